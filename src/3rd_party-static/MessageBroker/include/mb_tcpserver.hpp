@@ -18,6 +18,7 @@
 #define RECV_BUFFER_LENGTH 4097
 #define MAX_RECV_BUFFER_LENGTH 100000
 #define MAX_RECV_DATA 4096
+#define MAX_EPOLL_EVENTS 64
 
 /**
  * \namespace NsMessageBroker
@@ -65,8 +66,8 @@ namespace NsMessageBroker
          /**
          * \brief Wait message.
          *
-         * This function do a select() on the socket and Process() immediately 
-         * the message.
+         * This function do an epoll_wait() (select() where epoll is not
+         * available) on the sockets and Process() immediately the message.
          * \param ms millisecond to wait (0 means infinite)
          */
          virtual void WaitMessage(uint32_t ms);
@@ -113,6 +114,19 @@ namespace NsMessageBroker
          * \param fd socket file descriptor
          */
          std::string* getBufferFor(int fd);
+
+         /**
+         * \brief Removes receiving buffers of disconnected sockets.
+         */
+         void purgeClients();
+
+#ifdef __linux__
+         /**
+         * \brief Starts waiting for data on socket.
+         * \param fd socket file descriptor
+         */
+         void addToEpoll(int fd);
+#endif
       private:
          /**
          * \brief WebSocket clients fd's list.
@@ -133,6 +147,11 @@ namespace NsMessageBroker
          * \brief List of disconnected sockets to be purged.
          */
          std::list<int> m_purge;
+
+         /**
+         * \brief Epoll descriptor waiting for listen and client sockets.
+         */
+         int m_epoll;
          
          /**
          * \brief MessageBroker pointer.
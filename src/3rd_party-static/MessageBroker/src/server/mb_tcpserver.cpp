@@ -10,6 +10,10 @@
 #include <algorithm>
 #include <vector>
 #include <assert.h>
+#include <sys/uio.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include "MBDebugHelper.h"
 
@@ -19,7 +23,8 @@
 namespace NsMessageBroker {
 
 TcpServer::TcpServer(const std::string& address, uint16_t port, NsMessageBroker::CMessageBroker* pMessageBroker) :
-  Server(address, port) {
+  Server(address, port),
+  m_epoll(-1) {
   m_protocol = networking::TCP;
   mpMessageBroker = pMessageBroker;
 }
@@ -32,101 +37,112 @@ TcpServer::~TcpServer() {
 
 ssize_t TcpServer::Send(int fd, const std::string& data) {
   DBG_MSG(("Send to %d: %s\n", fd, data.c_str()));
-  std::string rep = data;
+  // WebSocket header and data are sent by one call without joining them
+  unsigned char header[10] = {'\0'};
+  struct iovec chunks[2];
+  chunks[0].iov_base = header;
+  chunks[0].iov_len = 0;
   if (isWebSocket(fd)) {
-    unsigned char buf[10] = {'\0'};
-    ssize_t headerlen = mWebSocketHandler.prepareWebSocketDataHeader(
-                          (unsigned char*)buf, (unsigned long)rep.length());
-    std::string header = std::string((char*)buf, headerlen);
-    rep = header + rep;
+    chunks[0].iov_len = mWebSocketHandler.prepareWebSocketDataHeader(
+                          header, (unsigned long)data.length());
   }
-  int bytesToSend = rep.length();
-  const char* ptrBuffer = rep.c_str();
-  do {
-    int retVal = send(fd, ptrBuffer, bytesToSend, 0);
+  chunks[1].iov_base = const_cast<char*>(data.data());
+  chunks[1].iov_len = data.length();
+  const ssize_t total = chunks[0].iov_len + chunks[1].iov_len;
+
+  struct iovec* chunk = chunks[0].iov_len ? &chunks[0] : &chunks[1];
+  const struct iovec* const end = chunks + 2;
+  while (chunk != end) {
+    ssize_t retVal = writev(fd, chunk, end - chunk);
     if (retVal == -1) {
+      if (EINTR == errno) {
+        continue;
+      }
       return -1;
     }
-    bytesToSend -= retVal;
-    ptrBuffer += retVal;
-  } while (bytesToSend > 0);
-  return rep.length();
+    while (chunk != end && static_cast<size_t>(retVal) >= chunk->iov_len) {
+      retVal -= chunk->iov_len;
+      ++chunk;
+    }
+    if (chunk != end) {
+      chunk->iov_base = static_cast<char*>(chunk->iov_base) + retVal;
+      chunk->iov_len -= retVal;
+    }
+  }
+  return total;
 }
 
 bool TcpServer::Recv(int fd) {
   DBG_MSG(("TcpServer::Recv(int fd)\n"));
-  ssize_t nb = -1;
 
   std::string* pReceivingBuffer = getBufferFor(fd);
-  std::vector<char> buf;
-  buf.reserve(RECV_BUFFER_LENGTH + pReceivingBuffer->size());
   DBG_MSG(("Left in  pReceivingBuffer: %d : %s\n",
            pReceivingBuffer->size(), pReceivingBuffer->c_str()));
-  buf.assign(pReceivingBuffer->c_str(),
-             pReceivingBuffer->c_str() + pReceivingBuffer->size());
-  buf.resize(RECV_BUFFER_LENGTH + pReceivingBuffer->size());
-  nb = recv(fd, &buf[pReceivingBuffer->size()], MAX_RECV_DATA, 0);
+  // Data is received into the buffer right after the rest of previous data,
+  // buffer keeps its capacity between messages
+  const size_t left = pReceivingBuffer->size();
+  pReceivingBuffer->resize(left + MAX_RECV_DATA);
+  const ssize_t nb = recv(fd, &(*pReceivingBuffer)[left], MAX_RECV_DATA, 0);
   DBG_MSG(("Recieved %d from %d\n", nb, fd));
-  nb += pReceivingBuffer->size();
-  DBG_MSG(("Recieved with buffer %d from %d\n", nb, fd));
-
-  if (nb > 0) {
-    unsigned int recieved_data = nb;
-    if (isWebSocket(fd)) {
-      const unsigned int data_length =
-        mWebSocketHandler.parseWebSocketDataLength(&buf[0], recieved_data);
-
-      DBG_MSG(("Received %d actual data length %d\n",
-               recieved_data, data_length));
-
-      if (data_length > recieved_data) {
-        DBG_MSG_ERROR(("Received %d actual data length %d\n",
-                       recieved_data, data_length));
-        DBG_MSG_ERROR(("Incomplete message"));
-        *pReceivingBuffer = std::string(&buf[0], nb);
-        return false;
-      }
-      unsigned int b_size = static_cast<unsigned int>(nb);
-      mWebSocketHandler.parseWebSocketData(&buf[0], b_size);
-      nb = b_size;
+  if (nb <= 0) {
+    pReceivingBuffer->resize(left);
+    m_purge.push_back(fd);
+    return false;
+  }
+  pReceivingBuffer->resize(left + nb);
+  DBG_MSG(("Recieved with buffer %d from %d\n",
+           pReceivingBuffer->size(), fd));
+
+  unsigned int recieved_data = pReceivingBuffer->size();
+  if (isWebSocket(fd)) {
+    const unsigned int data_length =
+      mWebSocketHandler.parseWebSocketDataLength(pReceivingBuffer->data(),
+                                                 recieved_data);
+
+    DBG_MSG(("Received %d actual data length %d\n",
+             recieved_data, data_length));
+
+    if (data_length > recieved_data) {
+      DBG_MSG_ERROR(("Received %d actual data length %d\n",
+                     recieved_data, data_length));
+      DBG_MSG_ERROR(("Incomplete message"));
+      return false;
     }
+    unsigned int b_size = recieved_data;
+    mWebSocketHandler.parseWebSocketData(&(*pReceivingBuffer)[0], b_size);
+    pReceivingBuffer->resize(b_size);
+  }
 
-    *pReceivingBuffer = std::string(&buf[0], nb);
-    DBG_MSG(("pReceivingBuffer before onMessageReceived:%d : %s",
-             pReceivingBuffer->size(), pReceivingBuffer->c_str()));
-    // we need to check websocket clients here
-    if (!checkWebSocketHandShake(fd, pReceivingBuffer))
-    { //JSON MESSAGE received. Send data in CMessageBroker.
-      if (mpMessageBroker) {
-        mpMessageBroker->onMessageReceived(fd, *pReceivingBuffer);
-      } else {
-        return false;
-      }
-    } else { // client is a websocket
-      std::string handshakeResponse =
-        "HTTP/1.1 101 Switching Protocols\r\nUpgrade: WebSocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: ";
-      ssize_t webSocketKeyPos = pReceivingBuffer->find("Sec-WebSocket-Key: ");
-      if (-1 != webSocketKeyPos) {
-        std::string wsKey = pReceivingBuffer->substr(webSocketKeyPos + 19, 24);
-        mWebSocketHandler.handshake_0405(wsKey);
-        handshakeResponse += wsKey;
-        handshakeResponse += "\r\n\r\n";
-        pReceivingBuffer->clear();
-        std::list<int>::iterator acceptedClientIt = find(m_AcceptedClients.begin(), m_AcceptedClients.end(), fd);
-        if (m_AcceptedClients.end() != acceptedClientIt) {
-          m_AcceptedClients.erase(acceptedClientIt);
-        }
-        Send(fd, handshakeResponse);
-        m_WebSocketClients.push_back(fd);
+  DBG_MSG(("pReceivingBuffer before onMessageReceived:%d : %s",
+           pReceivingBuffer->size(), pReceivingBuffer->c_str()));
+  // we need to check websocket clients here
+  if (!checkWebSocketHandShake(fd, pReceivingBuffer))
+  { //JSON MESSAGE received. Send data in CMessageBroker.
+    if (mpMessageBroker) {
+      mpMessageBroker->onMessageReceived(fd, *pReceivingBuffer);
+    } else {
+      return false;
+    }
+  } else { // client is a websocket
+    std::string handshakeResponse =
+      "HTTP/1.1 101 Switching Protocols\r\nUpgrade: WebSocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: ";
+    ssize_t webSocketKeyPos = pReceivingBuffer->find("Sec-WebSocket-Key: ");
+    if (-1 != webSocketKeyPos) {
+      std::string wsKey = pReceivingBuffer->substr(webSocketKeyPos + 19, 24);
+      mWebSocketHandler.handshake_0405(wsKey);
+      handshakeResponse += wsKey;
+      handshakeResponse += "\r\n\r\n";
+      pReceivingBuffer->clear();
+      std::list<int>::iterator acceptedClientIt = find(m_AcceptedClients.begin(), m_AcceptedClients.end(), fd);
+      if (m_AcceptedClients.end() != acceptedClientIt) {
+        m_AcceptedClients.erase(acceptedClientIt);
       }
+      Send(fd, handshakeResponse);
+      m_WebSocketClients.push_back(fd);
     }
-
-    return true;
-  }
-  else {
-    m_purge.push_back(fd);
-    return false;
   }
+
+  return true;
 }
 
 bool TcpServer::checkWebSocketHandShake(int fd, std::string* pReceivingBuffer) {
@@ -169,6 +185,48 @@ std::string* TcpServer::getBufferFor(int fd) {
   return res;
 }
 
+#ifdef __linux__
+void TcpServer::WaitMessage(uint32_t ms) {
+  if (-1 == m_epoll) {
+    m_epoll = epoll_create(MAX_EPOLL_EVENTS);
+    if (-1 == m_epoll) {
+      DBG_MSG_ERROR(("epoll_create failed: %s\n", strerror(errno)));
+      return;
+    }
+    addToEpoll(m_sock);
+    for (std::map<int, std::string*>::iterator it = m_receivingBuffers.begin();
+         it != m_receivingBuffers.end() ; it++) {
+      addToEpoll((*it).first);
+    }
+  }
+
+  struct epoll_event events[MAX_EPOLL_EVENTS];
+  const int count = epoll_wait(m_epoll, events, MAX_EPOLL_EVENTS,
+                               ms ? static_cast<int>(ms) : -1);
+  for (int i = 0; i < count; ++i) {
+    const int fd = events[i].data.fd;
+    if (fd == m_sock) {
+      Accept();
+    } else if (m_receivingBuffers.end() != m_receivingBuffers.find(fd)) {
+      Recv(fd);
+    }
+  }
+  purgeClients();
+}
+
+void TcpServer::addToEpoll(int fd) {
+  if (-1 == m_epoll) {
+    return;
+  }
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  if (-1 == epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event)) {
+    DBG_MSG_ERROR(("epoll_ctl failed for %d: %s\n", fd, strerror(errno)));
+  }
+}
+#else
 void TcpServer::WaitMessage(uint32_t ms) {
   fd_set fdsr;
   struct timeval tv;
@@ -213,25 +271,33 @@ void TcpServer::WaitMessage(uint32_t ms) {
       }
     }
 
-    /* remove disconnect socket descriptor */
-    for (std::list<int>::iterator it = m_purge.begin();
-         it != m_purge.end() ; it++) {
-      std::map <int, std::string*>::iterator itr;
-      itr = m_receivingBuffers.find((*it));
-      if (itr != m_receivingBuffers.end())
-      { // delete receiving buffer of disconnected client
-        delete(*itr).second;
-        m_receivingBuffers.erase(itr);
-      }
-    }
-
-    /* purge disconnected list */
-    m_purge.erase(m_purge.begin(), m_purge.end());
+    purgeClients();
   }
   else {
     /* error */
   }
 }
+#endif  // __linux__
+
+void TcpServer::purgeClients() {
+  /* remove disconnect socket descriptor */
+  for (std::list<int>::iterator it = m_purge.begin();
+       it != m_purge.end() ; it++) {
+    std::map <int, std::string*>::iterator itr;
+    itr = m_receivingBuffers.find((*it));
+    if (itr != m_receivingBuffers.end())
+    { // delete receiving buffer of disconnected client
+      delete(*itr).second;
+      m_receivingBuffers.erase(itr);
+    }
+#ifdef __linux__
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, (*it), NULL);
+#endif
+  }
+
+  /* purge disconnected list */
+  m_purge.erase(m_purge.begin(), m_purge.end());
+}
 
 bool TcpServer::Listen() const {
   if (m_sock == -1) {
@@ -263,6 +329,9 @@ bool TcpServer::Accept() {
   std::string* res = new std::string("");
   m_receivingBuffers.insert(std::map<int, std::string*>::value_type(client, res));
   m_AcceptedClients.push_back(client);
+#ifdef __linux__
+  addToEpoll(client);
+#endif
   return true;
 }
 
@@ -276,6 +345,12 @@ void TcpServer::Close() {
     }
   }
   m_receivingBuffers.clear();
+#ifdef __linux__
+  if (-1 != m_epoll) {
+    ::close(m_epoll);
+    m_epoll = -1;
+  }
+#endif
   Server::Close();
   /* listen socket should be closed in Server destructor */
 }
@@ -34,6 +34,17 @@
 #include "utils/signals.h"
 #include "config_profile/profile.h"
 #include "resumption/last_state.h"
+#include "application_manager/policies/policy_handler.h"
+#include "utils/memory_accounting.h"
+#include "utils/metrics_registry.h"
+#include "utils/resource_sampler.h"
+#include "utils/date_time.h"
+#include "utils/file_system.h"
+#include "utils/async_file_io.h"
+#include "utils/fd_handoff.h"
+#include "utils/conditional_variable.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
 
 #ifdef ENABLE_SECURITY
 #include "security_manager/security_manager_impl.h"
@@ -51,10 +62,122 @@ namespace main_namespace {
 CREATE_LOGGERPTR_GLOBAL(logger_, "appMain")
 
 namespace {
+// Time SDL running before is given to stop and save its state
+const int32_t kWarmRestartTimeoutMs = 30000;
+
 void NameMessageBrokerThread(const System::Thread& thread,
                              const std::string& name) {
   Thread::SetNameForId(thread.GetId(), name);
 }
+
+/**
+ * Logs duration of startup step on destruction and keeps it
+ * as "startup.<step>_us" gauge of metrics registry
+ */
+class StartupTimer {
+ public:
+  explicit StartupTimer(const std::string& step)
+    : step_(step),
+      start_(date_time::DateTime::getCurrentTime()) {
+  }
+
+  ~StartupTimer() {
+    const int64_t duration = date_time::DateTime::getuSecs(
+        date_time::DateTime::Sub(date_time::DateTime::getCurrentTime(),
+                                 start_));
+    LOG4CXX_INFO(logger_, "Startup step " << step_ << " took "
+                 << duration << " us");
+    utils::metrics::MetricsRegistry::instance()->GetGauge(
+        "startup." + step_ + "_us")->Set(duration);
+  }
+
+ private:
+  const std::string step_;
+  const TimevalStruct start_;
+  DISALLOW_COPY_AND_ASSIGN(StartupTimer);
+};
+
+/**
+ * Runs startup step of LifeCycle on its own thread, so steps which do not
+ * depend on each other are initialized concurrently. Dependent step has to
+ * Wait for result before it starts, destruction waits for step as well.
+ */
+class StartupStep {
+ public:
+  typedef bool (LifeCycle::*Function)();
+
+  StartupStep(const char* name, LifeCycle* life_cycle, Function function)
+    : delegate_(new Delegate(life_cycle, function)),
+      thread_(threads::CreateThread(name, delegate_)),
+      waited_(false),
+      result_(false) {
+    if (!thread_->start()) {
+      LOG4CXX_WARN(logger_, "Startup step " << name
+                   << " could not be started on its thread, running it now");
+      delegate_->threadMain();
+    }
+  }
+
+  ~StartupStep() {
+    Wait();
+  }
+
+  bool Wait() {
+    if (!waited_) {
+      waited_ = true;
+      result_ = delegate_->WaitResult();
+      thread_->join();
+      delete thread_->delegate();
+      threads::DeleteThread(thread_);
+    }
+    return result_;
+  }
+
+ private:
+  class Delegate : public threads::ThreadDelegate {
+   public:
+    Delegate(LifeCycle* life_cycle, Function function)
+      : life_cycle_(life_cycle),
+        function_(function),
+        done_(false),
+        result_(false) {
+    }
+
+    void threadMain() {
+      const bool result = (life_cycle_->*function_)();
+      sync_primitives::AutoLock auto_lock(lock_);
+      result_ = result;
+      done_ = true;
+      done_cond_.Broadcast();
+    }
+
+    // Step is never interrupted, owner waits for its completion instead
+    void exitThreadMain() {
+    }
+
+    bool WaitResult() {
+      sync_primitives::AutoLock auto_lock(lock_);
+      while (!done_) {
+        done_cond_.Wait(auto_lock);
+      }
+      return result_;
+    }
+
+   private:
+    LifeCycle* life_cycle_;
+    Function function_;
+    sync_primitives::Lock lock_;
+    sync_primitives::ConditionalVariable done_cond_;
+    bool done_;
+    bool result_;
+  };
+
+  Delegate* delegate_;
+  threads::Thread* thread_;
+  bool waited_;
+  bool result_;
+  DISALLOW_COPY_AND_ASSIGN(StartupStep);
+};
 }  // namespace
 
 LifeCycle::LifeCycle()
@@ -89,39 +212,81 @@ LifeCycle::LifeCycle()
 
 bool LifeCycle::StartComponents() {
   LOG4CXX_INFO(logger_, "LifeCycle::StartComponents()");
-  transport_manager_ =
-    transport_manager::TransportManagerDefault::instance();
-  DCHECK(transport_manager_ != NULL);
-
-  protocol_handler_ =
-    new protocol_handler::ProtocolHandlerImpl(transport_manager_,
-                                              profile::Profile::instance()->message_frequency_time(),
-                                              profile::Profile::instance()->message_frequency_count(),
-                                              profile::Profile::instance()->malformed_message_filtering(),
-                                              profile::Profile::instance()->malformed_frequency_time(),
-                                              profile::Profile::instance()->malformed_frequency_count());
-  DCHECK(protocol_handler_ != NULL);
-
-  connection_handler_ =
-    connection_handler::ConnectionHandlerImpl::instance();
-  DCHECK(connection_handler_ != NULL);
+  StartupTimer total_timer("total");
+
+  const std::string& warm_restart_socket =
+      profile::Profile::instance()->warm_restart_socket();
+  {
+    // Running SDL saves last state and policy table before they are loaded
+    StartupTimer timer("warm_restart");
+    if (utils::FdHandoff::instance()->TakeOver(warm_restart_socket,
+                                               kWarmRestartTimeoutMs)) {
+      LOG4CXX_INFO(logger_, "Warm restart, transports are taken over");
+    }
+  }
 
-  app_manager_ =
-    application_manager::ApplicationManagerImpl::instance();
-  DCHECK(app_manager_ != NULL);
-  if (!app_manager_->Init()) {
+  // Policy table is kept in storage folder, so it has to exist before
+  // policy and application manager are initialized concurrently
+  const std::string app_storage_folder =
+      profile::Profile::instance()->app_storage_folder();
+  if (!file_system::DirectoryExists(app_storage_folder) &&
+      !file_system::CreateDirectoryRecursively(app_storage_folder)) {
+    LOG4CXX_WARN(logger_, "Storage folder " << app_storage_folder
+                 << " could not be created");
+  }
+  // Loading of policy table and parsing of HMI capabilities
+  // do not depend on other components
+  StartupStep policy_step("PolicyInit", this, &LifeCycle::InitPolicy);
+  StartupStep app_manager_step("AppMngrInit", this,
+                               &LifeCycle::InitApplicationManager);
+
+  {
+    StartupTimer timer("transport_manager");
+    transport_manager_ =
+      transport_manager::TransportManagerDefault::instance();
+    DCHECK(transport_manager_ != NULL);
+  }
+
+  {
+    StartupTimer timer("protocol_handler");
+    protocol_handler_ =
+      new protocol_handler::ProtocolHandlerImpl(transport_manager_,
+                                                profile::Profile::instance()->message_frequency_time(),
+                                                profile::Profile::instance()->message_frequency_count(),
+                                                profile::Profile::instance()->malformed_message_filtering(),
+                                                profile::Profile::instance()->malformed_frequency_time(),
+                                                profile::Profile::instance()->malformed_frequency_count());
+    DCHECK(protocol_handler_ != NULL);
+  }
+
+  {
+    StartupTimer timer("connection_handler");
+    connection_handler_ =
+      connection_handler::ConnectionHandlerImpl::instance();
+    DCHECK(connection_handler_ != NULL);
+  }
+
+  {
+    StartupTimer timer("hmi_message_handler");
+    hmi_handler_ =
+      hmi_message_handler::HMIMessageHandlerImpl::instance();
+    DCHECK(hmi_handler_ != NULL)
+  }
+
+  if (!app_manager_step.Wait()) {
     LOG4CXX_ERROR(logger_, "Application manager init failed.");
     return false;
   }
 
-  hmi_handler_ =
-    hmi_message_handler::HMIMessageHandlerImpl::instance();
-  DCHECK(hmi_handler_ != NULL)
-
 #ifdef ENABLE_SECURITY
-  security_manager_ = new security_manager::SecurityManagerImpl();
-
   // FIXME(EZamakhov): move to Config or in Sm initialization method
+  int32_t handshake_threads = 0;
+  profile::Profile::instance()->ReadIntValue(
+        &handshake_threads, 0,
+        security_manager::SecurityManagerImpl::ConfigSection(), "HandshakeThreads");
+  security_manager_ = new security_manager::SecurityManagerImpl(
+        handshake_threads > 0 ? handshake_threads : 0);
+
   std::string cert_filename;
   profile::Profile::instance()->ReadStringValue(
         &cert_filename, "",
@@ -130,7 +295,27 @@ bool LifeCycle::StartComponents() {
   std::string ssl_mode;
   profile::Profile::instance()->ReadStringValue(
           &ssl_mode, "CLIENT", security_manager::SecurityManagerImpl::ConfigSection(), "SSLMode");
-  crypto_manager_ = new security_manager::CryptoManagerImpl();
+  security_manager::CryptoManagerImpl *crypto_manager =
+      new security_manager::CryptoManagerImpl();
+  crypto_manager_ = crypto_manager;
+
+  std::string crypto_engine;
+  profile::Profile::instance()->ReadStringValue(
+        &crypto_engine, "", security_manager::SecurityManagerImpl::ConfigSection(), "CryptoEngine");
+  crypto_manager->set_crypto_engine(crypto_engine);
+
+  std::string preferred_ciphers;
+  profile::Profile::instance()->ReadStringValue(
+        &preferred_ciphers, "", security_manager::SecurityManagerImpl::ConfigSection(), "PreferredCiphers");
+  if (preferred_ciphers == "AES-GCM") {
+    crypto_manager->set_cipher_preference(
+          security_manager::CryptoManagerImpl::PREFER_AES_GCM);
+  } else if (preferred_ciphers == "CHACHA20") {
+    crypto_manager->set_cipher_preference(
+          security_manager::CryptoManagerImpl::PREFER_CHACHA20);
+  } else if (!preferred_ciphers.empty()) {
+    LOG4CXX_WARN(logger_, "Unknown preferred ciphers: " << preferred_ciphers);
+  }
 
   std::string key_filename;
   profile::Profile::instance()->ReadStringValue(
@@ -211,24 +396,49 @@ bool LifeCycle::StartComponents() {
   app_manager_->set_connection_handler(connection_handler_);
   app_manager_->set_hmi_message_handler(hmi_handler_);
 
-  transport_manager_->Init();
-  // start transport manager
-  transport_manager_->Visibility(true);
+  // Applications connected through transport are checked against policy
+  if (!policy_step.Wait()) {
+    return false;
+  }
+  // Transport adapters scan for devices while plugins and HMI adapter load
+  StartupStep transport_step("TMInit", this,
+                             &LifeCycle::InitTransportManager);
 
   components_started_ = true;
 
+  utils::metrics::MetricsRegistry::instance()->StartPeriodicDump(
+      profile::Profile::instance()->metrics_dump_period());
+  utils::ResourceSampler::instance()->Start(
+      profile::Profile::instance()->resource_sampling_period());
+  utils::MemoryAccounting::instance()->set_app_quota(
+      static_cast<uint64_t>(
+          profile::Profile::instance()->app_memory_quota()) * 1024);
+
   core_service_ = new application_manager::CoreService();
 
   plugin_manager_ = functional_modules::PluginManager::instance();
   plugin_manager_->SetServiceHandler(core_service_);
-  plugin_manager_->LoadPlugins(profile::Profile::instance()->plugins_folder());
+  {
+    StartupTimer timer("plugins");
+    plugin_manager_->LoadPlugins(
+        profile::Profile::instance()->plugins_folder(),
+        profile::Profile::instance()->plugin_idle_timeout());
+  }
 
-  if (!InitMessageSystem()) {
-    LOG4CXX_INFO(logger_, "InitMessageBroker failed");
-    return false;
+  {
+    StartupTimer timer("message_system");
+    if (!InitMessageSystem()) {
+      LOG4CXX_INFO(logger_, "InitMessageBroker failed");
+      return false;
+    }
   }
 
   LOG4CXX_INFO(logger_, "InitMessageBroker successful");
+  transport_step.Wait();
+
+  // Transport adapters have taken what they use
+  utils::FdHandoff::instance()->CloseInherited();
+  utils::FdHandoff::instance()->StartServing(warm_restart_socket);
 
   plugin_manager_->OnServiceStateChanged(
     functional_modules::ServiceState::HMI_ADAPTER_INITIALIZED);
@@ -236,6 +446,45 @@ bool LifeCycle::StartComponents() {
   return true;
 }
 
+bool LifeCycle::InitPolicy() {
+  StartupTimer timer("policy");
+  policy::PolicyHandler* policy_handler = policy::PolicyHandler::instance();
+  if (!policy_handler->PolicyEnabled()) {
+    LOG4CXX_WARN(logger_, "System is configured to work without policy functionality.");
+    return true;
+  }
+  if (!policy_handler->LoadPolicyLibrary()) {
+    LOG4CXX_ERROR(logger_, "Policy library is not loaded. Check LD_LIBRARY_PATH");
+    return false;
+  }
+  LOG4CXX_INFO(logger_, "Policy library is loaded, now initing PT");
+  if (!policy_handler->InitPolicyTable()) {
+    LOG4CXX_ERROR(logger_, "Policy table is not initialized.");
+    return false;
+  }
+  return true;
+}
+
+bool LifeCycle::InitApplicationManager() {
+  StartupTimer timer("application_manager");
+  // HMI capabilities are loaded from file on creation
+  app_manager_ =
+    application_manager::ApplicationManagerImpl::instance();
+  DCHECK(app_manager_ != NULL);
+  return app_manager_->Init();
+}
+
+bool LifeCycle::InitTransportManager() {
+  StartupTimer timer("transport_adapters");
+  if (transport_manager::E_SUCCESS != transport_manager_->Init()) {
+    LOG4CXX_ERROR(logger_, "Transport manager init failed.");
+    return false;
+  }
+  // start transport manager
+  transport_manager_->Visibility(true);
+  return true;
+}
+
 #ifdef MESSAGEBROKER_HMIADAPTER
 bool LifeCycle::InitMessageSystem() {
   message_broker_ =
@@ -359,6 +608,30 @@ bool LifeCycle::InitMessageSystem() {
 
 #endif  // MQUEUE_HMIADAPTER
 
+#ifdef DIRECT_HMIADAPTER
+bool LifeCycle::InitMessageSystem() {
+  hmi_message_adapter_ = new hmi_message_handler::DirectAdapter(
+    hmi_message_handler::HMIMessageHandlerImpl::instance());
+  hmi_message_handler::HMIMessageHandlerImpl::instance()->AddHMIMessageAdapter(
+    hmi_message_adapter_);
+  return true;
+}
+
+hmi_message_handler::DirectAdapter* LifeCycle::direct_adapter() const {
+  return static_cast<hmi_message_handler::DirectAdapter*>(hmi_message_adapter_);
+}
+#endif  // DIRECT_HMIADAPTER
+
+#ifdef SHM_HMIADAPTER
+bool LifeCycle::InitMessageSystem() {
+  hmi_message_adapter_ = new hmi_message_handler::ShmAdapter(
+    hmi_message_handler::HMIMessageHandlerImpl::instance());
+  hmi_message_handler::HMIMessageHandlerImpl::instance()->AddHMIMessageAdapter(
+    hmi_message_adapter_);
+  return true;
+}
+#endif  // SHM_HMIADAPTER
+
 namespace {
 
   void sig_handler(int sig) {
@@ -398,6 +671,9 @@ void LifeCycle::StopComponents() {
 
   functional_modules::PluginManager::destroy();
 
+  utils::metrics::MetricsRegistry::instance()->StopPeriodicDump();
+  utils::ResourceSampler::instance()->Stop();
+
   hmi_handler_->set_message_observer(NULL);
   connection_handler_->set_connection_handler_observer(NULL);
   protocol_handler_->RemoveProtocolObserver(app_manager_);
@@ -440,6 +716,9 @@ void LifeCycle::StopComponents() {
   LOG4CXX_INFO(logger_, "Destroying Last State");
   resumption::LastState::destroy();
 
+  LOG4CXX_INFO(logger_, "Flushing pending file writes");
+  file_system::AsyncFileIO::destroy();
+
   LOG4CXX_INFO(logger_, "Destroying Application Manager.");
   application_manager::ApplicationManagerImpl::destroy();
 
@@ -508,6 +787,9 @@ void LifeCycle::StopComponents() {
     time_tester_ = NULL;
   }
 #endif  // TIME_TESTER
+
+  // State is saved, SDL taking over may load it
+  utils::FdHandoff::instance()->Complete();
   components_started_ = false;
   LOG4CXX_TRACE(logger_, "exit");
 }
@@ -45,6 +45,12 @@
 #ifdef MQUEUE_HMIADAPTER
 #  include "hmi_message_handler/mqueue_adapter.h"
 #endif  // MQUEUE_HMIADAPTER
+#ifdef DIRECT_HMIADAPTER
+#  include "hmi_message_handler/direct_adapter.h"
+#endif  // DIRECT_HMIADAPTER
+#ifdef SHM_HMIADAPTER
+#  include "hmi_message_handler/shm_adapter.h"
+#endif  // SHM_HMIADAPTER
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/core_service.h"
 #include "connection_handler/connection_handler_impl.h"
@@ -89,9 +95,24 @@ class LifeCycle : public utils::Singleton<LifeCycle> {
     void Run();
     void StopComponents();
 
+#ifdef DIRECT_HMIADAPTER
+    /**
+     * \brief Adapter in-process HMI has to be registered with
+     */
+    hmi_message_handler::DirectAdapter* direct_adapter() const;
+#endif  // DIRECT_HMIADAPTER
 
   private:
     LifeCycle();
+
+    /**
+     * Startup steps run concurrently by StartComponents
+     * @return true if success otherwise false.
+     */
+    bool InitPolicy();
+    bool InitApplicationManager();
+    bool InitTransportManager();
+
     transport_manager::TransportManager* transport_manager_;
     protocol_handler::ProtocolHandlerImpl* protocol_handler_;
     connection_handler::ConnectionHandlerImpl* connection_handler_;
@@ -50,6 +50,7 @@
 
 #include "utils/signals.h"
 #include "utils/system.h"
+#include "utils/threads/thread_profiles.h"
 #include "config_profile/profile.h"
 #include "utils/appenders_loader.h"
 
@@ -173,6 +174,20 @@ int32_t main(int32_t argc, char** argv) {
       profile::Profile::instance()->config_file_name("smartDeviceLink.ini");
   }
 
+  // Threads started so far, e.g. logger, keep default settings
+  threads::ThreadProfiles::instance()->Set(
+      profile::Profile::instance()->thread_profiles());
+
+  const std::string& binary_log_file =
+      profile::Profile::instance()->binary_log_file();
+  if (!binary_log_file.empty()) {
+    if (INIT_BINARY_LOGGER(binary_log_file)) {
+      LOG4CXX_INFO(logger_, "Binary log started: " << binary_log_file);
+    } else {
+      LOG4CXX_ERROR(logger_, "Failed to start binary log " << binary_log_file);
+    }
+  }
+
 #ifdef __QNX__
   if (profile::Profile::instance()->enable_policy()) {
     if (!utils::System("./init_policy.sh").Execute(true)) {
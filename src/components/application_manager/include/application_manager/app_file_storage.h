@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APP_FILE_STORAGE_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APP_FILE_STORAGE_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+
+#include "interfaces/MOBILE_API.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace application_manager {
+
+/**
+ * @brief Writes files which applications upload in parts by offset.
+ * Files stay open between parts and sizes of directories are kept up to
+ * date by writes, so a part costs neither reopening of file nor walk
+ * through directory for quota check
+ */
+class AppFileStorage {
+ public:
+  AppFileStorage();
+  ~AppFileStorage();
+
+  /**
+   * @brief Writes part of file
+   * @param directory Directory of file
+   * @param file_name Name of file in directory
+   * @param data Data of part
+   * @param size Size of data
+   * @param offset Offset of part, file is rewritten if it is 0,
+   * otherwise offset has to match current size of file
+   * @return SUCCESS if part is written, INVALID_DATA on mismatch of offset,
+   * GENERIC_ERROR otherwise
+   */
+  mobile_apis::Result::eType Write(const std::string& directory,
+                                   const std::string& file_name,
+                                   const uint8_t* data, size_t size,
+                                   int64_t offset);
+
+  /**
+   * @brief Sets directory where content of shared files is kept and removes
+   * content which is not used by any application anymore
+   * @param directory Directory on the same file system as files of apps
+   */
+  void SetSharedDirectory(const std::string& directory);
+
+  /**
+   * @brief Writes whole file, content which is already written for any
+   * application is hard linked instead of being written again
+   * @param directory Directory of file
+   * @param file_name Name of file in directory
+   * @param data Content of file
+   * @param size Size of content
+   * @param is_present Set to true if content was already present
+   * @return SUCCESS if file is written, GENERIC_ERROR otherwise
+   */
+  mobile_apis::Result::eType WriteShared(const std::string& directory,
+                                         const std::string& file_name,
+                                         const uint8_t* data, size_t size,
+                                         bool* is_present);
+
+  /**
+   * @brief Returns size of all files in directory, directory is walked
+   * only if its size is not known yet
+   */
+  size_t DirectorySize(const std::string& directory);
+
+  /**
+   * @brief Closes files and forgets sizes of directories affected by
+   * change not done by Write, e.g. removal of file or directory
+   * @param path Path to changed file or directory
+   */
+  void Invalidate(const std::string& path);
+
+ private:
+  struct OpenFile {
+    int fd;
+    uint64_t last_use;
+  };
+  typedef std::map<std::string, OpenFile> OpenFiles;
+  typedef std::map<std::string, size_t> DirectorySizes;
+
+  /**
+   * @brief Takes descriptor of file out of open files
+   * @return -1 if file is not open
+   */
+  int TakeOpenFile(const std::string& file_path);
+  void PutOpenFile(const std::string& file_path, int fd);
+  /**
+   * @brief Gives file its own copy of content shared with other files
+   */
+  bool Unshare(const std::string& file_path);
+  void UpdateDirectorySize(const std::string& directory,
+                           int64_t old_file_size, int64_t new_file_size);
+
+  std::string shared_directory_;
+  OpenFiles open_files_;
+  DirectorySizes directory_sizes_;
+  uint64_t use_counter_;
+  sync_primitives::Lock lock_;
+  DISALLOW_COPY_AND_ASSIGN(AppFileStorage);
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APP_FILE_STORAGE_H_
@@ -41,6 +41,7 @@
 #include "connection_handler/device.h"
 #include "application_manager/message.h"
 #include "application_manager/app_extension.h"
+#include "application_manager/scheduling_class.h"
 #include <set>
 
 namespace NsSmartDeviceLink {
@@ -250,6 +251,25 @@ class DynamicApplicationData {
     virtual smart_objects::SmartObject* FindChoiceSet(
       uint32_t choice_set_id) = 0;
 
+    /*
+     * @brief Returns true if choice with such id exists in any choice set
+     *
+     * @param choice_id ID of the choice
+     */
+    virtual bool IsChoiceIdAlreadyExist(uint32_t choice_id) const = 0;
+
+    /*
+     * @brief Marks choice set as created on HMI by
+     * UI.CreateInteractionChoiceSet
+     */
+    virtual void set_choice_set_cached_on_hmi(uint32_t choice_set_id,
+                                              bool cached) = 0;
+
+    /*
+     * @brief Returns true if HMI keeps a copy of the choice set
+     */
+    virtual bool is_choice_set_cached_on_hmi(uint32_t choice_set_id) const = 0;
+
     /*
      * @brief Adds perform interaction choice set to the application
      *
@@ -300,6 +320,15 @@ class DynamicApplicationData {
      */
     virtual DataAccessor<ChoiceSetMap> choice_set_map() const = 0;
 
+    /*
+     * @brief Retrieve change counters of commands, sub menus and choice sets,
+     * every add or remove increments the counter of its map, so data copied
+     * along with the same counter value is still up to date
+     */
+    virtual uint32_t commands_version() const = 0;
+    virtual uint32_t sub_menu_version() const = 0;
+    virtual uint32_t choice_set_version() const = 0;
+
     /*
      * @brief Sets perform interaction state
      *
@@ -359,6 +388,27 @@ class DynamicApplicationData {
     virtual bool is_reset_global_properties_active() const = 0;
 };
 
+/**
+ * @brief Receives changes of application subscriptions, allows
+ * application manager to keep its subscribers indexes up to date
+ */
+class SubscriptionsObserver {
+  public:
+    virtual void OnButtonSubscriptionChanged(
+        uint32_t app_id, mobile_apis::ButtonName::eType btn_name,
+        bool subscribed) = 0;
+    virtual void OnIVISubscriptionChanged(
+        uint32_t app_id, uint32_t vehicle_info_type, bool subscribed) = 0;
+    /*
+     * @param module_key key of module made by MessageHelper::InteriorModuleKey
+     */
+    virtual void OnInteriorVehicleDataSubscriptionChanged(
+        uint32_t app_id, const std::string& module_key, bool subscribed) = 0;
+  protected:
+    virtual ~SubscriptionsObserver() {
+    }
+};
+
 class Application : public virtual InitialApplicationData,
   public virtual DynamicApplicationData {
 
@@ -370,7 +420,8 @@ class Application : public virtual InitialApplicationData,
 
   public:
     Application() :
-      is_greyed_out_(false) {
+      is_greyed_out_(false),
+      scheduling_class_(kSchedulingDefault) {
     }
 
     virtual ~Application() {
@@ -511,6 +562,13 @@ class Application : public virtual InitialApplicationData,
     virtual bool IsSubscribedToIVI(uint32_t vehicle_info_type_) = 0;
     virtual bool UnsubscribeFromIVI(uint32_t vehicle_info_type_) = 0;
 
+    /**
+     * @brief Sets observer notified about every button and vehicle data
+     * subscription change, NULL to stop notifications
+     */
+    virtual void set_subscriptions_observer(
+        SubscriptionsObserver* observer) = 0;
+
     virtual bool SubscribeToInteriorVehicleData(smart_objects::SmartObject module) = 0;
     virtual bool IsSubscribedToInteriorVehicleData(smart_objects::SmartObject module) = 0;
     virtual bool UnsubscribeFromInteriorVehicleData(smart_objects::SmartObject module) = 0;
@@ -653,6 +711,31 @@ class Application : public virtual InitialApplicationData,
      */
     void set_greyed_out(bool is_greyed_out) {is_greyed_out_ = is_greyed_out;}
 
+    /**
+     * @brief Returns scheduling class of application RPCs, it is read
+     * by threads queueing RPCs
+     */
+    SchedulingClass scheduling_class() const {return scheduling_class_;}
+
+    /**
+     * @brief Sets priority assigned to application by policy
+     * @param priority Policy priority, empty if there is none
+     */
+    void set_policy_priority(const std::string& priority) {
+      policy_priority_ = priority;
+      UpdateSchedulingClass();
+    }
+
+  protected:
+    /**
+     * @brief Recalculates scheduling class, must be called when HMI level
+     * or application type is changed
+     */
+    void UpdateSchedulingClass() {
+      scheduling_class_ = GetSchedulingClass(
+          hmi_level(), is_navi() || is_media_application(), policy_priority_);
+    }
+
   protected:
 
     // interfaces for NAVI retry sequence
@@ -672,6 +755,8 @@ class Application : public virtual InitialApplicationData,
     bool streaming_;
     ssize_t connection_id_;
     bool is_greyed_out_;
+    std::string policy_priority_;
+    volatile SchedulingClass scheduling_class_;
 };
 
 typedef utils::SharedPtr<Application> ApplicationSharedPtr;
@@ -33,6 +33,7 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APPLICATION_DATA_IMPL_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APPLICATION_DATA_IMPL_H_
 
+#include <set>
 #include <string>
 #include "utils/lock.h"
 #include "smart_objects/smart_object.h"
@@ -162,6 +163,23 @@ class DynamicApplicationDataImpl : public virtual Application {
      */
     smart_objects::SmartObject* FindChoiceSet(uint32_t choice_set_id);
 
+    /*
+     * @brief Returns true if choice with such id exists in any choice set
+     */
+    bool IsChoiceIdAlreadyExist(uint32_t choice_id) const;
+
+    /*
+     * @brief Marks choice set as created on HMI by
+     * UI.CreateInteractionChoiceSet
+     */
+    void set_choice_set_cached_on_hmi(uint32_t choice_set_id, bool cached);
+
+    /*
+     * @brief Returns true if HMI keeps a copy of the choice set, so
+     * UI.PerformInteraction may refer to it by ID
+     */
+    bool is_choice_set_cached_on_hmi(uint32_t choice_set_id) const;
+
     /*
      * @brief Adds perform interaction choice set to the application
      *
@@ -210,6 +228,13 @@ class DynamicApplicationDataImpl : public virtual Application {
      */
     inline DataAccessor<ChoiceSetMap> choice_set_map() const;
 
+    /*
+     * @brief Retrieve change counters of commands, sub menus and choice sets
+     */
+    uint32_t commands_version() const;
+    uint32_t sub_menu_version() const;
+    uint32_t choice_set_version() const;
+
     /*
      * @brief Sets perform interaction state
      *
@@ -267,7 +292,30 @@ class DynamicApplicationDataImpl : public virtual Application {
      */
     inline bool is_reset_global_properties_active() const;
 
+private:
+    /*
+     * @brief Removes name of menu from names of sub menus
+     */
+    void EraseSubMenuName(const smart_objects::SmartObject& menu);
+
+    /*
+     * @brief Removes IDs of choices of choice set from choice IDs
+     */
+    void EraseChoiceIds(const smart_objects::SmartObject& choice_set);
+
+    /*
+     * @brief Accounts memory taken by object for application or returns it
+     */
+    void ChargeAppState(const smart_objects::SmartObject& object);
+    void ReleaseAppState(const smart_objects::SmartObject& object);
+
 protected:
+    /*
+     * @brief Returns estimated memory held in commands, sub menus
+     * and choice sets, which is accounted for application
+     */
+    uint64_t AppStateMemorySize() const;
+
     smart_objects::SmartObject* help_prompt_;
     smart_objects::SmartObject* timeout_prompt_;
     smart_objects::SmartObject* vr_help_title_;
@@ -281,10 +329,19 @@ protected:
 
 
     CommandsMap commands_;
+    uint32_t commands_version_;
     mutable sync_primitives::Lock commands_lock_;
     SubMenuMap sub_menu_;
+    // Names of sub menus, guarded by sub_menu_lock_
+    std::multiset<std::string> sub_menu_names_;
+    uint32_t sub_menu_version_;
     mutable sync_primitives::Lock sub_menu_lock_;
     ChoiceSetMap choice_set_map_;
+    // Choice IDs of all choice sets, guarded by choice_set_map_lock_
+    std::multiset<uint32_t> choice_ids_;
+    // Choice sets created on HMI, guarded by choice_set_map_lock_
+    std::set<uint32_t> hmi_cached_choice_sets_;
+    uint32_t choice_set_version_;
     mutable sync_primitives::Lock choice_set_map_lock_;
     PerformChoiceSetMap performinteraction_choice_set_map_;
     mutable sync_primitives::Lock performinteraction_choice_set_lock_;
@@ -38,7 +38,6 @@
 #include <vector>
 #include <list>
 #include <utility>
-#include <forward_list>
 
 #include "utils/date_time.h"
 #include "application_manager/application_data_impl.h"
@@ -154,6 +153,8 @@ class ApplicationImpl : public virtual InitialApplicationDataImpl,
   bool IsSubscribedToIVI(uint32_t vehicle_info_type_);
   bool UnsubscribeFromIVI(uint32_t vehicle_info_type_);
 
+  void set_subscriptions_observer(SubscriptionsObserver* observer);
+
   bool SubscribeToInteriorVehicleData(smart_objects::SmartObject module);
   bool IsSubscribedToInteriorVehicleData(smart_objects::SmartObject module);
   bool UnsubscribeFromInteriorVehicleData(smart_objects::SmartObject module);
@@ -265,7 +266,9 @@ class ApplicationImpl : public virtual InitialApplicationDataImpl,
   AppFilesMap                              app_files_;
   std::set<mobile_apis::ButtonName::eType> subscribed_buttons_;
   std::set<uint32_t>                       subscribed_vehicle_info_;
-  std::forward_list<smart_objects::SmartObject>     subscribed_interior_vehicle_data_;
+  // Keys of modules made by MessageHelper::InteriorModuleKey
+  std::set<std::string>                    subscribed_interior_vehicle_data_;
+  SubscriptionsObserver*                   subscriptions_observer_;
   UsageStatistics                          usage_report_;
   ProtocolVersion                          protocol_version_;
   bool                                     is_voice_communication_application_;
@@ -39,13 +39,16 @@
 #include <set>
 #include <algorithm>
 
+#include "application_manager/app_file_storage.h"
 #include "application_manager/hmi_command_factory.h"
+#include "application_manager/icon_storage.h"
 #include "application_manager/application_manager.h"
 #include "application_manager/hmi_capabilities.h"
 #include "application_manager/message.h"
 #include "application_manager/message_helper.h"
 #include "application_manager/request_controller.h"
 #include "application_manager/resume_ctrl.h"
+#include "application_manager/vehicle_data_cache.h"
 #include "application_manager/vehicle_info_data.h"
 #include "protocol_handler/protocol_observer.h"
 #include "hmi_message_handler/hmi_message_observer.h"
@@ -70,11 +73,14 @@
 #include "utils/shared_ptr.h"
 #include "utils/message_queue.h"
 #include "utils/prioritized_queue.h"
+#include "utils/coalescing_queue.h"
 #include "utils/threads/thread.h"
 #include "utils/threads/message_loop_thread.h"
+#include "utils/threads/thread_pool.h"
 #include "utils/lock.h"
 #include "utils/singleton.h"
 #include "utils/data_accessor.h"
+#include "utils/timer_wheel.h"
 
 
 
@@ -114,17 +120,29 @@ using namespace threads;
  * TODO(ik): replace these with globally defined message types
  * when we have them.
  */
+// Count of priority values of protocol_handler::MessagePriority
+const size_t kMessagePriorityLevels = 0x100;
+
 struct MessageFromMobile: public utils::SharedPtr<Message> {
+  MessageFromMobile() : scheduling_class(kSchedulingDefault) {}
   explicit MessageFromMobile(const utils::SharedPtr<Message>& message)
-      : utils::SharedPtr<Message>(message) {
+      : utils::SharedPtr<Message>(message),
+        scheduling_class(kSchedulingDefault) {
   }
-  // PrioritizedQueue requres this method to decide which priority to assign
+  // PrioritizedQueue requres this method to decide which priority to assign,
+  // scheduling class of application goes first, message priority breaks ties
   size_t PriorityOrder() const {
-    return (*this)->Priority().OrderingValue();
+    return scheduling_class * kMessagePriorityLevels +
+           (*this)->Priority().OrderingValue();
   }
+  // Validated smart object if message was parsed before it was handled
+  smart_objects::SmartObjectSPtr smart_object;
+  // Scheduling class of application at the moment message was received
+  SchedulingClass scheduling_class;
 };
 
 struct MessageToMobile: public utils::SharedPtr<Message> {
+  MessageToMobile() : is_final(false) {}
   explicit MessageToMobile(const utils::SharedPtr<Message>& message,
                            bool final_message)
       : utils::SharedPtr<Message>(message),
@@ -134,11 +152,23 @@ struct MessageToMobile: public utils::SharedPtr<Message> {
   size_t PriorityOrder() const {
     return (*this)->Priority().OrderingValue();
   }
+  // CoalescingQueue requires these methods to supersede pending messages
+  const std::string& CoalescingGroup() const {
+    return coalescing_group;
+  }
+  const std::string& CoalescingKey() const {
+    return coalescing_key;
+  }
   // Signals if connection to mobile must be closed after sending this message
   bool is_final;
+  // Pending notification of the same application and function is superseded
+  // by this one if keys are equal, empty group if it is never superseded
+  std::string coalescing_group;
+  std::string coalescing_key;
 };
 
 struct MessageFromHmi: public utils::SharedPtr<Message> {
+  MessageFromHmi() {}
   explicit MessageFromHmi(const utils::SharedPtr<Message>& message)
       : utils::SharedPtr<Message>(message) {
   }
@@ -149,6 +179,7 @@ struct MessageFromHmi: public utils::SharedPtr<Message> {
 };
 
 struct MessageToHmi: public utils::SharedPtr<Message> {
+  MessageToHmi() {}
   explicit MessageToHmi(const utils::SharedPtr<Message>& message)
       : utils::SharedPtr<Message>(message) {
   }
@@ -159,10 +190,15 @@ struct MessageToHmi: public utils::SharedPtr<Message> {
 };
 
 // Short type names for prioritized message queues
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromMobile> > FromMobileQueue;
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToMobile> > ToMobileQueue;
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromHmi> > FromHmiQueue;
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToHmi> > ToHmiQueue;
+// FixedPrioritizedQueue does not allocate on every message burst,
+// utils::PrioritizedQueue can be used instead if priorities are unbounded
+typedef threads::MessageLoopThread<utils::FixedPrioritizedQueue<
+    MessageFromMobile, kSchedulingClassesCount * kMessagePriorityLevels> >
+    FromMobileQueue;
+typedef threads::MessageLoopThread<utils::CoalescingQueue<
+    utils::FixedPrioritizedQueue<MessageToMobile> > > ToMobileQueue;
+typedef threads::MessageLoopThread<utils::FixedPrioritizedQueue<MessageFromHmi> > FromHmiQueue;
+typedef threads::MessageLoopThread<utils::FixedPrioritizedQueue<MessageToHmi> > ToHmiQueue;
 
 // AudioPassThru
 typedef struct  {
@@ -183,6 +219,7 @@ class ApplicationManagerImpl : public ApplicationManager,
   public impl::FromMobileQueue::Handler, public impl::ToMobileQueue::Handler,
   public impl::FromHmiQueue::Handler, public impl::ToHmiQueue::Handler,
   public impl::AudioPassThruQueue::Handler,
+  public SubscriptionsObserver,
   public utils::Singleton<ApplicationManagerImpl> {
 
     friend class ResumeCtrl;
@@ -192,7 +229,8 @@ class ApplicationManagerImpl : public ApplicationManager,
     ~ApplicationManagerImpl();
 
     /**
-     * Inits application manager
+     * Inits application manager, policy library is loaded
+     * by LifeCycle concurrently with it
      */
     virtual bool Init();
 
@@ -269,10 +307,34 @@ class ApplicationManagerImpl : public ApplicationManager,
     std::vector<ApplicationSharedPtr> IviInfoUpdated(
       VehicleDataType vehicle_info, int value);
 
+    /**
+     * @brief Keeps button subscribers index up to date
+     */
+    virtual void OnButtonSubscriptionChanged(
+        uint32_t app_id, mobile_apis::ButtonName::eType btn_name,
+        bool subscribed);
+
+    /**
+     * @brief Keeps vehicle data subscribers index up to date
+     */
+    virtual void OnIVISubscriptionChanged(
+        uint32_t app_id, uint32_t vehicle_info_type, bool subscribed);
+
+    /**
+     * @brief Keeps interior vehicle data subscribers index up to date
+     */
+    virtual void OnInteriorVehicleDataSubscriptionChanged(
+        uint32_t app_id, const std::string& module_key, bool subscribed);
+
     /////////////////////////////////////////////////////
 
     HMICapabilities& hmi_capabilities();
 
+    /**
+     * @brief Vehicle data last got from HMI
+     */
+    VehicleDataCache& vehicle_data_cache();
+
     /**
      * @brief ProcessQueryApp executes logic related to QUERY_APP system request.
      *
@@ -458,7 +520,8 @@ class ApplicationManagerImpl : public ApplicationManager,
      * @param session_key Id of application for which
      * audio pass thru should be sent
      *
-     * @param binary_data AudioPassThru data chunk
+     * @param binary_data AudioPassThru data chunk, it is moved to the queue
+     * and left empty
      */
     void SendAudioPassThroughNotification(uint32_t session_key,
                                           std::vector<uint8_t>& binary_data);
@@ -480,14 +543,60 @@ class ApplicationManagerImpl : public ApplicationManager,
     // Put message to the queue to be sent to mobile.
     // if |final_message| parameter is set connection to mobile will be closed
     // after processing this message
+    // if |serialized_json| is passed json of msg_params is taken from it
+    // or stored in it, so it must be passed only with equal msg_params
     void SendMessageToMobile(const commands::MessageSharedPtr message,
-                             bool final_message = false);
+                             bool final_message = false,
+                             SerializedJson* serialized_json = NULL);
+
+    /**
+     * @brief Messages sent to mobile on the calling thread while batch
+     * exists are posted to mobile queue at once when the outermost batch
+     * ends. Equal notifications of several applications, like OnHMIStatus
+     * on phone call or OnPermissionsChange after policy update, get json
+     * serialized once
+     */
+    class MobileMessageBatch {
+     public:
+      MobileMessageBatch();
+      ~MobileMessageBatch();
+     private:
+      DISALLOW_COPY_AND_ASSIGN(MobileMessageBatch);
+    };
+
+    /**
+     * @brief Starts and ends batch of messages sent to mobile on calling
+     * thread, calls must be paired, see MobileMessageBatch
+     */
+    void BeginMobileMessageBatch();
+    void EndMobileMessageBatch();
 
     bool ManageMobileCommand(
             const commands::MessageSharedPtr message,
             commands::Command::CommandOrigin origin =
             commands::Command::ORIGIN_SDL);
     void SendMessageToHMI(const commands::MessageSharedPtr message);
+
+    /**
+     * @brief Messages sent to HMI on the calling thread while batch exists
+     * are posted to HMI queue at once when the outermost batch ends, like
+     * requests and notifications sent on application registration
+     */
+    class HMIMessageBatch {
+     public:
+      HMIMessageBatch();
+      ~HMIMessageBatch();
+     private:
+      DISALLOW_COPY_AND_ASSIGN(HMIMessageBatch);
+    };
+
+    /**
+     * @brief Starts and ends batch of messages sent to HMI on calling
+     * thread, calls must be paired, see HMIMessageBatch
+     */
+    void BeginHMIMessageBatch();
+    void EndHMIMessageBatch();
+
     bool ManageHMICommand(const commands::MessageSharedPtr message);
 
     /////////////////////////////////////////////////////////
@@ -637,6 +746,14 @@ class ApplicationManagerImpl : public ApplicationManager,
       return resume_ctrl_;
     }
 
+    /**
+      * Getter for icon_storage
+      * @return Storage of application icons
+      */
+    IconStorage& icon_storage() {
+      return icon_storage_;
+    }
+
     /**
      * Generate grammar ID
      *
@@ -685,6 +802,23 @@ class ApplicationManagerImpl : public ApplicationManager,
         const std::string& file_name,
         const int64_t offset);
 
+    /**
+     * @brief Save whole file of application, content which is already
+     * stored for any application is shared instead of being written again
+     *
+     * @param binary_data Content of file
+     * @param file_path Path for saving data
+     * @param file_name File name
+     * @param is_present Set to true if content was already stored
+     *
+     * @return SUCCESS if file was saved, other code otherwise
+     */
+    mobile_apis::Result::eType SaveSharedBinary(
+        const std::vector<uint8_t>& binary_data,
+        const std::string& file_path,
+        const std::string& file_name,
+        bool* is_present);
+
     /**
      * @brief Get available app space
      * @param name of the app folder(make + mobile app id)
@@ -692,6 +826,13 @@ class ApplicationManagerImpl : public ApplicationManager,
      */
     uint32_t GetAvailableSpaceForApp(const std::string& folder_name);
 
+    /**
+     * @brief Notifies about files removed from storage of applications
+     * not by SaveBinary, so their handles and cached sizes are dropped
+     * @param path Path to removed file or directory
+     */
+    void OnAppStorageChanged(const std::string& path);
+
     /*
      * @brief returns true if HMI is cooperating
      */
@@ -863,6 +1004,64 @@ class ApplicationManagerImpl : public ApplicationManager,
     DataAccessor<AppsWaitRegistrationSet> apps_waiting_for_registration() const;
     ApplicationConstSharedPtr waiting_app(const uint32_t hmi_id) const;
 
+    typedef utils::SharedPtr<const ApplictionSet> ApplicationSetSnapshotPtr;
+
+    /**
+     * @brief Immutable snapshot of registered applications list.
+     * Taking snapshot does not wait for writers and iteration does not hold
+     * applications_list_lock_, so it is safe to send messages or even
+     * unregister applications from inside the loop.
+     * Only list membership is frozen, applications themselves are shared.
+     */
+    class ApplicationListSnapshot {
+     public:
+      ApplicationListSnapshot()
+        : applications_(
+            ApplicationManagerImpl::instance()->applications_snapshot()) {
+      }
+
+      const ApplictionSet& applications() const {
+        return *applications_;
+      }
+
+      ApplictionSetConstIt begin() const {
+        return applications_->begin();
+      }
+
+      ApplictionSetConstIt end() const {
+        return applications_->end();
+      }
+
+      template<class UnaryPredicate>
+      ApplicationSharedPtr Find(UnaryPredicate finder) const {
+        ApplicationSharedPtr result;
+        ApplictionSetConstIt it = std::find_if(begin(), end(), finder);
+        if (it != end()) {
+          result = *it;
+        }
+        return result;
+      }
+
+      template<class UnaryPredicate>
+      std::vector<ApplicationSharedPtr> FindAll(UnaryPredicate finder) const {
+        std::vector<ApplicationSharedPtr> result;
+        ApplictionSetConstIt it = std::find_if(begin(), end(), finder);
+        while (it != end()) {
+          result.push_back(*it);
+          it  = std::find_if(++it, end(), finder);
+        }
+        return result;
+      }
+
+      bool Empty() const {
+        return applications_->empty();
+      }
+
+     private:
+      ApplicationSetSnapshotPtr applications_;
+      DISALLOW_COPY_AND_ASSIGN(ApplicationListSnapshot);
+    };
+
     /**
      * Class for thread-safe access to applications list
      */
@@ -918,11 +1117,17 @@ class ApplicationManagerImpl : public ApplicationManager,
 
       void Erase(ApplicationSharedPtr app_to_remove) {
         app_to_remove->RemoveExtensions();
+        ApplicationManagerImpl::instance()->RemoveFromIndexes(app_to_remove);
         ApplicationManagerImpl::instance()->applications_.erase(app_to_remove);
+        ApplicationManagerImpl::instance()->PublishApplicationsSnapshot();
       }
 
       void Insert(ApplicationSharedPtr app_to_insert) {
-        ApplicationManagerImpl::instance()->applications_.insert(app_to_insert);
+        if (ApplicationManagerImpl::instance()->applications_.insert(
+              app_to_insert).second) {
+          ApplicationManagerImpl::instance()->AddToIndexes(app_to_insert);
+          ApplicationManagerImpl::instance()->PublishApplicationsSnapshot();
+        }
       }
 
       bool Empty() {
@@ -934,6 +1139,7 @@ class ApplicationManagerImpl : public ApplicationManager,
     };
 
     friend class ApplicationListAccessor;
+    friend class ApplicationListSnapshot;
 
     struct AppIdPredicate {
       uint32_t app_id_;
@@ -983,16 +1189,6 @@ class ApplicationManagerImpl : public ApplicationManager,
       }
     };
 
-    struct SubscribedToInteriorVehicleDataPredicate {
-      smart_objects::SmartObject interior_module_data_ = smart_objects::SmartObject(
-        smart_objects::SmartType_Map);
-      SubscribedToInteriorVehicleDataPredicate(smart_objects::SmartObject interior_module_data)
-        : interior_module_data_(interior_module_data) {}
-      bool operator () (const ApplicationSharedPtr app) const {
-        return app ? app->IsSubscribedToInteriorVehicleData(interior_module_data_) : false;
-      }
-    };
-
     struct AppV4DevicePredicate {
       connection_handler::DeviceHandle handle_;
       AppV4DevicePredicate(const connection_handler::DeviceHandle handle):
@@ -1022,7 +1218,8 @@ class ApplicationManagerImpl : public ApplicationManager,
     };
 
     /**
-     * @brief Sends UpdateAppList notification to HMI
+     * @brief Sends UpdateAppList notification to HMI, changes made within
+     * HMIListUpdateDelay are sent as single update
      */
     void SendUpdateAppList();
 
@@ -1076,14 +1273,62 @@ class ApplicationManagerImpl : public ApplicationManager,
     hmi_apis::HMI_API& hmi_so_factory();
     mobile_apis::MOBILE_API& mobile_so_factory();
 
-    bool ConvertMessageToSO(const Message& message,
+    /*
+     * @brief Converts message to smart object, binary data of mobile
+     * message is moved to smart object
+     */
+    bool ConvertMessageToSO(Message& message,
+                            smart_objects::SmartObject& output);
+    /*
+     * @brief Parses json of mobile message and validates it against schema.
+     * Has no side effects, so may be called on any thread.
+     */
+    bool ParseMobileMessage(const Message& message,
                             smart_objects::SmartObject& output);
+    /*
+     * @brief Adds connection key, protocol version and binary data
+     * of mobile message to parsed smart object. Binary data is moved
+     * without copying, message has none afterwards.
+     */
+    bool CompleteMobileMessageSO(Message& message,
+                                 smart_objects::SmartObject& output);
     bool ConvertSOtoMessage(const smart_objects::SmartObject& message,
-                            Message& output);
+                            Message& output,
+                            SerializedJson* serialized_json = NULL);
+    /*
+     * @brief Checks whether message is negative response to mobile carrying
+     * nothing but success and result code, so its json depends only on
+     * function and result
+     */
+    bool IsPlainNegativeResponse(
+      const smart_objects::SmartObject& message) const;
+    /*
+     * @brief Takes json of plain negative response serialized before
+     * @return true if template of function and result code exists
+     */
+    bool GetNegativeResponseTemplate(int32_t function_id, int32_t result_code,
+                                     SerializedJson* serialized_json);
+    void StoreNegativeResponseTemplate(int32_t function_id,
+                                       int32_t result_code,
+                                       const SerializedJson& serialized_json);
     utils::SharedPtr<Message> ConvertRawMsgToMessage(
       const ::protocol_handler::RawMessagePtr message);
 
-    void ProcessMessageFromMobile(const utils::SharedPtr<Message> message);
+    void ProcessMessageFromMobile(const impl::MessageFromMobile& message);
+
+    /**
+     * @brief Gets scheduling class of connection message being queued,
+     * class is kept while connection has queued messages
+     * @param connection_key Connection key of message
+     * @return Scheduling class of message
+     */
+    SchedulingClass QueueFromMobile(int32_t connection_key);
+
+    /**
+     * @brief Forgets message of connection taken from queues
+     * @param connection_key Connection key of message
+     */
+    void UnqueueFromMobile(int32_t connection_key);
     void ProcessMessageFromHMI(const utils::SharedPtr<Message> message);
 
     // threads::MessageLoopThread<*>::Handler implementations
@@ -1135,6 +1380,16 @@ class ApplicationManagerImpl : public ApplicationManager,
 
     void OnApplicationListUpdateTimer();
 
+    /**
+     * @brief Sends UpdateAppList with current application list right away
+     */
+    void SendPendingUpdateAppList();
+
+    /**
+     * @brief Sends UpdateDeviceList with latest reported device list
+     */
+    void SendPendingUpdateDeviceList();
+
     /**
      * @brief CreateApplications creates aplpication adds it to application list
      * and prepare data for sending AppIcon request.
@@ -1302,6 +1557,37 @@ class ApplicationManagerImpl : public ApplicationManager,
     AppsWaitRegistrationSet apps_to_register_;
     ForbiddenApps forbidden_applications;
 
+    /**
+     * @brief Lookup indexes of applications_, guarded by
+     * applications_list_lock_ and updated by ApplicationListAccessor
+     * Insert/Erase. App id is also the connection key of application.
+     */
+    typedef std::map<uint32_t, ApplicationSharedPtr> AppsByIdIndex;
+    typedef std::multimap<std::string, ApplicationSharedPtr> AppsByPolicyIdIndex;
+    typedef std::map<uint32_t, ApplictionSet> SubscribersIndex;
+    AppsByIdIndex apps_by_app_id_;
+    AppsByIdIndex apps_by_hmi_app_id_;
+    AppsByPolicyIdIndex apps_by_policy_app_id_;
+    SubscribersIndex button_subscribers_;
+    SubscribersIndex ivi_subscribers_;
+    // Keyed by MessageHelper::InteriorModuleKey
+    typedef std::map<std::string, ApplictionSet> InteriorSubscribersIndex;
+    InteriorSubscribersIndex interior_vehicle_data_subscribers_;
+
+    void AddToIndexes(ApplicationSharedPtr app);
+    void RemoveFromIndexes(ApplicationSharedPtr app);
+
+    /**
+     * @brief Last published copy of applications_, replaced as a whole
+     * by writers holding applications_list_lock_. Pointer itself is guarded
+     * by applications_snapshot_lock_, held only to copy or replace it.
+     */
+    ApplicationSetSnapshotPtr applications_snapshot_;
+    mutable sync_primitives::Lock applications_snapshot_lock_;
+
+    ApplicationSetSnapshotPtr applications_snapshot() const;
+    void PublishApplicationsSnapshot();
+
     // Lock for applications list
     mutable sync_primitives::Lock applications_list_lock_;
     mutable sync_primitives::Lock apps_to_register_list_lock_;
@@ -1363,6 +1649,36 @@ class ApplicationManagerImpl : public ApplicationManager,
 
     // Thread that pumps messages coming from mobile side.
     impl::FromMobileQueue messages_from_mobile_;
+
+    /*
+     * Parses messages from mobile on parsing_pool_ and passes them
+     * to messages_from_mobile_ in the order they came
+     */
+    class FromMobileParser : public impl::FromMobileQueue::Handler {
+      public:
+        explicit FromMobileParser(ApplicationManagerImpl* application_manager);
+        // CALLED ON parsing_pool_ thread!
+        virtual void Handle(const impl::MessageFromMobile message) OVERRIDE;
+      private:
+        ApplicationManagerImpl& application_manager_;
+    };
+    FromMobileParser from_mobile_parser_;
+    // Shared with all parsing queues, NULL if parallel parsing is disabled
+    threads::ThreadPool* parsing_pool_;
+    // Application messages always go through the same queue
+    std::vector<impl::FromMobileQueue*> parsing_queues_;
+    /*
+     * Scheduling class of connection changes only when none of its messages
+     * is queued, so messages of application never overtake each other
+     */
+    struct QueuedFromMobile {
+      QueuedFromMobile() : scheduling_class(kSchedulingDefault), count(0) {}
+      SchedulingClass scheduling_class;
+      size_t count;
+    };
+    typedef std::map<int32_t, QueuedFromMobile> QueuedFromMobileMap;
+    QueuedFromMobileMap queued_from_mobile_;
+    sync_primitives::Lock queued_from_mobile_lock_;
     // Thread that pumps messages being passed to mobile side.
     impl::ToMobileQueue messages_to_mobile_;
     // Thread that pumps messages coming from HMI.
@@ -1374,6 +1690,15 @@ class ApplicationManagerImpl : public ApplicationManager,
 
 
     HMICapabilities                         hmi_capabilities_;
+    VehicleDataCache                        vehicle_data_cache_;
+    AppFileStorage                          app_file_storage_;
+    IconStorage                             icon_storage_;
+
+    // Json of plain negative responses by function and result code
+    typedef std::map<std::pair<int32_t, int32_t>, std::string>
+      NegativeResponseTemplates;
+    NegativeResponseTemplates               negative_response_templates_;
+    sync_primitives::Lock                   negative_response_templates_lock_;
     // The reason of HU shutdown
     mobile_api::AppInterfaceUnregisteredReason::eType unregister_reason_;
 
@@ -1408,6 +1733,42 @@ class ApplicationManagerImpl : public ApplicationManager,
     typedef utils::SharedPtr<ApplicationListUpdateTimer> ApplicationListUpdateTimerSptr;
     ApplicationListUpdateTimerSptr application_list_update_timer_;
 
+    /**
+     * @brief Collects requests to send list to HMI for given delay and then
+     * sends it once, so burst of changes results in single update
+     */
+    class HMIListPublisher : public timer::TimerWheel::Timer {
+     public:
+      typedef void (ApplicationManagerImpl::*Callback)();
+      HMIListPublisher(ApplicationManagerImpl* callee, Callback callback);
+      ~HMIListPublisher();
+
+      /**
+       * @brief Schedules sending, calls made before it is done are merged
+       * @param delay_ms Milliseconds to collect changes for, 0 sends now
+       */
+      void Schedule(uint32_t delay_ms);
+
+      /**
+       * @brief Drops scheduled sending
+       */
+      void Cancel();
+
+      virtual void OnTimeout() OVERRIDE;
+
+     private:
+      ApplicationManagerImpl* callee_;
+      Callback callback_;
+      sync_primitives::Lock pending_lock_;
+      bool pending_;
+
+      DISALLOW_COPY_AND_ASSIGN(HMIListPublisher);
+    };
+    HMIListPublisher app_list_publisher_;
+    HMIListPublisher device_list_publisher_;
+    connection_handler::DeviceMap pending_device_list_;
+    sync_primitives::Lock pending_device_list_lock_;
+
     timer::TimerThread<ApplicationManagerImpl>  tts_global_properties_timer_;
 
     bool is_low_voltage_;
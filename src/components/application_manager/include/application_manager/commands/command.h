@@ -33,7 +33,10 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_COMMANDS_COMMAND_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_COMMANDS_COMMAND_H_
 
+#include <stddef.h>
+
 #include "utils/shared_ptr.h"
+#include "utils/small_object_pool.h"
 #include "smart_objects/smart_object.h"
 #include "application_manager/event_engine/event_observer.h"
 #include "application_manager/smart_object_keys.h"
@@ -111,6 +114,19 @@ class Command {
     ORIGIN_SDL,
     ORIGIN_MOBILE
   };
+
+  /*
+   * @brief Command is created for every message and released right after
+   * it is processed, so its memory is kept in thread local pool of blocks
+   * of the same size instead of reaching the heap each time
+   */
+  static void* operator new(size_t size) {
+    return utils::SmallObjectPool::Allocate(size);
+  }
+
+  static void operator delete(void* memory, size_t size) {
+    utils::SmallObjectPool::Free(memory, size);
+  }
 };
 
 typedef smart_objects::SmartObjectSPtr MessageSharedPtr;
@@ -34,6 +34,7 @@
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_COMMANDS_COMMAND_NOTIFICATION_IMPL_H_
 
 #include "application_manager/commands/command_impl.h"
+#include "application_manager/message.h"
 
 namespace NsSmartDeviceLink {
 namespace NsSmartObjects {
@@ -53,7 +54,19 @@ class CommandNotificationImpl : public CommandImpl {
   virtual bool CleanUp();
   virtual void Run();
   void SendNotification();
+
+  /**
+   * @brief Sends notification which msg_params are the same for every
+   * application it is sent to, json is serialized for the first one only
+   */
+  void SendBroadcastNotification();
+
  private:
+  void PrepareNotification();
+
+  // Json of msg_params shared by notifications sent by this command
+  SerializedJson broadcast_json_;
+
   DISALLOW_COPY_AND_ASSIGN(CommandNotificationImpl);
 };
 
@@ -101,6 +101,13 @@ class CommandRequestImpl : public CommandImpl,
    */
   bool CheckSyntax(std::string str, bool allow_empty_line = false);
 
+  /**
+   * @brief Checks if msg_params kept in application data fit memory quota
+   * of application, responds OUT_OF_MEMORY otherwise
+   * @return true if request may be processed
+   */
+  bool CheckAppMemoryQuota();
+
   /*
    * @brief Sends HMI request
    *
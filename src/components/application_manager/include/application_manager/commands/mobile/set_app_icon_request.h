@@ -35,6 +35,7 @@
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_COMMANDS_MOBILE_SET_ICON_REQUEST_H_
 
 #include "application_manager/commands/command_request_impl.h"
+#include "utils/async_file_io.h"
 #include "utils/macro.h"
 
 namespace application_manager {
@@ -80,25 +81,24 @@ class SetAppIconRequest : public CommandRequestImpl {
 
  private:
   /**
-   * @brief Copies file to icon storage
+   * @brief Copies file to icon storage, file is read and stored
+   * on file I/O thread
    * @param path_to_file Path to icon
    */
   void CopyToIconStorage(const std::string& path_to_file) const;
 
   /**
-   * @brief Remove oldest icons
-   * @param storage Path to icons storage
-   * @param icons_amount Amount of icons to be deleted
+   * @brief Stores icon of application as soon as it is read
    */
-  void RemoveOldestIcons(const std::string& storage,
-                         const uint32_t icons_amount) const;
+  class IconCopyCallback : public file_system::ReadCallback {
+   public:
+    explicit IconCopyCallback(const std::string& mobile_app_id);
+    virtual void OnRead(const std::string& file_name, bool result,
+                        const std::vector<uint8_t>& content) OVERRIDE;
+   private:
+    const std::string mobile_app_id_;
+  };
 
-  /**
-   * @brief Checks, if there enough space in storage for icon copy
-   * @param file_size File size
-   * @return true, if enough, otherwise - false
-   */
-  bool IsEnoughSpaceForIcon(const uint64_t icon_size) const;
   DISALLOW_COPY_AND_ASSIGN(SetAppIconRequest);
 
 private:
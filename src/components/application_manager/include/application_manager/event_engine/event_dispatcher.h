@@ -33,11 +33,16 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_EVENT_DISPATCHER_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_EVENT_DISPATCHER_H_
 
-#include <list>
 #include <map>
+#include <utility>
+#include <vector>
 
+#include "utils/date_time.h"
 #include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/shared_ptr.h"
 #include "utils/singleton.h"
+#include "utils/threads/thread.h"
 
 #include "application_manager/event_engine/event.h"
 
@@ -68,7 +73,29 @@ class EventDispatcher : public utils::Singleton<EventDispatcher> {
                     EventObserver* const observer);
 
   /*
-   * @brief Unsubscribes the observer from specific event
+   * @brief Subscribes the observer to response of request about to be sent,
+   * or to response of equal request sent earlier and still awaited,
+   * so one HMI request serves several mobile ones.
+   *
+   * @param event_id    The event ID of request
+   * @param hmi_correlation_id  HMI correlation ID of request about to be sent
+   * @param params      Parameters identifying request
+   * @param max_age_ms  Requests sent earlier are not joined, their
+   * responses are likely lost
+   * @param observer    The observer to subscribe for event
+   *
+   * @return HMI correlation ID of request observer waits response of,
+   * request is not sent if it differs from hmi_correlation_id
+   */
+  int32_t add_shared_observer(const Event::EventID& event_id,
+                              int32_t hmi_correlation_id,
+                              const smart_objects::SmartObject& params,
+                              uint32_t max_age_ms,
+                              EventObserver* const observer);
+
+  /*
+   * @brief Unsubscribes the observer from specific event.
+   * If observer is being called by other thread, waits until it returns.
    *
    * @param event_id    The event ID to unsubscribe from
    * @param observer    The observer to be unsubscribed
@@ -77,7 +104,8 @@ class EventDispatcher : public utils::Singleton<EventDispatcher> {
                        EventObserver* const observer);
 
   /*
-   * @brief Unsubscribes the observer from all events
+   * @brief Unsubscribes the observer from all events.
+   * If observer is being called by other thread, waits until it returns.
    *
    * @param observer  The observer to be unsubscribed
    */
@@ -97,27 +125,77 @@ class EventDispatcher : public utils::Singleton<EventDispatcher> {
    */
   virtual ~EventDispatcher();
 
+  // Data types section
+  typedef std::vector<EventObserver*>                 ObserverList;
+  typedef utils::SharedPtr<ObserverList>              ObserverListPtr;
+  typedef std::pair<Event::EventID, int32_t>          ResponseKey;
+  // Observers waiting for single response, entry is taken out on delivery
+  typedef std::map<ResponseKey, ObserverList>         ResponseObserverMap;
+  // Notification observers, lists are never changed once shared,
+  // so raising takes reference instead of copy
+  typedef std::map<Event::EventID, ObserverListPtr>   NotificationObserverMap;
+
+  /*
+   * @brief Request sent to HMI and awaited by observers of its response
+   */
+  struct SharedRequest {
+    smart_objects::SmartObject params;
+    TimevalStruct sent;
+  };
+  // Entry lives no longer than response entry with the same key
+  typedef std::map<ResponseKey, SharedRequest>        SharedRequestMap;
+
   /*
-   * @brief removes observer
-   * when occurs unsubscribe from event
-   * @param observer to be removed
+   * @brief Observers of event being delivered by raise_event()
    */
-  void remove_observer_from_list(EventObserver* const observer);
+  struct Delivery {
+    Event::EventID event_id;
+    ObserverList taken;
+    ObserverListPtr shared;
+    const ObserverList* observers;
+    size_t next;
+    // Observer being called outside of state_lock_
+    EventObserver* current;
+    threads::PlatformThreadHandle thread;
+    // Observers unsubscribed during delivery, they are not called anymore
+    ObserverList removed;
+  };
+  typedef std::vector<Delivery*>                      DeliveryList;
+
+  /*
+   * @brief Takes next observer to call, NULL if delivery is finished.
+   * Requires state_lock_ to be taken.
+   */
+  EventObserver* next_observer(Delivery* delivery);
+
+  /*
+   * @brief Removes observer from notification list of event
+   * Requires state_lock_ to be taken.
+   */
+  void remove_notification_observer(NotificationObserverMap::iterator it,
+                                    EventObserver* const observer);
+
+  /*
+   * @brief Prevents observer being called by deliveries of event,
+   * any event if all_events is true, and waits until calls of it
+   * on other threads are finished. Requires state_lock_ to be taken.
+   */
+  void cancel_deliveries(const Event::EventID& event_id, bool all_events,
+                         EventObserver* const observer,
+                         sync_primitives::AutoLock& auto_lock);
 
   DISALLOW_COPY_AND_ASSIGN(EventDispatcher);
 
   FRIEND_BASE_SINGLETON_CLASS(EventDispatcher);
 
-  // Data types section
-  typedef std::list<EventObserver*>                   ObserverList;
-  typedef std::map<int32_t, ObserverList>             ObserversMap;
-  typedef std::map<Event::EventID, ObserversMap>      EventObserverMap;
-
   // Members section
   sync_primitives::Lock                               state_lock_;
-  sync_primitives::Lock                               observer_list_lock_;
-  EventObserverMap                                    observers_;
-  ObserverList                                        observers_list_;
+  // Signaled every time delivery finishes call of observer
+  sync_primitives::ConditionalVariable                observer_released_;
+  ResponseObserverMap                                 response_observers_;
+  NotificationObserverMap                             notification_observers_;
+  SharedRequestMap                                    shared_requests_;
+  DeliveryList                                        deliveries_;
 
 };
 
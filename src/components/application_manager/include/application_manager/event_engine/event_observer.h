@@ -86,6 +86,22 @@ class EventObserver
   void subscribe_on_event(
       const Event::EventID& event_id, int32_t hmi_correlation_id = 0);
 
+  /*
+   * @brief Subscribe to response of request about to be sent to HMI,
+   * or of equal request sent earlier and still awaited
+   *
+   * @param event_id            The event ID of request
+   * @param hmi_correlation_id  HMI correlation ID of request to be sent
+   * @param params              Parameters identifying request
+   * @param max_age_ms          Age of requests not to be joined anymore
+   *
+   * @return HMI correlation ID of awaited response, request is not to be
+   * sent if it differs from hmi_correlation_id
+   */
+  int32_t subscribe_on_shared_event(
+      const Event::EventID& event_id, int32_t hmi_correlation_id,
+      const smart_objects::SmartObject& params, uint32_t max_age_ms);
+
   /*
    * @brief Unsubscribes the observer from specific event
    *
@@ -37,6 +37,7 @@
 #include "interfaces/MOBILE_API.h"
 #include "json/json.h"
 #include "utils/macro.h"
+#include "utils/lock.h"
 
 namespace NsSmartDeviceLink {
 namespace NsSmartObjects {
@@ -362,6 +363,17 @@ class HMICapabilities {
   void set_prerecorded_speech(
        const smart_objects::SmartObject& prerecorded_speech);
 
+  /*
+   * @brief Retrieves capabilities which are sent in every
+   * RegisterAppInterface response. They are put together once and then
+   * only after any of them is changed, instead of per registration
+   *
+   * @return Map of response parameters with display, button, soft button,
+   * preset bank, HMI zone, speech, VR, audio pass thru capabilities,
+   * vehicle type and prerecorded speech
+   */
+  smart_objects::SmartObject register_app_interface_capabilities() const;
+
  protected:
 
   /*
@@ -396,6 +408,12 @@ class HMICapabilities {
                                      smart_objects::SmartObject& languages);
 
  private:
+  /*
+   * @brief Drops capabilities put together for RegisterAppInterface
+   * response, should be called on change of any of them
+   */
+  void reset_register_app_interface_capabilities();
+
   bool                             is_vr_cooperating_;
   bool                             is_tts_cooperating_;
   bool                             is_ui_cooperating_;
@@ -427,6 +445,9 @@ class HMICapabilities {
   smart_objects::SmartObject*      audio_pass_thru_capabilities_;
   smart_objects::SmartObject*      prerecorded_speech_;
 
+  mutable smart_objects::SmartObject* register_app_interface_capabilities_;
+  mutable sync_primitives::Lock    register_app_interface_capabilities_lock_;
+
   ApplicationManagerImpl*          app_mngr_;
 
   DISALLOW_COPY_AND_ASSIGN(HMICapabilities);
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_ICON_STORAGE_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_ICON_STORAGE_H_
+
+#include <stdint.h>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace application_manager {
+
+/**
+ * @brief Storage of application icons which keeps index of stored icons,
+ * so storing of icon neither lists nor stats icons directory.
+ * Index is saved to the icons directory and is checked against files only
+ * once on first use
+ */
+class IconStorage {
+ public:
+  IconStorage();
+
+  /**
+   * @brief Sets up storage, index is loaded on first use
+   * @param folder Icons directory
+   * @param max_size Maximum size of all icons
+   * @param amount_to_remove Amount of least recently stored icons removed
+   * at once when there is not enough space, 0 means icon is not stored
+   */
+  void Init(const std::string& folder, uint64_t max_size,
+            uint32_t amount_to_remove);
+
+  /**
+   * @brief Stores icon of application, icon which is already stored with the
+   * same content is not rewritten but only becomes most recently used
+   * @param name Name of icon file
+   * @param content Icon data
+   * @return true if icon is stored
+   */
+  bool Store(const std::string& name, const std::vector<uint8_t>& content);
+
+  /**
+   * @brief Name of index file in icons directory
+   */
+  static const char* const kIndexFileName;
+
+ private:
+  struct Icon {
+    std::string name;
+    uint64_t size;
+    uint64_t modification_time;
+    uint64_t hash;
+  };
+  // Least recently used icon goes first
+  typedef std::list<Icon> Icons;
+  typedef std::map<std::string, Icons::iterator> IconsIndex;
+
+  void LoadIndex();
+  void SaveIndex() const;
+  void Remove(Icons::iterator icon);
+
+  std::string folder_;
+  uint64_t max_size_;
+  uint32_t amount_to_remove_;
+  bool is_loaded_;
+  uint64_t size_;
+  Icons icons_;
+  IconsIndex index_;
+  sync_primitives::Lock lock_;
+  DISALLOW_COPY_AND_ASSIGN(IconStorage);
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_ICON_STORAGE_H_
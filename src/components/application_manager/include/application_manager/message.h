@@ -39,7 +39,7 @@
 #include "utils/shared_ptr.h"
 #include "protocol/message_priority.h"
 #include "protocol/rpc_type.h"
-#ifdef HMI_DBUS_API
+#if defined(HMI_DBUS_API) || defined(DIRECT_HMIADAPTER)
 #include "smart_objects/smart_object.h"
 
 namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
@@ -48,6 +48,8 @@ namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
 namespace application_manager {
 
 typedef std::vector<uint8_t> BinaryData;
+// Same type as smart_objects::SharedBinary, so data is passed on unchanged
+typedef utils::SharedPtr<const BinaryData> SharedBinaryData;
 
 // Message type is a general type used by both mobile and HMI messages
 enum MessageType {
@@ -89,10 +91,11 @@ class Message {
 
   const std::string& json_message() const;
   const BinaryData* binary_data() const;
+  const SharedBinaryData& shared_binary_data() const;
   bool has_binary_data() const;
   size_t data_size() const;
   size_t payload_size() const;
-#ifdef HMI_DBUS_API
+#if defined(HMI_DBUS_API) || defined(DIRECT_HMIADAPTER)
   const smart_objects::SmartObject& smart_object() const;
 #endif
 
@@ -103,9 +106,11 @@ class Message {
   void set_connection_key(int32_t key);
   void set_message_type(MessageType type);
   void set_binary_data(BinaryData* data);
+  void set_binary_data(const SharedBinaryData& data);
   void set_json_message(const std::string& json_message);
+  void set_json_message(const char* data, size_t size);
   void set_protocol_version(ProtocolVersion version);
-#ifdef HMI_DBUS_API
+#if defined(HMI_DBUS_API) || defined(DIRECT_HMIADAPTER)
   void set_smart_object(const smart_objects::SmartObject& object);
 #endif
   void set_data_size(size_t data_size);
@@ -125,16 +130,27 @@ class Message {
 
   int32_t connection_key_;
   std::string json_message_;
-#ifdef HMI_DBUS_API
+#if defined(HMI_DBUS_API) || defined(DIRECT_HMIADAPTER)
   smart_objects::SmartObject smart_object_;
 #endif
 
-  // TODO(akandul): replace with shared_ptr
-  BinaryData* binary_data_;
+  // Shared with copies of message and smart object made of it
+  SharedBinaryData binary_data_;
   size_t data_size_;
   size_t payload_size_;
   ProtocolVersion version_;
 };
+/*
+ * Json of msg_params serialized once for notification sent to several
+ * applications. Messages of protocol version 2 and above carry only
+ * msg_params in json, so it can be reused while they differ in params only.
+ */
+struct SerializedJson {
+  SerializedJson() : is_serialized(false) {}
+  bool is_serialized;
+  std::string json_message;
+};
+
 typedef utils::SharedPtr<application_manager::Message> MobileMessage;
 typedef utils::SharedPtr<application_manager::Message> MessagePtr;
 }  // namespace application_manager
@@ -169,6 +169,15 @@ class MessageHelper {
     static std::string StringifiedFunctionID(
       mobile_apis::FunctionID::eType function_id);
 
+    /*
+    * @brief Makes compact key of module type and zone, so applications
+    * subscribed to interior vehicle data are found without comparing
+    * module descriptions
+    * @param module_description ModuleDescription with type and zone
+    */
+    static std::string InteriorModuleKey(
+      const smart_objects::SmartObject& module_description);
+
     static smart_objects::SmartObjectSPtr CreateBlockedByPoliciesResponse(
       mobile_apis::FunctionID::eType function_id,
       mobile_apis::Result::eType result, uint32_t correlation_id,
@@ -497,6 +506,12 @@ class MessageHelper {
 
     static bool PrintSmartObject(const smart_objects::SmartObject& object);
 
+    /**
+     * @brief Estimates bytes held by object and all its members,
+     * used to account memory application data takes
+     */
+    static size_t EstimateMemorySize(const smart_objects::SmartObject& object);
+
     template<typename From, typename To>
     static To ConvertEnumAPINoCheck(const From& input) {
       return static_cast<To>(input);
@@ -0,0 +1,77 @@
+﻿/*
+ Copyright (c) 2014, Ford Motor Company
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following
+ disclaimer in the documentation and/or other materials provided with the
+ distribution.
+
+ Neither the name of the Ford Motor Company nor the names of its contributors
+ may be used to endorse or promote products derived from this software
+ without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_DELEGATES_APP_REGISTERED_DELEGATE_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_DELEGATES_APP_REGISTERED_DELEGATE_H_
+
+#include <string>
+
+#include "utils/threads/thread_delegate.h"
+
+namespace policy {
+
+/**
+ * @brief The AppRegisteredDelegate class allows to call
+ * OnAppRegisteredOnMobile in async way, so PTU start and permissions
+ * notification don't delay registration of application.
+ */
+class AppRegisteredDelegate: public threads::ThreadDelegate {
+  public:
+    /**
+     * @brief AppRegisteredDelegate constructor, contains parameters
+     * which will be pass to the called function.
+     *
+     * @param device_id mac address of application device.
+     *
+     * @param application_id registered application.
+     */
+    AppRegisteredDelegate(const std::string& device_id,
+                          const std::string& application_id);
+
+    /**
+     * @brief threadMain run the needed function.
+     */
+    virtual void threadMain();
+
+    /**
+     * @brief exitThreadMain do some stuff before exit from thread
+     */
+    virtual void exitThreadMain();
+
+  private:
+    std::string device_id_;
+    std::string application_id_;
+};
+
+} // namespace policy
+
+#endif // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_DELEGATES_APP_REGISTERED_DELEGATE_H_
@@ -429,6 +429,12 @@ class PolicyHandler :
 
   virtual void OnCertificateUpdated(const std::string& certificate_data);
 
+  virtual void OnPTUpdated();
+
+  virtual void OnPermissionsChangesStarted();
+
+  virtual void OnPermissionsChangesFinished();
+
   virtual bool CanUpdate();
 
   virtual void OnDeviceConsentChanged(const std::string& device_id,
@@ -498,7 +504,8 @@ class PolicyHandler :
   /**
    * @brief OnAppRegisteredOnMobile alows to handle event when application were
    * succesfully registered on mobile device.
-   * It will send OnAppPermissionSend notification and will try to start PTU.
+   * It will send OnAppPermissionSend notification and will try to start PTU
+   * asynchronously, see OnAppRegisteredOnMobileInternal.
    * @param device_handle unique indetifier of device
    * @param application_id registered application.
    */
@@ -553,9 +560,31 @@ protected:
   void OnAppPermissionConsentInternal(const uint32_t connection_key,
                                       PermissionConsent& permissions);
 
+  /**
+   * @brief OnAppRegisteredOnMobileInternal passes registration of application
+   * to policy manager, called on async runner thread
+   *
+   * @param device_id mac address of application device
+   *
+   * @param application_id registered application.
+   */
+  void OnAppRegisteredOnMobileInternal(const std::string& device_id,
+                                       const std::string& application_id);
+
   void UpdateHMILevel(application_manager::ApplicationSharedPtr app,
                       mobile_apis::HMILevel::eType level);
 
+  /**
+   * @brief Drops cached results of permissions check for all applications
+   */
+  void ResetCachedPermissions();
+
+  /**
+   * @brief Drops cached results of permissions check for application
+   * @param policy_app_id unique application id
+   */
+  void ResetCachedPermissions(const std::string& policy_app_id);
+
 private:
   class StatisticManagerImpl: public usage_statistics::StatisticsManager {
       //TODO(AKutsan) REMOVE THIS UGLY HOTFIX
@@ -622,9 +651,24 @@ private:
   // Lock for app to device list
   sync_primitives::Lock app_to_device_link_lock_;
 
+  /**
+   * @brief Results of permissions check cached per policy application id,
+   * device and hmi level of application and rpc name
+   */
+  typedef std::pair<connection_handler::DeviceHandle,
+                    mobile_apis::HMILevel::eType> AppState;
+  typedef std::map<std::string, CheckPermissionResult> RpcPermissionResults;
+  typedef std::map<AppState, RpcPermissionResults> AppPermissionResults;
+  typedef std::map<std::string, AppPermissionResults> CachedPermissions;
+  CachedPermissions cached_permissions_;
+  // Incremented on every reset, so results calculated meanwhile are dropped
+  uint32_t cached_permissions_version_;
+  sync_primitives::Lock cached_permissions_lock_;
+
   utils::SharedPtr<StatisticManagerImpl> statistic_manager_impl_;
 
   friend class AppPermissionDelegate;
+  friend class AppRegisteredDelegate;
 
   DISALLOW_COPY_AND_ASSIGN(PolicyHandler);
   FRIEND_BASE_SINGLETON_CLASS_WITH_DELETER(PolicyHandler,
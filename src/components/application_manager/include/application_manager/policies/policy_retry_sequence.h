@@ -33,20 +33,48 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_POLICY_RETRY_SEQUENCE_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_POLICY_RETRY_SEQUENCE_H_
 
-#include "utils/threads/thread_delegate.h"
+#include "utils/macro.h"
+#include "utils/timer_wheel.h"
 
 namespace policy {
 
 class PolicyHandler;
 
-class RetrySequence : public threads::ThreadDelegate {
+/*
+ * Sends PT snapshot and repeats it by retry schedule of policy table.
+ * Sequence has no thread of its own, every step is run on the shared
+ * timer wheel, so it can be cancelled at any moment.
+ */
+class RetrySequence : private timer::TimerWheel::Timer {
  public:
   explicit RetrySequence(PolicyHandler* const policy_handler);
-  void threadMain();
+  ~RetrySequence();
+
+  /*
+   * @brief Cancels running sequence and starts new one
+   */
+  void Start();
+
+  /*
+   * @brief Cancels sequence, waits for running step to finish
+   */
+  void Stop();
 
  private:
-  PolicyHandler* const policy_handler_;
+  enum Step {
+    kSendSnapshot,
+    kExchangeTimeout
+  };
+
+  virtual void OnTimeout() OVERRIDE;
   void StartNextRetry();
+  void ScheduleRetry();
+
+  PolicyHandler* const policy_handler_;
+  Step next_step_;
+  int retry_timeout_seconds_;
+
+  DISALLOW_COPY_AND_ASSIGN(RetrySequence);
 };
 
 }  // namespace policy
@@ -34,8 +34,8 @@
 #define SRC_COMPONENTS_POLICY_INCLUDE_POLICY_PT_EXCHANGE_IMPL_H_
 
 #include "application_manager/policies/pt_exchange_handler.h"
+#include "application_manager/policies/policy_retry_sequence.h"
 #include "utils/lock.h"
-#include "utils/threads/thread.h"
 
 namespace policy {
 
@@ -43,17 +43,15 @@ class PolicyHandler;
 
 class PTExchangeHandlerImpl : public PTExchangeHandler {
  public:
-  PTExchangeHandlerImpl(PolicyHandler* handler);
+  explicit PTExchangeHandlerImpl(PolicyHandler* handler);
   virtual ~PTExchangeHandlerImpl();
   virtual void Start();
   virtual void Stop();
 
  protected:
   PolicyHandler* policy_handler_;
-  threads::Thread* retry_sequence_;
+  RetrySequence retry_sequence_;
   sync_primitives::Lock retry_sequence_lock_;
-
-  friend class RetrySequence;
 };
 
 }  // namespace policy
@@ -36,6 +36,8 @@
 #include <climits>
 #include <vector>
 #include <list>
+#include <map>
+#include <deque>
 
 #include "utils/lock.h"
 #include "utils/shared_ptr.h"
@@ -47,7 +49,10 @@
 #include "interfaces/HMI_API.h"
 
 #include "application_manager/request_info.h"
+#include "application_manager/request_rate_limiter.h"
+#include "application_manager/scheduling_class.h"
 #include "utils/timer_thread.h"
+#include "utils/metrics_registry.h"
 
 
 namespace application_manager {
@@ -111,12 +116,16 @@ class RequestController {
     *
     * @param request     Active mobile request
     * @param hmi_level   Current application hmi_level
+    * @param scheduling_class Current scheduling class of application,
+    * ready applications of higher class are served first
     *
     * @return Result code
     *
     */
     TResult addMobileRequest(const RequestPtr request,
-                             const mobile_apis::HMILevel::eType& hmi_level);
+                             const mobile_apis::HMILevel::eType& hmi_level,
+                             SchedulingClass scheduling_class =
+                                 kSchedulingDefault);
 
 
     /**
@@ -222,7 +231,8 @@ class RequestController {
 
     /**
     * @brief Update timout for next OnTimer
-    * Not thread safe
+    * Timer is rearmed only if earliest timeout comes before it fires,
+    * otherwise it fires early and is rearmed from onTimer
     */
     void UpdateTimer();
 
@@ -232,9 +242,11 @@ class RequestController {
     /**
      * @brief Check Posibility to add new requests, or limits was exceeded
      * @param request - request to check possipility to Add
+     * @param hmi_level - hmi level of application sent request
      * @return True if new request could be added, false otherwise
      */
-    TResult CheckPosibilitytoAdd(const RequestPtr request);
+    TResult CheckPosibilitytoAdd(const RequestPtr request,
+                                 const mobile_apis::HMILevel::eType hmi_level);
 
     /**
      * @brief Check Posibility to add new requests, or limits was exceeded
@@ -244,6 +256,46 @@ class RequestController {
     bool CheckPendingRequestsAmount(const uint32_t& pending_requests_amount);
 
   private:
+    /*
+     * Requests of application waiting for execution.
+     * Application is run by single worker at once, so its requests
+     * are executed in order they were added.
+     */
+    struct AppRequests {
+      AppRequests()
+        : ready(false), busy(false), scheduling_class(kSchedulingDefault) {}
+      std::list<RequestPtr> requests;
+      // Application is put in ready_apps_
+      bool ready;
+      // Request of application is being executed by worker
+      bool busy;
+      // Class of ready_apps_ application is put in
+      SchedulingClass scheduling_class;
+    };
+    typedef std::map<uint32_t, AppRequests> AppRequestsMap;
+
+    /**
+     * @brief Takes next request of the first ready application of the
+     * highest scheduling class and marks application busy. Requires mobile_requests_lock_ taken.
+     * @param app_id - filled with connection key of application
+     * @param request - filled with request to execute
+     * @return false if there is no ready application
+     */
+    bool TakeReadyRequest(uint32_t* app_id, RequestPtr* request);
+
+    /**
+     * @brief Lets request of application next to executed one be taken
+     * @param app_id - connection key of application
+     */
+    void OnRequestExecuted(const uint32_t app_id);
+
+    /**
+     * @brief Puts application in the end of ready_apps_ of its
+     * scheduling class unless it is
+     * already there or busy. Requires mobile_requests_lock_ taken.
+     */
+    void MakeReady(AppRequestsMap::iterator it);
+
     class Worker : public threads::ThreadDelegate {
       public:
         explicit Worker(RequestController* requestController);
@@ -262,8 +314,13 @@ class RequestController {
     uint32_t pool_size_;
     sync_primitives::ConditionalVariable cond_var_;
 
-    std::list<RequestPtr> mobile_request_list_;
-    sync_primitives::Lock mobile_request_list_lock_;
+    AppRequestsMap mobile_requests_;
+    // Applications with requests to execute by scheduling class,
+    // served round robin within class
+    std::deque<uint32_t> ready_apps_[kSchedulingClassesCount];
+    // Total count of requests in mobile_requests_
+    size_t pending_requests_count_;
+    sync_primitives::Lock mobile_requests_lock_;
 
     /*
      * Requests, that are waiting for responses
@@ -272,6 +329,11 @@ class RequestController {
      */
     RequestInfoSet waiting_for_response_;
 
+    /*
+     * Limits of requests rate of applications
+     */
+    RequestRateLimiter rate_limiter_;
+
     /**
     * @brief Set of HMI notifications with timeout.
     */
@@ -282,8 +344,18 @@ class RequestController {
      */
     timer::TimerThread<RequestController> timer_;
     static const uint32_t dafault_sleep_time_ = UINT_MAX;
+    // Seconds since epoch timer_ fires at, 0 if it sleeps default time
+    uint64_t timer_end_time_;
+    sync_primitives::Lock timer_lock_;
 
     bool is_low_voltage_;
+
+    // Metrics are owned by registry and live until process exit
+    utils::metrics::Gauge* pending_requests_metric_;
+    utils::metrics::Counter* rejected_requests_metric_;
+    utils::metrics::Counter* expired_requests_metric_;
+    utils::metrics::Histogram* execution_time_metric_;
+    utils::metrics::Histogram* response_time_metric_;
     DISALLOW_COPY_AND_ASSIGN(RequestController);
 };
 
@@ -37,7 +37,8 @@
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_INFO_H_
 
 #include <stdint.h>
-#include <set>
+#include <map>
+#include <vector>
 
 #include "application_manager/commands/command_request_impl.h"
 #include "commands/hmi/request_to_hmi.h"
@@ -65,7 +66,7 @@ namespace request_controller {
                 const uint64_t timeout_sec)
       : request_(request),
         timeout_sec_(timeout_sec) {
-        start_time_ = date_time::DateTime::getCurrentTime();
+        start_time_ = date_time::DateTime::getMonotonicTime();
         updateEndTime();
         requst_type_ = requst_type;
       }
@@ -140,25 +141,12 @@ namespace request_controller {
                      const  uint64_t timeout_sec);
   };
 
-  // Request info, for searching in request info set by log_n time
-  // Returns correct hash by app_id and corr_id
-  struct FakeRequestInfo :public RequestInfo {
-      FakeRequestInfo(uint32_t app_id, uint32_t correaltion_id);
-  };
-
-  struct RequestInfoTimeComparator {
-      bool operator() (const RequestInfoPtr lhs,
-                       const RequestInfoPtr rhs) const;
-  };
-
-  struct RequestInfoHashComparator {
-      bool operator() (const RequestInfoPtr lhs,
-                       const RequestInfoPtr rhs) const;
-  };
-
-
-  typedef std::set<RequestInfoPtr, RequestInfoTimeComparator> TimeSortedRequestInfoSet;
-  typedef std::set<RequestInfoPtr, RequestInfoHashComparator> HashSortedRequestInfoSet;
+  /*
+   * @brief Requests by hash of app_id and correlation_id. App id takes high
+   * bits of hash, so requests of one app are neighbours and are found
+   * by range of keys.
+   */
+  typedef std::map<uint64_t, RequestInfoPtr> HashSortedRequestInfoMap;
 
   /*
    * @brief RequestInfoSet provides uniue requests bu corralation_id and app_id
@@ -183,17 +171,28 @@ namespace request_controller {
                           const uint32_t correlation_id);
 
       /*
-       * @brief Get request with smalest end_time_
+       * @brief Get request with smalest end_time_ by linear time
        * @return founded request or shared_ptr with NULL
        */
       RequestInfoPtr Front();
 
       /*
-       * @brief Get request with smalest end_time_ != 0
+       * @brief Get request with smalest end_time_ with timeout != 0
+       * by amortized log(n) time
        * @return founded request or shared_ptr with NULL
        */
       RequestInfoPtr FrontWithNotNullTimeout();
 
+      /*
+       * @brief Set new timeout of request by log(n) time,
+       * request stays in collection
+       * @param request_info - request to update
+       * @param timeout_sec - new timeout
+       * @return false if request is not in collection
+       */
+      bool UpdateTimeout(const RequestInfoPtr request_info,
+                         const uint64_t timeout_sec);
+
       /*
        * @brief Erase request from colletion by log(n) time
        * @param request_info - request to erase
@@ -219,149 +218,59 @@ namespace request_controller {
        */
       const size_t Size();
 
-      /**
-       * @brief Check if this app is able to add new requests,
-       * or limits was exceeded
-       * @param app_id - application id
-       * @param app_time_scale - time scale (seconds)
-       * @param max_request_per_time_scale - maximum count of request
-       * that should be allowed for app_time_scale seconds
-       * @return True if new request could be added, false otherwise
-       */
-      bool CheckTimeScaleMaxRequest(uint32_t app_id,
-                                    uint32_t app_time_scale,
-                                    uint32_t max_request_per_time_scale);
-
-      /**
-       * @brief Check if this app is able to add new requests
-       * in current hmi_level, or limits was exceeded
-       * @param hmi_level - hmi level
-       * @param app_id - application id
-       * @param app_time_scale - time scale (seconds)
-       * @param max_request_per_time_scale - maximum count of request
-       * that should be allowed for app_time_scale seconds
-       * @return True if new request could be added, false otherwise
-       */
-      bool CheckHMILevelTimeScaleMaxRequest(mobile_apis::HMILevel::eType hmi_level,
-                                            uint32_t app_id,
-                                            uint32_t app_time_scale,
-                                            uint32_t max_request_per_time_scale);
     private:
       /*
-       * @brief Comparator of connection key for std::find_if function
+       * @brief End time of request put in deadlines heap
+       * Entry is stale if request was removed or its end time was changed,
+       * such entries are dropped when they come to the top of heap.
+       */
+      struct Deadline {
+          Deadline(const RequestInfoPtr request_info)
+            : end_time(request_info->end_time()),
+              request_info(request_info) {}
+          TimevalStruct end_time;
+          RequestInfoPtr request_info;
+      };
+
+      /*
+       * @brief Puts earliest deadline to the front of heap
        */
-      struct AppIdCompararator {
-          enum CompareType {Equal, NotEqual};
-          AppIdCompararator(CompareType compare_type, uint32_t app_id):
-            app_id_(app_id),
-            compare_type_(compare_type) {}
-          bool operator()(const RequestInfoPtr value_compare) const;
-
-        private:
-          uint32_t app_id_;
-          CompareType compare_type_;
+      struct DeadlineComparator {
+          bool operator() (const Deadline& lhs, const Deadline& rhs) const;
       };
 
       bool Erase(const RequestInfoPtr request_info);
 
       /*
-       * @brief Erase requests from collection if filter allows
-       * @param filter - filtering predicate
-       * @return count of erased requests
+       * @brief Put request deadline into heap if request has timeout
        */
-      uint32_t RemoveRequests(const RequestInfoSet::AppIdCompararator& filter);
+      void PushDeadline(const RequestInfoPtr request_info);
 
       /*
-       * @brief Debug function, will raise assert if set sizes are noit equal
+       * @brief Check if deadline still belongs to request in collection
        */
-      inline void CheckSetSizes();
-      TimeSortedRequestInfoSet time_sorted_pending_requests_;
-      HashSortedRequestInfoSet hash_sorted_pending_requests_;
-
-      // the lock caled this_lock_, since the class represent collection by itself.
-      sync_primitives::Lock this_lock_;
-  };
-
+      bool IsActualDeadline(const Deadline& deadline);
 
-  /**
-  * @brief Structure used in std algorithms to determine amount of request
-  * during time scale
-  */
-  struct TimeScale {
-    TimeScale(const TimevalStruct& start,
-              const TimevalStruct& end,
-              const uint32_t& app_id)
-      : start_(start),
-        end_(end),
-        app_id_(app_id) {}
-
-    bool operator()(RequestInfoPtr setEntry) {
-      if (!setEntry.valid()) {
-        return false;
-      }
-
-      if (setEntry->app_id() != app_id_) {
-        return false;
-      }
-
-      if (date_time::DateTime::getmSecs(setEntry->start_time())
-          < date_time::DateTime::getmSecs(start_) ||
-          date_time::DateTime::getmSecs(setEntry->start_time())
-          > date_time::DateTime::getmSecs(end_)) {
-        return false;
-      }
-
-      return true;
-    }
-
-  private:
-    TimevalStruct  start_;
-    TimevalStruct  end_;
-    uint32_t       app_id_;
-  };
-
-  /**
-  * @brief Structure used in std algorithms to determine amount of request
-  * during time scale for application in defined hmi level
-  */
-  struct HMILevelTimeScale {
-    HMILevelTimeScale(const TimevalStruct& start,
-                      const TimevalStruct& end,
-                      const uint32_t& app_id,
-                      const mobile_apis::HMILevel::eType& hmi_level)
-      : start_(start),
-        end_(end),
-        app_id_(app_id),
-        hmi_level_(hmi_level) {}
-
-    bool operator()(RequestInfoPtr setEntry) {
-      if (!setEntry.valid()) {
-        return false;
-      }
-
-      if (setEntry->app_id() != app_id_) {
-        return false;
-      }
-
-      if (setEntry->hmi_level() != hmi_level_) {
-        return false;
-      }
+      /*
+       * @brief Rebuild heap of deadlines without stale entries
+       * once they take most of it
+       */
+      void CompactDeadlines();
 
-      if (date_time::DateTime::getSecs(setEntry->start_time())
-          < date_time::DateTime::getSecs(start_) ||
-          date_time::DateTime::getSecs(setEntry->start_time())
-          > date_time::DateTime::getSecs(end_)) {
-        return false;
-      }
+      /*
+       * @brief Erase requests of apps with ids in [first_app_id, last_app_id]
+       * by log(n) time plus count of erased requests
+       * @return count of erased requests
+       */
+      uint32_t RemoveAppsRange(const uint32_t first_app_id,
+                               const uint32_t last_app_id);
 
-      return true;
-    }
+      HashSortedRequestInfoMap hash_sorted_pending_requests_;
+      // Heap of end times of requests having not null timeout
+      std::vector<Deadline> deadlines_;
 
-  private:
-    TimevalStruct                start_;
-    TimevalStruct                end_;
-    uint32_t                     app_id_;
-    mobile_apis::HMILevel::eType hmi_level_;
+      // the lock caled this_lock_, since the class represent collection by itself.
+      sync_primitives::Lock this_lock_;
   };
 
 }  //  namespace request_controller
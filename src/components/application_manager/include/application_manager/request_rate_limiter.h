@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_RATE_LIMITER_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_RATE_LIMITER_H_
+
+#include <stdint.h>
+#include <map>
+
+#include "interfaces/MOBILE_API.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace application_manager {
+
+namespace request_controller {
+
+/**
+ * @brief Limits rate of requests of every application with token buckets:
+ * one for all requests and one for requests in HMI level NONE.
+ * Bucket holds up to max_requests requests and refills at
+ * max_requests per time_scale, so checking request costs the same
+ * regardless of how many requests are pending
+ */
+class RequestRateLimiter {
+ public:
+  enum Result {
+    ALLOWED,
+    TOO_MANY_REQUESTS,
+    NONE_HMI_LEVEL_MANY_REQUESTS
+  };
+
+  RequestRateLimiter();
+
+  /**
+   * @brief Takes token for request of application if there is one
+   * @param app_id Connection key of application
+   * @param hmi_level HMI level of application
+   * @param now_us Current time in microseconds
+   * @param time_scale Time scale in seconds of all requests
+   * @param max_requests Requests allowed during time scale, 0 disables check
+   * @param none_time_scale Time scale in seconds of requests in HMI NONE
+   * @param none_max_requests Requests allowed in HMI NONE during time scale,
+   * 0 disables check
+   * @return ALLOWED if request may be processed
+   */
+  Result TakeToken(uint32_t app_id, mobile_apis::HMILevel::eType hmi_level,
+                   int64_t now_us,
+                   uint32_t time_scale, uint32_t max_requests,
+                   uint32_t none_time_scale, uint32_t none_max_requests);
+
+  /**
+   * @brief Forgets buckets of application
+   */
+  void RemoveApplication(uint32_t app_id);
+
+ private:
+  /*
+   * Credit is kept in units where one request costs time scale in
+   * microseconds and every microsecond adds max requests, so refill is
+   * exact in integers
+   */
+  struct Bucket {
+    Bucket() : credit(-1), last_refill_us(0) {}
+    int64_t credit;
+    int64_t last_refill_us;
+  };
+  struct AppBuckets {
+    Bucket all;
+    Bucket hmi_none;
+  };
+
+  /**
+   * @brief Refills bucket for time passed since last refill
+   * @return true if bucket has token for request
+   */
+  static bool Refill(Bucket* bucket, int64_t now_us,
+                     uint32_t time_scale, uint32_t max_requests);
+  static void Take(Bucket* bucket, uint32_t time_scale);
+
+  std::map<uint32_t, AppBuckets> buckets_;
+  sync_primitives::Lock lock_;
+  DISALLOW_COPY_AND_ASSIGN(RequestRateLimiter);
+};
+
+}  // namespace request_controller
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_RATE_LIMITER_H_
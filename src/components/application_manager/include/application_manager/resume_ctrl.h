@@ -49,6 +49,10 @@
 #include "smart_objects/smart_object.h"
 #include "application_manager/application.h"
 #include "utils/timer_thread.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
 
 namespace application_manager {
 
@@ -66,6 +70,11 @@ class ResumeCtrl: public event_engine::EventObserver {
    */
     explicit ResumeCtrl(ApplicationManagerImpl* app_mngr);
 
+  /**
+   * @brief Destructor, waits for loading of resumption data
+   */
+    ~ResumeCtrl();
+
     /**
      * @brief Event, that raised if application get resumption response from HMI
      * @param event : event object, that contains smart_object with HMI message
@@ -237,6 +246,28 @@ class ResumeCtrl: public event_engine::EventObserver {
 
     typedef std::pair<uint32_t, uint32_t> application_timestamp;
 
+    /*
+     * @brief Versions of application maps written to saved application,
+     * unchanged map is not converted to json once again
+     */
+    struct SavedDataVersions {
+      explicit SavedDataVersions(uint32_t app_id)
+        : app_id(app_id),
+          commands(0),
+          sub_menu(0),
+          choice_set(0),
+          hmi_level(mobile_apis::HMILevel::INVALID_ENUM) {
+      }
+      uint32_t app_id;
+      uint32_t commands;
+      uint32_t sub_menu;
+      uint32_t choice_set;
+      // Application is saved on timer only if hash or level are changed
+      std::string hash;
+      mobile_apis::HMILevel::eType hmi_level;
+    };
+    typedef std::map<std::string, SavedDataVersions> SavedDataVersionsMap;
+
     std::set<ApplicationSharedPtr> retrieve_application();
 
     /**
@@ -464,6 +495,24 @@ class ResumeCtrl: public event_engine::EventObserver {
      */
     int GetObjectIndex(const std::string& mobile_app_id);
 
+    /**
+     * @brief Rebuilds index of saved applications, should be called
+     * after applications array is rebuilt
+     */
+    void UpdateSavedAppIndexes();
+
+    /**
+     * @brief Saves registered applications changed since last save
+     */
+    void SaveChangedApplications();
+
+    /**
+     * @brief Writes changed records of saved applications to LastState
+     * applications storage, removes dropped ones and saves LastState.
+     * Records are copied under resumtion_lock_, disk I/O is done without it
+     */
+    void PersistResumptionData();
+
     /**
      * @brief Timer callback for  restoring HMI Level
      *
@@ -475,6 +524,21 @@ class ResumeCtrl: public event_engine::EventObserver {
      */
     void LoadResumeData();
 
+    /**
+     * @brief Loads resumption data in background on start up, so parsing of
+     * saved applications doesn't delay readiness. Loader holds
+     * resumtion_lock_ while it loads, any access to saved applications waits
+     * for loading
+     */
+    class ResumeDataLoader : public threads::ThreadDelegate {
+      public:
+        explicit ResumeDataLoader(ResumeCtrl* resume_ctrl);
+        virtual void threadMain();
+      private:
+        ResumeCtrl* resume_ctrl_;
+        DISALLOW_COPY_AND_ASSIGN(ResumeDataLoader);
+    };
+
     /*
      * @brief Return true if application resumption data is valid,
      * otherwise false
@@ -511,9 +575,23 @@ class ResumeCtrl: public event_engine::EventObserver {
     timer::TimerThread<ResumeCtrl>  save_persistent_data_timer_;
     timer::TimerThread<ResumeCtrl>  restore_hmi_level_timer_;
     std::vector<uint32_t>           waiting_for_timer_;
+    SavedDataVersionsMap            saved_data_versions_;
+    Json::Value                     saved_applications_;
+    // Mobile application id to index in saved applications
+    std::map<std::string, Json::ArrayIndex> saved_app_indexes_;
+    // Saved applications changed since last persisting
+    std::set<std::string>           dirty_apps_;
+    bool                            is_all_apps_dirty_;
+    // Serializes persisting, so older records never overwrite newer ones
+    sync_primitives::Lock           persist_lock_;
     bool                            is_resumption_active_;
     bool                            is_data_saved;
     time_t                          launch_time_;
+    threads::Thread*                loader_thread_;
+    // Constructor returns after loader has taken resumtion_lock_
+    sync_primitives::Lock           loader_lock_;
+    sync_primitives::ConditionalVariable loader_started_;
+    bool                            is_loader_started_;
 };
 
 }  // namespace application_manager
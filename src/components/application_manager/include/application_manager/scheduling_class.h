@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_SCHEDULING_CLASS_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_SCHEDULING_CLASS_H_
+
+#include <string>
+
+#include "interfaces/MOBILE_API.h"
+
+namespace application_manager {
+
+/**
+ * @brief Classes of RPCs coming from mobile, RPCs of higher class are
+ * processed first, so interactions of application in foreground are not
+ * delayed by applications flooding from background
+ */
+enum SchedulingClass {
+  kSchedulingBackground = 0,
+  kSchedulingLimited,
+  kSchedulingForeground,
+  kSchedulingUrgent,
+  kSchedulingClassesCount
+};
+
+/**
+ * @brief Scheduling class of RPCs of connection without registered
+ * application, e.g. RegisterAppInterface
+ */
+const SchedulingClass kSchedulingDefault = kSchedulingLimited;
+
+/**
+ * @brief Gets scheduling class of application RPCs
+ * @param hmi_level Current HMI level of application
+ * @param is_navi_or_media True for navigation and media applications
+ * @param policy_priority Priority of application assigned by policy,
+ * e.g. "EMERGENCY" or "NORMAL", empty if there is none
+ * @return Scheduling class of RPCs
+ */
+SchedulingClass GetSchedulingClass(mobile_apis::HMILevel::eType hmi_level,
+                                   bool is_navi_or_media,
+                                   const std::string& policy_priority);
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_SCHEDULING_CLASS_H_
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_VEHICLE_DATA_CACHE_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_VEHICLE_DATA_CACHE_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+
+#include "smart_objects/smart_object.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace application_manager {
+
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+
+/**
+ * @brief Keeps vehicle data last got from HMI by OnVehicleData notifications
+ * and GetVehicleData responses, so GetVehicleData requests are answered
+ * without asking HMI while requested data is fresh.
+ * Only parameters having time to live set are cached
+ */
+class VehicleDataCache {
+ public:
+  // Milliseconds values of vehicle data parameters stay fresh for
+  typedef std::map<std::string, uint32_t> TimeToLiveMap;
+
+  explicit VehicleDataCache(const TimeToLiveMap& time_to_live);
+
+  /**
+   * @brief Reads times to live of parameters from [VehicleDataCache]
+   * section of profile, keys are names of parameters
+   */
+  static TimeToLiveMap TimeToLiveFromProfile();
+
+  /**
+   * @brief Stores values of cached parameters
+   * @param data msg_params of notification or response
+   * @param now_ms Current time in milliseconds
+   */
+  void Update(const smart_objects::SmartObject& data, int64_t now_ms);
+
+  /**
+   * @brief Takes values of requested parameters
+   * @param request Parameters of GetVehicleData request
+   * @param now_ms Current time in milliseconds
+   * @param data Map receiving values
+   * @return false if any parameter is not cached or is outdated,
+   * data is incomplete then
+   */
+  bool Get(const smart_objects::SmartObject& request, int64_t now_ms,
+           smart_objects::SmartObject* data) const;
+
+  /**
+   * @brief Forgets all values, e.g. when HMI is restarted
+   */
+  void Clear();
+
+  /**
+   * @brief Whether any parameter is cached, so cache is worth checking
+   */
+  bool enabled() const {
+    return !time_to_live_.empty();
+  }
+
+ private:
+  struct Entry {
+    smart_objects::SmartObject value;
+    int64_t updated_ms;
+  };
+  typedef std::map<std::string, Entry> EntryMap;
+
+  const TimeToLiveMap time_to_live_;
+  mutable sync_primitives::Lock entries_lock_;
+  EntryMap entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(VehicleDataCache);
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_VEHICLE_DATA_CACHE_H_
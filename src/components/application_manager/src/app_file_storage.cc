@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/app_file_storage.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "utils/file_system.h"
+#include "utils/gen_hash.h"
+#include "utils/logger.h"
+
+namespace application_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "ApplicationManager")
+
+namespace {
+// Uploads rarely go in parallel, least recently used files over the limit
+// are closed
+const size_t kMaxOpenFiles = 8;
+
+bool IsPrefix(const std::string& prefix, const std::string& path) {
+  return 0 == path.compare(0, prefix.size(), prefix);
+}
+
+bool WriteAll(int fd, const uint8_t* data, size_t size, int64_t offset) {
+  size_t written = 0;
+  while (written < size) {
+    const ssize_t result = pwrite(fd, data + written, size - written,
+                                  offset + written);
+    if (-1 == result) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return false;
+    }
+    written += result;
+  }
+  return true;
+}
+
+bool WriteFile(const std::string& file_path,
+               const uint8_t* data, size_t size) {
+  const int fd = open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                      S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP |
+                      S_IROTH | S_IWOTH);
+  if (-1 == fd) {
+    return false;
+  }
+  const bool result = WriteAll(fd, data, size, 0);
+  close(fd);
+  return result;
+}
+}  // namespace
+
+AppFileStorage::AppFileStorage()
+  : use_counter_(0) {
+}
+
+AppFileStorage::~AppFileStorage() {
+  for (OpenFiles::iterator it = open_files_.begin();
+       it != open_files_.end(); ++it) {
+    close(it->second.fd);
+  }
+}
+
+mobile_apis::Result::eType AppFileStorage::Write(
+    const std::string& directory, const std::string& file_name,
+    const uint8_t* data, size_t size, int64_t offset) {
+  const std::string file_path = directory + "/" + file_name;
+
+  int fd = TakeOpenFile(file_path);
+  int64_t file_size = 0;
+  if (-1 != fd) {
+    struct stat file_info = { 0 };
+    // File might be removed while it was kept open
+    if (0 == offset || 0 != fstat(fd, &file_info) ||
+        0 == file_info.st_nlink) {
+      close(fd);
+      fd = -1;
+    } else {
+      file_size = file_info.st_size;
+    }
+  }
+  if (-1 == fd) {
+    file_size = file_system::FileSize(file_path);
+    if (0 != offset && file_size != offset) {
+      LOG4CXX_INFO(logger_, "Offset " << offset << " doesn't match size "
+                   << file_size << " of " << file_path);
+      return mobile_apis::Result::INVALID_DATA;
+    }
+    // Content might be shared with files of other applications
+    if (0 == offset) {
+      unlink(file_path.c_str());
+    } else if (!Unshare(file_path)) {
+      LOG4CXX_ERROR(logger_, "Failed to unshare " << file_path);
+      return mobile_apis::Result::GENERIC_ERROR;
+    }
+    const int flags = O_WRONLY | O_CREAT | (0 == offset ? O_TRUNC : 0);
+    fd = open(file_path.c_str(), flags,
+              S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+    if (-1 == fd) {
+      LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to open " << file_path);
+      return mobile_apis::Result::GENERIC_ERROR;
+    }
+  } else if (file_size != offset) {
+    LOG4CXX_INFO(logger_, "Offset " << offset << " doesn't match size "
+                 << file_size << " of " << file_path);
+    PutOpenFile(file_path, fd);
+    return mobile_apis::Result::INVALID_DATA;
+  }
+
+  if (!WriteAll(fd, data, size, offset)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to write " << file_path);
+    close(fd);
+    Invalidate(file_path);
+    return mobile_apis::Result::GENERIC_ERROR;
+  }
+
+  const int64_t new_file_size = offset + size;
+  UpdateDirectorySize(directory, file_size, new_file_size);
+  PutOpenFile(file_path, fd);
+  return mobile_apis::Result::SUCCESS;
+}
+
+void AppFileStorage::SetSharedDirectory(const std::string& directory) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (!file_system::CreateDirectoryRecursively(directory)) {
+    LOG4CXX_ERROR(logger_, "Can't create " << directory);
+    return;
+  }
+  const std::vector<std::string> files = file_system::ListFiles(directory);
+  for (std::vector<std::string>::const_iterator it = files.begin();
+       it != files.end(); ++it) {
+    const std::string file_path = directory + "/" + *it;
+    struct stat file_info = { 0 };
+    if (0 == stat(file_path.c_str(), &file_info) &&
+        1 == file_info.st_nlink) {
+      LOG4CXX_DEBUG(logger_, "Content " << file_path << " is not used");
+      unlink(file_path.c_str());
+    }
+  }
+  sync_primitives::AutoLock lock(lock_);
+  shared_directory_ = directory;
+}
+
+mobile_apis::Result::eType AppFileStorage::WriteShared(
+    const std::string& directory, const std::string& file_name,
+    const uint8_t* data, size_t size, bool* is_present) {
+  DCHECK(is_present);
+  *is_present = false;
+  std::string shared_path;
+  {
+    sync_primitives::AutoLock lock(lock_);
+    if (!shared_directory_.empty()) {
+      std::ostringstream stream;
+      stream << shared_directory_ << "/" << std::hex
+             << utils::content_hash(data, size) << std::dec << "_" << size;
+      shared_path = stream.str();
+    }
+  }
+  if (shared_path.empty()) {
+    return Write(directory, file_name, data, size, 0);
+  }
+
+  const std::string file_path = directory + "/" + file_name;
+  struct stat shared_info = { 0 };
+  if (0 == stat(shared_path.c_str(), &shared_info)) {
+    std::vector<uint8_t> content;
+    if (!file_system::ReadBinaryFile(shared_path, content) ||
+        content.size() != size ||
+        !std::equal(content.begin(), content.end(), data)) {
+      LOG4CXX_WARN(logger_, "Content of " << shared_path << " differs, "
+                   << file_path << " is not shared");
+      return Write(directory, file_name, data, size, 0);
+    }
+    *is_present = true;
+  } else if (!WriteFile(shared_path, data, size) ||
+             0 != stat(shared_path.c_str(), &shared_info)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to write " << shared_path);
+    unlink(shared_path.c_str());
+    return Write(directory, file_name, data, size, 0);
+  }
+
+  struct stat file_info = { 0 };
+  if (0 == stat(file_path.c_str(), &file_info) &&
+      file_info.st_dev == shared_info.st_dev &&
+      file_info.st_ino == shared_info.st_ino) {
+    LOG4CXX_DEBUG(logger_, file_path << " already shares " << shared_path);
+    return mobile_apis::Result::SUCCESS;
+  }
+
+  const int fd = TakeOpenFile(file_path);
+  if (-1 != fd) {
+    close(fd);
+  }
+  UpdateDirectorySize(directory, file_system::FileSize(file_path), 0);
+  unlink(file_path.c_str());
+  if (0 != link(shared_path.c_str(), file_path.c_str())) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to link " << file_path);
+    return Write(directory, file_name, data, size, 0);
+  }
+  UpdateDirectorySize(directory, 0, size);
+  return mobile_apis::Result::SUCCESS;
+}
+
+size_t AppFileStorage::DirectorySize(const std::string& directory) {
+  sync_primitives::AutoLock lock(lock_);
+  DirectorySizes::const_iterator it = directory_sizes_.find(directory);
+  if (directory_sizes_.end() != it) {
+    return it->second;
+  }
+  const size_t size = file_system::DirectorySize(directory);
+  directory_sizes_.insert(std::make_pair(directory, size));
+  return size;
+}
+
+void AppFileStorage::Invalidate(const std::string& path) {
+  sync_primitives::AutoLock lock(lock_);
+  for (OpenFiles::iterator it = open_files_.begin();
+       it != open_files_.end();) {
+    if (IsPrefix(path, it->first)) {
+      close(it->second.fd);
+      open_files_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  for (DirectorySizes::iterator it = directory_sizes_.begin();
+       it != directory_sizes_.end();) {
+    if (IsPrefix(it->first + "/", path) || IsPrefix(path, it->first)) {
+      directory_sizes_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+int AppFileStorage::TakeOpenFile(const std::string& file_path) {
+  sync_primitives::AutoLock lock(lock_);
+  OpenFiles::iterator it = open_files_.find(file_path);
+  if (open_files_.end() == it) {
+    return -1;
+  }
+  const int fd = it->second.fd;
+  open_files_.erase(it);
+  return fd;
+}
+
+void AppFileStorage::PutOpenFile(const std::string& file_path, int fd) {
+  sync_primitives::AutoLock lock(lock_);
+  OpenFile& file = open_files_[file_path];
+  file.fd = fd;
+  file.last_use = ++use_counter_;
+  if (open_files_.size() <= kMaxOpenFiles) {
+    return;
+  }
+  OpenFiles::iterator oldest = open_files_.begin();
+  for (OpenFiles::iterator it = open_files_.begin();
+       it != open_files_.end(); ++it) {
+    if (it->second.last_use < oldest->second.last_use) {
+      oldest = it;
+    }
+  }
+  close(oldest->second.fd);
+  open_files_.erase(oldest);
+}
+
+bool AppFileStorage::Unshare(const std::string& file_path) {
+  struct stat file_info = { 0 };
+  if (0 != stat(file_path.c_str(), &file_info) || 1 >= file_info.st_nlink) {
+    return true;
+  }
+  std::vector<uint8_t> content;
+  const std::string temp_path = file_path + ".tmp";
+  return file_system::ReadBinaryFile(file_path, content) &&
+         WriteFile(temp_path, content.data(), content.size()) &&
+         0 == rename(temp_path.c_str(), file_path.c_str());
+}
+
+void AppFileStorage::UpdateDirectorySize(const std::string& directory,
+                                         int64_t old_file_size,
+                                         int64_t new_file_size) {
+  sync_primitives::AutoLock lock(lock_);
+  DirectorySizes::iterator it = directory_sizes_.find(directory);
+  if (directory_sizes_.end() == it) {
+    return;
+  }
+  const int64_t size =
+      static_cast<int64_t>(it->second) + new_file_size - old_file_size;
+  it->second = size > 0 ? static_cast<size_t>(size) : 0;
+}
+
+}  // namespace application_manager
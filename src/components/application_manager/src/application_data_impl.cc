@@ -33,7 +33,9 @@
 #include <algorithm>
 
 #include "application_manager/application_data_impl.h"
+#include "application_manager/message_helper.h"
 #include "application_manager/smart_object_keys.h"
+#include "utils/memory_accounting.h"
 #include "utils/logger.h"
 
 namespace application_manager {
@@ -165,9 +167,14 @@ DynamicApplicationDataImpl::DynamicApplicationDataImpl()
       menu_icon_(NULL),
       tbt_show_command_(NULL),
       commands_(),
+      commands_version_(0),
       commands_lock_(true),
       sub_menu_(),
+      sub_menu_names_(),
+      sub_menu_version_(0),
       choice_set_map_(),
+      choice_ids_(),
+      choice_set_version_(0),
       performinteraction_choice_set_map_(),
       is_perform_interaction_active_(false),
       perform_interaction_ui_corrid_(0),
@@ -217,6 +224,7 @@ DynamicApplicationDataImpl::~DynamicApplicationDataImpl() {
     delete sub_menu_it->second;
   }
   sub_menu_.clear();
+  sub_menu_names_.clear();
 
   PerformChoiceSetMap::iterator it = performinteraction_choice_set_map_.begin();
   for (; performinteraction_choice_set_map_.end() != it; ++it) {
@@ -407,14 +415,18 @@ void DynamicApplicationDataImpl::AddCommand(
   uint32_t cmd_id, const smart_objects::SmartObject& command) {
   sync_primitives::AutoLock lock(commands_lock_);
   commands_[cmd_id] = new smart_objects::SmartObject(command);
+  ChargeAppState(command);
+  ++commands_version_;
 }
 
 void DynamicApplicationDataImpl::RemoveCommand(uint32_t cmd_id) {
   sync_primitives::AutoLock lock(commands_lock_);
   CommandsMap::iterator it = commands_.find(cmd_id);
   if (commands_.end() != it) {
+    ReleaseAppState(*it->second);
     delete it->second;
     commands_.erase(it);
+    ++commands_version_;
   }
 }
 
@@ -433,7 +445,18 @@ smart_objects::SmartObject* DynamicApplicationDataImpl::FindCommand(
 void DynamicApplicationDataImpl::AddSubMenu(
   uint32_t menu_id, const smart_objects::SmartObject& menu) {
   sync_primitives::AutoLock lock(sub_menu_lock_);
+  SubMenuMap::iterator it = sub_menu_.find(menu_id);
+  if (sub_menu_.end() != it) {
+    EraseSubMenuName(*it->second);
+    ReleaseAppState(*it->second);
+    delete it->second;
+  }
   sub_menu_[menu_id] = new smart_objects::SmartObject(menu);
+  ChargeAppState(menu);
+  if (menu.keyExists(strings::menu_name)) {
+    sub_menu_names_.insert(menu[strings::menu_name].asString());
+  }
+  ++sub_menu_version_;
 }
 
 void DynamicApplicationDataImpl::RemoveSubMenu(uint32_t menu_id) {
@@ -441,8 +464,11 @@ void DynamicApplicationDataImpl::RemoveSubMenu(uint32_t menu_id) {
   SubMenuMap::iterator it = sub_menu_.find(menu_id);
 
   if (sub_menu_.end() != it) {
+    EraseSubMenuName(*it->second);
+    ReleaseAppState(*it->second);
     delete it->second;
     sub_menu_.erase(menu_id);
+    ++sub_menu_version_;
   }
 }
 
@@ -460,21 +486,42 @@ smart_objects::SmartObject* DynamicApplicationDataImpl::FindSubMenu(
 bool DynamicApplicationDataImpl::IsSubMenuNameAlreadyExist(
     const std::string& name) {
   sync_primitives::AutoLock lock(sub_menu_lock_);
-  for (SubMenuMap::iterator it = sub_menu_.begin();
-       sub_menu_.end() != it;
-       ++it) {
-    smart_objects::SmartObject* menu = it->second;
-    if ((*menu)[strings::menu_name] == name) {
-      return true;
-    }
+  return sub_menu_names_.end() != sub_menu_names_.find(name);
+}
+
+void DynamicApplicationDataImpl::EraseSubMenuName(
+    const smart_objects::SmartObject& menu) {
+  if (!menu.keyExists(strings::menu_name)) {
+    return;
+  }
+  std::multiset<std::string>::iterator it =
+      sub_menu_names_.find(menu[strings::menu_name].asString());
+  if (sub_menu_names_.end() != it) {
+    sub_menu_names_.erase(it);
   }
-  return false;
 }
 
 void DynamicApplicationDataImpl::AddChoiceSet(
   uint32_t choice_set_id, const smart_objects::SmartObject& choice_set) {
   sync_primitives::AutoLock lock(choice_set_map_lock_);
+  ChoiceSetMap::iterator it = choice_set_map_.find(choice_set_id);
+  if (choice_set_map_.end() != it) {
+    EraseChoiceIds(*it->second);
+    ReleaseAppState(*it->second);
+    delete it->second;
+    hmi_cached_choice_sets_.erase(choice_set_id);
+  }
   choice_set_map_[choice_set_id] = new smart_objects::SmartObject(choice_set);
+  ChargeAppState(choice_set);
+  const smart_objects::SmartArray* choices =
+      choice_set[strings::choice_set].asArray();
+  if (choices) {
+    for (smart_objects::SmartArray::const_iterator choice = choices->begin();
+         choices->end() != choice; ++choice) {
+      choice_ids_.insert((*choice)[strings::choice_id].asUInt());
+    }
+  }
+  ++choice_set_version_;
 }
 
 void DynamicApplicationDataImpl::RemoveChoiceSet(uint32_t choice_set_id) {
@@ -482,8 +529,12 @@ void DynamicApplicationDataImpl::RemoveChoiceSet(uint32_t choice_set_id) {
   ChoiceSetMap::iterator it = choice_set_map_.find(choice_set_id);
 
   if (choice_set_map_.end() != it) {
+    EraseChoiceIds(*it->second);
+    ReleaseAppState(*it->second);
     delete it->second;
     choice_set_map_.erase(choice_set_id);
+    hmi_cached_choice_sets_.erase(choice_set_id);
+    ++choice_set_version_;
   }
 }
 
@@ -498,6 +549,99 @@ smart_objects::SmartObject* DynamicApplicationDataImpl::FindChoiceSet(
   return NULL;
 }
 
+bool DynamicApplicationDataImpl::IsChoiceIdAlreadyExist(
+    uint32_t choice_id) const {
+  sync_primitives::AutoLock lock(choice_set_map_lock_);
+  return choice_ids_.end() != choice_ids_.find(choice_id);
+}
+
+void DynamicApplicationDataImpl::set_choice_set_cached_on_hmi(
+    uint32_t choice_set_id, bool cached) {
+  sync_primitives::AutoLock lock(choice_set_map_lock_);
+  if (!cached) {
+    hmi_cached_choice_sets_.erase(choice_set_id);
+  } else if (choice_set_map_.end() != choice_set_map_.find(choice_set_id)) {
+    hmi_cached_choice_sets_.insert(choice_set_id);
+  }
+}
+
+bool DynamicApplicationDataImpl::is_choice_set_cached_on_hmi(
+    uint32_t choice_set_id) const {
+  sync_primitives::AutoLock lock(choice_set_map_lock_);
+  return hmi_cached_choice_sets_.end() !=
+      hmi_cached_choice_sets_.find(choice_set_id);
+}
+
+void DynamicApplicationDataImpl::EraseChoiceIds(
+    const smart_objects::SmartObject& choice_set) {
+  const smart_objects::SmartArray* choices =
+      choice_set[strings::choice_set].asArray();
+  if (!choices) {
+    return;
+  }
+  for (smart_objects::SmartArray::const_iterator choice = choices->begin();
+       choices->end() != choice; ++choice) {
+    std::multiset<uint32_t>::iterator it =
+        choice_ids_.find((*choice)[strings::choice_id].asUInt());
+    if (choice_ids_.end() != it) {
+      choice_ids_.erase(it);
+    }
+  }
+}
+
+void DynamicApplicationDataImpl::ChargeAppState(
+    const smart_objects::SmartObject& object) {
+  utils::MemoryAccounting::instance()->Charge(
+      app_id(), utils::MemoryAccounting::kAppState,
+      MessageHelper::EstimateMemorySize(object));
+}
+
+void DynamicApplicationDataImpl::ReleaseAppState(
+    const smart_objects::SmartObject& object) {
+  utils::MemoryAccounting::instance()->Release(
+      app_id(), utils::MemoryAccounting::kAppState,
+      MessageHelper::EstimateMemorySize(object));
+}
+
+uint64_t DynamicApplicationDataImpl::AppStateMemorySize() const {
+  uint64_t size = 0;
+  {
+    sync_primitives::AutoLock lock(commands_lock_);
+    for (CommandsMap::const_iterator it = commands_.begin();
+         commands_.end() != it; ++it) {
+      size += MessageHelper::EstimateMemorySize(*it->second);
+    }
+  }
+  {
+    sync_primitives::AutoLock lock(sub_menu_lock_);
+    for (SubMenuMap::const_iterator it = sub_menu_.begin();
+         sub_menu_.end() != it; ++it) {
+      size += MessageHelper::EstimateMemorySize(*it->second);
+    }
+  }
+  sync_primitives::AutoLock lock(choice_set_map_lock_);
+  for (ChoiceSetMap::const_iterator it = choice_set_map_.begin();
+       choice_set_map_.end() != it; ++it) {
+    size += MessageHelper::EstimateMemorySize(*it->second);
+  }
+  return size;
+}
+
+uint32_t DynamicApplicationDataImpl::commands_version() const {
+  sync_primitives::AutoLock lock(commands_lock_);
+  return commands_version_;
+}
+
+uint32_t DynamicApplicationDataImpl::sub_menu_version() const {
+  sync_primitives::AutoLock lock(sub_menu_lock_);
+  return sub_menu_version_;
+}
+
+uint32_t DynamicApplicationDataImpl::choice_set_version() const {
+  sync_primitives::AutoLock lock(choice_set_map_lock_);
+  return choice_set_version_;
+}
+
 void DynamicApplicationDataImpl::AddPerformInteractionChoiceSet(
   uint32_t choice_set_id, const smart_objects::SmartObject& vr_commands) {
   sync_primitives::AutoLock lock(performinteraction_choice_set_lock_);
@@ -33,6 +33,7 @@
 #include <string>
 #include <strings.h>
 #include "application_manager/application_impl.h"
+#include "application_manager/application_manager_impl.h"
 #include "application_manager/message_helper.h"
 #include "functional_module/plugin_manager.h"
 #include "config_profile/profile.h"
@@ -40,6 +41,7 @@
 #include "utils/file_system.h"
 #include "utils/logger.h"
 #include "utils/gen_hash.h"
+#include "utils/memory_accounting.h"
 
 namespace {
 
@@ -99,6 +101,7 @@ ApplicationImpl::ApplicationImpl(uint32_t application_id,
       system_context_(mobile_api::SystemContext::SYSCTXT_MAIN),
       audio_streaming_state_(mobile_api::AudioStreamingState::NOT_AUDIBLE),
       device_(0),
+      subscriptions_observer_(NULL),
       usage_report_(mobile_app_id, statistics_manager),
       protocol_version_(ProtocolVersion::kV3),
       is_voice_communication_application_(false),
@@ -140,6 +143,9 @@ ApplicationImpl::~ApplicationImpl() {
     DeletePerformInteractionChoiceSetMap();
   }
   CleanupFiles();
+  // Commands, sub menus and choice sets are deleted by base class destructor
+  utils::MemoryAccounting::instance()->Release(
+      app_id(), utils::MemoryAccounting::kAppState, AppStateMemorySize());
 }
 
 void ApplicationImpl::CloseActiveMessage() {
@@ -178,6 +184,7 @@ bool ApplicationImpl::IsAudible() const {
 
 void ApplicationImpl::set_is_navi(bool allow) {
   is_navi_ = allow;
+  UpdateSchedulingClass();
 }
 
 bool ApplicationImpl::is_voice_communication_supported() const {
@@ -266,6 +273,7 @@ void ApplicationImpl::set_name(const std::string& name) {
 
 void ApplicationImpl::set_is_media_application(bool is_media) {
   is_media_ = is_media;
+  UpdateSchedulingClass();
   // Audio streaming state for non-media application can not be different
   // from NOT_AUDIBLE
   if (!is_media)
@@ -308,6 +316,7 @@ void ApplicationImpl::set_hmi_level(
   }
   LOG4CXX_INFO(logger_, "hmi_level = " << hmi_level);
   hmi_level_ = hmi_level;
+  UpdateSchedulingClass();
   usage_report_.RecordHmiStateChanged(hmi_level);
 }
 
@@ -522,7 +531,12 @@ const AppFile* ApplicationImpl::GetFile(const std::string& file_name) {
 bool ApplicationImpl::SubscribeToButton(mobile_apis::ButtonName::eType btn_name) {
   size_t old_size = subscribed_buttons_.size();
   subscribed_buttons_.insert(btn_name);
-  return (subscribed_buttons_.size() == old_size + 1);
+  const bool subscribed = (subscribed_buttons_.size() == old_size + 1);
+  if (subscribed && subscriptions_observer_) {
+    subscriptions_observer_->OnButtonSubscriptionChanged(app_id(), btn_name,
+                                                         true);
+  }
+  return subscribed;
 }
 
 bool ApplicationImpl::IsSubscribedToButton(mobile_apis::ButtonName::eType btn_name) {
@@ -533,13 +547,23 @@ bool ApplicationImpl::IsSubscribedToButton(mobile_apis::ButtonName::eType btn_na
 bool ApplicationImpl::UnsubscribeFromButton(mobile_apis::ButtonName::eType btn_name) {
   size_t old_size = subscribed_buttons_.size();
   subscribed_buttons_.erase(btn_name);
-  return (subscribed_buttons_.size() == old_size - 1);
+  const bool unsubscribed = (subscribed_buttons_.size() == old_size - 1);
+  if (unsubscribed && subscriptions_observer_) {
+    subscriptions_observer_->OnButtonSubscriptionChanged(app_id(), btn_name,
+                                                         false);
+  }
+  return unsubscribed;
 }
 
 bool ApplicationImpl::SubscribeToIVI(uint32_t vehicle_info_type_) {
   size_t old_size = subscribed_vehicle_info_.size();
   subscribed_vehicle_info_.insert(vehicle_info_type_);
-  return (subscribed_vehicle_info_.size() == old_size + 1);
+  const bool subscribed = (subscribed_vehicle_info_.size() == old_size + 1);
+  if (subscribed && subscriptions_observer_) {
+    subscriptions_observer_->OnIVISubscriptionChanged(app_id(),
+                                                      vehicle_info_type_, true);
+  }
+  return subscribed;
 }
 
 bool ApplicationImpl::IsSubscribedToIVI(uint32_t vehicle_info_type_) {
@@ -551,29 +575,42 @@ bool ApplicationImpl::IsSubscribedToIVI(uint32_t vehicle_info_type_) {
 bool ApplicationImpl::UnsubscribeFromIVI(uint32_t vehicle_info_type_) {
   size_t old_size = subscribed_vehicle_info_.size();
   subscribed_vehicle_info_.erase(vehicle_info_type_);
-  return (subscribed_vehicle_info_.size() == old_size - 1);
+  const bool unsubscribed = (subscribed_vehicle_info_.size() == old_size - 1);
+  if (unsubscribed && subscriptions_observer_) {
+    subscriptions_observer_->OnIVISubscriptionChanged(app_id(),
+                                                      vehicle_info_type_,
+                                                      false);
+  }
+  return unsubscribed;
 }
 
-bool ApplicationImpl::SubscribeToInteriorVehicleData(smart_objects::SmartObject module) {
-  //size_t old_size = subscribed_interior_vehicle_data_.size();
-  subscribed_interior_vehicle_data_.push_front(module);
-  return true;//(subscribed_interior_vehicle_data_.size() == old_size + 1);
+void ApplicationImpl::set_subscriptions_observer(
+    SubscriptionsObserver* observer) {
+  subscriptions_observer_ = observer;
 }
 
-bool ApplicationImpl::IsSubscribedToInteriorVehicleData(smart_objects::SmartObject module){
-  for(auto it = subscribed_interior_vehicle_data_.begin(); it!=subscribed_interior_vehicle_data_.end(); ++it){
-    if(*it==module){
-      return true;
-    }
+bool ApplicationImpl::SubscribeToInteriorVehicleData(smart_objects::SmartObject module) {
+  const std::string key = MessageHelper::InteriorModuleKey(module);
+  const bool subscribed = subscribed_interior_vehicle_data_.insert(key).second;
+  if (subscribed && subscriptions_observer_) {
+    subscriptions_observer_->OnInteriorVehicleDataSubscriptionChanged(
+        app_id(), key, true);
   }
-  return false;
+  return true;
+}
 
-  //std::set<smart_objects::SmartObject>::iterator it = subscribed_interior_vehicle_data_.find(module);
- // return(subscribed_interior_vehicle_data_.end()._M_node!=it._M_node); //!= subscribed_interior_vehicle_data_.find(module));
+bool ApplicationImpl::IsSubscribedToInteriorVehicleData(smart_objects::SmartObject module){
+  return subscribed_interior_vehicle_data_.end() !=
+         subscribed_interior_vehicle_data_.find(
+             MessageHelper::InteriorModuleKey(module));
 }
 
 bool ApplicationImpl::UnsubscribeFromInteriorVehicleData(smart_objects::SmartObject module){
-  subscribed_interior_vehicle_data_.remove(module);
+  const std::string key = MessageHelper::InteriorModuleKey(module);
+  if (subscribed_interior_vehicle_data_.erase(key) && subscriptions_observer_) {
+    subscriptions_observer_->OnInteriorVehicleDataSubscriptionChanged(
+        app_id(), key, false);
+  }
   return true;
 }
 
@@ -691,7 +728,8 @@ const std::string& ApplicationImpl::curHash() const {
 
 void ApplicationImpl::UpdateHash() {
   LOG4CXX_AUTO_TRACE(logger_);
-  hash_val_ = utils::gen_hash(profile::Profile::instance()->hash_string_size());
+  hash_val_ = utils::gen_hash(
+      profile::Profile::instance()->snapshot().hash_string_size);
   MessageHelper::SendHashUpdateNotification(app_id());
 }
 
@@ -719,6 +757,10 @@ void ApplicationImpl::CleanupFiles() {
     }
 
     file_system::RemoveDirectory(directory_name, false);
+    // Applications are also destroyed along with application manager
+    if (ApplicationManagerImpl::exists()) {
+      ApplicationManagerImpl::instance()->OnAppStorageChanged(directory_name);
+    }
   }
   app_files_.clear();
 }
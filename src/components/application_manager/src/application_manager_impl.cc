@@ -30,11 +30,14 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <pthread.h>
 #include <stdlib.h>  // for rand()
 
 #include <climits>
 #include <string>
 #include <fstream>
+#include <list>
+#include <memory>
 #include <utility>
 
 #include "application_manager/application_manager_impl.h"
@@ -53,12 +56,18 @@
 #include "utils/threads/thread.h"
 #include "utils/file_system.h"
 #include "utils/helpers.h"
+#include "utils/arena.h"
+#include "utils/memory_accounting.h"
+#include "utils/scoped_string_buffer.h"
 #include "smart_objects/enum_schema_item.h"
 #include "interfaces/HMI_API_schema.h"
 #include "application_manager/application_impl.h"
 #include "usage_statistics/counter.h"
 #include "functional_module/plugin_manager.h"
 #include <time.h>
+#ifdef TIME_TESTER
+#include "utils/rpc_trace.h"
+#endif  // TIME_TESTER
 
 namespace {
   int get_rand_from_range(uint32_t from = 0, int to = RAND_MAX) {
@@ -78,8 +87,86 @@ namespace jhs = NsSmartDeviceLink::NsJSONHandler::strings;
 
 using namespace NsSmartDeviceLink::NsSmartObjects;
 
+namespace {
+// Json of notification params shared by messages of one batch
+struct BatchedJson {
+  int32_t function_id;
+  smart_objects::SmartObject msg_params;
+  SerializedJson json;
+};
+
+struct ThreadMessageBatch {
+  ThreadMessageBatch() : depth(0), hmi_depth(0) {}
+  // Nested batches are posted by the outermost one
+  size_t depth;
+  std::vector<impl::MessageToMobile> messages;
+  // List keeps pointers to json valid while batch grows
+  std::list<BatchedJson> jsons;
+  size_t hmi_depth;
+  std::vector<impl::MessageToHmi> hmi_messages;
+};
+
+pthread_key_t message_batch_key;
+pthread_once_t message_batch_key_once = PTHREAD_ONCE_INIT;
+
+// Called on thread exit
+void DestroyMessageBatch(void* data) {
+  delete static_cast<ThreadMessageBatch*>(data);
+}
+
+void CreateMessageBatchKey() {
+  pthread_key_create(&message_batch_key, &DestroyMessageBatch);
+}
+
+ThreadMessageBatch* ThisThreadBatch(bool create) {
+  pthread_once(&message_batch_key_once, &CreateMessageBatchKey);
+  ThreadMessageBatch* batch =
+      static_cast<ThreadMessageBatch*>(pthread_getspecific(message_batch_key));
+  if (!batch && create) {
+    batch = new ThreadMessageBatch();
+    pthread_setspecific(message_batch_key, batch);
+  }
+  return batch;
+}
+
+SerializedJson* BatchedJsonFor(ThreadMessageBatch* batch,
+                               const smart_objects::SmartObject& message) {
+  const int32_t function_id =
+      message[strings::params][strings::function_id].asInt();
+  const smart_objects::SmartObject& msg_params = message[strings::msg_params];
+  std::list<BatchedJson>::iterator it = batch->jsons.begin();
+  for (; batch->jsons.end() != it; ++it) {
+    if (it->function_id == function_id && it->msg_params == msg_params) {
+      return &it->json;
+    }
+  }
+  batch->jsons.push_back(BatchedJson());
+  BatchedJson& batched = batch->jsons.back();
+  batched.function_id = function_id;
+  batched.msg_params = msg_params;
+  return &batched.json;
+}
+}  // namespace
+
+ApplicationManagerImpl::MobileMessageBatch::MobileMessageBatch() {
+  ApplicationManagerImpl::instance()->BeginMobileMessageBatch();
+}
+
+ApplicationManagerImpl::MobileMessageBatch::~MobileMessageBatch() {
+  ApplicationManagerImpl::instance()->EndMobileMessageBatch();
+}
+
+ApplicationManagerImpl::HMIMessageBatch::HMIMessageBatch() {
+  ApplicationManagerImpl::instance()->BeginHMIMessageBatch();
+}
+
+ApplicationManagerImpl::HMIMessageBatch::~HMIMessageBatch() {
+  ApplicationManagerImpl::instance()->EndHMIMessageBatch();
+}
+
 ApplicationManagerImpl::ApplicationManagerImpl()
-  : applications_list_lock_(true),
+  : applications_snapshot_(utils::MakeShared<ApplictionSet>()),
+    applications_list_lock_(true),
     audio_pass_thru_active_(false),
     is_distracting_driver_(false),
     is_vr_session_strated_(false),
@@ -93,11 +180,14 @@ ApplicationManagerImpl::ApplicationManagerImpl()
     hmi_so_factory_(NULL),
     mobile_so_factory_(NULL),
     messages_from_mobile_("AM FromMobile", this),
+    from_mobile_parser_(this),
+    parsing_pool_(NULL),
     messages_to_mobile_("AM ToMobile", this),
     messages_from_hmi_("AM FromHMI", this),
     messages_to_hmi_("AM ToHMI", this),
     audio_pass_thru_messages_("AudioPassThru", this),
     hmi_capabilities_(this),
+    vehicle_data_cache_(VehicleDataCache::TimeToLiveFromProfile()),
     unregister_reason_(mobile_api::AppInterfaceUnregisteredReason::INVALID_ENUM),
     resume_ctrl_(this),
     end_services_timer("EndServiceTimer", this, &ApplicationManagerImpl::EndNaviServices),
@@ -106,6 +196,9 @@ ApplicationManagerImpl::ApplicationManagerImpl()
     metric_observer_(NULL),
 #endif  // TIME_TESTER
     application_list_update_timer_(new ApplicationListUpdateTimer(this)),
+    app_list_publisher_(this, &ApplicationManagerImpl::SendPendingUpdateAppList),
+    device_list_publisher_(this,
+                           &ApplicationManagerImpl::SendPendingUpdateDeviceList),
     tts_global_properties_timer_("TTSGLPRTimer",
                                       this,
                                       &ApplicationManagerImpl::OnTimerSendTTSGlobalProperties,
@@ -113,17 +206,42 @@ ApplicationManagerImpl::ApplicationManagerImpl()
     is_low_voltage_(false) {
     std::srand(std::time(0));
     AddPolicyObserver(this);
+    applications_list_lock_.set_name("applications_list_lock_");
 
     dir_type_to_string_map_ = {
       {TYPE_STORAGE, "Storage"},
       {TYPE_SYSTEM, "System"},
       {TYPE_ICONS, "Icons"}
     };
+
+    const uint32_t parsing_threads =
+        profile::Profile::instance()->from_mobile_parsing_threads();
+    if (parsing_threads > 0) {
+      // Factory is used by parsing threads, so it is created beforehand
+      mobile_so_factory();
+      parsing_pool_ = new threads::ThreadPool("AM Parse", parsing_threads);
+      // More queues than threads, so chatty application rarely
+      // shares its queue with others
+      const uint32_t queues_per_thread = 4;
+      const uint32_t queues_count = parsing_threads * queues_per_thread;
+      for (uint32_t i = 0; i < queues_count; ++i) {
+        parsing_queues_.push_back(new impl::FromMobileQueue(
+            "AM Parse", &from_mobile_parser_, parsing_pool_));
+      }
+    }
 }
 
 ApplicationManagerImpl::~ApplicationManagerImpl() {
   LOG4CXX_INFO(logger_, "Destructing ApplicationManager.");
 
+  // Parsed messages are passed on to messages_from_mobile_
+  for (size_t i = 0; i < parsing_queues_.size(); ++i) {
+    delete parsing_queues_[i];
+  }
+  parsing_queues_.clear();
+  delete parsing_pool_;
+  parsing_pool_ = NULL;
+
   SendOnSDLClose();
   media_manager_ = NULL;
   hmi_handler_ = NULL;
@@ -146,6 +264,8 @@ ApplicationManagerImpl::~ApplicationManagerImpl() {
 bool ApplicationManagerImpl::Stop() {
   LOG4CXX_INFO(logger_, "Stop ApplicationManager.");
   application_list_update_timer_->stop();
+  app_list_publisher_.Cancel();
+  device_list_publisher_.Cancel();
   try {
     UnregisterAllApplications();
   } catch (...) {
@@ -161,10 +281,60 @@ bool ApplicationManagerImpl::Stop() {
   return true;
 }
 
+namespace {
+template<typename Index, typename Key>
+ApplicationSharedPtr FindInIndex(const Index& index, const Key& key) {
+  typename Index::const_iterator it = index.find(key);
+  return index.end() != it ? it->second : ApplicationSharedPtr();
+}
+
+/*
+ * Marks notifications which are stale once newer one of the same
+ * application is sent: vehicle data with the same parameters,
+ * touch moves of the same touches and HMI status
+ */
+void SetCoalescingKey(const smart_objects::SmartObject& message,
+                      impl::MessageToMobile* message_to_mobile) {
+  const smart_objects::SmartObject& params = message[strings::params];
+  const smart_objects::SmartObject& msg_params = message[strings::msg_params];
+  const int32_t function_id = params[strings::function_id].asInt();
+  std::string key;
+  switch (function_id) {
+    case mobile_apis::FunctionID::OnVehicleDataID: {
+      const std::set<std::string> keys = msg_params.enumerate();
+      for (std::set<std::string>::const_iterator it = keys.begin();
+           it != keys.end(); ++it) {
+        key += *it + '\n';
+      }
+      break;
+    }
+    case mobile_apis::FunctionID::OnTouchEventID: {
+      if (mobile_apis::TouchType::MOVE != msg_params[strings::type].asInt()) {
+        return;
+      }
+      const smart_objects::SmartObject& events = msg_params["event"];
+      for (size_t i = 0; i < events.length(); ++i) {
+        std::stringstream id;
+        id << events[i][strings::id].asInt() << '\n';
+        key += id.str();
+      }
+      break;
+    }
+    case mobile_apis::FunctionID::OnHMIStatusID:
+      break;
+    default:
+      return;
+  }
+  std::stringstream group;
+  group << params[strings::connection_key].asInt() << '/' << function_id;
+  message_to_mobile->coalescing_group = group.str();
+  message_to_mobile->coalescing_key = key;
+}
+}  // namespace
+
 ApplicationSharedPtr ApplicationManagerImpl::application(uint32_t app_id) const {
-  AppIdPredicate finder(app_id);
   ApplicationListAccessor accessor;
-  ApplicationSharedPtr app = accessor.Find(finder);
+  ApplicationSharedPtr app = FindInIndex(apps_by_app_id_, app_id);
   LOG4CXX_DEBUG(logger_, " app_id << " << app_id << "Found = " << app);
   return app;
 }
@@ -177,8 +347,16 @@ struct TakeDeviceHandle {
 
 std::vector<std::string> ApplicationManagerImpl::devices(
     const std::string& policy_app_id) const {
-  MobileAppIdPredicate matcher(policy_app_id);
-  std::vector<ApplicationSharedPtr> apps = ApplicationListAccessor().FindAll(matcher);
+  std::vector<ApplicationSharedPtr> apps;
+  {
+    ApplicationListAccessor accessor;
+    std::pair<AppsByPolicyIdIndex::const_iterator,
+              AppsByPolicyIdIndex::const_iterator> range =
+        apps_by_policy_app_id_.equal_range(policy_app_id);
+    for (; range.first != range.second; ++range.first) {
+      apps.push_back(range.first->second);
+    }
+  }
   std::vector<std::string> devices;
   std::transform(apps.begin(), apps.end(), std::back_inserter(devices),
                  TakeDeviceHandle());
@@ -187,18 +365,16 @@ std::vector<std::string> ApplicationManagerImpl::devices(
 
 ApplicationSharedPtr ApplicationManagerImpl::application_by_hmi_app(
   uint32_t hmi_app_id) const {
-  HmiAppIdPredicate finder(hmi_app_id);
   ApplicationListAccessor accessor;
-  ApplicationSharedPtr app = accessor.Find(finder);
+  ApplicationSharedPtr app = FindInIndex(apps_by_hmi_app_id_, hmi_app_id);
   LOG4CXX_DEBUG(logger_, " hmi_app_id << " << hmi_app_id << "Found = " << app);
   return app;
 }
 
 ApplicationSharedPtr ApplicationManagerImpl::application_by_policy_id(
   const std::string& policy_app_id) const {
-  MobileAppIdPredicate finder(policy_app_id);
   ApplicationListAccessor accessor;
-  ApplicationSharedPtr app = accessor.Find(finder);
+  ApplicationSharedPtr app = FindInIndex(apps_by_policy_app_id_, policy_app_id);
   LOG4CXX_DEBUG(logger_, " policy_app_id << " << policy_app_id << "Found = " << app);
   return app;
 }
@@ -207,8 +383,19 @@ ApplicationSharedPtr ApplicationManagerImpl::application(
     const std::string& device_id, const std::string& policy_app_id) const {
   connection_handler::DeviceHandle device_handle;
   connection_handler()->GetDeviceID(device_id, &device_handle);
-  ApplicationSharedPtr app = ApplicationListAccessor().Find(
-      IsApplication(device_handle, policy_app_id));
+  ApplicationSharedPtr app;
+  {
+    ApplicationListAccessor accessor;
+    std::pair<AppsByPolicyIdIndex::const_iterator,
+              AppsByPolicyIdIndex::const_iterator> range =
+        apps_by_policy_app_id_.equal_range(policy_app_id);
+    for (; range.first != range.second; ++range.first) {
+      if (range.first->second->device() == device_handle) {
+        app = range.first->second;
+        break;
+      }
+    }
+  }
   LOG4CXX_DEBUG(logger_, " policy_app_id << " << policy_app_id << "Found = " << app);
   return app;
 }
@@ -278,20 +465,44 @@ std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_with_navi
 }
 std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_by_button(
   uint32_t button) {
-  SubscribedToButtonPredicate finder(
-        static_cast<mobile_apis::ButtonName::eType>(button));
-  ApplicationListAccessor accessor;
-  std::vector<ApplicationSharedPtr> apps = accessor.FindAll(finder);
+  std::vector<ApplicationSharedPtr> apps;
+  {
+    ApplicationListAccessor accessor;
+    SubscribersIndex::const_iterator it = button_subscribers_.find(button);
+    if (button_subscribers_.end() != it) {
+      apps.assign(it->second.begin(), it->second.end());
+    }
+  }
+  LOG4CXX_DEBUG(logger_, " Found count: " << apps.size());
+  return apps;
+}
+
+std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_by_ivi(
+  uint32_t vehicle_info) {
+  std::vector<ApplicationSharedPtr> apps;
+  {
+    ApplicationListAccessor accessor;
+    SubscribersIndex::const_iterator it = ivi_subscribers_.find(vehicle_info);
+    if (ivi_subscribers_.end() != it) {
+      apps.assign(it->second.begin(), it->second.end());
+    }
+  }
   LOG4CXX_DEBUG(logger_, " Found count: " << apps.size());
   return apps;
 }
 
 std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_by_interior_vehicle_data(
   smart_objects::SmartObject moduleDescription) {
-  SubscribedToInteriorVehicleDataPredicate finder(
-        moduleDescription);
-  ApplicationListAccessor accessor;
-  std::vector<ApplicationSharedPtr> apps = accessor.FindAll(finder);
+  const std::string key = MessageHelper::InteriorModuleKey(moduleDescription);
+  std::vector<ApplicationSharedPtr> apps;
+  {
+    ApplicationListAccessor accessor;
+    InteriorSubscribersIndex::const_iterator it =
+        interior_vehicle_data_subscribers_.find(key);
+    if (interior_vehicle_data_subscribers_.end() != it) {
+      apps.assign(it->second.begin(), it->second.end());
+    }
+  }
   LOG4CXX_DEBUG(logger_, " Found count: " << apps.size());
   return apps;
 }
@@ -309,10 +520,8 @@ std::vector<ApplicationSharedPtr> ApplicationManagerImpl::IviInfoUpdated(
       break;
   }
 
-  SubscribedToIVIPredicate finder(
-        static_cast<int32_t>(vehicle_info));
-  ApplicationListAccessor accessor;
-  std::vector<ApplicationSharedPtr> apps = accessor.FindAll(finder);
+  std::vector<ApplicationSharedPtr> apps =
+      applications_by_ivi(static_cast<uint32_t>(vehicle_info));
   LOG4CXX_DEBUG(logger_, " vehicle_info << " << vehicle_info << "Found count: " << apps.size());
   return apps;
 }
@@ -517,6 +726,10 @@ ApplicationSharedPtr ApplicationManagerImpl::RegisterApplication(
   policy::PolicyHandler::instance()->AddApplication(mac,
                                                     application->mobile_app_id(),
                                                     app_hmi_types);
+  std::string priority;
+  policy::PolicyHandler::instance()->GetPriority(
+      application->mobile_app_id(), &priority);
+  application->set_policy_priority(priority);
   application->set_hmi_level(GetDefaultHmiLevel(application));
   app_list_accesor.Insert(application);
 
@@ -533,6 +746,8 @@ bool ApplicationManagerImpl::LoadAppDataToHMI(ApplicationSharedPtr app) {
 
 bool ApplicationManagerImpl::ActivateApplication(ApplicationSharedPtr app) {
   LOG4CXX_AUTO_TRACE(logger_);
+  // Statuses of all affected applications are posted together
+  MobileMessageBatch batch;
 
   if (!app) {
     LOG4CXX_ERROR(logger_, "Null-pointer application received.");
@@ -660,6 +875,8 @@ void ApplicationManagerImpl::ConnectToDevice(uint32_t id) {
 void ApplicationManagerImpl::OnHMIStartedCooperation() {
   hmi_cooperating_ = true;
   LOG4CXX_INFO(logger_, "ApplicationManagerImpl::OnHMIStartedCooperation()");
+  // Values got from previous HMI run are not trusted
+  vehicle_data_cache_.Clear();
 
   utils::SharedPtr<smart_objects::SmartObject> is_vr_ready(
       MessageHelper::CreateModuleInfoSO(
@@ -763,7 +980,7 @@ void ApplicationManagerImpl::SendAudioPassThroughNotification(
 
   impl::AudioData data;
   data.session_key = session_key;
-  data.binary_data = binary_data;
+  data.binary_data.swap(binary_data);
   audio_pass_thru_messages_.PostMessage(data);
 }
 
@@ -805,10 +1022,113 @@ void ApplicationManagerImpl::OnMessageReceived(
 
   utils::SharedPtr<Message> outgoing_message = ConvertRawMsgToMessage(message);
 
-  if (outgoing_message) {
-    messages_from_mobile_.PostMessage(
-      impl::MessageFromMobile(outgoing_message));
+  if (!outgoing_message) {
+    return;
+  }
+#ifdef TIME_TESTER
+  // From here on RPC is found by its connection key and correlation id
+  const utils::RpcTracePtr& trace = message->trace();
+  if (trace) {
+    trace->set_rpc(outgoing_message->connection_key(),
+                   outgoing_message->correlation_id(),
+                   outgoing_message->function_id());
+    utils::RpcTracer::instance()->Bind(outgoing_message->connection_key(),
+                                       outgoing_message->correlation_id(),
+                                       trace);
+    trace->Enqueue(parsing_queues_.empty() ?
+                   utils::rpc_trace::kApplicationManager :
+                   utils::rpc_trace::kFormatter);
   }
+#endif  // TIME_TESTER
+  // Released once message is taken by messages_from_mobile_ thread
+  utils::MemoryAccounting::instance()->Charge(
+      outgoing_message->connection_key(),
+      utils::MemoryAccounting::kQueuedMessages,
+      outgoing_message->data_size());
+  impl::MessageFromMobile message_from_mobile(outgoing_message);
+  message_from_mobile.scheduling_class =
+      QueueFromMobile(outgoing_message->connection_key());
+  if (parsing_queues_.empty()) {
+    messages_from_mobile_.PostMessage(message_from_mobile);
+    return;
+  }
+  const size_t queue_index =
+      static_cast<uint32_t>(outgoing_message->connection_key()) %
+      parsing_queues_.size();
+  parsing_queues_[queue_index]->PostMessage(message_from_mobile);
+}
+
+SchedulingClass ApplicationManagerImpl::QueueFromMobile(
+    int32_t connection_key) {
+  sync_primitives::AutoLock lock(queued_from_mobile_lock_);
+  QueuedFromMobile& queued = queued_from_mobile_[connection_key];
+  if (0 == queued.count) {
+    ApplicationConstSharedPtr app = application(connection_key);
+    queued.scheduling_class = app ? app->scheduling_class()
+                                  : kSchedulingDefault;
+  }
+  ++queued.count;
+  return queued.scheduling_class;
+}
+
+void ApplicationManagerImpl::UnqueueFromMobile(int32_t connection_key) {
+  sync_primitives::AutoLock lock(queued_from_mobile_lock_);
+  QueuedFromMobileMap::iterator it = queued_from_mobile_.find(connection_key);
+  if (queued_from_mobile_.end() == it) {
+    return;
+  }
+  if (0 == --it->second.count) {
+    queued_from_mobile_.erase(it);
+  }
+}
+
+ApplicationManagerImpl::FromMobileParser::FromMobileParser(
+    ApplicationManagerImpl* application_manager)
+  : application_manager_(*application_manager) {
+}
+
+void ApplicationManagerImpl::FromMobileParser::Handle(
+    const impl::MessageFromMobile message) {
+  // Parsing scratch is dropped at once, parsed object is promoted out
+  utils::ScopedMessageArena message_arena;
+  impl::MessageFromMobile parsed_message(message);
+#ifdef TIME_TESTER
+  const utils::RpcTracePtr trace = utils::RpcTracer::instance()->Find(
+      message->connection_key(), message->correlation_id());
+  if (trace) {
+    trace->Begin(utils::rpc_trace::kFormatter);
+  }
+#endif  // TIME_TESTER
+  // Plugin routes message by function id of protocol header and decodes
+  // json itself, so it is not parsed here
+  if (functional_modules::PluginManager::instance()->IsMessageForPlugin(
+        message)) {
+    application_manager_.messages_from_mobile_.PostMessage(parsed_message);
+    return;
+  }
+  switch (message->protocol_version()) {
+    case ProtocolVersion::kV4:
+    case ProtocolVersion::kV3:
+    case ProtocolVersion::kV2: {
+      smart_objects::SmartObjectSPtr smart_object(
+          new smart_objects::SmartObject);
+      // Invalid message is parsed again on messages_from_mobile_ thread
+      // to respond it
+      if (application_manager_.ParseMobileMessage(*message, *smart_object)) {
+        parsed_message.smart_object = smart_object;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+#ifdef TIME_TESTER
+  if (trace) {
+    trace->End(utils::rpc_trace::kFormatter);
+    trace->Enqueue(utils::rpc_trace::kApplicationManager);
+  }
+#endif  // TIME_TESTER
+  application_manager_.messages_from_mobile_.PostMessage(parsed_message);
 }
 
 void ApplicationManagerImpl::OnMobileMessageSent(
@@ -885,6 +1205,21 @@ void ApplicationManagerImpl::OnErrorSending(
 void ApplicationManagerImpl::OnDeviceListUpdated(
     const connection_handler::DeviceMap& device_list) {
   LOG4CXX_AUTO_TRACE(logger_);
+  {
+    sync_primitives::AutoLock lock(pending_device_list_lock_);
+    pending_device_list_ = device_list;
+  }
+  device_list_publisher_.Schedule(
+      profile::Profile::instance()->hmi_list_update_delay());
+}
+
+void ApplicationManagerImpl::SendPendingUpdateDeviceList() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  connection_handler::DeviceMap device_list;
+  {
+    sync_primitives::AutoLock lock(pending_device_list_lock_);
+    device_list.swap(pending_device_list_);
+  }
   smart_objects::SmartObjectSPtr msg_params = MessageHelper::CreateDeviceListSO(
         device_list);
   if (!msg_params) {
@@ -915,6 +1250,12 @@ void ApplicationManagerImpl::OnFindNewApplicationsRequest() {
 
 void ApplicationManagerImpl::SendUpdateAppList() {
   LOG4CXX_AUTO_TRACE(logger_);
+  app_list_publisher_.Schedule(
+      profile::Profile::instance()->hmi_list_update_delay());
+}
+
+void ApplicationManagerImpl::SendPendingUpdateAppList() {
+  LOG4CXX_AUTO_TRACE(logger_);
 
   using namespace smart_objects;
   using namespace hmi_apis;
@@ -926,8 +1267,13 @@ void ApplicationManagerImpl::SendUpdateAppList() {
 
   SmartObject& applications = (*request)[strings::msg_params][strings::applications];
 
-  PrepareApplicationListSO(applications_, applications);
-  PrepareApplicationListSO(apps_to_register_, applications);
+  PrepareApplicationListSO(ApplicationListSnapshot().applications(),
+                           applications);
+  {
+    // List may be built on timer thread while QueryApps result is processed
+    sync_primitives::AutoLock lock(apps_to_register_list_lock_);
+    PrepareApplicationListSO(apps_to_register_, applications);
+  }
 
   ManageHMICommand(request);
 }
@@ -1243,7 +1589,8 @@ void ApplicationManagerImpl::StartDevicesDiscovery() {
 }
 
 void ApplicationManagerImpl::SendMessageToMobile(
-    const commands::MessageSharedPtr message, bool final_message) {
+    const commands::MessageSharedPtr message, bool final_message,
+    SerializedJson* serialized_json) {
   LOG4CXX_AUTO_TRACE(logger_);
 
   if (!message) {
@@ -1277,18 +1624,49 @@ void ApplicationManagerImpl::SendMessageToMobile(
       app->protocol_version();
   }
 
-  mobile_so_factory().attachSchema(*message);
-  LOG4CXX_INFO(
-    logger_,
-    "Attached schema to message, result if valid: " << message->isValid());
+  // Rejections like DISALLOWED or TOO_MANY_PENDING_REQUESTS differ only in
+  // header fields, so their json is serialized once and reused
+  SerializedJson response_template;
+  const bool is_plain_negative_response =
+    !serialized_json && IsPlainNegativeResponse(*message);
+  const int32_t function_id_value = is_plain_negative_response ?
+    (*message)[strings::params][strings::function_id].asInt() : 0;
+  const int32_t result_code = is_plain_negative_response ?
+    (*message)[strings::msg_params][strings::result_code].asInt() : 0;
+  if (is_plain_negative_response) {
+    GetNegativeResponseTemplate(function_id_value, result_code,
+                                &response_template);
+    serialized_json = &response_template;
+  }
+  const bool is_template_used = response_template.is_serialized;
+
+  ThreadMessageBatch* batch = ThisThreadBatch(false);
+  const bool is_batched = batch && batch->depth > 0;
+  if (is_batched && !serialized_json &&
+      static_cast<int32_t>(kNotification) ==
+      (*message)[strings::params][strings::message_type].asInt()) {
+    serialized_json = BatchedJsonFor(batch, *message);
+  }
+
+  if (!is_template_used) {
+    mobile_so_factory().attachSchema(*message);
+    LOG4CXX_INFO(
+      logger_,
+      "Attached schema to message, result if valid: " << message->isValid());
+  }
 
   // Messages to mobile are not yet prioritized so use default priority value
-  utils::SharedPtr<Message> message_to_send(new Message(
-        protocol_handler::MessagePriority::kDefault));
-  if (!ConvertSOtoMessage((*message), (*message_to_send))) {
+  utils::SharedPtr<Message> message_to_send = utils::MakeShared<Message>(
+        protocol_handler::MessagePriority::kDefault);
+  if (!ConvertSOtoMessage((*message), (*message_to_send), serialized_json)) {
     LOG4CXX_WARN(logger_, "Can't send msg to Mobile: failed to create string");
     return;
   }
+  if (is_plain_negative_response && !is_template_used &&
+      response_template.is_serialized) {
+    StoreNegativeResponseTemplate(function_id_value, result_code,
+                                  response_template);
+  }
 
   smart_objects::SmartObject& msg_to_mobile = *message;
   mobile_apis::FunctionID::eType function_id =
@@ -1349,8 +1727,41 @@ void ApplicationManagerImpl::SendMessageToMobile(
   if (message_to_send->binary_data()) {
     LOG4CXX_DEBUG(logger_, "Binary data size: " << message_to_send->binary_data()->size());
   }
-  messages_to_mobile_.PostMessage(impl::MessageToMobile(message_to_send,
-                                  final_message));
+  impl::MessageToMobile message_to_mobile(message_to_send, final_message);
+  if (profile::Profile::instance()->coalesce_mobile_notifications()) {
+    SetCoalescingKey(*message, &message_to_mobile);
+  }
+#ifdef TIME_TESTER
+  if (kResponse == message_to_send->type()) {
+    const utils::RpcTracePtr trace = utils::RpcTracer::instance()->Find(
+        message_to_send->connection_key(), message_to_send->correlation_id());
+    if (trace) {
+      trace->Enqueue(utils::rpc_trace::kMobileResponse);
+    }
+  }
+#endif  // TIME_TESTER
+  if (is_batched) {
+    batch->messages.push_back(message_to_mobile);
+    return;
+  }
+  messages_to_mobile_.PostMessage(message_to_mobile);
+}
+
+void ApplicationManagerImpl::BeginMobileMessageBatch() {
+  ++ThisThreadBatch(true)->depth;
+}
+
+void ApplicationManagerImpl::EndMobileMessageBatch() {
+  ThreadMessageBatch* batch = ThisThreadBatch(false);
+  DCHECK(batch && batch->depth > 0);
+  if (!batch || 0 == batch->depth || 0 != --batch->depth) {
+    return;
+  }
+  LOG4CXX_DEBUG(logger_, "Posting batch of " << batch->messages.size()
+                << " messages to mobile");
+  messages_to_mobile_.PostMessages(batch->messages);
+  batch->messages.clear();
+  batch->jsons.clear();
 }
 
 bool ApplicationManagerImpl::ManageMobileCommand(
@@ -1445,14 +1856,16 @@ bool ApplicationManagerImpl::ManageMobileCommand(
 
     // commands will be launched from requesr_ctrl
     mobile_apis::HMILevel::eType app_hmi_level = mobile_apis::HMILevel::INVALID_ENUM;
+    SchedulingClass scheduling_class = kSchedulingDefault;
     if (app) {
       app_hmi_level = app->hmi_level();
+      scheduling_class = app->scheduling_class();
     }
 
     // commands will be launched from request_ctrl
 
     const request_controller::RequestController::TResult result =
-      request_ctrl_.addMobileRequest(command, app_hmi_level);
+      request_ctrl_.addMobileRequest(command, app_hmi_level, scheduling_class);
 
     if (result == request_controller::RequestController::SUCCESS) {
       LOG4CXX_INFO(logger_, "Perform request");
@@ -1539,7 +1952,7 @@ void ApplicationManagerImpl::SendMessageToHMI(
     logger_,
     "Attached schema to message, result if valid: " << message->isValid());
 
-#ifdef HMI_DBUS_API
+#if defined(HMI_DBUS_API) || defined(DIRECT_HMIADAPTER)
   message_to_send->set_smart_object(*message);
 #else
   if (!ConvertSOtoMessage(*message, *message_to_send)) {
@@ -1549,9 +1962,30 @@ void ApplicationManagerImpl::SendMessageToHMI(
   }
 #endif  // HMI_DBUS_API
 
+  ThreadMessageBatch* batch = ThisThreadBatch(false);
+  if (batch && batch->hmi_depth > 0) {
+    batch->hmi_messages.push_back(impl::MessageToHmi(message_to_send));
+    return;
+  }
   messages_to_hmi_.PostMessage(impl::MessageToHmi(message_to_send));
 }
 
+void ApplicationManagerImpl::BeginHMIMessageBatch() {
+  ++ThisThreadBatch(true)->hmi_depth;
+}
+
+void ApplicationManagerImpl::EndHMIMessageBatch() {
+  ThreadMessageBatch* batch = ThisThreadBatch(false);
+  DCHECK(batch && batch->hmi_depth > 0);
+  if (!batch || 0 == batch->hmi_depth || 0 != --batch->hmi_depth) {
+    return;
+  }
+  LOG4CXX_DEBUG(logger_, "Posting batch of " << batch->hmi_messages.size()
+                << " messages to HMI");
+  messages_to_hmi_.PostMessages(batch->hmi_messages);
+  batch->hmi_messages.clear();
+}
+
 bool ApplicationManagerImpl::ManageHMICommand(
     const commands::MessageSharedPtr message) {
   LOG4CXX_AUTO_TRACE(logger_);
@@ -1602,6 +2036,7 @@ bool ApplicationManagerImpl::Init() {
       !IsReadWriteAllowed(app_storage_folder, TYPE_STORAGE)) {
     return false;
   }
+  app_file_storage_.SetSharedDirectory(app_storage_folder + "/.shared_files");
 
   const std::string system_files_path =
       profile::Profile::instance()->system_files_path();
@@ -1618,26 +2053,17 @@ bool ApplicationManagerImpl::Init() {
   // In case there is no R/W permissions for this location, SDL just has to
   // log this and proceed
   IsReadWriteAllowed(app_icons_folder, TYPE_ICONS);
+  icon_storage_.Init(
+      app_icons_folder,
+      profile::Profile::instance()->app_icons_folder_max_size(),
+      profile::Profile::instance()->app_icons_amount_to_remove());
 
-  if (policy::PolicyHandler::instance()->PolicyEnabled()) {
-    if(!policy::PolicyHandler::instance()->LoadPolicyLibrary()) {
-      LOG4CXX_ERROR(logger_, "Policy library is not loaded. Check LD_LIBRARY_PATH");
-      return false;
-    }
-    LOG4CXX_INFO(logger_, "Policy library is loaded, now initing PT");
-    if (!policy::PolicyHandler::instance()->InitPolicyTable()) {
-      LOG4CXX_ERROR(logger_, "Policy table is not initialized.");
-      return false;
-    }
-  } else {
-    LOG4CXX_WARN(logger_, "System is configured to work without policy functionality.");
-  }
   media_manager_ = media_manager::MediaManagerImpl::instance();
   return true;
 }
 
 bool ApplicationManagerImpl::ConvertMessageToSO(
-  const Message& message, smart_objects::SmartObject& output) {
+  Message& message, smart_objects::SmartObject& output) {
   LOG4CXX_INFO(
     logger_,
     "\t\t\tMessage to convert: protocol " << message.protocol_version()
@@ -1647,15 +2073,7 @@ bool ApplicationManagerImpl::ConvertMessageToSO(
     case ProtocolVersion::kV4:
     case ProtocolVersion::kV3:
     case ProtocolVersion::kV2: {
-        const bool conversion_result =
-            formatters::CFormatterJsonSDLRPCv2::fromString(
-            message.json_message(), output, message.function_id(),
-            message.type(), message.correlation_id());
-        if (!conversion_result
-            || !mobile_so_factory().attachSchema(output)
-            || ((output.validate() != smart_objects::Errors::OK)) ) {
-          LOG4CXX_WARN(logger_, "Failed to parse string to smart object :"
-                       << message.json_message());
+        if (!ParseMobileMessage(message, output)) {
           utils::SharedPtr<smart_objects::SmartObject> response(
                 MessageHelper::CreateNegativeResponse(
                   message.connection_key(), message.function_id(),
@@ -1663,32 +2081,18 @@ bool ApplicationManagerImpl::ConvertMessageToSO(
           ManageMobileCommand(response);
           return false;
         }
-      LOG4CXX_INFO(
-        logger_,
-        "Convertion result for sdl object is true" << " function_id "
-        << output[jhs::S_PARAMS][jhs::S_FUNCTION_ID].asInt());
-      output[strings::params][strings::connection_key] =
-        message.connection_key();
-      output[strings::params][strings::protocol_version] =
-        message.protocol_version();
-      if (message.binary_data()) {
-        if (message.payload_size() < message.data_size()) {
-          LOG4CXX_ERROR(logger_, "Incomplete binary" <<
-                                " binary size should be  " << message.data_size() <<
-                                " payload data size is " << message.payload_size());
-          utils::SharedPtr<smart_objects::SmartObject> response(
-                            MessageHelper::CreateNegativeResponse(
-                            message.connection_key(), message.function_id(),
-                            message.correlation_id(), mobile_apis::Result::INVALID_DATA));
-          ManageMobileCommand(response);
-          return false;
-        }
-        output[strings::params][strings::binary_data] =
-          *(message.binary_data());
+      if (!CompleteMobileMessageSO(message, output)) {
+        return false;
       }
       break;
     }
     case ProtocolVersion::kHMI: {
+#ifdef DIRECT_HMIADAPTER
+      // In-process HMI gives away ready object, it only has to be validated
+      if (message.json_message().empty()) {
+        output = message.smart_object();
+      } else {
+#endif  // DIRECT_HMIADAPTER
 #ifdef ENABLE_LOG
       int32_t result =
 #endif
@@ -1699,11 +2103,17 @@ bool ApplicationManagerImpl::ConvertMessageToSO(
         logger_,
         "Convertion result: " << result << " function id "
         << output[jhs::S_PARAMS][jhs::S_FUNCTION_ID].asInt());
-      if (!hmi_so_factory().attachSchema(output)) {
+#ifdef DIRECT_HMIADAPTER
+      }
+#endif  // DIRECT_HMIADAPTER
+      smart_objects::Errors::eType validation_result =
+          smart_objects::Errors::OK;
+      if (!hmi_so_factory().attachSchemaAndValidate(output,
+                                                    validation_result)) {
         LOG4CXX_WARN(logger_, "Failed to attach schema to object.");
         return false;
       }
-      if (output.validate() != smart_objects::Errors::OK) {
+      if (validation_result != smart_objects::Errors::OK) {
         LOG4CXX_ERROR(logger_, "Incorrect parameter from HMI");
 
         if (application_manager::MessageType::kNotification ==
@@ -1776,8 +2186,98 @@ bool ApplicationManagerImpl::ConvertMessageToSO(
   return true;
 }
 
+bool ApplicationManagerImpl::ParseMobileMessage(
+  const Message& message, smart_objects::SmartObject& output) {
+  const bool conversion_result =
+      formatters::CFormatterJsonSDLRPCv2::fromString(
+      message.json_message(), output, message.function_id(),
+      message.type(), message.correlation_id());
+  smart_objects::Errors::eType validation_result = smart_objects::Errors::OK;
+  if (!conversion_result
+      || !mobile_so_factory().attachSchemaAndValidate(output, validation_result)
+      || validation_result != smart_objects::Errors::OK) {
+    LOG4CXX_WARN(logger_, "Failed to parse string to smart object :"
+                 << message.json_message());
+    return false;
+  }
+  LOG4CXX_INFO(
+    logger_,
+    "Convertion result for sdl object is true" << " function_id "
+    << output[jhs::S_PARAMS][jhs::S_FUNCTION_ID].asInt());
+  return true;
+}
+
+bool ApplicationManagerImpl::CompleteMobileMessageSO(
+  Message& message, smart_objects::SmartObject& output) {
+  output[strings::params][strings::connection_key] =
+    message.connection_key();
+  output[strings::params][strings::protocol_version] =
+    message.protocol_version();
+  if (message.binary_data()) {
+    if (message.payload_size() < message.data_size()) {
+      LOG4CXX_ERROR(logger_, "Incomplete binary" <<
+                            " binary size should be  " << message.data_size() <<
+                            " payload data size is " << message.payload_size());
+      utils::SharedPtr<smart_objects::SmartObject> response(
+                        MessageHelper::CreateNegativeResponse(
+                        message.connection_key(), message.function_id(),
+                        message.correlation_id(), mobile_apis::Result::INVALID_DATA));
+      ManageMobileCommand(response);
+      return false;
+    }
+    // Multi-megabyte PutFile and SystemRequest data is shared, not copied
+    output[strings::params][strings::binary_data] =
+      message.shared_binary_data();
+  }
+  return true;
+}
+
+bool ApplicationManagerImpl::IsPlainNegativeResponse(
+  const smart_objects::SmartObject& message) const {
+  const smart_objects::SmartObject& params = message[strings::params];
+  if (kResponse !=
+      params[strings::message_type].asInt() ||
+      0 != params[strings::protocol_type].asInt() ||
+      ProtocolVersion::kV1 == params[strings::protocol_version].asInt() ||
+      params.keyExists(strings::binary_data)) {
+    return false;
+  }
+  // Formatter of protocol v2 and above writes only msg_params to json
+  const smart_objects::SmartObject& msg_params = message[strings::msg_params];
+  return smart_objects::SmartType_Map == msg_params.getType() &&
+         2 == msg_params.length() &&
+         msg_params.keyExists(strings::success) &&
+         msg_params.keyExists(strings::result_code) &&
+         !msg_params[strings::success].asBool();
+}
+
+bool ApplicationManagerImpl::GetNegativeResponseTemplate(
+  int32_t function_id, int32_t result_code,
+  SerializedJson* serialized_json) {
+  DCHECK(serialized_json);
+  sync_primitives::AutoLock lock(negative_response_templates_lock_);
+  NegativeResponseTemplates::const_iterator it =
+    negative_response_templates_.find(std::make_pair(function_id,
+                                                     result_code));
+  if (negative_response_templates_.end() == it) {
+    return false;
+  }
+  serialized_json->json_message = it->second;
+  serialized_json->is_serialized = true;
+  return true;
+}
+
+void ApplicationManagerImpl::StoreNegativeResponseTemplate(
+  int32_t function_id, int32_t result_code,
+  const SerializedJson& serialized_json) {
+  sync_primitives::AutoLock lock(negative_response_templates_lock_);
+  negative_response_templates_[std::make_pair(function_id, result_code)] =
+    serialized_json.json_message;
+}
+
 bool ApplicationManagerImpl::ConvertSOtoMessage(
-  const smart_objects::SmartObject& message, Message& output) {
+  const smart_objects::SmartObject& message, Message& output,
+  SerializedJson* serialized_json) {
   LOG4CXX_INFO(logger_, "Message to convert");
 
   if (smart_objects::SmartType_Null == message.getType()
@@ -1792,7 +2292,10 @@ bool ApplicationManagerImpl::ConvertSOtoMessage(
     << message.getElement(jhs::S_PARAMS).getElement(jhs::S_PROTOCOL_TYPE)
     .asInt());
 
-  std::string output_string;
+  // Formatters append to the cleared string, so reused thread buffer saves
+  // reallocations while json grows, message gets exactly sized copy below
+  utils::ScopedStringBuffer output_buffer;
+  std::string& output_string = output_buffer.get();
   switch (message.getElement(jhs::S_PARAMS).getElement(jhs::S_PROTOCOL_TYPE)
           .asInt()) {
     case 0: {
@@ -1803,12 +2306,22 @@ bool ApplicationManagerImpl::ConvertSOtoMessage(
           return false;
         }
         output.set_protocol_version(application_manager::kV1);
+      } else if (serialized_json && serialized_json->is_serialized) {
+        output_string = serialized_json->json_message;
+        output.set_protocol_version(
+          static_cast<ProtocolVersion>(
+            message.getElement(jhs::S_PARAMS).getElement(
+              jhs::S_PROTOCOL_VERSION).asUInt()));
       } else {
         if (!formatters::CFormatterJsonSDLRPCv2::toString(message,
             output_string)) {
           LOG4CXX_WARN(logger_, "Failed to serialize smart object");
           return false;
         }
+        if (serialized_json) {
+          serialized_json->json_message = output_string;
+          serialized_json->is_serialized = true;
+        }
         output.set_protocol_version(
           static_cast<ProtocolVersion>(
             message.getElement(jhs::S_PARAMS).getElement(
@@ -1855,16 +2368,14 @@ bool ApplicationManagerImpl::ConvertSOtoMessage(
   }
 
   if (message.getElement(jhs::S_PARAMS).keyExists(strings::binary_data)) {
-    application_manager::BinaryData* binaryData =
-      new application_manager::BinaryData(
+    const SharedBinaryData binary_data =
       message.getElement(jhs::S_PARAMS).getElement(strings::binary_data)
-      .asBinary());
-
-    if (NULL == binaryData) {
-      LOG4CXX_ERROR(logger_, "Null pointer");
+      .asSharedBinary();
+    if (!binary_data) {
+      LOG4CXX_ERROR(logger_, "Binary data is not binary");
       return false;
     }
-    output.set_binary_data(binaryData);
+    output.set_binary_data(binary_data);
   }
 
   LOG4CXX_INFO(logger_, "Successfully parsed smart object into message");
@@ -1897,22 +2408,42 @@ utils::SharedPtr<Message> ApplicationManagerImpl::ConvertRawMsgToMessage(
 }
 
 void ApplicationManagerImpl::ProcessMessageFromMobile(
-  const utils::SharedPtr<Message> message) {
+  const impl::MessageFromMobile& message) {
   LOG4CXX_INFO(logger_, "ApplicationManagerImpl::ProcessMessageFromMobile()");
 #ifdef TIME_TESTER
   AMMetricObserver::MessageMetricSharedPtr metric(new AMMetricObserver::MessageMetric());
-  metric->begin = date_time::DateTime::getCurrentTime();
-#endif  // TIME_TESTER
-  smart_objects::SmartObjectSPtr so_from_mobile(new smart_objects::SmartObject);
-
-  if (!so_from_mobile) {
-    LOG4CXX_ERROR(logger_, "Null pointer");
-    return;
+  metric->begin = date_time::DateTime::getPreciseMonotonicTime();
+  utils::RpcTracer* tracer = utils::RpcTracer::instance();
+  const utils::RpcTracePtr trace =
+      tracer->Find(message->connection_key(), message->correlation_id());
+  if (trace) {
+    trace->Begin(utils::rpc_trace::kApplicationManager);
   }
-
-  if (!ConvertMessageToSO(*message, *so_from_mobile)) {
-    LOG4CXX_ERROR(logger_, "Cannot create smart object from message");
-    return;
+#endif  // TIME_TESTER
+  smart_objects::SmartObjectSPtr so_from_mobile = message.smart_object;
+  if (so_from_mobile) {
+    // Parsed and validated on parsing_pool_
+    if (!CompleteMobileMessageSO(*message, *so_from_mobile)) {
+      LOG4CXX_ERROR(logger_, "Cannot create smart object from message");
+      return;
+    }
+  } else {
+#ifdef TIME_TESTER
+    if (trace) {
+      trace->Begin(utils::rpc_trace::kFormatter,
+                   utils::rpc_trace::kApplicationManager);
+    }
+#endif  // TIME_TESTER
+    so_from_mobile = new smart_objects::SmartObject;
+    if (!ConvertMessageToSO(*message, *so_from_mobile)) {
+      LOG4CXX_ERROR(logger_, "Cannot create smart object from message");
+      return;
+    }
+#ifdef TIME_TESTER
+    if (trace) {
+      trace->End(utils::rpc_trace::kFormatter);
+    }
+#endif  // TIME_TESTER
   }
 #ifdef TIME_TESTER
   metric->message = so_from_mobile;
@@ -1923,10 +2454,17 @@ void ApplicationManagerImpl::ProcessMessageFromMobile(
     LOG4CXX_ERROR(logger_, "Received command didn't run successfully");
   }
 #ifdef TIME_TESTER
-  metric->end = date_time::DateTime::getCurrentTime();
+  metric->end = date_time::DateTime::getPreciseMonotonicTime();
   if (metric_observer_) {
     metric_observer_->OnMessage(metric);
   }
+  if (trace) {
+    trace->End(utils::rpc_trace::kApplicationManager);
+    // Nothing is sent back for notifications
+    if (kRequest != message->type()) {
+      tracer->Complete(message->connection_key(), message->correlation_id());
+    }
+  }
 #endif  // TIME_TESTER
 }
 
@@ -1949,10 +2487,31 @@ void ApplicationManagerImpl::ProcessMessageFromHMI(
   }
 #endif  // HMI_DBUS_API
 
+#ifdef TIME_TESTER
+  // HMI round trip ends when response is taken for processing
+  utils::RpcTracer* tracer = utils::RpcTracer::instance();
+  const int32_t hmi_correlation_id =
+      (*smart_object)[strings::params][strings::correlation_id].asInt();
+  utils::RpcTracePtr trace;
+  if (kRequest != message->type() && kNotification != message->type()) {
+    trace = tracer->FindHmi(hmi_correlation_id);
+  }
+  if (trace) {
+    trace->End(utils::rpc_trace::kHmi);
+    trace->Begin(utils::rpc_trace::kHmiResponse);
+  }
+#endif  // TIME_TESTER
+
   LOG4CXX_INFO(logger_, "Converted message, trying to create hmi command");
   if (!ManageHMICommand(smart_object)) {
     LOG4CXX_ERROR(logger_, "Received command didn't run successfully");
   }
+#ifdef TIME_TESTER
+  if (trace) {
+    trace->End(utils::rpc_trace::kHmiResponse);
+    tracer->UnbindHmi(hmi_correlation_id);
+  }
+#endif  // TIME_TESTER
 }
 
 hmi_apis::HMI_API& ApplicationManagerImpl::hmi_so_factory() {
@@ -1981,6 +2540,10 @@ HMICapabilities& ApplicationManagerImpl::hmi_capabilities() {
   return hmi_capabilities_;
 }
 
+VehicleDataCache& ApplicationManagerImpl::vehicle_data_cache() {
+  return vehicle_data_cache_;
+}
+
 void ApplicationManagerImpl::PullLanguagesInfo(const SmartObject& app_data,
                                                SmartObject& ttsName,
                                                SmartObject& vrSynonym) {
@@ -2194,6 +2757,7 @@ void ApplicationManagerImpl::HeadUnitReset(
 
       resume_controller().StopSavePersistentDataTimer();
       file_system::remove_directory_content(profile::Profile::instance()->app_storage_folder());
+      OnAppStorageChanged(profile::Profile::instance()->app_storage_folder());
       break;
     }
     case mobile_api::AppInterfaceUnregisteredReason::FACTORY_DEFAULTS: {
@@ -2240,7 +2804,7 @@ void ApplicationManagerImpl::SendOnSDLClose() {
     "Attached schema to message, result if valid: " << msg->isValid());
 
 
-#ifdef HMI_DBUS_API
+#if defined(HMI_DBUS_API) || defined(DIRECT_HMIADAPTER)
   message_to_send->set_smart_object(*msg);
 #else
   if (!ConvertSOtoMessage(*msg, *message_to_send)) {
@@ -2351,13 +2915,9 @@ void ApplicationManagerImpl::UnregisterApplication(
   connection_handler::DeviceHandle handle = 0;
   {
     ApplicationListAccessor accessor;
-    ApplictionSetConstIt it = accessor.begin();
-    for (; it != accessor.end(); ++it) {
-      if ((*it)->app_id() == app_id) {
-        app_to_remove = *it;
-        handle = app_to_remove->device();
-        break;
-      }
+    app_to_remove = FindInIndex(apps_by_app_id_, app_id);
+    if (app_to_remove) {
+      handle = app_to_remove->device();
     }
     if (!app_to_remove) {
       LOG4CXX_ERROR(logger_, "Cant find application with app_id = " << app_id);
@@ -2402,11 +2962,17 @@ void ApplicationManagerImpl::OnAppUnauthorized(const uint32_t& app_id) {
 
 void ApplicationManagerImpl::Handle(const impl::MessageFromMobile message) {
   LOG4CXX_INFO(logger_, "Received message from Mobile side");
+  // Short-lived data of ManageMobileCommand is freed on return
+  utils::ScopedMessageArena message_arena;
 
   if (!message) {
     LOG4CXX_ERROR(logger_, "Null-pointer message received.");
     return;
   }
+  utils::MemoryAccounting::instance()->Release(
+      message->connection_key(), utils::MemoryAccounting::kQueuedMessages,
+      message->data_size());
+  UnqueueFromMobile(message->connection_key());
   functional_modules::PluginManager* plugin_manager =
       functional_modules::PluginManager::instance();
 
@@ -2442,8 +3008,24 @@ void ApplicationManagerImpl::Handle(const impl::MessageToMobile message) {
     }
   }
 
+#ifdef TIME_TESTER
+  utils::RpcTracer* tracer = utils::RpcTracer::instance();
+  utils::RpcTracePtr trace;
+  if (kResponse == message->type()) {
+    trace = tracer->Find(message->connection_key(), message->correlation_id());
+  }
+  if (trace) {
+    trace->Begin(utils::rpc_trace::kMobileResponse);
+  }
+#endif  // TIME_TESTER
   protocol_handler_->SendMessageToMobileApp(rawMessage, is_final);
   LOG4CXX_INFO(logger_, "Message for mobile given away");
+#ifdef TIME_TESTER
+  if (trace) {
+    trace->End(utils::rpc_trace::kMobileResponse);
+    tracer->Complete(message->connection_key(), message->correlation_id());
+  }
+#endif  // TIME_TESTER
 
   if (close_session) {
     connection_handler_->CloseSession(message->connection_key(),
@@ -2453,6 +3035,7 @@ void ApplicationManagerImpl::Handle(const impl::MessageToMobile message) {
 
 void ApplicationManagerImpl::Handle(const impl::MessageFromHmi message) {
   LOG4CXX_INFO(logger_, "Received message from hmi");
+  utils::ScopedMessageArena message_arena;
 
   if (!message) {
     LOG4CXX_ERROR(logger_, "Null-pointer message received.");
@@ -2480,6 +3063,15 @@ void ApplicationManagerImpl::Handle(const impl::MessageToHmi message) {
     return;
   }
 
+#ifdef TIME_TESTER
+  if (kRequest == message->type()) {
+    const utils::RpcTracePtr trace =
+        utils::RpcTracer::instance()->FindHmi(message->correlation_id());
+    if (trace) {
+      trace->Begin(utils::rpc_trace::kHmi);
+    }
+  }
+#endif  // TIME_TESTER
   hmi_handler_->SendMessageToHMI(message);
   LOG4CXX_INFO(logger_, "Message to hmi given away.");
 }
@@ -2770,6 +3362,7 @@ void ApplicationManagerImpl::OnWakeUp() {
 }
 
 void ApplicationManagerImpl::Mute(VRTTSSessionChanging changing_state) {
+  MobileMessageBatch batch;
   mobile_apis::AudioStreamingState::eType state =
       mobile_apis::AudioStreamingState::NOT_AUDIBLE;
 
@@ -2779,12 +3372,12 @@ void ApplicationManagerImpl::Mute(VRTTSSessionChanging changing_state) {
     state = mobile_apis::AudioStreamingState::ATTENUATED;
   }
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
 
   ApplicationManagerImpl::ApplictionSetConstIt it =
-      accessor.begin();
+      snapshot.begin();
   ApplicationManagerImpl::ApplictionSetConstIt
-      itEnd = accessor.end();
+      itEnd = snapshot.end();
   for (; it != itEnd; ++it) {
     if ((*it).valid()) {
       if ((*it)->is_media_application()) {
@@ -2803,10 +3396,11 @@ void ApplicationManagerImpl::Mute(VRTTSSessionChanging changing_state) {
 }
 
 void ApplicationManagerImpl::Unmute(VRTTSSessionChanging changing_state) {
+  MobileMessageBatch batch;
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  ApplicationManagerImpl::ApplictionSetConstIt it = accessor.begin();
-  ApplicationManagerImpl::ApplictionSetConstIt itEnd = accessor.end();
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  ApplicationManagerImpl::ApplictionSetConstIt it = snapshot.begin();
+  ApplicationManagerImpl::ApplictionSetConstIt itEnd = snapshot.end();
 
   for (; it != itEnd; ++it) {
     if ((*it).valid()) {
@@ -2847,38 +3441,33 @@ mobile_apis::Result::eType ApplicationManagerImpl::SaveBinary(
     return mobile_apis::Result::OUT_OF_MEMORY;
   }
 
-  const std::string full_file_path = file_path + "/" + file_name;
-  int64_t file_size = file_system::FileSize(full_file_path);
-  std::ofstream* file_stream;
-  if (offset != 0) {
-    if (file_size != offset) {
-      LOG4CXX_INFO(logger_,
-                   "ApplicationManagerImpl::SaveBinaryWithOffset offset"
-                   << " does'n match existing file size");
-      return mobile_apis::Result::INVALID_DATA;
-    }
-    file_stream = file_system::Open(full_file_path, std::ios_base::app);
-  } else {
-    LOG4CXX_INFO(
-      logger_,
-      "ApplicationManagerImpl::SaveBinaryWithOffset offset is 0, rewrite");
-    // if offset == 0: rewrite file
-    file_stream = file_system::Open(full_file_path, std::ios_base::out);
+  const mobile_apis::Result::eType result = app_file_storage_.Write(
+      file_path, file_name, binary_data.data(), binary_data.size(), offset);
+  if (mobile_apis::Result::SUCCESS != result) {
+    return result;
   }
+  LOG4CXX_INFO(logger_, "Successfully write data to file");
+  return mobile_apis::Result::SUCCESS;
+}
 
-  if (!file_system::Write(file_stream, binary_data.data(),
-                          binary_data.size())) {
-    file_system::Close(file_stream);
-    delete file_stream;
-    file_stream = NULL;
-    return mobile_apis::Result::GENERIC_ERROR;
+mobile_apis::Result::eType ApplicationManagerImpl::SaveSharedBinary(
+  const std::vector<uint8_t>& binary_data, const std::string& file_path,
+  const std::string& file_name, bool* is_present) {
+  LOG4CXX_INFO(logger_,
+               "SaveSharedBinary binary_size = " << binary_data.size());
+
+  if (binary_data.size() > file_system::GetAvailableDiskSpace(file_path)) {
+    LOG4CXX_ERROR(logger_, "Out of free disc space.");
+    return mobile_apis::Result::OUT_OF_MEMORY;
   }
 
-  file_system::Close(file_stream);
-  delete file_stream;
-  file_stream = NULL;
-  LOG4CXX_INFO(logger_, "Successfully write data to file");
-  return mobile_apis::Result::SUCCESS;
+  return app_file_storage_.WriteShared(file_path, file_name,
+                                       binary_data.data(), binary_data.size(),
+                                       is_present);
+}
+
+void ApplicationManagerImpl::OnAppStorageChanged(const std::string& path) {
+  app_file_storage_.Invalidate(path);
 }
 
 uint32_t ApplicationManagerImpl::GetAvailableSpaceForApp(
@@ -2891,7 +3480,8 @@ uint32_t ApplicationManagerImpl::GetAvailableSpaceForApp(
   app_storage_path += folder_name;
 
   if (file_system::DirectoryExists(app_storage_path)) {
-    size_t size_of_directory = file_system::DirectorySize(app_storage_path);
+    size_t size_of_directory =
+      app_file_storage_.DirectorySize(app_storage_path);
     if (app_quota < size_of_directory) {
       return 0;
     }
@@ -2920,6 +3510,46 @@ void ApplicationManagerImpl::OnApplicationListUpdateTimer() {
   policy::PolicyHandler::instance()->OnAppsSearchCompleted();
 }
 
+ApplicationManagerImpl::HMIListPublisher::HMIListPublisher(
+    ApplicationManagerImpl* callee, Callback callback)
+  : callee_(callee),
+    callback_(callback),
+    pending_(false) {
+}
+
+ApplicationManagerImpl::HMIListPublisher::~HMIListPublisher() {
+  Cancel();
+}
+
+void ApplicationManagerImpl::HMIListPublisher::Schedule(uint32_t delay_ms) {
+  if (0 == delay_ms) {
+    (callee_->*callback_)();
+    return;
+  }
+  sync_primitives::AutoLock lock(pending_lock_);
+  if (pending_) {
+    // Change is picked up when scheduled list is built
+    return;
+  }
+  pending_ = true;
+  timer::TimerWheel::instance()->Arm(this, delay_ms);
+}
+
+void ApplicationManagerImpl::HMIListPublisher::Cancel() {
+  timer::TimerWheel::instance()->Cancel(this);
+  sync_primitives::AutoLock lock(pending_lock_);
+  pending_ = false;
+}
+
+void ApplicationManagerImpl::HMIListPublisher::OnTimeout() {
+  {
+    // Reset before sending, so changes made meanwhile schedule new update
+    sync_primitives::AutoLock lock(pending_lock_);
+    pending_ = false;
+  }
+  (callee_->*callback_)();
+}
+
 void ApplicationManagerImpl::OnTimerSendTTSGlobalProperties() {
   std::vector<uint32_t> app_list;
   {
@@ -2931,7 +3561,7 @@ void ApplicationManagerImpl::OnTimerSendTTSGlobalProperties() {
     date_time::TimeCompare time_comp;
     for (; it != it_end; ++it) {
       time_comp = date_time::DateTime::compareTime(
-          date_time::DateTime::getCurrentTime(), it->second);
+          date_time::DateTime::getMonotonicTime(), it->second);
       if (date_time::GREATER == time_comp || date_time::EQUAL == time_comp) {
         app_list.push_back(it->first);
       }
@@ -2950,7 +3580,7 @@ void ApplicationManagerImpl::AddAppToTTSGlobalPropertiesList(
     const uint32_t app_id) {
   LOG4CXX_AUTO_TRACE(logger_);
   uint16_t timeout = profile::Profile::instance()->tts_global_properties_timeout();
-  TimevalStruct current_time = date_time::DateTime::getCurrentTime();
+  TimevalStruct current_time = date_time::DateTime::getMonotonicTime();
   current_time.tv_sec += timeout;
   // please avoid AutoLock usage to avoid deadlock
   tts_global_properties_app_list_lock_.Acquire();
@@ -2990,11 +3620,12 @@ void ApplicationManagerImpl::RemoveAppFromTTSGlobalPropertiesList(
 
 void ApplicationManagerImpl::CreatePhoneCallAppList() {
   LOG4CXX_AUTO_TRACE(logger_);
+  MobileMessageBatch batch;
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
 
-  ApplicationManagerImpl::ApplictionSetIt it = accessor.begin();
-  ApplicationManagerImpl::ApplictionSetIt itEnd = accessor.end();
+  ApplicationManagerImpl::ApplictionSetConstIt it = snapshot.begin();
+  ApplicationManagerImpl::ApplictionSetConstIt itEnd = snapshot.end();
 
   using namespace mobile_apis::HMILevel;
   using namespace helpers;
@@ -3019,6 +3650,7 @@ void ApplicationManagerImpl::CreatePhoneCallAppList() {
 
 void ApplicationManagerImpl::ResetPhoneCallAppList() {
   LOG4CXX_AUTO_TRACE(logger_);
+  MobileMessageBatch batch;
 
   std::map<uint32_t, AppState>::iterator it =
       on_phone_call_app_list_.begin();
@@ -3147,14 +3779,15 @@ bool ApplicationManagerImpl::CompareAppHMIType (const smart_objects::SmartObject
 void ApplicationManagerImpl::OnUpdateHMIAppType(
     std::map<std::string, std::vector<std::string> > app_hmi_types) {
   LOG4CXX_AUTO_TRACE(logger_);
+  MobileMessageBatch batch;
 
   std::map<std::string, std::vector<std::string> >::iterator it_app_hmi_types_from_policy;
   std::vector<std::string> hmi_types_from_policy;
   smart_objects::SmartObject transform_app_hmi_types(smart_objects::SmartType_Array);
   bool flag_diffirence_app_hmi_type = false;
-  ApplicationListAccessor accessor;
-  for (ApplictionSetIt it = accessor.begin();
-      it != accessor.end(); ++it) {
+  ApplicationListSnapshot snapshot;
+  for (ApplictionSetConstIt it = snapshot.begin();
+      it != snapshot.end(); ++it) {
 
     it_app_hmi_types_from_policy =
         app_hmi_types.find(((*it)->mobile_app_id()));
@@ -3269,6 +3902,147 @@ bool ApplicationManagerImpl::IsReadWriteAllowed(
   return true;
 }
 
+void ApplicationManagerImpl::OnButtonSubscriptionChanged(
+    uint32_t app_id, mobile_apis::ButtonName::eType btn_name,
+    bool subscribed) {
+  sync_primitives::AutoLock lock(applications_list_lock_);
+  ApplicationSharedPtr app = FindInIndex(apps_by_app_id_, app_id);
+  if (!app) {
+    // Not registered yet, subscriptions are indexed on insertion
+    return;
+  }
+  if (subscribed) {
+    button_subscribers_[btn_name].insert(app);
+    return;
+  }
+  SubscribersIndex::iterator it = button_subscribers_.find(btn_name);
+  if (button_subscribers_.end() != it) {
+    it->second.erase(app);
+    if (it->second.empty()) {
+      button_subscribers_.erase(it);
+    }
+  }
+}
+
+void ApplicationManagerImpl::OnIVISubscriptionChanged(
+    uint32_t app_id, uint32_t vehicle_info_type, bool subscribed) {
+  sync_primitives::AutoLock lock(applications_list_lock_);
+  ApplicationSharedPtr app = FindInIndex(apps_by_app_id_, app_id);
+  if (!app) {
+    return;
+  }
+  if (subscribed) {
+    ivi_subscribers_[vehicle_info_type].insert(app);
+    return;
+  }
+  SubscribersIndex::iterator it = ivi_subscribers_.find(vehicle_info_type);
+  if (ivi_subscribers_.end() != it) {
+    it->second.erase(app);
+    if (it->second.empty()) {
+      ivi_subscribers_.erase(it);
+    }
+  }
+}
+
+void ApplicationManagerImpl::OnInteriorVehicleDataSubscriptionChanged(
+    uint32_t app_id, const std::string& module_key, bool subscribed) {
+  sync_primitives::AutoLock lock(applications_list_lock_);
+  ApplicationSharedPtr app = FindInIndex(apps_by_app_id_, app_id);
+  if (!app) {
+    // Interior vehicle data subscriptions are not resumed
+    return;
+  }
+  if (subscribed) {
+    interior_vehicle_data_subscribers_[module_key].insert(app);
+    return;
+  }
+  InteriorSubscribersIndex::iterator it =
+      interior_vehicle_data_subscribers_.find(module_key);
+  if (interior_vehicle_data_subscribers_.end() != it) {
+    it->second.erase(app);
+    if (it->second.empty()) {
+      interior_vehicle_data_subscribers_.erase(it);
+    }
+  }
+}
+
+ApplicationManagerImpl::ApplicationSetSnapshotPtr
+ApplicationManagerImpl::applications_snapshot() const {
+  sync_primitives::AutoLock lock(applications_snapshot_lock_);
+  return applications_snapshot_;
+}
+
+void ApplicationManagerImpl::PublishApplicationsSnapshot() {
+  ApplicationSetSnapshotPtr snapshot =
+      utils::MakeShared<ApplictionSet>(applications_);
+  // Previous snapshot is released out of the lock by its last reader or here
+  ApplicationSetSnapshotPtr previous;
+  {
+    sync_primitives::AutoLock lock(applications_snapshot_lock_);
+    previous = applications_snapshot_;
+    applications_snapshot_ = snapshot;
+  }
+}
+
+void ApplicationManagerImpl::AddToIndexes(ApplicationSharedPtr app) {
+  apps_by_app_id_[app->app_id()] = app;
+  apps_by_hmi_app_id_[app->hmi_app_id()] = app;
+  apps_by_policy_app_id_.insert(std::make_pair(app->mobile_app_id(), app));
+
+  const std::set<mobile_apis::ButtonName::eType>& buttons =
+      app->SubscribedButtons();
+  for (std::set<mobile_apis::ButtonName::eType>::const_iterator it =
+       buttons.begin(); buttons.end() != it; ++it) {
+    button_subscribers_[*it].insert(app);
+  }
+  const std::set<uint32_t>& vehicle_info = app->SubscribesIVI();
+  for (std::set<uint32_t>::const_iterator it = vehicle_info.begin();
+       vehicle_info.end() != it; ++it) {
+    ivi_subscribers_[*it].insert(app);
+  }
+  app->set_subscriptions_observer(this);
+}
+
+void ApplicationManagerImpl::RemoveFromIndexes(ApplicationSharedPtr app) {
+  app->set_subscriptions_observer(NULL);
+  apps_by_app_id_.erase(app->app_id());
+  AppsByIdIndex::iterator hmi_it = apps_by_hmi_app_id_.find(app->hmi_app_id());
+  if (apps_by_hmi_app_id_.end() != hmi_it && hmi_it->second == app) {
+    apps_by_hmi_app_id_.erase(hmi_it);
+  }
+  std::pair<AppsByPolicyIdIndex::iterator, AppsByPolicyIdIndex::iterator>
+      range = apps_by_policy_app_id_.equal_range(app->mobile_app_id());
+  for (; range.first != range.second; ++range.first) {
+    if (range.first->second == app) {
+      apps_by_policy_app_id_.erase(range.first);
+      break;
+    }
+  }
+  // Subscriptions may be left after unregistration, drop all of them
+  SubscribersIndex* indexes[] = { &button_subscribers_, &ivi_subscribers_ };
+  for (size_t i = 0; i < ARRAYSIZE(indexes); ++i) {
+    SubscribersIndex::iterator it = indexes[i]->begin();
+    while (indexes[i]->end() != it) {
+      it->second.erase(app);
+      if (it->second.empty()) {
+        indexes[i]->erase(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
+  InteriorSubscribersIndex::iterator it =
+      interior_vehicle_data_subscribers_.begin();
+  while (interior_vehicle_data_subscribers_.end() != it) {
+    it->second.erase(app);
+    if (it->second.empty()) {
+      interior_vehicle_data_subscribers_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
 ApplicationManagerImpl::ApplicationListAccessor::~ApplicationListAccessor() {
 }
 
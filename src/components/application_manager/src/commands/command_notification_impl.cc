@@ -58,17 +58,29 @@ void CommandNotificationImpl::Run() {
 }
 
 void CommandNotificationImpl::SendNotification() {
-  (*message_)[strings::params][strings::protocol_type] = mobile_protocol_type_;
-  (*message_)[strings::params][strings::protocol_version] = protocol_version_;
-  (*message_)[strings::params][strings::message_type] =
-      static_cast<int32_t>(application_manager::MessageType::kNotification);
-
+  PrepareNotification();
   LOG4CXX_INFO(logger_, "SendNotification");
   MessageHelper::PrintSmartObject(*message_);
 
   ApplicationManagerImpl::instance()->SendMessageToMobile(message_);
 }
 
+void CommandNotificationImpl::SendBroadcastNotification() {
+  PrepareNotification();
+  LOG4CXX_INFO(logger_, "SendBroadcastNotification");
+  MessageHelper::PrintSmartObject(*message_);
+
+  ApplicationManagerImpl::instance()->SendMessageToMobile(
+      message_, false, &broadcast_json_);
+}
+
+void CommandNotificationImpl::PrepareNotification() {
+  (*message_)[strings::params][strings::protocol_type] = mobile_protocol_type_;
+  (*message_)[strings::params][strings::protocol_version] = protocol_version_;
+  (*message_)[strings::params][strings::message_type] =
+      static_cast<int32_t>(application_manager::MessageType::kNotification);
+}
+
 }  // namespace commands
 
 }  // namespace application_manager
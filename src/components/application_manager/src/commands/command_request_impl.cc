@@ -36,11 +36,24 @@
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/message_helper.h"
 #include "smart_objects/smart_object.h"
+#include "utils/memory_accounting.h"
+#ifdef TIME_TESTER
+#include "utils/rpc_trace.h"
+#endif  // TIME_TESTER
 
 namespace application_manager {
 
 namespace commands {
 
+namespace {
+// Requests with answers not depending on app sending them,
+// equal ones from several apps share single HMI request
+bool IsSharedHMIRequest(hmi_apis::FunctionID::eType function_id) {
+  return hmi_apis::FunctionID::VehicleInfo_GetVehicleData == function_id ||
+         hmi_apis::FunctionID::VehicleInfo_ReadDID == function_id;
+}
+}  // namespace
+
 struct DisallowedParamsInserter {
   DisallowedParamsInserter(smart_objects::SmartObject& response,
                            mobile_apis::VehicleDataResultCode::eType code)
@@ -174,6 +187,18 @@ void CommandRequestImpl::SendResponse(
   ApplicationManagerImpl::instance()->ManageMobileCommand(result);
 }
 
+bool CommandRequestImpl::CheckAppMemoryQuota() {
+  const size_t size =
+      MessageHelper::EstimateMemorySize((*message_)[strings::msg_params]);
+  if (utils::MemoryAccounting::instance()->HasRoom(connection_key(), size)) {
+    return true;
+  }
+  LOG4CXX_WARN(logger_, "Data of " << size << " bytes exceeds memory quota"
+               " of application " << connection_key());
+  SendResponse(false, mobile_apis::Result::OUT_OF_MEMORY);
+  return false;
+}
+
 bool CommandRequestImpl::CheckSyntax(std::string str, bool allow_empty_line) {
   if (std::string::npos != str.find_first_of("\t\n")) {
     LOG4CXX_ERROR(logger_, "CheckSyntax failed! :" << str);
@@ -204,7 +229,17 @@ void CommandRequestImpl::SendHMIRequest(
 
   const uint32_t hmi_correlation_id =
        ApplicationManagerImpl::instance()->GetNextHMICorrelationID();
-  if (use_events) {
+  if (use_events && msg_params && IsSharedHMIRequest(function_id)) {
+    smart_objects::SmartObject key(*msg_params);
+    key.erase(strings::app_id);
+    const int32_t awaited_id = subscribe_on_shared_event(
+        function_id, hmi_correlation_id, key, default_timeout());
+    if (static_cast<int32_t>(hmi_correlation_id) != awaited_id) {
+      LOG4CXX_DEBUG(logger_, "Waiting for response of HMI request "
+                    << function_id << " " << awaited_id);
+      return;
+    }
+  } else if (use_events) {
     LOG4CXX_DEBUG(logger_, "subscribe_on_event " << function_id << " " << hmi_correlation_id);
     subscribe_on_event(function_id, hmi_correlation_id);
   }
@@ -222,6 +257,10 @@ void CommandRequestImpl::SendHMIRequest(
     request[strings::msg_params] = *msg_params;
   }
 
+#ifdef TIME_TESTER
+  utils::RpcTracer::instance()->BindHmi(hmi_correlation_id, connection_key(),
+                                        correlation_id());
+#endif  // TIME_TESTER
   if (!ApplicationManagerImpl::instance()->ManageHMICommand(result)) {
     LOG4CXX_ERROR(logger_, "Unable to send request");
     SendResponse(false, mobile_apis::Result::OUT_OF_MEMORY);
@@ -368,11 +407,11 @@ bool CommandRequestImpl::CheckAllowedParameters() {
     return true;
   }
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
   ApplicationManagerImpl::ApplictionSetConstIt it_app_list =
-      accessor.begin();
+      snapshot.begin();
   ApplicationManagerImpl::ApplictionSetConstIt it_app_list_end =
-      accessor.end();
+      snapshot.end();
   for (; it_app_list != it_app_list_end; ++it_app_list) {
     if (connection_key() == (*it_app_list).get()->app_id()) {
 
@@ -74,8 +74,8 @@ void OnDriverDistractionNotification::Run() {
   (*on_driver_distraction)[strings::msg_params][mobile_notification::state] =
       state;
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const ApplicationManagerImpl::ApplictionSet applications = accessor.applications();
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  const ApplicationManagerImpl::ApplictionSet& applications = snapshot.applications();
 
   ApplicationManagerImpl::ApplictionSetConstIt it = applications.begin();
   for (; applications.end() != it; ++it) {
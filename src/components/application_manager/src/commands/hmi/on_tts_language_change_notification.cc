@@ -70,10 +70,10 @@ void OnTTSLanguageChangeNotification::Run() {
   (*message_)[strings::params][strings::function_id] =
       static_cast<int32_t>(mobile_apis::FunctionID::OnLanguageChangeID);
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
 
-  ApplicationManagerImpl::ApplictionSetIt it = accessor.begin();
-  for (;accessor.end() != it; ++it) {
+  ApplicationManagerImpl::ApplictionSetConstIt it = snapshot.begin();
+  for (;snapshot.end() != it; ++it) {
     ApplicationSharedPtr app = (*it);
     (*message_)[strings::params][strings::connection_key] = app->app_id();
     SendNotificationToMobile(message_);
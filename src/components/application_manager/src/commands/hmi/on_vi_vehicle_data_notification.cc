@@ -31,7 +31,9 @@
  */
 
 #include "application_manager/commands/hmi/on_vi_vehicle_data_notification.h"
+#include "application_manager/application_manager_impl.h"
 #include "interfaces/MOBILE_API.h"
+#include "utils/date_time.h"
 
 namespace application_manager {
 
@@ -48,6 +50,10 @@ OnVIVehicleDataNotification::~OnVIVehicleDataNotification() {
 void OnVIVehicleDataNotification::Run() {
   LOG4CXX_AUTO_TRACE(logger_);
 
+  ApplicationManagerImpl::instance()->vehicle_data_cache().Update(
+      (*message_)[strings::msg_params],
+      date_time::DateTime::getmSecs(date_time::DateTime::getMonotonicTime()));
+
   // prepare SmartObject for mobile factory
   (*message_)[strings::params][strings::function_id] =
       static_cast<int32_t>(mobile_apis::FunctionID::eType::OnVehicleDataID);
@@ -160,11 +160,11 @@ SDLActivateAppRequest::FindAllAppOnParticularDevice(
     const connection_handler::DeviceHandle handle) {
   DevicesApps apps;
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  ApplicationManagerImpl::ApplictionSet app_list = accessor.GetData();
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  const ApplicationManagerImpl::ApplictionSet& app_list = snapshot.applications();
 
-  ApplicationManagerImpl::ApplictionSetIt it = app_list.begin();
-  ApplicationManagerImpl::ApplictionSetIt it_end = app_list.end();
+  ApplicationManagerImpl::ApplictionSetConstIt it = app_list.begin();
+  ApplicationManagerImpl::ApplictionSetConstIt it_end = app_list.end();
 
   for (;it != it_end; ++it) {
     if (handle == (*it)->device()) {
@@ -30,9 +30,11 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include "application_manager/commands/hmi/vi_get_vehicle_data_response.h"
+#include "application_manager/application_manager_impl.h"
 #include "application_manager/event_engine/event.h"
 #include "application_manager/policies/policy_handler.h"
 #include "interfaces/HMI_API.h"
+#include "utils/date_time.h"
 
 namespace application_manager {
 namespace commands {
@@ -74,6 +76,13 @@ void VIGetVehicleDataResponse::Run() {
   } else {
     event.set_smart_object(*message_);
     policy::PolicyHandler::instance()->OnVehicleDataUpdated(*message_);
+    if (hmi_apis::Common_Result::SUCCESS ==
+        (*message_)[strings::params][hmi_response::code].asInt()) {
+      ApplicationManagerImpl::instance()->vehicle_data_cache().Update(
+          (*message_)[strings::msg_params],
+          date_time::DateTime::getmSecs(
+              date_time::DateTime::getMonotonicTime()));
+    }
   }
 
   event.raise();
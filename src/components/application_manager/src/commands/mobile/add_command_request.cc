@@ -36,6 +36,7 @@
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/application.h"
 #include "application_manager/message_helper.h"
+#include "utils/case_insensitive_string_set.h"
 #include "utils/file_system.h"
 
 namespace application_manager {
@@ -73,6 +74,10 @@ void AddCommandRequest::Run() {
     return;
   }
 
+  if (!CheckAppMemoryQuota()) {
+    return;
+  }
+
   if ((*message_)[strings::msg_params].keyExists(strings::cmd_icon)) {
     mobile_apis::Result::eType verification_result =
         MessageHelper::VerifyImage((*message_)[strings::msg_params]
@@ -236,6 +241,13 @@ bool AddCommandRequest::CheckCommandVRSynonym(ApplicationConstSharedPtr app) {
     return false;
   }
 
+  utils::CaseInsensitiveStringSet new_vr_commands;
+  const smart_objects::SmartObject& vr_commands =
+      (*message_)[strings::msg_params][strings::vr_commands];
+  for (size_t i = 0; i < vr_commands.length(); ++i) {
+    new_vr_commands.Insert(vr_commands[i].asString());
+  }
+
   const DataAccessor<CommandsMap> accessor = app->commands_map();
   const CommandsMap& commands = accessor.GetData();
   CommandsMap::const_iterator it = commands.begin();
@@ -246,21 +258,13 @@ bool AddCommandRequest::CheckCommandVRSynonym(ApplicationConstSharedPtr app) {
       continue;
     }
 
-    for (size_t i = 0; i < (*it->second)[strings::vr_commands].length(); ++i) {
-      for (size_t j = 0;
-          j < (*message_)[strings::msg_params][strings::vr_commands].length();
-          ++j) {
-        std::string vr_cmd_i =
-            (*it->second)[strings::vr_commands][i].asString();
-        std::string vr_cmd_j =
-            (*message_)[strings::msg_params]
-                        [strings::vr_commands][j].asString();
-
-        if (0 == strcasecmp(vr_cmd_i.c_str(), vr_cmd_j.c_str())) {
-          LOG4CXX_INFO(logger_, "AddCommandRequest::CheckCommandVRSynonym"
-                       " received command vr synonym already exist");
-          return false;
-        }
+    const smart_objects::SmartObject& app_vr_commands =
+        (*it->second)[strings::vr_commands];
+    for (size_t i = 0; i < app_vr_commands.length(); ++i) {
+      if (new_vr_commands.Contains(app_vr_commands[i].asString())) {
+        LOG4CXX_INFO(logger_, "AddCommandRequest::CheckCommandVRSynonym"
+                     " received command vr synonym already exist");
+        return false;
       }
     }
   }
@@ -58,6 +58,10 @@ void AddSubMenuRequest::Run() {
     return;
   }
 
+  if (!CheckAppMemoryQuota()) {
+    return;
+  }
+
   if (app->FindSubMenu(
       (*message_)[strings::msg_params][strings::menu_id].asInt())) {
     LOG4CXX_ERROR(logger_, "INVALID_ID");
@@ -379,15 +379,15 @@ mobile_apis::Result::eType ChangeRegistrationRequest::CheckCoincidence() {
   const smart_objects::SmartObject& msg_params =
       (*message_)[strings::msg_params];
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
   std::string app_name;
   uint32_t app_id = connection_key();
   if (msg_params.keyExists(strings::app_name)) {
     app_name = msg_params[strings::app_name].asString();
   }
 
-  ApplicationManagerImpl::ApplictionSetConstIt it = accessor.begin();
-  for (; accessor.end() != it; ++it) {
+  ApplicationManagerImpl::ApplictionSetConstIt it = snapshot.begin();
+  for (; snapshot.end() != it; ++it) {
     if (app_id == (*it)->app_id()) {
       continue;
     }
@@ -34,11 +34,14 @@
 #include <string.h>
 #include <string>
 #include <algorithm>
+#include <map>
 #include <vector>
 #include "application_manager/commands/mobile/create_interaction_choice_set_request.h"
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/application_impl.h"
 #include "application_manager/message_helper.h"
+#include "utils/case_insensitive_string_set.h"
+#include "config_profile/profile.h"
 
 namespace application_manager {
 
@@ -63,6 +66,11 @@ void CreateInteractionChoiceSetRequest::Run() {
     SendResponse(false, mobile_apis::Result::APPLICATION_NOT_REGISTERED);
     return;
   }
+
+  if (!CheckAppMemoryQuota()) {
+    return;
+  }
+
   for (uint32_t i = 0;
       i < (*message_)[strings::msg_params][strings::choice_set].length();
       ++i) {
@@ -108,8 +116,52 @@ void CreateInteractionChoiceSetRequest::Run() {
   (*message_)[strings::msg_params][strings::grammar_id] = grammar_id;
   app->AddChoiceSet(choice_set_id, (*message_)[strings::msg_params]);
   SendVRAddCommandRequest(app);
-  SendResponse(true, mobile_apis::Result::SUCCESS);
   app->UpdateHash();
+  if (profile::Profile::instance()->cache_choice_sets_on_hmi()) {
+    // Response waits for UI so PerformInteraction started right after it
+    // finds the set already on HMI
+    SendUICreateInteractionChoiceSetRequest(app);
+    return;
+  }
+  SendResponse(true, mobile_apis::Result::SUCCESS);
+}
+
+void CreateInteractionChoiceSetRequest::on_event(
+    const event_engine::Event& event) {
+  LOG4CXX_AUTO_TRACE(logger_);
+
+  switch (event.id()) {
+    case hmi_apis::FunctionID::UI_CreateInteractionChoiceSet: {
+      const smart_objects::SmartObject& message = event.smart_object();
+      const hmi_apis::Common_Result::eType result_code =
+          static_cast<hmi_apis::Common_Result::eType>(
+              message[strings::params][hmi_response::code].asInt());
+      ApplicationSharedPtr app =
+          ApplicationManagerImpl::instance()->application(connection_key());
+      if (app && hmi_apis::Common_Result::SUCCESS == result_code) {
+        app->set_choice_set_cached_on_hmi(
+            (*message_)[strings::msg_params]
+                [strings::interaction_choice_set_id].asUInt(),
+            true);
+      } else {
+        LOG4CXX_WARN(logger_, "Choice set is not cached on HMI, "
+                     "PerformInteraction sends it entirely");
+      }
+      // Choice set is stored by SDL in any case
+      SendResponse(true, mobile_apis::Result::SUCCESS);
+      break;
+    }
+    default: {
+      LOG4CXX_ERROR(logger_, "Received unknown event" << event.id());
+      return;
+    }
+  }
+}
+
+void CreateInteractionChoiceSetRequest::onTimeOut() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  // Choice set is stored by SDL, so it is still usable without HMI copy
+  SendResponse(true, mobile_apis::Result::SUCCESS);
 }
 
 mobile_apis::Result::eType CreateInteractionChoiceSetRequest::CheckChoiceSet(
@@ -119,101 +171,79 @@ mobile_apis::Result::eType CreateInteractionChoiceSetRequest::CheckChoiceSet(
   const smart_objects::SmartArray* new_choice_set_array =
     (*message_)[strings::msg_params][strings::choice_set].asArray();
 
-  smart_objects::SmartArray::const_iterator it_array =
-      new_choice_set_array->begin();
-
-  smart_objects::SmartArray::const_iterator it_array_end =
-      new_choice_set_array->end();
-
-  // Self check of new choice set for params coincidence
-  for (; it_array != it_array_end; ++it_array) {
+  // Index new choice set once instead of comparing every choice with
+  // each other. VR command is duplicated if it is repeated in one choice
+  // or used by another choice, in both cases ignoring differences in case
+  std::map<uint32_t, size_t> choice_ids;
+  std::map<std::string, size_t> menu_names;
+  std::vector<bool> has_duplicate_vr_commands(new_choice_set_array->size());
+  utils::CaseInsensitiveStringSet vr_commands;
+  utils::CaseInsensitiveStringSet repeated_vr_commands;
+  for (size_t index = 0; index < new_choice_set_array->size(); ++index) {
+    const smart_objects::SmartObject& choice = (*new_choice_set_array)[index];
+    ++choice_ids[choice[strings::choice_id].asUInt()];
+    ++menu_names[choice[strings::menu_name].asString()];
     const smart_objects::SmartArray* vr_array =
-        (*it_array)[strings::vr_commands].asArray();
-
-    CoincidencePredicateChoiceID c((*it_array)[strings::choice_id].asInt());
-    if (1 != std::count_if(
-        new_choice_set_array->begin(),
-        new_choice_set_array->end(),
-        c)) {
+        choice[strings::vr_commands].asArray();
+    DCHECK(vr_array != NULL);
+    if (!vr_array) {
+      continue;
+    }
+    utils::CaseInsensitiveStringSet choice_vr_commands;
+    for (smart_objects::SmartArray::const_iterator it_vr = vr_array->begin();
+         it_vr != vr_array->end(); ++it_vr) {
+      const std::string vr_command = it_vr->asString();
+      if (!choice_vr_commands.Insert(vr_command)) {
+        has_duplicate_vr_commands[index] = true;
+      } else if (!vr_commands.Insert(vr_command)) {
+        repeated_vr_commands.Insert(vr_command);
+      }
+    }
+  }
 
+  for (size_t index = 0; index < new_choice_set_array->size(); ++index) {
+    const smart_objects::SmartObject& choice = (*new_choice_set_array)[index];
+    const uint32_t choice_id = choice[strings::choice_id].asUInt();
+    if (1 != choice_ids[choice_id]) {
       LOG4CXX_ERROR(logger_, "Incoming choice set has duplicate IDs.");
       return mobile_apis::Result::INVALID_ID;
     }
 
     // Check new choice set params along with already registered choice sets
-    const DataAccessor<ChoiceSetMap> accessor = app->choice_set_map();
-    const ChoiceSetMap& app_choice_set_map = accessor.GetData();
-    ChoiceSetMap::const_iterator it = app_choice_set_map.begin();
-    ChoiceSetMap::const_iterator itEnd = app_choice_set_map.end();
-    for (; it != itEnd; ++it) {
-      const smart_objects::SmartObject* app_choice_set = it->second;
-      if (NULL != app_choice_set) {
-
-        const smart_objects::SmartArray* curr_choice_set =
-            (*app_choice_set)[strings::choice_set].asArray();
-
-        if (0 != std::count_if(
-            curr_choice_set->begin(),
-            curr_choice_set->end(),
-            c)) {
-          LOG4CXX_ERROR(logger_, "Incoming choice ID already exists.");
-          return mobile_apis::Result::INVALID_ID;
-        }
-      }
+    if (app->IsChoiceIdAlreadyExist(choice_id)) {
+      LOG4CXX_ERROR(logger_, "Incoming choice ID already exists.");
+      return mobile_apis::Result::INVALID_ID;
     }
 
-    CoincidencePredicateMenuName m((*it_array)[strings::menu_name].asString());
-    if (1 != std::count_if(
-        new_choice_set_array->begin(),
-        new_choice_set_array->end(),
-        m)) {
-
+    if (1 != menu_names[choice[strings::menu_name].asString()]) {
       LOG4CXX_ERROR(logger_, "Incoming choice set has duplicate menu names.");
       return mobile_apis::Result::DUPLICATE_NAME;
     }
 
     // Check coincidence inside the current choice
-
-    smart_objects::SmartArray::const_iterator it_vr = vr_array->begin();
-    smart_objects::SmartArray::const_iterator it_vr_end = vr_array->end();
-
-    for (; it_vr != it_vr_end; ++it_vr) {
-      CoincidencePredicateVRCommands v((*it_vr));
-      if (1 != std::count_if(vr_array->begin(), vr_array->end(), v)) {
-
-        LOG4CXX_ERROR(logger_,
-                      "Incoming choice set has duplicate VR command(s)");
-
-        return mobile_apis::Result::DUPLICATE_NAME;
-      }
+    if (has_duplicate_vr_commands[index]) {
+      LOG4CXX_ERROR(logger_,
+                    "Incoming choice set has duplicate VR command(s)");
+      return mobile_apis::Result::DUPLICATE_NAME;
     }
 
     // Check along with VR commands in other choices in the new set
-    smart_objects::SmartArray::const_iterator it_same_array =
-        new_choice_set_array->begin();
-
-    smart_objects::SmartArray::const_iterator it_same_array_end =
-        new_choice_set_array->end();
-
-    for (; it_same_array != it_same_array_end; ++it_same_array) {
-
-      // Skip check for itself
-      if ((*it_array)[strings::choice_id] ==
-          (*it_same_array)[strings::choice_id]) {
-
-        continue;
-      }
-
-      if (compareSynonyms((*it_array), (*it_same_array))) {
-
-        LOG4CXX_ERROR(logger_,
-                      "Incoming choice set has duplicate VR command(s).");
-
-        return mobile_apis::Result::DUPLICATE_NAME;
+    const smart_objects::SmartArray* vr_array =
+        choice[strings::vr_commands].asArray();
+    if (vr_array) {
+      for (smart_objects::SmartArray::const_iterator it_vr = vr_array->begin();
+           it_vr != vr_array->end(); ++it_vr) {
+        if (repeated_vr_commands.Contains(it_vr->asString())) {
+          LOG4CXX_INFO(logger_, "Incoming choice set has duplicated VR "
+                       "synonyms " << it_vr->asString());
+          LOG4CXX_ERROR(logger_,
+                        "Incoming choice set has duplicate VR command(s).");
+          return mobile_apis::Result::DUPLICATE_NAME;
+        }
       }
     }
 
-    if (IsWhiteSpaceExist((*it_array))) {
+    if (IsWhiteSpaceExist(choice)) {
       LOG4CXX_ERROR(logger_,
                     "Incoming choice set has contains \t\n \\t \\n");
       return mobile_apis::Result::INVALID_DATA;
@@ -223,39 +253,6 @@ mobile_apis::Result::eType CreateInteractionChoiceSetRequest::CheckChoiceSet(
   return mobile_apis::Result::SUCCESS;
 }
 
-bool CreateInteractionChoiceSetRequest::compareSynonyms(
-    const NsSmartDeviceLink::NsSmartObjects::SmartObject& choice1,
-    const NsSmartDeviceLink::NsSmartObjects::SmartObject& choice2) {
-
-  smart_objects::SmartArray* vr_cmds_1 =
-      choice1[strings::vr_commands].asArray();
-  DCHECK(vr_cmds_1 != NULL);
-  smart_objects::SmartArray* vr_cmds_2 =
-      choice2[strings::vr_commands].asArray();
-  DCHECK(vr_cmds_2 != NULL);
-
-  smart_objects::SmartArray::iterator it;
-  it = std::find_first_of(vr_cmds_1->begin(), vr_cmds_1->end(),
-                          vr_cmds_2->begin(), vr_cmds_2->end(),
-                          CreateInteractionChoiceSetRequest::compareStr);
-
-
-  if (it != vr_cmds_1->end()) {
-    LOG4CXX_INFO(logger_, "Incoming choice set has duplicated VR synonyms "
-                 << it->asString());
-    return true;
-  }
-
-  return false;
-}
-
-bool CreateInteractionChoiceSetRequest::compareStr(
-    const NsSmartDeviceLink::NsSmartObjects::SmartObject& str1,
-    const NsSmartDeviceLink::NsSmartObjects::SmartObject& str2) {
-
-  return 0 == strcasecmp(str1.asCharArray(), str2.asCharArray());
-}
-
 bool CreateInteractionChoiceSetRequest::IsWhiteSpaceExist(
     const smart_objects::SmartObject& choice_set) {
   LOG4CXX_AUTO_TRACE(logger_);
@@ -338,6 +335,26 @@ void CreateInteractionChoiceSetRequest::SendVRAddCommandRequest(
 
 }
 
+void CreateInteractionChoiceSetRequest::SendUICreateInteractionChoiceSetRequest(
+    ApplicationConstSharedPtr app) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  const smart_objects::SmartObject& choice_set =
+      (*message_)[strings::msg_params];
+
+  smart_objects::SmartObject msg_params(smart_objects::SmartType_Map);
+  msg_params[strings::app_id] = app->app_id();
+  msg_params[strings::interaction_choice_set_id] =
+      choice_set[strings::interaction_choice_set_id];
+  msg_params[strings::choice_set] = choice_set[strings::choice_set];
+  // VR commands are kept by VR.AddCommand, UI shows the rest only
+  for (size_t i = 0; i < msg_params[strings::choice_set].length(); ++i) {
+    msg_params[strings::choice_set][i].erase(strings::vr_commands);
+  }
+
+  SendHMIRequest(hmi_apis::FunctionID::UI_CreateInteractionChoiceSet,
+                 &msg_params, true);
+}
+
 
 }  // namespace commands
 
@@ -81,6 +81,7 @@ void DeleteFileRequest::Run() {
 
   if (file_system::FileExists(full_file_path)) {
     if (file_system::DeleteFile(full_file_path)) {
+      ApplicationManagerImpl::instance()->OnAppStorageChanged(full_file_path);
       const AppFile* file = application->GetFile(full_file_path);
       if (file) {
         SendFileRemovedNotification(file);
@@ -84,11 +84,13 @@ void DeleteInteractionChoiceSetRequest::Run() {
   msg_params[strings::interaction_choice_set_id] = choise_set_id;
   msg_params[strings::app_id] = app->app_id();
 
+  if (app->is_choice_set_cached_on_hmi(choise_set_id)) {
+    SendHMIRequest(hmi_apis::FunctionID::UI_DeleteInteractionChoiceSet,
+                   &msg_params);
+  }
   app->RemoveChoiceSet(choise_set_id);
 
   SendResponse(true, mobile_apis::Result::SUCCESS);
-  /*CreateHMIRequest(hmi_apis::FunctionID::UI_DeleteInteractionChoiceSet,
-   msg_params, true);*/
 }
 
 bool DeleteInteractionChoiceSetRequest::ChoiceSetInUse(ApplicationConstSharedPtr app) {
@@ -38,6 +38,7 @@
 #include "application_manager/message_helper.h"
 #include "interfaces/MOBILE_API.h"
 #include "interfaces/HMI_API.h"
+#include "utils/date_time.h"
 
 namespace application_manager {
 
@@ -249,6 +250,21 @@ void GetVehicleDataRequest::Run() {
     }
   }
   if (msg_params.length() > min_length_msg_params) {
+    // Parameters disallowed by policy are already removed from request
+    VehicleDataCache& cache =
+        ApplicationManagerImpl::instance()->vehicle_data_cache();
+    if (cache.enabled()) {
+      smart_objects::SmartObject requested(msg_params);
+      requested.erase(strings::app_id);
+      smart_objects::SmartObject cached(smart_objects::SmartType_Map);
+      if (cache.Get(requested, date_time::DateTime::getmSecs(
+                                   date_time::DateTime::getMonotonicTime()),
+                    &cached)) {
+        LOG4CXX_DEBUG(logger_, "Vehicle data is sent from cache");
+        SendResponse(true, mobile_apis::Result::SUCCESS, NULL, &cached);
+        return;
+      }
+    }
     SendHMIRequest(hmi_apis::FunctionID::VehicleInfo_GetVehicleData,
                    &msg_params, true);
     return;
@@ -92,11 +92,11 @@ void OnHMIStatusNotificationFromMobile::Run() {
                   " for handle: " << handle);
 
     if (ProtocolVersion::kV4 == app->protocol_version()) {
-      ApplicationManagerImpl::ApplicationListAccessor accessor;
+      ApplicationManagerImpl::ApplicationListSnapshot snapshot;
 
       bool is_another_foreground_sdl4_app = false;
-      ApplicationManagerImpl::ApplictionSetIt it = accessor.begin();
-      for (;accessor.end() != it; ++it) {
+      ApplicationManagerImpl::ApplictionSetConstIt it = snapshot.begin();
+      for (;snapshot.end() != it; ++it) {
         if (connection_key() != (*it)->app_id() &&
             ProtocolVersion::kV4 == (*it)->protocol_version() &&
            (*it)->is_foreground()) {
@@ -62,7 +62,7 @@ void OnTBTClientStateNotification::Run() {
     ApplicationSharedPtr app = *it;
     if (mobile_apis::HMILevel::eType::HMI_NONE != app->hmi_level()) {
       (*message_)[strings::params][strings::connection_key] = app->app_id();
-      SendNotification();
+      SendBroadcastNotification();
     }
   }
 }
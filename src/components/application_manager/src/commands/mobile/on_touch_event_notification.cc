@@ -60,7 +60,7 @@ void OnTouchEventNotification::Run() {
     ApplicationSharedPtr app = *it;
     if (mobile_apis::HMILevel::HMI_FULL == app->hmi_level()) {
       (*message_)[strings::params][strings::connection_key] = app->app_id();
-      SendNotification();
+      SendBroadcastNotification();
     }
   }
 }
@@ -52,35 +52,40 @@ OnVehicleDataNotification::~OnVehicleDataNotification() {
 void OnVehicleDataNotification::Run() {
   LOG4CXX_AUTO_TRACE(logger_);
 
+  // Notification carries a few of all vehicle data, so subscribers are
+  // looked up only for present ones and every subscriber gets it once
   const VehicleData& vehicle_data = MessageHelper::vehicle_data();
-  VehicleData::const_iterator it = vehicle_data.begin();
-
-  for (; vehicle_data.end() != it; ++it) {
-    if (true == (*message_)[strings::msg_params].keyExists(it->first)) {
-      const std::vector<utils::SharedPtr<Application>>& applications =
-            ApplicationManagerImpl::instance()->IviInfoUpdated(it->second,
-                (*message_)[strings::msg_params][it->first].asInt());
-
-      std::vector<utils::SharedPtr<Application>>::const_iterator it = applications.begin();
-      for (; applications.end() != it; ++it) {
-        utils::SharedPtr<Application> app = *it;
-        if (!app) {
-          LOG4CXX_ERROR_EXT(logger_, "NULL pointer");
-          continue;
-        }
+  const std::set<std::string> keys =
+      (*message_)[strings::msg_params].enumerate();
+  ApplicationManagerImpl::ApplictionSet subscribers;
+  for (std::set<std::string>::const_iterator key = keys.begin();
+       keys.end() != key; ++key) {
+    VehicleData::const_iterator it = vehicle_data.find(*key);
+    if (vehicle_data.end() == it) {
+      continue;
+    }
+    const std::vector<ApplicationSharedPtr> applications =
+        ApplicationManagerImpl::instance()->IviInfoUpdated(
+          it->second, (*message_)[strings::msg_params][*key].asInt());
+    subscribers.insert(applications.begin(), applications.end());
+  }
 
-        LOG4CXX_INFO(
-          logger_,
-          "Send OnVehicleData PRNDL notification to " << app->name()
-          << " application id " << app->app_id());
+  ApplicationManagerImpl::ApplictionSetConstIt it = subscribers.begin();
+  for (; subscribers.end() != it; ++it) {
+    ApplicationSharedPtr app = *it;
+    if (!app) {
+      LOG4CXX_ERROR_EXT(logger_, "NULL pointer");
+      continue;
+    }
 
-        (*message_)[strings::params][strings::connection_key] = app->app_id();
+    LOG4CXX_INFO(
+      logger_,
+      "Send OnVehicleData notification to " << app->name()
+      << " application id " << app->app_id());
 
-        SendNotification();
-      }
+    (*message_)[strings::params][strings::connection_key] = app->app_id();
 
-      return;
-    }
+    SendBroadcastNotification();
   }
 }
 
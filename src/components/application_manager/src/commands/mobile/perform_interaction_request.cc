@@ -32,6 +32,7 @@
  */
 
 #include <string.h>
+#include <set>
 #include <string>
 #include "application_manager/commands/mobile/perform_interaction_request.h"
 #include "application_manager/application_manager_impl.h"
@@ -40,6 +41,7 @@
 #include "config_profile/profile.h"
 #include "interfaces/MOBILE_API.h"
 #include "interfaces/HMI_API.h"
+#include "utils/case_insensitive_string_set.h"
 #include "utils/file_system.h"
 
 namespace application_manager {
@@ -457,8 +459,17 @@ void PerformInteractionRequest::SendUIPerformInteractionRequest(
       // save perform interaction choice set
       app->AddPerformInteractionChoiceSet(choice_set_id_list[i].asInt(),
                                           *choice_set);
+      // HMI already has this set, so it is referred to by ID only
+      const bool is_cached_on_hmi =
+          app->is_choice_set_cached_on_hmi(choice_set_id_list[i].asUInt());
+      if (is_cached_on_hmi && mobile_apis::InteractionMode::VR_ONLY != mode) {
+        smart_objects::SmartObject& cached_id_list =
+            msg_params[strings::interaction_choice_set_id_list];
+        cached_id_list[cached_id_list.length()] = choice_set_id_list[i];
+      }
       for (size_t j = 0; j < (*choice_set)[strings::choice_set].length(); ++j) {
-        if (mobile_apis::InteractionMode::VR_ONLY != mode) {
+        if (mobile_apis::InteractionMode::VR_ONLY != mode &&
+            !is_cached_on_hmi) {
           size_t index = msg_params[strings::choice_set].length();
           msg_params[strings::choice_set][index] =
               (*choice_set)[strings::choice_set][j];
@@ -474,12 +485,17 @@ void PerformInteractionRequest::SendUIPerformInteractionRequest(
             smart_objects::SmartObject item(smart_objects::SmartType_Map);
             item[strings::text] = vr_commands[0].asString();
             item[strings::position] = index_array_of_vr_help + 1;
-            msg_params[strings::vr_help][index_array_of_vr_help++] = item;
+            msg_params[strings::vr_help][index_array_of_vr_help++].swap(item);
           }
         }
       }
     }
   }
+  if (msg_params.keyExists(strings::choice_set) &&
+      0 == msg_params[strings::choice_set].length()) {
+    // all sets are cached on HMI, empty array is not allowed by HMI API
+    msg_params.erase(strings::choice_set);
+  }
   if ((*message_)[strings::msg_params]
                   .keyExists(hmi_request::interaction_layout)
         && mobile_apis::InteractionMode::VR_ONLY != mode) {
@@ -548,7 +564,7 @@ void PerformInteractionRequest::SendVRPerformInteractionRequest(
             item[strings::type] = hmi_apis::Common_SpeechCapabilities::SC_TEXT;
             item[strings::text] = vr_commands[0].asString() +
                                   profile::Profile::instance()->tts_delimiter();
-            msg_params[strings::help_prompt][index++] = item;
+            msg_params[strings::help_prompt][index++].swap(item);
           }
         }
       } else {
@@ -591,45 +607,30 @@ bool PerformInteractionRequest::CheckChoiceSetMenuNames(
   smart_objects::SmartObject& choice_list =
       (*message_)[strings::msg_params][strings::interaction_choice_set_id_list];
 
+  // Menu names are unique inside of every choice set, so any name met twice
+  // is shared by different choice sets
+  std::set<std::string> menu_names;
   for (size_t i = 0; i < choice_list.length(); ++i) {
     // choice_set contains SmartObject msg_params
     smart_objects::SmartObject* i_choice_set = app->FindChoiceSet(
         choice_list[i].asInt());
 
-    for (size_t j = 0; j < choice_list.length(); ++j) {
-      smart_objects::SmartObject* j_choice_set = app->FindChoiceSet(
-          choice_list[j].asInt());
-
-      if (i == j) {
-        // skip check the same element
-        continue;
-      }
+    if (!i_choice_set) {
+      LOG4CXX_ERROR(logger_, "Invalid ID");
+      SendResponse(false, mobile_apis::Result::INVALID_ID);
+      return false;
+    }
 
-      if (!i_choice_set || !j_choice_set) {
-        LOG4CXX_ERROR(logger_, "Invalid ID");
-        SendResponse(false, mobile_apis::Result::INVALID_ID);
+    const smart_objects::SmartObject& choices =
+        (*i_choice_set)[strings::choice_set];
+    for (size_t ii = 0; ii < choices.length(); ++ii) {
+      if (!menu_names.insert(choices[ii][strings::menu_name].asString())
+          .second) {
+        LOG4CXX_ERROR(logger_, "Choice set has duplicated menu name");
+        SendResponse(false, mobile_apis::Result::DUPLICATE_NAME,
+                     "Choice set has duplicated menu name");
         return false;
       }
-
-      size_t ii = 0;
-      size_t jj = 0;
-      for (; ii < (*i_choice_set)[strings::choice_set].length(); ++ii) {
-        for (; jj < (*j_choice_set)[strings::choice_set].length(); ++jj) {
-          std::string ii_menu_name =
-              (*i_choice_set)[strings::choice_set][ii][strings::menu_name]
-                  .asString();
-          std::string jj_menu_name =
-              (*j_choice_set)[strings::choice_set][jj][strings::menu_name]
-                  .asString();
-
-          if (ii_menu_name == jj_menu_name) {
-            LOG4CXX_ERROR(logger_, "Choice set has duplicated menu name");
-            SendResponse(false, mobile_apis::Result::DUPLICATE_NAME,
-                         "Choice set has duplicated menu name");
-            return false;
-          }
-        }
-      }
     }
   }
 
@@ -641,49 +642,31 @@ bool PerformInteractionRequest::CheckChoiceSetVRSynonyms(
   smart_objects::SmartObject& choice_list =
       (*message_)[strings::msg_params][strings::interaction_choice_set_id_list];
 
+  // VR commands are unique inside of every choice set, so any command met
+  // twice is shared by different choice sets
+  utils::CaseInsensitiveStringSet vr_commands;
   for (size_t i = 0; i < choice_list.length(); ++i) {
     // choice_set contains SmartObject msg_params
     smart_objects::SmartObject* i_choice_set = app->FindChoiceSet(
         choice_list[i].asInt());
 
-    for (size_t j = 0; j < choice_list.length(); ++j) {
-      smart_objects::SmartObject* j_choice_set = app->FindChoiceSet(
-          choice_list[j].asInt());
-
-      if (i == j) {
-        // skip check the same element
-        continue;
-      }
-
-      if ((!i_choice_set) || (!j_choice_set)) {
-        LOG4CXX_ERROR(logger_, "Invalid ID");
-        SendResponse(false, mobile_apis::Result::INVALID_ID);
-        return false;
-      }
+    if (!i_choice_set) {
+      LOG4CXX_ERROR(logger_, "Invalid ID");
+      SendResponse(false, mobile_apis::Result::INVALID_ID);
+      return false;
+    }
 
-      size_t ii = 0;
-      size_t jj = 0;
-      for (; ii < (*i_choice_set)[strings::choice_set].length(); ++ii) {
-        for (; jj < (*j_choice_set)[strings::choice_set].length(); ++jj) {
-          // choice_set pointer contains SmartObject msg_params
-          smart_objects::SmartObject& ii_vr_commands =
-              (*i_choice_set)[strings::choice_set][ii][strings::vr_commands];
-
-          smart_objects::SmartObject& jj_vr_commands =
-              (*j_choice_set)[strings::choice_set][jj][strings::vr_commands];
-
-          for (size_t iii = 0; iii < ii_vr_commands.length(); ++iii) {
-            for (size_t jjj = 0; jjj < jj_vr_commands.length(); ++jjj) {
-              std::string vr_cmd_i = ii_vr_commands[iii].asString();
-              std::string vr_cmd_j = jj_vr_commands[jjj].asString();
-              if (0 == strcasecmp(vr_cmd_i.c_str(), vr_cmd_j.c_str())) {
-                LOG4CXX_ERROR(logger_, "Choice set has duplicated VR synonym");
-                SendResponse(false, mobile_apis::Result::DUPLICATE_NAME,
-                             "Choice set has duplicated VR synonym");
-                return false;
-              }
-            }
-          }
+    const smart_objects::SmartObject& choices =
+        (*i_choice_set)[strings::choice_set];
+    for (size_t ii = 0; ii < choices.length(); ++ii) {
+      const smart_objects::SmartObject& ii_vr_commands =
+          choices[ii][strings::vr_commands];
+      for (size_t iii = 0; iii < ii_vr_commands.length(); ++iii) {
+        if (!vr_commands.Insert(ii_vr_commands[iii].asString())) {
+          LOG4CXX_ERROR(logger_, "Choice set has duplicated VR synonym");
+          SendResponse(false, mobile_apis::Result::DUPLICATE_NAME,
+                       "Choice set has duplicated VR synonym");
+          return false;
         }
       }
     }
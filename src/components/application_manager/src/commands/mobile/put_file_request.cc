@@ -69,7 +69,7 @@ void PutFileRequest::Run() {
   }
 
   if (mobile_api::HMILevel::HMI_NONE == application->hmi_level() &&
-      profile::Profile::instance()->put_file_in_none() <=
+      profile::Profile::instance()->snapshot().put_file_in_none <=
       application->put_file_in_none_count()) {
     // If application is in the HMI_NONE level the quantity of allowed
     // PutFile request is limited by the configuration profile
@@ -109,8 +109,17 @@ void PutFileRequest::Run() {
   file_type_ =
     static_cast<mobile_apis::FileType::eType>(
       (*message_)[strings::msg_params][strings::file_type].asInt());
-  const std::vector<uint8_t> binary_data =
-    (*message_)[strings::params][strings::binary_data].asBinary();
+  // Payload is referenced in place, chunks of big files are not copied
+  const std::vector<uint8_t>* binary_data_ptr =
+    (*message_)[strings::params][strings::binary_data].asBinaryPtr();
+  if (!binary_data_ptr) {
+    LOG4CXX_ERROR(logger_, "Binary data is not binary");
+    SendResponse(false, mobile_apis::Result::INVALID_DATA,
+                 "Binary data empty",
+                 &response_params);
+    return;
+  }
+  const std::vector<uint8_t>& binary_data = *binary_data_ptr;
 
   // Policy table update in json format is currently to be received via PutFile
   // TODO(PV): after latest discussion has to be changed
@@ -172,7 +181,18 @@ void PutFileRequest::Run() {
     return;
   }
 
+  // Files sent in one part, e.g. images, are often uploaded by many apps
+  // or again on every registration, so their content is shared
+  const bool is_whole_file = 0 == offset_ &&
+      (!(*message_)[strings::msg_params].keyExists(strings::length) ||
+       static_cast<uint64_t>(
+         (*message_)[strings::msg_params][strings::length].asInt64()) ==
+       binary_data.size());
+  bool is_present = false;
   mobile_apis::Result::eType save_result =
+      is_whole_file && !is_system_file ?
+      ApplicationManagerImpl::instance()->SaveSharedBinary(
+        binary_data, file_path, sync_file_name_, &is_present) :
       ApplicationManagerImpl::instance()->SaveBinary(binary_data, file_path,
                                                      sync_file_name_, offset_);
 
@@ -217,7 +237,10 @@ void PutFileRequest::Run() {
         }
       }
 
-      SendResponse(true, save_result, "File was downloaded", &response_params);
+      SendResponse(true, save_result,
+                   is_present ? "File is already present" :
+                                "File was downloaded",
+                   &response_params);
       if (is_system_file) {
         SendOnPutFileNotification();
       }
@@ -371,6 +371,11 @@ void RegisterAppInterfaceRequest::Run() {
   const smart_objects::SmartObject& msg_params =
     (*message_)[strings::msg_params];
 
+  // Registration sends response, OnAppRegistered, resumption and capability
+  // messages in one pass, post them to queues at once
+  ApplicationManagerImpl::MobileMessageBatch mobile_batch;
+  ApplicationManagerImpl::HMIMessageBatch hmi_batch;
+
   ApplicationSharedPtr app =
     ApplicationManagerImpl::instance()->RegisterApplication(message_);
 
@@ -441,8 +446,6 @@ void RegisterAppInterfaceRequest::Run() {
 
 void RegisterAppInterfaceRequest::SendRegisterAppInterfaceResponseToMobile(
   mobile_apis::Result::eType result) {
-  smart_objects::SmartObject response_params(smart_objects::SmartType_Map);
-
   ApplicationManagerImpl* app_manager = ApplicationManagerImpl::instance();
   const HMICapabilities& hmi_capabilities = app_manager->hmi_capabilities();
   const uint32_t key = connection_key();
@@ -455,6 +458,10 @@ void RegisterAppInterfaceRequest::SendRegisterAppInterfaceResponseToMobile(
     return;
   }
 
+  // Capabilities are put together once for all registrations
+  smart_objects::SmartObject response_params(
+      hmi_capabilities.register_app_interface_capabilities());
+
   response_params[strings::sync_msg_version][strings::major_version] =
     APIVersion::kAPIV3;
   response_params[strings::sync_msg_version][strings::minor_version] =
@@ -490,98 +497,6 @@ void RegisterAppInterfaceRequest::SendRegisterAppInterfaceResponseToMobile(
     result = mobile_apis::Result::WRONG_LANGUAGE;
   }
 
-  if (hmi_capabilities.display_capabilities()) {
-    response_params[hmi_response::display_capabilities] =
-      smart_objects::SmartObject(smart_objects::SmartType_Map);
-
-    smart_objects::SmartObject& display_caps =
-      response_params[hmi_response::display_capabilities];
-
-    display_caps[hmi_response::display_type] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::display_type);
-
-    display_caps[hmi_response::text_fields] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::text_fields);
-
-    display_caps[hmi_response::image_fields] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::image_fields);
-
-    display_caps[hmi_response::media_clock_formats] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::media_clock_formats);
-
-    display_caps[hmi_response::templates_available] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::templates_available);
-
-    display_caps[hmi_response::screen_params] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::screen_params);
-
-    display_caps[hmi_response::num_custom_presets_available] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::num_custom_presets_available);
-
-    if (hmi_capabilities.display_capabilities()->getElement(
-          hmi_response::image_capabilities).length() > 0) {
-      display_caps[hmi_response::graphic_supported] = true;
-    } else {
-      display_caps[hmi_response::graphic_supported] = false;
-    }
-
-    display_caps[hmi_response::templates_available] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::templates_available);
-
-    display_caps[hmi_response::screen_params] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::screen_params);
-
-    display_caps[hmi_response::num_custom_presets_available] =
-      hmi_capabilities.display_capabilities()->getElement(
-        hmi_response::num_custom_presets_available);
-  }
-
-  if (hmi_capabilities.button_capabilities()) {
-    response_params[hmi_response::button_capabilities] =
-      *hmi_capabilities.button_capabilities();
-  }
-  if (hmi_capabilities.soft_button_capabilities()) {
-    response_params[hmi_response::soft_button_capabilities] =
-      *hmi_capabilities.soft_button_capabilities();
-  }
-  if (hmi_capabilities.preset_bank_capabilities()) {
-    response_params[hmi_response::preset_bank_capabilities] =
-      *hmi_capabilities.preset_bank_capabilities();
-  }
-  if (hmi_capabilities.hmi_zone_capabilities()) {
-    response_params[hmi_response::hmi_zone_capabilities] =
-      *hmi_capabilities.hmi_zone_capabilities();
-  }
-  if (hmi_capabilities.speech_capabilities()) {
-    response_params[strings::speech_capabilities] =
-      *hmi_capabilities.speech_capabilities();
-  }
-  if (hmi_capabilities.vr_capabilities()) {
-    response_params[strings::vr_capabilities] =
-      *hmi_capabilities.vr_capabilities();
-  }
-  if (hmi_capabilities.audio_pass_thru_capabilities()) {
-    response_params[strings::audio_pass_thru_capabilities] =
-      *hmi_capabilities.audio_pass_thru_capabilities();
-  }
-  if (hmi_capabilities.vehicle_type()) {
-    response_params[hmi_response::vehicle_type] =
-      *hmi_capabilities.vehicle_type();
-  }
-  if (hmi_capabilities.prerecorded_speech()) {
-    response_params[strings::prerecorded_speech] =
-      *(hmi_capabilities.prerecorded_speech());
-  }
-
   const std::vector<uint32_t>& diag_modes =
     profile::Profile::instance()->supported_diag_modes();
   if (!diag_modes.empty()) {
@@ -651,8 +566,8 @@ RegisterAppInterfaceRequest::CheckCoincidence() {
     vr_synonyms = msg_params[strings::vr_synonyms].asArray();
   }
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const ApplicationManagerImpl::ApplictionSet applications = accessor.applications();
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  const ApplicationManagerImpl::ApplictionSet& applications = snapshot.applications();
 
 #ifdef SDL_REMOTE_CONTROL
   const std::string mobile_app_id = (*message_)[strings::msg_params]
@@ -790,8 +705,8 @@ bool RegisterAppInterfaceRequest::IsApplicationWithSameAppIdRegistered() {
   IsSameAppId matcher(mobile_app_id);
 #endif  // SDL_REMOTE_CONTROL
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const ApplicationManagerImpl::ApplictionSet applications = accessor.applications();
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  const ApplicationManagerImpl::ApplictionSet& applications = snapshot.applications();
 
   return std::find_if(applications.begin(), applications.end(), matcher)
       != applications.end();
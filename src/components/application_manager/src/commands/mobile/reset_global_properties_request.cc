@@ -154,7 +154,7 @@ void ResetGlobalPropertiesRequest::Run() {
         limited_character_list;*/
 
       key_board_properties[hmi_request::auto_complete_text] = "";
-      msg_params[hmi_request::keyboard_properties] = key_board_properties;
+      msg_params[hmi_request::keyboard_properties].swap(key_board_properties);
     }
 
     msg_params[strings::app_id] = app->app_id();
@@ -121,43 +121,6 @@ void SetAppIconRequest::CopyToIconStorage(
     return;
   }
 
-  std::vector<uint8_t> file_content;
-  if(!file_system::ReadBinaryFile(path_to_file, file_content)) {
-    LOG4CXX_ERROR(logger_, "Can't read icon file: " << path_to_file);
-    return;
-  }
-
-  const std::string icon_storage =
-          profile::Profile::instance()->app_icons_folder();
-  const uint64_t storage_max_size =
-      static_cast<uint64_t>(
-        profile::Profile::instance()->app_icons_folder_max_size());
-  const uint64_t file_size = file_system::FileSize(path_to_file);
-
-  if (storage_max_size < file_size) {
-    LOG4CXX_ERROR(logger_, "Icon size (" << file_size << ") is bigger, than "
-                  " icons storage maximum size (" << storage_max_size << ")."
-                  "Copying skipped.");
-    return;
-  }
-
-  const uint64_t storage_size = static_cast<uint64_t>(
-                                  file_system::DirectorySize(icon_storage));
-  if (storage_max_size < (file_size + storage_size)) {
-    const uint32_t icons_amount =
-        profile::Profile::instance()->app_icons_amount_to_remove();
-
-    if (!icons_amount) {
-      LOG4CXX_DEBUG(logger_,
-                    "No icons will be deleted, since amount icons to remove "
-                    "is zero. Icon saving skipped.");
-      return;
-    }
-
-    while (!IsEnoughSpaceForIcon(file_size)) {
-      RemoveOldestIcons(icon_storage, icons_amount);
-    }
-  }
   ApplicationConstSharedPtr app =
           application_manager::ApplicationManagerImpl::instance()->
           application(connection_key());
@@ -168,64 +131,33 @@ void SetAppIconRequest::CopyToIconStorage(
     return;
   }
 
-  const std::string icon_path =
-          icon_storage + "/" + app->mobile_app_id();
-  if (!file_system::CreateFile(icon_path)) {
-    LOG4CXX_ERROR(logger_, "Can't create icon: " << icon_path);
-    return;
-  }
-
-  if (!file_system::Write(icon_path, file_content)) {
-    LOG4CXX_ERROR(logger_, "Can't write icon: " << icon_path);
-    return;
-  }
-
-  LOG4CXX_DEBUG(logger_, "Icon was successfully copied from :" << path_to_file
-                << " to " << icon_path);
+  // Icon may be big, so command does not wait for it to be read and stored
+  file_system::ReadBinaryFileAsync(
+      path_to_file, new IconCopyCallback(app->mobile_app_id()));
+}
 
-  return;
+SetAppIconRequest::IconCopyCallback::IconCopyCallback(
+    const std::string& mobile_app_id)
+    : mobile_app_id_(mobile_app_id) {
 }
 
-void SetAppIconRequest::RemoveOldestIcons(const std::string& storage,
-                                          const uint32_t icons_amount) const {
-  const std::vector<std::string> icons_list = file_system::ListFiles(storage);
-  std::map<uint64_t, std::string> icon_modification_time;
-  std::vector<std::string>::const_iterator it = icons_list.begin();
-  for (;it != icons_list.end(); ++it) {
-    const std::string file_name = *it;
-    const std::string file_path = storage + "/" + file_name;
-    if (!file_system::FileExists(file_path)) {
-      continue;
-    }
-    const uint64_t time = file_system::GetFileModificationTime(file_path);
-    icon_modification_time[time] = file_name;
+void SetAppIconRequest::IconCopyCallback::OnRead(
+    const std::string& file_name, bool result,
+    const std::vector<uint8_t>& content) {
+  if (!result) {
+    LOG4CXX_ERROR(logger_, "Can't read icon file: " << file_name);
+    return;
   }
 
-  for (size_t counter = 0; counter < icons_amount; ++counter) {
-    if (!icon_modification_time.size()) {
-      LOG4CXX_ERROR(logger_, "No more icons left for deletion.");
-      return;
-    }
-    const std::string file_name = icon_modification_time.begin()->second;
-    const std::string file_path = storage + "/" + file_name;
-    if (!file_system::DeleteFile(file_path)) {
-      LOG4CXX_DEBUG(logger_, "Error while deleting icon " << file_path);
-    }
-    icon_modification_time.erase(icon_modification_time.begin());
-    LOG4CXX_DEBUG(logger_, "Old icon " << file_path
-                  << " was deleted successfully.");
+  if (!ApplicationManagerImpl::instance()->icon_storage().Store(
+        mobile_app_id_, content)) {
+    LOG4CXX_ERROR(logger_, "Icon of " << mobile_app_id_
+                  << " was not stored");
+    return;
   }
-}
 
-bool SetAppIconRequest::IsEnoughSpaceForIcon(const uint64_t icon_size) const {
-  const std::string icon_storage =
-          profile::Profile::instance()->app_icons_folder();
-  const uint64_t storage_max_size =
-      static_cast<uint64_t>(
-        profile::Profile::instance()->app_icons_folder_max_size());
-  const uint64_t storage_size = static_cast<uint64_t>(
-                                  file_system::DirectorySize(icon_storage));
-  return storage_max_size >= (icon_size + storage_size);
+  LOG4CXX_DEBUG(logger_, "Icon was successfully copied from :" << file_name
+                << " to icon storage");
 }
 
 void SetAppIconRequest::on_event(const event_engine::Event& event) {
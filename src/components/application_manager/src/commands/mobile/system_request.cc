@@ -82,10 +82,19 @@ void SystemRequest::Run() {
       return;
   }
 
-  std::vector<uint8_t> binary_data;
+  // Payload is referenced in place, it is shared with incoming message
+  const std::vector<uint8_t> empty_binary_data;
+  const std::vector<uint8_t>* binary_data_ptr = &empty_binary_data;
   if ((*message_)[strings::params].keyExists(strings::binary_data)) {
-    binary_data = (*message_)[strings::params][strings::binary_data].asBinary();
+    binary_data_ptr =
+        (*message_)[strings::params][strings::binary_data].asBinaryPtr();
+    if (!binary_data_ptr) {
+      LOG4CXX_ERROR(logger_, "Binary data is not binary");
+      SendResponse(false, mobile_apis::Result::INVALID_DATA);
+      return;
+    }
   }
+  const std::vector<uint8_t>& binary_data = *binary_data_ptr;
 
   if (mobile_apis::RequestType::QUERY_APPS == request_type) {
     using namespace NsSmartDeviceLink::NsJSONHandler::Formatters;
@@ -220,10 +220,10 @@ uint32_t CoreService::GetNextCorrelationID() {
 
 std::vector<ApplicationSharedPtr> CoreService::GetApplications(
     AppExtensionUID uid) {
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
   AppExtensionPredicate predicate;
   predicate.uid = uid;
-  return accessor.FindAll(predicate);
+  return snapshot.FindAll(predicate);
 }
 
 void CoreService::SubscribeToHMINotification(
@@ -30,6 +30,9 @@
  POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+#include <limits>
+
 #include "interfaces/HMI_API.h"
 #include "application_manager/event_engine/event_observer.h"
 #include "application_manager/event_engine/event_dispatcher.h"
@@ -38,39 +41,98 @@ namespace application_manager {
 namespace event_engine {
 using namespace sync_primitives;
 
+namespace {
+bool is_same(const EventObserver* first, const EventObserver* second) {
+  return first->id() == second->id();
+}
+
+bool contains(const std::vector<EventObserver*>& observers,
+              const EventObserver* observer) {
+  for (size_t i = 0; i < observers.size(); ++i) {
+    if (is_same(observers[i], observer)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void remove_from(std::vector<EventObserver*>* observers,
+                 const EventObserver* observer) {
+  std::vector<EventObserver*>::iterator it = observers->begin();
+  while (observers->end() != it) {
+    if (is_same(*it, observer)) {
+      it = observers->erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+}  // namespace
+
 EventDispatcher::EventDispatcher()
-    : observer_list_lock_(true),
-      observers_() {
+    : state_lock_(),
+      observer_released_(),
+      response_observers_(),
+      notification_observers_(),
+      shared_requests_(),
+      deliveries_() {
 }
 
 EventDispatcher::~EventDispatcher() {
 }
 
 void EventDispatcher::raise_event(const Event& event) {
+  const int32_t type = event.smart_object_type();
+  const bool is_response = hmi_apis::messageType::response == type ||
+                           hmi_apis::messageType::error_response == type;
+  Delivery delivery;
+  delivery.event_id = event.id();
+  delivery.observers = &delivery.taken;
+  delivery.next = 0;
+  delivery.current = NULL;
+  delivery.thread = threads::Thread::CurrentId();
   {
     AutoLock auto_lock(state_lock_);
-    // check if event is notification
-    if (hmi_apis::messageType::notification == event.smart_object_type()) {
-    	const uint32_t notification_correlation_id = 0;
-    	observers_list_ = observers_[event.id()][notification_correlation_id];
+    const int32_t correlation_id =
+        is_response ? event.smart_object_correlation_id() : 0;
+    if (0 != correlation_id) {
+      // Response is got once, so observers are taken out with the entry
+      ResponseObserverMap::iterator it =
+          response_observers_.find(ResponseKey(event.id(), correlation_id));
+      if (response_observers_.end() != it) {
+        delivery.taken.swap(it->second);
+        response_observers_.erase(it);
+        shared_requests_.erase(ResponseKey(event.id(), correlation_id));
+      }
+    } else if (is_response ||
+               hmi_apis::messageType::notification == type) {
+      NotificationObserverMap::iterator it =
+          notification_observers_.find(event.id());
+      if (notification_observers_.end() != it) {
+        delivery.shared = it->second;
+        delivery.observers = delivery.shared.get();
+      }
     }
-
-    if (hmi_apis::messageType::response == event.smart_object_type()
-        || hmi_apis::messageType::error_response == event.smart_object_type()) {
-    	observers_list_ = observers_[event.id()][event.smart_object_correlation_id()];
+    if (delivery.observers->empty()) {
+      return;
     }
+    deliveries_.push_back(&delivery);
   }
 
-  // Call observers
-  EventObserver* temp;
-  while (observers_list_.size() > 0) {
-    observer_list_lock_.Acquire();
-    if (!observers_list_.empty()) {
-      temp = observers_list_.front();
-      observers_list_.pop_front();
-      temp->on_event(event);
+  // Observers are called without lock, so events are delivered in parallel
+  // and observers may subscribe and unsubscribe from their callbacks
+  for (;;) {
+    EventObserver* observer = NULL;
+    {
+      AutoLock auto_lock(state_lock_);
+      observer = next_observer(&delivery);
+      if (!observer) {
+        deliveries_.erase(
+            std::find(deliveries_.begin(), deliveries_.end(), &delivery));
+        break;
+      }
     }
-    observer_list_lock_.Release();
+    observer->on_event(event);
   }
 }
 
@@ -78,59 +140,146 @@ void EventDispatcher::add_observer(const Event::EventID& event_id,
                                    int32_t hmi_correlation_id,
                                    EventObserver* const observer) {
   AutoLock auto_lock(state_lock_);
-  observers_[event_id][hmi_correlation_id].push_back(observer);
+  if (0 != hmi_correlation_id) {
+    response_observers_[ResponseKey(event_id, hmi_correlation_id)].push_back(
+        observer);
+    return;
+  }
+  ObserverListPtr& observers = notification_observers_[event_id];
+  ObserverListPtr updated(observers ? new ObserverList(*observers)
+                                    : new ObserverList());
+  updated->push_back(observer);
+  observers = updated;
+}
+
+int32_t EventDispatcher::add_shared_observer(
+    const Event::EventID& event_id, int32_t hmi_correlation_id,
+    const smart_objects::SmartObject& params, uint32_t max_age_ms,
+    EventObserver* const observer) {
+  AutoLock auto_lock(state_lock_);
+  SharedRequestMap::iterator it = shared_requests_.lower_bound(
+      ResponseKey(event_id, std::numeric_limits<int32_t>::min()));
+  while (shared_requests_.end() != it && event_id == it->first.first) {
+    // Its observers still get response, but new ones do not wait for it
+    if (date_time::DateTime::calculateTimeSpan(it->second.sent) >
+        static_cast<int64_t>(max_age_ms)) {
+      shared_requests_.erase(it++);
+      continue;
+    }
+    if (params == it->second.params) {
+      response_observers_[it->first].push_back(observer);
+      return it->first.second;
+    }
+    ++it;
+  }
+  const ResponseKey key(event_id, hmi_correlation_id);
+  response_observers_[key].push_back(observer);
+  SharedRequest& request = shared_requests_[key];
+  request.params = params;
+  request.sent = date_time::DateTime::getCurrentTime();
+  return hmi_correlation_id;
 }
 
 void EventDispatcher::remove_observer(const Event::EventID& event_id,
-		                              EventObserver* const observer) {
-  remove_observer_from_list(observer);
+                                      EventObserver* const observer) {
   AutoLock auto_lock(state_lock_);
-  ObserversMap::iterator it =  observers_[event_id].begin();
-  for (; observers_[event_id].end() != it; ++it) {
-
-    //ObserverList iterator
-	ObserverList::iterator observer_it =  it->second.begin();
-	while (it->second.end() != observer_it) {
-	  if (observer->id() == (*observer_it)->id()) {
-	    observer_it = it->second.erase(observer_it);
-	  } else {
-	    ++observer_it;
-	  }
-	}
+  ResponseObserverMap::iterator it = response_observers_.lower_bound(
+      ResponseKey(event_id, std::numeric_limits<int32_t>::min()));
+  while (response_observers_.end() != it && event_id == it->first.first) {
+    remove_from(&it->second, observer);
+    if (it->second.empty()) {
+      shared_requests_.erase(it->first);
+      response_observers_.erase(it++);
+    } else {
+      ++it;
+    }
   }
+  NotificationObserverMap::iterator notification =
+      notification_observers_.find(event_id);
+  if (notification_observers_.end() != notification) {
+    remove_notification_observer(notification, observer);
+  }
+  cancel_deliveries(event_id, false, observer, auto_lock);
 }
 
 void EventDispatcher::remove_observer(EventObserver* const observer) {
-  remove_observer_from_list(observer);
   AutoLock auto_lock(state_lock_);
-  EventObserverMap::iterator event_map = observers_.begin();
-  for (; observers_.end() != event_map; ++event_map) {
-    ObserversMap::iterator it =  event_map->second.begin();
-	for (; event_map->second.end() != it; ++it) {
-
-	  //ObserverList iterator
-	  ObserverList::iterator observer_it =  it->second.begin();
-	  while (it->second.end() != observer_it) {
-	    if (observer->id() == (*observer_it)->id()) {
-	      observer_it = it->second.erase(observer_it);
-		} else {
-		  ++observer_it;
-		}
-	  }
-	}
+  ResponseObserverMap::iterator it = response_observers_.begin();
+  while (response_observers_.end() != it) {
+    remove_from(&it->second, observer);
+    if (it->second.empty()) {
+      shared_requests_.erase(it->first);
+      response_observers_.erase(it++);
+    } else {
+      ++it;
+    }
   }
+  NotificationObserverMap::iterator notification =
+      notification_observers_.begin();
+  while (notification_observers_.end() != notification) {
+    remove_notification_observer(notification++, observer);
+  }
+  cancel_deliveries(Event::EventID(), true, observer, auto_lock);
 }
 
-void EventDispatcher::remove_observer_from_list(EventObserver* const observer) {
-  AutoLock auto_lock(observer_list_lock_);
-  if (!observers_list_.empty()) {
-    ObserverList::iterator it_begin = observers_list_.begin();
-    for(; it_begin != observers_list_.end(); ++it_begin) {
-      if ((*it_begin)->id() == observer->id()) {
-        it_begin = observers_list_.erase(it_begin);
-      }
+EventObserver* EventDispatcher::next_observer(Delivery* delivery) {
+  if (delivery->current) {
+    delivery->current = NULL;
+    observer_released_.Broadcast();
+  }
+  while (delivery->next < delivery->observers->size()) {
+    EventObserver* observer = (*delivery->observers)[delivery->next++];
+    if (!contains(delivery->removed, observer)) {
+      delivery->current = observer;
+      return observer;
     }
   }
+  return NULL;
+}
+
+void EventDispatcher::remove_notification_observer(
+    NotificationObserverMap::iterator it, EventObserver* const observer) {
+  if (!contains(*it->second, observer)) {
+    return;
+  }
+  // Shared list is left intact for deliveries using it
+  ObserverListPtr updated(new ObserverList(*it->second));
+  remove_from(updated.get(), observer);
+  if (updated->empty()) {
+    notification_observers_.erase(it);
+  } else {
+    it->second = updated;
+  }
+}
+
+void EventDispatcher::cancel_deliveries(const Event::EventID& event_id,
+                                        bool all_events,
+                                        EventObserver* const observer,
+                                        AutoLock& auto_lock) {
+  const threads::PlatformThreadHandle this_thread =
+      threads::Thread::CurrentId();
+  bool called_elsewhere = false;
+  do {
+    called_elsewhere = false;
+    for (DeliveryList::iterator it = deliveries_.begin();
+         deliveries_.end() != it; ++it) {
+      Delivery* delivery = *it;
+      if (!all_events && event_id != delivery->event_id) {
+        continue;
+      }
+      if (!contains(delivery->removed, observer)) {
+        delivery->removed.push_back(observer);
+      }
+      // Observer unsubscribing from its own callback is not waited for
+      if (delivery->current && is_same(delivery->current, observer) &&
+          this_thread != delivery->thread) {
+        called_elsewhere = true;
+      }
+    }
+    if (called_elsewhere) {
+      observer_released_.Wait(auto_lock);
+    }
+  } while (called_elsewhere);
 }
 
 } // namespace event_engine
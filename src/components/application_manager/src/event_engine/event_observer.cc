@@ -51,6 +51,13 @@ void EventObserver::subscribe_on_event(const Event::EventID& event_id,
   EventDispatcher::instance()->add_observer(event_id, hmi_correlation_id, this);
 }
 
+int32_t EventObserver::subscribe_on_shared_event(
+    const Event::EventID& event_id, int32_t hmi_correlation_id,
+    const smart_objects::SmartObject& params, uint32_t max_age_ms) {
+  return EventDispatcher::instance()->add_shared_observer(
+      event_id, hmi_correlation_id, params, max_age_ms, this);
+}
+
 void EventObserver::unsubscribe_from_event(const Event::EventID& event_id) {
   EventDispatcher::instance()->remove_observer(event_id, this);
 }
@@ -263,6 +263,7 @@ HMICapabilities::HMICapabilities(ApplicationManagerImpl* const app_mngr)
     speech_capabilities_(NULL),
     audio_pass_thru_capabilities_(NULL),
     prerecorded_speech_(NULL),
+    register_app_interface_capabilities_(NULL),
     app_mngr_(app_mngr) {
 
   if (false == load_capabilities_from_file()) {
@@ -299,6 +300,7 @@ HMICapabilities::~HMICapabilities() {
   delete speech_capabilities_;
   delete audio_pass_thru_capabilities_;
   delete prerecorded_speech_;
+  delete register_app_interface_capabilities_;
   app_mngr_ = NULL;
 }
 
@@ -479,6 +481,7 @@ void HMICapabilities::set_display_capabilities(
     delete display_capabilities_;
   }
   display_capabilities_ = new smart_objects::SmartObject(display_capabilities);
+  reset_register_app_interface_capabilities();
 }
 
 void HMICapabilities::set_hmi_zone_capabilities(
@@ -488,6 +491,7 @@ void HMICapabilities::set_hmi_zone_capabilities(
   }
   hmi_zone_capabilities_ = new smart_objects::SmartObject(
       hmi_zone_capabilities);
+  reset_register_app_interface_capabilities();
 }
 
 void HMICapabilities::set_soft_button_capabilities(
@@ -497,6 +501,7 @@ void HMICapabilities::set_soft_button_capabilities(
   }
   soft_buttons_capabilities_ = new smart_objects::SmartObject(
       soft_button_capabilities);
+  reset_register_app_interface_capabilities();
 }
 
 void HMICapabilities::set_button_capabilities(
@@ -505,6 +510,7 @@ void HMICapabilities::set_button_capabilities(
     delete button_capabilities_;
   }
   button_capabilities_ = new smart_objects::SmartObject(button_capabilities);
+  reset_register_app_interface_capabilities();
 }
 
 void HMICapabilities::set_vr_capabilities(
@@ -513,6 +519,7 @@ void HMICapabilities::set_vr_capabilities(
     delete vr_capabilities_;
   }
   vr_capabilities_ = new smart_objects::SmartObject(vr_capabilities);
+  reset_register_app_interface_capabilities();
 }
 
 void HMICapabilities::set_speech_capabilities(
@@ -521,6 +528,7 @@ void HMICapabilities::set_speech_capabilities(
     delete speech_capabilities_;
   }
   speech_capabilities_ = new smart_objects::SmartObject(speech_capabilities);
+  reset_register_app_interface_capabilities();
 }
 
 void HMICapabilities::set_audio_pass_thru_capabilities(
@@ -530,6 +538,7 @@ void HMICapabilities::set_audio_pass_thru_capabilities(
   }
   audio_pass_thru_capabilities_ = new smart_objects::SmartObject(
       audio_pass_thru_capabilities);
+  reset_register_app_interface_capabilities();
 }
 
 void HMICapabilities::set_preset_bank_capabilities(
@@ -539,6 +548,7 @@ void HMICapabilities::set_preset_bank_capabilities(
   }
   preset_bank_capabilities_ = new smart_objects::SmartObject(
       preset_bank_capabilities);
+  reset_register_app_interface_capabilities();
 }
 
 void HMICapabilities::set_vehicle_type(
@@ -547,6 +557,7 @@ void HMICapabilities::set_vehicle_type(
     delete vehicle_type_;
   }
   vehicle_type_ = new smart_objects::SmartObject(vehicle_type);
+  reset_register_app_interface_capabilities();
 }
 
 void HMICapabilities::set_prerecorded_speech(
@@ -556,6 +567,80 @@ void HMICapabilities::set_prerecorded_speech(
     prerecorded_speech_ = NULL;
   }
   prerecorded_speech_ = new smart_objects::SmartObject(prerecorded_speech);
+  reset_register_app_interface_capabilities();
+}
+
+smart_objects::SmartObject
+HMICapabilities::register_app_interface_capabilities() const {
+  sync_primitives::AutoLock lock(register_app_interface_capabilities_lock_);
+  if (register_app_interface_capabilities_) {
+    return *register_app_interface_capabilities_;
+  }
+
+  smart_objects::SmartObject* params =
+      new smart_objects::SmartObject(smart_objects::SmartType_Map);
+  if (display_capabilities_) {
+    smart_objects::SmartObject& display_caps =
+        (*params)[hmi_response::display_capabilities];
+    display_caps = smart_objects::SmartObject(smart_objects::SmartType_Map);
+
+    const char* const display_keys[] = {
+      hmi_response::display_type,
+      hmi_response::text_fields,
+      hmi_response::image_fields,
+      hmi_response::media_clock_formats,
+      hmi_response::templates_available,
+      hmi_response::screen_params,
+      hmi_response::num_custom_presets_available
+    };
+    for (size_t i = 0; i < ARRAYSIZE(display_keys); ++i) {
+      display_caps[display_keys[i]] =
+          display_capabilities_->getElement(display_keys[i]);
+    }
+    display_caps[hmi_response::graphic_supported] =
+        display_capabilities_->getElement(
+            hmi_response::image_capabilities).length() > 0;
+  }
+
+  if (button_capabilities_) {
+    (*params)[hmi_response::button_capabilities] = *button_capabilities_;
+  }
+  if (soft_buttons_capabilities_) {
+    (*params)[hmi_response::soft_button_capabilities] =
+        *soft_buttons_capabilities_;
+  }
+  if (preset_bank_capabilities_) {
+    (*params)[hmi_response::preset_bank_capabilities] =
+        *preset_bank_capabilities_;
+  }
+  if (hmi_zone_capabilities_) {
+    (*params)[hmi_response::hmi_zone_capabilities] = *hmi_zone_capabilities_;
+  }
+  if (speech_capabilities_) {
+    (*params)[strings::speech_capabilities] = *speech_capabilities_;
+  }
+  if (vr_capabilities_) {
+    (*params)[strings::vr_capabilities] = *vr_capabilities_;
+  }
+  if (audio_pass_thru_capabilities_) {
+    (*params)[strings::audio_pass_thru_capabilities] =
+        *audio_pass_thru_capabilities_;
+  }
+  if (vehicle_type_) {
+    (*params)[hmi_response::vehicle_type] = *vehicle_type_;
+  }
+  if (prerecorded_speech_) {
+    (*params)[strings::prerecorded_speech] = *prerecorded_speech_;
+  }
+
+  register_app_interface_capabilities_ = params;
+  return *register_app_interface_capabilities_;
+}
+
+void HMICapabilities::reset_register_app_interface_capabilities() {
+  sync_primitives::AutoLock lock(register_app_interface_capabilities_lock_);
+  delete register_app_interface_capabilities_;
+  register_app_interface_capabilities_ = NULL;
 }
 
 bool HMICapabilities::load_capabilities_from_file() {
@@ -86,6 +86,10 @@
 #include "application_manager/commands/hmi/ui_add_submenu_response.h"
 #include "application_manager/commands/hmi/ui_delete_submenu_request.h"
 #include "application_manager/commands/hmi/ui_delete_submenu_response.h"
+#include "application_manager/commands/hmi/ui_create_interaction_choice_set_request.h"
+#include "application_manager/commands/hmi/ui_create_interaction_choice_set_response.h"
+#include "application_manager/commands/hmi/ui_delete_interaction_choice_set_request.h"
+#include "application_manager/commands/hmi/ui_delete_interaction_choice_set_response.h"
 #include "application_manager/commands/hmi/ui_get_supported_languages_request.h"
 #include "application_manager/commands/hmi/ui_get_supported_languages_response.h"
 #include "application_manager/commands/hmi/ui_get_language_request.h"
@@ -286,16 +290,16 @@ CommandSharedPtr HMICommandFactory::CreateCommand(
   LOG4CXX_INFO(logger_,
                "HMICommandFactory::CreateCommand function_id: " << function_id);
 
-  CommandSharedPtr command(
-      new application_manager::commands::CommandImpl(message));
+  // Set by switch below, CommandImpl is created only for unknown functions
+  CommandSharedPtr command;
 
   bool is_response = false;
   const int msg_type = (*message)[strings::params][strings::message_type].asInt();
   if (msg_type == static_cast<int>(application_manager::MessageType::kResponse)) {
     is_response = true;
     LOG4CXX_INFO(logger_, "HMICommandFactory::CreateCommand response");
-  } else if ((*message)[strings::params][strings::message_type]
-      == static_cast<int>(application_manager::MessageType::kErrorResponse)) {
+  } else if (msg_type ==
+      static_cast<int>(application_manager::MessageType::kErrorResponse)) {
     is_response = true;
     LOG4CXX_INFO(logger_, "HMICommandFactory::CreateCommand error response");
   } else {
@@ -435,6 +439,26 @@ CommandSharedPtr HMICommandFactory::CreateCommand(
       }
       break;
     }
+    case hmi_apis::FunctionID::UI_CreateInteractionChoiceSet: {
+      if (is_response) {
+        command.reset(
+            new commands::UICreateInteractionChoiceSetResponse(message));
+      } else {
+        command.reset(
+            new commands::UICreateInteractionChoiceSetRequest(message));
+      }
+      break;
+    }
+    case hmi_apis::FunctionID::UI_DeleteInteractionChoiceSet: {
+      if (is_response) {
+        command.reset(
+            new commands::UIDeleteInteractionChoiceSetResponse(message));
+      } else {
+        command.reset(
+            new commands::UIDeleteInteractionChoiceSetRequest(message));
+      }
+      break;
+    }
     case hmi_apis::FunctionID::UI_SetMediaClockTimer: {
       if (is_response) {
         command.reset(new commands::UISetMediaClockTimerResponse(message));
@@ -2100,6 +2124,9 @@ CommandSharedPtr HMICommandFactory::CreateCommand(
     }
   }
 
+  if (!command) {
+    command.reset(new application_manager::commands::CommandImpl(message));
+  }
   return command;
 }
 
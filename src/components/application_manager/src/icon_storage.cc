@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/icon_storage.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <set>
+#include <sstream>
+
+#include "utils/file_system.h"
+#include "utils/gen_hash.h"
+#include "utils/logger.h"
+
+namespace application_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "ApplicationManager")
+
+const char* const IconStorage::kIndexFileName = ".icons_index";
+
+IconStorage::IconStorage()
+  : max_size_(0),
+    amount_to_remove_(0),
+    is_loaded_(false),
+    size_(0) {
+}
+
+void IconStorage::Init(const std::string& folder, uint64_t max_size,
+                       uint32_t amount_to_remove) {
+  sync_primitives::AutoLock lock(lock_);
+  folder_ = folder;
+  max_size_ = max_size;
+  amount_to_remove_ = amount_to_remove;
+  is_loaded_ = false;
+  size_ = 0;
+  icons_.clear();
+  index_.clear();
+}
+
+bool IconStorage::Store(const std::string& name,
+                        const std::vector<uint8_t>& content) {
+  sync_primitives::AutoLock lock(lock_);
+  if (!is_loaded_) {
+    LoadIndex();
+  }
+
+  const std::string icon_path = folder_ + "/" + name;
+  const uint64_t hash = utils::content_hash(content.data(), content.size());
+  IconsIndex::iterator stored = index_.find(name);
+  if (index_.end() != stored) {
+    const Icon& icon = *stored->second;
+    if (content.size() == icon.size && hash == icon.hash &&
+        file_system::FileExists(icon_path)) {
+      LOG4CXX_DEBUG(logger_, "Icon " << icon_path << " is already stored");
+      icons_.splice(icons_.end(), icons_, stored->second);
+      SaveIndex();
+      return true;
+    }
+    Remove(stored->second);
+  }
+
+  if (max_size_ < content.size()) {
+    LOG4CXX_ERROR(logger_, "Icon size (" << content.size() << ") is bigger, "
+                  "than icons storage maximum size (" << max_size_ << ").");
+    return false;
+  }
+
+  if (max_size_ < size_ + content.size()) {
+    if (!amount_to_remove_) {
+      LOG4CXX_DEBUG(logger_,
+                    "No icons will be deleted, since amount icons to remove "
+                    "is zero. Icon saving skipped.");
+      SaveIndex();
+      return false;
+    }
+    while (max_size_ < size_ + content.size() && !icons_.empty()) {
+      for (uint32_t counter = 0;
+           counter < amount_to_remove_ && !icons_.empty(); ++counter) {
+        const std::string old_icon_path = folder_ + "/" + icons_.front().name;
+        if (!file_system::DeleteFile(old_icon_path)) {
+          LOG4CXX_DEBUG(logger_, "Error while deleting icon " << old_icon_path);
+        }
+        LOG4CXX_DEBUG(logger_, "Old icon " << old_icon_path << " was deleted.");
+        Remove(icons_.begin());
+      }
+    }
+  }
+
+  if (!file_system::Write(icon_path, content)) {
+    LOG4CXX_ERROR(logger_, "Can't write icon: " << icon_path);
+    SaveIndex();
+    return false;
+  }
+
+  Icon icon;
+  icon.name = name;
+  icon.size = content.size();
+  icon.modification_time = file_system::GetFileModificationTime(icon_path);
+  icon.hash = hash;
+  index_[name] = icons_.insert(icons_.end(), icon);
+  size_ += icon.size;
+  SaveIndex();
+  return true;
+}
+
+void IconStorage::LoadIndex() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  is_loaded_ = true;
+
+  std::set<std::string> files;
+  const std::vector<std::string> files_list = file_system::ListFiles(folder_);
+  for (std::vector<std::string>::const_iterator it = files_list.begin();
+       it != files_list.end(); ++it) {
+    if (0 != it->compare(0, strlen(kIndexFileName), kIndexFileName)) {
+      files.insert(*it);
+    }
+  }
+
+  std::string saved_index;
+  file_system::ReadFile(folder_ + "/" + kIndexFileName, saved_index);
+  std::istringstream lines(saved_index);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream fields(line);
+    Icon icon;
+    if (!(fields >> icon.size >> icon.modification_time >> icon.hash) ||
+        !std::getline(fields >> std::ws, icon.name) ||
+        0 == files.erase(icon.name) || index_.count(icon.name)) {
+      continue;
+    }
+    const std::string icon_path = folder_ + "/" + icon.name;
+    const uint64_t size = file_system::FileSize(icon_path);
+    const uint64_t modification_time =
+        file_system::GetFileModificationTime(icon_path);
+    if (size != icon.size || modification_time != icon.modification_time) {
+      std::vector<uint8_t> content;
+      file_system::ReadBinaryFile(icon_path, content);
+      icon.size = content.size();
+      icon.modification_time = modification_time;
+      icon.hash = utils::content_hash(content.data(), content.size());
+    }
+    index_[icon.name] = icons_.insert(icons_.end(), icon);
+    size_ += icon.size;
+  }
+
+  // Icons stored before index existed are considered the oldest ones
+  std::multimap<uint64_t, Icon> unknown_icons;
+  for (std::set<std::string>::const_iterator it = files.begin();
+       it != files.end(); ++it) {
+    Icon icon;
+    icon.name = *it;
+    const std::string icon_path = folder_ + "/" + icon.name;
+    std::vector<uint8_t> content;
+    file_system::ReadBinaryFile(icon_path, content);
+    icon.size = content.size();
+    icon.modification_time = file_system::GetFileModificationTime(icon_path);
+    icon.hash = utils::content_hash(content.data(), content.size());
+    unknown_icons.insert(std::make_pair(icon.modification_time, icon));
+  }
+  Icons::iterator oldest_known = icons_.begin();
+  for (std::multimap<uint64_t, Icon>::const_iterator it =
+           unknown_icons.begin(); it != unknown_icons.end(); ++it) {
+    index_[it->second.name] = icons_.insert(oldest_known, it->second);
+    size_ += it->second.size;
+  }
+  LOG4CXX_DEBUG(logger_, "Loaded " << icons_.size() << " icons of size "
+                << size_ << " from " << folder_);
+}
+
+void IconStorage::SaveIndex() const {
+  std::ostringstream stream;
+  for (Icons::const_iterator it = icons_.begin(); it != icons_.end(); ++it) {
+    stream << it->size << ' ' << it->modification_time << ' ' << it->hash
+           << ' ' << it->name << '\n';
+  }
+  const std::string content = stream.str();
+  const std::string index_path = folder_ + "/" + kIndexFileName;
+  const std::string temp_path = index_path + ".tmp";
+  // Index is replaced at once, so it is never seen written partially
+  if (!file_system::Write(temp_path,
+                          std::vector<uint8_t>(content.begin(), content.end())) ||
+      0 != rename(temp_path.c_str(), index_path.c_str())) {
+    LOG4CXX_ERROR(logger_, "Can't save icons index " << index_path);
+  }
+}
+
+void IconStorage::Remove(Icons::iterator icon) {
+  size_ -= icon->size;
+  index_.erase(icon->name);
+  icons_.erase(icon);
+}
+
+}  // namespace application_manager
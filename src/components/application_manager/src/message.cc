@@ -62,15 +62,13 @@ Message::Message(protocol_handler::MessagePriority priority)
       type_(kUnknownType),
       priority_(priority),
       connection_key_(0),
-      binary_data_(NULL),
       data_size_(0),
       payload_size_(0),
       version_(kUnknownProtocol) {
 }
 
 Message::Message(const Message& message)
-    : priority_(message.priority_),
-      binary_data_(NULL) {
+    : priority_(message.priority_) {
   *this = message;
 }
 
@@ -82,9 +80,7 @@ Message& Message::operator=(const Message& message) {
   set_message_type(message.type_);
   set_data_size(message.data_size_);
   set_payload_size(message.payload_size_);
-  if (message.binary_data_) {
-    set_binary_data(message.binary_data_);
-  }
+  binary_data_ = message.binary_data_;
   set_json_message(message.json_message_);
   set_protocol_version(message.protocol_version());
   priority_ = message.priority_;
@@ -103,18 +99,18 @@ bool Message::operator==(const Message& message) {
   bool payload_size = payload_size_ == message.payload_size_;
 
 
-  bool binary_data = std::equal(binary_data_->begin(), binary_data_->end(),
-                                message.binary_data_->begin(),
-                                BinaryDataPredicate);
+  bool binary_data = binary_data_.valid() == message.binary_data_.valid();
+  if (binary_data && binary_data_.valid()) {
+    binary_data = binary_data_->size() == message.binary_data_->size() &&
+        std::equal(binary_data_->begin(), binary_data_->end(),
+                   message.binary_data_->begin(), BinaryDataPredicate);
+  }
 
   return function_id && correlation_id && connection_key && type && binary_data
       && json_message && version && data_size && payload_size;
 }
 
 Message::~Message() {
-  if (binary_data_) {
-    delete binary_data_;
-  }
 }
 
 std::string Message::function_name() const {
@@ -146,11 +142,15 @@ const std::string& Message::json_message() const {
 }
 
 const BinaryData* Message::binary_data() const {
+  return binary_data_.get();
+}
+
+const SharedBinaryData& Message::shared_binary_data() const {
   return binary_data_;
 }
 
 bool Message::has_binary_data() const {
-  return (binary_data_ != NULL);
+  return binary_data_.valid();
 }
 
 size_t Message::data_size() const {
@@ -187,10 +187,14 @@ void Message::set_binary_data(BinaryData* data) {
     return;
   }
 
-  if (binary_data_) {
-    delete binary_data_;
-  }
+  binary_data_ = SharedBinaryData(data);
+}
 
+void Message::set_binary_data(const SharedBinaryData& data) {
+  if (!data.valid()) {
+    NOTREACHED();
+    return;
+  }
   binary_data_ = data;
 }
 
@@ -198,11 +202,16 @@ void Message::set_json_message(const std::string& json_message) {
   json_message_ = json_message;
 }
 
+void Message::set_json_message(const char* data, size_t size) {
+  json_message_.assign(data, size);
+}
+
+
 void Message::set_protocol_version(ProtocolVersion version) {
   version_ = version;
 }
 
-#ifdef HMI_DBUS_API
+#if defined(HMI_DBUS_API) || defined(DIRECT_HMIADAPTER)
 const smart_objects::SmartObject &Message::smart_object() const {
   return smart_object_;
 }
@@ -38,6 +38,7 @@
 
 #include <set>
 #include <string>
+#include <sstream>
 #include <algorithm>
 #include <utility>
 #include <map>
@@ -483,17 +484,29 @@ std::string MessageHelper::StringifiedHMILevel(
 std::string MessageHelper::StringifiedFunctionID(
   mobile_apis::FunctionID::eType function_id) {
   LOG4CXX_AUTO_TRACE(logger_);
-  using namespace NsSmartDeviceLink::NsSmartObjects;
-  const char* str = 0;
-  if (EnumConversionHelper<mobile_apis::FunctionID::eType>::EnumToCString(
-        function_id, &str)) {
-    const std::string enum_name = str;
-    // Strip 'ID' suffix from value name
-    DCHECK(enum_name.length() > 2
-           && enum_name.substr(enum_name.length() - 2) == "ID");
-    return enum_name.substr(0, enum_name.length() - 2);
+  // Generated table has names without 'ID' suffix of value names
+  const mobile_apis::FunctionInfo* info =
+      mobile_apis::GetFunctionInfo(function_id);
+  return info ? info->name : std::string();
+}
+
+std::string MessageHelper::InteriorModuleKey(
+  const smart_objects::SmartObject& module_description) {
+  const char* const kZoneFields[] = {
+    "col", "row", "level", "colspan", "rowspan", "levelspan"
+  };
+  const smart_objects::SmartObject& type = module_description["moduleType"];
+  const smart_objects::SmartObject& zone = module_description["moduleZone"];
+  std::stringstream key;
+  if (smart_objects::SmartType_String == type.getType()) {
+    key << type.asString();
+  } else {
+    key << type.asInt();
   }
-  return std::string();
+  for (size_t i = 0; i < ARRAYSIZE(kZoneFields); ++i) {
+    key << ':' << zone[kZoneFields[i]].asInt();
+  }
+  return key.str();
 }
 
 #ifdef HMI_DBUS_API
@@ -823,7 +836,7 @@ smart_objects::SmartObjectList MessageHelper::CreateGlobalPropertiesRequestsToHM
     }
     ui_msg_params[strings::app_id] = app->app_id();
 
-    (*ui_global_properties)[strings::msg_params] = ui_msg_params;
+    (*ui_global_properties)[strings::msg_params].swap(ui_msg_params);
 
     requests.push_back(ui_global_properties);
   }
@@ -858,7 +871,7 @@ smart_objects::SmartObjectList MessageHelper::CreateGlobalPropertiesRequestsToHM
     }
     tts_msg_params[strings::app_id] = app->app_id();
 
-    (*tts_global_properties)[strings::msg_params] = tts_msg_params;
+    (*tts_global_properties)[strings::msg_params].swap(tts_msg_params);
 
     requests.push_back(tts_global_properties);
   }
@@ -907,7 +920,7 @@ void MessageHelper::SendTTSGlobalProperties(
     }
     app->set_help_prompt(msg_params[strings::help_prompt]);
     msg_params[strings::app_id] = app->app_id();
-    so_to_send[strings::msg_params] = msg_params;
+    so_to_send[strings::msg_params].swap(msg_params);
     ApplicationManagerImpl::instance()->ManageHMICommand(tts_global_properties);
   }
 }
@@ -922,12 +935,12 @@ smart_objects::SmartObjectSPtr MessageHelper::CreateAppVrHelp(
   smart_objects::SmartObject& vr_help = *result;
   vr_help[strings::vr_help_title] = app->name();
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
 
   int32_t index = 0;
  ApplicationManagerImpl::ApplictionSetConstIt it_app =
-     accessor.begin();
-  for (; accessor.end() != it_app; ++it_app) {
+     snapshot.begin();
+  for (; snapshot.end() != it_app; ++it_app) {
     if ((*it_app)->vr_synonyms()) {
       smart_objects::SmartObject item(smart_objects::SmartType_Map);
       item[strings::text] = (*((*it_app)->vr_synonyms())).getElement(0);
@@ -1074,7 +1087,7 @@ smart_objects::SmartObjectList MessageHelper::CreateAddCommandRequestToHMI(
         msg_params[strings::cmd_icon][strings::value] =
           (*i->second)[strings::cmd_icon][strings::value].asString();
       }
-      (*ui_command)[strings::msg_params] = msg_params;
+      (*ui_command)[strings::msg_params].swap(msg_params);
       requests.push_back(ui_command);
     }
 
@@ -1118,7 +1131,7 @@ smart_objects::SmartObjectSPtr MessageHelper::CreateChangeRegistration(
     msg_params[strings::app_hmi_type] = *app_types;
   }
 
-  params[strings::msg_params] = msg_params;
+  params[strings::msg_params].swap(msg_params);
   return command;
 }
 
@@ -1218,7 +1231,7 @@ smart_objects::SmartObjectSPtr MessageHelper::CreateAddVRCommandToHMI(
     ApplicationManagerImpl::instance()->application(app_id)->get_grammar_id();
   msg_params[strings::type] = hmi_apis::Common_VRCommandType::Command;
 
-  (*vr_command)[strings::msg_params] = msg_params;
+  (*vr_command)[strings::msg_params].swap(msg_params);
 
   return vr_command;
 }
@@ -1318,7 +1331,7 @@ smart_objects::SmartObjectList MessageHelper::CreateAddSubMenuRequestToHMI(
     msg_params[strings::menu_params][strings::menu_name] =
       (*i->second)[strings::menu_name];
     msg_params[strings::app_id] = app->app_id();
-    (*ui_sub_menu)[strings::msg_params] = msg_params;
+    (*ui_sub_menu)[strings::msg_params].swap(msg_params);
     requsets.push_back(ui_sub_menu);
   }
   return requsets;
@@ -1722,7 +1735,7 @@ void MessageHelper::SendNaviStartStream(int32_t connection_key) {
   msg_params[strings::app_id] = app_id;
   msg_params[strings::url] = url;
 
-  (*start_stream)[strings::msg_params] = msg_params;
+  (*start_stream)[strings::msg_params].swap(msg_params);
 
   ApplicationManagerImpl::instance()->ManageHMICommand(start_stream);
 }
@@ -1755,7 +1768,7 @@ void MessageHelper::SendNaviStopStream(int32_t connection_key) {
 
   msg_params[strings::app_id] = app_id;
 
-  (*stop_stream)[strings::msg_params] = msg_params;
+  (*stop_stream)[strings::msg_params].swap(msg_params);
 
   ApplicationManagerImpl::instance()->ManageHMICommand(stop_stream);
 }
@@ -1805,7 +1818,7 @@ void MessageHelper::SendAudioStartStream(int32_t connection_key) {
   msg_params[strings::app_id] = app_id;
   msg_params[strings::url] = url;
 
-  (*start_stream)[strings::msg_params] = msg_params;
+  (*start_stream)[strings::msg_params].swap(msg_params);
 
   DCHECK(ApplicationManagerImpl::instance()->ManageHMICommand(start_stream));
 }
@@ -1838,7 +1851,7 @@ void MessageHelper::SendAudioStopStream(int32_t connection_key) {
 
   msg_params[strings::app_id] = app_id;
 
-  (*stop_stream)[strings::msg_params] = msg_params;
+  (*stop_stream)[strings::msg_params].swap(msg_params);
 
   ApplicationManagerImpl::instance()->ManageHMICommand(stop_stream);
 }
@@ -2546,4 +2559,33 @@ bool MessageHelper::PrintSmartObject(const smart_objects::SmartObject& object) {
   return true;
 }
 
+size_t MessageHelper::EstimateMemorySize(
+    const smart_objects::SmartObject& object) {
+  size_t size = sizeof(smart_objects::SmartObject);
+  switch (object.getType()) {
+    case smart_objects::SmartType_String:
+    case smart_objects::SmartType_Binary:
+      size += object.length();
+      break;
+    case smart_objects::SmartType_Array: {
+      const smart_objects::SmartArray* array = object.asArray();
+      for (smart_objects::SmartArray::const_iterator it = array->begin();
+           array->end() != it; ++it) {
+        size += EstimateMemorySize(*it);
+      }
+      break;
+    }
+    case smart_objects::SmartType_Map: {
+      for (smart_objects::SmartMap::iterator it = object.map_begin();
+           object.map_end() != it; ++it) {
+        size += it->first.size() + EstimateMemorySize(it->second);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return size;
+}
+
 }  //  namespace application_manager
@@ -143,11 +143,15 @@ namespace application_manager {
 commands::Command *MobileCommandFactory::CreateCommand(
     const commands::MessageSharedPtr& message,
     commands::Command::CommandOrigin origin) {
+  // Params are read once, not for every case
+  const smart_objects::SmartObject& params = (*message)[strings::params];
+  const int32_t function_id = params[strings::function_id].asInt();
+  const int32_t message_type = params[strings::message_type].asInt();
 
-  switch ((*message)[strings::params][strings::function_id].asInt()) {
+  switch (function_id) {
     case mobile_apis::FunctionID::RegisterAppInterfaceID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kRequest)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kRequest)) {
         return new commands::RegisterAppInterfaceRequest(message);
       } else {
         return new commands::RegisterAppInterfaceResponse(message);
@@ -155,8 +159,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::UnregisterAppInterfaceID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kRequest)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kRequest)) {
         return new commands::UnregisterAppInterfaceRequest(message);
       } else {
         return new commands::UnregisterAppInterfaceResponse(message);
@@ -164,8 +168,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SetGlobalPropertiesID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SetGlobalPropertiesResponse(message);
       } else {
         return new commands::SetGlobalPropertiesRequest(message);
@@ -173,8 +177,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::ResetGlobalPropertiesID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::ResetGlobalPropertiesResponse(message);
       } else {
         return new commands::ResetGlobalPropertiesRequest(message);
@@ -182,8 +186,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::AddCommandID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::AddCommandResponse(message);
       } else {
         return new commands::AddCommandRequest(message);
@@ -191,8 +195,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::DeleteCommandID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::DeleteCommandResponse(message);
       } else {
         return new commands::DeleteCommandRequest(message);
@@ -200,8 +204,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::AddSubMenuID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::AddSubMenuResponse(message);
       } else {
         return new commands::AddSubMenuRequest(message);
@@ -209,8 +213,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::DeleteSubMenuID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::DeleteSubMenuResponse(message);
       } else {
         return new commands::DeleteSubMenuRequest(message);
@@ -218,8 +222,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::DeleteInteractionChoiceSetID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return
             new commands::DeleteInteractionChoiceSetResponse(message);
       } else {
@@ -228,8 +232,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::AlertID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::AlertResponse(message);
       } else {
         return new commands::AlertRequest(message);
@@ -237,8 +241,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SpeakID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SpeakResponse(message);
       } else {
         return new commands::SpeakRequest(message);
@@ -246,8 +250,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SliderID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SliderResponse(message);
       } else {
         return new commands::SliderRequest(message);
@@ -255,8 +259,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::PerformAudioPassThruID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::PerformAudioPassThruResponse(message);
       } else {
         return new commands::PerformAudioPassThruRequest(message);
@@ -264,8 +268,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::CreateInteractionChoiceSetID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return
             new commands::CreateInteractionChoiceSetResponse(message);
       } else {
@@ -274,8 +278,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::PerformInteractionID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::PerformInteractionResponse(message);
       } else {
         return new commands::PerformInteractionRequest(message);
@@ -283,8 +287,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::EndAudioPassThruID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::EndAudioPassThruResponse(message);
       } else {
         return new commands::EndAudioPassThruRequest(message);
@@ -292,8 +296,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::PutFileID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::PutFileResponse(message);
       } else {
         return new commands::PutFileRequest(message);
@@ -301,8 +305,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::DeleteFileID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::DeleteFileResponse(message);
       } else {
         return new commands::DeleteFileRequest(message);
@@ -310,8 +314,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::ListFilesID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::ListFilesResponse(message);
       } else {
         return new commands::ListFilesRequest(message);
@@ -319,8 +323,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SubscribeButtonID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SubscribeButtonResponse(message);
       } else {
         return new commands::SubscribeButtonRequest(message);
@@ -328,8 +332,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::UnsubscribeButtonID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::UnsubscribeButtonResponse(message);
       } else {
         return new commands::UnsubscribeButtonRequest(message);
@@ -337,8 +341,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::ShowConstantTBTID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::ShowConstantTBTResponse(message);
       } else {
         return new commands::ShowConstantTBTRequest(message);
@@ -346,8 +350,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::ShowID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::ShowResponse(message);
       } else {
         return new commands::ShowRequest(message);
@@ -355,8 +359,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SubscribeVehicleDataID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SubscribeVehicleDataResponse(message);
       } else {
         return new commands::SubscribeVehicleDataRequest(message);
@@ -364,8 +368,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::UnsubscribeVehicleDataID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::UnsubscribeVehicleDataResponse(message);
       } else {
         return new commands::UnsubscribeVehicleDataRequest(message);
@@ -373,8 +377,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::ReadDIDID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::ReadDIDResponse(message);
       } else {
         return new commands::ReadDIDRequest(message);
@@ -382,8 +386,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::GetVehicleDataID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::GetVehicleDataResponse(message);
       } else {
         return new commands::GetVehicleDataRequest(message);
@@ -391,8 +395,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::ScrollableMessageID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::ScrollableMessageResponse(message);
       } else {
         return new commands::ScrollableMessageRequest(message);
@@ -400,8 +404,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::AlertManeuverID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::AlertManeuverResponse(message);
       } else {
         return new commands::AlertManeuverRequest(message);
@@ -409,8 +413,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SetAppIconID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SetAppIconResponse(message);
       } else {
         return new commands::SetAppIconRequest(message);
@@ -418,8 +422,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SetDisplayLayoutID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SetDisplayLayoutResponse(message);
       } else {
         return new commands::SetDisplayLayoutRequest(message);
@@ -427,8 +431,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::UpdateTurnListID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::UpdateTurnListResponse(message);
       } else {
         return new commands::UpdateTurnListRequest(message);
@@ -436,8 +440,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::ChangeRegistrationID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::ChangeRegistrationResponse(message);
       } else {
         return new commands::ChangeRegistrationRequest(message);
@@ -445,8 +449,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::GetDTCsID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::GetDTCsResponse(message);
       } else {
         return new commands::GetDTCsRequest(message);
@@ -454,8 +458,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::DiagnosticMessageID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::DiagnosticMessageResponse(message);
       } else {
         return new commands::DiagnosticMessageRequest(message);
@@ -463,8 +467,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SetMediaClockTimerID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SetMediaClockTimerResponse(message);
       } else {
         return new commands::SetMediaClockRequest(message);
@@ -472,8 +476,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SystemRequestID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SystemResponse(message);
       } else {
         return new commands::SystemRequest(message);
@@ -481,8 +485,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SendLocationID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SendLocationResponse(message);
       } else {
         return new commands::SendLocationRequest(message);
@@ -490,8 +494,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::DialNumberID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::DialNumberResponse(message);
       } else {
         return new commands::DialNumberRequest(message);
@@ -499,8 +503,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::ButtonPressID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::ButtonPressResponse(message);
       } else {
         return new commands::ButtonPressRequest(message);
@@ -508,8 +512,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::GetInteriorVehicleDataCapabilitiesID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::GetInteriorVehicleDataCapabilitiesResponse(message);
       } else {
         return new commands::GetInteriorVehicleDataCapabilitiesRequest(message);
@@ -517,8 +521,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::GetInteriorVehicleDataID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::GetInteriorVehicleDataResponse(message);
       } else {
         return new commands::GetInteriorVehicleDataRequest(message);
@@ -526,8 +530,8 @@ commands::Command *MobileCommandFactory::CreateCommand(
       break;
     }
     case mobile_apis::FunctionID::SetInteriorVehicleDataID: {
-      if ((*message)[strings::params][strings::message_type]
-          == static_cast<int>(application_manager::MessageType::kResponse)) {
+      if (message_type ==
+          static_cast<int32_t>(application_manager::MessageType::kResponse)) {
         return new commands::SetInteriorVehicleDataResponse(message);
       } else {
         return new commands::SetInteriorVehicleDataRequest(message);
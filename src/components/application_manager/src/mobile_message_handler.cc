@@ -30,6 +30,7 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <limits.h>
 #include <string.h>
 
 #include "utils/macro.h"
@@ -118,25 +119,35 @@ MobileMessageHandler::HandleIncomingMessageProtocolV2(
   LOG4CXX_INFO(logger_,
                "MobileMessageHandler HandleIncomingMessageProtocolV2()");
 
-  utils::BitStream message_bytestream(message->data(), message->data_size());
+  // Only binary header is parsed, json and binary data are taken
+  // right from message buffer instead of copying them through bit stream
+  const uint8_t* const data = message->data();
+  const size_t data_size = message->data_size();
+  const size_t header_size =
+      protocol_handler::ProtocolPayloadV2SizeBits() / CHAR_BIT;
+  utils::BitStream message_bytestream(const_cast<uint8_t*>(data), data_size);
   protocol_handler::ProtocolPayloadV2 payload;
-  protocol_handler::Extract(&message_bytestream, &payload,
-                            message->data_size());
+  protocol_handler::Extract(&message_bytestream, &payload.header);
 
   // Silently drop message if it wasn't parsed correctly
-  if (message_bytestream.IsBad()) {
+  if (message_bytestream.IsBad() || data_size < header_size ||
+      data_size - header_size < payload.header.json_size) {
     LOG4CXX_WARN(logger_,
                  "Drop ill-formed message from mobile, partially parsed: "
                  << payload);
     return NULL;
   }
+  const uint8_t* const json = data + header_size;
+  const uint8_t* const binary = json + payload.header.json_size;
+  const uint8_t* const end = data + data_size;
 
   std::auto_ptr<application_manager::Message> outgoing_message(
       new application_manager::Message(
           protocol_handler::MessagePriority::FromServiceType(
               message->service_type())));
 
-  outgoing_message->set_json_message(payload.json);
+  outgoing_message->set_json_message(reinterpret_cast<const char*>(json),
+                                     payload.header.json_size);
   outgoing_message->set_function_id(payload.header.rpc_function_id);
   outgoing_message->set_message_type(
       MessageTypeFromRpcType(payload.header.rpc_type));
@@ -148,9 +159,9 @@ MobileMessageHandler::HandleIncomingMessageProtocolV2(
   outgoing_message->set_data_size(message->data_size());
   outgoing_message->set_payload_size(message->payload_size());
 
-  if (!payload.data.empty()) {
+  if (binary != end) {
     outgoing_message->set_binary_data(
-        new application_manager::BinaryData(payload.data));
+        new application_manager::BinaryData(binary, end));
   }
   return outgoing_message.release();
 }
@@ -167,15 +178,15 @@ MobileMessageHandler::HandleOutgoingMessageProtocolV1(
     return NULL;
   }
 
-  uint8_t* rawMessage = new uint8_t[messageString.length() + 1];
-  memcpy(rawMessage, messageString.c_str(), messageString.length() + 1);
-
-  protocol_handler::RawMessage* result = new protocol_handler::RawMessage(
-    message->connection_key(), 1, rawMessage, messageString.length() + 1);
-
-  delete [] rawMessage;
+  utils::BufferSlice rawMessage(messageString.length() + 1);
+  if (rawMessage.empty()) {
+    LOG4CXX_ERROR(logger_, "Failed to allocate memory for message");
+    return NULL;
+  }
+  memcpy(rawMessage.data(), messageString.c_str(), messageString.length() + 1);
 
-  return result;
+  return new protocol_handler::RawMessage(
+    message->connection_key(), 1, rawMessage);
 }
 
 protocol_handler::RawMessage*
@@ -194,7 +205,13 @@ MobileMessageHandler::HandleOutgoingMessageProtocolV2(
 
   const size_t dataForSendingSize =
       protocol_handler::PROTOCOL_HEADER_V2_SIZE + jsonSize + binarySize;
-  uint8_t* dataForSending = new uint8_t[dataForSendingSize];
+  // Message is built right in the storage protocol handler will send
+  utils::BufferSlice dataForSendingBuffer(dataForSendingSize);
+  if (dataForSendingBuffer.empty()) {
+    LOG4CXX_ERROR(logger_, "Failed to allocate memory for message");
+    return NULL;
+  }
+  uint8_t* dataForSending = dataForSendingBuffer.data();
   uint8_t offset = 0;
 
   uint8_t rpcTypeFlag = 0;
@@ -234,20 +251,11 @@ MobileMessageHandler::HandleOutgoingMessageProtocolV2(
 
   if (message->has_binary_data()) {
     const std::vector<uint8_t>& binaryData = *(message->binary_data());
-    uint8_t* currentPointer = dataForSending + offset + jsonSize;
-    for (uint32_t i = 0; i < binarySize; ++i) {
-      currentPointer[i] = binaryData[i];
-    }
+    memcpy(dataForSending + offset + jsonSize, &binaryData[0], binarySize);
   }
 
-  protocol_handler::RawMessage* msgToProtocolHandler =
-    new protocol_handler::RawMessage(message->connection_key(),
-                                     message->protocol_version(),
-                                     dataForSending,
-                                     dataForSendingSize);
-
-  delete [] dataForSending;
-
-  return msgToProtocolHandler;
+  return new protocol_handler::RawMessage(message->connection_key(),
+                                         message->protocol_version(),
+                                         dataForSendingBuffer);
 }
 }  // namespace application_manager
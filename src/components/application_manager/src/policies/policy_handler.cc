@@ -39,6 +39,7 @@
 #include "application_manager/smart_object_keys.h"
 
 #include "application_manager/policies/delegates/app_permission_delegate.h"
+#include "application_manager/policies/delegates/app_registered_delegate.h"
 
 #include "application_manager/application_manager_impl.h"
 #include "application_manager/message_helper.h"
@@ -242,6 +243,7 @@ PolicyHandler::PolicyHandler()
     dl_handle_(0),
     last_activated_app_id_(0),
     app_to_device_link_lock_(true),
+    cached_permissions_version_(0),
     statistic_manager_impl_(new StatisticManagerImpl()) {
 }
 
@@ -308,6 +310,7 @@ bool PolicyHandler::InitPolicyTable() {
 bool PolicyHandler::ResetPolicyTable() {
   LOG4CXX_TRACE(logger_, "Reset policy table.");
   POLICY_LIB_CHECK(false);
+  ResetCachedPermissions();
   std::string preloaded_file =
     profile::Profile::instance()->preloaded_pt_file();
   if (file_system::FileExists(preloaded_file)) {
@@ -320,12 +323,13 @@ bool PolicyHandler::ResetPolicyTable() {
 bool PolicyHandler::ClearUserConsent() {
   LOG4CXX_AUTO_TRACE(logger_);
   POLICY_LIB_CHECK(false);
+  ResetCachedPermissions();
   return policy_manager_->ResetUserConsent();
 }
 
 uint32_t PolicyHandler::GetAppIdForSending() {
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  HmiLevelOrderedApplicationList app_list(accessor.begin(), accessor.end());
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  HmiLevelOrderedApplicationList app_list(snapshot.begin(), snapshot.end());
 
   LOG4CXX_INFO(logger_, "Apps size: " << app_list.size());
 
@@ -354,6 +358,7 @@ void PolicyHandler::OnAppPermissionConsent(const uint32_t connection_key,
 void PolicyHandler::OnDeviceConsentChanged(const std::string& device_id,
                                            bool is_allowed) {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   connection_handler::DeviceHandle device_handle;
   ApplicationManagerImpl::instance()->connection_handler()
       ->GetDeviceID(device_id, &device_handle);
@@ -362,11 +367,11 @@ void PolicyHandler::OnDeviceConsentChanged(const std::string& device_id,
   // back to their own permissions, if device allowed again, and must be
   // notified about these changes
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
   ApplicationManagerImpl::ApplictionSetConstIt it_app_list =
-      accessor.begin();
+      snapshot.begin();
   ApplicationManagerImpl::ApplictionSetConstIt it_app_list_end =
-      accessor.end();
+      snapshot.end();
   for (; it_app_list != it_app_list_end; ++it_app_list) {
     if (device_handle == (*it_app_list).get()->device()) {
 
@@ -396,8 +401,8 @@ void PolicyHandler::OnPTExchangeNeeded() {
 
 void PolicyHandler::GetAvailableApps(std::queue<std::string>& apps) {
   LOG4CXX_INFO(logger_, "GetAvailable apps");
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  const ApplicationManagerImpl::ApplictionSet app_list = accessor.applications();
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  const ApplicationManagerImpl::ApplictionSet& app_list = snapshot.applications();
   ApplicationManagerImpl::ApplictionSetConstIt iter = app_list.begin();
 
   for (;app_list.end() != iter; ++iter) {
@@ -416,6 +421,7 @@ void PolicyHandler::AddApplication(const std::string& device_id,
                                    const std::string& application_id,
                                    const smart_objects::SmartObject* app_types) {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions(application_id);
   std::vector<int> hmi_types;
   if (app_types && app_types->asArray()) {
     smart_objects::SmartArray* hmi_list = app_types->asArray();
@@ -454,6 +460,7 @@ void PolicyHandler::OnAppPermissionConsentInternal(
     const uint32_t connection_key, PermissionConsent &permissions) {
   LOG4CXX_AUTO_TRACE(logger_);
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   if (connection_key) {
     ApplicationSharedPtr app =
         ApplicationManagerImpl::instance()
@@ -538,11 +545,11 @@ void PolicyHandler::OnGetListOfPermissions(const uint32_t connection_key,
   if (!connection_key) {
     sync_primitives::AutoLock lock(app_to_device_link_lock_);
     LinkAppToDevice linker(app_to_device_link_);
-    ApplicationManagerImpl::ApplicationListAccessor accessor;
+    ApplicationManagerImpl::ApplicationListSnapshot snapshot;
     ApplicationManagerImpl::ApplictionSetConstIt it_app
-        = accessor.begin();
+        = snapshot.begin();
     ApplicationManagerImpl::ApplictionSetConstIt it_app_end
-        = accessor.end();
+        = snapshot.end();
 
     // Add all currently registered applications
     std::for_each(it_app, it_app_end, linker);
@@ -669,6 +676,7 @@ void PolicyHandler::OnPendingPermissionChange(
   LOG4CXX_DEBUG(logger_, "PolicyHandler::OnPendingPermissionChange for "
                << policy_app_id);
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions(policy_app_id);
   ApplicationSharedPtr app =
       ApplicationManagerImpl::instance()
       ->application_by_policy_id(policy_app_id);
@@ -754,9 +762,9 @@ bool PolicyHandler::SendMessageToSDK(const BinaryMessage& pt_string,
 #ifdef SDL_REMOTE_CONTROL
     app = ApplicationManagerImpl::instance()->active_application();
     if (!app) {
-      ApplicationManagerImpl::ApplicationListAccessor accessor;
-      if (!accessor.Empty()) {
-        app = *(accessor.begin());
+      ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+      if (!snapshot.Empty()) {
+        app = *(snapshot.begin());
       }
     }
     if (!app) {
@@ -837,6 +845,7 @@ bool PolicyHandler::UnloadPolicyLibrary() {
   if (policy_manager_) {
     policy_manager_.reset();
   }
+  ResetCachedPermissions();
   if (dl_handle_) {
     ret = (dlclose(dl_handle_) == 0);
     dl_handle_ = 0;
@@ -849,13 +858,14 @@ void PolicyHandler::OnAllowSDLFunctionalityNotification(bool is_allowed,
     uint32_t device_id) {
   LOG4CXX_AUTO_TRACE(logger_);
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   // Device ids, need to be changed
   std::set<uint32_t> device_ids;
   bool device_specific = device_id != 0;
   // Common devices consents change
   if (!device_specific) {
-    ApplicationManagerImpl::ApplicationListAccessor accessor;
-    const ApplicationManagerImpl::ApplictionSet app_list = accessor.applications();
+    ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+    const ApplicationManagerImpl::ApplictionSet& app_list = snapshot.applications();
 
     ApplicationManagerImpl::ApplictionSetConstIt it_app_list = app_list.begin();
     ApplicationManagerImpl::ApplictionSetConstIt it_app_end = app_list.end();
@@ -1027,6 +1037,7 @@ void PolicyHandler::OnPermissionsUpdated(const std::string& device_id,
                                          const std::string& policy_app_id,
                                          const Permissions& permissions) {
   LOG4CXX_AUTO_TRACE(logger_);
+  ResetCachedPermissions(policy_app_id);
   ApplicationSharedPtr app = ApplicationManagerImpl::instance()->application(
       device_id, policy_app_id);
   if (!app.valid()) {
@@ -1036,6 +1047,11 @@ void PolicyHandler::OnPermissionsUpdated(const std::string& device_id,
     return;
   }
 
+  // Priority may come with the same policy update
+  std::string priority;
+  GetPriority(policy_app_id, &priority);
+  app->set_policy_priority(priority);
+
   MessageHelper::SendOnPermissionsChangeNotification(
     app->app_id(), permissions);
 
@@ -1084,6 +1100,29 @@ void PolicyHandler::CheckPermissions(const ApplicationSharedPtr app,
                                      const RPCParams& rpc_params,
                                      CheckPermissionResult& result) {
   POLICY_LIB_CHECK_VOID();
+  // Result doesn't depend on rpc parameters, since all allowed ones are
+  // listed, so it is reused until permissions of application are changed
+  const AppState app_state(app->device(), app->hmi_level());
+  uint32_t cached_permissions_version = 0;
+  {
+    sync_primitives::AutoLock lock(cached_permissions_lock_);
+    CachedPermissions::const_iterator app_it =
+        cached_permissions_.find(app->mobile_app_id());
+    if (cached_permissions_.end() != app_it) {
+      AppPermissionResults::const_iterator state_it =
+          app_it->second.find(app_state);
+      if (app_it->second.end() != state_it) {
+        RpcPermissionResults::const_iterator rpc_it =
+            state_it->second.find(rpc);
+        if (state_it->second.end() != rpc_it) {
+          result = rpc_it->second;
+          return;
+        }
+      }
+    }
+    cached_permissions_version = cached_permissions_version_;
+  }
+
   const std::string hmi_level = MessageHelper::StringifiedHMILevel(app->hmi_level());
   const std::string device_id = MessageHelper::GetDeviceMacAddressForHandle(app->device());
   LOG4CXX_INFO(
@@ -1094,6 +1133,24 @@ void PolicyHandler::CheckPermissions(const ApplicationSharedPtr app,
     " rpc " << rpc);
   policy_manager_->CheckPermissions(device_id, app->mobile_app_id(), hmi_level,
                                     rpc, rpc_params, result);
+
+  sync_primitives::AutoLock lock(cached_permissions_lock_);
+  // Permissions could be changed while result was being calculated
+  if (cached_permissions_version == cached_permissions_version_) {
+    cached_permissions_[app->mobile_app_id()][app_state][rpc] = result;
+  }
+}
+
+void PolicyHandler::ResetCachedPermissions() {
+  sync_primitives::AutoLock lock(cached_permissions_lock_);
+  cached_permissions_.clear();
+  ++cached_permissions_version_;
+}
+
+void PolicyHandler::ResetCachedPermissions(const std::string& policy_app_id) {
+  sync_primitives::AutoLock lock(cached_permissions_lock_);
+  cached_permissions_.erase(policy_app_id);
+  ++cached_permissions_version_;
 }
 
 uint32_t PolicyHandler::GetNotificationsNumber(const std::string& priority) {
@@ -1264,6 +1321,19 @@ void PolicyHandler::OnCertificateUpdated(const std::string& certificate_data) {
   }
 }
 
+void PolicyHandler::OnPTUpdated() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  ResetCachedPermissions();
+}
+
+void PolicyHandler::OnPermissionsChangesStarted() {
+  ApplicationManagerImpl::instance()->BeginMobileMessageBatch();
+}
+
+void PolicyHandler::OnPermissionsChangesFinished() {
+  ApplicationManagerImpl::instance()->EndMobileMessageBatch();
+}
+
 bool PolicyHandler::CanUpdate() {
   return 0 != GetAppIdForSending();
 }
@@ -1271,6 +1341,7 @@ bool PolicyHandler::CanUpdate() {
 void PolicyHandler::RemoveDevice(const std::string& device_id) {
   LOG4CXX_AUTO_TRACE(logger_);
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
 
   policy_manager_->MarkUnpairedDevice(device_id);
 
@@ -1349,7 +1420,13 @@ void PolicyHandler::OnAppRegisteredOnMobile(connection_handler::DeviceHandle dev
     const std::string& application_id) {
   POLICY_LIB_CHECK_VOID();
   std::string mac = MessageHelper::GetDeviceMacAddressForHandle(device_handle);
-  policy_manager_->OnAppRegisteredOnMobile(mac, application_id);
+  AsyncRun(new AppRegisteredDelegate(mac, application_id));
+}
+
+void PolicyHandler::OnAppRegisteredOnMobileInternal(
+    const std::string& device_id, const std::string& application_id) {
+  POLICY_LIB_CHECK_VOID();
+  policy_manager_->OnAppRegisteredOnMobile(device_id, application_id);
 }
 
 void PolicyHandler::Increment(usage_statistics::GlobalCounterId type) {
@@ -1444,6 +1521,7 @@ void PolicyHandler::SetAccess(const PTString& device_id,
                               const PTString& module,
                               bool allowed) {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   policy::SeatLocation policy_zone = {zone.col, zone.row, zone.level};
   policy_manager_->SetAccess(device_id, app_id, policy_zone, module, allowed);
 }
@@ -1451,18 +1529,21 @@ void PolicyHandler::SetAccess(const PTString& device_id,
 void PolicyHandler::ResetAccess(const PTString& device_id,
                                 const PTString& app_id) {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   policy_manager_->ResetAccess(device_id, app_id);
 }
 
 void PolicyHandler::ResetAccess(const application_manager::SeatLocation& zone,
                                 const std::string& module) {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   policy::SeatLocation policy_zone  = {zone.col, zone.row, zone.level};
   policy_manager_->ResetAccess(policy_zone, module);
 }
 
 void PolicyHandler::SetPrimaryDevice(const PTString& dev_id) {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   PTString old_dev_id = policy_manager_->PrimaryDevice();
   if (dev_id == old_dev_id) {
     LOG4CXX_INFO(logger_, "Driver's device has not changed.");
@@ -1485,9 +1566,9 @@ void PolicyHandler::SetPrimaryDevice(const PTString& dev_id) {
   std::map<connection_handler::DeviceHandle, PTString> devices;
   devices[device_handle] = dev_id;
   devices[old_device_handle] = old_dev_id;
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  for (ApplicationManagerImpl::ApplictionSetConstIt i = accessor.begin();
-      i != accessor.end(); ++i) {
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  for (ApplicationManagerImpl::ApplictionSetConstIt i = snapshot.begin();
+      i != snapshot.end(); ++i) {
     const ApplicationSharedPtr app = *i;
     LOG4CXX_DEBUG(logger_,
                   "Item: " << app->device() << " - " << app->mobile_app_id());
@@ -1502,6 +1583,7 @@ void PolicyHandler::SetPrimaryDevice(const PTString& dev_id) {
 
 void PolicyHandler::ResetPrimaryDevice() {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   PTString old_dev_id = policy_manager_->PrimaryDevice();
   policy_manager_->ResetPrimaryDevice();
 
@@ -1513,9 +1595,9 @@ void PolicyHandler::ResetPrimaryDevice() {
         logger_,
         "Old: " << old_dev_id << "(" << old_device_handle << ")");
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  for (ApplicationManagerImpl::ApplictionSetConstIt i = accessor.begin();
-      i != accessor.end(); ++i) {
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  for (ApplicationManagerImpl::ApplictionSetConstIt i = snapshot.begin();
+      i != snapshot.end(); ++i) {
     const ApplicationSharedPtr app = *i;
     LOG4CXX_DEBUG(logger_,
                   "Item: " << app->device() << " - " << app->mobile_app_id());
@@ -1543,6 +1625,7 @@ uint32_t PolicyHandler::PrimaryDevice() const {
 void PolicyHandler::SetDeviceZone(const std::string& device_id,
                                   const application_manager::SeatLocation& zone) {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   policy::SeatLocation policy_zone = { zone.col, zone.row, zone.level,
       zone.colspan, zone.rowspan, zone.levelspan };
   policy_manager_->SetDeviceZone(device_id, policy_zone);
@@ -1551,9 +1634,9 @@ void PolicyHandler::SetDeviceZone(const std::string& device_id,
   ApplicationManagerImpl::instance()->connection_handler()
       ->GetDeviceID(device_id, &device_handle);
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  for (ApplicationManagerImpl::ApplictionSetConstIt i = accessor.begin();
-      i != accessor.end(); ++i) {
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  for (ApplicationManagerImpl::ApplictionSetConstIt i = snapshot.begin();
+      i != snapshot.end(); ++i) {
     const ApplicationSharedPtr app = *i;
     LOG4CXX_DEBUG(logger_,
                   "Item: " << app->device() << " - " << app->mobile_app_id());
@@ -1598,11 +1681,12 @@ bool PolicyHandler::GetRemoteControl() const {
 
 void PolicyHandler::OnRemoteAllowedChanged(bool /*new_consent*/) {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions();
   connection_handler::DeviceHandle device_handle = PrimaryDevice();
 
-  ApplicationManagerImpl::ApplicationListAccessor accessor;
-  for (ApplicationManagerImpl::ApplictionSetConstIt i = accessor.begin();
-      i != accessor.end(); ++i) {
+  ApplicationManagerImpl::ApplicationListSnapshot snapshot;
+  for (ApplicationManagerImpl::ApplictionSetConstIt i = snapshot.begin();
+      i != snapshot.end(); ++i) {
     const ApplicationSharedPtr app = *i;
     LOG4CXX_DEBUG(logger_,
                   "Item: " << app->device() << " - " << app->mobile_app_id());
@@ -1619,6 +1703,7 @@ void PolicyHandler::OnRemoteAllowedChanged(bool /*new_consent*/) {
 void PolicyHandler::OnRemoteAppPermissionsChanged(const std::string& device_id,
       const std::string& application_id) {
   POLICY_LIB_CHECK_VOID();
+  ResetCachedPermissions(application_id);
   policy_manager_->SendAppPermissionsChanged(device_id, application_id);
 }
 
@@ -1626,6 +1711,7 @@ void PolicyHandler::OnUpdateHMIStatus(const std::string& device_id,
                                       const std::string& policy_app_id,
                                       const std::string& hmi_level) {
   LOG4CXX_AUTO_TRACE(logger_);
+  ResetCachedPermissions(policy_app_id);
   ApplicationSharedPtr app = ApplicationManagerImpl::instance()->application(
       device_id, policy_app_id);
   if (!app) {
@@ -1655,6 +1741,7 @@ void PolicyHandler::OnUpdateHMIStatus(const std::string& device_id,
                                       const std::string& hmi_level,
                                       const std::string& device_rank) {
   LOG4CXX_AUTO_TRACE(logger_);
+  ResetCachedPermissions(policy_app_id);
   ApplicationSharedPtr app = ApplicationManagerImpl::instance()->application(
       device_id, policy_app_id);
   if (!app) {
@@ -32,9 +32,8 @@
 
 #include "application_manager/policies/policy_retry_sequence.h"
 
-#include <unistd.h>
-
 #include "application_manager/policies/policy_handler.h"
+#include "utils/date_time.h"
 
 namespace policy {
 
@@ -42,10 +41,33 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "PolicyHandler")
 
 RetrySequence::RetrySequence(PolicyHandler* const policy_handler)
     // TODO (Risk copy of PolicyHandler Pointer)
-    : policy_handler_(policy_handler) {
+    : policy_handler_(policy_handler),
+      next_step_(kSendSnapshot),
+      retry_timeout_seconds_(0) {
+}
+
+RetrySequence::~RetrySequence() {
+  Stop();
+}
+
+void RetrySequence::Start() {
+  Stop();
+  next_step_ = kSendSnapshot;
+  retry_timeout_seconds_ = 0;
+  timer::TimerWheel::instance()->Arm(this, 0);
+}
+
+void RetrySequence::Stop() {
+  timer::TimerWheel::instance()->Cancel(this);
 }
 
-void RetrySequence::threadMain() {
+void RetrySequence::OnTimeout() {
+  DCHECK(policy_handler_);
+  if (kExchangeTimeout == next_step_) {
+    policy_handler_->OnExceededTimeout();
+    ScheduleRetry();
+    return;
+  }
   StartNextRetry();
 }
 
@@ -56,25 +78,34 @@ void RetrySequence::StartNextRetry() {
 
   BinaryMessageSptr pt_snapshot = policy_handler_
       ->RequestPTUpdate();
-  if (pt_snapshot) {
-    policy_handler_->SendMessageToSDK(*pt_snapshot);
-
-    const int timeout = policy_handler_->TimeoutExchange();
-    const int seconds = policy_handler_->NextRetryTimeout();
-    LOG4CXX_DEBUG(logger_,
-                  "Timeout response: " << timeout << " Next try: " << seconds);
-    if (timeout > 0) {
-      sleep(timeout);
-      policy_handler_->OnExceededTimeout();
-    }
-    if (seconds > 0) {
-      sleep(seconds);
-      StartNextRetry();
-    } else {
-      LOG4CXX_INFO(logger_, "End retry sequence. Update PT was not received");
-    }
+  if (!pt_snapshot) {
+    return;
   }
+  policy_handler_->SendMessageToSDK(*pt_snapshot);
+
+  const int timeout = policy_handler_->TimeoutExchange();
+  retry_timeout_seconds_ = policy_handler_->NextRetryTimeout();
+  LOG4CXX_DEBUG(logger_, "Timeout response: " << timeout
+                << " Next try: " << retry_timeout_seconds_);
+  if (timeout > 0) {
+    next_step_ = kExchangeTimeout;
+    timer::TimerWheel::instance()->Arm(
+        this, static_cast<uint64_t>(timeout) *
+                  date_time::DateTime::MILLISECONDS_IN_SECOND);
+    return;
+  }
+  ScheduleRetry();
 }
 
-}  // namespace policy
+void RetrySequence::ScheduleRetry() {
+  if (retry_timeout_seconds_ <= 0) {
+    LOG4CXX_INFO(logger_, "End retry sequence. Update PT was not received");
+    return;
+  }
+  next_step_ = kSendSnapshot;
+  timer::TimerWheel::instance()->Arm(
+      this, static_cast<uint64_t>(retry_timeout_seconds_) *
+                date_time::DateTime::MILLISECONDS_IN_SECOND);
+}
 
+}  // namespace policy
@@ -35,6 +35,9 @@
 #include "application_manager/request_controller.h"
 #include "application_manager/commands/command_request_impl.h"
 #include "application_manager/commands/hmi/request_to_hmi.h"
+#ifdef TIME_TESTER
+#include "utils/rpc_trace.h"
+#endif  // TIME_TESTER
 
 namespace application_manager {
 
@@ -47,8 +50,20 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "RequestController");
 RequestController::RequestController()
   : pool_state_(UNDEFINED),
     pool_size_(profile::Profile::instance()->thread_pool_size()),
+    pending_requests_count_(0),
     timer_("RequestCtrlTimer", this, &RequestController::onTimer, true),
-    is_low_voltage_(false) {
+    timer_end_time_(0),
+    is_low_voltage_(false),
+    pending_requests_metric_(utils::metrics::MetricsRegistry::instance()
+        ->GetGauge("request_controller.pending_requests")),
+    rejected_requests_metric_(utils::metrics::MetricsRegistry::instance()
+        ->GetCounter("request_controller.rejected_requests")),
+    expired_requests_metric_(utils::metrics::MetricsRegistry::instance()
+        ->GetCounter("request_controller.expired_requests")),
+    execution_time_metric_(utils::metrics::MetricsRegistry::instance()
+        ->GetHistogram("request_controller.execution_time_us")),
+    response_time_metric_(utils::metrics::MetricsRegistry::instance()
+        ->GetHistogram("request_controller.response_time_us")) {
   LOG4CXX_AUTO_TRACE(logger_);
   InitializeThreadpool();
   timer_.start(dafault_sleep_time_);
@@ -77,7 +92,7 @@ void RequestController::InitializeThreadpool() {
 void RequestController::DestroyThreadpool() {
   LOG4CXX_AUTO_TRACE(logger_);
   {
-    AutoLock auto_lock(mobile_request_list_lock_);
+    AutoLock auto_lock(mobile_requests_lock_);
     pool_state_ = TPoolState::STOPPED;
     LOG4CXX_DEBUG(logger_, "Broadcasting STOP signal to all threads...");
     cond_var_.Broadcast();  // notify all threads we are shutting down
@@ -92,40 +107,40 @@ void RequestController::DestroyThreadpool() {
 }
 
 RequestController::TResult  RequestController::CheckPosibilitytoAdd(
-    const RequestPtr request) {
+    const RequestPtr request, const mobile_apis::HMILevel::eType hmi_level) {
   LOG4CXX_AUTO_TRACE(logger_);
-  const uint32_t& app_hmi_level_none_time_scale =
-      profile::Profile::instance()->app_hmi_level_none_time_scale();
+  // Limits are taken from one snapshot, so reload never mixes them
+  const profile::ProfileSnapshot& snapshot =
+      profile::Profile::instance()->snapshot();
+  const uint32_t app_hmi_level_none_time_scale =
+      snapshot.app_hmi_level_none_time_scale;
 
   // app_hmi_level_none_max_request_per_time_scale
-  const uint32_t& hmi_level_none_count =
-     profile::Profile::instance()->app_hmi_level_none_time_scale_max_requests();
+  const uint32_t hmi_level_none_count =
+      snapshot.app_hmi_level_none_time_scale_max_requests;
 
-  const uint32_t& app_time_scale =
-      profile::Profile::instance()->app_time_scale();
+  const uint32_t app_time_scale = snapshot.app_time_scale;
 
-  const uint32_t& max_request_per_time_scale =
-      profile::Profile::instance()->app_time_scale_max_requests();
+  const uint32_t max_request_per_time_scale =
+      snapshot.app_time_scale_max_requests;
 
-  const uint32_t& pending_requests_amount =
-      profile::Profile::instance()->pending_requests_amount();
+  const uint32_t pending_requests_amount = snapshot.pending_requests_amount;
 
   if (!CheckPendingRequestsAmount(pending_requests_amount)) {
     LOG4CXX_ERROR(logger_, "Too many pending request");
     return RequestController::TOO_MANY_PENDING_REQUESTS;
   }
 
-  if (!waiting_for_response_.CheckHMILevelTimeScaleMaxRequest(
-                                        mobile_apis::HMILevel::HMI_NONE,
-                                        request->connection_key(),
-                                        app_hmi_level_none_time_scale,
-                                        hmi_level_none_count)) {
+  const RequestRateLimiter::Result rate_result = rate_limiter_.TakeToken(
+      request->connection_key(), hmi_level,
+      date_time::DateTime::getuSecs(date_time::DateTime::getMonotonicTime()),
+      app_time_scale, max_request_per_time_scale,
+      app_hmi_level_none_time_scale, hmi_level_none_count);
+  if (RequestRateLimiter::NONE_HMI_LEVEL_MANY_REQUESTS == rate_result) {
     LOG4CXX_ERROR(logger_, "Too many application requests in hmi level NONE");
     return RequestController::NONE_HMI_LEVEL_MANY_REQUESTS;
   }
-  if (!waiting_for_response_.CheckTimeScaleMaxRequest(request->connection_key(),
-                                app_time_scale,
-                                max_request_per_time_scale)) {
+  if (RequestRateLimiter::TOO_MANY_REQUESTS == rate_result) {
     LOG4CXX_ERROR(logger_, "Too many application requests");
     return RequestController::TOO_MANY_REQUESTS;
   }
@@ -136,7 +151,8 @@ bool RequestController::CheckPendingRequestsAmount(
     const uint32_t& pending_requests_amount) {
   LOG4CXX_AUTO_TRACE(logger_);
   if (pending_requests_amount > 0) {
-    const size_t pending_requests_size = mobile_request_list_.size();
+    AutoLock auto_lock(mobile_requests_lock_);
+    const size_t pending_requests_size = pending_requests_count_;
     const bool available_to_add =
         pending_requests_amount > pending_requests_size;
     if (!available_to_add) {
@@ -151,7 +167,8 @@ bool RequestController::CheckPendingRequestsAmount(
 
 RequestController::TResult RequestController::addMobileRequest(
     const RequestPtr request,
-    const mobile_apis::HMILevel::eType& hmi_level) {
+    const mobile_apis::HMILevel::eType& hmi_level,
+    SchedulingClass scheduling_class) {
   LOG4CXX_AUTO_TRACE(logger_);
   if (!request) {
     LOG4CXX_ERROR(logger_, "Null Pointer request");
@@ -160,13 +177,28 @@ RequestController::TResult RequestController::addMobileRequest(
   }
   LOG4CXX_DEBUG(logger_, "correlation_id : " << request->correlation_id()
                 << "connection_key : " << request->connection_key());
-  RequestController::TResult result = CheckPosibilitytoAdd(request);
+  RequestController::TResult result = CheckPosibilitytoAdd(request, hmi_level);
   if (SUCCESS ==result) {
-    AutoLock auto_lock_list(mobile_request_list_lock_);
-    mobile_request_list_.push_back(request);
+    AutoLock auto_lock_list(mobile_requests_lock_);
+    AppRequestsMap::iterator it = mobile_requests_.insert(
+        std::make_pair(request->connection_key(), AppRequests())).first;
+    it->second.requests.push_back(request);
+    it->second.scheduling_class = scheduling_class;
+    ++pending_requests_count_;
+    pending_requests_metric_->Set(pending_requests_count_);
+    MakeReady(it);
+#ifdef TIME_TESTER
+    const utils::RpcTracePtr trace = utils::RpcTracer::instance()->Find(
+        request->connection_key(), request->correlation_id());
+    if (trace) {
+      trace->Enqueue(utils::rpc_trace::kCommand);
+    }
+#endif  // TIME_TESTER
     LOG4CXX_DEBUG(logger_, "Waiting for execution: "
-                  << mobile_request_list_.size());
+                  << pending_requests_count_);
   // wake up one thread that is waiting for a task to be available
+  } else {
+    rejected_requests_metric_->Increment();
   }
   cond_var_.NotifyOne();
   return result;
@@ -184,8 +216,8 @@ RequestController::TResult RequestController::addHMIRequest(
 
   const uint32_t timeout_in_seconds =
       request->default_timeout() / date_time::DateTime::MILLISECONDS_IN_SECOND;
-  RequestInfoPtr request_info_ptr(new HMIRequestInfo(request,
-                                                     timeout_in_seconds));
+  RequestInfoPtr request_info_ptr =
+      utils::MakeShared<HMIRequestInfo>(request, timeout_in_seconds);
 
   if (0 != timeout_in_seconds) {
     waiting_for_response_.Add(request_info_ptr);
@@ -229,6 +261,9 @@ void RequestController::terminateRequest(
   RequestInfoPtr request = waiting_for_response_.Find(connection_key,
                                                       correlation_id);
   if (request) {
+    response_time_metric_->Record(date_time::DateTime::getuSecs(
+        date_time::DateTime::Sub(date_time::DateTime::getMonotonicTime(),
+                                 request->start_time())));
     waiting_for_response_.RemoveRequest(request);
     UpdateTimer();
   } else {
@@ -252,21 +287,22 @@ void RequestController::terminateHMIRequest(const uint32_t &correlation_id) {
 void RequestController::terminateWaitingForExecutionAppRequests(
     const uint32_t& app_id) {
   LOG4CXX_AUTO_TRACE(logger_);
+  AutoLock auto_lock(mobile_requests_lock_);
   LOG4CXX_DEBUG(logger_, "app_id: "  << app_id
-                << "Waiting for execution" << mobile_request_list_.size());
-  AutoLock
-      auto_lock(mobile_request_list_lock_);
-  std::list<RequestPtr>::iterator request_it = mobile_request_list_.begin();
-  while (mobile_request_list_.end() != request_it) {
-    RequestPtr request = (*request_it);
-    if ((request.valid()) && (request->connection_key() == app_id)) {
-      mobile_request_list_.erase(request_it++);
+                << "Waiting for execution" << pending_requests_count_);
+  AppRequestsMap::iterator it = mobile_requests_.find(app_id);
+  if (mobile_requests_.end() != it) {
+    pending_requests_count_ -= it->second.requests.size();
+    pending_requests_metric_->Set(pending_requests_count_);
+    // Busy application is erased by worker, ready_apps_ skips missing ones
+    if (it->second.busy) {
+      it->second.requests.clear();
     } else {
-      ++request_it;
+      mobile_requests_.erase(it);
     }
   }
   LOG4CXX_DEBUG(logger_, "Waiting for execution "
-                << mobile_request_list_.size());
+                << pending_requests_count_);
 }
 
 void RequestController::terminateWaitingForResponseAppRequests(
@@ -282,12 +318,13 @@ void RequestController::terminateAppRequests(
   LOG4CXX_AUTO_TRACE(logger_);
   LOG4CXX_DEBUG(logger_, "app_id : " << app_id
                 << "Requests waiting for execution count : "
-                << mobile_request_list_.size()
+                << pending_requests_count_
                 << "Requests waiting for response count : "
                 << waiting_for_response_.Size());
 
   terminateWaitingForExecutionAppRequests(app_id);
   terminateWaitingForResponseAppRequests(app_id);
+  rate_limiter_.RemoveApplication(app_id);
   UpdateTimer();
 }
 
@@ -300,8 +337,23 @@ void RequestController::terminateAllMobileRequests() {
   LOG4CXX_AUTO_TRACE(logger_);
   waiting_for_response_.RemoveMobileRequests();
   LOG4CXX_DEBUG(logger_, "Mobile Requests waiting for response cleared");
-  AutoLock waiting_execution_auto_lock(mobile_request_list_lock_);
-  mobile_request_list_.clear();
+  {
+    AutoLock waiting_execution_auto_lock(mobile_requests_lock_);
+    AppRequestsMap::iterator it = mobile_requests_.begin();
+    while (mobile_requests_.end() != it) {
+      // Busy applications are not ready, so they are erased by workers
+      if (it->second.busy) {
+        (it++)->second.requests.clear();
+      } else {
+        mobile_requests_.erase(it++);
+      }
+    }
+    for (size_t i = 0; i < kSchedulingClassesCount; ++i) {
+      ready_apps_[i].clear();
+    }
+    pending_requests_count_ = 0;
+    pending_requests_metric_->Set(0);
+  }
   LOG4CXX_DEBUG(logger_, "Mobile Requests waiting for execution cleared");
   UpdateTimer();
 }
@@ -319,9 +371,7 @@ void RequestController::updateRequestTimeout(
   if (request_info) {
     uint32_t timeout_in_seconds =
         new_timeout/date_time::DateTime::MILLISECONDS_IN_SECOND;
-    waiting_for_response_.RemoveRequest(request_info);
-    request_info->updateTimeOut(timeout_in_seconds);
-    waiting_for_response_.Add(request_info);
+    waiting_for_response_.UpdateTimeout(request_info, timeout_in_seconds);
     UpdateTimer();
     LOG4CXX_INFO(logger_, "Timeout updated for "
                   << " app_id " << app_id
@@ -368,6 +418,7 @@ void RequestController::onTimer() {
                  probably_expired ->app_id() << " is expired");
     const uint32_t experied_request_id = probably_expired->requestId();
     const uint32_t experied_app_id = probably_expired->app_id();
+    expired_requests_metric_->Increment();
 
     probably_expired->request()->onTimeOut();
     if (RequestInfo::HmiConnectoinKey == probably_expired ->app_id()) {
@@ -384,6 +435,11 @@ void RequestController::onTimer() {
       }
     }
   }
+  {
+    AutoLock auto_lock(timer_lock_);
+    // Timer has fired, so it has to be armed again
+    timer_end_time_ = 0;
+  }
   UpdateTimer();
   LOG4CXX_DEBUG(logger_, "EXIT Waiting for response count : "
                 << waiting_for_response_.Size());
@@ -402,35 +458,40 @@ void RequestController::Worker::threadMain() {
   AutoLock auto_lock(thread_lock_);
   while (!stop_flag_) {
     // Try to pick a request
-    AutoLock auto_lock(request_controller_->mobile_request_list_lock_);
-
-    while ((request_controller_->pool_state_ != TPoolState::STOPPED) &&
-           (request_controller_->mobile_request_list_.empty())) {
-      // Wait until there is a task in the queue
-      // Unlock mutex while wait, then lock it back when signaled
-      LOG4CXX_INFO(logger_, "Unlocking and waiting");
-      request_controller_->cond_var_.Wait(auto_lock);
-      LOG4CXX_INFO(logger_, "Signaled and locking");
-    }
+    uint32_t app_id = 0;
+    RequestPtr request;
+    {
+      AutoLock auto_lock(request_controller_->mobile_requests_lock_);
+      while ((request_controller_->pool_state_ != TPoolState::STOPPED) &&
+             !request_controller_->TakeReadyRequest(&app_id, &request)) {
+        // Wait until there is a task in the queue
+        // Unlock mutex while wait, then lock it back when signaled
+        LOG4CXX_INFO(logger_, "Unlocking and waiting");
+        request_controller_->cond_var_.Wait(auto_lock);
+        LOG4CXX_INFO(logger_, "Signaled and locking");
+      }
 
-    // If the thread was shutdown, return from here
-    if (request_controller_->pool_state_ == TPoolState::STOPPED) {
-      break;
+      // If the thread was shutdown, return from here
+      if (request_controller_->pool_state_ == TPoolState::STOPPED) {
+        break;
+      }
     }
 
-    if (request_controller_->mobile_request_list_.empty()) {
-      LOG4CXX_WARN(logger_, "Mobile request list is empty");
-      break;
+#ifdef TIME_TESTER
+    const utils::RpcTracePtr trace = utils::RpcTracer::instance()->Find(
+        request->connection_key(), request->correlation_id());
+    if (trace) {
+      trace->Begin(utils::rpc_trace::kCommand);
     }
-
-    RequestPtr request(request_controller_->mobile_request_list_.front());
-    request_controller_->mobile_request_list_.pop_front();
+#endif  // TIME_TESTER
+    const TimevalStruct execution_start = date_time::DateTime::getPreciseMonotonicTime();
+    // Other workers take requests of other applications meanwhile
     bool init_res = request->Init();  // to setup specific default timeout
 
     const uint32_t timeout_in_seconds =
        request->default_timeout() / date_time::DateTime::MILLISECONDS_IN_SECOND;
-    RequestInfoPtr request_info_ptr(new MobileRequestInfo(request,
-                                                          timeout_in_seconds));
+    RequestInfoPtr request_info_ptr =
+        utils::MakeShared<MobileRequestInfo>(request, timeout_in_seconds);
 
     request_controller_->waiting_for_response_.Add(request_info_ptr);
     if (0 != timeout_in_seconds) {
@@ -443,13 +504,20 @@ void RequestController::Worker::threadMain() {
                    "RequestController will not track timeout of this request.");
     }
 
-    AutoUnlock unlock(auto_lock);
-
     // execute
     if ((false == request_controller_->IsLowVoltage()) &&
         request->CheckPermissions() && init_res) {
       request->Run();
     }
+    request_controller_->execution_time_metric_->Record(
+        date_time::DateTime::getuSecs(date_time::DateTime::Sub(
+            date_time::DateTime::getPreciseMonotonicTime(), execution_start)));
+#ifdef TIME_TESTER
+    if (trace) {
+      trace->End(utils::rpc_trace::kCommand);
+    }
+#endif  // TIME_TESTER
+    request_controller_->OnRequestExecuted(app_id);
   }
 }
 
@@ -459,17 +527,79 @@ void RequestController::Worker::exitThreadMain() {
   // FIXME (dchmerev@luxoft.com): There is no waiting
 }
 
+bool RequestController::TakeReadyRequest(uint32_t* app_id,
+                                         RequestPtr* request) {
+  size_t scheduling_class = kSchedulingClassesCount;
+  while (scheduling_class > 0) {
+    std::deque<uint32_t>& ready_apps = ready_apps_[scheduling_class - 1];
+    if (ready_apps.empty()) {
+      --scheduling_class;
+      continue;
+    }
+    const uint32_t ready_app_id = ready_apps.front();
+    ready_apps.pop_front();
+    AppRequestsMap::iterator it = mobile_requests_.find(ready_app_id);
+    // Requests of application could be terminated after it got ready
+    if (mobile_requests_.end() == it || !it->second.ready) {
+      continue;
+    }
+    AppRequests& app_requests = it->second;
+    app_requests.ready = false;
+    DCHECK(!app_requests.busy);
+    DCHECK(!app_requests.requests.empty());
+    *app_id = ready_app_id;
+    *request = app_requests.requests.front();
+    app_requests.requests.pop_front();
+    app_requests.busy = true;
+    --pending_requests_count_;
+    pending_requests_metric_->Set(pending_requests_count_);
+    return true;
+  }
+  return false;
+}
+
+void RequestController::OnRequestExecuted(const uint32_t app_id) {
+  AutoLock auto_lock(mobile_requests_lock_);
+  AppRequestsMap::iterator it = mobile_requests_.find(app_id);
+  if (mobile_requests_.end() == it) {
+    return;
+  }
+  it->second.busy = false;
+  if (it->second.requests.empty()) {
+    mobile_requests_.erase(it);
+    return;
+  }
+  // Application goes after other ready ones, so none of them is starved
+  MakeReady(it);
+  cond_var_.NotifyOne();
+}
+
+void RequestController::MakeReady(AppRequestsMap::iterator it) {
+  if (it->second.ready || it->second.busy) {
+    return;
+  }
+  it->second.ready = true;
+  ready_apps_[it->second.scheduling_class].push_back(it->first);
+}
+
 void RequestController::UpdateTimer() {
   LOG4CXX_AUTO_TRACE(logger_);
   RequestInfoPtr front = waiting_for_response_.FrontWithNotNullTimeout();
+  AutoLock auto_lock(timer_lock_);
   if (front) {
-    const TimevalStruct current_time = date_time::DateTime::getCurrentTime();
+    const TimevalStruct current_time = date_time::DateTime::getMonotonicTime();
     const TimevalStruct end_time = front->end_time();
+    if (0 != timer_end_time_ &&
+        timer_end_time_ <= static_cast<uint64_t>(end_time.tv_sec)) {
+      LOG4CXX_DEBUG(logger_, "Timer fires before " << end_time.tv_sec);
+      return;
+    }
     if (current_time < end_time) {
       const uint64_t secs = end_time.tv_sec - current_time.tv_sec;
       LOG4CXX_DEBUG(logger_, "Sleep for " << secs << " secs");
       // Timeout for bigger than 5 minutes is a mistake
       timer_.updateTimeOut(secs);
+      timer_end_time_ = end_time.tv_sec;
     } else {
       LOG4CXX_WARN(logger_, "Request app_id = " << front->app_id()
                    << "correlation_id = " << front->requestId()
@@ -478,8 +608,9 @@ void RequestController::UpdateTimer() {
                    << current_time.tv_sec << " >= "
                    << front->timeout_sec());
       timer_.updateTimeOut(0);
+      timer_end_time_ = current_time.tv_sec;
     }
-  } else {
+  } else if (0 == timer_end_time_) {
     LOG4CXX_DEBUG(logger_, "Sleep for default sleep time "
                   << dafault_sleep_time_ << " secs");
     timer_.updateTimeOut(dafault_sleep_time_);
@@ -36,6 +36,8 @@
 #include "application_manager/request_info.h"
 
 #include <algorithm>
+#include <limits>
+
 namespace application_manager {
 
 namespace request_controller {
@@ -92,7 +94,7 @@ RequestInfo::RequestInfo(RequestPtr request,
 }
 
 void application_manager::request_controller::RequestInfo::updateEndTime() {
-  end_time_ = date_time::DateTime::getCurrentTime();
+  end_time_ = date_time::DateTime::getMonotonicTime();
   end_time_.tv_sec += timeout_sec_;
 
   // possible delay during IPC
@@ -106,7 +108,7 @@ void RequestInfo::updateTimeOut(const uint64_t& timeout_sec)  {
 }
 
 bool RequestInfo::isExpired() {
-  TimevalStruct curr_time = date_time::DateTime::getCurrentTime();
+  TimevalStruct curr_time = date_time::DateTime::getMonotonicTime();
   return end_time_.tv_sec <= curr_time.tv_sec;
   // TODO(AKutsan) APPLINK-9711 Need to use compareTime method when timer will support millisecconds
   // return date_time::GREATER == date_time::DateTime::compareTime(end_time_, curr_time);
@@ -124,11 +126,6 @@ uint64_t RequestInfo::GenerateHash(uint32_t var1, uint32_t var2) {
   return hash_result;
 }
 
-FakeRequestInfo::FakeRequestInfo(uint32_t app_id, uint32_t correaltion_id) {
-  app_id_ = app_id;
-  correlation_id_ = correaltion_id;
-}
-
 bool RequestInfoSet::Add(RequestInfoPtr request_info) {
   DCHECK(request_info);
   if (!request_info) {
@@ -137,24 +134,17 @@ bool RequestInfoSet::Add(RequestInfoPtr request_info) {
   }
   LOG4CXX_DEBUG(logger_, "Add request app_id = " << request_info->app_id()
                 << "; corr_id = " << request_info->requestId());
-  CheckSetSizes();
   sync_primitives::AutoLock lock(this_lock_);
-  const std::pair<HashSortedRequestInfoSet::iterator, bool>& insert_resilt =
-      hash_sorted_pending_requests_.insert(request_info);
+  const std::pair<HashSortedRequestInfoMap::iterator, bool>& insert_resilt =
+      hash_sorted_pending_requests_.insert(
+          std::make_pair(request_info->hash(), request_info));
   if (insert_resilt.second == true) {
-    const std::pair<TimeSortedRequestInfoSet::iterator, bool>& insert_resilt =
-        time_sorted_pending_requests_.insert(request_info);
-    DCHECK(insert_resilt.second);
-    if (!insert_resilt.second) {
-      return false;
-    }
-    CheckSetSizes();
+    PushDeadline(request_info);
     return true;
   } else {
     LOG4CXX_ERROR(logger_, "Request with app_id = " << request_info->app_id()
                   << "; corr_id " << request_info->requestId() << " Already exist ");
   }
-  CheckSetSizes();
   return false;
 }
 
@@ -162,15 +152,11 @@ RequestInfoPtr RequestInfoSet::Find(const uint32_t connection_key,
                                     const uint32_t correlation_id) {
   RequestInfoPtr result;
 
-  // Request info for searching in request info set by log_n time
-  utils::SharedPtr<FakeRequestInfo> request_info_for_search(
-      new FakeRequestInfo(connection_key, correlation_id));
-
   sync_primitives::AutoLock lock(this_lock_);
-  HashSortedRequestInfoSet::iterator it =
-      hash_sorted_pending_requests_.find(request_info_for_search);
+  HashSortedRequestInfoMap::iterator it = hash_sorted_pending_requests_.find(
+      RequestInfo::GenerateHash(connection_key, correlation_id));
   if (it != hash_sorted_pending_requests_.end()) {
-     result = *it;
+     result = it->second;
   }
   return result;
 }
@@ -179,9 +165,11 @@ RequestInfoPtr RequestInfoSet::Front() {
   RequestInfoPtr result;
 
   sync_primitives::AutoLock lock(this_lock_);
-  TimeSortedRequestInfoSet::iterator it = time_sorted_pending_requests_.begin();
-  if (it != time_sorted_pending_requests_.end()) {
-    result = *it;
+  HashSortedRequestInfoMap::iterator it = hash_sorted_pending_requests_.begin();
+  for (; it != hash_sorted_pending_requests_.end(); ++it) {
+    if (!result || it->second->end_time() < result->end_time()) {
+      result = it->second;
+    }
   }
   return result;
 }
@@ -189,17 +177,36 @@ RequestInfoPtr RequestInfoSet::Front() {
 RequestInfoPtr RequestInfoSet::FrontWithNotNullTimeout() {
   LOG4CXX_AUTO_TRACE(logger_);
   sync_primitives::AutoLock lock(this_lock_);
-  RequestInfoPtr result;
-  TimeSortedRequestInfoSet::iterator it = time_sorted_pending_requests_.begin();
-  while (it != time_sorted_pending_requests_.end()) {
-    if (0 != (*it)->timeout_sec()) {
-      result =*it;
-      it = time_sorted_pending_requests_.end();
-    } else {
-      ++it;
+  while (!deadlines_.empty()) {
+    if (IsActualDeadline(deadlines_.front())) {
+      return deadlines_.front().request_info;
     }
+    std::pop_heap(deadlines_.begin(), deadlines_.end(), DeadlineComparator());
+    deadlines_.pop_back();
   }
-  return result;
+  return RequestInfoPtr();
+}
+
+bool RequestInfoSet::UpdateTimeout(const RequestInfoPtr request_info,
+                                   const uint64_t timeout_sec) {
+  DCHECK(request_info);
+  if (!request_info) {
+    LOG4CXX_ERROR(logger_, "NULL ponter request_info");
+    return false;
+  }
+  sync_primitives::AutoLock lock(this_lock_);
+  HashSortedRequestInfoMap::iterator it =
+      hash_sorted_pending_requests_.find(request_info->hash());
+  if (it == hash_sorted_pending_requests_.end() || it->second != request_info) {
+    LOG4CXX_ERROR(logger_, "Request with app_id = " << request_info->app_id()
+                  << "; corr_id " << request_info->requestId()
+                  << " is not found");
+    return false;
+  }
+  // Previous deadline of request becomes stale
+  request_info->updateTimeOut(timeout_sec);
+  PushDeadline(request_info);
+  return true;
 }
 
 bool RequestInfoSet::Erase(const RequestInfoPtr request_info) {
@@ -208,27 +215,55 @@ bool RequestInfoSet::Erase(const RequestInfoPtr request_info) {
     LOG4CXX_ERROR(logger_, "NULL ponter request_info");
     return false;
   }
-  CheckSetSizes();
-
-  size_t erased_count =
-      hash_sorted_pending_requests_.erase(request_info);
-  DCHECK((erased_count <= 1));
-  if (1 == erased_count) {
-    TimeSortedRequestInfoSet::iterator it =
-        time_sorted_pending_requests_.find(request_info);
-    DCHECK(it != time_sorted_pending_requests_.end());
-    if (it == time_sorted_pending_requests_.end()) {
-      LOG4CXX_ERROR(logger_, "Can't find request in time_sorted_requests_");
-      return false;
+
+  HashSortedRequestInfoMap::iterator it =
+      hash_sorted_pending_requests_.find(request_info->hash());
+  if (it == hash_sorted_pending_requests_.end()) {
+    return false;
+  }
+  const RequestInfoPtr found = it->second;
+  DCHECK(request_info == found);
+  hash_sorted_pending_requests_.erase(it);
+  return true;
+}
+
+void RequestInfoSet::PushDeadline(const RequestInfoPtr request_info) {
+  if (0 == request_info->timeout_sec()) {
+    return;
+  }
+  CompactDeadlines();
+  deadlines_.push_back(Deadline(request_info));
+  std::push_heap(deadlines_.begin(), deadlines_.end(), DeadlineComparator());
+}
+
+bool RequestInfoSet::IsActualDeadline(const Deadline& deadline) {
+  const RequestInfoPtr& request_info = deadline.request_info;
+  if (0 == request_info->timeout_sec() ||
+      !(deadline.end_time == request_info->end_time())) {
+    return false;
+  }
+  HashSortedRequestInfoMap::iterator it =
+      hash_sorted_pending_requests_.find(request_info->hash());
+  return it != hash_sorted_pending_requests_.end() && it->second == request_info;
+}
+
+void RequestInfoSet::CompactDeadlines() {
+  // Keeps heap within linear size of collection, so rebuild is amortized
+  const size_t min_deadlines_to_compact = 64;
+  if (deadlines_.size() < min_deadlines_to_compact ||
+      deadlines_.size() < 2 * hash_sorted_pending_requests_.size()) {
+    return;
+  }
+  std::vector<Deadline> deadlines;
+  deadlines.reserve(hash_sorted_pending_requests_.size());
+  HashSortedRequestInfoMap::iterator it = hash_sorted_pending_requests_.begin();
+  for (; it != hash_sorted_pending_requests_.end(); ++it) {
+    if (0 != it->second->timeout_sec()) {
+      deadlines.push_back(Deadline(it->second));
     }
-    const RequestInfoPtr found = *it;
-    DCHECK(request_info == found);
-    time_sorted_pending_requests_.erase(it);
-    CheckSetSizes();
-    return 1 == erased_count;
   }
-  CheckSetSizes();
-  return false;
+  std::make_heap(deadlines.begin(), deadlines.end(), DeadlineComparator());
+  deadlines_.swap(deadlines);
 }
 
 bool RequestInfoSet::RemoveRequest(const RequestInfoPtr request_info) {
@@ -237,135 +272,54 @@ bool RequestInfoSet::RemoveRequest(const RequestInfoPtr request_info) {
 }
 
 
-uint32_t RequestInfoSet::RemoveRequests(const RequestInfoSet::AppIdCompararator& filter) {
-  LOG4CXX_AUTO_TRACE(logger_);
-  uint32_t erased = 0;
+namespace {
+const uint32_t kMaxId = std::numeric_limits<uint32_t>::max();
+}  // namespace
 
-  sync_primitives::AutoLock lock(this_lock_);
-  HashSortedRequestInfoSet::iterator it = std::find_if(
-                                            hash_sorted_pending_requests_.begin(),
-                                            hash_sorted_pending_requests_.end(),
-                                            filter);
-  while (it !=  hash_sorted_pending_requests_.end()) {
-    HashSortedRequestInfoSet::iterator to_erase = it++;
-    Erase(*to_erase);
-    it = std::find_if(it, hash_sorted_pending_requests_.end(), filter);
-    erased++;
+uint32_t RequestInfoSet::RemoveAppsRange(const uint32_t first_app_id,
+                                         const uint32_t last_app_id) {
+  uint32_t erased = 0;
+  HashSortedRequestInfoMap::iterator it =
+      hash_sorted_pending_requests_.lower_bound(
+          RequestInfo::GenerateHash(first_app_id, 0));
+  const HashSortedRequestInfoMap::iterator end =
+      hash_sorted_pending_requests_.upper_bound(
+          RequestInfo::GenerateHash(last_app_id, kMaxId));
+  for (; it != end; ++erased) {
+    hash_sorted_pending_requests_.erase(it++);
   }
-  CheckSetSizes();
   return erased;
 }
 
-
 uint32_t RequestInfoSet::RemoveByConnectionKey(uint32_t connection_key) {
   LOG4CXX_AUTO_TRACE(logger_);
-  return RemoveRequests(AppIdCompararator(AppIdCompararator::Equal, connection_key));
+  sync_primitives::AutoLock lock(this_lock_);
+  return RemoveAppsRange(connection_key, connection_key);
 }
 
 uint32_t RequestInfoSet::RemoveMobileRequests() {
   LOG4CXX_AUTO_TRACE(logger_);
-  return RemoveRequests(AppIdCompararator(AppIdCompararator::NotEqual, RequestInfo::HmiConnectoinKey));
-}
-
-const size_t RequestInfoSet::Size() {
-  CheckSetSizes();
-  return time_sorted_pending_requests_.size();
-}
-
-void RequestInfoSet::CheckSetSizes() {
-  const ssize_t time_set_size = time_sorted_pending_requests_.size();
-  const ssize_t hash_set_size = hash_sorted_pending_requests_.size();
-  const bool set_sizes_equal = (time_set_size == hash_set_size);
-  DCHECK(set_sizes_equal);
-}
-
-bool RequestInfoSet::CheckTimeScaleMaxRequest(
-    uint32_t app_id,
-    uint32_t app_time_scale,
-    uint32_t max_request_per_time_scale) {
-  LOG4CXX_AUTO_TRACE(logger_);
-  if (max_request_per_time_scale > 0
-      && app_time_scale > 0) {
-    TimevalStruct end = date_time::DateTime::getCurrentTime();
-    TimevalStruct start = {0, 0};
-    start.tv_sec = end.tv_sec - app_time_scale;
-
-    sync_primitives::AutoLock lock(this_lock_);
-    TimeScale scale(start, end, app_id);
-    const uint32_t count = std::count_if(time_sorted_pending_requests_.begin(),
-                                         time_sorted_pending_requests_.end(), scale);
-    if (count >= max_request_per_time_scale) {
-      LOG4CXX_WARN(logger_, "Processing requests count " << count <<
-                   " exceed application limit " << max_request_per_time_scale);
-      return false;
-    }
-    LOG4CXX_DEBUG(logger_, "Requests count " << count);
-  } else {
-    LOG4CXX_DEBUG(logger_, "CheckTimeScaleMaxRequest disabled");
-  }
-  return true;
-}
-
-bool RequestInfoSet::CheckHMILevelTimeScaleMaxRequest(mobile_apis::HMILevel::eType hmi_level,
-    uint32_t app_id,
-    uint32_t app_time_scale,
-    uint32_t max_request_per_time_scale) {
-  LOG4CXX_AUTO_TRACE(logger_);
-  if (max_request_per_time_scale > 0 &&
-      app_time_scale > 0) {
-    TimevalStruct end = date_time::DateTime::getCurrentTime();
-    TimevalStruct start = {0, 0};
-    start.tv_sec = end.tv_sec - app_time_scale;
-
-    sync_primitives::AutoLock lock(this_lock_);
-    HMILevelTimeScale scale(start, end, app_id, hmi_level);
-    const uint32_t count = std::count_if(time_sorted_pending_requests_.begin(),
-                                         time_sorted_pending_requests_.end(), scale);
-    if (count >= max_request_per_time_scale) {
-      LOG4CXX_WARN(logger_, "Processing requests count " << count
-                   << " exceed application limit " << max_request_per_time_scale
-                   << " in hmi level " << hmi_level);
-      return false;
-    }
-    LOG4CXX_DEBUG(logger_, "Requests count " << count);
-  } else {
-    LOG4CXX_DEBUG(logger_, "CheckHMILevelTimeScaleMaxRequest disabled");
+  const uint32_t hmi_key = RequestInfo::HmiConnectoinKey;
+  uint32_t erased = 0;
+  sync_primitives::AutoLock lock(this_lock_);
+  if (hmi_key > 0) {
+    erased += RemoveAppsRange(0, hmi_key - 1);
   }
-  return true;
-}
-
-bool RequestInfoSet::AppIdCompararator::operator()(const RequestInfoPtr value_compare) const {
-  switch (compare_type_) {
-    case Equal:
-      return value_compare->app_id() == app_id_;
-    case NotEqual:
-      return value_compare->app_id() != app_id_;
-    default:
-      return false;
+  if (hmi_key < kMaxId) {
+    erased += RemoveAppsRange(hmi_key + 1, kMaxId);
   }
+  return erased;
 }
 
-bool RequestInfoTimeComparator::operator()(const RequestInfoPtr lhs,
-                                           const RequestInfoPtr rhs) const {
-  date_time::TimeCompare compare_result =
-      date_time::DateTime::compareTime(lhs->end_time(), rhs->end_time());
-  if (compare_result == date_time::LESS) {
-    return true;
-  } else if (compare_result == date_time::GREATER) {
-    return false;
-  }
-  // compare_result == date_time::EQUAL
-  // If time is equal, sort by hash
-  LOG4CXX_DEBUG(logger_, "EQUAL " << lhs->end_time().tv_sec << ":" << lhs->end_time().tv_usec
-                << " and " << rhs->end_time().tv_sec << ":" << rhs->end_time().tv_usec
-                << "; compare hash: " << lhs->hash() << " < " << rhs->hash()
-                << " = " << (lhs->hash() < rhs->hash()));
-  return lhs->hash() < rhs->hash();
+const size_t RequestInfoSet::Size() {
+  sync_primitives::AutoLock lock(this_lock_);
+  return hash_sorted_pending_requests_.size();
 }
 
-bool RequestInfoHashComparator::operator()(const RequestInfoPtr lhs,
-                                           const RequestInfoPtr rhs) const {
-  return lhs->hash() < rhs->hash();
+bool RequestInfoSet::DeadlineComparator::operator()(
+    const Deadline& lhs, const Deadline& rhs) const {
+  // std heap keeps greatest element on top, so later deadline is less
+  return rhs.end_time < lhs.end_time;
 }
 
 }  // namespace request_controller
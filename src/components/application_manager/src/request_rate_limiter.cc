@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/request_rate_limiter.h"
+
+#include <algorithm>
+
+#include "utils/date_time.h"
+#include "utils/logger.h"
+
+namespace application_manager {
+
+namespace request_controller {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "RequestController")
+
+namespace {
+int64_t RequestCost(uint32_t time_scale) {
+  return static_cast<int64_t>(time_scale) *
+         date_time::DateTime::MICROSECONDS_IN_SECOND;
+}
+}  // namespace
+
+RequestRateLimiter::RequestRateLimiter() {
+}
+
+RequestRateLimiter::Result RequestRateLimiter::TakeToken(
+    uint32_t app_id, mobile_apis::HMILevel::eType hmi_level, int64_t now_us,
+    uint32_t time_scale, uint32_t max_requests,
+    uint32_t none_time_scale, uint32_t none_max_requests) {
+  const bool check_all = time_scale > 0 && max_requests > 0;
+  const bool check_none = mobile_apis::HMILevel::HMI_NONE == hmi_level &&
+                          none_time_scale > 0 && none_max_requests > 0;
+  if (!check_all && !check_none) {
+    return ALLOWED;
+  }
+
+  sync_primitives::AutoLock lock(lock_);
+  AppBuckets& buckets = buckets_[app_id];
+  if (check_none && !Refill(&buckets.hmi_none, now_us,
+                            none_time_scale, none_max_requests)) {
+    LOG4CXX_WARN(logger_, "Application " << app_id << " exceeded limit "
+                 << none_max_requests << " of requests per " << none_time_scale
+                 << " s in hmi level NONE");
+    return NONE_HMI_LEVEL_MANY_REQUESTS;
+  }
+  if (check_all && !Refill(&buckets.all, now_us, time_scale, max_requests)) {
+    LOG4CXX_WARN(logger_, "Application " << app_id << " exceeded limit "
+                 << max_requests << " of requests per " << time_scale << " s");
+    return TOO_MANY_REQUESTS;
+  }
+  if (check_none) {
+    Take(&buckets.hmi_none, none_time_scale);
+  }
+  if (check_all) {
+    Take(&buckets.all, time_scale);
+  }
+  return ALLOWED;
+}
+
+void RequestRateLimiter::RemoveApplication(uint32_t app_id) {
+  sync_primitives::AutoLock lock(lock_);
+  buckets_.erase(app_id);
+}
+
+bool RequestRateLimiter::Refill(Bucket* bucket, int64_t now_us,
+                                uint32_t time_scale, uint32_t max_requests) {
+  const int64_t cost = RequestCost(time_scale);
+  const int64_t capacity = cost * max_requests;
+  if (bucket->credit < 0) {
+    bucket->credit = capacity;
+  } else if (now_us > bucket->last_refill_us) {
+    const int64_t elapsed_us = now_us - bucket->last_refill_us;
+    // Bucket is full again after time scale, so larger time adds nothing
+    bucket->credit = elapsed_us >= cost ? capacity :
+        std::min(capacity, bucket->credit + elapsed_us * max_requests);
+  }
+  // Limits might be lowered by reload of profile
+  bucket->credit = std::min(capacity, bucket->credit);
+  bucket->last_refill_us = now_us;
+  return bucket->credit >= cost;
+}
+
+void RequestRateLimiter::Take(Bucket* bucket, uint32_t time_scale) {
+  bucket->credit -= RequestCost(time_scale);
+}
+
+}  // namespace request_controller
+
+}  // namespace application_manager
@@ -62,13 +62,50 @@ ResumeCtrl::ResumeCtrl(ApplicationManagerImpl* app_mngr)
                                 this, &ResumeCtrl::SaveDataOnTimer, true),
     restore_hmi_level_timer_("RsmCtrlRstore",
                              this, &ResumeCtrl::ApplicationResumptiOnTimer),
+    is_all_apps_dirty_(false),
     is_resumption_active_(false),
     is_data_saved(true),
-    launch_time_(time(NULL)) {
-  LoadResumeData();
+    launch_time_(time(NULL)),
+    loader_thread_(NULL),
+    is_loader_started_(false) {
+  loader_thread_ = threads::CreateThread("RsmCtrlLoader",
+                                         new ResumeDataLoader(this));
+  loader_thread_->start();
+  {
+    sync_primitives::AutoLock lock(loader_lock_);
+    while (!is_loader_started_) {
+      loader_started_.Wait(lock);
+    }
+  }
   save_persistent_data_timer_.start(profile::Profile::instance()->app_resumption_save_persistent_data_timeout());
 }
 
+ResumeCtrl::~ResumeCtrl() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  loader_thread_->join();
+  delete loader_thread_->delegate();
+  threads::DeleteThread(loader_thread_);
+}
+
+ResumeCtrl::ResumeDataLoader::ResumeDataLoader(ResumeCtrl* resume_ctrl)
+  : resume_ctrl_(resume_ctrl) {
+}
+
+void ResumeCtrl::ResumeDataLoader::threadMain() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  DCHECK(resume_ctrl_);
+  {
+    sync_primitives::AutoLock lock(resume_ctrl_->resumtion_lock_);
+    {
+      sync_primitives::AutoLock started_lock(resume_ctrl_->loader_lock_);
+      resume_ctrl_->is_loader_started_ = true;
+      resume_ctrl_->loader_started_.NotifyOne();
+    }
+    resume_ctrl_->LoadResumeData();
+  }
+  resume_ctrl_->PersistResumptionData();
+}
+
 void ResumeCtrl::SaveAllApplications() {
   LOG4CXX_AUTO_TRACE(logger_);
     std::set<ApplicationSharedPtr> apps(retrieve_application());
@@ -119,12 +156,42 @@ void ResumeCtrl::SaveApplication(ApplicationSharedPtr application) {
   json_app[strings::ign_off_count] = 0;
   json_app[strings::suspend_count] = 0;
   json_app[strings::hash_id] = hash;
-  json_app[strings::application_commands] =
-    GetApplicationCommands(application);
-  json_app[strings::application_submenus] =
-    GetApplicationSubMenus(application);
-  json_app[strings::application_choise_sets] =
-    GetApplicationInteractionChoiseSets(application);
+  // Versions are taken before maps are read, so change made meanwhile
+  // makes map be written again next time
+  SavedDataVersions versions(application->app_id());
+  versions.commands = application->commands_version();
+  versions.sub_menu = application->sub_menu_version();
+  versions.choice_set = application->choice_set_version();
+  versions.hash = hash;
+  versions.hmi_level = hmi_level;
+  dirty_apps_.insert(m_app_id);
+  SavedDataVersionsMap::iterator saved_it =
+      saved_data_versions_.find(m_app_id);
+  const bool is_saved_by_app = saved_data_versions_.end() != saved_it &&
+      saved_it->second.app_id == versions.app_id;
+  if (!is_saved_by_app ||
+      saved_it->second.commands != versions.commands ||
+      !json_app.isMember(strings::application_commands)) {
+    json_app[strings::application_commands] =
+      GetApplicationCommands(application);
+  }
+  if (!is_saved_by_app ||
+      saved_it->second.sub_menu != versions.sub_menu ||
+      !json_app.isMember(strings::application_submenus)) {
+    json_app[strings::application_submenus] =
+      GetApplicationSubMenus(application);
+  }
+  if (!is_saved_by_app ||
+      saved_it->second.choice_set != versions.choice_set ||
+      !json_app.isMember(strings::application_choise_sets)) {
+    json_app[strings::application_choise_sets] =
+      GetApplicationInteractionChoiseSets(application);
+  }
+  if (saved_data_versions_.end() != saved_it) {
+    saved_it->second = versions;
+  } else {
+    saved_data_versions_.insert(std::make_pair(m_app_id, versions));
+  }
   json_app[strings::application_global_properties] =
     GetApplicationGlobalProperties(application);
   json_app[strings::application_subscribtions] =
@@ -271,14 +338,19 @@ bool ResumeCtrl::RestoreApplicationData(ApplicationSharedPtr application) {
 
   LOG4CXX_DEBUG(logger_, "ENTER app_id : " << application->app_id());
 
-  sync_primitives::AutoLock lock(resumtion_lock_);
-  const int idx = GetObjectIndex(application->mobile_app_id());
-  if (-1 == idx) {
-    LOG4CXX_WARN(logger_, "Application not saved");
-    return false;
+  Json::Value saved_app;
+  {
+    sync_primitives::AutoLock lock(resumtion_lock_);
+    const int idx = GetObjectIndex(application->mobile_app_id());
+    if (-1 == idx) {
+      LOG4CXX_WARN(logger_, "Application not saved");
+      return false;
+    }
+    // Data is restored from copy without resumtion_lock_,
+    // so several applications can be restored at once
+    saved_app = GetSavedApplications()[idx];
   }
 
-  const Json::Value& saved_app = GetSavedApplications()[idx];
   if(saved_app.isMember(strings::grammar_id)) {
     const uint32_t app_grammar_id = saved_app[strings::grammar_id].asUInt();
     application->set_grammar_id(app_grammar_id);
@@ -380,11 +452,13 @@ bool ResumeCtrl::RemoveApplicationFromSaved(const std::string& mobile_app_id) {
     return result;
   }
 
+  saved_data_versions_.erase(mobile_app_id);
   GetSavedApplications().clear();
   for (std::vector<Json::Value>::iterator it = temp.begin();
       it != temp.end(); ++it) {
     GetSavedApplications().append((*it));
   }
+  UpdateSavedAppIndexes();
   LOG4CXX_TRACE(logger_, "EXIT result: " << (result ? "true" : "false"));
   return result;
 }
@@ -392,34 +466,42 @@ bool ResumeCtrl::RemoveApplicationFromSaved(const std::string& mobile_app_id) {
 void ResumeCtrl::Suspend() {
   LOG4CXX_AUTO_TRACE(logger_);
   StopSavePersistentDataTimer();
-  SaveAllApplications();
+  // Applications are saved on change by timer and on unregistration,
+  // only ones changed since then are serialized again
+  if (is_data_saved) {
+    SaveChangedApplications();
+  } else {
+    SaveAllApplications();
+  }
   Json::Value to_save;
-  sync_primitives::AutoLock lock(resumtion_lock_);
-  for (Json::Value::iterator it = GetSavedApplications().begin();
-      it != GetSavedApplications().end(); ++it) {
-    if ((*it).isMember(strings::suspend_count)) {
-      const uint32_t suspend_count = (*it)[strings::suspend_count].asUInt();
-      (*it)[strings::suspend_count] = suspend_count + 1;
-    } else {
-      LOG4CXX_WARN(logger_, "Unknown key among saved applications");
-      (*it)[strings::suspend_count] = 1;
-    }
-    if ((*it).isMember(strings::ign_off_count)) {
-      const uint32_t ign_off_count = (*it)[strings::ign_off_count].asUInt();
-      if (ign_off_count < kApplicationLifes) {
-        (*it)[strings::ign_off_count] = ign_off_count + 1;
-        to_save.append(*it);
+  {
+    sync_primitives::AutoLock lock(resumtion_lock_);
+    for (Json::Value::iterator it = GetSavedApplications().begin();
+        it != GetSavedApplications().end(); ++it) {
+      if ((*it).isMember(strings::suspend_count)) {
+        const uint32_t suspend_count = (*it)[strings::suspend_count].asUInt();
+        (*it)[strings::suspend_count] = suspend_count + 1;
+      } else {
+        LOG4CXX_WARN(logger_, "Unknown key among saved applications");
+        (*it)[strings::suspend_count] = 1;
+      }
+      if ((*it).isMember(strings::ign_off_count)) {
+        const uint32_t ign_off_count = (*it)[strings::ign_off_count].asUInt();
+        if (ign_off_count < kApplicationLifes) {
+          (*it)[strings::ign_off_count] = ign_off_count + 1;
+          to_save.append(*it);
+        }
+      } else {
+        LOG4CXX_WARN(logger_, "Unknown key among saved applications");
+        (*it)[strings::ign_off_count] = 1;
       }
-    } else {
-      LOG4CXX_WARN(logger_, "Unknown key among saved applications");
-      (*it)[strings::ign_off_count] = 1;
     }
+    SetSavedApplication(to_save);
+    SetLastIgnOffTime(time(NULL));
+    LOG4CXX_DEBUG(logger_,
+                  GetResumptionData().toStyledString());
   }
-  SetSavedApplication(to_save);
-  SetLastIgnOffTime(time(NULL));
-  LOG4CXX_DEBUG(logger_,
-                GetResumptionData().toStyledString());
-  resumption::LastState::instance()->SaveToFileSystem();
+  PersistResumptionData();
 }
 
 void ResumeCtrl::OnAwake() {
@@ -436,6 +518,7 @@ void ResumeCtrl::OnAwake() {
       (*it)[strings::ign_off_count] = 0;
     }
   }
+  is_all_apps_dirty_ = true;
   ResetLaunchTime();
   StartSavePersistentDataTimer();
 }
@@ -473,36 +556,39 @@ bool ResumeCtrl::StartResumption(ApplicationSharedPtr application,
                         << " mobile_id = " << application->mobile_app_id()
                         << "received hash = " << hash);
 
-  sync_primitives::AutoLock lock(resumtion_lock_);
-  const int idx = GetObjectIndex(application->mobile_app_id());
-  if (-1 == idx) {
-    LOG4CXX_WARN(logger_, "Application not saved");
-    return false;
-  }
-
-  const Json::Value& json_app = GetSavedApplications()[idx];
-  LOG4CXX_DEBUG(logger_, "Saved_application_data: " << json_app.toStyledString());
-  if (json_app.isMember(strings::hash_id) && json_app.isMember(strings::time_stamp)) {
-    const std::string& saved_hash = json_app[strings::hash_id].asString();
-
-    if (saved_hash == hash) {
-      RestoreApplicationData(application);
+  bool is_hash_equal = false;
+  {
+    sync_primitives::AutoLock lock(resumtion_lock_);
+    const int idx = GetObjectIndex(application->mobile_app_id());
+    if (-1 == idx) {
+      LOG4CXX_WARN(logger_, "Application not saved");
+      return false;
     }
-    application->UpdateHash();
-
-    queue_lock_.Acquire();
-    waiting_for_timer_.push_back(application->app_id());
-    queue_lock_.Release();
-    if (!is_resumption_active_) {
-      is_resumption_active_ = true;
-      restore_hmi_level_timer_.start(
-          profile::Profile::instance()->app_resuming_timeout());
+
+    const Json::Value& json_app = GetSavedApplications()[idx];
+    LOG4CXX_DEBUG(logger_, "Saved_application_data: " << json_app.toStyledString());
+    if (!json_app.isMember(strings::hash_id) ||
+        !json_app.isMember(strings::time_stamp)) {
+      LOG4CXX_INFO(logger_, "There are some unknown keys in the dictionary.");
+      return false;
     }
-  } else {
-    LOG4CXX_INFO(logger_, "There are some unknown keys in the dictionary.");
-    return false;
+    is_hash_equal = json_app[strings::hash_id].asString() == hash;
   }
 
+  if (is_hash_equal) {
+    RestoreApplicationData(application);
+  }
+  application->UpdateHash();
+
+  queue_lock_.Acquire();
+  waiting_for_timer_.push_back(application->app_id());
+  queue_lock_.Release();
+  sync_primitives::AutoLock lock(resumtion_lock_);
+  if (!is_resumption_active_) {
+    is_resumption_active_ = true;
+    restore_hmi_level_timer_.start(
+        profile::Profile::instance()->app_resuming_timeout());
+  }
   return true;
 }
 
@@ -659,10 +745,17 @@ void ResumeCtrl::SaveDataOnTimer() {
     return;
   }
 
-  if (false == is_data_saved) {
-    SaveAllApplications();
+  bool is_dirty = false;
+  {
+    // E.g. application saved on unregistration
+    sync_primitives::AutoLock lock(resumtion_lock_);
+    is_dirty = is_all_apps_dirty_ || !dirty_apps_.empty();
+  }
+  if (false == is_data_saved || is_dirty) {
+    // Data updated while saving is saved by next timer shot
     is_data_saved = true;
-    resumption::LastState::instance()->SaveToFileSystem();
+    SaveChangedApplications();
+    PersistResumptionData();
   }
 }
 
@@ -675,6 +768,8 @@ bool ResumeCtrl::IsDeviceMacAddressEqual(ApplicationSharedPtr application,
 
 Json::Value&ResumeCtrl::GetResumptionData() {
   LOG4CXX_AUTO_TRACE(logger_);
+  // Waits for ResumeDataLoader
+  sync_primitives::AutoLock lock(resumtion_lock_);
   Json::Value& last_state = resumption::LastState::instance()->dictionary;
   if (!last_state.isMember(strings::resumption)) {
     last_state[strings::resumption] = Json::Value(Json::objectValue);
@@ -690,17 +785,12 @@ Json::Value&ResumeCtrl::GetResumptionData() {
 
 Json::Value& ResumeCtrl::GetSavedApplications() {
   LOG4CXX_AUTO_TRACE(logger_);
-  Json::Value& resumption = GetResumptionData();
-  if (!resumption.isMember(strings::resume_app_list)) {
-    resumption[strings::resume_app_list] = Json::Value(Json::arrayValue);
-    LOG4CXX_WARN(logger_, "app_list section is missed");
-  }
-  Json::Value& resume_app_list = resumption[strings::resume_app_list];
-  if (!resume_app_list.isArray()) {
-    LOG4CXX_ERROR(logger_, "resume_app_list type INVALID rewrite");
-    resume_app_list =  Json::Value(Json::arrayValue);
+  // Waits for ResumeDataLoader
+  sync_primitives::AutoLock lock(resumtion_lock_);
+  if (!saved_applications_.isArray()) {
+    saved_applications_ = Json::Value(Json::arrayValue);
   }
-  return resume_app_list;
+  return saved_applications_;
 }
 
 time_t ResumeCtrl::GetIgnOffTime() {
@@ -724,16 +814,31 @@ void ResumeCtrl::SetLastIgnOffTime(time_t ign_off_time) {
 
 
 void ResumeCtrl::SetSavedApplication(Json::Value& apps_json) {
+  sync_primitives::AutoLock lock(resumtion_lock_);
   Json::Value& app_list = GetSavedApplications();
   app_list = apps_json;
+  UpdateSavedAppIndexes();
+  is_all_apps_dirty_ = true;
+  SavedDataVersionsMap::iterator it = saved_data_versions_.begin();
+  while (saved_data_versions_.end() != it) {
+    if (saved_app_indexes_.end() == saved_app_indexes_.find(it->first)) {
+      saved_data_versions_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
 }
 
 void ResumeCtrl::ClearResumptionInfo() {
   LOG4CXX_AUTO_TRACE(logger_);
   Json::Value empty_json;
 
-  SetSavedApplication(empty_json);
-  resumption::LastState::instance()->SaveToFileSystem();
+  {
+    sync_primitives::AutoLock lock(resumtion_lock_);
+    saved_data_versions_.clear();
+    SetSavedApplication(empty_json);
+  }
+  PersistResumptionData();
 }
 
 Json::Value ResumeCtrl::GetApplicationCommands(
@@ -1049,7 +1154,9 @@ void ResumeCtrl::ProcessHMIRequests(const smart_objects::SmartObjectList& reques
   for (smart_objects::SmartObjectList::const_iterator it = requests.begin(),
        total = requests.end();
        it != total; ++it) {
-    ProcessHMIRequest(*it, true);
+    // Responses to restoring requests are not awaited, so requests of
+    // all restored data go to HMI one after another
+    ProcessHMIRequest(*it, false);
   }
 }
 
@@ -1080,13 +1187,12 @@ bool ResumeCtrl::CheckIcons(ApplicationSharedPtr application,
 
 Json::Value& ResumeCtrl::GetFromSavedOrAppend(const std::string& mobile_app_id) {
   LOG4CXX_AUTO_TRACE(logger_);
-  for (Json::Value::iterator it = GetSavedApplications().begin();
-      it != GetSavedApplications().end(); ++it) {
-    if (mobile_app_id == (*it)[strings::app_id].asString()) {
-      return *it;
-    }
+  const int idx = GetObjectIndex(mobile_app_id);
+  if (-1 != idx) {
+    return GetSavedApplications()[idx];
   }
 
+  saved_app_indexes_[mobile_app_id] = GetSavedApplications().size();
   return GetSavedApplications().append(Json::Value());
 }
 
@@ -1174,17 +1280,98 @@ int ResumeCtrl::GetObjectIndex(const std::string& mobile_app_id) {
   LOG4CXX_AUTO_TRACE(logger_);
 
   sync_primitives::AutoLock lock(resumtion_lock_);
+  std::map<std::string, Json::ArrayIndex>::const_iterator it =
+      saved_app_indexes_.find(mobile_app_id);
+  if (saved_app_indexes_.end() == it) {
+    return -1;
+  }
+  LOG4CXX_DEBUG(logger_, "Found " << it->second);
+  return it->second;
+}
+
+void ResumeCtrl::UpdateSavedAppIndexes() {
+  sync_primitives::AutoLock lock(resumtion_lock_);
+  saved_app_indexes_.clear();
   const Json::Value& apps = GetSavedApplications();
   const Json::ArrayIndex size = apps.size();
-  Json::ArrayIndex idx = 0;
-  for (; idx != size; ++idx) {
-    const std::string& saved_app_id = apps[idx][strings::app_id].asString();
-    if (mobile_app_id == saved_app_id) {
-      LOG4CXX_DEBUG(logger_, "Found " << idx);
-      return idx;
+  for (Json::ArrayIndex idx = 0; idx != size; ++idx) {
+    // First record wins as it was found by scan before
+    saved_app_indexes_.insert(
+        std::make_pair(apps[idx][strings::app_id].asString(), idx));
+  }
+}
+
+void ResumeCtrl::SaveChangedApplications() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  std::set<ApplicationSharedPtr> apps(retrieve_application());
+  for (std::set<ApplicationSharedPtr>::const_iterator it = apps.begin();
+      it != apps.end(); ++it) {
+    const ApplicationSharedPtr application = *it;
+    bool is_changed = true;
+    {
+      sync_primitives::AutoLock lock(resumtion_lock_);
+      SavedDataVersionsMap::const_iterator saved_it =
+          saved_data_versions_.find(application->mobile_app_id());
+      if (saved_data_versions_.end() != saved_it) {
+        const SavedDataVersions& saved = saved_it->second;
+        is_changed = saved.app_id != application->app_id() ||
+            saved.hash != application->curHash() ||
+            saved.hmi_level != application->hmi_level();
+      }
+    }
+    if (is_changed) {
+      SaveApplication(application);
     }
   }
-  return -1;
+}
+
+void ResumeCtrl::PersistResumptionData() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  typedef resumption::ApplicationStorage::ApplicationKey ApplicationKey;
+  typedef resumption::ApplicationStorage::ApplicationRecords Records;
+  sync_primitives::AutoLock persist_lock(persist_lock_);
+
+  std::set<ApplicationKey> saved;
+  Records changed;
+  {
+    sync_primitives::AutoLock lock(resumtion_lock_);
+    const Json::Value& apps = GetSavedApplications();
+    const Json::ArrayIndex size = apps.size();
+    for (Json::ArrayIndex idx = 0; idx != size; ++idx) {
+      const Json::Value& app = apps[idx];
+      const std::string app_id = app[strings::app_id].asString();
+      const ApplicationKey key(app[strings::device_mac].asString(), app_id);
+      saved.insert(key);
+      if (is_all_apps_dirty_ || dirty_apps_.end() != dirty_apps_.find(app_id)) {
+        changed.push_back(std::make_pair(key, app));
+      }
+    }
+    dirty_apps_.clear();
+    is_all_apps_dirty_ = false;
+  }
+
+  resumption::ApplicationStorage& storage =
+      resumption::LastState::instance()->applications();
+  // All changed records share one sync, e.g. on suspend every record is
+  // changed by ignition counters
+  if (!storage.Save(changed)) {
+    LOG4CXX_ERROR(logger_, "Failed to save " << changed.size()
+                  << " application records");
+    sync_primitives::AutoLock lock(resumtion_lock_);
+    for (Records::const_iterator i = changed.begin(); i != changed.end(); ++i) {
+      dirty_apps_.insert(i->first.second);
+    }
+  }
+
+  resumption::ApplicationStorage::ApplicationKeys stored;
+  storage.Keys(&stored);
+  for (resumption::ApplicationStorage::ApplicationKeys::const_iterator i =
+      stored.begin(); i != stored.end(); ++i) {
+    if (saved.end() == saved.find(*i)) {
+      storage.Remove(i->first, i->second);
+    }
+  }
+  resumption::LastState::instance()->SaveToFileSystem();
 }
 time_t ResumeCtrl::launch_time() const {
   return launch_time_;
@@ -1220,6 +1407,35 @@ void ResumeCtrl::LoadResumeData() {
   sync_primitives::AutoLock lock(resumtion_lock_);
 
   Json::Value& resume_app_list = GetSavedApplications();
+  resumption::ApplicationStorage& storage =
+      resumption::LastState::instance()->applications();
+  resumption::ApplicationStorage::ApplicationKeys keys;
+  storage.Keys(&keys);
+  for (resumption::ApplicationStorage::ApplicationKeys::const_iterator i =
+      keys.begin(); i != keys.end(); ++i) {
+    Json::Value json_app;
+    if (storage.Get(i->first, i->second, &json_app)) {
+      resume_app_list.append(json_app);
+    }
+  }
+  UpdateSavedAppIndexes();
+
+  // Applications saved into LastState dictionary by previous versions
+  Json::Value& resumption = GetResumptionData();
+  if (resumption.isMember(strings::resume_app_list)) {
+    const Json::Value old_app_list =
+        resumption.removeMember(strings::resume_app_list);
+    for (Json::ArrayIndex idx = 0; old_app_list.isArray() &&
+        idx != old_app_list.size(); ++idx) {
+      const Json::Value& json_app = old_app_list[idx];
+      if (-1 == GetObjectIndex(json_app[strings::app_id].asString())) {
+        resume_app_list.append(json_app);
+      }
+    }
+    UpdateSavedAppIndexes();
+  }
+  is_all_apps_dirty_ = true;
+
   Json::Value::iterator full_app = resume_app_list.end();
   time_t time_stamp_full = 0;
   Json::Value::iterator limited_app = resume_app_list.end();
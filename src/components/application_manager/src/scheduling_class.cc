@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/scheduling_class.h"
+
+namespace application_manager {
+
+SchedulingClass GetSchedulingClass(mobile_apis::HMILevel::eType hmi_level,
+                                   bool is_navi_or_media,
+                                   const std::string& policy_priority) {
+  using namespace mobile_apis::HMILevel;
+  if (HMI_NONE != hmi_level && "EMERGENCY" == policy_priority) {
+    return kSchedulingUrgent;
+  }
+  // Applications guiding or talking to driver keep being served
+  // while they are not in foreground
+  const bool is_prioritized = is_navi_or_media ||
+                              "NAVIGATION" == policy_priority ||
+                              "VOICECOM" == policy_priority ||
+                              "COMMUNICATION" == policy_priority;
+  switch (hmi_level) {
+    case HMI_FULL:
+      return kSchedulingForeground;
+    case HMI_LIMITED:
+      return kSchedulingLimited;
+    case HMI_BACKGROUND:
+      return is_prioritized ? kSchedulingLimited : kSchedulingBackground;
+    default:
+      return kSchedulingBackground;
+  }
+}
+
+}  // namespace application_manager
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/vehicle_data_cache.h"
+
+#include <set>
+
+#include "application_manager/message_helper.h"
+#include "config_profile/profile.h"
+
+namespace application_manager {
+
+namespace {
+const char* kVehicleDataCacheSection = "VehicleDataCache";
+}  // namespace
+
+VehicleDataCache::VehicleDataCache(const TimeToLiveMap& time_to_live)
+    : time_to_live_(time_to_live),
+      entries_lock_(),
+      entries_() {
+}
+
+VehicleDataCache::TimeToLiveMap VehicleDataCache::TimeToLiveFromProfile() {
+  TimeToLiveMap time_to_live;
+  const VehicleData& vehicle_data = MessageHelper::vehicle_data();
+  for (VehicleData::const_iterator it = vehicle_data.begin();
+       vehicle_data.end() != it; ++it) {
+    int32_t value = 0;
+    if (profile::Profile::instance()->ReadIntValue(
+            &value, 0, kVehicleDataCacheSection, it->first.c_str()) &&
+        value > 0) {
+      time_to_live[it->first] = static_cast<uint32_t>(value);
+    }
+  }
+  return time_to_live;
+}
+
+void VehicleDataCache::Update(const smart_objects::SmartObject& data,
+                              int64_t now_ms) {
+  if (!enabled() || smart_objects::SmartType_Map != data.getType()) {
+    return;
+  }
+  const std::set<std::string> keys = data.enumerate();
+  sync_primitives::AutoLock lock(entries_lock_);
+  for (std::set<std::string>::const_iterator it = keys.begin();
+       keys.end() != it; ++it) {
+    if (time_to_live_.end() == time_to_live_.find(*it)) {
+      continue;
+    }
+    Entry& entry = entries_[*it];
+    entry.value = data.getElement(*it);
+    entry.updated_ms = now_ms;
+  }
+}
+
+bool VehicleDataCache::Get(const smart_objects::SmartObject& request,
+                           int64_t now_ms,
+                           smart_objects::SmartObject* data) const {
+  DCHECK_OR_RETURN(data, false);
+  if (!enabled() || 0 == request.length()) {
+    return false;
+  }
+  const std::set<std::string> keys = request.enumerate();
+  sync_primitives::AutoLock lock(entries_lock_);
+  for (std::set<std::string>::const_iterator it = keys.begin();
+       keys.end() != it; ++it) {
+    const TimeToLiveMap::const_iterator ttl = time_to_live_.find(*it);
+    const EntryMap::const_iterator entry = entries_.find(*it);
+    if (time_to_live_.end() == ttl || entries_.end() == entry ||
+        now_ms - entry->second.updated_ms > ttl->second) {
+      return false;
+    }
+    (*data)[*it] = entry->second.value;
+  }
+  return true;
+}
+
+void VehicleDataCache::Clear() {
+  sync_primitives::AutoLock lock(entries_lock_);
+  entries_.clear();
+}
+
+}  // namespace application_manager
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "application_manager/event_engine/event.h"
+#include "application_manager/event_engine/event_observer.h"
+#include "application_manager/event_engine/event_dispatcher.h"
+
+namespace test {
+namespace components {
+namespace application_manager_test {
+
+using ::application_manager::event_engine::Event;
+using ::application_manager::event_engine::EventObserver;
+using ::application_manager::event_engine::EventDispatcher;
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+namespace strings = ::application_manager::strings;
+
+namespace {
+const Event::EventID kEventId = hmi_apis::FunctionID::UI_Alert;
+const Event::EventID kOtherEventId = hmi_apis::FunctionID::UI_Show;
+const int32_t kCorrelationId = 5;
+
+class TestObserver : public EventObserver {
+ public:
+  TestObserver()
+      : calls_count_(0),
+        to_remove_(NULL) {
+  }
+  void on_event(const Event& event) {
+    ++calls_count_;
+    if (to_remove_) {
+      EventDispatcher::instance()->remove_observer(to_remove_);
+    }
+  }
+  void Subscribe(const Event::EventID& event_id, int32_t correlation_id = 0) {
+    subscribe_on_event(event_id, correlation_id);
+  }
+  int32_t SubscribeShared(int32_t correlation_id,
+                          const smart_objects::SmartObject& params,
+                          uint32_t max_age_ms = 10000) {
+    return subscribe_on_shared_event(kEventId, correlation_id, params,
+                                     max_age_ms);
+  }
+  void Unsubscribe(const Event::EventID& event_id) {
+    unsubscribe_from_event(event_id);
+  }
+  // Observer to be unsubscribed on event, may be this one
+  void set_to_remove(EventObserver* observer) {
+    to_remove_ = observer;
+  }
+  size_t calls_count() const {
+    return calls_count_;
+  }
+
+ private:
+  size_t calls_count_;
+  EventObserver* to_remove_;
+};
+
+void Raise(const Event::EventID& event_id,
+           hmi_apis::messageType::eType message_type,
+           int32_t correlation_id = 0) {
+  smart_objects::SmartObject message(smart_objects::SmartType_Map);
+  message[strings::params][strings::message_type] = message_type;
+  message[strings::params][strings::correlation_id] = correlation_id;
+  Event event(event_id);
+  event.set_smart_object(message);
+  event.raise();
+}
+}  // namespace
+
+TEST(EventDispatcherTest, Response_ExpectObserverCalledOnce) {
+  TestObserver observer;
+  observer.Subscribe(kEventId, kCorrelationId);
+  Raise(kEventId, hmi_apis::messageType::response, kCorrelationId + 1);
+  Raise(kOtherEventId, hmi_apis::messageType::response, kCorrelationId);
+  EXPECT_EQ(0u, observer.calls_count());
+
+  Raise(kEventId, hmi_apis::messageType::response, kCorrelationId);
+  EXPECT_EQ(1u, observer.calls_count());
+  Raise(kEventId, hmi_apis::messageType::error_response, kCorrelationId);
+  EXPECT_EQ(1u, observer.calls_count());
+}
+
+TEST(EventDispatcherTest, Notification_ExpectObserverCalledEveryTime) {
+  TestObserver observer;
+  observer.Subscribe(kEventId);
+  Raise(kEventId, hmi_apis::messageType::notification);
+  Raise(kEventId, hmi_apis::messageType::notification);
+  Raise(kOtherEventId, hmi_apis::messageType::notification);
+  EXPECT_EQ(2u, observer.calls_count());
+
+  observer.Unsubscribe(kEventId);
+  Raise(kEventId, hmi_apis::messageType::notification);
+  EXPECT_EQ(2u, observer.calls_count());
+}
+
+TEST(EventDispatcherTest, ObserverRemoved_ExpectNotCalled) {
+  TestObserver* observer = new TestObserver();
+  observer->Subscribe(kEventId);
+  observer->Subscribe(kEventId, kCorrelationId);
+  // Destruction unsubscribes from all events
+  delete observer;
+  Raise(kEventId, hmi_apis::messageType::notification);
+  Raise(kEventId, hmi_apis::messageType::response, kCorrelationId);
+}
+
+TEST(EventDispatcherTest, ObserverRemovedDuringDelivery_ExpectNotCalled) {
+  TestObserver first;
+  TestObserver second;
+  first.Subscribe(kEventId);
+  second.Subscribe(kEventId);
+  first.set_to_remove(&second);
+  Raise(kEventId, hmi_apis::messageType::notification);
+  EXPECT_EQ(1u, first.calls_count());
+  EXPECT_EQ(0u, second.calls_count());
+  first.set_to_remove(NULL);
+  first.Unsubscribe(kEventId);
+}
+
+TEST(EventDispatcherTest, ObserverRemovesItself_ExpectCalledOnce) {
+  TestObserver observer;
+  observer.Subscribe(kEventId);
+  observer.set_to_remove(&observer);
+  Raise(kEventId, hmi_apis::messageType::notification);
+  Raise(kEventId, hmi_apis::messageType::notification);
+  EXPECT_EQ(1u, observer.calls_count());
+}
+
+TEST(EventDispatcherTest, EqualSharedRequests_ExpectResponseFannedOut) {
+  smart_objects::SmartObject params(smart_objects::SmartType_Map);
+  params["speed"] = true;
+  TestObserver first;
+  TestObserver second;
+  EXPECT_EQ(kCorrelationId, first.SubscribeShared(kCorrelationId, params));
+  EXPECT_EQ(kCorrelationId,
+            second.SubscribeShared(kCorrelationId + 1, params));
+
+  Raise(kEventId, hmi_apis::messageType::response, kCorrelationId);
+  EXPECT_EQ(1u, first.calls_count());
+  EXPECT_EQ(1u, second.calls_count());
+
+  // Answered request is not joined anymore
+  TestObserver third;
+  EXPECT_EQ(kCorrelationId + 2,
+            third.SubscribeShared(kCorrelationId + 2, params));
+  Raise(kEventId, hmi_apis::messageType::response, kCorrelationId + 2);
+  EXPECT_EQ(1u, third.calls_count());
+}
+
+TEST(EventDispatcherTest, DifferentSharedRequests_ExpectSentSeparately) {
+  smart_objects::SmartObject params(smart_objects::SmartType_Map);
+  params["speed"] = true;
+  smart_objects::SmartObject other_params(smart_objects::SmartType_Map);
+  other_params["rpm"] = true;
+  TestObserver first;
+  TestObserver second;
+  EXPECT_EQ(kCorrelationId, first.SubscribeShared(kCorrelationId, params));
+  EXPECT_EQ(kCorrelationId + 1,
+            second.SubscribeShared(kCorrelationId + 1, other_params));
+
+  Raise(kEventId, hmi_apis::messageType::response, kCorrelationId);
+  EXPECT_EQ(1u, first.calls_count());
+  EXPECT_EQ(0u, second.calls_count());
+  Raise(kEventId, hmi_apis::messageType::response, kCorrelationId + 1);
+  EXPECT_EQ(1u, second.calls_count());
+}
+
+TEST(EventDispatcherTest, StaleSharedRequest_ExpectNotJoined) {
+  smart_objects::SmartObject params(smart_objects::SmartType_Map);
+  params["speed"] = true;
+  TestObserver first;
+  TestObserver second;
+  EXPECT_EQ(kCorrelationId, first.SubscribeShared(kCorrelationId, params));
+  usleep(2000);
+  EXPECT_EQ(kCorrelationId + 1,
+            second.SubscribeShared(kCorrelationId + 1, params, 1));
+
+  // Late response still reaches observers of stale request
+  Raise(kEventId, hmi_apis::messageType::response, kCorrelationId);
+  EXPECT_EQ(1u, first.calls_count());
+  EXPECT_EQ(0u, second.calls_count());
+}
+
+TEST(EventDispatcherTest, SharedRequestObserversRemoved_ExpectNotJoined) {
+  smart_objects::SmartObject params(smart_objects::SmartType_Map);
+  params["speed"] = true;
+  TestObserver* first = new TestObserver();
+  EXPECT_EQ(kCorrelationId, first->SubscribeShared(kCorrelationId, params));
+  delete first;
+
+  TestObserver second;
+  EXPECT_EQ(kCorrelationId + 1,
+            second.SubscribeShared(kCorrelationId + 1, params));
+  Raise(kEventId, hmi_apis::messageType::response, kCorrelationId + 1);
+  EXPECT_EQ(1u, second.calls_count());
+}
+
+}  // namespace application_manager_test
+}  // namespace components
+}  // namespace test
@@ -33,6 +33,7 @@
 
 #include "gmock/gmock.h"
 #include "application_manager/mobile_message_handler.h"
+#include "smart_objects/smart_object.h"
 
 
 using ::testing::_;
@@ -50,4 +51,17 @@ TEST(mobile_message_test, basic_test) {
   EXPECT_TRUE(message->has_binary_data());
 }
 
+TEST(mobile_message_test, copy_shares_binary_data) {
+  Message message(protocol_handler::MessagePriority::kDefault);
+  message.set_binary_data(new BinaryData(1000, 'X'));
+
+  const Message copy(message);
+  EXPECT_TRUE(copy.has_binary_data());
+  EXPECT_EQ(message.binary_data(), copy.binary_data());
+
+  const NsSmartDeviceLink::NsSmartObjects::SmartObject object(
+      message.shared_binary_data());
+  EXPECT_EQ(message.binary_data(), object.asBinaryPtr());
+}
+
 }
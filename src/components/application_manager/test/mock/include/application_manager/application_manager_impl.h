@@ -45,6 +45,7 @@
 #include "application_manager/message.h"
 #include "application_manager/request_controller.h"
 #include "application_manager/resume_ctrl.h"
+#include "application_manager/vehicle_data_cache.h"
 #include "application_manager/vehicle_info_data.h"
 #include "protocol_handler/protocol_observer.h"
 #include "hmi_message_handler/hmi_message_observer.h"
@@ -194,6 +195,7 @@ class ApplicationManagerImpl : public ApplicationManager,
   MOCK_METHOD1(RegisterApplication,
                 ApplicationSharedPtr(const utils::SharedPtr<smart_objects::SmartObject>&));
   MOCK_METHOD0(hmi_capabilities, HMICapabilities& ());
+  MOCK_METHOD0(vehicle_data_cache, VehicleDataCache& ());
   MOCK_METHOD1(ProcessQueryApp, void (const smart_objects::SmartObject& sm_object));
   MOCK_METHOD1(ManageHMICommand, bool (const utils::SharedPtr<smart_objects::SmartObject>&));
   MOCK_METHOD1(ManageMobileCommand, bool (const utils::SharedPtr<smart_objects::SmartObject>& message));
@@ -201,6 +203,8 @@ class ApplicationManagerImpl : public ApplicationManager,
   MOCK_METHOD2(SendMessageToMobile, bool (const utils::SharedPtr<smart_objects::SmartObject>&,
                                           bool));
   MOCK_METHOD1(SendMessageToMobile, bool (const utils::SharedPtr<smart_objects::SmartObject>&));
+  MOCK_METHOD0(BeginMobileMessageBatch, void());
+  MOCK_METHOD0(EndMobileMessageBatch, void());
   MOCK_METHOD1(GetDeviceName, std::string (connection_handler::DeviceHandle));
   MOCK_METHOD1(application, ApplicationSharedPtr (uint32_t));
   MOCK_METHOD1(application_by_policy_id, ApplicationSharedPtr (const std::string&));
@@ -277,6 +277,12 @@ class PolicyHandler :
 
   virtual void OnCertificateUpdated(const std::string& certificate_data);
 
+  virtual void OnPTUpdated();
+
+  virtual void OnPermissionsChangesStarted();
+
+  virtual void OnPermissionsChangesFinished();
+
   virtual bool CanUpdate();
 
   virtual void OnDeviceConsentChanged(const std::string& device_id,
@@ -3,6 +3,8 @@
 #include "application_manager/request_info.h"
 #include "application_manager/message_helper.h"
 #include <iostream>
+#include <list>
+#include <limits>
 
 namespace request_info = application_manager::request_controller;
 
@@ -224,6 +226,75 @@ TEST_F(RequestInfoTest, RequestInfoSetEqualHashTest) {
   EXPECT_EQ(0u, request_info_set.Size());
 }
 
+TEST_F(RequestInfoTest, RequestInfoSetUpdateTimeoutTest) {
+  for (uint32_t i = 0; i < count_of_requests_for_test_; ++i) {
+    utils::SharedPtr<TestRequestInfo> request =
+        create_test_info(mobile_connection_key1_, i, request_info::RequestInfo::MobileRequest,
+                         date_time::DateTime::getCurrentTime(), i + 1);
+    EXPECT_TRUE(request_info_set_.Add(request));
+  }
+  request_info::RequestInfoPtr front = request_info_set_.FrontWithNotNullTimeout();
+  ASSERT_TRUE(front.valid());
+  EXPECT_EQ(0u, front->requestId());
+
+  // Resetting timeout of earliest request many times moves it to the end
+  for (uint32_t i = 0; i < count_of_requests_for_test_; ++i) {
+    EXPECT_TRUE(request_info_set_.UpdateTimeout(front, 2 * count_of_requests_for_test_));
+  }
+  EXPECT_EQ(count_of_requests_for_test_, request_info_set_.Size());
+  request_info::RequestInfoPtr found = request_info_set_.FrontWithNotNullTimeout();
+  ASSERT_TRUE(found.valid());
+  EXPECT_EQ(1u, found->requestId());
+
+  // Request without timeout is not tracked
+  EXPECT_TRUE(request_info_set_.UpdateTimeout(found, 0));
+  found = request_info_set_.FrontWithNotNullTimeout();
+  ASSERT_TRUE(found.valid());
+  EXPECT_EQ(2u, found->requestId());
+
+  for (uint32_t i = 2; i < count_of_requests_for_test_; ++i) {
+    found = request_info_set_.FrontWithNotNullTimeout();
+    ASSERT_TRUE(found.valid());
+    EXPECT_EQ(i, found->requestId());
+    EXPECT_TRUE(request_info_set_.RemoveRequest(found));
+  }
+  found = request_info_set_.FrontWithNotNullTimeout();
+  EXPECT_EQ(front, found);
+  EXPECT_TRUE(request_info_set_.RemoveRequest(front));
+  EXPECT_FALSE(request_info_set_.FrontWithNotNullTimeout().valid());
+  EXPECT_FALSE(request_info_set_.UpdateTimeout(front, 1));
+  EXPECT_EQ(1u, request_info_set_.Size());
+}
+
+TEST_F(RequestInfoTest, RequestInfoSetRemoveNeighbourAppsTest) {
+  // Requests of apps with adjacent keys and extreme correlation ids
+  const uint32_t max_id = std::numeric_limits<uint32_t>::max();
+  const uint32_t keys[] = {hmi_connection_key_, 1, 2, max_id};
+  const uint32_t correlation_ids[] = {0, 1, max_id};
+  for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); ++k) {
+    for (size_t c = 0; c < sizeof(correlation_ids) / sizeof(correlation_ids[0]); ++c) {
+      EXPECT_TRUE(request_info_set_.Add(
+          create_test_info(keys[k], correlation_ids[c],
+                           request_info::RequestInfo::MobileRequest,
+                           date_time::DateTime::getCurrentTime(), default_timeout_)));
+    }
+  }
+  EXPECT_EQ(12u, request_info_set_.Size());
+  EXPECT_TRUE(request_info_set_.Find(2, max_id).valid());
+  EXPECT_FALSE(request_info_set_.Find(3, 0).valid());
+
+  EXPECT_EQ(3u, request_info_set_.RemoveByConnectionKey(1));
+  EXPECT_FALSE(request_info_set_.Find(1, max_id).valid());
+  EXPECT_TRUE(request_info_set_.Find(2, 0).valid());
+  EXPECT_EQ(0u, request_info_set_.RemoveByConnectionKey(1));
+
+  EXPECT_EQ(6u, request_info_set_.RemoveMobileRequests());
+  EXPECT_EQ(3u, request_info_set_.Size());
+  EXPECT_TRUE(request_info_set_.Find(hmi_connection_key_, max_id).valid());
+  EXPECT_EQ(3u, request_info_set_.RemoveByConnectionKey(hmi_connection_key_));
+  EXPECT_EQ(0u, request_info_set_.Size());
+}
+
 
 uint32_t MockRequest::correlation_id() const {
   return correlation_id_;
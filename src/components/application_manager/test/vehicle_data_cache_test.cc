@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include "application_manager/vehicle_data_cache.h"
+
+namespace test {
+namespace components {
+namespace application_manager_test {
+
+using ::application_manager::VehicleDataCache;
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+
+namespace {
+const int64_t kNowMs = 100000;
+const uint32_t kSpeedTimeToLiveMs = 200;
+
+VehicleDataCache::TimeToLiveMap TimeToLive() {
+  VehicleDataCache::TimeToLiveMap time_to_live;
+  time_to_live["speed"] = kSpeedTimeToLiveMs;
+  time_to_live["rpm"] = 1000;
+  return time_to_live;
+}
+
+smart_objects::SmartObject Request(const char* first,
+                                   const char* second = NULL) {
+  smart_objects::SmartObject request(smart_objects::SmartType_Map);
+  request[first] = true;
+  if (second) {
+    request[second] = true;
+  }
+  return request;
+}
+}  // namespace
+
+TEST(VehicleDataCacheTest, FreshData_ExpectTakenFromCache) {
+  VehicleDataCache cache(TimeToLive());
+  smart_objects::SmartObject data(smart_objects::SmartType_Map);
+  data["speed"] = 42.5;
+  data["rpm"] = 2000;
+  cache.Update(data, kNowMs);
+
+  smart_objects::SmartObject cached(smart_objects::SmartType_Map);
+  ASSERT_TRUE(cache.Get(Request("speed", "rpm"), kNowMs + kSpeedTimeToLiveMs,
+                        &cached));
+  EXPECT_DOUBLE_EQ(42.5, cached["speed"].asDouble());
+  EXPECT_EQ(2000, cached["rpm"].asInt());
+}
+
+TEST(VehicleDataCacheTest, OutdatedData_ExpectNotTaken) {
+  VehicleDataCache cache(TimeToLive());
+  smart_objects::SmartObject data(smart_objects::SmartType_Map);
+  data["speed"] = 42.5;
+  data["rpm"] = 2000;
+  cache.Update(data, kNowMs);
+
+  smart_objects::SmartObject cached(smart_objects::SmartType_Map);
+  EXPECT_TRUE(cache.Get(Request("rpm"), kNowMs + 500, &cached));
+  EXPECT_FALSE(cache.Get(Request("speed", "rpm"), kNowMs + 500, &cached));
+
+  data["speed"] = 50.0;
+  cache.Update(data, kNowMs + 500);
+  EXPECT_TRUE(cache.Get(Request("speed"), kNowMs + 500, &cached));
+  EXPECT_DOUBLE_EQ(50.0, cached["speed"].asDouble());
+}
+
+TEST(VehicleDataCacheTest, NotCachedParameter_ExpectNotTaken) {
+  VehicleDataCache cache(TimeToLive());
+  smart_objects::SmartObject data(smart_objects::SmartType_Map);
+  data["speed"] = 42.5;
+  data["gps"] = smart_objects::SmartObject(smart_objects::SmartType_Map);
+  cache.Update(data, kNowMs);
+
+  smart_objects::SmartObject cached(smart_objects::SmartType_Map);
+  EXPECT_FALSE(cache.Get(Request("speed", "gps"), kNowMs, &cached));
+  // Cached parameter without value yet
+  EXPECT_FALSE(cache.Get(Request("rpm"), kNowMs, &cached));
+}
+
+TEST(VehicleDataCacheTest, Cleared_ExpectNotTaken) {
+  VehicleDataCache cache(TimeToLive());
+  smart_objects::SmartObject data(smart_objects::SmartType_Map);
+  data["speed"] = 42.5;
+  cache.Update(data, kNowMs);
+  cache.Clear();
+
+  smart_objects::SmartObject cached(smart_objects::SmartType_Map);
+  EXPECT_FALSE(cache.Get(Request("speed"), kNowMs, &cached));
+}
+
+TEST(VehicleDataCacheTest, NoTimeToLive_ExpectDisabled) {
+  VehicleDataCache cache((VehicleDataCache::TimeToLiveMap()));
+  EXPECT_FALSE(cache.enabled());
+  smart_objects::SmartObject data(smart_objects::SmartType_Map);
+  data["speed"] = 42.5;
+  cache.Update(data, kNowMs);
+
+  smart_objects::SmartObject cached(smart_objects::SmartType_Map);
+  EXPECT_FALSE(cache.Get(Request("speed"), kNowMs, &cached));
+}
+
+}  // namespace application_manager_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "config_profile/profile.h"
+#include "policy/cache_manager.h"
+
+namespace benchmarks {
+
+namespace policy_table = rpc::policy_table_interface_base;
+using ::policy::CacheManager;
+using ::policy::CheckPermissionResult;
+
+namespace {
+const char kPreloadedPT[] = "sdl_preloaded_pt.json";
+
+// Groups of typical registered application
+const char* kGroups[] = {
+  "Base-4", "Notifications", "Location-1", "VehicleInfo-3",
+  "DrivingCharacteristics-3"
+};
+
+/*
+ * Cache loaded from preloaded policy table once for all benchmarks,
+ * NULL if table is not loaded
+ */
+CacheManager* Cache() {
+  static CacheManager* cache = NULL;
+  static bool initialized = false;
+  if (!cache) {
+    profile::Profile::instance()->config_file_name("smartDeviceLink.ini");
+    remove("policy.sqlite");
+    cache = new CacheManager();
+    initialized = cache->Init(kPreloadedPT);
+  }
+  return initialized ? cache : NULL;
+}
+
+policy_table::Strings MakeGroups(const size_t count) {
+  policy_table::Strings groups;
+  for (size_t i = 0; i < count; ++i) {
+    groups.push_back(policy_table::Strings::value_type(kGroups[i]));
+  }
+  return groups;
+}
+
+/*
+ * RPC of state.range(1) index checked with first state.range(0) groups
+ */
+void CheckPermissions(benchmark::State& state) {
+  const char* rpcs[] = {"Show", "GetVehicleData", "Speak"};
+  const policy_table::Strings groups =
+      MakeGroups(static_cast<size_t>(state.range(0)));
+  const std::string hmi_level("FULL");
+  const std::string rpc(rpcs[state.range(1)]);
+  CacheManager* cache = Cache();
+  if (!cache) {
+    state.SkipWithError("Policy table is not loaded");
+    return;
+  }
+  while (state.KeepRunning()) {
+    CheckPermissionResult result;
+    cache->CheckPermissions(groups, hmi_level, rpc, result);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+/*
+ * Every request is checked with groups of different application,
+ * so permissions are found for several group sets in turn
+ */
+void CheckPermissionsOfSeveralApps(benchmark::State& state) {
+  const size_t groups_count = sizeof(kGroups) / sizeof(kGroups[0]);
+  std::vector<policy_table::Strings> apps_groups;
+  for (size_t i = 1; i <= groups_count; ++i) {
+    apps_groups.push_back(MakeGroups(i));
+  }
+  const std::string hmi_level("BACKGROUND");
+  const std::string rpc("GetVehicleData");
+  CacheManager* cache = Cache();
+  if (!cache) {
+    state.SkipWithError("Policy table is not loaded");
+    return;
+  }
+  size_t app = 0;
+  while (state.KeepRunning()) {
+    CheckPermissionResult result;
+    cache->CheckPermissions(apps_groups[app], hmi_level, rpc, result);
+    benchmark::DoNotOptimize(result);
+    app = (app + 1) % apps_groups.size();
+  }
+}
+}  // namespace
+
+// Arguments are count of groups and RPC: 0 - Show, 1 - GetVehicleData,
+// 2 - Speak
+BENCHMARK(CheckPermissions)
+    ->ArgPair(1, 0)
+    ->ArgPair(5, 0)
+    ->ArgPair(5, 1)
+    ->ArgPair(5, 2);
+BENCHMARK(CheckPermissionsOfSeveralApps);
+
+}  // namespace benchmarks
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "application_manager/event_engine/event.h"
+#include "application_manager/event_engine/event_observer.h"
+#include "application_manager/event_engine/event_dispatcher.h"
+#include "smart_objects/smart_object.h"
+
+namespace benchmarks {
+
+using ::application_manager::event_engine::Event;
+using ::application_manager::event_engine::EventObserver;
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+namespace strings = ::application_manager::strings;
+
+namespace {
+const Event::EventID kEventId = hmi_apis::FunctionID::UI_Show;
+const Event::EventID kOtherEventId = hmi_apis::FunctionID::UI_Alert;
+
+class Observer : public EventObserver {
+ public:
+  Observer()
+      : calls_count_(0) {
+  }
+  void on_event(const Event& event) {
+    ++calls_count_;
+  }
+  void Subscribe(const Event::EventID& event_id, int32_t correlation_id = 0) {
+    subscribe_on_event(event_id, correlation_id);
+  }
+  size_t calls_count() const {
+    return calls_count_;
+  }
+
+ private:
+  size_t calls_count_;
+};
+
+/*
+ * Observers waiting for other events and responses, as commands in flight
+ */
+void AddBackground(const int count, std::vector<Observer*>* observers) {
+  for (int i = 0; i < count; ++i) {
+    Observer* observer = new Observer();
+    observer->Subscribe(kOtherEventId);
+    observer->Subscribe(kEventId, 1000 + i);
+    observers->push_back(observer);
+  }
+}
+
+void Delete(std::vector<Observer*>* observers) {
+  for (size_t i = 0; i < observers->size(); ++i) {
+    delete (*observers)[i];
+  }
+  observers->clear();
+}
+
+void SetMessage(hmi_apis::messageType::eType message_type,
+                int32_t correlation_id, Event* event) {
+  smart_objects::SmartObject message(smart_objects::SmartType_Map);
+  message[strings::params][strings::message_type] = message_type;
+  message[strings::params][strings::correlation_id] = correlation_id;
+  event->set_smart_object(message);
+}
+
+/*
+ * Notification delivered to state.range(0) subscribed observers
+ */
+void RaiseNotification(benchmark::State& state) {
+  std::vector<Observer*> observers;
+  AddBackground(static_cast<int>(state.range(1)), &observers);
+  for (int i = 0; i < state.range(0); ++i) {
+    Observer* subscriber = new Observer();
+    subscriber->Subscribe(kEventId);
+    observers.push_back(subscriber);
+  }
+  Event event(kEventId);
+  SetMessage(hmi_apis::messageType::notification, 0, &event);
+  while (state.KeepRunning()) {
+    event.raise();
+  }
+  Delete(&observers);
+}
+
+/*
+ * Command subscribes for response of its request and gets it,
+ * state.range(1) other responses are awaited meanwhile
+ */
+void SubscribeAndRaiseResponse(benchmark::State& state) {
+  std::vector<Observer*> observers;
+  AddBackground(static_cast<int>(state.range(1)), &observers);
+  const int32_t kCorrelationId = 1;
+  Event event(kEventId);
+  SetMessage(hmi_apis::messageType::response, kCorrelationId, &event);
+  Observer observer;
+  while (state.KeepRunning()) {
+    observer.Subscribe(kEventId, kCorrelationId);
+    event.raise();
+  }
+  if (observer.calls_count() != static_cast<size_t>(state.iterations())) {
+    state.SkipWithError("Response is not delivered");
+  }
+  Delete(&observers);
+}
+}  // namespace
+
+// Arguments are count of subscribers and count of observers of other events
+BENCHMARK(RaiseNotification)
+    ->ArgPair(1, 0)
+    ->ArgPair(8, 0)
+    ->ArgPair(8, 256);
+BENCHMARK(SubscribeAndRaiseResponse)
+    ->ArgPair(0, 0)
+    ->ArgPair(0, 256);
+
+}  // namespace benchmarks
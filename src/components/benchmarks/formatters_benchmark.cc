@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "formatters/CFormatterJsonSDLRPCv2.hpp"
+#include "interfaces/MOBILE_API.h"
+#include "interfaces/MOBILE_API_schema.h"
+#include "smart_objects/smart_object.h"
+
+namespace benchmarks {
+
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+namespace formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
+
+namespace {
+// msg_params of RPCs as mobile applications send them
+const char kRegisterAppInterface[] =
+    "{\"syncMsgVersion\":{\"majorVersion\":4,\"minorVersion\":0},"
+    "\"appName\":\"Media Player\","
+    "\"ttsName\":[{\"text\":\"Media Player\",\"type\":\"TEXT\"}],"
+    "\"ngnMediaScreenAppName\":\"Player\","
+    "\"vrSynonyms\":[\"Media Player\",\"Player\"],"
+    "\"isMediaApplication\":true,"
+    "\"languageDesired\":\"EN-US\","
+    "\"hmiDisplayLanguageDesired\":\"EN-US\","
+    "\"appHMIType\":[\"MEDIA\"],"
+    "\"deviceInfo\":{\"hardware\":\"Nexus 5\",\"os\":\"Android\","
+    "\"osVersion\":\"5.1\",\"carrier\":\"Carrier\","
+    "\"maxNumberRFCOMMPorts\":1},"
+    "\"appID\":\"584421907\"}";
+
+const char kShow[] =
+    "{\"mainField1\":\"Artist name\",\"mainField2\":\"Track title\","
+    "\"mainField3\":\"Album\",\"alignment\":\"CENTERED\","
+    "\"mediaTrack\":\"3/12\","
+    "\"graphic\":{\"value\":\"album_cover.png\",\"imageType\":\"DYNAMIC\"},"
+    "\"softButtons\":["
+    "{\"type\":\"BOTH\",\"text\":\"Like\",\"softButtonID\":1,"
+    "\"image\":{\"value\":\"like.png\",\"imageType\":\"DYNAMIC\"},"
+    "\"isHighlighted\":false,\"systemAction\":\"DEFAULT_ACTION\"},"
+    "{\"type\":\"TEXT\",\"text\":\"Shuffle\",\"softButtonID\":2,"
+    "\"isHighlighted\":true,\"systemAction\":\"DEFAULT_ACTION\"},"
+    "{\"type\":\"TEXT\",\"text\":\"Repeat\",\"softButtonID\":3,"
+    "\"systemAction\":\"KEEP_CONTEXT\"}],"
+    "\"customPresets\":[\"Rock\",\"Jazz\",\"News\"]}";
+
+struct Sample {
+  const char* json;
+  mobile_apis::FunctionID::eType function_id;
+};
+
+const Sample kSamples[] = {
+  {kRegisterAppInterface, mobile_apis::FunctionID::RegisterAppInterfaceID},
+  {kShow, mobile_apis::FunctionID::ShowID}
+};
+
+const Sample& GetSample(const benchmark::State& state) {
+  return kSamples[state.range(0)];
+}
+
+bool Parse(const Sample& sample, smart_objects::SmartObject* out) {
+  return formatters::CFormatterJsonSDLRPCv2::fromString(
+      std::string(sample.json), *out, sample.function_id,
+      mobile_apis::messageType::request, 42);
+}
+
+void FromString(benchmark::State& state) {
+  const std::string json(GetSample(state).json);
+  const mobile_apis::FunctionID::eType function_id =
+      GetSample(state).function_id;
+  while (state.KeepRunning()) {
+    smart_objects::SmartObject message;
+    benchmark::DoNotOptimize(formatters::CFormatterJsonSDLRPCv2::fromString(
+        json, message, function_id, mobile_apis::messageType::request, 42));
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+void ToString(benchmark::State& state) {
+  smart_objects::SmartObject message;
+  if (!Parse(GetSample(state), &message)) {
+    state.SkipWithError("Sample is not parsed");
+    return;
+  }
+  mobile_apis::MOBILE_API factory;
+  factory.attachSchema(message);
+  std::string json;
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        formatters::CFormatterJsonSDLRPCv2::toString(message, json));
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+void AttachSchemaAndValidate(benchmark::State& state) {
+  smart_objects::SmartObject parsed;
+  if (!Parse(GetSample(state), &parsed)) {
+    state.SkipWithError("Sample is not parsed");
+    return;
+  }
+  mobile_apis::MOBILE_API factory;
+  smart_objects::Errors::eType result = smart_objects::Errors::OK;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    smart_objects::SmartObject message(parsed);
+    state.ResumeTiming();
+    factory.attachSchemaAndValidate(message, result);
+  }
+  if (smart_objects::Errors::OK != result) {
+    state.SkipWithError("Sample is not valid");
+  }
+}
+
+/*
+ * CSmartSchema::validate of object which schema is already applied
+ */
+void Validate(benchmark::State& state) {
+  smart_objects::SmartObject message;
+  mobile_apis::MOBILE_API factory;
+  if (!Parse(GetSample(state), &message) || !factory.attachSchema(message)) {
+    state.SkipWithError("Sample is not parsed");
+    return;
+  }
+  smart_objects::Errors::eType result = smart_objects::Errors::OK;
+  while (state.KeepRunning()) {
+    result = message.validate();
+  }
+  if (smart_objects::Errors::OK != result) {
+    state.SkipWithError("Sample is not valid");
+  }
+}
+}  // namespace
+
+// Argument is index of the sample: 0 - RegisterAppInterface, 1 - Show
+BENCHMARK(FromString)->Arg(0)->Arg(1);
+BENCHMARK(ToString)->Arg(0)->Arg(1);
+BENCHMARK(AttachSchemaAndValidate)->Arg(0)->Arg(1);
+BENCHMARK(Validate)->Arg(0)->Arg(1);
+
+}  // namespace benchmarks
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include "protocol_handler/incoming_data_handler.h"
+#include "protocol_handler/protocol_packet.h"
+
+namespace benchmarks {
+
+using namespace protocol_handler;
+
+namespace {
+const transport_manager::ConnectionUID kConnection = 0x1234560;
+const size_t kFramesCount = 32;
+
+/*
+ * Serializes kFramesCount RPC frames with non-empty payload
+ * of payload_size bytes as transport manager receives them
+ */
+std::vector<uint8_t> MakeTransportData(const uint32_t payload_size) {
+  std::vector<uint8_t> payload(payload_size, 0xAB);
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < kFramesCount; ++i) {
+    const ProtocolPacket packet(kConnection, PROTOCOL_VERSION_3,
+                                PROTECTION_OFF, FRAME_TYPE_SINGLE,
+                                SERVICE_TYPE_RPC, FRAME_DATA_SINGLE, 1,
+                                payload_size, static_cast<uint32_t>(i + 1),
+                                &payload[0]);
+    const RawMessagePtr message = packet.serializePacket();
+    data.insert(data.end(), message->data(),
+                message->data() + message->data_size());
+  }
+  return data;
+}
+
+/*
+ * Frames data of kFramesCount frames with state.range(0) bytes of payload,
+ * delivered by transport in chunks of state.range(1) bytes,
+ * 0 means all frames come in a single chunk
+ */
+void ProcessData(benchmark::State& state) {
+  const std::vector<uint8_t> data =
+      MakeTransportData(static_cast<uint32_t>(state.range(0)));
+  const size_t chunk_size = state.range(1) ?
+      static_cast<size_t>(state.range(1)) : data.size();
+  ProtocolPacket::ProtocolHeaderValidator validator;
+  IncomingDataHandler handler;
+  handler.set_validator(&validator);
+  handler.AddConnection(kConnection);
+  RESULT_CODE result = RESULT_OK;
+  size_t malformed_occurrence = 0;
+  size_t frames_count = 0;
+  while (state.KeepRunning()) {
+    for (size_t offset = 0; offset < data.size(); offset += chunk_size) {
+      const size_t size = std::min(chunk_size, data.size() - offset);
+      const RawMessage message(kConnection, 0, &data[offset], size);
+      const std::list<ProtocolFramePtr> frames =
+          handler.ProcessData(message, &result, &malformed_occurrence);
+      frames_count += frames.size();
+    }
+  }
+  if (frames_count != kFramesCount * state.iterations()) {
+    state.SkipWithError("Frames are lost");
+  }
+  state.SetItemsProcessed(frames_count);
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+}  // namespace
+
+BENCHMARK(ProcessData)
+    ->ArgPair(16, 0)
+    ->ArgPair(64, 0)
+    ->ArgPair(1024, 0)
+    ->ArgPair(64, MAXIMUM_FRAME_DATA_SIZE)
+    ->ArgPair(1024, MAXIMUM_FRAME_DATA_SIZE)
+    ->ArgPair(1024, 512);
+
+}  // namespace benchmarks
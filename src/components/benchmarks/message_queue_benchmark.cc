@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <queue>
+
+#include "utils/message_queue.h"
+#include "utils/prioritized_queue.h"
+#include "utils/ring_buffer_queue.h"
+
+namespace benchmarks {
+
+namespace {
+struct Message {
+  Message()
+      : priority(0),
+        id(0) {
+  }
+  Message(size_t message_priority, int message_id)
+      : priority(message_priority),
+        id(message_id) {
+  }
+  size_t PriorityOrder() const {
+    return priority;
+  }
+  size_t priority;
+  int id;
+};
+
+// Priorities of messages mixed as protocol handler gets them
+const size_t kPriorities[] = {0, 1, 1, 2, 7, 0, 1, 10};
+const size_t kPrioritiesCount = sizeof(kPriorities) / sizeof(kPriorities[0]);
+
+/*
+ * Pushes batch of state.range(0) messages and pops them all
+ */
+template <class Queue>
+void PushPop(benchmark::State& state) {
+  utils::MessageQueue<Message, Queue> queue;
+  const int batch_size = static_cast<int>(state.range(0));
+  while (state.KeepRunning()) {
+    for (int i = 0; i < batch_size; ++i) {
+      queue.push(Message(kPriorities[i % kPrioritiesCount], i));
+    }
+    while (!queue.empty()) {
+      benchmark::DoNotOptimize(queue.pop());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+/*
+ * Pushes batch of messages and takes them all at once as message loop does
+ */
+template <class Queue>
+void PushPopAll(benchmark::State& state) {
+  utils::MessageQueue<Message, Queue> queue;
+  const int batch_size = static_cast<int>(state.range(0));
+  typename utils::MessageQueue<Message, Queue>::Queue output;
+  while (state.KeepRunning()) {
+    for (int i = 0; i < batch_size; ++i) {
+      queue.push(Message(kPriorities[i % kPrioritiesCount], i));
+    }
+    queue.PopAll(output);
+    while (!output.empty()) {
+      benchmark::DoNotOptimize(output.front());
+      output.pop();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+typedef std::queue<Message> FifoQueue;
+typedef utils::PrioritizedQueue<Message> MapPrioritizedQueue;
+typedef utils::FixedPrioritizedQueue<Message> FixedQueue;
+typedef utils::RingBufferQueue<Message, 2048> RingQueue;
+}  // namespace
+
+BENCHMARK_TEMPLATE(PushPop, FifoQueue)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(PushPop, MapPrioritizedQueue)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(PushPop, FixedQueue)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(PushPop, RingQueue)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(PushPopAll, FifoQueue)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(PushPopAll, MapPrioritizedQueue)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(PushPopAll, FixedQueue)->Arg(64)->Arg(1024);
+
+}  // namespace benchmarks
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "smart_objects/smart_object.h"
+
+namespace benchmarks {
+
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+
+namespace {
+/*
+ * Builds message shaped as Show request with state.range(0) soft buttons
+ */
+void BuildShow(const int soft_buttons_count, smart_objects::SmartObject* out) {
+  smart_objects::SmartObject& message = *out;
+  message["params"]["function_id"] = 13;
+  message["params"]["message_type"] = 0;
+  message["params"]["correlation_id"] = 42;
+  message["params"]["connection_key"] = 65537;
+  message["params"]["protocol_type"] = 0;
+  message["params"]["protocol_version"] = 3;
+  smart_objects::SmartObject& msg_params = message["msg_params"];
+  msg_params["mainField1"] = "Artist name";
+  msg_params["mainField2"] = "Track title";
+  msg_params["mainField3"] = "Album";
+  msg_params["alignment"] = 1;
+  msg_params["graphic"]["value"] = "album_cover.png";
+  msg_params["graphic"]["imageType"] = 1;
+  for (int i = 0; i < soft_buttons_count; ++i) {
+    smart_objects::SmartObject& button = msg_params["softButtons"][i];
+    button["type"] = 2;
+    button["text"] = "Button";
+    button["image"]["value"] = "icon.png";
+    button["image"]["imageType"] = 1;
+    button["isHighlighted"] = false;
+    button["softButtonID"] = i;
+    button["systemAction"] = 0;
+  }
+}
+
+void Build(benchmark::State& state) {
+  const int soft_buttons_count = static_cast<int>(state.range(0));
+  while (state.KeepRunning()) {
+    smart_objects::SmartObject message(smart_objects::SmartType_Map);
+    BuildShow(soft_buttons_count, &message);
+    benchmark::DoNotOptimize(message);
+  }
+}
+
+void Copy(benchmark::State& state) {
+  smart_objects::SmartObject message(smart_objects::SmartType_Map);
+  BuildShow(static_cast<int>(state.range(0)), &message);
+  while (state.KeepRunning()) {
+    smart_objects::SmartObject copy(message);
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+/*
+ * Lookups command code does for every message: params and few msg_params
+ */
+void Lookup(benchmark::State& state) {
+  smart_objects::SmartObject message(smart_objects::SmartType_Map);
+  BuildShow(static_cast<int>(state.range(0)), &message);
+  const smart_objects::SmartObject& const_message = message;
+  while (state.KeepRunning()) {
+    int32_t sum = const_message["params"]["function_id"].asInt();
+    sum += const_message["params"]["correlation_id"].asInt();
+    sum += const_message["params"]["connection_key"].asInt();
+    benchmark::DoNotOptimize(const_message["msg_params"].keyExists(
+        "mediaClock"));
+    const smart_objects::SmartObject& buttons =
+        const_message["msg_params"]["softButtons"];
+    const int32_t buttons_count = static_cast<int32_t>(buttons.length());
+    for (int32_t i = 0; i < buttons_count; ++i) {
+      sum += buttons[i]["softButtonID"].asInt();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+}  // namespace
+
+BENCHMARK(Build)->Arg(0)->Arg(8);
+BENCHMARK(Copy)->Arg(0)->Arg(8);
+BENCHMARK(Lookup)->Arg(0)->Arg(8);
+
+}  // namespace benchmarks
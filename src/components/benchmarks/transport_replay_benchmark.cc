@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "protocol_handler/protocol_packet.h"
+#include "transport_manager/traffic_capture.h"
+#include "transport_manager/transport_manager_impl.h"
+#include "transport_manager/transport_manager_listener_empty.h"
+#include "transport_manager/replay/replay_transport_adapter.h"
+#include "utils/conditional_variable.h"
+#include "utils/date_time.h"
+#include "utils/lock.h"
+
+namespace benchmarks {
+
+using namespace transport_manager;
+using transport_manager::transport_adapter::ReplayTransportAdapter;
+using date_time::DateTime;
+
+namespace {
+// Capture of field trace to replay, synthetic capture is used if not set
+const char kCaptureVariable[] = "SDL_TRAFFIC_CAPTURE";
+const char kSyntheticCapture[] = "transport_replay_benchmark.bin";
+const size_t kConnectionsCount = 4;
+const size_t kFramesCount = 256;
+const uint32_t kPayloadSize = 512;
+// Spacing of synthetic frames for real time replay
+const useconds_t kFrameInterval = 500;
+// Replay is expected to end long before this
+const int32_t kReplayTimeout = 60000;
+
+/*
+ * Captures kFramesCount RPC frames received over kConnectionsCount
+ * connections one after another
+ */
+bool MakeSyntheticCapture() {
+  TrafficCaptureWriter writer;
+  if (!writer.Open(kSyntheticCapture)) {
+    return false;
+  }
+  const std::vector<uint8_t> payload(kPayloadSize, 0xAB);
+  for (size_t i = 0; i < kFramesCount; ++i) {
+    const ConnectionUID connection = i % kConnectionsCount + 1;
+    const protocol_handler::ProtocolPacket packet(
+        connection, protocol_handler::PROTOCOL_VERSION_3,
+        protocol_handler::PROTECTION_OFF, protocol_handler::FRAME_TYPE_SINGLE,
+        protocol_handler::SERVICE_TYPE_RPC,
+        protocol_handler::FRAME_DATA_SINGLE, 1, kPayloadSize,
+        static_cast<uint32_t>(i + 1), &payload[0]);
+    writer.Record(kTrafficInbound, *packet.serializePacket());
+    usleep(kFrameInterval);
+  }
+  return true;
+}
+
+const std::string& CaptureFile() {
+  static std::string file;
+  if (file.empty()) {
+    const char* variable = getenv(kCaptureVariable);
+    if (variable && *variable) {
+      file = variable;
+    } else if (MakeSyntheticCapture()) {
+      file = kSyntheticCapture;
+    }
+  }
+  return file;
+}
+
+/*
+ * Counts frames and bytes SDL receives from capture
+ */
+bool CountInboundFrames(const std::string& file, size_t* frames,
+                        size_t* bytes) {
+  TrafficCaptureReader reader;
+  if (!reader.Open(file)) {
+    return false;
+  }
+  *frames = 0;
+  *bytes = 0;
+  CapturedFrame frame;
+  while (reader.Next(&frame)) {
+    if (kTrafficInbound == frame.direction && !frame.data.empty()) {
+      ++*frames;
+      *bytes += frame.data.size();
+    }
+  }
+  return reader.error().empty();
+}
+
+/*
+ * Measures time from frame being handed over by transport adapter
+ * to transport manager till it reaches transport manager listener.
+ * Frames reach listener in order they are handed over.
+ */
+class LatencyMeter : public TransportManagerListenerEmpty {
+ public:
+  explicit LatencyMeter(size_t expected_frames)
+    : expected_frames_(expected_frames),
+      received_frames_(0),
+      total_latency_(0),
+      max_latency_(0) {
+  }
+
+  void FrameDelivered() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    delivery_times_.push_back(DateTime::getPreciseMonotonicTime());
+  }
+
+  virtual void OnTMMessagesReceived(
+      const protocol_handler::RawMessageList& messages) {
+    const TimevalStruct now = DateTime::getPreciseMonotonicTime();
+    sync_primitives::AutoLock auto_lock(lock_);
+    for (size_t i = 0; i < messages.size() && !delivery_times_.empty(); ++i) {
+      const int64_t latency = DateTime::getuSecs(
+          DateTime::Sub(now, delivery_times_.front()));
+      delivery_times_.pop_front();
+      total_latency_ += latency;
+      max_latency_ = std::max(max_latency_, latency);
+      ++received_frames_;
+    }
+    if (received_frames_ >= expected_frames_) {
+      done_.Broadcast();
+    }
+  }
+
+  bool WaitAllReceived() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (received_frames_ < expected_frames_) {
+      if (sync_primitives::ConditionalVariable::kTimeout ==
+          done_.WaitFor(auto_lock, kReplayTimeout)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t received_frames() const {
+    return received_frames_;
+  }
+  int64_t total_latency() const {
+    return total_latency_;
+  }
+  int64_t max_latency() const {
+    return max_latency_;
+  }
+
+ private:
+  const size_t expected_frames_;
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable done_;
+  std::deque<TimevalStruct> delivery_times_;
+  size_t received_frames_;
+  int64_t total_latency_;
+  int64_t max_latency_;
+};
+
+class MeteredReplayAdapter : public ReplayTransportAdapter {
+ public:
+  MeteredReplayAdapter(const std::string& capture_file, bool real_time,
+                       LatencyMeter* meter)
+    : ReplayTransportAdapter(capture_file, real_time),
+      meter_(meter) {
+  }
+
+  virtual void DataReceiveDone(const DeviceUID& device_handle,
+                               const ApplicationHandle& app_handle,
+                               protocol_handler::RawMessagePtr message) {
+    meter_->FrameDelivered();
+    ReplayTransportAdapter::DataReceiveDone(device_handle, app_handle,
+                                            message);
+  }
+
+ private:
+  LatencyMeter* meter_;
+};
+
+/*
+ * Replays capture through transport manager once per iteration,
+ * with original timing if state.range(0) is not 0,
+ * otherwise as fast as possible
+ */
+void ReplayCapture(benchmark::State& state) {
+  const std::string& file = CaptureFile();
+  size_t frames = 0;
+  size_t bytes = 0;
+  if (file.empty() || !CountInboundFrames(file, &frames, &bytes) ||
+      !frames) {
+    state.SkipWithError("Capture is not readable or empty");
+    return;
+  }
+  const bool real_time = 0 != state.range(0);
+  size_t received_frames = 0;
+  int64_t total_latency = 0;
+  int64_t max_latency = 0;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    LatencyMeter meter(frames);
+    {
+      TransportManagerImpl transport_manager;
+      transport_manager.Init();
+      transport_manager.AddEventListener(&meter);
+      transport_manager.AddTransportAdapter(
+          new MeteredReplayAdapter(file, real_time, &meter));
+      state.ResumeTiming();
+      transport_manager.Visibility(true);
+      const bool received = meter.WaitAllReceived();
+      state.PauseTiming();
+      transport_manager.Stop();
+      if (!received) {
+        state.SkipWithError("Frames are lost");
+        break;
+      }
+    }
+    received_frames += meter.received_frames();
+    total_latency += meter.total_latency();
+    max_latency = std::max(max_latency, meter.max_latency());
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(received_frames);
+  state.SetBytesProcessed(state.iterations() * bytes);
+  if (received_frames) {
+    state.counters["latency_avg_us"] =
+        static_cast<double>(total_latency) / received_frames;
+    state.counters["latency_max_us"] = static_cast<double>(max_latency);
+  }
+}
+}  // namespace
+
+BENCHMARK(ReplayCapture)->Arg(0)->Arg(1)->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace benchmarks
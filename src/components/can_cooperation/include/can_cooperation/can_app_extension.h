@@ -34,7 +34,7 @@
 #define SRC_COMPONENTS_CAN_COOPERATION_INCLUDE_CAN_COOPERATION_CAN_APP_EXTENSION_H_
 
 #include <string>
-#include <set>
+#include <map>
 #include "application_manager/service.h"
 #include "application_manager/app_extension.h"
 #include "can_cooperation/can_module.h"
@@ -96,14 +96,16 @@ class CANAppExtension : public application_manager::AppExtension {
      */
     bool IsSubscibedToInteriorVehicleData(const Json::Value& moduleDescription);
 
-    friend void CANModule::UnsubscribeAppForAllZones(uint32_t hmi_app_id,
-                                                     CANAppExtensionPtr app);
+    friend void CANModule::UnsubscribeAppForAllZones(
+        application_manager::ApplicationSharedPtr application,
+        CANAppExtensionPtr app);
 
   private:
     bool is_control_given_;
     SeatLocation seat_;
     bool is_on_driver_device_;
-    std::set<Json::Value> subscribed_interior_vehicle_data_;
+    // Module descriptions by MessageHelper::InteriorModuleKey
+    std::map<std::string, Json::Value> subscribed_interior_vehicle_data_;
 
 };
 
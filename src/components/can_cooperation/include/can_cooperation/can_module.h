@@ -33,12 +33,16 @@
 #ifndef SRC_COMPONENTS_CAN_COOPERATION_INCLUDE_CAN_COOPERATION_CAN_MODULE_H_
 #define SRC_COMPONENTS_CAN_COOPERATION_INCLUDE_CAN_COOPERATION_CAN_MODULE_H_
 
+#include <map>
 #include <queue>
+#include <set>
 #include <string>
+#include <vector>
 #include "functional_module/generic_module.h"
 #include "can_cooperation/can_connection.h"
 #include "can_cooperation/request_controller.h"
 #include "utils/threads/message_loop_thread.h"
+#include "utils/lock.h"
 
 namespace can_cooperation {
 
@@ -135,8 +139,35 @@ class CANModule : public functional_modules::GenericModule,
 
   void SendHmiStatusNotification(application_manager::ApplicationSharedPtr app);
 
-  void UnsubscribeAppForAllZones(uint32_t hmi_app_id,
-                                 CANAppExtensionPtr app);
+  void UnsubscribeAppForAllZones(
+      application_manager::ApplicationSharedPtr application,
+      CANAppExtensionPtr app);
+
+  /**
+   * @brief Subscribes application to OnInteriorVehicleData of module
+   * @param app application having extension of module
+   * @param module_description type and zone of module
+   */
+  void SubscribeToInteriorVehicleData(
+      application_manager::ApplicationSharedPtr app,
+      const Json::Value& module_description);
+
+  /**
+   * @brief Unsubscribes application from OnInteriorVehicleData of module
+   * @param app application having extension of module
+   * @param module_description type and zone of module
+   */
+  void UnsubscribeFromInteriorVehicleData(
+      application_manager::ApplicationSharedPtr app,
+      const Json::Value& module_description);
+
+  /**
+   * @brief Provides applications subscribed to OnInteriorVehicleData
+   * @param module_description type and zone of module
+   * @return ids of subscribed applications
+   */
+  std::vector<uint32_t> InteriorVehicleDataSubscribers(
+      const Json::Value& module_description);
 
  protected:
   /**
@@ -151,9 +182,18 @@ class CANModule : public functional_modules::GenericModule,
   void NotifyMobiles(application_manager::MessagePtr msg);
 
   void UnsubscribeAppsFromAllInteriorZones(uint32_t  device_id);
+  /**
+   * @brief Drops application from subscribers of all modules
+   */
+  void RemoveInteriorVehicleDataSubscriber(uint32_t app_id);
 
   functional_modules::ProcessResult HandleMessage(
     application_manager::MessagePtr msg);
+  /*
+   * @brief Handles message which json is already parsed into value
+   */
+  functional_modules::ProcessResult HandleMessage(
+    application_manager::MessagePtr msg, const Json::Value& value);
   inline bool DoNeedUnsubscribe(
       uint32_t device_id, const application_manager::SeatLocation& zone);
   inline application_manager::SeatLocation GetInteriorZone(
@@ -167,6 +207,11 @@ class CANModule : public functional_modules::GenericModule,
   bool is_scan_started_;
   request_controller::RequestController request_controller_;
 
+  // Ids of subscribed applications by MessageHelper::InteriorModuleKey
+  typedef std::map<std::string, std::set<uint32_t> > SubscribersIndex;
+  SubscribersIndex interior_vehicle_data_subscribers_;
+  sync_primitives::Lock interior_vehicle_data_subscribers_lock_;
+
   friend class CanModuleTest;
   FRIEND_BASE_SINGLETON_CLASS(CANModule);
   DISALLOW_COPY_AND_ASSIGN(CANModule);
@@ -36,6 +36,7 @@
 #include <string>
 
 #include "application_manager/message.h"
+#include "json/json.h"
 
 #include "can_cooperation/event_engine/event.h"
 
@@ -50,9 +51,12 @@ class CanModuleEvent :
    *
    * @param id Event ID. (HMI or CAN function name)
    * @param message Message received in HMI or CAN response
+   * @param value Json of message already parsed by module, it has to
+   * outlive raising of event
    */
   CanModuleEvent(application_manager::MessagePtr& message,
-                 const std::string& id);
+                 const std::string& id,
+                 const Json::Value& value);
 
   /*
    * @brief Destructor
@@ -74,7 +78,14 @@ class CanModuleEvent :
    */
   virtual int32_t event_message_type() const;
 
+  /*
+   * @brief Retrieves json of event message parsed once for all observers
+   */
+  const Json::Value& event_message_value() const;
+
 private:
+  const Json::Value& value_;
+
   DISALLOW_COPY_AND_ASSIGN(CanModuleEvent);
 };
 
@@ -36,6 +36,7 @@
 #include <string>
 #include <deque>
 #include "can_cooperation/can_connection.h"
+#include "utils/lock.h"
 
 namespace threads {
 class Thread;
@@ -50,6 +51,10 @@ namespace can_cooperation {
   * Configuration of connection is done in "can_config.json" file.
   * By default port is 8092, address is "127.0.0.1".
   * CAN integrator software acts as server, CANTCPConnection connects as client.
+  * Messages pending while connection is down are kept in bounded queue
+  * and sent at once with single write after connection is restored.
+  * Several messages read at once from stream are split and returned one
+  * by one.
   */
 class CANTCPConnection : public CANConnection {
  public:
@@ -60,8 +65,21 @@ class CANTCPConnection : public CANConnection {
  private:
   ConnectionState OpenConnection();
   ConnectionState CloseConnection();
+  /**
+   * @brief Creates new socket and connects it, called when connection
+   * was lost
+   */
+  ConnectionState Reconnect();
   ConnectionState Flash();
+  /**
+   * @brief Extracts first complete json object from read data
+   * @param frame Text of extracted object
+   * @return false if no complete object was read yet
+   */
+  bool TakeFrame(std::string* frame);
   std::deque<CANMessage> to_send_;
+  sync_primitives::Lock to_send_lock_;
+  std::string incoming_;
   std::string address_;
   int port_;
   int socket_;
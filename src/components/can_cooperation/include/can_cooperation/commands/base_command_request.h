@@ -121,6 +121,17 @@ class BaseCommandRequest : public Command,
                        std::string&  result_code,
                        std::string& info);
 
+  /**
+   * @brief Provides json of response or notification from HMI or Can
+   * parsed once by module for all observers of event
+   *
+   * @param event Event raised by module
+   * @return parsed message of event
+   */
+  const Json::Value& EventMessageValue(
+      const event_engine::Event<application_manager::MessagePtr,
+      std::string>& event) const;
+
   /**
    * @brief Sends request to CAN or HMI
    * @param function_id request ID
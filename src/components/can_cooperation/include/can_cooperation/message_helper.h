@@ -89,6 +89,14 @@ class MessageHelper {
    */
   static bool ValidateInteriorZone(const Json::Value& value);
 
+  /**
+   * Makes compact key of module type and zone, so module descriptions
+   * are looked up without comparing json
+   * @param module_description json of ModuleDescription
+   * @return key equal for equal type and zone
+   */
+  static std::string InteriorModuleKey(const Json::Value& module_description);
+
  private:
   DISALLOW_COPY_AND_ASSIGN(MessageHelper);
 
@@ -31,6 +31,7 @@
  */
 
 #include "can_cooperation/can_app_extension.h"
+#include "can_cooperation/message_helper.h"
 
 namespace can_cooperation {
 CANAppExtension::CANAppExtension(application_manager::AppExtensionUID uid)
@@ -50,20 +51,21 @@ void CANAppExtension::GiveControl(bool is_control_given) {
 
 void CANAppExtension::SubscribeToInteriorVehicleData(
     const Json::Value& moduleDescription) {
-  subscribed_interior_vehicle_data_.insert(moduleDescription);
+  subscribed_interior_vehicle_data_[
+      MessageHelper::InteriorModuleKey(moduleDescription)] = moduleDescription;
 }
 
 void CANAppExtension::UnsubscribeFromInteriorVehicleData(
     const Json::Value& moduleDescription) {
-  subscribed_interior_vehicle_data_.erase(moduleDescription);
+  subscribed_interior_vehicle_data_.erase(
+      MessageHelper::InteriorModuleKey(moduleDescription));
 }
 
 bool CANAppExtension::IsSubscibedToInteriorVehicleData(
     const Json::Value& moduleDescription) {
-  std::set<Json::Value>::iterator it = subscribed_interior_vehicle_data_.find(
-      moduleDescription);
-
-  return (it != subscribed_interior_vehicle_data_.end());
+  return subscribed_interior_vehicle_data_.end() !=
+         subscribed_interior_vehicle_data_.find(
+             MessageHelper::InteriorModuleKey(moduleDescription));
 }
 
 CANAppExtension::~CANAppExtension() {}
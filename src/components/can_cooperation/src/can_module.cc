@@ -183,7 +183,8 @@ void CANModule::Handle(const MessageFromCAN can_msg) {
 
   LOG4CXX_INFO(logger_, "Can message: " << can_msg);
 
-  if (HandleMessage(msg) != ProcessResult::PROCESSED) {
+  // Message is already parsed by CAN connection, so it isn't parsed again
+  if (HandleMessage(msg, can_msg) != ProcessResult::PROCESSED) {
     LOG4CXX_ERROR(logger_, "Failed process CAN message!");
   }
 }
@@ -196,6 +197,11 @@ functional_modules::ProcessResult CANModule::HandleMessage(
   Json::Reader reader;
   reader.parse(msg->json_message(), value);
 
+  return HandleMessage(msg, value);
+}
+
+functional_modules::ProcessResult CANModule::HandleMessage(
+  application_manager::MessagePtr msg, const Json::Value& value) {
   std::string function_name;
 
   // Request or notification
@@ -237,7 +243,7 @@ functional_modules::ProcessResult CANModule::HandleMessage(
   switch (msg->type()) {
     case application_manager::MessageType::kResponse:
     case application_manager::MessageType::kErrorResponse: {
-      CanModuleEvent event(msg, function_name);
+      CanModuleEvent event(msg, function_name, value);
       EventDispatcher<application_manager::MessagePtr, std::string>::instance()
       ->raise_event(event);
       break;
@@ -268,7 +274,7 @@ functional_modules::ProcessResult CANModule::HandleMessage(
       } else if (functional_modules::hmi_api::on_device_rank_changed
           == function_name) {
         if (value.isMember(json_keys::kParams)) {
-          Json::Value& params = value[json_keys::kParams];
+          const Json::Value& params = value[json_keys::kParams];
           bool valid = MessageHelper::ValidateDeviceInfo(
               params.get(message_params::kDevice, Json::Value(Json::nullValue)))
             && params.isMember(message_params::kRank)
@@ -291,7 +297,7 @@ functional_modules::ProcessResult CANModule::HandleMessage(
       } else if (function_name ==
           functional_modules::hmi_api::on_device_location_changed) {
         if (value.isMember(json_keys::kParams)) {
-          Json::Value& params = value[json_keys::kParams];
+          const Json::Value& params = value[json_keys::kParams];
           bool valid = MessageHelper::ValidateDeviceInfo(
               params.get(message_params::kDevice, Json::Value(Json::nullValue)))
               && MessageHelper::ValidateInteriorZone(params.get(
@@ -425,6 +431,10 @@ void CANModule::SetScanStarted(bool is_scan_started) {
 }
 
 void CANModule::RemoveAppExtensions() {
+  {
+    sync_primitives::AutoLock lock(interior_vehicle_data_subscribers_lock_);
+    interior_vehicle_data_subscribers_.clear();
+  }
   std::vector<application_manager::ApplicationSharedPtr> applications =
     service()->GetApplications(GetModuleID());
 
@@ -441,6 +451,7 @@ void CANModule::RemoveAppExtensions() {
 }
 
 void CANModule::RemoveAppExtension(uint32_t app_id) {
+  RemoveInteriorVehicleDataSubscriber(app_id);
   application_manager::ApplicationSharedPtr app = service()->GetApplication(
         app_id);
 
@@ -503,10 +514,12 @@ void CANModule::OnDeviceRemoved(
   }
 }
 
-void CANModule::UnsubscribeAppForAllZones(uint32_t hmi_app_id,
-                                          CANAppExtensionPtr app) {
+void CANModule::UnsubscribeAppForAllZones(
+    application_manager::ApplicationSharedPtr application,
+    CANAppExtensionPtr app) {
   LOG4CXX_AUTO_TRACE(logger_);
-  std::set<Json::Value>::iterator iter =
+  RemoveInteriorVehicleDataSubscriber(application->app_id());
+  std::map<std::string, Json::Value>::iterator iter =
       app->subscribed_interior_vehicle_data_.begin();
   for (;iter != app->subscribed_interior_vehicle_data_.end();) {
 
@@ -519,9 +532,9 @@ void CANModule::UnsubscribeAppForAllZones(uint32_t hmi_app_id,
     msg[kMethod] =
         hmi_api::get_interior_vehicle_data;
 
-    msg[kParams][message_params::kModuleDescription] = *iter;
+    msg[kParams][message_params::kModuleDescription] = iter->second;
 
-    msg[kParams][json_keys::kAppId] = hmi_app_id;
+    msg[kParams][json_keys::kAppId] = application->hmi_app_id();
 
     msg[kParams][message_params::kSubscribe] = false;
 
@@ -554,12 +567,76 @@ void CANModule::UnsubscribeAppsFromAllInteriorZones(uint32_t  device_id) {
         CANAppExtensionPtr can_app_extension =
             application_manager::AppExtensionPtr::static_pointer_cast<CANAppExtension>(
                 app_extension);
-        UnsubscribeAppForAllZones(applications[i]->hmi_app_id(),
+        UnsubscribeAppForAllZones(applications[i],
                                   can_app_extension);
       }
     }
   }
 }
 
-}  //  namespace can_cooperation
+void CANModule::SubscribeToInteriorVehicleData(
+    application_manager::ApplicationSharedPtr app,
+    const Json::Value& module_description) {
+  DCHECK(app);
+  CANAppExtensionPtr extension =
+    application_manager::AppExtensionPtr::static_pointer_cast<CANAppExtension>(
+      app->QueryInterface(GetModuleID()));
+  if (!extension) {
+    LOG4CXX_ERROR(logger_, "Application " << app->app_id()
+                  << " is not handled by module");
+    return;
+  }
+  extension->SubscribeToInteriorVehicleData(module_description);
+  sync_primitives::AutoLock lock(interior_vehicle_data_subscribers_lock_);
+  interior_vehicle_data_subscribers_[
+    MessageHelper::InteriorModuleKey(module_description)].insert(
+      app->app_id());
+}
 
+void CANModule::UnsubscribeFromInteriorVehicleData(
+    application_manager::ApplicationSharedPtr app,
+    const Json::Value& module_description) {
+  DCHECK(app);
+  CANAppExtensionPtr extension =
+    application_manager::AppExtensionPtr::static_pointer_cast<CANAppExtension>(
+      app->QueryInterface(GetModuleID()));
+  if (extension) {
+    extension->UnsubscribeFromInteriorVehicleData(module_description);
+  }
+  sync_primitives::AutoLock lock(interior_vehicle_data_subscribers_lock_);
+  SubscribersIndex::iterator it = interior_vehicle_data_subscribers_.find(
+      MessageHelper::InteriorModuleKey(module_description));
+  if (interior_vehicle_data_subscribers_.end() != it) {
+    it->second.erase(app->app_id());
+    if (it->second.empty()) {
+      interior_vehicle_data_subscribers_.erase(it);
+    }
+  }
+}
+
+std::vector<uint32_t> CANModule::InteriorVehicleDataSubscribers(
+    const Json::Value& module_description) {
+  const std::string key = MessageHelper::InteriorModuleKey(module_description);
+  sync_primitives::AutoLock lock(interior_vehicle_data_subscribers_lock_);
+  SubscribersIndex::const_iterator it =
+    interior_vehicle_data_subscribers_.find(key);
+  if (interior_vehicle_data_subscribers_.end() == it) {
+    return std::vector<uint32_t>();
+  }
+  return std::vector<uint32_t>(it->second.begin(), it->second.end());
+}
+
+void CANModule::RemoveInteriorVehicleDataSubscriber(uint32_t app_id) {
+  sync_primitives::AutoLock lock(interior_vehicle_data_subscribers_lock_);
+  SubscribersIndex::iterator it = interior_vehicle_data_subscribers_.begin();
+  while (interior_vehicle_data_subscribers_.end() != it) {
+    it->second.erase(app_id);
+    if (it->second.empty()) {
+      interior_vehicle_data_subscribers_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  //  namespace can_cooperation
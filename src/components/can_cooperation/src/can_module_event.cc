@@ -36,9 +36,11 @@
 namespace can_cooperation {
 
 CanModuleEvent::CanModuleEvent(application_manager::MessagePtr& message,
-                               const std::string& id)
+                               const std::string& id,
+                               const Json::Value& value)
 : event_engine::Event<application_manager::MessagePtr,
-                      std::string>(message, id) {
+                      std::string>(message, id),
+  value_(value) {
 }
 
 
@@ -57,4 +59,8 @@ int32_t CanModuleEvent::event_message_type() const {
   return event_message_->type();
 }
 
+const Json::Value& CanModuleEvent::event_message_value() const {
+  return value_;
+}
+
 }  //  namespace can_cooperation
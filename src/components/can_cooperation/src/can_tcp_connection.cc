@@ -33,10 +33,14 @@
 #include "can_cooperation/can_tcp_connection.h"
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <limits.h>
+#include <algorithm>
 #include <cstring>
+#include <vector>
 #include "json/json.h"
 #include "utils/logger.h"
 #include "utils/threads/thread.h"
@@ -47,6 +51,39 @@ namespace can_cooperation {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "CANTCPConnection")
 
+namespace {
+// Oldest messages are dropped when more are pending while disconnected
+const size_t kMaxPendingMessages = 1000;
+// Read data without complete message is dropped when it grows bigger
+const size_t kMaxIncomingSize = 1024 * 1024;
+const int32_t kMinReconnectDelayMs = 1000;
+const int32_t kMaxReconnectDelayMs = 32000;
+
+bool WriteChunks(int socket, std::vector<iovec>* chunks) {
+  size_t first = 0;
+  while (first < chunks->size()) {
+    const int count = static_cast<int>(
+        std::min<size_t>(chunks->size() - first, IOV_MAX));
+    ssize_t written = writev(socket, &(*chunks)[first], count);
+    if (-1 == written) {
+      return false;
+    }
+    // Skip completely written chunks and rest of partially written one
+    while (first < chunks->size() &&
+           static_cast<size_t>(written) >= (*chunks)[first].iov_len) {
+      written -= (*chunks)[first].iov_len;
+      ++first;
+    }
+    if (first < chunks->size()) {
+      iovec& chunk = (*chunks)[first];
+      chunk.iov_base = static_cast<char*>(chunk.iov_base) + written;
+      chunk.iov_len -= written;
+    }
+  }
+  return true;
+}
+}  // namespace
+
 class TCPClientDelegate : public threads::ThreadDelegate {
  public:
   explicit TCPClientDelegate(CANTCPConnection* can_connection);
@@ -54,10 +91,16 @@ class TCPClientDelegate : public threads::ThreadDelegate {
   void threadMain();
   void exitThreadMain();
  private:
+  /**
+   * @brief Waits before next connection attempt
+   * @return false if thread was stopped meanwhile
+   */
+  bool WaitReconnect(int32_t delay_ms);
   CANTCPConnection* can_connection_;
   volatile bool stop_flag_;
   mutable sync_primitives::Lock stop_flag_lock_;
   mutable sync_primitives::ConditionalVariable stop_flag_cond_;
+  sync_primitives::ConditionalVariable reconnect_cond_;
 };
 
 CANTCPConnection::CANTCPConnection()
@@ -100,8 +143,15 @@ CANTCPConnection::~CANTCPConnection() {
 }
 
 ConnectionState CANTCPConnection::SendMessage(const CANMessage& message) {
-  if (INVALID != current_state_) {
-    to_send_.push_back(message);
+  {
+    sync_primitives::AutoLock lock(to_send_lock_);
+    if (INVALID != current_state_) {
+      if (to_send_.size() >= kMaxPendingMessages) {
+        LOG4CXX_WARN(logger_, "Too many messages to CAN, oldest is dropped");
+        to_send_.pop_front();
+      }
+      to_send_.push_back(message);
+    }
   }
   return Flash();
 }
@@ -113,12 +163,19 @@ ConnectionState CANTCPConnection::ReadMessage(CANMessage* message) {
       LOG4CXX_ERROR(logger_, "Nul-pointer provided");
       return current_state_;
     }
-    std::string data;
-    const int kSize = 500;
-    int read_chars = 0;
-    do {
-      char buf[kSize] = {0};
-      read_chars = read(socket_, buf, sizeof(buf));
+    const int kSize = 4096;
+    std::string frame;
+    while (OPENED == current_state_) {
+      if (TakeFrame(&frame)) {
+        Json::Reader reader;
+        if (reader.parse(frame, *message, false)) {
+          break;
+        }
+        LOG4CXX_ERROR(logger_, "Failed to parse incoming message from CAN ");
+        continue;
+      }
+      char buf[kSize];
+      const ssize_t read_chars = read(socket_, buf, sizeof(buf));
       switch (read_chars) {
         case 0:  // closed connection
           current_state_ = CLOSED;
@@ -127,23 +184,52 @@ ConnectionState CANTCPConnection::ReadMessage(CANMessage* message) {
           current_state_ = INVALID;
           break;
         default:
-          data.append(buf, read_chars);
+          incoming_.append(buf, read_chars);
           break;
       }
-    } while (read_chars >= kSize && OPENED == current_state_);
-    if (!data.empty()) {
-      Json::Reader reader;
-      Json::Value value;
-      if (reader.parse(data, value, false)) {
-        *message = value;
-      } else {
-        LOG4CXX_ERROR(logger_, "Failed to parse incoming message from CAN ");
-      }
     }
   }
   return current_state_;
 }
 
+bool CANTCPConnection::TakeFrame(std::string* frame) {
+  DCHECK(frame);
+  // Nothing but messages is expected between them
+  const size_t begin = incoming_.find('{');
+  if (std::string::npos == begin) {
+    incoming_.clear();
+    return false;
+  }
+  int depth = 0;
+  bool in_string = false;
+  bool escaped = false;
+  for (size_t i = begin; i < incoming_.size(); ++i) {
+    const char c = incoming_[i];
+    if (in_string) {
+      if (escaped) {
+        escaped = false;
+      } else if ('\\' == c) {
+        escaped = true;
+      } else if ('"' == c) {
+        in_string = false;
+      }
+    } else if ('"' == c) {
+      in_string = true;
+    } else if ('{' == c) {
+      ++depth;
+    } else if ('}' == c && 0 == --depth) {
+      frame->assign(incoming_, begin, i + 1 - begin);
+      incoming_.erase(0, i + 1);
+      return true;
+    }
+  }
+  if (incoming_.size() > kMaxIncomingSize) {
+    LOG4CXX_ERROR(logger_, "Too long incoming message from CAN is dropped");
+    incoming_.clear();
+  }
+  return false;
+}
+
 ConnectionState CANTCPConnection::OpenConnection() {
   if (INVALID != current_state_) {
     struct sockaddr_in server_addr;
@@ -162,20 +248,46 @@ ConnectionState CANTCPConnection::OpenConnection() {
 }
 
 ConnectionState CANTCPConnection::CloseConnection() {
+  // Unblocks reading thread
+  shutdown(socket_, SHUT_RDWR);
   if (-1 == close(socket_)) {
     current_state_ = INVALID;
   } else {
     current_state_ = CLOSED;
   }
+  socket_ = -1;
   return current_state_;
 }
 
+ConnectionState CANTCPConnection::Reconnect() {
+  sync_primitives::AutoLock lock(to_send_lock_);
+  if (-1 != socket_) {
+    close(socket_);
+  }
+  incoming_.clear();
+  socket_ = socket(AF_INET, SOCK_STREAM, 0);
+  current_state_ = -1 == socket_ ? INVALID : NONE;
+  return OpenConnection();
+}
+
 ConnectionState CANTCPConnection::Flash() {
+  sync_primitives::AutoLock lock(to_send_lock_);
   if (OPENED == current_state_ && to_send_.size() > 0) {
+    // All pending messages are sent with single call
     Json::FastWriter writer;
-    std::string msg = writer.write(to_send_.front());
-    to_send_.pop_front();
-    if (-1 == write(socket_, msg.c_str(), msg.size())) {
+    std::vector<std::string> frames;
+    frames.reserve(to_send_.size());
+    for (std::deque<CANMessage>::const_iterator it = to_send_.begin();
+         to_send_.end() != it; ++it) {
+      frames.push_back(writer.write(*it));
+    }
+    to_send_.clear();
+    std::vector<iovec> chunks(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+      chunks[i].iov_base = const_cast<char*>(frames[i].data());
+      chunks[i].iov_len = frames[i].size();
+    }
+    if (!WriteChunks(socket_, &chunks)) {
       current_state_ = INVALID;
       CloseConnection();
     }
@@ -196,6 +308,7 @@ TCPClientDelegate::~TCPClientDelegate() {
 }
 
 void TCPClientDelegate::threadMain() {
+  int32_t reconnect_delay_ms = kMinReconnectDelayMs;
   while (!stop_flag_) {
     Json::Value message_from_can;
     while (can_connection_->ReadMessage(&message_from_can) ==
@@ -220,15 +333,36 @@ void TCPClientDelegate::threadMain() {
       }
       can_connection_->observer_->OnCANConnectionError(
         can_connection_->current_state_, info);
+      if (!WaitReconnect(reconnect_delay_ms)) {
+        break;
+      }
+      if (ConnectionState::OPENED == can_connection_->Reconnect()) {
+        LOG4CXX_INFO(logger_, "Connection with CAN-bus module is restored");
+        reconnect_delay_ms = kMinReconnectDelayMs;
+        can_connection_->Flash();
+      } else {
+        reconnect_delay_ms =
+          std::min(2 * reconnect_delay_ms, kMaxReconnectDelayMs);
+      }
     }
   }
   stop_flag_cond_.NotifyOne();
 }
 
+bool TCPClientDelegate::WaitReconnect(int32_t delay_ms) {
+  sync_primitives::AutoLock run_lock(stop_flag_lock_);
+  if (stop_flag_) {
+    return false;
+  }
+  reconnect_cond_.WaitFor(run_lock, delay_ms);
+  return !stop_flag_;
+}
+
 void TCPClientDelegate::exitThreadMain() {
   if (stop_flag_) return;
   sync_primitives::AutoLock run_lock(stop_flag_lock_);
   stop_flag_ = true;
+  reconnect_cond_.NotifyOne();
   sync_primitives::ConditionalVariable::WaitStatus wait_status =
   stop_flag_cond_.WaitFor(run_lock, 10000);
   if (sync_primitives::ConditionalVariable::kTimeout ==
@@ -35,6 +35,7 @@
 #include "can_cooperation/event_engine/event_dispatcher.h"
 #include "can_cooperation/message_helper.h"
 #include "can_cooperation/can_module.h"
+#include "can_cooperation/can_module_event.h"
 #include "can_cooperation/can_module_constants.h"
 
 namespace can_cooperation {
@@ -283,6 +284,13 @@ CANAppExtensionPtr BaseCommandRequest::GetAppExtension(
   return can_app_extension;
 }
 
+const Json::Value& BaseCommandRequest::EventMessageValue(
+    const event_engine::Event<application_manager::MessagePtr,
+    std::string>& event) const {
+  // Module raises only its own events carrying message parsed already
+  return static_cast<const CanModuleEvent&>(event).event_message_value();
+}
+
 bool BaseCommandRequest::ParseResultCode(const Json::Value& value,
     std::string& result_code,
     std::string& info) {
@@ -483,8 +491,7 @@ void BaseCommandRequest::UpdateHMILevel(
     return;
   }
   if (!extension->is_on_driver_device()) {
-    Json::Value value  = MessageHelper::StringToValue(
-        event.event_message()->json_message());
+    const Json::Value& value = EventMessageValue(event);
     std::string result_code;
     std::string info;
     bool success = ParseResultCode(value, result_code, info);
@@ -501,9 +508,7 @@ void BaseCommandRequest::ProcessAccessResponse(
     SendResponse(false, result_codes::kApplicationNotRegistered, "");
     return;
   }
-  Json::Value value;
-  Json::Reader reader;
-  reader.parse(event.event_message()->json_message(), value);
+  const Json::Value& value = EventMessageValue(event);
 
   std::string result_code;
   std::string info;
@@ -520,8 +525,8 @@ void BaseCommandRequest::ProcessAccessResponse(
 
   // Check the actual User's answer.
   if (allowed) {
-    Json::Value request;
-    reader.parse(message_->json_message(), request);
+    Json::Value request = MessageHelper::StringToValue(
+        message_->json_message());
     std::string module = ModuleType(request);
     LOG4CXX_DEBUG(
         logger_,
@@ -72,9 +72,7 @@ void ButtonPressRequest::OnEvent(
     std::string result_code;
     std::string info;
 
-    Json::Value value;
-    Json::Reader reader;
-    reader.parse(event.event_message()->json_message(), value);
+    const Json::Value& value = EventMessageValue(event);
 
     bool success = ParseResultCode(value, result_code, info);
 
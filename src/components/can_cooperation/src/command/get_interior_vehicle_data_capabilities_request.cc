@@ -106,9 +106,7 @@ void GetInteriorVehicleDataCapabiliesRequest::OnEvent(
     std::string result_code;
     std::string info;
 
-    Json::Value value;
-    Json::Reader reader;
-    reader.parse(event.event_message()->json_message(), value);
+    const Json::Value& value = EventMessageValue(event);
 
     bool success = ParseResultCode(value, result_code, info);
 
@@ -70,7 +70,7 @@ void GetInteriorVehicleDataRequest::OnEvent(
     std::string result_code;
     std::string info;
 
-    Json::Value value  = MessageHelper::StringToValue(event.event_message()->json_message());
+    const Json::Value& value = EventMessageValue(event);
 
     bool success = ParseResultCode(value, result_code, info);
 
@@ -115,14 +115,14 @@ void GetInteriorVehicleDataRequest::ProccessSubscription() {
         response_params_[kIsSubscribed] = true;
       }
     } else {
-      CANAppExtensionPtr extension = GetAppExtension(app());
-
       bool isSubscribed = response_params_[kIsSubscribed].asBool();
 
       if (subscribe && isSubscribed) {
-        extension->SubscribeToInteriorVehicleData(params[kModuleDescription]);
+        CANModule::instance()->SubscribeToInteriorVehicleData(
+            app(), params[kModuleDescription]);
       } else if ((!subscribe) && (!isSubscribed)) {
-        extension->UnsubscribeFromInteriorVehicleData(params[kModuleDescription]);
+        CANModule::instance()->UnsubscribeFromInteriorVehicleData(
+            app(), params[kModuleDescription]);
       }
     }
   } else {
@@ -70,21 +70,14 @@ void OnInteriorVehicleDataNotification::Execute() {
   moduleDescription[message_params::kModuleZone] =
       json[message_params::kModuleData][message_params::kModuleZone];
 
-  std::vector<application_manager::ApplicationSharedPtr> applications =
-      service_->GetApplications(CANModule::instance()->GetModuleID());
-
-  for (size_t i = 0; i < applications.size(); ++i) {
-    CANAppExtensionPtr extension =
-      application_manager::AppExtensionPtr::static_pointer_cast<CANAppExtension>(
-        applications[i]->QueryInterface(CANModule::instance()->GetModuleID()));
-    DCHECK(extension);
-
-    if (extension->IsSubscibedToInteriorVehicleData(moduleDescription)) {
-      msg->set_connection_key(applications[i]->app_id());
-      application_manager::MessagePtr message(
-          new application_manager::Message(*msg));
-      NotifyOneApplication(message);
-    }
+  const std::vector<uint32_t> subscribers =
+      CANModule::instance()->InteriorVehicleDataSubscribers(moduleDescription);
+
+  for (size_t i = 0; i < subscribers.size(); ++i) {
+    msg->set_connection_key(subscribers[i]);
+    application_manager::MessagePtr message(
+        new application_manager::Message(*msg));
+    NotifyOneApplication(message);
   }
 }
 
@@ -79,9 +79,7 @@ void SetInteriorVehicleDataRequest::OnEvent(
     std::string result_code;
     std::string info;
 
-    Json::Value value;
-    Json::Reader reader;
-    reader.parse(event.event_message()->json_message(), value);
+    const Json::Value& value = EventMessageValue(event);
 
     bool success = false;
     if (IsMember(value, kError) && IsMember(value[kError], kCode) &&
@@ -31,6 +31,7 @@
  */
 
 #include <string>
+#include <sstream>
 #include "can_cooperation/message_helper.h"
 #include "can_cooperation/can_module_constants.h"
 
@@ -119,4 +120,22 @@ bool MessageHelper::ValidateInteriorZone(const Json::Value& value) {
       && value[message_params::kLevel].isInt();
 }
 
+std::string MessageHelper::InteriorModuleKey(
+    const Json::Value& module_description) {
+  const Json::Value& zone = module_description.get(
+      message_params::kModuleZone, Json::Value(Json::objectValue));
+  const char* const kZoneFields[] = {
+    message_params::kCol, message_params::kRow, message_params::kLevel,
+    message_params::kColspan, message_params::kRowspan,
+    message_params::kLevelspan
+  };
+  std::stringstream key;
+  key << module_description.get(message_params::kModuleType,
+                                Json::Value("")).asString();
+  for (size_t i = 0; i < ARRAYSIZE(kZoneFields); ++i) {
+    key << ':' << zone.get(kZoneFields[i], Json::Value(-1)).asInt();
+  }
+  return key.str();
+}
+
 }  // namespace can_cooperation
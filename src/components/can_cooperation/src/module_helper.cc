@@ -200,7 +200,7 @@ void ModuleHelper::ProccessDeviceRankChanged(const uint32_t device_handle,
             is_rank_actually_changed = true;
 
             CANModule::instance()->UnsubscribeAppForAllZones(
-                applications[i]->hmi_app_id(), can_app_extension);
+                applications[i], can_app_extension);
           }
         }
       }
@@ -217,7 +217,7 @@ void ModuleHelper::ProccessDeviceRankChanged(const uint32_t device_handle,
                   app_extension);
             if (can_app_extension->is_on_driver_device()) {
               CANModule::instance()->UnsubscribeAppForAllZones(
-                  applications[i]->hmi_app_id(), can_app_extension);
+                  applications[i], can_app_extension);
               can_app_extension->set_is_on_driver_device(false);
             }
           }
@@ -236,7 +236,7 @@ void ModuleHelper::ProccessDeviceRankChanged(const uint32_t device_handle,
                    app_extension);
            if (can_app_extension->is_on_driver_device()) {
              CANModule::instance()->UnsubscribeAppForAllZones(
-                 applications[i]->hmi_app_id(), can_app_extension);
+                 applications[i], can_app_extension);
              can_app_extension->set_is_on_driver_device(false);
            }
          }
@@ -260,7 +260,7 @@ void ModuleHelper::ProccessOnReverseAppsDisallowed () {
               app_extension);
       if (!can_app_extension->is_on_driver_device()) {
         CANModule::instance()->UnsubscribeAppForAllZones(
-            applications[i]->hmi_app_id(), can_app_extension);
+            applications[i], can_app_extension);
       }
     }
   }
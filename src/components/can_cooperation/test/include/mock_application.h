@@ -165,6 +165,8 @@ class MockApplication : public Application {
       bool(uint32_t vehicle_info_type_));
   MOCK_METHOD1(UnsubscribeFromIVI,
       bool(uint32_t vehicle_info_type_));
+  MOCK_METHOD1(set_subscriptions_observer,
+      void(application_manager::SubscriptionsObserver* observer));
   MOCK_METHOD2(IsCommandLimitsExceeded,
       bool(mobile_apis::FunctionID::eType cmd_id, TLimitSource source));
   MOCK_METHOD0(usage_report,
@@ -251,6 +253,12 @@ class MockApplication : public Application {
       void(uint32_t choice_set_id));
   MOCK_METHOD1(FindChoiceSet,
       smart_objects::SmartObject*(uint32_t choice_set_id));
+  MOCK_CONST_METHOD1(IsChoiceIdAlreadyExist,
+      bool(uint32_t choice_id));
+  MOCK_METHOD2(set_choice_set_cached_on_hmi,
+      void(uint32_t choice_set_id, bool cached));
+  MOCK_CONST_METHOD1(is_choice_set_cached_on_hmi,
+      bool(uint32_t choice_set_id));
   MOCK_METHOD2(AddPerformInteractionChoiceSet,
       void(uint32_t choice_set_id, const smart_objects::SmartObject& choice_set));
   MOCK_METHOD0(DeletePerformInteractionChoiceSetMap,
@@ -265,6 +273,12 @@ class MockApplication : public Application {
       DataAccessor<SubMenuMap>());
   MOCK_CONST_METHOD0(choice_set_map,
       DataAccessor<ChoiceSetMap>());
+  MOCK_CONST_METHOD0(commands_version,
+      uint32_t());
+  MOCK_CONST_METHOD0(sub_menu_version,
+      uint32_t());
+  MOCK_CONST_METHOD0(choice_set_version,
+      uint32_t());
   MOCK_METHOD1(set_perform_interaction_active,
       void(uint32_t active));
   MOCK_CONST_METHOD0(is_perform_interaction_active,
@@ -122,10 +122,6 @@ TEST_F(CanModuleTest, ProcessMessageEmptyAppsList) {
                         \"rowspan\": 2, \"levelspan\": 1}, \"climateControlData\": {\"fanSpeed\": 100} }}}";
   message->set_json_message(json);
 
-  std::vector<application_manager::ApplicationSharedPtr> apps;
-
-  EXPECT_CALL(*mock_service, GetApplications(module->GetModuleID())
-    ).WillOnce(Return(apps));
   EXPECT_CALL(*mock_service, SendMessageToMobile(_)).Times(0);
   EXPECT_EQ(ProcessResult::PROCESSED, module->ProcessMessage(message));
 }
@@ -158,10 +154,10 @@ TEST_F(CanModuleTest, ProcessMessagePass) {
   application_manager::ApplicationSharedPtr app_ptr(app);
   apps.push_back(app_ptr);
   CANAppExtension* ext = new CANAppExtension(module->GetModuleID());
-  ext->SubscribeToInteriorVehicleData(moduleDescription);
   EXPECT_CALL(*app, QueryInterface(module->GetModuleID())).
       WillRepeatedly(Return(ext));
   EXPECT_CALL(*app, app_id()).WillRepeatedly(Return(1));
+  module->SubscribeToInteriorVehicleData(app_ptr, moduleDescription);
   EXPECT_CALL(*mock_service, GetApplications(module->GetModuleID())
     ).WillRepeatedly(Return(apps));
   EXPECT_CALL(*mock_service, GetApplication(1)).Times(1)
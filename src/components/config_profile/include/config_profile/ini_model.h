@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_CONFIG_PROFILE_INCLUDE_CONFIG_PROFILE_INI_MODEL_H_
+#define SRC_COMPONENTS_CONFIG_PROFILE_INCLUDE_CONFIG_PROFILE_INI_MODEL_H_
+
+#include <map>
+#include <string>
+#include "utils/macro.h"
+
+namespace profile {
+
+/**
+ * @brief Items of ini-file parsed in one pass and kept in memory.
+ * Chapters and items are looked up regardless of case and only the first
+ * chapter and item of the same name are significant, same as for
+ * ini_read_value
+ */
+class IniModel {
+ public:
+  IniModel();
+
+  /**
+   * @brief Parses file replacing all previously loaded items
+   * @param file_name Path to ini-file
+   * @return false if file could not be opened, model is empty then
+   */
+  bool Load(const std::string& file_name);
+
+  /**
+   * @brief Returns path to file loaded last
+   */
+  const std::string& file_name() const;
+
+  /**
+   * @brief Looks up value of item of the specified chapter
+   * @param chapter Chapter name
+   * @param item Item name
+   * @param value Found value
+   * @return false if chapter or item not found (then value is not changed)
+   */
+  bool Find(const char* chapter, const char* item, std::string* value) const;
+
+  /**
+   * @brief Exchanges contents with other model
+   */
+  void Swap(IniModel& other);
+
+ private:
+  typedef std::map<std::string, std::string> Items;
+  typedef std::map<std::string, Items> Chapters;
+
+  std::string file_name_;
+  Chapters chapters_;
+  DISALLOW_COPY_AND_ASSIGN(IniModel);
+};
+
+}  // namespace profile
+
+#endif  // SRC_COMPONENTS_CONFIG_PROFILE_INCLUDE_CONFIG_PROFILE_INI_MODEL_H_
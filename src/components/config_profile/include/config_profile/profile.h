@@ -39,12 +39,36 @@
 #include <list>
 #include "utils/macro.h"
 #include "utils/singleton.h"
+#include "utils/lock.h"
+#include "utils/threads/thread_profiles.h"
+#include "config_profile/ini_model.h"
+
+namespace threads {
+class Thread;
+}  // namespace threads
 
 namespace profile {
 
 /**
  * The Profile class
  */
+/**
+ * @brief Immutable copy of tunables read on per-message paths. Snapshot is
+ * published as a whole, so its values are consistent with each other while
+ * ini file is reloaded. Published snapshots live as long as Profile, so
+ * reference to snapshot stays valid after reload.
+ */
+struct ProfileSnapshot {
+  uint32_t default_timeout;
+  uint32_t app_time_scale;
+  uint32_t app_time_scale_max_requests;
+  uint32_t app_hmi_level_none_time_scale;
+  uint32_t app_hmi_level_none_time_scale_max_requests;
+  uint32_t pending_requests_amount;
+  uint32_t put_file_in_none;
+  uint32_t hash_string_size;
+} __attribute__((aligned(64)));
+
 class Profile : public utils::Singleton<Profile> {
   public:
     // Methods section
@@ -62,6 +86,12 @@ class Profile : public utils::Singleton<Profile> {
       */
     bool launch_hmi() const;
 
+    /**
+     * @brief Returns latest snapshot of tunables read on per-message paths,
+     * caller reads all of them after single load
+     */
+    const ProfileSnapshot& snapshot() const;
+
     /**
       * @brief Returns application configuration path
       */
@@ -138,6 +168,30 @@ class Profile : public utils::Singleton<Profile> {
       */
     const uint16_t& time_testing_port() const;
 
+    /**
+      * @brief Returns true if time reports are streamed as binary records
+      * instead of JSON documents
+      */
+    bool time_testing_binary_format() const;
+
+    /**
+      * @brief Returns period in seconds of writing metrics aggregates
+      * to log, 0 disables it
+      */
+    uint32_t metrics_dump_period() const;
+
+    /**
+      * @brief Returns period in seconds of sampling per-thread CPU time,
+      * allocator, message queues and open files, 0 disables it
+      */
+    uint32_t resource_sampling_period() const;
+
+    /**
+      * @brief Returns limit in kilobytes of memory SDL holds for
+      * one application, 0 disables it
+      */
+    uint32_t app_memory_quota() const;
+
     /**
      * @brief Returns hmi capabilities file name
      */
@@ -328,11 +382,105 @@ class Profile : public utils::Singleton<Profile> {
       */
     const std::string& plugins_folder() const;
 
+    /**
+      * @brief Returns seconds after which idle module of plugin created
+      * on demand is destroyed, 0 keeps such modules till exit
+      */
+    uint32_t plugin_idle_timeout() const;
+
+    /**
+      * @brief Returns profiles of thread roles from Threads section,
+      * paired with every thread name prefix of role
+      */
+    threads::ThreadProfiles::Profiles thread_profiles() const;
+
     /**
      * @brief Returns port for TCP transport adapter
      */
     uint16_t transport_manager_tcp_adapter_port() const;
 
+    /**
+     * @brief Returns maximum frame size for TCP transport adapter,
+     * 0 if protocol default is to be used
+     */
+    uint32_t transport_manager_tcp_adapter_maximum_frame_size() const;
+
+    /**
+     * @brief Returns true if incoming TCP connections are served
+     * by single event loop thread instead of thread per connection
+     */
+    bool transport_manager_tcp_adapter_event_loop() const;
+
+    /**
+     * @brief Returns time in seconds connection of lost TCP link is kept
+     * to be restored by the same device reconnecting, 0 if it is not kept
+     */
+    uint32_t transport_manager_tcp_adapter_reconnect_grace_period() const;
+
+    /**
+     * @brief Returns file raw frames sent and received by transport
+     * manager are captured to, empty if capture is off
+     */
+    const std::string& transport_manager_traffic_capture_file() const;
+
+    /**
+     * @brief Returns capture file replayed by replay transport adapter,
+     * empty if the adapter is not used
+     */
+    const std::string& transport_manager_replay_capture_file() const;
+
+    /**
+     * @brief Returns weight of connection share in sending of frames by
+     * transport manager, device weight overrides weight of its transport
+     * @param transport_type type of transport adapter, e.g. "sdl-tcp"
+     * @param device_uid unique id of device
+     */
+    uint32_t transport_manager_send_weight(const std::string& transport_type,
+                                           const std::string& device_uid) const;
+
+    /**
+     * @brief Returns true if captured frames are replayed with their
+     * original timing, false if as fast as possible
+     */
+    bool transport_manager_replay_real_time() const;
+
+    /**
+     * @brief Returns maximum frame size for USB AOA transport adapter,
+     * 0 if protocol default is to be used
+     */
+    uint32_t transport_manager_aoa_adapter_maximum_frame_size() const;
+
+    /**
+     * @brief Returns count of bulk transfers USB AOA transport adapter
+     * keeps submitted at once for each direction of connection
+     */
+    uint32_t transport_manager_aoa_adapter_transfers_count() const;
+
+    /**
+     * @brief Returns maximum frame size for Bluetooth transport adapter,
+     * 0 if protocol default is to be used
+     */
+    uint32_t transport_manager_bluetooth_adapter_maximum_frame_size() const;
+
+    /**
+     * @brief Returns true if Bluetooth devices are queried for
+     * SDL service concurrently instead of one by one
+     */
+    bool transport_manager_bluetooth_adapter_async_discovery() const;
+
+    /**
+     * @brief Returns send and receive buffer sizes of RFCOMM sockets,
+     * 0 if system default is to be used
+     */
+    uint32_t transport_manager_bluetooth_adapter_send_buffer_size() const;
+    uint32_t transport_manager_bluetooth_adapter_receive_buffer_size() const;
+
+    /**
+     * @brief Returns priority of RFCOMM sockets (0 - 6), Bluetooth stack
+     * schedules ACL data of higher priority sockets first
+     */
+    uint32_t transport_manager_bluetooth_adapter_socket_priority() const;
+
     /**
      * @brief Returns value of timeout after which sent
      * tts global properties for VCA
@@ -433,6 +581,36 @@ class Profile : public utils::Singleton<Profile> {
      */
     const std::string& recording_file_name() const;
 
+    /**
+     * @brief Returns interval in milliseconds recorded audio is sent
+     * to mobile with during audio pass thru
+     */
+    uint32_t audio_pass_thru_chunk_interval() const;
+
+    /**
+     * @brief Returns milliseconds of audio buffered by A2DP source player
+     * in each direction, 0 if PulseAudio defaults are used
+     */
+    uint32_t a2dp_latency() const;
+
+    /**
+     * @brief Returns maximal count of frames queued for streamer,
+     * 0 if unlimited
+     */
+    uint32_t stream_queue_max_frames() const;
+
+    /**
+     * @brief Returns maximal size in bytes of frames queued for streamer,
+     * 0 if unlimited
+     */
+    uint32_t stream_queue_max_bytes() const;
+
+    /**
+     * @brief Returns size in bytes stream file is rotated at,
+     * 0 if it grows unlimited
+     */
+    uint32_t stream_file_max_size() const;
+
     const std::string& mme_db_name() const;
 
     const std::string& event_mq_name() const;
@@ -452,6 +630,32 @@ class Profile : public utils::Singleton<Profile> {
      */
     uint32_t thread_pool_size() const;
 
+    /**
+     * @brief Returns number of threads parsing messages from mobile
+     * in parallel for different applications, 0 if messages are parsed
+     * on the thread handling them
+     */
+    uint32_t from_mobile_parsing_threads() const;
+
+    /**
+     * @brief Returns true if pending notification to mobile is replaced
+     * by newer one of the same application superseding it
+     */
+    bool coalesce_mobile_notifications() const;
+
+    /**
+     * @brief Returns delay in milliseconds changes of application and
+     * device lists are collected for before single update is sent to HMI,
+     * 0 if every change is sent right away
+     */
+    uint32_t hmi_list_update_delay() const;
+
+    /**
+     * @brief Returns true if choice sets are sent to HMI once on creation
+     * and PerformInteraction refers to them by ID
+     */
+    bool cache_choice_sets_on_hmi() const;
+
     uint32_t default_hub_protocol_index() const;
 
     const std::string& iap_legacy_protocol_mask() const;
@@ -486,10 +690,58 @@ class Profile : public utils::Singleton<Profile> {
 
     size_t malformed_frequency_time() const;
 
+    /**
+     * @brief Returns true if audio and video frames are handled right on
+     * receiving instead of being queued with other protocol messages
+     */
+    bool media_fast_lane() const;
+
+    /**
+     * @brief Returns number of threads decrypting protected frames,
+     * 0 means frames are decrypted on transport thread
+     */
+    uint32_t decryption_threads() const;
+
+    /**
+     * @brief Returns number of threads handling frames from mobile,
+     * frames of one connection are always handled on the same thread
+     */
+    uint32_t from_mobile_threads() const;
+
+    /**
+     * @brief Returns true if protected messages bigger than one frame are
+     * encrypted at once into full size records, which are split into frames
+     */
+    bool encrypt_whole_messages() const;
+
+    /**
+     * @brief Returns true if SDL accepts compression of RPC and bulk
+     * payloads offered by mobile side at start of service
+     */
+    bool payload_compression() const;
+
+    /**
+     * @brief Returns deflate level (1 - fastest, 9 - smallest) of payloads
+     * sent in compressed services
+     */
+    uint32_t payload_compression_level() const;
+
     uint16_t attempts_to_open_policy_db() const;
 
     uint16_t open_attempt_timeout_ms() const;
 
+    /**
+     * @brief Returns synchronous level of policy DB write-ahead log
+     * (0 - OFF, 1 - NORMAL, 2 - FULL)
+     */
+    uint16_t policy_db_synchronous_level() const;
+
+    /**
+     * @brief Returns interval in seconds between stores of usage statistics
+     * collected in memory (0 - store on every change)
+     */
+    uint32_t usage_statistics_flush_interval() const;
+
     uint32_t resumption_delay_before_ign() const;
 
     uint32_t resumption_delay_after_ign() const;
@@ -498,11 +750,34 @@ class Profile : public utils::Singleton<Profile> {
 
     bool logs_enabled() const;
 
+    /**
+     * @brief Returns file for binary log, empty if log4cxx appenders
+     * have to be used directly
+     */
+    const std::string& binary_log_file() const;
+
+    /**
+     * @brief Returns unix socket path on which SDL hands its listening
+     * transports over to SDL started after it, empty disables it
+     */
+    const std::string& warm_restart_socket() const;
+
+    /**
+     * @brief Returns true if ini file has to be reloaded on its change
+     */
+    bool reload_config_on_change() const;
+
     /*
      * @brief Updates all related values from ini file
      */
     void UpdateValues();
 
+    /**
+     * @brief Parses ini file again and updates values which may change
+     * at runtime (limits of requests of applications)
+     */
+    void ReloadValues();
+
 
   private:
     /**
@@ -606,6 +881,27 @@ class Profile : public utils::Singleton<Profile> {
      */
     bool StringToNumber(const std::string& input, uint64_t& output) const;
 
+    /**
+     * @brief Looks up value in parsed ini file, parses it if not done yet
+     * @return false if value is not found (then the value is not changed)
+     */
+    bool ReadIniValue(std::string* value,
+                      const char* const pSection,
+                      const char* const pKey) const;
+
+    /**
+     * @brief Updates values which may change at runtime from ini file
+     */
+    void UpdateTunableValues();
+
+    void StartConfigWatch();
+    void StopConfigWatch();
+
+    /**
+     * @brief Publishes snapshot of current tunable values
+     */
+    void PublishSnapshot();
+
 private:
     bool                            launch_hmi_;
     std::string                     app_config_folder_;
@@ -660,14 +956,36 @@ private:
     std::string                     system_files_path_;
     std::string                     plugins_folder_;
     uint16_t                        transport_manager_tcp_adapter_port_;
+    uint32_t                        transport_manager_tcp_adapter_maximum_frame_size_;
+    uint32_t                        transport_manager_aoa_adapter_maximum_frame_size_;
+    uint32_t                        transport_manager_aoa_adapter_transfers_count_;
+    uint32_t                        transport_manager_bluetooth_adapter_maximum_frame_size_;
+    bool                            transport_manager_bluetooth_adapter_async_discovery_;
+    uint32_t                        transport_manager_bluetooth_adapter_send_buffer_size_;
+    uint32_t                        transport_manager_bluetooth_adapter_receive_buffer_size_;
+    uint32_t                        transport_manager_bluetooth_adapter_socket_priority_;
+    bool                            transport_manager_tcp_adapter_event_loop_;
+    uint32_t                        transport_manager_tcp_adapter_reconnect_grace_period_;
+    std::string                     transport_manager_traffic_capture_file_;
+    std::string                     transport_manager_replay_capture_file_;
+    bool                            transport_manager_replay_real_time_;
     std::string                     tts_delimiter_;
     std::string                     mme_db_name_;
     std::string                     event_mq_name_;
     std::string                     ack_mq_name_;
     std::string                     recording_file_source_;
     std::string                     recording_file_name_;
+    uint32_t                        audio_pass_thru_chunk_interval_;
+    uint32_t                        a2dp_latency_;
+    uint32_t                        stream_queue_max_frames_;
+    uint32_t                        stream_queue_max_bytes_;
+    uint32_t                        stream_file_max_size_;
     uint32_t                        application_list_update_timeout_;
     uint32_t                        max_thread_pool_size_;
+    uint32_t                        from_mobile_parsing_threads_;
+    bool                            coalesce_mobile_notifications_;
+    uint32_t                        hmi_list_update_delay_;
+    bool                            cache_choice_sets_on_hmi_;
     uint32_t                        default_hub_protocol_index_;
     /*
      * first value is count of request
@@ -697,10 +1015,23 @@ private:
     uint16_t                        tts_global_properties_timeout_;
     uint16_t                        attempts_to_open_policy_db_;
     uint16_t                        open_attempt_timeout_ms_;
+    uint16_t                        policy_db_synchronous_level_;
+    uint32_t                        usage_statistics_flush_interval_;
     uint32_t                        resumption_delay_before_ign_;
     uint32_t                        resumption_delay_after_ign_;
     uint32_t                        hash_string_size_;
     bool                            logs_enabled_;
+    std::string                     binary_log_file_;
+    std::string                     warm_restart_socket_;
+    bool                            reload_config_on_change_;
+
+    mutable IniModel                ini_model_;
+    mutable sync_primitives::Lock   ini_model_lock_;
+    threads::Thread*                config_watch_thread_;
+    ProfileSnapshot*                snapshot_;
+    // All published snapshots, freed with Profile
+    std::vector<ProfileSnapshot*>   snapshots_;
+    sync_primitives::Lock           snapshots_lock_;
 
     FRIEND_BASE_SINGLETON_CLASS(Profile);
     DISALLOW_COPY_AND_ASSIGN(Profile);
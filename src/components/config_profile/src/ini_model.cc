@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config_profile/ini_model.h"
+
+#include <ctype.h>
+#include <stdio.h>
+
+#include "config_profile/ini_file.h"
+
+namespace profile {
+
+namespace {
+std::string ToUpper(const char* name) {
+  std::string upper(name);
+  for (std::string::iterator it = upper.begin(); it != upper.end(); ++it) {
+    *it = toupper(*it);
+  }
+  return upper;
+}
+}  // namespace
+
+IniModel::IniModel() {
+}
+
+bool IniModel::Load(const std::string& file_name) {
+  file_name_ = file_name;
+  chapters_.clear();
+
+  FILE* fp = fopen(file_name.c_str(), "r");
+  if (NULL == fp) {
+    return false;
+  }
+
+  char line[INI_LINE_LEN] = "";
+  char value[INI_LINE_LEN] = "";
+  // Items of the chapter being read, NULL for repeated chapters
+  // and for lines preceding the first chapter
+  Items* items = NULL;
+  while (NULL != fgets(line, INI_LINE_LEN, fp)) {
+    // Parsing against empty tag gives name of chapter or item,
+    // the same parser then gives value of the item
+    const Ini_search_id result = ini_parse_line(line, "", value);
+    if ((INI_RIGHT_CHAPTER == result) || (INI_WRONG_CHAPTER == result)) {
+      const std::pair<Chapters::iterator, bool> inserted =
+          chapters_.insert(std::make_pair(ToUpper(value), Items()));
+      items = inserted.second ? &inserted.first->second : NULL;
+    } else if (items &&
+               ((INI_RIGHT_ITEM == result) || (INI_WRONG_ITEM == result))) {
+      const std::string item = ToUpper(value);
+      if (INI_RIGHT_ITEM == ini_parse_line(line, item.c_str(), value)) {
+        items->insert(std::make_pair(item, std::string(value)));
+      }
+    }
+  }
+
+  fclose(fp);
+  return true;
+}
+
+const std::string& IniModel::file_name() const {
+  return file_name_;
+}
+
+bool IniModel::Find(const char* chapter, const char* item,
+                    std::string* value) const {
+  if ((NULL == chapter) || (NULL == item) || (NULL == value)) {
+    return false;
+  }
+  if (('\0' == *chapter) || ('\0' == *item)) {
+    return false;
+  }
+  const Chapters::const_iterator chapter_it =
+      chapters_.find(ToUpper(chapter));
+  if (chapters_.end() == chapter_it) {
+    return false;
+  }
+  const Items::const_iterator item_it =
+      chapter_it->second.find(ToUpper(item));
+  if (chapter_it->second.end() == item_it) {
+    return false;
+  }
+  *value = item_it->second;
+  return true;
+}
+
+void IniModel::Swap(IniModel& other) {
+  file_name_.swap(other.file_name_);
+  chapters_.swap(other.chapters_);
+}
+
+}  // namespace profile
@@ -38,10 +38,18 @@
 #include <sstream>
 #include <algorithm>
 
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif  // __linux__
+
 #include "config_profile/ini_file.h"
 #include "utils/logger.h"
 #include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
 #include "utils/file_system.h"
+#include "utils/atomic.h"
 
 namespace {
 #define LOG_UPDATED_VALUE(value, key, section) {\
@@ -72,17 +80,32 @@ const char* kIAPSection = "IAP";
 const char* kProtocolHandlerSection = "ProtocolHandler";
 const char* kSDL4Section = "SDL4";
 const char* kResumptionSection = "Resumption";
+const char* kThreadsSection = "Threads";
+
+// Threads are grouped by roles, <Role>Threads key lists prefixes of
+// names of role threads and <Role>Profile key holds their profile
+const char* kThreadRoles[] = {
+  "TransportIO",
+  "ProtocolHandler",
+  "ApplicationManager",
+  "Media",
+  "Background"
+};
 
 const char* kHmiCapabilitiesKey = "HMICapabilities";
 const char* kPathToSnapshotKey = "PathToSnapshot";
 const char* kPreloadedPTKey = "PreloadedPT";
 const char* kAttemptsToOpenPolicyDBKey = "AttemptsToOpenPolicyDB";
 const char* kOpenAttemptTimeoutMsKey = "OpenAttemptTimeoutMs";
+const char* kPolicyDBSynchronousLevelKey = "PolicyDBSynchronousLevel";
+const char* kUsageStatisticsFlushIntervalKey = "UsageStatisticsFlushInterval";
 const char* kServerAddressKey = "ServerAddress";
 const char* kAppInfoStorageKey = "AppInfoStorage";
 const char* kAppStorageFolderKey = "AppStorageFolder";
 const char* kAppResourseFolderKey = "AppResourceFolder";
 const char* kLogsEnabledKey = "LogsEnabled";
+const char* kBinaryLogFileKey = "BinaryLogFile";
+const char* kWarmRestartSocketKey = "WarmRestartSocket";
 const char* kAppConfigFolderKey = "AppConfigFolder";
 const char* kEnableProtocol4Key = "EnableProtocol4";
 const char* kAppIconsFolderKey = "AppIconsFolder";
@@ -106,14 +129,40 @@ const char* kHelpTitleKey = "HelpTitle";
 const char* kHelpCommandKey = "HelpCommand";
 const char* kSystemFilesPathKey = "SystemFilesPath";
 const char* kPluginsFolderKey = "PluginFolder";
+const char* kPluginIdleTimeoutKey = "PluginIdleTimeout";
 const char* kHeartBeatTimeoutKey = "HeartBeatTimeout";
 const char* kUseLastStateKey = "UseLastState";
 const char* kTCPAdapterPortKey = "TCPAdapterPort";
+const char* kTCPAdapterMaximumFrameSizeKey = "TCPAdapterMaximumFrameSize";
+const char* kTCPAdapterEventLoopKey = "TCPAdapterEventLoop";
+const char* kTCPAdapterReconnectGracePeriodKey =
+    "TCPAdapterReconnectGracePeriod";
+const char* kTrafficCaptureFileKey = "TrafficCaptureFile";
+const char* kReplayCaptureFileKey = "ReplayCaptureFile";
+const char* kTransportSendWeightsKey = "TransportSendWeights";
+const char* kDeviceSendWeightsKey = "DeviceSendWeights";
+const char* kReplayRealTimeKey = "ReplayRealTime";
+const char* kAOAAdapterMaximumFrameSizeKey = "AOAAdapterMaximumFrameSize";
+const char* kAOAAdapterTransfersCountKey = "AOAAdapterTransfersCount";
+const char* kBluetoothAdapterMaximumFrameSizeKey =
+    "BluetoothAdapterMaximumFrameSize";
+const char* kBluetoothAdapterAsyncDiscoveryKey =
+    "BluetoothAdapterAsyncDiscovery";
+const char* kBluetoothAdapterSendBufferSizeKey =
+    "BluetoothAdapterSendBufferSize";
+const char* kBluetoothAdapterReceiveBufferSizeKey =
+    "BluetoothAdapterReceiveBufferSize";
+const char* kBluetoothAdapterSocketPriorityKey =
+    "BluetoothAdapterSocketPriority";
 const char* kServerPortKey = "ServerPort";
 const char* kVideoStreamingPortKey = "VideoStreamingPort";
 const char* kAudioStreamingPortKey = "AudioStreamingPort";
 const char* kStopStreamingTimeout = "StopStreamingTimeout";
 const char* kTimeTestingPortKey = "TimeTestingPort";
+const char* kTimeTestingBinaryFormatKey = "TimeTestingBinaryFormat";
+const char* kMetricsDumpPeriodKey = "MetricsDumpPeriod";
+const char* kResourceSamplingPeriodKey = "ResourceSamplingPeriod";
+const char* kAppMemoryQuotaKey = "AppMemoryQuota";
 const char* kThreadStackSizeKey = "ThreadStackSize";
 const char* kMaxCmdIdKey = "MaxCmdID";
 const char* kPutFileRequestKey = "PutFileRequest";
@@ -137,6 +186,11 @@ const char* kTransportManagerDisconnectTimeoutKey = "DisconnectTimeout";
 const char* kTTSDelimiterKey = "TTSDelimiter";
 const char* kRecordingFileNameKey = "RecordingFileName";
 const char* kRecordingFileSourceKey = "RecordingFileSource";
+const char* kAudioPassThruChunkIntervalKey = "AudioPassThruChunkInterval";
+const char* kA2DPLatencyKey = "A2DPLatency";
+const char* kStreamQueueMaxFramesKey = "StreamQueueMaxFrames";
+const char* kStreamQueueMaxBytesKey = "StreamQueueMaxBytes";
+const char* kStreamFileMaxSizeKey = "StreamFileMaxSize";
 const char* kEnablePolicy = "EnablePolicy";
 const char* kMmeDatabaseNameKey = "MMEDatabase";
 const char* kEventMQKey = "EventMQ";
@@ -159,7 +213,14 @@ const char* kFrequencyTime = "FrequencyTime";
 const char* kMalformedMessageFiltering = "MalformedMessageFiltering";
 const char* kMalformedFrequencyCount = "MalformedFrequencyCount";
 const char* kMalformedFrequencyTime = "MalformedFrequencyTime";
+const char* kMediaFastLane = "MediaFastLane";
+const char* kDecryptionThreadsKey = "DecryptionThreads";
+const char* kFromMobileThreadsKey = "FromMobileThreads";
+const char* kEncryptWholeMessagesKey = "EncryptWholeMessages";
+const char* kPayloadCompressionKey = "PayloadCompression";
+const char* kPayloadCompressionLevelKey = "PayloadCompressionLevel";
 const char* kHashStringSizeKey = "HashStringSize";
+const char* kReloadConfigOnChangeKey = "ReloadConfigOnChange";
 
 const char* kDefaultPoliciesSnapshotFileName = "sdl_snapshot.json";
 const char* kDefaultHmiCapabilitiesFileName = "hmi_capabilities.json";
@@ -175,6 +236,10 @@ const char* kDefaultAckMQ = "/dev/mqueue/FromSDLCoreUSBAdapter";
 const char* kDefaultRecordingFileSourceName = "audio.8bit.wav";
 const char* kDefaultRecordingFileName = "record.wav";
 const char* kDefaultThreadPoolSize = "ThreadPoolSize";
+const char* kFromMobileParsingThreadsKey = "FromMobileParsingThreads";
+const char* kCoalesceMobileNotificationsKey = "CoalesceMobileNotifications";
+const char* kHMIListUpdateDelayKey = "HMIListUpdateDelay";
+const char* kCacheChoiceSetsOnHMIKey = "CacheChoiceSetsOnHMI";
 const char* kDefaultLegacyProtocolMask = "com.ford.sync.prot";
 const char* kDefaultHubProtocolMask = "com.smartdevicelink.prot";
 const char* kDefaultPoolProtocolMask = "com.smartdevicelink.prot";
@@ -184,11 +249,28 @@ const char* kDefaultIAP2SystemConfig = "/fs/mp/etc/mm/iap2.cfg";
 const uint32_t kDefaultHubProtocolIndex = 0;
 const uint32_t kDefaultHeartBeatTimeout = 0;
 const uint16_t kDefautTransportManagerTCPPort = 12345;
+// 0 means protocol default frame size
+const uint32_t kDefaultTransportManagerMaximumFrameSize = 0;
+const bool kDefaultTransportManagerTCPEventLoop = false;
+// 0 means connections are closed as soon as transport link is lost
+const uint32_t kDefaultTransportManagerTCPReconnectGracePeriod = 0;
+const bool kDefaultTransportManagerReplayRealTime = true;
+const uint32_t kDefaultTransportManagerAOATransfersCount = 4;
+const bool kDefaultTransportManagerBluetoothAsyncDiscovery = false;
+const uint32_t kDefaultTransportManagerBluetoothSocketBufferSize = 0;
+const uint32_t kDefaultTransportManagerBluetoothSocketPriority = 0;
+// Higher priorities require CAP_NET_ADMIN
+const uint32_t kMaxTransportManagerBluetoothSocketPriority = 6;
 const uint16_t kDefaultServerPort = 8087;
 const uint16_t kDefaultVideoStreamingPort = 5050;
 const uint16_t kDefaultAudioStreamingPort = 5080;
 const uint32_t kDefaultStopStreamingTimeout = 1;
 const uint16_t kDefaultTimeTestingPort = 5090;
+const bool kDefaultTimeTestingBinaryFormat = false;
+const uint32_t kDefaultMetricsDumpPeriod = 0;
+const uint32_t kDefaultResourceSamplingPeriod = 0;
+const uint32_t kDefaultAppMemoryQuota = 0;
+const uint32_t kDefaultPluginIdleTimeout = 0;
 const uint32_t kDefaultMaxCmdId = 2000000000;
 const uint32_t kDefaultPutFileRequestInNone = 5;
 const uint32_t kDefaultDeleteFileRequestInNone = 5;
@@ -199,6 +281,7 @@ const uint32_t kDefaultAppSavePersistentDataTimeout = 10;
 const uint32_t kDefaultResumptionDelayBeforeIgn = 30;
 const uint32_t kDefaultResumptionDelayAfterIgn = 30;
 const uint32_t kDefaultHashStringSize = 32;
+const bool kDefaultReloadConfigOnChange = false;
 
 const uint32_t kDefaultDirQuota = 104857600;
 const uint32_t kDefaultAppTimeScaleMaxRequests = 0;
@@ -212,6 +295,16 @@ const std::pair<uint32_t, uint32_t> kReadDIDFrequency = {5 , 1};
 const std::pair<uint32_t, uint32_t> kGetVehicleDataFrequency = {5 , 1};
 const std::pair<uint32_t, uint32_t> kStartStreamRetryAmount = {3 , 1};
 const uint32_t kDefaultMaxThreadPoolSize = 2;
+const uint32_t kDefaultFromMobileParsingThreads = 0;
+const uint32_t kDefaultAudioPassThruChunkInterval = 1000;
+const uint32_t kDefaultA2DPLatency = 50;
+// 0 means streaming queues are not bounded
+const uint32_t kDefaultStreamQueueMaxFrames = 0;
+const uint32_t kDefaultStreamQueueMaxBytes = 0;
+// 0 means stream files are not rotated
+const uint32_t kDefaultStreamFileMaxSize = 0;
+// 0 means application and device lists are sent to HMI on every change
+const uint32_t kDefaultHMIListUpdateDelay = 0;
 const int kDefaultIAP2HubConnectAttempts = 0;
 const int kDefaultIAPHubConnectionWaitTimeout = 10;
 const uint16_t kDefaultTTSGlobalPropertiesTimeout = 20;
@@ -222,10 +315,29 @@ const size_t kDefaultFrequencyTime = 1000;
 const bool kDefaulMalformedMessageFiltering = true;
 const size_t kDefaultMalformedFrequencyCount = 10;
 const size_t kDefaultMalformedFrequencyTime = 1000;
+const bool kDefaultMediaFastLane = false;
+const uint32_t kDefaultDecryptionThreads = 0;
+const uint32_t kDefaultFromMobileThreads = 1;
+const bool kDefaultEncryptWholeMessages = false;
+const bool kDefaultPayloadCompression = false;
+const uint32_t kDefaultPayloadCompressionLevel = 6;
 const uint16_t kDefaultAttemptsToOpenPolicyDB = 5;
 const uint16_t kDefaultOpenAttemptTimeoutMsKey = 500;
+const uint16_t kDefaultPolicyDBSynchronousLevel = 1;
+const uint16_t kMaxPolicyDBSynchronousLevel = 2;
+const uint32_t kDefaultUsageStatisticsFlushInterval = 60;
 const uint32_t kDefaultAppIconsFolderMaxSize = 1048576;
 const uint32_t kDefaultAppIconsAmountToRemove = 1;
+const uint32_t kDefaultTransportManagerSendWeight = 1;
+const uint32_t kMaxTransportManagerSendWeight = 1000;
+
+std::string TrimSpaces(const std::string& value) {
+  const size_t begin = value.find_first_not_of(' ');
+  if (std::string::npos == begin) {
+    return std::string();
+  }
+  return value.substr(begin, value.find_last_not_of(' ') - begin + 1);
+}
 
 }  // namespace
 
@@ -279,13 +391,44 @@ Profile::Profile()
     system_files_path_(kDefaultSystemFilesPath),
     plugins_folder_(kDefaultPluginsPath),
     transport_manager_tcp_adapter_port_(kDefautTransportManagerTCPPort),
+    transport_manager_tcp_adapter_maximum_frame_size_(
+      kDefaultTransportManagerMaximumFrameSize),
+    transport_manager_aoa_adapter_maximum_frame_size_(
+      kDefaultTransportManagerMaximumFrameSize),
+    transport_manager_aoa_adapter_transfers_count_(
+      kDefaultTransportManagerAOATransfersCount),
+    transport_manager_bluetooth_adapter_maximum_frame_size_(
+      kDefaultTransportManagerMaximumFrameSize),
+    transport_manager_bluetooth_adapter_async_discovery_(
+      kDefaultTransportManagerBluetoothAsyncDiscovery),
+    transport_manager_bluetooth_adapter_send_buffer_size_(
+      kDefaultTransportManagerBluetoothSocketBufferSize),
+    transport_manager_bluetooth_adapter_receive_buffer_size_(
+      kDefaultTransportManagerBluetoothSocketBufferSize),
+    transport_manager_bluetooth_adapter_socket_priority_(
+      kDefaultTransportManagerBluetoothSocketPriority),
+    transport_manager_tcp_adapter_event_loop_(
+      kDefaultTransportManagerTCPEventLoop),
+    transport_manager_tcp_adapter_reconnect_grace_period_(
+      kDefaultTransportManagerTCPReconnectGracePeriod),
+    transport_manager_replay_real_time_(
+      kDefaultTransportManagerReplayRealTime),
     tts_delimiter_(kDefaultTtsDelimiter),
     mme_db_name_(kDefaultMmeDatabaseName),
     event_mq_name_(kDefaultEventMQ),
     ack_mq_name_(kDefaultAckMQ),
     recording_file_source_(kDefaultRecordingFileSourceName),
     recording_file_name_(kDefaultRecordingFileName),
+    audio_pass_thru_chunk_interval_(kDefaultAudioPassThruChunkInterval),
+    a2dp_latency_(kDefaultA2DPLatency),
+    stream_queue_max_frames_(kDefaultStreamQueueMaxFrames),
+    stream_queue_max_bytes_(kDefaultStreamQueueMaxBytes),
+    stream_file_max_size_(kDefaultStreamFileMaxSize),
     application_list_update_timeout_(kDefaultApplicationListUpdateTimeout),
+    from_mobile_parsing_threads_(kDefaultFromMobileParsingThreads),
+    coalesce_mobile_notifications_(false),
+    hmi_list_update_delay_(kDefaultHMIListUpdateDelay),
+    cache_choice_sets_on_hmi_(false),
     iap_legacy_protocol_mask_(kDefaultLegacyProtocolMask),
     iap_hub_protocol_mask_(kDefaultHubProtocolMask),
     iap_pool_protocol_mask_(kDefaultPoolProtocolMask),
@@ -296,17 +439,65 @@ Profile::Profile()
     tts_global_properties_timeout_(kDefaultTTSGlobalPropertiesTimeout),
     attempts_to_open_policy_db_(kDefaultAttemptsToOpenPolicyDB),
     open_attempt_timeout_ms_(kDefaultAttemptsToOpenPolicyDB),
+    policy_db_synchronous_level_(kDefaultPolicyDBSynchronousLevel),
+    usage_statistics_flush_interval_(kDefaultUsageStatisticsFlushInterval),
     hash_string_size_(kDefaultHashStringSize),
-    logs_enabled_(true) {
+    logs_enabled_(true),
+    reload_config_on_change_(kDefaultReloadConfigOnChange),
+    config_watch_thread_(NULL),
+    snapshot_(NULL) {
+  PublishSnapshot();
 }
 
 Profile::~Profile() {
+  StopConfigWatch();
+  for (std::vector<ProfileSnapshot*>::iterator it = snapshots_.begin();
+      it != snapshots_.end(); ++it) {
+    free(*it);
+  }
+}
+
+const ProfileSnapshot& Profile::snapshot() const {
+  return *atomic_pointer_load_acquire(snapshot_);
+}
+
+void Profile::PublishSnapshot() {
+  void* memory = NULL;
+  // Snapshot shares no cache line with data written by other threads
+  if (0 != posix_memalign(&memory, __alignof__(ProfileSnapshot),
+                          sizeof(ProfileSnapshot))) {
+    LOG4CXX_ERROR(logger_, "Failed to allocate profile snapshot");
+    return;
+  }
+  ProfileSnapshot* snapshot = static_cast<ProfileSnapshot*>(memory);
+  snapshot->default_timeout = default_timeout_;
+  snapshot->app_time_scale = app_requests_time_scale_;
+  snapshot->app_time_scale_max_requests = app_time_scale_max_requests_;
+  snapshot->app_hmi_level_none_time_scale =
+      app_hmi_level_none_requests_time_scale_;
+  snapshot->app_hmi_level_none_time_scale_max_requests =
+      app_hmi_level_none_time_scale_max_requests_;
+  snapshot->pending_requests_amount = pending_requests_amount_;
+  snapshot->put_file_in_none = put_file_in_none_;
+  snapshot->hash_string_size = hash_string_size_;
+
+  sync_primitives::AutoLock auto_lock(snapshots_lock_);
+  snapshots_.push_back(snapshot);
+  atomic_pointer_store_release(snapshot_, snapshot);
 }
 
 void Profile::config_file_name(const std::string& fileName) {
   if (false == fileName.empty()) {
+    StopConfigWatch();
     config_file_name_ = fileName;
+    {
+      sync_primitives::AutoLock auto_lock(ini_model_lock_);
+      ini_model_.Load(config_file_name_);
+    }
     UpdateValues();
+    if (reload_config_on_change_) {
+      StartConfigWatch();
+    }
   }
 }
 
@@ -406,6 +597,34 @@ const uint16_t& Profile::time_testing_port() const {
   return time_testing_port_;
 }
 
+bool Profile::time_testing_binary_format() const {
+  bool binary_format = false;
+  ReadBoolValue(&binary_format, kDefaultTimeTestingBinaryFormat,
+                kMainSection, kTimeTestingBinaryFormatKey);
+  return binary_format;
+}
+
+uint32_t Profile::metrics_dump_period() const {
+  uint32_t metrics_dump_period = 0;
+  ReadUIntValue(&metrics_dump_period, kDefaultMetricsDumpPeriod,
+                kMainSection, kMetricsDumpPeriodKey);
+  return metrics_dump_period;
+}
+
+uint32_t Profile::resource_sampling_period() const {
+  uint32_t resource_sampling_period = 0;
+  ReadUIntValue(&resource_sampling_period, kDefaultResourceSamplingPeriod,
+                kMainSection, kResourceSamplingPeriodKey);
+  return resource_sampling_period;
+}
+
+uint32_t Profile::app_memory_quota() const {
+  uint32_t app_memory_quota = 0;
+  ReadUIntValue(&app_memory_quota, kDefaultAppMemoryQuota,
+                kMainSection, kAppMemoryQuotaKey);
+  return app_memory_quota;
+}
+
 
 const uint64_t& Profile::thread_min_stack_size() const {
   return min_tread_stack_size_;
@@ -515,6 +734,46 @@ const std::string& Profile::system_files_path() const {
 const std::string& Profile::plugins_folder() const {
   return plugins_folder_;
 }
+
+uint32_t Profile::plugin_idle_timeout() const {
+  uint32_t plugin_idle_timeout = 0;
+  ReadUIntValue(&plugin_idle_timeout, kDefaultPluginIdleTimeout,
+                kMainSection, kPluginIdleTimeoutKey);
+  return plugin_idle_timeout;
+}
+
+threads::ThreadProfiles::Profiles Profile::thread_profiles() const {
+  threads::ThreadProfiles::Profiles profiles;
+  for (size_t i = 0; i < ARRAYSIZE(kThreadRoles); ++i) {
+    const std::string role = kThreadRoles[i];
+    const std::string profile_key = role + "Profile";
+    std::string profile_value;
+    if (!ReadValue(&profile_value, kThreadsSection, profile_key.c_str())) {
+      continue;
+    }
+    threads::ThreadProfile profile;
+    if (!profile.Parse(profile_value)) {
+      LOG4CXX_ERROR(logger_, "Malformed " << profile_key << " '"
+                    << profile_value << "' is ignored");
+      continue;
+    }
+    const std::string threads_key = role + "Threads";
+    const std::list<std::string> prefixes =
+        ReadStringContainer(kThreadsSection, threads_key.c_str(), NULL);
+    for (std::list<std::string>::const_iterator it = prefixes.begin();
+         it != prefixes.end(); ++it) {
+      const size_t begin = it->find_first_not_of(' ');
+      if (std::string::npos == begin) {
+        continue;
+      }
+      const std::string prefix =
+          it->substr(begin, it->find_last_not_of(' ') - begin + 1);
+      LOG_UPDATED_VALUE(profile_value, prefix, kThreadsSection);
+      profiles.push_back(std::make_pair(prefix, profile));
+    }
+  }
+  return profiles;
+}
 const std::vector<uint32_t>& Profile::supported_diag_modes() const {
   return supported_diag_modes_;
 }
@@ -523,6 +782,93 @@ uint16_t Profile::transport_manager_tcp_adapter_port() const {
   return transport_manager_tcp_adapter_port_;
 }
 
+uint32_t Profile::transport_manager_tcp_adapter_maximum_frame_size() const {
+  return transport_manager_tcp_adapter_maximum_frame_size_;
+}
+
+bool Profile::transport_manager_tcp_adapter_event_loop() const {
+  return transport_manager_tcp_adapter_event_loop_;
+}
+
+uint32_t Profile::transport_manager_tcp_adapter_reconnect_grace_period() const {
+  return transport_manager_tcp_adapter_reconnect_grace_period_;
+}
+
+const std::string& Profile::transport_manager_traffic_capture_file() const {
+  return transport_manager_traffic_capture_file_;
+}
+
+const std::string& Profile::transport_manager_replay_capture_file() const {
+  return transport_manager_replay_capture_file_;
+}
+
+uint32_t Profile::transport_manager_send_weight(
+    const std::string& transport_type, const std::string& device_uid) const {
+  const char* const keys[] = { kTransportSendWeightsKey,
+                               kDeviceSendWeightsKey };
+  const std::string* const names[] = { &transport_type, &device_uid };
+  uint32_t weight = kDefaultTransportManagerSendWeight;
+  // Weight of device overrides weight of its transport
+  for (size_t i = 0; i < ARRAYSIZE(keys); ++i) {
+    const std::list<std::string> weights =
+        ReadStringContainer(kTransportManagerSection, keys[i], NULL);
+    for (std::list<std::string>::const_iterator it = weights.begin();
+         it != weights.end(); ++it) {
+      // Device ids are MAC addresses containing colons
+      const size_t colon = it->rfind(':');
+      if (std::string::npos == colon ||
+          TrimSpaces(it->substr(0, colon)) != *names[i]) {
+        continue;
+      }
+      uint64_t value = 0;
+      if (!StringToNumber(TrimSpaces(it->substr(colon + 1)), value) ||
+          0 == value || value > kMaxTransportManagerSendWeight) {
+        LOG4CXX_ERROR(logger_, "Malformed " << keys[i] << " entry '" << *it
+                      << "' is ignored");
+        continue;
+      }
+      weight = static_cast<uint32_t>(value);
+    }
+  }
+  return weight;
+}
+
+bool Profile::transport_manager_replay_real_time() const {
+  return transport_manager_replay_real_time_;
+}
+
+uint32_t Profile::transport_manager_aoa_adapter_maximum_frame_size() const {
+  return transport_manager_aoa_adapter_maximum_frame_size_;
+}
+
+uint32_t Profile::transport_manager_aoa_adapter_transfers_count() const {
+  return transport_manager_aoa_adapter_transfers_count_;
+}
+
+uint32_t
+Profile::transport_manager_bluetooth_adapter_maximum_frame_size() const {
+  return transport_manager_bluetooth_adapter_maximum_frame_size_;
+}
+
+bool Profile::transport_manager_bluetooth_adapter_async_discovery() const {
+  return transport_manager_bluetooth_adapter_async_discovery_;
+}
+
+uint32_t
+Profile::transport_manager_bluetooth_adapter_send_buffer_size() const {
+  return transport_manager_bluetooth_adapter_send_buffer_size_;
+}
+
+uint32_t
+Profile::transport_manager_bluetooth_adapter_receive_buffer_size() const {
+  return transport_manager_bluetooth_adapter_receive_buffer_size_;
+}
+
+uint32_t
+Profile::transport_manager_bluetooth_adapter_socket_priority() const {
+  return transport_manager_bluetooth_adapter_socket_priority_;
+}
+
 const std::string& Profile::tts_delimiter() const {
   return tts_delimiter_;
 }
@@ -535,6 +881,26 @@ const std::string&Profile::recording_file_name() const {
   return recording_file_name_;
 }
 
+uint32_t Profile::audio_pass_thru_chunk_interval() const {
+  return audio_pass_thru_chunk_interval_;
+}
+
+uint32_t Profile::a2dp_latency() const {
+  return a2dp_latency_;
+}
+
+uint32_t Profile::stream_queue_max_frames() const {
+  return stream_queue_max_frames_;
+}
+
+uint32_t Profile::stream_queue_max_bytes() const {
+  return stream_queue_max_bytes_;
+}
+
+uint32_t Profile::stream_file_max_size() const {
+  return stream_file_max_size_;
+}
+
 const std::string& Profile::mme_db_name() const {
   return mme_db_name_;
 }
@@ -567,6 +933,22 @@ uint32_t Profile::thread_pool_size() const  {
   return max_thread_pool_size_;
 }
 
+uint32_t Profile::from_mobile_parsing_threads() const {
+  return from_mobile_parsing_threads_;
+}
+
+bool Profile::coalesce_mobile_notifications() const {
+  return coalesce_mobile_notifications_;
+}
+
+uint32_t Profile::hmi_list_update_delay() const {
+  return hmi_list_update_delay_;
+}
+
+bool Profile::cache_choice_sets_on_hmi() const {
+  return cache_choice_sets_on_hmi_;
+}
+
 uint32_t Profile::default_hub_protocol_index() const{
   return default_hub_protocol_index_;
 }
@@ -641,6 +1023,48 @@ size_t Profile::malformed_frequency_time() const {
   return malformed_frequency_time;
 }
 
+bool Profile::media_fast_lane() const {
+  bool media_fast_lane = false;
+  ReadBoolValue(&media_fast_lane, kDefaultMediaFastLane,
+                kProtocolHandlerSection, kMediaFastLane);
+  return media_fast_lane;
+}
+
+uint32_t Profile::decryption_threads() const {
+  uint32_t decryption_threads = 0;
+  ReadUIntValue(&decryption_threads, kDefaultDecryptionThreads,
+                kProtocolHandlerSection, kDecryptionThreadsKey);
+  return decryption_threads;
+}
+
+uint32_t Profile::from_mobile_threads() const {
+  uint32_t from_mobile_threads = 0;
+  ReadUIntValue(&from_mobile_threads, kDefaultFromMobileThreads,
+                kProtocolHandlerSection, kFromMobileThreadsKey);
+  return from_mobile_threads > 0 ? from_mobile_threads : 1;
+}
+
+bool Profile::encrypt_whole_messages() const {
+  bool encrypt_whole_messages = false;
+  ReadBoolValue(&encrypt_whole_messages, kDefaultEncryptWholeMessages,
+                kProtocolHandlerSection, kEncryptWholeMessagesKey);
+  return encrypt_whole_messages;
+}
+
+bool Profile::payload_compression() const {
+  bool payload_compression = false;
+  ReadBoolValue(&payload_compression, kDefaultPayloadCompression,
+                kProtocolHandlerSection, kPayloadCompressionKey);
+  return payload_compression;
+}
+
+uint32_t Profile::payload_compression_level() const {
+  uint32_t payload_compression_level = 0;
+  ReadUIntValue(&payload_compression_level, kDefaultPayloadCompressionLevel,
+                kProtocolHandlerSection, kPayloadCompressionLevelKey);
+  return payload_compression_level;
+}
+
 uint16_t Profile::attempts_to_open_policy_db() const {
   return attempts_to_open_policy_db_;
 }
@@ -649,6 +1073,14 @@ uint16_t Profile::open_attempt_timeout_ms() const {
   return open_attempt_timeout_ms_;
 }
 
+uint16_t Profile::policy_db_synchronous_level() const {
+  return policy_db_synchronous_level_;
+}
+
+uint32_t Profile::usage_statistics_flush_interval() const {
+  return usage_statistics_flush_interval_;
+}
+
 uint32_t Profile::resumption_delay_before_ign() const {
   return resumption_delay_before_ign_;
 }
@@ -669,6 +1101,18 @@ bool Profile::logs_enabled() const {
   return logs_enabled_;
 }
 
+const std::string& Profile::binary_log_file() const {
+  return binary_log_file_;
+}
+
+const std::string& Profile::warm_restart_socket() const {
+  return warm_restart_socket_;
+}
+
+bool Profile::reload_config_on_change() const {
+  return reload_config_on_change_;
+}
+
 void Profile::UpdateValues() {
   LOG4CXX_AUTO_TRACE(logger_);
 
@@ -690,6 +1134,28 @@ void Profile::UpdateValues() {
 
   logs_enabled_ = true;
 
+  // Binary log file
+  ReadStringValue(&binary_log_file_, "", kMainSection, kBinaryLogFileKey);
+
+  LOG_UPDATED_VALUE(binary_log_file_, kBinaryLogFileKey, kMainSection);
+
+  // Warm restart socket
+  ReadStringValue(&warm_restart_socket_, "", kMainSection,
+                  kWarmRestartSocketKey);
+
+  LOG_UPDATED_VALUE(warm_restart_socket_, kWarmRestartSocketKey,
+                    kMainSection);
+
+  std::string reload_value;
+  if (ReadValue(&reload_value, kMainSection, kReloadConfigOnChangeKey)) {
+    reload_config_on_change_ = 0 == strcmp("true", reload_value.c_str());
+  } else {
+    reload_config_on_change_ = kDefaultReloadConfigOnChange;
+  }
+
+  LOG_UPDATED_BOOL_VALUE(reload_config_on_change_, kReloadConfigOnChangeKey,
+                         kMainSection);
+
   // Application config folder
   ReadStringValue(&app_config_folder_,
                   file_system::CurrentWorkingDirectory().c_str(),
@@ -1100,52 +1566,7 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(tts_global_properties_timeout_, kTTSGlobalPropertiesTimeoutKey,
                     kGlobalPropertiesSection);
 
-  // Application time scale maximum requests
-  ReadUIntValue(&app_time_scale_max_requests_,
-                kDefaultAppTimeScaleMaxRequests,
-                kMainSection,
-                kAppTimeScaleMaxRequestsKey);
-
-  LOG_UPDATED_VALUE(app_time_scale_max_requests_, kAppTimeScaleMaxRequestsKey,
-                    kMainSection);
-
-  // Application time scale
-  ReadUIntValue(&app_requests_time_scale_, kDefaultAppRequestsTimeScale,
-                kMainSection, kAppRequestsTimeScaleKey);
-
-  LOG_UPDATED_VALUE(app_requests_time_scale_, kAppRequestsTimeScaleKey,
-                    kMainSection);
-
-  // Application HMI level NONE time scale maximum requests
-  ReadUIntValue(&app_hmi_level_none_time_scale_max_requests_,
-                kDefaultAppHmiLevelNoneTimeScaleMaxRequests,
-                kMainSection,
-                kAppHmiLevelNoneTimeScaleMaxRequestsKey);
-
-  LOG_UPDATED_VALUE(app_hmi_level_none_time_scale_max_requests_,
-                    kAppHmiLevelNoneTimeScaleMaxRequestsKey,
-                    kMainSection);
-
-  // Application HMI level NONE requests time scale
-  ReadUIntValue(&app_hmi_level_none_requests_time_scale_,
-                kDefaultAppHmiLevelNoneRequestsTimeScale,
-                kMainSection,
-                kAppHmiLevelNoneRequestsTimeScaleKey);
-
-  LOG_UPDATED_VALUE(app_hmi_level_none_requests_time_scale_,
-                    kAppHmiLevelNoneRequestsTimeScaleKey,
-                    kMainSection);
-
-  // Amount of pending requests
-  ReadUIntValue(&pending_requests_amount_, kDefaultPendingRequestsAmount,
-                kMainSection, kPendingRequestsAmoundKey);
-
-  if (pending_requests_amount_ <= 0) {
-    pending_requests_amount_ = kDefaultPendingRequestsAmount;
-  }
-
-  LOG_UPDATED_VALUE(pending_requests_amount_, kPendingRequestsAmoundKey,
-                    kMainSection);
+  UpdateTunableValues();
 
   // Supported diagnostic modes
   supported_diag_modes_.clear();
@@ -1205,6 +1626,129 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(transport_manager_tcp_adapter_port_, kTCPAdapterPortKey,
                     kTransportManagerSection);
 
+  // Transport manager maximum frame sizes
+  ReadUIntValue(&transport_manager_tcp_adapter_maximum_frame_size_,
+                kDefaultTransportManagerMaximumFrameSize,
+                kTransportManagerSection,
+                kTCPAdapterMaximumFrameSizeKey);
+
+  LOG_UPDATED_VALUE(transport_manager_tcp_adapter_maximum_frame_size_,
+                    kTCPAdapterMaximumFrameSizeKey, kTransportManagerSection);
+
+  ReadUIntValue(&transport_manager_aoa_adapter_maximum_frame_size_,
+                kDefaultTransportManagerMaximumFrameSize,
+                kTransportManagerSection,
+                kAOAAdapterMaximumFrameSizeKey);
+
+  LOG_UPDATED_VALUE(transport_manager_aoa_adapter_maximum_frame_size_,
+                    kAOAAdapterMaximumFrameSizeKey, kTransportManagerSection);
+
+  ReadUIntValue(&transport_manager_aoa_adapter_transfers_count_,
+                kDefaultTransportManagerAOATransfersCount,
+                kTransportManagerSection,
+                kAOAAdapterTransfersCountKey);
+
+  if (transport_manager_aoa_adapter_transfers_count_ < 1) {
+    transport_manager_aoa_adapter_transfers_count_ =
+        kDefaultTransportManagerAOATransfersCount;
+  }
+
+  LOG_UPDATED_VALUE(transport_manager_aoa_adapter_transfers_count_,
+                    kAOAAdapterTransfersCountKey, kTransportManagerSection);
+
+  ReadUIntValue(&transport_manager_bluetooth_adapter_maximum_frame_size_,
+                kDefaultTransportManagerMaximumFrameSize,
+                kTransportManagerSection,
+                kBluetoothAdapterMaximumFrameSizeKey);
+
+  LOG_UPDATED_VALUE(transport_manager_bluetooth_adapter_maximum_frame_size_,
+                    kBluetoothAdapterMaximumFrameSizeKey,
+                    kTransportManagerSection);
+
+  // Transport manager Bluetooth devices discovery mode
+  ReadBoolValue(&transport_manager_bluetooth_adapter_async_discovery_,
+                kDefaultTransportManagerBluetoothAsyncDiscovery,
+                kTransportManagerSection,
+                kBluetoothAdapterAsyncDiscoveryKey);
+
+  LOG_UPDATED_BOOL_VALUE(transport_manager_bluetooth_adapter_async_discovery_,
+                         kBluetoothAdapterAsyncDiscoveryKey,
+                         kTransportManagerSection);
+
+  // Transport manager RFCOMM sockets tuning
+  ReadUIntValue(&transport_manager_bluetooth_adapter_send_buffer_size_,
+                kDefaultTransportManagerBluetoothSocketBufferSize,
+                kTransportManagerSection,
+                kBluetoothAdapterSendBufferSizeKey);
+
+  LOG_UPDATED_VALUE(transport_manager_bluetooth_adapter_send_buffer_size_,
+                    kBluetoothAdapterSendBufferSizeKey,
+                    kTransportManagerSection);
+
+  ReadUIntValue(&transport_manager_bluetooth_adapter_receive_buffer_size_,
+                kDefaultTransportManagerBluetoothSocketBufferSize,
+                kTransportManagerSection,
+                kBluetoothAdapterReceiveBufferSizeKey);
+
+  LOG_UPDATED_VALUE(transport_manager_bluetooth_adapter_receive_buffer_size_,
+                    kBluetoothAdapterReceiveBufferSizeKey,
+                    kTransportManagerSection);
+
+  ReadUIntValue(&transport_manager_bluetooth_adapter_socket_priority_,
+                kDefaultTransportManagerBluetoothSocketPriority,
+                kTransportManagerSection,
+                kBluetoothAdapterSocketPriorityKey);
+
+  if (transport_manager_bluetooth_adapter_socket_priority_ >
+      kMaxTransportManagerBluetoothSocketPriority) {
+    transport_manager_bluetooth_adapter_socket_priority_ =
+        kMaxTransportManagerBluetoothSocketPriority;
+  }
+
+  LOG_UPDATED_VALUE(transport_manager_bluetooth_adapter_socket_priority_,
+                    kBluetoothAdapterSocketPriorityKey,
+                    kTransportManagerSection);
+
+  // Transport manager TCP connections serving mode
+  ReadBoolValue(&transport_manager_tcp_adapter_event_loop_,
+                kDefaultTransportManagerTCPEventLoop,
+                kTransportManagerSection,
+                kTCPAdapterEventLoopKey);
+
+  LOG_UPDATED_BOOL_VALUE(transport_manager_tcp_adapter_event_loop_,
+                         kTCPAdapterEventLoopKey, kTransportManagerSection);
+
+  // Transport manager TCP connection standby time after link loss
+  ReadUIntValue(&transport_manager_tcp_adapter_reconnect_grace_period_,
+                kDefaultTransportManagerTCPReconnectGracePeriod,
+                kTransportManagerSection,
+                kTCPAdapterReconnectGracePeriodKey);
+
+  LOG_UPDATED_VALUE(transport_manager_tcp_adapter_reconnect_grace_period_,
+                    kTCPAdapterReconnectGracePeriodKey,
+                    kTransportManagerSection);
+
+  // Transport manager traffic capture and replay
+  ReadStringValue(&transport_manager_traffic_capture_file_, "",
+                  kTransportManagerSection, kTrafficCaptureFileKey);
+
+  LOG_UPDATED_VALUE(transport_manager_traffic_capture_file_,
+                    kTrafficCaptureFileKey, kTransportManagerSection);
+
+  ReadStringValue(&transport_manager_replay_capture_file_, "",
+                  kTransportManagerSection, kReplayCaptureFileKey);
+
+  LOG_UPDATED_VALUE(transport_manager_replay_capture_file_,
+                    kReplayCaptureFileKey, kTransportManagerSection);
+
+  ReadBoolValue(&transport_manager_replay_real_time_,
+                kDefaultTransportManagerReplayRealTime,
+                kTransportManagerSection,
+                kReplayRealTimeKey);
+
+  LOG_UPDATED_BOOL_VALUE(transport_manager_replay_real_time_,
+                         kReplayRealTimeKey, kTransportManagerSection);
+
   // MME database name
   ReadStringValue(&mme_db_name_,
                   kDefaultMmeDatabaseName,
@@ -1251,6 +1795,44 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(recording_file_source_, kRecordingFileSourceKey,
                     kMediaManagerSection);
 
+  // Audio pass thru chunk interval
+  ReadUIntValue(&audio_pass_thru_chunk_interval_,
+                kDefaultAudioPassThruChunkInterval,
+                kMediaManagerSection, kAudioPassThruChunkIntervalKey);
+
+  if (0 == audio_pass_thru_chunk_interval_) {
+    audio_pass_thru_chunk_interval_ = kDefaultAudioPassThruChunkInterval;
+  }
+
+  LOG_UPDATED_VALUE(audio_pass_thru_chunk_interval_,
+                    kAudioPassThruChunkIntervalKey, kMediaManagerSection);
+
+  // A2DP source player buffering
+  ReadUIntValue(&a2dp_latency_, kDefaultA2DPLatency,
+                kMediaManagerSection, kA2DPLatencyKey);
+
+  LOG_UPDATED_VALUE(a2dp_latency_, kA2DPLatencyKey, kMediaManagerSection);
+
+  // Streaming queues bounds
+  ReadUIntValue(&stream_queue_max_frames_, kDefaultStreamQueueMaxFrames,
+                kMediaManagerSection, kStreamQueueMaxFramesKey);
+
+  LOG_UPDATED_VALUE(stream_queue_max_frames_, kStreamQueueMaxFramesKey,
+                    kMediaManagerSection);
+
+  ReadUIntValue(&stream_queue_max_bytes_, kDefaultStreamQueueMaxBytes,
+                kMediaManagerSection, kStreamQueueMaxBytesKey);
+
+  LOG_UPDATED_VALUE(stream_queue_max_bytes_, kStreamQueueMaxBytesKey,
+                    kMediaManagerSection);
+
+  // Stream file rotation
+  ReadUIntValue(&stream_file_max_size_, kDefaultStreamFileMaxSize,
+                kMediaManagerSection, kStreamFileMaxSizeKey);
+
+  LOG_UPDATED_VALUE(stream_file_max_size_, kStreamFileMaxSizeKey,
+                    kMediaManagerSection);
+
   // Policy preloaded file
   ReadStringValue(&preloaded_pt_file_,
                   kDefaultPreloadedPTFileName,
@@ -1286,6 +1868,28 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(open_attempt_timeout_ms_,
                     kOpenAttemptTimeoutMsKey, kPolicySection);
 
+  // Synchronous level of policy DB journal
+  ReadUIntValue(&policy_db_synchronous_level_,
+                kDefaultPolicyDBSynchronousLevel,
+                kPolicySection,
+                kPolicyDBSynchronousLevelKey);
+
+  if (policy_db_synchronous_level_ > kMaxPolicyDBSynchronousLevel) {
+    policy_db_synchronous_level_ = kDefaultPolicyDBSynchronousLevel;
+  }
+
+  LOG_UPDATED_VALUE(policy_db_synchronous_level_,
+                    kPolicyDBSynchronousLevelKey, kPolicySection);
+
+  // Interval between stores of usage statistics
+  ReadUIntValue(&usage_statistics_flush_interval_,
+                kDefaultUsageStatisticsFlushInterval,
+                kPolicySection,
+                kUsageStatisticsFlushIntervalKey);
+
+  LOG_UPDATED_VALUE(usage_statistics_flush_interval_,
+                    kUsageStatisticsFlushIntervalKey, kPolicySection);
+
   // Turn Policy Off?
   std::string enable_policy_string;
   if (ReadValue(&enable_policy_string, kPolicySection, kEnablePolicy) &&
@@ -1321,6 +1925,36 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(max_thread_pool_size_,
                     kDefaultMaxThreadPoolSize, kApplicationManagerSection);
 
+  ReadUIntValue(&from_mobile_parsing_threads_,
+                kDefaultFromMobileParsingThreads,
+                kApplicationManagerSection,
+                kFromMobileParsingThreadsKey);
+
+  LOG_UPDATED_VALUE(from_mobile_parsing_threads_,
+                    kFromMobileParsingThreadsKey, kApplicationManagerSection);
+
+  ReadBoolValue(&coalesce_mobile_notifications_, false,
+                kApplicationManagerSection, kCoalesceMobileNotificationsKey);
+
+  LOG_UPDATED_BOOL_VALUE(coalesce_mobile_notifications_,
+                         kCoalesceMobileNotificationsKey,
+                         kApplicationManagerSection);
+
+  ReadUIntValue(&hmi_list_update_delay_,
+                kDefaultHMIListUpdateDelay,
+                kApplicationManagerSection,
+                kHMIListUpdateDelayKey);
+
+  LOG_UPDATED_VALUE(hmi_list_update_delay_,
+                    kHMIListUpdateDelayKey, kApplicationManagerSection);
+
+  ReadBoolValue(&cache_choice_sets_on_hmi_, false,
+                kApplicationManagerSection, kCacheChoiceSetsOnHMIKey);
+
+  LOG_UPDATED_BOOL_VALUE(cache_choice_sets_on_hmi_,
+                         kCacheChoiceSetsOnHMIKey,
+                         kApplicationManagerSection);
+
   ReadStringValue(&iap_legacy_protocol_mask_,
                   kDefaultLegacyProtocolMask,
                   kIAPSection,
@@ -1383,6 +2017,212 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(hash_string_size_,
                     kHashStringSizeKey,
                     kApplicationManagerSection);
+
+  PublishSnapshot();
+}
+
+void Profile::UpdateTunableValues() {
+  // Application time scale maximum requests
+  ReadUIntValue(&app_time_scale_max_requests_,
+                kDefaultAppTimeScaleMaxRequests,
+                kMainSection,
+                kAppTimeScaleMaxRequestsKey);
+
+  LOG_UPDATED_VALUE(app_time_scale_max_requests_, kAppTimeScaleMaxRequestsKey,
+                    kMainSection);
+
+  // Application time scale
+  ReadUIntValue(&app_requests_time_scale_, kDefaultAppRequestsTimeScale,
+                kMainSection, kAppRequestsTimeScaleKey);
+
+  LOG_UPDATED_VALUE(app_requests_time_scale_, kAppRequestsTimeScaleKey,
+                    kMainSection);
+
+  // Application HMI level NONE time scale maximum requests
+  ReadUIntValue(&app_hmi_level_none_time_scale_max_requests_,
+                kDefaultAppHmiLevelNoneTimeScaleMaxRequests,
+                kMainSection,
+                kAppHmiLevelNoneTimeScaleMaxRequestsKey);
+
+  LOG_UPDATED_VALUE(app_hmi_level_none_time_scale_max_requests_,
+                    kAppHmiLevelNoneTimeScaleMaxRequestsKey,
+                    kMainSection);
+
+  // Application HMI level NONE requests time scale
+  ReadUIntValue(&app_hmi_level_none_requests_time_scale_,
+                kDefaultAppHmiLevelNoneRequestsTimeScale,
+                kMainSection,
+                kAppHmiLevelNoneRequestsTimeScaleKey);
+
+  LOG_UPDATED_VALUE(app_hmi_level_none_requests_time_scale_,
+                    kAppHmiLevelNoneRequestsTimeScaleKey,
+                    kMainSection);
+
+  // Amount of pending requests
+  ReadUIntValue(&pending_requests_amount_, kDefaultPendingRequestsAmount,
+                kMainSection, kPendingRequestsAmoundKey);
+
+  if (pending_requests_amount_ <= 0) {
+    pending_requests_amount_ = kDefaultPendingRequestsAmount;
+  }
+
+  LOG_UPDATED_VALUE(pending_requests_amount_, kPendingRequestsAmoundKey,
+                    kMainSection);
+}
+
+void Profile::ReloadValues() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  {
+    IniModel ini_model;
+    if (!ini_model.Load(config_file_name_)) {
+      LOG4CXX_WARN(logger_, "Failed to reload " << config_file_name_);
+      return;
+    }
+    sync_primitives::AutoLock auto_lock(ini_model_lock_);
+    ini_model_.Swap(ini_model);
+  }
+  UpdateTunableValues();
+  PublishSnapshot();
+}
+
+namespace {
+/**
+ * Reloads profile when its ini file is rewritten or replaced,
+ * directory is watched since editors usually replace files
+ */
+class ConfigWatchDelegate : public threads::ThreadDelegate {
+ public:
+  ConfigWatchDelegate(profile::Profile* profile, const std::string& file_name)
+    : profile_(profile),
+      file_name_(file_name) {
+    stop_pipe_[0] = stop_pipe_[1] = -1;
+#ifdef __linux__
+    if (0 != pipe(stop_pipe_)) {
+      LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to create stop pipe");
+      stop_pipe_[0] = stop_pipe_[1] = -1;
+    }
+#endif  // __linux__
+  }
+
+  ~ConfigWatchDelegate() {
+#ifdef __linux__
+    if (-1 != stop_pipe_[0]) {
+      close(stop_pipe_[0]);
+      close(stop_pipe_[1]);
+    }
+#endif  // __linux__
+  }
+
+  void threadMain() {
+#ifdef __linux__
+    if (-1 == stop_pipe_[0]) {
+      return;
+    }
+    const std::string::size_type slash = file_name_.rfind('/');
+    const std::string directory = std::string::npos == slash ?
+        std::string(".") : file_name_.substr(0, slash + 1);
+    const std::string name = std::string::npos == slash ?
+        file_name_ : file_name_.substr(slash + 1);
+
+    const int notify_fd = inotify_init();
+    if (-1 == notify_fd) {
+      LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to init inotify");
+      return;
+    }
+    if (-1 == inotify_add_watch(notify_fd, directory.c_str(),
+                                IN_CLOSE_WRITE | IN_MOVED_TO)) {
+      LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to watch " << directory);
+      close(notify_fd);
+      return;
+    }
+    LOG4CXX_INFO(logger_, "Watching " << file_name_ << " for changes");
+
+    pollfd poll_fds[2] = { { notify_fd, POLLIN, 0 },
+                           { stop_pipe_[0], POLLIN, 0 } };
+    char buffer[4096]
+        __attribute__((aligned(__alignof__(struct inotify_event))));
+    for (;;) {
+      if (-1 == poll(poll_fds, 2, -1)) {
+        if (EINTR == errno) {
+          continue;
+        }
+        LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to poll inotify");
+        break;
+      }
+      if (poll_fds[1].revents) {
+        break;
+      }
+      const ssize_t size = read(notify_fd, buffer, sizeof(buffer));
+      if (size <= 0) {
+        continue;
+      }
+      bool changed = false;
+      for (ssize_t offset = 0; offset < size;) {
+        const inotify_event* event =
+            reinterpret_cast<const inotify_event*>(buffer + offset);
+        if (event->len && name == event->name) {
+          changed = true;
+        }
+        offset += sizeof(inotify_event) + event->len;
+      }
+      if (changed) {
+        LOG4CXX_INFO(logger_, file_name_ << " is changed, reloading");
+        profile_->ReloadValues();
+      }
+    }
+    close(notify_fd);
+#else
+    LOG4CXX_WARN(logger_, "Reload of " << file_name_
+                 << " on change is not supported on this platform");
+#endif  // __linux__
+  }
+
+  void exitThreadMain() {
+#ifdef __linux__
+    if (-1 != stop_pipe_[1]) {
+      const char stop = 0;
+      if (-1 == write(stop_pipe_[1], &stop, sizeof(stop))) {
+        LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to stop config watch");
+      }
+    }
+#endif  // __linux__
+  }
+
+ private:
+  profile::Profile* profile_;
+  const std::string file_name_;
+  int stop_pipe_[2];
+  DISALLOW_COPY_AND_ASSIGN(ConfigWatchDelegate);
+};
+}  // namespace
+
+void Profile::StartConfigWatch() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  DCHECK(NULL == config_watch_thread_);
+  config_watch_thread_ = threads::CreateThread(
+      "ConfigWatch", new ConfigWatchDelegate(this, config_file_name_));
+  config_watch_thread_->start();
+}
+
+void Profile::StopConfigWatch() {
+  if (config_watch_thread_) {
+    LOG4CXX_AUTO_TRACE(logger_);
+    config_watch_thread_->join();
+    delete config_watch_thread_->delegate();
+    threads::DeleteThread(config_watch_thread_);
+    config_watch_thread_ = NULL;
+  }
+}
+
+bool Profile::ReadIniValue(std::string* value, const char* const pSection,
+                           const char* const pKey) const {
+  sync_primitives::AutoLock auto_lock(ini_model_lock_);
+  if (ini_model_.file_name() != config_file_name_) {
+    if (!ini_model_.Load(config_file_name_)) {
+      LOG4CXX_WARN(logger_, "Failed to open " << config_file_name_);
+    }
+  }
+  return ini_model_.Find(pSection, pKey, value);
 }
 
 bool Profile::ReadValue(bool* value, const char* const pSection,
@@ -1390,11 +2230,9 @@ bool Profile::ReadValue(bool* value, const char* const pSection,
   DCHECK(value);
   bool ret = false;
 
-  char buf[INI_LINE_LEN + 1];
-  *buf = '\0';
-  if ((0 != ini_read_value(config_file_name_.c_str(), pSection, pKey, buf))
-      && ('\0' != *buf)) {
-    const int32_t tmpVal = atoi(buf);
+  std::string buf;
+  if (ReadIniValue(&buf, pSection, pKey) && !buf.empty()) {
+    const int32_t tmpVal = atoi(buf.c_str());
     if (0 == tmpVal) {
       *value = false;
     } else {
@@ -1411,10 +2249,8 @@ bool Profile::ReadValue(std::string* value, const char* const pSection,
   DCHECK(value);
   bool ret = false;
 
-  char buf[INI_LINE_LEN + 1];
-  *buf = '\0';
-  if ((0 != ini_read_value(config_file_name_.c_str(), pSection, pKey, buf))
-      && ('\0' != *buf)) {
+  std::string buf;
+  if (ReadIniValue(&buf, pSection, pKey) && !buf.empty()) {
     *value = buf;
     ret = true;
   }
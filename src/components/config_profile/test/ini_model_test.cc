@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "config_profile/ini_file.h"
+#include "config_profile/ini_model.h"
+#include "utils/file_system.h"
+
+namespace test {
+namespace components {
+namespace profile {
+
+using ::profile::IniModel;
+
+namespace {
+const std::string kIniFile = "./ini_model_test.ini";
+const char* kContent =
+    "; remark\n"
+    "Orphan = before any chapter\n"
+    "[MAIN]\n"
+    "  LaunchHMI = true   \n"
+    "PendingRequestsAmount=5000\n"
+    "Empty =\n"
+    "pendingrequestsamount = 10\n"
+    "\n"
+    "[ Security Manager ]\n"
+    "Protocol = TLSv1.2\n"
+    "[main]\n"
+    "Repeated = ignored\n";
+}  // namespace
+
+class IniModelTest : public ::testing::Test {
+ protected:
+  void SetUp() {
+    FILE* fp = fopen(kIniFile.c_str(), "w");
+    ASSERT_TRUE(NULL != fp);
+    fputs(kContent, fp);
+    fclose(fp);
+    ASSERT_TRUE(model_.Load(kIniFile));
+  }
+  void TearDown() {
+    file_system::DeleteFile(kIniFile);
+  }
+
+  // Checks model gives the same as line scanning of the file
+  void ExpectSameAsReadValue(const char* chapter, const char* item) {
+    char buf[INI_LINE_LEN + 1] = "";
+    const bool read = NULL != ::profile::ini_read_value(
+        kIniFile.c_str(), chapter, item, buf);
+    std::string value;
+    EXPECT_EQ(read, model_.Find(chapter, item, &value)) << item;
+    if (read) {
+      EXPECT_EQ(std::string(buf), value) << item;
+    }
+  }
+
+  IniModel model_;
+};
+
+TEST_F(IniModelTest, FindValues) {
+  std::string value;
+  ASSERT_TRUE(model_.Find("MAIN", "LaunchHMI", &value));
+  EXPECT_EQ("true", value);
+  ASSERT_TRUE(model_.Find("main", "PENDINGREQUESTSAMOUNT", &value));
+  EXPECT_EQ("5000", value);
+  ASSERT_TRUE(model_.Find("Security Manager", "Protocol", &value));
+  EXPECT_EQ("TLSv1.2", value);
+  EXPECT_FALSE(model_.Find("MAIN", "Repeated", &value));
+  EXPECT_FALSE(model_.Find("MAIN", "Orphan", &value));
+  EXPECT_FALSE(model_.Find("Unknown", "Protocol", &value));
+  EXPECT_FALSE(model_.Find("", "Protocol", &value));
+  EXPECT_EQ(kIniFile, model_.file_name());
+}
+
+TEST_F(IniModelTest, SameAsReadValue) {
+  const char* items[] = { "LaunchHMI", "PendingRequestsAmount", "Empty",
+                          "Repeated", "Orphan", "Protocol", "Missing" };
+  for (size_t i = 0; i < sizeof(items) / sizeof(items[0]); ++i) {
+    ExpectSameAsReadValue("MAIN", items[i]);
+    ExpectSameAsReadValue("Security Manager", items[i]);
+  }
+}
+
+TEST_F(IniModelTest, LoadMissingFile) {
+  IniModel model;
+  EXPECT_FALSE(model.Load("./missing_ini_model_test.ini"));
+  std::string value;
+  EXPECT_FALSE(model.Find("MAIN", "LaunchHMI", &value));
+  model.Swap(model_);
+  EXPECT_TRUE(model.Find("MAIN", "LaunchHMI", &value));
+  EXPECT_FALSE(model_.Find("MAIN", "LaunchHMI", &value));
+}
+
+}  // namespace profile
+}  // namespace components
+}  // namespace test
@@ -34,6 +34,7 @@
 #define SRC_COMPONENTS_CONNECTION_HANDLER_INCLUDE_CONNECTION_HANDLER_CONNECTION_H_
 
 #include <map>
+#include <set>
 #include <vector>
 
 #include "utils/lock.h"
@@ -269,6 +270,19 @@ class Connection {
    */
    bool ProtocolVersion(uint8_t session_id, uint8_t& protocol_version);
 
+  /**
+   * @brief Marks all sessions as left from lost transport link after
+   * connection is restored. Session stops being standby once it is kept
+   * alive or gets new service, i.e. mobile side has resumed it.
+   */
+  void MarkSessionsStandby();
+
+  /**
+   * @brief Takes ids of sessions that were not resumed after restoring
+   * @return session ids, standby marks are cleared
+   */
+  std::vector<uint8_t> TakeStandbySessions();
+
 
  private:
   /**
@@ -293,11 +307,15 @@ class Connection {
 
   mutable sync_primitives::Lock session_map_lock_;
 
+  /**
+   * @brief Sessions not resumed since connection restoring
+   */
+  std::set<uint8_t> standby_sessions_;
+
   /**
    * @brief monitor that closes connection if there is no traffic over it
    */
   HeartBeatMonitor* heartbeat_monitor_;
-  threads::Thread *heart_beat_monitor_thread_;
 
   DISALLOW_COPY_AND_ASSIGN(Connection);
 };
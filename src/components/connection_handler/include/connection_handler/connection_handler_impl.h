@@ -49,6 +49,7 @@
 #include "utils/logger.h"
 #include "utils/macro.h"
 #include "utils/lock.h"
+#include "utils/rwlock.h"
 #include "utils/stl_utils.h"
 #include "utils/singleton.h"
 
@@ -123,6 +124,7 @@ class ConnectionHandlerImpl : public ConnectionHandler,
   virtual void OnDeviceFound(const transport_manager::DeviceInfo &device_info);
   virtual void OnDeviceAdded(const transport_manager::DeviceInfo &device_info);
   virtual void OnDeviceRemoved(const transport_manager::DeviceInfo &device_info);
+  virtual void OnDeviceChanged(const transport_manager::DeviceInfo &device_info);
 
   virtual void OnScanDevicesFinished();
   virtual void OnScanDevicesFailed(
@@ -136,6 +138,16 @@ class ConnectionHandlerImpl : public ConnectionHandler,
   virtual void OnConnectionEstablished(
     const transport_manager::DeviceInfo &device_info,
     const transport_manager::ConnectionUID &connection_id);
+
+  /**
+   * \brief Connection with lost link is bound to new link of the device.
+   * Its sessions are kept until mobile side resumes them or starts
+   * new RPC session.
+   * \param connection_id ID of restored connection.
+   **/
+  virtual void OnConnectionRestored(
+    const transport_manager::DeviceInfo &device_info,
+    const transport_manager::ConnectionUID &connection_id);
   virtual void OnConnectionFailed(
     const transport_manager::DeviceInfo &device_info,
     const transport_manager::ConnectError &error);
@@ -420,6 +432,12 @@ class ConnectionHandlerImpl : public ConnectionHandler,
   void OnConnectionEnded(
     const transport_manager::ConnectionUID &connection_id);
 
+  /**
+   * \brief Closes sessions of restored connection that mobile side
+   * has not resumed, called when it starts new RPC session instead
+   */
+  void CloseStandbySessions(ConnectionHandle connection_handle);
+
   /**
    * \brief Pointer to observer
    */
@@ -437,15 +455,22 @@ class ConnectionHandlerImpl : public ConnectionHandler,
    */
   DeviceMap device_list_;
 
+  /**
+   * \brief Handles of devices by lowercase hashed MAC address
+   */
+  std::map<std::string, DeviceHandle> device_handles_;
+
   /**
    * \brief List of connections
    */
   ConnectionList connection_list_;
 
   /**
-   *  \brief Lock for applications list
+   *  \brief Lock for connections list. It is taken for writing only to add
+   *  or remove connection, lookups from message handling threads share it
+   *  and state of particular connection is guarded by that connection.
    */
-  mutable sync_primitives::Lock connection_list_lock_;
+  mutable sync_primitives::RWLock connection_list_lock_;
   mutable sync_primitives::Lock connection_handler_observer_lock_;
 
   /**
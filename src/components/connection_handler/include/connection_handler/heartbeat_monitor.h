@@ -35,28 +35,25 @@
 #include <stdint.h>
 #include <map>
 
-#include "utils/threads/thread.h"
-#include "utils/threads/thread_delegate.h"
 #include "utils/date_time.h"
 #include "utils/macro.h"
 #include "utils/lock.h"
+#include "utils/timer_wheel.h"
 
 namespace connection_handler {
 
 class Connection;
 
 /*
- * Starts hearbeat timer for session and when it elapses closes it
+ * Starts hearbeat timer for session and when it elapses closes it.
+ * Monitor has no thread of its own, it is armed on the shared timer wheel
+ * for the nearest deadline of its sessions and processed only then.
  */
-class HeartBeatMonitor: public threads::ThreadDelegate {
+class HeartBeatMonitor: private timer::TimerWheel::Timer {
  public:
   HeartBeatMonitor(int32_t heartbeat_timeout_seconds,
                    Connection *connection);
-
-  /**
-   * Thread procedure.
-   */
-  virtual void threadMain();
+  ~HeartBeatMonitor();
 
   /**
    * \brief add and remove session
@@ -69,22 +66,14 @@ class HeartBeatMonitor: public threads::ThreadDelegate {
    */
   void KeepAlive(uint8_t session_id);
 
-  /**
-   * \brief Thread exit procedure.
-   */
-  virtual void exitThreadMain();
-
   void set_heartbeat_timeout_seconds(int32_t timeout, uint8_t session_id);
 
  private:
-
   // \brief Heartbeat timeout, should be read from profile
   int32_t default_heartbeat_timeout_;
   // \brief Connection that must be closed when timeout elapsed
   Connection *connection_;
 
-  static const int32_t kDefaultCycleTimeout = 100000;
-
   class SessionState {
     public:
       explicit SessionState(int32_t heartbeat_timeout_seconds = 0);
@@ -93,6 +82,7 @@ class HeartBeatMonitor: public threads::ThreadDelegate {
       bool IsReadyToClose() const;
       void KeepAlive();
       bool HasTimeoutElapsed();
+      int64_t expiration_ms() const;
     private:
       void RefreshExpiration();
 
@@ -108,12 +98,26 @@ class HeartBeatMonitor: public threads::ThreadDelegate {
   SessionMap sessions_;
 
   sync_primitives::Lock sessions_list_lock_; // recurcive
-  sync_primitives::Lock main_thread_lock_;
-  mutable sync_primitives::Lock heartbeat_timeout_seconds_lock_;
+  // \brief Deadline the monitor is armed for, 0 if it is not armed
+  int64_t armed_deadline_ms_;
 
-  volatile bool run_;
+  /**
+   * \brief Called from timer wheel thread when nearest deadline comes
+   */
+  virtual void OnTimeout() OVERRIDE;
 
-  void Process();
+  /**
+   * \brief Sends heartbeats to and closes expired sessions
+   * \return Nearest deadline of remaining sessions in milliseconds,
+   * 0 if there are no sessions
+   */
+  int64_t Process();
+
+  /**
+   * \brief Arms monitor for deadline unless it is armed for earlier one.
+   * Should be called under sessions_list_lock_
+   */
+  void ScheduleProcessing(int64_t deadline_ms);
 
   DISALLOW_COPY_AND_ASSIGN(HeartBeatMonitor);
 };
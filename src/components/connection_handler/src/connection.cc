@@ -84,16 +84,11 @@ Connection::Connection(ConnectionHandle connection_handle,
   DCHECK(connection_handler_);
 
   heartbeat_monitor_ = new HeartBeatMonitor(heartbeat_timeout, this);
-  heart_beat_monitor_thread_ = threads::CreateThread("HeartBeatMonitor",
-                                                     heartbeat_monitor_);
-  heart_beat_monitor_thread_->start();
 }
 
 Connection::~Connection() {
   LOG4CXX_AUTO_TRACE(logger_);
-  heart_beat_monitor_thread_->join();
   delete heartbeat_monitor_;
-  threads::DeleteThread(heart_beat_monitor_thread_);
   sync_primitives::AutoLock lock(session_map_lock_);
   session_map_.clear();
 }
@@ -153,6 +148,7 @@ bool Connection::AddNewService(uint8_t session_id,
     LOG4CXX_WARN(logger_, "Session not found in this connection!");
     return false;
   }
+  standby_sessions_.erase(session_id);
   Session &session = session_it->second;
   Service *service = session.FindService(service_type);
   // if service already exists
@@ -370,9 +366,34 @@ void Connection::SendHeartBeat(uint8_t session_id) {
 }
 
 void Connection::KeepAlive(uint8_t session_id) {
+  {
+    sync_primitives::AutoLock lock(session_map_lock_);
+    standby_sessions_.erase(session_id);
+  }
   heartbeat_monitor_->KeepAlive(session_id);
 }
 
+void Connection::MarkSessionsStandby() {
+  sync_primitives::AutoLock lock(session_map_lock_);
+  for (SessionMap::const_iterator it = session_map_.begin();
+       it != session_map_.end(); ++it) {
+    standby_sessions_.insert(it->first);
+  }
+}
+
+std::vector<uint8_t> Connection::TakeStandbySessions() {
+  sync_primitives::AutoLock lock(session_map_lock_);
+  std::vector<uint8_t> sessions;
+  for (std::set<uint8_t>::const_iterator it = standby_sessions_.begin();
+       it != standby_sessions_.end(); ++it) {
+    if (session_map_.end() != session_map_.find(*it)) {
+      sessions.push_back(*it);
+    }
+  }
+  standby_sessions_.clear();
+  return sessions;
+}
+
 void Connection::SetHeartBeatTimeout(int32_t timeout, uint8_t session_id) {
   heartbeat_monitor_->set_heartbeat_timeout_seconds(timeout, session_id);
 }
@@ -35,6 +35,7 @@
 #include <list>
 #include <algorithm>
 #include <memory>
+#include <ctype.h>
 
 #include "connection_handler/connection_handler_impl.h"
 #include "transport_manager/info.h"
@@ -48,6 +49,13 @@ namespace {
 int32_t HeartBeatTimeout() {
   return profile::Profile::instance()->heart_beat_timeout();
 }
+
+// Hashed MAC addresses are compared case insensitively
+std::string DeviceIdKey(const std::string& device_id) {
+  std::string key(device_id);
+  std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+  return key;
+}
 }  // namespace
 
 /**
@@ -71,7 +79,6 @@ ConnectionHandlerImpl::ConnectionHandlerImpl()
   : connection_handler_observer_(NULL),
     transport_manager_(NULL),
     protocol_handler_(NULL),
-    connection_list_lock_(true),
     connection_handler_observer_lock_(true),
     connection_list_deleter_(&connection_list_) {
 }
@@ -124,6 +131,9 @@ void ConnectionHandlerImpl::set_protocol_handler(
 void ConnectionHandlerImpl::OnDeviceListUpdated(
     const std::vector<transport_manager::DeviceInfo>&) {
   LOG4CXX_AUTO_TRACE(logger_);
+  // Transport manager raises it only if devices were added, removed or
+  // changed, and device_list_ is already updated by those events
+
   sync_primitives::AutoLock lock(connection_handler_observer_lock_);
   if (connection_handler_observer_) {
     connection_handler_observer_->OnDeviceListUpdated(device_list_);
@@ -145,11 +155,15 @@ void ConnectionHandlerImpl::OnDeviceFound(
 void ConnectionHandlerImpl::OnDeviceAdded(
     const transport_manager::DeviceInfo &device_info) {
   LOG4CXX_AUTO_TRACE(logger_);
-  device_list_.insert(
+  const std::pair<DeviceMap::iterator, bool> inserted = device_list_.insert(
         DeviceMap::value_type(
           device_info.device_handle(),
           Device(device_info.device_handle(), device_info.name(),
                  device_info.mac_address(), device_info.connection_type())));
+  if (inserted.second) {
+    device_handles_[DeviceIdKey(inserted.first->second.mac_address())] =
+        device_info.device_handle();
+  }
 }
 
 void ConnectionHandlerImpl::OnDeviceRemoved(
@@ -162,7 +176,7 @@ void ConnectionHandlerImpl::OnDeviceRemoved(
 
   std::vector<ConnectionHandle> connections_to_remove;
   {
-    sync_primitives::AutoLock lock(connection_list_lock_);
+    sync_primitives::AutoReadLock lock(connection_list_lock_);
     for (ConnectionList::iterator it = connection_list_.begin();
          it != connection_list_.end(); ++it) {
       if (device_info.device_handle() ==
@@ -181,7 +195,27 @@ void ConnectionHandlerImpl::OnDeviceRemoved(
   if (connection_handler_observer_) {
     connection_handler_observer_->RemoveDevice(device_info.device_handle());
   }
-  device_list_.erase(device_info.device_handle());
+  DeviceMap::iterator device = device_list_.find(device_info.device_handle());
+  if (device_list_.end() != device) {
+    device_handles_.erase(DeviceIdKey(device->second.mac_address()));
+    device_list_.erase(device);
+  }
+}
+
+void ConnectionHandlerImpl::OnDeviceChanged(
+    const transport_manager::DeviceInfo &device_info) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  // Connections of renamed device are kept, only its description is updated
+  DeviceMap::iterator it = device_list_.find(device_info.device_handle());
+  if (device_list_.end() == it) {
+    OnDeviceAdded(device_info);
+    return;
+  }
+  device_handles_.erase(DeviceIdKey(it->second.mac_address()));
+  it->second = Device(device_info.device_handle(), device_info.name(),
+                      device_info.mac_address(), device_info.connection_type());
+  device_handles_[DeviceIdKey(it->second.mac_address())] =
+      device_info.device_handle();
 }
 
 void ConnectionHandlerImpl::OnScanDevicesFinished() {
@@ -204,7 +238,7 @@ void ConnectionHandlerImpl::OnConnectionEstablished(
     return;
   }
   LOG4CXX_DEBUG(logger_, "Add Connection #" << connection_id << " to the list.");
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoWriteLock lock(connection_list_lock_);
   connection_list_.insert(
       ConnectionList::value_type(
           connection_id,
@@ -212,6 +246,38 @@ void ConnectionHandlerImpl::OnConnectionEstablished(
                          HeartBeatTimeout())));
 }
 
+void ConnectionHandlerImpl::OnConnectionRestored(
+    const transport_manager::DeviceInfo &device_info,
+    const transport_manager::ConnectionUID &connection_id) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
+  ConnectionList::iterator it = connection_list_.find(connection_id);
+  if (connection_list_.end() == it) {
+    LOG4CXX_ERROR(logger_, "Unknown connection " << connection_id);
+    return;
+  }
+  it->second->MarkSessionsStandby();
+}
+
+void ConnectionHandlerImpl::CloseStandbySessions(
+    ConnectionHandle connection_handle) {
+  std::vector<uint8_t> standby_sessions;
+  {
+    sync_primitives::AutoReadLock lock(connection_list_lock_);
+    ConnectionList::iterator it = connection_list_.find(connection_handle);
+    if (connection_list_.end() == it) {
+      return;
+    }
+    standby_sessions = it->second->TakeStandbySessions();
+  }
+  for (std::vector<uint8_t>::const_iterator it = standby_sessions.begin();
+       it != standby_sessions.end(); ++it) {
+    LOG4CXX_INFO(logger_, "Session " << static_cast<int32_t>(*it)
+                 << " was not resumed after reconnect");
+    CloseSession(connection_handle, *it, kCommon);
+  }
+}
+
 void ConnectionHandlerImpl::OnConnectionFailed(
     const transport_manager::DeviceInfo &device_info,
     const transport_manager::ConnectError &error) {
@@ -308,52 +374,70 @@ uint32_t ConnectionHandlerImpl::OnSessionStartedCallback(
     return 0;
   }
 #endif  // ENABLE_SECURITY
-  sync_primitives::AutoLock lock(connection_list_lock_);
-  ConnectionList::iterator it = connection_list_.find(connection_handle);
-  if (connection_list_.end() == it) {
-    LOG4CXX_ERROR(logger_, "Unknown connection!");
-    return 0;
+  if ((0 == session_id) && (protocol_handler::kRpc == service_type)) {
+    // Mobile side did not keep sessions of lost link, so they are stale
+    CloseStandbySessions(connection_handle);
   }
   uint32_t new_session_id = 0;
-
-  Connection *connection = it->second;
-  if ((0 == session_id) && (protocol_handler::kRpc == service_type)) {
-    new_session_id = connection->AddNewSession();
-    if (0 == new_session_id) {
-      LOG4CXX_ERROR(logger_, "Couldn't start new session!");
+  DeviceHandle device_handle = 0;
+  {
+    // Only session allocation is done under connection list lock,
+    // observer is notified after it is released
+    sync_primitives::AutoReadLock lock(connection_list_lock_);
+    ConnectionList::iterator it = connection_list_.find(connection_handle);
+    if (connection_list_.end() == it) {
+      LOG4CXX_ERROR(logger_, "Unknown connection!");
       return 0;
     }
-    if (hash_id) {
-      *hash_id = KeyFromPair(connection_handle, new_session_id);
-    }
-  } else {  // Could be create new service or protected exists one
-    if (!connection->AddNewService(session_id, service_type, is_protected)) {
-      LOG4CXX_ERROR(logger_, "Couldn't establish "
+    Connection *connection = it->second;
+    device_handle = connection->connection_device_handle();
+    if ((0 == session_id) && (protocol_handler::kRpc == service_type)) {
+      new_session_id = connection->AddNewSession();
+      if (0 == new_session_id) {
+        LOG4CXX_ERROR(logger_, "Couldn't start new session!");
+        return 0;
+      }
+      if (hash_id) {
+        *hash_id = KeyFromPair(connection_handle, new_session_id);
+      }
+    } else {  // Could be create new service or protected exists one
+      if (!connection->AddNewService(session_id, service_type, is_protected)) {
+        LOG4CXX_ERROR(logger_, "Couldn't establish "
 #ifdef ENABLE_SECURITY
-                    << (is_protected ? "protected" : "non-protected")
+                      << (is_protected ? "protected" : "non-protected")
 #endif  // ENABLE_SECURITY
-                    << " service " << static_cast<int>(service_type)
-                    << " for session " << static_cast<int>(session_id));
-      return 0;
+                      << " service " << static_cast<int>(service_type)
+                      << " for session " << static_cast<int>(session_id));
+        return 0;
+      }
+      new_session_id = session_id;
+      if (hash_id) {
+        *hash_id = protocol_handler::HASH_ID_NOT_SUPPORTED;
+      }
     }
-    new_session_id = session_id;
-    if (hash_id) {
-      *hash_id = protocol_handler::HASH_ID_NOT_SUPPORTED;
+  }
+
+  bool success = true;
+  {
+    sync_primitives::AutoLock lock(connection_handler_observer_lock_);
+    if (connection_handler_observer_) {
+      const uint32_t session_key = KeyFromPair(connection_handle, new_session_id);
+      success = connection_handler_observer_->OnServiceStartedCallback(
+            device_handle, session_key, service_type);
     }
   }
-  sync_primitives::AutoLock lock2(connection_handler_observer_lock_);
-  if (connection_handler_observer_) {
-    const uint32_t session_key = KeyFromPair(connection_handle, new_session_id);
-    const bool success = connection_handler_observer_->OnServiceStartedCallback(
-          connection->connection_device_handle(), session_key, service_type);
-    if (!success) {
+  if (!success) {
+    // Connection could be closed while observer was deciding
+    sync_primitives::AutoReadLock lock(connection_list_lock_);
+    ConnectionList::iterator it = connection_list_.find(connection_handle);
+    if (connection_list_.end() != it) {
       if (protocol_handler::kRpc == service_type) {
-        connection->RemoveSession(new_session_id);
+        it->second->RemoveSession(new_session_id);
       } else {
-        connection->RemoveService(session_id, service_type);
+        it->second->RemoveService(session_id, service_type);
       }
-      return 0;
     }
+    return 0;
   }
   return new_session_id;
 }
@@ -402,16 +486,16 @@ uint32_t ConnectionHandlerImpl::OnSessionEndedCallback(
     const protocol_handler::ServiceType &service_type) {
   LOG4CXX_AUTO_TRACE(logger_);
 
-  connection_list_lock_.Acquire();
-  ConnectionList::iterator it = connection_list_.find(connection_handle);
-  if (connection_list_.end() == it) {
-    LOG4CXX_WARN(logger_, "Unknown connection!");
-    return 0;
+  Connection *connection = NULL;
+  {
+    sync_primitives::AutoReadLock lock(connection_list_lock_);
+    ConnectionList::iterator it = connection_list_.find(connection_handle);
+    if (connection_list_.end() == it) {
+      LOG4CXX_WARN(logger_, "Unknown connection!");
+      return 0;
+    }
+    connection = it->second;
   }
-  std::pair<int32_t, Connection*> connection_item = *it;
-  connection_list_lock_.Release();
-
-  Connection *connection = connection_item.second;
   const uint32_t session_key = KeyFromPair(connection_handle, session_id);
 
   if (protocol_handler::kRpc == service_type) {
@@ -483,6 +567,7 @@ int32_t ConnectionHandlerImpl::GetDataOnSessionKey(
   transport_manager::ConnectionUID conn_handle = 0;
   uint8_t session_id = 0;
   PairFromKey(key, &conn_handle, &session_id);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   ConnectionList::iterator it = connection_list_.find(conn_handle);
 
   if (connection_list_.end() == it) {
@@ -530,23 +615,13 @@ int32_t ConnectionHandlerImpl::GetDataOnSessionKey(
   return result;
 }
 
-struct CompareMAC {
-  explicit CompareMAC(const std::string &mac) : mac_(mac) {}
-  bool operator() (const DeviceMap::value_type &device) {
-    return strcasecmp(device.second.mac_address().c_str(), mac_.c_str()) == 0;
-  }
- private:
-  std::string mac_;
-};
-
 bool ConnectionHandlerImpl::GetDeviceID(const std::string &mac_address,
                                         DeviceHandle *device_handle) {
-  DeviceMap::const_iterator it = std::find_if(device_list_.begin(),
-                                               device_list_.end(),
-                                               CompareMAC(mac_address));
-  if (it != device_list_.end()) {
+  std::map<std::string, DeviceHandle>::const_iterator it =
+      device_handles_.find(DeviceIdKey(mac_address));
+  if (it != device_handles_.end()) {
     if (device_handle) {
-      *device_handle = it->first;
+      *device_handle = it->second;
     }
     return true;
   }
@@ -575,7 +650,7 @@ int32_t ConnectionHandlerImpl::GetDataOnDeviceID(
   }
   if (applications_list) {
     applications_list->clear();
-    sync_primitives::AutoLock connection_list_lock(connection_list_lock_);
+    sync_primitives::AutoReadLock connection_list_lock(connection_list_lock_);
     for (ConnectionList::iterator itr = connection_list_.begin();
         itr != connection_list_.end(); ++itr) {
       if (device_handle == (*itr).second->connection_device_handle()) {
@@ -607,7 +682,7 @@ int ConnectionHandlerImpl::SetSSLContext(
   uint8_t session_id = 0;
   PairFromKey(key, &connection_handle, &session_id);
 
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   ConnectionList::iterator it = connection_list_.find(connection_handle);
   if (connection_list_.end() == it) {
     LOG4CXX_ERROR(logger_, "Unknown connection!");
@@ -624,7 +699,7 @@ security_manager::SSLContext *ConnectionHandlerImpl::GetSSLContext(
   uint8_t session_id = 0;
   PairFromKey(key, &connection_handle, &session_id);
 
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   ConnectionList::iterator it = connection_list_.find(connection_handle);
   if (connection_list_.end() == it) {
     LOG4CXX_ERROR(logger_, "Unknown connection!");
@@ -641,7 +716,7 @@ void ConnectionHandlerImpl::SetProtectionFlag(
   uint8_t session_id = 0;
   PairFromKey(key, &connection_handle, &session_id);
 
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   ConnectionList::iterator it = connection_list_.find(connection_handle);
   if (connection_list_.end() == it) {
     LOG4CXX_ERROR(logger_, "Unknown connection!");
@@ -725,7 +800,7 @@ void ConnectionHandlerImpl::CloseConnection(
       ConnectionUIDFromHandle(connection_handle);
   transport_manager_->DisconnectForce(connection_uid);
 
-  sync_primitives::AutoLock connection_list_lock(connection_list_lock_);
+  sync_primitives::AutoWriteLock connection_list_lock(connection_list_lock_);
 
   ConnectionList::iterator connection_list_itr =
       connection_list_.find(connection_uid);
@@ -740,7 +815,7 @@ uint32_t ConnectionHandlerImpl::GetConnectionSessionsCount(
   uint8_t session_id = 0;
   PairFromKey(connection_key, &connection_handle, &session_id);
 
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   ConnectionList::iterator itr = connection_list_.find(connection_handle);
 
   if (connection_list_.end() != itr) {
@@ -770,7 +845,7 @@ void ConnectionHandlerImpl::CloseSession(ConnectionHandle connection_handle,
 
   SessionMap session_map;
   {
-    sync_primitives::AutoLock connection_list_lock(connection_list_lock_);
+    sync_primitives::AutoReadLock connection_list_lock(connection_list_lock_);
 
     ConnectionList::iterator connection_list_itr =
         connection_list_.find(connection_id);
@@ -828,7 +903,7 @@ void ConnectionHandlerImpl::CloseConnectionSessions(
   typedef std::vector<uint8_t> SessionIdVector;
   SessionIdVector session_id_vector;
   {
-    sync_primitives::AutoLock connection_list_lock(connection_list_lock_);
+    sync_primitives::AutoReadLock connection_list_lock(connection_list_lock_);
 
     ConnectionList::iterator connection_list_itr =
         connection_list_.find(connection_id);
@@ -870,7 +945,7 @@ void ConnectionHandlerImpl::StartSessionHeartBeat(uint32_t connection_key) {
   uint8_t session_id = 0;
   PairFromKey(connection_key, &connection_handle, &session_id);
 
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   ConnectionList::iterator it = connection_list_.find(connection_handle);
   if (connection_list_.end() != it) {
     it->second->StartHeartBeat(session_id);
@@ -882,7 +957,7 @@ void ConnectionHandlerImpl::SetHeartBeatTimeout(uint32_t connection_key,
   uint32_t connection_handle = 0;
   uint8_t session_id = 0;
   PairFromKey(connection_key, &connection_handle, &session_id);
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   ConnectionList::iterator it = connection_list_.find(connection_handle);
   if (connection_list_.end() != it) {
     it->second->SetHeartBeatTimeout(timeout, session_id);
@@ -900,7 +975,7 @@ void ConnectionHandlerImpl::SendHeartBeat(ConnectionHandle connection_handle,
 
 void ConnectionHandlerImpl::KeepConnectionAlive(uint32_t connection_key,
                                                 uint8_t session_id) {
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
 
   ConnectionList::iterator it = connection_list_.find(connection_key);
   if (connection_list_.end() != it) {
@@ -913,15 +988,17 @@ void ConnectionHandlerImpl::OnConnectionEnded(
   LOG4CXX_INFO(logger_, "Delete Connection: " << static_cast<int32_t>(connection_id)
                << " from the list.");
 
-  connection_list_lock_.Acquire();
-  ConnectionList::iterator itr = connection_list_.find(connection_id);
-  if (connection_list_.end() == itr) {
-    LOG4CXX_ERROR(logger_, "Connection not found!");
-    return;
+  std::auto_ptr<Connection> connection;
+  {
+    sync_primitives::AutoWriteLock lock(connection_list_lock_);
+    ConnectionList::iterator itr = connection_list_.find(connection_id);
+    if (connection_list_.end() == itr) {
+      LOG4CXX_ERROR(logger_, "Connection not found!");
+      return;
+    }
+    connection.reset(itr->second);
+    connection_list_.erase(itr);
   }
-  std::auto_ptr<Connection> connection(itr->second);
-  connection_list_.erase(itr);
-  connection_list_lock_.Release();
 
   sync_primitives::AutoLock lock2(connection_handler_observer_lock_);
   if (connection_handler_observer_ && connection.get() != NULL) {
@@ -947,7 +1024,7 @@ void ConnectionHandlerImpl::BindProtocolVersionWithSession(
   uint8_t session_id = 0;
   PairFromKey(connection_key, &connection_handle, &session_id);
 
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   ConnectionList::iterator it = connection_list_.find(connection_handle);
   if (connection_list_.end() != it) {
     it->second->UpdateProtocolVersionSession(session_id, protocol_version);
@@ -957,7 +1034,7 @@ void ConnectionHandlerImpl::BindProtocolVersionWithSession(
 bool ConnectionHandlerImpl::IsHeartBeatSupported(
     transport_manager::ConnectionUID connection_handle,uint8_t session_id) {
   LOG4CXX_AUTO_TRACE(logger_);
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   uint32_t connection = static_cast<uint32_t>(connection_handle);
   ConnectionList::iterator it = connection_list_.find(connection);
   if (connection_list_.end() == it) {
@@ -970,7 +1047,7 @@ bool ConnectionHandlerImpl::IsHeartBeatSupported(
 bool ConnectionHandlerImpl::ProtocolVersionUsed(uint32_t connection_id,
 		  uint8_t session_id, uint8_t& protocol_version) {
   LOG4CXX_AUTO_TRACE(logger_);
-  sync_primitives::AutoLock lock(connection_list_lock_);
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
   ConnectionList::iterator it = connection_list_.find(connection_id);
   if (connection_list_.end() != it) {
     return it->second->ProtocolVersion(session_id, protocol_version);
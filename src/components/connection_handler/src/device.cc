@@ -35,7 +35,10 @@
 
 #include "connection_handler/device.h"
 #include "encryption/hashing.h"
+#include "utils/lock.h"
 #include "utils/logger.h"
+#include "utils/macro.h"
+#include "utils/singleton.h"
 
 /**
  * \namespace connection_handler
@@ -45,6 +48,38 @@ namespace connection_handler {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "ConnectionHandler")
 
+namespace {
+/*
+ * Hashes of MAC addresses seen by the process. Devices are recreated
+ * on every change reported by transport manager, physical device
+ * is hashed only once.
+ */
+class DeviceIdCache : public utils::Singleton<DeviceIdCache> {
+ public:
+  std::string Get(const std::string& mac_address) {
+    sync_primitives::AutoLock lock(lock_);
+    std::map<std::string, std::string>::const_iterator it =
+        ids_.find(mac_address);
+    if (ids_.end() != it) {
+      return it->second;
+    }
+    const std::string id = encryption::MakeHash(mac_address);
+    ids_.insert(std::make_pair(mac_address, id));
+    LOG4CXX_INFO(logger_, "Device MAC address hash is: " << id);
+    return id;
+  }
+
+ private:
+  DeviceIdCache() {}
+
+  sync_primitives::Lock lock_;
+  std::map<std::string, std::string> ids_;
+
+  FRIEND_BASE_SINGLETON_CLASS(DeviceIdCache);
+  DISALLOW_COPY_AND_ASSIGN(DeviceIdCache);
+};
+}  // namespace
+
 Device::Device(DeviceHandle device_handle,
                const std::string &user_friendly_name,
                const std::string &mac_address, const std::string& connection_type)
@@ -52,9 +87,8 @@ Device::Device(DeviceHandle device_handle,
       user_friendly_name_(user_friendly_name),
       mac_address_(mac_address),
       connection_type_(connection_type){
-    LOG4CXX_INFO(logger_, "Device MAC address is: " << mac_address_);
-    mac_address_ = encryption::MakeHash(mac_address);
-    LOG4CXX_INFO(logger_, "Device MAC address hash is: " << mac_address_);
+    LOG4CXX_DEBUG(logger_, "Device MAC address is: " << mac_address_);
+    mac_address_ = DeviceIdCache::instance()->Get(mac_address);
 }
 
 DeviceHandle Device::device_handle() const {
@@ -31,7 +31,6 @@
  */
 #include "connection_handler/heartbeat_monitor.h"
 
-#include <unistd.h>
 #include <utility>
 
 #include "utils/logger.h"
@@ -48,10 +47,40 @@ HeartBeatMonitor::HeartBeatMonitor(int32_t heartbeat_timeout_seconds,
     : default_heartbeat_timeout_(heartbeat_timeout_seconds),
       connection_(connection),
       sessions_list_lock_(true),
-      run_(true) {
+      armed_deadline_ms_(0) {
+  LOG4CXX_DEBUG(
+      logger_,
+      "Start heart beat monitor. Timeout is " << default_heartbeat_timeout_);
 }
 
-void HeartBeatMonitor::Process() {
+HeartBeatMonitor::~HeartBeatMonitor() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  // Waits for running processing to finish
+  timer::TimerWheel::instance()->Cancel(this);
+}
+
+void HeartBeatMonitor::OnTimeout() {
+  AutoLock auto_lock(sessions_list_lock_);
+  armed_deadline_ms_ = 0;
+  const int64_t next_deadline_ms = Process();
+  if (next_deadline_ms > 0) {
+    ScheduleProcessing(next_deadline_ms);
+  }
+}
+
+void HeartBeatMonitor::ScheduleProcessing(int64_t deadline_ms) {
+  if (armed_deadline_ms_ > 0 && armed_deadline_ms_ <= deadline_ms) {
+    // Later deadlines are picked up when armed one expires
+    return;
+  }
+  const int64_t now_ms =
+      date_time::DateTime::getmSecs(date_time::DateTime::getCurrentTime());
+  const int64_t timeout_ms = deadline_ms > now_ms ? deadline_ms - now_ms : 0;
+  armed_deadline_ms_ = deadline_ms;
+  timer::TimerWheel::instance()->Arm(this, static_cast<uint64_t>(timeout_ms));
+}
+
+int64_t HeartBeatMonitor::Process() {
   AutoLock auto_lock(sessions_list_lock_);
 
   SessionMap::iterator it = sessions_.begin();
@@ -73,17 +102,15 @@ void HeartBeatMonitor::Process() {
     }
     ++it;
   }
-}
 
-void HeartBeatMonitor::threadMain() {
-  AutoLock main_lock(main_thread_lock_);
-  LOG4CXX_DEBUG(
-      logger_,
-      "Start heart beat monitor. Timeout is " << default_heartbeat_timeout_);
-  while (run_) {
-    usleep(kDefaultCycleTimeout);
-    Process();
+  int64_t next_deadline_ms = 0;
+  for (it = sessions_.begin(); it != sessions_.end(); ++it) {
+    const int64_t expiration_ms = it->second.expiration_ms();
+    if (0 == next_deadline_ms || expiration_ms < next_deadline_ms) {
+      next_deadline_ms = expiration_ms;
+    }
   }
+  return next_deadline_ms;
 }
 
 void HeartBeatMonitor::AddSession(uint8_t session_id) {
@@ -95,8 +122,9 @@ void HeartBeatMonitor::AddSession(uint8_t session_id) {
         "Session with id " << static_cast<int32_t>(session_id) << " already exists");
     return;
   }
-  sessions_.insert(std::make_pair(session_id,
-                                  SessionState(default_heartbeat_timeout_)));
+  const SessionState state(default_heartbeat_timeout_);
+  sessions_.insert(std::make_pair(session_id, state));
+  ScheduleProcessing(state.expiration_ms());
   LOG4CXX_INFO(logger_, "Start heartbeat for session " << session_id);
 }
 
@@ -124,22 +152,17 @@ void HeartBeatMonitor::KeepAlive(uint8_t session_id) {
   }
 }
 
-void HeartBeatMonitor::exitThreadMain() {
-  // FIXME (dchmerev@luxoft.com): thread requested to stop should stop as soon as possible,
-  // not running one more iteration before actual stop
-  LOG4CXX_AUTO_TRACE(logger_);
-  run_ = false;
-  AutoLock main_lock(main_thread_lock_);
-}
-
 void HeartBeatMonitor::set_heartbeat_timeout_seconds(int32_t timeout,
                                                      uint8_t session_id) {
   LOG4CXX_DEBUG(logger_, "Set new heart beat timeout " << timeout <<
                 "For session: " << session_id);
 
   AutoLock session_locker(sessions_list_lock_);
-  if (sessions_.end() != sessions_.find(session_id)) {
-    sessions_[session_id].UpdateTimeout(timeout);
+  SessionMap::iterator it = sessions_.find(session_id);
+  if (sessions_.end() != it) {
+    it->second.UpdateTimeout(timeout);
+    // Decreased timeout may expire before currently scheduled deadline
+    ScheduleProcessing(it->second.expiration_ms());
   }
 }
 
@@ -179,6 +202,13 @@ void HeartBeatMonitor::SessionState::KeepAlive() {
   RefreshExpiration();
 }
 
+int64_t HeartBeatMonitor::SessionState::expiration_ms() const {
+  // Rounded up for session to be elapsed when its deadline comes
+  return (date_time::DateTime::getuSecs(heartbeat_expiration) +
+          date_time::DateTime::MICROSECONDS_IN_MILLISECONDS - 1) /
+         date_time::DateTime::MICROSECONDS_IN_MILLISECONDS;
+}
+
 bool HeartBeatMonitor::SessionState::HasTimeoutElapsed() {
   TimevalStruct now = date_time::DateTime::getCurrentTime();
   return date_time::DateTime::Greater(now, heartbeat_expiration);
@@ -31,6 +31,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <fstream>
 #include <cstdint>
 #include "connection_handler/connection_handler_impl.h"
@@ -223,6 +224,24 @@ TEST_F(ConnectionHandlerTest, StartSession) {
   AddTestSession();
 }
 
+TEST_F(ConnectionHandlerTest, GetDeviceID_ByHashedMacAnyCase) {
+  AddTestDeviceConnection();
+  std::string device_id;
+  ASSERT_EQ(0, connection_handler_->GetDataOnDeviceID(0, NULL, NULL,
+                                                      &device_id));
+  std::transform(device_id.begin(), device_id.end(), device_id.begin(),
+                 ::toupper);
+
+  DeviceHandle device_handle = 1;
+  EXPECT_TRUE(connection_handler_->GetDeviceID(device_id, &device_handle));
+  EXPECT_EQ(0u, device_handle);
+
+  connection_handler_->OnDeviceRemoved(transport_manager::DeviceInfo(
+      0, std::string("test_address"), std::string("test_name"),
+      std::string("BTMAC")));
+  EXPECT_FALSE(connection_handler_->GetDeviceID(device_id, &device_handle));
+}
+
 TEST_F(ConnectionHandlerTest, StartService_withServices) {
   // Add virtual device and connection
   AddTestDeviceConnection();
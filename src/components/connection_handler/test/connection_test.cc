@@ -294,6 +294,28 @@ TEST_F(ConnectionTest, Session_AddAllOtherService_DelayProtected2) {
 #endif  // ENABLE_SECURITY
 }
 
+TEST_F(ConnectionTest, Session_StandbyNotResumed) {
+  StartSession();
+  connection_->MarkSessionsStandby();
+
+  const std::vector<uint8_t> standby_sessions =
+      connection_->TakeStandbySessions();
+  ASSERT_EQ(1u, standby_sessions.size());
+  EXPECT_EQ(session_id, standby_sessions.front());
+  // Marks are taken only once
+  EXPECT_TRUE(connection_->TakeStandbySessions().empty());
+}
+
+TEST_F(ConnectionTest, Session_StandbyResumedByNewService) {
+  StartSession();
+  connection_->MarkSessionsStandby();
+
+  AddNewService(protocol_handler::kAudio, PROTECTION_OFF,
+                EXPECT_RETURN_TRUE,
+                EXPECT_SERVICE_EXISTS);
+  EXPECT_TRUE(connection_->TakeStandbySessions().empty());
+}
+
 }  // namespace connection_handle
 }  // namespace components
 }  // namespace test
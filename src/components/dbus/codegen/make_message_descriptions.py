@@ -203,6 +203,25 @@ class Impl(FordXmlParser):
                 message_desc_name = interface + '__' + name + '__' + messagetype
                 out.write("  &" + message_desc_name + ",\n")
         out.write("  NULL\n")
+        out.write("};\n\n")
+
+
+    def make_sorted_message_array(self, out):
+        """Writes descriptions sorted by interface and name like strcmp does,
+        so they are found by binary search without building indexes"""
+        names = list()
+        for interface_el in self.el_tree.findall('interface'):
+            interface = interface_el.get('name')
+            for message_el in interface_el.findall('function'):
+                names.append((interface, message_el.get('name'),
+                              message_el.get('messagetype')))
+        # Stable sort keeps XML order of message types of the same name
+        names.sort(key=lambda name: (name[0].encode('ascii'),
+                                     name[1].encode('ascii')))
+        out.write("const MessageDescription* message_descriptions_by_name[] = {\n")
+        for interface, name, messagetype in names:
+            out.write("  &" + interface + '__' + name + '__' + messagetype + ",\n")
+        out.write("  NULL\n")
         out.write("};\n")
 
 
@@ -269,5 +288,6 @@ out.write("}\n\n");
 
 out.write("namespace " + namespace_name + " {\n\n");
 impl.make_message_array(out)
+impl.make_sorted_message_array(out)
 out.write("}\n\n");
 
@@ -66,6 +66,8 @@ struct MessageDescription {
 };
 
 extern const MessageDescription* message_descriptions[];
+// The same descriptions sorted by interface and name, as strcmp orders them
+extern const MessageDescription* message_descriptions_by_name[];
 
 }  // namespace ford_message_descriptions
 
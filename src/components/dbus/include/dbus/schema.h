@@ -37,6 +37,7 @@
 #include <utility>
 
 #include "dbus/message_descriptions.h"
+#include "utils/macro.h"
 #include "interfaces/HMI_API.h"
 
 namespace dbus {
@@ -57,14 +58,29 @@ typedef std::vector<const Description*> Messages;
  */
 class DBusSchema {
  public:
+  /**
+   * \brief builds schema, sorts own copy of descriptions for name lookups
+   * \param array NULL terminated descriptions
+   */
   explicit DBusSchema(const MessageDescription** array);
 
+  /**
+   * \brief builds schema from descriptions already sorted by generator
+   * \param array NULL terminated descriptions
+   * \param sorted_by_name the same descriptions ordered by interface and
+   * name as strcmp orders them
+   */
+  DBusSchema(const MessageDescription** array,
+             const MessageDescription** sorted_by_name);
+
+  ~DBusSchema();
+
   /**
    * \brief gets message name by message id
    * \param id id message
    * \return name message
    */
-  MessageName getMessageName(MessageId id) const;
+  const MessageName& getMessageName(MessageId id) const;
 
   /**
    * \brief gets message id by message name
@@ -73,13 +89,21 @@ class DBusSchema {
    */
   MessageId getMessageId(const MessageName& name) const;
 
+  /**
+   * \brief gets message id by names taken right from D-Bus message
+   * \param interface short name of interface
+   * \param name name message
+   * \return id message
+   */
+  MessageId getMessageId(const char* interface, const char* name) const;
+
   /**
    * \brief gets list rules for arguments
    * \param id id message
    * \param type type message
    * \return list rules
    */
-  ListArgs getListArgs(MessageId id, MessageType type) const;
+  const ListArgs& getListArgs(MessageId id, MessageType type) const;
 
   /**
    * \brief gets list rules for arguments
@@ -87,10 +111,39 @@ class DBusSchema {
    * @param type type message
    * @return list rules
    */
-  ListArgs getListArgs(const MessageName& name, MessageType type) const;
+  const ListArgs& getListArgs(const MessageName& name,
+                              MessageType type) const;
+
+  /**
+   * \brief gets list rules for arguments by names taken from D-Bus message
+   * \param interface short name of interface
+   * \param name name message
+   * \param type type message
+   * \return list rules
+   */
+  const ListArgs& getListArgs(const char* interface, const char* name,
+                              MessageType type) const;
 
  private:
+  void AddMessages(const MessageDescription** array);
+  void IndexById();
+
+  /**
+   * \brief binary search of first description of interface and name
+   * \return index in names_ or names_.size() if there is no such message
+   */
+  size_t FindName(const char* interface, const char* name) const;
+  const Description* FindIdType(MessageId id, MessageType type) const;
+
   Messages msgs_;
+  // Lookups are done for every message, so ids index plain tables
+  // and names are searched in descriptions sorted by generator
+  Messages ids_;
+  // Indexed by id * types_count_ + type
+  Messages id_types_;
+  size_t types_count_;
+  Messages names_;
+  DISALLOW_COPY_AND_ASSIGN(DBusSchema);
 };
 
 }  // namespace dbus
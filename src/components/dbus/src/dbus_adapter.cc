@@ -32,7 +32,7 @@
 
 #include "dbus/dbus_adapter.h"
 #include <dbus/dbus.h>
-#include <sstream>
+#include <string.h>
 #include "formatters/CSmartFactory.hpp"
 #include "utils/logger.h"
 
@@ -46,15 +46,13 @@ namespace dbus {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "HMIMessageHandler")
 
-std::vector<std::string> &split(const std::string& s, char delim,
-                                std::vector<std::string> &elems) {
-  std::stringstream ss(s);
-  std::string item;
-  while (std::getline(ss, item, delim)) {
-    elems.push_back(item);
-  }
-  return elems;
+namespace {
+// Schema knows interfaces by last component of D-Bus interface name
+const char* ShortInterfaceName(const char* interface) {
+  const char* last_dot = strrchr(interface, '.');
+  return last_dot ? last_dot + 1 : interface;
 }
+}  // namespace
 
 DBusAdapter::DBusAdapter(const std::string& sdlServiceName,
                          const std::string& sdlObjectPath,
@@ -65,7 +63,9 @@ DBusAdapter::DBusAdapter(const std::string& sdlServiceName,
       hmi_service_name_(hmiServiceName),
       hmi_object_path_(hmiObjectPath),
       conn_(NULL),
-      schema_(new DBusSchema(ford_message_descriptions::message_descriptions)) {
+      schema_(new DBusSchema(
+          ford_message_descriptions::message_descriptions,
+          ford_message_descriptions::message_descriptions_by_name)) {
 }
 
 DBusAdapter::~DBusAdapter() {
@@ -302,21 +302,23 @@ void DBusAdapter::AddMatch(const std::string& rule) {
 
 bool DBusAdapter::ProcessMethodCall(DBusMessage* msg,
                                     smart_objects::SmartObject& obj) {
-  std::string method = dbus_message_get_member(msg);
-  std::string interface = dbus_message_get_interface(msg);
+  const char* method = dbus_message_get_member(msg);
+  const char* interface = dbus_message_get_interface(msg);
+  if (!method || !interface) {
+    LOG4CXX_ERROR(logger_, "DBus: method call without name from hmi");
+    return false;
+  }
   LOG4CXX_INFO(logger_, "DBus: name of method " << interface << " " << method);
 
-  if (interface == "org.freedesktop.DBus.Introspectable"
-      && method == "Introspect") {
+  if (0 == strcmp(interface, "org.freedesktop.DBus.Introspectable")
+      && 0 == strcmp(method, "Introspect")) {
     LOG4CXX_INFO(logger_, "DBus: INTROSPECT");
     Introspect(msg);
     return false;
   }
 
-  std::vector<std::string> elems;
-  split(interface, '.', elems);
-  MessageName name(elems.back(), method);
-  MessageId m_id = schema_->getMessageId(name);
+  const char* short_interface = ShortInterfaceName(interface);
+  MessageId m_id = schema_->getMessageId(short_interface, method);
   if (m_id == hmi_apis::FunctionID::INVALID_ENUM) {
     LOG4CXX_ERROR(logger_, "DBus: Invalid name method call from hmi");
     return false;
@@ -334,8 +336,8 @@ bool DBusAdapter::ProcessMethodCall(DBusMessage* msg,
   obj[sos::S_MSG_PARAMS] = smart_objects::SmartObject(
       smart_objects::SmartType_Map);
 
-  const ListArgs args = schema_->getListArgs(name,
-                                             hmi_apis::messageType::request);
+  const ListArgs& args = schema_->getListArgs(short_interface, method,
+                                              hmi_apis::messageType::request);
 
   DBusMessageIter iter;
   dbus_message_iter_init(msg, &iter);
@@ -359,8 +361,8 @@ bool DBusAdapter::ProcessMethodReturn(DBusMessage* msg,
   obj[sos::S_MSG_PARAMS] = smart_objects::SmartObject(
       smart_objects::SmartType_Map);
 
-  ListArgs args = schema_->getListArgs(ids.second,
-                                       hmi_apis::messageType::response);
+  const ListArgs& args = schema_->getListArgs(ids.second,
+                                              hmi_apis::messageType::response);
   DBusMessageIter iter;
   dbus_message_iter_init(msg, &iter);
   int code = 0;
@@ -376,7 +378,7 @@ bool DBusAdapter::ProcessMethodReturn(DBusMessage* msg,
     obj[sos::S_PARAMS][sos::kCode] = code;
     obj[sos::S_PARAMS][sos::kMessage] = message;
     if (code != hmi_apis::Common_Result::SUCCESS) {
-      MessageName name = schema_->getMessageName(ids.second);
+      const MessageName& name = schema_->getMessageName(ids.second);
       description["method"] = name.first + "." + name.second;
       obj[sos::S_PARAMS]["data"] = description;
     } else {
@@ -413,7 +415,7 @@ bool DBusAdapter::ProcessError(DBusMessage* msg,
     DBusMessageIter iter;
     dbus_message_iter_init(msg, &iter);
     ret = GetArguments(&iter, args, description);
-    MessageName method = schema_->getMessageName(ids.second);
+    const MessageName& method = schema_->getMessageName(ids.second);
 
     obj[sos::S_PARAMS][sos::S_CORRELATION_ID] = ids.first;
     obj[sos::S_PARAMS][sos::S_FUNCTION_ID] = ids.second;
@@ -438,14 +440,16 @@ bool DBusAdapter::ProcessError(DBusMessage* msg,
 
 bool DBusAdapter::ProcessSignal(DBusMessage* msg,
                                 smart_objects::SmartObject& obj) {
-  std::string method = dbus_message_get_member(msg);
-  std::string interface = dbus_message_get_interface(msg);
+  const char* method = dbus_message_get_member(msg);
+  const char* interface = dbus_message_get_interface(msg);
+  if (!method || !interface) {
+    LOG4CXX_ERROR(logger_, "DBus: signal without name");
+    return false;
+  }
   LOG4CXX_INFO(logger_, "DBus: name of signal " << method);
 
-  std::vector<std::string> elems;
-  split(interface, '.', elems);
-  MessageName name(elems.back(), method);
-  MessageId m_id = schema_->getMessageId(name);
+  const char* short_interface = ShortInterfaceName(interface);
+  MessageId m_id = schema_->getMessageId(short_interface, method);
   if (m_id == hmi_apis::FunctionID::INVALID_ENUM) {
     LOG4CXX_ERROR(logger_, "DBus: Invalid name signal");
     return false;
@@ -456,8 +460,8 @@ bool DBusAdapter::ProcessSignal(DBusMessage* msg,
   obj[sos::S_MSG_PARAMS] = smart_objects::SmartObject(
       smart_objects::SmartType_Map);
 
-  const ListArgs args = schema_->getListArgs(
-      name, hmi_apis::messageType::notification);
+  const ListArgs& args = schema_->getListArgs(
+      short_interface, method, hmi_apis::messageType::notification);
 
   DBusMessageIter iter;
   dbus_message_iter_init(msg, &iter);
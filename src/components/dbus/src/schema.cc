@@ -31,8 +31,9 @@
  */
 #include "dbus/schema.h"
 
+#include <string.h>
 #include <algorithm>
-#include <functional>
+#include <map>
 
 namespace dbus {
 
@@ -41,63 +42,71 @@ struct Description {
   MessageName name;
   MessageType type;
   ListArgs args;
+  const MessageDescription* source;
 };
 
-struct IsId : public std::unary_function<const Description*, bool> {
-  explicit IsId(MessageId id)
-      : id_(id) {
-  }
-  bool operator()(const Description* desc) {
-    return desc->id == id_;
-  }
- private:
-  MessageId id_;
-};
+namespace {
+int CompareNames(const Description* desc, const char* interface,
+                 const char* name) {
+  const int result = strcmp(desc->source->interface, interface);
+  return 0 != result ? result : strcmp(desc->source->name, name);
+}
 
-struct IsName : public std::unary_function<const Description*, bool> {
-  explicit IsName(const MessageName& name)
-      : name_(name) {
-  }
-  bool operator()(const Description* desc) {
-    return desc->name == name_;
-  }
- private:
-  MessageName name_;
-};
+bool NameLess(const Description* left, const Description* right) {
+  return CompareNames(left, right->source->interface, right->source->name) < 0;
+}
+
+size_t Index(int32_t value) {
+  // Negative values wrap around to large indexes
+  return static_cast<uint32_t>(value);
+}
+}  // namespace
 
-struct IsIdType : public std::unary_function<const Description*, bool> {
-  explicit IsIdType(const MessageId& id, const MessageType& type)
-      : id_(id),
-        type_(type) {
+DBusSchema::DBusSchema(const MessageDescription** array)
+  : types_count_(0) {
+  AddMessages(array);
+  IndexById();
+  names_ = msgs_;
+  std::stable_sort(names_.begin(), names_.end(), NameLess);
+}
+
+DBusSchema::DBusSchema(const MessageDescription** array,
+                       const MessageDescription** sorted_by_name)
+  : types_count_(0) {
+  AddMessages(array);
+  IndexById();
+  std::map<const MessageDescription*, const Description*> descriptions;
+  for (Messages::const_iterator it = msgs_.begin(); msgs_.end() != it; ++it) {
+    descriptions.insert(std::make_pair((*it)->source, *it));
   }
-  bool operator()(const Description* desc) {
-    return desc->id == id_ && desc->type == type_;
+  for (const MessageDescription** msg = sorted_by_name; *msg != NULL; ++msg) {
+    std::map<const MessageDescription*, const Description*>::const_iterator
+        it = descriptions.find(*msg);
+    DCHECK(descriptions.end() != it);
+    if (descriptions.end() != it) {
+      names_.push_back(it->second);
+    }
   }
- private:
-  MessageId id_;
-  MessageType type_;
-};
-
-struct IsNameType : public std::unary_function<const Description*, bool> {
-  explicit IsNameType(const MessageName& name, const MessageType& type)
-      : name_(name),
-        type_(type) {
+  DCHECK(msgs_.size() == names_.size());
+  for (size_t i = 1; i < names_.size(); ++i) {
+    DCHECK(!NameLess(names_[i], names_[i - 1]));
   }
-  bool operator()(const Description* desc) {
-    return desc->name == name_ && desc->type == type_;
+}
+
+DBusSchema::~DBusSchema() {
+  for (Messages::iterator it = msgs_.begin(); msgs_.end() != it; ++it) {
+    delete *it;
   }
- private:
-  MessageName name_;
-  MessageType type_;
-};
+}
 
-DBusSchema::DBusSchema(const MessageDescription** array) {
+void DBusSchema::AddMessages(const MessageDescription** array) {
   const MessageDescription** msg = array;
   while (*msg != NULL) {
     Description *desc = new Description();
     desc->id = (*msg)->function_id;
     desc->name = std::make_pair((*msg)->interface, (*msg)->name);
     desc->type = (*msg)->message_type;
+    desc->source = *msg;
     const ParameterDescription** param;
     param = (*msg)->parameters;
     while (*param != NULL) {
@@ -109,41 +118,100 @@ DBusSchema::DBusSchema(const MessageDescription** array) {
   }
 }
 
-MessageName DBusSchema::getMessageName(MessageId id) const {
-  Messages::const_iterator it = std::find_if(msgs_.begin(), msgs_.end(),
-                                             IsId(id));
-  if (msgs_.end() != it) {
-    return (*it)->name;
+void DBusSchema::IndexById() {
+  size_t ids_count = 0;
+  for (Messages::const_iterator it = msgs_.begin(); msgs_.end() != it; ++it) {
+    ids_count = std::max(ids_count, Index((*it)->id) + 1);
+    types_count_ = std::max(types_count_, Index((*it)->type) + 1);
   }
-  return MessageName();
+  ids_.assign(ids_count, NULL);
+  id_types_.assign(ids_count * types_count_, NULL);
+  for (Messages::const_iterator it = msgs_.begin(); msgs_.end() != it; ++it) {
+    // First description wins like in former linear search
+    const Description*& by_id = ids_[Index((*it)->id)];
+    if (!by_id) {
+      by_id = *it;
+    }
+    const Description*& by_id_type =
+        id_types_[Index((*it)->id) * types_count_ + Index((*it)->type)];
+    if (!by_id_type) {
+      by_id_type = *it;
+    }
+  }
+}
+
+size_t DBusSchema::FindName(const char* interface, const char* name) const {
+  size_t first = 0;
+  size_t count = names_.size();
+  while (count > 0) {
+    const size_t step = count / 2;
+    if (CompareNames(names_[first + step], interface, name) < 0) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  if (first < names_.size() &&
+      0 == CompareNames(names_[first], interface, name)) {
+    return first;
+  }
+  return names_.size();
+}
+
+const Description* DBusSchema::FindIdType(MessageId id,
+                                          MessageType type) const {
+  if (Index(id) >= ids_.size() || Index(type) >= types_count_) {
+    return NULL;
+  }
+  return id_types_[Index(id) * types_count_ + Index(type)];
+}
+
+const MessageName& DBusSchema::getMessageName(MessageId id) const {
+  static const MessageName kEmptyName;
+  if (Index(id) < ids_.size() && ids_[Index(id)]) {
+    return ids_[Index(id)]->name;
+  }
+  return kEmptyName;
 }
 
 MessageId DBusSchema::getMessageId(const MessageName& name) const {
-  Messages::const_iterator it = std::find_if(msgs_.begin(), msgs_.end(),
-                                             IsName(name));
-  if (msgs_.end() != it) {
-    return (*it)->id;
+  return getMessageId(name.first.c_str(), name.second.c_str());
+}
+
+MessageId DBusSchema::getMessageId(const char* interface,
+                                   const char* name) const {
+  const size_t index = FindName(interface, name);
+  if (index < names_.size()) {
+    return names_[index]->id;
   }
   return hmi_apis::FunctionID::eType::INVALID_ENUM;
 }
 
-ListArgs DBusSchema::getListArgs(MessageId id, MessageType type) const {
-  Messages::const_iterator it = std::find_if(msgs_.begin(), msgs_.end(),
-                                             IsIdType(id, type));
-  if (msgs_.end() != it) {
-    return (*it)->args;
-  }
-  return ListArgs();
+const ListArgs& DBusSchema::getListArgs(MessageId id, MessageType type) const {
+  static const ListArgs kEmptyArgs;
+  const Description* desc = FindIdType(id, type);
+  return desc ? desc->args : kEmptyArgs;
+}
+
+const ListArgs& DBusSchema::getListArgs(const MessageName& name,
+                                        MessageType type) const {
+  return getListArgs(name.first.c_str(), name.second.c_str(), type);
 }
 
-ListArgs DBusSchema::getListArgs(const MessageName& name,
-                                 MessageType type) const {
-  Messages::const_iterator it = std::find_if(msgs_.begin(), msgs_.end(),
-                                             IsNameType(name, type));
-  if (msgs_.end() != it) {
-    return (*it)->args;
+const ListArgs& DBusSchema::getListArgs(const char* interface,
+                                        const char* name,
+                                        MessageType type) const {
+  static const ListArgs kEmptyArgs;
+  // Descriptions of all types of message are next to each other
+  for (size_t i = FindName(interface, name);
+       i < names_.size() && 0 == CompareNames(names_[i], interface, name);
+       ++i) {
+    if (type == names_[i]->type) {
+      return names_[i]->args;
+    }
   }
-  return ListArgs();
+  return kEmptyArgs;
 }
 
 }  // namespace dbus_schema
@@ -112,6 +112,25 @@ TEST_F(DBusSchemaTest, GetListArg) {
   EXPECT_EQ(kExpListWrong, argsId);
 }
 
+TEST_F(DBusSchemaTest, GetByNamesOfDBusMessage) {
+  const DBusSchema sorted_schema(
+      ford_message_descriptions::message_descriptions,
+      ford_message_descriptions::message_descriptions_by_name);
+  const MessageName kName("Buttons", "GetCapabilities");
+  const MessageType kType = hmi_apis::messageType::response;
+  const DBusSchema* schemas[] = { schema_, &sorted_schema };
+  for (size_t i = 0; i < sizeof(schemas) / sizeof(schemas[0]); ++i) {
+    EXPECT_EQ(hmi_apis::FunctionID::Buttons_GetCapabilities,
+              schemas[i]->getMessageId("Buttons", "GetCapabilities"));
+    EXPECT_EQ(hmi_apis::FunctionID::INVALID_ENUM,
+              schemas[i]->getMessageId("Buttons", "TestMessage"));
+    EXPECT_EQ(schema_->getListArgs(kName, kType),
+              schemas[i]->getListArgs("Buttons", "GetCapabilities", kType));
+    EXPECT_EQ(ListArgs(),
+              schemas[i]->getListArgs("TestInterface", "TestMessage", kType));
+  }
+}
+
 }  // namespace dbus
 }  // namespace components
 }  // namespace test
@@ -35,6 +35,9 @@
 #ifndef __CFORMATTERJSONBASE_HPP__
 #define __CFORMATTERJSONBASE_HPP__
 
+#include <string>
+#include <vector>
+
 #include "smart_objects/smart_object.h"
 #include "json/json.h"
 
@@ -105,6 +108,40 @@ namespace meta_formatter_error_code {
         static void jsonValueToObj(const Json::Value &value,
                 NsSmartDeviceLink::NsSmartObjects::SmartObject &obj);
 
+        /**
+         * @brief The method constructs a SmartObject directly from JSON text
+         *
+         * Accepts the same documents as Json::Reader with default features
+         * and gives the same SmartObject as jsonValueToObj would do, but
+         * without building intermediate Json::Value tree. Text does not need
+         * to be NUL-terminated.
+         *
+         * @param begin Start of JSON text.
+         * @param end End of JSON text.
+         * @param obj The resulting SmartObject, is not changed on failure.
+         * @return true if text is parsed successfully, false otherwise.
+         */
+        static bool jsonStringToObj(const char *begin, const char *end,
+                NsSmartDeviceLink::NsSmartObjects::SmartObject &obj);
+
+        /**
+         * @brief The method constructs a SmartObject of one member of JSON text
+         *
+         * Only value at the path is built, other values are checked the same
+         * way as jsonStringToObj does but skipped, so routing fields can be
+         * read without paying for the whole message.
+         *
+         * @param begin Start of JSON text.
+         * @param end End of JSON text.
+         * @param path Names of nested object members leading to the value,
+         *             empty path denotes the root value.
+         * @param obj The resulting SmartObject, is not changed on failure.
+         * @return true if text is valid and the member exists, false otherwise.
+         */
+        static bool jsonStringMemberToObj(const char *begin, const char *end,
+                const std::vector<std::string> &path,
+                NsSmartDeviceLink::NsSmartObjects::SmartObject &obj);
+
        /**
          * @brief The method constructs a JSON object from the input SmartObject
          *
@@ -113,6 +150,27 @@ namespace meta_formatter_error_code {
          */
         static void objToJsonValue(const NsSmartDeviceLink::NsSmartObjects::SmartObject &obj,
                 Json::Value &value);
+
+       /**
+         * @brief The method appends compact JSON text of the input SmartObject
+         *
+         * Gives the same JSON as objToJsonValue followed by Json writer,
+         * but without building intermediate Json::Value tree.
+         *
+         * @param obj Input SmartObject. Can contain a complex structure of objects.
+         * @param out String JSON text is appended to.
+         */
+        static void objToJsonString(const NsSmartDeviceLink::NsSmartObjects::SmartObject &obj,
+                std::string &out);
+
+       /**
+         * @brief The method appends string as quoted and escaped JSON string
+         *
+         * @param value String to quote.
+         * @param out String JSON text is appended to.
+         */
+        static void appendQuotedString(const std::string &value,
+                std::string &out);
     };
 
 }
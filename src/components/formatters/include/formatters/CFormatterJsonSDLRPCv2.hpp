@@ -133,11 +133,11 @@ inline bool CFormatterJsonSDLRPCv2::fromString(
   bool result = true;
 
   try {
-    Json::Value root;
-    Json::Reader reader;
+    NsSmartDeviceLink::NsSmartObjects::SmartObject msg_params;
 
     namespace strings = NsSmartDeviceLink::NsJSONHandler::strings;
-    bool result = reader.parse(str, root);
+    bool result = jsonStringToObj(str.data(), str.data() + str.size(),
+                                  msg_params);
 
     if (true == result) {
       out[strings::S_PARAMS][strings::S_MESSAGE_TYPE] = messageType;
@@ -145,7 +145,7 @@ inline bool CFormatterJsonSDLRPCv2::fromString(
       out[strings::S_PARAMS][strings::S_PROTOCOL_TYPE] = 0;
       out[strings::S_PARAMS][strings::S_PROTOCOL_VERSION] = 2;
 
-      jsonValueToObj(root, out[strings::S_MSG_PARAMS]);
+      out[strings::S_MSG_PARAMS].swap(msg_params);
     }
   } catch (...) {
     result = false;
@@ -153,6 +153,22 @@ namespace NsSmartDeviceLink
              */
             bool attachSchema(NsSmartDeviceLink::NsSmartObjects::SmartObject& object);
 
+            /**
+             * @brief Attach schema to the function SmartObject and validate it.
+             *
+             * Same as attachSchema followed by validate, but the object
+             * is walked only once.
+             *
+             * @param object SmartObject to attach schema for.
+             * @param validation_result Result of validation, set only if
+             *        schema was found.
+             *
+             * @return True if schema was found or false otherwise.
+             */
+            bool attachSchemaAndValidate(
+                NsSmartDeviceLink::NsSmartObjects::SmartObject& object,
+                NsSmartDeviceLink::NsSmartObjects::Errors::eType& validation_result);
+
           /**
            * @brief Attach schema to the struct SmartObject.
            *
@@ -265,6 +281,18 @@ namespace NsSmartDeviceLink
            * @brief Map of all struct shemes for this factory.
            */
           StructsSchemesMap structs_schemes_;
+
+        private:
+
+          /**
+           * @brief Finds function schema by params of the object.
+           *
+           * @param object Function SmartObject.
+           *
+           * @return Iterator to the schema or end of functions_schemes_.
+           */
+          typename FuncionsSchemesMap::iterator findFunctionSchema(
+              NsSmartDeviceLink::NsSmartObjects::SmartObject &object);
         };
 
         template <class FunctionIdEnum, class MessageTypeEnum, class StructIdEnum>
@@ -277,16 +305,26 @@ namespace NsSmartDeviceLink
         template <class FunctionIdEnum, class MessageTypeEnum, class StructIdEnum>
         bool CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::attachSchema(NsSmartDeviceLink::NsSmartObjects::SmartObject &object)
         {
-            if(false == object.keyExists(strings::S_PARAMS)) return false;
-            if(false == object[strings::S_PARAMS].keyExists(strings::S_MESSAGE_TYPE)) return false;
-            if(false == object[strings::S_PARAMS].keyExists(strings::S_FUNCTION_ID)) return false;
+            typename FuncionsSchemesMap::iterator schemaIterator = findFunctionSchema(object);
 
-            MessageTypeEnum msgtype((MessageTypeEnum)object[strings::S_PARAMS][strings::S_MESSAGE_TYPE].asInt());
-            FunctionIdEnum fid((FunctionIdEnum)object[strings::S_PARAMS][strings::S_FUNCTION_ID].asInt());
+            if(schemaIterator == functions_schemes_.end())
+            {
+                // Schema was not found
+                return false;
+            }
 
-            SmartSchemaKey<FunctionIdEnum, MessageTypeEnum> key(fid, msgtype);
+            object.setSchema(schemaIterator->second);
+            schemaIterator->second.applySchema(object);
+
+            return true;
+        }
 
-            typename FuncionsSchemesMap::iterator schemaIterator = functions_schemes_.find(key);
+        template <class FunctionIdEnum, class MessageTypeEnum, class StructIdEnum>
+        bool CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::attachSchemaAndValidate(
+            NsSmartDeviceLink::NsSmartObjects::SmartObject &object,
+            NsSmartDeviceLink::NsSmartObjects::Errors::eType &validation_result)
+        {
+            typename FuncionsSchemesMap::iterator schemaIterator = findFunctionSchema(object);
 
             if(schemaIterator == functions_schemes_.end())
             {
@@ -295,11 +333,28 @@ namespace NsSmartDeviceLink
             }
 
             object.setSchema(schemaIterator->second);
-            schemaIterator->second.applySchema(object);
+            validation_result = schemaIterator->second.applySchemaAndValidate(object);
 
             return true;
         }
 
+        template <class FunctionIdEnum, class MessageTypeEnum, class StructIdEnum>
+        typename CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::FuncionsSchemesMap::iterator
+        CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::findFunctionSchema(
+            NsSmartDeviceLink::NsSmartObjects::SmartObject &object)
+        {
+            if(false == object.keyExists(strings::S_PARAMS)) return functions_schemes_.end();
+            if(false == object[strings::S_PARAMS].keyExists(strings::S_MESSAGE_TYPE)) return functions_schemes_.end();
+            if(false == object[strings::S_PARAMS].keyExists(strings::S_FUNCTION_ID)) return functions_schemes_.end();
+
+            MessageTypeEnum msgtype((MessageTypeEnum)object[strings::S_PARAMS][strings::S_MESSAGE_TYPE].asInt());
+            FunctionIdEnum fid((FunctionIdEnum)object[strings::S_PARAMS][strings::S_FUNCTION_ID].asInt());
+
+            SmartSchemaKey<FunctionIdEnum, MessageTypeEnum> key(fid, msgtype);
+
+            return functions_schemes_.find(key);
+        }
+
       template <class FunctionIdEnum,
           class MessageTypeEnum,
           class StructIdEnum>
@@ -127,6 +127,20 @@ class FormatterJsonRpc: public CFormatterJsonBase {
     static int32_t FromString(const std::string& str,
                           NsSmartObjects::SmartObject& out);
 
+    /**
+     * @brief Gets method name of a JSON string without parsing it entirely.
+     *
+     * Method is taken from "method" field of request or notification,
+     * "result" of response or "data" of error response.
+     *
+     * @param str input JSON string.
+     * @param method_name The resulting method name.
+     *
+     * @return true if string is valid JSON with method name, false otherwise.
+     */
+    static bool GetMethodName(const std::string& str,
+                              std::string& method_name);
+
   private:
     /**
      * @brief Request.
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_MSGPACK_FORMATTER_H_
+#define SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_MSGPACK_FORMATTER_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "utils/macro.h"
+#include "smart_objects/smart_object.h"
+#include "formatters/CSmartFactory.hpp"
+
+namespace NsSmartDeviceLink {
+namespace NsJSONHandler {
+namespace Formatters {
+
+/**
+ * @brief Converts SmartObjects to MessagePack and vice versa.
+ *
+ * Compact binary alternative to the SDLRPCv2 JSON body. Only the subset
+ * of MessagePack SmartObject can represent is used: nil, bool, integers up
+ * to 64 bits, float64 (float32 is accepted on input), str, bin, array and
+ * map with string keys.
+ */
+class MsgPackFormatter {
+ public:
+  /**
+   * @brief Writes a SmartObject as MessagePack.
+   *
+   * @param obj Input SmartObject.
+   * @param out_str Resulting bytes, previous content is replaced.
+   */
+  static void ToString(const NsSmartObjects::SmartObject& obj,
+                       std::string& out_str);
+
+  /**
+   * @brief Reads a SmartObject from MessagePack bytes.
+   *
+   * The whole input must hold exactly one value.
+   *
+   * @param begin First byte of the input.
+   * @param end Byte past the end of the input.
+   * @param out The resulting SmartObject, left unchanged on failure.
+   *
+   * @return true if success, false otherwise.
+   */
+  static bool FromString(const char* begin, const char* end,
+                         NsSmartObjects::SmartObject& out);
+
+  static bool FromString(const std::string& str,
+                         NsSmartObjects::SmartObject& out);
+
+  /**
+   * @brief Writes msg_params of a mobile RPC as MessagePack.
+   *
+   * Unlike SDLRPCv2 JSON the schema is not unapplied, so enums are sent
+   * as their integer values.
+   *
+   * @param obj Input SmartObject with params and msg_params.
+   * @param out_str Resulting bytes.
+   *
+   * @return true if success, false otherwise.
+   */
+  static bool MessageToString(const NsSmartObjects::SmartObject& obj,
+                              std::string& out_str);
+
+  /**
+   * @brief Creates a mobile RPC SmartObject from a MessagePack body.
+   *
+   * Params are filled the same way CFormatterJsonSDLRPCv2::fromString does.
+   * Both integer and string enums are accepted once the schema is attached.
+   *
+   * @param str Input MessagePack body.
+   * @param out Output SmartObject.
+   * @param function_id The corresponding field in params is filled with it.
+   * @param message_type The corresponding field in params is filled with it.
+   * @param correlation_id The corresponding field in params is filled with it.
+   *
+   * @return true if success, false otherwise.
+   */
+  template<typename FunctionId, typename MessageType>
+  static bool MessageFromString(const std::string& str,
+                                NsSmartObjects::SmartObject& out,
+                                FunctionId function_id,
+                                MessageType message_type,
+                                int32_t correlation_id);
+
+ private:
+  MsgPackFormatter();
+  DISALLOW_COPY_AND_ASSIGN(MsgPackFormatter);
+};
+
+template<typename FunctionId, typename MessageType>
+bool MsgPackFormatter::MessageFromString(const std::string& str,
+                                         NsSmartObjects::SmartObject& out,
+                                         FunctionId function_id,
+                                         MessageType message_type,
+                                         int32_t correlation_id) {
+  NsSmartObjects::SmartObject msg_params;
+  if (!FromString(str, msg_params)) {
+    return false;
+  }
+  out[strings::S_PARAMS][strings::S_MESSAGE_TYPE] = message_type;
+  out[strings::S_PARAMS][strings::S_FUNCTION_ID] = function_id;
+  out[strings::S_PARAMS][strings::S_CORRELATION_ID] = correlation_id;
+  out[strings::S_PARAMS][strings::S_PROTOCOL_TYPE] = 0;
+  out[strings::S_PARAMS][strings::S_PROTOCOL_VERSION] = 2;
+  out[strings::S_MSG_PARAMS].swap(msg_params);
+  return true;
+}
+
+}  // namespace Formatters
+}  // namespace NsJSONHandler
+}  // namespace NsSmartDeviceLink
+
+#endif  // SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_MSGPACK_FORMATTER_H_
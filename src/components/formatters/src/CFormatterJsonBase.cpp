@@ -31,9 +31,553 @@
 // CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits>
+
 #include "json/json.h"
 
 #include "formatters/CFormatterJsonBase.hpp"
+#include "utils/arena.h"
+#include "utils/macro.h"
+#include "utils/number_conversion.h"
+
+namespace {
+namespace smart_objects_ns = NsSmartDeviceLink::NsSmartObjects;
+
+/**
+ * @brief Recursive descent JSON parser filling SmartObject in place.
+ *
+ * Follows Json::Reader with default features: comments are allowed, any
+ * value may be a root and content after the root value is ignored.
+ * Integers beyond 64 bit range are parsed as double, where Json::Reader
+ * may wrap them around.
+ * Conversion follows jsonValueToObj: integers out of int32_t range leave
+ * null object, JSON null leaves object untouched.
+ * Scratch strings are taken from message arena when parsing runs within
+ * utils::ScopedMessageArena, only values stored in object are copied out.
+ */
+class JsonParser {
+ public:
+  JsonParser(const char* begin, const char* end)
+    : current_(begin),
+      end_(end),
+      depth_(0) {
+  }
+
+  bool Parse(smart_objects_ns::SmartObject& obj) {
+    return ParseValue(obj);
+  }
+
+  /**
+   * @brief Builds only value at the member path, the rest of document is
+   * validated the same way but skipped without building.
+   * @param found is set if member exists, later duplicate of the member
+   * or any of its parents replaces it as full parse would do
+   */
+  bool ParseMember(const std::vector<std::string>& path,
+                   smart_objects_ns::SmartObject& obj, bool* found) {
+    return FindValue(path.begin(), path.end(), obj, found);
+  }
+
+ private:
+  typedef std::vector<std::string>::const_iterator PathIterator;
+  // Bounds recursion on malicious input
+  static const size_t kMaxDepth = 1000;
+
+  void SkipSpaces() {
+    while (current_ != end_) {
+      const char c = *current_;
+      if (' ' != c && '\t' != c && '\r' != c && '\n' != c) {
+        break;
+      }
+      ++current_;
+    }
+  }
+
+  bool SkipSpacesAndComments() {
+    while (current_ != end_) {
+      const char c = *current_;
+      if (' ' == c || '\t' == c || '\r' == c || '\n' == c) {
+        ++current_;
+      } else if ('/' == c) {
+        if (!SkipComment()) {
+          return false;
+        }
+      } else {
+        break;
+      }
+    }
+    return true;
+  }
+
+  bool SkipComment() {
+    ++current_;
+    if (current_ == end_) {
+      return false;
+    }
+    if ('*' == *current_) {
+      ++current_;
+      for (; current_ != end_; ++current_) {
+        if ('*' == *current_ && current_ + 1 != end_ &&
+            '/' == *(current_ + 1)) {
+          current_ += 2;
+          return true;
+        }
+      }
+      return false;
+    }
+    if ('/' == *current_) {
+      while (current_ != end_ && '\n' != *current_ && '\r' != *current_) {
+        ++current_;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  bool ParseValue(smart_objects_ns::SmartObject& obj) {
+    if (!SkipSpacesAndComments() || current_ == end_) {
+      return false;
+    }
+    switch (*current_) {
+      case '{':
+        return ParseObject(obj);
+      case '[':
+        return ParseArray(obj);
+      case '"': {
+        utils::ArenaString value;
+        if (!ParseString(value)) {
+          return false;
+        }
+        // Promoted out of message arena, object outlives it
+        obj = std::string(value.data(), value.size());
+        return true;
+      }
+      case 't':
+        if (!ParseLiteral("true")) {
+          return false;
+        }
+        obj = true;
+        return true;
+      case 'f':
+        if (!ParseLiteral("false")) {
+          return false;
+        }
+        obj = false;
+        return true;
+      case 'n':
+        return ParseLiteral("null");
+      default:
+        if ('-' == *current_ || ('0' <= *current_ && *current_ <= '9')) {
+          return ParseNumber(obj);
+        }
+        return false;
+    }
+  }
+
+  bool FindValue(PathIterator key, PathIterator path_end,
+                 smart_objects_ns::SmartObject& obj, bool* found) {
+    smart_objects_ns::SmartObject().swap(obj);
+    *found = false;
+    if (key == path_end) {
+      *found = true;
+      return ParseValue(obj);
+    }
+    if (!SkipSpacesAndComments() || current_ == end_) {
+      return false;
+    }
+    if ('{' == *current_) {
+      return FindInObject(&*key, key + 1, path_end, &obj, found);
+    }
+    return SkipValue();
+  }
+
+  // Skips object members, the one named key (if any) is looked up further
+  bool FindInObject(const std::string* key, PathIterator next_key,
+                    PathIterator path_end, smart_objects_ns::SmartObject* obj,
+                    bool* found) {
+    if (++depth_ > kMaxDepth) {
+      return false;
+    }
+    ++current_;
+    if (!SkipSpacesAndComments()) {
+      return false;
+    }
+    if (current_ != end_ && '}' == *current_) {
+      ++current_;
+      --depth_;
+      return true;
+    }
+    utils::ArenaString member_key;
+    while (true) {
+      if (!SkipSpacesAndComments() || current_ == end_ || '"' != *current_) {
+        return false;
+      }
+      member_key.clear();
+      if (!ParseString(member_key)) {
+        return false;
+      }
+      SkipSpaces();
+      if (current_ == end_ || ':' != *current_) {
+        return false;
+      }
+      ++current_;
+      const bool is_member_valid = key && IsEqual(*key, member_key) ?
+          FindValue(next_key, path_end, *obj, found) : SkipValue();
+      if (!is_member_valid) {
+        return false;
+      }
+      if (!SkipSpacesAndComments() || current_ == end_) {
+        return false;
+      }
+      const char separator = *current_++;
+      if ('}' == separator) {
+        --depth_;
+        return true;
+      }
+      if (',' != separator) {
+        return false;
+      }
+    }
+  }
+
+  static bool IsEqual(const std::string& key,
+                      const utils::ArenaString& member_key) {
+    return 0 == key.compare(0, std::string::npos,
+                            member_key.data(), member_key.size());
+  }
+
+  bool SkipValue() {
+    if (!SkipSpacesAndComments() || current_ == end_) {
+      return false;
+    }
+    switch (*current_) {
+      case '{':
+        return FindInObject(NULL, PathIterator(), PathIterator(), NULL, NULL);
+      case '[':
+        return SkipArray();
+      case '"':
+        // Scratch string keeps its capacity between skipped strings
+        skipped_string_.clear();
+        return ParseString(skipped_string_);
+      case 't':
+        return ParseLiteral("true");
+      case 'f':
+        return ParseLiteral("false");
+      case 'n':
+        return ParseLiteral("null");
+      default:
+        if ('-' == *current_ || ('0' <= *current_ && *current_ <= '9')) {
+          smart_objects_ns::SmartObject number;
+          return ParseNumber(number);
+        }
+        return false;
+    }
+  }
+
+  bool SkipArray() {
+    if (++depth_ > kMaxDepth) {
+      return false;
+    }
+    ++current_;
+    SkipSpaces();
+    if (current_ != end_ && ']' == *current_) {
+      ++current_;
+      --depth_;
+      return true;
+    }
+    while (true) {
+      if (!SkipValue()) {
+        return false;
+      }
+      if (!SkipSpacesAndComments() || current_ == end_) {
+        return false;
+      }
+      const char separator = *current_++;
+      if (']' == separator) {
+        --depth_;
+        return true;
+      }
+      if (',' != separator) {
+        return false;
+      }
+    }
+  }
+
+  bool ParseObject(smart_objects_ns::SmartObject& obj) {
+    if (++depth_ > kMaxDepth) {
+      return false;
+    }
+    ++current_;
+    obj = smart_objects_ns::SmartObject(smart_objects_ns::SmartType_Map);
+    if (!SkipSpacesAndComments()) {
+      return false;
+    }
+    if (current_ != end_ && '}' == *current_) {
+      ++current_;
+      --depth_;
+      return true;
+    }
+    std::string key;
+    while (true) {
+      if (!SkipSpacesAndComments() || current_ == end_ || '"' != *current_) {
+        return false;
+      }
+      key.clear();
+      if (!ParseString(key)) {
+        return false;
+      }
+      // Json::Reader allows no comments between name and colon
+      SkipSpaces();
+      if (current_ == end_ || ':' != *current_) {
+        return false;
+      }
+      ++current_;
+      smart_objects_ns::SmartObject& member = obj[key];
+      // Duplicated member replaces previous one
+      smart_objects_ns::SmartObject().swap(member);
+      if (!ParseValue(member)) {
+        return false;
+      }
+      if (!SkipSpacesAndComments() || current_ == end_) {
+        return false;
+      }
+      const char separator = *current_++;
+      if ('}' == separator) {
+        --depth_;
+        return true;
+      }
+      if (',' != separator) {
+        return false;
+      }
+    }
+  }
+
+  bool ParseArray(smart_objects_ns::SmartObject& obj) {
+    if (++depth_ > kMaxDepth) {
+      return false;
+    }
+    ++current_;
+    obj = smart_objects_ns::SmartObject(smart_objects_ns::SmartType_Array);
+    // Json::Reader allows no comments in empty array
+    SkipSpaces();
+    if (current_ != end_ && ']' == *current_) {
+      ++current_;
+      --depth_;
+      return true;
+    }
+    for (int32_t index = 0; ; ++index) {
+      if (!ParseValue(obj[index])) {
+        return false;
+      }
+      if (!SkipSpacesAndComments() || current_ == end_) {
+        return false;
+      }
+      const char separator = *current_++;
+      if (']' == separator) {
+        --depth_;
+        return true;
+      }
+      if (',' != separator) {
+        return false;
+      }
+    }
+  }
+
+  template <typename String>
+  bool ParseString(String& value) {
+    ++current_;
+    // Characters not requiring unescaping are appended by whole runs
+    const char* run = current_;
+    while (current_ != end_) {
+      const char c = *current_;
+      if ('"' == c) {
+        value.append(run, current_);
+        ++current_;
+        return true;
+      }
+      if ('\\' != c) {
+        ++current_;
+        continue;
+      }
+      value.append(run, current_);
+      if (++current_ == end_) {
+        return false;
+      }
+      switch (*current_++) {
+        case '"':
+          value += '"';
+          break;
+        case '/':
+          value += '/';
+          break;
+        case '\\':
+          value += '\\';
+          break;
+        case 'b':
+          value += '\b';
+          break;
+        case 'f':
+          value += '\f';
+          break;
+        case 'n':
+          value += '\n';
+          break;
+        case 'r':
+          value += '\r';
+          break;
+        case 't':
+          value += '\t';
+          break;
+        case 'u':
+          if (!ParseUnicodeEscape(value)) {
+            return false;
+          }
+          break;
+        default:
+          return false;
+      }
+      run = current_;
+    }
+    return false;
+  }
+
+  template <typename String>
+  bool ParseUnicodeEscape(String& value) {
+    uint32_t code_point = 0;
+    if (!ReadHex4(&code_point)) {
+      return false;
+    }
+    if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+      // Surrogate pair, second half is expected right after
+      uint32_t surrogate = 0;
+      if (end_ - current_ < 6 || '\\' != current_[0] || 'u' != current_[1]) {
+        return false;
+      }
+      current_ += 2;
+      if (!ReadHex4(&surrogate)) {
+        return false;
+      }
+      code_point = 0x10000 + ((code_point & 0x3FF) << 10) +
+                   (surrogate & 0x3FF);
+    }
+    AppendUtf8(code_point, value);
+    return true;
+  }
+
+  bool ReadHex4(uint32_t* value) {
+    if (end_ - current_ < 4) {
+      return false;
+    }
+    for (int i = 0; i < 4; ++i) {
+      const char c = *current_++;
+      *value <<= 4;
+      if ('0' <= c && c <= '9') {
+        *value += c - '0';
+      } else if ('a' <= c && c <= 'f') {
+        *value += c - 'a' + 10;
+      } else if ('A' <= c && c <= 'F') {
+        *value += c - 'A' + 10;
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename String>
+  static void AppendUtf8(uint32_t code_point, String& value) {
+    if (code_point <= 0x7F) {
+      value += static_cast<char>(code_point);
+    } else if (code_point <= 0x7FF) {
+      value += static_cast<char>(0xC0 | (code_point >> 6));
+      value += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point <= 0xFFFF) {
+      value += static_cast<char>(0xE0 | (code_point >> 12));
+      value += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      value += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point <= 0x10FFFF) {
+      value += static_cast<char>(0xF0 | (code_point >> 18));
+      value += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+      value += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      value += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+  }
+
+  bool ParseLiteral(const char* literal) {
+    for (; *literal; ++literal, ++current_) {
+      if (current_ == end_ || *current_ != *literal) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool ParseNumber(smart_objects_ns::SmartObject& obj) {
+    const char* const begin = current_;
+    bool is_double = false;
+    for (; current_ != end_; ++current_) {
+      const char c = *current_;
+      if ('0' <= c && c <= '9') {
+        continue;
+      }
+      if ('.' == c || 'e' == c || 'E' == c || '+' == c ||
+          ('-' == c && current_ != begin)) {
+        is_double = true;
+        continue;
+      }
+      if ('-' != c) {
+        break;
+      }
+    }
+    if (!is_double) {
+      const bool is_negative = '-' == *begin;
+      // The same limits as Json::Reader has for 64 bit integers
+      const uint64_t max_value = is_negative ?
+          static_cast<uint64_t>(1) << 63 :
+          std::numeric_limits<uint64_t>::max();
+      uint64_t value = 0;
+      bool overflow = false;
+      for (const char* digit = is_negative ? begin + 1 : begin;
+           digit != current_; ++digit) {
+        const uint64_t digit_value = *digit - '0';
+        if (value > (max_value - digit_value) / 10) {
+          overflow = true;
+          break;
+        }
+        value = value * 10 + digit_value;
+      }
+      if (!overflow) {
+        const uint64_t limit = is_negative ?
+            static_cast<uint64_t>(std::numeric_limits<int32_t>::max()) + 1 :
+            static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+        if (value <= limit) {
+          obj = is_negative ?
+              static_cast<int32_t>(-static_cast<int64_t>(value)) :
+              static_cast<int32_t>(value);
+        }
+        // else Json::Value::asInt() throws and object is left null
+        return true;
+      }
+      // Json::Reader parses too long integer as double
+    }
+    // Parsed in place, independently of locale
+    double value = 0;
+    if (utils::ParseDouble(begin, current_, &value) == begin) {
+      return false;
+    }
+    obj = value;
+    return true;
+  }
+
+  const char* current_;
+  const char* const end_;
+  size_t depth_;
+  utils::ArenaString skipped_string_;
+  DISALLOW_COPY_AND_ASSIGN(JsonParser);
+};
+}  // namespace
 
 void NsSmartDeviceLink::NsJSONHandler::Formatters::CFormatterJsonBase::jsonValueToObj(
     const Json::Value& value,
@@ -71,6 +615,35 @@ void NsSmartDeviceLink::NsJSONHandler::Formatters::CFormatterJsonBase::jsonValue
 
 // ----------------------------------------------------------------------------
 
+bool NsSmartDeviceLink::NsJSONHandler::Formatters::CFormatterJsonBase::jsonStringToObj(
+    const char *begin, const char *end,
+    NsSmartDeviceLink::NsSmartObjects::SmartObject &obj) {
+  NsSmartDeviceLink::NsSmartObjects::SmartObject result;
+  JsonParser parser(begin, end);
+  if (!parser.Parse(result)) {
+    return false;
+  }
+  obj.swap(result);
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+bool NsSmartDeviceLink::NsJSONHandler::Formatters::CFormatterJsonBase::jsonStringMemberToObj(
+    const char *begin, const char *end, const std::vector<std::string> &path,
+    NsSmartDeviceLink::NsSmartObjects::SmartObject &obj) {
+  NsSmartDeviceLink::NsSmartObjects::SmartObject result;
+  JsonParser parser(begin, end);
+  bool found = false;
+  if (!parser.ParseMember(path, result, &found) || !found) {
+    return false;
+  }
+  obj.swap(result);
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
 void NsSmartDeviceLink::NsJSONHandler::Formatters::CFormatterJsonBase::objToJsonValue(
     const NsSmartDeviceLink::NsSmartObjects::SmartObject &obj,
     Json::Value &item) {
@@ -116,3 +689,104 @@ void NsSmartDeviceLink::NsJSONHandler::Formatters::CFormatterJsonBase::objToJson
   } catch (...) {
   }
 }
+
+// ----------------------------------------------------------------------------
+
+void NsSmartDeviceLink::NsJSONHandler::Formatters::CFormatterJsonBase::objToJsonString(
+    const NsSmartDeviceLink::NsSmartObjects::SmartObject &obj,
+    std::string &out) {
+  namespace smart_objects_ns = NsSmartDeviceLink::NsSmartObjects;
+  switch (obj.getType()) {
+    case smart_objects_ns::SmartType_Array: {
+      out += '[';
+      const size_t length = obj.length();
+      for (size_t i = 0; i < length; ++i) {
+        if (i > 0) {
+          out += ',';
+        }
+        objToJsonString(obj.getElement(i), out);
+      }
+      out += ']';
+      break;
+    }
+    case smart_objects_ns::SmartType_Map: {
+      out += '{';
+      smart_objects_ns::SmartMap::const_iterator it = obj.map_begin();
+      const smart_objects_ns::SmartMap::const_iterator end = obj.map_end();
+      for (bool first = true; it != end; ++it, first = false) {
+        if (!first) {
+          out += ',';
+        }
+        appendQuotedString(it->first, out);
+        out += ':';
+        objToJsonString(it->second, out);
+      }
+      out += '}';
+      break;
+    }
+    case smart_objects_ns::SmartType_Boolean:
+      out += obj.asBool() ? "true" : "false";
+      break;
+    case smart_objects_ns::SmartType_Integer: {
+      char buffer[utils::kInt64StringSize];
+      out.append(buffer, utils::FormatInt64(obj.asInt(), buffer));
+      break;
+    }
+    case smart_objects_ns::SmartType_Double:
+      // Json writer format is kept for doubles
+      out += Json::valueToString(obj.asDouble());
+      break;
+    case smart_objects_ns::SmartType_Null:
+      out += "null";
+      break;
+    default:
+      appendQuotedString(obj.asString(), out);
+      break;
+  }
+}
+
+void NsSmartDeviceLink::NsJSONHandler::Formatters::CFormatterJsonBase::appendQuotedString(
+    const std::string &value, std::string &out) {
+  out += '"';
+  // Characters not requiring escaping are appended by whole runs
+  size_t run_begin = 0;
+  for (size_t i = 0; i < value.size(); ++i) {
+    const unsigned char c = static_cast<unsigned char>(value[i]);
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+    out.append(value, run_begin, i - run_begin);
+    run_begin = i + 1;
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\b':
+        out += "\\b";
+        break;
+      case '\f':
+        out += "\\f";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default: {
+        char buffer[8];
+        snprintf(buffer, sizeof(buffer), "\\u%04X", static_cast<unsigned int>(c));
+        out += buffer;
+        break;
+      }
+    }
+  }
+  out.append(value, run_begin, std::string::npos);
+  out += '"';
+}
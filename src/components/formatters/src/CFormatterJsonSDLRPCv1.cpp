@@ -83,27 +83,34 @@ bool CFormatterJsonSDLRPCv1::toString(const smart_objects_ns::SmartObject& obj,
                                       std::string& outStr) {
   bool result = false;
   try {
-    Json::Value root(Json::objectValue);
-    Json::Value params(Json::objectValue);
-
     smart_objects_ns::SmartObject formattedObj(obj);
     formattedObj.getSchema().unapplySchema(formattedObj);  // converts enums(as int32_t) to strings
 
-    objToJsonValue(formattedObj.getElement(strings::S_MSG_PARAMS), params);
-
-    std::string type = getMessageType(formattedObj);
-    root[type] = Json::Value(Json::objectValue);
-    root[type][S_PARAMETERS] = params;
-
-    if (formattedObj[strings::S_PARAMS].keyExists(strings::S_CORRELATION_ID)) {
-      root[type][S_CORRELATION_ID] =
-          formattedObj[strings::S_PARAMS][strings::S_CORRELATION_ID].asInt();
+    const smart_objects_ns::SmartObject& params =
+        formattedObj.getElement(strings::S_PARAMS);
+
+    // {"<type>":{"correlationID":...,"name":...,"parameters":{...}}},
+    // members are written in the order Json writer sorts them
+    outStr.clear();
+    outStr += '{';
+    appendQuotedString(getMessageType(formattedObj), outStr);
+    outStr += ":{";
+    if (params.keyExists(strings::S_CORRELATION_ID)) {
+      appendQuotedString(S_CORRELATION_ID, outStr);
+      outStr += ':';
+      objToJsonString(smart_objects_ns::SmartObject(
+          params.getElement(strings::S_CORRELATION_ID).asInt()), outStr);
+      outStr += ',';
     }
-
-    root[type][S_NAME] = formattedObj[strings::S_PARAMS][strings::S_FUNCTION_ID]
-        .asString();
-
-    outStr = root.toStyledString();
+    appendQuotedString(S_NAME, outStr);
+    outStr += ':';
+    appendQuotedString(params.getElement(strings::S_FUNCTION_ID).asString(),
+                       outStr);
+    outStr += ',';
+    appendQuotedString(S_PARAMETERS, outStr);
+    outStr += ':';
+    objToJsonString(formattedObj.getElement(strings::S_MSG_PARAMS), outStr);
+    outStr += "}}";
 
     result = true;
   } catch (...) {
@@ -44,14 +44,11 @@ bool CFormatterJsonSDLRPCv2::toString(const smart_objects_ns::SmartObject& obj,
                                       std::string& outStr) {
   bool result = true;
   try {
-    Json::Value root(Json::objectValue);
-
     smart_objects_ns::SmartObject formattedObj(obj);
     formattedObj.getSchema().unapplySchema(formattedObj);  // converts enums(as int32_t) to strings
 
-    objToJsonValue(formattedObj.getElement(strings::S_MSG_PARAMS), root);
-
-    outStr = root.toStyledString();
+    outStr.clear();
+    objToJsonString(formattedObj.getElement(strings::S_MSG_PARAMS), outStr);
 
     result = true;
   } catch (...) {
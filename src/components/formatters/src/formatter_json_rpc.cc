@@ -140,7 +140,8 @@ bool FormatterJsonRpc::ToString(const NsSmartObjects::SmartObject &obj,
         }
       }
     }
-    out_str = root.toStyledString();
+    Json::FastWriter writer;
+    out_str = writer.write(root);
   } catch (...) {
     result = false;
   }
@@ -148,6 +149,32 @@ bool FormatterJsonRpc::ToString(const NsSmartObjects::SmartObject &obj,
   return result;
 }
 
+bool FormatterJsonRpc::GetMethodName(const std::string &str,
+                                     std::string &method_name) {
+  static const char* const kRequestPath[] = { kMethod };
+  static const char* const kResponsePath[] = { kResult, kMethod };
+  static const char* const kErrorResponsePath[] = { kError, kData, kMethod };
+  static const std::vector<std::string> kPaths[] = {
+    std::vector<std::string>(kRequestPath, kRequestPath + 1),
+    std::vector<std::string>(kResponsePath, kResponsePath + 2),
+    std::vector<std::string>(kErrorResponsePath, kErrorResponsePath + 3)
+  };
+
+  const char* const begin = str.data();
+  const char* const end = begin + str.size();
+  for (size_t i = 0; i < sizeof(kPaths) / sizeof(kPaths[0]); ++i) {
+    NsSmartObjects::SmartObject method;
+    if (jsonStringMemberToObj(begin, end, kPaths[i], method)) {
+      if (NsSmartObjects::SmartType_String != method.getType()) {
+        return false;
+      }
+      method_name = method.asString();
+      return true;
+    }
+  }
+  return false;
+}
+
 bool FormatterJsonRpc::SetMethod(const NsSmartObjects::SmartObject &params,
                                  Json::Value &method_container) {
   bool result = false;
@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "formatters/msgpack_formatter.h"
+
+#include <string.h>
+#include <limits>
+
+namespace {
+namespace smart_objects_ns = NsSmartDeviceLink::NsSmartObjects;
+
+// MessagePack format markers
+const uint8_t kPositiveFixIntMax = 0x7f;
+const uint8_t kFixMap = 0x80;
+const uint8_t kFixArray = 0x90;
+const uint8_t kFixStr = 0xa0;
+const uint8_t kNil = 0xc0;
+const uint8_t kFalse = 0xc2;
+const uint8_t kTrue = 0xc3;
+const uint8_t kBin8 = 0xc4;
+const uint8_t kBin16 = 0xc5;
+const uint8_t kBin32 = 0xc6;
+const uint8_t kFloat32 = 0xca;
+const uint8_t kFloat64 = 0xcb;
+const uint8_t kUint8 = 0xcc;
+const uint8_t kUint16 = 0xcd;
+const uint8_t kUint32 = 0xce;
+const uint8_t kUint64 = 0xcf;
+const uint8_t kInt8 = 0xd0;
+const uint8_t kInt16 = 0xd1;
+const uint8_t kInt32 = 0xd2;
+const uint8_t kInt64 = 0xd3;
+const uint8_t kStr8 = 0xd9;
+const uint8_t kStr16 = 0xda;
+const uint8_t kStr32 = 0xdb;
+const uint8_t kArray16 = 0xdc;
+const uint8_t kArray32 = 0xdd;
+const uint8_t kMap16 = 0xde;
+const uint8_t kMap32 = 0xdf;
+const uint8_t kNegativeFixIntMin = 0xe0;
+
+void WriteBigEndian(uint8_t marker, uint64_t value, size_t bytes,
+                    std::string& out) {
+  out += static_cast<char>(marker);
+  for (size_t shift = bytes * 8; shift > 0; shift -= 8) {
+    out += static_cast<char>((value >> (shift - 8)) & 0xff);
+  }
+}
+
+void WriteInteger(int64_t value, std::string& out) {
+  if (value >= 0) {
+    if (value <= kPositiveFixIntMax) {
+      out += static_cast<char>(value);
+    } else if (value <= std::numeric_limits<uint8_t>::max()) {
+      WriteBigEndian(kUint8, value, 1, out);
+    } else if (value <= std::numeric_limits<uint16_t>::max()) {
+      WriteBigEndian(kUint16, value, 2, out);
+    } else if (value <= std::numeric_limits<uint32_t>::max()) {
+      WriteBigEndian(kUint32, value, 4, out);
+    } else {
+      WriteBigEndian(kUint64, value, 8, out);
+    }
+  } else {
+    if (value >= -32) {
+      out += static_cast<char>(value);
+    } else if (value >= std::numeric_limits<int8_t>::min()) {
+      WriteBigEndian(kInt8, value, 1, out);
+    } else if (value >= std::numeric_limits<int16_t>::min()) {
+      WriteBigEndian(kInt16, value, 2, out);
+    } else if (value >= std::numeric_limits<int32_t>::min()) {
+      WriteBigEndian(kInt32, value, 4, out);
+    } else {
+      WriteBigEndian(kInt64, value, 8, out);
+    }
+  }
+}
+
+void WriteDouble(double value, std::string& out) {
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  WriteBigEndian(kFloat64, bits, 8, out);
+}
+
+// Lengths below fix_count are stored in fix_marker itself, zero marker8
+// means there is no 8 bit form
+void WriteLength(uint8_t fix_marker, size_t fix_count, uint8_t marker8,
+                 uint8_t marker16, uint8_t marker32, size_t length,
+                 std::string& out) {
+  if (length < fix_count) {
+    out += static_cast<char>(fix_marker | length);
+  } else if (marker8 && length <= std::numeric_limits<uint8_t>::max()) {
+    WriteBigEndian(marker8, length, 1, out);
+  } else if (length <= std::numeric_limits<uint16_t>::max()) {
+    WriteBigEndian(marker16, length, 2, out);
+  } else {
+    WriteBigEndian(marker32, length, 4, out);
+  }
+}
+
+void WriteString(const char* data, size_t length, std::string& out) {
+  WriteLength(kFixStr, 32, kStr8, kStr16, kStr32, length, out);
+  out.append(data, length);
+}
+
+void WriteValue(const smart_objects_ns::SmartObject& obj, std::string& out) {
+  switch (obj.getType()) {
+    case smart_objects_ns::SmartType_Boolean:
+      out += static_cast<char>(obj.asBool() ? kTrue : kFalse);
+      break;
+    case smart_objects_ns::SmartType_Integer:
+      WriteInteger(obj.asInt64(), out);
+      break;
+    case smart_objects_ns::SmartType_Double:
+      WriteDouble(obj.asDouble(), out);
+      break;
+    case smart_objects_ns::SmartType_Character: {
+      const char value = obj.asChar();
+      WriteString(&value, 1, out);
+      break;
+    }
+    case smart_objects_ns::SmartType_String: {
+      const std::string value = obj.asString();
+      WriteString(value.data(), value.size(), out);
+      break;
+    }
+    case smart_objects_ns::SmartType_Binary: {
+      const smart_objects_ns::SmartBinary& value = *obj.asBinaryPtr();
+      WriteLength(0, 0, kBin8, kBin16, kBin32, value.size(), out);
+      out.append(value.begin(), value.end());
+      break;
+    }
+    case smart_objects_ns::SmartType_Array: {
+      const smart_objects_ns::SmartArray* array = obj.asArray();
+      WriteLength(kFixArray, 16, 0, kArray16, kArray32, array->size(), out);
+      for (smart_objects_ns::SmartArray::const_iterator it = array->begin();
+           it != array->end(); ++it) {
+        WriteValue(*it, out);
+      }
+      break;
+    }
+    case smart_objects_ns::SmartType_Map: {
+      WriteLength(kFixMap, 16, 0, kMap16, kMap32, obj.length(), out);
+      const smart_objects_ns::SmartMap::const_iterator end = obj.map_end();
+      for (smart_objects_ns::SmartMap::const_iterator it = obj.map_begin();
+           it != end; ++it) {
+        WriteString(it->first.data(), it->first.size(), out);
+        WriteValue(it->second, out);
+      }
+      break;
+    }
+    default:
+      out += static_cast<char>(kNil);
+      break;
+  }
+}
+
+/**
+ * @brief MessagePack reader filling SmartObject in place.
+ *
+ * Every length is checked against the remaining input before anything
+ * is allocated, so truncated or malicious input cannot cause huge
+ * allocations.
+ */
+class MsgPackReader {
+ public:
+  MsgPackReader(const uint8_t* begin, const uint8_t* end)
+    : current_(begin),
+      end_(end),
+      depth_(0) {
+  }
+
+  bool Read(smart_objects_ns::SmartObject& obj) {
+    return ReadValue(obj) && current_ == end_;
+  }
+
+ private:
+  // Bounds recursion on malicious input
+  static const uint32_t kMaxDepth = 1000;
+
+  size_t Remaining() const {
+    return end_ - current_;
+  }
+
+  bool ReadBigEndian(size_t bytes, uint64_t& value) {
+    if (Remaining() < bytes) {
+      return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+      value = (value << 8) | *current_++;
+    }
+    return true;
+  }
+
+  // Integer of given width in two's complement
+  bool ReadSigned(size_t bytes, int64_t& value) {
+    uint64_t raw = 0;
+    if (!ReadBigEndian(bytes, raw)) {
+      return false;
+    }
+    const size_t unused_bits = (8 - bytes) * 8;
+    value = static_cast<int64_t>(raw << unused_bits) >> unused_bits;
+    return true;
+  }
+
+  bool ReadLength(uint8_t marker, uint8_t fix_marker, uint8_t marker8,
+                  uint8_t marker16, uint8_t marker32, size_t& length) {
+    uint64_t value = 0;
+    if (marker8 && marker == marker8) {
+      if (!ReadBigEndian(1, value)) {
+        return false;
+      }
+    } else if (marker == marker16) {
+      if (!ReadBigEndian(2, value)) {
+        return false;
+      }
+    } else if (marker == marker32) {
+      if (!ReadBigEndian(4, value)) {
+        return false;
+      }
+    } else {
+      value = marker - fix_marker;
+    }
+    length = static_cast<size_t>(value);
+    return true;
+  }
+
+  bool IsString(uint8_t marker) const {
+    return (marker >= kFixStr && marker <= kFixStr + 31) ||
+           kStr8 == marker || kStr16 == marker || kStr32 == marker;
+  }
+
+  bool ReadString(uint8_t marker, std::string& value) {
+    size_t length = 0;
+    if (!ReadLength(marker, kFixStr, kStr8, kStr16, kStr32, length) ||
+        Remaining() < length) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(current_), length);
+    current_ += length;
+    return true;
+  }
+
+  bool ReadValue(smart_objects_ns::SmartObject& obj) {
+    if (0 == Remaining()) {
+      return false;
+    }
+    const uint8_t marker = *current_++;
+    if (marker <= kPositiveFixIntMax) {
+      obj = static_cast<int64_t>(marker);
+      return true;
+    }
+    if (marker >= kNegativeFixIntMin) {
+      obj = static_cast<int64_t>(static_cast<int8_t>(marker));
+      return true;
+    }
+    if (marker < kFixArray) {
+      return ReadMap(marker, obj);
+    }
+    if (marker < kFixStr) {
+      return ReadArray(marker, obj);
+    }
+    if (IsString(marker)) {
+      std::string value;
+      if (!ReadString(marker, value)) {
+        return false;
+      }
+      obj = smart_objects_ns::SmartObject(value);
+      return true;
+    }
+    switch (marker) {
+      case kNil:
+        obj = smart_objects_ns::SmartObject();
+        return true;
+      case kFalse:
+      case kTrue:
+        obj = (kTrue == marker);
+        return true;
+      case kBin8:
+      case kBin16:
+      case kBin32:
+        return ReadBinary(marker, obj);
+      case kFloat32: {
+        uint64_t bits = 0;
+        if (!ReadBigEndian(4, bits)) {
+          return false;
+        }
+        const uint32_t bits32 = static_cast<uint32_t>(bits);
+        float value = 0;
+        memcpy(&value, &bits32, sizeof(value));
+        obj = static_cast<double>(value);
+        return true;
+      }
+      case kFloat64: {
+        uint64_t bits = 0;
+        if (!ReadBigEndian(8, bits)) {
+          return false;
+        }
+        double value = 0;
+        memcpy(&value, &bits, sizeof(value));
+        obj = value;
+        return true;
+      }
+      case kUint8:
+      case kUint16:
+      case kUint32:
+      case kUint64: {
+        uint64_t value = 0;
+        if (!ReadBigEndian(1 << (marker - kUint8), value) ||
+            value > static_cast<uint64_t>(
+                std::numeric_limits<int64_t>::max())) {
+          return false;
+        }
+        obj = static_cast<int64_t>(value);
+        return true;
+      }
+      case kInt8:
+      case kInt16:
+      case kInt32:
+      case kInt64: {
+        int64_t value = 0;
+        if (!ReadSigned(1 << (marker - kInt8), value)) {
+          return false;
+        }
+        obj = value;
+        return true;
+      }
+      case kArray16:
+      case kArray32:
+        return ReadArray(marker, obj);
+      case kMap16:
+      case kMap32:
+        return ReadMap(marker, obj);
+      default:
+        // Extension types are not used by SDL
+        return false;
+    }
+  }
+
+  bool ReadBinary(uint8_t marker, smart_objects_ns::SmartObject& obj) {
+    size_t length = 0;
+    if (!ReadLength(marker, 0, kBin8, kBin16, kBin32, length) ||
+        Remaining() < length) {
+      return false;
+    }
+    obj = smart_objects_ns::SharedBinary(
+        new smart_objects_ns::SmartBinary(current_, current_ + length));
+    current_ += length;
+    return true;
+  }
+
+  bool ReadArray(uint8_t marker, smart_objects_ns::SmartObject& obj) {
+    size_t length = 0;
+    // Every element takes at least one byte
+    if (++depth_ > kMaxDepth ||
+        !ReadLength(marker, kFixArray, 0, kArray16, kArray32, length) ||
+        Remaining() < length) {
+      return false;
+    }
+    obj = smart_objects_ns::SmartObject(smart_objects_ns::SmartType_Array);
+    smart_objects_ns::SmartArray* array = obj.asArray();
+    array->resize(length);
+    for (size_t i = 0; i < length; ++i) {
+      if (!ReadValue((*array)[i])) {
+        return false;
+      }
+    }
+    --depth_;
+    return true;
+  }
+
+  bool ReadMap(uint8_t marker, smart_objects_ns::SmartObject& obj) {
+    size_t length = 0;
+    // Every member takes at least two bytes
+    if (++depth_ > kMaxDepth ||
+        !ReadLength(marker, kFixMap, 0, kMap16, kMap32, length) ||
+        Remaining() / 2 < length) {
+      return false;
+    }
+    obj = smart_objects_ns::SmartObject(smart_objects_ns::SmartType_Map);
+    std::string key;
+    for (size_t i = 0; i < length; ++i) {
+      if (0 == Remaining() || !IsString(*current_)) {
+        return false;
+      }
+      if (!ReadString(*current_++, key)) {
+        return false;
+      }
+      smart_objects_ns::SmartObject& member = obj[key];
+      // Duplicated member replaces previous one
+      smart_objects_ns::SmartObject().swap(member);
+      if (!ReadValue(member)) {
+        return false;
+      }
+    }
+    --depth_;
+    return true;
+  }
+
+  const uint8_t* current_;
+  const uint8_t* const end_;
+  uint32_t depth_;
+};
+}  // namespace
+
+namespace NsSmartDeviceLink {
+namespace NsJSONHandler {
+namespace Formatters {
+
+void MsgPackFormatter::ToString(const NsSmartObjects::SmartObject& obj,
+                                std::string& out_str) {
+  out_str.clear();
+  WriteValue(obj, out_str);
+}
+
+bool MsgPackFormatter::FromString(const char* begin, const char* end,
+                                  NsSmartObjects::SmartObject& out) {
+  NsSmartObjects::SmartObject result;
+  MsgPackReader reader(reinterpret_cast<const uint8_t*>(begin),
+                       reinterpret_cast<const uint8_t*>(end));
+  if (!reader.Read(result)) {
+    return false;
+  }
+  out.swap(result);
+  return true;
+}
+
+bool MsgPackFormatter::FromString(const std::string& str,
+                                  NsSmartObjects::SmartObject& out) {
+  return FromString(str.data(), str.data() + str.size(), out);
+}
+
+bool MsgPackFormatter::MessageToString(const NsSmartObjects::SmartObject& obj,
+                                       std::string& out_str) {
+  if (!obj.keyExists(strings::S_MSG_PARAMS)) {
+    return false;
+  }
+  ToString(obj.getElement(strings::S_MSG_PARAMS), out_str);
+  return true;
+}
+
+}  // namespace Formatters
+}  // namespace NsJSONHandler
+}  // namespace NsSmartDeviceLink
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "json/json.h"
+#include "formatters/CFormatterJsonBase.hpp"
+#include "utils/arena.h"
+
+namespace test {
+namespace components {
+namespace formatters {
+
+namespace smartobj = NsSmartDeviceLink::NsSmartObjects;
+namespace json_formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
+
+namespace {
+std::string WriteViaJsonValue(const smartobj::SmartObject& obj) {
+  Json::Value value;
+  json_formatters::CFormatterJsonBase::objToJsonValue(obj, value);
+  Json::FastWriter writer;
+  std::string result = writer.write(value);
+  // FastWriter terminates document with new line
+  result.erase(result.size() - 1);
+  return result;
+}
+
+std::string WriteDirectly(const smartobj::SmartObject& obj) {
+  std::string result;
+  json_formatters::CFormatterJsonBase::objToJsonString(obj, result);
+  return result;
+}
+}  // namespace
+
+TEST(CFormatterJsonBaseTest, ObjToJsonString_Primitives_SameAsJsonValue) {
+  smartobj::SmartObject obj;
+  EXPECT_EQ("null", WriteDirectly(obj));
+
+  obj = true;
+  EXPECT_EQ(WriteViaJsonValue(obj), WriteDirectly(obj));
+  obj = -100500;
+  EXPECT_EQ(WriteViaJsonValue(obj), WriteDirectly(obj));
+  obj = 15.2;
+  EXPECT_EQ(WriteViaJsonValue(obj), WriteDirectly(obj));
+  obj = 'c';
+  EXPECT_EQ(WriteViaJsonValue(obj), WriteDirectly(obj));
+  obj = "string";
+  EXPECT_EQ("\"string\"", WriteDirectly(obj));
+}
+
+TEST(CFormatterJsonBaseTest, ObjToJsonString_SpecialCharacters_Escaped) {
+  smartobj::SmartObject obj("quote\" slash\\ /\b\f\n\r\t\x01 end");
+  EXPECT_EQ(WriteViaJsonValue(obj), WriteDirectly(obj));
+  EXPECT_EQ("\"quote\\\" slash\\\\ /\\b\\f\\n\\r\\t\\u0001 end\"",
+            WriteDirectly(obj));
+}
+
+TEST(CFormatterJsonBaseTest, ObjToJsonString_ComplexObject_SameAsJsonValue) {
+  smartobj::SmartObject obj;
+  obj["intField"] = 100500;
+  obj["stringField"] = "s";
+  obj["emptyMap"] = smartobj::SmartObject(smartobj::SmartType_Map);
+  obj["emptyArray"] = smartobj::SmartObject(smartobj::SmartType_Array);
+  obj["subobject"]["boolField"] = false;
+  obj["subobject"]["arrayField"][0] = 0;
+  obj["subobject"]["arrayField"][1] = 'c';
+  obj["subobject"]["arrayField"][2][0] = 10.0;
+  obj["subobject"]["key \"quoted\""] = smartobj::SmartObject();
+
+  EXPECT_EQ(WriteViaJsonValue(obj), WriteDirectly(obj));
+
+  std::string appended("prefix");
+  json_formatters::CFormatterJsonBase::objToJsonString(obj["intField"],
+                                                       appended);
+  EXPECT_EQ("prefix100500", appended);
+}
+
+namespace {
+bool ParseDirectly(const std::string& json, smartobj::SmartObject& obj) {
+  return json_formatters::CFormatterJsonBase::jsonStringToObj(
+      json.data(), json.data() + json.size(), obj);
+}
+
+smartobj::SmartObject ParseViaJsonValue(const std::string& json) {
+  Json::Value value;
+  Json::Reader reader;
+  EXPECT_TRUE(reader.parse(json, value));
+  smartobj::SmartObject obj;
+  json_formatters::CFormatterJsonBase::jsonValueToObj(value, obj);
+  return obj;
+}
+}  // namespace
+
+TEST(CFormatterJsonBaseTest, JsonStringToObj_ComplexObject_SameAsJsonValue) {
+  const std::string json =
+      "{\"appID\" : 5, \"appName\" : \"Test\\u00e9\\n\","
+      " \"ttsName\" : [ { \"text\" : \"Name\", \"type\" : \"TEXT\" } ],"
+      " \"isMediaApplication\" : true, \"ratio\" : -1.5e2,"
+      " \"empty\" : {}, \"none\" : null, \"list\" : [1, [], [2, 3]],"
+      " \"big\" : 4294967296, \"min\" : -2147483648 } // comment";
+  smartobj::SmartObject obj;
+  ASSERT_TRUE(ParseDirectly(json, obj));
+  EXPECT_TRUE(ParseViaJsonValue(json) == obj);
+  EXPECT_EQ(5, obj["appID"].asInt());
+  EXPECT_EQ("Test\xc3\xa9\n", obj["appName"].asString());
+  EXPECT_EQ("TEXT", obj["ttsName"][0]["type"].asString());
+  EXPECT_EQ(-150.0, obj["ratio"].asDouble());
+  EXPECT_EQ(smartobj::SmartType_Null, obj["big"].getType());
+}
+
+TEST(CFormatterJsonBaseTest, JsonStringToObj_NotTerminatedSlice_OnlySliceParsed) {
+  const std::string buffer = "[1,2]garbage";
+  smartobj::SmartObject obj;
+  ASSERT_TRUE(json_formatters::CFormatterJsonBase::jsonStringToObj(
+      buffer.data(), buffer.data() + 4, obj) == false);
+  ASSERT_TRUE(json_formatters::CFormatterJsonBase::jsonStringToObj(
+      buffer.data(), buffer.data() + 5, obj));
+  EXPECT_EQ(2u, obj.length());
+}
+
+TEST(CFormatterJsonBaseTest, JsonStringToObj_InvalidJson_ObjectNotChanged) {
+  const char* invalid_jsons[] = {
+    "", "{", "{\"a\":}", "{\"a\" 1}", "[1,]", "[1 2]", "\"abc", "\"\\x\"",
+    "\"\\u12\"", "tru", "{1:2}", "/* not closed"
+  };
+  for (size_t i = 0; i < sizeof(invalid_jsons) / sizeof(invalid_jsons[0]); ++i) {
+    smartobj::SmartObject obj(7);
+    EXPECT_FALSE(ParseDirectly(invalid_jsons[i], obj)) << invalid_jsons[i];
+    EXPECT_EQ(7, obj.asInt());
+  }
+}
+
+TEST(CFormatterJsonBaseTest, JsonStringToObj_WithinMessageArena_ObjectOutlivesIt) {
+  const std::string json =
+      "{\"appName\" : \"Long enough to leave small string buffer\","
+      " \"skipped\" : \"\\u0041\", \"ratio\" : 12345678901234567890 }";
+  smartobj::SmartObject obj;
+  {
+    utils::ScopedMessageArena scope;
+    ASSERT_TRUE(ParseDirectly(json, obj));
+    EXPECT_LT(0u, utils::ScopedMessageArena::Current()->allocated_bytes());
+  }
+  EXPECT_TRUE(ParseViaJsonValue(json) == obj);
+  EXPECT_EQ("Long enough to leave small string buffer",
+            obj["appName"].asString());
+}
+
+bool ParseMember(const std::string& json, const std::string& path,
+                 smartobj::SmartObject& obj) {
+  std::vector<std::string> keys;
+  for (size_t begin = 0; !path.empty() && begin <= path.size(); ) {
+    const size_t dot = std::min(path.find('.', begin), path.size());
+    keys.push_back(path.substr(begin, dot - begin));
+    begin = dot + 1;
+  }
+  return json_formatters::CFormatterJsonBase::jsonStringMemberToObj(
+      json.data(), json.data() + json.size(), keys, obj);
+}
+
+TEST(CFormatterJsonBaseTest, JsonStringMemberToObj_SameAsFullParse) {
+  const std::string json =
+      "{\"id\":5,\"jsonrpc\":\"2.0\","
+      "\"result\":{\"code\":0,\"method\":\"UI.Show\","
+      "\"list\":[{\"a\":[1,2.5,true,null,\"x\\u0041\"]}]}}";
+  smartobj::SmartObject full;
+  ASSERT_TRUE(ParseDirectly(json, full));
+  smartobj::SmartObject obj;
+  ASSERT_TRUE(ParseMember(json, "", obj));
+  EXPECT_TRUE(full == obj);
+  ASSERT_TRUE(ParseMember(json, "id", obj));
+  EXPECT_TRUE(full["id"] == obj);
+  ASSERT_TRUE(ParseMember(json, "result", obj));
+  EXPECT_TRUE(full["result"] == obj);
+  ASSERT_TRUE(ParseMember(json, "result.method", obj));
+  EXPECT_EQ("UI.Show", obj.asString());
+  ASSERT_TRUE(ParseMember(json, "result.list", obj));
+  EXPECT_TRUE(full["result"]["list"] == obj);
+}
+
+TEST(CFormatterJsonBaseTest, JsonStringMemberToObj_DuplicatedParent_LastWins) {
+  smartobj::SmartObject obj(7);
+  EXPECT_FALSE(ParseMember(
+      "{\"result\":{\"method\":\"A\"},\"result\":{}}", "result.method",
+      obj));
+  EXPECT_EQ(7, obj.asInt());
+  ASSERT_TRUE(ParseMember(
+      "{\"result\":{},\"result\":{\"method\":\"B\"}}", "result.method",
+      obj));
+  EXPECT_EQ("B", obj.asString());
+}
+
+TEST(CFormatterJsonBaseTest, JsonStringMemberToObj_MissingOrInvalid) {
+  smartobj::SmartObject obj(7);
+  EXPECT_FALSE(ParseMember("{\"a\":{\"b\":1}}", "a.c", obj));
+  EXPECT_FALSE(ParseMember("{\"a\":[{\"b\":1}]}", "a.b", obj));
+  // Skipped part of document is still checked
+  EXPECT_FALSE(ParseMember("{\"a\":1,\"b\":[1,]}", "a", obj));
+  EXPECT_FALSE(ParseMember("{\"b\":\"\\x\",\"a\":1}", "a", obj));
+  EXPECT_EQ(7, obj.asInt());
+}
+
+}  // namespace formatters
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "formatters/msgpack_formatter.h"
+#include "formatters/CFormatterJsonBase.hpp"
+
+namespace test {
+namespace components {
+namespace formatters {
+
+namespace smartobj = NsSmartDeviceLink::NsSmartObjects;
+namespace json_formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
+namespace strings = NsSmartDeviceLink::NsJSONHandler::strings;
+
+using json_formatters::MsgPackFormatter;
+
+namespace {
+smartobj::SmartObject RoundTrip(const smartobj::SmartObject& obj) {
+  std::string bytes;
+  MsgPackFormatter::ToString(obj, bytes);
+  smartobj::SmartObject result;
+  EXPECT_TRUE(MsgPackFormatter::FromString(bytes, result));
+  return result;
+}
+}  // namespace
+
+TEST(MsgPackFormatterTest, Scalars_EncodedInShortestForm) {
+  std::string bytes;
+  MsgPackFormatter::ToString(smartobj::SmartObject(5), bytes);
+  EXPECT_EQ(std::string("\x05", 1), bytes);
+  MsgPackFormatter::ToString(smartobj::SmartObject(-1), bytes);
+  EXPECT_EQ(std::string("\xff", 1), bytes);
+  MsgPackFormatter::ToString(smartobj::SmartObject(300), bytes);
+  EXPECT_EQ(std::string("\xcd\x01\x2c", 3), bytes);
+  MsgPackFormatter::ToString(smartobj::SmartObject(-200), bytes);
+  EXPECT_EQ(std::string("\xd1\xff\x38", 3), bytes);
+  MsgPackFormatter::ToString(smartobj::SmartObject(true), bytes);
+  EXPECT_EQ(std::string("\xc3", 1), bytes);
+  MsgPackFormatter::ToString(smartobj::SmartObject(), bytes);
+  EXPECT_EQ(std::string("\xc0", 1), bytes);
+  MsgPackFormatter::ToString(smartobj::SmartObject("abc"), bytes);
+  EXPECT_EQ(std::string("\xa3" "abc", 4), bytes);
+}
+
+TEST(MsgPackFormatterTest, ComplexObject_RoundTrip_SameObject) {
+  smartobj::SmartObject obj(smartobj::SmartType_Map);
+  obj["appID"] = 5;
+  obj["big"] = static_cast<int64_t>(-5000000000LL);
+  obj["speed"] = 55.5;
+  obj["isMedia"] = false;
+  obj["name"] = std::string(300, 'n');
+  obj["ttsName"][0]["text"] = "Name";
+  obj["ttsName"][0]["type"] = 1;
+  obj["empty"] = smartobj::SmartObject(smartobj::SmartType_Map);
+  obj["list"] = smartobj::SmartObject(smartobj::SmartType_Array);
+  for (int32_t i = 0; i < 20; ++i) {
+    obj["list"][i] = i * 1000;
+  }
+  smartobj::SmartBinary binary(70000, 0xab);
+  obj["data"] = binary;
+
+  const smartobj::SmartObject result = RoundTrip(obj);
+  EXPECT_TRUE(obj == result);
+  EXPECT_EQ(-5000000000LL, result["big"].asInt64());
+  EXPECT_EQ(binary, result["data"].asBinary());
+}
+
+TEST(MsgPackFormatterTest, VehicleData_SmallerThanJson) {
+  smartobj::SmartObject obj(smartobj::SmartType_Map);
+  obj["speed"] = 52.25;
+  obj["rpm"] = 2500;
+  obj["fuelLevel"] = 48.5;
+  obj["prndl"] = 3;
+  obj["odometer"] = 43210;
+
+  std::string bytes;
+  MsgPackFormatter::ToString(obj, bytes);
+  std::string json;
+  json_formatters::CFormatterJsonBase::objToJsonString(obj, json);
+  EXPECT_LT(bytes.size(), json.size());
+}
+
+TEST(MsgPackFormatterTest, Message_ParamsFilled) {
+  smartobj::SmartObject message(smartobj::SmartType_Map);
+  message[strings::S_PARAMS][strings::S_FUNCTION_ID] = 7;
+  message[strings::S_MSG_PARAMS]["cmdID"] = 10;
+
+  std::string bytes;
+  ASSERT_TRUE(MsgPackFormatter::MessageToString(message, bytes));
+  smartobj::SmartObject result;
+  ASSERT_TRUE(MsgPackFormatter::MessageFromString(bytes, result, 7, 0, 33));
+  EXPECT_EQ(10, result[strings::S_MSG_PARAMS]["cmdID"].asInt());
+  EXPECT_EQ(7, result[strings::S_PARAMS][strings::S_FUNCTION_ID].asInt());
+  EXPECT_EQ(33, result[strings::S_PARAMS][strings::S_CORRELATION_ID].asInt());
+  EXPECT_EQ(2, result[strings::S_PARAMS][strings::S_PROTOCOL_VERSION].asInt());
+
+  EXPECT_FALSE(MsgPackFormatter::MessageToString(
+      smartobj::SmartObject(smartobj::SmartType_Map), bytes));
+}
+
+TEST(MsgPackFormatterTest, InvalidInput_ObjectNotChanged) {
+  const std::string invalid_inputs[] = {
+    std::string(),
+    std::string("\x92\x01", 2),          // truncated array
+    std::string("\x81\x01\x02", 3),      // not a string key
+    std::string("\xa5" "abc", 4),        // truncated string
+    std::string("\xdd\xff\xff\xff\xff", 5),  // huge array length
+    std::string("\xcf\xff\xff\xff\xff\xff\xff\xff\xff", 9),  // above int64
+    std::string("\xc1", 1),              // never used marker
+    std::string("\xd4\x01\x02", 3),      // extension type
+    std::string("\x01\x02", 2)           // trailing data
+  };
+  for (size_t i = 0; i < sizeof(invalid_inputs) / sizeof(invalid_inputs[0]);
+       ++i) {
+    smartobj::SmartObject obj(7);
+    EXPECT_FALSE(MsgPackFormatter::FromString(invalid_inputs[i], obj)) << i;
+    EXPECT_EQ(7, obj.asInt());
+  }
+}
+
+TEST(MsgPackFormatterTest, DeepNesting_Rejected) {
+  const std::string bytes(100000, '\x91');
+  smartobj::SmartObject obj;
+  EXPECT_FALSE(MsgPackFormatter::FromString(bytes, obj));
+}
+
+}  // namespace formatters
+}  // namespace components
+}  // namespace test
@@ -58,6 +58,19 @@ enum ServiceState {
   HMI_ADAPTER_INITIALIZED
 };
 
+/**
+ * @brief Defines how PluginManager runs processing of mobile messages
+ * of module
+ */
+enum ExecutionModel {
+  // On thread which delivered message, blocks it till processing ends
+  EXECUTE_INLINE = 0,
+  // One message at a time, in order of arrival, on shared workers
+  EXECUTE_SERIAL,
+  // Concurrently on shared workers, module has to be thread safe
+  EXECUTE_SHARED_POOL
+};
+
 typedef std::string HMIFunctionID;
 
 class GenericModule;
@@ -70,6 +83,14 @@ struct PluginInfo {
   std::deque<HMIFunctionID> hmi_function_list;
 };
 
+/**
+ * @brief Type of optional "Describe" export of plugin library, fills id
+ * and info of module without creating it. Module of such library is created
+ * on first message for it and destroyed when idle, so it has to cope with
+ * applications registered while it did not exist.
+ */
+typedef bool (*DescribeModule)(ModuleID* module_id, PluginInfo* info);
+
 class GenericModule {
  public:
   typedef std::deque<ModuleObserver* > Observers;
@@ -89,6 +110,15 @@ class GenericModule {
   virtual application_manager::ServicePtr service();
 
   virtual ProcessResult ProcessMessage(application_manager::MessagePtr msg) = 0;
+
+  /**
+   * @brief Returns how ProcessMessage has to be called for module,
+   * HMI messages are always processed inline since caller uses result
+   */
+  virtual ExecutionModel GetExecutionModel() const {
+    return EXECUTE_INLINE;
+  }
+
   virtual ProcessResult ProcessHMIMessage(
     application_manager::MessagePtr msg) = 0;
   virtual void OnServiceStateChanged(ServiceState state);
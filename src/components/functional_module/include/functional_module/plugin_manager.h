@@ -35,10 +35,14 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include "functional_module/generic_module.h"
 #include "application_manager/service.h"
 #include "application_manager/message.h"
 #include "utils/singleton.h"
+#include "utils/lock.h"
+#include "utils/timer_thread.h"
+#include "utils/threads/thread_pool.h"
 
 namespace functional_modules {
 
@@ -46,7 +50,15 @@ class PluginManager : public utils::Singleton<PluginManager>,
   public ModuleObserver {
  public:
   typedef std::map<ModuleID, ModulePtr> Modules;
-  int LoadPlugins(const std::string& plugin_path);
+
+  /**
+   * @brief Loads plugin libraries from folder
+   * @param plugin_path folder with libraries
+   * @param idle_timeout seconds after which module of library exporting
+   * Describe is destroyed if it gets no messages, 0 keeps modules
+   * @return number of loaded plugins
+   */
+  int LoadPlugins(const std::string& plugin_path, uint32_t idle_timeout = 0);
   void UnloadPlugins();
   void ProcessMessage(application_manager::MessagePtr msg);
   ProcessResult ProcessHMIMessage(application_manager::MessagePtr msg);
@@ -106,12 +118,97 @@ class PluginManager : public utils::Singleton<PluginManager>,
   void OnDeviceRemoved(const connection_handler::DeviceHandle& device);
 
  private:
+  /**
+   * @brief Processing state and metrics of module for mobile messages,
+   * defined in source file
+   */
+  struct ModuleDispatcher;
+  /**
+   * @brief Plugin library with its routes and module if it is created
+   */
+  struct ModuleSlot;
+  class ProcessMessageTask;
+  typedef std::map<ModuleID, ModuleSlot*> Slots;
+
   PluginManager();
   ~PluginManager();
-  Modules plugins_;
+
+  /**
+   * @brief Opens plugin library and routes messages to its module,
+   * which is created at once unless library describes it
+   * @return true if plugin is added
+   */
+  bool LoadPlugin(const std::string& file_name);
+
+  /**
+   * @brief Creates dispatcher of module and makes module available
+   * to callers, slot lock has to be held
+   */
+  void AttachModule(ModuleSlot* slot, ModulePtr module);
+
+  /**
+   * @brief Stops workers of module and releases it, slot lock has to be held
+   */
+  void DetachModule(ModuleSlot* slot);
+
+  /**
+   * @return dispatcher of module creating module if needed or NULL,
+   * module is not destroyed till Release
+   */
+  ModuleDispatcher* Acquire(ModuleSlot* slot);
+  void Release(ModuleSlot* slot);
+
+  /**
+   * @brief Routes mobile function to module, first module wins
+   * if several modules subscribe to the same function
+   */
+  void AddMobileRoute(MobileFunctionID function_id, ModuleSlot* slot);
+
+  /**
+   * @return slot of module processing mobile message or NULL
+   */
+  ModuleSlot* MobileRoute(application_manager::MessagePtr msg) const;
+
+  /**
+   * @return slot of module processing HMI message or NULL
+   */
+  ModuleSlot* HMIRoute(application_manager::MessagePtr msg);
+
+  /**
+   * @brief Processes message inline or passes it to workers of module,
+   * blocks caller while module has too many pending messages
+   */
+  void Dispatch(ModuleSlot* slot, application_manager::MessagePtr msg);
+
+  /**
+   * @brief Destroys described modules which got no messages
+   * during idle timeout, called by idle timer
+   */
+  void UnloadIdleModules();
+
+  /**
+   * @return copy of created modules, safe to iterate while
+   * modules are created and destroyed
+   */
+  Modules LoadedModules() const;
+
+  // Slots and routes are filled by LoadPlugins and do not change till
+  // UnloadPlugins, only modules inside slots come and go
+  Slots slots_;
   std::map<ModuleID, void*> dlls_;
-  std::map<MobileFunctionID, ModulePtr> mobile_subscribers_;
-  std::map<HMIFunctionID, ModulePtr> hmi_subscribers_;
+  // Slots indexed by mobile function id minus offset,
+  // so messages are routed with one table load
+  std::vector<ModuleSlot*> mobile_routes_;
+  int32_t mobile_routes_offset_;
+  std::map<HMIFunctionID, ModuleSlot*> hmi_subscribers_;
+
+  Modules plugins_;
+  mutable sync_primitives::Lock plugins_lock_;
+  threads::ThreadPool* pool_;
+  sync_primitives::Lock pool_lock_;
+  uint32_t idle_timeout_;
+  timer::TimerThread<PluginManager> idle_timer_;
+  ServiceState service_state_;
   application_manager::ServicePtr service_;
 
   friend class PluginManagerTest;
@@ -36,32 +36,447 @@
 #include "functional_module/function_ids.h"
 #include "utils/file_system.h"
 #include "utils/logger.h"
-#include "json/json.h"
+#include "utils/date_time.h"
+#include "utils/conditional_variable.h"
+#include "utils/metrics_registry.h"
+#include "formatters/formatter_json_rpc.h"
 
 namespace functional_modules {
 
+namespace formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
+
 CREATE_LOGGERPTR_GLOBAL(logger_, "PluginManager")
 
 typedef std::map<ModuleID, ModulePtr>::iterator PluginsIterator;
-typedef std::map<MobileFunctionID, ModulePtr>::iterator PluginFunctionsIterator;
-typedef std::map<HMIFunctionID, ModulePtr>::iterator PluginHMIFunctionsIterator;
+namespace {
+// Modules processing messages off caller thread share these workers
+const size_t kWorkersCount = 2;
+// Caller is blocked when module has that many unprocessed messages
+const uint32_t kMaxPendingMessages = 100;
+const int32_t kStopWaitMs = 100;
+// Guards routing table against plugins with scattered function ids
+const size_t kMaxMobileRoutes = 1024;
+
+uint64_t MicrosecondsSince(const TimevalStruct& start) {
+  return date_time::DateTime::getuSecs(date_time::DateTime::Sub(
+      date_time::DateTime::getCurrentTime(), start));
+}
+
+std::string MetricName(const PluginInfo& info, const std::string& metric) {
+  return "plugin_manager." + info.name + "." + metric;
+}
+}  // namespace
+
+struct PluginManager::ModuleDispatcher {
+  ModuleDispatcher(ModulePtr module, const PluginInfo& info,
+                   threads::ThreadPool* pool)
+    : module(module),
+      model(module->GetExecutionModel()),
+      strand(EXECUTE_SERIAL == model ? new threads::Strand(pool) : NULL),
+      pending(0),
+      stopped(false),
+      processing_time_metric(utils::metrics::MetricsRegistry::instance()
+          ->GetHistogram(MetricName(info, "processing_time_us"))),
+      queue_time_metric(utils::metrics::MetricsRegistry::instance()
+          ->GetHistogram(MetricName(info, "queue_time_us"))),
+      pending_messages_metric(utils::metrics::MetricsRegistry::instance()
+          ->GetGauge(MetricName(info, "pending_messages"))),
+      blocked_callers_metric(utils::metrics::MetricsRegistry::instance()
+          ->GetCounter(MetricName(info, "blocked_callers"))) {
+  }
+
+  ~ModuleDispatcher() {
+    delete strand;
+  }
+
+  void Process(application_manager::MessagePtr msg) {
+    const TimevalStruct start_time = date_time::DateTime::getCurrentTime();
+    if (module->ProcessMessage(msg) != ProcessResult::PROCESSED) {
+      LOG4CXX_ERROR(logger_, "Failed process HMI message!");
+    }
+    processing_time_metric->Record(MicrosecondsSince(start_time));
+  }
+
+  /**
+   * @brief Drops messages which are not processed yet and waits
+   * for messages being processed
+   */
+  void Stop() {
+    sync_primitives::AutoLock auto_lock(pending_lock);
+    stopped = true;
+    pending_cond.Broadcast();
+    // Scheduled tasks only release messages now, so they end quickly
+    while (0 != pending) {
+      pending_cond.WaitFor(auto_lock, kStopWaitMs);
+    }
+  }
+
+  bool HasPending() {
+    sync_primitives::AutoLock auto_lock(pending_lock);
+    return 0 != pending;
+  }
+
+  ModulePtr module;
+  const ExecutionModel model;
+  // Keeps order of messages of serial module, NULL for other models
+  threads::Strand* strand;
+  sync_primitives::Lock pending_lock;
+  sync_primitives::ConditionalVariable pending_cond;
+  uint32_t pending;
+  bool stopped;
+  utils::metrics::Histogram* processing_time_metric;
+  utils::metrics::Histogram* queue_time_metric;
+  utils::metrics::Gauge* pending_messages_metric;
+  utils::metrics::Counter* blocked_callers_metric;
+};
+
+struct PluginManager::ModuleSlot {
+  ModuleSlot(const std::string& file_name, GenericModule* (*create)())
+    : file_name(file_name),
+      create(create),
+      module_id(0),
+      described(false),
+      dispatcher(NULL),
+      users(0),
+      last_use(date_time::DateTime::getCurrentTime()) {
+  }
+
+  const std::string file_name;
+  GenericModule* (*const create)();
+  ModuleID module_id;
+  PluginInfo info;
+  // Module is created on demand and destroyed when idle
+  bool described;
+  sync_primitives::Lock lock;
+  // NULL while module is not created
+  ModuleDispatcher* dispatcher;
+  // Callers using module right now
+  uint32_t users;
+  TimevalStruct last_use;
+};
+
+class PluginManager::ProcessMessageTask : public threads::ThreadDelegate {
+ public:
+  ProcessMessageTask(ModuleDispatcher* dispatcher,
+                     application_manager::MessagePtr msg)
+    : dispatcher_(*dispatcher),
+      msg_(msg),
+      queued_time_(date_time::DateTime::getCurrentTime()) {
+  }
+
+  virtual void threadMain() {
+    dispatcher_.queue_time_metric->Record(MicrosecondsSince(queued_time_));
+    bool stopped;
+    {
+      sync_primitives::AutoLock auto_lock(dispatcher_.pending_lock);
+      stopped = dispatcher_.stopped;
+    }
+    if (stopped) {
+      LOG4CXX_WARN(logger_, "Message " << msg_->function_id()
+                   << " is dropped since plugin is unloaded");
+    } else {
+      dispatcher_.Process(msg_);
+    }
+    // Strand deletes posted tasks itself, pool does not own them.
+    // Dispatcher may be destroyed as soon as pending counter is released
+    const bool self_owned = !dispatcher_.strand;
+    {
+      sync_primitives::AutoLock auto_lock(dispatcher_.pending_lock);
+      --dispatcher_.pending;
+      dispatcher_.pending_messages_metric->Set(dispatcher_.pending);
+      dispatcher_.pending_cond.Broadcast();
+    }
+    if (self_owned) {
+      delete this;
+    }
+  }
+
+ private:
+  ModuleDispatcher& dispatcher_;
+  application_manager::MessagePtr msg_;
+  const TimevalStruct queued_time_;
+};
 
 PluginManager::PluginManager()
-  : service_() {
+  : mobile_routes_offset_(0),
+    pool_(NULL),
+    idle_timeout_(0),
+    idle_timer_("PluginIdle", this, &PluginManager::UnloadIdleModules, true),
+    service_state_(IDLE),
+    service_() {
   LOG4CXX_DEBUG(logger_, "Creating plugin mgr");
 }
 
 PluginManager::~PluginManager() {
   // TODO(PV): unsubscribe plugins from functions
-  mobile_subscribers_.clear();
-  hmi_subscribers_.clear();
   UnloadPlugins();
 }
 
-int PluginManager::LoadPlugins(const std::string& plugin_path) {
+void PluginManager::AttachModule(ModuleSlot* slot, ModulePtr module) {
+  threads::ThreadPool* pool = NULL;
+  if (EXECUTE_INLINE != module->GetExecutionModel()) {
+    sync_primitives::AutoLock auto_lock(pool_lock_);
+    if (!pool_) {
+      pool_ = new threads::ThreadPool("PluginWorker", kWorkersCount);
+    }
+    pool = pool_;
+  }
+  module->set_service(service_);
+  module->AddObserver(this);
+  if (IDLE != service_state_) {
+    module->OnServiceStateChanged(service_state_);
+  }
+  slot->dispatcher = new ModuleDispatcher(module, slot->info, pool);
+  slot->last_use = date_time::DateTime::getCurrentTime();
+  sync_primitives::AutoLock auto_lock(plugins_lock_);
+  plugins_.insert(std::make_pair(slot->module_id, module));
+}
+
+void PluginManager::DetachModule(ModuleSlot* slot) {
+  ModuleDispatcher* dispatcher = slot->dispatcher;
+  slot->dispatcher = NULL;
+  dispatcher->Stop();
+  {
+    sync_primitives::AutoLock auto_lock(plugins_lock_);
+    plugins_.erase(slot->module_id);
+  }
+  dispatcher->module->RemoveObserver(this);
+  LOG4CXX_INFO(logger_, "Releasing module of plugin " << slot->file_name);
+  // Module is destroyed with last reference, copies of LoadedModules
+  // may hold it a bit longer, so library is closed only by UnloadPlugins
+  delete dispatcher;
+}
+
+PluginManager::ModuleDispatcher* PluginManager::Acquire(ModuleSlot* slot) {
+  sync_primitives::AutoLock auto_lock(slot->lock);
+  if (!slot->dispatcher) {
+    LOG4CXX_INFO(logger_, "Creating module of plugin " << slot->file_name);
+    ModulePtr module = slot->create();
+    if (!module || slot->module_id != module->GetModuleID()) {
+      LOG4CXX_ERROR(logger_, "Failed to create plugin main class "
+                    << slot->file_name);
+      return NULL;
+    }
+    AttachModule(slot, module);
+  }
+  ++slot->users;
+  return slot->dispatcher;
+}
+
+void PluginManager::Release(ModuleSlot* slot) {
+  sync_primitives::AutoLock auto_lock(slot->lock);
+  DCHECK(slot->users);
+  --slot->users;
+  slot->last_use = date_time::DateTime::getCurrentTime();
+}
+
+void PluginManager::AddMobileRoute(MobileFunctionID function_id,
+                                   ModuleSlot* slot) {
+  const int32_t id = static_cast<int32_t>(function_id);
+  if (mobile_routes_.empty()) {
+    mobile_routes_offset_ = id;
+  }
+  const int32_t first = std::min(id, mobile_routes_offset_);
+  const int32_t last = std::max(
+      id, mobile_routes_offset_ + static_cast<int32_t>(mobile_routes_.size()) - 1);
+  if (static_cast<size_t>(last - first) >= kMaxMobileRoutes) {
+    LOG4CXX_ERROR(logger_, "Function " << id << " of plugin "
+                  << slot->module_id
+                  << " is too far from other plugins functions, ignored");
+    return;
+  }
+  mobile_routes_.insert(mobile_routes_.begin(), mobile_routes_offset_ - first,
+                        static_cast<ModuleSlot*>(NULL));
+  mobile_routes_.resize(last - first + 1, NULL);
+  mobile_routes_offset_ = first;
+  ModuleSlot*& route = mobile_routes_[id - first];
+  if (route) {
+    LOG4CXX_WARN(logger_, "Function " << id << " is already handled by plugin "
+                 << route->module_id);
+    return;
+  }
+  route = slot;
+}
+
+PluginManager::ModuleSlot* PluginManager::MobileRoute(
+    application_manager::MessagePtr msg) const {
+  if (application_manager::ProtocolVersion::kUnknownProtocol ==
+        msg->protocol_version()
+      || application_manager::ProtocolVersion::kHMI ==
+        msg->protocol_version()) {
+    return NULL;
+  }
+  // Ids below offset wrap around to large indexes
+  const size_t index = static_cast<uint32_t>(
+      msg->function_id() - mobile_routes_offset_);
+  return index < mobile_routes_.size() ? mobile_routes_[index] : NULL;
+}
+
+PluginManager::ModuleSlot* PluginManager::HMIRoute(
+    application_manager::MessagePtr msg) {
+  if (application_manager::ProtocolVersion::kHMI != msg->protocol_version()) {
+    return NULL;
+  }
+  // Method is decoded once and kept in message for later checks and plugin
+  std::string function_name = msg->function_name();
+  if (function_name.empty()) {
+    // Method of request, notification, response or error response,
+    // message is parsed entirely by its handler
+    if (!formatters::FormatterJsonRpc::GetMethodName(msg->json_message(),
+                                                     function_name)) {
+      DCHECK(false);
+      return NULL;
+    }
+    msg->set_function_name(function_name);
+  }
+  std::map<HMIFunctionID, ModuleSlot*>::const_iterator subscribed_plugin_itr =
+    hmi_subscribers_.find(function_name);
+  return hmi_subscribers_.end() != subscribed_plugin_itr ?
+         subscribed_plugin_itr->second : NULL;
+}
+
+void PluginManager::Dispatch(ModuleSlot* slot,
+                             application_manager::MessagePtr msg) {
+  ModuleDispatcher* dispatcher = Acquire(slot);
+  if (!dispatcher) {
+    return;
+  }
+  if (EXECUTE_INLINE == dispatcher->model) {
+    dispatcher->Process(msg);
+    Release(slot);
+    return;
+  }
+  {
+    sync_primitives::AutoLock auto_lock(dispatcher->pending_lock);
+    if (kMaxPendingMessages <= dispatcher->pending) {
+      LOG4CXX_WARN(logger_, "Plugin " << slot->module_id
+                   << " is overloaded, waiting for its messages processing");
+      dispatcher->blocked_callers_metric->Increment();
+    }
+    while (!dispatcher->stopped &&
+           kMaxPendingMessages <= dispatcher->pending) {
+      dispatcher->pending_cond.Wait(auto_lock);
+    }
+    if (dispatcher->stopped) {
+      LOG4CXX_WARN(logger_, "Message " << msg->function_id()
+                   << " is dropped since plugin is unloaded");
+      Release(slot);
+      return;
+    }
+    ++dispatcher->pending;
+    dispatcher->pending_messages_metric->Set(dispatcher->pending);
+  }
+  ProcessMessageTask* task = new ProcessMessageTask(dispatcher, msg);
+  if (dispatcher->strand) {
+    dispatcher->strand->Post(task);
+  } else {
+    pool_->Schedule(task);
+  }
+  // Pending task keeps module from being destroyed
+  Release(slot);
+}
+
+void PluginManager::UnloadIdleModules() {
+  const TimevalStruct now = date_time::DateTime::getCurrentTime();
+  for (Slots::iterator it = slots_.begin(); slots_.end() != it; ++it) {
+    ModuleSlot* slot = it->second;
+    if (!slot->described) {
+      continue;
+    }
+    sync_primitives::AutoLock auto_lock(slot->lock);
+    if (slot->dispatcher && 0 == slot->users &&
+        date_time::DateTime::Sub(now, slot->last_use).tv_sec >=
+          static_cast<int64_t>(idle_timeout_) &&
+        !slot->dispatcher->HasPending()) {
+      DetachModule(slot);
+    }
+  }
+}
+
+PluginManager::Modules PluginManager::LoadedModules() const {
+  sync_primitives::AutoLock auto_lock(plugins_lock_);
+  return plugins_;
+}
+
+bool PluginManager::LoadPlugin(const std::string& file_name) {
+  void* generic_plugin_dll = dlopen(file_name.c_str(), RTLD_LAZY);
+  if (NULL == generic_plugin_dll) {
+    LOG4CXX_ERROR(logger_, "Failed to open dll " << file_name << "\n"
+                  << dlerror());
+    return false;
+  }
+  typedef GenericModule* (*Create)();
+  Create create_manager = reinterpret_cast<Create>(
+    dlsym(generic_plugin_dll, "Create"));
+  char* error_string = dlerror();
+  if (NULL != error_string) {
+    LOG4CXX_ERROR(logger_, "Failed to export dll's " << file_name
+      << " symbols\n" << error_string);
+    dlclose(generic_plugin_dll);
+    return false;
+  }
+  // Describe export is optional
+  DescribeModule describe = reinterpret_cast<DescribeModule>(
+    dlsym(generic_plugin_dll, "Describe"));
+  dlerror();
+
+  ModuleSlot* slot = new ModuleSlot(file_name, create_manager);
+  bool described = false;
+  ModulePtr module;
+  if (describe) {
+    described = describe(&slot->module_id, &slot->info);
+    slot->described = described;
+  } else {
+    module = create_manager();
+  }
+  if (!described && !module) {
+    LOG4CXX_ERROR(logger_, "Failed to create plugin main class "
+      << file_name);
+    delete slot;
+    dlclose(generic_plugin_dll);
+    return false;
+  }
+  if (module) {
+    slot->module_id = module->GetModuleID();
+    slot->info = module->GetPluginInfo();
+  }
+  if (slots_.end() != slots_.find(slot->module_id)) {
+    LOG4CXX_ERROR(logger_, "Plugin with id " << slot->module_id
+                  << " is already loaded, skipping " << file_name);
+    module.reset();
+    delete slot;
+    dlclose(generic_plugin_dll);
+    return false;
+  }
+  LOG4CXX_DEBUG(logger_, "Opened and working plugin from "
+                << file_name << " with id " << slot->module_id
+                << (described ? ", module is created on demand" : ""));
+  dlls_.insert(std::make_pair(slot->module_id, generic_plugin_dll));
+  slots_.insert(std::make_pair(slot->module_id, slot));
+
+  const std::deque<MobileFunctionID>& subscribers =
+    slot->info.mobile_function_list;
+  for (size_t i = 0; i < subscribers.size(); ++i) {
+    AddMobileRoute(subscribers[i], slot);
+  }
+  const std::deque<HMIFunctionID>& hmi_subscribers =
+    slot->info.hmi_function_list;
+  for (size_t i = 0; i < hmi_subscribers.size(); ++i) {
+    hmi_subscribers_.insert(std::make_pair(hmi_subscribers[i], slot));
+  }
+  if (module) {
+    sync_primitives::AutoLock auto_lock(slot->lock);
+    AttachModule(slot, module);
+  }
+  return true;
+}
+
+int PluginManager::LoadPlugins(const std::string& plugin_path,
+                               uint32_t idle_timeout) {
   LOG4CXX_INFO(logger_, "Loading plugins from " << plugin_path);
   std::vector<std::string> plugin_files = file_system::ListFiles(
       plugin_path);
+  bool has_described = false;
   for (size_t i = 0; i < plugin_files.size(); ++i) {
     size_t pos = plugin_files[i].find_last_of(".");
     if (std::string::npos != pos) {
@@ -71,62 +486,38 @@ int PluginManager::LoadPlugins(const std::string& plugin_path) {
     } else {
       continue;
     }
-    std::string full_name = plugin_path + '/' + plugin_files[i];
-    void* generic_plugin_dll = dlopen(full_name.c_str(), RTLD_LAZY);
-    if (NULL == generic_plugin_dll) {
-      LOG4CXX_ERROR(logger_, "Failed to open dll " << plugin_files[i] << "\n"
-                    << dlerror());
-      continue;
-    }
-    typedef GenericModule* (*Create)();
-    Create create_manager = reinterpret_cast<Create>(
-      dlsym(generic_plugin_dll, "Create"));
-    char* error_string = dlerror();
-    if (NULL != error_string) {
-      LOG4CXX_ERROR(logger_, "Failed to export dll's " << plugin_files[i]
-        << " symbols\n" << error_string);
-      dlclose(generic_plugin_dll);
-      continue;
-    }
-    ModulePtr module = create_manager();
-    if (!module) {
-      LOG4CXX_ERROR(logger_, "Failed to create plugin main class "
-        << plugin_files[i]);
-      dlclose(generic_plugin_dll);
-      continue;
-    } else {
-      LOG4CXX_DEBUG(logger_, "Opened and working plugin from "
-                    << plugin_files[i] << " with id "
-                    << module->GetModuleID());
-      dlls_.insert(std::pair<ModuleID, void*>(
-                     module->GetModuleID(), generic_plugin_dll));
-      plugins_.insert(std::pair<ModuleID, ModulePtr>(
-                        module->GetModuleID(), module));
-      std::deque<MobileFunctionID> subscribers =
-        module->GetPluginInfo().mobile_function_list;
-      for (size_t i = 0; i < subscribers.size(); ++i) {
-        mobile_subscribers_.insert(std::pair<MobileFunctionID, ModulePtr>(
-          subscribers[i], module));
-      }
-
-      std::deque<HMIFunctionID> hmi_subscribers =
-        module->GetPluginInfo().hmi_function_list;
-      for (size_t i = 0; i < hmi_subscribers.size(); ++i) {
-        hmi_subscribers_.insert(
-          std::pair<HMIFunctionID, ModulePtr>(hmi_subscribers[i], module));
-      }
-      module->set_service(service_);
-      module->AddObserver(this);
-    }
+    LoadPlugin(plugin_path + '/' + plugin_files[i]);
+  }
+  for (Slots::iterator it = slots_.begin(); slots_.end() != it; ++it) {
+    has_described = has_described || it->second->described;
+  }
+  idle_timeout_ = idle_timeout;
+  if (has_described && idle_timeout_) {
+    idle_timer_.start(idle_timeout_);
   }
-  return plugins_.size();
+  return slots_.size();
 }
 
 void PluginManager::UnloadPlugins() {
-  for (Modules::iterator it = plugins_.begin(); plugins_.end() != it; ++it) {
-    it->second->RemoveObserver(this);
+  idle_timer_.stop();
+  mobile_routes_.clear();
+  hmi_subscribers_.clear();
+  for (Slots::iterator it = slots_.begin(); slots_.end() != it; ++it) {
+    ModuleSlot* slot = it->second;
+    {
+      sync_primitives::AutoLock auto_lock(slot->lock);
+      if (slot->dispatcher) {
+        DetachModule(slot);
+      }
+    }
+    delete slot;
+  }
+  slots_.clear();
+  {
+    sync_primitives::AutoLock auto_lock(pool_lock_);
+    delete pool_;
+    pool_ = NULL;
   }
-  plugins_.clear();
 
   for (std::map<ModuleID, void*>::iterator it = dlls_.begin();
        dlls_.end() != it; ++it) {
@@ -135,27 +526,15 @@ void PluginManager::UnloadPlugins() {
   dlls_.clear();
 }
 
-// TODO(VS): Optimize similar code in ProcessMessage, IsMessageForPlugin,
-// ProcessHMIMessage, IsHMIMessageForPlugin methods
-// (also we have similar code in can module)
 void PluginManager::ProcessMessage(application_manager::MessagePtr msg) {
   DCHECK(msg);
   if (!msg) {
     LOG4CXX_ERROR(logger_, "Null pointer message was received.");
     return;
   }
-  if (application_manager::ProtocolVersion::kUnknownProtocol !=
-        msg->protocol_version()
-      && application_manager::ProtocolVersion::kHMI !=
-        msg->protocol_version()) {
-    PluginFunctionsIterator subscribed_plugin_itr = mobile_subscribers_.find(
-          static_cast<MobileFunctionID>(msg->function_id()));
-    if (mobile_subscribers_.end() != subscribed_plugin_itr) {
-      if (subscribed_plugin_itr->second->ProcessMessage(msg) !=
-          ProcessResult::PROCESSED) {
-        LOG4CXX_ERROR(logger_, "Failed process HMI message!");
-      }
-    }
+  ModuleSlot* slot = MobileRoute(msg);
+  if (slot) {
+    Dispatch(slot, msg);
   }
 }
 
@@ -165,35 +544,17 @@ ProcessResult PluginManager::ProcessHMIMessage(application_manager::MessagePtr m
     LOG4CXX_ERROR(logger_, "Null pointer message was received.");
     return ProcessResult::CANNOT_PROCESS;
   }
-
-  Json::Value value;
-  Json::Reader reader;
-  reader.parse(msg->json_message(), value);
-
-  std::string function_name;
-  if (application_manager::ProtocolVersion::kHMI == msg->protocol_version()) {
-    // Request or notification from HMI
-    if (value.isMember("method")) {
-      function_name = value["method"].asCString();
-      // Response from HMI
-    } else if (value.isMember("result") && value["result"].isMember("method")) {
-      function_name = value["result"]["method"].asCString();
-      // Error response from HMI
-    }  else if (value.isMember("error") && value["error"].isMember("data") &&
-                value["error"]["data"].isMember("method")) {
-      function_name = value["error"]["data"]["method"].asCString();
-    } else {
-      DCHECK(false);
-      return ProcessResult::CANNOT_PROCESS;
-    }
+  ModuleSlot* slot = HMIRoute(msg);
+  if (!slot) {
+    return ProcessResult::CANNOT_PROCESS;
   }
-
-  PluginHMIFunctionsIterator subscribed_plugin_itr =
-    hmi_subscribers_.find(function_name);
-  if (hmi_subscribers_.end() != subscribed_plugin_itr) {
-    return subscribed_plugin_itr->second->ProcessHMIMessage(msg);
+  ModuleDispatcher* dispatcher = Acquire(slot);
+  if (!dispatcher) {
+    return ProcessResult::FAILED;
   }
-  return ProcessResult::CANNOT_PROCESS;
+  const ProcessResult result = dispatcher->module->ProcessHMIMessage(msg);
+  Release(slot);
+  return result;
 }
 
 bool PluginManager::IsMessageForPlugin(application_manager::MessagePtr msg) {
@@ -202,15 +563,7 @@ bool PluginManager::IsMessageForPlugin(application_manager::MessagePtr msg) {
     LOG4CXX_ERROR(logger_, "Null pointer message was received.");
     return false;
   }
-  if (application_manager::ProtocolVersion::kUnknownProtocol !=
-      msg->protocol_version()
-      && application_manager::ProtocolVersion::kHMI !=
-      msg->protocol_version()) {
-    MobileFunctionID id = static_cast<MobileFunctionID>(msg->function_id());
-    return (mobile_subscribers_.find(id) != mobile_subscribers_.end());
-  } else {
-    return false;
-  }
+  return NULL != MobileRoute(msg);
 }
 
 bool PluginManager::IsHMIMessageForPlugin(application_manager::MessagePtr msg) {
@@ -219,36 +572,14 @@ bool PluginManager::IsHMIMessageForPlugin(application_manager::MessagePtr msg) {
     LOG4CXX_ERROR(logger_, "Null pointer message was received.");
     return false;
   }
-
-  Json::Value value;
-  Json::Reader reader;
-  reader.parse(msg->json_message(), value);
-
-  if (application_manager::ProtocolVersion::kHMI == msg->protocol_version()) {
-    // Request or notification from HMI
-    if (value.isMember("method")) {
-      return (hmi_subscribers_.find(value["method"].asCString()) !=
-              hmi_subscribers_.end());
-      // Response from HMI
-    } else if (value.isMember("result") && value["result"].isMember("method")) {
-      return (hmi_subscribers_.find(value["result"]["method"].asCString()) !=
-              hmi_subscribers_.end());
-      // Error response from HMI
-    }  else if (value.isMember("error") && value["error"].isMember("data") &&
-                value["error"]["data"].isMember("method")) {
-      return (hmi_subscribers_.find(value["error"]["data"]["method"].asCString()) !=
-              hmi_subscribers_.end());
-    } else {
-      DCHECK(false);
-    }
-  }
-
-  return false;
+  return NULL != HMIRoute(msg);
 }
 
 void PluginManager::OnServiceStateChanged(ServiceState state) {
-  for (PluginsIterator it = plugins_.begin();
-       plugins_.end() != it; ++it) {
+  service_state_ = state;
+  Modules modules = LoadedModules();
+  for (PluginsIterator it = modules.begin();
+       modules.end() != it; ++it) {
     it->second->OnServiceStateChanged(state);
   }
 }
@@ -274,7 +605,8 @@ void PluginManager::OnError(ModuleObserver::Errors error, ModuleID module_id) {
 }
 
 void PluginManager::RemoveAppExtension(uint32_t app_id) {
-  for (PluginsIterator it = plugins_.begin(); plugins_.end() != it; ++it) {
+  Modules modules = LoadedModules();
+  for (PluginsIterator it = modules.begin(); modules.end() != it; ++it) {
     it->second->RemoveAppExtension(app_id);
   }
 }
@@ -287,7 +619,8 @@ bool PluginManager::IsAppForPlugins(
   }
 
   bool res = false;
-  for (PluginsIterator it = plugins_.begin(); plugins_.end() != it; ++it) {
+  Modules modules = LoadedModules();
+  for (PluginsIterator it = modules.begin(); modules.end() != it; ++it) {
     res = res || it->second->IsAppForPlugin(app);
   }
   return res;
@@ -295,8 +628,15 @@ bool PluginManager::IsAppForPlugins(
 
 bool PluginManager::IsAppForPlugin(
     application_manager::ApplicationSharedPtr app, ModuleID module_id) const {
-  Modules::const_iterator i = plugins_.find(module_id);
-  return i != plugins_.end() ? i->second->IsAppForPlugin(app) : false;
+  ModulePtr module;
+  {
+    sync_primitives::AutoLock auto_lock(plugins_lock_);
+    Modules::const_iterator i = plugins_.find(module_id);
+    if (plugins_.end() != i) {
+      module = i->second;
+    }
+  }
+  return module ? module->IsAppForPlugin(app) : false;
 }
 
 void PluginManager::OnAppHMILevelChanged(
@@ -306,7 +646,8 @@ void PluginManager::OnAppHMILevelChanged(
   if (!app) {
     return;
   }
-  for (PluginsIterator it = plugins_.begin(); plugins_.end() != it; ++it) {
+  Modules modules = LoadedModules();
+  for (PluginsIterator it = modules.begin(); modules.end() != it; ++it) {
     if (it->second->IsAppForPlugin(app)) {
       LOG4CXX_DEBUG(logger_, "Application " << app->name() << " of plugin "
         << it->second->GetModuleID() << " has changed level from " << old_level
@@ -324,7 +665,8 @@ bool PluginManager::CanAppChangeHMILevel(
     return false;
   }
   bool result = true;
-  for (PluginsIterator it = plugins_.begin(); plugins_.end() != it; ++it) {
+  Modules modules = LoadedModules();
+  for (PluginsIterator it = modules.begin(); modules.end() != it; ++it) {
     if (it->second->IsAppForPlugin(app)) {
       result = result && it->second->CanAppChangeHMILevel(app, new_level);
       LOG4CXX_DEBUG(logger_, "Application " << app->name() << " of plugin "
@@ -351,7 +693,8 @@ struct HandleDeviceRemoved {
 void PluginManager::OnDeviceRemoved(
     const connection_handler::DeviceHandle& device) {
   LOG4CXX_AUTO_TRACE(logger_);
-  std::for_each(plugins_.begin(), plugins_.end(), HandleDeviceRemoved(device));
+  Modules modules = LoadedModules();
+  std::for_each(modules.begin(), modules.end(), HandleDeviceRemoved(device));
 }
 
 }  //  namespace functional_modules
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_DIRECT_ADAPTER_H_
+#define SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_DIRECT_ADAPTER_H_
+
+#include <string>
+#include "hmi_message_handler/hmi_message_adapter.h"
+#include "smart_objects/smart_object.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace hmi_message_handler {
+
+namespace smart_objects = NsSmartDeviceLink::NsSmartObjects;
+
+/**
+ * \class DirectHMI
+ * \brief Interface of HMI linked into SDL process.
+ */
+class DirectHMI {
+ public:
+  virtual ~DirectHMI() {}
+  /**
+   * \brief Receives message from SDL, it is called on the thread
+   * sending messages to HMI so it should not block for long.
+   * \param message HMI API message with attached schema
+   */
+  virtual void OnMessageFromSDL(const smart_objects::SmartObject& message) = 0;
+};
+
+/**
+ * \class DirectAdapter
+ * \brief HMI message adapter passing smart objects to and from in-process
+ * HMI, messages are neither formatted to JSON nor parsed.
+ */
+class DirectAdapter : public HMIMessageAdapter {
+ public:
+  explicit DirectAdapter(HMIMessageHandler* handler);
+  virtual ~DirectAdapter();
+
+  /**
+   * \brief Registers HMI receiving messages from SDL
+   * \param hmi HMI or NULL to stop passing messages
+   */
+  void set_hmi(DirectHMI* hmi);
+
+  /**
+   * \brief Passes message from HMI to SDL
+   * \param message HMI API message
+   */
+  void SendMessageToSDL(const smart_objects::SmartObject& message);
+
+  virtual void SubscribeToHMINotification(const std::string& hmi_notification);
+
+ protected:
+  virtual void SendMessageToHMI(MessageSharedPointer message);
+  virtual void SubscribeTo();
+
+ private:
+  sync_primitives::Lock hmi_lock_;
+  DirectHMI* hmi_;
+  DISALLOW_COPY_AND_ASSIGN(DirectAdapter);
+};
+
+}  // namespace hmi_message_handler
+
+#endif  // SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_DIRECT_ADAPTER_H_
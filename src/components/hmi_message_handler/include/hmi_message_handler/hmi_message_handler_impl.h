@@ -33,12 +33,15 @@
 #ifndef SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_HMI_MESSAGE_HANDLER_IMPL_H_
 #define SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_HMI_MESSAGE_HANDLER_IMPL_H_
 
+#include <map>
 #include <set>
+#include <string>
 #include "hmi_message_handler/hmi_message_adapter.h"
 #include "hmi_message_handler/hmi_message_handler.h"
+#include "hmi_message_handler/lanes_queue.h"
+#include "utils/lock.h"
 #include "utils/macro.h"
 #include "utils/message_queue.h"
-#include "utils/prioritized_queue.h"
 #include "utils/threads/message_loop_thread.h"
 #include "utils/threads/thread.h"
 #include "utils/singleton.h"
@@ -57,38 +60,48 @@ namespace impl {
 struct MessageFromHmi: public MessageSharedPointer {
   MessageFromHmi(const MessageSharedPointer& message)
       : MessageSharedPointer(message) {}
-  // PrioritizedQueue requres this method to decide which priority to assign
-  size_t PriorityOrder() const { return (*this)->Priority().OrderingValue(); }
 };
 
 struct MessageToHmi: public MessageSharedPointer {
   MessageToHmi(const MessageSharedPointer& message)
       : MessageSharedPointer(message) {}
-  // PrioritizedQueue requres this method to decide which priority to assign
-  size_t PriorityOrder() const { return (*this)->Priority().OrderingValue(); }
 };
 
+// Messages are ordered by their lanes, see LanesQueue
 typedef threads::MessageLoopThread<
-    utils::PrioritizedQueue<MessageFromHmi> > FromHmiQueue;
+    LanesQueue<MessageFromHmi> > FromHmiQueue;
 typedef threads::MessageLoopThread<
-    utils::PrioritizedQueue<MessageToHmi> > ToHmiQueue;
+    LanesQueue<MessageToHmi> > ToHmiQueue;
 }
 
 class ToHMIThreadImpl;
 class FromHMIThreadImpl;
 
+/*
+ * Each adapter is sent messages by its own thread, so slow adapter does
+ * not delay others. Adapter may take only messages of some interfaces.
+ */
 class HMIMessageHandlerImpl
     : public HMIMessageHandler,
       public impl::FromHmiQueue::Handler,
-      public impl::ToHmiQueue::Handler,
       public utils::Singleton<HMIMessageHandlerImpl> {
  public:
+  // Names of HMI interfaces, e.g. "UI", "VR"
+  typedef std::set<std::string> Interfaces;
+
   ~HMIMessageHandlerImpl();
   void OnMessageReceived(MessageSharedPointer message);
   void SendMessageToHMI(MessageSharedPointer message);
   void set_message_observer(HMIMessageObserver* observer);
   void OnErrorSending(MessageSharedPointer message);
   void AddHMIMessageAdapter(HMIMessageAdapter* adapter);
+  /**
+   * @brief Adds adapter getting messages and notification subscriptions
+   * of given interfaces only
+   * @param interfaces empty means all interfaces
+   */
+  void AddHMIMessageAdapter(HMIMessageAdapter* adapter,
+                            const Interfaces& interfaces);
   void RemoveHMIMessageAdapter(HMIMessageAdapter* adapter);
   /**
    * @brief Subscribes to notification from HMI
@@ -100,23 +113,24 @@ class HMIMessageHandlerImpl
  private:
   HMIMessageHandlerImpl();
 
+  class AdapterChannel;
+  typedef std::map<HMIMessageAdapter*, AdapterChannel*> AdapterChannels;
 
   // threads::MessageLoopThread<*>::Handler implementations
 
   // CALLED ON messages_from_hmi_ THREAD!
   virtual void Handle(const impl::MessageFromHmi message) OVERRIDE;
-  // CALLED ON messages_to_hmi_ THREAD!
-  virtual void Handle(const impl::MessageToHmi message) OVERRIDE;
  private:
 
   HMIMessageObserver* observer_;
   mutable sync_primitives::Lock observer_locker_;
-  std::set<HMIMessageAdapter*> message_adapters_;
+  // Send queue and thread of each adapter
+  AdapterChannels adapter_channels_;
+  sync_primitives::Lock adapter_channels_lock_;
+  uint32_t adapters_added_;
 
   // Construct message threads when everything is already created
 
-  // Thread that pumps messages being passed to hmi.
-  impl::ToHmiQueue messages_to_hmi_;
   // Thread that pumps messages coming from hmi.
   impl::FromHmiQueue messages_from_hmi_;
 
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_LANES_QUEUE_H_
+#define SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_LANES_QUEUE_H_
+
+#include <stdint.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include "application_manager/message.h"
+#include "utils/logger.h"
+#include "utils/macro.h"
+
+namespace hmi_message_handler {
+namespace impl {
+
+/*
+ * Classes of HMI messages, messages of higher lane are handled first.
+ * Requests and notifications share regular lane so their order is kept,
+ * only periodic notifications like OnVehicleData go to separate lane.
+ */
+enum Lane {
+  kBulkLane = 0,
+  kPeriodicLane,
+  kRegularLane,
+  kResponseLane,
+  kLanesCount
+};
+
+/*
+ * Lane message belongs to, message of unknown type goes to regular lane
+ */
+Lane LaneOf(const application_manager::Message& message);
+
+/*
+ * Key of notification superseded by next one with the same key,
+ * empty for messages which are never superseded
+ */
+std::string SupersedingKey(const application_manager::Message& message);
+
+/*
+ * HMI interface of message, e.g. "VR" for VR.PerformInteraction,
+ * empty if function is not known
+ */
+std::string InterfaceOf(const application_manager::Message& message);
+
+/*
+ * Queue giving out HMI messages by lanes. Lane of periodic notifications
+ * is bounded, new notification is dropped when the lane is full and
+ * pending notification superseded by new one is replaced in place.
+ * Messages of other lanes are never dropped.
+ * Message class must be a shared pointer to application_manager::Message.
+ * All api mimics usual std queue interface.
+ */
+template < typename M >
+class LanesQueue {
+ public:
+  typedef M value_type;
+  static const size_t kPeriodicLaneCapacity = 1000;
+
+  LanesQueue()
+    : total_size_(0) {
+  }
+  void push(const value_type& message) {
+    const Lane lane = LaneOf(*message);
+    LaneQueue& queue = lanes_[lane];
+    const std::string key = kPeriodicLane == lane ?
+                            SupersedingKey(*message) : std::string();
+    if (!key.empty()) {
+      typename Pending::iterator it = queue.pending.find(key);
+      if (queue.pending.end() != it) {
+        queue.messages[it->second - queue.popped].message = message;
+        return;
+      }
+    }
+    if (kPeriodicLane == lane &&
+        queue.messages.size() >= kPeriodicLaneCapacity) {
+      CREATE_LOGGERPTR_LOCAL(logger_, "HMIMessageHandler")
+      LOG4CXX_WARN(logger_, "Periodic HMI messages lane is full, message "
+                   << message->function_name() << " is dropped");
+      return;
+    }
+    if (!key.empty()) {
+      queue.pending[key] = queue.popped + queue.messages.size();
+    }
+    queue.messages.push_back(Entry(message, key));
+    ++total_size_;
+  }
+  size_t size() const {
+    return total_size_;
+  }
+  bool empty() const {
+    return 0 == total_size_;
+  }
+  value_type front() {
+    DCHECK(!empty());
+    return lanes_[HighestLane()].messages.front().message;
+  }
+  void pop() {
+    DCHECK(!empty());
+    LaneQueue& queue = lanes_[HighestLane()];
+    const std::string& key = queue.messages.front().key;
+    if (!key.empty()) {
+      queue.pending.erase(key);
+    }
+    queue.messages.pop_front();
+    ++queue.popped;
+    --total_size_;
+  }
+  void swap(LanesQueue& other) {
+    for (size_t lane = 0; lane < kLanesCount; ++lane) {
+      lanes_[lane].swap(other.lanes_[lane]);
+    }
+    std::swap(total_size_, other.total_size_);
+  }
+
+ private:
+  struct Entry {
+    Entry(const value_type& message, const std::string& key)
+      : message(message),
+        key(key) {
+    }
+    value_type message;
+    std::string key;
+  };
+  // Superseding key to monotonic number of pending message in lane
+  typedef std::map<std::string, uint64_t> Pending;
+
+  struct LaneQueue {
+    LaneQueue()
+      : popped(0) {
+    }
+    void swap(LaneQueue& other) {
+      messages.swap(other.messages);
+      pending.swap(other.pending);
+      std::swap(popped, other.popped);
+    }
+    std::deque<Entry> messages;
+    Pending pending;
+    uint64_t popped;
+  };
+
+  size_t HighestLane() const {
+    for (size_t lane = kLanesCount; lane > 0; --lane) {
+      if (!lanes_[lane - 1].messages.empty()) {
+        return lane - 1;
+      }
+    }
+    NOTREACHED();
+    return 0;
+  }
+
+  LaneQueue lanes_[kLanesCount];
+  size_t total_size_;
+};
+
+}  // namespace impl
+}  // namespace hmi_message_handler
+
+#endif  // SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_LANES_QUEUE_H_
@@ -81,7 +81,15 @@ class MessageBrokerAdapter : public HMIMessageAdapter,
       const std::string& hmi_notification);
 
  protected:
-  void ProcessRecievedFromMB(Json::Value& root);
+  /**
+   * \brief Passes received message to handler
+   * \param root Received Json object.
+   * \param type Type of received message.
+   * \param method Name of method, used to order messages by their lanes.
+   */
+  void ProcessRecievedFromMB(Json::Value& root,
+                             application_manager::MessageType type,
+                             const std::string& method);
 
  private:
   static const std::string ADDRESS;
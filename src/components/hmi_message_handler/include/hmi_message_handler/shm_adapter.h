@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_SHM_ADAPTER_H_
+#define SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_SHM_ADAPTER_H_
+
+#include "utils/lock.h"
+#include "utils/threads/thread.h"
+#include "hmi_message_handler/hmi_message_adapter.h"
+#include "utils/shm_ring.h"
+
+namespace hmi_message_handler {
+
+class ShmReceiverDelegate;
+
+/**
+ * \brief HMI message adapter exchanging messages through ring buffers in
+ * shared memory. Segment holds SDL to HMI ring followed by HMI to SDL ring,
+ * both of ShmAdapter::kRingCapacity bytes.
+ */
+class ShmAdapter : public HMIMessageAdapter {
+ public:
+  static const uint32_t kRingCapacity = 1 << 20;
+
+  explicit ShmAdapter(HMIMessageHandler* hmi_message_handler);
+  virtual ~ShmAdapter();
+
+  virtual void SubscribeToHMINotification(const std::string& hmi_notification);
+
+ protected:
+  virtual void SendMessageToHMI(MessageSharedPointer message);
+  virtual void SubscribeTo();
+
+ private:
+  void* memory_;
+  size_t memory_size_;
+  utils::ShmRing sdl_to_hmi_;
+  utils::ShmRing hmi_to_sdl_;
+  sync_primitives::Lock send_lock_;
+
+  ShmReceiverDelegate* receiver_thread_delegate_;
+  threads::Thread* receiver_thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShmAdapter);
+};
+
+}  // namespace hmi_message_handler
+#endif  // SRC_COMPONENTS_HMI_MESSAGE_HANDLER_INCLUDE_HMI_MESSAGE_HANDLER_SHM_ADAPTER_H_
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hmi_message_handler/direct_adapter.h"
+#include "hmi_message_handler/hmi_message_handler.h"
+#include "formatters/formatter_json_rpc.h"
+#include "interfaces/HMI_API.h"
+#include "utils/logger.h"
+
+namespace hmi_message_handler {
+
+namespace formatters = NsSmartDeviceLink::NsJSONHandler::Formatters;
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "HMIMessageHandler")
+
+DirectAdapter::DirectAdapter(HMIMessageHandler* handler)
+    : HMIMessageAdapter(handler),
+      hmi_(NULL) {
+}
+
+DirectAdapter::~DirectAdapter() {
+  set_hmi(NULL);
+}
+
+void DirectAdapter::set_hmi(DirectHMI* hmi) {
+  sync_primitives::AutoLock lock(hmi_lock_);
+  hmi_ = hmi;
+}
+
+void DirectAdapter::SendMessageToSDL(
+    const smart_objects::SmartObject& message) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  MessageSharedPointer message_to_sdl(new application_manager::Message(
+      protocol_handler::MessagePriority::kDefault));
+  message_to_sdl->set_protocol_version(
+      application_manager::ProtocolVersion::kHMI);
+  message_to_sdl->set_smart_object(message);
+  handler()->OnMessageReceived(message_to_sdl);
+}
+
+void DirectAdapter::SubscribeToHMINotification(
+    const std::string& hmi_notification) {
+  // HMI is called for every message, there is nothing to subscribe to
+}
+
+void DirectAdapter::SendMessageToHMI(MessageSharedPointer message) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock lock(hmi_lock_);
+  if (!hmi_) {
+    LOG4CXX_WARN(logger_, "No in-process HMI is set");
+    return;
+  }
+  if (message->json_message().empty()) {
+    hmi_->OnMessageFromSDL(message->smart_object());
+    return;
+  }
+  // Plugins still send formatted messages
+  smart_objects::SmartObject object;
+  if (formatters::FormatterJsonRpc::kSuccess !=
+      formatters::FormatterJsonRpc::FromString<hmi_apis::FunctionID::eType,
+                                               hmi_apis::messageType::eType>(
+          message->json_message(), object)) {
+    LOG4CXX_ERROR(logger_, "Cannot parse message " << message->json_message());
+    return;
+  }
+  hmi_->OnMessageFromSDL(object);
+}
+
+void DirectAdapter::SubscribeTo() {
+  // empty implementation of pure virtual method, actually it's not called
+}
+
+}  // namespace hmi_message_handler
@@ -31,6 +31,9 @@
  */
 
 #include "hmi_message_handler/hmi_message_handler_impl.h"
+
+#include <sstream>
+
 #include "config_profile/profile.h"
 #include "utils/logger.h"
 
@@ -38,11 +41,49 @@ namespace hmi_message_handler {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "HMIMessageHandler")
 
+class HMIMessageHandlerImpl::AdapterChannel
+    : public impl::ToHmiQueue::Handler {
+ public:
+  AdapterChannel(const std::string& name, HMIMessageAdapter* adapter,
+                 const Interfaces& interfaces)
+    : adapter_(adapter),
+      interfaces_(interfaces),
+      messages_to_hmi_(name, this,
+                 threads::ThreadOptions(
+                     profile::Profile::instance()->thread_min_stack_size())) {
+  }
+
+  bool IsSubscribedTo(const std::string& interface_name) const {
+    // Message of unknown interface goes to all adapters
+    return interfaces_.empty() || interface_name.empty() ||
+           interfaces_.end() != interfaces_.find(interface_name);
+  }
+
+  void PostMessage(const MessageSharedPointer& message) {
+    messages_to_hmi_.PostMessage(impl::MessageToHmi(message));
+  }
+
+  HMIMessageAdapter* adapter() const {
+    return adapter_;
+  }
+
+ private:
+  // CALLED ON messages_to_hmi_ THREAD!
+  virtual void Handle(const impl::MessageToHmi message) OVERRIDE {
+    adapter_->SendMessageToHMI(message);
+  }
+
+  HMIMessageAdapter* const adapter_;
+  const Interfaces interfaces_;
+  // Destroyed first, so pending messages are sent to adapter
+  impl::ToHmiQueue messages_to_hmi_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdapterChannel);
+};
+
 HMIMessageHandlerImpl::HMIMessageHandlerImpl()
     : observer_(NULL),
-      messages_to_hmi_("HMH ToHMI", this,
-                 threads::ThreadOptions(
-                     profile::Profile::instance()->thread_min_stack_size())),
+      adapters_added_(0),
       messages_from_hmi_("HMH FromHMI", this,
                  threads::ThreadOptions(
                      profile::Profile::instance()->thread_min_stack_size())) {
@@ -52,10 +93,14 @@ HMIMessageHandlerImpl::~HMIMessageHandlerImpl() {
   LOG4CXX_INFO(logger_, "HMIMessageHandlerImpl::~HMIMessageHandlerImpl()");
   sync_primitives::AutoLock lock(observer_locker_);
   observer_ = NULL;
-  if (!message_adapters_.empty()) {
+  if (!adapter_channels_.empty()) {
     LOG4CXX_WARN(logger_, "Not all HMIMessageAdapter have unsubscribed from"
                          " HMIMessageHandlerImpl");
   }
+  for (AdapterChannels::iterator it = adapter_channels_.begin();
+       it != adapter_channels_.end(); ++it) {
+    delete it->second;
+  }
 }
 
 void HMIMessageHandlerImpl::OnMessageReceived(MessageSharedPointer message) {
@@ -70,7 +115,14 @@ void HMIMessageHandlerImpl::OnMessageReceived(MessageSharedPointer message) {
 
 void HMIMessageHandlerImpl::SendMessageToHMI(MessageSharedPointer message) {
   LOG4CXX_INFO(logger_, "HMIMessageHandlerImpl::~sendMessageToHMI()");
-  messages_to_hmi_.PostMessage(impl::MessageToHmi(message));
+  const std::string interface_name = impl::InterfaceOf(*message);
+  sync_primitives::AutoLock lock(adapter_channels_lock_);
+  for (AdapterChannels::const_iterator it = adapter_channels_.begin();
+       it != adapter_channels_.end(); ++it) {
+    if (it->second->IsSubscribedTo(interface_name)) {
+      it->second->PostMessage(message);
+    }
+  }
 }
 
 void HMIMessageHandlerImpl::set_message_observer(HMIMessageObserver* observer) {
@@ -89,16 +141,41 @@ void HMIMessageHandlerImpl::OnErrorSending(MessageSharedPointer message) {
 }
 
 void HMIMessageHandlerImpl::AddHMIMessageAdapter(HMIMessageAdapter* adapter) {
+  AddHMIMessageAdapter(adapter, Interfaces());
+}
+
+void HMIMessageHandlerImpl::AddHMIMessageAdapter(
+    HMIMessageAdapter* adapter, const Interfaces& interfaces) {
   LOG4CXX_INFO(logger_, "HMIMessageHandlerImpl::AddHMIMessageAdapter()");
-  message_adapters_.insert(adapter);
+  if (adapter == NULL) {
+    return;
+  }
+  sync_primitives::AutoLock lock(adapter_channels_lock_);
+  if (adapter_channels_.end() != adapter_channels_.find(adapter)) {
+    LOG4CXX_WARN(logger_, "HMIMessageAdapter has already been added");
+    return;
+  }
+  std::stringstream name;
+  name << "HMH ToHMI " << ++adapters_added_;
+  adapter_channels_[adapter] =
+      new AdapterChannel(name.str(), adapter, interfaces);
 }
 
 void HMIMessageHandlerImpl::RemoveHMIMessageAdapter(
     HMIMessageAdapter* adapter) {
   LOG4CXX_INFO(logger_, "HMIMessageHandlerImpl::RemoveHMIMessageAdapter()");
-  if (adapter != NULL) {
-    message_adapters_.erase(adapter);
+  AdapterChannel* channel = NULL;
+  {
+    sync_primitives::AutoLock lock(adapter_channels_lock_);
+    AdapterChannels::iterator it = adapter_channels_.find(adapter);
+    if (adapter_channels_.end() == it) {
+      return;
+    }
+    channel = it->second;
+    adapter_channels_.erase(it);
   }
+  // Waits till messages already posted are sent
+  delete channel;
 }
 
 void HMIMessageHandlerImpl::Handle(const impl::MessageFromHmi message) {
@@ -111,24 +188,18 @@ void HMIMessageHandlerImpl::Handle(const impl::MessageFromHmi message) {
 
   observer_->OnMessageReceived(message);
   LOG4CXX_INFO(logger_, "Message from hmi given away.");
-
-}
-void HMIMessageHandlerImpl::Handle(const impl::MessageToHmi message) {
-  for (std::set<HMIMessageAdapter*>::iterator it =
-      message_adapters_.begin();
-      it != message_adapters_.end();
-      ++it) {
-    (*it)->SendMessageToHMI(message);
-  }
 }
 
 void  HMIMessageHandlerImpl::SubscribeToHMINotification(const std::string& hmi_notification) {
-  for (std::set<HMIMessageAdapter*>::iterator it =
-        message_adapters_.begin();
-        it != message_adapters_.end();
-        ++it) {
-      (*it)->SubscribeToHMINotification(hmi_notification);
+  const std::string interface_name =
+      hmi_notification.substr(0, hmi_notification.find('.'));
+  sync_primitives::AutoLock lock(adapter_channels_lock_);
+  for (AdapterChannels::const_iterator it = adapter_channels_.begin();
+       it != adapter_channels_.end(); ++it) {
+    if (it->second->IsSubscribedTo(interface_name)) {
+      it->second->adapter()->SubscribeToHMINotification(hmi_notification);
     }
+  }
 }
 
 
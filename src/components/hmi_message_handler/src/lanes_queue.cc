@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hmi_message_handler/lanes_queue.h"
+
+#include "json/json.h"
+#include "interfaces/HMI_API.h"
+
+namespace hmi_message_handler {
+namespace impl {
+
+namespace {
+const char* kOnVehicleData = "VehicleInfo.OnVehicleData";
+const char* kOnInteriorVehicleData = "RC.OnInteriorVehicleData";
+const char* kUpdateAppList = "BasicCommunication.UpdateAppList";
+const char* kUpdateDeviceList = "BasicCommunication.UpdateDeviceList";
+
+// Messages from HMI are known by name, messages to HMI by function id
+bool IsFunction(const application_manager::Message& message,
+                const std::string& function_name, const char* name,
+                hmi_apis::FunctionID::eType id) {
+  return function_name.empty() ? id == message.function_id()
+                               : function_name == name;
+}
+
+bool IsPeriodic(const application_manager::Message& message,
+                const std::string& function_name) {
+  return IsFunction(message, function_name, kOnVehicleData,
+                    hmi_apis::FunctionID::VehicleInfo_OnVehicleData) ||
+         IsFunction(message, function_name, kOnInteriorVehicleData,
+                    hmi_apis::FunctionID::RC_OnInteriorVehicleData);
+}
+
+bool IsBulk(const application_manager::Message& message,
+            const std::string& function_name) {
+  return IsFunction(message, function_name, kUpdateAppList,
+                    hmi_apis::FunctionID::BasicCommunication_UpdateAppList) ||
+         IsFunction(message, function_name, kUpdateDeviceList,
+                    hmi_apis::FunctionID::BasicCommunication_UpdateDeviceList);
+}
+}  // namespace
+
+Lane LaneOf(const application_manager::Message& message) {
+  switch (message.type()) {
+    case application_manager::kResponse:
+    case application_manager::kErrorResponse:
+      return kResponseLane;
+    case application_manager::kNotification:
+      return IsPeriodic(message, message.function_name()) ? kPeriodicLane
+                                                          : kRegularLane;
+    case application_manager::kRequest:
+      return IsBulk(message, message.function_name()) ? kBulkLane
+                                                      : kRegularLane;
+    default:
+      return kRegularLane;
+  }
+}
+
+std::string SupersedingKey(const application_manager::Message& message) {
+  // Vehicle data notification carries only changed parameters, so it
+  // supersedes pending one with exactly the same parameters
+  const std::string function_name = message.function_name();
+  if (kOnVehicleData != function_name || message.json_message().empty()) {
+    return std::string();
+  }
+  Json::Reader reader;
+  Json::Value root;
+  if (!reader.parse(message.json_message(), root, false) ||
+      !root["params"].isObject()) {
+    return std::string();
+  }
+  std::string key = function_name;
+  const Json::Value::Members members = root["params"].getMemberNames();
+  for (Json::Value::Members::const_iterator it = members.begin();
+       it != members.end(); ++it) {
+    key += '\n';
+    key += *it;
+  }
+  return key;
+}
+
+std::string InterfaceOf(const application_manager::Message& message) {
+  const std::string function_name = message.function_name();
+  if (function_name.empty()) {
+    const hmi_apis::FunctionInfo* info = hmi_apis::GetFunctionInfo(
+        static_cast<hmi_apis::FunctionID::eType>(message.function_id()));
+    return info ? info->interface_name : std::string();
+  }
+  const std::string::size_type dot = function_name.find('.');
+  return std::string::npos == dot ? std::string()
+                                  : function_name.substr(0, dot);
+}
+
+}  // namespace impl
+}  // namespace hmi_message_handler
@@ -75,17 +75,19 @@ void MessageBrokerAdapter::SendMessageToHMI(
 void MessageBrokerAdapter::processResponse(std::string method,
     Json::Value& root) {
   LOG4CXX_AUTO_TRACE(logger_);
-  ProcessRecievedFromMB(root);
+  ProcessRecievedFromMB(root, application_manager::kResponse, method);
 }
 
 void MessageBrokerAdapter::processRequest(Json::Value& root) {
   LOG4CXX_AUTO_TRACE(logger_);
-  ProcessRecievedFromMB(root);
+  ProcessRecievedFromMB(root, application_manager::kRequest,
+                        root["method"].asString());
 }
 
 void MessageBrokerAdapter::processNotification(Json::Value& root) {
   LOG4CXX_AUTO_TRACE(logger_);
-  ProcessRecievedFromMB(root);
+  ProcessRecievedFromMB(root, application_manager::kNotification,
+                        root["method"].asString());
 }
 
 void MessageBrokerAdapter::SubscribeTo() {
@@ -149,7 +151,9 @@ void* MessageBrokerAdapter::SubscribeAndBeginReceiverThread(void* param) {
   return MethodForReceiverThread(param);
 }
 
-void MessageBrokerAdapter::ProcessRecievedFromMB(Json::Value& root) {
+void MessageBrokerAdapter::ProcessRecievedFromMB(
+    Json::Value& root, application_manager::MessageType type,
+    const std::string& method) {
   LOG4CXX_AUTO_TRACE(logger_);
   if (root.isNull()) {
     // LOG
@@ -168,7 +172,8 @@ void MessageBrokerAdapter::ProcessRecievedFromMB(Json::Value& root) {
   // assign default priority
   hmi_message_handler::MessageSharedPointer message = hmi_message_handler::MessageSharedPointer(new application_manager::Message(
         protocol_handler::MessagePriority::kDefault));
-  // message->set_message_type()
+  message->set_message_type(type);
+  message->set_function_name(method);
   message->set_json_message(message_string);
   message->set_protocol_version(application_manager::ProtocolVersion::kHMI);
 
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hmi_message_handler/shm_adapter.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "hmi_message_handler/hmi_message_handler.h"
+#include "utils/logger.h"
+
+namespace hmi_message_handler {
+
+const char* kShmName = "/sdl_hmi_ring";
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "HMIMessageHandler")
+
+class ShmReceiverDelegate : public threads::ThreadDelegate {
+ public:
+  ShmReceiverDelegate(utils::ShmRing* ring,
+                      HMIMessageHandler* hmi_message_handler)
+      : ring_(ring),
+        hmi_message_handler_(hmi_message_handler) {}
+
+ private:
+  virtual void threadMain() {
+    std::string message_string;
+    while (ring_->Read(&message_string)) {
+      LOG4CXX_DEBUG(logger_, "Message: " << message_string);
+      MessageSharedPointer message(new application_manager::Message(
+          protocol_handler::MessagePriority::kDefault));
+      message->set_json_message(message_string);
+      message->set_protocol_version(application_manager::ProtocolVersion::kHMI);
+      hmi_message_handler_->OnMessageReceived(message);
+    }
+  }
+
+  virtual void exitThreadMain() {
+    ring_->Stop();
+  }
+
+  utils::ShmRing* ring_;
+  HMIMessageHandler* hmi_message_handler_;
+};
+
+ShmAdapter::ShmAdapter(HMIMessageHandler* hmi_message_handler)
+    : HMIMessageAdapter(hmi_message_handler),
+      memory_(MAP_FAILED),
+      memory_size_(2 * utils::ShmRing::RequiredSize(kRingCapacity)),
+      receiver_thread_delegate_(NULL),
+      receiver_thread_(NULL) {
+  const int fd = shm_open(kShmName, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+  if (-1 == fd) {
+    LOG4CXX_ERROR(logger_, "Could not open shared memory "
+                              << kShmName << ", error " << errno);
+    return;
+  }
+  if (0 == ftruncate(fd, memory_size_)) {
+    memory_ = mmap(NULL, memory_size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   fd, 0);
+  }
+  close(fd);
+  if (MAP_FAILED == memory_) {
+    LOG4CXX_ERROR(logger_, "Could not map shared memory "
+                              << kShmName << ", error " << errno);
+    return;
+  }
+  char* memory = static_cast<char*>(memory_);
+  sdl_to_hmi_.Attach(memory, kRingCapacity, true);
+  hmi_to_sdl_.Attach(memory + utils::ShmRing::RequiredSize(kRingCapacity),
+                     kRingCapacity, true);
+  receiver_thread_delegate_ = new ShmReceiverDelegate(&hmi_to_sdl_,
+                                                      hmi_message_handler);
+  receiver_thread_ = threads::CreateThread("ShmAdapter",
+                                           receiver_thread_delegate_);
+  receiver_thread_->start();
+}
+
+ShmAdapter::~ShmAdapter() {
+  if (receiver_thread_) {
+    receiver_thread_->join();
+    delete receiver_thread_delegate_;
+    threads::DeleteThread(receiver_thread_);
+  }
+  // Wakes up sender waiting for HMI to free space
+  sdl_to_hmi_.Stop();
+  {
+    sync_primitives::AutoLock lock(send_lock_);
+    if (MAP_FAILED != memory_) {
+      munmap(memory_, memory_size_);
+      memory_ = MAP_FAILED;
+    }
+  }
+  shm_unlink(kShmName);
+}
+
+void ShmAdapter::SendMessageToHMI(const MessageSharedPointer message) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock lock(send_lock_);
+  if (MAP_FAILED == memory_) {
+    LOG4CXX_ERROR(logger_, "Shared memory is not mapped");
+    return;
+  }
+  const std::string& json = message->json_message();
+  if (!sdl_to_hmi_.Write(json.data(), json.size())) {
+    LOG4CXX_ERROR(logger_, "Could not send message, ring is stopped");
+  }
+}
+
+void ShmAdapter::SubscribeTo() {
+  // empty implementation of pure virtual method, actually it's not called
+}
+
+void ShmAdapter::SubscribeToHMINotification(
+    const std::string& hmi_notification) {
+  // HMI reads all messages from the ring, there is nothing to subscribe to
+}
+
+}  // namespace hmi_message_handler
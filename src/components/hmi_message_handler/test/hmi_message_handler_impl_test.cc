@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "hmi_message_handler/hmi_message_adapter.h"
+#include "hmi_message_handler/hmi_message_handler_impl.h"
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+
+namespace test {
+namespace components {
+namespace hmi_message_handler_test {
+
+using hmi_message_handler::HMIMessageAdapter;
+using hmi_message_handler::HMIMessageHandlerImpl;
+using hmi_message_handler::MessageSharedPointer;
+using application_manager::Message;
+
+namespace {
+MessageSharedPointer CreateRequest(const std::string& name) {
+  MessageSharedPointer message(
+      new Message(protocol_handler::MessagePriority::kDefault));
+  message->set_message_type(application_manager::kRequest);
+  message->set_function_name(name);
+  return message;
+}
+
+// Records names of messages sent, sending may be held until released
+class FakeAdapter : public HMIMessageAdapter {
+ public:
+  FakeAdapter()
+    : HMIMessageAdapter(HMIMessageHandlerImpl::instance()),
+      held_(false) {
+  }
+
+  virtual void SendMessageToHMI(MessageSharedPointer message) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (held_) {
+      condition_.Wait(auto_lock);
+    }
+    sent_.push_back(message->function_name());
+    condition_.Broadcast();
+  }
+
+  virtual void SubscribeToHMINotification(
+      const std::string& hmi_notification) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    subscriptions_.push_back(hmi_notification);
+  }
+
+  void Hold(bool held) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    held_ = held;
+    condition_.Broadcast();
+  }
+
+  bool WaitSent(size_t count) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (sent_.size() < count) {
+      if (sync_primitives::ConditionalVariable::kTimeout ==
+          condition_.WaitFor(auto_lock, 1000)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<std::string> sent() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return sent_;
+  }
+
+  std::vector<std::string> subscriptions() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return subscriptions_;
+  }
+
+ protected:
+  virtual void SubscribeTo() {}
+
+ private:
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable condition_;
+  bool held_;
+  std::vector<std::string> sent_;
+  std::vector<std::string> subscriptions_;
+};
+}  // namespace
+
+TEST(HMIMessageHandlerImplTest, SendMessageToHMI_OnlySubscribedInterfaces) {
+  HMIMessageHandlerImpl* handler = HMIMessageHandlerImpl::instance();
+  FakeAdapter all_adapter;
+  FakeAdapter vr_adapter;
+  HMIMessageHandlerImpl::Interfaces vr;
+  vr.insert("VR");
+  handler->AddHMIMessageAdapter(&all_adapter);
+  handler->AddHMIMessageAdapter(&vr_adapter, vr);
+
+  handler->SendMessageToHMI(CreateRequest("UI.Show"));
+  handler->SendMessageToHMI(CreateRequest("VR.PerformInteraction"));
+  handler->SubscribeToHMINotification("UI.OnCommand");
+  handler->SubscribeToHMINotification("VR.OnCommand");
+  // Removal waits till posted messages are sent
+  handler->RemoveHMIMessageAdapter(&all_adapter);
+  handler->RemoveHMIMessageAdapter(&vr_adapter);
+
+  ASSERT_EQ(2u, all_adapter.sent().size());
+  EXPECT_EQ("UI.Show", all_adapter.sent()[0]);
+  EXPECT_EQ("VR.PerformInteraction", all_adapter.sent()[1]);
+  ASSERT_EQ(1u, vr_adapter.sent().size());
+  EXPECT_EQ("VR.PerformInteraction", vr_adapter.sent()[0]);
+  EXPECT_EQ(2u, all_adapter.subscriptions().size());
+  ASSERT_EQ(1u, vr_adapter.subscriptions().size());
+  EXPECT_EQ("VR.OnCommand", vr_adapter.subscriptions()[0]);
+}
+
+TEST(HMIMessageHandlerImplTest, SendMessageToHMI_SlowAdapterDoesNotBlockOthers) {
+  HMIMessageHandlerImpl* handler = HMIMessageHandlerImpl::instance();
+  FakeAdapter slow_adapter;
+  FakeAdapter fast_adapter;
+  slow_adapter.Hold(true);
+  handler->AddHMIMessageAdapter(&slow_adapter);
+  handler->AddHMIMessageAdapter(&fast_adapter);
+
+  handler->SendMessageToHMI(CreateRequest("UI.Show"));
+  handler->SendMessageToHMI(CreateRequest("UI.Alert"));
+  EXPECT_TRUE(fast_adapter.WaitSent(2));
+  EXPECT_TRUE(slow_adapter.sent().empty());
+
+  slow_adapter.Hold(false);
+  EXPECT_TRUE(slow_adapter.WaitSent(2));
+  handler->RemoveHMIMessageAdapter(&slow_adapter);
+  handler->RemoveHMIMessageAdapter(&fast_adapter);
+}
+
+}  // namespace hmi_message_handler_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "hmi_message_handler/lanes_queue.h"
+#include "hmi_message_handler/hmi_message_sender.h"
+#include "interfaces/HMI_API.h"
+
+namespace test {
+namespace components {
+namespace hmi_message_handler_test {
+
+using hmi_message_handler::MessageSharedPointer;
+using hmi_message_handler::impl::LanesQueue;
+using hmi_message_handler::impl::InterfaceOf;
+using application_manager::Message;
+
+namespace {
+typedef LanesQueue<MessageSharedPointer> Queue;
+
+MessageSharedPointer CreateMessage(application_manager::MessageType type,
+                                   const std::string& name,
+                                   const std::string& json = std::string()) {
+  MessageSharedPointer message(
+      new Message(protocol_handler::MessagePriority::kDefault));
+  message->set_message_type(type);
+  message->set_function_name(name);
+  message->set_json_message(json);
+  return message;
+}
+
+MessageSharedPointer CreateVehicleData(const std::string& params) {
+  return CreateMessage(application_manager::kNotification,
+                       "VehicleInfo.OnVehicleData",
+                       "{\"method\":\"VehicleInfo.OnVehicleData\","
+                       "\"params\":" + params + "}");
+}
+}  // namespace
+
+TEST(LanesQueueTest, FrontPop_ResponsesGoFirst_RegularOrderIsKept) {
+  Queue queue;
+  MessageSharedPointer vehicle_data = CreateVehicleData("{\"speed\":1}");
+  MessageSharedPointer update = CreateMessage(
+      application_manager::kRequest, "BasicCommunication.UpdateDeviceList");
+  MessageSharedPointer notification = CreateMessage(
+      application_manager::kNotification, "UI.OnSystemContext");
+  MessageSharedPointer request = CreateMessage(application_manager::kRequest,
+                                               "SDL.ActivateApp");
+  MessageSharedPointer response = CreateMessage(
+      application_manager::kResponse, "UI.Show");
+  queue.push(update);
+  queue.push(vehicle_data);
+  queue.push(notification);
+  queue.push(request);
+  queue.push(response);
+  ASSERT_EQ(5u, queue.size());
+
+  EXPECT_EQ(response, queue.front());
+  queue.pop();
+  EXPECT_EQ(notification, queue.front());
+  queue.pop();
+  EXPECT_EQ(request, queue.front());
+  queue.pop();
+  EXPECT_EQ(vehicle_data, queue.front());
+  queue.pop();
+  EXPECT_EQ(update, queue.front());
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(LanesQueueTest, Push_SupersededVehicleDataIsReplaced) {
+  Queue queue;
+  queue.push(CreateVehicleData("{\"speed\":1}"));
+  MessageSharedPointer rpm = CreateVehicleData("{\"rpm\":1}");
+  queue.push(rpm);
+  MessageSharedPointer speed = CreateVehicleData("{\"speed\":2}");
+  queue.push(speed);
+  ASSERT_EQ(2u, queue.size());
+
+  EXPECT_EQ(speed, queue.front());
+  queue.pop();
+  EXPECT_EQ(rpm, queue.front());
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+
+  // Popped notification is not replaced any more
+  queue.push(CreateVehicleData("{\"speed\":3}"));
+  queue.push(CreateVehicleData("{\"speed\":4}"));
+  EXPECT_EQ(1u, queue.size());
+}
+
+TEST(LanesQueueTest, Push_PeriodicLaneIsBounded) {
+  Queue queue;
+  for (size_t i = 0; i < Queue::kPeriodicLaneCapacity + 1; ++i) {
+    queue.push(CreateMessage(application_manager::kNotification,
+                             "RC.OnInteriorVehicleData"));
+  }
+  queue.push(CreateMessage(application_manager::kNotification,
+                           "UI.OnSystemContext"));
+  EXPECT_EQ(Queue::kPeriodicLaneCapacity + 1, queue.size());
+}
+
+TEST(LanesQueueTest, Swap) {
+  Queue queue;
+  queue.push(CreateVehicleData("{\"speed\":1}"));
+  Queue other;
+  queue.swap(other);
+  EXPECT_TRUE(queue.empty());
+  ASSERT_EQ(1u, other.size());
+  other.push(CreateVehicleData("{\"speed\":2}"));
+  EXPECT_EQ(1u, other.size());
+}
+
+TEST(LanesQueueTest, InterfaceOf_ByNameOrFunctionId) {
+  EXPECT_EQ("VR", InterfaceOf(*CreateMessage(application_manager::kRequest,
+                                             "VR.PerformInteraction")));
+  EXPECT_EQ("", InterfaceOf(*CreateMessage(application_manager::kRequest,
+                                           "NoInterface")));
+  MessageSharedPointer message = CreateMessage(application_manager::kRequest,
+                                               "");
+  message->set_function_id(hmi_apis::FunctionID::Navigation_ShowConstantTBT);
+  EXPECT_EQ("Navigation", InterfaceOf(*message));
+}
+
+}  // namespace hmi_message_handler_test
+}  // namespace components
+}  // namespace test
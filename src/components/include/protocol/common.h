@@ -200,6 +200,12 @@ enum {
  */
 const uint32_t MAXIMUM_FRAME_DATA_SIZE = 1500;
 
+/**
+ *\brief Constant: Maximum size of one frame including frame header
+ *\brief supported by protocol version 3 and higher (128KB payload)
+ */
+const uint32_t MAXIMUM_FRAME_DATA_SIZE_V3 = 131084;
+
 /**
  *\brief If FRAME_TYPE_CONSECUTIVE: Constant: Size of first frame in
  *\brief mutliframe message.
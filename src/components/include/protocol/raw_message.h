@@ -32,8 +32,14 @@
 #ifndef SRC_COMPONENTS_INCLUDE_PROTOCOL_RAW_MESSAGE_H_
 #define SRC_COMPONENTS_INCLUDE_PROTOCOL_RAW_MESSAGE_H_
 
+#include <vector>
 #include "utils/macro.h"
 #include "utils/shared_ptr.h"
+#include "utils/buffer_slice.h"
+#ifdef TIME_TESTER
+#include "utils/date_time.h"
+#include "utils/rpc_trace.h"
+#endif  // TIME_TESTER
 #include "protocol/service_type.h"
 #include "protocol/message_priority.h"
 
@@ -58,6 +64,31 @@ class RawMessage {
              const uint8_t *const data_param, uint32_t data_size,
              uint8_t type = ServiceType::kRpc,
              uint32_t payload_size = 0);
+  /**
+   * \brief Constructor referencing data without copying it
+   * \param connection_key Identifier of connection within which message
+   * is transferred
+   * \param protocolVersion Version of protocol of the message
+   * \param data Message bytes, may be a part of a larger shared buffer
+   * \param payload_size Received data size
+   */
+  RawMessage(uint32_t connection_key, uint32_t protocol_version,
+             const utils::BufferSlice& data,
+             uint8_t type = ServiceType::kRpc,
+             uint32_t payload_size = 0);
+  /**
+   * \brief Constructor of message gathered from two fragments,
+   * e.g. frame header and a part of shared payload, none of them is copied
+   * \param connection_key Identifier of connection within which message
+   * is transferred
+   * \param protocolVersion Version of protocol of the message
+   * \param header First fragment of message
+   * \param payload Second fragment of message
+   */
+  RawMessage(uint32_t connection_key, uint32_t protocol_version,
+             const utils::BufferSlice& header,
+             const utils::BufferSlice& payload,
+             uint8_t type = ServiceType::kRpc);
   /**
    * \brief Destructor
    */
@@ -73,8 +104,25 @@ class RawMessage {
   void set_connection_key(uint32_t);
   /**
    * \brief Getter for message string data
+   * Fragmented message is merged into single buffer on first call,
+   * so it should not be called concurrently with other accessors
    */
   uint8_t *data() const;
+  /**
+   * \brief Getter for shared storage of message data
+   * Merges fragmented message the same way as data()
+   */
+  const utils::BufferSlice& buffer() const;
+  /**
+   * \brief Count of fragments message data consists of, 1 or 2
+   */
+  size_t fragments_count() const;
+  /**
+   * \brief Getter for fragment of message data
+   * Fragments are to be sent one after another without merging
+   * \param index Fragment index below fragments_count()
+   */
+  const utils::BufferSlice& fragment(size_t index) const;
   /**
    * \brief Getter for message size
    */
@@ -101,17 +149,42 @@ class RawMessage {
    */
   bool IsWaiting() const;
   void set_waiting(bool v);
+#ifdef TIME_TESTER
+  /**
+   * \brief Time message was created, for received data it is
+   * time of reading from transport
+   */
+  const TimevalStruct& creation_time() const {
+    return creation_time_;
+  }
+  const utils::RpcTracePtr& trace() const {
+    return trace_;
+  }
+  void set_trace(const utils::RpcTracePtr& trace) {
+    trace_ = trace;
+  }
+#endif  // TIME_TESTER
 
  private:
+  void MergeFragments() const;
+
   uint32_t connection_key_;
-  uint8_t *data_;
+  // Whole message or its first fragment
+  mutable utils::BufferSlice data_;
+  // Second fragment, empty if message is not fragmented
+  mutable utils::BufferSlice tail_;
   size_t data_size_;
   uint32_t protocol_version_;
   ServiceType service_type_;
   size_t payload_size_;
   bool waiting_;
+#ifdef TIME_TESTER
+  TimevalStruct creation_time_;
+  utils::RpcTracePtr trace_;
+#endif  // TIME_TESTER
   DISALLOW_COPY_AND_ASSIGN(RawMessage);
 };
 typedef  utils::SharedPtr<RawMessage> RawMessagePtr;
+typedef std::vector<RawMessagePtr> RawMessageList;
 }  // namespace protocol_handler
 #endif  // SRC_COMPONENTS_INCLUDE_PROTOCOL_RAW_MESSAGE_H_
@@ -39,8 +39,11 @@
  * \class security_manager::CryptoManager
  * \brief Class factory, producing instances of \ref SSLContext
  *
- * \fn security_manager::SSLContext *security_manager::CryptoManager::CreateSSLContext()
+ * \fn security_manager::SSLContext *security_manager::CryptoManager::CreateSSLContext(const std::string &peer_id)
  * \brief Creates an instance of \ref SSLContext class
+ * \param peer_id identifies remote side, contexts with the same identifier
+ * resume previously negotiated session instead of doing full handshake.
+ * Empty identifier disables resumption.
  *
   * \fn void security_manager::CryptoManager::ReleaseSSLContext(security_manager::SSLContext *context)
  * \brief Frees \ref SSLContext instance
@@ -61,7 +64,7 @@ class CryptoManager {
                     const std::string &ciphers_list,
                     bool verify_peer) = 0;
   virtual void Finish() = 0;
-  virtual SSLContext *CreateSSLContext() = 0;
+  virtual SSLContext *CreateSSLContext(const std::string &peer_id) = 0;
   virtual void ReleaseSSLContext(SSLContext *context) = 0;
   virtual std::string LastError() const = 0;
   virtual ~CryptoManager() { }
@@ -36,6 +36,8 @@
 #include <cstddef>  // for size_t typedef
 #include <string>
 
+#include "utils/buffer_slice.h"
+
 // TODO(EZamakhov): update brief info
 /**
  * \class security_manager::SSLContext
@@ -55,6 +57,16 @@
  * \param in_data_size   [in]   size of data in \ref in_data buffer
  * \param out_data       [out]  response of SSL context if there is one. If not, equals NULL
  * \param out_data_size  [out]  length of response. On no response, equals 0
+ *
+ * Data returned by Encrypt and Decrypt stays valid till the next call of
+ * the same method, so encryption and decryption of one context may run
+ * on different threads.
+ *
+ * \fn security_manager::SSLContext::Encrypt(
+ *             const uint8_t* in_data, size_t in_data_size,
+ *             utils::BufferSlice* out_data)
+ * \brief Encrypts data into newly allocated storage taken over by caller,
+ * so encrypted payload is sent without copying it again
  */
 
 namespace security_manager {
@@ -73,6 +85,8 @@ class SSLContext {
                                           size_t *out_data_size) = 0;
   virtual bool Encrypt(const uint8_t *const in_data,    size_t in_data_size,
                        const uint8_t ** const out_data, size_t *out_data_size) = 0;
+  virtual bool Encrypt(const uint8_t *const in_data, size_t in_data_size,
+                       utils::BufferSlice *out_data) = 0;
   virtual bool Decrypt(const uint8_t *const in_data,    size_t in_data_size,
                        const uint8_t ** const out_data, size_t *out_data_size) = 0;
   virtual bool  IsInitCompleted() const = 0;
@@ -102,6 +102,12 @@ class DeviceInfo : public Info {
    */
   ConnectionType connection_type_;
 
+  /**
+   * @brief Maximum protocol frame size suitable for transport of device,
+   * 0 if transport has no preference.
+   */
+  size_t maximum_frame_size_;
+
  public:
   /**
    * @brief Constructor.
@@ -109,13 +115,17 @@ class DeviceInfo : public Info {
    * @param device_handle Handle of device.
    * @param mac_address MAC address of device.
    * @param name Name of device.
+   * @param connection_type Connection type used by device.
+   * @param maximum_frame_size Maximum frame size suitable for transport.
    */
   DeviceInfo(DeviceHandle device_handle, std::string mac_address,
-             std::string name, const ConnectionType& connection_type)
+             std::string name, const ConnectionType& connection_type,
+             size_t maximum_frame_size = 0)
     : Info(name),
       mac_address_(mac_address),
       device_handle_(device_handle),
-      connection_type_(connection_type) {
+      connection_type_(connection_type),
+      maximum_frame_size_(maximum_frame_size) {
   }
 
   /**
@@ -140,6 +150,13 @@ class DeviceInfo : public Info {
     return connection_type_;
   }
 
+  /**
+   * @brief Return maximum_frame_size_.
+   */
+  size_t maximum_frame_size() const {
+    return maximum_frame_size_;
+  }
+
   /**
    * @brief Overloaded operator "==".
    */
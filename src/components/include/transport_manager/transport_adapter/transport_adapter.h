@@ -100,6 +100,20 @@ class TransportAdapter {
    */
   virtual ConnectionType GetConnectionType() const = 0;
 
+  /**
+   * @brief Allows to obtain maximum size of protocol frame, including
+   * header, that fits transport the best.
+   * @return frame size or 0 if transport has no preference.
+   */
+  virtual size_t GetMaximumFrameSize() const = 0;
+
+  /**
+   * @brief Allows to obtain time connection of unexpectedly lost link
+   * is kept waiting for the same device to reconnect.
+   * @return time in seconds or 0 if connection is not kept.
+   */
+  virtual uint32_t GetReconnectGracePeriod() const = 0;
+
   /* TODO
    virtual Error LoadState(TransportAdapterState* state) = 0;
    virtual void SaveState(TransportAdapterState* state) = 0;
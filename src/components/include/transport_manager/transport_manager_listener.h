@@ -70,6 +70,13 @@ class TransportManagerListener {
   virtual void OnDeviceAdded(const DeviceInfo& device_info) = 0;
   virtual void OnDeviceRemoved(const DeviceInfo& device_info) = 0;
 
+  /**
+   * @brief Reaction to the event, when known device is renamed.
+   *
+   * @param device_info Variable that hold updated information about device.
+   */
+  virtual void OnDeviceChanged(const DeviceInfo& device_info) = 0;
+
   /**
    * @brief Reaction to the event, when scanning of devices is finished.
    */
@@ -91,6 +98,17 @@ class TransportManagerListener {
   virtual void OnConnectionEstablished(const DeviceInfo& device_info,
                                        const ConnectionUID& connection_id) = 0;
 
+  /**
+   * @brief Reaction to the event, when connection which link was lost
+   * is bound to the new link of the same device within grace period.
+   * Connection keeps its identifier, so sessions on it stay valid.
+   *
+   * @param devcie_info Variable that hold information about device.
+   * @param connection_id connection unique identifier.
+   */
+  virtual void OnConnectionRestored(const DeviceInfo& device_info,
+                                    const ConnectionUID& connection_id) = 0;
+
   /**
    * @brief Reaction to the event, when connection to the device is failed.
    *
@@ -147,6 +165,14 @@ class TransportManagerListener {
    **/
   virtual void OnTMMessageReceived(const ::protocol_handler::RawMessagePtr message) = 0;
 
+  /**
+   * @brief Notifies about bunch of messages received from TM at once.
+   *
+   * @param messages Received messages in order of receiving
+   **/
+  virtual void OnTMMessagesReceived(
+      const ::protocol_handler::RawMessageList& messages) = 0;
+
   /**
    * @brief Reaction to the event, when receiving of massage for transport manager is failed.
    *
@@ -72,6 +72,8 @@ class TransportManagerListenerEmpty : public TransportManagerListener {
   }
   virtual void OnDeviceRemoved(const DeviceInfo& device_info) {
   }
+  virtual void OnDeviceChanged(const DeviceInfo& device_info) {
+  }
 
   /**
    * @brief Reaction to the event, when scanning of devices is finished.
@@ -97,6 +99,16 @@ class TransportManagerListenerEmpty : public TransportManagerListener {
                                        const ConnectionUID& connection_id) {
   }
 
+  /**
+   * @brief Reaction to the event, when connection is restored.
+   *
+   * @param devcie_info Variable that hold information about device.
+   * @param connection_id connection unique identifier.
+   */
+  virtual void OnConnectionRestored(const DeviceInfo& device_info,
+                                    const ConnectionUID& connection_id) {
+  }
+
   /**
    * @brief Reaction to the event, when connection to the device is failed.
    *
@@ -158,6 +170,20 @@ class TransportManagerListenerEmpty : public TransportManagerListener {
   virtual void OnTMMessageReceived(const ::protocol_handler::RawMessagePtr message) {
   }
 
+  /**
+   * @brief Reaction to the event, when transport manager received
+   * bunch of massages. Every message is passed to OnTMMessageReceived.
+   *
+   * @param messages Raw massages in order of receiving.
+   */
+  virtual void OnTMMessagesReceived(
+      const ::protocol_handler::RawMessageList& messages) {
+    for (::protocol_handler::RawMessageList::const_iterator it =
+         messages.begin(); it != messages.end(); ++it) {
+      OnTMMessageReceived(*it);
+    }
+  }
+
   /**
    * @brief Reaction to the event, when receiving of massage for transport manager is failed.
    *
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_ARENA_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_ARENA_H_
+
+#include <stddef.h>
+#include <new>
+#include <string>
+
+#include "utils/macro.h"
+
+namespace utils {
+
+/*
+ * Region allocator: memory is bump-allocated from chunks and is given back
+ * only all at once by Reset() or destruction. Suits short-lived
+ * intermediates of one message, which are all dropped together.
+ * Not thread safe, each thread uses its own arena.
+ */
+class Arena {
+ public:
+  static const size_t kDefaultChunkSize = 8 * 1024;
+  static const size_t kAlignment = 16;
+
+  explicit Arena(size_t chunk_size = kDefaultChunkSize);
+  ~Arena();
+
+  /*
+   * @brief Allocates size bytes aligned to kAlignment
+   * @return NULL if system is out of memory
+   */
+  void* Allocate(size_t size);
+
+  /*
+   * @brief Invalidates everything allocated so far. One chunk of default
+   * size is kept, so next message does not allocate from system again.
+   */
+  void Reset();
+
+  /*
+   * @brief Bytes handed out since last Reset()
+   */
+  size_t allocated_bytes() const {
+    return allocated_bytes_;
+  }
+
+  /*
+   * @brief Bytes taken from system and held now
+   */
+  size_t reserved_bytes() const {
+    return reserved_bytes_;
+  }
+
+ private:
+  struct Chunk {
+    Chunk* next;
+    size_t size;
+  };
+
+  Chunk* NewChunk(size_t size);
+  static char* ChunkData(Chunk* chunk);
+
+  const size_t chunk_size_;
+  Chunk* chunks_;
+  char* current_;
+  char* limit_;
+  size_t allocated_bytes_;
+  size_t reserved_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(Arena);
+};
+
+/*
+ * Gives the calling thread's arena for a message handling scope.
+ * Nested scopes share the arena, the outermost one resets it on exit, so
+ * everything allocated while the message was handled is freed in one step.
+ * Data outliving the scope must be promoted out of arena by copying it
+ * into regular storage, e.g. ArenaString into std::string.
+ */
+class ScopedMessageArena {
+ public:
+  ScopedMessageArena();
+  ~ScopedMessageArena();
+
+  /*
+   * @brief Arena of the innermost scope open on calling thread
+   * @return NULL outside of any scope
+   */
+  static Arena* Current();
+
+ private:
+  struct State;
+
+  static State* ThisThreadState(bool create);
+  static void CreateStateKey();
+  // Called on thread exit
+  static void DestroyState(void* data);
+
+  State* state_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedMessageArena);
+};
+
+/*
+ * STL allocator taking memory from the arena current at its construction
+ * and from the heap outside of message scope. Deallocation within arena is
+ * a no-op. Container using it must not outlive the scope it was made in.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind {
+    typedef ArenaAllocator<U> other;
+  };
+
+  ArenaAllocator()
+    : arena_(ScopedMessageArena::Current()) {
+  }
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)
+    : arena_(other.arena()) {
+  }
+
+  pointer address(reference value) const {
+    return &value;
+  }
+
+  const_pointer address(const_reference value) const {
+    return &value;
+  }
+
+  pointer allocate(size_type count, const void* = 0) {
+    if (count > max_size()) {
+      throw std::bad_alloc();
+    }
+    const size_t size = count * sizeof(T);
+    void* memory = arena_ ? arena_->Allocate(size) : ::operator new(size);
+    if (!memory) {
+      throw std::bad_alloc();
+    }
+    return static_cast<pointer>(memory);
+  }
+
+  void deallocate(pointer memory, size_type) {
+    if (!arena_) {
+      ::operator delete(memory);
+    }
+  }
+
+  size_type max_size() const {
+    return static_cast<size_type>(-1) / sizeof(T);
+  }
+
+  void construct(pointer memory, const T& value) {
+    new (memory) T(value);
+  }
+
+  void destroy(pointer memory) {
+    memory->~T();
+  }
+
+  Arena* arena() const {
+    return arena_;
+  }
+
+ private:
+  Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right) {
+  return left.arena() == right.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right) {
+  return left.arena() != right.arena();
+}
+
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> >
+    ArenaString;
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_ARENA_H_
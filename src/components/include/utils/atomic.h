@@ -55,6 +55,15 @@
 #define atomic_post_dec(ptr) (*(ptr))--
 #endif
 
+#if defined(__QNXNTO__)
+#define atomic_post_sub(ptr, value) atomic_sub_value((ptr), (value))
+#elif defined(__GNUG__)
+#define atomic_post_sub(ptr, value) __sync_fetch_and_sub((ptr), (value))
+#else
+#warning "atomic_post_sub() implementation is not atomic"
+#define atomic_post_sub(ptr, value) (((*(ptr)) -= (value)) + (value))
+#endif
+
 #if defined(__QNXNTO__)
 // on QNX pointer assignment is believed to be atomic
 #define atomic_pointer_assign(dst, src) (dst) = (src)
@@ -66,6 +75,33 @@
 #define atomic_pointer_assign(dst, src) (dst) = (src)
 #endif
 
+// Acquire load and release store of a pointer: reads after the load see
+// everything written before the store which published the pointer
+#if defined(__GNUG__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+#define atomic_pointer_load_acquire(src) __atomic_load_n(&(src), __ATOMIC_ACQUIRE)
+#define atomic_pointer_store_release(dst, src) \
+  __atomic_store_n(&(dst), (src), __ATOMIC_RELEASE)
+#elif defined(__QNXNTO__) || defined(__GNUG__)
+// without C++11 memory model builtins a full barrier provides ordering
+#define atomic_pointer_load_acquire(src) \
+  (utils::atomic_detail::LoadAcquire(&(src)))
+#define atomic_pointer_store_release(dst, src) \
+  do { __sync_synchronize(); (dst) = (src); } while (0)
+namespace utils {
+namespace atomic_detail {
+template<typename T>
+inline T* LoadAcquire(T* const* src) {
+  T* const value = *const_cast<T* const volatile*>(src);
+  __sync_synchronize();
+  return value;
+}
+}  // namespace atomic_detail
+}  // namespace utils
+#else
+#error "atomic pointer acquire and release operations not defined"
+#endif
+
 #if defined(__QNXNTO__)
 #define atomic_post_set(dst) atomic_set_value(dst, 1)
 #elif defined(__GNUG__)
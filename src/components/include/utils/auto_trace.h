@@ -34,21 +34,37 @@
 #define SRC_COMPONENTS_INCLUDE_UTILS_AUTO_TRACE_H_
 
 #include <log4cxx/logger.h>
-#include <string>
 
 namespace logger {
 
+struct LogSite;
+
+/*
+ * Logs enter and exit of scope, constructed by LOG4CXX_AUTO_TRACE
+ * with NULL logger if trace is disabled
+ */
 class AutoTrace {
  public:
-  AutoTrace(
-    log4cxx::LoggerPtr logger,
-    const log4cxx::spi::LocationInfo& location
-  );
-  ~AutoTrace();
+  AutoTrace(const log4cxx::LoggerPtr* logger, const LogSite* site)
+    : logger_(logger),
+      site_(site) {
+    if (logger_) {
+      Log("Enter");
+    }
+  }
+
+  ~AutoTrace() {
+    if (logger_) {
+      // Location corresponds rather to creation of object than to deletion
+      Log("Exit");
+    }
+  }
 
  private:
-  log4cxx::LoggerPtr logger_;
-  log4cxx::spi::LocationInfo location_;
+  void Log(const char* message);
+
+  const log4cxx::LoggerPtr* logger_;
+  const LogSite* site_;
 };
 
 }  // namespace logger
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_BINARY_LOG_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_BINARY_LOG_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+#include <log4cxx/logger.h>
+
+#include "utils/binary_log_format.h"
+
+/*
+ * Binary log keeps enabled log statements out of string formatting.
+ * Statement puts its arguments in binary form into ring buffer owned
+ * by calling thread, no allocation or lock is taken on the way.
+ * Single writer thread drains rings and stores records to file,
+ * text is produced offline by binary_log_decoder tool.
+ * When ring of thread is full new records are dropped and counted.
+ */
+namespace logger {
+
+/*
+ * Static description of log statement, its address identifies
+ * statement instead of formatted location
+ */
+struct LogSite {
+  const char* file;
+  const char* function;
+  int line;
+};
+
+// Set while binary log writer is running
+extern volatile bool binary_log_started;
+
+/*
+ * Starts writer thread, afterwards enabled log statements go to file_name
+ * instead of log4cxx appenders.
+ * Returns false if file could not be opened.
+ */
+bool StartBinaryLog(const std::string& file_name);
+
+/*
+ * Stores records left in rings and stops writer thread
+ */
+void StopBinaryLog();
+
+namespace impl {
+
+template <bool Condition, typename T>
+struct EnableIf {
+};
+
+template <typename T>
+struct EnableIf<true, T> {
+  typedef T type;
+};
+
+/*
+ * Types stored in binary form, all others are formatted as text
+ */
+template <typename T>
+struct BinaryArg {
+  enum { kSupported = false };
+};
+
+#define SDL_BINARY_LOG_ARG(Type, Tag, Stored) \
+  template <> \
+  struct BinaryArg<Type> { \
+    enum { kSupported = true }; \
+    typedef Stored stored_type; \
+    static const uint8_t kTag = Tag; \
+  };
+
+SDL_BINARY_LOG_ARG(bool, kArgBool, uint8_t)
+SDL_BINARY_LOG_ARG(char, kArgChar, char)
+SDL_BINARY_LOG_ARG(signed char, kArgChar, char)
+SDL_BINARY_LOG_ARG(unsigned char, kArgChar, char)
+SDL_BINARY_LOG_ARG(short, kArgInt64, int64_t)
+SDL_BINARY_LOG_ARG(unsigned short, kArgUInt64, uint64_t)
+SDL_BINARY_LOG_ARG(int, kArgInt64, int64_t)
+SDL_BINARY_LOG_ARG(unsigned int, kArgUInt64, uint64_t)
+SDL_BINARY_LOG_ARG(long, kArgInt64, int64_t)
+SDL_BINARY_LOG_ARG(unsigned long, kArgUInt64, uint64_t)
+SDL_BINARY_LOG_ARG(long long, kArgInt64, int64_t)
+SDL_BINARY_LOG_ARG(unsigned long long, kArgUInt64, uint64_t)
+SDL_BINARY_LOG_ARG(float, kArgDouble, double)
+SDL_BINARY_LOG_ARG(double, kArgDouble, double)
+SDL_BINARY_LOG_ARG(long double, kArgDouble, double)
+
+#undef SDL_BINARY_LOG_ARG
+
+/*
+ * Strings are matched exactly, so classes converting to string
+ * keep using their own output operators
+ */
+template <typename T>
+struct StringArg {
+  enum { kSupported = false };
+};
+
+template <>
+struct StringArg<std::string> {
+  enum { kSupported = true };
+};
+
+/*
+ * Enumerations are formatted by std::ostream, so their own output
+ * operators found by argument dependent lookup are still used
+ */
+template <typename T>
+struct IsClass {
+  template <typename U> static char Test(int U::*);
+  template <typename U> static long Test(...);
+  enum { value = sizeof(Test<T>(0)) == sizeof(char) };
+};
+
+template <typename T, bool IsClassType = IsClass<T>::value>
+struct EnumArg {
+  static char Test(int);
+  static long Test(...);
+  static T& Make();
+  enum {
+    kSupported = !BinaryArg<T>::kSupported &&
+                 sizeof(Test(Make())) == sizeof(char)
+  };
+};
+
+template <typename T>
+struct EnumArg<T, true> {
+  enum { kSupported = false };
+};
+
+/*
+ * Classes without own output operator but with conversion to bool, like
+ * utils::SharedPtr, are printed by std::ostream as bool values
+ */
+template <typename T, bool IsClassType = IsClass<T>::value>
+struct BoolConvertibleArg {
+  enum { kSupported = false };
+};
+
+template <typename T>
+struct BoolConvertibleArg<T, true> {
+  static char TestBool(bool);
+  static long TestBool(...);
+  static char TestPointer(const volatile void*);
+  static long TestPointer(...);
+  static const T& Make();
+  enum {
+    kSupported = sizeof(TestBool(Make())) == sizeof(char) &&
+                 sizeof(TestPointer(Make())) != sizeof(char)
+  };
+};
+
+/*
+ * Pointers are printed as addresses except character ones,
+ * std::ostream prints those as strings
+ */
+template <typename T>
+struct PointerArg {
+  enum { kSupported = true };
+};
+
+template <>
+struct PointerArg<char> {
+  enum { kSupported = false };
+};
+
+template <>
+struct PointerArg<signed char> {
+  enum { kSupported = false };
+};
+
+template <>
+struct PointerArg<unsigned char> {
+  enum { kSupported = false };
+};
+
+/*
+ * Storage of record arguments. Being stream buffer it also takes text of
+ * values having no binary form, such text is stored as string argument.
+ */
+class BinaryRecordBuffer : public std::streambuf {
+ public:
+  static const size_t kMaxSize = 2048;
+
+  BinaryRecordBuffer();
+
+  const uint8_t* data() const {
+    return data_;
+  }
+  size_t size() const {
+    return size_;
+  }
+  bool truncated() const {
+    return truncated_;
+  }
+
+  template <typename T>
+  void AppendValue(uint8_t tag, T value) {
+    if (size_ + sizeof(tag) + sizeof(value) > kMaxSize) {
+      truncated_ = true;
+      return;
+    }
+    data_[size_] = tag;
+    memcpy(data_ + size_ + sizeof(tag), &value, sizeof(value));
+    size_ += sizeof(tag) + sizeof(value);
+    text_length_pos_ = 0;
+  }
+
+  /*
+   * Appends characters to last string argument or starts new one
+   */
+  void AppendText(const char* text, size_t length);
+
+ protected:
+  // std::streambuf
+  virtual int_type overflow(int_type c);
+  virtual std::streamsize xsputn(const char* s, std::streamsize count);
+
+ private:
+  uint8_t data_[kMaxSize];
+  size_t size_;
+  // Position of length of string argument being appended, 0 if none
+  size_t text_length_pos_;
+  bool truncated_;
+
+  // utils/macro.h includes this header through logger.h
+  BinaryRecordBuffer(const BinaryRecordBuffer&);
+  void operator=(const BinaryRecordBuffer&);
+};
+
+}  // namespace impl
+
+/*
+ * One log event being composed on stack of calling thread.
+ * Arithmetic values and strings are stored as is. Other types are not
+ * handled by record itself, so their std::ostream output operators are
+ * picked at place of statement and write text into record buffer.
+ * In result every statement written for std::stringstream works unchanged.
+ */
+class BinaryRecord : private impl::BinaryRecordBuffer, public std::ostream {
+ public:
+  BinaryRecord(const LogSite* site,
+               const log4cxx::LoggerPtr& logger,
+               const log4cxx::LevelPtr& level);
+
+  using impl::BinaryRecordBuffer::kMaxSize;
+
+  template <typename T>
+  typename impl::EnableIf<impl::BinaryArg<T>::kSupported, BinaryRecord&>::type
+  operator<<(const T& value) {
+    typedef typename impl::BinaryArg<T>::stored_type Stored;
+    AppendValue(impl::BinaryArg<T>::kTag, static_cast<Stored>(value));
+    return *this;
+  }
+
+  template <typename T>
+  typename impl::EnableIf<impl::StringArg<T>::kSupported, BinaryRecord&>::type
+  operator<<(const T& value) {
+    AppendText(value.data(), value.size());
+    return *this;
+  }
+
+  template <typename T>
+  typename impl::EnableIf<impl::EnumArg<T>::kSupported, BinaryRecord&>::type
+  operator<<(const T& value) {
+    static_cast<std::ostream&>(*this) << value;
+    return *this;
+  }
+
+  template <typename T>
+  typename impl::EnableIf<impl::BoolConvertibleArg<T>::kSupported,
+                          BinaryRecord&>::type
+  operator<<(const T& value) {
+    AppendValue(kArgBool, static_cast<uint8_t>(static_cast<bool>(value)));
+    return *this;
+  }
+
+  template <typename T>
+  typename impl::EnableIf<impl::PointerArg<T>::kSupported, BinaryRecord&>::type
+  operator<<(const T* value) {
+    static_cast<std::ostream&>(*this) << static_cast<const void*>(value);
+    return *this;
+  }
+
+  BinaryRecord& operator<<(const char* value) {
+    if (value) {
+      AppendText(value, strlen(value));
+    } else {
+      setstate(std::ios_base::badbit);
+    }
+    return *this;
+  }
+
+  /*
+   * Manipulators change formatting of the rest of statement,
+   * so following values are formatted by std::ostream as text
+   */
+  std::ostream& operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+    return manipulator(*this);
+  }
+  std::ostream& operator<<(std::ios& (*manipulator)(std::ios&)) {
+    manipulator(*this);
+    return *this;
+  }
+  std::ostream& operator<<(
+      std::ios_base& (*manipulator)(std::ios_base&)) {
+    manipulator(*this);
+    return *this;
+  }
+
+  /*
+   * Passes record to ring of calling thread,
+   * record is dropped if ring is full
+   */
+  void Commit();
+
+ private:
+  const LogSite* site_;
+  log4cxx::Logger* logger_;
+  int32_t level_;
+  uint64_t time_stamp_;
+
+  BinaryRecord(const BinaryRecord&);
+  void operator=(const BinaryRecord&);
+};
+
+}  // namespace logger
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_BINARY_LOG_H_
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_BINARY_LOG_FORMAT_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_BINARY_LOG_FORMAT_H_
+
+#include <stdint.h>
+
+/*
+ * Layout of files written by binary log (see utils/binary_log.h).
+ * Values are stored in byte order of the writer, header carries
+ * kBinaryLogByteOrder so reader may detect foreign files.
+ *
+ * File:   header, then sequence of records
+ * Header: magic[8], uint32 byte order, uint32 version
+ * Record: uint32 payload size, uint8 record type, payload
+ *
+ * Strings are stored as uint16 length followed by characters.
+ * Sites, loggers and threads are defined once before the first event
+ * referring to them, events carry their ids and arguments only.
+ */
+namespace logger {
+
+const char kBinaryLogMagic[8] = {'S', 'D', 'L', 'B', 'L', 'O', 'G', '1'};
+const uint32_t kBinaryLogByteOrder = 0x01020304;
+const uint32_t kBinaryLogVersion = 1;
+
+enum BinaryLogRecordType {
+  // uint32 id, uint32 line, string file, string function
+  kRecordSite = 1,
+  // uint32 id, string name
+  kRecordLogger = 2,
+  // uint32 id, string name
+  kRecordThread = 3,
+  // uint32 site id, uint32 logger id, uint32 thread id, int32 level,
+  // uint64 time stamp (microseconds), uint8 flags, arguments up to the end
+  kRecordEvent = 4,
+  // uint32 thread id, uint32 count of records lost while ring was full
+  kRecordDropped = 5
+};
+
+enum BinaryLogEventFlags {
+  // Event did not fit into record and was cut
+  kEventTruncated = 0x1
+};
+
+/*
+ * Tags of event arguments, every argument is tag followed by value.
+ * Arguments are formatted one after another same way as std::ostream does.
+ */
+enum BinaryLogArgType {
+  kArgInt64 = 1,     // int64
+  kArgUInt64 = 2,    // uint64
+  kArgDouble = 3,    // double
+  kArgChar = 4,      // char, printed as character
+  kArgBool = 5,      // uint8, printed as 0 or 1
+  kArgString = 6     // string
+};
+
+/*
+ * Returns log4cxx name of level stored in events
+ */
+inline const char* BinaryLogLevelName(int32_t level) {
+  // Values of log4cxx::Level
+  if (level >= 50000) return "FATAL";
+  if (level >= 40000) return "ERROR";
+  if (level >= 30000) return "WARN";
+  if (level >= 20000) return "INFO";
+  if (level >= 10000) return "DEBUG";
+  return "TRACE";
+}
+
+}  // namespace logger
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_BINARY_LOG_FORMAT_H_
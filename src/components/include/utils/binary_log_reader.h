@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_BINARY_LOG_READER_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_BINARY_LOG_READER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace logger {
+
+/*
+ * Event restored from binary log
+ */
+struct BinaryLogEvent {
+  std::string file;
+  std::string function;
+  uint32_t line;
+  std::string logger;
+  std::string thread;
+  int32_t level;
+  // Microseconds since epoch
+  uint64_t time_stamp;
+  std::string message;
+  bool truncated;
+  // Not zero for notification about records lost by thread
+  uint32_t dropped;
+};
+
+/*
+ * Reads files written by binary log, does not depend on log4cxx
+ * or other SDL headers, so it may be used by offline tools
+ */
+class BinaryLogReader {
+ public:
+  BinaryLogReader();
+  ~BinaryLogReader();
+
+  bool Open(const std::string& file_name);
+
+  /*
+   * Reads next event, returns false at the end of file or on error.
+   * Site, logger and thread definitions are consumed silently.
+   */
+  bool Next(BinaryLogEvent* event);
+
+  // Not empty if reading stopped because of broken or foreign file
+  const std::string& error() const {
+    return error_;
+  }
+
+ private:
+  struct Site {
+    std::string file;
+    std::string function;
+    uint32_t line;
+  };
+
+  bool ReadRecord(uint8_t* type);
+  bool ReadEvent(BinaryLogEvent* event);
+  bool FormatArguments(size_t offset, std::string* message);
+
+  template <typename T>
+  bool Get(size_t* offset, T* value) {
+    if (*offset + sizeof(T) > payload_.size()) {
+      return false;
+    }
+    memcpy(value, &payload_[*offset], sizeof(T));
+    *offset += sizeof(T);
+    return true;
+  }
+  bool GetString(size_t* offset, std::string* value);
+
+  FILE* file_;
+  std::vector<uint8_t> payload_;
+  std::map<uint32_t, Site> sites_;
+  std::map<uint32_t, std::string> loggers_;
+  std::map<uint32_t, std::string> threads_;
+  std::string error_;
+
+  BinaryLogReader(const BinaryLogReader&);
+  void operator=(const BinaryLogReader&);
+};
+
+}  // namespace logger
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_BINARY_LOG_READER_H_
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_BUFFER_POOL_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include "utils/macro.h"
+#include "utils/buffer_slice.h"
+#include "utils/shared_ptr.h"
+
+namespace utils {
+
+/*
+ * Cache of big byte buffers shared by threads, e.g. receive buffers of
+ * transport connections.
+ * Sizes are rounded up to powers of two starting from min_block_size, block
+ * is recycled as soon as the last slice of it is released, on whichever
+ * thread this happens, so steady stream needs no heap allocations of data.
+ * Cached memory is limited by max_cached_bytes, sizes greater than
+ * max_block_size are allocated on the heap right away.
+ * Blocks handed out stay valid after pool destruction.
+ */
+class BufferPool {
+ public:
+  BufferPool(size_t min_block_size, size_t max_block_size,
+             size_t max_cached_bytes);
+  ~BufferPool();
+
+  /*
+   * Slice of given size, empty if memory could not be allocated.
+   * Bytes are uninitialized.
+   */
+  BufferSlice Allocate(size_t size);
+
+  /*
+   * Total size of free blocks kept for reuse
+   */
+  size_t cached_bytes() const;
+
+ private:
+  class Blocks;
+
+  size_t BlockSize(size_t size) const;
+
+  const size_t min_block_size_;
+  const size_t max_block_size_;
+  SharedPtr<Blocks> blocks_;
+
+  DISALLOW_COPY_AND_ASSIGN(BufferPool);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_BUFFER_POOL_H_
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_BUFFER_SLICE_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_BUFFER_SLICE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <new>
+
+#include "utils/macro.h"
+#include "utils/shared_ptr.h"
+
+namespace utils {
+
+/*
+ * Region of reference counted byte storage.
+ * Copying slice or taking sub slice of it never copies bytes, so one receive
+ * buffer may back several messages, storage is freed with the last slice
+ * referencing it.
+ * Bytes are not guarded: writer must own the only slice of the storage
+ * or write before sharing it.
+ */
+class BufferSlice {
+ public:
+  /*
+   * Source of storage memory other than the heap.
+   * Memory is given back by Free() when the last slice of it is gone,
+   * which may happen on any thread.
+   */
+  class Allocator {
+   public:
+    virtual ~Allocator() {}
+    virtual void Free(uint8_t* data, size_t size) = 0;
+  };
+  typedef SharedPtr<Allocator> AllocatorPtr;
+
+  /*
+   * Empty slice
+   */
+  BufferSlice()
+    : offset_(0),
+      size_(0) {
+  }
+
+  /*
+   * Allocates new uninitialized storage of given size.
+   * Slice stays empty if memory could not be allocated.
+   */
+  explicit BufferSlice(size_t size)
+    : offset_(0),
+      size_(0) {
+    if (size > 0) {
+      StoragePtr storage = MakeShared<Storage>(size);
+      if (storage->data()) {
+        storage_ = storage;
+        size_ = size;
+      }
+    }
+  }
+
+  /*
+   * Allocates new storage and copies given bytes into it
+   */
+  BufferSlice(const uint8_t* data, size_t size)
+    : offset_(0),
+      size_(0) {
+    if (data && size > 0) {
+      BufferSlice copy(size);
+      if (!copy.empty()) {
+        memcpy(copy.data(), data, size);
+        *this = copy;
+      }
+    }
+  }
+
+  /*
+   * Takes over memory got from allocator, allocator is kept alive
+   * until memory is given back to it
+   */
+  BufferSlice(uint8_t* data, size_t size, const AllocatorPtr& allocator)
+    : offset_(0),
+      size_(0) {
+    if (data && size > 0) {
+      storage_ = MakeShared<Storage>(data, size, allocator);
+      size_ = size;
+    }
+  }
+
+  /*
+   * Slice of the same storage starting at offset from beginning of this slice.
+   * Requested region is clamped to bounds of this slice.
+   */
+  BufferSlice Slice(size_t offset, size_t size) const {
+    BufferSlice result;
+    if (offset < size_ && size > 0) {
+      result.storage_ = storage_;
+      result.offset_ = offset_ + offset;
+      result.size_ = size < size_ - offset ? size : size_ - offset;
+    }
+    return result;
+  }
+
+  /*
+   * Start of region, NULL for empty slice
+   */
+  uint8_t* data() const {
+    return size_ ? storage_->data() + offset_ : NULL;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return 0 == size_;
+  }
+
+ private:
+  class Storage {
+   public:
+    explicit Storage(size_t size)
+      : data_(new (std::nothrow) uint8_t[size]),
+        size_(size) {
+    }
+    Storage(uint8_t* data, size_t size, const AllocatorPtr& allocator)
+      : data_(data),
+        size_(size),
+        allocator_(allocator) {
+    }
+    ~Storage() {
+      if (allocator_) {
+        allocator_->Free(data_, size_);
+      } else {
+        delete[] data_;
+      }
+    }
+    uint8_t* data() const {
+      return data_;
+    }
+   private:
+    uint8_t* data_;
+    const size_t size_;
+    const AllocatorPtr allocator_;
+    DISALLOW_COPY_AND_ASSIGN(Storage);
+  };
+  typedef SharedPtr<Storage> StoragePtr;
+
+  StoragePtr storage_;
+  size_t offset_;
+  size_t size_;
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_BUFFER_SLICE_H_
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_COALESCING_QUEUE_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_COALESCING_QUEUE_H_
+
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include "utils/macro.h"
+
+namespace utils {
+
+/*
+ * Queue adaptor replacing pending message by newer one superseding it.
+ * Message class must be a shared pointer whose pointee is assignable and have
+ *   const std::string& CoalescingGroup() const, empty if never superseded,
+ *   const std::string& CoalescingKey() const.
+ * Only the latest pending message of a group is superseded by message with
+ * the same key, so order of messages within the group is kept. Superseded
+ * message object is overwritten with the content of new one.
+ * All api mimics usual std queue interface.
+ */
+template < class Q >
+class CoalescingQueue {
+ public:
+  typedef typename Q::value_type value_type;
+
+  void push(const value_type& message) {
+    const std::string& group = message.CoalescingGroup();
+    if (group.empty()) {
+      queue_.push(message);
+      return;
+    }
+    typename Pending::iterator it = pending_.find(group);
+    if (pending_.end() != it &&
+        it->second.CoalescingKey() == message.CoalescingKey()) {
+      *(it->second) = *message;
+      return;
+    }
+    if (pending_.end() != it) {
+      it->second = message;
+    } else {
+      pending_.insert(std::make_pair(group, message));
+    }
+    queue_.push(message);
+  }
+  size_t size() const {
+    return queue_.size();
+  }
+  bool empty() const {
+    return queue_.empty();
+  }
+  value_type front() {
+    return queue_.front();
+  }
+  void pop() {
+    const value_type message = queue_.front();
+    const std::string& group = message.CoalescingGroup();
+    if (!group.empty()) {
+      typename Pending::iterator it = pending_.find(group);
+      // Group may have newer pending message which has to stay
+      if (pending_.end() != it && it->second.get() == message.get()) {
+        pending_.erase(it);
+      }
+    }
+    queue_.pop();
+  }
+  void swap(CoalescingQueue& other) {
+    queue_.swap(other.queue_);
+    pending_.swap(other.pending_);
+  }
+
+ private:
+  // Latest pending message of every group
+  typedef std::map<std::string, value_type> Pending;
+
+  Q queue_;
+  Pending pending_;
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_COALESCING_QUEUE_H_
@@ -54,6 +54,15 @@ class DateTime {
 
   static TimevalStruct getCurrentTime();
 
+  // Time since unspecified start point which is not moved together with
+  // system time, e.g. by NTP or GPS. Resolution is about scheduler tick
+  // and reading it is cheapest, use it for timeouts
+  static TimevalStruct getMonotonicTime();
+
+  // Same time line as getMonotonicTime with full resolution,
+  // use it for time measurements and metrics
+  static TimevalStruct getPreciseMonotonicTime();
+
   // return SECONDS count
   static int64_t getSecs(const TimevalStruct& time);
 
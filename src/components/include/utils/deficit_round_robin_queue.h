@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_DEFICIT_ROUND_ROBIN_QUEUE_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_DEFICIT_ROUND_ROBIN_QUEUE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <queue>
+
+#include "utils/macro.h"
+
+namespace utils {
+
+/*
+ * Weights policy of DeficitRoundRobinQueue sharing output equally
+ */
+struct EqualFlowWeights {
+  template < typename M >
+  static uint32_t Weight(const M&) {
+    return 1;
+  }
+};
+
+/*
+ * Weights policy of DeficitRoundRobinQueue taking weight of flow from
+ * its latest message, zero weight is taken as one.
+ * Message class must have uint32_t Weight() const method implemented
+ */
+struct MessageFlowWeights {
+  template < typename M >
+  static uint32_t Weight(const M& message) {
+    return message.Weight();
+  }
+};
+
+/*
+ * Template queue class sharing its output fairly between flows of messages.
+ * Urgent messages are given out first in order of arrival.
+ * Other messages are grouped by flow and flows are served by deficit round
+ * robin: on its turn flow gets quantum of credit and gives out messages
+ * while their cost is covered by accumulated credit, so every flow gets
+ * the same share of the cost (e.g. bytes) regardless of message sizes.
+ * Messages of the same flow keep their order.
+ * Message class must have following methods implemented:
+ *   bool IsUrgent() const;
+ *   uint64_t FlowId() const;
+ *   size_t Cost() const;
+ * Weights policy W gives weight of flow, flow gets quantum multiplied
+ * by its weight on each turn.
+ */
+template < typename M, class W = EqualFlowWeights >
+class DeficitRoundRobinQueue {
+ public:
+  typedef M value_type;
+  static const size_t kDefaultQuantum = 1500;
+
+  explicit DeficitRoundRobinQueue(size_t quantum = kDefaultQuantum)
+    : quantum_(quantum),
+      head_credited_(false),
+      total_size_(0) {
+    DCHECK(quantum_ > 0);
+  }
+  // All api mimics usual std queue interface
+  void push(const value_type& message) {
+    ++total_size_;
+    if (message.IsUrgent()) {
+      urgent_.push(message);
+      return;
+    }
+    const uint64_t flow_id = message.FlowId();
+    Flow& flow = flows_[flow_id];
+    if (flow.messages.empty()) {
+      active_flows_.push_back(flow_id);
+    }
+    flow.weight = std::max<uint32_t>(W::Weight(message), 1u);
+    flow.messages.push(message);
+  }
+  size_t size() const {
+    return total_size_;
+  }
+  bool empty() const {
+    return 0 == total_size_;
+  }
+  value_type front() {
+    DCHECK(!empty());
+    if (!urgent_.empty()) {
+      return urgent_.front();
+    }
+    return ScheduledFlow().messages.front();
+  }
+  void pop() {
+    DCHECK(!empty());
+    --total_size_;
+    if (!urgent_.empty()) {
+      urgent_.pop();
+      return;
+    }
+    Flow& flow = ScheduledFlow();
+    flow.deficit -= flow.messages.front().Cost();
+    flow.messages.pop();
+    if (flow.messages.empty()) {
+      // Idle flow does not keep its credit
+      flows_.erase(active_flows_.front());
+      active_flows_.pop_front();
+      head_credited_ = false;
+    }
+  }
+  void swap(DeficitRoundRobinQueue& other) {
+    std::swap(quantum_, other.quantum_);
+    urgent_.swap(other.urgent_);
+    flows_.swap(other.flows_);
+    active_flows_.swap(other.active_flows_);
+    std::swap(head_credited_, other.head_credited_);
+    std::swap(total_size_, other.total_size_);
+  }
+
+ private:
+  struct Flow {
+    Flow()
+      : deficit(0),
+        weight(1) {
+    }
+    std::queue<value_type> messages;
+    size_t deficit;
+    uint32_t weight;
+  };
+  typedef std::map<uint64_t, Flow> FlowsMap;
+
+  /*
+   * Returns flow which head message is to be given out next,
+   * flows which credit does not cover their head message are moved
+   * to the end of the round
+   */
+  Flow& ScheduledFlow() {
+    DCHECK(!active_flows_.empty());
+    for (;;) {
+      const uint64_t flow_id = active_flows_.front();
+      Flow& flow = flows_[flow_id];
+      if (!head_credited_) {
+        flow.deficit += quantum_ * flow.weight;
+        head_credited_ = true;
+      }
+      if (flow.messages.front().Cost() <= flow.deficit) {
+        return flow;
+      }
+      active_flows_.pop_front();
+      active_flows_.push_back(flow_id);
+      head_credited_ = false;
+    }
+  }
+
+  size_t quantum_;
+  std::queue<value_type> urgent_;
+  FlowsMap flows_;
+  // Flows having messages in order of their turns
+  std::deque<uint64_t> active_flows_;
+  // Whether flow at the head of round already got its quantum
+  bool head_credited_;
+  size_t total_size_;
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_DEFICIT_ROUND_ROBIN_QUEUE_H_
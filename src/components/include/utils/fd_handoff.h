@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_FD_HANDOFF_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_FD_HANDOFF_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace threads {
+class Thread;
+}  // namespace threads
+
+namespace utils {
+
+/*
+ * Hands descriptors of running SDL over to its successor process, so
+ * restart (e.g. after update) does not close listening transports.
+ *
+ * Predecessor publishes its descriptors and serves local socket. When
+ * successor connects, descriptors are passed to it with SCM_RIGHTS and
+ * predecessor stops itself as on SIGTERM. Successor waits until
+ * predecessor has stopped and saved its state (last state, policy
+ * table), only then it loads the state and takes descriptors over.
+ */
+class FdHandoff {
+ public:
+  typedef std::map<std::string, int> Descriptors;
+
+  static FdHandoff* instance();
+
+  /*
+   * @brief Sends named descriptors over unix domain socket
+   * @param channel SOCK_SEQPACKET socket
+   */
+  static bool SendDescriptors(int channel, const Descriptors& descriptors);
+
+  /*
+   * @brief Receives descriptors sent by SendDescriptors
+   * @return false on error, descriptors received so far are kept
+   */
+  static bool ReceiveDescriptors(int channel, Descriptors* descriptors);
+
+  /*
+   * @brief Takes descriptors over from SDL serving path
+   * @param timeout_ms time to wait for predecessor to stop
+   * @return false if there is no predecessor, then SDL starts cold
+   */
+  bool TakeOver(const std::string& path, int32_t timeout_ms);
+
+  /*
+   * @brief Gives away descriptor inherited from predecessor
+   * @return -1 if there is no such descriptor
+   */
+  int TakeInherited(const std::string& name);
+
+  /*
+   * @brief Closes inherited descriptors nobody has taken
+   */
+  void CloseInherited();
+
+  /*
+   * @brief Adds descriptor to be handed over, it stays owned by caller
+   */
+  void Publish(const std::string& name, int fd);
+
+  /*
+   * @brief Removes descriptor before its owner closes it
+   */
+  void Withdraw(const std::string& name);
+
+  /*
+   * @brief Starts waiting for successor on path
+   */
+  bool StartServing(const std::string& path);
+
+  /*
+   * @brief Stops waiting for successor and releases the one taking over,
+   * to be called when state is saved
+   */
+  void Complete();
+
+  /*
+   * @brief True if published descriptors are shared with successor,
+   * then they must be closed without shutdown()
+   */
+  bool handed_over() const;
+
+  FdHandoff();
+  ~FdHandoff();
+
+ private:
+  class ServingDelegate;
+
+  static void CreateInstance();
+  void Serve();
+  void StopServing();
+
+  mutable sync_primitives::Lock lock_;
+  Descriptors published_;
+  Descriptors inherited_;
+  bool handed_over_;
+  std::string path_;
+  int listener_;
+  int successor_;
+  threads::Thread* thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(FdHandoff);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_FD_HANDOFF_H_
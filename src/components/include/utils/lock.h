@@ -51,6 +51,7 @@ typedef pthread_mutex_t PlatformMutex;
 #endif
 } // namespace impl
 
+struct LockStatistics;
 
 class SpinMutex {
  public:
@@ -108,9 +109,29 @@ class Lock {
   // @returns wether lock was captured.
   bool Try();
 
+  // Name lock is reported with by LockProfiler, must be given before
+  // the lock is shared between threads.
+  // Does nothing unless built with LOCK_PROFILING
+  void set_name(const char* name);
+
  private:
   impl::PlatformMutex mutex_;
 
+#ifdef LOCK_PROFILING
+  /**
+  * @brief Statistics entry of named lock, NULL if lock is not profiled
+  */
+  LockStatistics* statistics_;
+  uint64_t acquired_at_;
+  uint32_t hold_depth_;
+
+  void MarkHeld(bool contended, uint64_t wait_time);
+  void MarkReleased();
+#else
+  void MarkHeld(bool contended, uint64_t wait_time) {}
+  void MarkReleased() {}
+#endif
+
 #ifndef NDEBUG
   /**
   * @brief Basic debugging aid, a flag that signals wether this lock is currently taken
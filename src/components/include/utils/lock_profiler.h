@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_LOCK_PROFILER_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_LOCK_PROFILER_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace sync_primitives {
+
+/**
+ * @brief Contention statistics collected for all locks sharing one name.
+ * All times are in microseconds.
+ */
+struct LockStatistics {
+  LockStatistics();
+  explicit LockStatistics(const std::string& lock_name);
+  LockStatistics(const LockStatistics& other);
+  LockStatistics& operator=(const LockStatistics& other);
+
+  /**
+   * @brief Accounts successful acquisition
+   * @param contended lock was busy and caller had to block
+   * @param wait_time time spent waiting for the lock
+   */
+  void OnAcquired(bool contended, uint64_t wait_time);
+
+  /**
+   * @brief Accounts time lock was held by single owner
+   */
+  void OnReleased(uint64_t hold_time);
+
+  std::string name;
+  uint64_t acquisitions;
+  uint64_t contentions;
+  uint64_t total_wait_time;
+  uint64_t max_wait_time;
+  uint64_t total_hold_time;
+  uint64_t max_hold_time;
+
+ private:
+  mutable SpinMutex spin_;
+};
+
+/**
+ * @brief Registry of named locks statistics.
+ *
+ * Locks are reported only when built with LOCK_PROFILING and named with
+ * Lock::set_name()/RWLock::set_name(); unnamed locks are not instrumented
+ * at all. Statistics live until process exit, so any lock may keep
+ * a pointer to its entry during static destruction.
+ */
+class LockProfiler {
+ public:
+  static LockProfiler* instance();
+
+  /**
+   * @brief Returns statistics entry for a name, creating it on first call.
+   * Locks registered with the same name are accounted together.
+   */
+  LockStatistics* Register(const std::string& name);
+
+  /**
+   * @brief Copies current statistics of all registered names
+   */
+  void Snapshot(std::vector<LockStatistics>* statistics) const;
+
+  /**
+   * @brief Monotonic time used for wait and hold measurements
+   */
+  static uint64_t CurrentTimeUsec();
+
+ private:
+  LockProfiler();
+  static void CreateInstance();
+
+  typedef std::map<std::string, LockStatistics*> StatisticsMap;
+  StatisticsMap statistics_;
+  mutable Lock statistics_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(LockProfiler);
+};
+
+}  // namespace sync_primitives
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_LOCK_PROFILER_H_
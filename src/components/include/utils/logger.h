@@ -43,9 +43,25 @@
   #include <log4cxx/spi/loggingevent.h>
   #include "utils/push_log.h"
   #include "utils/logger_status.h"
+  #include "utils/logger_level_cache.h"
   #include "utils/auto_trace.h"
+  #include "utils/binary_log.h"
 #endif  // ENABLE_LOG
 
+// Log statements below LOG_MIN_LEVEL are removed at compile time,
+// e.g. -DLOG_MIN_LEVEL=LOG_LEVEL_WARN leaves no trace of TRACE, DEBUG
+// and INFO statements in release builds
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_FATAL 5
+
+#ifndef LOG_MIN_LEVEL
+  #define LOG_MIN_LEVEL LOG_LEVEL_TRACE
+#endif
+
 #ifdef ENABLE_LOG
 
     #define CREATE_LOGGERPTR_GLOBAL(logger_var, logger_name) \
@@ -57,33 +73,67 @@
       log4cxx::LoggerPtr logger_var = log4cxx::LoggerPtr(log4cxx::Logger::getLogger(logger_name));
 
     #define INIT_LOGGER(file_name) \
-      log4cxx::PropertyConfigurator::configure(file_name);
+      log4cxx::PropertyConfigurator::configure(file_name); \
+      logger::LevelsChanged();
+
+    // Redirects enabled log statements to binary log file,
+    // could be decoded by binary_log_decoder tool
+    #define INIT_BINARY_LOGGER(file_name) \
+      logger::StartBinaryLog(file_name)
 
     // Logger deinitilization function and macro, need to stop log4cxx writing
     // without this deinitilization log4cxx threads continue using some instances destroyed by exit()
     void deinit_logger ();
     #define DEINIT_LOGGER() deinit_logger()
 
-    #define LOG4CXX_IS_TRACE_ENABLED(logger) logger->isTraceEnabled()
+    #if LOG_MIN_LEVEL <= LOG_LEVEL_TRACE
+      #define LOG4CXX_IS_TRACE_ENABLED(logger) logger->isTraceEnabled()
+    #else
+      #define LOG4CXX_IS_TRACE_ENABLED(logger) false
+    #endif
 
     log4cxx_time_t time_now();
 
     #define LOG_WITH_LEVEL(loggerPtr, logLevel, logEvent) \
     do { \
-      if (logger::logs_enabled()) { \
-        if (logger::logger_status != logger::DeletingLoggerThread) { \
-          if (loggerPtr->isEnabledFor(logLevel)) { \
-            std::stringstream accumulator; \
-            accumulator << logEvent; \
-            logger::push_log(loggerPtr, logLevel, accumulator.str(), time_now(), \
-                   LOG4CXX_LOCATION, ::log4cxx::spi::LoggingEvent::getCurrentThreadName()); \
+      static logger::LevelCache log_level_cache; \
+      if (LOG4CXX_CACHED_IS_ENABLED(log_level_cache, loggerPtr, logLevel)) { \
+        if (logger::logs_enabled()) { \
+          if (logger::logger_status != logger::DeletingLoggerThread) { \
+            if (logger::binary_log_started) { \
+              static const logger::LogSite log_site = \
+                  {__FILE__, __LOG4CXX_FUNC__, __LINE__}; \
+              logger::BinaryRecord binary_record(&log_site, loggerPtr, logLevel); \
+              binary_record << logEvent; \
+              binary_record.Commit(); \
+            } else { \
+              std::stringstream accumulator; \
+              accumulator << logEvent; \
+              logger::push_log(loggerPtr, logLevel, accumulator.str(), time_now(), \
+                     LOG4CXX_LOCATION, ::log4cxx::spi::LoggingEvent::getCurrentThreadName()); \
+            } \
           } \
         } \
       } \
     } while (false)
 
+    // Statement below LOG_MIN_LEVEL is kept in dead branch, so it is still
+    // compiled and its variables are used, but no code is generated
+    #define LOG_COMPILED_OUT(loggerPtr, logEvent) \
+    do { \
+      if (false) { \
+        static_cast<void>(loggerPtr); \
+        std::stringstream accumulator; \
+        accumulator << logEvent; \
+      } \
+    } while (false)
+
     #undef LOG4CXX_INFO
-    #define LOG4CXX_INFO(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getInfo(), logEvent)
+    #if LOG_MIN_LEVEL <= LOG_LEVEL_INFO
+      #define LOG4CXX_INFO(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getInfo(), logEvent)
+    #else
+      #define LOG4CXX_INFO(loggerPtr, logEvent) LOG_COMPILED_OUT(loggerPtr, logEvent)
+    #endif
 
     #define LOG4CXX_INFO_EXT(logger, logEvent) LOG4CXX_INFO(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
     #define LOG4CXX_INFO_STR_EXT(logger, logEvent) LOG4CXX_INFO_STR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
@@ -92,19 +142,31 @@
     #define LOG4CXX_TRACE_STR_EXT(logger, logEvent) LOG4CXX_TRACE_STR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
 
     #undef LOG4CXX_DEBUG
-    #define LOG4CXX_DEBUG(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getDebug(), logEvent)
+    #if LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
+      #define LOG4CXX_DEBUG(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getDebug(), logEvent)
+    #else
+      #define LOG4CXX_DEBUG(loggerPtr, logEvent) LOG_COMPILED_OUT(loggerPtr, logEvent)
+    #endif
 
     #define LOG4CXX_DEBUG_EXT(logger, logEvent) LOG4CXX_DEBUG(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
     #define LOG4CXX_DEBUG_STR_EXT(logger, logEvent) LOG4CXX_DEBUG_STR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
 
     #undef LOG4CXX_WARN
-    #define LOG4CXX_WARN(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getWarn(), logEvent)
+    #if LOG_MIN_LEVEL <= LOG_LEVEL_WARN
+      #define LOG4CXX_WARN(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getWarn(), logEvent)
+    #else
+      #define LOG4CXX_WARN(loggerPtr, logEvent) LOG_COMPILED_OUT(loggerPtr, logEvent)
+    #endif
 
     #define LOG4CXX_WARN_EXT(logger, logEvent) LOG4CXX_WARN(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
     #define LOG4CXX_WARN_STR_EXT(logger, logEvent) LOG4CXX_WARN_STR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
 
     #undef LOG4CXX_ERROR
-    #define LOG4CXX_ERROR(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getError(), logEvent)
+    #if LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+      #define LOG4CXX_ERROR(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getError(), logEvent)
+    #else
+      #define LOG4CXX_ERROR(loggerPtr, logEvent) LOG_COMPILED_OUT(loggerPtr, logEvent)
+    #endif
 
     #define LOG4CXX_ERROR_EXT(logger, logEvent) LOG4CXX_ERROR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
     #define LOG4CXX_ERROR_STR_EXT(logger, logEvent) LOG4CXX_ERROR_STR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
@@ -116,9 +178,25 @@
     #define LOG4CXX_FATAL_STR_EXT(logger, logEvent) LOG4CXX_FATAL_STR(logger, __PRETTY_FUNCTION__ << ": " << logEvent)
 
     #undef LOG4CXX_TRACE
-    #define LOG4CXX_TRACE(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getTrace(), logEvent)
-
-    #define LOG4CXX_AUTO_TRACE_WITH_NAME_SPECIFIED(loggerPtr, auto_trace) logger::AutoTrace auto_trace(loggerPtr, LOG4CXX_LOCATION)
+    #if LOG_MIN_LEVEL <= LOG_LEVEL_TRACE
+      #define LOG4CXX_TRACE(loggerPtr, logEvent) LOG_WITH_LEVEL(loggerPtr, ::log4cxx::Level::getTrace(), logEvent)
+
+      // AutoTrace gets NULL logger when trace is disabled, so disabled trace
+      // costs one cached check and no logger copy or location capture
+      #define LOG4CXX_AUTO_TRACE_WITH_NAME_SPECIFIED(loggerPtr, auto_trace) \
+        static const logger::LogSite auto_trace##_site = \
+            {__FILE__, __LOG4CXX_FUNC__, __LINE__}; \
+        static logger::LevelCache auto_trace##_level_cache; \
+        logger::AutoTrace auto_trace( \
+            LOG4CXX_CACHED_IS_ENABLED(auto_trace##_level_cache, loggerPtr, \
+                                      ::log4cxx::Level::getTrace()) \
+                ? &(loggerPtr) : NULL, \
+            &auto_trace##_site)
+    #else
+      #define LOG4CXX_TRACE(loggerPtr, logEvent) LOG_COMPILED_OUT(loggerPtr, logEvent)
+      #define LOG4CXX_AUTO_TRACE_WITH_NAME_SPECIFIED(loggerPtr, auto_trace) \
+        static_cast<void>(loggerPtr)
+    #endif
     #define LOG4CXX_AUTO_TRACE(loggerPtr) LOG4CXX_AUTO_TRACE_WITH_NAME_SPECIFIED(loggerPtr, SDL_local_auto_trace_object)
 
     #define LOG4CXX_ERROR_WITH_ERRNO(logger, message) \
@@ -135,6 +213,8 @@
 
     #define INIT_LOGGER(file_name)
 
+    #define INIT_BINARY_LOGGER(file_name) false
+
     #define DEINIT_LOGGER(file_name)
 
     #define LOG4CXX_IS_TRACE_ENABLED(logger) false
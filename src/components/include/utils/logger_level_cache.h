@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_LOGGER_LEVEL_CACHE_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_LOGGER_LEVEL_CACHE_H_
+
+#include <stdint.h>
+
+#include <log4cxx/logger.h>
+
+namespace logger {
+
+// Changed every time levels of loggers may have been changed,
+// starts from 1 so zero initialized caches are never valid
+extern volatile uint32_t levels_generation;
+
+/*
+ * Drops all cached level checks, has to be called after logger
+ * configuration or levels are changed in runtime
+ */
+void LevelsChanged();
+
+/*
+ * Result of Logger::isEnabledFor() remembered by single log statement.
+ * Instances are static and zero initialized, so no guard is involved;
+ * while configuration is unchanged the check is a couple of compares
+ * instead of walk over logger hierarchy.
+ * Cache also remembers logger it was filled for, in case statement
+ * is reached with different loggers.
+ * Races of concurrent updates are benign, all of them store same result.
+ */
+struct LevelCache {
+  const log4cxx::Logger* logger;
+  // Generation shifted left by one, lowest bit is the cached result
+  volatile uint32_t state;
+
+  bool IsValidFor(const log4cxx::Logger* checked_logger) const {
+    return checked_logger == logger && (state >> 1) == levels_generation;
+  }
+
+  bool enabled() const {
+    return state & 1;
+  }
+
+  bool Update(const log4cxx::LoggerPtr& checked_logger,
+              const log4cxx::LevelPtr& level) {
+    const uint32_t generation = levels_generation;
+    const bool is_enabled = checked_logger->isEnabledFor(level);
+    logger = &*checked_logger;
+    state = (generation << 1) | (is_enabled ? 1 : 0);
+    return is_enabled;
+  }
+};
+
+}  // namespace logger
+
+// Level is evaluated only when cache is refreshed
+#define LOG4CXX_CACHED_IS_ENABLED(cache, loggerPtr, logLevel) \
+  ((cache).IsValidFor(&*(loggerPtr)) ? (cache).enabled() \
+                                     : (cache).Update((loggerPtr), (logLevel)))
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_LOGGER_LEVEL_CACHE_H_
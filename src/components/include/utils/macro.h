@@ -123,6 +123,12 @@
 #define FINAL
 #endif
 
+// Allows to declare move constructor and move assignment if compiler supports
+// rvalue references, otherwise values are transferred with swap()
+#if __cplusplus >= 201103L
+#define SUPPORT_MOVE_SEMANTICS
+#endif
+
 /*
 * @brief Calculate size of na array
 * @param arr  array, which size need to calculate
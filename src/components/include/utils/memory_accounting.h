@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_MEMORY_ACCOUNTING_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_MEMORY_ACCOUNTING_H_
+
+#include <stdint.h>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace utils {
+
+/*
+ * Bytes held on behalf of applications, accounted by connection key
+ * and by category, with process totals on top.
+ * Quota limits sum of all categories of one application. Components
+ * taking memory an application asked for, e.g. to reassemble its message
+ * or to keep its commands, check the quota and refuse the request
+ * when it would be exceeded.
+ */
+class MemoryAccounting {
+ public:
+  enum Category {
+    // Commands, submenus and choice sets kept in application data
+    kAppState = 0,
+    // Multi-frame messages being reassembled by protocol handler
+    kMultiFrame,
+    // Messages from mobile waiting for application manager
+    kQueuedMessages,
+    kCategoriesCount
+  };
+
+  struct Usage {
+    Usage();
+    uint64_t Total() const;
+
+    uint64_t bytes[kCategoriesCount];
+  };
+
+  typedef std::vector<std::pair<uint32_t, Usage> > Snapshot;
+
+  static MemoryAccounting* instance();
+
+  static const char* CategoryName(Category category);
+
+  /*
+   * Own instances are used by tests, SDL accounts in instance()
+   */
+  MemoryAccounting();
+
+  /*
+   * @brief Sets limit of bytes held for one application, 0 disables it
+   */
+  void set_app_quota(uint64_t bytes);
+  uint64_t app_quota() const;
+
+  /*
+   * @brief Accounts bytes if application stays within its quota
+   * @return false if bytes are not accounted since quota would be exceeded
+   */
+  bool TryCharge(uint32_t key, Category category, uint64_t bytes);
+
+  /*
+   * @brief Accounts bytes regardless of quota, for memory which can not
+   * be refused but still has to be seen
+   */
+  void Charge(uint32_t key, Category category, uint64_t bytes);
+
+  /*
+   * @brief Returns bytes accounted before, account of application
+   * is forgotten once nothing is held for it
+   */
+  void Release(uint32_t key, Category category, uint64_t bytes);
+
+  /*
+   * @brief Checks if bytes can be taken for application within its quota
+   */
+  bool HasRoom(uint32_t key, uint64_t bytes) const;
+
+  Usage AppUsage(uint32_t key) const;
+  Usage TotalUsage() const;
+
+  /*
+   * @brief Copies usage of every application holding memory
+   */
+  void TakeSnapshot(Snapshot* snapshot) const;
+
+ private:
+  static void CreateInstance();
+  bool FitsQuota(const Usage& usage, uint64_t bytes) const;
+
+  typedef std::map<uint32_t, Usage> Accounts;
+  Accounts accounts_;
+  Usage total_;
+  uint64_t app_quota_;
+  mutable sync_primitives::Lock accounts_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryAccounting);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_MEMORY_ACCOUNTING_H_
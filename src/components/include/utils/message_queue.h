@@ -39,6 +39,9 @@
 #include "utils/lock.h"
 #include "utils/logger.h"
 #include "utils/prioritized_queue.h"
+#include "utils/ring_buffer_queue.h"
+#include "utils/atomic.h"
+#include "utils/memory_barrier.h"
 
 /**
  * \class MessageQueue
@@ -83,12 +86,27 @@ template<typename T, class Q = std::queue<T> > class MessageQueue {
      */
     void push(const T& element);
 
+    /**
+     * \brief Adds elements of the range to the queue taking the lock
+     * and waking consumer only once.
+     */
+    template <class InputIterator>
+    void push(InputIterator first, InputIterator last);
+
     /**
      * \brief Removes element from the queue and returns it.
      * \return To element of the queue.
      */
     T pop();
 
+    /**
+     * \brief Moves all elements of the queue to the output queue
+     * taking the lock only once. Previous content of output is discarded.
+     * \param output Queue that receives all pending elements.
+     * \return Number of elements moved.
+     */
+    size_t PopAll(Queue& output);
+
     /**
      * \brief Conditional wait.
      */
@@ -164,7 +182,29 @@ template<typename T, class Q> void MessageQueue<T, Q>::push(const T& element) {
     }
     queue_.push(element);
   }
-  queue_new_items_.Broadcast();
+  // Every pushed element can be consumed by a single waiter only
+  queue_new_items_.NotifyOne();
+}
+
+template<typename T, class Q>
+template <class InputIterator>
+void MessageQueue<T, Q>::push(InputIterator first, InputIterator last) {
+  if (first == last) {
+    return;
+  }
+  {
+    sync_primitives::AutoLock auto_lock(queue_lock_);
+    if (shutting_down_) {
+      CREATE_LOGGERPTR_LOCAL(logger_, "Utils")
+      LOG4CXX_ERROR(logger_, "Runtime error, pushing into queue"
+                           " that is being shut down");
+    }
+    for (; first != last; ++first) {
+      queue_.push(*first);
+    }
+  }
+  // Consumer drains the whole queue at once, so one waiter is enough
+  queue_new_items_.NotifyOne();
 }
 
 template<typename T, class Q> T MessageQueue<T, Q>::pop() {
@@ -179,6 +219,17 @@ template<typename T, class Q> T MessageQueue<T, Q>::pop() {
   return result;
 }
 
+template<typename T, class Q> size_t MessageQueue<T, Q>::PopAll(
+    Queue& output) {
+  if (!output.empty()) {
+    Queue empty_queue;
+    output.swap(empty_queue);
+  }
+  sync_primitives::AutoLock auto_lock(queue_lock_);
+  queue_.swap(output);
+  return output.size();
+}
+
 template<typename T, class Q> void MessageQueue<T, Q>::Shutdown() {
   sync_primitives::AutoLock auto_lock(queue_lock_);
   shutting_down_ = true;
@@ -194,6 +245,136 @@ template<typename T, class Q> void MessageQueue<T, Q>::Reset() {
   }
 }
 
+/**
+ * \brief Specialization for lock-free ring buffer.
+ * Producers never take the lock unless consumer is parked waiting for
+ * new elements. Consumer must be the single thread.
+ * Elements are handed out to consumer in usual std::queue.
+ */
+template<typename T, size_t Size>
+class MessageQueue<T, RingBufferQueue<T, Size> > {
+  public:
+    typedef std::queue<T> Queue;
+
+    MessageQueue()
+        : shutting_down_(false),
+          waiters_count_(0) {
+    }
+
+    ~MessageQueue() {
+      if (!ring_.empty()) {
+        CREATE_LOGGERPTR_LOCAL(logger_, "Utils")
+        LOG4CXX_ERROR(logger_, "Destruction of non-drained queue");
+      }
+    }
+
+    size_t size() const {
+      return ring_.size();
+    }
+
+    bool empty() const {
+      return ring_.empty();
+    }
+
+    bool IsShuttingDown() const {
+      return shutting_down_;
+    }
+
+    void push(const T& element) {
+      if (shutting_down_) {
+        CREATE_LOGGERPTR_LOCAL(logger_, "Utils")
+        LOG4CXX_ERROR(logger_, "Runtime error, pushing into queue"
+                             " that is being shut down");
+      }
+      ring_.push(element);
+      // Pairs with barrier in wait(): either consumer sees new element
+      // or producer sees parked consumer
+      memory_barrier();
+      if (waiters_count_ > 0) {
+        sync_primitives::AutoLock auto_lock(queue_lock_);
+        queue_new_items_.NotifyOne();
+      }
+    }
+
+    template <class InputIterator>
+    void push(InputIterator first, InputIterator last) {
+      if (first == last) {
+        return;
+      }
+      if (shutting_down_) {
+        CREATE_LOGGERPTR_LOCAL(logger_, "Utils")
+        LOG4CXX_ERROR(logger_, "Runtime error, pushing into queue"
+                             " that is being shut down");
+      }
+      for (; first != last; ++first) {
+        ring_.push(*first);
+      }
+      memory_barrier();
+      if (waiters_count_ > 0) {
+        sync_primitives::AutoLock auto_lock(queue_lock_);
+        queue_new_items_.NotifyOne();
+      }
+    }
+
+    T pop() {
+      T result = T();
+      if (!ring_.TryPop(result)) {
+        CREATE_LOGGERPTR_LOCAL(logger_, "Utils")
+        LOG4CXX_ERROR(logger_, "Runtime error, popping out of empty queue");
+        NOTREACHED();
+      }
+      return result;
+    }
+
+    size_t PopAll(Queue& output) {
+      if (!output.empty()) {
+        Queue empty_queue;
+        output.swap(empty_queue);
+      }
+      T element = T();
+      while (ring_.TryPop(element)) {
+        output.push(element);
+      }
+      return output.size();
+    }
+
+    void wait() {
+      if (!ring_.empty() || shutting_down_) {
+        return;
+      }
+      sync_primitives::AutoLock auto_lock(queue_lock_);
+      atomic_post_inc(&waiters_count_);
+      memory_barrier();
+      while ((!shutting_down_) && ring_.empty()) {
+        queue_new_items_.Wait(auto_lock);
+      }
+      atomic_post_dec(&waiters_count_);
+    }
+
+    void Shutdown() {
+      sync_primitives::AutoLock auto_lock(queue_lock_);
+      shutting_down_ = true;
+      queue_new_items_.Broadcast();
+    }
+
+    void Reset() {
+      shutting_down_ = false;
+      T element = T();
+      while (ring_.TryPop(element)) {}
+    }
+
+  private:
+    RingBufferQueue<T, Size> ring_;
+    volatile bool shutting_down_;
+    // Number of consumers parked on queue_new_items_
+    volatile uint32_t waiters_count_;
+
+    sync_primitives::Lock queue_lock_;
+    sync_primitives::ConditionalVariable queue_new_items_;
+
+    DISALLOW_COPY_AND_ASSIGN(MessageQueue);
+};
+
 }  // namespace utils
 
 #endif  // SRC_COMPONENTS_INCLUDE_UTILS_MESSAGE_QUEUE_H_
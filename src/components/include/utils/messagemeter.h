@@ -33,10 +33,13 @@
 #ifndef SRC_COMPONENTS_INCLUDE_UTILS_MESSAGEMETER_H_
 #define SRC_COMPONENTS_INCLUDE_UTILS_MESSAGEMETER_H_
 
+#include <stdint.h>
 #include <cstddef>
+#include <algorithm>
 #include <set>
 #include <map>
 #include "utils/date_time.h"
+#include "utils/macro.h"
 
 namespace utils {
 /**
@@ -92,6 +95,87 @@ class MessageMeter {
   TimingMap timing_map_;
 };
 
+/**
+    @brief The BucketedMessageMeter class counts message frequency
+    as MessageMeter does, but keeps only BucketsCount + 1 counters per
+    identifier instead of every message timestamp.
+    Time range is split to BucketsCount buckets, message is forgotten
+    not earlier than time range and not later than time range plus
+    one bucket width after it was tracked.
+    Tracking and frequency calculation take constant time and do not
+    allocate for already known identifier.
+    Changing the time range drops all frequency data.
+    Methods are reentrant and not thread-safe
+    @tparam Id could be used for handling messages by session,
+    connection or other identifier
+    @tparam BucketsCount count of buckets time range is split to
+ */
+template <class Id, size_t BucketsCount = 16>
+class BucketedMessageMeter {
+ public:
+  BucketedMessageMeter();
+  /**
+     @brief Update frequency value for selected identifier
+     @param Id - unique identifier
+     @return frequency
+   */
+  size_t TrackMessage(const Id& id);
+  /**
+     @brief Update frequency value for selected identifier
+     @param Id - unique identifier
+     @param count - count of received messages
+     @return frequency
+   */
+  size_t TrackMessages(const Id& id, const size_t count);
+  /**
+     @brief Frequency of messages for selected identifier
+     @param Id - unique identifier
+     @return frequency
+   */
+  size_t Frequency(const Id& id);
+
+  /**
+     @brief Remove all data refer to selected identifier
+     @param Id - unique identifier
+   */
+  void RemoveIdentifier(const Id& id);
+
+  /**
+     @brief Remove all frequency data
+   */
+  void ClearIdentifiers();
+
+  void set_time_range(const size_t time_range_msecs);
+  void set_time_range(const TimevalStruct& time_range);
+  TimevalStruct time_range() const;
+
+ private:
+  // Current bucket is only partially elapsed, so one more is kept
+  static const size_t kRingSize = BucketsCount + 1;
+
+  struct Counter {
+    explicit Counter(const int64_t bucket)
+      : last_bucket(bucket),
+        total(0) {
+      std::fill(counts, counts + kRingSize, 0);
+    }
+    // Absolute number of the latest bucket messages were counted in
+    int64_t last_bucket;
+    size_t counts[kRingSize];
+    size_t total;
+  };
+  typedef std::map<Id, Counter> CounterMap;
+
+  int64_t CurrentBucket() const;
+  // Forgets buckets which became older than kRingSize buckets
+  void Advance(Counter& counter, const int64_t bucket) const;
+
+  TimevalStruct time_range_;
+  // Zero for null time range
+  int64_t bucket_usecs_;
+  CounterMap counters_;
+};
+
 template <class Id>
 MessageMeter<Id>::MessageMeter()
   : time_range_(TimevalStruct {0, 0}) {
@@ -107,7 +191,7 @@ template <class Id>
 size_t MessageMeter<Id>::TrackMessages(const Id& id,
                                   const size_t count) {
   Timings& timings = timing_map_[id];
-  const TimevalStruct current_time = date_time::DateTime::getCurrentTime();
+  const TimevalStruct current_time = date_time::DateTime::getPreciseMonotonicTime();
   for (size_t i = 0; i < count; ++i) {
     // Adding to the end is amortized constant
     timings.insert(timings.end(), current_time);
@@ -126,7 +210,7 @@ size_t MessageMeter<Id>::Frequency(const Id& id) {
     return 0u;
   }
   const TimevalStruct actual_begin_time =
-      date_time::DateTime::Sub(date_time::DateTime::getCurrentTime(),
+      date_time::DateTime::Sub(date_time::DateTime::getPreciseMonotonicTime(),
                                time_range_);
   timings.erase(timings.begin(),
                 timings.upper_bound(actual_begin_time));
@@ -162,5 +246,113 @@ template <class Id>
 TimevalStruct MessageMeter<Id>::time_range() const {
   return time_range_;
 }
+
+template <class Id, size_t BucketsCount>
+BucketedMessageMeter<Id, BucketsCount>::BucketedMessageMeter()
+  : time_range_(TimevalStruct {0, 0}),
+    bucket_usecs_(0) {
+  time_range_.tv_sec = 1;
+  set_time_range(time_range_);
+}
+
+template <class Id, size_t BucketsCount>
+size_t BucketedMessageMeter<Id, BucketsCount>::TrackMessage(const Id& id) {
+  return TrackMessages(id, 1);
+}
+
+template <class Id, size_t BucketsCount>
+size_t BucketedMessageMeter<Id, BucketsCount>::TrackMessages(
+    const Id& id, const size_t count) {
+  if (0 == bucket_usecs_) {
+    return 0u;
+  }
+  const int64_t bucket = CurrentBucket();
+  typename CounterMap::iterator it = counters_.find(id);
+  if (it == counters_.end()) {
+    it = counters_.insert(std::make_pair(id, Counter(bucket))).first;
+  }
+  Counter& counter = it->second;
+  Advance(counter, bucket);
+  counter.counts[counter.last_bucket % kRingSize] += count;
+  counter.total += count;
+  return counter.total;
+}
+
+template <class Id, size_t BucketsCount>
+size_t BucketedMessageMeter<Id, BucketsCount>::Frequency(const Id& id) {
+  typename CounterMap::iterator it = counters_.find(id);
+  if (it == counters_.end() || 0 == bucket_usecs_) {
+    return 0u;
+  }
+  Counter& counter = it->second;
+  Advance(counter, CurrentBucket());
+  return counter.total;
+}
+
+template <class Id, size_t BucketsCount>
+void BucketedMessageMeter<Id, BucketsCount>::RemoveIdentifier(const Id& id) {
+  counters_.erase(id);
+}
+
+template <class Id, size_t BucketsCount>
+void BucketedMessageMeter<Id, BucketsCount>::ClearIdentifiers() {
+  counters_.clear();
+}
+
+template <class Id, size_t BucketsCount>
+void BucketedMessageMeter<Id, BucketsCount>::set_time_range(
+    const size_t time_range_msecs) {
+  TimevalStruct time_range = {0, 0};
+  time_range.tv_sec =
+      time_range_msecs / date_time::DateTime::MILLISECONDS_IN_SECOND;
+  time_range.tv_usec =
+      (time_range_msecs % date_time::DateTime::MILLISECONDS_IN_SECOND) *
+      date_time::DateTime::MICROSECONDS_IN_MILLISECONDS;
+  set_time_range(time_range);
+}
+
+template <class Id, size_t BucketsCount>
+void BucketedMessageMeter<Id, BucketsCount>::set_time_range(
+    const TimevalStruct& time_range) {
+  time_range_ = time_range;
+  const int64_t range_usecs = date_time::DateTime::getuSecs(time_range_);
+  // Rounded up, so buckets never cover less than the time range
+  bucket_usecs_ = range_usecs > 0 ?
+      (range_usecs + BucketsCount - 1) / BucketsCount : 0;
+  // Counted buckets have no meaning with the new width
+  counters_.clear();
+}
+
+template <class Id, size_t BucketsCount>
+TimevalStruct BucketedMessageMeter<Id, BucketsCount>::time_range() const {
+  return time_range_;
+}
+
+template <class Id, size_t BucketsCount>
+int64_t BucketedMessageMeter<Id, BucketsCount>::CurrentBucket() const {
+  DCHECK(bucket_usecs_ > 0);
+  return date_time::DateTime::getuSecs(
+      date_time::DateTime::getPreciseMonotonicTime()) / bucket_usecs_;
+}
+
+template <class Id, size_t BucketsCount>
+void BucketedMessageMeter<Id, BucketsCount>::Advance(
+    Counter& counter, const int64_t bucket) const {
+  // Bucket of same or earlier time, keep counting in the latest bucket
+  if (bucket <= counter.last_bucket) {
+    return;
+  }
+  if (bucket - counter.last_bucket >= static_cast<int64_t>(kRingSize)) {
+    std::fill(counter.counts, counter.counts + kRingSize, 0);
+    counter.total = 0;
+  } else {
+    for (int64_t i = counter.last_bucket + 1; i <= bucket; ++i) {
+      size_t& expired = counter.counts[i % kRingSize];
+      counter.total -= expired;
+      expired = 0;
+    }
+  }
+  counter.last_bucket = bucket;
+}
 }  // namespace utils
 #endif  // SRC_COMPONENTS_INCLUDE_UTILS_MESSAGEMETER_H_
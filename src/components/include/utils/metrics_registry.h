@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_METRICS_REGISTRY_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_METRICS_REGISTRY_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/timer_thread.h"
+
+namespace utils {
+namespace metrics {
+
+/*
+ * Updates are spread over shards, each thread sticks to one shard,
+ * so hot metrics updated by several threads do not share cache lines
+ */
+const uint32_t kShardsCount = 8;
+
+/*
+ * Histogram keeps 2^(kSubBucketBits - 1) buckets per power of two,
+ * so recorded values are precise within 1/32 of their magnitude
+ */
+const uint32_t kSubBucketBits = 6;
+const uint32_t kMaxValueBits = 40;
+const uint32_t kBucketsCount =
+    (kMaxValueBits - kSubBucketBits + 2) << (kSubBucketBits - 1);
+
+/*
+ * Monotonically growing count of events
+ */
+class Counter {
+ public:
+  explicit Counter(const std::string& name);
+
+  void Add(uint64_t value);
+  void Increment() {
+    Add(1);
+  }
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  uint64_t Value() const;
+
+ private:
+  struct Shard {
+    volatile uint64_t value;
+    // Keeps shards on separate cache lines
+    char padding[64 - sizeof(uint64_t)];
+  };
+
+  const std::string name_;
+  Shard shards_[kShardsCount];
+
+  DISALLOW_COPY_AND_ASSIGN(Counter);
+};
+
+/*
+ * Current value of some amount, e.g. queue depth
+ */
+class Gauge {
+ public:
+  explicit Gauge(const std::string& name);
+
+  void Set(int64_t value);
+  void Add(int64_t value);
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  int64_t Value() const;
+
+ private:
+  const std::string name_;
+  volatile int64_t value_;
+
+  DISALLOW_COPY_AND_ASSIGN(Gauge);
+};
+
+struct HistogramSnapshot {
+  HistogramSnapshot();
+
+  /*
+   * Returns lowest value with percent of recorded values at or below it,
+   * value is reported with histogram precision
+   */
+  uint64_t Percentile(double percent) const;
+
+  std::string name;
+  uint64_t count;
+  uint64_t sum;
+  uint64_t max;
+  std::vector<uint64_t> buckets;
+};
+
+/*
+ * High dynamic range histogram of latencies or sizes.
+ * Values are bucketed log-linearly, so memory does not depend on
+ * amount of recorded values and recording is a few atomic additions.
+ */
+class Histogram {
+ public:
+  explicit Histogram(const std::string& name);
+
+  void Record(uint64_t value);
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  void Snapshot(HistogramSnapshot* snapshot) const;
+
+  static uint32_t BucketIndex(uint64_t value);
+  static uint64_t BucketUpperBound(uint32_t index);
+
+ private:
+  struct Shard {
+    volatile uint64_t count;
+    volatile uint64_t sum;
+    volatile uint64_t max;
+    volatile uint32_t buckets[kBucketsCount];
+  };
+
+  const std::string name_;
+  Shard shards_[kShardsCount];
+
+  DISALLOW_COPY_AND_ASSIGN(Histogram);
+};
+
+struct Snapshot {
+  std::vector<std::pair<std::string, uint64_t> > counters;
+  std::vector<std::pair<std::string, int64_t> > gauges;
+  std::vector<HistogramSnapshot> histograms;
+};
+
+/*
+ * Writes counters, gauges and p50/p99/p999 of histograms as one
+ * "name=value" line per metric
+ */
+std::string ToString(const Snapshot& snapshot);
+
+/*
+ * Registry of named process metrics.
+ * Metrics live until process exit, so callers keep returned pointers
+ * to avoid lookups on hot paths, typically in function static variables.
+ */
+class MetricsRegistry {
+ public:
+  static MetricsRegistry* instance();
+
+  /*
+   * Return metric of a name, creating it on first call
+   */
+  Counter* GetCounter(const std::string& name);
+  Gauge* GetGauge(const std::string& name);
+  Histogram* GetHistogram(const std::string& name);
+
+  /*
+   * @brief Copies current values of all metrics
+   */
+  void TakeSnapshot(Snapshot* snapshot) const;
+
+  /*
+   * @brief Writes snapshot to log every period, 0 disables dumps
+   */
+  void StartPeriodicDump(uint32_t period_seconds);
+  void StopPeriodicDump();
+
+ private:
+  MetricsRegistry();
+  static void CreateInstance();
+  void LogSnapshot();
+
+  typedef std::map<std::string, Counter*> Counters;
+  typedef std::map<std::string, Gauge*> Gauges;
+  typedef std::map<std::string, Histogram*> Histograms;
+  Counters counters_;
+  Gauges gauges_;
+  Histograms histograms_;
+  mutable sync_primitives::Lock metrics_lock_;
+  timer::TimerThread<MetricsRegistry> dump_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(MetricsRegistry);
+};
+
+/*
+ * Returns shard of calling thread
+ */
+uint32_t CurrentShard();
+
+}  // namespace metrics
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_METRICS_REGISTRY_H_
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_NUMBER_CONVERSION_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_NUMBER_CONVERSION_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace utils {
+
+/*
+ * Conversions between numbers and their decimal text that neither allocate
+ * nor depend on process locale, so decimal point is always '.'.
+ * Formatting functions write into caller's buffer without terminating zero
+ * and return count of characters written. Parsing functions read the
+ * longest number at the start of [begin, end) and return pointer past it,
+ * or begin if there is no number or it does not fit the type.
+ */
+
+// Buffer sizes enough for any value
+const size_t kInt64StringSize = 20;
+// Values of 2^53 and above are formatted as integers of up to 309 digits
+const size_t kDoubleStringSize = 330;
+// Fraction digits FormatFixed keeps exactly
+const int kMaxFixedPrecision = 15;
+
+size_t FormatInt64(int64_t value, char* buffer);
+
+size_t FormatUInt64(uint64_t value, char* buffer);
+
+/*
+ * Fixed notation rounded to precision fraction digits, trailing zeros of
+ * fraction and dangling decimal point are dropped: 123.1200 => "123.12",
+ * 5.0 => "5". Infinities and NaN are written as "inf", "-inf" and "nan".
+ */
+size_t FormatFixed(double value, int precision, char* buffer);
+
+/*
+ * Integer is optional '-' followed by digits
+ */
+const char* ParseInt64(const char* begin, const char* end, int64_t* value);
+
+/*
+ * Number is optional sign followed by digits with optional decimal point
+ * and optional exponent. Result is correctly rounded, values out of double
+ * range are not parsed.
+ */
+const char* ParseDouble(const char* begin, const char* end, double* value);
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_NUMBER_CONVERSION_H_
@@ -33,9 +33,12 @@
 #ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_PRIORITIZED_QUEUE_H_
 #define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_PRIORITIZED_QUEUE_H_
 
+#include <stdint.h>
 #include <queue>
 #include <map>
+#include <vector>
 #include <iostream>
+#include <algorithm>
 
 #include "utils/macro.h"
 
@@ -79,11 +82,151 @@ class PrioritizedQueue {
       queues_.erase(last);
     }
   }
+  void swap(PrioritizedQueue& other) {
+    queues_.swap(other.queues_);
+    std::swap(total_size_, other.total_size_);
+  }
  private:
   QueuesMap queues_;
   size_t total_size_;
 };
 
+/*
+ * Prioritized queue with fixed number of priority levels.
+ * Every level is a circular buffer which storage is reused, so after warm up
+ * push and pop are never allocating. Non-empty levels are tracked in a bit
+ * mask, thus front and pop just find highest set bit.
+ * Message class must have size_t PriorityOrder() method implemented
+ * and be default constructible,
+ * priorities greater than (LevelsCount - 1) share the highest level.
+ */
+template < typename M, size_t LevelsCount = 256 >
+class FixedPrioritizedQueue {
+ public:
+  typedef M value_type;
+  FixedPrioritizedQueue()
+    : total_size_(0) {
+    std::fill(non_empty_levels_, non_empty_levels_ + kMaskWordsCount, 0);
+  }
+  // All api mimics usual std queue interface
+  void push(const value_type& message) {
+    const size_t level = std::min(message.PriorityOrder(), LevelsCount - 1);
+    levels_[level].push(message);
+    non_empty_levels_[level / kBitsPerWord] |= Bit(level);
+    ++total_size_;
+  }
+  size_t size() const {
+    return total_size_;
+  }
+  bool empty() const {
+    return 0 == total_size_;
+  }
+  value_type front() {
+    DCHECK(!empty());
+    return levels_[HighestLevel()].front();
+  }
+  void pop() {
+    DCHECK(!empty());
+    const size_t level = HighestLevel();
+    levels_[level].pop();
+    --total_size_;
+    if (levels_[level].empty()) {
+      non_empty_levels_[level / kBitsPerWord] &= ~Bit(level);
+    }
+  }
+  void swap(FixedPrioritizedQueue& other) {
+    for (size_t word = 0; word < kMaskWordsCount; ++word) {
+      uint64_t levels_to_swap =
+          non_empty_levels_[word] | other.non_empty_levels_[word];
+      while (levels_to_swap) {
+        const size_t bit = __builtin_ctzll(levels_to_swap);
+        levels_[word * kBitsPerWord + bit].swap(
+            other.levels_[word * kBitsPerWord + bit]);
+        levels_to_swap &= levels_to_swap - 1;
+      }
+      std::swap(non_empty_levels_[word], other.non_empty_levels_[word]);
+    }
+    std::swap(total_size_, other.total_size_);
+  }
+
+ private:
+  /*
+   * Circular buffer growing only when it is full
+   */
+  class Level {
+   public:
+    Level()
+      : head_(0),
+        size_(0) {
+    }
+    void push(const value_type& message) {
+      if (size_ == storage_.size()) {
+        Grow();
+      }
+      storage_[(head_ + size_) % storage_.size()] = message;
+      ++size_;
+    }
+    value_type& front() {
+      return storage_[head_];
+    }
+    void pop() {
+      // Release message right away, storage cell is kept for reuse
+      storage_[head_] = value_type();
+      head_ = (head_ + 1) % storage_.size();
+      --size_;
+    }
+    bool empty() const {
+      return 0 == size_;
+    }
+    void swap(Level& other) {
+      storage_.swap(other.storage_);
+      std::swap(head_, other.head_);
+      std::swap(size_, other.size_);
+    }
+   private:
+    void Grow() {
+      std::vector<value_type> storage;
+      const size_t capacity = storage_.size() * 2;
+      storage.reserve(capacity > kInitialLevelCapacity ? capacity
+                                                       : kInitialLevelCapacity);
+      for (size_t i = 0; i < size_; ++i) {
+        storage.push_back(storage_[(head_ + i) % storage_.size()]);
+      }
+      storage.resize(storage.capacity());
+      storage_.swap(storage);
+      head_ = 0;
+    }
+    std::vector<value_type> storage_;
+    size_t head_;
+    size_t size_;
+  };
+
+  static const size_t kInitialLevelCapacity = 16;
+  static const size_t kBitsPerWord = 64;
+  static const size_t kMaskWordsCount =
+      (LevelsCount + kBitsPerWord - 1) / kBitsPerWord;
+
+  static uint64_t Bit(size_t level) {
+    return static_cast<uint64_t>(1) << (level % kBitsPerWord);
+  }
+
+  size_t HighestLevel() const {
+    for (size_t word = kMaskWordsCount; word > 0; --word) {
+      const uint64_t mask = non_empty_levels_[word - 1];
+      if (mask) {
+        return (word - 1) * kBitsPerWord + (kBitsPerWord - 1) -
+               __builtin_clzll(mask);
+      }
+    }
+    NOTREACHED();
+    return 0;
+  }
+
+  Level levels_[LevelsCount];
+  uint64_t non_empty_levels_[kMaskWordsCount];
+  size_t total_size_;
+};
+
 }
 
 #endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_RING_BUFFER_QUEUE_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_RING_BUFFER_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sched.h>
+
+#include "utils/macro.h"
+#include "utils/memory_barrier.h"
+
+namespace utils {
+
+/*
+ * Bounded lock-free queue for multiple producers and single consumer.
+ * Every cell of the ring carries a sequence number which tells producers
+ * and consumer whether cell is free or filled, so hand-off of a message
+ * costs one compare-and-swap for producer and a couple of barriers.
+ * Size must be power of two.
+ * Api mimics usual std queue interface, but front/pop must be
+ * called from single consumer thread only.
+ */
+template < typename T, size_t Size = 1024 >
+class RingBufferQueue {
+ public:
+  typedef T value_type;
+
+  RingBufferQueue()
+    : enqueue_pos_(0),
+      dequeue_pos_(0) {
+    DCHECK((Size & (Size - 1)) == 0);
+    for (size_t i = 0; i < Size; ++i) {
+      cells_[i].sequence = i;
+    }
+  }
+
+  /*
+   * Tries to place element to the ring.
+   * Returns false if ring is full.
+   */
+  bool TryPush(const value_type& element) {
+    size_t pos = enqueue_pos_;
+    Cell* cell = NULL;
+    for (;;) {
+      cell = &cells_[pos & kMask];
+      const size_t sequence = cell->sequence;
+      memory_barrier();
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (0 == diff) {
+        if (__sync_bool_compare_and_swap(&enqueue_pos_, pos, pos + 1)) {
+          break;
+        }
+        pos = enqueue_pos_;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_;
+      }
+    }
+    cell->data = element;
+    memory_barrier();
+    cell->sequence = pos + 1;
+    return true;
+  }
+
+  /*
+   * Places element to the ring, yields while ring is full.
+   */
+  void push(const value_type& element) {
+    while (!TryPush(element)) {
+      sched_yield();
+    }
+  }
+
+  /*
+   * Takes element out of the ring.
+   * Returns false if ring is empty.
+   */
+  bool TryPop(value_type& element) {
+    Cell& cell = cells_[dequeue_pos_ & kMask];
+    const size_t sequence = cell.sequence;
+    memory_barrier();
+    if (sequence != dequeue_pos_ + 1) {
+      return false;
+    }
+    element = cell.data;
+    // Release reference to the data as early as possible
+    cell.data = value_type();
+    memory_barrier();
+    cell.sequence = dequeue_pos_ + Size;
+    ++dequeue_pos_;
+    return true;
+  }
+
+  bool empty() const {
+    const size_t sequence = cells_[dequeue_pos_ & kMask].sequence;
+    memory_barrier();
+    return sequence != dequeue_pos_ + 1;
+  }
+
+  // Approximate, precise only when producers are idle
+  size_t size() const {
+    const size_t enqueued = enqueue_pos_;
+    return enqueued - dequeue_pos_;
+  }
+
+  value_type front() const {
+    DCHECK(!empty());
+    return cells_[dequeue_pos_ & kMask].data;
+  }
+
+  void pop() {
+    value_type element;
+    const bool popped = TryPop(element);
+    DCHECK(popped);
+  }
+
+  static size_t capacity() {
+    return Size;
+  }
+
+ private:
+  static const size_t kMask = Size - 1;
+
+  struct Cell {
+    volatile size_t sequence;
+    value_type data;
+  };
+
+  Cell cells_[Size];
+  volatile size_t enqueue_pos_;
+  // Keeps producers and consumer positions in different cache lines
+  char padding_[64];
+  // Modified by consumer thread only
+  volatile size_t dequeue_pos_;
+
+  DISALLOW_COPY_AND_ASSIGN(RingBufferQueue);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_RING_BUFFER_QUEUE_H_
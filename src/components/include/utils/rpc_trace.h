@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_RPC_TRACE_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_RPC_TRACE_H_
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+#include "utils/date_time.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/shared_ptr.h"
+#include "utils/singleton.h"
+
+namespace utils {
+
+namespace rpc_trace {
+// Stages of mobile RPC, spans are named after them
+extern const char kRpc[];
+extern const char kTransportManager[];
+extern const char kProtocolHandler[];
+extern const char kApplicationManager[];
+extern const char kFormatter[];
+extern const char kCommand[];
+extern const char kHmi[];
+extern const char kHmiResponse[];
+extern const char kMobileResponse[];
+}  // namespace rpc_trace
+
+/**
+ * @brief Time spent by RPC in one stage.
+ * Queued is the time work was handed over to the stage, so
+ * begin - queued is queue wait and end - begin is processing.
+ * Zero time means the point was never reached.
+ */
+struct RpcTraceSpan {
+  RpcTraceSpan();
+  RpcTraceSpan(const char* span_name, int32_t parent_span);
+
+  // Name of the stage, one of rpc_trace constants
+  const char* name;
+  // Index of enclosing span, -1 for the root span
+  int32_t parent;
+  TimevalStruct queued;
+  TimevalStruct begin;
+  TimevalStruct end;
+};
+
+/**
+ * @brief Span tree of single mobile RPC from reception of its first byte
+ * till its response is handed over to protocol handler.
+ * Stages of RPC are processed by different threads one after another,
+ * span lookup by name finds the latest span of that name.
+ */
+class RpcTrace {
+ public:
+  /**
+   * @param received time the message was read from transport,
+   * starts the root span
+   */
+  explicit RpcTrace(const TimevalStruct& received);
+
+  void set_rpc(uint32_t connection_key, int32_t correlation_id,
+               int32_t function_id);
+  uint32_t connection_key() const;
+  int32_t correlation_id() const;
+  int32_t function_id() const;
+
+  /**
+   * @brief Adds span with known times as child of the root span
+   */
+  void AddSpan(const char* name, const TimevalStruct& queued,
+               const TimevalStruct& begin, const TimevalStruct& end);
+
+  /**
+   * @brief Opens span of stage the RPC is handed over to
+   * @param parent name of enclosing span, NULL for the root span
+   */
+  void Enqueue(const char* name, const char* parent = NULL);
+
+  /**
+   * @brief Marks the latest not started span of stage as started,
+   * opens new span if stage was entered without queue
+   */
+  void Begin(const char* name, const char* parent = NULL);
+
+  /**
+   * @brief Closes the latest not finished span of stage
+   */
+  void End(const char* name);
+
+  /**
+   * @brief Closes the root span
+   */
+  void Finish();
+
+  std::vector<RpcTraceSpan> spans() const;
+
+ private:
+  // Returns index of the latest span of name, -1 if there is none
+  int32_t Find(const char* name, bool begun, bool ended) const;
+  int32_t ParentOf(const char* parent) const;
+
+  uint32_t connection_key_;
+  int32_t correlation_id_;
+  int32_t function_id_;
+  mutable sync_primitives::Lock spans_lock_;
+  std::vector<RpcTraceSpan> spans_;
+
+  DISALLOW_COPY_AND_ASSIGN(RpcTrace);
+};
+
+typedef SharedPtr<RpcTrace> RpcTracePtr;
+
+/**
+ * @brief Receives traces of finished RPCs
+ */
+class RpcTraceObserver {
+ public:
+  virtual void OnRpcTraced(const RpcTracePtr& trace) = 0;
+  virtual ~RpcTraceObserver() {}
+};
+
+/**
+ * @brief Keeps traces of RPCs in flight between components which
+ * know RPC only by its connection key and correlation id.
+ * Nothing is traced until observer is set.
+ * RPCs never finished (e.g. requests without response) are removed
+ * after timeout once too many of them are pending.
+ */
+class RpcTracer : public Singleton<RpcTracer> {
+ public:
+  void set_observer(RpcTraceObserver* observer);
+
+  bool enabled() const {
+    return NULL != observer_;
+  }
+
+  void Bind(uint32_t connection_key, int32_t correlation_id,
+            const RpcTracePtr& trace);
+  RpcTracePtr Find(uint32_t connection_key, int32_t correlation_id) const;
+
+  /**
+   * @brief Finishes trace of RPC and passes it to observer
+   */
+  void Complete(uint32_t connection_key, int32_t correlation_id);
+
+  /**
+   * @brief Links HMI request sent while processing mobile RPC to its trace,
+   * HMI round trip is traced as child of command span
+   */
+  void BindHmi(int32_t hmi_correlation_id, uint32_t connection_key,
+               int32_t correlation_id);
+  RpcTracePtr FindHmi(int32_t hmi_correlation_id) const;
+  void UnbindHmi(int32_t hmi_correlation_id);
+
+  size_t pending_count() const;
+
+ private:
+  RpcTracer();
+
+  struct PendingTrace {
+    PendingTrace() : bound(0) {}
+    PendingTrace(const RpcTracePtr& pending_trace, int64_t bound_time)
+      : trace(pending_trace), bound(bound_time) {}
+    RpcTracePtr trace;
+    // Seconds since epoch
+    int64_t bound;
+  };
+  typedef std::pair<uint32_t, int32_t> RpcKey;
+  typedef std::map<RpcKey, PendingTrace> Traces;
+  typedef std::map<int32_t, PendingTrace> HmiTraces;
+
+  template <typename Map>
+  static void RemoveStale(Map* pending, int64_t now);
+
+  RpcTraceObserver* volatile observer_;
+  mutable sync_primitives::Lock traces_lock_;
+  Traces traces_;
+  HmiTraces hmi_traces_;
+
+  FRIEND_BASE_SINGLETON_CLASS(RpcTracer);
+  DISALLOW_COPY_AND_ASSIGN(RpcTracer);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_RPC_TRACE_H_
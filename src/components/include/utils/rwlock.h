@@ -37,10 +37,14 @@
 #include <pthread.h>
 #endif
 
+#include <stdint.h>
+
 #include "utils/macro.h"
 
 namespace sync_primitives {
 
+struct LockStatistics;
+
 namespace impl {
 #if defined(OS_POSIX)
 typedef pthread_rwlock_t PlatformRWLock;
@@ -55,6 +59,8 @@ typedef pthread_rwlock_t PlatformRWLock;
  * The read-write lock is a single entity that can be locked in read or write mode.
  * To modify a resource, a thread must first acquire the exclusive write lock.
  * An exclusive write lock is not permitted until all read locks have been released.
+ * Lock is reader-biased where platform allows to choose: readers are not
+ * blocked behind waiting writers, which suits read mostly data.
  */
 
 class RWLock {
@@ -121,8 +127,24 @@ class RWLock {
      */
   bool Release();
 
+  /**
+   * @brief Name lock is reported with by LockProfiler, must be given
+   * before the lock is shared between threads.
+   * Does nothing unless built with LOCK_PROFILING
+   */
+  void set_name(const char* name);
+
  private:
   impl::PlatformRWLock rwlock_;
+
+#ifdef LOCK_PROFILING
+  /**
+   * @brief Statistics entry of named lock, NULL if lock is not profiled.
+   * Hold time is collected for writers only.
+   */
+  LockStatistics* statistics_;
+  uint64_t write_acquired_at_;
+#endif
 };
 
 /**
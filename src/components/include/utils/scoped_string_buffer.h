@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_SCOPED_STRING_BUFFER_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_SCOPED_STRING_BUFFER_H_
+
+#include <pthread.h>
+#include <stddef.h>
+#include <new>
+#include <string>
+
+#include "utils/macro.h"
+
+namespace utils {
+
+/*
+ * Scratch string borrowed from the calling thread for the scope lifetime.
+ * Buffer comes back cleared but keeps its capacity, so formatting a stream
+ * of messages of similar size stops reallocating after the first one.
+ * Scopes nested on the same thread get their own string. Capacity grown
+ * above kMaxRetainedCapacity is released at the scope end, so one huge
+ * message does not pin memory for the thread lifetime.
+ */
+class ScopedStringBuffer {
+ public:
+  static const size_t kMaxRetainedCapacity = 64 * 1024;
+
+  ScopedStringBuffer()
+    : cache_(ThisThreadCache()),
+      buffer_(&own_buffer_) {
+    if (cache_ && !cache_->in_use) {
+      cache_->in_use = true;
+      buffer_ = &cache_->buffer;
+    } else {
+      cache_ = NULL;
+    }
+  }
+
+  ~ScopedStringBuffer() {
+    if (!cache_) {
+      return;
+    }
+    if (cache_->buffer.capacity() > kMaxRetainedCapacity) {
+      std::string().swap(cache_->buffer);
+    } else {
+      cache_->buffer.clear();
+    }
+    cache_->in_use = false;
+  }
+
+  std::string& get() {
+    return *buffer_;
+  }
+
+ private:
+  struct Cache {
+    Cache() : in_use(false) {}
+    std::string buffer;
+    bool in_use;
+  };
+
+  static Cache* ThisThreadCache() {
+    static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+    pthread_once(&key_once, &CreateCacheKey);
+    Cache* cache = static_cast<Cache*>(pthread_getspecific(cache_key()));
+    if (!cache) {
+      cache = new (std::nothrow) Cache();
+      if (cache && 0 != pthread_setspecific(cache_key(), cache)) {
+        delete cache;
+        cache = NULL;
+      }
+    }
+    return cache;
+  }
+
+  static pthread_key_t& cache_key() {
+    static pthread_key_t key;
+    return key;
+  }
+
+  static void CreateCacheKey() {
+    pthread_key_create(&cache_key(), &DestroyCache);
+  }
+
+  // Called on thread exit
+  static void DestroyCache(void* data) {
+    delete static_cast<Cache*>(data);
+  }
+
+  Cache* cache_;
+  std::string* buffer_;
+  std::string own_buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedStringBuffer);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_SCOPED_STRING_BUFFER_H_
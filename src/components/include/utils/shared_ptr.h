@@ -36,11 +36,43 @@
 #include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <new>
 
 #include "utils/macro.h"
 #include "utils/atomic.h"
+#include "utils/small_object_pool.h"
 
 namespace utils {
+
+namespace detail {
+/**
+ * @brief Shared pointer control block.
+ *
+ * Block is taken from thread local SmallObjectPool. If object is
+ * created with MakeShared it is placed in the same allocation right after
+ * the block, then destroy releases both object and block.
+ **/
+struct SharedPtrCounter {
+  uint32_t count;
+  void (*destroy)(SharedPtrCounter* counter);
+};
+
+inline SharedPtrCounter* CreateSharedPtrCounter() {
+  SharedPtrCounter* counter = static_cast<SharedPtrCounter*>(
+      SmallObjectPool::Allocate(sizeof(SharedPtrCounter)));
+  counter->count = 1;
+  counter->destroy = NULL;
+  return counter;
+}
+
+inline void FreeSharedPtrCounter(SharedPtrCounter* counter) {
+  SmallObjectPool::Free(counter, sizeof(SharedPtrCounter));
+}
+
+template<typename ObjectType>
+struct InplaceSharedBlock;
+}  // namespace detail
+
 /**
  * @brief Shared pointer.
  *
@@ -179,6 +211,10 @@ class SharedPtr {
     template<typename OtherObjectType>
     friend class SharedPtr;
 
+    // MakeShared constructs pointers on top of preallocated control block
+    template<typename OtherObjectType>
+    friend struct detail::InplaceSharedBlock;
+
     /**
      * @brief Drop reference to wrapped object.
      *
@@ -195,7 +231,7 @@ class SharedPtr {
     /**
      * @brief Pointer to reference counter.
      **/
-    uint32_t* mReferenceCounter;
+    detail::SharedPtrCounter* mReferenceCounter;
 
     void release();
 };
@@ -203,7 +239,7 @@ class SharedPtr {
 template<typename ObjectType>
 inline utils::SharedPtr<ObjectType>::SharedPtr(ObjectType* Object)
   : mObject(NULL),
-    mReferenceCounter(new uint32_t(1)) {
+    mReferenceCounter(detail::CreateSharedPtrCounter()) {
   DCHECK(Object != NULL);
   mObject = Object;
 }
@@ -265,7 +301,7 @@ utils::SharedPtr<ObjectType>::operator=(
   mReferenceCounter = Other.mReferenceCounter;
 
   if (0 != mReferenceCounter) {
-    atomic_post_inc(mReferenceCounter);
+    atomic_post_inc(&mReferenceCounter->count);
   }
 
   return *this;
@@ -279,7 +315,7 @@ utils::SharedPtr<OtherObjectType> utils::SharedPtr<ObjectType>::static_pointer_c
   casted_pointer.mReferenceCounter = pointer.mReferenceCounter;
 
   if (0 != casted_pointer.mReferenceCounter) {
-    atomic_post_inc(casted_pointer.mReferenceCounter);
+    atomic_post_inc(&casted_pointer.mReferenceCounter->count);
   }
 
   return casted_pointer;
@@ -294,7 +330,7 @@ utils::SharedPtr<OtherObjectType> utils::SharedPtr<ObjectType>::dynamic_pointer_
     casted_pointer.mReferenceCounter = pointer.mReferenceCounter;
 
     if (0 != casted_pointer.mReferenceCounter) {
-      atomic_post_inc(casted_pointer.mReferenceCounter);
+      atomic_post_inc(&casted_pointer.mReferenceCounter->count);
     }
   }
 
@@ -331,11 +367,14 @@ utils::SharedPtr<ObjectType>::reset(ObjectType* other) {
 
 template<typename ObjectType>
 void SharedPtr<ObjectType>::release() {
-
-  delete mObject;
+  if (mReferenceCounter->destroy) {
+    // Object shares allocation with counter, it is destroyed by its real type
+    mReferenceCounter->destroy(mReferenceCounter);
+  } else {
+    delete mObject;
+    detail::FreeSharedPtrCounter(mReferenceCounter);
+  }
   mObject = 0;
-
-  delete mReferenceCounter;
   mReferenceCounter = 0;
 }
 
@@ -343,13 +382,13 @@ template<typename ObjectType> void
 utils::SharedPtr<ObjectType>::reset_impl(ObjectType* other) {
   dropReference();
   mObject = other;
-  mReferenceCounter = new uint32_t(1);
+  mReferenceCounter = detail::CreateSharedPtrCounter();
 }
 
 template<typename ObjectType>
 inline void SharedPtr<ObjectType>::dropReference() {
   if (0 != mReferenceCounter) {
-    if (1 == atomic_post_dec(mReferenceCounter)) {
+    if (1 == atomic_post_dec(&mReferenceCounter->count)) {
       release();
     }
   }
@@ -362,12 +401,119 @@ ObjectType* SharedPtr<ObjectType>::get() const {
 
 template<typename ObjectType>
 inline bool SharedPtr<ObjectType>::valid() const {
-  if (mReferenceCounter && (0 < *mReferenceCounter)) {
+  if (mReferenceCounter && (0 < mReferenceCounter->count)) {
     return (mObject != NULL);
   }
   return false;
 }
 
+namespace detail {
+/**
+ * @brief Control block followed by storage for the object itself.
+ **/
+template<typename ObjectType>
+struct InplaceSharedBlock {
+  SharedPtrCounter counter;
+  union {
+    char bytes[sizeof(ObjectType)];
+    long double long_double_alignment;
+    long long long_long_alignment;
+    void* pointer_alignment;
+  } storage;
+
+  ObjectType* object() {
+    return reinterpret_cast<ObjectType*>(storage.bytes);
+  }
+
+  static InplaceSharedBlock* Create() {
+    InplaceSharedBlock* block = static_cast<InplaceSharedBlock*>(
+        SmallObjectPool::Allocate(sizeof(InplaceSharedBlock)));
+    block->counter.count = 1;
+    block->counter.destroy = &Destroy;
+    return block;
+  }
+
+  static void Destroy(SharedPtrCounter* counter) {
+    // counter is the first member of the block
+    InplaceSharedBlock* block = reinterpret_cast<InplaceSharedBlock*>(counter);
+    block->object()->~ObjectType();
+    SmallObjectPool::Free(block, sizeof(InplaceSharedBlock));
+  }
+
+  static SharedPtr<ObjectType> Share(InplaceSharedBlock* block) {
+    SharedPtr<ObjectType> pointer;
+    pointer.mObject = block->object();
+    pointer.mReferenceCounter = &block->counter;
+    return pointer;
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief Creates object owned by shared pointer with single allocation.
+ *
+ * Object and reference counter share one block from SmallObjectPool,
+ * constructor arguments are passed by const reference.
+ * Resulting pointer may be converted to pointer to a base class.
+ *
+ * @tparam ObjectType Type of created object.
+ **/
+template<typename ObjectType>
+inline SharedPtr<ObjectType> MakeShared() {
+  detail::InplaceSharedBlock<ObjectType>* block =
+      detail::InplaceSharedBlock<ObjectType>::Create();
+  ::new (block->object()) ObjectType();
+  return detail::InplaceSharedBlock<ObjectType>::Share(block);
+}
+
+template<typename ObjectType, typename A1>
+inline SharedPtr<ObjectType> MakeShared(const A1& a1) {
+  detail::InplaceSharedBlock<ObjectType>* block =
+      detail::InplaceSharedBlock<ObjectType>::Create();
+  ::new (block->object()) ObjectType(a1);
+  return detail::InplaceSharedBlock<ObjectType>::Share(block);
+}
+
+template<typename ObjectType, typename A1, typename A2>
+inline SharedPtr<ObjectType> MakeShared(const A1& a1, const A2& a2) {
+  detail::InplaceSharedBlock<ObjectType>* block =
+      detail::InplaceSharedBlock<ObjectType>::Create();
+  ::new (block->object()) ObjectType(a1, a2);
+  return detail::InplaceSharedBlock<ObjectType>::Share(block);
+}
+
+template<typename ObjectType, typename A1, typename A2, typename A3>
+inline SharedPtr<ObjectType> MakeShared(const A1& a1, const A2& a2, const A3& a3) {
+  detail::InplaceSharedBlock<ObjectType>* block =
+      detail::InplaceSharedBlock<ObjectType>::Create();
+  ::new (block->object()) ObjectType(a1, a2, a3);
+  return detail::InplaceSharedBlock<ObjectType>::Share(block);
+}
+
+template<typename ObjectType, typename A1, typename A2, typename A3, typename A4>
+inline SharedPtr<ObjectType> MakeShared(const A1& a1, const A2& a2, const A3& a3, const A4& a4) {
+  detail::InplaceSharedBlock<ObjectType>* block =
+      detail::InplaceSharedBlock<ObjectType>::Create();
+  ::new (block->object()) ObjectType(a1, a2, a3, a4);
+  return detail::InplaceSharedBlock<ObjectType>::Share(block);
+}
+
+template<typename ObjectType, typename A1, typename A2, typename A3, typename A4, typename A5>
+inline SharedPtr<ObjectType> MakeShared(const A1& a1, const A2& a2, const A3& a3, const A4& a4, const A5& a5) {
+  detail::InplaceSharedBlock<ObjectType>* block =
+      detail::InplaceSharedBlock<ObjectType>::Create();
+  ::new (block->object()) ObjectType(a1, a2, a3, a4, a5);
+  return detail::InplaceSharedBlock<ObjectType>::Share(block);
+}
+
+template<typename ObjectType, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+inline SharedPtr<ObjectType> MakeShared(const A1& a1, const A2& a2, const A3& a3, const A4& a4, const A5& a5, const A6& a6) {
+  detail::InplaceSharedBlock<ObjectType>* block =
+      detail::InplaceSharedBlock<ObjectType>::Create();
+  ::new (block->object()) ObjectType(a1, a2, a3, a4, a5, a6);
+  return detail::InplaceSharedBlock<ObjectType>::Share(block);
+}
+
 }  // namespace utils
 
 #endif  // SRC_COMPONENTS_INCLUDE_UTILS_SHARED_PTR_H_
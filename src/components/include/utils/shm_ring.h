@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_SHM_RING_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_SHM_RING_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include "utils/macro.h"
+
+namespace utils {
+
+/**
+ * \class ShmRing
+ * \brief Single producer single consumer byte ring placed in memory shared
+ * between processes (SDL and HMI).
+ *
+ * Messages are written as records of 32 bit length followed by data padded
+ * to 4 bytes. Message not fitting into free space is split into several
+ * records, so its size is not limited by ring capacity.
+ * Peers are woken up with futex only when the other side really sleeps,
+ * so while both are busy messages pass without syscalls.
+ */
+class ShmRing {
+ public:
+  ShmRing();
+
+  /**
+   * \brief Memory needed for ring of given capacity
+   * \param capacity size of data area, power of two
+   */
+  static size_t RequiredSize(uint32_t capacity);
+
+  /**
+   * \brief Attaches ring to shared memory
+   * \param memory memory of RequiredSize(capacity) bytes
+   * \param capacity size of data area, power of two
+   * \param init true for the side creating memory, it resets ring state
+   */
+  void Attach(void* memory, uint32_t capacity, bool init);
+
+  /**
+   * \brief Writes message, blocks while ring is full
+   * \return false if ring was stopped
+   */
+  bool Write(const char* data, size_t size);
+
+  /**
+   * \brief Reads next message, blocks while ring is empty
+   * \param message receives message data
+   * \return false if ring was stopped
+   */
+  bool Read(std::string* message);
+
+  /**
+   * \brief Wakes up and stops all blocked Write and Read calls of
+   * this process
+   */
+  void Stop();
+
+ private:
+  struct Header;
+
+  /**
+   * \brief Sleeps until peer changes position or ring is stopped
+   * \return false if ring was stopped
+   */
+  bool WaitWhile(volatile uint32_t* sequence, volatile uint32_t* waiting,
+                 volatile uint32_t* position, uint32_t value);
+  static void Notify(volatile uint32_t* sequence, volatile uint32_t* waiting);
+  void CopyIn(uint32_t position, const void* data, uint32_t size);
+  void CopyOut(uint32_t position, void* data, uint32_t size) const;
+
+  Header* header_;
+  char* data_;
+  uint32_t capacity_;
+  volatile uint32_t stopped_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShmRing);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_SHM_RING_H_
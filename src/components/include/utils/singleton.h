@@ -34,7 +34,6 @@
 #define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_SINGLETON_H_
 
 #include "utils/lock.h"
-#include "utils/memory_barrier.h"
 #include "utils/atomic.h"
 
 namespace utils {
@@ -111,55 +110,46 @@ class Singleton {
 
   static T** instance_pointer();
   static Deleter* deleter();
+  static sync_primitives::Lock* instance_lock();
 };
 
 template<typename T, class Deleter>
 T* Singleton<T, Deleter>::instance() {
-  static sync_primitives::Lock lock;
-
-  T* local_instance;
-  atomic_pointer_assign(local_instance, *instance_pointer());
-  memory_barrier();
+  // Once created the instance is returned after a single acquire load,
+  // lock is taken only until the first instance is published
+  T* local_instance = atomic_pointer_load_acquire(*instance_pointer());
+  if (local_instance) {
+    return local_instance;
+  }
 
+  sync_primitives::AutoLock auto_lock(*instance_lock());
+  local_instance = *instance_pointer();
   if (!local_instance) {
-    lock.Acquire();
-    local_instance = *instance_pointer();
-    if (!local_instance) {
-      local_instance = new T();
-      memory_barrier();
-      atomic_pointer_assign(*instance_pointer(), local_instance);
-      deleter()->grab(local_instance);
-    }
-    lock.Release();
+    local_instance = new T();
+    atomic_pointer_store_release(*instance_pointer(), local_instance);
+    deleter()->grab(local_instance);
   }
-
   return local_instance;
 }
 
 template<typename T, class Deleter>
 void Singleton<T, Deleter>::destroy() {
-  static sync_primitives::Lock lock;
-
-  T* local_instance;
-  atomic_pointer_assign(local_instance, *instance_pointer());
-  memory_barrier();
+  if (!atomic_pointer_load_acquire(*instance_pointer())) {
+    return;
+  }
 
+  sync_primitives::AutoLock auto_lock(*instance_lock());
+  T* local_instance = *instance_pointer();
   if (local_instance) {
-    lock.Acquire();
-    local_instance = *instance_pointer();
-    if (local_instance) {
-      atomic_pointer_assign(*instance_pointer(), 0);
-      memory_barrier();
-      delete local_instance;
-      deleter()->grab(0);
-    }
-    lock.Release();
+    atomic_pointer_store_release(*instance_pointer(), static_cast<T*>(0));
+    delete local_instance;
+    deleter()->grab(0);
   }
 }
 
 template<typename T, class Deleter>
 bool Singleton<T, Deleter>::exists() {
-  return *instance_pointer() != 0;
+  return atomic_pointer_load_acquire(*instance_pointer()) != 0;
 }
 
 template<typename T, class Deleter>
@@ -174,6 +164,12 @@ Deleter* Singleton<T, Deleter>::deleter() {
   return &deleter;
 }
 
+template<typename T, class Deleter>
+sync_primitives::Lock* Singleton<T, Deleter>::instance_lock() {
+  static sync_primitives::Lock lock;
+  return &lock;
+}
+
 }  // namespace utils
 
 #endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_SINGLETON_H_
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_SMALL_OBJECT_POOL_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_SMALL_OBJECT_POOL_H_
+
+#include <pthread.h>
+#include <stddef.h>
+#include <new>
+
+#include "utils/macro.h"
+
+namespace utils {
+
+/*
+ * Thread local cache of small memory blocks.
+ * Blocks are grouped in size classes of kGranularity bytes, freed block is
+ * kept in the cache of calling thread and handed out again by the next
+ * allocation of the same class, so steady flow of short living objects
+ * (messages, shared pointer counters) does not reach the heap.
+ * Block may be freed from any thread, but the same size it was allocated
+ * with must be passed. Blocks bigger than kMaxBlockSize are not cached.
+ */
+class SmallObjectPool {
+ public:
+  static const size_t kGranularity = 16;
+  static const size_t kMaxBlockSize = 512;
+  // Limit per size class, surplus is returned to the heap
+  static const size_t kMaxCachedBlocks = 256;
+
+  static void* Allocate(size_t size) {
+    if (size > kMaxBlockSize) {
+      return ::operator new(size);
+    }
+    const size_t size_class = SizeClass(size);
+    Cache* cache = ThisThreadCache();
+    if (cache && cache->free_blocks[size_class]) {
+      FreeBlock* block = cache->free_blocks[size_class];
+      cache->free_blocks[size_class] = block->next;
+      --cache->blocks_count[size_class];
+      return block;
+    }
+    return ::operator new(BlockSize(size_class));
+  }
+
+  static void Free(void* memory, size_t size) {
+    if (!memory) {
+      return;
+    }
+    if (size > kMaxBlockSize) {
+      ::operator delete(memory);
+      return;
+    }
+    const size_t size_class = SizeClass(size);
+    Cache* cache = ThisThreadCache();
+    if (!cache || cache->blocks_count[size_class] >= kMaxCachedBlocks) {
+      ::operator delete(memory);
+      return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(memory);
+    block->next = cache->free_blocks[size_class];
+    cache->free_blocks[size_class] = block;
+    ++cache->blocks_count[size_class];
+  }
+
+ private:
+  static const size_t kClassesCount = kMaxBlockSize / kGranularity;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct Cache {
+    FreeBlock* free_blocks[kClassesCount];
+    size_t blocks_count[kClassesCount];
+  };
+
+  static size_t SizeClass(size_t size) {
+    return size ? (size - 1) / kGranularity : 0;
+  }
+
+  static size_t BlockSize(size_t size_class) {
+    return (size_class + 1) * kGranularity;
+  }
+
+  static Cache* ThisThreadCache() {
+    static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+    pthread_once(&key_once, &CreateCacheKey);
+    Cache* cache = static_cast<Cache*>(pthread_getspecific(cache_key()));
+    if (!cache) {
+      // Value initialization zeroes all lists
+      cache = new (std::nothrow) Cache();
+      if (cache && 0 != pthread_setspecific(cache_key(), cache)) {
+        delete cache;
+        cache = NULL;
+      }
+    }
+    return cache;
+  }
+
+  static pthread_key_t& cache_key() {
+    static pthread_key_t key;
+    return key;
+  }
+
+  static void CreateCacheKey() {
+    pthread_key_create(&cache_key(), &DestroyCache);
+  }
+
+  // Called on thread exit, returns all cached blocks to the heap
+  static void DestroyCache(void* data) {
+    Cache* cache = static_cast<Cache*>(data);
+    for (size_t size_class = 0; size_class < kClassesCount; ++size_class) {
+      while (cache->free_blocks[size_class]) {
+        FreeBlock* block = cache->free_blocks[size_class];
+        cache->free_blocks[size_class] = block->next;
+        ::operator delete(block);
+      }
+    }
+    delete cache;
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(SmallObjectPool);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_SMALL_OBJECT_POOL_H_
@@ -34,11 +34,14 @@
 #define SRC_COMPONENTS_INCLUDE_UTILS_ASYNC_RUNNER_H_
 
 #include <string>
-#include <queue>
+#include <deque>
+#include <vector>
 
 #include "thread_delegate.h"
 #include "thread.h"
+#include "thread_pool.h"
 
+#include "utils/macro.h"
 #include "utils/lock.h"
 #include "utils/conditional_variable.h"
 
@@ -50,6 +53,8 @@ namespace threads {
  * into special queue. In case this queue is not empty AsyncRunner will
  * create separate thread for delegate processing. So actualy this AsyncRunner
  * is kind of manager for async functions.
+ * Runner created on thread pool has no own thread, it runs up to max_running
+ * delegates concurrently on pool workers.
  */
 class AsyncRunner {
   public:
@@ -64,14 +69,41 @@ class AsyncRunner {
      */
     explicit AsyncRunner(const std::string& thread_name);
 
+    /**
+     * @brief AsyncRunner constructor, allows to run delegates on shared
+     * thread pool instead of own thread.
+     *
+     * @param thread_name name of runner used for debugging.
+     *
+     * @param pool thread pool to run delegates on, has to outlive runner.
+     *
+     * @param max_running number of delegates run concurrently, delegates
+     * are run one by one in posted order if it is 1.
+     */
+    AsyncRunner(const std::string& thread_name, ThreadPool* pool,
+                size_t max_running = 1);
+
     /**
      * @brief AsyncRun pass obtained delegate into internal queue
      *
      * @param delegate the objet which has to be concuremtly run
      */
     void AsyncRun(threads::ThreadDelegate* delegate);
+
     /**
-     * @brief Stop delegates activity
+     * @brief Cancel removes not started delegate from queue and deletes it
+     *
+     * @param delegate the object passed to AsyncRun
+     *
+     * @return true if delegate was removed, false if it is already started
+     * or unknown
+     */
+    bool Cancel(threads::ThreadDelegate* delegate);
+
+    /**
+     * @brief Stop delegates activity. Runner working on thread pool drops
+     * not started delegates, calls exitThreadMain() of running ones and
+     * waits for them. Must not be called from run delegate.
      */
     void Stop();
 
@@ -100,6 +132,13 @@ class AsyncRunner {
          */
         void runDelegate(threads::ThreadDelegate* delegate);
 
+        /**
+         * @brief cancelDelegate removes not started delegate from queue
+         *
+         * @return true if delegate was found and deleted
+         */
+        bool cancelDelegate(threads::ThreadDelegate* delegate);
+
       private:
         /**
          * @brief processDelegate allows to pop delegate
@@ -112,14 +151,45 @@ class AsyncRunner {
          */
         void waitForDelegate();
 
-        std::queue<threads::ThreadDelegate*> delegates_queue_;
+        std::deque<threads::ThreadDelegate*> delegates_queue_;
         sync_primitives::ConditionalVariable delegate_notifier_;
         sync_primitives::Lock delegates_queue_lock_;
         volatile bool stop_flag_;
     };
 
+    /**
+     * @brief The PoolTask class is scheduled on thread pool to run queued
+     * delegates, runner owns max_running tasks reused for all delegates.
+     */
+    class PoolTask: public threads::ThreadDelegate {
+      public:
+        explicit PoolTask(AsyncRunner* runner);
+        virtual void threadMain();
+        // Delegate being run, guarded by runner pool_lock_
+        threads::ThreadDelegate* current;
+      private:
+        AsyncRunner& runner_;
+    };
+
+    /**
+     * @brief RunPooledDelegates runs queued delegates on pool worker
+     * until queue is empty, then returns task to idle ones.
+     */
+    void RunPooledDelegates(PoolTask* task);
+
+    DISALLOW_COPY_AND_ASSIGN(AsyncRunner);
+
     threads::Thread* thread_;
     AsyncRunnerDelegate* executor_;
+    // Used instead of thread_ and executor_ if runner works on thread pool
+    ThreadPool* pool_;
+    std::deque<threads::ThreadDelegate*> pool_queue_;
+    std::vector<PoolTask*> pool_tasks_;
+    // Tasks not scheduled on pool, runner is idle when all tasks are here
+    std::vector<PoolTask*> idle_tasks_;
+    bool pool_stopped_;
+    sync_primitives::Lock pool_lock_;
+    sync_primitives::ConditionalVariable pool_idle_;
 };
 
 } // namespace threads
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_THREADS_MESSAGE_LOOP_REGISTRY_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_THREADS_MESSAGE_LOOP_REGISTRY_H_
+
+#include <stddef.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace threads {
+
+/*
+ * Registry of message loops alive in process, lets resource sampling
+ * report queue depths without knowing every loop owner
+ */
+class MessageLoopRegistry {
+ public:
+  class Entry {
+   public:
+    virtual size_t QueueDepth() const = 0;
+   protected:
+    virtual ~Entry() {}
+  };
+
+  typedef std::vector<std::pair<std::string, size_t> > Depths;
+
+  static MessageLoopRegistry* instance();
+
+  /*
+   * Entry has to be unregistered before it is destroyed
+   */
+  void Register(const std::string& name, const Entry* entry);
+  void Unregister(const Entry* entry);
+
+  /*
+   * @brief Returns current queue depth of every registered loop
+   */
+  void Snapshot(Depths* depths) const;
+
+ private:
+  MessageLoopRegistry();
+  static void CreateInstance();
+
+  typedef std::vector<std::pair<std::string, const Entry*> > Entries;
+  Entries entries_;
+  mutable sync_primitives::Lock entries_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(MessageLoopRegistry);
+};
+
+}  // namespace threads
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_THREADS_MESSAGE_LOOP_REGISTRY_H_
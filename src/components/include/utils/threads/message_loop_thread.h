@@ -35,11 +35,14 @@
 
 #include <string>
 #include <queue>
+#include <vector>
 
 #include "utils/logger.h"
 #include "utils/macro.h"
 #include "utils/message_queue.h"
 #include "utils/threads/thread.h"
+#include "utils/threads/thread_pool.h"
+#include "utils/threads/message_loop_registry.h"
 #include "utils/shared_ptr.h"
 
 namespace threads {
@@ -57,6 +60,8 @@ class MessageLoopThread {
  public:
   typedef Q Queue;
   typedef typename Queue::value_type Message;
+  // Queue of messages taken out at once
+  typedef typename MessageQueue<Message, Queue>::Queue Batch;
   /*
    * Handler interface. It is called from a thread that is
    * owned by MessageLoopThread so make sure is only accesses
@@ -69,6 +74,18 @@ class MessageLoopThread {
      */
     virtual void Handle(const Message message) = 0; // TODO(dchmerev): Use reference?
 
+    /*
+     * Method called by MessageLoopThread to process all messages taken
+     * out of it's queue at once. Handler has to empty the batch.
+     * Override it to complete work accumulated over several messages.
+     */
+    virtual void HandleBatch(Batch* batch) {
+      while (!batch->empty()) {
+        Handle(batch->front());
+        batch->pop();
+      }
+    }
+
     virtual ~Handler() {}
   };
 
@@ -78,11 +95,22 @@ class MessageLoopThread {
   MessageLoopThread(const std::string& name,
                     Handler* handler,
                     const ThreadOptions& thread_opts = ThreadOptions());
+  /*
+   * Constructs MessageLoopThread which handles messages as serial task
+   * on shared thread pool instead of own thread. Messages are handled
+   * in the order they were posted. Pool has to outlive MessageLoopThread.
+   */
+  MessageLoopThread(const std::string& name,
+                    Handler* handler,
+                    ThreadPool* pool);
   ~MessageLoopThread();
 
   // Places a message to the therad's queue. Thread-safe.
   void PostMessage(const Message& message);
 
+  // Places messages to the thread's queue waking it only once. Thread-safe.
+  void PostMessages(const std::vector<Message>& messages);
+
   // Process already posted messages and stop thread processing. Thread-safe.
   void Shutdown();
 
@@ -99,19 +127,54 @@ class MessageLoopThread {
     virtual void threadMain() OVERRIDE;
     virtual void exitThreadMain() OVERRIDE;
 
-   private:
     // Handle all messages that are in the queue until it is empty
     void DrainQue();
+
+   private:
+    // Messages taken out of message_queue_ at once
+    Batch batch_;
     // Handler that processes messages
     Handler& handler_;
     // Message queue that is actually owned by MessageLoopThread
     MessageQueue<Message, Queue>& message_queue_;
   };
 
+  /*
+   * Task run on thread pool each time new messages are posted
+   */
+  struct PoolTaskDelegate : public threads::ThreadDelegate {
+    explicit PoolTaskDelegate(LoopThreadDelegate* loop_delegate)
+        : loop_delegate_(*loop_delegate) {
+    }
+    virtual void threadMain() OVERRIDE {
+      loop_delegate_.DrainQue();
+    }
+   private:
+    LoopThreadDelegate& loop_delegate_;
+  };
+
+  /*
+   * Reports depth of the queue to MessageLoopRegistry
+   */
+  struct DepthEntry : public MessageLoopRegistry::Entry {
+    explicit DepthEntry(const MessageQueue<Message, Queue>* message_queue)
+        : message_queue_(*message_queue) {
+    }
+    virtual size_t QueueDepth() const OVERRIDE {
+      return message_queue_.size();
+    }
+   private:
+    const MessageQueue<Message, Queue>& message_queue_;
+  };
+
  private:
   MessageQueue<Message, Queue> message_queue_;
+  DepthEntry depth_entry_;
   LoopThreadDelegate* thread_delegate_;
   threads::Thread* thread_;
+  // Used instead of thread_ if messages are handled on thread pool
+  PoolTaskDelegate* pool_task_delegate_;
+  SerialTask* pool_task_;
 };
 
 ///////// Implementation
@@ -120,9 +183,13 @@ template<class Q>
 MessageLoopThread<Q>::MessageLoopThread(const std::string&   name,
                                         Handler*             handler,
                                         const ThreadOptions& thread_opts)
-    : thread_delegate_(new LoopThreadDelegate(&message_queue_, handler)),
+    : depth_entry_(&message_queue_),
+      thread_delegate_(new LoopThreadDelegate(&message_queue_, handler)),
       thread_(threads::CreateThread(name.c_str(),
-                                    thread_delegate_)) {
+                                    thread_delegate_)),
+      pool_task_delegate_(NULL),
+      pool_task_(NULL) {
+  MessageLoopRegistry::instance()->Register(name, &depth_entry_);
   const bool started = thread_->start(thread_opts);
   if (!started) {
     CREATE_LOGGERPTR_LOCAL(logger_, "Utils")
@@ -130,22 +197,63 @@ MessageLoopThread<Q>::MessageLoopThread(const std::string&   name,
   }
 }
 
+template<class Q>
+MessageLoopThread<Q>::MessageLoopThread(const std::string& name,
+                                        Handler*           handler,
+                                        ThreadPool*        pool)
+    : depth_entry_(&message_queue_),
+      thread_delegate_(new LoopThreadDelegate(&message_queue_, handler)),
+      thread_(NULL),
+      pool_task_delegate_(new PoolTaskDelegate(thread_delegate_)),
+      pool_task_(new SerialTask(pool, pool_task_delegate_)) {
+  MessageLoopRegistry::instance()->Register(name, &depth_entry_);
+  CREATE_LOGGERPTR_LOCAL(logger_, "Utils")
+  LOG4CXX_DEBUG(logger_, "Message loop " << name << " works on thread pool");
+}
+
 template<class Q>
 MessageLoopThread<Q>::~MessageLoopThread() {
+  MessageLoopRegistry::instance()->Unregister(&depth_entry_);
   Shutdown();
-  thread_->join();
+  if (thread_) {
+    thread_->join();
+  }
+  delete pool_task_;
+  delete pool_task_delegate_;
   delete thread_delegate_;
-  threads::DeleteThread(thread_);
+  if (thread_) {
+    threads::DeleteThread(thread_);
+  }
 }
 
 template <class Q>
 void MessageLoopThread<Q>::PostMessage(const Message& message) {
   message_queue_.push(message);
+  if (pool_task_) {
+    pool_task_->Notify();
+  }
+}
+
+template <class Q>
+void MessageLoopThread<Q>::PostMessages(const std::vector<Message>& messages) {
+  if (messages.empty()) {
+    return;
+  }
+  message_queue_.push(messages.begin(), messages.end());
+  if (pool_task_) {
+    pool_task_->Notify();
+  }
 }
 
 template <class Q>
 void MessageLoopThread<Q>::Shutdown() {
-  thread_->stop();
+  if (thread_) {
+    thread_->stop();
+    return;
+  }
+  // Already posted messages are handled by scheduled runs
+  message_queue_.Shutdown();
+  pool_task_->WaitIdle();
 }
 
 //////////
@@ -179,8 +287,9 @@ void MessageLoopThread<Q>::LoopThreadDelegate::exitThreadMain() {
 
 template<class Q>
 void MessageLoopThread<Q>::LoopThreadDelegate::DrainQue() {
-  while (!message_queue_.empty()) {
-    handler_.Handle(message_queue_.pop());
+  while (message_queue_.PopAll(batch_) > 0) {
+    handler_.HandleBatch(&batch_);
+    DCHECK(batch_.empty());
   }
 }
 }  // namespace threads
@@ -0,0 +1,242 @@
+﻿/*
+ Copyright (c) 2015, Ford Motor Company
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following
+ disclaimer in the documentation and/or other materials provided with the
+ distribution.
+
+ Neither the name of the Ford Motor Company nor the names of its contributors
+ may be used to endorse or promote products derived from this software
+ without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_THREADS_THREAD_POOL_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_THREADS_THREAD_POOL_H_
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <deque>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "utils/macro.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace threads {
+
+/**
+ * @brief The ThreadPool class is shared executor of short tasks.
+ * Every worker owns its own tasks queue, tasks scheduled from a worker
+ * go to its own queue, other tasks are spread between workers.
+ * Idle worker steals tasks from queues of other workers, so all workers are
+ * busy while there is a work to do.
+ * Tasks are executed in arbitrary order, use Strand or SerialTask to keep
+ * order of related tasks.
+ * Tasks must not block for long time since they occupy a shared worker.
+ */
+class ThreadPool {
+  public:
+    /**
+     * @brief ThreadPool constructor, starts workers threads.
+     *
+     * @param name prefix of workers threads names.
+     *
+     * @param workers_count number of workers, if 0 number of online
+     * processors is used.
+     */
+    ThreadPool(const std::string& name, size_t workers_count);
+
+    /**
+     * @brief Stops and joins all workers. Not executed tasks are dropped.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Schedule passes task to be executed once on some worker.
+     * Task is not owned by pool and has to outlive its execution.
+     *
+     * @param task the object which threadMain() is to be called.
+     */
+    void Schedule(ThreadDelegate* task);
+
+    /**
+     * @brief Stop finishes workers after running tasks are done.
+     */
+    void Stop();
+
+    size_t workers_count() const {
+      return workers_.size();
+    }
+
+  private:
+    struct WorkQueue {
+      sync_primitives::Lock lock;
+      std::deque<ThreadDelegate*> tasks;
+    };
+
+    class WorkerDelegate : public ThreadDelegate {
+      public:
+        WorkerDelegate(ThreadPool* pool, size_t index);
+        virtual void threadMain() OVERRIDE;
+        virtual void exitThreadMain() OVERRIDE;
+        size_t index() const {
+          return index_;
+        }
+      private:
+        ThreadPool& pool_;
+        const size_t index_;
+    };
+
+    /**
+     * @brief TakeTask takes task from queue of worker with passed index,
+     * steals it from other workers if own queue is empty.
+     * @return task to run or NULL if there are no tasks
+     */
+    ThreadDelegate* TakeTask(size_t index);
+
+    /**
+     * @brief WaitForTask blocks worker while no tasks are scheduled.
+     * @return false if pool is stopped
+     */
+    bool WaitForTask();
+
+    std::vector<WorkQueue*> queues_;
+    std::vector<WorkerDelegate*> delegates_;
+    std::vector<Thread*> workers_;
+    // Identifies worker of calling thread
+    pthread_key_t current_worker_key_;
+
+    // Number of scheduled but not taken tasks
+    volatile uint32_t pending_tasks_;
+    volatile uint32_t sleeping_workers_;
+    volatile uint32_t next_queue_;
+    volatile bool stopped_;
+    sync_primitives::Lock idle_lock_;
+    sync_primitives::ConditionalVariable task_available_;
+
+    DISALLOW_COPY_AND_ASSIGN(ThreadPool);
+};
+
+/**
+ * @brief The SerialTask class runs its delegate on a pool each time
+ * Notify() is called, but never runs it concurrently with itself.
+ * Notifications received while delegate runs cause single rerun,
+ * so delegate has to process all accumulated work on each run.
+ */
+class SerialTask {
+  public:
+    /**
+     * @param pool pool to run delegate on.
+     * @param delegate the object which threadMain() is called, not owned.
+     */
+    SerialTask(ThreadPool* pool, ThreadDelegate* delegate);
+    ~SerialTask();
+
+    /**
+     * @brief Notify schedules delegate run. Thread-safe.
+     */
+    void Notify();
+
+    /**
+     * @brief WaitIdle blocks until all requested runs are done.
+     * Must not be called from the delegate.
+     */
+    void WaitIdle();
+
+  private:
+    class RunnerDelegate : public ThreadDelegate {
+      public:
+        explicit RunnerDelegate(SerialTask* task);
+        virtual void threadMain() OVERRIDE;
+      private:
+        SerialTask& task_;
+    };
+
+    void Run();
+
+    ThreadPool& pool_;
+    ThreadDelegate& delegate_;
+    RunnerDelegate runner_;
+    volatile uint32_t notifications_count_;
+    sync_primitives::Lock idle_lock_;
+    sync_primitives::ConditionalVariable idle_;
+
+    DISALLOW_COPY_AND_ASSIGN(SerialTask);
+};
+
+/**
+ * @brief The Strand class executes passed delegates one by one on a pool
+ * keeping the order delegates were posted in.
+ */
+class Strand {
+  public:
+    explicit Strand(ThreadPool* pool);
+
+    /**
+     * @brief Drops not started delegates and waits for running one.
+     */
+    ~Strand();
+
+    /**
+     * @brief Post passes delegate to be run after all previously posted.
+     * Delegate is deleted after run. Thread-safe.
+     *
+     * @param delegate the object which threadMain() is called.
+     */
+    void Post(ThreadDelegate* delegate);
+
+    /**
+     * @brief Stop drops not started delegates and waits for running one.
+     * Delegates posted after stop are deleted right away.
+     * Must not be called from posted delegate.
+     */
+    void Stop();
+
+  private:
+    class DrainDelegate : public ThreadDelegate {
+      public:
+        explicit DrainDelegate(Strand* strand);
+        virtual void threadMain() OVERRIDE;
+      private:
+        Strand& strand_;
+    };
+
+    void Drain();
+
+    std::queue<ThreadDelegate*> delegates_queue_;
+    sync_primitives::Lock delegates_queue_lock_;
+    volatile bool stopped_;
+    DrainDelegate drain_delegate_;
+    SerialTask serial_task_;
+
+    DISALLOW_COPY_AND_ASSIGN(Strand);
+};
+
+}  // namespace threads
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_THREADS_THREAD_POOL_H_
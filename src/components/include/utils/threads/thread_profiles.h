@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_THREADS_THREAD_PROFILES_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_THREADS_THREAD_PROFILES_H_
+
+#include <stddef.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace threads {
+
+/*
+ * Stack size, scheduling and CPU affinity thread is started with,
+ * default fields keep settings of platform
+ */
+struct ThreadProfile {
+  enum SchedulingPolicy {
+    kInheritPolicy,
+    kOtherPolicy,
+    kFifoPolicy,
+    kRoundRobinPolicy
+  };
+
+  ThreadProfile();
+
+  /*
+   * @brief Parses "stack size in KB, policy, priority, CPUs" string,
+   * policy is OTHER, FIFO or RR, CPUs are separated by spaces and may be
+   * ranges like 2-3. Empty or missing field keeps its default.
+   * @return false if some field is malformed
+   */
+  bool Parse(const std::string& value);
+
+  size_t stack_size;
+  SchedulingPolicy policy;
+  int priority;
+  std::vector<int> cpus;
+};
+
+/*
+ * Profiles of threads by thread name prefix, thread takes the profile
+ * of the longest prefix of its name when it is started
+ */
+class ThreadProfiles {
+ public:
+  typedef std::vector<std::pair<std::string, ThreadProfile> > Profiles;
+
+  static ThreadProfiles* instance();
+
+  /*
+   * @brief Replaces all profiles, threads already started keep
+   * settings they were started with
+   */
+  void Set(const Profiles& profiles);
+
+  /*
+   * @brief Looks profile of thread up
+   * @return false if no prefix matches name of thread
+   */
+  bool Find(const std::string& thread_name, ThreadProfile* profile) const;
+
+ private:
+  ThreadProfiles();
+  static void CreateInstance();
+
+  Profiles profiles_;
+  mutable sync_primitives::Lock profiles_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadProfiles);
+};
+
+}  // namespace threads
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_THREADS_THREAD_PROFILES_H_
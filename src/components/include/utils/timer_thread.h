@@ -43,19 +43,17 @@
 #include "utils/lock.h"
 #include "utils/logger.h"
 #include "utils/macro.h"
-#include "utils/timer_thread.h"
-#include "utils/threads/thread.h"
-#include "utils/threads/thread_delegate.h"
+#include "utils/timer_wheel.h"
 
 namespace timer {
 // TODO(AKutsan): Remove this logger after bugfix
 CREATE_LOGGERPTR_GLOBAL(logger_, "Utils")
 
-class TimerDelegate;
-
 /**
  * \class TimerThread
- * \brief TimerThread class provide possibility to run timer in a separate thread.
+ * \brief TimerThread class provide possibility to run callback on timeout.
+ * Timers do not own threads, all of them are served by TimerWheel
+ * dispatch thread.
  * The client should specify callee and const callback function.
  * Example usage:
  *
@@ -72,16 +70,14 @@ class TimerDelegate;
 template<class T>
 class TimerThread {
  public:
-  friend class TimerDelegate;
-  friend class TimerLooperDelegate;
-
   /**
    * @brief Default constructor
    *
-   * @param name - display string to identify the thread.
+   * @param name - display string to identify the timer.
    * @param callee A class that use timer
    * @param f    CallBackFunction which will be called on timeout
    *  Attention! "f()" will be called not in main thread but in timer thread
+   *  shared by all timers, so it must be short
    *  Never use stop() and start() methods inside f
    * @param is_looper    Define this timer as looper,
    *  if true, TimerThread will call "f()" function every time out
@@ -139,9 +135,8 @@ class TimerThread {
   virtual void pause();
 
   /**
-   * @brief Stop timer update timeout and start timer again
-   * Note that it cancel thread of timer, If you use it from callback,
-   * it probably will stop execution of callback function
+   * @brief Update timeout and start timer again from now
+   * Can be used from callback of looper timer to set next timeout
    * @param timeout_seconds new timeout value
    *
    */
@@ -155,79 +150,25 @@ class TimerThread {
 
  private:
   /**
-   * @brief Delegate release timer, will call callback function one time
+   * @brief Timer placed on the TimerWheel on behalf of TimerThread
    */
-  class TimerDelegate : public threads::ThreadDelegate {
+  class WheelTimer : public TimerWheel::Timer {
    public:
-    /**
-     * @brief Default constructor
-     *
-     * @param timer_thread The Timer_thread pointer
-     */
-    explicit TimerDelegate(TimerThread* timer_thread);
-
-    /**
-     * @brief Destructor
-     */
-    virtual ~TimerDelegate();
-
-    /**
-     * @brief Thread main function.
-     */
-    virtual void threadMain();
-
-    /**
-     * @brief Called by thread::thread to free all allocated resources.
-     */
-    virtual void exitThreadMain();
-
-    /**
-     * @brief Set new Timeout
-     * @param timeout_seconds New timeout to be set
-     */
-    virtual void setTimeOut(const uint32_t timeout_seconds);
-
-   protected:
-    TimerThread* timer_thread_;
-    uint32_t timeout_seconds_;
-    sync_primitives::Lock state_lock_;
-    sync_primitives::ConditionalVariable termination_condition_;
-    volatile bool stop_flag_;
-    int32_t calculateMillisecondsLeft();
-
+    explicit WheelTimer(TimerThread* timer_thread)
+        : timer_thread_(timer_thread) {
+    }
+    virtual void OnTimeout() OVERRIDE;
    private:
-    DISALLOW_COPY_AND_ASSIGN(TimerDelegate);
+    TimerThread* timer_thread_;
   };
 
-  /**
-   * @brief Delegate release looper timer.
-   * Will call delegate every timeout function while stop()
-   * won't be called
-   */
-  class TimerLooperDelegate : public TimerDelegate {
-   public:
-    /**
-     * @brief Default constructor
-     *
-     * @param timer_thread The Timer_thread pointer
-     * @param timeout      Timeout to be set
-     */
-    explicit TimerLooperDelegate(TimerThread* timer_thread);
-
-    /**
-     * @brief Thread main function.
-     */
-    virtual void threadMain();
-
-   private:
-    DISALLOW_COPY_AND_ASSIGN(TimerLooperDelegate);
-  };
-  threads::Thread* thread_;
   void (T::*callback_)();
   T* callee_;
-  TimerDelegate* delegate_;
+  WheelTimer wheel_timer_;
   std::string name_;
   volatile bool is_looper_;
+  volatile bool is_running_;
+  volatile uint32_t timeout_seconds_;
 
   DISALLOW_COPY_AND_ASSIGN(TimerThread);
 };
@@ -235,24 +176,19 @@ class TimerThread {
 template<class T>
 TimerThread<T>::TimerThread(const char* name, T* callee, void (T::*f)(),
                             bool is_looper)
-    : thread_(NULL),
-      callback_(f),
+    : callback_(f),
       callee_(callee),
-      delegate_(NULL),
+      wheel_timer_(this),
       name_(name),
-      is_looper_(is_looper) {
-  delegate_ =
-      is_looper_ ? new TimerLooperDelegate(this) : new TimerDelegate(this);
-
-  thread_ = threads::CreateThread(name_.c_str(), delegate_);
+      is_looper_(is_looper),
+      is_running_(false),
+      timeout_seconds_(0) {
 }
 
 template<class T>
 TimerThread<T>::~TimerThread() {
   LOG4CXX_DEBUG(logger_, "TimerThread is to be destroyed " << name_);
-  thread_->join();
-  delete delegate_;
-  threads::DeleteThread(thread_);
+  stop();
   callback_ = NULL;
   callee_ = NULL;
 }
@@ -264,8 +200,8 @@ void TimerThread<T>::start(uint32_t timeout_seconds) {
     LOG4CXX_INFO(logger_, "TimerThread start needs stop " << name_);
     stop();
   }
+  is_running_ = true;
   updateTimeOut(timeout_seconds);
-  thread_->start();
 }
 
 template<class T>
@@ -279,15 +215,14 @@ void TimerThread<T>::start(uint32_t timeout_seconds, T* callee,
 template<class T>
 void TimerThread<T>::stop() {
   LOG4CXX_AUTO_TRACE(logger_);
-  DCHECK(thread_);
   LOG4CXX_DEBUG(logger_, "Stopping timer  " << name_);
-  thread_->join();
+  is_running_ = false;
+  TimerWheel::instance()->Cancel(&wheel_timer_);
 }
 
 template<class T>
 bool TimerThread<T>::isRunning() {
-  DCHECK(thread_);
-  return thread_->is_running();
+  return is_running_;
 }
 
 template<class T>
@@ -299,7 +234,12 @@ void TimerThread<T>::pause() {
 
 template<class T>
 void TimerThread<T>::updateTimeOut(const uint32_t timeout_seconds) {
-  delegate_->setTimeOut(timeout_seconds);
+  timeout_seconds_ = timeout_seconds;
+  if (is_running_) {
+    const uint64_t milliseconds_in_second = 1000;
+    TimerWheel::instance()->Arm(&wheel_timer_,
+                                milliseconds_in_second * timeout_seconds);
+  }
 }
 
 template<class T> void TimerThread<T>::onTimeOut() const {
@@ -309,103 +249,18 @@ template<class T> void TimerThread<T>::onTimeOut() const {
 }
 
 template<class T>
-TimerThread<T>::TimerDelegate::TimerDelegate(TimerThread* timer_thread)
-    : timer_thread_(timer_thread),
-      timeout_seconds_(0),
-      state_lock_(true),
-      stop_flag_(false) {
-  DCHECK(timer_thread_);
-}
-
-template<class T>
-TimerThread<T>::TimerLooperDelegate::TimerLooperDelegate(
-    TimerThread* timer_thread)
-    : TimerDelegate(timer_thread) {
-}
-
-template<class T>
-TimerThread<T>::TimerDelegate::~TimerDelegate() {
-  timer_thread_ = NULL;
-}
-
-template<class T>
-void TimerThread<T>::TimerDelegate::threadMain() {
-  using sync_primitives::ConditionalVariable;
-  sync_primitives::AutoLock auto_lock(state_lock_);
-  stop_flag_ = false;
-  while (!stop_flag_) {
-    // Sleep
-    int32_t wait_milliseconds_left = TimerDelegate::calculateMillisecondsLeft();
-    ConditionalVariable::WaitStatus wait_status =
-        termination_condition_.WaitFor(auto_lock, wait_milliseconds_left);
-    // Quit sleeping or continue sleeping in case of spurious wake up
-    if (ConditionalVariable::kTimeout == wait_status
-        || wait_milliseconds_left <= 0) {
-      LOG4CXX_TRACE(logger_,
-                    "Timer timeout " << wait_milliseconds_left << " ms");
-      timer_thread_->onTimeOut();
-      return;
-    } else {
-      LOG4CXX_DEBUG(logger_,
-                    "Timeout reset force: " << TimerDelegate::timeout_seconds_);
-      return;
-    }
-  }
-}
-
-template<class T>
-void TimerThread<T>::TimerLooperDelegate::threadMain() {
-  using sync_primitives::ConditionalVariable;
-  sync_primitives::AutoLock auto_lock(TimerDelegate::state_lock_);
-  TimerDelegate::stop_flag_ = false;
-  while (!TimerDelegate::stop_flag_) {
-    int32_t wait_milliseconds_left = TimerDelegate::calculateMillisecondsLeft();
-    ConditionalVariable::WaitStatus wait_status =
-        TimerDelegate::termination_condition_.WaitFor(auto_lock,
-                                                      wait_milliseconds_left);
-    // Quit sleeping or continue sleeping in case of spurious wake up
-    if (ConditionalVariable::kTimeout == wait_status
-        || wait_milliseconds_left <= 0) {
-      LOG4CXX_TRACE(logger_,
-                    "Timer timeout " << wait_milliseconds_left << " ms");
-      TimerDelegate::timer_thread_->onTimeOut();
-    } else {
-      LOG4CXX_DEBUG(logger_,
-                    "Timeout reset force: " << TimerDelegate::timeout_seconds_);
-    }
-  }
-}
-
-template<class T>
-void TimerThread<T>::TimerDelegate::exitThreadMain() {
-  sync_primitives::AutoLock auto_lock(state_lock_);
-  stop_flag_ = true;
-  termination_condition_.NotifyOne();
-}
-
-template<class T>
-void TimerThread<T>::TimerDelegate::setTimeOut(const uint32_t timeout_seconds) {
-  timeout_seconds_ = timeout_seconds;
-  termination_condition_.NotifyOne();
-}
-
-template<class T>
-int32_t TimerThread<T>::TimerThread::TimerDelegate::calculateMillisecondsLeft() {
-  time_t cur_time = time(NULL);
-  time_t end_time = std::numeric_limits<time_t>::max();
-  if (TimerDelegate::timeout_seconds_ + cur_time
-      > TimerDelegate::timeout_seconds_) {  // no overflow occurred
-    end_time = cur_time + TimerDelegate::timeout_seconds_;
+void TimerThread<T>::WheelTimer::OnTimeout() {
+  LOG4CXX_TRACE(logger_, "Timer timeout " << timer_thread_->name_);
+  if (timer_thread_->is_looper_) {
+    // Rearm before callback, so callback is able to update timeout
+    timer_thread_->updateTimeOut(timer_thread_->timeout_seconds_);
+    timer_thread_->onTimeOut();
+    return;
   }
-
-  int64_t wait_seconds_left = static_cast<int64_t>(difftime(end_time, cur_time));
-  int32_t wait_milliseconds_left = std::numeric_limits<int32_t>::max();
-  const int32_t milliseconds_in_second = 1000;
-  if (wait_seconds_left
-      < std::numeric_limits<int32_t>::max() / milliseconds_in_second) {
-    wait_milliseconds_left = milliseconds_in_second * wait_seconds_left;
+  timer_thread_->onTimeOut();
+  if (!TimerWheel::instance()->IsArmed(this)) {
+    timer_thread_->is_running_ = false;
   }
-  return wait_milliseconds_left;
 }
 
 }  // namespace timer
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_TIMER_WHEEL_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/singleton.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace timer {
+
+/**
+ * \class TimerWheel
+ * \brief Hierarchical timing wheel serving all timers of the process
+ * from single dispatch thread.
+ * Arming and cancelling of timer is O(1), timers with far expiration
+ * are cascaded to finer levels of the wheel when their time approaches.
+ * Callbacks are called from dispatch thread one by one, so they have
+ * to be short.
+ */
+class TimerWheel : public utils::Singleton<TimerWheel> {
+ public:
+  /**
+   * \brief Base class for timers placed on the wheel
+   */
+  class Timer {
+   public:
+    Timer();
+    /**
+     * \brief Timer has to be cancelled before destruction
+     */
+    virtual ~Timer();
+
+    /**
+     * \brief Called from dispatch thread on expiration
+     */
+    virtual void OnTimeout() = 0;
+
+   private:
+    friend class TimerWheel;
+    Timer* prev_;
+    Timer* next_;
+    uint64_t expiration_tick_;
+    volatile bool armed_;
+
+    DISALLOW_COPY_AND_ASSIGN(Timer);
+  };
+
+  /**
+   * \brief Duration of single wheel tick
+   */
+  static const uint32_t kTickMilliseconds = 100;
+
+  /**
+   * \brief Places timer on the wheel, previously armed timer is rearmed.
+   * Can be called from timer callbacks.
+   * \param timer Timer to be armed
+   * \param timeout_milliseconds Timeout to call timer callback after
+   */
+  void Arm(Timer* timer, uint64_t timeout_milliseconds);
+
+  /**
+   * \brief Removes timer from the wheel. If callback of the timer is being
+   * run it waits for callback to finish unless it is called from callback.
+   * \param timer Timer to be cancelled
+   */
+  void Cancel(Timer* timer);
+
+  /**
+   * \brief Tells whether timer is waiting for expiration
+   */
+  bool IsArmed(const Timer* timer) const;
+
+  ~TimerWheel();
+
+ private:
+  /**
+   * \brief Circular list of timers with sentinel element
+   */
+  class Slot : public Timer {
+   public:
+    Slot();
+    virtual void OnTimeout() OVERRIDE;
+    bool empty() const {
+      return next_ == this;
+    }
+  };
+
+  class DispatchDelegate : public threads::ThreadDelegate {
+   public:
+    explicit DispatchDelegate(TimerWheel* wheel);
+    virtual void threadMain() OVERRIDE;
+    virtual void exitThreadMain() OVERRIDE;
+   private:
+    TimerWheel& wheel_;
+  };
+
+  TimerWheel();
+
+  static uint64_t NowTicks();
+  static void Link(Slot* slot, Timer* timer);
+  static void Unlink(Timer* timer);
+  static void MoveAll(Slot* from, Slot* to);
+
+  void Insert(Timer* timer);
+  void Cascade(size_t level);
+  void ProcessTick();
+  void RunExpired(sync_primitives::AutoLock& auto_lock);
+  uint64_t NextExpirationTick() const;
+  void Dispatch();
+  void Stop();
+
+  static const size_t kRootSlotsBits = 8;
+  static const size_t kRootSlotsCount = 1 << kRootSlotsBits;
+  static const size_t kLevelSlotsBits = 6;
+  static const size_t kLevelSlotsCount = 1 << kLevelSlotsBits;
+  static const size_t kLevelsCount = 4;
+
+  Slot root_slots_[kRootSlotsCount];
+  Slot level_slots_[kLevelsCount][kLevelSlotsCount];
+  Slot expired_;
+  uint64_t current_tick_;
+  uint64_t wakeup_tick_;
+  size_t armed_count_;
+  Timer* running_timer_;
+  volatile bool stop_flag_;
+
+  mutable sync_primitives::Lock wheel_lock_;
+  sync_primitives::ConditionalVariable wakeup_condition_;
+  sync_primitives::ConditionalVariable callback_finished_;
+  DispatchDelegate* dispatch_delegate_;
+  threads::Thread* dispatch_thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+  FRIEND_BASE_SINGLETON_CLASS(TimerWheel);
+};
+
+}  // namespace timer
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_TIMER_WHEEL_H_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, Ford Motor Company
+ * Copyright (c) 2015, Ford Motor Company
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -30,69 +30,59 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_FROM_MIC_TO_FILE_RECORDER_THREAD_H_
-#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_FROM_MIC_TO_FILE_RECORDER_THREAD_H_
-
-#include <net/if.h>
-#include <gst/gst.h>
-#include <string>
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_AUDIO_RING_BUFFER_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_AUDIO_RING_BUFFER_H_
 
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include "utils/macro.h"
 #include "utils/lock.h"
-#include "utils/threads/thread.h"
-#include "utils/threads/thread_delegate.h"
 
 namespace media_manager {
 
-class FromMicToFileRecorderThread : public threads::ThreadDelegate {
-  public:
-    FromMicToFileRecorderThread(const std::string& output_file,
-                                int32_t duration);
-    ~FromMicToFileRecorderThread();
-    void threadMain();
-
-    void exitThreadMain();
-
-    void set_output_file(const std::string& output_file);
-    void set_record_duration(int32_t duration);
-
-  private:
-    int32_t argc_;
-    gchar** argv_;
-
-    const std::string oKey_;
-    const std::string tKey_;
-
-    static GMainLoop* loop;
-    threads::Thread* sleepThread_;
-    bool shouldBeStoped_;
-    sync_primitives::Lock stopFlagLock_;
-
-    std::string outputFileName_, durationString_;
-
-    typedef struct {
-      GstElement* pipeline;
-      gint duration;
-    } GstTimeout;
-
-    void initArgs();
-
-    void psleep(void* timeout);
-
-    class SleepThreadDelegate : public threads::ThreadDelegate {
-      public:
-        explicit SleepThreadDelegate(GstTimeout timeout);
-
-        void threadMain();
-
-      private:
-        GstTimeout timeout_;
-
-        DISALLOW_COPY_AND_ASSIGN(SleepThreadDelegate);
-    };
-
-    DISALLOW_COPY_AND_ASSIGN(FromMicToFileRecorderThread);
+/*
+ * @brief Fixed size buffer of captured audio between microphone pipeline
+ * and audio pass thru sender. When sender falls behind, oldest bytes are
+ * overwritten, so apps get the latest audio and memory use stays bounded.
+ * Writes of whole samples into buffer of size multiple of sample size
+ * keep samples aligned.
+ */
+class AudioRingBuffer {
+ public:
+  explicit AudioRingBuffer(size_t capacity);
+
+  /*
+   * @brief Appends bytes, dropping oldest ones if buffer overflows
+   */
+  void Write(const uint8_t* data, size_t size);
+
+  /*
+   * @brief Takes all buffered bytes
+   *
+   * @param data Receives bytes in order they were written
+   *
+   * @return Count of bytes taken
+   */
+  size_t Read(std::vector<uint8_t>* data);
+
+  void Clear();
+
+  size_t size() const;
+
+  // Bytes overwritten before being read since construction
+  uint64_t dropped_bytes() const;
+
+ private:
+  std::vector<uint8_t> storage_;
+  size_t begin_;
+  size_t size_;
+  uint64_t dropped_bytes_;
+  mutable sync_primitives::Lock lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(AudioRingBuffer);
 };
 
 }  // namespace media_manager
 
-#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_FROM_MIC_TO_FILE_RECORDER_THREAD_H_
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_AUDIO_RING_BUFFER_H_
@@ -34,6 +34,8 @@
 #define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_AUDIO_STREAM_SENDER_THREAD_H_
 
 #include <string>
+#include <fstream>
+#include <vector>
 #include "utils/macro.h"
 #include "utils/threads/thread_delegate.h"
 #include "utils/conditional_variable.h"
@@ -48,6 +50,8 @@ class SmartObject;
 
 namespace media_manager {
 
+class AudioRingBuffer;
+
 typedef enum {
   SR_INVALID = -1,
   SR_8KHZ = 0,
@@ -69,7 +73,9 @@ typedef enum {
 
 /*
  * @brief AudioStreamSenderThread class used to read binary data written from microphone
- * and send it every 1 second to mobile device.
+ * and send it every AudioPassThruChunkInterval milliseconds to mobile device.
+ * Recording file is kept open and only bytes appended since previous chunk
+ * are read. Audio captured into ring buffer is sent without file.
  */
 class AudioStreamSenderThread : public threads::ThreadDelegate {
   public:
@@ -82,6 +88,11 @@ class AudioStreamSenderThread : public threads::ThreadDelegate {
     AudioStreamSenderThread(const std::string fileName,
                             uint32_t session_key);
 
+    /*
+     * @brief Sends audio taken from buffer
+     */
+    AudioStreamSenderThread(AudioRingBuffer* buffer, uint32_t session_key);
+
     /*
      * @brief AudioStreamSenderThread class destructor
      */
@@ -109,13 +120,24 @@ class AudioStreamSenderThread : public threads::ThreadDelegate {
 
     void sendAudioChunkToMobile();
 
+    /*
+     * @brief Reads bytes appended to recording file after offset_
+     *
+     * @param data Receives read bytes
+     *
+     * @return false if file could not be read
+     */
+    bool ReadNewData(std::vector<uint8_t>& data);
 
     bool getShouldBeStopped();
     void setShouldBeStopped(bool should_stop);
 
     uint32_t                              session_key_;
     const std::string                     fileName_;
-    int32_t                               offset_;
+    AudioRingBuffer*                      buffer_;
+    std::ifstream                         file_;
+    std::streamoff                        offset_;
+    uint32_t                              chunk_interval_ms_;
     volatile bool                         shouldBeStoped_;
     sync_primitives::Lock                 shouldBeStoped_lock_;
     sync_primitives::ConditionalVariable  shouldBeStoped_cv_;
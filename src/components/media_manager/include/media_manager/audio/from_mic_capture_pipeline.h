@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_FROM_MIC_CAPTURE_PIPELINE_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_FROM_MIC_CAPTURE_PIPELINE_H_
+
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace media_manager {
+
+class AudioRingBuffer;
+
+/*
+ * @brief Microphone capture pipeline built once and kept paused between
+ * audio pass thru sessions, so session starts without building pipeline
+ * and opening device again. Appsink hands PCM samples to ring buffer
+ * read by audio pass thru sender, nothing goes through file.
+ * Samples are written only while capture is started and not longer
+ * than requested duration.
+ */
+class FromMicCapturePipeline {
+  public:
+    // Format of captured samples, 16 bit little endian mono PCM
+    static const int32_t kSamplingRate = 16000;
+    static const int32_t kBytesPerSample = 2;
+
+    explicit FromMicCapturePipeline(AudioRingBuffer* buffer);
+    ~FromMicCapturePipeline();
+
+    /*
+     * @brief Builds pipeline and pauses it, so it is ready to start
+     *
+     * @return false if pipeline could not be built
+     */
+    bool Prepare();
+
+    /*
+     * @brief Starts writing samples to buffer
+     *
+     * @param duration_ms Milliseconds to capture for,
+     * not limited if not positive
+     */
+    bool Start(int32_t duration_ms);
+
+    /*
+     * @brief Stops writing samples and pauses pipeline
+     */
+    void Stop();
+
+  private:
+    bool IsCapturing();
+
+    static GstFlowReturn OnNewSample(GstAppSink* sink, gpointer user_data);
+    static GstBusSyncReply OnBusMessage(GstBus* bus, GstMessage* message,
+                                        gpointer user_data);
+
+    AudioRingBuffer* buffer_;
+    GstElement* pipeline_;
+    sync_primitives::Lock capture_lock_;
+    bool capturing_;
+    // Monotonic time capture ends at, 0 if not limited
+    int64_t deadline_ms_;
+
+    DISALLOW_COPY_AND_ASSIGN(FromMicCapturePipeline);
+};
+
+}  // namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_FROM_MIC_CAPTURE_PIPELINE_H_
@@ -33,29 +33,29 @@
 #ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_FROM_MIC_RECORDER_ADAPTER_H_
 #define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_AUDIO_FROM_MIC_RECORDER_ADAPTER_H_
 
-#include <string>
 #include "media_manager/media_adapter_impl.h"
-
-namespace threads {
-class Thread;
-}
+#include "media_manager/audio/from_mic_capture_pipeline.h"
 
 namespace media_manager {
 
+class AudioRingBuffer;
+
+/*
+ * @brief Captures microphone of audio pass thru into ring buffer,
+ * pipeline is prepared once and only gated per application
+ */
 class FromMicRecorderAdapter : public MediaAdapterImpl {
   public:
-    FromMicRecorderAdapter();
+    explicit FromMicRecorderAdapter(AudioRingBuffer* buffer);
     ~FromMicRecorderAdapter();
     void SendData(int32_t application_key,
                   const ::protocol_handler::RawMessagePtr message) {}
     void StartActivity(int32_t application_key);
     void StopActivity(int32_t application_key);
     bool is_app_performing_activity(int32_t application_key);
-    void set_output_file(const std::string& output_file);
     void set_duration(int32_t duration);
   private:
-    threads::Thread* recorder_thread_;
-    std::string output_file_;
+    FromMicCapturePipeline pipeline_;
     const int32_t kDefaultDuration;
     int32_t duration_;
     DISALLOW_COPY_AND_ASSIGN(FromMicRecorderAdapter);
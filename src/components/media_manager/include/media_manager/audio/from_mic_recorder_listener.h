@@ -41,10 +41,16 @@ class Thread;
 }
 
 namespace media_manager {
+class AudioRingBuffer;
+
 class FromMicRecorderListener : public MediaAdapterListener {
   public:
     explicit FromMicRecorderListener(
       const std::string& file_name);
+    /*
+     * @brief Sends audio captured into buffer instead of file
+     */
+    explicit FromMicRecorderListener(AudioRingBuffer* buffer);
     ~FromMicRecorderListener();
     virtual void OnDataReceived(
       int32_t application_key,
@@ -58,6 +64,7 @@ class FromMicRecorderListener : public MediaAdapterListener {
   private:
     threads::Thread* reader_;
     std::string file_name_;
+    AudioRingBuffer* buffer_;
     int32_t current_application_;
     DISALLOW_COPY_AND_ASSIGN(FromMicRecorderListener);
 };
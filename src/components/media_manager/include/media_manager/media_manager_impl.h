@@ -45,6 +45,8 @@
 
 namespace media_manager {
 
+class AudioRingBuffer;
+
 class MediaManagerImpl : public MediaManager,
   public protocol_handler::ProtocolObserver,
   public utils::Singleton<MediaManagerImpl> {
@@ -75,6 +77,8 @@ class MediaManagerImpl : public MediaManager,
     MediaAdapter*                      a2dp_player_;
     MediaAdapterImpl*                  from_mic_recorder_;
     MediaListenerPtr                   from_mic_listener_;
+    // Audio captured from microphone until audio pass thru sender takes it
+    AudioRingBuffer*                   from_mic_buffer_;
     MediaAdapterImpl*                  video_streamer_;
     MediaAdapterImpl*                  audio_streamer_;
     uint32_t                           stop_streaming_timeout_;
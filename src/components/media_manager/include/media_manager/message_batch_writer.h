@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_MESSAGE_BATCH_WRITER_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_MESSAGE_BATCH_WRITER_H_
+
+#include <stdint.h>
+#include "protocol/raw_message.h"
+
+namespace media_manager {
+
+/*
+ * @brief Writes data of messages to descriptor in order with as few
+ * system calls as possible. Data is gathered right from message buffers,
+ * so nothing is copied in user space; messages have to be kept alive
+ * by caller until function returns.
+ * Non-blocking descriptor is polled for readiness whenever it is full,
+ * message is never left written partially unless writing is stopped.
+ *
+ * @param fd         Descriptor of socket or pipe
+ * @param messages   Messages to write, null messages are skipped
+ * @param is_socket  True if fd is socket, so SIGPIPE has to be suppressed
+ * @param stop_flag  If not NULL, waiting for readiness is abandoned
+ *                   once flag is set
+ *
+ * @return false if writing failed or was stopped, data may be written
+ * partially then
+ */
+bool WriteMessages(int32_t fd,
+                   const protocol_handler::RawMessageList& messages,
+                   bool is_socket,
+                   const volatile bool* stop_flag = NULL);
+
+}  // namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_MESSAGE_BATCH_WRITER_H_
@@ -36,17 +36,19 @@
 #include <string>
 #include "media_manager/media_adapter_impl.h"
 #include "utils/shared_ptr.h"
-#include "utils/message_queue.h"
+#include "media_manager/stream_queue.h"
 #include "utils/threads/thread.h"
 #include "utils/threads/thread_delegate.h"
 
 namespace media_manager {
 
-using ::utils::MessageQueue;
-
 class PipeStreamerAdapter : public MediaAdapterImpl {
   public:
-    PipeStreamerAdapter();
+    /*
+     * @param stream_name  Name of stream for statistics
+     * @param is_video     True if stream carries H.264 video
+     */
+    PipeStreamerAdapter(const std::string& stream_name, bool is_video);
     virtual ~PipeStreamerAdapter();
     virtual void SendData(int32_t application_key,
                           const ::protocol_handler::RawMessagePtr message);
@@ -98,16 +100,24 @@ class PipeStreamerAdapter : public MediaAdapterImpl {
         void close();
 
       private:
+        /*
+         * @brief Moves all queued messages to batch_
+         *
+         * @return Count of frames dropped meanwhile
+         */
+        size_t TakeMessages();
+
         PipeStreamerAdapter*        server_;
         int32_t                     pipe_fd_;
         volatile bool               stop_flag_;
+        protocol_handler::RawMessageList batch_;
 
         DISALLOW_COPY_AND_ASSIGN(Streamer);
     };
 
     bool                                          is_ready_;
     threads::Thread*                              thread_;
-    MessageQueue<protocol_handler::RawMessagePtr> messages_;
+    StreamQueue messages_;
 
     DISALLOW_COPY_AND_ASSIGN(PipeStreamerAdapter);
 };
@@ -37,17 +37,19 @@
 #include "media_manager/media_adapter_impl.h"
 #include "utils/logger.h"
 #include "utils/shared_ptr.h"
-#include "utils/message_queue.h"
+#include "media_manager/stream_queue.h"
 #include "utils/threads/thread.h"
 #include "utils/threads/thread_delegate.h"
 
 namespace media_manager {
 
-using ::utils::MessageQueue;
-
 class SocketStreamerAdapter : public MediaAdapterImpl {
   public:
-    SocketStreamerAdapter();
+    /*
+     * @param stream_name  Name of stream for statistics
+     * @param is_video     True if stream carries H.264 video
+     */
+    SocketStreamerAdapter(const std::string& stream_name, bool is_video);
     virtual ~SocketStreamerAdapter();
     virtual void SendData(int32_t application_key,
                           const ::protocol_handler::RawMessagePtr message);
@@ -112,9 +114,16 @@ class SocketStreamerAdapter : public MediaAdapterImpl {
         /*
          * Sends data to connected client
          *
-         * @param block Pointer to the data
+         * @param messages Messages to be sent in order
+         */
+        bool send(const ::protocol_handler::RawMessageList& messages);
+
+        /*
+         * Moves all queued messages to batch_
+         *
+         * @return Count of frames dropped meanwhile
          */
-        bool send(const ::protocol_handler::RawMessagePtr msg);
+        size_t TakeMessages();
 
       private:
         SocketStreamerAdapter* const server_;
@@ -123,6 +132,7 @@ class SocketStreamerAdapter : public MediaAdapterImpl {
         volatile bool is_client_connected_;
         volatile bool stop_flag_;
         sync_primitives::Lock thread_lock;
+        ::protocol_handler::RawMessageList batch_;
         DISALLOW_COPY_AND_ASSIGN(Streamer);
     };
 
@@ -130,7 +140,7 @@ class SocketStreamerAdapter : public MediaAdapterImpl {
     bool                                          is_ready_;
     Streamer*                                     streamer_;
     threads::Thread*                              thread_;
-    MessageQueue<protocol_handler::RawMessagePtr>                   messages_;
+    StreamQueue messages_;
     DISALLOW_COPY_AND_ASSIGN(SocketStreamerAdapter);
 };
 }  //  namespace media_manager
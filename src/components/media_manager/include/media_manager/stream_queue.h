@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_STREAM_QUEUE_H_
+#define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_STREAM_QUEUE_H_
+
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <vector>
+#include "protocol/raw_message.h"
+#include "utils/macro.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+
+namespace media_manager {
+
+/*
+ * @brief Snapshot of stream queue state
+ */
+struct StreamQueueStatistics {
+  StreamQueueStatistics();
+
+  std::string name;
+  size_t queued_frames;
+  size_t queued_bytes;
+  uint64_t dropped_frames;
+  uint64_t dropped_bytes;
+  // Frames and bytes pushed since creation or reset, dropped ones included
+  uint64_t received_frames;
+  uint64_t received_bytes;
+  // Input rates of last completed second
+  uint32_t frame_rate;
+  uint64_t bitrate;
+  // Smoothed deviation of frame inter-arrival time from its mean
+  uint64_t jitter_us;
+  // Time from push till streamer thread takes frame
+  uint64_t average_latency_us;
+  uint64_t max_latency_us;
+};
+
+/*
+ * @brief Queue of media frames between protocol handler and streamer
+ * thread, optionally bounded by count and size of queued frames.
+ * When bounded queue is full, H.264 stream drops incoming non-IDR frames
+ * and everything after them until next key frame, which the decoder can
+ * resync on; key frame arriving to full queue replaces all queued frames.
+ * Other streams drop oldest queued frames.
+ * Arrival of frames is timed to tell input rates, jitter and latency
+ * of streamer thread apart. All the queues are registered for statistics reporting.
+ */
+class StreamQueue {
+ public:
+  /*
+   * @param name        Name of stream for statistics
+   * @param max_frames  Maximal count of queued frames, 0 for unlimited
+   * @param max_bytes   Maximal size of queued frames, 0 for unlimited
+   * @param h264        True if frames carry H.264 Annex B stream
+   */
+  StreamQueue(const std::string& name, size_t max_frames, size_t max_bytes,
+              bool h264);
+  ~StreamQueue();
+
+  /*
+   * @brief Queues frame applying drop policy
+   *
+   * @return false if frame was dropped
+   */
+  bool push(const protocol_handler::RawMessagePtr& message);
+
+  /*
+   * @brief Moves all queued frames to output taking the lock once
+   *
+   * @param output          Receives queued frames
+   * @param dropped_frames  Receives count of frames dropped since previous
+   *                        call, they still have to be acknowledged
+   *
+   * @return Number of frames moved
+   */
+  size_t PopAll(protocol_handler::RawMessageList& output,
+                size_t* dropped_frames);
+
+  bool empty() const;
+
+  /*
+   * @brief Waits for frames unless queue is shut down
+   */
+  void wait();
+
+  /*
+   * @brief Wakes up waiting thread, frames pushed later are dropped
+   */
+  void Shutdown();
+
+  /*
+   * @brief Drops queued frames and reopens queue after shut down,
+   * counters of input and latency start over
+   */
+  void Reset();
+
+  StreamQueueStatistics statistics() const;
+
+  /*
+   * @brief Collects statistics of all existing queues
+   */
+  static void Snapshot(std::vector<StreamQueueStatistics>* statistics);
+
+  /*
+   * @brief Tells whether H.264 frame starts new group of pictures,
+   * frames without Annex B start code are considered key ones
+   */
+  static bool IsKeyFrame(const protocol_handler::RawMessage& message);
+
+ private:
+  bool IsFull(size_t incoming_bytes) const;
+  void DropFront();
+  void CountDropped(size_t bytes);
+  void CountReceived(size_t bytes, int64_t now_us);
+  void ResetTelemetry();
+
+  const std::string name_;
+  const size_t max_frames_;
+  const size_t max_bytes_;
+  const bool h264_;
+
+  mutable sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable new_items_;
+  std::deque<protocol_handler::RawMessagePtr> queue_;
+  // Arrival time of every queued frame, microseconds
+  std::deque<int64_t> arrival_times_;
+  size_t queued_bytes_;
+  bool shutting_down_;
+  bool awaiting_key_frame_;
+  size_t dropped_since_pop_;
+  uint64_t dropped_frames_;
+  uint64_t dropped_bytes_;
+
+  uint64_t received_frames_;
+  uint64_t received_bytes_;
+  int64_t last_arrival_us_;
+  int64_t mean_interval_us_;
+  int64_t jitter_us_;
+  int64_t window_start_us_;
+  uint32_t window_frames_;
+  uint64_t window_bytes_;
+  uint32_t frame_rate_;
+  uint64_t bitrate_;
+  int64_t average_latency_us_;
+  int64_t max_latency_us_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamQueue);
+};
+
+}  // namespace media_manager
+
+#endif  // SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_STREAM_QUEUE_H_
@@ -33,20 +33,27 @@
 #ifndef SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_VIDEO_STREAM_TO_FILE_ADAPTER_H_
 #define SRC_COMPONENTS_MEDIA_MANAGER_INCLUDE_MEDIA_MANAGER_VIDEO_VIDEO_STREAM_TO_FILE_ADAPTER_H_
 
+#include <stdint.h>
 #include <string>
-#include <fstream>
 #include "media_manager/media_adapter_impl.h"
-#include "utils/message_queue.h"
+#include "media_manager/stream_queue.h"
+#include "protocol/raw_message.h"
 #include "utils/threads/thread.h"
 #include "utils/threads/thread_delegate.h"
 
 namespace media_manager {
 
-using ::utils::MessageQueue;
-
+/*
+ * @brief Records stream to file for diagnostics. Frames queued meanwhile
+ * are written by single writev, file space is preallocated in large
+ * steps and written data is synced and dropped from page cache
+ * periodically, so recording does not build up dirty pages flushed
+ * at once. File exceeding StreamFileMaxSize is rotated, video at
+ * key frame, so every part is decodable.
+ */
 class VideoStreamToFileAdapter : public MediaAdapterImpl {
   public:
-    explicit VideoStreamToFileAdapter(const std::string& file_name);
+    VideoStreamToFileAdapter(const std::string& file_name, bool is_video);
     virtual ~VideoStreamToFileAdapter();
     virtual void SendData(int32_t application_key,
                           const ::protocol_handler::RawMessagePtr message);
@@ -95,18 +102,51 @@ class VideoStreamToFileAdapter : public MediaAdapterImpl {
         void close();
 
       private:
+        /*
+         * @brief Writes taken messages, rotating file at first frame
+         * it can be rotated at if it is full
+         */
+        void WriteBatch();
+
+        /*
+         * @brief Writes messages to current file
+         */
+        bool Write(const protocol_handler::RawMessageList& messages);
+
+        /*
+         * @brief Extends preallocated space of file to fit size bytes
+         */
+        void Preallocate(uint64_t size);
+
+        /*
+         * @brief Moves current file to rotated one and opens new file
+         */
+        void Rotate();
+
+        bool IsRotationDue() const;
+
         VideoStreamToFileAdapter*   server_;
         volatile bool               stop_flag_;
-        std::ofstream*              file_stream_;
+        int32_t                     file_fd_;
+        // Bytes written to current file
+        uint64_t                    file_size_;
+        // Bytes of file space preallocated
+        uint64_t                    allocated_size_;
+        bool                        preallocation_supported_;
+        // Bytes written since last sync
+        uint64_t                    unsynced_size_;
+        protocol_handler::RawMessageList batch_;
 
         DISALLOW_COPY_AND_ASSIGN(Streamer);
     };
 
   private:
     std::string                                   file_name_;
+    const bool                                    is_video_;
+    const uint64_t                                max_file_size_;
     bool                                          is_ready_;
     threads::Thread*                              thread_;
-    MessageQueue<protocol_handler::RawMessagePtr> messages_;
+    StreamQueue                                   messages_;
 };
 }  //  namespace media_manager
 
@@ -33,9 +33,13 @@
 #include <pulse/simple.h>
 #include <pulse/error.h>
 #include <string.h>
+#include <algorithm>
 #include <utility>
+#include <vector>
 #include "utils/threads/thread.h"
 #include "media_manager/audio/a2dp_source_player_adapter.h"
+#include "config_profile/profile.h"
+#include "utils/date_time.h"
 #include "utils/lock.h"
 #include "utils/logger.h"
 #include "connection_handler/connection_handler_impl.h"
@@ -44,7 +48,9 @@ namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "A2DPSourcePlayerAdapter");
 
-const static size_t BUFSIZE = 32;
+// Chunk size used when PulseAudio chooses buffering
+const static size_t kDefaultChunkSize = 4096;
+const static int64_t kLatencyReportIntervalMs = 5000;
 
 class A2DPSourcePlayerAdapter::A2DPSourcePlayerThread
     : public threads::ThreadDelegate {
@@ -61,11 +67,23 @@ class A2DPSourcePlayerAdapter::A2DPSourcePlayerThread
 
     pa_simple* s_in, *s_out;
     std::string device_;
+    // Bytes read from source and written to sink at once
+    size_t chunk_size_;
     bool should_be_stopped_;
     sync_primitives::Lock should_be_stopped_lock_;
 
     void freeStreams();
 
+    /*
+     * @brief Sets buffering of streams for configured latency
+     *
+     * @return false if PulseAudio defaults are to be used
+     */
+    bool prepareBufferAttributes(pa_buffer_attr* playback,
+                                 pa_buffer_attr* record);
+
+    void reportLatency();
+
     DISALLOW_COPY_AND_ASSIGN(A2DPSourcePlayerThread);
 };
 
@@ -143,17 +161,71 @@ sSampleFormat_ = {
 A2DPSourcePlayerAdapter::A2DPSourcePlayerThread::A2DPSourcePlayerThread(
   const std::string& device)
   : threads::ThreadDelegate(),
-    device_(device) {
+    s_in(NULL),
+    s_out(NULL),
+    device_(device),
+    chunk_size_(kDefaultChunkSize),
+    should_be_stopped_(false) {
+}
+
+bool A2DPSourcePlayerAdapter::A2DPSourcePlayerThread::prepareBufferAttributes(
+  pa_buffer_attr* playback, pa_buffer_attr* record) {
+  const uint32_t latency_ms = profile::Profile::instance()->a2dp_latency();
+  if (0 == latency_ms) {
+    chunk_size_ = kDefaultChunkSize;
+    return false;
+  }
+  const uint32_t latency_bytes = static_cast<uint32_t>(
+      pa_usec_to_bytes(latency_ms * PA_USEC_PER_MSEC, &sSampleFormat_));
+  // Recorded audio is handed over in chunks of half the latency,
+  // so one wakeup moves whole chunk instead of few samples
+  const uint32_t fragment_bytes = static_cast<uint32_t>(
+      pa_frame_size(&sSampleFormat_) *
+      std::max<size_t>(1, latency_bytes / 2 / pa_frame_size(&sSampleFormat_)));
+
+  playback->maxlength = static_cast<uint32_t>(-1);
+  playback->tlength = latency_bytes;
+  playback->prebuf = static_cast<uint32_t>(-1);
+  playback->minreq = static_cast<uint32_t>(-1);
+  playback->fragsize = static_cast<uint32_t>(-1);
+
+  record->maxlength = static_cast<uint32_t>(-1);
+  record->tlength = static_cast<uint32_t>(-1);
+  record->prebuf = static_cast<uint32_t>(-1);
+  record->minreq = static_cast<uint32_t>(-1);
+  record->fragsize = fragment_bytes;
+
+  chunk_size_ = fragment_bytes;
+  LOG4CXX_DEBUG(logger_, "Latency " << latency_ms << " ms, playback buffer "
+                << latency_bytes << " bytes, record fragment "
+                << fragment_bytes << " bytes");
+  return true;
+}
+
+void A2DPSourcePlayerAdapter::A2DPSourcePlayerThread::reportLatency() {
+  int32_t error = 0;
+  const pa_usec_t in = pa_simple_get_latency(s_in, &error);
+  const pa_usec_t out = pa_simple_get_latency(s_out, &error);
+  if (static_cast<pa_usec_t>(-1) == in || static_cast<pa_usec_t>(-1) == out) {
+    LOG4CXX_WARN(logger_, "pa_simple_get_latency() failed: "
+                 << pa_strerror(error));
+    return;
+  }
+  LOG4CXX_INFO(logger_, "A2DP " << device_ << " latency: record "
+               << in / PA_USEC_PER_MSEC << " ms, playback "
+               << out / PA_USEC_PER_MSEC << " ms");
 }
 
 void A2DPSourcePlayerAdapter::A2DPSourcePlayerThread::freeStreams() {
   LOG4CXX_INFO(logger_, "Free streams in A2DPSourcePlayerThread.");
   if (s_in) {
     pa_simple_free(s_in);
+    s_in = NULL;
   }
 
   if (s_out) {
     pa_simple_free(s_out);
+    s_out = NULL;
   }
 }
 
@@ -178,16 +250,25 @@ void A2DPSourcePlayerAdapter::A2DPSourcePlayerThread::threadMain() {
 
   LOG4CXX_DEBUG(logger_, "Creating streams");
 
+  pa_buffer_attr playback_attr;
+  pa_buffer_attr record_attr;
+  const bool custom_buffering =
+      prepareBufferAttributes(&playback_attr, &record_attr);
+
   /* Create a new playback stream */
   if (!(s_out = pa_simple_new(NULL, "AudioManager", PA_STREAM_PLAYBACK, NULL,
-                           "playback", &sSampleFormat_, NULL, NULL, &error))) {
+                           "playback", &sSampleFormat_, NULL,
+                           custom_buffering ? &playback_attr : NULL,
+                           &error))) {
     LOG4CXX_ERROR(logger_, "pa_simple_new() failed: " << pa_strerror(error));
     freeStreams();
     return;
   }
 
   if (!(s_in = pa_simple_new(NULL, "AudioManager", PA_STREAM_RECORD, a2dpSource,
-                             "record", &sSampleFormat_, NULL, NULL, &error))) {
+                             "record", &sSampleFormat_, NULL,
+                             custom_buffering ? &record_attr : NULL,
+                             &error))) {
     LOG4CXX_ERROR(logger_, "pa_simple_new() failed: " << pa_strerror(error));
     freeStreams();
     return;
@@ -195,34 +276,27 @@ void A2DPSourcePlayerAdapter::A2DPSourcePlayerThread::threadMain() {
 
   LOG4CXX_DEBUG(logger_, "Entering main loop");
 
-  for (;;) {
-    uint8_t buf[BUFSIZE];
+  std::vector<uint8_t> buf(chunk_size_);
+  TimevalStruct last_report = date_time::DateTime::getMonotonicTime();
+  reportLatency();
 
-    pa_usec_t latency;
-
-    if ((latency = pa_simple_get_latency(s_in, &error)) == (pa_usec_t) - 1) {
-      LOG4CXX_ERROR(logger_, "pa_simple_get_latency() failed: "
-                    << pa_strerror(error));
-      break;
-    }
-
-    // LOG4CXX_INFO(logger_, "In: " << static_cast<float>(latency));
-
-    if ((latency = pa_simple_get_latency(s_out, &error)) == (pa_usec_t) - 1) {
-      LOG4CXX_ERROR(logger_, "pa_simple_get_latency() failed: "
-                    << pa_strerror(error));
-      break;
+  for (;;) {
+    // Latency is queried from server, so not on every chunk
+    const TimevalStruct now = date_time::DateTime::getMonotonicTime();
+    if (date_time::DateTime::getmSecs(now) -
+        date_time::DateTime::getmSecs(last_report) >=
+        kLatencyReportIntervalMs) {
+      reportLatency();
+      last_report = now;
     }
 
-    // LOG4CXX_INFO(logger_, "Out: " << static_cast<float>(latency));
-
-    if (pa_simple_read(s_in, buf, sizeof(buf), &error) < 0) {
+    if (pa_simple_read(s_in, &buf[0], buf.size(), &error) < 0) {
       LOG4CXX_ERROR(logger_, "read() failed: " << strerror(error));
       break;
     }
 
     /* ... and play it */
-    if (pa_simple_write(s_out, buf, sizeof(buf), &error) < 0) {
+    if (pa_simple_write(s_out, &buf[0], buf.size(), &error) < 0) {
       LOG4CXX_ERROR(logger_, "pa_simple_write() failed: "
                     << pa_strerror(error));
       break;
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "media_manager/audio/audio_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace media_manager {
+
+AudioRingBuffer::AudioRingBuffer(size_t capacity)
+    : storage_(capacity),
+      begin_(0),
+      size_(0),
+      dropped_bytes_(0),
+      lock_() {
+}
+
+void AudioRingBuffer::Write(const uint8_t* data, size_t size) {
+  const size_t capacity = storage_.size();
+  if (0 == capacity || 0 == size) {
+    return;
+  }
+  sync_primitives::AutoLock lock(lock_);
+  if (size >= capacity) {
+    // Only the latest bytes fit
+    dropped_bytes_ += size_ + size - capacity;
+    memcpy(&storage_[0], data + size - capacity, capacity);
+    begin_ = 0;
+    size_ = capacity;
+    return;
+  }
+  if (size_ + size > capacity) {
+    const size_t overflow = size_ + size - capacity;
+    begin_ = (begin_ + overflow) % capacity;
+    size_ -= overflow;
+    dropped_bytes_ += overflow;
+  }
+  const size_t end = (begin_ + size_) % capacity;
+  const size_t first_part = std::min(size, capacity - end);
+  memcpy(&storage_[end], data, first_part);
+  if (first_part < size) {
+    memcpy(&storage_[0], data + first_part, size - first_part);
+  }
+  size_ += size;
+}
+
+size_t AudioRingBuffer::Read(std::vector<uint8_t>* data) {
+  DCHECK_OR_RETURN(data, 0);
+  sync_primitives::AutoLock lock(lock_);
+  data->resize(size_);
+  if (0 == size_) {
+    return 0;
+  }
+  const size_t capacity = storage_.size();
+  const size_t first_part = std::min(size_, capacity - begin_);
+  memcpy(&(*data)[0], &storage_[begin_], first_part);
+  if (first_part < size_) {
+    memcpy(&(*data)[first_part], &storage_[0], size_ - first_part);
+  }
+  const size_t read = size_;
+  begin_ = 0;
+  size_ = 0;
+  return read;
+}
+
+void AudioRingBuffer::Clear() {
+  sync_primitives::AutoLock lock(lock_);
+  begin_ = 0;
+  size_ = 0;
+}
+
+size_t AudioRingBuffer::size() const {
+  sync_primitives::AutoLock lock(lock_);
+  return size_;
+}
+
+uint64_t AudioRingBuffer::dropped_bytes() const {
+  sync_primitives::AutoLock lock(lock_);
+  return dropped_bytes_;
+}
+
+}  // namespace media_manager
@@ -46,8 +46,10 @@
 #include "interfaces/MOBILE_API.h"
 #include "utils/file_system.h"
 #include "utils/logger.h"
+#include "config_profile/profile.h"
 
 #include "media_manager/audio/audio_stream_sender_thread.h"
+#include "media_manager/audio/audio_ring_buffer.h"
 #include "application_manager/smart_object_keys.h"
 #include "application_manager/message.h"
 
@@ -63,6 +65,29 @@ AudioStreamSenderThread::AudioStreamSenderThread(
   const std::string fileName, uint32_t session_key)
   : session_key_(session_key),
     fileName_(fileName),
+    buffer_(NULL),
+    offset_(0),
+#if defined(EXTENDED_MEDIA_MODE)
+    chunk_interval_ms_(
+        profile::Profile::instance()->audio_pass_thru_chunk_interval()),
+#else
+    // Emulation file holds one second of audio
+    chunk_interval_ms_(kAudioPassThruTimeout * 1000),
+#endif
+    shouldBeStoped_(false),
+    shouldBeStoped_lock_(),
+    shouldBeStoped_cv_() {
+  LOG4CXX_AUTO_TRACE(logger_);
+}
+
+AudioStreamSenderThread::AudioStreamSenderThread(
+  AudioRingBuffer* buffer, uint32_t session_key)
+  : session_key_(session_key),
+    fileName_(),
+    buffer_(buffer),
+    offset_(0),
+    chunk_interval_ms_(
+        profile::Profile::instance()->audio_pass_thru_chunk_interval()),
     shouldBeStoped_(false),
     shouldBeStoped_lock_(),
     shouldBeStoped_cv_() {
@@ -79,51 +104,71 @@ void AudioStreamSenderThread::threadMain() {
 
   while (false == getShouldBeStopped()) {
     AutoLock auto_lock(shouldBeStoped_lock_);
-    shouldBeStoped_cv_.WaitFor(auto_lock, kAudioPassThruTimeout * 1000);
+    shouldBeStoped_cv_.WaitFor(auto_lock, chunk_interval_ms_);
     sendAudioChunkToMobile();
   }
 
+  file_.close();
 }
 
 void AudioStreamSenderThread::sendAudioChunkToMobile() {
   LOG4CXX_AUTO_TRACE(logger_);
 
   std::vector<uint8_t> binaryData;
-  std::vector<uint8_t>::iterator from;
-  std::vector<uint8_t>::iterator to;
-
-  if (!file_system::ReadBinaryFile(fileName_, binaryData)) {
+  if (buffer_) {
+    buffer_->Read(&binaryData);
+  } else if (!ReadNewData(binaryData)) {
     LOG4CXX_ERROR_EXT(logger_, "Unable to read file." << fileName_);
-
-    return;
-  }
-
-  if (binaryData.empty()) {
-    LOG4CXX_ERROR_EXT(logger_, "Binary data is empty.");
     return;
   }
 
   LOG4CXX_INFO_EXT(logger_, "offset = " << offset_);
 
-  from = binaryData.begin() + offset_;
-  to = binaryData.end();
-
-  if (from < binaryData.end() /*from != binaryData.end()*/) {
-    LOG4CXX_INFO_EXT(logger_, "from != binaryData.end()");
-
-    offset_ = offset_ + to - from;
-    std::vector<uint8_t> data(from, to);
-
+  if (!binaryData.empty()) {
+    // Data is moved to notification queue without copying
     application_manager::ApplicationManagerImpl::instance()->
-    SendAudioPassThroughNotification(session_key_, data);
-    binaryData.clear();
+    SendAudioPassThroughNotification(session_key_, binaryData);
   }
 #if !defined(EXTENDED_MEDIA_MODE)
   // without recording stream restart reading 1-sec file
   offset_ = 0;
+  file_.close();
 #endif
 }
 
+bool AudioStreamSenderThread::ReadNewData(std::vector<uint8_t>& data) {
+  if (!file_.is_open()) {
+    file_.open(fileName_.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!file_.is_open()) {
+      return false;
+    }
+  }
+
+  // Recorder keeps appending to the file, so end of it moves
+  file_.clear();
+  file_.seekg(0, std::ios_base::end);
+  const std::streamoff size = file_.tellg();
+  if (size < 0) {
+    file_.close();
+    return false;
+  }
+  if (size < offset_) {
+    LOG4CXX_WARN(logger_, "Recording file is truncated, reading from start");
+    offset_ = 0;
+  }
+  if (size == offset_) {
+    return true;
+  }
+
+  data.resize(static_cast<size_t>(size - offset_));
+  file_.seekg(offset_, std::ios_base::beg);
+  file_.read(reinterpret_cast<char*>(&data[0]), data.size());
+  const std::streamsize read = file_.gcount();
+  data.resize(static_cast<size_t>(read));
+  offset_ += read;
+  return true;
+}
+
 bool AudioStreamSenderThread::getShouldBeStopped() {
   AutoLock auto_lock(shouldBeStoped_lock_);
 
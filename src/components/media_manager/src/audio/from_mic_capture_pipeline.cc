@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "media_manager/audio/from_mic_capture_pipeline.h"
+
+#include <string.h>
+
+#include "media_manager/audio/audio_ring_buffer.h"
+#include "utils/date_time.h"
+#include "utils/logger.h"
+
+namespace media_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "FromMicCapturePipeline")
+
+namespace {
+const char* kDevice = "hw:0,0";
+// Samples are copied out on arrival, appsink queue only absorbs hiccups
+const guint kMaxQueuedBuffers = 8;
+
+int64_t NowMs() {
+  return date_time::DateTime::getmSecs(
+      date_time::DateTime::getMonotonicTime());
+}
+}  // namespace
+
+FromMicCapturePipeline::FromMicCapturePipeline(AudioRingBuffer* buffer)
+  : buffer_(buffer),
+    pipeline_(NULL),
+    capture_lock_(),
+    capturing_(false),
+    deadline_ms_(0) {
+}
+
+FromMicCapturePipeline::~FromMicCapturePipeline() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (pipeline_) {
+    gst_element_set_state(pipeline_, GST_STATE_NULL);
+    gst_object_unref(GST_OBJECT(pipeline_));
+    pipeline_ = NULL;
+  }
+}
+
+bool FromMicCapturePipeline::Prepare() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (pipeline_) {
+    return true;
+  }
+  gst_init(NULL, NULL);
+
+  GstElement* pipeline = gst_pipeline_new("mic-capture");
+  GstElement* alsasrc = gst_element_factory_make("alsasrc", "alsasrc0");
+  GstElement* convert =
+      gst_element_factory_make("audioconvert", "audioconvert0");
+  GstElement* resample =
+      gst_element_factory_make("audioresample", "audioresample0");
+  GstElement* appsink = gst_element_factory_make("appsink", "appsink0");
+  if (!pipeline || !alsasrc || !convert || !resample || !appsink) {
+    LOG4CXX_ERROR(logger_, "Failed creating microphone pipeline elements");
+    GstElement* elements[] = { pipeline, alsasrc, convert, resample, appsink };
+    for (size_t i = 0; i < sizeof(elements) / sizeof(elements[0]); ++i) {
+      if (elements[i]) {
+        gst_object_unref(GST_OBJECT(elements[i]));
+      }
+    }
+    return false;
+  }
+
+  g_object_set(G_OBJECT(alsasrc), "device", kDevice, NULL);
+
+  GstCaps* caps = gst_caps_new_simple("audio/x-raw",
+                                      "format", G_TYPE_STRING, "S16LE",
+                                      "layout", G_TYPE_STRING, "interleaved",
+                                      "rate", G_TYPE_INT, kSamplingRate,
+                                      "channels", G_TYPE_INT, 1,
+                                      NULL);
+  GstAppSink* sink = GST_APP_SINK(appsink);
+  gst_app_sink_set_caps(sink, caps);
+  gst_caps_unref(caps);
+  gst_app_sink_set_max_buffers(sink, kMaxQueuedBuffers);
+  gst_app_sink_set_drop(sink, TRUE);
+  GstAppSinkCallbacks callbacks;
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.new_sample = &FromMicCapturePipeline::OnNewSample;
+  gst_app_sink_set_callbacks(sink, &callbacks, this, NULL);
+
+  gst_bin_add_many(GST_BIN(pipeline), alsasrc, convert, resample, appsink,
+                   NULL);
+  if (!gst_element_link_many(alsasrc, convert, resample, appsink, NULL)) {
+    LOG4CXX_ERROR(logger_, "Failed linking microphone pipeline");
+    gst_object_unref(GST_OBJECT(pipeline));
+    return false;
+  }
+
+  GstBus* bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline));
+  gst_bus_set_sync_handler(bus, &FromMicCapturePipeline::OnBusMessage, this,
+                           NULL);
+  gst_object_unref(bus);
+
+  // Device is opened once here and stays open while pipeline is paused
+  if (GST_STATE_CHANGE_FAILURE ==
+      gst_element_set_state(pipeline, GST_STATE_PAUSED)) {
+    LOG4CXX_ERROR(logger_, "Failed opening microphone " << kDevice);
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    gst_object_unref(GST_OBJECT(pipeline));
+    return false;
+  }
+  pipeline_ = pipeline;
+  LOG4CXX_DEBUG(logger_, "Microphone pipeline is ready");
+  return true;
+}
+
+bool FromMicCapturePipeline::Start(int32_t duration_ms) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (!Prepare()) {
+    return false;
+  }
+  buffer_->Clear();
+  {
+    sync_primitives::AutoLock auto_lock(capture_lock_);
+    capturing_ = true;
+    deadline_ms_ = duration_ms > 0 ? NowMs() + duration_ms : 0;
+  }
+  if (GST_STATE_CHANGE_FAILURE ==
+      gst_element_set_state(pipeline_, GST_STATE_PLAYING)) {
+    LOG4CXX_ERROR(logger_, "Failed starting microphone pipeline");
+    Stop();
+    return false;
+  }
+  return true;
+}
+
+void FromMicCapturePipeline::Stop() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  {
+    sync_primitives::AutoLock auto_lock(capture_lock_);
+    capturing_ = false;
+  }
+  if (pipeline_) {
+    gst_element_set_state(pipeline_, GST_STATE_PAUSED);
+  }
+}
+
+bool FromMicCapturePipeline::IsCapturing() {
+  sync_primitives::AutoLock auto_lock(capture_lock_);
+  if (capturing_ && 0 != deadline_ms_ && NowMs() >= deadline_ms_) {
+    LOG4CXX_DEBUG(logger_, "Capture duration is over");
+    capturing_ = false;
+  }
+  return capturing_;
+}
+
+GstFlowReturn FromMicCapturePipeline::OnNewSample(GstAppSink* sink,
+                                                  gpointer user_data) {
+  FromMicCapturePipeline* self =
+      static_cast<FromMicCapturePipeline*>(user_data);
+  GstSample* sample = gst_app_sink_pull_sample(sink);
+  if (!sample) {
+    return GST_FLOW_OK;
+  }
+  // Samples arriving while paused or after duration are dropped
+  if (self->IsCapturing()) {
+    GstBuffer* buffer = gst_sample_get_buffer(sample);
+    GstMapInfo map;
+    if (buffer && gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+      self->buffer_->Write(map.data, map.size);
+      gst_buffer_unmap(buffer, &map);
+    }
+  }
+  gst_sample_unref(sample);
+  return GST_FLOW_OK;
+}
+
+GstBusSyncReply FromMicCapturePipeline::OnBusMessage(GstBus* bus,
+                                                     GstMessage* message,
+                                                     gpointer user_data) {
+  if (GST_MESSAGE_ERROR == GST_MESSAGE_TYPE(message)) {
+    GError* error = NULL;
+    gst_message_parse_error(message, &error, NULL);
+    LOG4CXX_ERROR(logger_, "Microphone pipeline error: "
+                  << (error ? error->message : "unknown"));
+    if (error) {
+      g_error_free(error);
+    }
+  }
+  return GST_BUS_DROP;
+}
+
+}  // namespace media_manager
@@ -30,31 +30,23 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <string>
-#include "utils/threads/thread.h"
 #include "utils/logger.h"
-#include "media_manager/audio/from_mic_to_file_recorder_thread.h"
 #include "media_manager/audio/from_mic_recorder_adapter.h"
 
 namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "FromMicRecorderAdapter")
 
-FromMicRecorderAdapter::FromMicRecorderAdapter()
-  : recorder_thread_(NULL)
-  , output_file_("default_recorded_audio.wav")
+FromMicRecorderAdapter::FromMicRecorderAdapter(AudioRingBuffer* buffer)
+  : pipeline_(buffer)
   , kDefaultDuration(1000)
   , duration_(kDefaultDuration) {
-
+  // Failure is logged, preparing is retried on start
+  pipeline_.Prepare();
 }
 
 FromMicRecorderAdapter::~FromMicRecorderAdapter() {
   LOG4CXX_AUTO_TRACE(logger_);
-  if (recorder_thread_) {
-    recorder_thread_->join();
-    delete recorder_thread_->delegate();
-    threads::DeleteThread(recorder_thread_);
-  }
 }
 
 void FromMicRecorderAdapter::StartActivity(int32_t application_key) {
@@ -65,17 +57,7 @@ void FromMicRecorderAdapter::StartActivity(int32_t application_key) {
     return;
   }
 
-// Todd: No gstreamer recorder thread
-  if (!recorder_thread_) {
-    FromMicToFileRecorderThread* thread_delegate =
-      new FromMicToFileRecorderThread(
-      output_file_, duration_);
-    recorder_thread_ = threads::CreateThread("MicrophoneRec",
-                                           thread_delegate);
-  }
-
-  if (NULL != recorder_thread_) {
-    recorder_thread_->start();
+  if (pipeline_.Start(duration_)) {
     current_application_ = application_key;
   }
 }
@@ -89,10 +71,7 @@ void FromMicRecorderAdapter::StopActivity(int32_t application_key) {
     return;
   }
 
-  if (recorder_thread_) {
-    recorder_thread_->stop();
-  }
-  current_application_ = 0;
+  pipeline_.Stop();
 }
 
 bool FromMicRecorderAdapter::is_app_performing_activity(int32_t
@@ -100,10 +79,6 @@ bool FromMicRecorderAdapter::is_app_performing_activity(int32_t
   return (application_key == current_application_);
 }
 
-void FromMicRecorderAdapter::set_output_file(const std::string& output_file) {
-  output_file_ = output_file;
-}
-
 void FromMicRecorderAdapter::set_duration(int32_t duration) {
   duration_ = duration;
 }
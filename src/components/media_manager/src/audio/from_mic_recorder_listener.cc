@@ -42,7 +42,16 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "FromMicRecorderListener")
 FromMicRecorderListener::FromMicRecorderListener(
   const std::string& file_name)
   : reader_(NULL)
-  , file_name_(file_name) {
+  , file_name_(file_name)
+  , buffer_(NULL)
+  , current_application_(0) {
+}
+
+FromMicRecorderListener::FromMicRecorderListener(AudioRingBuffer* buffer)
+  : reader_(NULL)
+  , file_name_()
+  , buffer_(buffer)
+  , current_application_(0) {
 }
 
 FromMicRecorderListener::~FromMicRecorderListener() {
@@ -71,7 +80,8 @@ void FromMicRecorderListener::OnActivityStarted(int32_t application_key) {
     return;
   }
   if (!reader_) {
-    AudioStreamSenderThread* thread_delegate =
+    AudioStreamSenderThread* thread_delegate = buffer_ ?
+      new AudioStreamSenderThread(buffer_, application_key) :
       new AudioStreamSenderThread(file_name_, application_key);
     reader_ = threads::CreateThread("RecorderSender", thread_delegate);
   }
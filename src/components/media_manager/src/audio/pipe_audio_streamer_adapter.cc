@@ -38,7 +38,8 @@ namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger, "PipeAudioStreamerAdapter")
 
-PipeAudioStreamerAdapter::PipeAudioStreamerAdapter() {
+PipeAudioStreamerAdapter::PipeAudioStreamerAdapter()
+  : PipeStreamerAdapter("AudioStream", false) {
   LOG4CXX_AUTO_TRACE(logger);
   named_pipe_path_ = profile::Profile::instance()->named_audio_pipe_path();
 
@@ -38,7 +38,8 @@ namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger, "SocketAudioStreamerAdapter")
 
-SocketAudioStreamerAdapter::SocketAudioStreamerAdapter() {
+SocketAudioStreamerAdapter::SocketAudioStreamerAdapter()
+  : SocketStreamerAdapter("AudioStream", false) {
   LOG4CXX_AUTO_TRACE(logger);
   port_ = profile::Profile::instance()->audio_streaming_port();
   ip_ = profile::Profile::instance()->server_address();
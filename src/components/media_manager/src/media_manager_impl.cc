@@ -32,6 +32,7 @@
 
 #include "config_profile/profile.h"
 #include "media_manager/media_manager_impl.h"
+#include "media_manager/audio/audio_ring_buffer.h"
 #include "media_manager/audio/from_mic_recorder_listener.h"
 #include "media_manager/streamer_listener.h"
 #include "application_manager/message_helper.h"
@@ -49,6 +50,7 @@
 #include "media_manager/video/pipe_video_streamer_adapter.h"
 #include "media_manager/audio/pipe_audio_streamer_adapter.h"
 #include "media_manager/video/video_stream_to_file_adapter.h"
+#include "media_manager/video/shm_video_streamer_adapter.h"
 
 
 namespace media_manager {
@@ -57,10 +59,20 @@ using profile::Profile;
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "MediaManagerImpl")
 
+#if defined(EXTENDED_MEDIA_MODE)
+namespace {
+// Four seconds of captured audio, sender takes it every chunk interval
+const size_t kFromMicBufferSize =
+    4 * FromMicCapturePipeline::kSamplingRate *
+    FromMicCapturePipeline::kBytesPerSample;
+}  // namespace
+#endif
+
 MediaManagerImpl::MediaManagerImpl()
   : protocol_handler_(NULL)
   , a2dp_player_(NULL)
   , from_mic_recorder_(NULL)
+  , from_mic_buffer_(NULL)
   , video_streamer_(NULL)
   , audio_streamer_(NULL)
   , video_stream_active_(false)
@@ -81,6 +93,9 @@ MediaManagerImpl::~MediaManagerImpl() {
     from_mic_recorder_ = NULL;
   }
 
+  delete from_mic_buffer_;
+  from_mic_buffer_ = NULL;
+
   if (video_streamer_) {
     delete video_streamer_;
     video_streamer_ = NULL;
@@ -103,7 +118,8 @@ void MediaManagerImpl::Init() {
 #if defined(EXTENDED_MEDIA_MODE)
   LOG4CXX_INFO(logger_, "Called Init with default configuration.");
   a2dp_player_ = new A2DPSourcePlayerAdapter();
-  from_mic_recorder_ = new FromMicRecorderAdapter();
+  from_mic_buffer_ = new AudioRingBuffer(kFromMicBufferSize);
+  from_mic_recorder_ = new FromMicRecorderAdapter(from_mic_buffer_);
 #endif
 
   if ("socket" == profile::Profile::instance()->video_server_type()) {
@@ -112,7 +128,9 @@ void MediaManagerImpl::Init() {
     video_streamer_ = new PipeVideoStreamerAdapter();
   } else if ("file" == profile::Profile::instance()->video_server_type()) {
     video_streamer_ = new VideoStreamToFileAdapter(
-        profile::Profile::instance()->video_stream_file());
+        profile::Profile::instance()->video_stream_file(), true);
+  } else if ("shm" == profile::Profile::instance()->video_server_type()) {
+    video_streamer_ = new ShmVideoStreamerAdapter();
   }
 
   if ("socket" == profile::Profile::instance()->audio_server_type()) {
@@ -121,7 +139,7 @@ void MediaManagerImpl::Init() {
     audio_streamer_ = new PipeAudioStreamerAdapter();
   } else if ("file" == profile::Profile::instance()->audio_server_type()) {
     audio_streamer_ = new VideoStreamToFileAdapter(
-        profile::Profile::instance()->audio_stream_file());
+        profile::Profile::instance()->audio_stream_file(), false);
   }
 
   stop_streaming_timeout_ = profile::Profile::instance()->stop_streaming_timeout();
@@ -165,21 +183,21 @@ void MediaManagerImpl::StartMicrophoneRecording(
   application_manager::ApplicationSharedPtr app =
     application_manager::ApplicationManagerImpl::instance()->
       application(application_key);
-  std::string file_path =
-  profile::Profile::instance()->app_storage_folder();
-  file_path += "/";
-  file_path += output_file;
-  from_mic_listener_ = new FromMicRecorderListener(file_path);
 #if defined(EXTENDED_MEDIA_MODE)
+  // Captured audio goes to sender through buffer, output file is not used
+  from_mic_listener_ = new FromMicRecorderListener(from_mic_buffer_);
   if (from_mic_recorder_) {
     from_mic_recorder_->AddListener(from_mic_listener_);
     (static_cast<FromMicRecorderAdapter*>(from_mic_recorder_))
-    ->set_output_file(file_path);
-    (static_cast<FromMicRecorderAdapter*>(from_mic_recorder_))
     ->set_duration(duration);
     from_mic_recorder_->StartActivity(application_key);
   }
 #else
+  std::string file_path =
+  profile::Profile::instance()->app_storage_folder();
+  file_path += "/";
+  file_path += output_file;
+  from_mic_listener_ = new FromMicRecorderListener(file_path);
   if (file_system::FileExists(file_path)) {
     LOG4CXX_INFO(logger_, "File " << output_file << " exists, removing");
     if (file_system::DeleteFile(file_path)) {
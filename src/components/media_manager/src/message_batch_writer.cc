@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "media_manager/message_batch_writer.h"
+#include "utils/logger.h"
+
+namespace media_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "MediaManager")
+
+namespace {
+// Vectors written by single system call, far below IOV_MAX
+const size_t kMaxBatchVectors = 64;
+// Stop flag is checked this often while descriptor is not writable
+const int kPollTimeoutMs = 100;
+
+/*
+ * Waits till descriptor accepts data again
+ *
+ * @return false if waiting failed or was stopped
+ */
+bool WaitWritable(int32_t fd, const volatile bool* stop_flag) {
+  struct pollfd descriptor;
+  descriptor.fd = fd;
+  descriptor.events = POLLOUT;
+  while (!stop_flag || !*stop_flag) {
+    descriptor.revents = 0;
+    const int ready = ::poll(&descriptor, 1, kPollTimeoutMs);
+    if (-1 == ready) {
+      if (EINTR == errno) {
+        continue;
+      }
+      LOG4CXX_ERROR(logger_, "Unable to poll: " << strerror(errno));
+      return false;
+    }
+    if (ready > 0) {
+      // Errors are reported by following write
+      return true;
+    }
+  }
+  LOG4CXX_DEBUG(logger_, "Writing is stopped");
+  return false;
+}
+
+/*
+ * Writes all the vectors handling partial writes and interruptions
+ */
+bool WriteVectors(int32_t fd, struct iovec* vectors, size_t count,
+                  bool is_socket, const volatile bool* stop_flag) {
+  while (count > 0) {
+    ssize_t written = 0;
+    if (is_socket) {
+      struct msghdr header;
+      memset(&header, 0, sizeof(header));
+      header.msg_iov = vectors;
+      header.msg_iovlen = count;
+      written = ::sendmsg(fd, &header, MSG_NOSIGNAL);
+    } else {
+      written = ::writev(fd, vectors, count);
+    }
+    if (-1 == written) {
+      if (EINTR == errno) {
+        continue;
+      }
+      if (EAGAIN == errno || EWOULDBLOCK == errno) {
+        if (!WaitWritable(fd, stop_flag)) {
+          return false;
+        }
+        continue;
+      }
+      LOG4CXX_ERROR(logger_, "Unable to write: " << strerror(errno));
+      return false;
+    }
+    // Skip fully written vectors and shift partially written one
+    size_t left = static_cast<size_t>(written);
+    while (count > 0 && left >= vectors->iov_len) {
+      left -= vectors->iov_len;
+      ++vectors;
+      --count;
+    }
+    if (count > 0) {
+      vectors->iov_base = static_cast<uint8_t*>(vectors->iov_base) + left;
+      vectors->iov_len -= left;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+bool WriteMessages(int32_t fd,
+                   const protocol_handler::RawMessageList& messages,
+                   bool is_socket,
+                   const volatile bool* stop_flag) {
+  struct iovec vectors[kMaxBatchVectors];
+  size_t count = 0;
+  for (protocol_handler::RawMessageList::const_iterator it = messages.begin();
+       messages.end() != it; ++it) {
+    if (!(*it)) {
+      continue;
+    }
+    // Fragments are gathered as they are, without merging them
+    const size_t fragments_count = (*it)->fragments_count();
+    for (size_t i = 0; i < fragments_count; ++i) {
+      const utils::BufferSlice& fragment = (*it)->fragment(i);
+      if (fragment.empty()) {
+        continue;
+      }
+      if (kMaxBatchVectors == count) {
+        if (!WriteVectors(fd, vectors, count, is_socket, stop_flag)) {
+          return false;
+        }
+        count = 0;
+      }
+      vectors[count].iov_base = fragment.data();
+      vectors[count].iov_len = fragment.size();
+      ++count;
+    }
+  }
+  return WriteVectors(fd, vectors, count, is_socket, stop_flag);
+}
+
+}  // namespace media_manager
@@ -32,21 +32,33 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include "utils/logger.h"
 #include "utils/file_system.h"
 #include "config_profile/profile.h"
 #include "media_manager/pipe_streamer_adapter.h"
+#include "media_manager/message_batch_writer.h"
 
 namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "PipeStreamerAdapter")
 
-PipeStreamerAdapter::PipeStreamerAdapter()
+namespace {
+// Pipe holds about a second of video, so short stalls of player
+// do not hold streamer thread
+const int kPipeSize = 1024 * 1024;
+}  // namespace
+
+PipeStreamerAdapter::PipeStreamerAdapter(const std::string& stream_name,
+                                         bool is_video)
   : is_ready_(false),
     thread_(threads::CreateThread("PipeStreamer", new Streamer(this))),
-    messages_() {
+    messages_(stream_name,
+              profile::Profile::instance()->stream_queue_max_frames(),
+              profile::Profile::instance()->stream_queue_max_bytes(),
+              is_video) {
   LOG4CXX_AUTO_TRACE(logger_);
 }
 
@@ -147,17 +159,13 @@ void PipeStreamerAdapter::Streamer::threadMain() {
   open();
 
   while (!stop_flag_) {
-    while (!server_->messages_.empty()) {
-      ::protocol_handler::RawMessagePtr msg = server_->messages_.pop();
-      if (!msg) {
-        LOG4CXX_ERROR(logger_, "Null pointer message");
-        continue;
-      }
-
-      ssize_t ret = write(pipe_fd_, msg.get()->data(),
-                          msg.get()->data_size());
-
-      if (ret == -1) {
+    size_t dropped = TakeMessages();
+    while (!batch_.empty() || dropped > 0) {
+      // All frames queued meanwhile are written by single writev.
+      // While player does not read pipe, frames wait in bounded queue,
+      // which drops them by its policy
+      if (!batch_.empty() &&
+          !WriteMessages(pipe_fd_, batch_, false, &stop_flag_)) {
         LOG4CXX_ERROR(logger_, "Failed writing data to pipe "
                       << server_->named_pipe_path_);
 
@@ -166,29 +174,37 @@ void PipeStreamerAdapter::Streamer::threadMain() {
         for (;server_->media_listeners_.end() != it; ++it) {
           (*it)->OnErrorReceived(server_->current_application_, -1);
         }
-      } else if (static_cast<uint32_t>(ret) != msg.get()->data_size()) {
-        LOG4CXX_WARN(logger_, "Couldn't write all the data to pipe "
-                     << server_->named_pipe_path_);
       }
 
       static int32_t messsages_for_session = 0;
-      ++messsages_for_session;
-
-      LOG4CXX_DEBUG(logger_, "Handling map streaming message. This is "
-                   << messsages_for_session << " the message for "
-                   << server_->current_application_);
-      std::set<MediaListenerPtr>::iterator it =
-          server_->media_listeners_.begin();
-      for (; server_->media_listeners_.end() != it; ++it) {
-        (*it)->OnDataReceived(server_->current_application_,
-                              messsages_for_session);
+      // Dropped frames are acknowledged too, so mobile keeps streaming
+      const size_t processed = batch_.size() + dropped;
+      for (size_t i = 0; i < processed; ++i) {
+        ++messsages_for_session;
+
+        LOG4CXX_DEBUG(logger_, "Handling map streaming message. This is "
+                     << messsages_for_session << " the message for "
+                     << server_->current_application_);
+        std::set<MediaListenerPtr>::iterator it =
+            server_->media_listeners_.begin();
+        for (; server_->media_listeners_.end() != it; ++it) {
+          (*it)->OnDataReceived(server_->current_application_,
+                                messsages_for_session);
+        }
       }
+      dropped = TakeMessages();
     }
     server_->messages_.wait();
   }
   close();
 }
 
+size_t PipeStreamerAdapter::Streamer::TakeMessages() {
+  size_t dropped = 0;
+  server_->messages_.PopAll(batch_, &dropped);
+  return dropped;
+}
+
 void PipeStreamerAdapter::Streamer::exitThreadMain() {
   LOG4CXX_AUTO_TRACE(logger_);
   stop_flag_ = true;
@@ -208,12 +224,19 @@ void PipeStreamerAdapter::Streamer::open() {
     return;
   }
 
-  pipe_fd_ = ::open(server_->named_pipe_path_.c_str(), O_RDWR, 0);
+  pipe_fd_ = ::open(server_->named_pipe_path_.c_str(),
+                    O_RDWR | O_NONBLOCK, 0);
   if (-1 == pipe_fd_) {
     LOG4CXX_ERROR(logger_, "Cannot open pipe for writing "
                   << server_->named_pipe_path_);
     return;
   }
+#if defined(F_SETPIPE_SZ)
+  if (-1 == fcntl(pipe_fd_, F_SETPIPE_SZ, kPipeSize)) {
+    LOG4CXX_WARN(logger_, "Cannot enlarge pipe " << server_->named_pipe_path_
+                 << ": " << strerror(errno));
+  }
+#endif
 
   LOG4CXX_DEBUG(logger_, "Pipe " << server_->named_pipe_path_
                 << " was successfully created");
@@ -42,18 +42,23 @@
 #include <errno.h>
 #include "config_profile/profile.h"
 #include "media_manager/video/socket_video_streamer_adapter.h"
+#include "media_manager/message_batch_writer.h"
 #include "utils/logger.h"
 
 namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger, "SocketStreamerAdapter")
 
-SocketStreamerAdapter::SocketStreamerAdapter()
+SocketStreamerAdapter::SocketStreamerAdapter(const std::string& stream_name,
+                                             bool is_video)
   : socket_fd_(0),
     is_ready_(false),
     streamer_(new Streamer(this)),
     thread_(threads::CreateThread("SocketStreamer", streamer_)),
-    messages_() {
+    messages_(stream_name,
+              profile::Profile::instance()->stream_queue_max_frames(),
+              profile::Profile::instance()->stream_queue_max_bytes(),
+              is_video) {
 }
 
 SocketStreamerAdapter::~SocketStreamerAdapter() {
@@ -164,26 +169,29 @@ void SocketStreamerAdapter::Streamer::threadMain() {
     is_client_connected_ = true;
     is_first_loop_ = true;
     while (is_client_connected_) {
-      while (!server_->messages_.empty()) {
-        ::protocol_handler::RawMessagePtr msg = server_->messages_.pop();
-        if (!msg) {
-          LOG4CXX_ERROR(logger, "Null pointer message");
-          continue;
+      size_t dropped = TakeMessages();
+      while (!batch_.empty() || dropped > 0) {
+        // All frames queued meanwhile are sent by single system call
+        if (!batch_.empty()) {
+          is_client_connected_ = send(batch_);
         }
-
-        is_client_connected_ = send(msg);
         static int32_t messages_for_session = 0;
-        ++messages_for_session;
-
-        LOG4CXX_INFO(logger, "Handling map streaming message. This is "
-            << messages_for_session << " the message for "
-            << server_->current_application_);
-        std::set<MediaListenerPtr>::iterator it = server_->media_listeners_
-            .begin();
-        for (; server_->media_listeners_.end() != it; ++it) {
-          (*it)->OnDataReceived(server_->current_application_,
-                                messages_for_session);
+        // Dropped frames are acknowledged too, so mobile keeps streaming
+        const size_t processed = batch_.size() + dropped;
+        for (size_t i = 0; i < processed; ++i) {
+          ++messages_for_session;
+
+          LOG4CXX_INFO(logger, "Handling map streaming message. This is "
+              << messages_for_session << " the message for "
+              << server_->current_application_);
+          std::set<MediaListenerPtr>::iterator it = server_->media_listeners_
+              .begin();
+          for (; server_->media_listeners_.end() != it; ++it) {
+            (*it)->OnDataReceived(server_->current_application_,
+                                  messages_for_session);
+          }
         }
+        dropped = TakeMessages();
       }
 
       if (!is_ready()) {
@@ -280,8 +288,14 @@ bool SocketStreamerAdapter::Streamer::is_ready() const {
   return result;
 }
 
+size_t SocketStreamerAdapter::Streamer::TakeMessages() {
+  size_t dropped = 0;
+  server_->messages_.PopAll(batch_, &dropped);
+  return dropped;
+}
+
 bool SocketStreamerAdapter::Streamer::send(
-  const ::protocol_handler::RawMessagePtr msg) {
+  const ::protocol_handler::RawMessageList& messages) {
   if (!is_ready()) {
     LOG4CXX_ERROR_EXT(logger, " Socket is not ready");
     return false;
@@ -302,13 +316,12 @@ bool SocketStreamerAdapter::Streamer::send(
     }
   }
 
-  if (-1 == ::send(new_socket_fd_, (*msg).data(),
-                   (*msg).data_size(), MSG_NOSIGNAL)) {
+  if (!WriteMessages(new_socket_fd_, messages, true)) {
     LOG4CXX_ERROR_EXT(logger, " Unable to send");
     return false;
   }
 
-  LOG4CXX_INFO(logger, "Streamer::sent " << (*msg).data_size());
+  LOG4CXX_INFO(logger, "Streamer::sent " << messages.size() << " messages");
   return true;
 }
 
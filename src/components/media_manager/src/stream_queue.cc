@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <set>
+#include "media_manager/stream_queue.h"
+#include "utils/date_time.h"
+#include "utils/logger.h"
+#include "utils/singleton.h"
+
+namespace media_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "StreamQueue")
+
+namespace {
+const uint8_t kNalTypeMask = 0x1F;
+const uint8_t kNalTypeNonIdrSlice = 1;
+const uint8_t kNalTypeIdrSlice = 5;
+const uint8_t kNalTypeSps = 7;
+const uint8_t kNalTypePps = 8;
+
+const int64_t kRateWindowUs = date_time::DateTime::MICROSECONDS_IN_SECOND;
+// Weight of new sample in smoothed values is 1/16 as for RTP jitter
+const int64_t kSmoothingShift = 4;
+
+int64_t NowUs() {
+  return date_time::DateTime::getuSecs(
+      date_time::DateTime::getMonotonicTime());
+}
+
+void Smooth(int64_t sample, int64_t* value) {
+  *value += (sample - *value) >> kSmoothingShift;
+}
+
+/*
+ * Queues existing in the process, polled for statistics
+ */
+class StreamQueueRegistry : public utils::Singleton<StreamQueueRegistry> {
+ public:
+  void Add(const StreamQueue* queue) {
+    sync_primitives::AutoLock lock(lock_);
+    queues_.insert(queue);
+  }
+  void Remove(const StreamQueue* queue) {
+    sync_primitives::AutoLock lock(lock_);
+    queues_.erase(queue);
+  }
+  void Snapshot(std::vector<StreamQueueStatistics>* statistics) const {
+    sync_primitives::AutoLock lock(lock_);
+    for (std::set<const StreamQueue*>::const_iterator it = queues_.begin();
+         queues_.end() != it; ++it) {
+      statistics->push_back((*it)->statistics());
+    }
+  }
+
+ private:
+  StreamQueueRegistry() {}
+
+  mutable sync_primitives::Lock lock_;
+  std::set<const StreamQueue*> queues_;
+
+  FRIEND_BASE_SINGLETON_CLASS(StreamQueueRegistry);
+  DISALLOW_COPY_AND_ASSIGN(StreamQueueRegistry);
+};
+}  // namespace
+
+StreamQueueStatistics::StreamQueueStatistics()
+  : queued_frames(0),
+    queued_bytes(0),
+    dropped_frames(0),
+    dropped_bytes(0),
+    received_frames(0),
+    received_bytes(0),
+    frame_rate(0),
+    bitrate(0),
+    jitter_us(0),
+    average_latency_us(0),
+    max_latency_us(0) {
+}
+
+StreamQueue::StreamQueue(const std::string& name, size_t max_frames,
+                         size_t max_bytes, bool h264)
+  : name_(name),
+    max_frames_(max_frames),
+    max_bytes_(max_bytes),
+    h264_(h264),
+    queued_bytes_(0),
+    shutting_down_(false),
+    awaiting_key_frame_(false),
+    dropped_since_pop_(0),
+    dropped_frames_(0),
+    dropped_bytes_(0) {
+  ResetTelemetry();
+  StreamQueueRegistry::instance()->Add(this);
+}
+
+StreamQueue::~StreamQueue() {
+  StreamQueueRegistry::instance()->Remove(this);
+}
+
+bool StreamQueue::push(const protocol_handler::RawMessagePtr& message) {
+  if (!message) {
+    LOG4CXX_ERROR(logger_, "Null pointer message");
+    return false;
+  }
+  // Frame is inspected before taking the lock
+  const bool is_key_frame = h264_ && IsKeyFrame(*message);
+  const size_t size = message->data_size();
+  const int64_t now_us = NowUs();
+  {
+    sync_primitives::AutoLock lock(lock_);
+    if (shutting_down_) {
+      return false;
+    }
+    CountReceived(size, now_us);
+    if (h264_) {
+      if (is_key_frame) {
+        awaiting_key_frame_ = false;
+        // Queued frames are not needed to decode the key frame
+        while (!queue_.empty() && IsFull(size)) {
+          DropFront();
+        }
+      } else if (awaiting_key_frame_ || IsFull(size)) {
+        // Following frames reference dropped one, skip to next key frame
+        awaiting_key_frame_ = true;
+        CountDropped(size);
+        return false;
+      }
+    } else {
+      while (!queue_.empty() && IsFull(size)) {
+        DropFront();
+      }
+    }
+    queue_.push_back(message);
+    arrival_times_.push_back(now_us);
+    queued_bytes_ += size;
+  }
+  new_items_.NotifyOne();
+  return true;
+}
+
+size_t StreamQueue::PopAll(protocol_handler::RawMessageList& output,
+                           size_t* dropped_frames) {
+  DCHECK(dropped_frames);
+  output.clear();
+  const int64_t now_us = NowUs();
+  sync_primitives::AutoLock lock(lock_);
+  for (std::deque<int64_t>::const_iterator it = arrival_times_.begin();
+       arrival_times_.end() != it; ++it) {
+    const int64_t latency_us = now_us - *it;
+    Smooth(latency_us, &average_latency_us_);
+    max_latency_us_ = std::max(max_latency_us_, latency_us);
+  }
+  arrival_times_.clear();
+  output.assign(queue_.begin(), queue_.end());
+  queue_.clear();
+  queued_bytes_ = 0;
+  *dropped_frames = dropped_since_pop_;
+  dropped_since_pop_ = 0;
+  return output.size();
+}
+
+bool StreamQueue::empty() const {
+  sync_primitives::AutoLock lock(lock_);
+  return queue_.empty();
+}
+
+void StreamQueue::wait() {
+  sync_primitives::AutoLock lock(lock_);
+  while (!shutting_down_ && queue_.empty()) {
+    new_items_.Wait(lock);
+  }
+}
+
+void StreamQueue::Shutdown() {
+  sync_primitives::AutoLock lock(lock_);
+  shutting_down_ = true;
+  new_items_.Broadcast();
+}
+
+void StreamQueue::Reset() {
+  sync_primitives::AutoLock lock(lock_);
+  shutting_down_ = false;
+  awaiting_key_frame_ = false;
+  queue_.clear();
+  arrival_times_.clear();
+  queued_bytes_ = 0;
+  dropped_since_pop_ = 0;
+  ResetTelemetry();
+}
+
+StreamQueueStatistics StreamQueue::statistics() const {
+  StreamQueueStatistics result;
+  result.name = name_;
+  sync_primitives::AutoLock lock(lock_);
+  result.queued_frames = queue_.size();
+  result.queued_bytes = queued_bytes_;
+  result.dropped_frames = dropped_frames_;
+  result.dropped_bytes = dropped_bytes_;
+  result.received_frames = received_frames_;
+  result.received_bytes = received_bytes_;
+  result.frame_rate = frame_rate_;
+  result.bitrate = bitrate_;
+  result.jitter_us = jitter_us_;
+  result.average_latency_us = average_latency_us_;
+  result.max_latency_us = max_latency_us_;
+  return result;
+}
+
+void StreamQueue::Snapshot(std::vector<StreamQueueStatistics>* statistics) {
+  DCHECK(statistics);
+  StreamQueueRegistry::instance()->Snapshot(statistics);
+}
+
+bool StreamQueue::IsKeyFrame(const protocol_handler::RawMessage& message) {
+  bool start_code_found = false;
+  for (size_t fragment = 0; fragment < message.fragments_count(); ++fragment) {
+    const utils::BufferSlice& slice = message.fragment(fragment);
+    const uint8_t* data = slice.data();
+    const size_t size = slice.size();
+    // Parameter sets and slices are preceded by 00 00 01 start code
+    for (size_t i = 2; i + 1 < size; ++i) {
+      if (1 != data[i] || 0 != data[i - 1] || 0 != data[i - 2]) {
+        continue;
+      }
+      start_code_found = true;
+      const uint8_t nal_type = data[i + 1] & kNalTypeMask;
+      if (kNalTypeIdrSlice == nal_type || kNalTypeSps == nal_type ||
+          kNalTypePps == nal_type) {
+        return true;
+      }
+      if (kNalTypeNonIdrSlice <= nal_type && kNalTypeIdrSlice > nal_type) {
+        // First slice tells picture type
+        return false;
+      }
+    }
+  }
+  return !start_code_found;
+}
+
+bool StreamQueue::IsFull(size_t incoming_bytes) const {
+  return (max_frames_ > 0 && queue_.size() + 1 > max_frames_) ||
+         (max_bytes_ > 0 && queued_bytes_ + incoming_bytes > max_bytes_);
+}
+
+void StreamQueue::DropFront() {
+  const size_t size = queue_.front()->data_size();
+  queue_.pop_front();
+  arrival_times_.pop_front();
+  queued_bytes_ -= size;
+  CountDropped(size);
+}
+
+void StreamQueue::CountDropped(size_t bytes) {
+  ++dropped_since_pop_;
+  ++dropped_frames_;
+  dropped_bytes_ += bytes;
+  LOG4CXX_DEBUG(logger_, name_ << " dropped frame of " << bytes
+                << " bytes, " << dropped_frames_ << " dropped in total");
+}
+
+void StreamQueue::CountReceived(size_t bytes, int64_t now_us) {
+  ++received_frames_;
+  received_bytes_ += bytes;
+  if (0 != last_arrival_us_) {
+    const int64_t interval_us = now_us - last_arrival_us_;
+    if (0 == mean_interval_us_) {
+      mean_interval_us_ = interval_us;
+    }
+    Smooth(interval_us, &mean_interval_us_);
+    const int64_t deviation_us = interval_us - mean_interval_us_;
+    Smooth(deviation_us < 0 ? -deviation_us : deviation_us, &jitter_us_);
+  }
+  last_arrival_us_ = now_us;
+
+  if (0 == window_start_us_) {
+    window_start_us_ = now_us;
+  }
+  const int64_t window_us = now_us - window_start_us_;
+  if (window_us >= kRateWindowUs) {
+    frame_rate_ = static_cast<uint32_t>(
+        window_frames_ * kRateWindowUs / window_us);
+    bitrate_ = window_bytes_ * 8 * kRateWindowUs / window_us;
+    window_start_us_ = now_us;
+    window_frames_ = 0;
+    window_bytes_ = 0;
+  }
+  ++window_frames_;
+  window_bytes_ += bytes;
+}
+
+void StreamQueue::ResetTelemetry() {
+  received_frames_ = 0;
+  received_bytes_ = 0;
+  last_arrival_us_ = 0;
+  mean_interval_us_ = 0;
+  jitter_us_ = 0;
+  window_start_us_ = 0;
+  window_frames_ = 0;
+  window_bytes_ = 0;
+  frame_rate_ = 0;
+  bitrate_ = 0;
+  average_latency_us_ = 0;
+  max_latency_us_ = 0;
+}
+
+}  // namespace media_manager
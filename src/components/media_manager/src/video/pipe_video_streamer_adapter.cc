@@ -37,7 +37,8 @@ namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger, "PipeVideoStreamerAdapter")
 
-PipeVideoStreamerAdapter::PipeVideoStreamerAdapter() {
+PipeVideoStreamerAdapter::PipeVideoStreamerAdapter()
+  : PipeStreamerAdapter("VideoStream", true) {
   LOG4CXX_AUTO_TRACE(logger);
   named_pipe_path_ = profile::Profile::instance()->named_video_pipe_path();
 
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "utils/logger.h"
+#include "config_profile/profile.h"
+#include "media_manager/video/shm_video_streamer_adapter.h"
+
+namespace media_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "ShmVideoStreamerAdapter")
+
+namespace {
+const char* kShmName = "/sdl_video_ring";
+// Holds about a second of 30 Mbit/s stream
+const uint32_t kRingCapacity = 4 * 1024 * 1024;
+}  // namespace
+
+ShmVideoStreamerAdapter::ShmVideoStreamerAdapter()
+  : is_ready_(false),
+    thread_(threads::CreateThread("ShmStreamer", new Streamer(this))),
+    messages_("VideoStream",
+              profile::Profile::instance()->stream_queue_max_frames(),
+              profile::Profile::instance()->stream_queue_max_bytes(),
+              true) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  Init();
+}
+
+ShmVideoStreamerAdapter::~ShmVideoStreamerAdapter() {
+  LOG4CXX_AUTO_TRACE(logger_);
+
+  if ((0 != current_application_ ) && (is_ready_)) {
+    StopActivity(current_application_);
+  }
+
+  thread_->join();
+  delete thread_->delegate();
+  threads::DeleteThread(thread_);
+}
+
+void ShmVideoStreamerAdapter::SendData(
+  int32_t application_key,
+  const ::protocol_handler::RawMessagePtr message) {
+  LOG4CXX_AUTO_TRACE(logger_);
+
+  if (application_key != current_application_) {
+    LOG4CXX_WARN(logger_, "Wrong application " << application_key);
+    return;
+  }
+
+  if (is_ready_) {
+    messages_.push(message);
+  }
+}
+
+void ShmVideoStreamerAdapter::StartActivity(int32_t application_key) {
+  LOG4CXX_AUTO_TRACE(logger_);
+
+  if (application_key == current_application_) {
+    LOG4CXX_WARN(logger_, "Already started activity for " << application_key);
+    return;
+  }
+
+  current_application_ = application_key;
+  is_ready_ = true;
+
+  for (std::set<MediaListenerPtr>::iterator it = media_listeners_.begin();
+       media_listeners_.end() != it;
+       ++it) {
+    (*it)->OnActivityStarted(application_key);
+  }
+}
+
+void ShmVideoStreamerAdapter::StopActivity(int32_t application_key) {
+  LOG4CXX_AUTO_TRACE(logger_);
+
+  if (application_key != current_application_) {
+    LOG4CXX_WARN(logger_, "Not performing activity for " << application_key);
+    return;
+  }
+
+  is_ready_ = false;
+  current_application_ = 0;
+
+  for (std::set<MediaListenerPtr>::iterator it = media_listeners_.begin();
+       media_listeners_.end() != it;
+       ++it) {
+    (*it)->OnActivityEnded(application_key);
+  }
+}
+
+bool ShmVideoStreamerAdapter::is_app_performing_activity(
+  int32_t application_key) {
+  return (application_key == current_application_);
+}
+
+void ShmVideoStreamerAdapter::Init() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (thread_->is_running()) {
+    thread_->stop();
+    thread_->join();
+  }
+  LOG4CXX_DEBUG(logger_, "Start sending thread");
+  const size_t kStackSize = 16384;
+  thread_->start(threads::ThreadOptions(kStackSize));
+}
+
+ShmVideoStreamerAdapter::Streamer::Streamer(
+  ShmVideoStreamerAdapter* server)
+  : server_(server),
+    memory_(MAP_FAILED),
+    stop_flag_(false) {
+}
+
+ShmVideoStreamerAdapter::Streamer::~Streamer() {
+  server_ = NULL;
+}
+
+void ShmVideoStreamerAdapter::Streamer::threadMain() {
+  LOG4CXX_AUTO_TRACE(logger_);
+
+  if (!open()) {
+    return;
+  }
+
+  while (!stop_flag_) {
+    size_t dropped = 0;
+    server_->messages_.PopAll(batch_, &dropped);
+    while (!batch_.empty() || dropped > 0) {
+      if (!WriteBatch()) {
+        // Ring was stopped, adapter is being destroyed
+        break;
+      }
+
+      static int32_t messsages_for_session = 0;
+      // Dropped frames are acknowledged too, so mobile keeps streaming
+      const size_t processed = batch_.size() + dropped;
+      for (size_t i = 0; i < processed; ++i) {
+        ++messsages_for_session;
+
+        LOG4CXX_DEBUG(logger_, "Handling map streaming message. This is "
+                     << messsages_for_session << " the message for "
+                     << server_->current_application_);
+        std::set<MediaListenerPtr>::iterator it =
+            server_->media_listeners_.begin();
+        for (; server_->media_listeners_.end() != it; ++it) {
+          (*it)->OnDataReceived(server_->current_application_,
+                                messsages_for_session);
+        }
+      }
+      server_->messages_.PopAll(batch_, &dropped);
+    }
+    server_->messages_.wait();
+  }
+  close();
+}
+
+bool ShmVideoStreamerAdapter::Streamer::WriteBatch() {
+  for (protocol_handler::RawMessageList::const_iterator it = batch_.begin();
+       batch_.end() != it; ++it) {
+    // Blocks while decoder has not freed enough space
+    if (!ring_.Write(reinterpret_cast<const char*>((*it)->data()),
+                     (*it)->data_size())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ShmVideoStreamerAdapter::Streamer::exitThreadMain() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  stop_flag_ = true;
+  // Wakes up streamer blocked on full ring
+  ring_.Stop();
+  server_->messages_.Shutdown();
+}
+
+bool ShmVideoStreamerAdapter::Streamer::open() {
+  LOG4CXX_AUTO_TRACE(logger_);
+
+  const size_t memory_size = ::utils::ShmRing::RequiredSize(kRingCapacity);
+  const int fd = shm_open(kShmName, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+  if (-1 == fd) {
+    LOG4CXX_ERROR(logger_, "Cannot open shared memory " << kShmName
+                  << ", error " << errno);
+    return false;
+  }
+  if (0 == ftruncate(fd, memory_size)) {
+    memory_ = mmap(NULL, memory_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   fd, 0);
+  }
+  ::close(fd);
+  if (MAP_FAILED == memory_) {
+    LOG4CXX_ERROR(logger_, "Cannot map shared memory " << kShmName
+                  << ", error " << errno);
+    shm_unlink(kShmName);
+    return false;
+  }
+  ring_.Attach(memory_, kRingCapacity, true);
+
+  LOG4CXX_DEBUG(logger_, "Shared memory " << kShmName
+                << " was successfully created");
+  return true;
+}
+
+void ShmVideoStreamerAdapter::Streamer::close() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (MAP_FAILED != memory_) {
+    munmap(memory_, ::utils::ShmRing::RequiredSize(kRingCapacity));
+    memory_ = MAP_FAILED;
+  }
+  shm_unlink(kShmName);
+}
+
+}  // namespace media_manager
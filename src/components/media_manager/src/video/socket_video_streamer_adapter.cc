@@ -38,7 +38,8 @@ namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger, "SocketVideoStreamerAdapter")
 
-SocketVideoStreamerAdapter::SocketVideoStreamerAdapter() {
+SocketVideoStreamerAdapter::SocketVideoStreamerAdapter()
+  : SocketStreamerAdapter("VideoStream", true) {
   LOG4CXX_AUTO_TRACE(logger);
   port_ = profile::Profile::instance()->video_streaming_port();
   ip_ = profile::Profile::instance()->server_address();
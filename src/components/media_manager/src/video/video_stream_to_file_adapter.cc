@@ -30,20 +30,52 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
 #include "utils/logger.h"
 #include "utils/file_system.h"
 #include "config_profile/profile.h"
+#include "media_manager/message_batch_writer.h"
 #include "media_manager/video/video_stream_to_file_adapter.h"
 
 namespace media_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger, "VideoStreamToFileAdapter")
 
-VideoStreamToFileAdapter::VideoStreamToFileAdapter(const std::string& file_name)
+namespace {
+// File space is reserved this much at a time, so file is not fragmented
+const uint64_t kPreallocationStep = 8 * 1024 * 1024;
+// Written data is synced and dropped from page cache every this many bytes
+const uint64_t kSyncStep = 4 * 1024 * 1024;
+const char* kRotatedFileSuffix = ".1";
+
+uint64_t DataSize(const protocol_handler::RawMessageList& messages) {
+  uint64_t size = 0;
+  for (protocol_handler::RawMessageList::const_iterator it = messages.begin();
+       messages.end() != it; ++it) {
+    if (*it) {
+      size += (*it)->data_size();
+    }
+  }
+  return size;
+}
+}  // namespace
+
+VideoStreamToFileAdapter::VideoStreamToFileAdapter(const std::string& file_name,
+                                                   bool is_video)
   : file_name_(file_name),
+    is_video_(is_video),
+    max_file_size_(profile::Profile::instance()->stream_file_max_size()),
     is_ready_(false),
     thread_(threads::CreateThread("VideoStreamer",
-                                    new Streamer(this))) {
+                                    new Streamer(this))),
+    messages_(file_name,
+              profile::Profile::instance()->stream_queue_max_frames(),
+              profile::Profile::instance()->stream_queue_max_bytes(),
+              is_video) {
   Init();
 }
 
@@ -130,12 +162,15 @@ VideoStreamToFileAdapter::Streamer::Streamer(
   VideoStreamToFileAdapter* server)
   : server_(server),
     stop_flag_(false),
-    file_stream_(NULL) {
+    file_fd_(-1),
+    file_size_(0),
+    allocated_size_(0),
+    preallocation_supported_(true),
+    unsynced_size_(0) {
 }
 
 VideoStreamToFileAdapter::Streamer::~Streamer() {
   server_ = NULL;
-  file_stream_ = NULL;
 }
 
 void VideoStreamToFileAdapter::Streamer::threadMain() {
@@ -144,17 +179,19 @@ void VideoStreamToFileAdapter::Streamer::threadMain() {
   open();
 
   while (!stop_flag_) {
-    while (!server_->messages_.empty()) {
-      ::protocol_handler::RawMessagePtr msg = server_->messages_.pop();
-      if (!msg) {
-        LOG4CXX_ERROR(logger, "Null pointer message");
-        continue;
+    size_t dropped = 0;
+    server_->messages_.PopAll(batch_, &dropped);
+    while (!batch_.empty() || dropped > 0) {
+      if (-1 != file_fd_) {
+        WriteBatch();
+      } else {
+        LOG4CXX_WARN(logger, "Can't open File stream! " << server_->file_name_);
       }
 
-      if (file_stream_) {
-        file_system::Write(file_stream_, msg->data(), msg->data_size());
-
-        static int32_t messsages_for_session = 0;
+      static int32_t messsages_for_session = 0;
+      // Dropped frames are acknowledged too, so mobile keeps streaming
+      const size_t processed = batch_.size() + dropped;
+      for (size_t i = 0; i < processed; ++i) {
         ++messsages_for_session;
         std::set<MediaListenerPtr>::iterator it =
             server_->media_listeners_.begin();
@@ -162,9 +199,8 @@ void VideoStreamToFileAdapter::Streamer::threadMain() {
           (*it)->OnDataReceived(server_->current_application_,
                                 messsages_for_session);
         }
-      } else {
-        LOG4CXX_WARN(logger, "Can't open File stream! " << server_->file_name_);
       }
+      server_->messages_.PopAll(batch_, &dropped);
     }
     server_->messages_.wait();
   }
@@ -172,6 +208,88 @@ void VideoStreamToFileAdapter::Streamer::threadMain() {
   close();
 }
 
+void VideoStreamToFileAdapter::Streamer::WriteBatch() {
+  protocol_handler::RawMessageList::iterator split = batch_.end();
+  if (IsRotationDue()) {
+    for (split = batch_.begin(); batch_.end() != split; ++split) {
+      if (*split && (!server_->is_video_ || StreamQueue::IsKeyFrame(**split))) {
+        break;
+      }
+    }
+  }
+  if (batch_.end() == split) {
+    Write(batch_);
+    return;
+  }
+  const protocol_handler::RawMessageList head(batch_.begin(), split);
+  const protocol_handler::RawMessageList tail(split, batch_.end());
+  if (!head.empty()) {
+    Write(head);
+  }
+  Rotate();
+  if (-1 != file_fd_) {
+    Write(tail);
+  }
+}
+
+bool VideoStreamToFileAdapter::Streamer::Write(
+  const protocol_handler::RawMessageList& messages) {
+  const uint64_t size = DataSize(messages);
+  Preallocate(file_size_ + size);
+  if (!WriteMessages(file_fd_, messages, false)) {
+    LOG4CXX_ERROR(logger, "Failed writing to " << server_->file_name_);
+    return false;
+  }
+  file_size_ += size;
+  unsynced_size_ += size;
+  if (unsynced_size_ >= kSyncStep) {
+    // Synced pages are not needed anymore, recording should not
+    // push streaming and apps out of page cache
+    if (0 != fdatasync(file_fd_)) {
+      LOG4CXX_WARN(logger, "fdatasync failed: " << strerror(errno));
+    }
+    posix_fadvise(file_fd_, 0, 0, POSIX_FADV_DONTNEED);
+    unsynced_size_ = 0;
+  }
+  return true;
+}
+
+void VideoStreamToFileAdapter::Streamer::Preallocate(uint64_t size) {
+#if defined(OS_LINUX)
+  if (!preallocation_supported_ || size <= allocated_size_) {
+    return;
+  }
+  const uint64_t allocated =
+      (size + kPreallocationStep - 1) / kPreallocationStep * kPreallocationStep;
+  // Size of file is kept, so reader sees only written data
+  if (0 != fallocate(file_fd_, FALLOC_FL_KEEP_SIZE, allocated_size_,
+                     allocated - allocated_size_)) {
+    LOG4CXX_DEBUG(logger, "File space is not preallocated: "
+                  << strerror(errno));
+    preallocation_supported_ = false;
+    return;
+  }
+  allocated_size_ = allocated;
+#endif
+}
+
+bool VideoStreamToFileAdapter::Streamer::IsRotationDue() const {
+  return 0 != server_->max_file_size_ && file_size_ >= server_->max_file_size_;
+}
+
+void VideoStreamToFileAdapter::Streamer::Rotate() {
+  LOG4CXX_INFO(logger, "Rotating " << server_->file_name_ << " of "
+               << file_size_ << " bytes");
+  const std::string rotated_name = server_->file_name_ + kRotatedFileSuffix;
+  ::close(file_fd_);
+  file_fd_ = -1;
+  if (0 != rename(server_->file_name_.c_str(), rotated_name.c_str())) {
+    LOG4CXX_WARN(logger, "Failed renaming to " << rotated_name << ": "
+                 << strerror(errno));
+  }
+  open();
+}
+
 void VideoStreamToFileAdapter::Streamer::exitThreadMain() {
   LOG4CXX_INFO(logger, "Streamer::exitThreadMain");
   stop_flag_ = true;
@@ -184,21 +302,30 @@ void VideoStreamToFileAdapter::Streamer::open() {
   DCHECK(file_system::CreateDirectoryRecursively(
       profile::Profile::instance()->app_storage_folder()));
 
-  file_stream_ = file_system::Open(server_->file_name_);
-  if (!file_stream_) {
-      LOG4CXX_WARN(logger, "Can't open file stream! " << server_->file_name_);
+  file_fd_ = ::open(server_->file_name_.c_str(),
+                    O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP);
+  file_size_ = 0;
+  allocated_size_ = 0;
+  unsynced_size_ = 0;
+  if (-1 == file_fd_) {
+    LOG4CXX_WARN(logger, "Can't open file stream! " << server_->file_name_
+                 << ": " << strerror(errno));
   } else {
-    LOG4CXX_INFO(logger, "file_stream_ opened :" << file_stream_);
+    LOG4CXX_INFO(logger, "file opened: " << file_fd_);
   }
 }
 
 void VideoStreamToFileAdapter::Streamer::close() {
-  if (file_stream_) {
-    file_system::Close(file_stream_);
-    delete file_stream_;
-    file_stream_ = NULL;
+  if (-1 != file_fd_) {
+    // Space preallocated beyond written data is released
+    if (0 != allocated_size_) {
+      ftruncate(file_fd_, static_cast<off_t>(file_size_));
+    }
+    ::close(file_fd_);
+    file_fd_ = -1;
   }
   file_system::DeleteFile(server_->file_name_);
+  file_system::DeleteFile(server_->file_name_ + kRotatedFileSuffix);
 }
 
 }  //  namespace media_manager
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include "gmock/gmock.h"
+#include "media_manager/audio/audio_ring_buffer.h"
+
+namespace test {
+namespace components {
+namespace media_manager_test {
+
+using ::media_manager::AudioRingBuffer;
+
+namespace {
+std::vector<uint8_t> Bytes(uint8_t first, size_t count) {
+  std::vector<uint8_t> bytes(count);
+  for (size_t i = 0; i < count; ++i) {
+    bytes[i] = static_cast<uint8_t>(first + i);
+  }
+  return bytes;
+}
+}  // namespace
+
+TEST(AudioRingBufferTest, Writes_ExpectReadInOrder) {
+  AudioRingBuffer buffer(8);
+  const std::vector<uint8_t> first = Bytes(0, 3);
+  const std::vector<uint8_t> second = Bytes(3, 4);
+  buffer.Write(&first[0], first.size());
+  buffer.Write(&second[0], second.size());
+  EXPECT_EQ(7u, buffer.size());
+
+  std::vector<uint8_t> data;
+  EXPECT_EQ(7u, buffer.Read(&data));
+  EXPECT_EQ(Bytes(0, 7), data);
+  EXPECT_EQ(0u, buffer.size());
+  EXPECT_EQ(0u, buffer.Read(&data));
+  EXPECT_TRUE(data.empty());
+  EXPECT_EQ(0u, buffer.dropped_bytes());
+}
+
+TEST(AudioRingBufferTest, Overflow_ExpectOldestDropped) {
+  AudioRingBuffer buffer(8);
+  const std::vector<uint8_t> first = Bytes(0, 6);
+  const std::vector<uint8_t> second = Bytes(6, 4);
+  buffer.Write(&first[0], first.size());
+  buffer.Write(&second[0], second.size());
+
+  std::vector<uint8_t> data;
+  EXPECT_EQ(8u, buffer.Read(&data));
+  EXPECT_EQ(Bytes(2, 8), data);
+  EXPECT_EQ(2u, buffer.dropped_bytes());
+}
+
+TEST(AudioRingBufferTest, WrappedAround_ExpectReadInOrder) {
+  AudioRingBuffer buffer(8);
+  const std::vector<uint8_t> first = Bytes(0, 6);
+  buffer.Write(&first[0], first.size());
+  std::vector<uint8_t> data;
+  buffer.Read(&data);
+
+  const std::vector<uint8_t> second = Bytes(6, 5);
+  buffer.Write(&second[0], second.size());
+  EXPECT_EQ(5u, buffer.Read(&data));
+  EXPECT_EQ(second, data);
+}
+
+TEST(AudioRingBufferTest, WriteLargerThanCapacity_ExpectLatestKept) {
+  AudioRingBuffer buffer(4);
+  const std::vector<uint8_t> first = Bytes(0, 2);
+  const std::vector<uint8_t> second = Bytes(2, 6);
+  buffer.Write(&first[0], first.size());
+  buffer.Write(&second[0], second.size());
+
+  std::vector<uint8_t> data;
+  EXPECT_EQ(4u, buffer.Read(&data));
+  EXPECT_EQ(Bytes(4, 4), data);
+  EXPECT_EQ(4u, buffer.dropped_bytes());
+}
+
+TEST(AudioRingBufferTest, Clear_ExpectEmpty) {
+  AudioRingBuffer buffer(4);
+  const std::vector<uint8_t> bytes = Bytes(0, 3);
+  buffer.Write(&bytes[0], bytes.size());
+  buffer.Clear();
+  EXPECT_EQ(0u, buffer.size());
+  std::vector<uint8_t> data;
+  EXPECT_EQ(0u, buffer.Read(&data));
+}
+
+}  // namespace media_manager_test
+}  // namespace components
+}  // namespace test
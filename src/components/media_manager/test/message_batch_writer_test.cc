@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <string>
+#include "gmock/gmock.h"
+#include "media_manager/message_batch_writer.h"
+#include "utils/shared_ptr.h"
+
+namespace test {
+namespace components {
+namespace media_manager_test {
+
+using protocol_handler::RawMessage;
+using protocol_handler::RawMessagePtr;
+using protocol_handler::RawMessageList;
+
+namespace {
+RawMessagePtr MakeMessage(const std::string& data) {
+  return utils::MakeShared<RawMessage>(
+      1, 3, reinterpret_cast<const uint8_t*>(data.c_str()), data.size());
+}
+
+std::string ReadAll(int fd, size_t size) {
+  std::string result(size, '\0');
+  size_t received = 0;
+  while (received < size) {
+    const ssize_t ret = read(fd, &result[received], size - received);
+    if (ret <= 0) {
+      break;
+    }
+    received += ret;
+  }
+  result.resize(received);
+  return result;
+}
+
+struct ReadArgs {
+  int fd;
+  size_t size;
+  std::string result;
+};
+
+void* ReadLater(void* data) {
+  ReadArgs* args = static_cast<ReadArgs*>(data);
+  usleep(50000);
+  args->result = ReadAll(args->fd, args->size);
+  return NULL;
+}
+}  // namespace
+
+class MessageBatchWriterTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    ASSERT_EQ(0, pipe(fds_));
+  }
+  virtual void TearDown() {
+    close(fds_[0]);
+    close(fds_[1]);
+  }
+  int fds_[2];
+};
+
+TEST_F(MessageBatchWriterTest, WriteMessages_ExpectDataWrittenInOrder) {
+  RawMessageList messages;
+  messages.push_back(MakeMessage("first;"));
+  messages.push_back(RawMessagePtr());
+  messages.push_back(MakeMessage("second;"));
+  messages.push_back(MakeMessage("third"));
+
+  ASSERT_TRUE(media_manager::WriteMessages(fds_[1], messages, false));
+  EXPECT_EQ("first;second;third", ReadAll(fds_[0], 18));
+}
+
+TEST_F(MessageBatchWriterTest, WriteMessages_FragmentedMessage_ExpectNotMerged) {
+  const std::string text = "headerpayload";
+  const utils::BufferSlice whole(
+      reinterpret_cast<const uint8_t*>(text.c_str()), text.size());
+  RawMessageList messages;
+  messages.push_back(utils::MakeShared<RawMessage>(
+      1, 3, whole.Slice(0, 6), whole.Slice(6, 7)));
+
+  ASSERT_TRUE(media_manager::WriteMessages(fds_[1], messages, false));
+  EXPECT_EQ(2u, messages[0]->fragments_count());
+  EXPECT_EQ(text, ReadAll(fds_[0], text.size()));
+}
+
+TEST_F(MessageBatchWriterTest, WriteMessages_MoreThanSingleCall_ExpectAllWritten) {
+  RawMessageList messages;
+  std::string expected;
+  for (int i = 0; i < 200; ++i) {
+    const std::string data(1, static_cast<char>('a' + i % 26));
+    messages.push_back(MakeMessage(data));
+    expected += data;
+  }
+
+  ASSERT_TRUE(media_manager::WriteMessages(fds_[1], messages, false));
+  EXPECT_EQ(expected, ReadAll(fds_[0], expected.size()));
+}
+
+TEST_F(MessageBatchWriterTest, WriteMessages_ClosedPeerSocket_ExpectFailure) {
+  int sockets[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+  close(sockets[1]);
+  RawMessageList messages;
+  messages.push_back(MakeMessage("data"));
+
+  // Has to fail without raising SIGPIPE
+  EXPECT_FALSE(media_manager::WriteMessages(sockets[0], messages, true));
+  close(sockets[0]);
+}
+
+TEST_F(MessageBatchWriterTest, WriteMessages_NonBlockingFullPipe_ExpectWaitedForReader) {
+  ASSERT_EQ(0, fcntl(fds_[1], F_SETFL, O_NONBLOCK));
+  // More than default pipe capacity
+  const std::string data(256 * 1024, 'x');
+  RawMessageList messages;
+  messages.push_back(MakeMessage(data));
+
+  ReadArgs args = { fds_[0], data.size(), std::string() };
+  pthread_t reader;
+  ASSERT_EQ(0, pthread_create(&reader, NULL, &ReadLater, &args));
+  EXPECT_TRUE(media_manager::WriteMessages(fds_[1], messages, false));
+  pthread_join(reader, NULL);
+  EXPECT_EQ(data, args.result);
+}
+
+TEST_F(MessageBatchWriterTest, WriteMessages_StoppedWhileFull_ExpectFailure) {
+  ASSERT_EQ(0, fcntl(fds_[1], F_SETFL, O_NONBLOCK));
+  RawMessageList messages;
+  messages.push_back(MakeMessage(std::string(256 * 1024, 'x')));
+
+  const volatile bool stop_flag = true;
+  EXPECT_FALSE(media_manager::WriteMessages(fds_[1], messages, false,
+                                            &stop_flag));
+}
+
+}  // namespace media_manager_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "gmock/gmock.h"
+#include "media_manager/stream_queue.h"
+#include "utils/shared_ptr.h"
+
+namespace test {
+namespace components {
+namespace media_manager_test {
+
+using media_manager::StreamQueue;
+using protocol_handler::RawMessage;
+using protocol_handler::RawMessagePtr;
+using protocol_handler::RawMessageList;
+
+namespace {
+const uint8_t kIdrNal = 0x65;
+const uint8_t kNonIdrNal = 0x41;
+const uint8_t kSpsNal = 0x67;
+const uint8_t kSeiNal = 0x06;
+
+// Annex B frame of given NAL units, padded to size
+RawMessagePtr MakeFrame(const std::vector<uint8_t>& nal_headers,
+                        size_t size = 16) {
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < nal_headers.size(); ++i) {
+    data.push_back(0);
+    data.push_back(0);
+    data.push_back(0);
+    data.push_back(1);
+    data.push_back(nal_headers[i]);
+    data.push_back(0xAA);
+  }
+  data.resize(std::max(size, data.size()), 0xAA);
+  return utils::MakeShared<RawMessage>(1, 3, &data[0], data.size(),
+                                       protocol_handler::kMobileNav);
+}
+
+RawMessagePtr MakeFrame(uint8_t nal_header, size_t size = 16) {
+  return MakeFrame(std::vector<uint8_t>(1, nal_header), size);
+}
+
+std::vector<RawMessagePtr> PopAll(StreamQueue& queue, size_t* dropped) {
+  RawMessageList result;
+  queue.PopAll(result, dropped);
+  return result;
+}
+}  // namespace
+
+TEST(StreamQueueTest, IsKeyFrame_ExpectIdrAndParameterSetsDetected) {
+  EXPECT_TRUE(StreamQueue::IsKeyFrame(*MakeFrame(kIdrNal)));
+  EXPECT_FALSE(StreamQueue::IsKeyFrame(*MakeFrame(kNonIdrNal)));
+
+  std::vector<uint8_t> gop_start;
+  gop_start.push_back(kSeiNal);
+  gop_start.push_back(kSpsNal);
+  gop_start.push_back(kIdrNal);
+  EXPECT_TRUE(StreamQueue::IsKeyFrame(*MakeFrame(gop_start)));
+
+  std::vector<uint8_t> sei_slice;
+  sei_slice.push_back(kSeiNal);
+  sei_slice.push_back(kNonIdrNal);
+  EXPECT_FALSE(StreamQueue::IsKeyFrame(*MakeFrame(sei_slice)));
+
+  const uint8_t raw[] = {0xAA, 0xBB, 0xCC, 0xDD};
+  EXPECT_TRUE(StreamQueue::IsKeyFrame(RawMessage(1, 3, raw, sizeof(raw))));
+}
+
+TEST(StreamQueueTest, Unbounded_ExpectNothingDropped) {
+  StreamQueue queue("video", 0, 0, true);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(queue.push(MakeFrame(kNonIdrNal)));
+  }
+  size_t dropped = 0;
+  EXPECT_EQ(100u, PopAll(queue, &dropped).size());
+  EXPECT_EQ(0u, dropped);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(StreamQueueTest, H264Full_ExpectNonIdrDroppedUntilKeyFrame) {
+  StreamQueue queue("video", 2, 0, true);
+  EXPECT_TRUE(queue.push(MakeFrame(kIdrNal)));
+  EXPECT_TRUE(queue.push(MakeFrame(kNonIdrNal)));
+  EXPECT_FALSE(queue.push(MakeFrame(kNonIdrNal)));
+
+  size_t dropped = 0;
+  EXPECT_EQ(2u, PopAll(queue, &dropped).size());
+  EXPECT_EQ(1u, dropped);
+
+  // Queue has room now, but frames reference dropped one
+  EXPECT_FALSE(queue.push(MakeFrame(kNonIdrNal)));
+  EXPECT_TRUE(queue.push(MakeFrame(kIdrNal)));
+  EXPECT_TRUE(queue.push(MakeFrame(kNonIdrNal)));
+
+  const std::vector<RawMessagePtr> frames = PopAll(queue, &dropped);
+  ASSERT_EQ(2u, frames.size());
+  EXPECT_TRUE(StreamQueue::IsKeyFrame(*frames[0]));
+  EXPECT_EQ(1u, dropped);
+
+  const media_manager::StreamQueueStatistics statistics = queue.statistics();
+  EXPECT_EQ("video", statistics.name);
+  EXPECT_EQ(2u, statistics.dropped_frames);
+  EXPECT_EQ(32u, statistics.dropped_bytes);
+}
+
+TEST(StreamQueueTest, H264KeyFrameToFullQueue_ExpectQueuedFramesReplaced) {
+  StreamQueue queue("video", 0, 40, true);
+  EXPECT_TRUE(queue.push(MakeFrame(kIdrNal, 20)));
+  EXPECT_TRUE(queue.push(MakeFrame(kNonIdrNal, 20)));
+  EXPECT_TRUE(queue.push(MakeFrame(kIdrNal, 30)));
+
+  size_t dropped = 0;
+  const std::vector<RawMessagePtr> frames = PopAll(queue, &dropped);
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(30u, frames[0]->data_size());
+  EXPECT_EQ(2u, dropped);
+}
+
+TEST(StreamQueueTest, NotH264Full_ExpectOldestDropped) {
+  StreamQueue queue("audio", 2, 0, false);
+  const RawMessagePtr first = MakeFrame(kNonIdrNal);
+  const RawMessagePtr second = MakeFrame(kNonIdrNal);
+  const RawMessagePtr third = MakeFrame(kNonIdrNal);
+  EXPECT_TRUE(queue.push(first));
+  EXPECT_TRUE(queue.push(second));
+  EXPECT_TRUE(queue.push(third));
+
+  size_t dropped = 0;
+  const std::vector<RawMessagePtr> frames = PopAll(queue, &dropped);
+  ASSERT_EQ(2u, frames.size());
+  EXPECT_EQ(second.get(), frames[0].get());
+  EXPECT_EQ(third.get(), frames[1].get());
+  EXPECT_EQ(1u, dropped);
+}
+
+TEST(StreamQueueTest, Snapshot_ExpectExistingQueuesReported) {
+  std::vector<media_manager::StreamQueueStatistics> before;
+  StreamQueue::Snapshot(&before);
+  {
+    StreamQueue queue("snapshot", 0, 0, false);
+    queue.push(MakeFrame(kIdrNal, 10));
+    std::vector<media_manager::StreamQueueStatistics> statistics;
+    StreamQueue::Snapshot(&statistics);
+    ASSERT_EQ(before.size() + 1, statistics.size());
+  }
+  std::vector<media_manager::StreamQueueStatistics> after;
+  StreamQueue::Snapshot(&after);
+  EXPECT_EQ(before.size(), after.size());
+}
+
+TEST(StreamQueueTest, Shutdown_ExpectPushRejectedUntilReset) {
+  StreamQueue queue("video", 0, 0, true);
+  queue.Shutdown();
+  queue.wait();
+  EXPECT_FALSE(queue.push(MakeFrame(kIdrNal)));
+  queue.Reset();
+  EXPECT_TRUE(queue.push(MakeFrame(kIdrNal)));
+  EXPECT_FALSE(queue.empty());
+}
+
+TEST(StreamQueueTest, Statistics_ExpectReceivedAndLatencyCounted) {
+  StreamQueue queue("telemetry", 1, 0, false);
+  queue.push(MakeFrame(kIdrNal, 10));
+  usleep(2000);
+  queue.push(MakeFrame(kIdrNal, 20));
+
+  media_manager::StreamQueueStatistics statistics = queue.statistics();
+  EXPECT_EQ(2u, statistics.received_frames);
+  EXPECT_EQ(30u, statistics.received_bytes);
+  EXPECT_EQ(1u, statistics.dropped_frames);
+  EXPECT_EQ(0u, statistics.max_latency_us);
+
+  usleep(2000);
+  size_t dropped = 0;
+  ASSERT_EQ(1u, PopAll(queue, &dropped).size());
+  statistics = queue.statistics();
+  EXPECT_LE(2000u, statistics.max_latency_us);
+  EXPECT_LT(0u, statistics.average_latency_us);
+
+  queue.Reset();
+  statistics = queue.statistics();
+  EXPECT_EQ(0u, statistics.received_frames);
+  EXPECT_EQ(0u, statistics.max_latency_us);
+}
+
+}  // namespace media_manager_test
+}  // namespace components
+}  // namespace test
@@ -33,9 +33,11 @@
 #define SRC_COMPONENTS_POLICY_SRC_POLICY_INCLUDE_POLICY_ACCESS_REMOTE_IMPL_H_
 
 #include <map>
+#include <set>
 #include "types.h"
 #include "utils/macro.h"
 #include "utils/shared_ptr.h"
+#include "utils/lock.h"
 #include "policy/access_remote.h"
 #include "policy/cache_manager.h"
 
@@ -86,15 +88,42 @@ class AccessRemoteImpl : public AccessRemote {
   typedef std::map<Object, AccessControlRow> AccessControlList;
   typedef std::map<Subject, policy_table::AppHMITypes> HMIList;
   typedef std::map<std::string, SeatLocation> SeatList;
+  /**
+   * Parameters allowed for RPC, empty set means any parameter is allowed
+   */
+  typedef std::set<std::string> AllowedParameters;
+  /**
+   * RPCs allowed for module, empty map means any RPC is allowed
+   */
+  typedef std::map<std::string, AllowedParameters> AllowedRpcs;
+  typedef std::map<policy_table::ModuleType, AllowedRpcs> AllowedModules;
+  struct ZoneAccess {
+    AllowedModules auto_allow;
+    AllowedModules driver_allow;
+  };
+  typedef std::map<SeatLocation, ZoneAccess> ZoneList;
+  /**
+   * Module types allowed for application, empty set means any module
+   * is allowed. Application without module types is absent
+   */
+  typedef std::map<std::string, std::set<policy_table::ModuleType> >
+      ModuleTypeList;
   inline void set_enabled(bool value);
   inline bool country_consent() const;
   const policy_table::AppHMITypes& HmiTypes(const Subject& who);
   void GetGroupsIds(const std::string &device_id, const std::string &app_id,
                     FunctionalGroupIDs& grops_ids);
-  bool IsAllowed(const policy_table::AccessModules& modules,
-                 const std::string& module_name, const std::string& rpc_name,
+  /**
+   * @brief Rebuilds lookup lists if policy table was published
+   * since last call, index_lock_ should be acquired
+   */
+  void UpdateIndex() const;
+  static void IndexModules(const policy_table::AccessModules& modules,
+                           AllowedModules* index);
+  bool IsAllowed(const AllowedModules& modules,
+                 policy_table::ModuleType module, const std::string& rpc_name,
                  RemoteControlParams* input) const;
-  bool CompareParameters(const policy_table::Strings& parameters,
+  bool CompareParameters(const AllowedParameters& parameters,
                          RemoteControlParams* input) const;
   utils::SharedPtr<CacheManager> cache_;
   PTString primary_device_;
@@ -103,6 +132,12 @@ class AccessRemoteImpl : public AccessRemote {
   HMIList hmi_types_;
   SeatList seats_;
 
+  // Lookup lists built from published version of policy table
+  mutable sync_primitives::Lock index_lock_;
+  mutable CacheManager::TableVersion indexed_pt_;
+  mutable ModuleTypeList module_types_;
+  mutable ZoneList zones_;
+
   friend struct Erase;
   friend struct IsTypeAccess;
 
@@ -39,11 +39,14 @@
 #include "policy/pt_representation.h"
 #include "policy/pt_ext_representation.h"
 #include "usage_statistics/statistics_manager.h"
+#include "usage_statistics/statistics_registry.h"
 #include "policy/cache_manager_interface.h"
 
 #include "utils/lock.h"
 #include "utils/timer_thread.h"
 #include "utils/conditional_variable.h"
+#include "utils/date_time.h"
+#include "utils/metrics_registry.h"
 
 namespace policy {
 
@@ -550,6 +553,12 @@ class CacheManager : public CacheManagerInterface {
    */
   void Backup();
 
+  /**
+   * @brief Backup schedules saving of modified sections of cache
+   * @param sections Mask of TableSection values which were modified
+   */
+  void Backup(uint32_t sections);
+
 
   /**
    * Returns heart beat timeout
@@ -589,6 +598,18 @@ private:
 
   void PersistData();
 
+  /**
+   * @brief Records time spent to save policy table to backup
+   */
+  void RecordPersistTime(const TimevalStruct& start_time);
+
+  /**
+   * @brief Stores applications of usage statistics collected in memory into
+   * cache and schedules backup, once flush interval is over since last one
+   * @param force flush regardless of interval, e.g. on shutdown
+   */
+  void FlushUsageStatistics(bool force);
+
   void ResetCalculatedPermissions();
 
   void AddCalculatedPermissions(
@@ -600,6 +621,66 @@ private:
                                const std::string& policy_app_id,
                                policy::Permissions& permission);
 
+private:
+  static const size_t kHmiLevelsCount = policy_table::HL_NONE + 1;
+
+  /**
+   * @brief Permissions of rpc compiled from all groups of a group set,
+   * bit of HMI level is set in allowed_levels if rpc is allowed on it and
+   * parameters allowed on every level are bits of policy_table::Parameter
+   */
+  struct RpcPermissions {
+    RpcPermissions();
+    uint32_t allowed_levels;
+    uint32_t parameters[kHmiLevelsCount];
+  };
+  typedef std::map<std::string, RpcPermissions> RpcPermissionsMap;
+
+  /**
+   * @brief Orders group sets by names without joining them, so the key is
+   * not built for every permissions check
+   */
+  struct GroupsLess {
+    bool operator()(const policy_table::Strings& lhs,
+                    const policy_table::Strings& rhs) const;
+  };
+  typedef std::map<policy_table::Strings, RpcPermissionsMap, GroupsLess>
+      PermissionsMatrices;
+
+  /**
+   * @brief Gets rpc permissions of group set, compiling them from functional
+   * groupings on the first request, permissions_matrices_lock_ must be held
+   */
+  const RpcPermissionsMap& GetPermissionsMatrix(
+      const policy_table::Table& table,
+      const policy_table::Strings& groups);
+
+  typedef utils::SharedPtr<const policy_table::Table> TableVersion;
+
+  /**
+   * @brief Gets current published version of policy table. The version is
+   * never changed, so it is read without holding cache_lock_
+   */
+  TableVersion PublishedTable() const;
+
+  /**
+   * @brief Publishes copy of working table as the new version for readers,
+   * must be called by writers after all changes of pt_ are done
+   */
+  void PublishTable();
+
+  /**
+   * @brief Copies policies of default application to given one
+   * without publishing and backup
+   */
+  void ApplyDefaultPolicy(const std::string& app_id);
+
+  /**
+   * @brief Rebuilds friendly messages cache from consumer friendly
+   * messages section of working table, cache_lock_ must be held
+   */
+  void UpdateFriendlyMessages();
+
 private:
   /**
    * @brief Checks, if input string is known service represented by number, than
@@ -615,6 +696,9 @@ private:
   utils::SharedPtr<policy_table::Table> snapshot_;
   utils::SharedPtr<PTRepresentation> backup_;
   utils::SharedPtr<PTExtRepresentation> ex_backup_;
+  // Read-only copy of pt_ which is replaced as a whole after each change
+  TableVersion published_pt_;
+  mutable sync_primitives::Lock published_pt_lock_;
   bool update_required;
   typedef std::set<std::string> UnpairedDevices;
   UnpairedDevices is_unpaired_;
@@ -626,6 +710,17 @@ private:
   typedef std::map<std::string, AppCalculatedPermissions> CalculatedPermissions;
   CalculatedPermissions calculated_permissions_;
   sync_primitives::Lock calculated_permissions_lock_;
+  PermissionsMatrices permissions_matrices_;
+  sync_primitives::Lock permissions_matrices_lock_;
+
+  // Messages are looked up by language, then by message code
+  typedef std::map<std::string, UserFriendlyMessage> FriendlyMessagesByCode;
+  typedef std::map<std::string, FriendlyMessagesByCode> FriendlyMessagesMap;
+  typedef utils::SharedPtr<const FriendlyMessagesMap> FriendlyMessages;
+  // Built only when messages section is loaded or updated and replaced
+  // as a whole, so permission dialogs do not walk the table
+  FriendlyMessages friendly_messages_;
+  mutable sync_primitives::Lock friendly_messages_lock_;
 
   class BackgroundBackuper: public threads::ThreadDelegate {
       friend class CacheManager;
@@ -648,6 +743,18 @@ private:
   threads::Thread* backup_thread_;
   sync_primitives::Lock backuper_locker_;
   BackgroundBackuper* backuper_;
+  uint32_t modified_sections_;
+  sync_primitives::Lock modified_sections_lock_;
+
+  // Counting doesn't touch table, collected data is flushed periodically
+  usage_statistics::StatisticsRegistry usage_statistics_;
+  TimevalStruct last_usage_statistics_flush_;
+  sync_primitives::Lock usage_statistics_flush_lock_;
+
+  // Metrics are owned by registry and live until process exit
+  utils::metrics::Histogram* check_permissions_time_metric_;
+  utils::metrics::Counter* permissions_matrix_misses_metric_;
+  utils::metrics::Histogram* persist_time_metric_;
 
   friend class AccessRemoteImpl;
   FRIEND_TEST(AccessRemoteImplTest, CheckModuleType);
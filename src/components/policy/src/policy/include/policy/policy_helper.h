@@ -33,6 +33,8 @@
 #ifndef SRC_COMPONENTS_POLICY_INCLUDE_POLICY_POLICY_HELPER_H_
 #define SRC_COMPONENTS_POLICY_INCLUDE_POLICY_POLICY_HELPER_H_
 
+#include <set>
+#include <string>
 #include "./functions.h"
 #include "utils/shared_ptr.h"
 #include "policy/policy_types.h"
@@ -73,6 +75,15 @@ struct CompareGroupName {
 bool operator!=(const policy_table::ApplicationParams& first,
                 const policy_table::ApplicationParams& second);
 
+/*
+ * @brief Collects names of functional groups, which are present both in
+ * current data snapshot and in update, but were redefined by update
+ */
+void GetChangedFunctionalGroups(
+    const policy_table::FunctionalGroupings& snapshot,
+    const policy_table::FunctionalGroupings& update,
+    std::set<std::string>* changed_groups);
+
 /*
  * @brief Helper struct for checking changes of application policies, which
  * come with update along with current data snapshot
@@ -104,6 +115,7 @@ struct CheckAppPolicy {
     bool HasNewGroups(const AppPoliciesValueType& app_policy,
                       policy_table::Strings* new_groups = NULL) const;
     bool HasConsentNeededGroups(const AppPoliciesValueType& app_policy) const;
+    bool HasChangedGroups(const AppPoliciesValueType& app_policy) const;
     std::vector<FunctionalGroupPermission> GetRevokedGroups(
             const AppPoliciesValueType& app_policy) const;
     void RemoveRevokedConsents(
@@ -124,6 +136,7 @@ struct CheckAppPolicy {
     PolicyManagerImpl* pm_;
     const utils::SharedPtr<policy_table::Table> update_;
     const utils::SharedPtr<policy_table::Table> snapshot_;
+    std::set<std::string> changed_groups_;
 };
 
 /*
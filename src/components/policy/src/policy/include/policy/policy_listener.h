@@ -134,6 +134,19 @@ class PolicyListener {
    */
   virtual void OnCertificateUpdated(const std::string& certificate_data) = 0;
 
+  /**
+   * @brief OnPTUpdated the callback which signals that policy table update
+   * has been applied, so permissions calculated before are outdated.
+   */
+  virtual void OnPTUpdated() = 0;
+
+  /**
+   * @brief Bracket notifications of applications about permissions
+   * changed by policy table update, so they can be sent at once
+   */
+  virtual void OnPermissionsChangesStarted() = 0;
+  virtual void OnPermissionsChangesFinished() = 0;
+
 #ifdef SDL_REMOTE_CONTROL
    /**
     * @brief Signal that country_consent field was updated during PTU
@@ -34,8 +34,10 @@
 #define SRC_COMPONENTS_POLICY_INCLUDE_POLICY_POLICY_MANAGER_IMPL_H_
 
 #include <list>
+#include <queue>
 #include "utils/shared_ptr.h"
 #include "utils/lock.h"
+#include "utils/threads/message_loop_thread.h"
 #include "policy/policy_manager.h"
 #include "policy/policy_table.h"
 #include "policy/cache_manager_interface.h"
@@ -50,7 +52,15 @@ class AccessRemote;
 struct Subject;
 struct CheckAppPolicy;
 
-class PolicyManagerImpl : public PolicyManager {
+/*
+ * Validated policy table updates waiting to be applied
+ */
+typedef utils::SharedPtr<policy_table::Table> PTUpdate;
+typedef std::queue<PTUpdate> PTUpdateQueue;
+typedef threads::MessageLoopThread<PTUpdateQueue> PTUpdateLoop;
+
+class PolicyManagerImpl : public PolicyManager,
+                          public PTUpdateLoop::Handler {
   public:
     PolicyManagerImpl();
     virtual void set_listener(PolicyListener* listener);
@@ -211,6 +221,14 @@ class PolicyManagerImpl : public PolicyManager {
                                 std::vector<std::string>* modules) const;
 #endif  // SDL_REMOTE_CONTROL
 
+    /**
+     * @brief Applies validated update to policy table and notifies
+     * applications, which permissions were changed by it.
+     * CALLED in PTUpdateLoop thread
+     * @param pt_update Policy table update
+     */
+    virtual void Handle(const PTUpdate pt_update);
+
   protected:
     virtual utils::SharedPtr<policy_table::Table> Parse(
         const BinaryMessage& pt_content);
@@ -375,6 +393,14 @@ private:
 
     bool ignition_check;
 
+    /**
+     * @brief Applies updates accepted by LoadPT, so thread, which delivered
+     * update, is not blocked by saving and permissions recalculation.
+     * Kept as the last member, so it applies already accepted updates and
+     * stops before the data it uses is destroyed.
+     */
+    PTUpdateLoop pt_update_loop_;
+
     friend struct CheckAppPolicy;
     friend struct ProccessAppGroups;
     friend class PolicyManagerImplTest;
@@ -58,6 +58,22 @@ enum InitResult {
   FAIL
 };
 
+/**
+ * @brief Sections of policy table which are persisted separately,
+ * values are bit flags to be combined into mask of modified sections.
+ */
+enum TableSection {
+  kNoSections = 0,
+  kFunctionalGroupingsSection = 1 << 0,
+  kApplicationPoliciesSection = 1 << 1,
+  kModuleConfigSection = 1 << 2,
+  kConsumerFriendlyMessagesSection = 1 << 3,
+  kDeviceDataSection = 1 << 4,
+  kUsageAndErrorCountsSection = 1 << 5,
+  kModuleMetaSection = 1 << 6,
+  kAllSections = (1 << 7) - 1
+};
+
 class PTRepresentation {
   public:
     virtual ~PTRepresentation() {
@@ -226,6 +242,16 @@ class PTRepresentation {
 
     virtual bool Save(const policy_table::Table& table) = 0;
 
+    /**
+     * @brief Saves only given sections of policy table in one transaction,
+     * content of other sections in storage is left untouched.
+     * @param table Policy table to take sections from
+     * @param sections Mask of TableSection values
+     * @return true if all requested sections were saved
+     */
+    virtual bool SaveSections(const policy_table::Table& table,
+                              uint32_t sections) = 0;
+
     /**
      * Gets flag updateRequired
      * @return true if update is required
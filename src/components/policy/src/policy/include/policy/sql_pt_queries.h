@@ -44,6 +44,8 @@ extern const std::string kDropSchema;
 extern const std::string kDeleteData;
 extern const std::string kCheckPgNumber;
 extern const std::string kCheckDBIntegrity;
+extern const std::string kEnableWriteAheadLog;
+extern const std::string kSetSynchronousLevel;
 extern const std::string kSelectRpc;
 extern const std::string kSelectPreloaded;
 extern const std::string kIsFirstRun;
@@ -84,6 +84,8 @@ class SQLPTRepresentation : public virtual PTRepresentation {
     virtual void WriteDb();
     virtual utils::SharedPtr<policy_table::Table> GenerateSnapshot() const;
     virtual bool Save(const policy_table::Table& table);
+    virtual bool SaveSections(const policy_table::Table& table,
+                              uint32_t sections);
     bool GetInitialAppData(const std::string& app_id, StringArray* nicknames =
                              NULL,
                            StringArray* app_hmi_types = NULL);
@@ -26,27 +26,45 @@ const char* EnumToJsonString(Priority val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, Priority* result) {
-  if ("EMERGENCY" == literal) {
-    *result = P_EMERGENCY;
-    return true;
-  } else if ("NAVIGATION" == literal) {
-    *result = P_NAVIGATION;
-    return true;
-  } else if ("VOICECOM" == literal) {
-    *result = P_VOICECOM;
-    return true;
-  } else if ("COMMUNICATION" == literal) {
-    *result = P_COMMUNICATION;
-    return true;
-  } else if ("NORMAL" == literal) {
-    *result = P_NORMAL;
-    return true;
-  } else if ("NONE" == literal) {
-    *result = P_NONE;
-    return true;
-  } else {
-    return false;
+  switch (literal.size()) {
+    case 4:
+      if ("NONE" == literal) {
+        *result = P_NONE;
+        return true;
+      }
+      break;
+    case 6:
+      if ("NORMAL" == literal) {
+        *result = P_NORMAL;
+        return true;
+      }
+      break;
+    case 8:
+      if ("VOICECOM" == literal) {
+        *result = P_VOICECOM;
+        return true;
+      }
+      break;
+    case 9:
+      if ("EMERGENCY" == literal) {
+        *result = P_EMERGENCY;
+        return true;
+      }
+      break;
+    case 10:
+      if ("NAVIGATION" == literal) {
+        *result = P_NAVIGATION;
+        return true;
+      }
+      break;
+    case 13:
+      if ("COMMUNICATION" == literal) {
+        *result = P_COMMUNICATION;
+        return true;
+      }
+      break;
   }
+  return false;
 }
 
 bool IsValidEnum(HmiLevel val) {
@@ -68,21 +86,31 @@ const char* EnumToJsonString(HmiLevel val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, HmiLevel* result) {
-  if ("BACKGROUND" == literal) {
-    *result = HL_BACKGROUND;
-    return true;
-  } else if ("FULL" == literal) {
-    *result = HL_FULL;
-    return true;
-  } else if ("LIMITED" == literal) {
-    *result = HL_LIMITED;
-    return true;
-  } else if ("NONE" == literal) {
-    *result = HL_NONE;
-    return true;
-  } else {
-    return false;
+  switch (literal.size()) {
+    case 4:
+      if ("FULL" == literal) {
+        *result = HL_FULL;
+        return true;
+      }
+      if ("NONE" == literal) {
+        *result = HL_NONE;
+        return true;
+      }
+      break;
+    case 7:
+      if ("LIMITED" == literal) {
+        *result = HL_LIMITED;
+        return true;
+      }
+      break;
+    case 10:
+      if ("BACKGROUND" == literal) {
+        *result = HL_BACKGROUND;
+        return true;
+      }
+      break;
   }
+  return false;
 }
 
 bool IsValidEnum(Parameter val) {
@@ -146,84 +174,139 @@ const char* EnumToJsonString(Parameter val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, Parameter* result) {
-  if ("gps" == literal) {
-    *result = P_GPS;
-    return true;
-  } else if ("speed" == literal) {
-    *result = P_SPEED;
-    return true;
-  } else if ("engineTorque" == literal) {
-    *result = P_ENGINETORQUE;
-    return true;
-  } else if ("externalTemperature" == literal) {
-    *result = P_EXTERNALTEMPERATURE;
-    return true;
-  } else if ("fuelLevel" == literal) {
-    *result = P_FUELLEVEL;
-    return true;
-  } else if ("fuelLevel_State" == literal) {
-    *result = P_FUELLEVEL_STATE;
-    return true;
-  } else if ("headLampStatus" == literal) {
-    *result = P_HEADLAMPSTATUS;
-    return true;
-  } else if ("instantFuelConsumption" == literal) {
-    *result = P_INSTANTFUELCONSUMPTION;
-    return true;
-  } else if ("odometer" == literal) {
-    *result = P_ODOMETER;
-    return true;
-  } else if ("tirePressure" == literal) {
-    *result = P_TIREPRESSURE;
-    return true;
-  } else if ("wiperStatus" == literal) {
-    *result = P_WIPERSTATUS;
-    return true;
-  } else if ("vin" == literal) {
-    *result = P_VIN;
-    return true;
-  } else if ("accPedalPosition" == literal) {
-    *result = P_ACCPEDALPOSITION;
-    return true;
-  } else if ("beltStatus" == literal) {
-    *result = P_BELTSTATUS;
-    return true;
-  } else if ("driverBraking" == literal) {
-    *result = P_DRIVERBRAKING;
-    return true;
-  } else if ("prndl" == literal) {
-    *result = P_PRNDL;
-    return true;
-  } else if ("rpm" == literal) {
-    *result = P_RPM;
-    return true;
-  } else if ("steeringWheelAngle" == literal) {
-    *result = P_STEERINGWHEELANGLE;
-    return true;
-  } else if ("myKey" == literal) {
-    *result = P_MYKEY;
-    return true;
-  } else if ("airbagStatus" == literal) {
-    *result = P_AIRBAGSTATUS;
-    return true;
-  } else if ("bodyInformation" == literal) {
-    *result = P_BODYINFORMATION;
-    return true;
-  } else if ("clusterModeStatus" == literal) {
-    *result = P_CLUSTERMODESTATUS;
-    return true;
-  } else if ("deviceStatus" == literal) {
-    *result = P_DEVICESTATUS;
-    return true;
-  } else if ("emergencyEvent" == literal) {
-    *result = P_EMERGENCYEVENT;
-    return true;
-  } else if ("eCallInfo" == literal) {
-    *result = P_ECALLINFO;
-    return true;
-  } else {
-    return false;
+  switch (literal.size()) {
+    case 3:
+      if ("gps" == literal) {
+        *result = P_GPS;
+        return true;
+      }
+      if ("vin" == literal) {
+        *result = P_VIN;
+        return true;
+      }
+      if ("rpm" == literal) {
+        *result = P_RPM;
+        return true;
+      }
+      break;
+    case 5:
+      if ("speed" == literal) {
+        *result = P_SPEED;
+        return true;
+      }
+      if ("prndl" == literal) {
+        *result = P_PRNDL;
+        return true;
+      }
+      if ("myKey" == literal) {
+        *result = P_MYKEY;
+        return true;
+      }
+      break;
+    case 8:
+      if ("odometer" == literal) {
+        *result = P_ODOMETER;
+        return true;
+      }
+      break;
+    case 9:
+      if ("fuelLevel" == literal) {
+        *result = P_FUELLEVEL;
+        return true;
+      }
+      if ("eCallInfo" == literal) {
+        *result = P_ECALLINFO;
+        return true;
+      }
+      break;
+    case 10:
+      if ("beltStatus" == literal) {
+        *result = P_BELTSTATUS;
+        return true;
+      }
+      break;
+    case 11:
+      if ("wiperStatus" == literal) {
+        *result = P_WIPERSTATUS;
+        return true;
+      }
+      break;
+    case 12:
+      if ("engineTorque" == literal) {
+        *result = P_ENGINETORQUE;
+        return true;
+      }
+      if ("tirePressure" == literal) {
+        *result = P_TIREPRESSURE;
+        return true;
+      }
+      if ("airbagStatus" == literal) {
+        *result = P_AIRBAGSTATUS;
+        return true;
+      }
+      if ("deviceStatus" == literal) {
+        *result = P_DEVICESTATUS;
+        return true;
+      }
+      break;
+    case 13:
+      if ("driverBraking" == literal) {
+        *result = P_DRIVERBRAKING;
+        return true;
+      }
+      break;
+    case 14:
+      if ("headLampStatus" == literal) {
+        *result = P_HEADLAMPSTATUS;
+        return true;
+      }
+      if ("emergencyEvent" == literal) {
+        *result = P_EMERGENCYEVENT;
+        return true;
+      }
+      break;
+    case 15:
+      if ("fuelLevel_State" == literal) {
+        *result = P_FUELLEVEL_STATE;
+        return true;
+      }
+      if ("bodyInformation" == literal) {
+        *result = P_BODYINFORMATION;
+        return true;
+      }
+      break;
+    case 16:
+      if ("accPedalPosition" == literal) {
+        *result = P_ACCPEDALPOSITION;
+        return true;
+      }
+      break;
+    case 17:
+      if ("clusterModeStatus" == literal) {
+        *result = P_CLUSTERMODESTATUS;
+        return true;
+      }
+      break;
+    case 18:
+      if ("steeringWheelAngle" == literal) {
+        *result = P_STEERINGWHEELANGLE;
+        return true;
+      }
+      break;
+    case 19:
+      if ("externalTemperature" == literal) {
+        *result = P_EXTERNALTEMPERATURE;
+        return true;
+      }
+      break;
+    case 22:
+      if ("instantFuelConsumption" == literal) {
+        *result = P_INSTANTFUELCONSUMPTION;
+        return true;
+      }
+      break;
   }
+  return false;
 }
 
 bool IsValidEnum(AppHMIType val) {
@@ -259,42 +342,71 @@ const char* EnumToJsonString(AppHMIType val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, AppHMIType* result) {
-  if ("DEFAULT" == literal) {
-    *result = AHT_DEFAULT;
-    return true;
-  } else if ("COMMUNICATION" == literal) {
-    *result = AHT_COMMUNICATION;
-    return true;
-  } else if ("MEDIA" == literal) {
-    *result = AHT_MEDIA;
-    return true;
-  } else if ("MESSAGING" == literal) {
-    *result = AHT_MESSAGING;
-    return true;
-  } else if ("NAVIGATION" == literal) {
-    *result = AHT_NAVIGATION;
-    return true;
-  } else if ("INFORMATION" == literal) {
-    *result = AHT_INFORMATION;
-    return true;
-  } else if ("SOCIAL" == literal) {
-    *result = AHT_SOCIAL;
-    return true;
-  } else if ("BACKGROUND_PROCESS" == literal) {
-    *result = AHT_BACKGROUND_PROCESS;
-    return true;
-  } else if ("TESTING" == literal) {
-    *result = AHT_TESTING;
-    return true;
-  } else if ("SYSTEM" == literal) {
-    *result = AHT_SYSTEM;
-    return true;
-  } else if ("REMOTE_CONTROL" == literal) {
-    *result = AHT_REMOTE_CONTROL;
-    return true;
-  } else {
-    return false;
+  switch (literal.size()) {
+    case 5:
+      if ("MEDIA" == literal) {
+        *result = AHT_MEDIA;
+        return true;
+      }
+      break;
+    case 6:
+      if ("SOCIAL" == literal) {
+        *result = AHT_SOCIAL;
+        return true;
+      }
+      if ("SYSTEM" == literal) {
+        *result = AHT_SYSTEM;
+        return true;
+      }
+      break;
+    case 7:
+      if ("DEFAULT" == literal) {
+        *result = AHT_DEFAULT;
+        return true;
+      }
+      if ("TESTING" == literal) {
+        *result = AHT_TESTING;
+        return true;
+      }
+      break;
+    case 9:
+      if ("MESSAGING" == literal) {
+        *result = AHT_MESSAGING;
+        return true;
+      }
+      break;
+    case 10:
+      if ("NAVIGATION" == literal) {
+        *result = AHT_NAVIGATION;
+        return true;
+      }
+      break;
+    case 11:
+      if ("INFORMATION" == literal) {
+        *result = AHT_INFORMATION;
+        return true;
+      }
+      break;
+    case 13:
+      if ("COMMUNICATION" == literal) {
+        *result = AHT_COMMUNICATION;
+        return true;
+      }
+      break;
+    case 14:
+      if ("REMOTE_CONTROL" == literal) {
+        *result = AHT_REMOTE_CONTROL;
+        return true;
+      }
+      break;
+    case 18:
+      if ("BACKGROUND_PROCESS" == literal) {
+        *result = AHT_BACKGROUND_PROCESS;
+        return true;
+      }
+      break;
   }
+  return false;
 }
 
 bool IsValidEnum(Input val) {
@@ -312,15 +424,19 @@ const char* EnumToJsonString(Input val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, Input* result) {
-  if ("GUI" == literal) {
-    *result = I_GUI;
-    return true;
-  } else if ("VUI" == literal) {
-    *result = I_VUI;
-    return true;
-  } else {
-    return false;
+  switch (literal.size()) {
+    case 3:
+      if ("GUI" == literal) {
+        *result = I_GUI;
+        return true;
+      }
+      if ("VUI" == literal) {
+        *result = I_VUI;
+        return true;
+      }
+      break;
   }
+  return false;
 }
 
 bool IsValidEnum(ModuleType val) {
@@ -338,15 +454,21 @@ const char* EnumToJsonString(ModuleType val) {
   }
 }
 bool EnumFromJsonString(const std::string& literal, ModuleType* result) {
-  if ("CLIMATE" == literal) {
-    *result = MT_CLIMATE;
-    return true;
-  } else if ("RADIO" == literal) {
-    *result = MT_RADIO;
-    return true;
-  } else {
-    return false;
+  switch (literal.size()) {
+    case 5:
+      if ("RADIO" == literal) {
+        *result = MT_RADIO;
+        return true;
+      }
+      break;
+    case 7:
+      if ("CLIMATE" == literal) {
+        *result = MT_CLIMATE;
+        return true;
+      }
+      break;
   }
+  return false;
 }
 
 const std::string kDefaultApp = "default";
@@ -59,6 +59,21 @@ Json::Value ApplicationParams::ToJsonValue() const {
   impl::WriteJsonField("certificate", certificate, &result__);
   return result__;
 }
+void ApplicationParams::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("groups", groups, &first__, output__);
+  impl::WriteJsonField("groups_primaryRC", groups_primaryRC, &first__, output__);
+  impl::WriteJsonField("groups_nonPrimaryRC", groups_nonPrimaryRC, &first__, output__);
+  impl::WriteJsonField("nicknames", nicknames, &first__, output__);
+  impl::WriteJsonField("moduleType", moduleType, &first__, output__);
+  impl::WriteJsonField("AppHMIType", AppHMIType, &first__, output__);
+  impl::WriteJsonField("priority", priority, &first__, output__);
+  impl::WriteJsonField("memory_kb", memory_kb, &first__, output__);
+  impl::WriteJsonField("heart_beat_timeout_ms", heart_beat_timeout_ms, &first__, output__);
+  impl::WriteJsonField("certificate", certificate, &first__, output__);
+  output__->push_back('}');
+}
 bool ApplicationParams::is_valid() const {
   if (!groups.is_valid()) {
     return false;
@@ -198,6 +213,13 @@ Json::Value RpcParameters::ToJsonValue() const {
   impl::WriteJsonField("parameters", parameters, &result__);
   return result__;
 }
+void RpcParameters::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("hmi_levels", hmi_levels, &first__, output__);
+  impl::WriteJsonField("parameters", parameters, &first__, output__);
+  output__->push_back('}');
+}
 bool RpcParameters::is_valid() const {
   if (!hmi_levels.is_valid()) {
     return false;
@@ -259,6 +281,13 @@ Json::Value Rpcs::ToJsonValue() const {
   impl::WriteJsonField("rpcs", rpcs, &result__);
   return result__;
 }
+void Rpcs::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("user_consent_prompt", user_consent_prompt, &first__, output__);
+  impl::WriteJsonField("rpcs", rpcs, &first__, output__);
+  output__->push_back('}');
+}
 bool Rpcs::is_valid() const {
   if (!user_consent_prompt.is_valid()) {
     return false;
@@ -352,6 +381,26 @@ Json::Value ModuleConfig::ToJsonValue() const {
   impl::WriteJsonField("equipment", equipment, &result__);
   return result__;
 }
+void ModuleConfig::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("device_certificates", device_certificates, &first__, output__);
+  impl::WriteJsonField("preloaded_pt", preloaded_pt, &first__, output__);
+  impl::WriteJsonField("exchange_after_x_ignition_cycles", exchange_after_x_ignition_cycles, &first__, output__);
+  impl::WriteJsonField("exchange_after_x_kilometers", exchange_after_x_kilometers, &first__, output__);
+  impl::WriteJsonField("exchange_after_x_days", exchange_after_x_days, &first__, output__);
+  impl::WriteJsonField("timeout_after_x_seconds", timeout_after_x_seconds, &first__, output__);
+  impl::WriteJsonField("seconds_between_retries", seconds_between_retries, &first__, output__);
+  impl::WriteJsonField("endpoints", endpoints, &first__, output__);
+  impl::WriteJsonField("notifications_per_minute_by_priority", notifications_per_minute_by_priority, &first__, output__);
+  impl::WriteJsonField("vehicle_make", vehicle_make, &first__, output__);
+  impl::WriteJsonField("vehicle_model", vehicle_model, &first__, output__);
+  impl::WriteJsonField("vehicle_year", vehicle_year, &first__, output__);
+  impl::WriteJsonField("user_consent_passengersRC", user_consent_passengersRC, &first__, output__);
+  impl::WriteJsonField("country_consent_passengersRC", country_consent_passengersRC, &first__, output__);
+  impl::WriteJsonField("equipment", equipment, &first__, output__);
+  output__->push_back('}');
+}
 bool ModuleConfig::is_valid() const {
   if (!device_certificates.is_valid()) {
     return false;
@@ -571,6 +620,16 @@ Json::Value MessageString::ToJsonValue() const {
   impl::WriteJsonField("textBody", textBody, &result__);
   return result__;
 }
+void MessageString::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("line1", line1, &first__, output__);
+  impl::WriteJsonField("line2", line2, &first__, output__);
+  impl::WriteJsonField("tts", tts, &first__, output__);
+  impl::WriteJsonField("label", label, &first__, output__);
+  impl::WriteJsonField("textBody", textBody, &first__, output__);
+  output__->push_back('}');
+}
 bool MessageString::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized && Validate();
@@ -664,6 +723,12 @@ Json::Value MessageLanguages::ToJsonValue() const {
   impl::WriteJsonField("languages", languages, &result__);
   return result__;
 }
+void MessageLanguages::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("languages", languages, &first__, output__);
+  output__->push_back('}');
+}
 bool MessageLanguages::is_valid() const {
   if (!languages.is_valid()) {
     return false;
@@ -722,6 +787,13 @@ Json::Value ConsumerFriendlyMessages::ToJsonValue() const {
   impl::WriteJsonField("messages", messages, &result__);
   return result__;
 }
+void ConsumerFriendlyMessages::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("version", version, &first__, output__);
+  impl::WriteJsonField("messages", messages, &first__, output__);
+  output__->push_back('}');
+}
 bool ConsumerFriendlyMessages::is_valid() const {
   if (!version.is_valid()) {
     return false;
@@ -782,6 +854,10 @@ Json::Value ModuleMeta::ToJsonValue() const {
   Json::Value result__(Json::objectValue);
   return result__;
 }
+void ModuleMeta::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  output__->push_back('}');
+}
 bool ModuleMeta::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized && Validate();
@@ -813,6 +889,10 @@ Json::Value AppLevel::ToJsonValue() const {
   Json::Value result__(Json::objectValue);
   return result__;
 }
+void AppLevel::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  output__->push_back('}');
+}
 bool AppLevel::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized && Validate();
@@ -853,6 +933,12 @@ Json::Value UsageAndErrorCounts::ToJsonValue() const {
   impl::WriteJsonField("app_level", app_level, &result__);
   return result__;
 }
+void UsageAndErrorCounts::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("app_level", app_level, &first__, output__);
+  output__->push_back('}');
+}
 bool UsageAndErrorCounts::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized && Validate();
@@ -904,6 +990,10 @@ Json::Value DeviceParams::ToJsonValue() const {
   Json::Value result__(Json::objectValue);
   return result__;
 }
+void DeviceParams::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  output__->push_back('}');
+}
 bool DeviceParams::is_valid() const {
   if (struct_empty()) {
     return initialization_state__ == kInitialized && Validate();
@@ -961,6 +1051,18 @@ Json::Value PolicyTable::ToJsonValue() const {
   impl::WriteJsonField("device_data", device_data, &result__);
   return result__;
 }
+void PolicyTable::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("app_policies", app_policies, &first__, output__);
+  impl::WriteJsonField("functional_groupings", functional_groupings, &first__, output__);
+  impl::WriteJsonField("consumer_friendly_messages", consumer_friendly_messages, &first__, output__);
+  impl::WriteJsonField("module_config", module_config, &first__, output__);
+  impl::WriteJsonField("module_meta", module_meta, &first__, output__);
+  impl::WriteJsonField("usage_and_error_counts", usage_and_error_counts, &first__, output__);
+  impl::WriteJsonField("device_data", device_data, &first__, output__);
+  output__->push_back('}');
+}
 bool PolicyTable::is_valid() const {
   if (!app_policies.is_valid()) {
     return false;
@@ -1081,6 +1183,12 @@ Json::Value Table::ToJsonValue() const {
   impl::WriteJsonField("policy_table", policy_table, &result__);
   return result__;
 }
+void Table::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("policy_table", policy_table, &first__, output__);
+  output__->push_back('}');
+}
 bool Table::is_valid() const {
   if (!policy_table.is_valid()) {
     return false;
@@ -1125,6 +1233,12 @@ Json::Value Equipment::ToJsonValue() const {
   impl::WriteJsonField("zones", zones, &result__);
   return result__;
 }
+void Equipment::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("zones", zones, &first__, output__);
+  output__->push_back('}');
+}
 bool Equipment::is_valid() const {
   if (!zones.is_valid()) {
     return false;
@@ -1216,6 +1330,16 @@ Json::Value InteriorZone::ToJsonValue() const {
   impl::WriteJsonField("driver_allow", driver_allow, &result__);
   return result__;
 }
+void InteriorZone::WriteJson(std::string* output__) const {
+  output__->push_back('{');
+  bool first__ = true;
+  impl::WriteJsonField("col", col, &first__, output__);
+  impl::WriteJsonField("row", row, &first__, output__);
+  impl::WriteJsonField("level", level, &first__, output__);
+  impl::WriteJsonField("auto_allow", auto_allow, &first__, output__);
+  impl::WriteJsonField("driver_allow", driver_allow, &first__, output__);
+  output__->push_back('}');
+}
 bool InteriorZone::is_valid() const {
   if (!col.is_valid()) {
     return false;
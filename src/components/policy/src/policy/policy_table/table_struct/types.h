@@ -81,6 +81,7 @@ struct ApplicationParams : CompositeType {
     ~ApplicationParams();
     explicit ApplicationParams(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -101,6 +102,7 @@ struct RpcParameters : CompositeType {
     ~RpcParameters();
     explicit RpcParameters(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -120,6 +122,7 @@ struct Rpcs : CompositeType {
     ~Rpcs();
     explicit Rpcs(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -142,6 +145,7 @@ struct InteriorZone: CompositeType {
     ~InteriorZone();
     explicit InteriorZone(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -171,6 +175,7 @@ struct Equipment : CompositeType {
     ~Equipment();
     explicit Equipment(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -205,6 +210,7 @@ struct ModuleConfig : CompositeType {
     ~ModuleConfig();
     explicit ModuleConfig(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -226,6 +232,7 @@ struct MessageString : CompositeType {
     ~MessageString();
     explicit MessageString(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -244,6 +251,7 @@ struct MessageLanguages : CompositeType {
     ~MessageLanguages();
     explicit MessageLanguages(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -263,6 +271,7 @@ struct ConsumerFriendlyMessages : CompositeType {
     ~ConsumerFriendlyMessages();
     explicit ConsumerFriendlyMessages(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -279,6 +288,7 @@ struct ModuleMeta : CompositeType {
     ~ModuleMeta();
     explicit ModuleMeta(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -294,6 +304,7 @@ struct AppLevel : CompositeType {
     ~AppLevel();
     explicit AppLevel(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -310,6 +321,7 @@ struct UsageAndErrorCounts : CompositeType {
     ~UsageAndErrorCounts();
     explicit UsageAndErrorCounts(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -326,6 +338,7 @@ struct DeviceParams : CompositeType {
     ~DeviceParams();
     explicit DeviceParams(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -350,6 +363,7 @@ struct PolicyTable : CompositeType {
     ~PolicyTable();
     explicit PolicyTable(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -368,6 +382,7 @@ struct Table : CompositeType {
     ~Table();
     explicit Table(const Json::Value* value__);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output__) const;
     bool is_valid() const;
     bool is_initialized() const;
     bool struct_empty() const;
@@ -37,6 +37,7 @@
 #include <string>
 #include "qdb_wrapper/sql_error.h"
 #include "utils/lock.h"
+#include "utils/macro.h"
 
 namespace policy {
 namespace dbms {
@@ -80,6 +81,12 @@ class SQLDatabase {
    */
   bool RollbackTransaction();
 
+  /**
+   * Checks if transaction was begun and not finished yet
+   * @return true if database is inside of transaction
+   */
+  bool IsInTransaction() const;
+
   /**
    * Gets information about the last error that occurred on the database
    * @return last error
@@ -108,6 +115,11 @@ class SQLDatabase {
    */
   sync_primitives::Lock conn_lock_;
 
+  /**
+   * Flag of transaction begun by BeginTransaction
+   */
+  bool in_transaction_;
+
   /**
    * The database name
    */
@@ -128,6 +140,42 @@ class SQLDatabase {
   friend class SQLQuery;
 };
 
+/**
+ * Begins transaction on creation and rolls it back on destruction
+ * unless it was committed. If database is already inside of transaction
+ * then it does nothing, so enclosing transaction owns all the changes.
+ */
+class ScopedTransaction {
+ public:
+  explicit ScopedTransaction(SQLDatabase* db)
+      : db_(db),
+        owner_(!db->IsInTransaction() && db->BeginTransaction()) {
+  }
+
+  ~ScopedTransaction() {
+    if (owner_) {
+      db_->RollbackTransaction();
+    }
+  }
+
+  /**
+   * Commits owned transaction
+   * @return true if successfully or transaction is not owned
+   */
+  bool Commit() {
+    if (!owner_) {
+      return true;
+    }
+    owner_ = false;
+    return db_->CommitTransaction();
+  }
+
+ private:
+  SQLDatabase* db_;
+  bool owner_;
+  DISALLOW_COPY_AND_ASSIGN(ScopedTransaction);
+};
+
 }  // namespace dbms
 }  // namespace policy
 
@@ -41,6 +41,7 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "SQLDatabase")
 
 SQLDatabase::SQLDatabase(const std::string& db_name)
     : conn_(NULL),
+      in_transaction_(false),
       db_name_(db_name),
       error_(Error::OK) {
 }
@@ -72,17 +73,24 @@ void SQLDatabase::Close() {
 }
 
 bool SQLDatabase::BeginTransaction() {
-  return Exec("BEGIN TRANSACTION");
+  in_transaction_ = Exec("BEGIN TRANSACTION");
+  return in_transaction_;
 }
 
 bool SQLDatabase::CommitTransaction() {
+  in_transaction_ = false;
   return Exec("COMMIT TRANSACTION");
 }
 
 bool SQLDatabase::RollbackTransaction() {
+  in_transaction_ = false;
   return Exec("ROLLBACK TRANSACTION");
 }
 
+bool SQLDatabase::IsInTransaction() const {
+  return in_transaction_;
+}
+
 bool SQLDatabase::Exec(const std::string& query) {
   sync_primitives::AutoLock auto_lock(conn_lock_);
   if (qdb_statement(conn_, query.c_str()) == -1) {
@@ -33,11 +33,14 @@
 #ifndef SRC_COMPONENTS_POLICY_SQLITE_WRAPPER_INCLUDE_SQLITE_WRAPPER_SQL_DATABASE_H_
 #define SRC_COMPONENTS_POLICY_SQLITE_WRAPPER_INCLUDE_SQLITE_WRAPPER_SQL_DATABASE_H_
 
+#include <map>
 #include <string>
 #include "sqlite_wrapper/sql_error.h"
 #include "utils/lock.h"
+#include "utils/macro.h"
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace policy {
 namespace dbms {
@@ -82,6 +85,12 @@ class SQLDatabase {
    */
   bool RollbackTransaction();
 
+  /**
+   * Checks if transaction was begun and not finished yet
+   * @return true if database is inside of transaction
+   */
+  bool IsInTransaction() const;
+
   /**
    * Gets information about the last error that occurred on the database
    * @return last error
@@ -123,6 +132,18 @@ class SQLDatabase {
    */
   sync_primitives::Lock conn_lock_;
 
+  /**
+   * Compiled statements which are not used at the moment, keyed by SQL text.
+   * Every query text is compiled once per connection and then reused.
+   */
+  typedef std::map<std::string, sqlite3_stmt*> StatementsCache;
+  StatementsCache statements_;
+
+  /**
+   * Lock for guarding cache of statements
+   */
+  sync_primitives::Lock statements_lock_;
+
   /**
    * The filename of database
    */
@@ -151,9 +172,64 @@ class SQLDatabase {
    */
   inline bool Exec(const std::string& query);
 
+  /**
+   * Takes compiled statement for query from cache or compiles new one
+   * @param query sql query
+   * @param statement compiled statement
+   * @return SQLite result code of compiling
+   */
+  int AcquireStatement(const std::string& query, sqlite3_stmt** statement);
+
+  /**
+   * Resets statement and returns it into cache for reusing
+   * @param statement compiled statement taken by AcquireStatement
+   */
+  void ReleaseStatement(sqlite3_stmt* statement);
+
+  /**
+   * Finalizes all cached statements, must be done before closing connection
+   */
+  void FinalizeStatements();
+
   friend class SQLQuery;
 };
 
+/**
+ * Begins transaction on creation and rolls it back on destruction
+ * unless it was committed. If database is already inside of transaction
+ * then it does nothing, so enclosing transaction owns all the changes.
+ */
+class ScopedTransaction {
+ public:
+  explicit ScopedTransaction(SQLDatabase* db)
+      : db_(db),
+        owner_(!db->IsInTransaction() && db->BeginTransaction()) {
+  }
+
+  ~ScopedTransaction() {
+    if (owner_) {
+      db_->RollbackTransaction();
+    }
+  }
+
+  /**
+   * Commits owned transaction
+   * @return true if successfully or transaction is not owned
+   */
+  bool Commit() {
+    if (!owner_) {
+      return true;
+    }
+    owner_ = false;
+    return db_->CommitTransaction();
+  }
+
+ private:
+  SQLDatabase* db_;
+  bool owner_;
+  DISALLOW_COPY_AND_ASSIGN(ScopedTransaction);
+};
+
 }  // namespace dbms
 }  // namespace policy
 
@@ -66,6 +66,7 @@ bool SQLDatabase::IsReadWrite() {
 }
 
 void SQLDatabase::Close() {
+  FinalizeStatements();
   sync_primitives::AutoLock auto_lock(conn_lock_);
   error_ = sqlite3_close(conn_);
   if (error_ == SQLITE_OK) {
@@ -85,6 +86,10 @@ bool SQLDatabase::RollbackTransaction() {
   return Exec("ROLLBACK TRANSACTION");
 }
 
+bool SQLDatabase::IsInTransaction() const {
+  return conn_ && 0 == sqlite3_get_autocommit(conn_);
+}
+
 bool SQLDatabase::Exec(const std::string& query) {
   sync_primitives::AutoLock auto_lock(conn_lock_);
   error_ = sqlite3_exec(conn_, query.c_str(), NULL, NULL, NULL);
@@ -106,5 +111,45 @@ void SQLDatabase::set_path(const std::string& path) {
 bool SQLDatabase::Backup() {
    return true;
 }
+
+int SQLDatabase::AcquireStatement(const std::string& query,
+                                  sqlite3_stmt** statement) {
+  {
+    sync_primitives::AutoLock auto_lock(statements_lock_);
+    StatementsCache::iterator it = statements_.find(query);
+    if (statements_.end() != it) {
+      *statement = it->second;
+      statements_.erase(it);
+      return SQLITE_OK;
+    }
+  }
+  // Statements of v2 interface are recompiled by SQLite on schema change
+  return sqlite3_prepare_v2(conn_, query.c_str(), query.length(),
+                            statement, NULL);
+}
+
+void SQLDatabase::ReleaseStatement(sqlite3_stmt* statement) {
+  if (!statement) {
+    return;
+  }
+  sqlite3_reset(statement);
+  sqlite3_clear_bindings(statement);
+  // Text of statement is used as key, so it can't differ from compiled one
+  const std::string query(sqlite3_sql(statement));
+  sync_primitives::AutoLock auto_lock(statements_lock_);
+  if (!statements_.insert(std::make_pair(query, statement)).second) {
+    // The same query is cached already by other SQLQuery
+    sqlite3_finalize(statement);
+  }
+}
+
+void SQLDatabase::FinalizeStatements() {
+  sync_primitives::AutoLock auto_lock(statements_lock_);
+  for (StatementsCache::iterator it = statements_.begin();
+       statements_.end() != it; ++it) {
+    sqlite3_finalize(it->second);
+  }
+  statements_.clear();
+}
 }  // namespace dbms
 }  // namespace policy
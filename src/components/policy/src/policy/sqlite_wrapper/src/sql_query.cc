@@ -53,8 +53,7 @@ bool SQLQuery::Prepare(const std::string& query) {
   Finalize();
   sync_primitives::AutoLock auto_lock(statement_lock_);
   if (statement_) return false;
-  error_ = sqlite3_prepare(db_.conn(), query.c_str(), query.length(),
-                           &statement_, NULL);
+  error_ = db_.AcquireStatement(query, &statement_);
   query_ = query;
   return error_ == SQLITE_OK;
 }
@@ -76,10 +75,10 @@ bool SQLQuery::Reset() {
 
 void SQLQuery::Finalize() {
   sync_primitives::AutoLock auto_lock(statement_lock_);
-  error_ = sqlite3_finalize(statement_);
-  if (error_ == SQLITE_OK) {
-    statement_ = NULL;
-  }
+  // Statement is kept compiled by database for next queries with same text
+  db_.ReleaseStatement(statement_);
+  statement_ = NULL;
+  error_ = SQLITE_OK;
 }
 
 bool SQLQuery::Exec(const std::string& query) {
@@ -82,44 +82,18 @@ struct ToHMIType {
   }
 };
 
-struct IsZone {
- private:
-  const SeatLocation& seat_;
- public:
-  explicit IsZone(const SeatLocation& seat)
-      : seat_(seat) {
-  }
-  bool operator() (const policy_table::Zones::value_type& item) const {
-    const policy_table::InteriorZone& zone = item.second;
-    return seat_ == zone;
-  }
-};
-
 struct Contained {
  private:
-  const policy_table::Strings& params_;
+  const std::set<std::string>& params_;
  public:
-  explicit Contained(const policy_table::Strings& params)
+  explicit Contained(const std::set<std::string>& params)
       : params_(params) {
   }
   bool operator() (const RemoteControlParams::value_type& item) const {
-    return std::find_if(params_.begin(), params_.end(), CompareString(item))
-        != params_.end();
+    return params_.find(item) != params_.end();
   }
-  struct CompareString {
-   private:
-    const RemoteControlParams::value_type& value_;
-   public:
-    explicit CompareString(const RemoteControlParams::value_type& value)
-        : value_(value) {
-    }
-    bool operator() (const policy_table::Strings::value_type& item) const {
-      return value_ == static_cast<std::string>(item);
-    }
-  };
 };
 
-
 struct ToModuleType {
   std::string operator() (policy_table::ModuleTypes::value_type item) const {
     policy_table::ModuleType type = static_cast<policy_table::ModuleType>(item);
@@ -179,76 +153,123 @@ TypeAccess AccessRemoteImpl::Check(const Subject& who,
 bool AccessRemoteImpl::CheckModuleType(const PTString& app_id,
                                        policy_table::ModuleType module) const {
   LOG4CXX_AUTO_TRACE(logger_);
-  if (!cache_->IsApplicationRepresented(app_id)) {
-    return false;
-  }
-
-  const policy_table::ApplicationParams& app = cache_->pt_->policy_table
-      .app_policies[app_id];
-  if (!app.moduleType.is_initialized()) {
+  sync_primitives::AutoLock lock(index_lock_);
+  UpdateIndex();
+  ModuleTypeList::const_iterator i = module_types_.find(app_id);
+  if (i == module_types_.end()) {
     return false;
   }
 
-  const policy_table::ModuleTypes& modules = *app.moduleType;
-  if (modules.empty()) {
-    return true;
-  }
-
-  return std::find(modules.begin(), modules.end(), module) != modules.end();
+  const ModuleTypeList::mapped_type& modules = i->second;
+  return modules.empty() || modules.find(module) != modules.end();
 }
 
 TypeAccess AccessRemoteImpl::CheckParameters(
     const Object& what, const std::string& rpc,
     const RemoteControlParams& params) const {
   LOG4CXX_AUTO_TRACE(logger_);
-  const policy_table::Zones& zones = cache_->pt_->policy_table.module_config
-      .equipment->zones;
-  policy_table::Zones::const_iterator i = std::find_if(zones.begin(),
-                                                       zones.end(),
-                                                       IsZone(what.zone));
-  if (i == zones.end()) {
+  sync_primitives::AutoLock lock(index_lock_);
+  UpdateIndex();
+  ZoneList::const_iterator i = zones_.find(what.zone);
+  if (i == zones_.end()) {
     LOG4CXX_DEBUG(logger_, what.zone << " wasn't found");
     return TypeAccess::kDisallowed;
   }
 
-  const policy_table::InteriorZone& zone = i->second;
-  std::string module_name = EnumToJsonString(what.module);
+  const ZoneAccess& zone = i->second;
   RemoteControlParams copy_params(params);
-  if (IsAllowed(zone.auto_allow, module_name, rpc, &copy_params)) {
+  if (IsAllowed(zone.auto_allow, what.module, rpc, &copy_params)) {
     return TypeAccess::kAllowed;
   }
-  if (IsAllowed(zone.driver_allow, module_name, rpc, &copy_params)) {
+  if (IsAllowed(zone.driver_allow, what.module, rpc, &copy_params)) {
     return TypeAccess::kManual;
   }
   return TypeAccess::kDisallowed;
 }
 
+void AccessRemoteImpl::IndexModules(
+    const policy_table::AccessModules& modules, AllowedModules* index) {
+  for (policy_table::AccessModules::const_iterator i = modules.begin();
+      i != modules.end(); ++i) {
+    policy_table::ModuleType module;
+    if (!EnumFromJsonString(i->first, &module)) {
+      LOG4CXX_WARN(logger_, "Module type isn't known " << i->first);
+      continue;
+    }
+    AllowedRpcs& rpcs = (*index)[module];
+    for (policy_table::RemoteRpcs::const_iterator j = i->second.begin();
+        j != i->second.end(); ++j) {
+      rpcs[j->first].insert(j->second.begin(), j->second.end());
+    }
+  }
+}
+
+void AccessRemoteImpl::UpdateIndex() const {
+  const CacheManager::TableVersion pt = cache_->PublishedTable();
+  if (pt.get() == indexed_pt_.get()) {
+    return;
+  }
+  LOG4CXX_DEBUG(logger_, "Rebuilding RC lookup lists");
+  indexed_pt_ = pt;
+  module_types_.clear();
+  zones_.clear();
+  if (!pt.valid()) {
+    return;
+  }
+
+  const policy_table::ApplicationPolicies& apps = pt->policy_table
+      .app_policies;
+  for (policy_table::ApplicationPolicies::const_iterator i = apps.begin();
+      i != apps.end(); ++i) {
+    const rpc::Optional<policy_table::ModuleTypes>& modules =
+        i->second.moduleType;
+    if (modules.is_initialized()) {
+      module_types_[i->first].insert(modules->begin(), modules->end());
+    }
+  }
+
+  const policy_table::Zones& zones = pt->policy_table.module_config
+      .equipment->zones;
+  for (policy_table::Zones::const_iterator i = zones.begin();
+      i != zones.end(); ++i) {
+    const policy_table::InteriorZone& zone = i->second;
+    const SeatLocation seat = { zone.col, zone.row, zone.level };
+    // First zone with such location is used as it was found by scan before
+    if (zones_.find(seat) != zones_.end()) {
+      continue;
+    }
+    ZoneAccess& access = zones_[seat];
+    IndexModules(zone.auto_allow, &access.auto_allow);
+    IndexModules(zone.driver_allow, &access.driver_allow);
+  }
+}
+
 bool AccessRemoteImpl::IsAllowed(
-    const policy_table::AccessModules& modules,
-    const std::string& module_name, const std::string& rpc_name,
+    const AllowedModules& modules,
+    policy_table::ModuleType module, const std::string& rpc_name,
     RemoteControlParams* input) const {
   LOG4CXX_AUTO_TRACE(logger_);
-  policy_table::AccessModules::const_iterator i = modules.find(module_name);
+  AllowedModules::const_iterator i = modules.find(module);
   if (i == modules.end()) {
-    LOG4CXX_DEBUG(logger_, "Module " << module_name << " wasn't found");
+    LOG4CXX_DEBUG(logger_, "Module " << EnumToJsonString(module)
+                  << " wasn't found");
     return false;
   }
 
-  const policy_table::RemoteRpcs& rpcs = i->second;
+  const AllowedRpcs& rpcs = i->second;
   if (rpcs.empty()) {
     return true;
   }
-  policy_table::RemoteRpcs::const_iterator j = rpcs.find(rpc_name);
+  AllowedRpcs::const_iterator j = rpcs.find(rpc_name);
   if (j != rpcs.end()) {
-    const policy_table::Strings& parameters = j->second;
-    return CompareParameters(parameters, input);
+    return CompareParameters(j->second, input);
   }
   LOG4CXX_DEBUG(logger_, "RPC " << rpc_name << " wasn't found");
   return false;
 }
 
 bool AccessRemoteImpl::CompareParameters(
-    const policy_table::Strings& parameters,
+    const AllowedParameters& parameters,
     RemoteControlParams* input) const {
   LOG4CXX_AUTO_TRACE(logger_);
   if (parameters.empty()) {
@@ -312,7 +333,8 @@ void AccessRemoteImpl::Disable() {
 void AccessRemoteImpl::set_enabled(bool value) {
   enabled_ = country_consent() && value;
   *cache_->pt_->policy_table.module_config.user_consent_passengersRC = value;
-  cache_->Backup();
+  cache_->PublishTable();
+  cache_->Backup(kModuleConfigSection);
 }
 
 bool AccessRemoteImpl::country_consent() const {
@@ -41,6 +41,7 @@
 #include "json/reader.h"
 #include "json/features.h"
 #include "utils/logger.h"
+#include "config_profile/profile.h"
 
 #  include "policy/sql_pt_representation.h"
 
@@ -50,6 +51,10 @@ namespace policy {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "CacheManager")
 
+// Defined in policy_manager_impl.cc
+extern std::ostream& operator <<(std::ostream& output,
+                                 const policy_table::Strings& groups);
+
 #define CACHE_MANAGER_CHECK(return_value) {\
   if (!pt_) {\
     LOG4CXX_WARN(logger_, "The cache manager is not initialized");\
@@ -70,9 +75,18 @@ CacheManager::CacheManager()
     backup_(
                      new SQLPTRepresentation()
     ),
-    update_required(false) {
+    update_required(false),
+    modified_sections_(kNoSections),
+    last_usage_statistics_flush_(date_time::DateTime::getCurrentTime()),
+    check_permissions_time_metric_(utils::metrics::MetricsRegistry::instance()
+        ->GetHistogram("policy.check_permissions_time_us")),
+    permissions_matrix_misses_metric_(utils::metrics::MetricsRegistry::instance()
+        ->GetCounter("policy.permissions_matrix_misses")),
+    persist_time_metric_(utils::metrics::MetricsRegistry::instance()
+        ->GetHistogram("policy.persist_time_us")) {
 
   LOG4CXX_AUTO_TRACE(logger_);
+  cache_lock_.set_name("cache_lock_");
   backuper_ = new BackgroundBackuper(this);
   backup_thread_ = threads::CreateThread("Backup thread", backuper_);
   backup_thread_->start();
@@ -80,10 +94,21 @@ CacheManager::CacheManager()
 
 CacheManager::~CacheManager() {
   LOG4CXX_AUTO_TRACE(logger_);
+  FlushUsageStatistics(true);
   sync_primitives::AutoLock lock(backuper_locker_);
   backup_thread_->join();
   delete backup_thread_->delegate();
   threads::DeleteThread(backup_thread_);
+
+  // Backup requested right before stop could be left by backup thread
+  bool is_data_modified = false;
+  {
+    sync_primitives::AutoLock lock(modified_sections_lock_);
+    is_data_modified = kNoSections != modified_sections_;
+  }
+  if (is_data_modified) {
+    PersistData();
+  }
 }
 
 bool CacheManager::CanAppKeepContext(const std::string &app_id) {
@@ -148,10 +173,11 @@ void CacheManager::GetAllAppGroups(const std::string& app_id,
 
   LOG4CXX_AUTO_TRACE(logger_);
   CACHE_MANAGER_CHECK_VOID();
+  const TableVersion pt = PublishedTable();
   policy_table::ApplicationPolicies::const_iterator app_params_iter =
-      pt_->policy_table.app_policies.find(app_id);
+      pt->policy_table.app_policies.find(app_id);
 
-  if (pt_->policy_table.app_policies.end() != app_params_iter) {
+  if (pt->policy_table.app_policies.end() != app_params_iter) {
     policy_table::Strings::const_iterator iter =
         (*app_params_iter).second.groups.begin();
     policy_table::Strings::const_iterator iter_end =
@@ -220,7 +246,7 @@ bool CacheManager::ApplyUpdate(const policy_table::Table& update_pt) {
         pt_->policy_table.app_policies.end() != it;
         ++it) {
     if (IsDefaultPolicy(it->first)) {
-      SetDefaultPolicy(it->first);
+      ApplyDefaultPolicy(it->first);
     }
   }
 
@@ -235,7 +261,9 @@ bool CacheManager::ApplyUpdate(const policy_table::Table& update_pt) {
   if (update_pt.policy_table.consumer_friendly_messages.is_initialized()) {
     pt_->policy_table.consumer_friendly_messages =
         update_pt.policy_table.consumer_friendly_messages;
+    UpdateFriendlyMessages();
   }
+  PublishTable();
   ResetCalculatedPermissions();
   Backup();
   return true;
@@ -263,6 +291,14 @@ void CacheManager::GetHMIAppTypeAfterUpdate(std::map<std::string, StringArray>&
 }
 
 void CacheManager::Backup() {
+  Backup(kAllSections);
+}
+
+void CacheManager::Backup(uint32_t sections) {
+  {
+    sync_primitives::AutoLock lock(modified_sections_lock_);
+    modified_sections_ |= sections;
+  }
   sync_primitives::AutoLock lock(backuper_locker_);
   DCHECK(backuper_);
   backuper_->DoBackup();
@@ -310,7 +346,7 @@ bool CacheManager::SetDeviceData(const std::string &device_id,
 
   sync_primitives::AutoLock auto_lock(cache_lock_);
   CACHE_MANAGER_CHECK(false);
-  Backup();
+  Backup(kDeviceDataSection);
   return true;
 }
 
@@ -321,7 +357,7 @@ bool CacheManager::SetUserPermissionsForDevice(
   LOG4CXX_AUTO_TRACE(logger_);
   sync_primitives::AutoLock auto_lock(cache_lock_);
   CACHE_MANAGER_CHECK(false);
-  Backup();
+  Backup(kDeviceDataSection);
   return true;
 }
 
@@ -330,7 +366,7 @@ bool CacheManager::ReactOnUserDevConsentForApp(const std::string &app_id,
   LOG4CXX_AUTO_TRACE(logger_);
   CACHE_MANAGER_CHECK(false);
   bool result = true;
-  Backup();
+  Backup(kDeviceDataSection | kApplicationPoliciesSection);
   return result;
 }
 
@@ -356,7 +392,7 @@ bool CacheManager::SetUserPermissionsForApp(
   LOG4CXX_AUTO_TRACE(logger_);
   sync_primitives::AutoLock auto_lock(cache_lock_);
   CACHE_MANAGER_CHECK(false);
-  Backup();
+  Backup(kDeviceDataSection);
   return true;
 }
 
@@ -366,16 +402,16 @@ bool CacheManager::UpdateRequired() const {
 
 void CacheManager::SaveUpdateRequired(bool status) {
   update_required = status;
-  Backup();
+  Backup(kNoSections);
 }
 
 bool CacheManager::IsApplicationRevoked(const std::string& app_id) const {
   CACHE_MANAGER_CHECK(false);
-  bool is_revoked = false;
-  if (pt_->policy_table.app_policies.end() !=
-      pt_->policy_table.app_policies.find(app_id)) {
-    is_revoked = pt_->policy_table.app_policies[app_id].is_null();
-  }
+  const TableVersion pt = PublishedTable();
+  policy_table::ApplicationPolicies::const_iterator app_iter =
+      pt->policy_table.app_policies.find(app_id);
+  const bool is_revoked = pt->policy_table.app_policies.end() != app_iter &&
+      app_iter->second.is_null();
 
   return is_revoked;
 }
@@ -384,6 +420,70 @@ const policy_table::Strings& CacheManager::GetGroups(const PTString &app_id) {
   return pt_->policy_table.app_policies[app_id].groups;
 }
 
+CacheManager::RpcPermissions::RpcPermissions()
+  : allowed_levels(0) {
+  std::fill(parameters, parameters + kHmiLevelsCount, 0);
+}
+
+bool CacheManager::GroupsLess::operator()(
+    const policy_table::Strings& lhs, const policy_table::Strings& rhs) const {
+  policy_table::Strings::const_iterator lhs_it = lhs.begin();
+  policy_table::Strings::const_iterator rhs_it = rhs.begin();
+  for (; lhs.end() != lhs_it && rhs.end() != rhs_it; ++lhs_it, ++rhs_it) {
+    const int result = static_cast<const std::string&>(*lhs_it).compare(
+        static_cast<const std::string&>(*rhs_it));
+    if (0 != result) {
+      return result < 0;
+    }
+  }
+  return rhs.end() != rhs_it;
+}
+
+const CacheManager::RpcPermissionsMap& CacheManager::GetPermissionsMatrix(
+    const policy_table::Table& table,
+    const policy_table::Strings& groups) {
+  PermissionsMatrices::iterator matrix_it = permissions_matrices_.find(groups);
+  if (permissions_matrices_.end() != matrix_it) {
+    return matrix_it->second;
+  }
+
+  LOG4CXX_DEBUG(logger_, "Compiling permissions for groups: " << groups);
+  permissions_matrix_misses_metric_->Increment();
+  RpcPermissionsMap& matrix = permissions_matrices_[groups];
+  for (policy_table::Strings::const_iterator it = groups.begin();
+       groups.end() != it; ++it) {
+    policy_table::FunctionalGroupings::const_iterator concrete_group =
+        table.policy_table.functional_groupings.find(*it);
+    if (table.policy_table.functional_groupings.end() == concrete_group) {
+      continue;
+    }
+    const policy_table::Rpc& rpcs = concrete_group->second.rpcs;
+    for (policy_table::Rpc::const_iterator rpc_iter = rpcs.begin();
+         rpcs.end() != rpc_iter; ++rpc_iter) {
+      const policy_table::RpcParameters& rpc_param = rpc_iter->second;
+      uint32_t parameters = 0;
+      for (policy_table::Parameters::const_iterator params_iter =
+               rpc_param.parameters->begin();
+           rpc_param.parameters->end() != params_iter; ++params_iter) {
+        const policy_table::Parameter parameter = *params_iter;
+        DCHECK(static_cast<uint32_t>(parameter) < 32);
+        parameters |= 1u << parameter;
+      }
+      RpcPermissions& permissions = matrix[rpc_iter->first];
+      for (policy_table::HmiLevels::const_iterator level_iter =
+               rpc_param.hmi_levels.begin();
+           rpc_param.hmi_levels.end() != level_iter; ++level_iter) {
+        const size_t level = static_cast<policy_table::HmiLevel>(*level_iter);
+        if (level < kHmiLevelsCount) {
+          permissions.allowed_levels |= 1u << level;
+          permissions.parameters[level] |= parameters;
+        }
+      }
+    }
+  }
+  return matrix;
+}
+
 void CacheManager::CheckPermissions(const policy_table::Strings &groups,
                                     const PTString &hmi_level,
                                     const PTString &rpc,
@@ -391,42 +491,35 @@ void CacheManager::CheckPermissions(const policy_table::Strings &groups,
   LOG4CXX_AUTO_TRACE(logger_);
   CACHE_MANAGER_CHECK_VOID();
 
-  policy_table::Strings::const_iterator app_groups_iter = groups.begin();
-  policy_table::Strings::const_iterator app_groups_iter_end = groups.end();
-
-  policy_table::FunctionalGroupings::const_iterator concrete_group;
-
-  for (; app_groups_iter != app_groups_iter_end; ++app_groups_iter) {
-    concrete_group = pt_->policy_table.functional_groupings.find(*app_groups_iter);
-    if (pt_->policy_table.functional_groupings.end() != concrete_group) {
-      const policy_table::Rpcs& rpcs = concrete_group->second;
-
-      policy_table::Rpc::const_iterator rpc_iter = rpcs.rpcs.find(rpc);
-      if (rpcs.rpcs.end() != rpc_iter) {
-        policy_table::RpcParameters rpc_param = rpc_iter->second;
-
-        policy_table::HmiLevel hmi_level_e;
-        policy_table::EnumFromJsonString(hmi_level, &hmi_level_e);
-
-        policy_table::HmiLevels::const_iterator hmi_iter =
-            std::find(rpc_param.hmi_levels.begin(), rpc_param.hmi_levels.end(),
-                  hmi_level_e);
-
-        if (rpc_param.hmi_levels.end() != hmi_iter) {
-          result.hmi_level_permitted = PermitResult::kRpcAllowed;
-
-          policy_table::Parameters::const_iterator params_iter =
-              rpc_param.parameters->begin();
-          policy_table::Parameters::const_iterator params_iter_end =
-              rpc_param.parameters->end();
+  policy_table::HmiLevel hmi_level_e;
+  if (!policy_table::EnumFromJsonString(hmi_level, &hmi_level_e)) {
+    LOG4CXX_WARN(logger_, "Unknown HMI level " << hmi_level);
+    return;
+  }
 
-          for (;params_iter != params_iter_end; ++params_iter) {
-            result.list_of_allowed_params.push_back(
-                  policy_table::EnumToJsonString(*params_iter));
-          }
-        }
-      }
-    }
+  const TimevalStruct start_time = date_time::DateTime::getCurrentTime();
+  // Version is taken under the lock, so matrices compiled from it are
+  // dropped by ResetCalculatedPermissions after next version is published
+  sync_primitives::AutoLock lock(permissions_matrices_lock_);
+  const TableVersion pt = PublishedTable();
+  const RpcPermissionsMap& matrix = GetPermissionsMatrix(*pt, groups);
+  RpcPermissionsMap::const_iterator rpc_iter = matrix.find(rpc);
+  const bool allowed = matrix.end() != rpc_iter &&
+      (rpc_iter->second.allowed_levels & (1u << hmi_level_e));
+  check_permissions_time_metric_->Record(date_time::DateTime::getuSecs(
+      date_time::DateTime::Sub(date_time::DateTime::getCurrentTime(),
+                               start_time)));
+  if (!allowed) {
+    return;
+  }
+  result.hmi_level_permitted = PermitResult::kRpcAllowed;
+
+  uint32_t parameters = rpc_iter->second.parameters[hmi_level_e];
+  while (parameters) {
+    const int parameter = __builtin_ctz(parameters);
+    result.list_of_allowed_params.push_back(policy_table::EnumToJsonString(
+        static_cast<policy_table::Parameter>(parameter)));
+    parameters &= parameters - 1;
   }
 }
 
@@ -464,7 +557,7 @@ int CacheManager::KilometersBeforeExchange(int current) {
 bool CacheManager::SetCountersPassedForSuccessfulUpdate(int kilometers,
                                                         int days_after_epoch) {
   CACHE_MANAGER_CHECK(false);
-  Backup();
+  Backup(kModuleMetaSection);
   return true;
 }
 
@@ -484,12 +577,12 @@ int CacheManager::DaysBeforeExchange(int current) {
 
 void CacheManager::IncrementIgnitionCycles() {
   CACHE_MANAGER_CHECK_VOID();
-  Backup();
+  Backup(kModuleMetaSection);
 }
 
 void CacheManager::ResetIgnitionCycles() {
   CACHE_MANAGER_CHECK_VOID();
-  Backup();
+  Backup(kModuleMetaSection);
 }
 
 int CacheManager::TimeoutResponse() {
@@ -526,17 +619,84 @@ std::vector<UserFriendlyMessage> CacheManager::GetUserFriendlyMsg(
   CACHE_MANAGER_CHECK(result);
 
   const std::string fallback_language = "en-us";
+  FriendlyMessages messages;
+  {
+    sync_primitives::AutoLock lock(friendly_messages_lock_);
+    messages = friendly_messages_;
+  }
+  const FriendlyMessagesByCode* required = NULL;
+  const FriendlyMessagesByCode* fallback = NULL;
+  if (messages) {
+    FriendlyMessagesMap::const_iterator lang_it = messages->find(language);
+    if (messages->end() != lang_it) {
+      required = &lang_it->second;
+    }
+    lang_it = messages->find(fallback_language);
+    if (messages->end() != lang_it) {
+      fallback = &lang_it->second;
+    }
+  }
+
+  result.reserve(msg_codes.size());
   std::vector<std::string>::const_iterator it = msg_codes.begin();
   std::vector<std::string>::const_iterator it_end = msg_codes.end();
   for (; it != it_end; ++it) {
-
-    UserFriendlyMessage msg;
-    msg.message_code = *it;
-    result.push_back(msg);
+    // If message has no records with required language, fallback language
+    // is used instead
+    FriendlyMessagesByCode::const_iterator msg_it;
+    if (required && required->end() != (msg_it = required->find(*it))) {
+      result.push_back(msg_it->second);
+    } else if (fallback &&
+               fallback->end() != (msg_it = fallback->find(*it))) {
+      result.push_back(msg_it->second);
+    } else {
+      UserFriendlyMessage msg;
+      msg.message_code = *it;
+      result.push_back(msg);
+    }
   }
   return result;
 }
 
+void CacheManager::UpdateFriendlyMessages() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  utils::SharedPtr<FriendlyMessagesMap> messages(new FriendlyMessagesMap);
+  const policy_table::ConsumerFriendlyMessages& section =
+      *pt_->policy_table.consumer_friendly_messages;
+  if (pt_->policy_table.consumer_friendly_messages.is_initialized() &&
+      section.messages.is_initialized()) {
+    policy_table::Messages::const_iterator msg_it = section.messages->begin();
+    for (; section.messages->end() != msg_it; ++msg_it) {
+      const policy_table::Languages& languages = msg_it->second.languages;
+      policy_table::Languages::const_iterator lang_it = languages.begin();
+      for (; languages.end() != lang_it; ++lang_it) {
+        const policy_table::MessageString& text = lang_it->second;
+        UserFriendlyMessage& msg = (*messages)[lang_it->first][msg_it->first];
+        msg.message_code = msg_it->first;
+        if (text.tts.is_initialized()) {
+          msg.tts = *text.tts;
+        }
+        if (text.label.is_initialized()) {
+          msg.label = *text.label;
+        }
+        if (text.line1.is_initialized()) {
+          msg.line1 = *text.line1;
+        }
+        if (text.line2.is_initialized()) {
+          msg.line2 = *text.line2;
+        }
+        if (text.textBody.is_initialized()) {
+          msg.text_body = *text.textBody;
+        }
+      }
+    }
+  }
+  LOG4CXX_DEBUG(logger_, "Friendly messages cached for "
+                << messages->size() << " languages");
+  sync_primitives::AutoLock lock(friendly_messages_lock_);
+  friendly_messages_ = messages;
+}
+
 void CacheManager::GetServiceUrls(const std::string& service_type,
                                  EndpointUrls& end_points) {
   LOG4CXX_AUTO_TRACE(logger_);
@@ -588,8 +748,9 @@ int CacheManager::GetNotificationsNumber(const std::string &priority) {
 bool CacheManager::GetPriority(const std::string &policy_app_id,
                                std::string &priority) {
   CACHE_MANAGER_CHECK(false);
+  const TableVersion pt = PublishedTable();
   const policy_table::ApplicationPolicies& policies =
-      pt_->policy_table.app_policies;
+      pt->policy_table.app_policies;
 
   policy_table::ApplicationPolicies::const_iterator policy_iter = policies.find(policy_app_id);
   const bool app_id_exists = policies.end() != policy_iter;
@@ -628,17 +789,35 @@ struct HandleModuleTypes {
 void CacheManager::PersistData() {
   LOG4CXX_AUTO_TRACE(logger_);
   if (backup_.valid()) {
-    if (pt_.valid()) {
+    const TableVersion published_pt = PublishedTable();
+    if (published_pt.valid()) {
+      const TimevalStruct start_time = date_time::DateTime::getCurrentTime();
+
+      uint32_t sections = kNoSections;
+      {
+        sync_primitives::AutoLock lock(modified_sections_lock_);
+        std::swap(sections, modified_sections_);
+      }
 
-      cache_lock_.Acquire();
-      policy_table::Table copy_pt(*pt_);
-      cache_lock_.Release();
+      policy_table::Table copy_pt(*published_pt);
 
       policy_table::ApplicationPolicies& apps = copy_pt.policy_table.app_policies;
       std::for_each(apps.begin(), apps.end(), HandleModuleTypes(this));
-      backup_->Save(copy_pt);
+      if (!backup_->SaveSections(copy_pt, sections)) {
+        LOG4CXX_WARN(logger_, "Policy table sections were not saved");
+        // Keep them modified to be saved along with next backup
+        sync_primitives::AutoLock lock(modified_sections_lock_);
+        modified_sections_ |= sections;
+      }
       backup_->SaveUpdateRequired(update_required);
 
+      // Custom data is stored along with application policies
+      if (!(sections & kApplicationPoliciesSection)) {
+        backup_->WriteDb();
+        RecordPersistTime(start_time);
+        return;
+      }
+
       policy_table::ApplicationPolicies::const_iterator app_policy_iter =
           copy_pt.policy_table.app_policies.begin();
       policy_table::ApplicationPolicies::const_iterator app_policy_iter_end =
@@ -677,14 +856,41 @@ void CacheManager::PersistData() {
 
   // In case of extended policy the meta info should be backuped as well.
       backup_->WriteDb();
+      RecordPersistTime(start_time);
     }
   }
 }
 
+void CacheManager::RecordPersistTime(const TimevalStruct& start_time) {
+  persist_time_metric_->Record(date_time::DateTime::getuSecs(
+      date_time::DateTime::Sub(date_time::DateTime::getCurrentTime(),
+                               start_time)));
+}
+
+CacheManager::TableVersion CacheManager::PublishedTable() const {
+  sync_primitives::AutoLock lock(published_pt_lock_);
+  return published_pt_;
+}
+
+void CacheManager::PublishTable() {
+  TableVersion table(new policy_table::Table(*pt_));
+  TableVersion previous;
+  {
+    sync_primitives::AutoLock lock(published_pt_lock_);
+    previous = published_pt_;
+    published_pt_ = table;
+  }
+  // Previous version is released here or by the last reader holding it
+}
+
 void CacheManager::ResetCalculatedPermissions() {
   LOG4CXX_TRACE(logger_, "ResetCalculatedPermissions");
-  sync_primitives::AutoLock lock(calculated_permissions_lock_);
-  calculated_permissions_.clear();
+  {
+    sync_primitives::AutoLock lock(calculated_permissions_lock_);
+    calculated_permissions_.clear();
+  }
+  sync_primitives::AutoLock lock(permissions_matrices_lock_);
+  permissions_matrices_.clear();
 }
 
 void CacheManager::AddCalculatedPermissions(
@@ -749,7 +955,7 @@ utils::SharedPtr<policy_table::Table>
 CacheManager::GenerateSnapshot() {
   CACHE_MANAGER_CHECK(snapshot_);
   snapshot_ = new policy_table::Table();
-  snapshot_->policy_table = pt_->policy_table;
+  snapshot_->policy_table = PublishedTable()->policy_table;
   CheckSnapshotInitialization();
 
   policy_table::ConsumerFriendlyMessages messages(
@@ -785,8 +991,9 @@ bool CacheManager::GetFunctionalGroupings(
 
   LOG4CXX_AUTO_TRACE(logger_);
   CACHE_MANAGER_CHECK(false);
+  const TableVersion pt = PublishedTable();
   const policy_table::FunctionalGroupings& f_groupings =
-    pt_->policy_table.functional_groupings;
+    pt->policy_table.functional_groupings;
 
   groups.insert(f_groupings.begin(), f_groupings.end());
   return true;
@@ -805,7 +1012,7 @@ bool CacheManager::SetMetaInfo(const std::string &ccpu_version,
                                const std::string &wers_country_code,
                                const std::string &language) {
   CACHE_MANAGER_CHECK(false);
-  Backup();
+  Backup(kModuleMetaSection);
   return true;
 }
 
@@ -817,7 +1024,7 @@ bool CacheManager::IsMetaInfoPresent() const {
 
 bool CacheManager::SetSystemLanguage(const std::string &language) {
   CACHE_MANAGER_CHECK(false);
-  Backup();
+  Backup(kModuleMetaSection);
   return true;
 }
 
@@ -841,33 +1048,86 @@ bool CacheManager::GetFunctionalGroupNames(FunctionalGroupNames &names) {
 
 bool CacheManager::CleanupUnpairedDevices() {
   CACHE_MANAGER_CHECK(false);
-  Backup();
+  Backup(kDeviceDataSection);
   return true;
 }
 
 void CacheManager::Increment(usage_statistics::GlobalCounterId type) {
   CACHE_MANAGER_CHECK_VOID();
-  Backup();
+  usage_statistics_.Increment(type);
+  FlushUsageStatistics(false);
 }
 
 void CacheManager::Increment(const std::string &app_id,
                              usage_statistics::AppCounterId type) {
   CACHE_MANAGER_CHECK_VOID();
-  Backup();
+  usage_statistics_.Increment(app_id, type);
+  FlushUsageStatistics(false);
 }
 
 void CacheManager::Set(const std::string &app_id,
                        usage_statistics::AppInfoId type,
                        const std::string &value) {
   CACHE_MANAGER_CHECK_VOID();
-  Backup();
+  usage_statistics_.Set(app_id, type, value);
+  FlushUsageStatistics(false);
 }
 
 void CacheManager::Add(const std::string &app_id,
                        usage_statistics::AppStopwatchId type,
                        int seconds) {
   CACHE_MANAGER_CHECK_VOID();
-  Backup();
+  usage_statistics_.Add(app_id, type, seconds);
+  FlushUsageStatistics(false);
+}
+
+void CacheManager::FlushUsageStatistics(bool force) {
+  {
+    sync_primitives::AutoLock lock(usage_statistics_flush_lock_);
+    const TimevalStruct now = date_time::DateTime::getCurrentTime();
+    const int64_t flush_interval_ms =
+        static_cast<int64_t>(
+            profile::Profile::instance()->usage_statistics_flush_interval()) *
+        date_time::DateTime::MILLISECONDS_IN_SECOND;
+    if (!force &&
+        date_time::DateTime::calculateTimeDiff(
+            now, last_usage_statistics_flush_) < flush_interval_ms) {
+      return;
+    }
+    last_usage_statistics_flush_ = now;
+  }
+
+  std::set<std::string> app_ids;
+  if (!usage_statistics_.TakeChanges(&app_ids)) {
+    return;
+  }
+
+  // Only applications having statistics are stored within this table, so
+  // backup is needed just when new ones appear
+  bool is_table_changed = false;
+  {
+    sync_primitives::AutoLock lock(cache_lock_);
+    if (!pt_) {
+      return;
+    }
+    policy_table::AppLevels& app_levels =
+        *pt_->policy_table.usage_and_error_counts->app_level;
+    std::set<std::string>::const_iterator it = app_ids.begin();
+    for (; app_ids.end() != it; ++it) {
+      if (app_levels.end() == app_levels.find(*it)) {
+        policy_table::AppLevel app_level;
+        app_level.mark_initialized();
+        app_levels[*it] = app_level;
+        is_table_changed = true;
+      }
+    }
+    if (is_table_changed) {
+      PublishTable();
+    }
+  }
+  if (is_table_changed) {
+    Backup(kUsageAndErrorCountsSection);
+  }
 }
 
 long CacheManager::ConvertSecondsToMinute(int seconds) {
@@ -877,16 +1137,21 @@ long CacheManager::ConvertSecondsToMinute(int seconds) {
 
 bool CacheManager::SetDefaultPolicy(const std::string &app_id) {
   CACHE_MANAGER_CHECK(false);
+  ApplyDefaultPolicy(app_id);
+  PublishTable();
+  Backup(kApplicationPoliciesSection);
+  return true;
+}
+
+void CacheManager::ApplyDefaultPolicy(const std::string& app_id) {
   policy_table::ApplicationPolicies::const_iterator iter =
       pt_->policy_table.app_policies.find(kDefaultId);
   if (pt_->policy_table.app_policies.end() != iter) {
     pt_->policy_table.app_policies[app_id] =
         pt_->policy_table.app_policies[kDefaultId];
 
-    SetIsDefault(app_id);
+    pt_->policy_table.app_policies[app_id].set_to_string(kDefaultId);
   }
-  Backup();
-  return true;
 }
 
 bool CacheManager::IsDefaultPolicy(const std::string& app_id) {
@@ -906,6 +1171,7 @@ bool CacheManager::SetIsDefault(const std::string& app_id) {
       pt_->policy_table.app_policies.find(app_id);
   if (pt_->policy_table.app_policies.end() != iter) {
     pt_->policy_table.app_policies[app_id].set_to_string(kDefaultId);
+    PublishTable();
   }
   return true;
 }
@@ -926,7 +1192,8 @@ bool CacheManager::SetPredataPolicy(const std::string &app_id) {
 
   pt_->policy_table.app_policies[app_id].set_to_string(kPreDataConsentId);
 
-  Backup();
+  PublishTable();
+  Backup(kApplicationPoliciesSection);
   return true;
 }
 
@@ -972,7 +1239,7 @@ bool CacheManager::SetUnpairedDevice(const std::string &device_id,
 
 bool CacheManager::SetVINValue(const std::string& value) {
   CACHE_MANAGER_CHECK(false);
-  Backup();
+  Backup(kModuleMetaSection);
   return true;
 }
 
@@ -1013,6 +1280,8 @@ void CacheManager::FillDeviceSpecificData() {
 bool CacheManager::LoadFromBackup() {
   sync_primitives::AutoLock lock(cache_lock_);
   pt_ = backup_->GenerateSnapshot();
+  UpdateFriendlyMessages();
+  PublishTable();
   update_required = backup_->UpdateRequired();
 
   FillDeviceSpecificData();
@@ -1022,16 +1291,17 @@ bool CacheManager::LoadFromBackup() {
 
 bool CacheManager::LoadFromFile(const std::string& file_name) {
   LOG4CXX_AUTO_TRACE(logger_);
-  BinaryMessage json_string;
-  if (!file_system::ReadBinaryFile(file_name, json_string)) {
+  // Preloaded table is parsed right from the mapped file, it is the biggest
+  // document SDL reads at startup
+  const file_system::MappedFile json(file_name);
+  if (!json.IsMapped()) {
     LOG4CXX_FATAL(logger_, "Failed to read pt file.");
     return false;
   }
 
   Json::Value value;
   Json::Reader reader(Json::Features::strictMode());
-  std::string json(json_string.begin(), json_string.end());
-  if (!reader.parse(json.c_str(), value)) {
+  if (!reader.parse(json.begin(), json.end(), value)) {
     LOG4CXX_FATAL(
         logger_,
         "Preloaded PT is corrupted: " << reader.getFormattedErrorMessages());
@@ -1046,6 +1316,8 @@ bool CacheManager::LoadFromFile(const std::string& file_name) {
   if (pt_->is_valid()) {
     policy_table::ApplicationPolicies& apps = pt_->policy_table.app_policies;
     std::for_each(apps.begin(), apps.end(), HandleModuleTypes(this));
+    UpdateFriendlyMessages();
+    PublishTable();
     if (backup_->Save(*pt_)) {
       backup_->WriteDb();
       return true;
@@ -1054,10 +1326,8 @@ bool CacheManager::LoadFromFile(const std::string& file_name) {
       return false;
     }
   } else {
-    rpc::ValidationReport report("policy_table");
-    pt_->ReportErrors(&report);
-    LOG4CXX_FATAL(logger_,
-                  "Parsed table is not valid " << rpc::PrettyFormat(report));
+    LOG4CXX_FATAL(logger_, "Parsed table is not valid "
+                  << rpc::ValidationErrors("policy_table", *pt_));
     return false;
   }
 }
@@ -120,6 +120,29 @@ bool operator!=(const policy_table::ApplicationParams& first,
   return false;
 }
 
+void GetChangedFunctionalGroups(
+    const policy_table::FunctionalGroupings& snapshot,
+    const policy_table::FunctionalGroupings& update,
+    std::set<std::string>* changed_groups) {
+  DCHECK(changed_groups);
+  FuncGroupConstItr it = update.begin();
+  FuncGroupConstItr it_end = update.end();
+  for (; it != it_end; ++it) {
+    FuncGroupConstItr it_current = snapshot.find(it->first);
+    if (snapshot.end() == it_current) {
+      // New groups are checked as part of application groups list
+      continue;
+    }
+    std::string current_group;
+    it_current->second.WriteJson(&current_group);
+    std::string updated_group;
+    it->second.WriteJson(&updated_group);
+    if (current_group != updated_group) {
+      changed_groups->insert(it->first);
+    }
+  }
+}
+
 CheckAppPolicy::CheckAppPolicy(
     PolicyManagerImpl* pm,
     const utils::SharedPtr<policy_table::Table> update,
@@ -127,6 +150,9 @@ CheckAppPolicy::CheckAppPolicy(
   : pm_(pm),
     update_(update),
     snapshot_(snapshot) {
+  GetChangedFunctionalGroups(snapshot_->policy_table.functional_groupings,
+                             update_->policy_table.functional_groupings,
+                             &changed_groups_);
 }
 
 bool policy::CheckAppPolicy::HasRevokedGroups(
@@ -207,6 +233,21 @@ bool policy::CheckAppPolicy::HasConsentNeededGroups(
   return false;
 }
 
+bool CheckAppPolicy::HasChangedGroups(
+    const AppPoliciesValueType& app_policy) const {
+  if (changed_groups_.empty()) {
+    return false;
+  }
+  StringsConstItr it = app_policy.second.groups.begin();
+  StringsConstItr it_end = app_policy.second.groups.end();
+  for (; it != it_end; ++it) {
+    if (changed_groups_.end() != changed_groups_.find(*it)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::vector<FunctionalGroupPermission>
 policy::CheckAppPolicy::GetRevokedGroups(
     const policy::AppPoliciesValueType& app_policy) const {
@@ -326,6 +367,10 @@ bool CheckAppPolicy::operator()(const AppPoliciesValueType& app_policy) {
   }
 
   PermissionsCheckResult result = CheckPermissionsChanges(app_policy);
+  if (RESULT_NO_CHANGES == result && HasChangedGroups(app_policy)) {
+    // Same groups are assigned, but some of them got other rpcs
+    result = RESULT_CONSENT_NOT_REQIURED;
+  }
   if (RESULT_NO_CHANGES == result) {
     LOG4CXX_INFO(logger_, "Permissions for application:" << app_id <<
                  " wasn't changed.");
@@ -71,7 +71,8 @@ PolicyManagerImpl::PolicyManagerImpl()
 #endif  // SDL_REMOTE_CONTROL
     retry_sequence_timeout_(60),
     retry_sequence_index_(0),
-    ignition_check(true) {
+    ignition_check(true),
+    pt_update_loop_("PolicyUpdate", this) {
 }
 
 void PolicyManagerImpl::set_listener(PolicyListener* listener) {
@@ -81,10 +82,13 @@ void PolicyManagerImpl::set_listener(PolicyListener* listener) {
 
 utils::SharedPtr<policy_table::Table> PolicyManagerImpl::Parse(
   const BinaryMessage& pt_content) {
-  std::string json(pt_content.begin(), pt_content.end());
+  if (pt_content.empty()) {
+    return utils::SharedPtr<policy_table::Table>();
+  }
+  const char* json = reinterpret_cast<const char*>(&pt_content[0]);
   Json::Value value;
   Json::Reader reader;
-  if (reader.parse(json.c_str(), value)) {
+  if (reader.parse(json, json + pt_content.size(), value)) {
     return new policy_table::Table(&value);
   } else {
     return utils::SharedPtr<policy_table::Table>();
@@ -127,54 +131,67 @@ bool PolicyManagerImpl::LoadPT(const std::string& file,
   update_status_manager_.OnValidUpdateReceived();
   cache_->SaveUpdateRequired(false);
 
-  apps_registration_lock_.Acquire();
+  // Saving and notification of applications are done in background,
+  // policy readers keep using current table until update replaces it
+  pt_update_loop_.PostMessage(pt_update);
+  return true;
+}
 
-  // Get current DB data, since it could be updated during awaiting of PTU
-  utils::SharedPtr<policy_table::Table> policy_table_snapshot =
-      cache_->GenerateSnapshot();
-  if (!policy_table_snapshot) {
-    LOG4CXX_ERROR(logger_, "Failed to create snapshot of policy table");
-    return false;
-  }
+void PolicyManagerImpl::Handle(const PTUpdate pt_update) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  {
+    sync_primitives::AutoLock lock(apps_registration_lock_);
+
+    // Get current DB data, since it could be updated during awaiting of PTU
+    utils::SharedPtr<policy_table::Table> policy_table_snapshot =
+        cache_->GenerateSnapshot();
+    if (!policy_table_snapshot) {
+      LOG4CXX_ERROR(logger_, "Failed to create snapshot of policy table");
+      update_status_manager_.OnWrongUpdateReceived();
+      return;
+    }
 
-  // Replace current data with updated
-  if (!cache_->ApplyUpdate(*pt_update)) {
-    LOG4CXX_WARN(logger_, "Unsuccessful save of updated policy table.");
-    return false;
-  }
+    // Replace current data with updated
+    if (!cache_->ApplyUpdate(*pt_update)) {
+      LOG4CXX_WARN(logger_, "Unsuccessful save of updated policy table.");
+      update_status_manager_.OnWrongUpdateReceived();
+      return;
+    }
+    listener_->OnPTUpdated();
 
-  if (pt_update->policy_table.module_config.certificate.is_initialized()) {
-    listener_->OnCertificateUpdated(*(pt_update->policy_table.module_config.certificate));
-  }
+    if (pt_update->policy_table.module_config.certificate.is_initialized()) {
+      listener_->OnCertificateUpdated(
+          *(pt_update->policy_table.module_config.certificate));
+    }
 
-  // Check permissions for applications, send notifications
-  CheckPermissionsChanges(pt_update, policy_table_snapshot);
+    // Check permissions for applications, send notifications
+    listener_->OnPermissionsChangesStarted();
+    CheckPermissionsChanges(pt_update, policy_table_snapshot);
+    listener_->OnPermissionsChangesFinished();
 
 #ifdef SDL_REMOTE_CONTROL
-  access_remote_->Init();
-  CheckPTUUpdatesChange(pt_update, policy_table_snapshot);
+    access_remote_->Init();
+    CheckPTUUpdatesChange(pt_update, policy_table_snapshot);
 #endif  // SDL_REMOTE_CONTROL
 
-  std::map<std::string, StringArray> app_hmi_types;
-  cache_->GetHMIAppTypeAfterUpdate(app_hmi_types);
-  if (!app_hmi_types.empty()) {
-    LOG4CXX_INFO(logger_, "app_hmi_types is full calling OnUpdateHMIAppType");
-    listener_->OnUpdateHMIAppType(app_hmi_types);
-  }else{
-    LOG4CXX_INFO(logger_, "app_hmi_types empty" << pt_content.size());
+    std::map<std::string, StringArray> app_hmi_types;
+    cache_->GetHMIAppTypeAfterUpdate(app_hmi_types);
+    if (!app_hmi_types.empty()) {
+      LOG4CXX_INFO(logger_, "app_hmi_types is full calling OnUpdateHMIAppType");
+      listener_->OnUpdateHMIAppType(app_hmi_types);
+    } else {
+      LOG4CXX_INFO(logger_, "app_hmi_types empty");
+    }
   }
 
-  apps_registration_lock_.Release();
-
   // If there was a user request for policy table update, it should be started
   // right after current update is finished
   if (update_status_manager_.IsUpdateRequired()) {
     StartPTExchange();
-    return true;
+    return;
   }
 
   RefreshRetrySequence();
-  return true;
 }
 
 void PolicyManagerImpl::CheckPermissionsChanges(
@@ -219,9 +236,9 @@ void PolicyManagerImpl::RequestPTUpdate() {
 
   IsPTValid(policy_table_snapshot, policy_table::PT_SNAPSHOT);
 
-  Json::Value value = policy_table_snapshot->ToJsonValue();
-  Json::FastWriter writer;
-  std::string message_string = writer.write(value);
+  // Snapshot is written right into the string without building Json::Value
+  std::string message_string;
+  policy_table_snapshot->WriteJson(&message_string);
 
   BinaryMessage update(message_string.begin(), message_string.end());
 
@@ -689,10 +706,9 @@ bool PolicyManagerImpl::IsPTValid(
   if (!policy_table->is_valid()) {
     LOG4CXX_ERROR(
           logger_, "Policy table is not valid.");
-    rpc::ValidationReport report("policy_table");
-    policy_table->ReportErrors(&report);
-    LOG4CXX_DEBUG(logger_,
-                 "Errors: " << rpc::PrettyFormat(report));
+    // Report is built only if it is logged
+    LOG4CXX_DEBUG(logger_, "Errors: "
+                  << rpc::ValidationErrors("policy_table", *policy_table));
     return false;
   }
   return true;
@@ -253,6 +253,7 @@ bool SQLPTExtRepresentation::SetDeviceData(const std::string& device_id,
 bool SQLPTExtRepresentation::SetUserPermissionsForDevice(
   const std::string& device_id, const StringArray& consented_groups,
   const StringArray& disallowed_groups) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_TRACE(logger_, "SetUserPermissionsForDevice");
   dbms::SQLQuery count_query(db());
   if (!count_query.Prepare(sql_pt_ext::kCountDeviceConsentGroup)) {
@@ -310,7 +311,7 @@ bool SQLPTExtRepresentation::SetUserPermissionsForDevice(
       }
     }
 
-    return true;
+    return transaction.Commit();
   }
 
   // Insert new values
@@ -349,7 +350,7 @@ bool SQLPTExtRepresentation::SetUserPermissionsForDevice(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTExtRepresentation::ReactOnUserDevConsentForApp(
@@ -393,6 +394,7 @@ bool SQLPTExtRepresentation::ReactOnUserDevConsentForApp(
 
 bool SQLPTExtRepresentation::SetUserPermissionsForApp(
   const PermissionConsent& permissions) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_INFO(logger_, "SetUserPermissionsForApp");
   // TODO(AOleynik): Handle situation, when no application was specified, i.e.
   // general permissions were set
@@ -468,7 +470,7 @@ bool SQLPTExtRepresentation::SetUserPermissionsForApp(
     }
     continue;
   }
-  return true;
+  return transaction.Commit();
 }
 
 std::vector<UserFriendlyMessage> SQLPTExtRepresentation::GetUserFriendlyMsg(
@@ -616,6 +618,7 @@ bool SQLPTExtRepresentation::SetSystemLanguage(const std::string& language) {
 
 bool SQLPTExtRepresentation::SaveApplicationPolicies(
   const policy_table::ApplicationPolicies& apps) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_INFO(logger_, "SaveApplicationPolicies ext");
   dbms::SQLQuery query_delete(db());
   if (!query_delete.Exec(sql_pt::kDeleteAppGroup)) {
@@ -670,11 +673,12 @@ bool SQLPTExtRepresentation::SaveApplicationPolicies(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTExtRepresentation::SaveSpecificAppPolicy(
     const policy_table::ApplicationPolicies::value_type& app) {
+  dbms::ScopedTransaction transaction(db());
   if (app.second.is_string()) {
     if (kDefaultId.compare(app.second.get_string()) == 0) {
       if (!SetDefaultPolicy(app.first)) {
@@ -687,7 +691,7 @@ bool SQLPTExtRepresentation::SaveSpecificAppPolicy(
     }
 
     // Stop saving other params, since predefined permissions already set
-    return true;
+    return transaction.Commit();
   }
 
   SetIsDefault(app.first, false);
@@ -734,7 +738,7 @@ bool SQLPTExtRepresentation::SaveSpecificAppPolicy(
     return false;
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTExtRepresentation::GatherApplicationPolicies(
@@ -932,6 +936,7 @@ void SQLPTExtRepresentation::GatherConsentGroup(
 
 bool SQLPTExtRepresentation::SaveDeviceData(
 const policy_table::DeviceData& devices) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_INFO(logger_, "SaveDeviceData");
   dbms::SQLQuery drop_device_query(db());
   const std::string drop_device = "DELETE FROM `device`";
@@ -983,12 +988,13 @@ const policy_table::DeviceData& devices) {
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTExtRepresentation::SaveConsentGroup(
   const std::string& device_id,
   const policy_table::UserConsentRecords& records) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_INFO(logger_, "SaveConsentGroup");
   dbms::SQLQuery query(db());
 
@@ -1045,11 +1051,12 @@ bool SQLPTExtRepresentation::SaveConsentGroup(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTExtRepresentation::SavePreconsentedGroup(
   const std::string& app_id, const policy_table::Strings& groups) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_INFO(logger_, "SavePreconsentedGroup");
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt_ext::kInsertPreconsentedGroups)) {
@@ -1068,7 +1075,7 @@ bool SQLPTExtRepresentation::SavePreconsentedGroup(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 void SQLPTExtRepresentation::GatherModuleMeta(
@@ -1411,6 +1418,7 @@ bool SQLPTExtRepresentation::SaveModuleMeta(
 
 bool SQLPTExtRepresentation::SaveAppCounters(
     const rpc::policy_table_interface_base::AppLevels& app_levels) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query(db());
   if (!query.Exec(sql_pt::kDeleteAppLevel)) {
     LOG4CXX_WARN(logger_, "Incorrect delete from app level.");
@@ -1443,7 +1451,7 @@ bool SQLPTExtRepresentation::SaveAppCounters(
       return false;
     }
   }
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTExtRepresentation::SaveGlobalCounters(
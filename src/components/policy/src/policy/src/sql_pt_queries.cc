@@ -522,6 +522,10 @@ const std::string kCheckDBIntegrity = "PRAGMA integrity_check";
 
 const std::string kCheckPgNumber = "PRAGMA page_count";
 
+const std::string kEnableWriteAheadLog = "PRAGMA journal_mode = WAL";
+
+const std::string kSetSynchronousLevel = "PRAGMA synchronous = ";
+
 const std::string kSelectRpc =
   "SELECT DISTINCT `rpc`.`parameter` FROM `rpc` "
   "  JOIN `app_group` AS `g` ON (`g`.`functional_group_id` = `rpc`.`functional_group_id` "
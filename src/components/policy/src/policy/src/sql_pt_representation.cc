@@ -35,6 +35,7 @@
 #include <stdint.h>
 #include <errno.h>
 #include <unistd.h>
+#include <sstream>
 
 #include "utils/logger.h"
 #include "policy/sql_pt_representation.h"
@@ -356,6 +357,17 @@ InitResult SQLPTRepresentation::Init() {
     LOG4CXX_ERROR(logger_, "There are no read/write permissions for database");
     return InitResult::FAIL;
   }
+  dbms::SQLQuery journal_mode(db());
+  if (!journal_mode.Exec(sql_pt::kEnableWriteAheadLog)) {
+    LOG4CXX_WARN(logger_, "Incorrect pragma for write-ahead log.");
+  }
+  std::stringstream synchronous_level;
+  synchronous_level << sql_pt::kSetSynchronousLevel
+                    << profile::Profile::instance()->
+                       policy_db_synchronous_level();
+  if (!journal_mode.Exec(synchronous_level.str())) {
+    LOG4CXX_WARN(logger_, "Incorrect pragma for synchronous level.");
+  }
 #endif  // __QNX__
   dbms::SQLQuery check_pages(db());
   if (!check_pages.Prepare(sql_pt::kCheckPgNumber) || !check_pages.Next()) {
@@ -701,43 +713,52 @@ bool SQLPTRepresentation::GatherApplicationPolicies(
 
 bool SQLPTRepresentation::Save(const policy_table::Table& table) {
   LOG4CXX_AUTO_TRACE(logger_);
-  db_->BeginTransaction();
-  if (!SaveFunctionalGroupings(table.policy_table.functional_groupings)) {
-    db_->RollbackTransaction();
+  return SaveSections(table, kAllSections);
+}
+
+bool SQLPTRepresentation::SaveSections(const policy_table::Table& table,
+                                       uint32_t sections) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (kNoSections == sections) {
+    return true;
+  }
+  dbms::ScopedTransaction transaction(db());
+  if ((sections & kFunctionalGroupingsSection) &&
+      !SaveFunctionalGroupings(table.policy_table.functional_groupings)) {
     return false;
   }
-  if (!SaveApplicationPolicies(table.policy_table.app_policies)) {
-    db_->RollbackTransaction();
+  if ((sections & kApplicationPoliciesSection) &&
+      !SaveApplicationPolicies(table.policy_table.app_policies)) {
     return false;
   }
-  if (!SaveModuleConfig(table.policy_table.module_config)) {
-    db_->RollbackTransaction();
+  if ((sections & kModuleConfigSection) &&
+      !SaveModuleConfig(table.policy_table.module_config)) {
     return false;
   }
-  if (!SaveConsumerFriendlyMessages(
+  if ((sections & kConsumerFriendlyMessagesSection) &&
+      !SaveConsumerFriendlyMessages(
         *table.policy_table.consumer_friendly_messages)) {
-    db_->RollbackTransaction();
     return false;
   }
 
-  if (!SaveDeviceData(*table.policy_table.device_data)) {
-    db_->RollbackTransaction();
+  if ((sections & kDeviceDataSection) &&
+      !SaveDeviceData(*table.policy_table.device_data)) {
     return false;
   }
-  if (!SaveUsageAndErrorCounts(*table.policy_table.usage_and_error_counts)) {
-    db_->RollbackTransaction();
+  if ((sections & kUsageAndErrorCountsSection) &&
+      !SaveUsageAndErrorCounts(*table.policy_table.usage_and_error_counts)) {
     return false;
   }
-  if (!SaveModuleMeta(*table.policy_table.module_meta)) {
-    db_->RollbackTransaction();
+  if ((sections & kModuleMetaSection) &&
+      !SaveModuleMeta(*table.policy_table.module_meta)) {
     return false;
   }
-  db_->CommitTransaction();
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveFunctionalGroupings(
   const policy_table::FunctionalGroupings& groups) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query_delete(db());
   if (!query_delete.Exec(sql_pt::kDeleteRpc)) {
     LOG4CXX_WARN(logger_, "Incorrect delete from rpc.");
@@ -780,11 +801,12 @@ bool SQLPTRepresentation::SaveFunctionalGroupings(
       return false;
     }
   }
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveRpcs(int64_t group_id,
                                    const policy_table::Rpc& rpcs) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query(db());
   dbms::SQLQuery query_parameter(db());
   if (!query.Prepare(sql_pt::kInsertRpc)
@@ -826,11 +848,12 @@ bool SQLPTRepresentation::SaveRpcs(int64_t group_id,
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveApplicationPolicies(
   const policy_table::ApplicationPolicies& apps) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query_delete(db());
   if (!query_delete.Exec(sql_pt::kDeleteAppGroup)) {
     LOG4CXX_WARN(logger_, "Incorrect delete from app_group.");
@@ -897,11 +920,12 @@ bool SQLPTRepresentation::SaveApplicationPolicies(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveSpecificAppPolicy(
     const policy_table::ApplicationPolicies::value_type& app) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery app_query(db());
   if (!app_query.Prepare(sql_pt::kInsertApplication)) {
     LOG4CXX_WARN(logger_, "Incorrect insert statement into application.");
@@ -927,7 +951,7 @@ bool SQLPTRepresentation::SaveSpecificAppPolicy(
         return false;
       }
       // Stop saving other params, since predefined permissions already set
-      return true;
+      return transaction.Commit();
     }
   }
 
@@ -959,11 +983,12 @@ bool SQLPTRepresentation::SaveSpecificAppPolicy(
     return false;
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveAppGroup(
   const std::string& app_id, const policy_table::Strings& app_groups) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kInsertAppGroup)) {
     LOG4CXX_WARN(logger_, "Incorrect insert statement for app group");
@@ -984,11 +1009,12 @@ bool SQLPTRepresentation::SaveAppGroup(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveNickname(const std::string& app_id,
                                        const policy_table::Strings& nicknames) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kInsertNickname)) {
     LOG4CXX_WARN(logger_, "Incorrect insert statement for nickname");
@@ -1005,11 +1031,12 @@ bool SQLPTRepresentation::SaveNickname(const std::string& app_id,
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveAppType(const std::string& app_id,
                                       const policy_table::AppHMITypes& types) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kInsertAppType)) {
     LOG4CXX_WARN(logger_, "Incorrect insert statement for app type");
@@ -1026,7 +1053,7 @@ bool SQLPTRepresentation::SaveAppType(const std::string& app_id,
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveModuleMeta(const policy_table::ModuleMeta& meta) {
@@ -1036,6 +1063,7 @@ bool SQLPTRepresentation::SaveModuleMeta(const policy_table::ModuleMeta& meta) {
 
 bool SQLPTRepresentation::SaveModuleConfig(
   const policy_table::ModuleConfig& config) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_AUTO_TRACE(logger_);
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kUpdateModuleConfig)) {
@@ -1084,11 +1112,12 @@ bool SQLPTRepresentation::SaveModuleConfig(
   }
 #endif  // SDL_REMOTE_CONTROL
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveServiceEndpoints(
   const policy_table::ServiceEndpoints& endpoints) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query(db());
   if (!query.Exec(sql_pt::kDeleteEndpoint)) {
     LOG4CXX_WARN(logger_, "Incorrect delete from endpoint.");
@@ -1119,11 +1148,12 @@ bool SQLPTRepresentation::SaveServiceEndpoints(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveConsumerFriendlyMessages(
   const policy_table::ConsumerFriendlyMessages& messages) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_AUTO_TRACE(logger_);
 
   // According CRS-2419  If there is no “consumer_friendly_messages” key,
@@ -1168,7 +1198,7 @@ bool SQLPTRepresentation::SaveConsumerFriendlyMessages(
     LOG4CXX_INFO(logger_, "Messages list is empty");
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveMessageType(const std::string& type) {
@@ -1212,6 +1242,7 @@ bool SQLPTRepresentation::SaveMessageString(
 
 bool SQLPTRepresentation::SaveSecondsBetweenRetries(
   const policy_table::SecondsBetweenRetries& seconds) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query(db());
   if (!query.Exec(sql_pt::kDeleteSecondsBetweenRetries)) {
     LOG4CXX_WARN(logger_, "Incorrect delete from seconds between retries.");
@@ -1232,11 +1263,12 @@ bool SQLPTRepresentation::SaveSecondsBetweenRetries(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveNumberOfNotificationsPerMinute(
   const policy_table::NumberOfNotificationsPerMinute& notifications) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kInsertNotificationsByPriority)) {
     LOG4CXX_WARN(logger_,
@@ -1254,11 +1286,12 @@ bool SQLPTRepresentation::SaveNumberOfNotificationsPerMinute(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveDeviceData(
   const policy_table::DeviceData& devices) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_AUTO_TRACE(logger_);
   dbms::SQLQuery query(db());
   if (!query.Exec(sql_pt::kDeleteAllDevices)) {
@@ -1281,11 +1314,12 @@ bool SQLPTRepresentation::SaveDeviceData(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveUsageAndErrorCounts(
   const policy_table::UsageAndErrorCounts& counts) {
+  dbms::ScopedTransaction transaction(db());
   const_cast<policy_table::UsageAndErrorCounts&>(counts).mark_initialized();
   dbms::SQLQuery query(db());
   if (!query.Exec(sql_pt::kDeleteAppLevel)) {
@@ -1307,7 +1341,7 @@ bool SQLPTRepresentation::SaveUsageAndErrorCounts(
       return false;
     }
   }
-  return true;
+  return transaction.Commit();
 }
 
 void SQLPTRepresentation::IncrementIgnitionCycles() {
@@ -1514,6 +1548,7 @@ bool SQLPTRepresentation::GatherModuleType(
 
 bool SQLPTRepresentation::SaveAppGroupPrimary(
   const std::string& app_id, const policy_table::Strings& app_groups) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_AUTO_TRACE(logger_);
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kInsertAppGroupPrimary)) {
@@ -1534,11 +1569,12 @@ bool SQLPTRepresentation::SaveAppGroupPrimary(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveAppGroupNonPrimary(
   const std::string& app_id, const policy_table::Strings& app_groups) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_AUTO_TRACE(logger_);
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kInsertAppGroupNonPrimary)) {
@@ -1559,7 +1595,7 @@ bool SQLPTRepresentation::SaveAppGroupNonPrimary(
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveRemoteControlDenied(const std::string& app_id,
@@ -1582,6 +1618,7 @@ bool SQLPTRepresentation::SaveRemoteControlDenied(const std::string& app_id,
 
 bool SQLPTRepresentation::SaveModuleType(const std::string& app_id,
                                          const policy_table::ModuleTypes& types) {
+  dbms::ScopedTransaction transaction(db());
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kInsertModuleType)) {
     LOG4CXX_WARN(logger_, "Incorrect insert statement for module type");
@@ -1601,11 +1638,12 @@ bool SQLPTRepresentation::SaveModuleType(const std::string& app_id,
     }
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::SaveEquipment(
     const policy_table::Equipment& equipment) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_AUTO_TRACE(logger_);
   LOG4CXX_DEBUG(logger_, "PRELOADED: " << equipment.ToJsonValue().toStyledString());
   dbms::SQLQuery is_empty(db());
@@ -1664,7 +1702,7 @@ bool SQLPTRepresentation::SaveEquipment(
       return false;
     }
   }
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::GatherEquipment(
@@ -1697,6 +1735,7 @@ bool SQLPTRepresentation::GatherEquipment(
 bool SQLPTRepresentation::SaveAccessModule(
     int zone_id, TypeAccess access,
     const policy_table::AccessModules& modules) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_AUTO_TRACE(logger_);
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kInsertAccessModule)) {
@@ -1724,7 +1763,7 @@ bool SQLPTRepresentation::SaveAccessModule(
       return false;
     }
   }
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::GatherAccessModule(
@@ -1753,6 +1792,7 @@ bool SQLPTRepresentation::GatherAccessModule(
 
 bool SQLPTRepresentation::SaveRemoteRpc(
     int module_id, const policy_table::RemoteRpcs& rpcs) {
+  dbms::ScopedTransaction transaction(db());
   LOG4CXX_AUTO_TRACE(logger_);
   dbms::SQLQuery query(db());
   if (!query.Prepare(sql_pt::kInsertRemoteRpc)) {
@@ -1785,7 +1825,7 @@ bool SQLPTRepresentation::SaveRemoteRpc(
       }
     }
   }
-  return true;
+  return transaction.Commit();
 }
 
 bool SQLPTRepresentation::GatherRemoteRpc(
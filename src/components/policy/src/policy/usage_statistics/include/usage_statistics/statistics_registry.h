@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_POLICY_INCLUDE_POLICY_USAGE_STATISTICS_STATISTICS_REGISTRY_H_
+#define SRC_COMPONENTS_POLICY_INCLUDE_POLICY_USAGE_STATISTICS_STATISTICS_REGISTRY_H_
+
+#include <stdint.h>
+#include <map>
+#include <set>
+#include <string>
+
+#include "usage_statistics/statistics_manager.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace usage_statistics {
+
+/*
+ * Keeps usage statistics in memory, so counting is not a storage operation.
+ * Global counters are bumped atomically, application statistics are
+ * guarded by a lock. Owner decides when changed statistics are stored.
+ */
+class StatisticsRegistry : public StatisticsManager {
+ public:
+  StatisticsRegistry();
+
+  virtual void Increment(GlobalCounterId type);
+  virtual void Increment(const std::string& app_id, AppCounterId type);
+  virtual void Set(const std::string& app_id, AppInfoId type,
+                   const std::string& value);
+  virtual void Add(const std::string& app_id,
+                   AppStopwatchId type,
+                   int32_t timespan_seconds);
+
+  uint32_t GlobalCount(GlobalCounterId type) const;
+  uint32_t AppCount(const std::string& app_id, AppCounterId type) const;
+  std::string AppInformation(const std::string& app_id, AppInfoId type) const;
+  int32_t AppStopwatchSeconds(const std::string& app_id,
+                              AppStopwatchId type) const;
+
+  /**
+   * @brief Gives out applications, which statistics were changed since
+   * previous call
+   * @param app_ids ids of applications are added here
+   * @return true if any statistics, including global ones, were changed
+   */
+  bool TakeChanges(std::set<std::string>* app_ids);
+
+ private:
+  static const size_t kGlobalCountersCount = SYNC_REBOOTS + 1;
+  static const size_t kAppCountersCount = RUN_ATTEMPTS_WHILE_REVOKED + 1;
+  static const size_t kAppInfosCount = LANGUAGE_VUI + 1;
+  static const size_t kAppStopwatchesCount = SECONDS_HMI_NONE + 1;
+
+  struct AppStatistics {
+    AppStatistics();
+    uint32_t counters[kAppCountersCount];
+    std::string infos[kAppInfosCount];
+    int32_t stopwatches[kAppStopwatchesCount];
+  };
+  typedef std::map<std::string, AppStatistics> AppsStatistics;
+
+  AppStatistics& ChangedApp(const std::string& app_id);
+
+  volatile uint32_t global_counters_[kGlobalCountersCount];
+  volatile uint32_t global_counters_changed_;
+
+  AppsStatistics apps_statistics_;
+  std::set<std::string> changed_apps_;
+  mutable sync_primitives::Lock apps_statistics_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(StatisticsRegistry);
+};
+
+}  //  namespace usage_statistics
+
+#endif  //  SRC_COMPONENTS_POLICY_INCLUDE_POLICY_USAGE_STATISTICS_STATISTICS_REGISTRY_H_
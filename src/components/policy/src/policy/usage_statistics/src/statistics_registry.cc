@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "usage_statistics/statistics_registry.h"
+
+#include <algorithm>
+
+#include "utils/atomic.h"
+
+namespace usage_statistics {
+
+StatisticsRegistry::AppStatistics::AppStatistics() {
+  std::fill(counters, counters + kAppCountersCount, 0);
+  std::fill(stopwatches, stopwatches + kAppStopwatchesCount, 0);
+}
+
+StatisticsRegistry::StatisticsRegistry()
+    : global_counters_changed_(0) {
+  std::fill(global_counters_, global_counters_ + kGlobalCountersCount, 0);
+}
+
+void StatisticsRegistry::Increment(GlobalCounterId type) {
+  DCHECK(static_cast<size_t>(type) < kGlobalCountersCount);
+  atomic_post_inc(&global_counters_[type]);
+  atomic_post_set(&global_counters_changed_);
+}
+
+void StatisticsRegistry::Increment(const std::string& app_id,
+                                   AppCounterId type) {
+  DCHECK(static_cast<size_t>(type) < kAppCountersCount);
+  sync_primitives::AutoLock lock(apps_statistics_lock_);
+  ++ChangedApp(app_id).counters[type];
+}
+
+void StatisticsRegistry::Set(const std::string& app_id, AppInfoId type,
+                             const std::string& value) {
+  DCHECK(static_cast<size_t>(type) < kAppInfosCount);
+  sync_primitives::AutoLock lock(apps_statistics_lock_);
+  ChangedApp(app_id).infos[type] = value;
+}
+
+void StatisticsRegistry::Add(const std::string& app_id,
+                             AppStopwatchId type,
+                             int32_t timespan_seconds) {
+  DCHECK(static_cast<size_t>(type) < kAppStopwatchesCount);
+  sync_primitives::AutoLock lock(apps_statistics_lock_);
+  ChangedApp(app_id).stopwatches[type] += timespan_seconds;
+}
+
+uint32_t StatisticsRegistry::GlobalCount(GlobalCounterId type) const {
+  DCHECK(static_cast<size_t>(type) < kGlobalCountersCount);
+  return global_counters_[type];
+}
+
+uint32_t StatisticsRegistry::AppCount(const std::string& app_id,
+                                      AppCounterId type) const {
+  DCHECK(static_cast<size_t>(type) < kAppCountersCount);
+  sync_primitives::AutoLock lock(apps_statistics_lock_);
+  AppsStatistics::const_iterator it = apps_statistics_.find(app_id);
+  return apps_statistics_.end() == it ? 0 : it->second.counters[type];
+}
+
+std::string StatisticsRegistry::AppInformation(const std::string& app_id,
+                                               AppInfoId type) const {
+  DCHECK(static_cast<size_t>(type) < kAppInfosCount);
+  sync_primitives::AutoLock lock(apps_statistics_lock_);
+  AppsStatistics::const_iterator it = apps_statistics_.find(app_id);
+  return apps_statistics_.end() == it ? std::string() : it->second.infos[type];
+}
+
+int32_t StatisticsRegistry::AppStopwatchSeconds(const std::string& app_id,
+                                                AppStopwatchId type) const {
+  DCHECK(static_cast<size_t>(type) < kAppStopwatchesCount);
+  sync_primitives::AutoLock lock(apps_statistics_lock_);
+  AppsStatistics::const_iterator it = apps_statistics_.find(app_id);
+  return apps_statistics_.end() == it ? 0 : it->second.stopwatches[type];
+}
+
+bool StatisticsRegistry::TakeChanges(std::set<std::string>* app_ids) {
+  DCHECK(app_ids);
+  const bool global_changed = atomic_post_clr(&global_counters_changed_);
+  sync_primitives::AutoLock lock(apps_statistics_lock_);
+  if (changed_apps_.empty()) {
+    return global_changed;
+  }
+  app_ids->insert(changed_apps_.begin(), changed_apps_.end());
+  changed_apps_.clear();
+  return true;
+}
+
+StatisticsRegistry::AppStatistics& StatisticsRegistry::ChangedApp(
+    const std::string& app_id) {
+  changed_apps_.insert(app_id);
+  return apps_statistics_[app_id];
+}
+
+}  //  namespace usage_statistics
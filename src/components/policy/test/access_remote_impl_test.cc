@@ -162,6 +162,7 @@ TEST(AccessRemoteImplTest, CheckManual) {
 TEST(AccessRemoteImplTest, CheckModuleType) {
   AccessRemoteImpl access_remote;
   access_remote.cache_->pt_ = new policy_table::Table();
+  access_remote.cache_->PublishTable();
 
   // No application
   EXPECT_FALSE(access_remote.CheckModuleType("1234", policy_table::MT_RADIO));
@@ -170,16 +171,19 @@ TEST(AccessRemoteImplTest, CheckModuleType) {
   policy_table::ApplicationPolicies& apps = access_remote.cache_->pt_
       ->policy_table.app_policies;
   apps["1234"];
+  access_remote.cache_->PublishTable();
   EXPECT_FALSE(access_remote.CheckModuleType("1234", policy_table::MT_RADIO));
 
   // Empty modules
   policy_table::ModuleTypes& modules = *apps["1234"].moduleType;
   modules.mark_initialized();
+  access_remote.cache_->PublishTable();
   EXPECT_TRUE(access_remote.CheckModuleType("1234", policy_table::MT_RADIO));
   EXPECT_TRUE(access_remote.CheckModuleType("1234", policy_table::MT_CLIMATE));
 
   // Specific modules
   modules.push_back(policy_table::MT_RADIO);
+  access_remote.cache_->PublishTable();
   EXPECT_TRUE(access_remote.CheckModuleType("1234", policy_table::MT_RADIO));
   EXPECT_FALSE(access_remote.CheckModuleType("1234", policy_table::MT_CLIMATE));
 }
@@ -298,6 +302,7 @@ TEST(AccessRemoteImplTest, CheckParameters) {
   zones["Block B"].driver_allow["CLIMATE"]["Rpc 3"].push_back("param 1");
   zones["Block B"].driver_allow["CLIMATE"]["Rpc 3"].push_back("param 2");
   zones["Block B"].driver_allow["RADIO"]["Rpc 5"].push_back("param 2");
+  access_remote.cache_->PublishTable();
 
   // No zone
   SeatLocation no_zone = { 2, 2, 2 };
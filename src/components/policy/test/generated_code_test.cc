@@ -69,6 +69,22 @@ TEST(PolicyGeneratedCodeTest, DISABLED_TestValidPTUpdateJsonIsValid) {
   ASSERT_RPCTYPE_VALID(table);
 }
 
+TEST(PolicyGeneratedCodeTest, WriteJson_PTUpdate_EqualsToJsonValue) {
+  std::ifstream json_file("valid_sdl_pt_update.json");
+  ASSERT_TRUE(json_file.is_open());
+  Json::Value valid_table;
+  Json::Reader reader;
+  ASSERT_TRUE(reader.parse(json_file, valid_table));
+  Table table(&valid_table);
+
+  std::string written;
+  table.WriteJson(&written);
+
+  Json::Value written_table;
+  ASSERT_TRUE(reader.parse(written, written_table));
+  EXPECT_EQ(table.ToJsonValue(), written_table);
+}
+
 }  // namespace policy
 }  // namespace components
 }  // namespace test
@@ -95,6 +95,8 @@ class MockPTRepresentation : virtual public PTRepresentation {
       utils::SharedPtr<policy_table::Table>());
   MOCK_METHOD1(Save,
       bool(const policy_table::Table& table));
+  MOCK_METHOD2(SaveSections,
+      bool(const policy_table::Table& table, uint32_t sections));
   MOCK_CONST_METHOD0(UpdateRequired,
       bool());
   MOCK_METHOD1(SaveUpdateRequired,
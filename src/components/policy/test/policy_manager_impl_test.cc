@@ -84,6 +84,89 @@ class PolicyManagerImplTest : public ::testing::Test {
     delete listener;
   }
 
+  Json::Value CreatePTUpdate() {
+    Json::Value table(Json::objectValue);
+    table["policy_table"] = Json::Value(Json::objectValue);
+
+    Json::Value& policy_table = table["policy_table"];
+    policy_table["module_config"] = Json::Value(Json::objectValue);
+    policy_table["functional_groupings"] = Json::Value(Json::objectValue);
+    policy_table["consumer_friendly_messages"] = Json::Value(Json::objectValue);
+    policy_table["app_policies"] = Json::Value(Json::objectValue);
+
+    Json::Value& module_config = policy_table["module_config"];
+    module_config["preloaded_pt"] = Json::Value(true);
+    module_config["exchange_after_x_ignition_cycles"] = Json::Value(10);
+    module_config["exchange_after_x_kilometers"] = Json::Value(100);
+    module_config["exchange_after_x_days"] = Json::Value(5);
+    module_config["timeout_after_x_seconds"] = Json::Value(500);
+    module_config["seconds_between_retries"] = Json::Value(Json::arrayValue);
+    module_config["seconds_between_retries"][0] = Json::Value(10);
+    module_config["seconds_between_retries"][1] = Json::Value(20);
+    module_config["seconds_between_retries"][2] = Json::Value(30);
+    module_config["endpoints"] = Json::Value(Json::objectValue);
+    module_config["endpoints"]["0x00"] = Json::Value(Json::objectValue);
+    module_config["endpoints"]["0x00"]["default"] = Json::Value(Json::arrayValue);
+    module_config["endpoints"]["0x00"]["default"][0] = Json::Value(
+        "http://ford.com/cloud/default");
+    module_config["notifications_per_minute_by_priority"] = Json::Value(
+        Json::objectValue);
+    module_config["notifications_per_minute_by_priority"]["emergency"] =
+        Json::Value(1);
+    module_config["notifications_per_minute_by_priority"]["navigation"] =
+        Json::Value(2);
+    module_config["notifications_per_minute_by_priority"]["VOICECOMM"] =
+        Json::Value(3);
+    module_config["notifications_per_minute_by_priority"]["communication"] =
+        Json::Value(4);
+    module_config["notifications_per_minute_by_priority"]["normal"] = Json::Value(
+        5);
+    module_config["notifications_per_minute_by_priority"]["none"] = Json::Value(
+        6);
+    module_config["vehicle_make"] = Json::Value("MakeT");
+    module_config["vehicle_model"] = Json::Value("ModelT");
+    module_config["vehicle_year"] = Json::Value("2014");
+
+    Json::Value& functional_groupings = policy_table["functional_groupings"];
+    functional_groupings["default"] = Json::Value(Json::objectValue);
+    Json::Value& default_group = functional_groupings["default"];
+    default_group["rpcs"] = Json::Value(Json::objectValue);
+    default_group["rpcs"]["Update"] = Json::Value(Json::objectValue);
+    default_group["rpcs"]["Update"]["hmi_levels"] = Json::Value(Json::arrayValue);
+    default_group["rpcs"]["Update"]["hmi_levels"][0] = Json::Value("FULL");
+    default_group["rpcs"]["Update"]["parameters"] = Json::Value(Json::arrayValue);
+    default_group["rpcs"]["Update"]["parameters"][0] = Json::Value("speed");
+
+    Json::Value& consumer_friendly_messages =
+        policy_table["consumer_friendly_messages"];
+    consumer_friendly_messages["version"] = Json::Value("1.2");
+
+    Json::Value& app_policies = policy_table["app_policies"];
+    app_policies["default"] = Json::Value(Json::objectValue);
+    app_policies["default"]["memory_kb"] = Json::Value(50);
+    app_policies["default"]["heart_beat_timeout_ms"] = Json::Value(100);
+    app_policies["default"]["groups"] = Json::Value(Json::arrayValue);
+    app_policies["default"]["groups"][0] = Json::Value("default");
+    app_policies["default"]["priority"] = Json::Value("EMERGENCY");
+    app_policies["default"]["default_hmi"] = Json::Value("FULL");
+    app_policies["default"]["keep_context"] = Json::Value(true);
+    app_policies["default"]["steal_focus"] = Json::Value(true);
+    app_policies["default"]["certificate"] = Json::Value("sign");
+    app_policies["default"]["moduleType"] = Json::Value(Json::arrayValue);
+    app_policies["default"]["moduleType"][0] = Json::Value("RADIO");
+    app_policies["1234"] = Json::Value(Json::objectValue);
+    app_policies["1234"]["memory_kb"] = Json::Value(50);
+    app_policies["1234"]["heart_beat_timeout_ms"] = Json::Value(100);
+    app_policies["1234"]["groups"] = Json::Value(Json::arrayValue);
+    app_policies["1234"]["groups"][0] = Json::Value("default");
+    app_policies["1234"]["priority"] = Json::Value("EMERGENCY");
+    app_policies["1234"]["default_hmi"] = Json::Value("FULL");
+    app_policies["1234"]["keep_context"] = Json::Value(true);
+    app_policies["1234"]["steal_focus"] = Json::Value(true);
+    app_policies["1234"]["certificate"] = Json::Value("sign");
+    return table;
+  }
+
   ::testing::AssertionResult IsValid(const policy_table::Table& table) {
     if (table.is_valid()) {
       return ::testing::AssertionSuccess();
@@ -197,86 +280,7 @@ TEST_F(PolicyManagerImplTest, CheckPermissions_SetHmiLevelFullForAlert_ExpectAll
 TEST_F(PolicyManagerImplTest, LoadPT_SetPT_PTIsLoaded) {
 
   //arrange
-  Json::Value table(Json::objectValue);
-  table["policy_table"] = Json::Value(Json::objectValue);
-
-  Json::Value& policy_table = table["policy_table"];
-  policy_table["module_config"] = Json::Value(Json::objectValue);
-  policy_table["functional_groupings"] = Json::Value(Json::objectValue);
-  policy_table["consumer_friendly_messages"] = Json::Value(Json::objectValue);
-  policy_table["app_policies"] = Json::Value(Json::objectValue);
-
-  Json::Value& module_config = policy_table["module_config"];
-  module_config["preloaded_pt"] = Json::Value(true);
-  module_config["exchange_after_x_ignition_cycles"] = Json::Value(10);
-  module_config["exchange_after_x_kilometers"] = Json::Value(100);
-  module_config["exchange_after_x_days"] = Json::Value(5);
-  module_config["timeout_after_x_seconds"] = Json::Value(500);
-  module_config["seconds_between_retries"] = Json::Value(Json::arrayValue);
-  module_config["seconds_between_retries"][0] = Json::Value(10);
-  module_config["seconds_between_retries"][1] = Json::Value(20);
-  module_config["seconds_between_retries"][2] = Json::Value(30);
-  module_config["endpoints"] = Json::Value(Json::objectValue);
-  module_config["endpoints"]["0x00"] = Json::Value(Json::objectValue);
-  module_config["endpoints"]["0x00"]["default"] = Json::Value(Json::arrayValue);
-  module_config["endpoints"]["0x00"]["default"][0] = Json::Value(
-      "http://ford.com/cloud/default");
-  module_config["notifications_per_minute_by_priority"] = Json::Value(
-      Json::objectValue);
-  module_config["notifications_per_minute_by_priority"]["emergency"] =
-      Json::Value(1);
-  module_config["notifications_per_minute_by_priority"]["navigation"] =
-      Json::Value(2);
-  module_config["notifications_per_minute_by_priority"]["VOICECOMM"] =
-      Json::Value(3);
-  module_config["notifications_per_minute_by_priority"]["communication"] =
-      Json::Value(4);
-  module_config["notifications_per_minute_by_priority"]["normal"] = Json::Value(
-      5);
-  module_config["notifications_per_minute_by_priority"]["none"] = Json::Value(
-      6);
-  module_config["vehicle_make"] = Json::Value("MakeT");
-  module_config["vehicle_model"] = Json::Value("ModelT");
-  module_config["vehicle_year"] = Json::Value("2014");
-
-  Json::Value& functional_groupings = policy_table["functional_groupings"];
-  functional_groupings["default"] = Json::Value(Json::objectValue);
-  Json::Value& default_group = functional_groupings["default"];
-  default_group["rpcs"] = Json::Value(Json::objectValue);
-  default_group["rpcs"]["Update"] = Json::Value(Json::objectValue);
-  default_group["rpcs"]["Update"]["hmi_levels"] = Json::Value(Json::arrayValue);
-  default_group["rpcs"]["Update"]["hmi_levels"][0] = Json::Value("FULL");
-  default_group["rpcs"]["Update"]["parameters"] = Json::Value(Json::arrayValue);
-  default_group["rpcs"]["Update"]["parameters"][0] = Json::Value("speed");
-
-  Json::Value& consumer_friendly_messages =
-      policy_table["consumer_friendly_messages"];
-  consumer_friendly_messages["version"] = Json::Value("1.2");
-
-  Json::Value& app_policies = policy_table["app_policies"];
-  app_policies["default"] = Json::Value(Json::objectValue);
-  app_policies["default"]["memory_kb"] = Json::Value(50);
-  app_policies["default"]["heart_beat_timeout_ms"] = Json::Value(100);
-  app_policies["default"]["groups"] = Json::Value(Json::arrayValue);
-  app_policies["default"]["groups"][0] = Json::Value("default");
-  app_policies["default"]["priority"] = Json::Value("EMERGENCY");
-  app_policies["default"]["default_hmi"] = Json::Value("FULL");
-  app_policies["default"]["keep_context"] = Json::Value(true);
-  app_policies["default"]["steal_focus"] = Json::Value(true);
-  app_policies["default"]["certificate"] = Json::Value("sign");
-  app_policies["default"]["moduleType"] = Json::Value(Json::arrayValue);
-  app_policies["default"]["moduleType"][0] = Json::Value("RADIO");
-  app_policies["1234"] = Json::Value(Json::objectValue);
-  app_policies["1234"]["memory_kb"] = Json::Value(50);
-  app_policies["1234"]["heart_beat_timeout_ms"] = Json::Value(100);
-  app_policies["1234"]["groups"] = Json::Value(Json::arrayValue);
-  app_policies["1234"]["groups"][0] = Json::Value("default");
-  app_policies["1234"]["priority"] = Json::Value("EMERGENCY");
-  app_policies["1234"]["default_hmi"] = Json::Value("FULL");
-  app_policies["1234"]["keep_context"] = Json::Value(true);
-  app_policies["1234"]["steal_focus"] = Json::Value(true);
-  app_policies["1234"]["certificate"] = Json::Value("sign");
-
+  Json::Value table = CreatePTUpdate();
   policy_table::Table update(&table);
   update.SetPolicyTableType(rpc::policy_table_interface_base::PT_UPDATE);
 
@@ -299,7 +303,50 @@ TEST_F(PolicyManagerImplTest, LoadPT_SetPT_PTIsLoaded) {
   EXPECT_CALL(*listener, OnUpdateHMIAppType(hmi_types));
   EXPECT_CALL(*cache_manager, GenerateSnapshot()).WillOnce(Return(snapshot));
   EXPECT_CALL(*cache_manager, ApplyUpdate(_)).WillOnce(Return(true));
+  EXPECT_CALL(*listener, OnPTUpdated());
+  EXPECT_CALL(*listener, OnPermissionsChangesStarted());
+  EXPECT_CALL(*listener, OnPermissionsChangesFinished());
+  EXPECT_CALL(*listener, GetAppName("1234")).WillOnce(Return(""));
+  EXPECT_CALL(*listener, OnUpdateStatusChanged(_));
+  EXPECT_CALL(*cache_manager, SaveUpdateRequired(false));
+  EXPECT_CALL(*cache_manager, TimeoutResponse());
+  EXPECT_CALL(*cache_manager, SecondsBetweenRetries(_));
+#ifdef SDL_REMOTE_CONTROL
+  EXPECT_CALL(*access_remote, Init());
+#endif  // SDL_REMOTE_CONTROL
+
+  EXPECT_TRUE(manager->LoadPT("file_pt_update.json", msg));
+}
+
+TEST_F(PolicyManagerImplTest, LoadPT_ChangedGroupRpcs_AppIsNotified) {
+
+  //arrange
+  Json::Value table = CreatePTUpdate();
+  policy_table::Table update(&table);
+  update.SetPolicyTableType(rpc::policy_table_interface_base::PT_UPDATE);
+  ASSERT_TRUE(IsValid(update));
+
+  std::string json = table.toStyledString();
+  ::policy::BinaryMessage msg(json.begin(), json.end());
+
+  // Same groups are assigned to application, but "default" group had
+  // other hmi levels before update
+  Json::Value& current_levels = table["policy_table"]["functional_groupings"]
+      ["default"]["rpcs"]["Update"]["hmi_levels"];
+  current_levels[0] = Json::Value("BACKGROUND");
+  policy_table::Table current(&table);
+  utils::SharedPtr<policy_table::Table> snapshot = new policy_table::Table(
+      current.policy_table);
+
+  //assert
+  EXPECT_CALL(*cache_manager, GenerateSnapshot()).WillOnce(Return(snapshot));
+  EXPECT_CALL(*cache_manager, ApplyUpdate(_)).WillOnce(Return(true));
+  EXPECT_CALL(*listener, OnPTUpdated());
+  EXPECT_CALL(*listener, OnPermissionsChangesStarted());
+  EXPECT_CALL(*listener, OnPermissionsChangesFinished());
   EXPECT_CALL(*listener, GetAppName("1234")).WillOnce(Return(""));
+  EXPECT_CALL(*listener, OnCurrentDeviceIdUpdateRequired("1234"))
+      .WillOnce(Return(""));
   EXPECT_CALL(*listener, OnUpdateStatusChanged(_));
   EXPECT_CALL(*cache_manager, SaveUpdateRequired(false));
   EXPECT_CALL(*cache_manager, TimeoutResponse());
@@ -308,6 +355,7 @@ TEST_F(PolicyManagerImplTest, LoadPT_SetPT_PTIsLoaded) {
   EXPECT_CALL(*access_remote, Init());
 #endif  // SDL_REMOTE_CONTROL
 
+  //act
   EXPECT_TRUE(manager->LoadPT("file_pt_update.json", msg));
 }
 
@@ -35,6 +35,7 @@
 
 using ::policy::dbms::SQLError;
 using ::policy::dbms::SQLDatabase;
+using ::policy::dbms::ScopedTransaction;
 
 namespace test {
 namespace components {
@@ -223,6 +224,49 @@ TEST(SQLDatabaseTest, IsReadWrite_FirstOpenDBIsRWSecondIsNot) {
   remove("test-database.sqlite");
 }
 
+TEST(SQLDatabaseTest, ScopedTransaction_NotCommitted_ExpectRolledBack) {
+
+  //arrange
+  SQLDatabase db;
+  ASSERT_TRUE(db.Open());
+  EXPECT_FALSE(db.IsInTransaction());
+
+  //act
+  {
+    ScopedTransaction transaction(&db);
+
+    //assert
+    EXPECT_TRUE(db.IsInTransaction());
+  }
+
+  //assert
+  EXPECT_FALSE(db.IsInTransaction());
+  EXPECT_FALSE(IsError(db.LastError()));
+
+  db.Close();
+}
+
+TEST(SQLDatabaseTest, ScopedTransaction_Nested_ExpectOuterOwnsTransaction) {
+
+  //arrange
+  SQLDatabase db;
+  ASSERT_TRUE(db.Open());
+  ScopedTransaction outer(&db);
+
+  //act
+  {
+    ScopedTransaction inner(&db);
+    EXPECT_TRUE(inner.Commit());
+  }
+
+  //assert
+  EXPECT_TRUE(db.IsInTransaction());
+  EXPECT_TRUE(outer.Commit());
+  EXPECT_FALSE(db.IsInTransaction());
+
+  db.Close();
+}
+
 }  // namespace dbms
 }  // namespace policy
 }  // namespace components
@@ -369,6 +369,62 @@ TEST_F(SQLQueryTest, DoublePrepare_TwicePrepareQuery_ActWithoutErrors) {
   EXPECT_FALSE(IsError(query.LastError()));
 }
 
+TEST_F(SQLQueryTest, PrepareCached_SameQueryAfterFinalize_ExpectBindingsCleared) {
+
+  //arrange
+  const std::string kInsert("INSERT INTO testTable (`integerValue`, "
+                            "`stringValue`) VALUES (?, ?)");
+  SQLDatabase db(kDatabaseName);
+  ASSERT_TRUE(db.Open());
+
+  //act
+  {
+    SQLQuery query(&db);
+    ASSERT_TRUE(query.Prepare(kInsert));
+    query.Bind(0, 1);
+    query.Bind(1, std::string("one"));
+    EXPECT_TRUE(query.Exec());
+  }
+  SQLQuery query(&db);
+  ASSERT_TRUE(query.Prepare(kInsert));
+  query.Bind(0, 2);
+  EXPECT_TRUE(query.Exec());
+
+  //assert
+  SQLQuery select(&db);
+  ASSERT_TRUE(select.Prepare("SELECT `stringValue` FROM testTable"
+                             " WHERE `integerValue` = 2"));
+  ASSERT_TRUE(select.Next());
+  EXPECT_TRUE(select.IsNull(0));
+}
+
+TEST_F(SQLQueryTest, PrepareCached_SameQueryTwiceAtOnce_ExpectIndependentResults) {
+
+  //arrange
+  const char* insert = "INSERT INTO testTable (integerValue) "
+      "VALUES (1), (2);";
+  ASSERT_EQ(SQLITE_OK, sqlite3_exec(conn, insert, NULL, NULL, NULL));
+  const std::string kSelect("SELECT integerValue FROM testTable"
+                            " ORDER BY integerValue");
+  SQLDatabase db(kDatabaseName);
+  ASSERT_TRUE(db.Open());
+
+  //act
+  SQLQuery first(&db);
+  SQLQuery second(&db);
+  ASSERT_TRUE(first.Prepare(kSelect));
+  ASSERT_TRUE(first.Next());
+  ASSERT_TRUE(second.Prepare(kSelect));
+  ASSERT_TRUE(second.Next());
+
+  //assert
+  EXPECT_EQ(1, first.GetInteger(0));
+  EXPECT_EQ(1, second.GetInteger(0));
+  ASSERT_TRUE(first.Next());
+  EXPECT_EQ(2, first.GetInteger(0));
+  EXPECT_EQ(1, second.GetInteger(0));
+}
+
 }  // namespace dbms
 }  // namespace policy
 }  // namespace components
@@ -32,6 +32,7 @@
 
 #include "mock_statistics_manager.h"
 #include "usage_statistics/counter.h"
+#include "usage_statistics/statistics_registry.h"
 
 using ::testing::StrictMock;
 using ::testing::InSequence;
@@ -192,5 +193,56 @@ TEST(StatisticsManagerAddMethod, DISABLED_AppStopwatchSwitchMethod_CallAnd1SecSl
   hmi_full_stopwatch.Switch(SECONDS_HMI_BACKGROUND);
   sleep(2);
 }
+
+TEST(StatisticsRegistry, Counters_IncrementedSeveralTimes_SumIsKept) {
+  //Arrange
+  StatisticsRegistry registry;
+
+  //Act
+  registry.Increment(SYNC_REBOOTS);
+  registry.Increment(SYNC_REBOOTS);
+  registry.Increment("HelloApp", REJECTED_RPC_CALLS);
+  registry.Increment("HelloApp", REJECTED_RPC_CALLS);
+  registry.Increment("HelloApp", USER_SELECTIONS);
+  registry.Set("HelloApp", LANGUAGE_GUI, "EN-US");
+  registry.Add("HelloApp", SECONDS_HMI_FULL, 10);
+  registry.Add("HelloApp", SECONDS_HMI_FULL, 5);
+
+  //Assert
+  EXPECT_EQ(2u, registry.GlobalCount(SYNC_REBOOTS));
+  EXPECT_EQ(0u, registry.GlobalCount(IAP_BUFFER_FULL));
+  EXPECT_EQ(2u, registry.AppCount("HelloApp", REJECTED_RPC_CALLS));
+  EXPECT_EQ(1u, registry.AppCount("HelloApp", USER_SELECTIONS));
+  EXPECT_EQ(0u, registry.AppCount("OtherApp", USER_SELECTIONS));
+  EXPECT_EQ("EN-US", registry.AppInformation("HelloApp", LANGUAGE_GUI));
+  EXPECT_EQ(15, registry.AppStopwatchSeconds("HelloApp", SECONDS_HMI_FULL));
+}
+
+TEST(StatisticsRegistry, TakeChanges_ChangesTaken_NextCallReportsNothing) {
+  //Arrange
+  StatisticsRegistry registry;
+  std::set<std::string> app_ids;
+  EXPECT_FALSE(registry.TakeChanges(&app_ids));
+
+  //Act
+  registry.Increment("HelloApp", USER_SELECTIONS);
+  registry.Add("OtherApp", SECONDS_HMI_NONE, 1);
+
+  //Assert
+  EXPECT_TRUE(registry.TakeChanges(&app_ids));
+  EXPECT_EQ(2u, app_ids.size());
+  EXPECT_EQ(1u, app_ids.count("HelloApp"));
+  EXPECT_EQ(1u, app_ids.count("OtherApp"));
+
+  app_ids.clear();
+  EXPECT_FALSE(registry.TakeChanges(&app_ids));
+  EXPECT_TRUE(app_ids.empty());
+
+  registry.Increment(IAP_BUFFER_FULL);
+  EXPECT_TRUE(registry.TakeChanges(&app_ids));
+  EXPECT_TRUE(app_ids.empty());
+  // Collected values are kept after changes are taken
+  EXPECT_EQ(1u, registry.AppCount("HelloApp", USER_SELECTIONS));
+}
 }  // namespace test
 }  // namespace usage_statistics
@@ -32,7 +32,7 @@
 
 #include "protocol/raw_message.h"
 
-#include <memory.h>
+#include <string.h>
 
 namespace protocol_handler {
 
@@ -40,20 +40,50 @@ RawMessage::RawMessage(uint32_t connection_key, uint32_t protocol_version,
                        const uint8_t *const data_param, uint32_t data_sz,
                        uint8_t type, uint32_t payload_size)
   : connection_key_(connection_key),
-    data_(NULL),
+    data_(data_param, data_sz),
     data_size_(data_sz),
     protocol_version_(protocol_version),
     service_type_(ServiceTypeFromByte(type)),
     payload_size_(payload_size),
     waiting_(false) {
-  if (data_param && data_sz > 0) {
-    data_ = new uint8_t[data_sz];
-    memcpy(data_, data_param, sizeof(*data_) * data_sz);
-  }
+#ifdef TIME_TESTER
+  creation_time_ = date_time::DateTime::getPreciseMonotonicTime();
+#endif  // TIME_TESTER
+}
+
+RawMessage::RawMessage(uint32_t connection_key, uint32_t protocol_version,
+                       const utils::BufferSlice& data,
+                       uint8_t type, uint32_t payload_size)
+  : connection_key_(connection_key),
+    data_(data),
+    data_size_(data.size()),
+    protocol_version_(protocol_version),
+    service_type_(ServiceTypeFromByte(type)),
+    payload_size_(payload_size),
+    waiting_(false) {
+#ifdef TIME_TESTER
+  creation_time_ = date_time::DateTime::getPreciseMonotonicTime();
+#endif  // TIME_TESTER
+}
+
+RawMessage::RawMessage(uint32_t connection_key, uint32_t protocol_version,
+                       const utils::BufferSlice& header,
+                       const utils::BufferSlice& payload,
+                       uint8_t type)
+  : connection_key_(connection_key),
+    data_(header),
+    tail_(payload),
+    data_size_(header.size() + payload.size()),
+    protocol_version_(protocol_version),
+    service_type_(ServiceTypeFromByte(type)),
+    payload_size_(0),
+    waiting_(false) {
+#ifdef TIME_TESTER
+  creation_time_ = date_time::DateTime::getPreciseMonotonicTime();
+#endif  // TIME_TESTER
 }
 
 RawMessage::~RawMessage() {
-  delete[] data_;
 }
 
 uint32_t RawMessage::connection_key() const {
@@ -65,9 +95,38 @@ void RawMessage::set_connection_key(uint32_t key) {
 }
 
 uint8_t *RawMessage::data() const {
+  MergeFragments();
+  return data_.data();
+}
+
+const utils::BufferSlice& RawMessage::buffer() const {
+  MergeFragments();
   return data_;
 }
 
+size_t RawMessage::fragments_count() const {
+  return tail_.empty() ? 1 : 2;
+}
+
+const utils::BufferSlice& RawMessage::fragment(size_t index) const {
+  DCHECK(index < fragments_count());
+  return 0 == index ? data_ : tail_;
+}
+
+void RawMessage::MergeFragments() const {
+  if (tail_.empty()) {
+    return;
+  }
+  utils::BufferSlice merged(data_size_);
+  if (merged.empty()) {
+    return;
+  }
+  memcpy(merged.data(), data_.data(), data_.size());
+  memcpy(merged.data() + data_.size(), tail_.data(), tail_.size());
+  data_ = merged;
+  tail_ = utils::BufferSlice();
+}
+
 size_t RawMessage::payload_size() const {
   return payload_size_;
 }
@@ -36,6 +36,7 @@
 #include <map>
 #include <vector>
 #include "utils/macro.h"
+#include "utils/buffer_slice.h"
 #include "protocol_handler/protocol_packet.h"
 #include "transport_manager/common.h"
 
@@ -86,8 +87,12 @@ class IncomingDataHandler {
   static uint32_t GetPacketSize(const ProtocolPacket::ProtocolHeader &header);
   /**
    * @brief Try to create frame from incoming data
+   * Created frames reference their payload in incoming_data storage.
    * \param incommung_data raw stream
+   * \param processed_size count of bytes consumed from incoming_data
    * \param malformed_occurrence count of malformed messages occurrence
+   * \param correct_frame_occurs false while stream of malformed bytes lasts,
+   * so stream split between several calls is counted once
    * \param out_frames list for read frames
    *
    * \return operation RESULT_CODE
@@ -95,12 +100,36 @@ class IncomingDataHandler {
    *   - RESULT_OK - one or more frames successfully created
    *   - RESULT_FAIL - packet serialization or validation error occurs
    */
-  RESULT_CODE CreateFrame(std::vector<uint8_t> &incoming_data,
+  RESULT_CODE CreateFrame(const utils::BufferSlice &incoming_data,
+                          size_t *processed_size,
                           std::list<ProtocolFramePtr> &out_frames,
                           size_t &malformed_occurrence,
+                          bool *correct_frame_occurs,
                           const transport_manager::ConnectionUID connection_id);
 
-  typedef std::map<transport_manager::ConnectionUID, std::vector<uint8_t> >
+  /**
+   * @brief Bytes of incomplete frame waiting for the next portion of data.
+   * Storage is appended in place while no frame references it.
+   */
+  struct PendingData {
+    PendingData() : size(0) {}
+    utils::BufferSlice storage;
+    size_t size;
+  };
+  /**
+   * @brief Returns count of bytes pending frame lacks to be complete
+   * (or to have complete header if it is not received yet),
+   * 0 if it could not be determined because of malformed header.
+   */
+  size_t GetMissingFrameSize(const PendingData &pending);
+  /**
+   * @brief Appends bytes to pending data growing its storage if needed
+   * \return false if memory could not be allocated
+   */
+  static bool AppendPendingData(PendingData *pending,
+                                const uint8_t *data, size_t data_size);
+
+  typedef std::map<transport_manager::ConnectionUID, PendingData>
   ConnectionsDataMap;
   ConnectionsDataMap connections_data_;
   ProtocolPacket::ProtocolHeader header_;
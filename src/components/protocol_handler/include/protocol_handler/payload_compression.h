@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_PAYLOAD_COMPRESSION_H_
+#define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_PAYLOAD_COMPRESSION_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "utils/buffer_slice.h"
+
+namespace protocol_handler {
+/*
+ * Compression of RPC and bulk payloads of a service.
+ * Mobile side offers bitmask of supported methods in payload of
+ * StartService, SDL answers chosen method in the byte following hash id of
+ * StartServiceACK. Every payload of compressed service then starts with
+ * encoding byte, so small or incompressible payloads are sent as they are.
+ * Payloads are deflated independently with preset dictionary of common
+ * SDL RPC strings, so there is no compression state shared between messages
+ * and frames may be lost or reordered by transport without breaking stream.
+ */
+namespace compression {
+
+enum Method {
+  kMethodNone = 0x00,
+  kMethodDeflate = 0x01
+};
+
+enum Encoding {
+  kEncodingStored = 0x00,
+  kEncodingDeflated = 0x01
+};
+
+// Payloads smaller than this gain nothing from compression
+const size_t kMinimumCompressedSize = 128;
+// Limit of single inflated payload, protects from decompression bombs
+const size_t kMaximumInflatedSize = 16 * 1024 * 1024;
+
+/**
+ * \brief Encodes payload of compressed service
+ * \param data Payload bytes
+ * \param size Payload size
+ * \param level Deflate level from 1 (fastest) to 9 (smallest)
+ * \param out Encoding byte followed by deflated or original payload
+ * \return false if memory could not be allocated
+ */
+bool Compress(const uint8_t* data, size_t size, int level,
+              utils::BufferSlice* out);
+
+/**
+ * \brief Decodes payload of compressed service
+ * \param in Encoding byte followed by encoded payload
+ * \param max_size Maximum size of decoded payload
+ * \param out Decoded payload, stored payloads are not copied
+ * \return false if payload is malformed or exceeds max_size
+ */
+bool Decompress(const utils::BufferSlice& in, size_t max_size,
+                utils::BufferSlice* out);
+
+}  // namespace compression
+}  // namespace protocol_handler
+#endif  // SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_PAYLOAD_COMPRESSION_H_
@@ -33,13 +33,17 @@
 #ifndef SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_PROTOCOL_HANDLER_IMPL_H_
 #define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_PROTOCOL_HANDLER_IMPL_H_
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
 #include <list>
+#include <vector>
 #include "utils/prioritized_queue.h"
+#include "utils/deficit_round_robin_queue.h"
 #include "utils/message_queue.h"
 #include "utils/threads/message_loop_thread.h"
+#include "utils/threads/thread_pool.h"
 #include "utils/shared_ptr.h"
 #include "utils/messagemeter.h"
 
@@ -97,21 +101,72 @@ struct RawFordMessageFromMobile: public ProtocolFramePtr {
 struct RawFordMessageToMobile: public ProtocolFramePtr {
   explicit RawFordMessageToMobile(const ProtocolFramePtr message,
                                   bool final_message)
-    : ProtocolFramePtr(message), is_final(final_message) {}
-  // PrioritizedQueue requires this method to decide which priority to assign
-  size_t PriorityOrder() const {
-    return MessagePriority::FromServiceType(
-             ServiceTypeFromByte(get()->service_type())).OrderingValue();
+    : ProtocolFramePtr(message), is_final(final_message),
+      is_whole_message(false) {}
+  RawFordMessageToMobile(const ProtocolFramePtr message, bool final_message,
+                         bool whole_message)
+    : ProtocolFramePtr(message), is_final(final_message),
+      is_whole_message(whole_message) {}
+  // DeficitRoundRobinQueue requires following methods to schedule frames
+  // Control frames and RPC are never delayed by streaming
+  bool IsUrgent() const {
+    const ServiceType service_type = ServiceTypeFromByte(get()->service_type());
+    return FRAME_TYPE_CONTROL == get()->frame_type() ||
+           kControl == service_type || kRpc == service_type;
+  }
+  // Frames are shared fairly between services of every session
+  uint64_t FlowId() const {
+    return (static_cast<uint64_t>(get()->connection_id()) << 16) |
+           (static_cast<uint64_t>(get()->session_id()) << 8) |
+           get()->service_type();
+  }
+  size_t Cost() const {
+    return PROTOCOL_HEADER_V2_SIZE + get()->data_size();
   }
   // Signals whether connection to mobile must be closed after processing this message
   bool is_final;
+  // Frame holds whole message to be encrypted and split into frames
+  // right before sending
+  bool is_whole_message;
+};
+
+/*
+ * State of connection and its sessions kept in flat arrays indexed
+ * by session identifier, so frames are processed without tree lookups
+ */
+struct ConnectionContext {
+  static const size_t kSessionsCount = 256;
+  explicit ConnectionContext(ConnectionID id)
+    : connection_id(id),
+      maximum_frame_size(0) {
+    std::fill(message_counters, message_counters + kSessionsCount, 0u);
+    std::fill(last_message_ids, last_message_ids + kSessionsCount, 0u);
+    std::fill(last_message_pending, last_message_pending + kSessionsCount,
+              false);
+    std::fill(compression_offers, compression_offers + kSessionsCount, 0u);
+    std::fill(compressed_services, compressed_services + kSessionsCount, 0u);
+  }
+  ConnectionID connection_id;
+  // Maximum frame size preferred by transport, 0 if there is no preference
+  size_t maximum_frame_size;
+  // Counters of messages sent in each session, used as message identifiers
+  uint32_t message_counters[kSessionsCount];
+  // Identifiers of final messages of sessions, connection is closed
+  // after they are sent
+  uint32_t last_message_ids[kSessionsCount];
+  bool last_message_pending[kSessionsCount];
+  // Services of each session which mobile side offered to compress
+  // at their start and which payloads are compressed since they started,
+  // bits are defined by CompressionFlag() of protocol_handler_impl.cc
+  uint8_t compression_offers[kSessionsCount];
+  uint8_t compressed_services[kSessionsCount];
 };
 
 // Short type names for prioritized message queues
 typedef threads::MessageLoopThread <
   utils::PrioritizedQueue<RawFordMessageFromMobile> > FromMobileQueue;
 typedef threads::MessageLoopThread <
-  utils::PrioritizedQueue<RawFordMessageToMobile> > ToMobileQueue;
+  utils::DeficitRoundRobinQueue<RawFordMessageToMobile> > ToMobileQueue;
 }  // namespace impl
 
 /**
@@ -354,8 +409,7 @@ class ProtocolHandlerImpl
    * \param session_id ID of session through which message is to be sent.
    * \param protocol_version Version of Protocol used in message.
    * \param service_type Type of session, RPC or BULK Data
-   * \param data_size Size of message excluding protocol header
-   * \param data Message string
+   * \param data Message data excluding protocol header, referenced by frame
    * \param is_final_message if is_final_message = true - it is last message
    * \return \saRESULT_CODE Status of operation
    */
@@ -363,8 +417,7 @@ class ProtocolHandlerImpl
                                      const uint8_t session_id,
                                      const uint32_t protocol_version,
                                      const uint8_t service_type,
-                                     const size_t data_size,
-                                     const uint8_t *data,
+                                     const utils::BufferSlice &data,
                                      const bool is_final_message);
 
   /**
@@ -374,8 +427,8 @@ class ProtocolHandlerImpl
    * \param session_id ID of session through which message is to be sent.
    * \param protocol_version Version of Protocol used in message.
    * \param service_type Type of session, RPC or BULK Data
-   * \param data_size Size of message excluding protocol header
-   * \param data Message string
+   * \param data Message data excluding protocol header, frames reference
+   * its parts
    * \param max_data_size Maximum allowed size of single frame.
    * \param is_final_message if is_final_message = true - it is last message
    * \return \saRESULT_CODE Status of operation
@@ -384,11 +437,53 @@ class ProtocolHandlerImpl
                                     const uint8_t session_id,
                                     const uint8_t protocol_version,
                                     const uint8_t service_type,
-                                    const size_t data_size,
-                                    const uint8_t *data,
+                                    const utils::BufferSlice &data,
                                     const size_t max_frame_size,
                                     const bool is_final_message);
 
+  /**
+   * \brief Splits message data into first and consecutive frames.
+   * \param message_size Size of message announced by first frame
+   * \param protection Protection flag of consecutive frames
+   * \param frames Receives frames in sending order
+   */
+  void SplitToFrames(const ConnectionID connection_id,
+                     const uint8_t session_id,
+                     const uint8_t protocol_version,
+                     const uint8_t service_type,
+                     const uint32_t message_id,
+                     const utils::BufferSlice &data,
+                     const size_t message_size,
+                     const size_t max_frame_size,
+                     const bool protection,
+                     std::vector<ProtocolFramePtr> *frames);
+
+  /**
+   * \brief Maximum size of frame, including header, for connection
+   * Transport preference is used for protocol version 3 and higher,
+   * older versions are limited to MAXIMUM_FRAME_DATA_SIZE.
+   * \param connection_id Identifier of connection
+   * \param protocol_version Version of Protocol used in message.
+   */
+  size_t GetMaximumFrameSize(const ConnectionID connection_id,
+                             const uint32_t protocol_version);
+
+  /**
+   * \brief Context of connection, it is created on first use
+   * connection_contexts_lock_ shall be acquired by caller
+   * \param connection_id Identifier of connection
+   */
+  impl::ConnectionContext &GetConnectionContext(
+      const ConnectionID connection_id);
+
+  /**
+   * \brief Takes identifier for next message sent in session
+   * \param connection_id Identifier of connection
+   * \param session_id Identifier of session
+   */
+  uint32_t NextMessageId(const ConnectionID connection_id,
+                         const uint8_t session_id);
+
   /**
    * \brief Sends message already containing protocol header.
    * \param packet Message with protocol header
@@ -396,6 +491,11 @@ class ProtocolHandlerImpl
    */
   RESULT_CODE SendFrame(const ProtocolFramePtr packet);
 
+  /**
+   * \brief Sends frame as it is, without encryption
+   */
+  RESULT_CODE TransmitFrame(const ProtocolFramePtr packet);
+
   /**
    * \brief Handles received message.
    * \param connection_handle Identifier of connection through which message
@@ -429,6 +529,14 @@ class ProtocolHandlerImpl
     ConnectionID connection_id,
     const ProtocolFramePtr packet);
 
+  /**
+   * \brief Drops unfinished multiframe message and returns its storage
+   * to memory account of its session.
+   * Expects incomplete_multi_frame_messages_lock_ to be acquired.
+   */
+  void EraseMultiFrameMessage(
+    std::map<int32_t, ProtocolFramePtr>::iterator it);
+
   /**
    * \brief Handles message received in single frame.
    * \param connection_handle Identifier of connection through which message
@@ -452,8 +560,15 @@ class ProtocolHandlerImpl
     ConnectionID connection_id,
     const ProtocolPacket &packet);
 
+  /**
+   * \brief Queue frames of the connection are handled by, frames of
+   * one connection always go to the same queue to keep their order
+   */
+  impl::FromMobileQueue& FromMobileQueueFor(ConnectionID connection_id);
+
   // threads::MessageLoopThread<*>::Handler implementations
-  // CALLED ON raw_ford_messages_from_mobile_ thread!
+  // CALLED ON raw_ford_messages_from_mobile_ or one of
+  // from_mobile_shards_ threads!
   void Handle(const impl::RawFordMessageFromMobile message);
   // CALLED ON raw_ford_messages_to_mobile_ thread!
   void Handle(const impl::RawFordMessageToMobile message);
@@ -465,6 +580,38 @@ class ProtocolHandlerImpl
    */
   RESULT_CODE EncryptFrame(ProtocolFramePtr packet);
   RESULT_CODE DecryptFrame(ProtocolFramePtr packet);
+
+  /**
+   * \brief Encrypts whole message at once, so TLS produces full size
+   * records, and sends the records stream split into frames.
+   * First frame announcing message size is sent unprotected, as it is
+   * sent before records it describes.
+   * \param message frame holding whole message data
+   */
+  RESULT_CODE SendWholeEncryptedMessage(const ProtocolFramePtr message);
+
+  /**
+   * \brief Tells whether payloads of service are compressed
+   * \param connection_id Identifier of connection
+   * \param session_id Identifier of session
+   * \param service_type Type of service
+   */
+  bool IsCompressedService(const ConnectionID connection_id,
+                           const uint8_t session_id,
+                           const uint8_t service_type);
+
+  /**
+   * \brief Decodes payload of received message if its service is compressed
+   * \param connection_id Identifier of connection
+   * \param packet Frame holding whole message data
+   * \param payload Payload to be passed to observers
+   * \param payload_size Received data size of message
+   * \return false if payload could not be decoded
+   */
+  bool DecodePayload(const ConnectionID connection_id,
+                     const ProtocolPacket &packet,
+                     utils::BufferSlice *payload,
+                     uint32_t *payload_size);
 #endif  // ENABLE_SECURITY
 
   bool TrackMessage(const uint32_t &connection_key);
@@ -473,6 +620,23 @@ class ProtocolHandlerImpl
                              const size_t count);
 
  private:
+  /**
+   * \brief Decrypts frame if needed and passes it on for handling
+   * \param frame frame received from mobile
+   */
+  void ProcessFrame(const ProtocolFramePtr frame);
+
+#ifdef TIME_TESTER
+  /**
+   * \brief Starts trace of RPC if frame is single or first frame of RPC
+   * \param tm_message data the frame was parsed from
+   * \param begin time the data was taken from transport manager
+   */
+  void StartRpcTrace(const RawMessage &tm_message,
+                     const ProtocolFramePtr frame,
+                     const TimevalStruct &begin);
+#endif  // TIME_TESTER
+
   /**
    *\brief Pointer on instance of class implementing IProtocolObserver
    *\brief (JSON Handler)
@@ -494,34 +658,46 @@ class ProtocolHandlerImpl
    *\brief Map of frames for messages received in multiple frames.
    */
   std::map<int32_t, ProtocolFramePtr> incomplete_multi_frame_messages_;
+  // Media frames may be assembled on transport thread, see media_fast_lane_
+  sync_primitives::Lock incomplete_multi_frame_messages_lock_;
 
   /**
-   * \brief Map of messages (frames) received over mobile nave session
-   * for map streaming.
+   * \brief Audio and video frames are handled on transport thread
+   * instead of raw_ford_messages_from_mobile_ one
    */
-  MessagesOverNaviMap message_over_navi_session_;
+  const bool media_fast_lane_;
 
   /**
-   * \brief Untill specified otherwise, amount of message recievied
-   * over streaming session to send Ack
+   * \brief Protected messages are encrypted as a whole instead of frame
+   * by frame, see SendWholeEncryptedMessage
    */
-  const uint32_t kPeriodForNaviAck;
+  const bool encrypt_whole_messages_;
 
   /**
-   *\brief Counter of messages sent in each session.
-   * Used ad unique message identifier
+   * \brief Compression of RPC and bulk services is accepted when mobile
+   * side offers it, see payload_compression.h
+   */
+  const bool payload_compression_;
+  const int payload_compression_level_;
+
+  /**
+   * \brief Map of messages (frames) received over mobile nave session
+   * for map streaming.
    */
-  std::map<uint8_t, uint32_t> message_counters_;
+  MessagesOverNaviMap message_over_navi_session_;
 
   /**
-   *\brief Counter of messages sent in each session.
+   * \brief Untill specified otherwise, amount of message recievied
+   * over streaming session to send Ack
    */
-  std::map<ConnectionID, uint32_t> malformed_message_counters_;
+  const uint32_t kPeriodForNaviAck;
 
   /**
-   *\brief map for session last message.
+   *\brief Contexts of connections, there are only few connections
+   * so they are searched linearly
    */
-  std::map<uint8_t, uint32_t> sessions_last_message_id_;
+  std::vector<impl::ConnectionContext> connection_contexts_;
+  sync_primitives::Lock connection_contexts_lock_;
 
   /**
    *\brief Connections that must be closed after their last messages were sent
@@ -531,12 +707,14 @@ class ProtocolHandlerImpl
   ProtocolPacket::ProtocolHeaderValidator protocol_header_validator_;
   IncomingDataHandler incoming_data_handler_;
   // Use uint32_t as application identifier
-  utils::MessageMeter<uint32_t> message_meter_;
+  utils::BucketedMessageMeter<uint32_t> message_meter_;
+  // Messages are tracked on all from mobile threads
+  sync_primitives::Lock message_meter_lock_;
   size_t message_max_frequency_;
   size_t message_frequency_time_;
   bool malformed_message_filtering_;
   // Use uint32_t as connection identifier
-  utils::MessageMeter<uint32_t> malformed_message_meter_;
+  utils::BucketedMessageMeter<uint32_t> malformed_message_meter_;
   size_t malformed_message_max_frequency_;
   size_t malformed_message_frequency_time_;
 
@@ -544,8 +722,31 @@ class ProtocolHandlerImpl
   security_manager::SecurityManager *security_manager_;
 #endif  // ENABLE_SECURITY
 
+#ifdef ENABLE_SECURITY
+  /*
+   * Decrypts frames on decryption_pool_ and passes them
+   * to raw_ford_messages_from_mobile_ in the order they came
+   */
+  class FrameDecryptor : public impl::FromMobileQueue::Handler {
+   public:
+    explicit FrameDecryptor(ProtocolHandlerImpl *protocol_handler);
+    // CALLED ON decryption_pool_ thread!
+    virtual void Handle(const impl::RawFordMessageFromMobile message);
+   private:
+    ProtocolHandlerImpl &protocol_handler_;
+  };
+  FrameDecryptor frame_decryptor_;
+  // Shared with all decryption queues, NULL if parallel decryption is disabled
+  threads::ThreadPool *decryption_pool_;
+  // Session frames always go through the same queue
+  std::vector<impl::FromMobileQueue*> decryption_queues_;
+#endif  // ENABLE_SECURITY
+
   // Thread that pumps non-parsed messages coming from mobile side.
   impl::FromMobileQueue raw_ford_messages_from_mobile_;
+  // Additional threads sharing connections with
+  // raw_ford_messages_from_mobile_, empty if FromMobileThreads is 1
+  std::vector<impl::FromMobileQueue*> from_mobile_shards_;
   // Thread that pumps messages prepared to being sent to mobile side.
   impl::ToMobileQueue raw_ford_messages_to_mobile_;
 
@@ -34,6 +34,10 @@
 #define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_PROTOCOL_PACKET_H_
 
 #include "utils/macro.h"
+#include "utils/buffer_slice.h"
+#ifdef TIME_TESTER
+#include "utils/rpc_trace.h"
+#endif  // TIME_TESTER
 #include "protocol/common.h"
 #include "transport_manager/common.h"
 
@@ -57,8 +61,7 @@ class ProtocolPacket {
    */
   struct ProtocolData {
     ProtocolData();
-    ~ProtocolData();
-    uint8_t *data;
+    utils::BufferSlice data;
     uint32_t totalDataBytes;
   };
 
@@ -145,11 +148,13 @@ class ProtocolPacket {
   /**
    * \brief Appends message frame to existing message in
    * recieving multiframe messages.
+   * Storage for the whole message is allocated once by the first frame,
+   * every chunk is written right at its offset.
    * \param chunkData Current frame's message string
    * \param chunkDataSize Size of current message string
    * \return \saRESULT_CODE Status of serialization
    */
-  RESULT_CODE appendData(uint8_t *chunkData, uint32_t chunkDataSize);
+  RESULT_CODE appendData(const uint8_t *chunkData, uint32_t chunkDataSize);
 
   /**
    * \brief Getter of message size including protocol header
@@ -173,6 +178,15 @@ class ProtocolPacket {
   RESULT_CODE deserializePacket(const uint8_t *message,
                                 const size_t messageSize);
 
+  /**
+   * \brief Parses protocol header, message body is referenced
+   * in the storage of incoming message instead of being copied
+   * \param message Incoming message containing both header and
+   * message body
+   * \return \saRESULT_CODE Status of serialization
+   */
+  RESULT_CODE deserializePacket(const utils::BufferSlice &message);
+
   /**
    * \brief Getter of protocol version.
    */
@@ -223,6 +237,11 @@ class ProtocolPacket {
    */
   uint8_t *data() const;
 
+  /**
+   *\brief Getter of message body storage
+   */
+  const utils::BufferSlice &buffer() const;
+
   /**
    *\brief Setter for size of multiframe message
    */
@@ -234,6 +253,12 @@ class ProtocolPacket {
   void set_data(const uint8_t *const  new_data,
                 const size_t new_data_size);
 
+  /**
+   *\brief Setter for new data referencing shared storage without copying,
+   * empty slice leaves packet without data
+   */
+  void set_data(const utils::BufferSlice &new_data);
+
   /**
    *\brief Getter for size of multiframe message
    */
@@ -250,6 +275,18 @@ class ProtocolPacket {
     */
   uint32_t payload_size() const;
 
+#ifdef TIME_TESTER
+  /**
+   * \brief Trace of RPC started by this frame, empty for other frames
+   */
+  const utils::RpcTracePtr &trace() const {
+    return trace_;
+  }
+  void set_trace(const utils::RpcTracePtr &trace) {
+    trace_ = trace;
+  }
+#endif  // TIME_TESTER
+
  private:
   /**
    *\brief Protocol header
@@ -272,6 +309,10 @@ class ProtocolPacket {
     */
   ConnectionID connection_id_;
 
+#ifdef TIME_TESTER
+  utils::RpcTracePtr trace_;
+#endif  // TIME_TESTER
+
   DISALLOW_COPY_AND_ASSIGN(ProtocolPacket);
 };
 }  // namespace protocol_handler
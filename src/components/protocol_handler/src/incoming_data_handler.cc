@@ -30,6 +30,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include "protocol_handler/incoming_data_handler.h"
+#include <string.h>
+#include <algorithm>
 #include "utils/logger.h"
 #include "protocol/common.h"
 
@@ -72,15 +74,66 @@ std::list<ProtocolFramePtr> IncomingDataHandler::ProcessData(
     *result = RESULT_FAIL;
     return std::list<ProtocolFramePtr>();
   }
-  std::vector<uint8_t> &connection_data = it->second;
-  connection_data.insert(connection_data.end(), data, data + tm_message_size);
-  LOG4CXX_DEBUG(logger_, "Total data size for connection "
-                << connection_id << " is " << connection_data.size());
+  PendingData &pending = it->second;
   std::list<ProtocolFramePtr> out_frames;
   *malformed_occurrence = 0;
-  *result = CreateFrame(connection_data, out_frames, *malformed_occurrence, connection_id);
+  *result = RESULT_DEFERRED;
+  bool correct_frame_occurs = true;
+  size_t chunk_offset = 0;
+  // Frame straddling chunks boundary is completed in pending storage,
+  // only its own bytes are copied out of the new chunk
+  while (pending.size > 0 && chunk_offset < tm_message_size) {
+    const size_t missing_size = GetMissingFrameSize(pending);
+    const size_t rest_size = tm_message_size - chunk_offset;
+    const size_t append_size =
+        missing_size > 0 ? std::min(missing_size, rest_size) : rest_size;
+    if (!AppendPendingData(&pending, data + chunk_offset, append_size)) {
+      LOG4CXX_ERROR(logger_, "Failed to allocate memory for incoming data");
+      *result = RESULT_FAIL;
+      return out_frames;
+    }
+    chunk_offset += append_size;
+    if (GetMissingFrameSize(pending) > 0) {
+      // Frame is still incomplete, wait for the rest of it
+      continue;
+    }
+    const utils::BufferSlice pending_data =
+        pending.storage.Slice(0, pending.size);
+    size_t processed_size = 0;
+    *result = CreateFrame(pending_data, &processed_size, out_frames,
+                          *malformed_occurrence, &correct_frame_occurs,
+                          connection_id);
+    if (processed_size > 0) {
+      // Created frames may reference pending storage, it can't be reused
+      pending.storage = utils::BufferSlice();
+      pending.size = 0;
+      if (processed_size < pending_data.size() &&
+          !AppendPendingData(&pending, pending_data.data() + processed_size,
+                             pending_data.size() - processed_size)) {
+        LOG4CXX_ERROR(logger_, "Failed to allocate memory for incoming data");
+        *result = RESULT_FAIL;
+        return out_frames;
+      }
+    }
+  }
+  // The rest of frames are parsed right from the transport buffer
+  if (chunk_offset < tm_message_size) {
+    const utils::BufferSlice chunk =
+        tm_message.buffer().Slice(chunk_offset, tm_message_size - chunk_offset);
+    size_t processed_size = 0;
+    *result = CreateFrame(chunk, &processed_size, out_frames,
+                          *malformed_occurrence, &correct_frame_occurs,
+                          connection_id);
+    if (processed_size < chunk.size() &&
+        !AppendPendingData(&pending, chunk.data() + processed_size,
+                           chunk.size() - processed_size)) {
+      LOG4CXX_ERROR(logger_, "Failed to allocate memory for incoming data");
+      *result = RESULT_FAIL;
+      return out_frames;
+    }
+  }
   LOG4CXX_DEBUG(logger_, "New data size for connection " << connection_id
-                << " is " << connection_data.size());
+                << " is " << pending.size);
   if (!out_frames.empty()) {
     LOG4CXX_DEBUG(logger_, "Created and passed " << out_frames.size() <<
                   " packets");
@@ -129,30 +182,73 @@ uint32_t IncomingDataHandler::GetPacketSize(
   return 0u;
 }
 
+size_t IncomingDataHandler::GetMissingFrameSize(const PendingData &pending) {
+  if (pending.size < MIN_HEADER_SIZE) {
+    return MIN_HEADER_SIZE - pending.size;
+  }
+  header_.deserialize(pending.storage.data(), pending.size);
+  const size_t header_size = PROTOCOL_VERSION_1 == header_.version
+      ? PROTOCOL_HEADER_V1_SIZE : PROTOCOL_HEADER_V2_SIZE;
+  if (pending.size < header_size) {
+    return header_size - pending.size;
+  }
+  if (validator_ && validator_->validate(header_) != RESULT_OK) {
+    return 0u;
+  }
+  const uint32_t packet_size = GetPacketSize(header_);
+  return packet_size > pending.size ? packet_size - pending.size : 0u;
+}
+
+bool IncomingDataHandler::AppendPendingData(
+    PendingData *pending, const uint8_t *data, size_t data_size) {
+  DCHECK(pending);
+  const size_t required_size = pending->size + data_size;
+  if (pending->storage.size() < required_size) {
+    // Grow geometrically to keep appending of long frames linear
+    utils::BufferSlice storage(
+        std::max(required_size, pending->storage.size() * 2));
+    if (storage.empty()) {
+      return false;
+    }
+    if (pending->size > 0) {
+      memcpy(storage.data(), pending->storage.data(), pending->size);
+    }
+    pending->storage = storage;
+  }
+  memcpy(pending->storage.data() + pending->size, data, data_size);
+  pending->size = required_size;
+  return true;
+}
+
 RESULT_CODE IncomingDataHandler::CreateFrame(
-    std::vector<uint8_t> &incoming_data,
+    const utils::BufferSlice &incoming_data,
+    size_t *processed_size,
     std::list<ProtocolFramePtr> &out_frames,
     size_t &malformed_occurrence,
+    bool *correct_frame_occurs,
     const transport_manager::ConnectionUID connection_id) {
   LOG4CXX_AUTO_TRACE(logger_);
-  bool correct_frame_occurs = true;
-  std::vector<uint8_t>::iterator data_it = incoming_data.begin();
+  DCHECK(processed_size);
+  DCHECK(correct_frame_occurs);
+  const uint8_t *data_it = incoming_data.data();
   size_t data_size = incoming_data.size();
+  *processed_size = 0;
   while (data_size >= MIN_HEADER_SIZE) {
-    header_.deserialize(&*data_it, data_size);
+    header_.deserialize(data_it, data_size);
     const RESULT_CODE validate_result =
       validator_ ? validator_->validate(header_) : RESULT_OK;
 
     if (validate_result != RESULT_OK) {
       LOG4CXX_WARN(logger_, "Packet validation failed");
-      if(correct_frame_occurs) {
+      if (*correct_frame_occurs) {
         ++malformed_occurrence;
       }
-      correct_frame_occurs = false;
+      *correct_frame_occurs = false;
       ++data_it;
       --data_size;
+      ++*processed_size;
       LOG4CXX_DEBUG(logger_, "Moved to the next byte " << std::hex
-                    << static_cast<const void *>(&*data_it));
+                    << static_cast<const void *>(data_it));
       continue;
     }
     LOG4CXX_DEBUG(logger_, "Payload size " << header_.dataSize);
@@ -161,30 +257,29 @@ RESULT_CODE IncomingDataHandler::CreateFrame(
       LOG4CXX_WARN(logger_, "Null packet size");
       ++data_it;
       --data_size;
+      ++*processed_size;
       LOG4CXX_DEBUG(logger_, "Moved to the next byte " << std::hex
-                    << static_cast<const void *>(&*data_it));
+                    << static_cast<const void *>(data_it));
       continue;
     }
     if (data_size < packet_size) {
       LOG4CXX_DEBUG(logger_, "Packet data is not available yet");
-      incoming_data.erase(incoming_data.begin(), data_it);
       return RESULT_DEFERRED;
     }
     ProtocolFramePtr frame(new protocol_handler::ProtocolPacket(connection_id));
-    const RESULT_CODE deserialize_result =
-      frame->deserializePacket(&*data_it, packet_size);
+    const RESULT_CODE deserialize_result = frame->deserializePacket(
+        incoming_data.Slice(*processed_size, packet_size));
     if (deserialize_result != RESULT_OK) {
       LOG4CXX_WARN(logger_, "Packet deserialization failed");
-      incoming_data.erase(incoming_data.begin(), data_it);
       return RESULT_FAIL;
     }
     out_frames.push_back(frame);
-    correct_frame_occurs = true;
+    *correct_frame_occurs = true;
 
     data_it += packet_size;
     data_size -= packet_size;
+    *processed_size += packet_size;
   }
-  incoming_data.erase(incoming_data.begin(), data_it);
   return RESULT_OK;
 }
 }  // namespace protocol_handler
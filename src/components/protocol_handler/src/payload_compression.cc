@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "protocol_handler/payload_compression.h"
+
+#include <zlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "utils/logger.h"
+
+namespace protocol_handler {
+namespace compression {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "ProtocolHandler")
+
+namespace {
+/*
+ * Preset dictionary shared with mobile side, it shall never be changed
+ * without introducing new compression method.
+ * Deflate refers to the end of dictionary with the shortest distances,
+ * so the most frequent strings are placed last.
+ */
+const char kDictionary[] =
+    "\"policy_table\":{\"module_config\":{\"functional_groupings\":"
+    "\"app_policies\":\"consumer_friendly_messages\":\"device_data\":"
+    "\"usage_and_error_counts\":\"hmi_levels\":[\"BACKGROUND\",\"LIMITED\","
+    "\"user_consent_prompt\":\"certificate\":\"endpoints\":\"0x07\":"
+    "\"default\":\"pre_DataConsent\":\"seconds_between_retries\":"
+    "\"vehicleType\":{\"make\":\"\",\"model\":\"\",\"modelYear\":\"\","
+    "\"trim\":\"\"},\"supportedDiagModes\":[\"hmiCapabilities\":"
+    "{\"navigation\":true,\"phoneCall\":true},\"sdlVersion\":"
+    "\"systemSoftwareVersion\":\"audioPassThruCapabilities\":[{"
+    "\"samplingRate\":\"44KHZ\",\"bitsPerSample\":\"16_BIT\","
+    "\"audioType\":\"PCM\"}],\"hmiZoneCapabilities\":[\"FRONT\"],"
+    "\"speechCapabilities\":[\"TEXT\",\"SAPI_PHONEMES\",\"LHPLUS_PHONEMES\","
+    "\"PRE_RECORDED\",\"SILENCE\"],\"vrCapabilities\":[\"TEXT\"],"
+    "\"prerecordedSpeech\":[\"HELP_JINGLE\",\"INITIAL_JINGLE\","
+    "\"LISTEN_JINGLE\",\"POSITIVE_JINGLE\",\"NEGATIVE_JINGLE\"],"
+    "\"presetBankCapabilities\":{\"onScreenPresetsAvailable\":true},"
+    "\"softButtonCapabilities\":[{\"shortPressAvailable\":true,"
+    "\"longPressAvailable\":true,\"upDownAvailable\":true,"
+    "\"imageSupported\":true}],\"buttonCapabilities\":[{\"name\":\"OK\","
+    "\"SEEKLEFT\",\"SEEKRIGHT\",\"TUNEUP\",\"TUNEDOWN\",\"PRESET_0\","
+    "\"displayCapabilities\":{\"displayType\":\"GEN2_8_DMA\","
+    "\"textFields\":[{\"name\":\"mainField1\",\"characterSet\":"
+    "\"TYPE2SET\",\"width\":500,\"rows\":1},{\"name\":\"mainField2\","
+    "\"mediaClock\",\"mediaTrack\",\"alertText1\",\"alertText2\","
+    "\"scrollableMessageBody\",\"initialInteractionText\","
+    "\"imageFields\":[{\"name\":\"softButtonImage\",\"imageTypeSupported\":"
+    "[\"GRAPHIC_BMP\",\"GRAPHIC_JPEG\",\"GRAPHIC_PNG\"],\"imageResolution\":"
+    "{\"resolutionWidth\":64,\"resolutionHeight\":64}},{\"name\":"
+    "\"choiceImage\",\"menuIcon\",\"cmdIcon\",\"appIcon\",\"graphic\","
+    "\"mediaClockFormats\":[\"CLOCK1\",\"CLOCK2\",\"CLOCK3\","
+    "\"CLOCKTEXT1\",\"CLOCKTEXT2\",\"CLOCKTEXT3\",\"CLOCKTEXT4\"],"
+    "\"graphicSupported\":true,\"templatesAvailable\":[\"DEFAULT\","
+    "\"MEDIA\",\"NON-MEDIA\"],\"screenParams\":{\"resolution\":"
+    "\"touchEventAvailable\":{\"pressAvailable\":true,"
+    "\"multiTouchAvailable\":true,\"doublePressAvailable\":false}},"
+    "\"numCustomPresetsAvailable\":8},\"syncMsgVersion\":{\"majorVersion\":"
+    "4,\"minorVersion\":0},\"language\":\"EN-US\",\"hmiDisplayLanguage\":"
+    "\"languageDesired\":\"appHMIType\":[\"isMediaApplication\":false,"
+    "\"ngnMediaScreenAppName\":\"vrSynonyms\":[\"ttsName\":[{\"appName\":"
+    "\"appID\":\"deviceInfo\":{\"hardware\":\"firmwareRev\":\"os\":"
+    "\"Android\",\"osVersion\":\"carrier\":\"maxNumberRFCOMMPorts\":"
+    "\"interactionChoiceSetID\":\"choiceSet\":[{\"choiceID\":"
+    "\"secondaryText\":\"tertiaryText\":\"secondaryImage\":"
+    "\"menuParams\":{\"parentID\":0,\"position\":0,\"menuName\":\"\"},"
+    "\"cmdID\":\"vrCommands\":[\"\"],\"cmdIcon\":\"initialPrompt\":"
+    "\"helpPrompt\":\"timeoutPrompt\":\"vrHelp\":[{\"position\":1,"
+    "\"interactionMode\":\"MANUAL_ONLY\",\"BOTH\",\"VR_ONLY\","
+    "\"interactionLayout\":\"LIST_ONLY\",\"ICON_ONLY\",\"ICON_WITH_SEARCH\","
+    "\"requestType\":\"PROPRIETARY\",\"HTTP\",\"fileName\":\"fileType\":"
+    "\"BINARY\",\"JSON\",\"persistentFile\":false,\"systemFile\":false,"
+    "\"offset\":0,\"length\":\"spaceAvailable\":\"filenames\":["
+    "\"syncFileName\":\"softButtons\":[{\"type\":\"TEXT\",\"BOTH\","
+    "\"IMAGE\",\"softButtonID\":\"systemAction\":\"DEFAULT_ACTION\","
+    "\"isHighlighted\":false,\"ttsChunks\":[{\"text\":\"\",\"type\":"
+    "\"TEXT\"}],\"duration\":5000,\"playTone\":false,\"alertText1\":"
+    "\"image\":{\"value\":\"\",\"imageType\":\"DYNAMIC\",\"STATIC\"},"
+    "\"success\":true,\"resultCode\":\"SUCCESS\",\"info\":\"\"}";
+
+// Raw deflate stream, there is no place for zlib header in payload
+const int kWindowBits = -15;
+const int kMemoryLevel = 8;
+}  // namespace
+
+bool Compress(const uint8_t* data, size_t size, int level,
+              utils::BufferSlice* out) {
+  DCHECK_OR_RETURN(out, false);
+  if (size >= kMinimumCompressedSize) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (Z_OK != deflateInit2(&stream, level, Z_DEFLATED, kWindowBits,
+                             kMemoryLevel, Z_DEFAULT_STRATEGY)) {
+      LOG4CXX_ERROR(logger_, "Could not initialize deflate: " << stream.msg);
+      return false;
+    }
+    deflateSetDictionary(&stream,
+                         reinterpret_cast<const Bytef*>(kDictionary),
+                         sizeof(kDictionary) - 1);
+    // Payload is not worth sending deflated unless it becomes smaller
+    utils::BufferSlice deflated(size);
+    if (!deflated.empty()) {
+      deflated.data()[0] = kEncodingDeflated;
+      stream.next_in = const_cast<Bytef*>(data);
+      stream.avail_in = size;
+      stream.next_out = deflated.data() + 1;
+      stream.avail_out = size - 1;
+      const int result = deflate(&stream, Z_FINISH);
+      const size_t deflated_size = stream.total_out;
+      deflateEnd(&stream);
+      if (Z_STREAM_END == result) {
+        *out = deflated.Slice(0, 1 + deflated_size);
+        return true;
+      }
+    } else {
+      deflateEnd(&stream);
+    }
+  }
+  utils::BufferSlice stored(1 + size);
+  if (stored.empty()) {
+    LOG4CXX_ERROR(logger_, "Could not allocate " << 1 + size << " bytes");
+    return false;
+  }
+  stored.data()[0] = kEncodingStored;
+  if (size > 0) {
+    memcpy(stored.data() + 1, data, size);
+  }
+  *out = stored;
+  return true;
+}
+
+bool Decompress(const utils::BufferSlice& in, size_t max_size,
+                utils::BufferSlice* out) {
+  DCHECK_OR_RETURN(out, false);
+  if (in.empty()) {
+    LOG4CXX_WARN(logger_, "Payload of compressed service has no encoding");
+    return false;
+  }
+  const uint8_t encoding = in.data()[0];
+  if (kEncodingStored == encoding) {
+    if (in.size() - 1 > max_size) {
+      return false;
+    }
+    *out = in.Slice(1, in.size() - 1);
+    return true;
+  }
+  if (kEncodingDeflated != encoding) {
+    LOG4CXX_WARN(logger_, "Unknown payload encoding "
+                 << static_cast<int>(encoding));
+    return false;
+  }
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (Z_OK != inflateInit2(&stream, kWindowBits)) {
+    LOG4CXX_ERROR(logger_, "Could not initialize inflate: " << stream.msg);
+    return false;
+  }
+  inflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(kDictionary),
+                       sizeof(kDictionary) - 1);
+  stream.next_in = in.data() + 1;
+  stream.avail_in = in.size() - 1;
+
+  // JSON usually shrinks several times, buffer grows if it is not enough
+  size_t capacity = std::min(max_size, 4 * in.size() + 1024);
+  utils::BufferSlice inflated(capacity);
+  int result = Z_OK;
+  while (!inflated.empty()) {
+    stream.next_out = inflated.data() + stream.total_out;
+    stream.avail_out = capacity - stream.total_out;
+    result = inflate(&stream, Z_FINISH);
+    // Buffer is grown only if inflate stopped because it was full
+    if (Z_STREAM_END == result || 0 != stream.avail_out ||
+        capacity == max_size || (Z_BUF_ERROR != result && Z_OK != result)) {
+      break;
+    }
+    const size_t new_capacity = std::min(max_size, 2 * capacity);
+    utils::BufferSlice bigger(new_capacity);
+    if (!bigger.empty()) {
+      memcpy(bigger.data(), inflated.data(), stream.total_out);
+    }
+    inflated = bigger;
+    capacity = new_capacity;
+  }
+  const size_t inflated_size = stream.total_out;
+  inflateEnd(&stream);
+
+  if (inflated.empty()) {
+    LOG4CXX_ERROR(logger_, "Could not allocate " << capacity << " bytes");
+    return false;
+  }
+  if (Z_STREAM_END != result || 0 != stream.avail_in) {
+    LOG4CXX_WARN(logger_, "Malformed or too big deflated payload");
+    return false;
+  }
+  *out = inflated.Slice(0, inflated_size);
+  return true;
+}
+
+}  // namespace compression
+}  // namespace protocol_handler
@@ -32,11 +32,14 @@
 
 #include "protocol_handler/protocol_handler_impl.h"
 #include <memory.h>
-#include <algorithm>    // std::find
+#include <algorithm>    // std::find, std::min
+#include <sstream>
 
+#include "protocol_handler/payload_compression.h"
 #include "connection_handler/connection_handler_impl.h"
 #include "config_profile/profile.h"
 #include "utils/byte_order.h"
+#include "utils/memory_accounting.h"
 
 #ifdef ENABLE_SECURITY
 #include "security_manager/ssl_context.h"
@@ -62,6 +65,32 @@ uint8_t SupportedSDLProtocolVersion();
 
 const size_t kStackSize = 32768;
 
+namespace {
+/**
+ * \brief Tells whether frame carries audio or video streaming data
+ */
+bool IsMediaDataFrame(const ProtocolPacket& frame) {
+  return (kMobileNav == frame.service_type() ||
+          kAudio == frame.service_type()) &&
+         FRAME_TYPE_CONTROL != frame.frame_type();
+}
+
+/**
+ * \brief Bit of service in compression state of session,
+ * only RPC and bulk services carry payloads worth compressing
+ */
+uint8_t CompressionFlag(const uint8_t service_type) {
+  switch (service_type) {
+    case kRpc:
+      return 0x01;
+    case kBulk:
+      return 0x02;
+    default:
+      return 0x00;
+  }
+}
+}  // namespace
+
 ProtocolHandlerImpl::ProtocolHandlerImpl(
     transport_manager::TransportManager *transport_manager_param,
     size_t message_frequency_time, size_t message_frequency_count,
@@ -70,6 +99,13 @@ ProtocolHandlerImpl::ProtocolHandlerImpl(
     : protocol_observers_(),
       session_observer_(0),
       transport_manager_(transport_manager_param),
+      media_fast_lane_(profile::Profile::instance()->media_fast_lane()),
+      encrypt_whole_messages_(
+          profile::Profile::instance()->encrypt_whole_messages()),
+      payload_compression_(
+          profile::Profile::instance()->payload_compression()),
+      payload_compression_level_(
+          profile::Profile::instance()->payload_compression_level()),
       kPeriodForNaviAck(5),
       message_max_frequency_(message_frequency_count),
       message_frequency_time_(message_frequency_time),
@@ -78,6 +114,8 @@ ProtocolHandlerImpl::ProtocolHandlerImpl(
       malformed_message_frequency_time_(malformed_message_frequency_time),
 #ifdef ENABLE_SECURITY
       security_manager_(NULL),
+      frame_decryptor_(this),
+      decryption_pool_(NULL),
 #endif  // ENABLE_SECURITY
       raw_ford_messages_from_mobile_("PH FromMobile", this,
                                      threads::ThreadOptions(kStackSize)),
@@ -114,9 +152,49 @@ ProtocolHandlerImpl::ProtocolHandlerImpl(
     LOG4CXX_WARN(logger_, "Malformed message filtering is disabled."
                  << "Connection will be close on first malformed message detection");
   }
+
+#ifdef ENABLE_SECURITY
+  const uint32_t decryption_threads =
+      profile::Profile::instance()->decryption_threads();
+  if (decryption_threads > 0) {
+    decryption_pool_ = new threads::ThreadPool("PH Decrypt",
+                                               decryption_threads);
+    // More queues than threads, so streaming session rarely
+    // shares its queue with others
+    const uint32_t queues_per_thread = 4;
+    const uint32_t queues_count = decryption_threads * queues_per_thread;
+    for (uint32_t i = 0; i < queues_count; ++i) {
+      decryption_queues_.push_back(new impl::FromMobileQueue(
+          "PH Decrypt", &frame_decryptor_, decryption_pool_));
+    }
+  }
+#endif  // ENABLE_SECURITY
+
+  const uint32_t from_mobile_threads =
+      profile::Profile::instance()->from_mobile_threads();
+  for (uint32_t i = 1; i < from_mobile_threads; ++i) {
+    std::stringstream name;
+    name << "PH FromMobile " << i;
+    from_mobile_shards_.push_back(new impl::FromMobileQueue(
+        name.str(), this, threads::ThreadOptions(kStackSize)));
+  }
 }
 
 ProtocolHandlerImpl::~ProtocolHandlerImpl() {
+#ifdef ENABLE_SECURITY
+  // Decrypted frames are passed on to raw_ford_messages_from_mobile_
+  for (size_t i = 0; i < decryption_queues_.size(); ++i) {
+    delete decryption_queues_[i];
+  }
+  decryption_queues_.clear();
+  delete decryption_pool_;
+  decryption_pool_ = NULL;
+#endif  // ENABLE_SECURITY
+  for (size_t i = 0; i < from_mobile_shards_.size(); ++i) {
+    delete from_mobile_shards_[i];
+  }
+  from_mobile_shards_.clear();
+
   sync_primitives::AutoLock lock(protocol_observers_lock_);
   if (!protocol_observers_.empty()) {
     LOG4CXX_WARN(logger_, "Not all observers have unsubscribed"
@@ -181,10 +259,33 @@ void ProtocolHandlerImpl::SendStartSessionAck(ConnectionID connection_id,
   ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
     protocolVersion, protection, FRAME_TYPE_CONTROL,
     service_type, FRAME_DATA_START_SERVICE_ACK, session_id,
-    0u, message_counters_[session_id]++));
+    0u, NextMessageId(connection_id, session_id)));
 
   set_hash_id(hash_id, *ptr);
 
+  // Compression offered at start of service is accepted by acknowledgement
+  bool compression = false;
+  const uint8_t compression_flag = CompressionFlag(service_type);
+  if (compression_flag) {
+    sync_primitives::AutoLock lock(connection_contexts_lock_);
+    impl::ConnectionContext &context = GetConnectionContext(connection_id);
+    compression = 0 != (context.compression_offers[session_id] &
+                        compression_flag);
+    context.compression_offers[session_id] &= ~compression_flag;
+    if (compression) {
+      context.compressed_services[session_id] |= compression_flag;
+    } else {
+      context.compressed_services[session_id] &= ~compression_flag;
+    }
+  }
+  if (compression) {
+    // Chosen method follows hash id
+    uint8_t data[sizeof(hash_id) + 1];
+    memcpy(data, ptr->data(), sizeof(hash_id));
+    data[sizeof(hash_id)] = compression::kMethodDeflate;
+    ptr->set_data(data, sizeof(data));
+  }
+
   raw_ford_messages_to_mobile_.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
 
@@ -192,7 +293,8 @@ void ProtocolHandlerImpl::SendStartSessionAck(ConnectionID connection_id,
                "SendStartSessionAck() for connection " << connection_id
                << " for service_type " << static_cast<int32_t>(service_type)
                << " session_id " << static_cast<int32_t>(session_id)
-               << " protection " << (protection ? "ON" : "OFF"));
+               << " protection " << (protection ? "ON" : "OFF")
+               << " compression " << (compression ? "ON" : "OFF"));
 }
 
 void ProtocolHandlerImpl::SendStartSessionNAck(ConnectionID connection_id,
@@ -204,7 +306,7 @@ void ProtocolHandlerImpl::SendStartSessionNAck(ConnectionID connection_id,
   ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
       protocol_version, PROTECTION_OFF, FRAME_TYPE_CONTROL,
       service_type, FRAME_DATA_START_SERVICE_NACK,
-      session_id, 0u, message_counters_[session_id]++));
+      session_id, 0u, NextMessageId(connection_id, session_id)));
 
   raw_ford_messages_to_mobile_.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
@@ -224,7 +326,7 @@ void ProtocolHandlerImpl::SendEndSessionNAck(ConnectionID connection_id,
   ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
       protocol_version, PROTECTION_OFF, FRAME_TYPE_CONTROL,
       service_type, FRAME_DATA_END_SERVICE_NACK,
-      session_id, 0u, message_counters_[session_id]++));
+      session_id, 0u, NextMessageId(connection_id, session_id)));
 
   raw_ford_messages_to_mobile_.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
@@ -243,7 +345,7 @@ void ProtocolHandlerImpl::SendEndSessionAck(ConnectionID connection_id,
   ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
       protocol_version, PROTECTION_OFF, FRAME_TYPE_CONTROL,
       service_type, FRAME_DATA_END_SERVICE_ACK, session_id,
-      0u, message_counters_[session_id]++));
+      0u, NextMessageId(connection_id, session_id)));
 
   raw_ford_messages_to_mobile_.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
@@ -265,7 +367,7 @@ void ProtocolHandlerImpl::SendEndServicePrivate(int32_t connection_id,
     ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
       protocol_version, PROTECTION_OFF, FRAME_TYPE_CONTROL,
       service_type, FRAME_DATA_END_SERVICE, session_id, 0,
-      message_counters_[session_id]++));
+      NextMessageId(connection_id, session_id)));
 
     raw_ford_messages_to_mobile_.PostMessage(
       impl::RawFordMessageToMobile(ptr, false));
@@ -318,7 +420,7 @@ void ProtocolHandlerImpl::SendHeartBeat(int32_t connection_id,
     ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
 	    protocol_version, PROTECTION_OFF, FRAME_TYPE_CONTROL,
         SERVICE_TYPE_CONTROL, FRAME_DATA_HEART_BEAT, session_id,
-        0u, message_counters_[session_id]++));
+        0u, NextMessageId(connection_id, session_id)));
 
     raw_ford_messages_to_mobile_.PostMessage(
         impl::RawFordMessageToMobile(ptr, false));
@@ -331,7 +433,7 @@ void ProtocolHandlerImpl::SendHeartBeat(int32_t connection_id,
 void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
                                                  bool final_message) {
 #ifdef TIME_TESTER
-    const TimevalStruct start_time = date_time::DateTime::getCurrentTime();
+    const TimevalStruct start_time = date_time::DateTime::getPreciseMonotonicTime();
 #endif  // TIME_TESTER
   LOG4CXX_AUTO_TRACE(logger_);
   if (!message) {
@@ -353,22 +455,47 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
   session_observer_->PairFromKey(message->connection_key(), &connection_handle,
                                  &sessionID);
 #ifdef TIME_TESTER
-  uint32_t message_id = message_counters_[sessionID];
+  uint32_t message_id = 0;
+  {
+    sync_primitives::AutoLock lock(connection_contexts_lock_);
+    message_id =
+        GetConnectionContext(connection_handle).message_counters[sessionID];
+  }
   if (metric_observer_) {
     metric_observer_->StartMessageProcess(message_id, start_time);
   }
 #endif  // TIME_TESTER
 
+  utils::BufferSlice payload = message->buffer();
+  if (IsCompressedService(connection_handle, sessionID,
+                          message->service_type())) {
+    // Compressed before splitting and encryption, mobile side
+    // decompresses the message it assembled and decrypted
+    if (!compression::Compress(message->data(), message->data_size(),
+                               payload_compression_level_, &payload)) {
+      LOG4CXX_ERROR(logger_, "Failed to compress message for mobile app.");
+      return;
+    }
+    LOG4CXX_DEBUG(logger_, "Payload of " << message->data_size()
+                  << " bytes is encoded into " << payload.size());
+  }
+
   const uint32_t header_size = (PROTOCOL_VERSION_1 == message->protocol_version())
       ? PROTOCOL_HEADER_V1_SIZE : PROTOCOL_HEADER_V2_SIZE;
-  uint32_t max_frame_size = MAXIMUM_FRAME_DATA_SIZE - header_size;
+  uint32_t max_frame_size =
+      GetMaximumFrameSize(connection_handle, message->protocol_version()) -
+      header_size;
+  bool is_whole_message = false;
 #ifdef ENABLE_SECURITY
   const security_manager::SSLContext *ssl_context = session_observer_->
       GetSSLContext(message->connection_key(), message->service_type());
   if (ssl_context && ssl_context->IsInitCompleted()) {
     const size_t max_block_size = ssl_context->get_max_block_size(max_frame_size);
     DCHECK(max_block_size > 0);
-    if (max_block_size > 0) {
+    if (encrypt_whole_messages_ && payload.size() > max_block_size) {
+      // Frames keep full size, they carry records of whole message
+      is_whole_message = true;
+    } else if (max_block_size > 0) {
       max_frame_size = max_block_size;
       LOG4CXX_DEBUG(logger_, "Security set new optimal packet size " << max_frame_size);
     } else {
@@ -377,15 +504,26 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
   }
   LOG4CXX_DEBUG(logger_, "Optimal packet size is " << max_frame_size);
 #endif  // ENABLE_SECURITY
-  DCHECK(MAXIMUM_FRAME_DATA_SIZE > max_frame_size);
-
-
-  if (message->data_size() <= max_frame_size) {
+  DCHECK(MAXIMUM_FRAME_DATA_SIZE_V3 > max_frame_size);
+
+
+  if (is_whole_message) {
+    LOG4CXX_DEBUG(logger_, "Message will be encrypted as a whole");
+    // Frame is queued to be split at sending, when encryption
+    // takes place in order with other frames of session
+    ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(
+        connection_handle, message->protocol_version(), PROTECTION_OFF,
+        FRAME_TYPE_FIRST, message->service_type(), FRAME_DATA_FIRST,
+        sessionID, payload.size(),
+        NextMessageId(connection_handle, sessionID), NULL));
+    ptr->set_data(payload);
+    raw_ford_messages_to_mobile_.PostMessage(
+        impl::RawFordMessageToMobile(ptr, final_message, true));
+  } else if (payload.size() <= max_frame_size) {
     RESULT_CODE result = SendSingleFrameMessage(connection_handle, sessionID,
                                                 message->protocol_version(),
                                                 message->service_type(),
-                                                message->data_size(),
-                                                message->data(),
+                                                payload,
                                                 final_message);
     if (result != RESULT_OK) {
       LOG4CXX_ERROR(logger_,
@@ -399,8 +537,7 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
     RESULT_CODE result = SendMultiFrameMessage(connection_handle, sessionID,
                                                message->protocol_version(),
                                                message->service_type(),
-                                               message->data_size(),
-                                               message->data(),
+                                               payload,
                                                max_frame_size, final_message);
     if (result != RESULT_OK) {
       LOG4CXX_ERROR(logger_,
@@ -420,6 +557,9 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
 }
 
 void ProtocolHandlerImpl::OnTMMessageReceived(const RawMessagePtr tm_message) {
+#ifdef TIME_TESTER
+  const TimevalStruct start_time = date_time::DateTime::getPreciseMonotonicTime();
+#endif  // TIME_TESTER
   LOG4CXX_AUTO_TRACE(logger_);
 
   if (!tm_message) {
@@ -462,27 +602,97 @@ void ProtocolHandlerImpl::OnTMMessageReceived(const RawMessagePtr tm_message) {
   for (std::list<ProtocolFramePtr>::const_iterator it =
        protocol_frames.begin(); it != protocol_frames.end(); ++it) {
 #ifdef TIME_TESTER
-    const TimevalStruct start_time = date_time::DateTime::getCurrentTime();
+    StartRpcTrace(*tm_message, *it, start_time);
 #endif  // TIME_TESTER
-    ProtocolFramePtr frame = *it;
 #ifdef ENABLE_SECURITY
-    const RESULT_CODE result = DecryptFrame(frame);
-    if (result != RESULT_OK) {
-      LOG4CXX_WARN(logger_, "Error frame decryption. Frame skipped.");
+    if (!decryption_queues_.empty()) {
+      // Unprotected frames go through the queue too, otherwise they
+      // could overtake protected frames of the same session
+      const size_t queue_index =
+          (static_cast<size_t>(connection_key) *
+           impl::ConnectionContext::kSessionsCount + (*it)->session_id()) %
+          decryption_queues_.size();
+      decryption_queues_[queue_index]->PostMessage(
+          impl::RawFordMessageFromMobile(*it));
       continue;
     }
 #endif  // ENABLE_SECURITY
-    impl::RawFordMessageFromMobile msg(frame);
+    ProcessFrame(*it);
+  }
+}
+
 #ifdef TIME_TESTER
-    if (metric_observer_) {
-      metric_observer_->StartMessageProcess(msg->message_id(), start_time);
-    }
+void ProtocolHandlerImpl::StartRpcTrace(const RawMessage &tm_message,
+                                        const ProtocolFramePtr frame,
+                                        const TimevalStruct &begin) {
+  if (!utils::RpcTracer::instance()->enabled() ||
+      kRpc != ServiceTypeFromByte(frame->service_type()) ||
+      (FRAME_TYPE_SINGLE != frame->frame_type() &&
+       FRAME_TYPE_FIRST != frame->frame_type())) {
+    return;
+  }
+  // Transport manager queue is waited from reading till begin,
+  // after that data is parsed into frames
+  const utils::RpcTracePtr trace(
+      new utils::RpcTrace(tm_message.creation_time()));
+  trace->AddSpan(utils::rpc_trace::kTransportManager,
+                 tm_message.creation_time(), begin,
+                 date_time::DateTime::getPreciseMonotonicTime());
+  trace->Enqueue(utils::rpc_trace::kProtocolHandler);
+  frame->set_trace(trace);
+}
+#endif  // TIME_TESTER
+
+void ProtocolHandlerImpl::ProcessFrame(const ProtocolFramePtr frame) {
+#ifdef TIME_TESTER
+  const TimevalStruct start_time = date_time::DateTime::getPreciseMonotonicTime();
+#endif  // TIME_TESTER
+#ifdef ENABLE_SECURITY
+  const RESULT_CODE result = DecryptFrame(frame);
+  if (result != RESULT_OK) {
+    LOG4CXX_WARN(logger_, "Error frame decryption. Frame skipped.");
+    return;
+  }
+#endif  // ENABLE_SECURITY
+  impl::RawFordMessageFromMobile msg(frame);
+#ifdef TIME_TESTER
+  if (metric_observer_) {
+    metric_observer_->StartMessageProcess(msg->message_id(), start_time);
+  }
 #endif  // TIME_TESTER
 
-    raw_ford_messages_from_mobile_.PostMessage(msg);
+  if (media_fast_lane_ && IsMediaDataFrame(*frame)) {
+    // Streaming data does not wait behind RPCs, control frames of
+    // media services still go through the queue to keep service state
+    // changes ordered with other messages
+    Handle(msg);
+    return;
   }
+  FromMobileQueueFor(frame->connection_id()).PostMessage(msg);
 }
 
+impl::FromMobileQueue& ProtocolHandlerImpl::FromMobileQueueFor(
+    ConnectionID connection_id) {
+  if (from_mobile_shards_.empty()) {
+    return raw_ford_messages_from_mobile_;
+  }
+  const size_t index = connection_id % (from_mobile_shards_.size() + 1);
+  return 0 == index ? raw_ford_messages_from_mobile_
+                    : *from_mobile_shards_[index - 1];
+}
+
+#ifdef ENABLE_SECURITY
+ProtocolHandlerImpl::FrameDecryptor::FrameDecryptor(
+    ProtocolHandlerImpl *protocol_handler)
+  : protocol_handler_(*protocol_handler) {
+}
+
+void ProtocolHandlerImpl::FrameDecryptor::Handle(
+    const impl::RawFordMessageFromMobile message) {
+  protocol_handler_.ProcessFrame(message);
+}
+#endif  // ENABLE_SECURITY
+
 void ProtocolHandlerImpl::OnTMMessageReceiveFailed(
     const transport_manager::DataReceiveError &error) {
   // TODO(PV): implement
@@ -518,25 +728,33 @@ void ProtocolHandlerImpl::OnTMMessageSend(const RawMessagePtr message) {
     return;
   }
 
-  ProtocolPacket sent_message(message->connection_key());
-  const RESULT_CODE result = sent_message.deserializePacket(message->data(),
-                                                            message->data_size());
-  if (result != RESULT_OK) {
+  // Only header is needed, first fragment of sent frame always contains it
+  const utils::BufferSlice &frame_header = message->fragment(0);
+  if (frame_header.size() < PROTOCOL_HEADER_V1_SIZE) {
     LOG4CXX_ERROR(logger_, "Error while message deserialization.");
     return;
   }
-  std::map<uint8_t, uint32_t>::iterator it =
-      sessions_last_message_id_.find(sent_message.session_id());
+  ProtocolPacket::ProtocolHeader sent_header;
+  sent_header.deserialize(frame_header.data(), frame_header.size());
+  bool last_message_pending = false;
+  uint32_t last_message_id = 0;
+  {
+    // Outgoing frames are keyed by connection identifier
+    sync_primitives::AutoLock lock(connection_contexts_lock_);
+    impl::ConnectionContext &context =
+        GetConnectionContext(message->connection_key());
+    std::swap(last_message_pending,
+              context.last_message_pending[sent_header.sessionId]);
+    last_message_id = context.last_message_ids[sent_header.sessionId];
+  }
 
-  if (sessions_last_message_id_.end() != it) {
-    uint32_t last_message_id = it->second;
-    sessions_last_message_id_.erase(it);
-    if ((sent_message.message_id() ==  last_message_id) &&
-        ((FRAME_TYPE_SINGLE == sent_message.frame_type()) ||
-        ((FRAME_TYPE_CONSECUTIVE == sent_message.frame_type()) &&
-         (0 == sent_message.frame_data())))) {
+  if (last_message_pending) {
+    if ((sent_header.messageId ==  last_message_id) &&
+        ((FRAME_TYPE_SINGLE == sent_header.frameType) ||
+        ((FRAME_TYPE_CONSECUTIVE == sent_header.frameType) &&
+         (0 == sent_header.frameData)))) {
       ready_to_close_connections_.push_back(connection_handle);
-      SendEndSession(connection_handle, sent_message.session_id());
+      SendEndSession(connection_handle, sent_header.sessionId);
     }
   }
   sync_primitives::AutoLock lock(protocol_observers_lock_);
@@ -558,15 +776,120 @@ void ProtocolHandlerImpl::OnConnectionEstablished(
     const transport_manager::DeviceInfo &device_info,
     const transport_manager::ConnectionUID &connection_id) {
   incoming_data_handler_.AddConnection(connection_id);
+  LOG4CXX_DEBUG(logger_, "Connection " << connection_id
+                << " prefers frames of " << device_info.maximum_frame_size()
+                << " bytes");
+  sync_primitives::AutoLock lock(connection_contexts_lock_);
+  GetConnectionContext(connection_id).maximum_frame_size =
+      device_info.maximum_frame_size();
 }
 
 void ProtocolHandlerImpl::OnConnectionClosed(
     const transport_manager::ConnectionUID &connection_id) {
   incoming_data_handler_.RemoveConnection(connection_id);
+  {
+    sync_primitives::AutoLock lock(connection_contexts_lock_);
+    for (std::vector<impl::ConnectionContext>::iterator it =
+         connection_contexts_.begin(); connection_contexts_.end() != it; ++it) {
+      if (connection_id == it->connection_id) {
+        connection_contexts_.erase(it);
+        break;
+      }
+    }
+  }
+  if (session_observer_) {
+    // Partially received messages of closed connection are never completed
+    sync_primitives::AutoLock frames_lock(incomplete_multi_frame_messages_lock_);
+    std::map<int32_t, ProtocolFramePtr>::iterator it =
+        incomplete_multi_frame_messages_.begin();
+    while (incomplete_multi_frame_messages_.end() != it) {
+      transport_manager::ConnectionUID key_connection_id = 0;
+      uint8_t session_id = 0;
+      session_observer_->PairFromKey(it->first, &key_connection_id,
+                                     &session_id);
+      if (connection_id == key_connection_id) {
+        EraseMultiFrameMessage(it++);
+      } else {
+        ++it;
+      }
+    }
+  }
   message_meter_.ClearIdentifiers();
   malformed_message_meter_.ClearIdentifiers();
 }
 
+size_t ProtocolHandlerImpl::GetMaximumFrameSize(
+    const ConnectionID connection_id, const uint32_t protocol_version) {
+  // Mobile side of protocol version 1 and 2 accepts only Ethernet MTU frames
+  if (protocol_version < PROTOCOL_VERSION_3) {
+    return MAXIMUM_FRAME_DATA_SIZE;
+  }
+  size_t maximum_frame_size = 0;
+  {
+    sync_primitives::AutoLock lock(connection_contexts_lock_);
+    maximum_frame_size =
+        GetConnectionContext(connection_id).maximum_frame_size;
+  }
+  // Frame shall fit protocol limit and hold at least first frame data
+  const size_t min_frame_size = PROTOCOL_HEADER_V2_SIZE + FIRST_FRAME_DATA_SIZE;
+  if (maximum_frame_size < min_frame_size) {
+    return MAXIMUM_FRAME_DATA_SIZE;
+  }
+  return std::min(maximum_frame_size,
+                  static_cast<size_t>(MAXIMUM_FRAME_DATA_SIZE_V3));
+}
+
+impl::ConnectionContext &ProtocolHandlerImpl::GetConnectionContext(
+    const ConnectionID connection_id) {
+  for (std::vector<impl::ConnectionContext>::iterator it =
+       connection_contexts_.begin(); connection_contexts_.end() != it; ++it) {
+    if (connection_id == it->connection_id) {
+      return *it;
+    }
+  }
+  connection_contexts_.push_back(impl::ConnectionContext(connection_id));
+  return connection_contexts_.back();
+}
+
+uint32_t ProtocolHandlerImpl::NextMessageId(const ConnectionID connection_id,
+                                            const uint8_t session_id) {
+  sync_primitives::AutoLock lock(connection_contexts_lock_);
+  return GetConnectionContext(connection_id).message_counters[session_id]++;
+}
+
+bool ProtocolHandlerImpl::IsCompressedService(const ConnectionID connection_id,
+                                              const uint8_t session_id,
+                                              const uint8_t service_type) {
+  const uint8_t compression_flag = CompressionFlag(service_type);
+  if (!compression_flag) {
+    return false;
+  }
+  sync_primitives::AutoLock lock(connection_contexts_lock_);
+  return 0 != (GetConnectionContext(connection_id).
+               compressed_services[session_id] & compression_flag);
+}
+
+bool ProtocolHandlerImpl::DecodePayload(const ConnectionID connection_id,
+                                        const ProtocolPacket &packet,
+                                        utils::BufferSlice *payload,
+                                        uint32_t *payload_size) {
+  DCHECK_OR_RETURN(payload && payload_size, false);
+  if (!IsCompressedService(connection_id, packet.session_id(),
+                           packet.service_type())) {
+    *payload = packet.buffer();
+    *payload_size = packet.payload_size();
+    return true;
+  }
+  if (!compression::Decompress(packet.buffer(),
+                               compression::kMaximumInflatedSize, payload)) {
+    LOG4CXX_WARN(logger_, "Could not decode payload of "
+                 << packet.data_size() << " bytes of compressed service");
+    return false;
+  }
+  *payload_size = payload->size();
+  return true;
+}
+
 RESULT_CODE ProtocolHandlerImpl::SendFrame(const ProtocolFramePtr packet) {
   LOG4CXX_AUTO_TRACE(logger_);
   if (!packet) {
@@ -582,6 +905,10 @@ RESULT_CODE ProtocolHandlerImpl::SendFrame(const ProtocolFramePtr packet) {
   }
 #endif  // ENABLE_SECURITY
 
+  return TransmitFrame(packet);
+}
+
+RESULT_CODE ProtocolHandlerImpl::TransmitFrame(const ProtocolFramePtr packet) {
   LOG4CXX_DEBUG(logger_, "Packet to be sent: " <<
                    ConvertPacketDataToString(packet->data(), packet->data_size()) <<
                    " of size: " << packet->data_size());
@@ -609,13 +936,14 @@ RESULT_CODE ProtocolHandlerImpl::SendFrame(const ProtocolFramePtr packet) {
 RESULT_CODE ProtocolHandlerImpl::SendSingleFrameMessage(
     const ConnectionID connection_id, const uint8_t session_id,
     const uint32_t protocol_version, const uint8_t service_type,
-    const size_t data_size, const uint8_t *data,
+    const utils::BufferSlice &data,
     const bool is_final_message) {
   LOG4CXX_AUTO_TRACE(logger_);
 
   ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
       protocol_version, PROTECTION_OFF, FRAME_TYPE_SINGLE, service_type, FRAME_DATA_SINGLE,
-      session_id, data_size, message_counters_[session_id]++, data));
+      session_id, data.size(), NextMessageId(connection_id, session_id), NULL));
+  ptr->set_data(data);
 
   raw_ford_messages_to_mobile_.PostMessage(
       impl::RawFordMessageToMobile(ptr, is_final_message));
@@ -625,10 +953,35 @@ RESULT_CODE ProtocolHandlerImpl::SendSingleFrameMessage(
 RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
     const ConnectionID connection_id, const uint8_t session_id,
     const uint8_t protocol_version, const uint8_t service_type,
-    const size_t data_size, const uint8_t *data,
+    const utils::BufferSlice &data,
     const size_t max_frame_size, const bool is_final_message) {
   LOG4CXX_AUTO_TRACE(logger_);
 
+  // TODO(EZamakhov): investigate message_id for CONSECUTIVE frames - APPLINK-9531
+  const uint8_t message_id = NextMessageId(connection_id, session_id);
+  std::vector<ProtocolFramePtr> frames;
+  SplitToFrames(connection_id, session_id, protocol_version, service_type,
+                message_id, data, data.size(), max_frame_size, PROTECTION_OFF,
+                &frames);
+
+  for (size_t i = 0; i < frames.size(); ++i) {
+    const bool is_final_packet =
+        (i == frames.size() - 1) ? is_final_message : false;
+    raw_ford_messages_to_mobile_.PostMessage(
+          impl::RawFordMessageToMobile(frames[i], is_final_packet));
+  }
+  LOG4CXX_DEBUG(logger_, frames.size() << " frames are sent.");
+  return RESULT_OK;
+}
+
+void ProtocolHandlerImpl::SplitToFrames(
+    const ConnectionID connection_id, const uint8_t session_id,
+    const uint8_t protocol_version, const uint8_t service_type,
+    const uint32_t message_id, const utils::BufferSlice &data,
+    const size_t message_size, const size_t max_frame_size,
+    const bool protection, std::vector<ProtocolFramePtr> *frames) {
+  DCHECK(frames);
+  const size_t data_size = data.size();
   LOG4CXX_DEBUG(
       logger_, " data size " << data_size << " max_frame_size " << max_frame_size);
 
@@ -650,27 +1003,22 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
   DCHECK(max_frame_size >= FIRST_FRAME_DATA_SIZE);
   DCHECK(FIRST_FRAME_DATA_SIZE >= 8);
   uint8_t out_data[FIRST_FRAME_DATA_SIZE];
-  out_data[0] = data_size >> 24;
-  out_data[1] = data_size >> 16;
-  out_data[2] = data_size >> 8;
-  out_data[3] = data_size;
+  out_data[0] = message_size >> 24;
+  out_data[1] = message_size >> 16;
+  out_data[2] = message_size >> 8;
+  out_data[3] = message_size;
 
   out_data[4] = frames_count >> 24;
   out_data[5] = frames_count >> 16;
   out_data[6] = frames_count >> 8;
   out_data[7] = frames_count;
 
-  // TODO(EZamakhov): investigate message_id for CONSECUTIVE frames - APPLINK-9531
-  const uint8_t message_id = message_counters_[session_id]++;
-  const ProtocolFramePtr firstPacket(
+  frames->reserve(frames_count + 1);
+  frames->push_back(ProtocolFramePtr(
         new protocol_handler::ProtocolPacket(
           connection_id, protocol_version, PROTECTION_OFF, FRAME_TYPE_FIRST,
           service_type, FRAME_DATA_FIRST, session_id, FIRST_FRAME_DATA_SIZE,
-          message_id, out_data));
-
-  raw_ford_messages_to_mobile_.PostMessage(
-      impl::RawFordMessageToMobile(firstPacket, false));
-  LOG4CXX_DEBUG(logger_, "First frame is sent.");
+          message_id, out_data)));
 
   for (uint32_t i = 0; i < frames_count; ++i) {
     const bool is_last_frame = (i == (frames_count - 1));
@@ -679,18 +1027,14 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
         is_last_frame
         ? FRAME_DATA_LAST_CONSECUTIVE
         : (i % FRAME_DATA_MAX_CONSECUTIVE + 1);
-    const bool is_final_packet = is_last_frame ? is_final_message : false;
 
     const ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
-        protocol_version, PROTECTION_OFF, FRAME_TYPE_CONSECUTIVE,
-        service_type, data_type, session_id, frame_size, message_id,
-        data + max_frame_size * i));
-
-    raw_ford_messages_to_mobile_.PostMessage(
-          impl::RawFordMessageToMobile(ptr, is_final_packet));
-    LOG4CXX_DEBUG(logger_, '#' << i << " frame is sent.");
+        protocol_version, protection, FRAME_TYPE_CONSECUTIVE,
+        service_type, data_type, session_id, frame_size, message_id, NULL));
+    // Consecutive frames reference parts of message without copying
+    ptr->set_data(data.Slice(max_frame_size * i, frame_size));
+    frames->push_back(ptr);
   }
-  return RESULT_OK;
 }
 
 RESULT_CODE ProtocolHandlerImpl::HandleMessage(ConnectionID connection_id,
@@ -733,13 +1077,17 @@ RESULT_CODE ProtocolHandlerImpl::HandleSingleFrameMessage(
   const uint32_t connection_key =
       session_observer_->KeyFromPair(connection_id, packet->session_id());
 
-  const RawMessagePtr rawMessage(
-        new RawMessage(connection_key,
-                       packet->protocol_version(),
-                       packet->data(),
-                       packet->total_data_bytes(),
-                       packet->service_type(),
-                       packet->payload_size()));
+  utils::BufferSlice payload;
+  uint32_t payload_size = 0;
+  if (!DecodePayload(connection_id, *packet, &payload, &payload_size)) {
+    return RESULT_FAIL;
+  }
+  const RawMessagePtr rawMessage =
+      utils::MakeShared<RawMessage>(connection_key,
+                                    packet->protocol_version(),
+                                    payload,
+                                    packet->service_type(),
+                                    payload_size);
   if (!rawMessage) {
     return RESULT_FAIL;
   }
@@ -752,6 +1100,10 @@ RESULT_CODE ProtocolHandlerImpl::HandleSingleFrameMessage(
         metric->raw_msg = rawMessage;
         metric_observer_->EndMessageProcess(metric);
       }
+  if (packet->trace()) {
+    packet->trace()->End(utils::rpc_trace::kProtocolHandler);
+    rawMessage->set_trace(packet->trace());
+  }
 #endif
 
   // TODO(EZamakhov): check service in session
@@ -774,9 +1126,24 @@ RESULT_CODE ProtocolHandlerImpl::HandleMultiFrameMessage(
       logger_,
       "Packet " << packet << "; session id " << static_cast<int32_t>(key));
 
+  sync_primitives::AutoLock frames_lock(incomplete_multi_frame_messages_lock_);
   if (packet->frame_type() == FRAME_TYPE_FIRST) {
     LOG4CXX_INFO(logger_, "handleMultiFrameMessage() - FRAME_TYPE_FIRST "
                  << packet->data_size());
+    std::map<int32_t, ProtocolFramePtr>::iterator it =
+        incomplete_multi_frame_messages_.find(key);
+    if (it != incomplete_multi_frame_messages_.end()) {
+      EraseMultiFrameMessage(it);
+    }
+    // Storage of whole message is held till its last frame comes
+    if (!utils::MemoryAccounting::instance()->TryCharge(
+            key, utils::MemoryAccounting::kMultiFrame,
+            packet->total_data_bytes())) {
+      LOG4CXX_WARN(logger_, "Multiframe message of "
+                   << packet->total_data_bytes() << " bytes exceeds memory"
+                   " quota of connection key " << key);
+      return RESULT_FAIL;
+    }
     incomplete_multi_frame_messages_[key] = packet;
   } else {
     LOG4CXX_INFO(logger_, "handleMultiFrameMessage() - Consecutive frame");
@@ -790,10 +1157,14 @@ RESULT_CODE ProtocolHandlerImpl::HandleMultiFrameMessage(
       return RESULT_FAIL;
     }
 
-    if (it->second->appendData(packet->data(), packet->data_size())
+    // Frame of whole encrypted message may complete no record
+    if (packet->data_size() > 0 &&
+        it->second->appendData(packet->data(), packet->data_size())
         != RESULT_OK) {
       LOG4CXX_ERROR(logger_,
           "Failed to append frame for multiframe message.");
+      // Message can't be completed, don't hold its storage any longer
+      EraseMultiFrameMessage(it);
       return RESULT_FAIL;
     }
 
@@ -816,13 +1187,19 @@ RESULT_CODE ProtocolHandlerImpl::HandleMultiFrameMessage(
       const uint32_t connection_key =
           session_observer_->KeyFromPair(connection_id,
                                          completePacket->session_id());
-      const RawMessagePtr rawMessage(
-            new RawMessage(connection_key,
-                           completePacket->protocol_version(),
-                           completePacket->data(),
-                           completePacket->total_data_bytes(),
-                           completePacket->service_type(),
-                           completePacket->payload_size()));
+      utils::BufferSlice payload;
+      uint32_t payload_size = 0;
+      if (!DecodePayload(connection_id, *completePacket,
+                         &payload, &payload_size)) {
+        EraseMultiFrameMessage(it);
+        return RESULT_FAIL;
+      }
+      const RawMessagePtr rawMessage =
+          utils::MakeShared<RawMessage>(connection_key,
+                                        completePacket->protocol_version(),
+                                        payload,
+                                        completePacket->service_type(),
+                                        payload_size);
 
       LOG4CXX_INFO(logger_,
                     "total_data_bytes " << completePacket->total_data_bytes() <<
@@ -841,16 +1218,29 @@ RESULT_CODE ProtocolHandlerImpl::HandleMultiFrameMessage(
         metric->raw_msg = rawMessage;
         metric_observer_->EndMessageProcess(metric);
       }
+      // Span of multiframe message lasts from first till last frame
+      if (completePacket->trace()) {
+        completePacket->trace()->End(utils::rpc_trace::kProtocolHandler);
+        rawMessage->set_trace(completePacket->trace());
+      }
 #endif  // TIME_TESTER
       // TODO(EZamakhov): check service in session
       NotifySubscribers(rawMessage);
 
-      incomplete_multi_frame_messages_.erase(it);
+      EraseMultiFrameMessage(it);
     }
   }
   return RESULT_OK;
 }
 
+void ProtocolHandlerImpl::EraseMultiFrameMessage(
+    std::map<int32_t, ProtocolFramePtr>::iterator it) {
+  utils::MemoryAccounting::instance()->Release(
+      it->first, utils::MemoryAccounting::kMultiFrame,
+      it->second->total_data_bytes());
+  incomplete_multi_frame_messages_.erase(it);
+}
+
 RESULT_CODE ProtocolHandlerImpl::HandleControlMessage(
     ConnectionID connection_id, const ProtocolFramePtr packet) {
   LOG4CXX_AUTO_TRACE(logger_);
@@ -914,7 +1304,25 @@ RESULT_CODE ProtocolHandlerImpl::HandleControlMessageEndSession(
   if (session_key != 0) {
     SendEndSessionAck( connection_id, current_session_id,
                        packet.protocol_version(), service_type);
-    message_counters_.erase(current_session_id);
+    {
+      sync_primitives::AutoLock lock(connection_contexts_lock_);
+      impl::ConnectionContext &context = GetConnectionContext(connection_id);
+      context.message_counters[current_session_id] = 0;
+      // Ending RPC service ends the whole session
+      const uint8_t compression_flags =
+          kRpc == service_type ? 0xFF : CompressionFlag(service_type);
+      context.compression_offers[current_session_id] &= ~compression_flags;
+      context.compressed_services[current_session_id] &= ~compression_flags;
+    }
+    // Partially received message of ended service will never be completed
+    sync_primitives::AutoLock frames_lock(incomplete_multi_frame_messages_lock_);
+    std::map<int32_t, ProtocolFramePtr>::iterator it =
+        incomplete_multi_frame_messages_.find(session_key);
+    if (incomplete_multi_frame_messages_.end() != it &&
+        (kRpc == service_type ||
+         service_type == ServiceTypeFromByte(it->second->service_type()))) {
+      EraseMultiFrameMessage(it);
+    }
   } else {
     LOG4CXX_INFO_EXT(
         logger_,
@@ -1024,6 +1432,18 @@ RESULT_CODE ProtocolHandlerImpl::HandleControlMessageStartSession(
     return RESULT_OK;
   }
 
+  // Mobile side offers compression methods in first byte of payload,
+  // offer is accepted or declined by acknowledgement
+  const uint8_t compression_flag = CompressionFlag(packet.service_type());
+  if (compression_flag && protocol_version >= PROTOCOL_VERSION_4) {
+    const bool offered = payload_compression_ && packet.data_size() > 0 &&
+        (packet.data()[0] & compression::kMethodDeflate);
+    sync_primitives::AutoLock lock(connection_contexts_lock_);
+    uint8_t &offers =
+        GetConnectionContext(connection_id).compression_offers[session_id];
+    offers = offered ? offers | compression_flag : offers & ~compression_flag;
+  }
+
 #ifdef ENABLE_SECURITY
   // for packet is encrypted and security plugin is enable
   if (protection && security_manager_) {
@@ -1099,14 +1519,20 @@ bool ProtocolHandlerImpl::TrackMessage(const uint32_t& connection_key) {
   LOG4CXX_AUTO_TRACE(logger_);
   if (message_frequency_time_ > 0u &&
       message_max_frequency_ > 0u) {
-    const size_t message_frequency = message_meter_.TrackMessage(connection_key);
+    size_t message_frequency = 0;
+    {
+      sync_primitives::AutoLock lock(message_meter_lock_);
+      message_frequency = message_meter_.TrackMessage(connection_key);
+      if (message_frequency > message_max_frequency_) {
+        message_meter_.RemoveIdentifier(connection_key);
+      }
+    }
     LOG4CXX_DEBUG(logger_, "Frequency of " << connection_key << " is " << message_frequency);
     if (message_frequency > message_max_frequency_) {
       LOG4CXX_WARN(logger_, "Frequency of " << connection_key << " is marked as high.");
       if (session_observer_) {
         session_observer_->OnApplicationFloodCallBack(connection_key);
       }
-      message_meter_.RemoveIdentifier(connection_key);
       return true;
     }
   }
@@ -1139,6 +1565,11 @@ bool ProtocolHandlerImpl::TrackMalformedMessage(const uint32_t &connection_key,
 void ProtocolHandlerImpl::Handle(
     const impl::RawFordMessageFromMobile message) {
   LOG4CXX_AUTO_TRACE(logger_);
+#ifdef TIME_TESTER
+  if (message->trace()) {
+    message->trace()->Begin(utils::rpc_trace::kProtocolHandler);
+  }
+#endif  // TIME_TESTER
 
   if (NULL == session_observer_) {
     LOG4CXX_WARN(logger_, "Session Observer is NULL");
@@ -1190,16 +1621,30 @@ void ProtocolHandlerImpl::Handle(const impl::RawFordMessageToMobile message) {
       " protocolVersion " << static_cast<int>(message->protocol_version()));
 
   if (message.is_final) {
-    sessions_last_message_id_.insert(
-        std::pair<uint8_t, uint32_t>(message->session_id(),
-                                     message->message_id()));
+    sync_primitives::AutoLock lock(connection_contexts_lock_);
+    impl::ConnectionContext &context =
+        GetConnectionContext(message->connection_id());
+    // The first final message of session is kept
+    if (!context.last_message_pending[message->session_id()]) {
+      context.last_message_pending[message->session_id()] = true;
+      context.last_message_ids[message->session_id()] = message->message_id();
+    }
   }
 
+#ifdef ENABLE_SECURITY
+  if (message.is_whole_message) {
+    SendWholeEncryptedMessage(message);
+    return;
+  }
+#endif  // ENABLE_SECURITY
   SendFrame(message);
 }
 
 void ProtocolHandlerImpl::Stop() {
   raw_ford_messages_from_mobile_.Shutdown();
+  for (size_t i = 0; i < from_mobile_shards_.size(); ++i) {
+    from_mobile_shards_[i]->Shutdown();
+  }
   raw_ford_messages_to_mobile_.Shutdown();
 }
 
@@ -1235,10 +1680,8 @@ RESULT_CODE ProtocolHandlerImpl::EncryptFrame(ProtocolFramePtr packet) {
   if (!context || !context->IsInitCompleted()) {
     return RESULT_OK;
   }
-  const uint8_t *out_data;
-  size_t out_data_size;
-  if (!context->Encrypt(packet->data(), packet->data_size(),
-                       &out_data, &out_data_size)) {
+  utils::BufferSlice out_data;
+  if (!context->Encrypt(packet->data(), packet->data_size(), &out_data)) {
     const std::string error_text(context->LastError());
     LOG4CXX_ERROR(logger_, "Enryption failed: " << error_text);
     security_manager_->SendInternalError(connection_key,
@@ -1250,11 +1693,42 @@ RESULT_CODE ProtocolHandlerImpl::EncryptFrame(ProtocolFramePtr packet) {
     return RESULT_OK;
   };
   LOG4CXX_DEBUG(logger_, "Encrypted " << packet->data_size() << " bytes to "
-                << out_data_size << " bytes");
-  DCHECK(out_data);
-  DCHECK(out_data_size);
+                << out_data.size() << " bytes");
+  DCHECK(!out_data.empty());
   packet->set_protection_flag(true);
-  packet->set_data(out_data, out_data_size);
+  packet->set_data(out_data);
+  return RESULT_OK;
+}
+
+RESULT_CODE ProtocolHandlerImpl::SendWholeEncryptedMessage(
+    const ProtocolFramePtr message) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  const size_t message_size = message->data_size();
+  // TLS splits data of one call into records of maximum size
+  if (EncryptFrame(message) != RESULT_OK) {
+    LOG4CXX_WARN(logger_, "Error message encryption. Message droped.");
+    return RESULT_FAIL;
+  }
+  const uint32_t header_size =
+      (PROTOCOL_VERSION_1 == message->protocol_version())
+      ? PROTOCOL_HEADER_V1_SIZE : PROTOCOL_HEADER_V2_SIZE;
+  const size_t max_frame_size =
+      GetMaximumFrameSize(message->connection_id(),
+                          message->protocol_version()) - header_size;
+  std::vector<ProtocolFramePtr> frames;
+  // Receiver appends decrypted data, so plain message size is announced
+  SplitToFrames(message->connection_id(), message->session_id(),
+                message->protocol_version(), message->service_type(),
+                message->message_id(), message->buffer(), message_size,
+                max_frame_size, message->protection_flag(), &frames);
+  LOG4CXX_DEBUG(logger_, "Encrypted " << message_size << " bytes are sent in "
+                << frames.size() << " frames");
+  // Records stream shall not be interleaved with other records of session
+  for (size_t i = 0; i < frames.size(); ++i) {
+    if (TransmitFrame(frames[i]) != RESULT_OK) {
+      return RESULT_FAIL;
+    }
+  }
   return RESULT_OK;
 }
 
@@ -1302,8 +1776,10 @@ RESULT_CODE ProtocolHandlerImpl::DecryptFrame(ProtocolFramePtr packet) {
   LOG4CXX_DEBUG(logger_, "Decrypted " << packet->data_size() << " bytes to "
                 << out_data_size << " bytes");
   DCHECK(out_data);
-  DCHECK(out_data_size);
-  packet->set_data(out_data, out_data_size);
+  // Consecutive frame of whole encrypted message may end in the middle
+  // of record, the rest of it is decrypted with next frames
+  DCHECK(out_data_size || FRAME_TYPE_CONSECUTIVE == packet->frame_type());
+  packet->set_data(utils::BufferSlice(out_data, out_data_size));
   return RESULT_OK;
 }
 #endif  // ENABLE_SECURITY
@@ -1323,7 +1799,7 @@ void ProtocolHandlerImpl::SendFramesNumber(uint32_t connection_key,
     ProtocolFramePtr ptr(new protocol_handler::ProtocolPacket(connection_id,
 	  	  protocol_version, PROTECTION_OFF, FRAME_TYPE_CONTROL,
 	        SERVICE_TYPE_NAVI, FRAME_DATA_SERVICE_DATA_ACK,
-	        session_id, 0, message_counters_[session_id]++));
+	        session_id, 0, NextMessageId(connection_id, session_id)));
 
     // Flow control data shall be 4 bytes according Ford Protocol
     DCHECK(sizeof(number_of_frames) == 4);
@@ -32,7 +32,6 @@
 
 #include <stdint.h>
 #include <memory.h>
-#include <new>
 #include <cstring>
 #include <limits>
 
@@ -42,12 +41,87 @@
 
 namespace protocol_handler {
 
-ProtocolPacket::ProtocolData::ProtocolData()
-  : data(NULL), totalDataBytes(0u) { }
+namespace {
+// Set of valid values of 8-bit header field, bit N stands for value N
+typedef uint64_t FieldValuesMask[4];
+
+#define FIELD_VALUE_BIT(value, word) \
+  ((value) / 64 == (word) ? static_cast<uint64_t>(1) << ((value) % 64) : 0)
+
+#define FIELD_VALUES_WORD(word) (FIELD_VALUE_BIT(PROTOCOL_VERSION_1, word) | \
+                                 FIELD_VALUE_BIT(PROTOCOL_VERSION_2, word) | \
+                                 FIELD_VALUE_BIT(PROTOCOL_VERSION_3, word) | \
+                                 FIELD_VALUE_BIT(PROTOCOL_VERSION_4, word))
+const FieldValuesMask kValidVersions = {
+  FIELD_VALUES_WORD(0), FIELD_VALUES_WORD(1),
+  FIELD_VALUES_WORD(2), FIELD_VALUES_WORD(3)
+};
+#undef FIELD_VALUES_WORD
+
+#define FIELD_VALUES_WORD(word) (FIELD_VALUE_BIT(SERVICE_TYPE_CONTROL, word) | \
+                                 FIELD_VALUE_BIT(SERVICE_TYPE_RPC, word) | \
+                                 FIELD_VALUE_BIT(SERVICE_TYPE_AUDIO, word) | \
+                                 FIELD_VALUE_BIT(SERVICE_TYPE_NAVI, word) | \
+                                 FIELD_VALUE_BIT(SERVICE_TYPE_BULK, word))
+const FieldValuesMask kValidServiceTypes = {
+  FIELD_VALUES_WORD(0), FIELD_VALUES_WORD(1),
+  FIELD_VALUES_WORD(2), FIELD_VALUES_WORD(3)
+};
+#undef FIELD_VALUES_WORD
+
+#define FIELD_VALUES_WORD(word) \
+  (FIELD_VALUE_BIT(FRAME_DATA_HEART_BEAT, word) | \
+   FIELD_VALUE_BIT(FRAME_DATA_START_SERVICE, word) | \
+   FIELD_VALUE_BIT(FRAME_DATA_START_SERVICE_ACK, word) | \
+   FIELD_VALUE_BIT(FRAME_DATA_START_SERVICE_NACK, word) | \
+   FIELD_VALUE_BIT(FRAME_DATA_END_SERVICE, word) | \
+   FIELD_VALUE_BIT(FRAME_DATA_END_SERVICE_ACK, word) | \
+   FIELD_VALUE_BIT(FRAME_DATA_END_SERVICE_NACK, word) | \
+   FIELD_VALUE_BIT(FRAME_DATA_SERVICE_DATA_ACK, word) | \
+   FIELD_VALUE_BIT(FRAME_DATA_HEART_BEAT_ACK, word))
+// Valid frame data values of each frame type, unknown types have none
+const FieldValuesMask kValidFrameData[FRAME_TYPE_MAX_VALUE + 1] = {
+  // FRAME_TYPE_CONTROL
+  { FIELD_VALUES_WORD(0), FIELD_VALUES_WORD(1),
+    FIELD_VALUES_WORD(2), FIELD_VALUES_WORD(3) },
+  // FRAME_TYPE_SINGLE
+  { FIELD_VALUE_BIT(FRAME_DATA_SINGLE, 0), 0, 0, 0 },
+  // FRAME_TYPE_FIRST
+  { FIELD_VALUE_BIT(FRAME_DATA_FIRST, 0), 0, 0, 0 },
+  // FRAME_TYPE_CONSECUTIVE could have any frame data value
+  { ~static_cast<uint64_t>(0), ~static_cast<uint64_t>(0),
+    ~static_cast<uint64_t>(0), ~static_cast<uint64_t>(0) },
+  { 0, 0, 0, 0 },
+  { 0, 0, 0, 0 },
+  { 0, 0, 0, 0 },
+  { 0, 0, 0, 0 }
+};
+#undef FIELD_VALUES_WORD
+#undef FIELD_VALUE_BIT
+
+// Frame types which data size shall be greater than 0
+const uint32_t kFrameTypesWithPayload =
+    (1u << FRAME_TYPE_SINGLE) | (1u << FRAME_TYPE_CONSECUTIVE);
+// Frame types which message id shall be greater than 0,
+// is not actual for protocol version 1
+const uint32_t kFrameTypesWithMessageId =
+    (1u << FRAME_TYPE_SINGLE) | (1u << FRAME_TYPE_FIRST) |
+    (1u << FRAME_TYPE_CONSECUTIVE);
+
+inline bool ContainsValue(const FieldValuesMask& mask, uint8_t value) {
+  return (mask[value / 64] >> (value % 64)) & 1u;
+}
 
-ProtocolPacket::ProtocolData::~ProtocolData() {
-  delete[] data;
+inline uint32_t ReadBE32(const uint8_t* data) {
+  uint32_t value_be = 0;
+  memcpy(&value_be, data, sizeof(value_be));
+  const uint32_t value = BE_TO_LE32(value_be);
+  return value;
 }
+}  // namespace
+
+ProtocolPacket::ProtocolData::ProtocolData()
+  : data(), totalDataBytes(0u) { }
 
 ProtocolPacket::ProtocolHeader::ProtocolHeader()
   : version(0x00),
@@ -78,20 +152,21 @@ void ProtocolPacket::ProtocolHeader::deserialize(
   if (messageSize < PROTOCOL_HEADER_V1_SIZE) {
     return;
   }
+  // First word holds all 1-byte and shorter fields
+  const uint32_t fields = ReadBE32(message);
   // first 4 bits
-  version = message[0] >> 4u;
+  version = fields >> 28u;
   // 5th bit
-  protection_flag = message[0] & 0x08u;
+  protection_flag = (fields >> 24u) & 0x08u;
   // 6-8 bits
-  frameType = message[0] & 0x07u;
+  frameType = (fields >> 24u) & 0x07u;
 
-  serviceType = message[1];
-  frameData   = message[2];
-  sessionId   = message[3];
+  serviceType = fields >> 16u;
+  frameData   = fields >> 8u;
+  sessionId   = fields;
 
   // FIXME(EZamakhov): usage for FirstFrame message
-  const uint32_t data_size_be = *(reinterpret_cast<const uint32_t*>(message + 4));
-  dataSize = BE_TO_LE32(data_size_be);
+  dataSize = ReadBE32(message + 4);
   switch (version) {
     case PROTOCOL_VERSION_2:
     case PROTOCOL_VERSION_3:
@@ -99,9 +174,7 @@ void ProtocolPacket::ProtocolHeader::deserialize(
         if (messageSize < PROTOCOL_HEADER_V2_SIZE) {
           return;
         }
-        const uint32_t message_id_be =
-            *(reinterpret_cast<const  uint32_t*>(message + 8));
-        messageId = BE_TO_LE32(message_id_be);
+        messageId = ReadBE32(message + 8);
       }
       break;
     default:
@@ -123,83 +196,31 @@ size_t ProtocolPacket::ProtocolHeaderValidator::max_payload_size() const {
 }
 
 RESULT_CODE ProtocolPacket::ProtocolHeaderValidator::validate(const ProtocolHeader& header) const {
-  // Protocol version shall be from 1 to 4
-  switch (header.version) {
-    case PROTOCOL_VERSION_1:
-    case PROTOCOL_VERSION_2:
-    case PROTOCOL_VERSION_3:
-    case PROTOCOL_VERSION_4:
-      break;
-    default:
-      return RESULT_FAIL;
-  }
-  // ServiceType shall be equal 0x0 (Control), 0x07 (RPC), 0x0A (PCM), 0x0B (Video), 0x0F (Bulk)
-  if (ServiceTypeFromByte(header.serviceType) == kInvalidServiceType) {
+  // Frame type shall be 0x00 (Control), 0x01 (Single), 0x02 (First), 0x03 (Consecutive),
+  // other values up to FRAME_TYPE_MAX_VALUE have no valid Frame info values
+  if (header.frameType > FRAME_TYPE_MAX_VALUE) {
     return RESULT_FAIL;
   }
-  // Check frame info for each frame type
-  // Frame type shall be 0x00 (Control), 0x01 (Single), 0x02 (First), 0x03 (Consecutive)
+  const uint32_t frame_type_bit = 1u << header.frameType;
+  // All fields are checked without branches by lookups into value masks
+  // Protocol version shall be from 1 to 4
+  // ServiceType shall be equal 0x0 (Control), 0x07 (RPC), 0x0A (PCM), 0x0B (Video), 0x0F (Bulk)
   // For Control frames Frame info value shall be from 0x00 to 0x06 or 0xFE(Data Ack), 0xFF(HB Ack)
   // For Single and First frames Frame info value shall be equal 0x00
-  switch (header.frameType) {
-    case FRAME_TYPE_CONTROL : {
-        switch (header.frameData) {
-          case FRAME_DATA_HEART_BEAT:
-          case FRAME_DATA_START_SERVICE:
-          case FRAME_DATA_START_SERVICE_ACK:
-          case FRAME_DATA_START_SERVICE_NACK:
-          case FRAME_DATA_END_SERVICE:
-          case FRAME_DATA_END_SERVICE_ACK:
-          case FRAME_DATA_END_SERVICE_NACK:
-          case FRAME_DATA_SERVICE_DATA_ACK:
-          case FRAME_DATA_HEART_BEAT_ACK:
-            break;
-          default:
-            return RESULT_FAIL;
-        }
-        break;
-      }
-    case FRAME_TYPE_SINGLE:
-      if (header.frameData != FRAME_DATA_SINGLE) {
-        return RESULT_FAIL;
-      }
-      break;
-    case FRAME_TYPE_FIRST:
-      if (header.frameData != FRAME_DATA_FIRST) {
-        return RESULT_FAIL;
-      }
-      break;
-    case FRAME_TYPE_CONSECUTIVE:
-      // Could have any FrameInfo value
-      break;
-    default:
-      // All other Frame type is invalid
-      return RESULT_FAIL;
-  }
-  // For Control frames Data Size value shall be less than MTU header
-  // For Single and Consecutive Data Size value shall be greater than 0x00
-  // and shall be less than N (this value will be defined in .ini file)
-  if (header.dataSize > max_payload_size_) {
-    return RESULT_FAIL;
-  }
-  switch (header.frameType) {
-    case FRAME_TYPE_SINGLE:
-    case FRAME_TYPE_CONSECUTIVE:
-      if (header.dataSize <= 0) {
-        return RESULT_FAIL;
-      }
-      break;
-    default:
-      break;
-  }
+  // Consecutive frames could have any FrameInfo value
+  // Data Size value shall be less than N (this value will be defined in .ini file),
+  // for Single and Consecutive frames it shall be greater than 0x00
   // Message ID be equal or greater than 0x01 (not actual for 1 protocol version and Control frames)
-  if (FRAME_TYPE_CONTROL != header.frameType && PROTOCOL_VERSION_1 != header.version
-     && header.messageId <= 0) {
-    // Message ID shall be greater than 0x00, but not implemented in SPT
-    // TODO(EZamakhov): return on fix on mobile side - APPLINK-9990
-    return RESULT_FAIL;
-  }
-  return RESULT_OK;
+  // TODO(EZamakhov): Message ID is not implemented in SPT - APPLINK-9990
+  const bool valid =
+      ContainsValue(kValidVersions, header.version) &
+      ContainsValue(kValidServiceTypes, header.serviceType) &
+      ContainsValue(kValidFrameData[header.frameType], header.frameData) &
+      (header.dataSize <= max_payload_size_) &
+      !((kFrameTypesWithPayload & frame_type_bit) && 0 == header.dataSize) &
+      !((kFrameTypesWithMessageId & frame_type_bit) &&
+        PROTOCOL_VERSION_1 != header.version && 0 == header.messageId);
+  return valid ? RESULT_OK : RESULT_FAIL;
 }
 
 
@@ -258,33 +279,33 @@ RawMessagePtr ProtocolPacket::serializePacket() const {
     header[offset++] = packet_header_.messageId;
   };
 
-  size_t total_packet_size = offset + (packet_data_.data ? packet_data_.totalDataBytes : 0);
-
-  uint8_t *packet = new (std::nothrow) uint8_t[total_packet_size];
-  if (!packet) {
+  const utils::BufferSlice serialized_header(header, offset);
+  if (serialized_header.empty()) {
     return RawMessagePtr();
   }
 
-  memcpy(packet, header, offset);
-  if (packet_data_.data && packet_data_.totalDataBytes) {
-    memcpy(packet + offset, packet_data_.data, packet_data_.totalDataBytes);
+  if (packet_data_.data.empty() || 0 == packet_data_.totalDataBytes) {
+    return utils::MakeShared<RawMessage>(
+        connection_id(), packet_header_.version,
+        serialized_header, packet_header_.serviceType);
   }
 
-  const RawMessagePtr out_message(
-        new RawMessage(
-          connection_id(), packet_header_.version,
-          packet, total_packet_size, packet_header_.serviceType) );
-
-  delete[] packet;
-  return out_message;
+  // Payload is referenced, not copied: transport sends header and payload
+  // one after another
+  return utils::MakeShared<RawMessage>(
+      connection_id(), packet_header_.version,
+      serialized_header,
+      packet_data_.data.Slice(0, packet_data_.totalDataBytes),
+      packet_header_.serviceType);
 }
 
-RESULT_CODE ProtocolPacket::appendData(uint8_t *chunkData,
+RESULT_CODE ProtocolPacket::appendData(const uint8_t *chunkData,
                                        uint32_t chunkDataSize) {
   if (payload_size_ + chunkDataSize <= packet_data_.totalDataBytes) {
     if (chunkData && chunkDataSize > 0) {
-      if (packet_data_.data) {
-        memcpy(packet_data_.data + payload_size_, chunkData, chunkDataSize);
+      if (!packet_data_.data.empty()) {
+        memcpy(packet_data_.data.data() + payload_size_,
+               chunkData, chunkDataSize);
         payload_size_ += chunkDataSize;
         return RESULT_OK;
       }
@@ -313,8 +334,8 @@ bool ProtocolPacket::operator==(const ProtocolPacket& other) const {
       return true;
     }
     // Compare payload data
-    if (packet_data_.data && other.packet_data_.data &&
-        0 == memcmp(packet_data_.data, other.packet_data_.data,
+    if (!packet_data_.data.empty() && !other.packet_data_.data.empty() &&
+        0 == memcmp(packet_data_.data.data(), other.packet_data_.data.data(),
                     packet_data_.totalDataBytes)) {
       return true;
     }
@@ -324,6 +345,13 @@ bool ProtocolPacket::operator==(const ProtocolPacket& other) const {
 
 RESULT_CODE ProtocolPacket::deserializePacket(
     const uint8_t *message, const size_t messageSize) {
+  return deserializePacket(utils::BufferSlice(message, messageSize));
+}
+
+RESULT_CODE ProtocolPacket::deserializePacket(
+    const utils::BufferSlice &message_buffer) {
+  const uint8_t *message = message_buffer.data();
+  const size_t messageSize = message_buffer.size();
   packet_header_.deserialize(message, messageSize);
   const uint8_t offset =
       packet_header_.version == PROTOCOL_VERSION_1 ? PROTOCOL_HEADER_V1_SIZE
@@ -337,16 +365,6 @@ RESULT_CODE ProtocolPacket::deserializePacket(
     dataPayloadSize = messageSize - offset;
   }
 
-  uint8_t *data = NULL;
-  if (dataPayloadSize) {
-    data = new (std::nothrow) uint8_t[dataPayloadSize];
-    if (!data) {
-      return RESULT_FAIL;
-    }
-    memcpy(data, message + offset, dataPayloadSize);
-    payload_size_ = dataPayloadSize;
-  }
-
   if (packet_header_.frameType == FRAME_TYPE_FIRST) {
     payload_size_ = 0;
     const uint8_t *data = message + offset;
@@ -355,12 +373,15 @@ RESULT_CODE ProtocolPacket::deserializePacket(
     total_data_bytes |= data[2] << 8;
     total_data_bytes |= data[3];
     set_total_data_bytes(total_data_bytes);
-    if (0 == packet_data_.data) {
+    if (packet_data_.data.empty()) {
       return RESULT_FAIL;
     }
   } else {
-    delete[] packet_data_.data;
-    packet_data_.data = data;
+    // Payload stays in the storage of incoming message
+    packet_data_.data = message_buffer.Slice(offset, dataPayloadSize);
+    if (dataPayloadSize) {
+      payload_size_ = dataPayloadSize;
+    }
   }
 
   return RESULT_OK;
@@ -403,14 +424,17 @@ uint32_t ProtocolPacket::message_id() const {
 }
 
 uint8_t *ProtocolPacket::data() const {
+  return packet_data_.data.data();
+}
+
+const utils::BufferSlice &ProtocolPacket::buffer() const {
   return packet_data_.data;
 }
 
 void ProtocolPacket::set_total_data_bytes(size_t dataBytes) {
   if (dataBytes) {
-    delete[] packet_data_.data;
-    packet_data_.data = new (std::nothrow) uint8_t[dataBytes];
-    packet_data_.totalDataBytes = packet_data_.data ? dataBytes : 0u;
+    packet_data_.data = utils::BufferSlice(dataBytes);
+    packet_data_.totalDataBytes = packet_data_.data.size();
   }
 }
 
@@ -418,17 +442,19 @@ void ProtocolPacket::set_data(
     const uint8_t *const new_data, const size_t new_data_size) {
   if (new_data_size && new_data) {
     packet_header_.dataSize = packet_data_.totalDataBytes = new_data_size;
-    delete[] packet_data_.data;
-    packet_data_.data = new (std::nothrow) uint8_t[packet_data_.totalDataBytes];
-    if (packet_data_.data) {
-      memcpy(packet_data_.data, new_data, packet_data_.totalDataBytes);
-    } else {
+    packet_data_.data = utils::BufferSlice(new_data, new_data_size);
+    if (packet_data_.data.empty()) {
       // TODO(EZamakhov): add log info about memory problem
       packet_header_.dataSize = packet_data_.totalDataBytes = 0u;
     }
   }
 }
 
+void ProtocolPacket::set_data(const utils::BufferSlice &new_data) {
+  packet_header_.dataSize = packet_data_.totalDataBytes = new_data.size();
+  packet_data_.data = new_data;
+}
+
 uint32_t ProtocolPacket::total_data_bytes() const {
   return packet_data_.totalDataBytes;
 }
@@ -211,6 +211,8 @@ class SSLContextMock : public security_manager::SSLContext {
   MOCK_METHOD4(Encrypt,
       bool (const uint8_t* const, size_t,
           const uint8_t** const, size_t*));
+  MOCK_METHOD3(Encrypt,
+      bool (const uint8_t* const, size_t, ::utils::BufferSlice*));
   MOCK_METHOD4(Decrypt,
       bool (const uint8_t* const, size_t,
           const uint8_t** const, size_t*));
@@ -32,6 +32,7 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <list>
+#include <algorithm>
 
 #include "utils/macro.h"
 #include "protocol_handler/incoming_data_handler.h"
@@ -520,6 +521,87 @@ TEST_F(IncomingDataHandlerTest, MalformedPacket_Mix) {
   }
 }
 
+TEST_F(IncomingDataHandlerTest, Payload_ReferencesTransportBuffer) {
+  const ProtocolPacket packet(
+      uid1, PROTOCOL_VERSION_3, PROTECTION_OFF, FRAME_TYPE_SINGLE,
+      kMobileNav, FRAME_DATA_SINGLE, some_session_id, some_data2_size,
+      some_message_id, some_data2);
+  AppendPacketToTMData(packet);
+  AppendPacketToTMData(packet);
+  const RawMessage tm_message(uid1, 0, tm_data.data(), tm_data.size());
+  actual_frames = data_handler.ProcessData(tm_message, &result_code,
+                                           &malformed_occurs);
+  EXPECT_EQ(RESULT_OK, result_code);
+  ASSERT_EQ(2u, actual_frames.size());
+  const uint8_t* tm_begin = tm_message.data();
+  const uint8_t* tm_end = tm_begin + tm_message.data_size();
+  for (FrameList::const_iterator it = actual_frames.begin();
+       it != actual_frames.end(); ++it) {
+    EXPECT_EQ(packet, **it);
+    // Payload is not copied out of transport message
+    EXPECT_GE((*it)->data(), tm_begin);
+    EXPECT_LE((*it)->data() + (*it)->data_size(), tm_end);
+  }
+}
+
+TEST_F(IncomingDataHandlerTest, Payload_SplitBetweenTransportMessages) {
+  const ProtocolPacket packet(
+      uid1, PROTOCOL_VERSION_3, PROTECTION_OFF, FRAME_TYPE_SINGLE,
+      kMobileNav, FRAME_DATA_SINGLE, some_session_id, some_data2_size,
+      some_message_id, some_data2);
+  const size_t packets_count = 10;
+  for (size_t i = 0; i < packets_count; ++i) {
+    AppendPacketToTMData(packet);
+  }
+  // Portions do not match frame bounds
+  const size_t portion_size = 100;
+  FrameList frames;
+  for (size_t offset = 0; offset < tm_data.size(); offset += portion_size) {
+    ProcessData(uid1, &tm_data[offset],
+                std::min(portion_size, tm_data.size() - offset));
+    EXPECT_EQ(RESULT_OK, result_code);
+    EXPECT_EQ(0u, malformed_occurs);
+    frames.insert(frames.end(), actual_frames.begin(), actual_frames.end());
+  }
+  EXPECT_EQ(packets_count, frames.size());
+  for (FrameList::const_iterator it = frames.begin(); it != frames.end(); ++it) {
+    EXPECT_EQ(packet, **it);
+  }
+}
+
+TEST_F(IncomingDataHandlerTest, Payload_OnlyStraddlingFrameCopied) {
+  const ProtocolPacket packet(
+      uid1, PROTOCOL_VERSION_3, PROTECTION_OFF, FRAME_TYPE_SINGLE,
+      kRpc, FRAME_DATA_SINGLE, some_session_id, some_data_size,
+      some_message_id, some_data);
+  const size_t packets_count = 100;
+  for (size_t i = 0; i < packets_count; ++i) {
+    AppendPacketToTMData(packet);
+  }
+  // Split in the middle of the first frame
+  const size_t first_chunk_size = 5;
+  ProcessData(uid1, &tm_data[0], first_chunk_size);
+  EXPECT_EQ(RESULT_OK, result_code);
+  EXPECT_TRUE(actual_frames.empty());
+
+  const RawMessage tm_message(uid1, 0, &tm_data[first_chunk_size],
+                              tm_data.size() - first_chunk_size);
+  actual_frames = data_handler.ProcessData(tm_message, &result_code,
+                                           &malformed_occurs);
+  EXPECT_EQ(RESULT_OK, result_code);
+  EXPECT_EQ(0u, malformed_occurs);
+  ASSERT_EQ(packets_count, actual_frames.size());
+  const uint8_t* tm_begin = tm_message.data();
+  const uint8_t* tm_end = tm_begin + tm_message.data_size();
+  FrameList::const_iterator it = actual_frames.begin();
+  EXPECT_EQ(packet, **it);
+  for (++it; it != actual_frames.end(); ++it) {
+    EXPECT_EQ(packet, **it);
+    EXPECT_GE((*it)->data(), tm_begin);
+    EXPECT_LE((*it)->data() + (*it)->data_size(), tm_end);
+  }
+}
+
 // TODO(EZamakhov): add tests for handling 2+ connection data
 
 }  // namespace protocol_handler_test
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string>
+
+#include "protocol_handler/payload_compression.h"
+
+namespace test {
+namespace components {
+namespace protocol_handler_test {
+using namespace protocol_handler;
+
+namespace {
+std::string CapabilitiesJson() {
+  std::string json("{\"success\":true,\"resultCode\":\"SUCCESS\","
+                   "\"displayCapabilities\":{\"textFields\":[");
+  for (int i = 0; i < 20; ++i) {
+    json += "{\"name\":\"mainField1\",\"characterSet\":\"TYPE2SET\","
+            "\"width\":500,\"rows\":1},";
+  }
+  json += "]}}";
+  return json;
+}
+
+const uint8_t* Bytes(const std::string& str) {
+  return reinterpret_cast<const uint8_t*>(str.data());
+}
+
+std::string ToString(const utils::BufferSlice& slice) {
+  return std::string(reinterpret_cast<const char*>(slice.data()),
+                     slice.size());
+}
+}  // namespace
+
+TEST(PayloadCompressionTest, SmallPayload_IsStored) {
+  const std::string data("{\"success\":true}");
+  utils::BufferSlice encoded;
+  ASSERT_TRUE(compression::Compress(Bytes(data), data.size(), 6, &encoded));
+  ASSERT_EQ(data.size() + 1, encoded.size());
+  EXPECT_EQ(compression::kEncodingStored, encoded.data()[0]);
+
+  utils::BufferSlice decoded;
+  ASSERT_TRUE(compression::Decompress(encoded, data.size(), &decoded));
+  EXPECT_EQ(data, ToString(decoded));
+}
+
+TEST(PayloadCompressionTest, Json_IsDeflatedAndRestored) {
+  const std::string data = CapabilitiesJson();
+  utils::BufferSlice encoded;
+  ASSERT_TRUE(compression::Compress(Bytes(data), data.size(), 6, &encoded));
+  EXPECT_EQ(compression::kEncodingDeflated, encoded.data()[0]);
+  EXPECT_LT(encoded.size(), data.size() / 4);
+
+  utils::BufferSlice decoded;
+  ASSERT_TRUE(compression::Decompress(
+      encoded, compression::kMaximumInflatedSize, &decoded));
+  EXPECT_EQ(data, ToString(decoded));
+}
+
+TEST(PayloadCompressionTest, IncompressiblePayload_IsStored) {
+  std::string data(4096, '\0');
+  srand(42);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(rand());
+  }
+  utils::BufferSlice encoded;
+  ASSERT_TRUE(compression::Compress(Bytes(data), data.size(), 9, &encoded));
+  EXPECT_EQ(compression::kEncodingStored, encoded.data()[0]);
+
+  utils::BufferSlice decoded;
+  ASSERT_TRUE(compression::Decompress(
+      encoded, compression::kMaximumInflatedSize, &decoded));
+  EXPECT_EQ(data, ToString(decoded));
+}
+
+TEST(PayloadCompressionTest, PayloadBiggerThanLimit_IsRejected) {
+  const std::string data(100000, 'a');
+  utils::BufferSlice encoded;
+  ASSERT_TRUE(compression::Compress(Bytes(data), data.size(), 6, &encoded));
+  EXPECT_EQ(compression::kEncodingDeflated, encoded.data()[0]);
+
+  utils::BufferSlice decoded;
+  EXPECT_FALSE(compression::Decompress(encoded, data.size() - 1, &decoded));
+  EXPECT_TRUE(compression::Decompress(encoded, data.size(), &decoded));
+  EXPECT_EQ(data.size(), decoded.size());
+}
+
+TEST(PayloadCompressionTest, MalformedPayload_IsRejected) {
+  const std::string data = CapabilitiesJson();
+  utils::BufferSlice encoded;
+  ASSERT_TRUE(compression::Compress(Bytes(data), data.size(), 6, &encoded));
+  utils::BufferSlice decoded;
+
+  // Truncated stream
+  EXPECT_FALSE(compression::Decompress(
+      encoded.Slice(0, encoded.size() / 2),
+      compression::kMaximumInflatedSize, &decoded));
+  // Unknown encoding
+  encoded.data()[0] = 0x7F;
+  EXPECT_FALSE(compression::Decompress(
+      encoded, compression::kMaximumInflatedSize, &decoded));
+  // No encoding at all
+  EXPECT_FALSE(compression::Decompress(
+      utils::BufferSlice(), compression::kMaximumInflatedSize, &decoded));
+}
+
+}  // namespace protocol_handler_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <iostream>
+#include <vector>
+
+#include "utils/byte_order.h"
+#include "utils/date_time.h"
+#include "protocol_handler/protocol_packet.h"
+
+namespace test {
+namespace components {
+namespace protocol_handler_test {
+using namespace protocol_handler;
+
+namespace {
+typedef ProtocolPacket::ProtocolHeader ProtocolHeader;
+typedef ProtocolPacket::ProtocolHeaderValidator ProtocolHeaderValidator;
+
+const size_t kMaxPayloadSize = MAXIMUM_FRAME_DATA_SIZE - PROTOCOL_HEADER_V2_SIZE;
+
+/*
+ * Byte by byte header parsing ProtocolHeader::deserialize was implemented
+ * with, kept as a reference for the word based one
+ */
+void ReferenceDeserialize(const uint8_t* message, const size_t message_size,
+                          ProtocolHeader* header) {
+  if (message_size < PROTOCOL_HEADER_V1_SIZE) {
+    return;
+  }
+  header->version = message[0] >> 4u;
+  header->protection_flag = message[0] & 0x08u;
+  header->frameType = message[0] & 0x07u;
+  header->serviceType = message[1];
+  header->frameData = message[2];
+  header->sessionId = message[3];
+  header->dataSize = (static_cast<uint32_t>(message[4]) << 24u) |
+                     (message[5] << 16u) | (message[6] << 8u) | message[7];
+  switch (header->version) {
+    case PROTOCOL_VERSION_2:
+    case PROTOCOL_VERSION_3:
+    case PROTOCOL_VERSION_4:
+      if (message_size < PROTOCOL_HEADER_V2_SIZE) {
+        return;
+      }
+      header->messageId = (static_cast<uint32_t>(message[8]) << 24u) |
+                          (message[9] << 16u) | (message[10] << 8u) |
+                          message[11];
+      break;
+    default:
+      header->messageId = 0;
+      break;
+  }
+}
+
+/*
+ * Branch per field validation ProtocolHeaderValidator::validate was
+ * implemented with, kept as a reference for the mask based one
+ */
+RESULT_CODE ReferenceValidate(const ProtocolHeader& header,
+                              const size_t max_payload_size) {
+  switch (header.version) {
+    case PROTOCOL_VERSION_1:
+    case PROTOCOL_VERSION_2:
+    case PROTOCOL_VERSION_3:
+    case PROTOCOL_VERSION_4:
+      break;
+    default:
+      return RESULT_FAIL;
+  }
+  switch (header.serviceType) {
+    case SERVICE_TYPE_CONTROL:
+    case SERVICE_TYPE_RPC:
+    case SERVICE_TYPE_AUDIO:
+    case SERVICE_TYPE_NAVI:
+    case SERVICE_TYPE_BULK:
+      break;
+    default:
+      return RESULT_FAIL;
+  }
+  switch (header.frameType) {
+    case FRAME_TYPE_CONTROL:
+      switch (header.frameData) {
+        case FRAME_DATA_HEART_BEAT:
+        case FRAME_DATA_START_SERVICE:
+        case FRAME_DATA_START_SERVICE_ACK:
+        case FRAME_DATA_START_SERVICE_NACK:
+        case FRAME_DATA_END_SERVICE:
+        case FRAME_DATA_END_SERVICE_ACK:
+        case FRAME_DATA_END_SERVICE_NACK:
+        case FRAME_DATA_SERVICE_DATA_ACK:
+        case FRAME_DATA_HEART_BEAT_ACK:
+          break;
+        default:
+          return RESULT_FAIL;
+      }
+      break;
+    case FRAME_TYPE_SINGLE:
+      if (header.frameData != FRAME_DATA_SINGLE) {
+        return RESULT_FAIL;
+      }
+      break;
+    case FRAME_TYPE_FIRST:
+      if (header.frameData != FRAME_DATA_FIRST) {
+        return RESULT_FAIL;
+      }
+      break;
+    case FRAME_TYPE_CONSECUTIVE:
+      break;
+    default:
+      return RESULT_FAIL;
+  }
+  if (header.dataSize > max_payload_size) {
+    return RESULT_FAIL;
+  }
+  switch (header.frameType) {
+    case FRAME_TYPE_SINGLE:
+    case FRAME_TYPE_CONSECUTIVE:
+      if (header.dataSize <= 0) {
+        return RESULT_FAIL;
+      }
+      break;
+    default:
+      break;
+  }
+  if (FRAME_TYPE_CONTROL != header.frameType &&
+      PROTOCOL_VERSION_1 != header.version && header.messageId <= 0) {
+    return RESULT_FAIL;
+  }
+  return RESULT_OK;
+}
+
+void ExpectEqualHeaders(const ProtocolHeader& expected,
+                        const ProtocolHeader& actual) {
+  EXPECT_EQ(expected.version, actual.version);
+  EXPECT_EQ(expected.protection_flag, actual.protection_flag);
+  EXPECT_EQ(expected.frameType, actual.frameType);
+  EXPECT_EQ(expected.serviceType, actual.serviceType);
+  EXPECT_EQ(expected.frameData, actual.frameData);
+  EXPECT_EQ(expected.sessionId, actual.sessionId);
+  EXPECT_EQ(expected.dataSize, actual.dataSize);
+  EXPECT_EQ(expected.messageId, actual.messageId);
+}
+}  // namespace
+
+class ProtocolHeaderBenchmarkTest : public ::testing::Test {
+ protected:
+  void SetUp() OVERRIDE {
+    validator.set_max_payload_size(kMaxPayloadSize);
+    random_state = 0x2015u;
+    // Synthetic capture: mostly RPC and video streaming frames
+    // with heartbeats and some garbage in between
+    for (uint32_t i = 0; i < kCaptureFramesCount; ++i) {
+      uint8_t header[PROTOCOL_HEADER_V2_SIZE];
+      const uint32_t kind = NextRandom() % 10;
+      if (kind < 9) {
+        const uint8_t frame_type = kind < 3 ? FRAME_TYPE_SINGLE :
+            (kind < 8 ? FRAME_TYPE_CONSECUTIVE : FRAME_TYPE_CONTROL);
+        const uint8_t service_type = kind < 3 ? SERVICE_TYPE_RPC :
+            (kind < 8 ? SERVICE_TYPE_NAVI : SERVICE_TYPE_CONTROL);
+        const uint8_t frame_data = FRAME_TYPE_CONSECUTIVE == frame_type ?
+            static_cast<uint8_t>(NextRandom()) : FRAME_DATA_HEART_BEAT;
+        const uint32_t data_size = FRAME_TYPE_CONTROL == frame_type ? 0 :
+            1 + NextRandom() % kMaxPayloadSize;
+        const ProtocolPacket packet(
+            1, PROTOCOL_VERSION_3, PROTECTION_OFF, frame_type, service_type,
+            frame_data, 1, data_size, i + 1, NULL);
+        const RawMessagePtr raw = packet.serializePacket();
+        memcpy(header, raw->fragment(0).data(), PROTOCOL_HEADER_V2_SIZE);
+      } else {
+        for (size_t byte = 0; byte < PROTOCOL_HEADER_V2_SIZE; ++byte) {
+          header[byte] = static_cast<uint8_t>(NextRandom());
+        }
+      }
+      capture.insert(capture.end(), header, header + PROTOCOL_HEADER_V2_SIZE);
+    }
+  }
+
+  uint32_t NextRandom() {
+    random_state = random_state * 1103515245u + 12345u;
+    return random_state >> 8;
+  }
+
+  static const uint32_t kCaptureFramesCount = 10000;
+  static const uint32_t kBenchmarkRuns = 100;
+  ProtocolHeaderValidator validator;
+  uint32_t random_state;
+  std::vector<uint8_t> capture;
+};
+
+TEST_F(ProtocolHeaderBenchmarkTest, Capture_FastPathMatchesReference) {
+  for (size_t offset = 0; offset < capture.size();
+       offset += PROTOCOL_HEADER_V2_SIZE) {
+    ProtocolHeader expected;
+    ReferenceDeserialize(&capture[offset], PROTOCOL_HEADER_V2_SIZE, &expected);
+    ProtocolHeader actual;
+    actual.deserialize(&capture[offset], PROTOCOL_HEADER_V2_SIZE);
+    ExpectEqualHeaders(expected, actual);
+    EXPECT_EQ(ReferenceValidate(expected, kMaxPayloadSize),
+              validator.validate(actual));
+  }
+}
+
+TEST_F(ProtocolHeaderBenchmarkTest, AllFieldValues_FastPathMatchesReference) {
+  const uint32_t data_sizes[] = {0u, 1u, kMaxPayloadSize, kMaxPayloadSize + 1};
+  // All valid frame types, unused ones of 3-bit field and out of range one
+  const uint8_t frame_types[] = {0u, 1u, 2u, 3u, 4u, 7u, 8u, 0xFFu};
+  ProtocolHeader header;
+  for (uint32_t version = 0; version <= PROTOCOL_VERSION_MAX; ++version) {
+    header.version = version;
+    for (size_t type = 0; type < ARRAYSIZE(frame_types); ++type) {
+      header.frameType = frame_types[type];
+      for (uint32_t frame_data = 0; frame_data <= 0xFF; ++frame_data) {
+        header.frameData = frame_data;
+        for (uint32_t service_type = 0; service_type <= 0x10; ++service_type) {
+          header.serviceType = service_type;
+          for (size_t size = 0; size < ARRAYSIZE(data_sizes); ++size) {
+            header.dataSize = data_sizes[size];
+            for (uint32_t message_id = 0; message_id < 2; ++message_id) {
+              header.messageId = message_id;
+              ASSERT_EQ(ReferenceValidate(header, kMaxPayloadSize),
+                        validator.validate(header));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(ProtocolHeaderBenchmarkTest, Capture_CompareParsingTime) {
+  // Sum of results keeps parsing from being optimized out
+  uint32_t reference_checksum = 0;
+  const TimevalStruct reference_start = date_time::DateTime::getCurrentTime();
+  for (uint32_t run = 0; run < kBenchmarkRuns; ++run) {
+    for (size_t offset = 0; offset < capture.size();
+         offset += PROTOCOL_HEADER_V2_SIZE) {
+      ProtocolHeader header;
+      ReferenceDeserialize(&capture[offset], PROTOCOL_HEADER_V2_SIZE, &header);
+      reference_checksum += ReferenceValidate(header, kMaxPayloadSize) +
+                            header.dataSize;
+    }
+  }
+  const int64_t reference_usecs = date_time::DateTime::getuSecs(
+      date_time::DateTime::Sub(date_time::DateTime::getCurrentTime(),
+                               reference_start));
+
+  uint32_t fast_checksum = 0;
+  const TimevalStruct fast_start = date_time::DateTime::getCurrentTime();
+  for (uint32_t run = 0; run < kBenchmarkRuns; ++run) {
+    for (size_t offset = 0; offset < capture.size();
+         offset += PROTOCOL_HEADER_V2_SIZE) {
+      ProtocolHeader header;
+      header.deserialize(&capture[offset], PROTOCOL_HEADER_V2_SIZE);
+      fast_checksum += validator.validate(header) + header.dataSize;
+    }
+  }
+  const int64_t fast_usecs = date_time::DateTime::getuSecs(
+      date_time::DateTime::Sub(date_time::DateTime::getCurrentTime(),
+                               fast_start));
+
+  EXPECT_EQ(reference_checksum, fast_checksum);
+  // Timings depend on build and load, so they are reported only
+  std::cout << kBenchmarkRuns * kCaptureFramesCount << " headers parsed: "
+            << "reference " << reference_usecs << " us, "
+            << "fast path " << fast_usecs << " us" << std::endl;
+  RecordProperty("reference_usecs", static_cast<int>(reference_usecs));
+  RecordProperty("fast_path_usecs", static_cast<int>(fast_usecs));
+}
+
+}  // namespace protocol_handler_test
+}  // namespace components
+}  // namespace test
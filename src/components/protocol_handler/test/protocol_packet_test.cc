@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+
+#include "utils/macro.h"
+#include "protocol_handler/protocol_packet.h"
+
+namespace test {
+namespace components {
+namespace protocol_handler_test {
+using namespace protocol_handler;
+
+class ProtocolPacketTest : public ::testing::Test {
+ protected:
+  void SetUp() OVERRIDE {
+    connection_id = 0x1234560;
+    session_id = 0x05;
+    message_id = 0xABCDEF0;
+  }
+  // First frame payload holds total size and frames count in big endian
+  RawMessagePtr SerializeFirstFrame(uint32_t total_size, uint32_t frames_count) {
+    uint8_t first_frame_payload[FIRST_FRAME_DATA_SIZE];
+    first_frame_payload[0] = total_size >> 24;
+    first_frame_payload[1] = total_size >> 16;
+    first_frame_payload[2] = total_size >> 8;
+    first_frame_payload[3] = total_size;
+    first_frame_payload[4] = frames_count >> 24;
+    first_frame_payload[5] = frames_count >> 16;
+    first_frame_payload[6] = frames_count >> 8;
+    first_frame_payload[7] = frames_count;
+    const ProtocolPacket first_frame(
+        connection_id, PROTOCOL_VERSION_3, PROTECTION_OFF, FRAME_TYPE_FIRST,
+        kBulk, FRAME_DATA_FIRST, session_id, FIRST_FRAME_DATA_SIZE,
+        message_id, first_frame_payload);
+    return first_frame.serializePacket();
+  }
+  ConnectionID connection_id;
+  uint8_t session_id;
+  uint32_t message_id;
+};
+
+TEST_F(ProtocolPacketTest, FirstFrame_PreallocatesWholeMessage) {
+  const uint32_t total_size = 3000u;
+  const RawMessagePtr raw_first_frame = SerializeFirstFrame(total_size, 3u);
+  ASSERT_TRUE(raw_first_frame.valid());
+  ProtocolPacket packet(connection_id);
+  EXPECT_EQ(RESULT_OK, packet.deserializePacket(raw_first_frame->buffer()));
+  EXPECT_EQ(FRAME_TYPE_FIRST, packet.frame_type());
+  EXPECT_EQ(total_size, packet.total_data_bytes());
+  EXPECT_EQ(total_size, packet.buffer().size());
+  EXPECT_EQ(0u, packet.payload_size());
+}
+
+TEST_F(ProtocolPacketTest, AppendData_WritesChunksInPlace) {
+  const uint32_t chunk_size = 1000u;
+  const uint32_t chunks_count = 3u;
+  const RawMessagePtr raw_first_frame =
+      SerializeFirstFrame(chunk_size * chunks_count, chunks_count);
+  ASSERT_TRUE(raw_first_frame.valid());
+  ProtocolPacket packet(connection_id);
+  ASSERT_EQ(RESULT_OK, packet.deserializePacket(raw_first_frame->buffer()));
+  const uint8_t* const storage = packet.data();
+  ASSERT_TRUE(storage != NULL);
+
+  std::vector<uint8_t> chunk(chunk_size);
+  for (uint32_t i = 0; i < chunks_count; ++i) {
+    std::fill(chunk.begin(), chunk.end(), static_cast<uint8_t>(i + 1));
+    EXPECT_EQ(RESULT_OK, packet.appendData(&chunk[0], chunk_size));
+    // Storage is never reallocated
+    EXPECT_EQ(storage, packet.data());
+    EXPECT_EQ((i + 1) * chunk_size, packet.payload_size());
+  }
+  for (uint32_t i = 0; i < chunks_count; ++i) {
+    EXPECT_EQ(i + 1, storage[i * chunk_size]);
+    EXPECT_EQ(i + 1, storage[(i + 1) * chunk_size - 1]);
+  }
+  // Message is complete, no room for more data
+  EXPECT_EQ(RESULT_FAIL, packet.appendData(&chunk[0], 1u));
+}
+
+TEST_F(ProtocolPacketTest, AppendData_Overflow) {
+  const RawMessagePtr raw_first_frame = SerializeFirstFrame(100u, 1u);
+  ASSERT_TRUE(raw_first_frame.valid());
+  ProtocolPacket packet(connection_id);
+  ASSERT_EQ(RESULT_OK, packet.deserializePacket(raw_first_frame->buffer()));
+  std::vector<uint8_t> chunk(101u);
+  EXPECT_EQ(RESULT_FAIL, packet.appendData(&chunk[0], chunk.size()));
+  EXPECT_EQ(0u, packet.payload_size());
+}
+
+TEST_F(ProtocolPacketTest, SerializePacket_ReferencesPayload) {
+  std::vector<uint8_t> payload(2000u);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i);
+  }
+  const utils::BufferSlice message(&payload[0], payload.size());
+  const utils::BufferSlice frame_payload = message.Slice(500u, 1000u);
+  ProtocolPacket packet(
+      connection_id, PROTOCOL_VERSION_3, PROTECTION_OFF,
+      FRAME_TYPE_CONSECUTIVE, kBulk, FRAME_DATA_LAST_CONSECUTIVE, session_id,
+      0u, message_id, NULL);
+  packet.set_data(frame_payload);
+  EXPECT_EQ(frame_payload.size(), packet.data_size());
+
+  const RawMessagePtr raw_frame = packet.serializePacket();
+  ASSERT_TRUE(raw_frame.valid());
+  ASSERT_EQ(2u, raw_frame->fragments_count());
+  EXPECT_EQ(PROTOCOL_HEADER_V2_SIZE, raw_frame->fragment(0).size());
+  // Payload is not copied into frame
+  EXPECT_EQ(frame_payload.data(), raw_frame->fragment(1).data());
+  EXPECT_EQ(PROTOCOL_HEADER_V2_SIZE + frame_payload.size(),
+            raw_frame->data_size());
+
+  // Merged on demand into single buffer
+  ProtocolPacket sent_packet(connection_id);
+  ASSERT_EQ(RESULT_OK, sent_packet.deserializePacket(raw_frame->buffer()));
+  EXPECT_EQ(1u, raw_frame->fragments_count());
+  EXPECT_EQ(frame_payload.size(), sent_packet.data_size());
+  EXPECT_EQ(0, memcmp(&payload[500], sent_packet.data(),
+                      frame_payload.size()));
+}
+
+TEST_F(ProtocolPacketTest, SerializePacket_EmptyPayloadSingleFragment) {
+  const ProtocolPacket packet(
+      connection_id, PROTOCOL_VERSION_3, PROTECTION_OFF, FRAME_TYPE_CONTROL,
+      kControl, FRAME_DATA_HEART_BEAT, session_id, 0u, message_id, NULL);
+  const RawMessagePtr raw_frame = packet.serializePacket();
+  ASSERT_TRUE(raw_frame.valid());
+  EXPECT_EQ(1u, raw_frame->fragments_count());
+  EXPECT_EQ(PROTOCOL_HEADER_V2_SIZE, raw_frame->data_size());
+}
+
+}  // namespace protocol_handler_test
+}  // namespace components
+}  // namespace test
@@ -35,6 +35,7 @@
 import QtQuick 1.1
 import com.ford.sdl.hmi.dbus_adapter 1.0
 import com.ford.sdl.hmi.log4cxx 1.0
+import com.ford.sdl.hmi.image_cache 1.0
 import "./controls"
 import "./views"
 import "./hmi_api" as HmiApi
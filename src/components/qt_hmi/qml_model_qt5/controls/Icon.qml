@@ -41,6 +41,9 @@ Item {
     Image {
         anchors.fill: parent
         source: url(parent.source)
+        // Provider keeps decoded images and notices files overwritten by
+        // PutFile, engine cache keyed by url would show stale ones
+        cache: false
 
         function image(turnIcon) {
             if (turnIcon && turnIcon.imageType === Common.ImageType.STATIC) {
@@ -51,8 +54,9 @@ Item {
         }
 
         function url(turnIcon) {
-            if (turnIcon && turnIcon.imageType === Common.ImageType.DYNAMIC) {
-                return turnIcon.value;
+            if (turnIcon && turnIcon.imageType === Common.ImageType.DYNAMIC
+                    && turnIcon.value) {
+                return "image://sdlimages/" + turnIcon.value;
             } else {
                 return "";
             }
@@ -0,0 +1,92 @@
+/*
+ * \file app_image_provider.cc
+ * \brief AppImageProvider class source file.
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "app_image_provider.h"
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QUrl>
+
+namespace {
+// Decoded images of a few screens of applications fit into it
+const int kMaxCacheKilobytes = 32 * 1024;
+}  // namespace
+
+const char AppImageProvider::kName[] = "sdlimages";
+
+AppImageProvider::AppImageProvider()
+    : ImageProvider(ImageProvider::Image),
+      images_(kMaxCacheKilobytes) {
+}
+
+QImage AppImageProvider::requestImage(const QString& id, QSize* size,
+                                      const QSize& requested_size) {
+  const QString path = id.startsWith("file:") ? QUrl(id).toLocalFile() : id;
+  const QFileInfo file(path);
+  if (!file.exists()) {
+    return QImage();
+  }
+  const QString key = path + "#" + QString::number(requested_size.width())
+      + "x" + QString::number(requested_size.height());
+  {
+    QMutexLocker locker(&lock_);
+    const CachedImage* cached = images_.object(key);
+    if (cached && cached->modified == file.lastModified()
+        && cached->file_size == file.size()) {
+      if (size) {
+        *size = cached->image.size();
+      }
+      return cached->image;
+    }
+  }
+
+  QImage image(path);
+  if (!image.isNull() && requested_size.isValid()) {
+    image = image.scaled(requested_size, Qt::KeepAspectRatio,
+                         Qt::SmoothTransformation);
+  }
+  if (size) {
+    *size = image.size();
+  }
+  if (!image.isNull()) {
+    CachedImage* cached = new CachedImage;
+    cached->modified = file.lastModified();
+    cached->file_size = file.size();
+    cached->image = image;
+    QMutexLocker locker(&lock_);
+    // Cache takes ownership, also of rejected too large image
+    images_.insert(key, cached, qMax(1, image.byteCount() / 1024));
+  }
+  return image;
+}
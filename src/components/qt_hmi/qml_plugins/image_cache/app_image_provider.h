@@ -0,0 +1,82 @@
+/*
+ * \file app_image_provider.h
+ * \brief AppImageProvider class header file.
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_QT_HMI_QML_PLUGINS_IMAGE_CACHE_APP_IMAGE_PROVIDER_H_
+#define SRC_COMPONENTS_QT_HMI_QML_PLUGINS_IMAGE_CACHE_APP_IMAGE_PROVIDER_H_
+
+#include "qt_version.h"
+
+#include <QtCore/QCache>
+#include <QtCore/QDateTime>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtGui/QImage>
+
+#if QT_4
+#  include <QtDeclarative/QDeclarativeImageProvider>
+typedef QDeclarativeImageProvider ImageProvider;
+#elif QT_5
+#  include <QtQuick/QQuickImageProvider>
+typedef QQuickImageProvider ImageProvider;
+#endif  // QT_VERSION
+
+/**
+ * Decodes images of applications (icons, soft button and choice images)
+ * once and serves them from memory to every view showing them.
+ * Applications overwrite files by PutFile under the same name, so cached
+ * image is decoded again when modification time or size of file changes.
+ * Images are requested as "image://sdlimages/<path of file>".
+ */
+class AppImageProvider : public ImageProvider {
+ public:
+  static const char kName[];
+
+  AppImageProvider();
+  virtual QImage requestImage(const QString& id, QSize* size,
+                              const QSize& requested_size);
+
+ private:
+  struct CachedImage {
+    QDateTime modified;
+    qint64 file_size;
+    QImage image;
+  };
+
+  // Requests come from several loader threads
+  QMutex lock_;
+  // Cost of image is its size in kilobytes
+  QCache<QString, CachedImage> images_;
+};
+
+#endif  // SRC_COMPONENTS_QT_HMI_QML_PLUGINS_IMAGE_CACHE_APP_IMAGE_PROVIDER_H_
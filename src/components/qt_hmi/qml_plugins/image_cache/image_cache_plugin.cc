@@ -0,0 +1,59 @@
+/*
+ * \file image_cache_plugin.cc
+ * \brief ImageCachePlugin class source file.
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "image_cache_plugin.h"
+
+#if QT_4
+#  include <QtDeclarative/QDeclarativeEngine>
+#elif QT_5
+#  include <QtQml/QQmlEngine>
+#endif  // QT_VERSION
+
+#include "app_image_provider.h"
+
+void ImageCachePlugin::registerTypes(const char* uri) {
+  // @uri com.ford.sdl.hmi.image_cache
+  // Module has no types, only image provider
+  Q_UNUSED(uri);
+}
+
+void ImageCachePlugin::initializeEngine(Engine* engine, const char* uri) {
+  Q_UNUSED(uri);
+  // Engine takes ownership of provider
+  engine->addImageProvider(AppImageProvider::kName, new AppImageProvider());
+}
+
+#if QT_4
+Q_EXPORT_PLUGIN2(ImageCache, ImageCachePlugin)
+#endif  // QT_4
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_RESUMPTION_INCLUDE_RESUMPTION_APPLICATION_STORAGE_H_
+#define SRC_COMPONENTS_RESUMPTION_INCLUDE_RESUMPTION_APPLICATION_STORAGE_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/macro.h"
+#include "utils/lock.h"
+#include "json/json.h"
+
+namespace resumption {
+
+/**
+ * @brief Resumption records of applications keyed by device and application
+ * id. Records are kept in append-only log, so saving of one application
+ * writes only its record. Log is compacted when it is twice as big as live
+ * records, compacted log replaces the old one by rename.
+ */
+class ApplicationStorage {
+ public:
+  // Device id and application id
+  typedef std::pair<std::string, std::string> ApplicationKey;
+  typedef std::vector<ApplicationKey> ApplicationKeys;
+  typedef std::vector<std::pair<ApplicationKey, Json::Value> >
+      ApplicationRecords;
+
+  /**
+   * @param file_name path to log file
+   */
+  explicit ApplicationStorage(const std::string& file_name);
+  ~ApplicationStorage();
+
+  /**
+   * @brief Indexes records of log by keys, data of records is parsed
+   * only by Get. Broken tail left by crash is dropped
+   * @return false if existing log can't be read or rewritten
+   */
+  bool Load();
+
+  /**
+   * @brief Gets record of application
+   * @param data record
+   * @return false if there is no record for application
+   */
+  bool Get(const std::string& device_id, const std::string& app_id,
+           Json::Value* data) const;
+
+  /**
+   * @brief Replaces record of application, record is synced to disk
+   * before return. Record equal to saved one is not written again
+   * @return true if record was written
+   */
+  bool Save(const std::string& device_id, const std::string& app_id,
+            const Json::Value& data);
+
+  /**
+   * @brief Replaces records of several applications by single write with
+   * single sync, so saving many applications costs one fsync. Records equal
+   * to saved ones are not written again
+   * @return true if all records were written
+   */
+  bool Save(const ApplicationRecords& records);
+
+  /**
+   * @brief Removes record of application
+   * @return true if record was removed or was absent
+   */
+  bool Remove(const std::string& device_id, const std::string& app_id);
+
+  /**
+   * @brief Gets keys of all applications having record
+   */
+  void Keys(ApplicationKeys* keys) const;
+
+  /**
+   * @return number of applications having record
+   */
+  size_t size() const;
+
+  /**
+   * @brief Rewrites log keeping only live records
+   * @return true on success
+   */
+  bool Compact();
+
+ private:
+  typedef ApplicationKey Key;
+  // Log line of each live record
+  typedef std::map<Key, std::string> Records;
+
+  struct Change {
+    Key key;
+    std::string line;
+    // false if line removes record
+    bool live;
+  };
+  typedef std::vector<Change> Changes;
+
+  /**
+   * @brief Writes line to log and applies it to records
+   * @param live false if line removes record
+   */
+  bool Append(const Key& key, const std::string& line, bool live);
+
+  /**
+   * @brief Writes lines of all changes to log with single sync and applies
+   * them to records
+   */
+  bool Append(const Changes& changes);
+  bool CompactLocked();
+  bool OpenLog();
+  void CloseLog();
+
+  const std::string file_name_;
+  int log_fd_;
+  Records records_;
+  size_t live_size_;
+  size_t log_size_;
+  mutable sync_primitives::Lock lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(ApplicationStorage);
+};
+
+}  // namespace resumption
+
+#endif  // SRC_COMPONENTS_RESUMPTION_INCLUDE_RESUMPTION_APPLICATION_STORAGE_H_
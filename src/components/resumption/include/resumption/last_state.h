@@ -38,6 +38,7 @@
 #include "utils/macro.h"
 #include "utils/singleton.h"
 #include "json/json.h"
+#include "resumption/application_storage.h"
 
 namespace resumption {
 
@@ -53,6 +54,12 @@ class LastState : public utils::Singleton<LastState> {
    */
   Json::Value dictionary;
 
+  /**
+   * @brief Resumption records of applications, each record is saved
+   * separately without rewriting the dictionary
+   */
+  ApplicationStorage& applications();
+
  private:
 
   /**
@@ -70,6 +77,8 @@ class LastState : public utils::Singleton<LastState> {
    */
   ~LastState();
 
+  ApplicationStorage applications_;
+
   DISALLOW_COPY_AND_ASSIGN(LastState);
 
   FRIEND_BASE_SINGLETON_CLASS(LastState);
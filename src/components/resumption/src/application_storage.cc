@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "resumption/application_storage.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "utils/file_system.h"
+#include "utils/logger.h"
+
+namespace resumption {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "LastState");
+
+namespace {
+const char* kDeviceId = "device_id";
+const char* kAppId = "app_id";
+const char* kData = "data";
+// Smaller logs are not worth compacting
+const size_t kMinCompactionSize = 64 * 1024;
+
+bool WriteAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t written = write(fd, data, size);
+    if (-1 == written) {
+      if (EINTR == errno) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+// Reads JSON string starting at begin of line
+// @return position after string or npos if there is no valid string
+std::string::size_type ReadString(const std::string& line,
+                                  std::string::size_type begin,
+                                  std::string* value) {
+  if (begin >= line.size() || '"' != line[begin]) {
+    return std::string::npos;
+  }
+  bool escaped = false;
+  bool has_escapes = false;
+  std::string::size_type end = begin + 1;
+  for (; end < line.size(); ++end) {
+    if (escaped) {
+      escaped = false;
+    } else if ('\\' == line[end]) {
+      escaped = has_escapes = true;
+    } else if ('"' == line[end]) {
+      break;
+    }
+  }
+  if (end >= line.size()) {
+    return std::string::npos;
+  }
+  if (!has_escapes) {
+    value->assign(line, begin + 1, end - begin - 1);
+    return end + 1;
+  }
+  Json::Value token;
+  Json::Reader reader;
+  if (!reader.parse(line.substr(begin, end - begin + 1), token, false) ||
+      !token.isString()) {
+    return std::string::npos;
+  }
+  *value = token.asString();
+  return end + 1;
+}
+
+// Gets key of line written by RecordLine without parsing of data, so loading
+// of log costs only its reading. Writer sorts members, so line is
+// {"app_id":..,"data":..,"device_id":..} and device id is the last member
+// @param live false if line removes record
+// @return false if line has other layout
+bool IndexLine(const std::string& line, ApplicationStorage::ApplicationKey* key,
+               bool* live) {
+  static const std::string kAppIdPrefix = "{\"app_id\":";
+  static const std::string kDataPrefix = ",\"data\":";
+  static const std::string kDeviceIdPrefix = ",\"device_id\":";
+  static const std::string kEnd = "}\n";
+  if (0 != line.compare(0, kAppIdPrefix.size(), kAppIdPrefix)) {
+    return false;
+  }
+  const std::string::size_type app_id_end =
+      ReadString(line, kAppIdPrefix.size(), &key->second);
+  if (std::string::npos == app_id_end) {
+    return false;
+  }
+  *live = 0 == line.compare(app_id_end, kDataPrefix.size(), kDataPrefix);
+  // Members of data precede device id, so the last match is top level one
+  const std::string::size_type device_id =
+      line.rfind(kDeviceIdPrefix);
+  if (std::string::npos == device_id || device_id < app_id_end ||
+      (!*live && device_id != app_id_end)) {
+    return false;
+  }
+  const std::string::size_type device_id_end =
+      ReadString(line, device_id + kDeviceIdPrefix.size(), &key->first);
+  return std::string::npos != device_id_end &&
+      0 == line.compare(device_id_end, std::string::npos, kEnd);
+}
+
+// Gets key of line by full parsing
+bool ParseLine(const std::string& line, ApplicationStorage::ApplicationKey* key,
+               bool* live) {
+  Json::Value record;
+  Json::Reader reader;
+  if (!reader.parse(line, record, false) || !record.isObject()
+      || !record[kDeviceId].isString() || !record[kAppId].isString()) {
+    return false;
+  }
+  key->first = record[kDeviceId].asString();
+  key->second = record[kAppId].asString();
+  *live = record.isMember(kData);
+  return true;
+}
+
+std::string RecordLine(const std::string& device_id, const std::string& app_id,
+                       const Json::Value* data) {
+  Json::Value record(Json::objectValue);
+  record[kDeviceId] = device_id;
+  record[kAppId] = app_id;
+  if (data) {
+    record[kData] = *data;
+  }
+  // Writes single line ending with new line
+  Json::FastWriter writer;
+  return writer.write(record);
+}
+}  // namespace
+
+ApplicationStorage::ApplicationStorage(const std::string& file_name)
+    : file_name_(file_name),
+      log_fd_(-1),
+      live_size_(0),
+      log_size_(0) {
+}
+
+ApplicationStorage::~ApplicationStorage() {
+  CloseLog();
+}
+
+bool ApplicationStorage::Load() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock lock(lock_);
+  CloseLog();
+  records_.clear();
+  live_size_ = 0;
+  log_size_ = 0;
+
+  if (!file_system::FileExists(file_name_)) {
+    return OpenLog();
+  }
+
+  std::string log;
+  if (!file_system::ReadFile(file_name_, log)) {
+    LOG4CXX_ERROR(logger_, "Unable to read " << file_name_);
+    return false;
+  }
+
+  // Records are only indexed here, data is parsed by Get on demand
+  bool broken = false;
+  std::string::size_type begin = 0;
+  while (begin < log.size()) {
+    const std::string::size_type end = log.find('\n', begin);
+    if (std::string::npos == end) {
+      // Record was not finished
+      broken = true;
+      break;
+    }
+    const std::string line = log.substr(begin, end - begin + 1);
+    Key key;
+    bool live = false;
+    if (!IndexLine(line, &key, &live) && !ParseLine(line, &key, &live)) {
+      broken = true;
+      break;
+    }
+    Records::iterator i = records_.find(key);
+    if (i != records_.end()) {
+      live_size_ -= i->second.size();
+      records_.erase(i);
+    }
+    if (live) {
+      records_[key] = line;
+      live_size_ += line.size();
+    }
+    log_size_ += line.size();
+    begin = end + 1;
+  }
+
+  LOG4CXX_DEBUG(logger_, records_.size() << " application records indexed");
+  if (broken) {
+    // Appending after broken tail would corrupt next record
+    LOG4CXX_WARN(logger_, "Broken record is dropped from " << file_name_);
+    return CompactLocked();
+  }
+  return OpenLog();
+}
+
+bool ApplicationStorage::Get(const std::string& device_id,
+                             const std::string& app_id,
+                             Json::Value* data) const {
+  DCHECK(data);
+  sync_primitives::AutoLock lock(lock_);
+  Records::const_iterator i = records_.find(Key(device_id, app_id));
+  if (i == records_.end()) {
+    return false;
+  }
+  Json::Value record;
+  Json::Reader reader;
+  if (!reader.parse(i->second, record, false)) {
+    return false;
+  }
+  *data = record[kData];
+  return true;
+}
+
+bool ApplicationStorage::Save(const std::string& device_id,
+                              const std::string& app_id,
+                              const Json::Value& data) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock lock(lock_);
+  const Key key(device_id, app_id);
+  const std::string line = RecordLine(device_id, app_id, &data);
+  Records::const_iterator i = records_.find(key);
+  if (i != records_.end() && i->second == line) {
+    return true;
+  }
+  return Append(key, line, true);
+}
+
+bool ApplicationStorage::Save(const ApplicationRecords& records) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock lock(lock_);
+  Changes changes;
+  changes.reserve(records.size());
+  for (ApplicationRecords::const_iterator i = records.begin();
+      i != records.end(); ++i) {
+    Change change;
+    change.key = i->first;
+    change.line = RecordLine(i->first.first, i->first.second, &i->second);
+    change.live = true;
+    Records::const_iterator saved = records_.find(change.key);
+    if (saved != records_.end() && saved->second == change.line) {
+      continue;
+    }
+    changes.push_back(change);
+  }
+  return changes.empty() || Append(changes);
+}
+
+bool ApplicationStorage::Remove(const std::string& device_id,
+                                const std::string& app_id) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock lock(lock_);
+  const Key key(device_id, app_id);
+  if (records_.find(key) == records_.end()) {
+    return true;
+  }
+  return Append(key, RecordLine(device_id, app_id, NULL), false);
+}
+
+void ApplicationStorage::Keys(ApplicationKeys* keys) const {
+  DCHECK(keys);
+  sync_primitives::AutoLock lock(lock_);
+  keys->reserve(keys->size() + records_.size());
+  for (Records::const_iterator i = records_.begin(); i != records_.end(); ++i) {
+    keys->push_back(i->first);
+  }
+}
+
+size_t ApplicationStorage::size() const {
+  sync_primitives::AutoLock lock(lock_);
+  return records_.size();
+}
+
+bool ApplicationStorage::Compact() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock lock(lock_);
+  return CompactLocked();
+}
+
+bool ApplicationStorage::Append(const Key& key, const std::string& line,
+                                bool live) {
+  Changes changes(1);
+  changes[0].key = key;
+  changes[0].line = line;
+  changes[0].live = live;
+  return Append(changes);
+}
+
+bool ApplicationStorage::Append(const Changes& changes) {
+  if (-1 == log_fd_ && !OpenLog()) {
+    return false;
+  }
+  std::string lines;
+  for (Changes::const_iterator i = changes.begin(); i != changes.end(); ++i) {
+    lines += i->line;
+  }
+  if (!WriteAll(log_fd_, lines.data(), lines.size()) || 0 != fsync(log_fd_)) {
+    LOG4CXX_ERROR(logger_, "Unable to write " << file_name_);
+    // Partial record must not stay in front of next one
+    CompactLocked();
+    return false;
+  }
+  log_size_ += lines.size();
+
+  for (Changes::const_iterator change = changes.begin();
+      change != changes.end(); ++change) {
+    Records::iterator i = records_.find(change->key);
+    if (i != records_.end()) {
+      live_size_ -= i->second.size();
+      records_.erase(i);
+    }
+    if (change->live) {
+      records_[change->key] = change->line;
+      live_size_ += change->line.size();
+    }
+  }
+  if (log_size_ > kMinCompactionSize && log_size_ > 2 * live_size_) {
+    // Appended record is already durable, failed compaction only leaves
+    // the log longer
+    CompactLocked();
+  }
+  return true;
+}
+
+bool ApplicationStorage::CompactLocked() {
+  LOG4CXX_DEBUG(logger_, "Compacting " << file_name_ << ", " << log_size_
+                << " bytes of " << live_size_ << " bytes are live");
+  CloseLog();
+  const std::string temp_name = file_name_ + ".tmp";
+  const int fd = open(temp_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (-1 == fd) {
+    LOG4CXX_ERROR(logger_, "Unable to create " << temp_name);
+    return false;
+  }
+  bool result = true;
+  for (Records::const_iterator i = records_.begin();
+      result && i != records_.end(); ++i) {
+    result = WriteAll(fd, i->second.data(), i->second.size());
+  }
+  result = result && 0 == fsync(fd);
+  close(fd);
+  if (!result || 0 != rename(temp_name.c_str(), file_name_.c_str())) {
+    LOG4CXX_ERROR(logger_, "Unable to replace " << file_name_);
+    file_system::DeleteFile(temp_name);
+    OpenLog();
+    return false;
+  }
+  log_size_ = live_size_;
+  return OpenLog();
+}
+
+bool ApplicationStorage::OpenLog() {
+  log_fd_ = open(file_name_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (-1 == log_fd_) {
+    LOG4CXX_ERROR(logger_, "Unable to open " << file_name_);
+    return false;
+  }
+  return true;
+}
+
+void ApplicationStorage::CloseLog() {
+  if (-1 != log_fd_) {
+    close(log_fd_);
+    log_fd_ = -1;
+  }
+}
+
+}  // namespace resumption
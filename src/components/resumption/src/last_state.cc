@@ -31,7 +31,10 @@
  */
 
 #include "resumption/last_state.h"
+
+
 #include "config_profile/profile.h"
+#include "utils/async_file_io.h"
 #include "utils/file_system.h"
 #include "utils/logger.h"
 
@@ -53,8 +56,13 @@ void LastState::SaveToFileSystem() {
   LOG4CXX_INFO(logger_, "LastState::SaveToFileSystem " << file
                << str);
 
-  DCHECK(file_system::Write(file, char_vector_pdata));
+  // Dictionary is replaced by rename, so crash while writing keeps old one
+  file_system::WriteBinaryFileAsync(file, char_vector_pdata,
+                                    file_system::kSyncReplace);
+}
 
+ApplicationStorage& LastState::applications() {
+  return applications_;
 }
 
 void LastState::LoadFromFileSystem() {
@@ -71,8 +79,13 @@ void LastState::LoadFromFileSystem() {
   LOG4CXX_WARN(logger_, "No valid last state was found.");
 }
 
-LastState::LastState() {
+LastState::LastState()
+    : applications_(profile::Profile::instance()->app_info_storage()
+                    + ".apps") {
   LoadFromFileSystem();
+  if (!applications_.Load()) {
+    LOG4CXX_WARN(logger_, "Application records were not loaded.");
+  }
 }
 
 LastState::~LastState() {
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+#include "resumption/application_storage.h"
+#include "utils/file_system.h"
+
+namespace test {
+namespace components {
+namespace resumption {
+
+using ::resumption::ApplicationStorage;
+
+namespace {
+const std::string kLogFile = "./app_storage_test.apps";
+
+Json::Value AppData(const std::string& name) {
+  Json::Value data;
+  data["name"] = name;
+  data["hmi_level"] = "FULL";
+  return data;
+}
+}  // namespace
+
+class ApplicationStorageTest : public ::testing::Test {
+ protected:
+  void SetUp() {
+    file_system::DeleteFile(kLogFile);
+  }
+  void TearDown() {
+    file_system::DeleteFile(kLogFile);
+  }
+};
+
+TEST_F(ApplicationStorageTest, SaveGetRemove) {
+  ApplicationStorage storage(kLogFile);
+  ASSERT_TRUE(storage.Load());
+  Json::Value data;
+  EXPECT_FALSE(storage.Get("dev", "app", &data));
+
+  EXPECT_TRUE(storage.Save("dev", "app", AppData("first")));
+  EXPECT_TRUE(storage.Save("dev", "other", AppData("second")));
+  EXPECT_TRUE(storage.Save("dev", "app", AppData("third")));
+  EXPECT_EQ(2u, storage.size());
+  ASSERT_TRUE(storage.Get("dev", "app", &data));
+  EXPECT_EQ(AppData("third"), data);
+  EXPECT_FALSE(storage.Get("other dev", "app", &data));
+
+  EXPECT_TRUE(storage.Remove("dev", "app"));
+  EXPECT_FALSE(storage.Get("dev", "app", &data));
+  EXPECT_EQ(1u, storage.size());
+}
+
+TEST_F(ApplicationStorageTest, Save_SameRecord_LogIsNotWritten) {
+  ApplicationStorage storage(kLogFile);
+  ASSERT_TRUE(storage.Load());
+  EXPECT_TRUE(storage.Save("dev", "app", AppData("first")));
+  const int64_t size = file_system::FileSize(kLogFile);
+  EXPECT_TRUE(storage.Save("dev", "app", AppData("first")));
+  EXPECT_EQ(size, file_system::FileSize(kLogFile));
+
+  EXPECT_TRUE(storage.Save("other dev", "app", AppData("first")));
+  ApplicationStorage::ApplicationKeys keys;
+  storage.Keys(&keys);
+  ASSERT_EQ(2u, keys.size());
+  EXPECT_EQ(ApplicationStorage::ApplicationKey("dev", "app"), keys[0]);
+  EXPECT_EQ(ApplicationStorage::ApplicationKey("other dev", "app"), keys[1]);
+}
+
+TEST_F(ApplicationStorageTest, SaveRecords_OnlyChangedRecordsAreWritten) {
+  ApplicationStorage storage(kLogFile);
+  ASSERT_TRUE(storage.Load());
+  ApplicationStorage::ApplicationRecords records;
+  records.push_back(std::make_pair(
+      ApplicationStorage::ApplicationKey("dev", "app"), AppData("first")));
+  records.push_back(std::make_pair(
+      ApplicationStorage::ApplicationKey("other dev", "app"),
+      AppData("second")));
+  EXPECT_TRUE(storage.Save(records));
+  EXPECT_EQ(2u, storage.size());
+  const int64_t size = file_system::FileSize(kLogFile);
+
+  EXPECT_TRUE(storage.Save(records));
+  EXPECT_EQ(size, file_system::FileSize(kLogFile));
+
+  records[1].second = AppData("third");
+  EXPECT_TRUE(storage.Save(records));
+  EXPECT_LT(size, file_system::FileSize(kLogFile));
+
+  ApplicationStorage loaded(kLogFile);
+  ASSERT_TRUE(loaded.Load());
+  EXPECT_EQ(2u, loaded.size());
+  Json::Value data;
+  ASSERT_TRUE(loaded.Get("dev", "app", &data));
+  EXPECT_EQ(AppData("first"), data);
+  ASSERT_TRUE(loaded.Get("other dev", "app", &data));
+  EXPECT_EQ(AppData("third"), data);
+}
+
+TEST_F(ApplicationStorageTest, Load_LatestRecordsAreKept) {
+  {
+    ApplicationStorage storage(kLogFile);
+    ASSERT_TRUE(storage.Load());
+    EXPECT_TRUE(storage.Save("dev", "app", AppData("first")));
+    EXPECT_TRUE(storage.Save("dev", "removed", AppData("second")));
+    EXPECT_TRUE(storage.Save("dev", "app", AppData("third")));
+    EXPECT_TRUE(storage.Remove("dev", "removed"));
+  }
+  ApplicationStorage storage(kLogFile);
+  ASSERT_TRUE(storage.Load());
+  EXPECT_EQ(1u, storage.size());
+  Json::Value data;
+  ASSERT_TRUE(storage.Get("dev", "app", &data));
+  EXPECT_EQ(AppData("third"), data);
+  EXPECT_FALSE(storage.Get("dev", "removed", &data));
+}
+
+TEST_F(ApplicationStorageTest, Load_BrokenTail_RecordIsDropped) {
+  {
+    ApplicationStorage storage(kLogFile);
+    ASSERT_TRUE(storage.Load());
+    EXPECT_TRUE(storage.Save("dev", "app", AppData("first")));
+  }
+  // Record interrupted by crash
+  std::string log;
+  ASSERT_TRUE(file_system::ReadFile(kLogFile, log));
+  log += "{\"app_id\":\"broken\",\"dev";
+  ASSERT_TRUE(file_system::WriteBinaryFile(
+      kLogFile, std::vector<uint8_t>(log.begin(), log.end())));
+
+  {
+    ApplicationStorage storage(kLogFile);
+    ASSERT_TRUE(storage.Load());
+    EXPECT_EQ(1u, storage.size());
+    EXPECT_TRUE(storage.Save("dev", "next", AppData("second")));
+  }
+  ApplicationStorage storage(kLogFile);
+  ASSERT_TRUE(storage.Load());
+  EXPECT_EQ(2u, storage.size());
+  Json::Value data;
+  ASSERT_TRUE(storage.Get("dev", "next", &data));
+  EXPECT_EQ(AppData("second"), data);
+}
+
+TEST_F(ApplicationStorageTest, Load_KeysLikeData_RecordsAreIndexed) {
+  Json::Value nested = AppData("first");
+  nested["device_id"] = "nested dev";
+  nested["app_id"] = "nested app";
+  nested["files"]["device_id"] = "\"device_id\":\"}";
+  {
+    ApplicationStorage storage(kLogFile);
+    ASSERT_TRUE(storage.Load());
+    EXPECT_TRUE(storage.Save("dev \"quoted\"", "app\\", nested));
+    EXPECT_TRUE(storage.Save("dev", "removed", AppData("second")));
+    EXPECT_TRUE(storage.Remove("dev", "removed"));
+  }
+  ApplicationStorage storage(kLogFile);
+  ASSERT_TRUE(storage.Load());
+  ApplicationStorage::ApplicationKeys keys;
+  storage.Keys(&keys);
+  ASSERT_EQ(1u, keys.size());
+  EXPECT_EQ(ApplicationStorage::ApplicationKey("dev \"quoted\"", "app\\"),
+            keys[0]);
+  Json::Value data;
+  ASSERT_TRUE(storage.Get("dev \"quoted\"", "app\\", &data));
+  EXPECT_EQ(nested, data);
+}
+
+TEST_F(ApplicationStorageTest, Save_ManyUpdates_LogIsCompacted) {
+  ApplicationStorage storage(kLogFile);
+  ASSERT_TRUE(storage.Load());
+  for (int i = 0; i < 2000; ++i) {
+    ASSERT_TRUE(storage.Save("dev", "app", AppData(i % 2 ? "name" : "odd")));
+  }
+  const std::string record_once = "{\"app_id\":\"app\",\"data\":" +
+      std::string("{\"hmi_level\":\"FULL\",\"name\":\"name\"},") +
+      "\"device_id\":\"dev\"}\n";
+  EXPECT_GT(static_cast<int64_t>(64 * 1024 + 2 * record_once.size()),
+            file_system::FileSize(kLogFile));
+
+  EXPECT_TRUE(storage.Compact());
+  EXPECT_EQ(static_cast<int64_t>(record_once.size()),
+            file_system::FileSize(kLogFile));
+  Json::Value data;
+  ASSERT_TRUE(storage.Get("dev", "app", &data));
+  EXPECT_EQ(AppData("name"), data);
+}
+
+}  // namespace resumption
+}  // namespace components
+}  // namespace test
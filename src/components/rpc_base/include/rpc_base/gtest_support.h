@@ -45,12 +45,9 @@ template<typename T>
   if (obj.is_valid())
     return ::testing::AssertionSuccess();
 
-  rpc::ValidationReport report(obj_expr);
-  obj.ReportErrors(&report);
-
   return ::testing::AssertionFailure()
       << obj_expr << " failed validation. Violations are:\n"
-      << rpc::PrettyFormat(report);
+      << rpc::ValidationErrors(obj_expr, obj);
 }
 
 #define ASSERT_RPCTYPE_VALID(object) \
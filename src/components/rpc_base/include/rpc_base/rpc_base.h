@@ -167,6 +167,7 @@ class Boolean : public PrimitiveType {
     Boolean& operator=(bool new_val);
     operator bool() const;
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
 
   private:
@@ -192,6 +193,7 @@ class Integer : public PrimitiveType {
     Integer& operator+=(int value);
     operator IntType() const;
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
 
   private:
@@ -211,6 +213,7 @@ class Float : public PrimitiveType {
     Float& operator=(double new_val);
     operator double() const;
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
 
   private:
@@ -234,6 +237,7 @@ class String : public PrimitiveType {
     bool operator==(const String& rhs);
     operator const std::string& () const;
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
 
   private:
@@ -256,6 +260,7 @@ class Enum : public PrimitiveType {
     Enum& operator=(EnumType new_val);
     operator EnumType() const;
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
 
   private:
@@ -283,6 +288,7 @@ class Array : public std::vector<T>, public CompositeType {
     template<typename U>
     void push_back(const U& value);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
 
     bool is_valid() const;
@@ -312,6 +318,7 @@ class Map : public std::map<std::string, T>, public CompositeType  {
     template<typename U>
     void insert(const std::pair<std::string, U>& value);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
     void ToDbusWriter(dbus::MessageWriter* writer) const;
 
     bool is_valid() const;
@@ -336,6 +343,7 @@ class Nullable : public T {
     template<typename U>
     Nullable& operator=(const U& new_val);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
 
     bool is_valid() const;
     bool is_initialized() const;
@@ -362,6 +370,7 @@ class Stringifyable : public T {
     template<typename U>
     Stringifyable& operator=(const U& new_val);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
 
     bool is_valid() const;
     bool is_initialized() const;
@@ -384,6 +393,7 @@ class Optional {
     template<typename U>
     Optional(const Json::Value* value, const U& def_value);
     Json::Value ToJsonValue() const;
+    void WriteJson(std::string* output) const;
 
     void ToDbusWriter(dbus::MessageWriter* writer) const;
 
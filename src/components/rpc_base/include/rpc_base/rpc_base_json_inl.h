@@ -33,8 +33,11 @@
 #ifndef VALIDATED_TYPES_JSON_INL_H_
 #define VALIDATED_TYPES_JSON_INL_H_
 
+#include <cstdio>
+#include <cstring>
 #include "rpc_base/rpc_base.h"
 #include "json/value.h"
+#include "json/writer.h"
 
 namespace rpc {
 
@@ -104,6 +107,54 @@ inline void WriteJsonField(const char* field_name,
   }
 }
 
+// Appends quoted and escaped string the same way Json::FastWriter does
+inline void WriteJsonString(const char* value, size_t length,
+                            std::string* output) {
+  output->push_back('"');
+  for (const char* c = value; c != value + length; ++c) {
+    switch (*c) {
+      case '"': output->append("\\\""); break;
+      case '\\': output->append("\\\\"); break;
+      case '\b': output->append("\\b"); break;
+      case '\f': output->append("\\f"); break;
+      case '\n': output->append("\\n"); break;
+      case '\r': output->append("\\r"); break;
+      case '\t': output->append("\\t"); break;
+      default:
+        if (*c > 0 && *c <= 0x1F) {
+          char escaped[7];
+          snprintf(escaped, sizeof(escaped), "\\u%04X", *c);
+          output->append(escaped);
+        } else {
+          output->push_back(*c);
+        }
+    }
+  }
+  output->push_back('"');
+}
+
+inline void WriteJsonString(const std::string& value, std::string* output) {
+  WriteJsonString(value.data(), value.length(), output);
+}
+
+// Streaming counterpart of WriteJsonField, appends field to JSON object
+// which is being written to output
+template<class T>
+inline void WriteJsonField(const char* field_name,
+                           const T& field,
+                           bool* first_field,
+                           std::string* output) {
+  if (field.is_initialized()) {
+    if (!*first_field) {
+      output->push_back(',');
+    }
+    *first_field = false;
+    WriteJsonString(field_name, strlen(field_name), output);
+    output->push_back(':');
+    field.WriteJson(output);
+  }
+}
+
 }  // namespace impl
 
 inline Boolean::Boolean(const Json::Value* value)
@@ -124,6 +175,10 @@ inline Json::Value Boolean::ToJsonValue() const {
   return Json::Value(value_);
 }
 
+inline void Boolean::WriteJson(std::string* output) const {
+  output->append(value_ ? "true" : "false");
+}
+
 template<typename T, T minval, T maxval>
 Integer<T, minval, maxval>::Integer(const Json::Value* value)
   : PrimitiveType(InitHelper(value, &Json::Value::isInt)),
@@ -159,6 +214,13 @@ Json::Value Integer<T, minval, maxval>::ToJsonValue() const {
   return Json::Value(Json::Int64(value_));
 }
 
+template<typename T, T minval, T maxval>
+void Integer<T, minval, maxval>::WriteJson(std::string* output) const {
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value_));
+  output->append(buffer);
+}
+
 template<int64_t minnum, int64_t maxnum, int64_t minden, int64_t maxden>
 Float<minnum, maxnum, minden, maxden>::Float(const Json::Value* value)
   : PrimitiveType(InitHelper(value, &Json::Value::isDouble)),
@@ -187,6 +249,12 @@ Json::Value Float<minnum, maxnum, minden, maxden>::ToJsonValue() const {
   return Json::Value(value_);
 }
 
+template<int64_t minnum, int64_t maxnum, int64_t minden, int64_t maxden>
+void Float<minnum, maxnum, minden, maxden>::WriteJson(
+    std::string* output) const {
+  output->append(Json::valueToString(value_));
+}
+
 template<size_t minlen, size_t maxlen>
 String<minlen, maxlen>::String(const Json::Value* value)
   : PrimitiveType(InitHelper(value, &Json::Value::isString)),
@@ -212,6 +280,11 @@ Json::Value String<minlen, maxlen>::ToJsonValue() const {
   return Json::Value(value_);
 }
 
+template<size_t minlen, size_t maxlen>
+void String<minlen, maxlen>::WriteJson(std::string* output) const {
+  impl::WriteJsonString(value_, output);
+}
+
 template<typename T>
 Enum<T>::Enum(const Json::Value* value)
   : PrimitiveType(InitHelper(value, &Json::Value::isString)),
@@ -239,6 +312,12 @@ Json::Value Enum<T>::ToJsonValue() const {
   return Json::Value(Json::StaticString(EnumToJsonString(value_)));
 }
 
+template<typename T>
+void Enum<T>::WriteJson(std::string* output) const {
+  const char* value = EnumToJsonString(value_);
+  impl::WriteJsonString(value, strlen(value), output);
+}
+
 // Non-const version
 template<typename T, size_t minsize, size_t maxsize>
 Array<T, minsize, maxsize>::Array(Json::Value* value)
@@ -283,6 +362,18 @@ Json::Value Array<T, minsize, maxsize>::ToJsonValue() const {
   return array;
 }
 
+template<typename T, size_t minsize, size_t maxsize>
+void Array<T, minsize, maxsize>::WriteJson(std::string* output) const {
+  output->push_back('[');
+  for (size_t i = 0; i != this->size(); ++i) {
+    if (i) {
+      output->push_back(',');
+    }
+    (this->operator [](i)).WriteJson(output);
+  }
+  output->push_back(']');
+}
+
 // Non-const version
 template<typename T, size_t minsize, size_t maxsize>
 Map<T, minsize, maxsize>::Map(Json::Value* value)
@@ -323,6 +414,20 @@ Json::Value Map<T, minsize, maxsize>::ToJsonValue() const {
   return map;
 }
 
+template<typename T, size_t minsize, size_t maxsize>
+void Map<T, minsize, maxsize>::WriteJson(std::string* output) const {
+  output->push_back('{');
+  for (typename MapType::const_iterator i = this->begin(); i != this->end(); ++i) {
+    if (i != this->begin()) {
+      output->push_back(',');
+    }
+    impl::WriteJsonString(i->first, output);
+    output->push_back(':');
+    i->second.WriteJson(output);
+  }
+  output->push_back('}');
+}
+
 template<typename T>
 Nullable<T>::Nullable(const Json::Value* value)
   : T(value),
@@ -347,6 +452,15 @@ inline Json::Value Nullable<T>::ToJsonValue() const {
   return marked_null_ ? Json::Value::null : T::ToJsonValue();
 }
 
+template<typename T>
+inline void Nullable<T>::WriteJson(std::string* output) const {
+  if (marked_null_) {
+    output->append("null");
+  } else {
+    T::WriteJson(output);
+  }
+}
+
 template<typename T>
 template<typename U>
 Optional<T>::Optional(const Json::Value* value, const U& def_value)
@@ -358,6 +472,11 @@ inline Json::Value Optional<T>::ToJsonValue() const {
   return value_.ToJsonValue();
 }
 
+template<typename T>
+inline void Optional<T>::WriteJson(std::string* output) const {
+  value_.WriteJson(output);
+}
+
 template<typename T>
 Stringifyable<T>::Stringifyable(const Json::Value* value)
   : T(NULL != value&&  !value->isString() ? value : NULL),
@@ -382,6 +501,15 @@ inline Json::Value Stringifyable<T>::ToJsonValue() const {
   return predefined_string_.empty() ? T::ToJsonValue() : predefined_string_;
 }
 
+template<typename T>
+inline void Stringifyable<T>::WriteJson(std::string* output) const {
+  if (predefined_string_.empty()) {
+    T::WriteJson(output);
+  } else {
+    impl::WriteJsonString(predefined_string_, output);
+  }
+}
+
 }  // namespace rpc
 
 #endif /* VALIDATED_TYPES_JSON_INL_H_ */
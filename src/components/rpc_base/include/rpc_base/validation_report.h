@@ -57,6 +57,11 @@ private:
 
 std::string PrettyFormat(const ValidationReport& report);
 
+// Validates object once more building the report, so report is made only
+// when it is read, e.g. inside of log statement after is_valid() failed
+template<typename T>
+std::string ValidationErrors(const std::string& object_name, const T& object);
+
 // Implementation
 
 namespace impl {
@@ -114,6 +119,14 @@ inline std::string PrettyFormat(const ValidationReport& report) {
   return result;
 }
 
+template<typename T>
+std::string ValidationErrors(const std::string& object_name,
+                             const T& object) {
+  ValidationReport report(object_name);
+  object.ReportErrors(&report);
+  return PrettyFormat(report);
+}
+
 }  // namespace rpc
 
 #endif /* RPC_BASE_VALIDATION_REPORT_H_ */
@@ -32,6 +32,7 @@
 
 #include "gtest/gtest.h"
 #include "json/value.h"
+#include "json/writer.h"
 #include "rpc_base/rpc_base.h"
 
 namespace test {
@@ -371,6 +372,48 @@ TEST(ValidatedTypesJson, OptionalIntFromJsonTest) {
 }
 
 
+TEST(ValidatedTypesJson, WriteJsonEqualsFastWriterTest) {
+  Value array_value(Json::arrayValue);
+  array_value.append(Value("plain"));
+  array_value.append(Value("quote\" slash\\ tab\t ctrl\x01"));
+  Value map_value(Json::objectValue);
+  map_value["a\nkey"] = array_value;
+  map_value["empty"] = Value(Json::arrayValue);
+  Map< Array< String<0, 255>, 0, 5 >, 0, 5 > map(&map_value);
+  ASSERT_TRUE(map.is_valid());
+
+  std::string written;
+  map.WriteJson(&written);
+
+  Json::FastWriter writer;
+  std::string expected = writer.write(map.ToJsonValue());
+  // FastWriter terminates document with new line
+  expected.erase(expected.size() - 1);
+  ASSERT_EQ(expected, written);
+}
+
+TEST(ValidatedTypesJson, WriteJsonPrimitivesTest) {
+  Value int_value(-42);
+  Value double_value(2.5);
+  Value enum_value("kValue1");
+  std::string written;
+  Integer<int32_t, -100, 100>(&int_value).WriteJson(&written);
+  written.push_back(' ');
+  Float<0, 10>(&double_value).WriteJson(&written);
+  written.push_back(' ');
+  Enum<TestEnum>(&enum_value).WriteJson(&written);
+  written.push_back(' ');
+  Boolean(true).WriteJson(&written);
+  written.push_back(' ');
+  Nullable< Integer<int8_t, 1, 15> > nullable_int;
+  nullable_int.set_to_null();
+  nullable_int.WriteJson(&written);
+  // Floating point is formatted by jsoncpp itself
+  ASSERT_EQ("-42 " + Json::valueToString(2.5) + " \"kValue1\" true null",
+            written);
+}
+
+
 }  // namespace test
 
 
@@ -366,6 +366,14 @@ TEST(ValidatedTypes, ReportNullInitializedNullableIntType) {
   ASSERT_EQ("", PrettyFormat(report));
 }
 
+TEST(ValidatedTypes, ValidationErrorsOfIncorrectInitializedIntType) {
+  Integer<int8_t, 1, 3> val(5);
+  ASSERT_FALSE(val.is_valid());
+  ASSERT_EQ("val: value initialized incorrectly\n",
+            ValidationErrors("val", val));
+  ASSERT_EQ("", ValidationErrors("val", Integer<int8_t, 1, 3>(2)));
+}
+
 TEST(ValidatedTypes, ReportNoninitializedIntArray) {
   Array< Enum<TestEnum>, 1, 3 > array;
   ASSERT_FALSE(array.is_valid());
@@ -38,7 +38,9 @@
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <string>
+#include <list>
 #include <map>
+#include <vector>
 
 #include "security_manager/crypto_manager.h"
 #include "security_manager/ssl_context.h"
@@ -48,9 +50,52 @@
 namespace security_manager {
 class CryptoManagerImpl : public CryptoManager {
  private:
+  /*
+   * Keeps last negotiated session of every peer for client side resumption,
+   * least recently used sessions are dropped above max_size
+   */
+  class SessionCache {
+   public:
+    explicit SessionCache(size_t max_size);
+    ~SessionCache();
+    /*
+     * \return session with added reference to be released by caller
+     * or NULL if there is no session for peer
+     */
+    SSL_SESSION *Get(const std::string &peer_id);
+    /*
+     * \brief Stores session taking over reference owned by caller
+     */
+    void Put(const std::string &peer_id, SSL_SESSION *session);
+    void Remove(const std::string &peer_id);
+    void Clear();
+
+   private:
+    typedef std::list<std::string> PeersList;
+    struct Entry {
+      SSL_SESSION *session;
+      // Position in recent_peers_
+      PeersList::iterator position;
+    };
+    typedef std::map<std::string, Entry> SessionsMap;
+    void Erase(SessionsMap::iterator it);
+
+    SessionsMap sessions_;
+    // Most recently used peer first
+    PeersList recent_peers_;
+    const size_t max_size_;
+    sync_primitives::Lock sessions_lock_;
+    DISALLOW_COPY_AND_ASSIGN(SessionCache);
+  };
+
   class SSLContextImpl : public SSLContext {
    public:
-    SSLContextImpl(SSL *conn, Mode mode);
+    /*
+     * \param session_cache cache to resume and store session in,
+     * NULL disables resumption
+     */
+    SSLContextImpl(SSL *conn, Mode mode, SessionCache *session_cache,
+                   const std::string &peer_id);
     virtual HandshakeResult StartHandshake(const uint8_t** const out_data,
                                            size_t *out_data_size);
     virtual HandshakeResult DoHandshakeStep(const uint8_t *const in_data,
@@ -59,6 +104,8 @@ class CryptoManagerImpl : public CryptoManager {
                                             size_t *out_data_size);
     virtual bool Encrypt(const uint8_t *const in_data,    size_t in_data_size,
                          const uint8_t ** const out_data, size_t *out_data_size);
+    virtual bool Encrypt(const uint8_t *const in_data, size_t in_data_size,
+                         utils::BufferSlice *out_data);
     virtual bool Decrypt(const uint8_t *const in_data,    size_t in_data_size,
                          const uint8_t ** const out_data, size_t *out_data_size);
     virtual bool IsInitCompleted() const;
@@ -66,19 +113,35 @@ class CryptoManagerImpl : public CryptoManager {
     virtual size_t get_max_block_size(size_t mtu) const;
     virtual std::string LastError() const;
     virtual ~SSLContextImpl();
+    /*
+     * \brief Prepares released context for new connection without
+     * reallocating SSL and BIO objects
+     */
+    void Reset(const std::string &peer_id);
 
    private:
     typedef size_t(*BlockSizeGetter)(size_t);
-    void EnsureBufferSizeEnough(size_t size);
+    typedef std::vector<uint8_t> Buffer;
+    static uint8_t *EnsureBufferSizeEnough(Buffer *buffer, size_t size);
+    void SetPeer(const std::string &peer_id);
+    // Writes data to SSL filter, \return size of encrypted data pending
+    size_t WriteForEncryption(const uint8_t *const in_data, size_t in_data_size);
+    // Drops cached session after failed handshake, so next one is full
+    void ForgetSession();
     SSL *connection_;
     BIO *bioIn_;
     BIO *bioOut_;
     BIO *bioFilter_;
     mutable sync_primitives::Lock bio_locker;
-    size_t buffer_size_;
-    uint8_t *buffer_;
+    // Every operation returns data in its own buffer, so output of
+    // decryption stays valid while other thread encrypts and vice versa
+    Buffer handshake_buffer_;
+    Buffer encrypt_buffer_;
+    Buffer decrypt_buffer_;
     bool is_handshake_pending_;
     Mode mode_;
+    SessionCache *session_cache_;
+    std::string peer_id_;
     BlockSizeGetter max_block_size_;
     static std::map<std::string, BlockSizeGetter> max_block_sizes;
     static std::map<std::string, BlockSizeGetter> create_max_block_sizes();
@@ -86,7 +149,28 @@ class CryptoManagerImpl : public CryptoManager {
   };
 
  public:
+  /*
+   * Kind of cipher suites negotiated first, AES-GCM suits SoCs with AES
+   * accelerator, ChaCha20 is faster in software
+   */
+  enum CipherPreference {
+    NO_PREFERENCE,
+    PREFER_AES_GCM,
+    PREFER_CHACHA20
+  };
+
   CryptoManagerImpl();
+  /*
+   * \brief Selects OpenSSL engine (provider since OpenSSL 3.0) doing
+   * cryptographic operations, to be called before Init.
+   * Empty identifier keeps default software implementation.
+   */
+  void set_crypto_engine(const std::string &engine_id);
+  /*
+   * \brief Moves preferred suites of cipher list to its beginning,
+   * to be called before Init
+   */
+  void set_cipher_preference(CipherPreference preference);
   virtual bool Init(Mode mode,
                     Protocol protocol,
                     const std::string &cert_filename,
@@ -94,13 +178,28 @@ class CryptoManagerImpl : public CryptoManager {
                     const std::string &ciphers_list,
                     bool verify_peer);
   virtual void Finish();
-  virtual SSLContext *CreateSSLContext();
+  virtual SSLContext *CreateSSLContext(const std::string &peer_id);
   virtual void ReleaseSSLContext(SSLContext *context);
   virtual std::string LastError() const;
 
  private:
+  bool LoadCryptoEngine();
+  void UnloadCryptoEngine();
+  bool ApplyCipherPreference();
+
   SSL_CTX *context_;
   Mode mode_;
+  std::string engine_id_;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  OSSL_PROVIDER *engine_;
+#else
+  ENGINE *engine_;
+#endif
+  CipherPreference cipher_preference_;
+  SessionCache session_cache_;
+  // Released contexts recycled by CreateSSLContext
+  std::vector<SSLContextImpl*> free_contexts_;
+  sync_primitives::Lock free_contexts_lock_;
   static uint32_t instance_count_;
   DISALLOW_COPY_AND_ASSIGN(CryptoManagerImpl);
 };
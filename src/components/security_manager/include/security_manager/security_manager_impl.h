@@ -35,10 +35,13 @@
 
 #include <list>
 #include <string>
+#include <vector>
 
 #include "utils/macro.h"
+#include "utils/lock.h"
 #include "utils/message_queue.h"
 #include "utils/threads/message_loop_thread.h"
+#include "utils/threads/thread_pool.h"
 
 #include "security_manager/security_manager.h"
 #include "security_manager/security_query.h"
@@ -71,8 +74,11 @@ class SecurityManagerImpl
  public:
   /**
    * \brief Constructor
+   * \param handshake_threads number of threads handshakes of different
+   * connections run on concurrently, 0 means single message loop thread
    */
-  SecurityManagerImpl();
+  explicit SecurityManagerImpl(uint32_t handshake_threads = 0);
+  ~SecurityManagerImpl();
   /**
    * \brief Add received from Mobile Application message
    * Overriden ProtocolObserver::OnMessageReceived method
@@ -120,7 +126,7 @@ class SecurityManagerImpl
   /**
    * \brief Handle SecurityMessage from mobile for processing
    * threads::MessageLoopThread<*>::Handler implementations
-   * CALLED in SecurityMessageLoop thread
+   * CALLED in SecurityMessageLoop thread or on handshake_pool_ thread
    */
   void Handle(const SecurityMessage message) OVERRIDE;
 
@@ -185,8 +191,20 @@ class SecurityManagerImpl
    */
   void SendQuery(const SecurityQuery &query, const uint32_t connection_key);
 
+  /**
+   * \brief Builds identifier of remote side for TLS session resumption
+   * from device address and session number, which survive reconnection
+   * \param connection_key Unique key used by other components as session identifier
+   * \return peer identifier or empty string if device is unknown
+   */
+  std::string PeerId(const uint32_t connection_key);
+
   // Thread that pumps handshake data
   SecurityMessageLoop security_messages_;
+  // Shared with all handshake queues, NULL if concurrent handshakes are disabled
+  threads::ThreadPool *handshake_pool_;
+  // Connection messages always go through the same queue
+  std::vector<SecurityMessageLoop*> handshake_queues_;
 
   /**
    *\brief Pointer on instance of class implementing SessionObserver
@@ -204,6 +222,8 @@ class SecurityManagerImpl
    *\brief List of listeners for notify handshake done result
    */
   std::list<SecurityManagerListener *> listeners_;
+  // Recursive, so notified listener could add or remove listeners
+  sync_primitives::Lock listeners_lock_;
   DISALLOW_COPY_AND_ASSIGN(SecurityManagerImpl);
 };
 }  // namespace security_manager
@@ -34,21 +34,73 @@
 #include <openssl/bio.h>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
+#include <pthread.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/evp.h>
+#include <openssl/provider.h>
+#elif !defined(OPENSSL_NO_ENGINE)
+#include <openssl/engine.h>
+#endif
 #include "security_manager/security_manager.h"
 #include "utils/logger.h"
 #include "utils/atomic.h"
+#include "utils/lock.h"
 
 #define TLS1_1_MINIMAL_VERSION            0x1000103fL
 #define CONST_SSL_METHOD_MINIMAL_VERSION  0x00909000L
+#define BUILTIN_THREADS_MINIMAL_VERSION   0x10100000L
+#define PROVIDERS_MINIMAL_VERSION         0x30000000L
 
 namespace security_manager {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "CryptoManagerImpl")
 
+#if OPENSSL_VERSION_NUMBER < BUILTIN_THREADS_MINIMAL_VERSION
+namespace {
+// Older OpenSSL shares its state between contexts without any locking,
+// so contexts are used from several threads only with these callbacks
+sync_primitives::Lock *crypto_locks = NULL;
+
+void LockingCallback(int mode, int type, const char *file, int line) {
+  if (mode & CRYPTO_LOCK) {
+    crypto_locks[type].Acquire();
+  } else {
+    crypto_locks[type].Release();
+  }
+}
+
+unsigned long ThreadIdCallback() {
+  return static_cast<unsigned long>(pthread_self());
+}
+}  // namespace
+#endif  // OPENSSL_VERSION_NUMBER < BUILTIN_THREADS_MINIMAL_VERSION
+
+namespace {
+// Peers and server side sessions kept for abbreviated handshake
+const size_t kSessionCacheSize = 64;
+// Seconds negotiated session could be resumed in
+const long kSessionTimeout = 600;
+const unsigned char kSessionIdContext[] = "SDL";
+// Released contexts kept for reconnecting peers
+const size_t kMaxFreeContexts = 16;
+}  // namespace
+
 uint32_t CryptoManagerImpl::instance_count_ = 0;
 
 CryptoManagerImpl::CryptoManagerImpl()
-    : context_(NULL), mode_(CLIENT) {
+    : context_(NULL),
+      mode_(CLIENT),
+      engine_(NULL),
+      cipher_preference_(NO_PREFERENCE),
+      session_cache_(kSessionCacheSize) {
+}
+
+void CryptoManagerImpl::set_crypto_engine(const std::string &engine_id) {
+  engine_id_ = engine_id;
+}
+
+void CryptoManagerImpl::set_cipher_preference(CipherPreference preference) {
+  cipher_preference_ = preference;
 }
 
 bool CryptoManagerImpl::Init(Mode mode,
@@ -62,6 +114,17 @@ bool CryptoManagerImpl::Init(Mode mode,
     ERR_load_BIO_strings();
     OpenSSL_add_all_algorithms();
     SSL_library_init();
+#if OPENSSL_VERSION_NUMBER < BUILTIN_THREADS_MINIMAL_VERSION
+    crypto_locks = new sync_primitives::Lock[CRYPTO_num_locks()];
+    CRYPTO_set_id_callback(ThreadIdCallback);
+    CRYPTO_set_locking_callback(LockingCallback);
+#endif  // OPENSSL_VERSION_NUMBER < BUILTIN_THREADS_MINIMAL_VERSION
+  }
+
+  // Misconfigured accelerator should not disable protected services
+  if (!engine_id_.empty() && !LoadCryptoEngine()) {
+    LOG4CXX_WARN(logger_, "Could not use crypto engine " << engine_id_
+                 << ", software implementation is used");
   }
 
   mode_ = mode;
@@ -117,6 +180,19 @@ bool CryptoManagerImpl::Init(Mode mode,
   // Disable SSL2 as deprecated
   SSL_CTX_set_options(context_, SSL_OP_NO_SSLv2);
 
+  // Restarted service or reconnected application resumes its session,
+  // by session identifier or ticket, skipping certificate verification
+  SSL_CTX_set_timeout(context_, kSessionTimeout);
+  if (is_server) {
+    SSL_CTX_set_session_cache_mode(context_, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(context_, kSessionCacheSize);
+    SSL_CTX_set_session_id_context(context_, kSessionIdContext,
+                                   sizeof(kSessionIdContext) - 1);
+  } else {
+    // Client sessions are kept by session_cache_ per peer
+    SSL_CTX_set_session_cache_mode(context_, SSL_SESS_CACHE_OFF);
+  }
+
   if (cert_filename.empty()) {
     LOG4CXX_WARN(logger_, "Empty certificate path");
   } else {
@@ -153,6 +229,10 @@ bool CryptoManagerImpl::Init(Mode mode,
     }
   }
 
+  if (NO_PREFERENCE != cipher_preference_ && !ApplyCipherPreference()) {
+    LOG4CXX_WARN(logger_, "Could not reorder cipher list");
+  }
+
   // TODO(EZamakhov): add loading SSL_VERIFY_FAIL_IF_NO_PEER_CERT from INI
   const int verify_mode = verify_peer
       ? SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT
@@ -163,18 +243,45 @@ bool CryptoManagerImpl::Init(Mode mode,
 }
 
 void CryptoManagerImpl::Finish() {
+  {
+    sync_primitives::AutoLock locker(free_contexts_lock_);
+    for (std::vector<SSLContextImpl*>::iterator it = free_contexts_.begin();
+         it != free_contexts_.end(); ++it) {
+      delete *it;
+    }
+    free_contexts_.clear();
+  }
+  session_cache_.Clear();
   SSL_CTX_free(context_);
+  context_ = NULL;
+  UnloadCryptoEngine();
   if (atomic_post_dec(&instance_count_) == 1) {
     EVP_cleanup();
     ERR_free_strings();
+#if OPENSSL_VERSION_NUMBER < BUILTIN_THREADS_MINIMAL_VERSION
+    CRYPTO_set_locking_callback(NULL);
+    CRYPTO_set_id_callback(NULL);
+    delete[] crypto_locks;
+    crypto_locks = NULL;
+#endif  // OPENSSL_VERSION_NUMBER < BUILTIN_THREADS_MINIMAL_VERSION
   }
 }
 
-SSLContext* CryptoManagerImpl::CreateSSLContext() {
+SSLContext* CryptoManagerImpl::CreateSSLContext(const std::string &peer_id) {
   if (context_ == NULL) {
     return NULL;
   }
 
+  {
+    sync_primitives::AutoLock locker(free_contexts_lock_);
+    if (!free_contexts_.empty()) {
+      SSLContextImpl *context = free_contexts_.back();
+      free_contexts_.pop_back();
+      context->Reset(peer_id);
+      return context;
+    }
+  }
+
   SSL *conn = SSL_new(context_);
   if (conn == NULL)
     return NULL;
@@ -184,13 +291,116 @@ SSLContext* CryptoManagerImpl::CreateSSLContext() {
   } else {
     SSL_set_connect_state(conn);
   }
-  return new SSLContextImpl(conn, mode_);
+  return new SSLContextImpl(conn, mode_, &session_cache_, peer_id);
 }
 
 void CryptoManagerImpl::ReleaseSSLContext(SSLContext *context) {
+  if (!context) {
+    return;
+  }
+  {
+    sync_primitives::AutoLock locker(free_contexts_lock_);
+    // Contexts are created only by this manager
+    if (context_ && free_contexts_.size() < kMaxFreeContexts) {
+      free_contexts_.push_back(static_cast<SSLContextImpl*>(context));
+      return;
+    }
+  }
   delete context;
 }
 
+bool CryptoManagerImpl::LoadCryptoEngine() {
+  LOG4CXX_INFO(logger_, "Crypto engine: " << engine_id_);
+#if OPENSSL_VERSION_NUMBER >= PROVIDERS_MINIMAL_VERSION
+  // Default provider stays loaded for algorithms engine does not implement
+  engine_ = OSSL_PROVIDER_try_load(NULL, engine_id_.c_str(), 1);
+  if (!engine_) {
+    return false;
+  }
+  const std::string properties = "?provider=" + engine_id_;
+  return EVP_set_default_properties(NULL, properties.c_str());
+#elif !defined(OPENSSL_NO_ENGINE)
+  ENGINE_load_builtin_engines();
+  ENGINE *engine = ENGINE_by_id(engine_id_.c_str());
+  if (!engine) {
+    return false;
+  }
+  // Structural reference is exchanged for functional one
+  const bool initialized = ENGINE_init(engine);
+  ENGINE_free(engine);
+  if (!initialized) {
+    return false;
+  }
+  engine_ = engine;
+  return ENGINE_set_default(engine_, ENGINE_METHOD_ALL);
+#else
+  return false;
+#endif
+}
+
+void CryptoManagerImpl::UnloadCryptoEngine() {
+  if (!engine_) {
+    return;
+  }
+#if OPENSSL_VERSION_NUMBER >= PROVIDERS_MINIMAL_VERSION
+  EVP_set_default_properties(NULL, NULL);
+  OSSL_PROVIDER_unload(engine_);
+#elif !defined(OPENSSL_NO_ENGINE)
+  ENGINE_finish(engine_);
+#endif
+  engine_ = NULL;
+}
+
+namespace {
+bool IsPreferredCipher(const SSL_CIPHER *cipher,
+                       CryptoManagerImpl::CipherPreference preference) {
+  const std::string name(SSL_CIPHER_get_name(cipher));
+  switch (preference) {
+    case CryptoManagerImpl::PREFER_AES_GCM:
+      return std::string::npos != name.find("AES") &&
+          std::string::npos != name.find("GCM");
+    case CryptoManagerImpl::PREFER_CHACHA20:
+      return std::string::npos != name.find("CHACHA20");
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+bool CryptoManagerImpl::ApplyCipherPreference() {
+  STACK_OF(SSL_CIPHER) *ciphers = SSL_CTX_get_ciphers(context_);
+  if (!ciphers) {
+    return false;
+  }
+  // Relative order inside preferred and the rest of suites is kept
+  std::string preferred;
+  std::string others;
+  for (int i = 0; i < sk_SSL_CIPHER_num(ciphers); ++i) {
+    const SSL_CIPHER *cipher = sk_SSL_CIPHER_value(ciphers, i);
+    std::string &list = IsPreferredCipher(cipher, cipher_preference_)
+        ? preferred : others;
+    if (!list.empty()) {
+      list += ':';
+    }
+    list += SSL_CIPHER_get_name(cipher);
+  }
+  if (preferred.empty()) {
+    LOG4CXX_WARN(logger_, "No preferred ciphers in cipher list");
+    return true;
+  }
+  const std::string ordered =
+      others.empty() ? preferred : preferred + ':' + others;
+  LOG4CXX_INFO(logger_, "Ordered cipher list: " << ordered);
+  if (!SSL_CTX_set_cipher_list(context_, ordered.c_str())) {
+    return false;
+  }
+  if (SERVER == mode_) {
+    // Server picks suite by its own order instead of client's one
+    SSL_CTX_set_options(context_, SSL_OP_CIPHER_SERVER_PREFERENCE);
+  }
+  return true;
+}
+
 std::string CryptoManagerImpl::LastError() const {
   if (!context_) {
     return std::string("Initialization is not completed");
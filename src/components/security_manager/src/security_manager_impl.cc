@@ -31,6 +31,7 @@
  */
 
 #include "security_manager/security_manager_impl.h"
+#include <sstream>
 #include "security_manager/crypto_manager_impl.h"
 #include "protocol_handler/protocol_packet.h"
 #include "utils/logger.h"
@@ -44,9 +45,32 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "SecurityManager")
 static const char* kErrId = "id";
 static const char* kErrText = "text";
 
-SecurityManagerImpl::SecurityManagerImpl()
+SecurityManagerImpl::SecurityManagerImpl(uint32_t handshake_threads)
   : security_messages_("SecurityManager", this),
-  session_observer_(NULL), crypto_manager_(NULL), protocol_handler_(NULL) {
+  handshake_pool_(NULL),
+  session_observer_(NULL), crypto_manager_(NULL), protocol_handler_(NULL),
+  listeners_lock_(true) {
+  if (handshake_threads > 0) {
+    handshake_pool_ = new threads::ThreadPool("SM Handshake",
+                                              handshake_threads);
+    // More queues than threads, so slow handshake of one device
+    // rarely delays other connections
+    const uint32_t queues_per_thread = 4;
+    const uint32_t queues_count = handshake_threads * queues_per_thread;
+    for (uint32_t i = 0; i < queues_count; ++i) {
+      handshake_queues_.push_back(new SecurityMessageLoop(
+          "SM Handshake", this, handshake_pool_));
+    }
+  }
+}
+
+SecurityManagerImpl::~SecurityManagerImpl() {
+  for (size_t i = 0; i < handshake_queues_.size(); ++i) {
+    delete handshake_queues_[i];
+  }
+  handshake_queues_.clear();
+  delete handshake_pool_;
+  handshake_pool_ = NULL;
 }
 
 void SecurityManagerImpl::OnMessageReceived(
@@ -68,8 +92,16 @@ void SecurityManagerImpl::OnMessageReceived(
   }
   securityMessagePtr->set_connection_key(message->connection_key());
 
-  // Post message to message query for next processing in thread
-  security_messages_.PostMessage(securityMessagePtr);
+  if (handshake_queues_.empty()) {
+    // Post message to message query for next processing in thread
+    security_messages_.PostMessage(securityMessagePtr);
+    return;
+  }
+  // Messages of connection keep their order while different
+  // connections handshake concurrently
+  const size_t queue_index =
+      message->connection_key() % handshake_queues_.size();
+  handshake_queues_[queue_index]->PostMessage(securityMessagePtr);
 }
 
 void SecurityManagerImpl::OnMobileMessageSent(
@@ -148,7 +180,7 @@ security_manager::SSLContext *SecurityManagerImpl::CreateSSLContext(
     return ssl_context;
   }
 
-  ssl_context = crypto_manager_->CreateSSLContext();
+  ssl_context = crypto_manager_->CreateSSLContext(PeerId(connection_key));
   if (!ssl_context) {
     const std::string error_text("CryptoManager could not create SSL context.");
     LOG4CXX_ERROR(logger_, error_text);
@@ -171,6 +203,26 @@ security_manager::SSLContext *SecurityManagerImpl::CreateSSLContext(
   return ssl_context;
 }
 
+std::string SecurityManagerImpl::PeerId(const uint32_t connection_key) {
+  uint32_t device_handle = 0;
+  if (0 != session_observer_->GetDataOnSessionKey(connection_key, NULL, NULL,
+                                                  &device_handle)) {
+    return std::string();
+  }
+  std::string mac_address;
+  if (0 != session_observer_->GetDataOnDeviceID(device_handle, NULL, NULL,
+                                                &mac_address, NULL)) {
+    return std::string();
+  }
+  uint32_t connection_handle = 0;
+  uint8_t session_id = 0;
+  session_observer_->PairFromKey(connection_key, &connection_handle,
+                                 &session_id);
+  std::stringstream peer_id;
+  peer_id << mac_address << '/' << static_cast<uint32_t>(session_id);
+  return peer_id.str();
+}
+
 void SecurityManagerImpl::StartHandshake(uint32_t connection_key) {
   DCHECK(session_observer_);
   LOG4CXX_INFO(logger_, "StartHandshake: connection_key " << connection_key);
@@ -211,6 +263,7 @@ void SecurityManagerImpl::AddListener(SecurityManagerListener *const listener) {
     LOG4CXX_ERROR(logger_, "Invalid (NULL) pointer to SecurityManagerListener.");
     return;
   }
+  sync_primitives::AutoLock lock(listeners_lock_);
   listeners_.push_back(listener);
 }
 void SecurityManagerImpl::RemoveListener(SecurityManagerListener *const listener) {
@@ -218,11 +271,13 @@ void SecurityManagerImpl::RemoveListener(SecurityManagerListener *const listener
     LOG4CXX_ERROR(logger_, "Invalid (NULL) pointer to SecurityManagerListener.");
     return;
   }
+  sync_primitives::AutoLock lock(listeners_lock_);
   listeners_.remove(listener);
 }
 void SecurityManagerImpl::NotifyListenersOnHandshakeDone(const uint32_t &connection_key,
                                                      const bool success) {
   LOG4CXX_TRACE(logger_, "NotifyListenersOnHandshakeDone");
+  sync_primitives::AutoLock lock(listeners_lock_);
   std::list<SecurityManagerListener*>::iterator it = listeners_.begin();
   while (it != listeners_.end()) {
     if ((*it)->OnHandshakeDone(connection_key, success)) {
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "security_manager/crypto_manager_impl.h"
+
+#include "utils/macro.h"
+
+#define SESSION_UP_REF_MINIMAL_VERSION  0x10100000L
+
+namespace security_manager {
+
+CryptoManagerImpl::SessionCache::SessionCache(size_t max_size)
+  : max_size_(max_size) {
+  DCHECK(max_size_ > 0);
+}
+
+CryptoManagerImpl::SessionCache::~SessionCache() {
+  Clear();
+}
+
+SSL_SESSION *CryptoManagerImpl::SessionCache::Get(const std::string &peer_id) {
+  sync_primitives::AutoLock lock(sessions_lock_);
+  SessionsMap::iterator it = sessions_.find(peer_id);
+  if (sessions_.end() == it) {
+    return NULL;
+  }
+  recent_peers_.splice(recent_peers_.begin(), recent_peers_,
+                       it->second.position);
+#if OPENSSL_VERSION_NUMBER < SESSION_UP_REF_MINIMAL_VERSION
+  CRYPTO_add(&it->second.session->references, 1, CRYPTO_LOCK_SSL_SESSION);
+#else
+  SSL_SESSION_up_ref(it->second.session);
+#endif
+  return it->second.session;
+}
+
+void CryptoManagerImpl::SessionCache::Put(const std::string &peer_id,
+                                          SSL_SESSION *session) {
+  if (!session) {
+    return;
+  }
+  sync_primitives::AutoLock lock(sessions_lock_);
+  SessionsMap::iterator it = sessions_.find(peer_id);
+  if (sessions_.end() != it) {
+    Erase(it);
+  }
+  while (sessions_.size() >= max_size_) {
+    Erase(sessions_.find(recent_peers_.back()));
+  }
+  recent_peers_.push_front(peer_id);
+  Entry entry = { session, recent_peers_.begin() };
+  sessions_.insert(std::make_pair(peer_id, entry));
+}
+
+void CryptoManagerImpl::SessionCache::Remove(const std::string &peer_id) {
+  sync_primitives::AutoLock lock(sessions_lock_);
+  SessionsMap::iterator it = sessions_.find(peer_id);
+  if (sessions_.end() != it) {
+    Erase(it);
+  }
+}
+
+void CryptoManagerImpl::SessionCache::Clear() {
+  sync_primitives::AutoLock lock(sessions_lock_);
+  while (!sessions_.empty()) {
+    Erase(sessions_.begin());
+  }
+}
+
+void CryptoManagerImpl::SessionCache::Erase(SessionsMap::iterator it) {
+  DCHECK(sessions_.end() != it);
+  SSL_SESSION_free(it->second.session);
+  recent_peers_.erase(it->second.position);
+  sessions_.erase(it);
+}
+
+}  // namespace security_manager
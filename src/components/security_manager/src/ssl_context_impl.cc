@@ -42,18 +42,62 @@
 
 namespace security_manager {
 
-CryptoManagerImpl::SSLContextImpl::SSLContextImpl(SSL *conn, Mode mode)
+namespace {
+// TODO(EZamakhov): get MTU by parameter (from transport)
+// default buffer size is TCP MTU
+const size_t kDefaultBufferSize = 1500;
+}  // namespace
+
+CryptoManagerImpl::SSLContextImpl::SSLContextImpl(
+    SSL *conn, Mode mode, SessionCache *session_cache,
+    const std::string &peer_id)
   : connection_(conn),
     bioIn_(BIO_new(BIO_s_mem())),
     bioOut_(BIO_new(BIO_s_mem())),
     bioFilter_(NULL),
-    // TODO(EZamakhov): get MTU by parameter (from transport)
-    // default buffer size is TCP MTU
-    buffer_size_(1500),
-    buffer_(new uint8_t[buffer_size_]),
+    handshake_buffer_(kDefaultBufferSize),
+    encrypt_buffer_(kDefaultBufferSize),
+    decrypt_buffer_(kDefaultBufferSize),
     is_handshake_pending_(false),
-    mode_(mode) {
+    mode_(mode),
+    session_cache_(session_cache),
+    max_block_size_(NULL) {
   SSL_set_bio(connection_, bioIn_, bioOut_);
+  SetPeer(peer_id);
+}
+
+void CryptoManagerImpl::SSLContextImpl::Reset(const std::string &peer_id) {
+  sync_primitives::AutoLock locker(bio_locker);
+  if (bioFilter_) {
+    BIO_free(bioFilter_);
+    bioFilter_ = NULL;
+  }
+  SSL_shutdown(connection_);
+  SSL_clear(connection_);
+  SSL_set_session(connection_, NULL);
+  // Drop records left from previous connection
+  BIO_reset(bioIn_);
+  BIO_reset(bioOut_);
+  if (SERVER == mode_) {
+    SSL_set_accept_state(connection_);
+  } else {
+    SSL_set_connect_state(connection_);
+  }
+  is_handshake_pending_ = false;
+  max_block_size_ = NULL;
+  SetPeer(peer_id);
+}
+
+void CryptoManagerImpl::SSLContextImpl::SetPeer(const std::string &peer_id) {
+  peer_id_ = peer_id;
+  // Server finds resumed session in SSL_CTX cache by itself
+  if (session_cache_ && !peer_id_.empty() && CLIENT == mode_) {
+    SSL_SESSION *session = session_cache_->Get(peer_id_);
+    if (session) {
+      SSL_set_session(connection_, session);
+      SSL_SESSION_free(session);
+    }
+  }
 }
 
 std::string CryptoManagerImpl::SSLContextImpl::LastError() const {
@@ -150,6 +194,7 @@ DoHandshakeStep(const uint8_t*  const in_data,  size_t in_data_size,
     if (ret <= 0) {
       is_handshake_pending_ = false;
       SSL_clear(connection_);
+      ForgetSession();
       return SSLContext::Handshake_Result_AbnormalFail;
     }
   }
@@ -157,18 +202,27 @@ DoHandshakeStep(const uint8_t*  const in_data,  size_t in_data_size,
   const int handshake_result = SSL_do_handshake(connection_);
   if (handshake_result == 1) {
     // Handshake is successful
+    if (bioFilter_) {
+      BIO_free(bioFilter_);
+    }
     bioFilter_ = BIO_new(BIO_f_ssl());
     BIO_set_ssl(bioFilter_, connection_, BIO_NOCLOSE);
 
     const SSL_CIPHER *cipher = SSL_get_current_cipher(connection_);
     max_block_size_ = max_block_sizes[SSL_CIPHER_get_name(cipher)];
     is_handshake_pending_ = false;
+    if (session_cache_ && !peer_id_.empty() && CLIENT == mode_) {
+      // Resumed session is stored again to renew its usage order
+      session_cache_->Put(peer_id_, SSL_get1_session(connection_));
+    }
   } else if (handshake_result == 0) {
     SSL_clear(connection_);
+    ForgetSession();
     is_handshake_pending_ = false;
     return SSLContext::Handshake_Result_Fail;
   } else if (SSL_get_error(connection_, handshake_result) != SSL_ERROR_WANT_READ) {
     SSL_clear(connection_);
+    ForgetSession();
     is_handshake_pending_ = false;
     return SSLContext::Handshake_Result_AbnormalFail;
   }
@@ -176,15 +230,16 @@ DoHandshakeStep(const uint8_t*  const in_data,  size_t in_data_size,
   const size_t pend = BIO_ctrl_pending(bioOut_);
 
   if (pend) {
-    EnsureBufferSizeEnough(pend);
+    uint8_t *buffer = EnsureBufferSizeEnough(&handshake_buffer_, pend);
 
-    const int read_count = BIO_read(bioOut_, buffer_, pend);
+    const int read_count = BIO_read(bioOut_, buffer, pend);
     if (read_count  == static_cast<int>(pend)) {
       *out_data_size = read_count;
-      *out_data =  buffer_;
+      *out_data =  buffer;
     } else {
       is_handshake_pending_ = false;
       SSL_clear(connection_);
+      ForgetSession();
       return SSLContext::Handshake_Result_AbnormalFail;
     }
   }
@@ -192,22 +247,29 @@ DoHandshakeStep(const uint8_t*  const in_data,  size_t in_data_size,
   return SSLContext::Handshake_Result_Success;
 }
 
+size_t CryptoManagerImpl::SSLContextImpl::WriteForEncryption(
+    const uint8_t *const in_data, size_t in_data_size) {
+  if (!SSL_is_init_finished(connection_) ||
+      !in_data ||
+      !in_data_size) {
+    return 0;
+  }
+  BIO_write(bioFilter_, in_data, in_data_size);
+  return BIO_ctrl_pending(bioOut_);
+}
+
 bool CryptoManagerImpl::SSLContextImpl::Encrypt(
     const uint8_t *  const in_data,  size_t in_data_size,
     const uint8_t ** const out_data, size_t *out_data_size) {
 
   sync_primitives::AutoLock locker(bio_locker);
-  if (!SSL_is_init_finished(connection_) ||
-      !in_data ||
-      !in_data_size) {
+  const size_t len = WriteForEncryption(in_data, in_data_size);
+  if (!len) {
     return false;
   }
 
-  BIO_write(bioFilter_, in_data, in_data_size);
-  const size_t len = BIO_ctrl_pending(bioOut_);
-
-  EnsureBufferSizeEnough(len);
-  const int read_size = BIO_read(bioOut_, buffer_, len);
+  uint8_t *buffer = EnsureBufferSizeEnough(&encrypt_buffer_, len);
+  const int read_size = BIO_read(bioOut_, buffer, len);
   DCHECK(len == static_cast<size_t>(read_size));
   if (read_size <= 0) {
     // Reset filter and connection deinitilization instead
@@ -215,11 +277,38 @@ bool CryptoManagerImpl::SSLContextImpl::Encrypt(
     return false;
   }
   *out_data_size = read_size;
-  *out_data = buffer_;
+  *out_data = buffer;
 
   return true;
 }
 
+bool CryptoManagerImpl::SSLContextImpl::Encrypt(
+    const uint8_t *const in_data, size_t in_data_size,
+    utils::BufferSlice *out_data) {
+  DCHECK(out_data);
+  sync_primitives::AutoLock locker(bio_locker);
+  const size_t len = WriteForEncryption(in_data, in_data_size);
+  if (!len) {
+    return false;
+  }
+
+  // Records are read right into storage sent with the packet
+  utils::BufferSlice buffer(len);
+  if (buffer.empty()) {
+    BIO_ctrl(bioFilter_, BIO_CTRL_RESET, 0, NULL);
+    return false;
+  }
+  const int read_size = BIO_read(bioOut_, buffer.data(), len);
+  DCHECK(len == static_cast<size_t>(read_size));
+  if (read_size <= 0) {
+    // Reset filter and connection deinitilization instead
+    BIO_ctrl(bioFilter_, BIO_CTRL_RESET, 0, NULL);
+    return false;
+  }
+  *out_data = buffer.Slice(0, read_size);
+  return true;
+}
+
 bool CryptoManagerImpl::SSLContextImpl::Decrypt(
     const uint8_t *  const in_data,  size_t in_data_size,
     const uint8_t ** const out_data, size_t *out_data_size) {
@@ -238,8 +327,12 @@ bool CryptoManagerImpl::SSLContextImpl::Decrypt(
 
   *out_data_size = 0;
   while (len) {
-    EnsureBufferSizeEnough(len + offset);
-    len = BIO_read(bioFilter_, buffer_ + offset, len);
+    uint8_t *buffer = EnsureBufferSizeEnough(&decrypt_buffer_, len + offset);
+    len = BIO_read(bioFilter_, buffer + offset, len);
+    if (len <= 0 && BIO_should_retry(bioFilter_)) {
+      // Rest of record comes with next data
+      break;
+    }
     // TODO(EZamakhov): investigate BIO_read return 0, -1 and -2 meanings
     if (len <= 0) {
       // Reset filter and connection deinitilization instead
@@ -250,7 +343,7 @@ bool CryptoManagerImpl::SSLContextImpl::Decrypt(
     offset += len;
     len = BIO_ctrl_pending(bioFilter_);
   }
-  *out_data = buffer_;
+  *out_data = &decrypt_buffer_[0];
   return true;
 }
 
@@ -269,19 +362,27 @@ bool CryptoManagerImpl::SSLContextImpl::IsHandshakePending() const {
 }
 
 CryptoManagerImpl::SSLContextImpl::~SSLContextImpl() {
+  if (bioFilter_) {
+    BIO_free(bioFilter_);
+  }
   SSL_shutdown(connection_);
   SSL_free(connection_);
-  delete[] buffer_;
 }
 
-void CryptoManagerImpl::SSLContextImpl::EnsureBufferSizeEnough(size_t size) {
-  if (buffer_size_ < size) {
-    delete[] buffer_;
-    buffer_ = new(std::nothrow) uint8_t[size];
-    if (buffer_) {
-      buffer_size_ = size;
-    }
+void CryptoManagerImpl::SSLContextImpl::ForgetSession() {
+  if (session_cache_ && !peer_id_.empty() && CLIENT == mode_) {
+    session_cache_->Remove(peer_id_);
+  }
+}
+
+uint8_t *CryptoManagerImpl::SSLContextImpl::EnsureBufferSizeEnough(
+    Buffer *buffer, size_t size) {
+  DCHECK(buffer);
+  if (buffer->size() < size) {
+    // Decrypted data is appended, so already read part is kept
+    buffer->resize(size);
   }
+  return &(*buffer)[0];
 }
 
 }  // namespace security_manager
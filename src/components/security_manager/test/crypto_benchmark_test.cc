@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "protocol/common.h"
+#include "security_manager/crypto_manager_impl.h"
+#include "security_manager/ssl_context.h"
+#include "utils/buffer_slice.h"
+#include "utils/date_time.h"
+
+namespace test {
+namespace components {
+namespace security_manager_test {
+
+using security_manager::CryptoManagerImpl;
+using security_manager::SSLContext;
+
+struct BenchmarkCipher {
+  const char *name;
+  CryptoManagerImpl::CipherPreference preference;
+};
+
+namespace {
+const size_t kBenchmarkBytes = 16 * 1024 * 1024;
+const size_t kMaxHandshakeSteps = 16;
+
+/*
+ * Reports rate of processing given bytes count in given microseconds
+ */
+double MegabytesPerSecond(size_t bytes, int64_t usecs) {
+  return usecs ? static_cast<double>(bytes) / usecs : 0.0;
+}
+}  // namespace
+
+/*
+ * Measures data encryption and decryption of established connection,
+ * engine to compare software implementation with is taken from
+ * CRYPTO_ENGINE environment variable
+ */
+class CryptoBenchmarkTest : public testing::TestWithParam<BenchmarkCipher> {
+ protected:
+  CryptoBenchmarkTest()
+    : server_ctx(NULL),
+      client_ctx(NULL) {
+  }
+
+  virtual void SetUp() {
+    const char *engine = getenv("CRYPTO_ENGINE");
+    if (engine) {
+      server_manager.set_crypto_engine(engine);
+      client_manager.set_crypto_engine(engine);
+    }
+    server_manager.set_cipher_preference(GetParam().preference);
+    initialized =
+        server_manager.Init(security_manager::SERVER, security_manager::TLSv1_2,
+                            "mycert.pem", "mykey.pem", GetParam().name, false) &&
+        client_manager.Init(security_manager::CLIENT, security_manager::TLSv1_2,
+                            "", "", GetParam().name, false);
+    if (initialized) {
+      server_ctx = server_manager.CreateSSLContext("");
+      client_ctx = client_manager.CreateSSLContext("");
+    }
+  }
+
+  virtual void TearDown() {
+    server_manager.ReleaseSSLContext(server_ctx);
+    client_manager.ReleaseSSLContext(client_ctx);
+    server_manager.Finish();
+    client_manager.Finish();
+  }
+
+  bool DoHandshake() {
+    const uint8_t *client_buf;
+    size_t client_buf_len;
+    if (SSLContext::Handshake_Result_Success !=
+        client_ctx->StartHandshake(&client_buf, &client_buf_len)) {
+      return false;
+    }
+    for (size_t step = 0; step < kMaxHandshakeSteps; ++step) {
+      if (server_ctx->IsInitCompleted() && client_ctx->IsInitCompleted()) {
+        return true;
+      }
+      const uint8_t *server_buf;
+      size_t server_buf_len;
+      if (SSLContext::Handshake_Result_Success !=
+          server_ctx->DoHandshakeStep(client_buf, client_buf_len,
+                                      &server_buf, &server_buf_len)) {
+        return false;
+      }
+      if (SSLContext::Handshake_Result_Success !=
+          client_ctx->DoHandshakeStep(server_buf, server_buf_len,
+                                      &client_buf, &client_buf_len)) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  CryptoManagerImpl server_manager;
+  CryptoManagerImpl client_manager;
+  SSLContext *server_ctx;
+  SSLContext *client_ctx;
+  bool initialized;
+};
+
+TEST_P(CryptoBenchmarkTest, EncryptDecrypt_Throughput) {
+  if (!initialized) {
+    // Not every OpenSSL build has all benchmarked suites
+    std::cout << GetParam().name << " is not supported" << std::endl;
+    return;
+  }
+  ASSERT_TRUE(DoHandshake());
+
+  const size_t block_size =
+      client_ctx->get_max_block_size(protocol_handler::MAXIMUM_FRAME_DATA_SIZE);
+  ASSERT_GT(block_size, 0u);
+  std::vector<uint8_t> block(block_size);
+  for (size_t i = 0; i < block.size(); ++i) {
+    block[i] = static_cast<uint8_t>(i);
+  }
+  const size_t blocks_count = kBenchmarkBytes / block_size;
+
+  std::vector<utils::BufferSlice> encrypted;
+  encrypted.reserve(blocks_count);
+  const TimevalStruct encrypt_start = date_time::DateTime::getCurrentTime();
+  for (size_t i = 0; i < blocks_count; ++i) {
+    utils::BufferSlice out_data;
+    ASSERT_TRUE(client_ctx->Encrypt(&block[0], block.size(), &out_data));
+    encrypted.push_back(out_data);
+  }
+  const int64_t encrypt_usecs = date_time::DateTime::getuSecs(
+      date_time::DateTime::Sub(date_time::DateTime::getCurrentTime(),
+                               encrypt_start));
+
+  const TimevalStruct decrypt_start = date_time::DateTime::getCurrentTime();
+  for (size_t i = 0; i < encrypted.size(); ++i) {
+    const uint8_t *out_data;
+    size_t out_data_size;
+    ASSERT_TRUE(server_ctx->Decrypt(encrypted[i].data(), encrypted[i].size(),
+                                    &out_data, &out_data_size));
+    ASSERT_EQ(block.size(), out_data_size);
+  }
+  const int64_t decrypt_usecs = date_time::DateTime::getuSecs(
+      date_time::DateTime::Sub(date_time::DateTime::getCurrentTime(),
+                               decrypt_start));
+
+  // Timings depend on hardware and load, so they are reported only
+  const size_t total_bytes = blocks_count * block_size;
+  std::cout << GetParam().name << ": "
+            << "encrypt " << MegabytesPerSecond(total_bytes, encrypt_usecs)
+            << " MB/s, decrypt "
+            << MegabytesPerSecond(total_bytes, decrypt_usecs) << " MB/s"
+            << std::endl;
+  RecordProperty("encrypt_usecs", static_cast<int>(encrypt_usecs));
+  RecordProperty("decrypt_usecs", static_cast<int>(decrypt_usecs));
+}
+
+const BenchmarkCipher kBenchmarkCiphers[] = {
+  {"AES128-GCM-SHA256", CryptoManagerImpl::PREFER_AES_GCM},
+  {"AES256-GCM-SHA384", CryptoManagerImpl::PREFER_AES_GCM},
+  {"ECDHE-RSA-CHACHA20-POLY1305", CryptoManagerImpl::PREFER_CHACHA20},
+  {"AES128-SHA", CryptoManagerImpl::NO_PREFERENCE}
+};
+
+INSTANTIATE_TEST_CASE_P(Ciphers, CryptoBenchmarkTest,
+                        testing::ValuesIn(kBenchmarkCiphers));
+
+}  // namespace security_manager_test
+}  // namespace components
+}  // namespace test
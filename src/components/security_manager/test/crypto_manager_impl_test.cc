@@ -35,6 +35,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <vector>
 
 #include "security_manager/crypto_manager.h"
 #include "security_manager/crypto_manager_impl.h"
@@ -92,8 +93,8 @@ class SSLTest : public testing::Test {
   }
 
   virtual void SetUp() {
-    server_ctx = crypto_manager->CreateSSLContext();
-    client_ctx = client_manager->CreateSSLContext();
+    server_ctx = crypto_manager->CreateSSLContext("");
+    client_ctx = client_manager->CreateSSLContext("");
   }
 
   virtual void TearDown() {
@@ -112,7 +113,7 @@ security_manager::CryptoManager* SSLTest::client_manager;
 
 TEST(CryptoManagerTest, UsingBeforeInit) {
   security_manager::CryptoManager *crypto_manager = new security_manager::CryptoManagerImpl();
-  EXPECT_TRUE(crypto_manager->CreateSSLContext() == NULL);
+  EXPECT_TRUE(crypto_manager->CreateSSLContext("") == NULL);
   EXPECT_EQ(crypto_manager->LastError(), std::string ("Initialization is not completed"));
   delete crypto_manager;
 }
@@ -199,6 +200,68 @@ TEST_F(SSLTest, BrokenHandshake) {
           &server_buf_len));
 }
 
+TEST_F(SSLTest, ReleasedContextReused) {
+  crypto_manager->ReleaseSSLContext(server_ctx);
+  security_manager::SSLContext *reused_ctx =
+      crypto_manager->CreateSSLContext("");
+  EXPECT_EQ(server_ctx, reused_ctx);
+  server_ctx = reused_ctx;
+  ASSERT_FALSE(server_ctx->IsInitCompleted());
+
+  const uint8_t *server_buf;
+  const uint8_t *client_buf;
+  size_t server_buf_len;
+  size_t client_buf_len;
+  ASSERT_EQ(security_manager::SSLContext::Handshake_Result_Success,
+      client_ctx->StartHandshake(&client_buf,
+          &client_buf_len));
+  ASSERT_GT(client_buf_len, 0u);
+  EXPECT_EQ(security_manager::SSLContext::Handshake_Result_Success,
+      server_ctx->DoHandshakeStep(client_buf,
+          client_buf_len,
+          &server_buf,
+          &server_buf_len));
+  EXPECT_GT(server_buf_len, 0u);
+}
+
+TEST_F(SSLTest, Decrypt_RecordsSplitToFrames) {
+  const uint8_t *server_buf;
+  const uint8_t *client_buf;
+  size_t server_buf_len;
+  size_t client_buf_len;
+  ASSERT_EQ(security_manager::SSLContext::Handshake_Result_Success,
+      client_ctx->StartHandshake(&client_buf, &client_buf_len));
+  while (!server_ctx->IsInitCompleted() || !client_ctx->IsInitCompleted()) {
+    ASSERT_EQ(security_manager::SSLContext::Handshake_Result_Success,
+        server_ctx->DoHandshakeStep(client_buf, client_buf_len,
+                                    &server_buf, &server_buf_len));
+    ASSERT_EQ(security_manager::SSLContext::Handshake_Result_Success,
+        client_ctx->DoHandshakeStep(server_buf, server_buf_len,
+                                    &client_buf, &client_buf_len));
+  }
+
+  // Several full size records
+  std::vector<uint8_t> text(100000);
+  for (size_t i = 0; i < text.size(); ++i) {
+    text[i] = static_cast<uint8_t>(i);
+  }
+  utils::BufferSlice encrypted;
+  ASSERT_TRUE(client_ctx->Encrypt(&text[0], text.size(), &encrypted));
+
+  // Frames end in the middle of records
+  const size_t frame_size = 1488;
+  std::vector<uint8_t> decrypted;
+  for (size_t offset = 0; offset < encrypted.size(); offset += frame_size) {
+    const utils::BufferSlice frame = encrypted.Slice(offset, frame_size);
+    const uint8_t *out_data;
+    size_t out_data_size;
+    ASSERT_TRUE(server_ctx->Decrypt(frame.data(), frame.size(),
+                                    &out_data, &out_data_size));
+    decrypted.insert(decrypted.end(), out_data, out_data + out_data_size);
+  }
+  EXPECT_EQ(text, decrypted);
+}
+
 // TODO(EZamakhov): split to SSL/TLS1/1.1/1.2 tests
 // TODO{ALeshin}: APPLINK-10846
 //TEST_F(SSLTest, Positive) {
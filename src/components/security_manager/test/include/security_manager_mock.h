@@ -184,8 +184,8 @@ class CryptoManagerMock : public security_manager::CryptoManager {
           bool verify_peer));
   MOCK_METHOD0(Finish,
       void ());
-  MOCK_METHOD0(CreateSSLContext,
-      security_manager::SSLContext* ());
+  MOCK_METHOD1(CreateSSLContext,
+      security_manager::SSLContext* (const std::string& peer_id));
   MOCK_METHOD1(ReleaseSSLContext,
       void(security_manager::SSLContext*));
   MOCK_CONST_METHOD0(LastError,
@@ -207,6 +207,8 @@ class SSLContextMock : public security_manager::SSLContext {
   MOCK_METHOD4(Encrypt,
       bool (const uint8_t* const, size_t,
           const uint8_t** const, size_t*));
+  MOCK_METHOD3(Encrypt,
+      bool (const uint8_t* const, size_t, ::utils::BufferSlice*));
   MOCK_METHOD4(Decrypt,
       bool (const uint8_t* const, size_t,
           const uint8_t** const, size_t*));
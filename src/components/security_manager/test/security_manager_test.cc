@@ -329,6 +329,29 @@ TEST_F(SecurityManagerTest, GetInvalidQueryId) {
   const uint8_t data = 0;
   EmulateMobileMessage(header, &data, 1);
 }
+/*
+ * Shall process queries the same way on handshake threads
+ */
+TEST_F(SecurityManagerTest, GetInvalidQueryId_HandshakeThreads) {
+  security_manager_.reset(new SecurityManagerImpl(2));
+  security_manager_->set_session_observer(&mock_session_observer);
+  security_manager_->set_protocol_handler(&mock_protocol_handler);
+  SetMockCryptoManger();
+  uint32_t connection_id = 0;
+  uint8_t session_id = 0;
+  EXPECT_CALL(mock_session_observer, PairFromKey(key, _, _));
+  EXPECT_CALL(mock_session_observer, ProtocolVersionUsed(connection_id, session_id,_)).
+    WillOnce(Return(true));
+  // Expect InternalError with ERROR_ID
+  EXPECT_CALL(
+    mock_protocol_handler,
+    SendMessageToMobileApp( InternalErrorWithErrId( SecurityManager::ERROR_INVALID_QUERY_ID), is_final));
+  const SecurityQuery::QueryHeader header(
+          SecurityQuery::REQUEST,
+          SecurityQuery::INVALID_QUERY_ID);
+  const uint8_t data = 0;
+  EmulateMobileMessage(header, &data, 1);
+}
 /*
  * Shall send Internall Error on call
  * CreateSSLContext for already protected connections
@@ -362,7 +385,9 @@ TEST_F(SecurityManagerTest, CreateSSLContext_ErrorCreateSSL) {
   // Emulate SessionObserver and CryptoManager result
   EXPECT_CALL(mock_session_observer, GetSSLContext(key, kControl)).
       WillOnce(ReturnNull());
-  EXPECT_CALL(mock_crypto_manager, CreateSSLContext()).
+  EXPECT_CALL(mock_session_observer, GetDataOnSessionKey(key, NULL, NULL, _)).
+      WillOnce(Return(-1));
+  EXPECT_CALL(mock_crypto_manager, CreateSSLContext(std::string())).
       WillOnce(ReturnNull());
 
   const bool rezult = security_manager_->CreateSSLContext(key);
@@ -389,7 +414,9 @@ TEST_F(SecurityManagerTest, CreateSSLContext_SetSSLContextError) {
   // Emulate SessionObserver and CryptoManager result
   EXPECT_CALL(mock_session_observer, GetSSLContext(key, kControl)).
       WillOnce(ReturnNull());
-  EXPECT_CALL(mock_crypto_manager, CreateSSLContext()).
+  EXPECT_CALL(mock_session_observer, GetDataOnSessionKey(key, NULL, NULL, _)).
+      WillOnce(Return(-1));
+  EXPECT_CALL(mock_crypto_manager, CreateSSLContext(std::string())).
       WillOnce(Return(&mock_ssl_context_new));
   EXPECT_CALL(mock_crypto_manager, ReleaseSSLContext(&mock_ssl_context_new));
   EXPECT_CALL(mock_session_observer, SetSSLContext(key, &mock_ssl_context_new)).
@@ -411,7 +438,18 @@ TEST_F(SecurityManagerTest, CreateSSLContext_Success) {
       WillOnce(ReturnNull()).
       // additional check for debug code
       WillOnce(Return(&mock_ssl_context_exists));
-  EXPECT_CALL(mock_crypto_manager, CreateSSLContext()).
+  // Session is resumed by device address and session number
+  const uint32_t device_handle = 0x3;
+  const std::string mac_address("01:02:03:04:05:06");
+  const uint8_t session_id = 0x5;
+  EXPECT_CALL(mock_session_observer, GetDataOnSessionKey(key, NULL, NULL, _)).
+      WillOnce(DoAll(SetArgPointee<3>(device_handle), Return(0)));
+  EXPECT_CALL(mock_session_observer,
+              GetDataOnDeviceID(device_handle, NULL, NULL, _, NULL)).
+      WillOnce(DoAll(SetArgPointee<3>(mac_address), Return(0)));
+  EXPECT_CALL(mock_session_observer, PairFromKey(key, _, _)).
+      WillOnce(SetArgPointee<2>(session_id));
+  EXPECT_CALL(mock_crypto_manager, CreateSSLContext(mac_address + "/5")).
       WillOnce(Return(&mock_ssl_context_new));
   EXPECT_CALL(mock_session_observer, SetSSLContext(key, &mock_ssl_context_new)).
       WillOnce(Return(SecurityManager::ERROR_SUCCESS));
@@ -83,6 +83,15 @@ class CArraySchemaItem : public ISchemaItem {
    **/
   void unapplySchema(SmartObject& Object) OVERRIDE;
 
+  /**
+   * @brief Apply schema and validate object in a single pass.
+   *
+   * @param Object Object to apply schema and validate.
+   *
+   * @return NsSmartObjects::Errors::eType
+   **/
+  Errors::eType applySchemaAndValidate(SmartObject& Object) OVERRIDE;
+
   /**
    * @brief Build smart object by smart schema having copied matched
    *        parameters from pattern smart object
@@ -33,11 +33,13 @@
 #ifndef SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_ENUM_SCHEMA_ITEM_H_
 #define SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_ENUM_SCHEMA_ITEM_H_
 
+#include <stdint.h>
 #include <string.h>
 
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "utils/shared_ptr.h"
 #include "smart_objects/default_shema_item.h"
@@ -112,6 +114,39 @@ struct CStringComparator {
   }
 };
 
+/**
+ * @brief Collision free hash table of enum strings.
+ *
+ * Hash seed and table size are picked on construction so that every
+ * string gets its own slot, thus lookup is one hash and one strcmp.
+ **/
+class CStringHashTable {
+ public:
+  static const size_t kNotFound = static_cast<size_t>(-1);
+  /**
+   * @brief Constructor.
+   * @param strings Distinct strings to index, must outlive the table.
+   **/
+  explicit CStringHashTable(const std::vector<const char*>& strings);
+  /**
+   * @brief Finds string.
+   * @param str String to find.
+   * @return Index of the string in strings or kNotFound.
+   **/
+  size_t Find(const char* str) const;
+
+ private:
+  static uint32_t Hash(const char* str, uint32_t seed);
+  bool Build(size_t table_size, uint32_t seed);
+
+  const std::vector<const char*> strings_;
+  uint32_t seed_;
+  uint32_t mask_;
+  // Index of the string occupying slot or -1
+  std::vector<int32_t> slots_;
+  DISALLOW_COPY_AND_ASSIGN(CStringHashTable);
+};
+
 template <typename EnumType>
 class EnumConversionHelper {
  public:
@@ -127,12 +162,14 @@ class EnumConversionHelper {
   }
 
   static bool CStringToEnum(const char* str, EnumType* value) {
-    typename CStringToEnumMap::const_iterator it = cstring_to_enum_map().find(str);
-    if (it == cstring_to_enum_map().end()) {
+    // Built on first use as the string map is
+    static const CStringHashIndex hash_index(cstring_to_enum_map());
+    const size_t index = hash_index.table.Find(str);
+    if (CStringHashTable::kNotFound == index) {
       return false;
     }
     if (value) {
-      *value = it->second;
+      *value = hash_index.values[index];
     }
     return true;
   }
@@ -169,6 +206,31 @@ class EnumConversionHelper {
   static const EnumToCStringMap enum_to_cstring_map_;
   static const CStringToEnumMap cstring_to_enum_map_;
 
+  /**
+   * @brief Hash table of the string map keys with values in the same order.
+   **/
+  struct CStringHashIndex {
+    explicit CStringHashIndex(const CStringToEnumMap& map)
+      : table(Keys(map)) {
+      values.reserve(map.size());
+      for (typename CStringToEnumMap::const_iterator it = map.begin();
+           it != map.end(); ++it) {
+        values.push_back(it->second);
+      }
+    }
+    static std::vector<const char*> Keys(const CStringToEnumMap& map) {
+      std::vector<const char*> keys;
+      keys.reserve(map.size());
+      for (typename CStringToEnumMap::const_iterator it = map.begin();
+           it != map.end(); ++it) {
+        keys.push_back(it->first);
+      }
+      return keys;
+    }
+    const CStringHashTable table;
+    std::vector<EnumType> values;
+  };
+
   struct Size {
     enum {value = sizeof(cstring_values_) / sizeof(cstring_values_[0])};
   };
@@ -35,6 +35,7 @@
 #include <map>
 #include <string>
 #include <set>
+#include <vector>
 
 #include "utils/macro.h"
 #include "utils/shared_ptr.h"
@@ -100,6 +101,12 @@ class CObjectSchemaItem : public ISchemaItem {
    * @param Object Object to unapply schema.
    **/
   void unapplySchema(SmartObject& Object) OVERRIDE;
+  /**
+   * @brief Apply schema and validate object in a single pass.
+   * @param Object Object to apply schema and validate.
+   * @return NsSmartObjects::Errors::eType
+   **/
+  Errors::eType applySchemaAndValidate(SmartObject& Object) OVERRIDE;
   /**
    * @brief Build smart object by smart schema having copied matched
    *        parameters from pattern smart object
@@ -125,6 +132,22 @@ class CObjectSchemaItem : public ISchemaItem {
    * @brief Map of member name to SMember structure describing the object member.
    **/
   const Members mMembers;
+
+ private:
+  /**
+   * @brief Member flattened for validation.
+   **/
+  struct SFlatMember {
+    const std::string* mName;
+    ISchemaItem* mSchemaItem;
+    bool mIsMandatory;
+  };
+  typedef std::vector<SFlatMember> FlatMembers;
+  /**
+   * @brief mMembers in the same order laid out contiguously, items are
+   *        owned by mMembers.
+   **/
+  FlatMembers mFlatMembers;
   DISALLOW_COPY_AND_ASSIGN(CObjectSchemaItem);
 };
 }  // namespace NsSmartObjects
@@ -89,6 +89,18 @@ class ISchemaItem {
   virtual void unapplySchema(
       NsSmartDeviceLink::NsSmartObjects::SmartObject& Object);
 
+  /**
+   * @brief Apply schema and validate object in a single pass.
+   *
+   * Object is left the same as after applySchema and the result is the
+   * same as validate would return afterwards.
+   *
+   * @param Object Object to apply schema and validate.
+   *
+   * @return NsSmartObjects::Errors::eType
+   **/
+  virtual Errors::eType applySchemaAndValidate(SmartObject& Object);
+
   /**
    * @brief Build smart object by smart schema having copied matched
    *        parameters from pattern smart object
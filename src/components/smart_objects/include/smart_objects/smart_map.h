@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_SMART_MAP_H_
+#define SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_SMART_MAP_H_
+
+#include <stddef.h>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace NsSmartDeviceLink {
+namespace NsSmartObjects {
+class SmartObject;
+
+/**
+ * @brief Map of SmartObject members.
+ *
+ * Mimics subset of std::map<std::string, SmartObject> interface used by
+ * SmartObject. Elements are kept in pooled nodes, so references to them stay
+ * valid until element is erased, and node pointers are kept in a vector
+ * sorted by key. Lookup is a binary search over contiguous index and accepts
+ * C string keys (e.g. strings:: constants) without building std::string.
+ * Inserting or erasing invalidates iterators.
+ **/
+class SmartMap {
+ public:
+  typedef std::string key_type;
+  typedef SmartObject mapped_type;
+  typedef std::pair<const std::string, SmartObject> value_type;
+
+ private:
+  typedef std::vector<value_type*> Nodes;
+
+  template<typename Value>
+  class Iterator {
+   public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef SmartMap::value_type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    Iterator()
+      : node_(NULL) {
+    }
+    // Allows iterator to const_iterator conversion
+    Iterator(const Iterator<SmartMap::value_type>& other)
+      : node_(other.node()) {
+    }
+    reference operator*() const {
+      return **node_;
+    }
+    pointer operator->() const {
+      return *node_;
+    }
+    Iterator& operator++() {
+      ++node_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator result(*this);
+      ++node_;
+      return result;
+    }
+    Iterator& operator--() {
+      --node_;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator result(*this);
+      --node_;
+      return result;
+    }
+    // Allows comparison of iterator with const_iterator
+    template<typename OtherValue>
+    bool operator==(const Iterator<OtherValue>& other) const {
+      return node_ == other.node();
+    }
+    template<typename OtherValue>
+    bool operator!=(const Iterator<OtherValue>& other) const {
+      return node_ != other.node();
+    }
+    Value* const* node() const {
+      return node_;
+    }
+
+   private:
+    friend class SmartMap;
+    explicit Iterator(Value* const* node)
+      : node_(node) {
+    }
+    // Points to element of nodes_, so is dependent on Value and does not
+    // require SmartObject to be complete until dereferenced
+    Value* const* node_;
+  };
+
+ public:
+  typedef Iterator<value_type> iterator;
+  typedef Iterator<const value_type> const_iterator;
+
+  SmartMap();
+  SmartMap(const SmartMap& other);
+  SmartMap& operator=(const SmartMap& other);
+  ~SmartMap();
+
+  iterator begin() {
+    return iterator(nodes_.data());
+  }
+  iterator end() {
+    return iterator(nodes_.data() + nodes_.size());
+  }
+  const_iterator begin() const {
+    return const_iterator(nodes_.data());
+  }
+  const_iterator end() const {
+    return const_iterator(nodes_.data() + nodes_.size());
+  }
+  size_t size() const {
+    return nodes_.size();
+  }
+  bool empty() const {
+    return nodes_.empty();
+  }
+
+  iterator find(const std::string& key);
+  iterator find(const char* key);
+  const_iterator find(const std::string& key) const;
+  const_iterator find(const char* key) const;
+
+  /**
+   * @brief Returns element by key, inserting null object if it is absent
+   **/
+  SmartObject& operator[](const std::string& key);
+  SmartObject& operator[](const char* key);
+
+  /**
+   * @brief Removes element by key
+   * @return Count of removed elements
+   **/
+  size_t erase(const std::string& key);
+  size_t erase(const char* key);
+
+  void clear();
+  void swap(SmartMap& other);
+
+ private:
+  /**
+   * @brief Index of first node which key is not less than given one
+   **/
+  size_t LowerBound(const char* key, size_t key_length) const;
+  bool IsFound(size_t index, const char* key, size_t key_length) const;
+  SmartObject& Access(const char* key, size_t key_length);
+  size_t Erase(const char* key, size_t key_length);
+
+  static value_type* CreateNode(const value_type& value);
+  static void DestroyNode(value_type* node);
+
+  Nodes nodes_;
+};
+
+}  // namespace NsSmartObjects
+}  // namespace NsSmartDeviceLink
+#endif  // SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_SMART_MAP_H_
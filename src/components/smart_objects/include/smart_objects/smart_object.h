@@ -38,6 +38,7 @@
 #include <vector>
 #include <map>
 
+#include "smart_objects/smart_map.h"
 #include "smart_objects/smart_schema.h"
 
 namespace NsSmartDeviceLink {
@@ -105,14 +106,15 @@ enum SmartType {
 typedef std::vector<SmartObject> SmartArray;
 
 /**
- * @brief SmartMap type
+ * @brief SmartBinary type
  **/
-typedef std::map<std::string, SmartObject> SmartMap;
+typedef std::vector<uint8_t> SmartBinary;
 
 /**
- * @brief SmartBinary type
+ * @brief Binary data shared without copying by smart objects, messages
+ * and file writes. Shared data is never modified.
  **/
-typedef std::vector<uint8_t> SmartBinary;
+typedef utils::SharedPtr<const SmartBinary> SharedBinary;
 
 typedef utils::SharedPtr<SmartObject> SmartObjectSPtr;
 
@@ -143,6 +145,18 @@ class SmartObject FINAL {
    **/
   SmartObject(const SmartObject& Other);
 
+#ifdef SUPPORT_MOVE_SEMANTICS
+  /**
+   * @brief Move constructor.
+   *
+   * Takes over data of Other, which becomes null object unless it holds
+   * primitive value.
+   *
+   * @param Other Object to be moved from.
+   **/
+  SmartObject(SmartObject&& Other) noexcept;
+#endif
+
   /**
    * @brief Constructor for avoid cast
    * from unknown type
@@ -175,6 +189,27 @@ class SmartObject FINAL {
    **/
   SmartObject& operator=(const SmartObject& Other);
 
+#ifdef SUPPORT_MOVE_SEMANTICS
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param  Other Other SmartObject, may be element of this object
+   * @return SmartObject&
+   **/
+  SmartObject& operator=(SmartObject&& Other) noexcept;
+#endif
+
+  /**
+   * @brief Exchanges content (type, data and schema) with other object
+   * without copying.
+   *
+   * Allows to transfer built tree into another one in constant time
+   * where move semantics is not supported.
+   *
+   * @param Other Object to exchange content with
+   **/
+  void swap(SmartObject& Other);
+
   /**
    * @brief Comparison operator
    *
@@ -468,6 +503,14 @@ class SmartObject FINAL {
    **/
   explicit SmartObject(const SmartBinary& InitialValue);
 
+  /**
+   * @brief Constructor for creating object of type: binary
+   * sharing given data without copying it
+   *
+   * @param InitialValue Initial binary value
+   **/
+  explicit SmartObject(const SharedBinary& InitialValue);
+
   /**
    * @brief Returns current object converted to binary
    *
@@ -475,6 +518,20 @@ class SmartObject FINAL {
    **/
   SmartBinary asBinary() const;
 
+  /**
+   * @brief Returns binary value of object without copying it
+   *
+   * @return Pointer to binary value or NULL if object is not binary
+   **/
+  const SmartBinary* asBinaryPtr() const;
+
+  /**
+   * @brief Returns binary value of object shared with it
+   *
+   * @return Shared binary value, empty pointer if object is not binary
+   **/
+  SharedBinary asSharedBinary() const;
+
   /**
    * @brief Returns current object converted to array
    *
@@ -490,6 +547,22 @@ class SmartObject FINAL {
    **/
   SmartObject& operator=(const SmartBinary&);
 
+  /**
+   * @brief Assignment operator for type: binary, data is shared
+   *
+   * @param  NewValue New object value
+   * @return SmartObject&
+   **/
+  SmartObject& operator=(const SharedBinary&);
+
+  /**
+   * @brief Makes object binary exchanging its value with given one,
+   * so big binary data is taken over without copying
+   *
+   * @param Value Binary data to exchange value with
+   **/
+  void swapBinary(SmartBinary& Value);
+
   /**
    * @brief Comparison operator for comparing object with binary value
    *
@@ -600,6 +673,7 @@ class SmartObject FINAL {
    * @return bool
    **/
   bool keyExists(const std::string& Key) const;
+  bool keyExists(const char* Key) const;
 
   /**
    * @brief Removes element from the map.
@@ -609,6 +683,7 @@ class SmartObject FINAL {
    * @return true if success, false if there is no such element in the map
    */
   bool erase(const std::string& Key);
+  bool erase(const char* Key);
   /** @} */
 
   /**
@@ -816,6 +891,15 @@ class SmartObject FINAL {
    **/
   inline void set_value_binary(const SmartBinary& NewValue);
 
+  /**
+   * @brief Sets new shared binary value to the object.
+   *
+   * Empty pointer makes object hold empty binary value.
+   *
+   * @param NewValue New object value
+   **/
+  inline void set_value_binary(const SharedBinary& NewValue);
+
   /**
    * @brief Converts object to binary type
    *
@@ -838,6 +922,17 @@ class SmartObject FINAL {
    * @return SmartObject&
    **/
   inline SmartObject& handle_map_access(const std::string& Key);
+  inline SmartObject& handle_map_access(const char* Key);
+
+  /**
+   * @brief Returns map element by C string key without building std::string
+   *
+   * Is not a getElement overload to keep getElement(0) resolved to index.
+   *
+   * @param Key Key of element to retrieve
+   * @return Element of map or invalid object
+   **/
+  const SmartObject& get_map_element(const char* Key) const;
 
   /**
    * @brief Converts string to double
@@ -906,7 +1001,8 @@ class SmartObject FINAL {
     std::string* str_value;
     SmartArray* array_value;
     SmartMap* map_value;
-    SmartBinary* binary_value;
+    // Copies of object share binary data
+    SharedBinary* binary_value;
   } SmartData;
 
   /**
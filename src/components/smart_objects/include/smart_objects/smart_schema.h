@@ -83,6 +83,15 @@ class CSmartSchema FINAL {
    **/
   void applySchema(SmartObject& Object);
 
+  /**
+   * @brief Apply schema and validate smart object in a single pass.
+   *
+   * @param Object Object to apply schema and validate.
+   *
+   * @return Result of validation.
+   **/
+  Errors::eType applySchemaAndValidate(SmartObject& Object);
+
   /**
    * @brief The reverse SmartObject conversion using schema.
    *
@@ -81,6 +81,29 @@ void CArraySchemaItem::unapplySchema(SmartObject& Object) {
   }
 }
 
+Errors::eType CArraySchemaItem::applySchemaAndValidate(SmartObject& Object) {
+  if (SmartType_Array != Object.getType()) {
+    return Errors::INVALID_VALUE;
+  }
+  Errors::eType result = Errors::OK;
+  size_t sizeLimit;
+  const size_t array_len = Object.length();
+
+  if ((mMinSize.getValue(sizeLimit) && (array_len < sizeLimit)) ||
+      (mMaxSize.getValue(sizeLimit) && (array_len > sizeLimit))) {
+    result = Errors::OUT_OF_RANGE;
+  }
+  // Schema is applied to all elements, the first error is reported
+  for (size_t i = 0U; i < array_len; ++i) {
+    const Errors::eType element_result =
+      mElementSchemaItem->applySchemaAndValidate(Object[i]);
+    if (Errors::OK == result) {
+      result = element_result;
+    }
+  }
+  return result;
+}
+
 void CArraySchemaItem::BuildObjectBySchema(
     const SmartObject& pattern_object, SmartObject& result_object) {
   if (SmartType_Array == pattern_object.getType()) {
@@ -30,3 +30,64 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include "smart_objects/enum_schema_item.h"
+
+namespace {
+// Tries per table size before it is doubled
+const uint32_t kSeedsPerSize = 16;
+}  // namespace
+
+namespace NsSmartDeviceLink {
+namespace NsSmartObjects {
+
+const size_t CStringHashTable::kNotFound;
+
+CStringHashTable::CStringHashTable(const std::vector<const char*>& strings)
+  : strings_(strings),
+    seed_(0),
+    mask_(0) {
+  size_t table_size = 1;
+  while (table_size < strings_.size() * 2) {
+    table_size *= 2;
+  }
+  for (uint32_t seed = 0; !Build(table_size, seed); ++seed) {
+    if (kSeedsPerSize - 1 == seed % kSeedsPerSize) {
+      table_size *= 2;
+    }
+  }
+}
+
+size_t CStringHashTable::Find(const char* str) const {
+  const int32_t index = slots_[Hash(str, seed_) & mask_];
+  if (index < 0 || 0 != strcmp(strings_[index], str)) {
+    return kNotFound;
+  }
+  return static_cast<size_t>(index);
+}
+
+uint32_t CStringHashTable::Hash(const char* str, uint32_t seed) {
+  // FNV-1a with seeded offset basis
+  uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+  for (; *str; ++str) {
+    hash ^= static_cast<uint8_t>(*str);
+    hash *= 16777619u;
+  }
+  // Mix high bits into low ones used as slot index
+  return hash ^ (hash >> 16);
+}
+
+bool CStringHashTable::Build(size_t table_size, uint32_t seed) {
+  slots_.assign(table_size, -1);
+  seed_ = seed;
+  mask_ = static_cast<uint32_t>(table_size - 1);
+  for (size_t i = 0; i < strings_.size(); ++i) {
+    int32_t& slot = slots_[Hash(strings_[i], seed_) & mask_];
+    if (slot >= 0) {
+      return false;
+    }
+    slot = static_cast<int32_t>(i);
+  }
+  return true;
+}
+
+}  // namespace NsSmartObjects
+}  // namespace NsSmartDeviceLink
@@ -64,25 +64,28 @@ Errors::eType CObjectSchemaItem::validate(const SmartObject& object) {
     return Errors::INVALID_VALUE;
   }
 
-  std::set<std::string> object_keys = object.enumerate();
-
-  for (Members::const_iterator it = mMembers.begin(); it != mMembers.end(); ++it) {
-    const std::string& key = it->first;
-    const SMember& member = it->second;
-
-    std::set<std::string>::const_iterator key_it = object_keys.find(key);
-    if (object_keys.end() == key_it) {
-      if (member.mIsMandatory) {
+  // Members and map keys are sorted in the same order, so both are walked
+  // together without lookups
+  SmartMap::const_iterator field = object.map_begin();
+  const SmartMap::const_iterator fields_end = object.map_end();
+  for (FlatMembers::const_iterator it = mFlatMembers.begin();
+       it != mFlatMembers.end(); ++it) {
+    int compare_result = 1;
+    while (fields_end != field &&
+           (compare_result = field->first.compare(*it->mName)) < 0) {
+      ++field;
+    }
+    if (fields_end == field || 0 != compare_result) {
+      if (it->mIsMandatory) {
         return Errors::MISSING_MANDATORY_PARAMETER;
       }
       continue;
     }
-    const SmartObject& field = object.getElement(key);
-    const Errors::eType result = member.mSchemaItem->validate(field);
+    const Errors::eType result = it->mSchemaItem->validate(field->second);
     if (Errors::OK != result) {
       return result;
     }
-    object_keys.erase(key_it);
+    ++field;
   }
   return Errors::OK;
 }
@@ -127,16 +130,19 @@ void CObjectSchemaItem::unapplySchema(SmartObject& Object) {
   if (SmartType_Map != Object.getType()) {
     return;
   }
+  // erase invalidates map iterators, so fake params are collected first
+  std::vector<std::string> fake_params;
   for (SmartMap::const_iterator it = Object.map_begin();
-       it != Object.map_end();) {
-    const std::string& key = it->first;
-    // move next to avoid wrong iterator on erase
-    ++it;
-    if (mMembers.end() == mMembers.find(key)) {
-      // remove fake params
-      Object.erase(key);
+       it != Object.map_end(); ++it) {
+    if (mMembers.end() == mMembers.find(it->first)) {
+      fake_params.push_back(it->first);
     }
   }
+  for (std::vector<std::string>::const_iterator it = fake_params.begin();
+       it != fake_params.end(); ++it) {
+    // remove fake params
+    Object.erase(*it);
+  }
 
   for (Members::const_iterator it = mMembers.begin(); it != mMembers.end(); ++it) {
     const std::string& key = it->first;
@@ -147,6 +153,34 @@ void CObjectSchemaItem::unapplySchema(SmartObject& Object) {
   }
 }
 
+Errors::eType CObjectSchemaItem::applySchemaAndValidate(SmartObject& Object) {
+  if (SmartType_Map != Object.getType()) {
+    return Errors::INVALID_VALUE;
+  }
+  // Schema is applied to all members, the first error is reported
+  Errors::eType result = Errors::OK;
+  SmartObject default_value;
+  for (FlatMembers::const_iterator it = mFlatMembers.begin();
+       it != mFlatMembers.end(); ++it) {
+    const std::string& key = *it->mName;
+    if (!Object.keyExists(key)) {
+      if (!it->mSchemaItem->setDefaultValue(default_value)) {
+        if (it->mIsMandatory && Errors::OK == result) {
+          result = Errors::MISSING_MANDATORY_PARAMETER;
+        }
+        continue;
+      }
+      Object[key] = default_value;
+    }
+    const Errors::eType member_result =
+        it->mSchemaItem->applySchemaAndValidate(Object[key]);
+    if (Errors::OK == result) {
+      result = member_result;
+    }
+  }
+  return result;
+}
+
 void CObjectSchemaItem::BuildObjectBySchema(
   const SmartObject& pattern_object, SmartObject& result_object) {
   result_object = SmartObject(SmartType_Map);
@@ -167,7 +201,15 @@ size_t CObjectSchemaItem::GetMemberSize() {
 }
 
 CObjectSchemaItem::CObjectSchemaItem(const Members& members)
-  : mMembers(members) {}
+  : mMembers(members) {
+  mFlatMembers.reserve(mMembers.size());
+  for (Members::const_iterator it = mMembers.begin(); it != mMembers.end(); ++it) {
+    const SFlatMember flat_member = {
+      &it->first, it->second.mSchemaItem.get(), it->second.mIsMandatory
+    };
+    mFlatMembers.push_back(flat_member);
+  }
+}
 
 }  // namespace NsSmartObjects
 }  // namespace NsSmartDeviceLink
@@ -53,6 +53,11 @@ void ISchemaItem::applySchema(SmartObject& Object) {
 void ISchemaItem::unapplySchema(SmartObject& Object) {
 }
 
+Errors::eType ISchemaItem::applySchemaAndValidate(SmartObject& Object) {
+  applySchema(Object);
+  return validate(Object);
+}
+
 void ISchemaItem::BuildObjectBySchema(const SmartObject& pattern_object,
                                       SmartObject& result_object) {
 }
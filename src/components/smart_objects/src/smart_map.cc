@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "smart_objects/smart_map.h"
+
+#include <string.h>
+#include <new>
+
+#include "smart_objects/smart_object.h"
+#include "utils/small_object_pool.h"
+
+namespace NsSmartDeviceLink {
+namespace NsSmartObjects {
+
+SmartMap::SmartMap() {
+}
+
+SmartMap::SmartMap(const SmartMap& other) {
+  nodes_.reserve(other.nodes_.size());
+  for (Nodes::const_iterator it = other.nodes_.begin();
+       it != other.nodes_.end(); ++it) {
+    nodes_.push_back(CreateNode(**it));
+  }
+}
+
+SmartMap& SmartMap::operator=(const SmartMap& other) {
+  if (this != &other) {
+    SmartMap copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+SmartMap::~SmartMap() {
+  clear();
+}
+
+SmartMap::iterator SmartMap::find(const std::string& key) {
+  const size_t index = LowerBound(key.data(), key.size());
+  return IsFound(index, key.data(), key.size()) ?
+         iterator(nodes_.data() + index) : end();
+}
+
+SmartMap::iterator SmartMap::find(const char* key) {
+  const size_t key_length = strlen(key);
+  const size_t index = LowerBound(key, key_length);
+  return IsFound(index, key, key_length) ?
+         iterator(nodes_.data() + index) : end();
+}
+
+SmartMap::const_iterator SmartMap::find(const std::string& key) const {
+  const size_t index = LowerBound(key.data(), key.size());
+  return IsFound(index, key.data(), key.size()) ?
+         const_iterator(nodes_.data() + index) : end();
+}
+
+SmartMap::const_iterator SmartMap::find(const char* key) const {
+  const size_t key_length = strlen(key);
+  const size_t index = LowerBound(key, key_length);
+  return IsFound(index, key, key_length) ?
+         const_iterator(nodes_.data() + index) : end();
+}
+
+SmartObject& SmartMap::operator[](const std::string& key) {
+  return Access(key.data(), key.size());
+}
+
+SmartObject& SmartMap::operator[](const char* key) {
+  return Access(key, strlen(key));
+}
+
+size_t SmartMap::erase(const std::string& key) {
+  return Erase(key.data(), key.size());
+}
+
+size_t SmartMap::erase(const char* key) {
+  return Erase(key, strlen(key));
+}
+
+void SmartMap::clear() {
+  for (Nodes::iterator it = nodes_.begin(); it != nodes_.end(); ++it) {
+    DestroyNode(*it);
+  }
+  nodes_.clear();
+}
+
+void SmartMap::swap(SmartMap& other) {
+  nodes_.swap(other.nodes_);
+}
+
+size_t SmartMap::LowerBound(const char* key, size_t key_length) const {
+  size_t first = 0;
+  size_t count = nodes_.size();
+  while (count > 0) {
+    const size_t step = count / 2;
+    const size_t middle = first + step;
+    if (nodes_[middle]->first.compare(0, std::string::npos,
+                                      key, key_length) < 0) {
+      first = middle + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+bool SmartMap::IsFound(size_t index, const char* key,
+                       size_t key_length) const {
+  return index < nodes_.size() &&
+         0 == nodes_[index]->first.compare(0, std::string::npos,
+                                           key, key_length);
+}
+
+SmartObject& SmartMap::Access(const char* key, size_t key_length) {
+  const size_t index = LowerBound(key, key_length);
+  if (!IsFound(index, key, key_length)) {
+    value_type* node =
+        CreateNode(value_type(std::string(key, key_length), SmartObject()));
+    nodes_.insert(nodes_.begin() + index, node);
+  }
+  return nodes_[index]->second;
+}
+
+size_t SmartMap::Erase(const char* key, size_t key_length) {
+  const size_t index = LowerBound(key, key_length);
+  if (!IsFound(index, key, key_length)) {
+    return 0;
+  }
+  // Key may refer to the node itself, so it is not used after destroying
+  value_type* node = nodes_[index];
+  nodes_.erase(nodes_.begin() + index);
+  DestroyNode(node);
+  return 1;
+}
+
+SmartMap::value_type* SmartMap::CreateNode(const value_type& value) {
+  void* memory = utils::SmallObjectPool::Allocate(sizeof(value_type));
+  return new (memory) value_type(value);
+}
+
+void SmartMap::DestroyNode(value_type* node) {
+  node->~value_type();
+  utils::SmallObjectPool::Free(node, sizeof(value_type));
+}
+
+}  // namespace NsSmartObjects
+}  // namespace NsSmartDeviceLink
@@ -32,19 +32,47 @@
 
 #include "smart_objects/smart_object.h"
 
-#include <errno.h>
+#include <ctype.h>
 #include <inttypes.h>
 #include <limits>
 #include <stdlib.h>
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
 #include <iterator>
 #include <limits>
+#include <new>
+#include <utility>
+
+#include "utils/number_conversion.h"
+#include "utils/small_object_pool.h"
 
 namespace NsSmartDeviceLink {
 namespace NsSmartObjects {
 
+namespace {
+/*
+ * String, array, map and binary holders are taken from the thread local
+ * small object pool. Message trees are built and released in bulk, so the
+ * holders (and map nodes, see SmartMap) circulate inside the pool and a
+ * small object like {"appID": 5} does not reach the heap after warm up.
+ * Short strings are kept inside the std::string holder itself.
+ */
+template<typename T>
+T* CreateValue() {
+  return new (utils::SmallObjectPool::Allocate(sizeof(T))) T();
+}
+
+template<typename T>
+T* CreateValue(const T& value) {
+  return new (utils::SmallObjectPool::Allocate(sizeof(T))) T(value);
+}
+
+template<typename T>
+void DestroyValue(T* value) {
+  value->~T();
+  utils::SmallObjectPool::Free(value, sizeof(T));
+}
+}  // namespace
+
 /**
  * @brief Value that is used as invalid value for string type
  **/
@@ -85,11 +113,11 @@ SmartObject::SmartObject(SmartType Type)
       set_value_string("");
       break;
     case SmartType_Map:
-      m_data.map_value = new SmartMap();
+      m_data.map_value = CreateValue<SmartMap>();
       m_type = SmartType_Map;
       break;
     case SmartType_Array:
-      m_data.array_value = new SmartArray();
+      m_data.array_value = CreateValue<SmartArray>();
       m_type = SmartType_Array;
       break;
     case SmartType_Binary:
@@ -114,6 +142,42 @@ SmartObject& SmartObject::operator=(const SmartObject& Other) {
   return *this;
 }
 
+#ifdef SUPPORT_MOVE_SEMANTICS
+SmartObject::SmartObject(SmartObject&& Other) noexcept
+    : m_type(Other.m_type),
+      m_data(Other.m_data),
+      m_schema(Other.m_schema) {
+  switch (Other.m_type) {
+    case SmartType_String:
+    case SmartType_Map:
+    case SmartType_Array:
+    case SmartType_Binary:
+      // Ownership of holder is taken over
+      Other.m_type = SmartType_Null;
+      Other.m_data.str_value = NULL;
+      break;
+    default:
+      break;
+  }
+}
+
+SmartObject& SmartObject::operator=(SmartObject&& Other) noexcept {
+  if (this != &Other) {
+    // Other is detached before old data is released, as it may be
+    // element of this object
+    SmartObject moved(std::move(Other));
+    swap(moved);
+  }
+  return *this;
+}
+#endif
+
+void SmartObject::swap(SmartObject& Other) {
+  std::swap(m_type, Other.m_type);
+  std::swap(m_data, Other.m_data);
+  std::swap(m_schema, Other.m_schema);
+}
+
 /*Wbool SmartObject::operator<(const SmartObject& Other) const{
 
   return std::lexicographical_compare(m_data.map_value->begin(),m_data.map_value->end(),
@@ -152,13 +216,13 @@ bool SmartObject::operator==(const SmartObject& Other) const {
                         Other.m_data.array_value->begin());
       }
     case SmartType_Binary: {
-      if (m_data.binary_value == Other.m_data.binary_value)
+      const SmartBinary& binary = **m_data.binary_value;
+      const SmartBinary& other_binary = **Other.m_data.binary_value;
+      if (&binary == &other_binary)
         return true;
-      if (m_data.array_value->size() != Other.m_data.array_value->size())
+      if (binary.size() != other_binary.size())
         return false;
-      return std::equal(m_data.binary_value->begin(),
-                        m_data.binary_value->end(),
-                        Other.m_data.binary_value->begin());
+      return std::equal(binary.begin(), binary.end(), other_binary.begin());
       }
     case SmartType_Null:
       return true;
@@ -478,8 +542,13 @@ bool SmartObject::operator==(const std::string& Value) const {
 }
 
 void SmartObject::set_value_string(const std::string& NewValue) {
+  if (SmartType_String == m_type) {
+    // Reuse holder and its buffer
+    m_data.str_value->assign(NewValue);
+    return;
+  }
   set_new_type(SmartType_String);
-  m_data.str_value = new std::string(NewValue);
+  m_data.str_value = CreateValue(NewValue);
 }
 
 std::string SmartObject::convert_string() const {
@@ -487,9 +556,9 @@ std::string SmartObject::convert_string() const {
     case SmartType_String:
       return *(m_data.str_value);
     case SmartType_Integer: {
-        std::stringstream stream;
-        stream << m_data.int_value;
-        return stream.str();
+        char buffer[utils::kInt64StringSize];
+        return std::string(buffer,
+                           utils::FormatInt64(m_data.int_value, buffer));
       }
     case SmartType_Character:
       return std::string(1, m_data.char_value);
@@ -542,10 +611,31 @@ SmartObject::SmartObject(const SmartBinary& InitialValue)
   set_value_binary(InitialValue);
 }
 
+SmartObject::SmartObject(const SharedBinary& InitialValue)
+    : m_type(SmartType_Null),
+      m_schema() {
+  m_data.str_value = NULL;
+  set_value_binary(InitialValue);
+}
+
 SmartBinary SmartObject::asBinary() const {
   return convert_binary();
 }
 
+const SmartBinary* SmartObject::asBinaryPtr() const {
+  if (m_type != SmartType_Binary) {
+    return NULL;
+  }
+  return m_data.binary_value->get();
+}
+
+SharedBinary SmartObject::asSharedBinary() const {
+  if (m_type != SmartType_Binary) {
+    return SharedBinary();
+  }
+  return *m_data.binary_value;
+}
+
 SmartArray* SmartObject::asArray() const {
   if (m_type != SmartType_Array) {
     return NULL;
@@ -560,6 +650,23 @@ SmartObject& SmartObject::operator=(const SmartBinary& NewValue) {
   return *this;
 }
 
+SmartObject& SmartObject::operator=(const SharedBinary& NewValue) {
+  if (m_type != SmartType_Invalid) {
+    set_value_binary(NewValue);
+  }
+  return *this;
+}
+
+void SmartObject::swapBinary(SmartBinary& Value) {
+  if (SmartType_Invalid == m_type) {
+    return;
+  }
+  // Shared data is not modified, new one takes over the buffer
+  SmartBinary* binary = new SmartBinary;
+  binary->swap(Value);
+  set_value_binary(SharedBinary(binary));
+}
+
 bool SmartObject::operator==(const SmartBinary& Value) const {
   const SmartBinary comp = convert_binary();
   if (comp == invalid_binary_value) {
@@ -571,14 +678,25 @@ bool SmartObject::operator==(const SmartBinary& Value) const {
 }
 
 void SmartObject::set_value_binary(const SmartBinary& NewValue) {
+  set_value_binary(SharedBinary(new SmartBinary(NewValue)));
+}
+
+void SmartObject::set_value_binary(const SharedBinary& NewValue) {
+  const SharedBinary value =
+      NewValue.valid() ? NewValue : SharedBinary(new SmartBinary);
+  if (SmartType_Binary == m_type) {
+    // Reuse holder
+    *m_data.binary_value = value;
+    return;
+  }
   set_new_type(SmartType_Binary);
-  m_data.binary_value = new SmartBinary(NewValue);
+  m_data.binary_value = CreateValue(value);
 }
 
 SmartBinary SmartObject::convert_binary() const {
   switch (m_type) {
     case SmartType_Binary:
-      return *(m_data.binary_value);
+      return **m_data.binary_value;
     default:
       break;
   }
@@ -605,7 +723,7 @@ inline SmartObject& SmartObject::handle_array_access(const int32_t Index) {
   if (m_type != SmartType_Array) {
     cleanup_data();
     m_type = SmartType_Array;
-    m_data.array_value = new SmartArray();
+    m_data.array_value = CreateValue<SmartArray>();
   }
   SmartArray& array = *m_data.array_value;
   if (Index == -1 || static_cast<size_t>(Index) == array.size()) {
@@ -633,19 +751,19 @@ const SmartObject& SmartObject::operator[] (const std::string& Key) const {
 }
 
 SmartObject& SmartObject::operator[](char* Key) {
-  return handle_map_access(std::string(Key));
+  return handle_map_access(Key);
 }
 
 const SmartObject& SmartObject::operator[](char* Key) const {
-  return getElement(std::string(Key));
+  return get_map_element(Key);
 }
 
 SmartObject& SmartObject::operator[](const char* Key) {
-  return handle_map_access(std::string(Key));
+  return handle_map_access(Key);
 }
 
 const SmartObject& SmartObject::operator[](const char* Key) const {
-  return getElement(std::string(Key));
+  return get_map_element(Key);
 }
 
 const SmartObject& SmartObject::getElement(size_t Index) const {
@@ -667,6 +785,16 @@ const SmartObject& SmartObject::getElement(const std::string& Key) const {
   return invalid_object_value;
 }
 
+const SmartObject& SmartObject::get_map_element(const char* Key) const {
+  if (SmartType_Map == m_type) {
+    SmartMap::const_iterator it = m_data.map_value->find(Key);
+    if (it != m_data.map_value->end()) {
+      return it->second;
+    }
+  }
+  return invalid_object_value;
+}
+
 SmartObject& SmartObject::handle_map_access(const std::string& Key) {
   if (m_type == SmartType_Invalid) {
     return *this;
@@ -675,7 +803,22 @@ SmartObject& SmartObject::handle_map_access(const std::string& Key) {
   if (m_type != SmartType_Map) {
     cleanup_data();
     m_type = SmartType_Map;
-    m_data.map_value = new SmartMap();
+    m_data.map_value = CreateValue<SmartMap>();
+  }
+  SmartMap& map = *m_data.map_value;
+
+  return map[Key];
+}
+
+SmartObject& SmartObject::handle_map_access(const char* Key) {
+  if (m_type == SmartType_Invalid) {
+    return *this;
+  }
+
+  if (m_type != SmartType_Map) {
+    cleanup_data();
+    m_type = SmartType_Map;
+    m_data.map_value = CreateValue<SmartMap>();
   }
   SmartMap& map = *m_data.map_value;
 
@@ -692,10 +835,10 @@ void SmartObject::duplicate(const SmartObject& OtherObject) {
     case SmartType_Null: // on duplicate empty SmartObject
       return;
     case SmartType_Map:
-      newData.map_value = new SmartMap(*OtherObject.m_data.map_value);
+      newData.map_value = CreateValue(*OtherObject.m_data.map_value);
       break;
     case SmartType_Array:
-      newData.array_value = new SmartArray(*OtherObject.m_data.array_value);
+      newData.array_value = CreateValue(*OtherObject.m_data.array_value);
       break;
     case SmartType_Integer:
       newData.int_value = OtherObject.m_data.int_value;
@@ -710,10 +853,10 @@ void SmartObject::duplicate(const SmartObject& OtherObject) {
       newData.char_value = OtherObject.m_data.char_value;
       break;
     case SmartType_String:
-      newData.str_value = new std::string(*OtherObject.m_data.str_value);
+      newData.str_value = CreateValue(*OtherObject.m_data.str_value);
       break;
     case SmartType_Binary:
-      newData.binary_value = new SmartBinary(*OtherObject.m_data.binary_value);
+      newData.binary_value = CreateValue(*OtherObject.m_data.binary_value);
       break;
     default:
       DCHECK(!"Unhandled smart object type");
@@ -730,16 +873,16 @@ void SmartObject::duplicate(const SmartObject& OtherObject) {
 void SmartObject::cleanup_data() {
   switch (m_type) {
     case SmartType_String:
-      delete m_data.str_value;
+      DestroyValue(m_data.str_value);
       break;
     case SmartType_Map:
-      delete m_data.map_value;
+      DestroyValue(m_data.map_value);
       break;
     case SmartType_Array:
-      delete m_data.array_value;
+      DestroyValue(m_data.array_value);
       break;
     case SmartType_Binary:
-      delete m_data.binary_value;
+      DestroyValue(m_data.binary_value);
       break;
     default:
       break;
@@ -755,7 +898,7 @@ size_t SmartObject::length() const {
     case SmartType_Map:
       return m_data.map_value->size();
     case SmartType_Binary:
-      return m_data.binary_value->size();
+      return (*m_data.binary_value)->size();
     default:
       break;
   }
@@ -771,7 +914,7 @@ bool SmartObject::empty() const {
     case SmartType_Map:
       return m_data.map_value->empty();
     case SmartType_Binary:
-      return m_data.binary_value->empty();
+      return (*m_data.binary_value)->empty();
     default:
       break;
   }
@@ -788,46 +931,45 @@ double SmartObject::convert_string_to_double(const std::string* Value) {
     return invalid_double_value;
   }
 
-  char* ptr;
-  errno = 0;
-
-  double result = strtod(Value->c_str(), &ptr);
-  if (errno || (ptr != (Value->c_str() + Value->length()))) {
+  // Leading spaces are skipped as strtod did
+  const char* begin = Value->data();
+  const char* const end = begin + Value->size();
+  while (begin != end && isspace(static_cast<unsigned char>(*begin))) {
+    ++begin;
+  }
+  double result = 0;
+  if (begin == end || utils::ParseDouble(begin, end, &result) != end) {
     return invalid_double_value;
   }
-
   return result;
 }
 
 std::string SmartObject::convert_double_to_string(const double& Value) {
-  std::stringstream ss;
-
-  // convert double to string w fixed notation, hi precision
-  ss << std::fixed << std::setprecision(10) << Value;
-
-  // output to std::string
-  std::string s = ss.str();
-
-  // remove trailing 000s    (123.1200 => 123.12,  123.000 => 123.)
-  s.erase(s.find_last_not_of('0') + 1, std::string::npos);
-  if (s[s.size() - 1] == '.') {
-    // remove dangling decimal (123. => 123)
-    s.erase(s.end() - 1);
-  }
-  return s;
+  // Fixed notation, hi precision, without trailing 000s and dangling
+  // decimal point (123.1200 => 123.12, 123.000 => 123)
+  char buffer[utils::kDoubleStringSize];
+  return std::string(buffer, utils::FormatFixed(Value, 10, buffer));
 }
 
 uint64_t SmartObject::convert_string_to_integer(const std::string* Value) {
   if (!Value || Value->empty()) {
     return invalid_int64_value;
   }
-  int64_t result;
-  std::stringstream stream(*Value);
-  stream >> result;
-  if (stream.eof()) {
-    return result;
+  // Leading spaces and plus are skipped as stream did
+  const char* begin = Value->data();
+  const char* const end = begin + Value->size();
+  while (begin != end && isspace(static_cast<unsigned char>(*begin))) {
+    ++begin;
   }
-  return invalid_int64_value;
+  if (end - begin > 1 && '+' == begin[0] &&
+      isdigit(static_cast<unsigned char>(begin[1]))) {
+    ++begin;
+  }
+  int64_t result = 0;
+  if (begin == end || utils::ParseInt64(begin, end, &result) != end) {
+    return invalid_int64_value;
+  }
+  return result;
 }
 
 SmartType SmartObject::getType() const {
@@ -859,6 +1001,13 @@ bool SmartObject::keyExists(const std::string& Key) const {
   return m_data.map_value->find(Key) != m_data.map_value->end();
 }
 
+bool SmartObject::keyExists(const char* Key) const {
+  if (m_type != SmartType_Map) {
+    return false;
+  }
+  return m_data.map_value->find(Key) != m_data.map_value->end();
+}
+
 bool SmartObject::erase(const std::string& Key) {
   if (m_type != SmartType_Map) {
     return false;
@@ -866,6 +1015,13 @@ bool SmartObject::erase(const std::string& Key) {
   return (m_data.map_value->erase(Key) > 0);
 }
 
+bool SmartObject::erase(const char* Key) {
+  if (m_type != SmartType_Map) {
+    return false;
+  }
+  return (m_data.map_value->erase(Key) > 0);
+}
+
 bool SmartObject::isValid() const {
   return (Errors::OK == m_schema.validate(*this));
 }
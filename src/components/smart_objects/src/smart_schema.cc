@@ -55,6 +55,10 @@ void CSmartSchema::applySchema(SmartObject& Object) {
   mSchemaItem->applySchema(Object);
 }
 
+Errors::eType CSmartSchema::applySchemaAndValidate(SmartObject& Object) {
+  return mSchemaItem->applySchemaAndValidate(Object);
+}
+
 void CSmartSchema::unapplySchema(SmartObject& Object) {
   mSchemaItem->unapplySchema(Object);
 }
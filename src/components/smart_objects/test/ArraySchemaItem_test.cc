@@ -293,6 +293,38 @@ TEST(test_array_with_min_and_max_size, test_ArraySchemaItemTest) {
   EXPECT_EQ(std::string("Out of array"), obj[4].asString());
 }
 
+/**
+ * Test ArraySchemaItem apply schema and validate in a single pass
+ **/
+TEST(test_array_apply_schema_and_validate, test_ArraySchemaItemTest) {
+  using namespace NsSmartDeviceLink::NsSmartObjects;
+  SmartObject obj;
+
+  ISchemaItemPtr item = CArraySchemaItem::create(
+      CStringSchemaItem::create(TSchemaItemParameter<size_t>(),
+                                TSchemaItemParameter<size_t>(25)),
+      TSchemaItemParameter<size_t>(2), TSchemaItemParameter<size_t>(4));
+
+  EXPECT_EQ(Errors::INVALID_VALUE, item->applySchemaAndValidate(obj));
+
+  obj[0] = "Some String";
+  EXPECT_EQ(Errors::OUT_OF_RANGE, item->applySchemaAndValidate(obj));
+
+  obj[1] = 5;
+  EXPECT_EQ(Errors::INVALID_VALUE, item->applySchemaAndValidate(obj));
+
+  obj[1] = "true";
+  EXPECT_EQ(Errors::OK, item->applySchemaAndValidate(obj));
+
+  obj[2] = "New String";
+  obj[3] = "Another String";
+  obj[4] = "Out of array";
+  // size is checked before elements as validate does
+  obj[0] = 5;
+  EXPECT_EQ(Errors::OUT_OF_RANGE, item->applySchemaAndValidate(obj));
+  EXPECT_EQ(Errors::OUT_OF_RANGE, item->validate(obj));
+}
+
 TEST(test_map_validate, test_ArraySchemaItemTest) {
   using namespace NsSmartDeviceLink::NsSmartObjects;
   SmartObject obj;
@@ -249,6 +249,29 @@ TEST_F(ObjectSchemaItemTest, validation_missing_mandatory) {
   EXPECT_EQ(Errors::OK, schema_item->validate(obj));
 }
 
+TEST_F(ObjectSchemaItemTest, validation_unexpected_params_around_members) {
+  SmartObject obj;
+  // unexpected keys sorted before, between and after the members
+  obj[S_MSG_PARAMS]["a"] = 1;
+  obj[S_MSG_PARAMS]["inf"] = 1;
+  obj[S_MSG_PARAMS][Keys::INFO] = "info";
+  obj[S_MSG_PARAMS]["infoo"] = 1;
+  obj[S_MSG_PARAMS]["z"] = 1;
+  obj[S_PARAMS][S_FUNCTION_ID] = 0;
+  obj[S_PARAMS][S_CORRELATION_ID] = 0XFF;
+  obj[S_PARAMS][S_PROTOCOL_VERSION] = 1;
+  EXPECT_EQ(Errors::OK, schema_item->validate(obj));
+
+  // member between unexpected keys is still validated
+  obj[S_MSG_PARAMS][Keys::INFO] = 10;
+  EXPECT_EQ(Errors::INVALID_VALUE, schema_item->validate(obj));
+
+  obj[S_MSG_PARAMS][Keys::INFO] = "info";
+  obj[S_PARAMS].erase(S_PROTOCOL_VERSION);
+  obj[S_PARAMS]["zzz"] = 1;
+  EXPECT_EQ(Errors::MISSING_MANDATORY_PARAMETER, schema_item->validate(obj));
+}
+
 TEST_F(ObjectSchemaItemTest, validation_unexpected_param) {
   const char* fake1 = "FAKE_PARAM1";
   const char* fake2 = "FAKE_PARAM2";
@@ -392,6 +415,46 @@ TEST_F(ObjectSchemaItemTest, test_strings_to_enum_conversion) {
     }
   }
 }
+TEST_F(ObjectSchemaItemTest, apply_schema_and_validate_same_as_separate_passes) {
+  SmartObject valid;
+  valid[S_PARAMS][S_FUNCTION_ID] = "Function2";
+  valid[S_PARAMS][S_CORRELATION_ID] = 0XFF0;
+  valid[S_PARAMS][S_PROTOCOL_VERSION] = 1;
+  valid[S_MSG_PARAMS][Keys::RESULT_CODE] = "REJECTED";
+  valid[S_MSG_PARAMS][Keys::SUCCESS] = true;
+  valid[S_MSG_PARAMS]["FAKE_PARAM"] = 1;
+
+  SmartObject missing_mandatory(valid);
+  missing_mandatory[S_PARAMS].erase(S_CORRELATION_ID);
+
+  SmartObject invalid_after_enum(valid);
+  invalid_after_enum[S_PARAMS][S_PROTOCOL_VERSION] = 3;
+
+  SmartObject invalid_last_member(valid);
+  invalid_last_member[S_MSG_PARAMS][Keys::SUCCESS] = "true";
+
+  SmartObject not_a_map(valid);
+  not_a_map[S_MSG_PARAMS] = 5;
+
+  const SmartObject objects[] = {
+    valid, missing_mandatory, invalid_after_enum, invalid_last_member,
+    not_a_map, SmartObject()
+  };
+  for (size_t i = 0; i < sizeof(objects) / sizeof(objects[0]); ++i) {
+    SmartObject separate(objects[i]);
+    schema_item->applySchema(separate);
+    const Errors::eType expected = schema_item->validate(separate);
+
+    SmartObject fused(objects[i]);
+    EXPECT_EQ(expected, schema_item->applySchemaAndValidate(fused)) << i;
+    EXPECT_TRUE(separate == fused) << i;
+  }
+  SmartObject fused(invalid_last_member);
+  EXPECT_EQ(Errors::INVALID_VALUE, schema_item->applySchemaAndValidate(fused));
+  // params follow invalid msg_params and are still converted
+  EXPECT_EQ(FunctionID::Function2, fused[S_PARAMS][S_FUNCTION_ID].asInt());
+}
+
 // ----------------------------------------------------------------------------
 }// namespace SchemaItem
 }  // namespace SmartObjects
@@ -37,6 +37,7 @@
 #include "smart_objects/string_schema_item.h"
 
 #include <string>
+#include <vector>
 
 namespace test {
 namespace components {
@@ -227,6 +228,26 @@ TEST_F(EnumSchemaItemTest, test_apply_unapply_schema) {
   EXPECT_EQ(std::string("ENOUGH_REQUESTS"), obj.asString());
 }
 
+TEST(CStringHashTableTest, FindsEveryStringOnly) {
+  std::vector<std::string> values;
+  for (int32_t i = 0; i < 500; ++i) {
+    values.push_back("VALUE_" + std::string(1, 'A' + i % 26) +
+                     std::string(i / 26, '_'));
+  }
+  std::vector<const char*> strings;
+  for (size_t i = 0; i < values.size(); ++i) {
+    strings.push_back(values[i].c_str());
+  }
+  CStringHashTable table(strings);
+  for (size_t i = 0; i < strings.size(); ++i) {
+    EXPECT_EQ(i, table.Find(values[i].c_str()));
+  }
+  EXPECT_EQ(CStringHashTable::kNotFound, table.Find(""));
+  EXPECT_EQ(CStringHashTable::kNotFound, table.Find("VALUE_"));
+  EXPECT_EQ(CStringHashTable::kNotFound, table.Find("value_A"));
+  EXPECT_EQ(CStringHashTable::kNotFound, table.Find("VALUE_A_______________________"));
+}
+
 }
 }
 }
@@ -30,6 +30,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <utility>
+
 #include "gmock/gmock.h"
 #include "smart_objects/smart_object.h"
 
@@ -577,6 +579,99 @@ TEST(MapEraseTest, SmartObjectTest) {
   srcObj = 1234;       // not a map
   ASSERT_FALSE(srcObj.erase("one"));
 }
+
+TEST(ReassignValueTest, SmartObjectTest) {
+  SmartObject obj("short");
+  obj = std::string(100, 'x');
+  ASSERT_EQ(std::string(100, 'x'), obj.asString());
+  obj = "short again";
+  ASSERT_EQ("short again", obj.asString());
+
+  SmartBinary binary(3, 1);
+  obj = binary;
+  binary.push_back(2);
+  obj = binary;
+  ASSERT_EQ(SmartType_Binary, obj.getType());
+  ASSERT_TRUE(obj == binary);
+
+  obj = 5;
+  ASSERT_EQ(SmartType_Integer, obj.getType());
+  ASSERT_EQ(5, obj.asInt());
+}
+TEST(SwapBinaryTest, SmartObjectTest) {
+  SmartObject obj("not binary");
+  SmartBinary binary(1000, 7);
+  const uint8_t* const buffer = &binary[0];
+  obj.swapBinary(binary);
+
+  ASSERT_EQ(SmartType_Binary, obj.getType());
+  ASSERT_TRUE(binary.empty());
+  ASSERT_EQ(1000u, obj.asBinaryPtr()->size());
+  // Buffer is taken over, not copied
+  ASSERT_EQ(buffer, &(*obj.asBinaryPtr())[0]);
+}
+
+TEST(SharedBinaryTest, SmartObjectTest) {
+  const SharedBinary data(new SmartBinary(1000, 3));
+  SmartObject obj(data);
+  SmartObject copy(obj);
+  SmartObject tree;
+  tree["params"]["binary_data"] = obj.asSharedBinary();
+
+  // Copies refer to the same data
+  ASSERT_EQ(data.get(), obj.asBinaryPtr());
+  ASSERT_EQ(data.get(), copy.asBinaryPtr());
+  ASSERT_EQ(data.get(), tree["params"]["binary_data"].asBinaryPtr());
+
+  // Shared data is not modified by assignment
+  copy = SmartBinary(2, 1);
+  ASSERT_EQ(2u, copy.length());
+  ASSERT_EQ(1000u, data->size());
+  ASSERT_TRUE(obj == *data);
+
+  ASSERT_FALSE(SmartObject(5).asSharedBinary().valid());
+}
+
+TEST(SwapTest, SmartObjectTest) {
+  SmartObject tree;
+  tree["params"]["function_id"] = 1;
+  SmartObject msg_params(SmartType_Map);
+  msg_params["app_id"] = 5;
+  msg_params["choice_set"][0]["choice_id"] = 10;
+
+  tree["msg_params"].swap(msg_params);
+
+  ASSERT_EQ(SmartType_Null, msg_params.getType());
+  ASSERT_EQ(5, tree["msg_params"]["app_id"].asInt());
+  ASSERT_EQ(10, tree["msg_params"]["choice_set"][0]["choice_id"].asInt());
+
+  SmartObject number(7);
+  number.swap(tree["params"]);
+  ASSERT_EQ(7, tree["params"].asInt());
+  ASSERT_EQ(1, number["function_id"].asInt());
+}
+
+#ifdef SUPPORT_MOVE_SEMANTICS
+TEST(MoveTest, SmartObjectTest) {
+  SmartObject source;
+  source["key"] = "value";
+  SmartObject moved(std::move(source));
+  ASSERT_EQ(SmartType_Null, source.getType());
+  ASSERT_EQ("value", moved["key"].asString());
+
+  SmartObject number(3);
+  SmartObject moved_number(std::move(number));
+  ASSERT_EQ(3, number.asInt());
+  ASSERT_EQ(3, moved_number.asInt());
+
+  // Moving from own element
+  moved["nested"]["inner"] = 1;
+  moved = std::move(moved["nested"]);
+  ASSERT_EQ(1, moved["inner"].asInt());
+  ASSERT_FALSE(moved.keyExists("key"));
+}
+#endif
+
 // TODO: Add a test to check accessing an array at strange indexes.
 }// namespace SmartObjectUnitTest
 }  // namespace SmartObjects
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "smart_objects/smart_map.h"
+#include "smart_objects/smart_object.h"
+
+namespace test {
+namespace components {
+namespace SmartObjects {
+namespace SmartMapTest {
+
+using namespace NsSmartDeviceLink::NsSmartObjects;
+
+TEST(SmartMapTest, Iteration_KeysInsertedUnordered_KeysAreSorted) {
+  SmartMap map;
+  map["delta"] = 4;
+  map["alpha"] = 1;
+  map[std::string("charlie")] = 3;
+  map["bravo"] = 2;
+
+  ASSERT_EQ(4u, map.size());
+  SmartMap::const_iterator it = map.begin();
+  EXPECT_EQ("alpha", it->first);
+  EXPECT_EQ(1, (it++)->second.asInt());
+  EXPECT_EQ("bravo", it->first);
+  EXPECT_EQ("charlie", (++it)->first);
+  EXPECT_EQ("delta", (++it)->first);
+  EXPECT_TRUE(map.end() == ++it);
+}
+
+TEST(SmartMapTest, Access_ExistingKey_ElementIsNotDuplicated) {
+  SmartMap map;
+  map["key"] = 1;
+  map[std::string("key")] = 2;
+
+  ASSERT_EQ(1u, map.size());
+  EXPECT_EQ(2, map["key"].asInt());
+}
+
+TEST(SmartMapTest, Access_OtherKeysInserted_ReferenceStaysValid) {
+  SmartMap map;
+  SmartObject& middle = map["m"];
+  middle = 10;
+  map["a"] = 1;
+  map["z"] = 26;
+  map.erase("a");
+
+  EXPECT_EQ(&middle, &map["m"]);
+  EXPECT_EQ(10, middle.asInt());
+}
+
+TEST(SmartMapTest, Find_CStringAndStringKeys_SameElementFound) {
+  SmartMap map;
+  map["app_id"] = 5;
+  const SmartMap& const_map = map;
+
+  EXPECT_TRUE(map.find("app_id") == map.find(std::string("app_id")));
+  EXPECT_TRUE(const_map.find("app_id") != const_map.end());
+  EXPECT_TRUE(map.find("app") == map.end());
+  EXPECT_TRUE(map.find("app_id_") == map.end());
+  EXPECT_TRUE(const_map.find(std::string()) == const_map.end());
+}
+
+TEST(SmartMapTest, Erase_ExistingAndAbsentKeys_OnlyExistingRemoved) {
+  SmartMap map;
+  map["first"] = 1;
+  map["second"] = 2;
+
+  EXPECT_EQ(0u, map.erase("third"));
+  EXPECT_EQ(1u, map.erase(std::string("first")));
+  EXPECT_EQ(0u, map.erase("first"));
+  ASSERT_EQ(1u, map.size());
+  EXPECT_EQ("second", map.begin()->first);
+  EXPECT_EQ(1u, map.erase("second"));
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(SmartMapTest, Copy_NestedMap_CopyIsDeepAndIndependent) {
+  SmartMap map;
+  map["params"]["function_id"] = 1;
+  map["msg_params"]["app_id"] = 2;
+
+  SmartMap copy(map);
+  map["params"]["function_id"] = 10;
+  map.erase("msg_params");
+
+  ASSERT_EQ(2u, copy.size());
+  EXPECT_EQ(1, copy["params"]["function_id"].asInt());
+  EXPECT_EQ(2, copy["msg_params"]["app_id"].asInt());
+
+  copy = map;
+  ASSERT_EQ(1u, copy.size());
+  EXPECT_EQ(10, copy["params"]["function_id"].asInt());
+}
+
+TEST(SmartMapTest, SmartObject_CStringKeys_MapInterfaceConsistent) {
+  SmartObject object;
+  object["b"] = 2;
+  object["a"] = 1;
+
+  EXPECT_TRUE(object.keyExists("a"));
+  EXPECT_TRUE(object.keyExists(std::string("b")));
+  EXPECT_FALSE(object.keyExists("c"));
+  const SmartObject& const_object = object;
+  EXPECT_EQ(2, const_object["b"].asInt());
+  EXPECT_EQ(SmartType_Invalid, const_object["c"].getType());
+  EXPECT_EQ("a", object.map_begin()->first);
+  EXPECT_TRUE(object.erase("a"));
+  EXPECT_FALSE(object.erase("a"));
+  EXPECT_EQ(1u, object.length());
+}
+
+}  // namespace SmartMapTest
+}  // namespace SmartObjects
+}  // namespace components
+}  // namespace test
@@ -34,6 +34,7 @@
 #define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_APPLICATION_MANAGER_OBSERVER_H_
 
 #include "utils/message_queue.h"
+#include "utils/metrics_registry.h"
 #include "application_manager/time_metric_observer.h"
 #include "application_manager_metric.h"
 
@@ -49,6 +50,7 @@ class ApplicationManagerObserver: public application_manager::AMMetricObserver {
 
   private:
     TimeManager* time_manager_;
+    utils::metrics::Histogram* processing_time_metric_;
 };
 
 }
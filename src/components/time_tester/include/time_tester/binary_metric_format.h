@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_BINARY_METRIC_FORMAT_H_
+#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_BINARY_METRIC_FORMAT_H_
+
+#include <stdint.h>
+
+namespace time_tester {
+namespace binary_metrics {
+
+/*
+ * Binary metrics stream starts with magic, byte order mark and version.
+ * It is followed by records: uint16 type, uint16 payload size, payload.
+ * All values are in host byte order, reader detects order by the mark.
+ * Times are microseconds since epoch, zero time is a point never reached.
+ * Names are zero padded and truncated to kNameSize.
+ */
+const char kMagic[] = "SDLMTRC1";
+const uint32_t kMagicSize = 8;
+const uint32_t kByteOrder = 0x01020304;
+const uint16_t kVersion = 1;
+
+enum RecordType {
+  kTransportManager = 1,
+  kProtocolHandler = 2,
+  kApplicationManager = 3,
+  kResources = 4,
+  kLock = 5,
+  kStreamQueue = 6,
+  kRpcSpan = 7,
+  kDropped = 8,
+  kCounter = 9,
+  kGauge = 10,
+  kHistogram = 11,
+  kProcessUsage = 12,
+  kThreadUsage = 13,
+  kQueueDepth = 14,
+  kAppMemory = 15
+};
+
+const uint32_t kNameSize = 24;
+// Registry metrics have longer dotted names
+const uint32_t kMetricNameSize = 48;
+
+struct MessagePayload {
+  int64_t begin;
+  int64_t end;
+  uint32_t connection_key;
+  // Message id for protocol handler, correlation id for application manager
+  int32_t id;
+  int32_t function_id;
+  uint32_t data_size;
+};
+
+struct ResourcesPayload {
+  int64_t time;
+  int64_t utime;
+  int64_t stime;
+  int64_t memory;
+};
+
+struct LockPayload {
+  char name[kNameSize];
+  uint64_t acquisitions;
+  uint64_t contentions;
+  uint64_t wait_time;
+  uint64_t max_wait_time;
+  uint64_t hold_time;
+  uint64_t max_hold_time;
+};
+
+struct StreamQueuePayload {
+  char name[kNameSize];
+  uint64_t queued_frames;
+  uint64_t queued_bytes;
+  uint64_t dropped_frames;
+  uint64_t dropped_bytes;
+  uint64_t received_frames;
+  uint64_t received_bytes;
+  uint64_t bitrate;
+  uint64_t jitter_us;
+  uint64_t average_latency_us;
+  uint64_t max_latency_us;
+  uint32_t frame_rate;
+};
+
+/*
+ * One span of RPC trace, spans of one trace share trace number
+ * and are sent one after another
+ */
+struct RpcSpanPayload {
+  int64_t queued;
+  int64_t begin;
+  int64_t end;
+  char name[kNameSize];
+  uint32_t trace;
+  uint32_t connection_key;
+  int32_t correlation_id;
+  int32_t function_id;
+  int16_t index;
+  int16_t parent;
+  uint32_t reserved;
+};
+
+// Counter or gauge of metrics registry, sent on query
+struct ValuePayload {
+  char name[kMetricNameSize];
+  int64_t value;
+};
+
+// Aggregated histogram of metrics registry, sent on query
+struct HistogramPayload {
+  char name[kMetricNameSize];
+  uint64_t count;
+  uint64_t sum;
+  uint64_t max;
+  uint64_t p50;
+  uint64_t p99;
+  uint64_t p999;
+};
+
+// Allocator statistics in bytes and open files, -1 if not known
+struct ProcessUsagePayload {
+  int64_t time;
+  uint64_t arena;
+  uint64_t mmapped;
+  uint64_t in_use;
+  uint64_t free;
+  int32_t open_files;
+  uint32_t threads_count;
+};
+
+// CPU time of one thread in milliseconds
+struct ThreadUsagePayload {
+  char name[kNameSize];
+  int64_t time;
+  uint64_t utime;
+  uint64_t stime;
+  int32_t tid;
+  uint32_t reserved;
+};
+
+// Messages waiting in one message loop
+struct QueueDepthPayload {
+  char name[kNameSize];
+  int64_t time;
+  uint64_t depth;
+};
+
+// Bytes SDL holds for one application, see utils::MemoryAccounting
+struct AppMemoryPayload {
+  int64_t time;
+  uint32_t connection_key;
+  uint32_t reserved;
+  uint64_t app_state;
+  uint64_t multi_frame;
+  uint64_t queued_messages;
+};
+
+// Records lost because client did not keep up since previous notice
+struct DroppedPayload {
+  uint64_t count;
+};
+
+/*
+ * Record as it is kept in memory, only size bytes of payload are sent
+ */
+struct Record {
+  uint16_t type;
+  uint16_t size;
+  uint32_t reserved;
+  union {
+    MessagePayload message;
+    ResourcesPayload resources;
+    LockPayload lock;
+    StreamQueuePayload stream_queue;
+    RpcSpanPayload span;
+    DroppedPayload dropped;
+    ValuePayload value;
+    HistogramPayload histogram;
+    ProcessUsagePayload process_usage;
+    ThreadUsagePayload thread_usage;
+    QueueDepthPayload queue_depth;
+    AppMemoryPayload app_memory;
+  } payload;
+};
+
+const uint32_t kRecordHeaderSize = 2 * sizeof(uint16_t);
+
+}  // namespace binary_metrics
+}  // namespace time_tester
+#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_BINARY_METRIC_FORMAT_H_
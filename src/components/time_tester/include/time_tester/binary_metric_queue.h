@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_BINARY_METRIC_QUEUE_H_
+#define SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_BINARY_METRIC_QUEUE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "utils/macro.h"
+#include "utils/ring_buffer_queue.h"
+#include "binary_metric_format.h"
+
+namespace time_tester {
+
+/*
+ * Preallocated lock-free queue of binary metric records.
+ * Any thread pushes records without allocations, single streamer
+ * thread drains them into batches sent with one socket write.
+ * Records are dropped and counted while queue is full.
+ */
+class BinaryMetricQueue {
+ public:
+  static const size_t kCapacity = 4096;
+
+  BinaryMetricQueue();
+
+  void Push(binary_metrics::Record* record, binary_metrics::RecordType type,
+            uint16_t payload_size);
+
+  void PushMessage(binary_metrics::RecordType type,
+                   const binary_metrics::MessagePayload& payload);
+
+  /*
+   * Appends stream header to batch
+   */
+  static void EncodeHeader(std::vector<uint8_t>* batch);
+
+  /*
+   * Appends queued records to batch while it is below max_size bytes,
+   * returns count of drained records
+   */
+  size_t Drain(std::vector<uint8_t>* batch, size_t max_size);
+
+  /*
+   * Removes queued records, which were collected for closed client
+   */
+  void Clear();
+
+  /*
+   * Copies name to zero padded payload field, name is not terminated
+   * if it fills the field, reader takes field size at most
+   */
+  template <size_t Size>
+  static void SetName(char (&field)[Size], const char* name) {
+    strncpy(field, name, Size);
+  }
+
+ private:
+  static void Encode(const binary_metrics::Record& record,
+                     std::vector<uint8_t>* batch);
+
+  utils::RingBufferQueue<binary_metrics::Record, kCapacity> records_;
+  volatile uint32_t dropped_;
+  // Used by streamer only
+  uint32_t reported_dropped_;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryMetricQueue);
+};
+
+}  // namespace time_tester
+#endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_BINARY_METRIC_QUEUE_H_
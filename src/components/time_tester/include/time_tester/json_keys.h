@@ -47,6 +47,52 @@ namespace time_tester {
     const char stime[] = "stime";
     const char utime[] = "utime";
     const char memory[] = "RAM";
+    const char locks[] = "locks";
+    const char name[] = "name";
+    const char acquisitions[] = "acquisitions";
+    const char contentions[] = "contentions";
+    const char wait_time[] = "wait_time";
+    const char max_wait_time[] = "max_wait_time";
+    const char hold_time[] = "hold_time";
+    const char max_hold_time[] = "max_hold_time";
+    const char streams[] = "streams";
+    const char queued_frames[] = "queued_frames";
+    const char queued_bytes[] = "queued_bytes";
+    const char dropped_frames[] = "dropped_frames";
+    const char dropped_bytes[] = "dropped_bytes";
+    const char received_frames[] = "received_frames";
+    const char received_bytes[] = "received_bytes";
+    const char frame_rate[] = "frame_rate";
+    const char bitrate[] = "bitrate";
+    const char jitter[] = "jitter";
+    const char average_latency[] = "average_latency";
+    const char max_latency[] = "max_latency";
+    const char function_id[] = "function_id";
+    const char spans[] = "spans";
+    const char parent[] = "parent";
+    const char queue_wait[] = "queue_wait";
+    const char processing[] = "processing";
+    const char counters[] = "counters";
+    const char gauges[] = "gauges";
+    const char histograms[] = "histograms";
+    const char count[] = "count";
+    const char sum[] = "sum";
+    const char max[] = "max";
+    const char p50[] = "p50";
+    const char p99[] = "p99";
+    const char p999[] = "p999";
+    const char time[] = "time";
+    const char open_files[] = "open_files";
+    const char allocator[] = "allocator";
+    const char arena[] = "arena";
+    const char mmapped[] = "mmapped";
+    const char in_use[] = "in_use";
+    const char free[] = "free";
+    const char threads[] = "threads";
+    const char tid[] = "tid";
+    const char queues[] = "queues";
+    const char depth[] = "depth";
+    const char apps_memory[] = "apps_memory";
   }
 }
 #endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_JSON_KEYS_H_
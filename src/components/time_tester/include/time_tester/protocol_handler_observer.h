@@ -35,6 +35,7 @@
 
 #include "protocol_handler/time_metric_observer.h"
 #include "utils/message_queue.h"
+#include "utils/metrics_registry.h"
 
 namespace time_tester {
 
@@ -51,6 +52,7 @@ class ProtocolHandlerObserver: public protocol_handler::PHMetricObserver {
  private:
   TimeManager* time_manager_;
   std::map<uint32_t, TimevalStruct> time_starts;
+  utils::metrics::Histogram* processing_time_metric_;
 };
 }  // namespace time_tester
 #endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_PROTOCOL_HANDLER_OBSERVER_H_
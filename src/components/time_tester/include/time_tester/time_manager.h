@@ -47,6 +47,12 @@
 #include "transport_manager/transport_manager_impl.h"
 #include "protocol_handler_observer.h"
 #include "protocol_handler/protocol_handler_impl.h"
+#include "rpc_trace_observer.h"
+#include "resource_sample_observer.h"
+#include "utils/timer_thread.h"
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "binary_metric_queue.h"
 
 namespace time_tester {
 
@@ -59,7 +65,53 @@ class TimeManager {
   void Init(protocol_handler::ProtocolHandlerImpl* ph);
   void Stop();
   void SendMetric(utils::SharedPtr<MetricWrapper> metric);
+
+  /*
+   * @brief Returns true if metrics are streamed as binary records
+   */
+  bool binary_format() const {
+    return binary_format_;
+  }
+
+  /*
+   * @brief Returns true if there is a client to stream metrics to
+   */
+  bool is_client_connected() const;
+
+  /*
+   * @brief Queues binary record for connected client without allocations
+   */
+  void SendRecord(binary_metrics::Record* record,
+                  binary_metrics::RecordType type, uint16_t payload_size);
  private:
+  /*
+   * @brief Sends process resources usage as binary record,
+   * binary stream samples resources periodically instead of per metric
+   */
+  void SendResourcesRecord();
+  timer::TimerThread<TimeManager> resources_record_timer_;
+
+  /*
+   * @brief Checks whether client asked for metrics registry snapshot
+   * with "metrics" line and sends it in current stream format
+   */
+  void PollQuery();
+  void SendMetricsSnapshot();
+  timer::TimerThread<TimeManager> query_timer_;
+
+#ifdef LOCK_PROFILING
+  /*
+   * @brief Sends snapshot of named locks statistics to connected client
+   */
+  void SendLockMetric();
+  timer::TimerThread<TimeManager> lock_metric_timer_;
+#endif  // LOCK_PROFILING
+
+  /*
+   * @brief Sends depth and drops of media streaming queues
+   */
+  void SendStreamQueueMetric();
+  timer::TimerThread<TimeManager> stream_queue_metric_timer_;
 
   class Streamer : public threads::ThreadDelegate {
    public:
@@ -72,14 +124,34 @@ class TimeManager {
     void Stop();
     bool Send(const std::string &msg);
     void PushMessage(utils::SharedPtr<MetricWrapper> metric);
+    /*
+     * @brief Reads pending client input without blocking,
+     * returns true if complete query line was received
+     */
+    bool ReadQuery();
     volatile bool is_client_connected_;
     private:
     void ShutDownAndCloseSocket(int32_t socket_fd);
+    /*
+     * @brief Sends JSON metrics while client is connected
+     */
+    void StreamJson();
+    /*
+     * @brief Sends header and batches of binary records while client
+     * is connected
+     */
+    void StreamBinary();
+    bool Send(const uint8_t* data, size_t size);
     TimeManager* const server_;
     int32_t server_socket_fd_;
     int32_t client_socket_fd_;
     volatile bool stop_flag_;
     MessageQueue<utils::SharedPtr<MetricWrapper> > messages_;
+    std::vector<uint8_t> batch_;
+    // Client input, which is not a complete line yet
+    std::string query_;
+    sync_primitives::Lock idle_lock_;
+    sync_primitives::ConditionalVariable idle_;
     DISALLOW_COPY_AND_ASSIGN(Streamer);
   };
 
@@ -88,9 +160,13 @@ class TimeManager {
   bool is_ready_;
   threads::Thread* thread_;
   Streamer* streamer_;
+  bool binary_format_;
+  BinaryMetricQueue records_;
   ApplicationManagerObserver app_observer;
   TransportManagerObserver tm_observer;
   ProtocolHandlerObserver ph_observer;
+  RpcTraceObserver rpc_trace_observer;
+  ResourceSampleObserver resource_sample_observer;
 
   DISALLOW_COPY_AND_ASSIGN(TimeManager);
 };
@@ -36,6 +36,7 @@
 #include "transport_manager/time_metric_observer.h"
 #include "utils/message_queue.h"
 #include "utils/date_time.h"
+#include "utils/metrics_registry.h"
 
 namespace time_tester {
 
@@ -49,6 +50,7 @@ class TransportManagerObserver: public transport_manager::TMMetricObserver {
  private:
   TimeManager* time_manager_;
   std::map<const protocol_handler::RawMessage*, TimevalStruct> time_starts;
+  utils::metrics::Histogram* processing_time_metric_;
 };
 }  // namespace time_tester
 #endif  // SRC_COMPONENTS_TIME_TESTER_INCLUDE_TIME_TESTER_TRANSPORT_MANAGER_OBSERVER_H_
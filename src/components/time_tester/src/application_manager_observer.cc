@@ -33,14 +33,36 @@
 #include "utils/shared_ptr.h"
 #include "time_manager.h"
 #include "application_manager_metric.h"
+#include "application_manager/smart_object_keys.h"
 
 namespace time_tester {
 
 ApplicationManagerObserver::ApplicationManagerObserver(TimeManager* time_manager):
-  time_manager_(time_manager) {
+  time_manager_(time_manager),
+  processing_time_metric_(utils::metrics::MetricsRegistry::instance()
+      ->GetHistogram("application_manager.message_time_us")) {
 }
 
 void ApplicationManagerObserver::OnMessage(utils::SharedPtr<MessageMetric> metric) {
+  processing_time_metric_->Record(date_time::DateTime::getuSecs(
+      date_time::DateTime::Sub(metric->end, metric->begin)));
+  if (time_manager_->binary_format()) {
+    const NsSmartDeviceLink::NsSmartObjects::SmartObject& params =
+        metric->message->getElement(application_manager::strings::params);
+    binary_metrics::Record record;
+    binary_metrics::MessagePayload& payload = record.payload.message;
+    payload.begin = date_time::DateTime::getuSecs(metric->begin);
+    payload.end = date_time::DateTime::getuSecs(metric->end);
+    payload.connection_key =
+        params[application_manager::strings::connection_key].asUInt();
+    payload.id = params[application_manager::strings::correlation_id].asInt();
+    payload.function_id =
+        params[application_manager::strings::function_id].asInt();
+    payload.data_size = 0;
+    time_manager_->SendRecord(&record, binary_metrics::kApplicationManager,
+                              sizeof(payload));
+    return;
+  }
   ApplicationManagerMetricWrapper* m = new ApplicationManagerMetricWrapper();
   m->message_metric = metric;
   m->grabResources();
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "binary_metric_queue.h"
+
+#include "utils/atomic.h"
+
+namespace time_tester {
+
+BinaryMetricQueue::BinaryMetricQueue()
+  : dropped_(0),
+    reported_dropped_(0) {
+}
+
+void BinaryMetricQueue::Push(binary_metrics::Record* record,
+                             binary_metrics::RecordType type,
+                             uint16_t payload_size) {
+  record->type = type;
+  record->size = payload_size;
+  record->reserved = 0;
+  if (!records_.TryPush(*record)) {
+    atomic_post_inc(&dropped_);
+  }
+}
+
+void BinaryMetricQueue::PushMessage(
+    binary_metrics::RecordType type,
+    const binary_metrics::MessagePayload& payload) {
+  binary_metrics::Record record;
+  record.payload.message = payload;
+  Push(&record, type, sizeof(payload));
+}
+
+void BinaryMetricQueue::EncodeHeader(std::vector<uint8_t>* batch) {
+  const uint8_t* magic = reinterpret_cast<const uint8_t*>(
+      binary_metrics::kMagic);
+  batch->insert(batch->end(), magic, magic + binary_metrics::kMagicSize);
+  const uint8_t* byte_order =
+      reinterpret_cast<const uint8_t*>(&binary_metrics::kByteOrder);
+  batch->insert(batch->end(), byte_order,
+                byte_order + sizeof(binary_metrics::kByteOrder));
+  const uint8_t* version =
+      reinterpret_cast<const uint8_t*>(&binary_metrics::kVersion);
+  batch->insert(batch->end(), version,
+                version + sizeof(binary_metrics::kVersion));
+}
+
+size_t BinaryMetricQueue::Drain(std::vector<uint8_t>* batch,
+                                size_t max_size) {
+  size_t drained = 0;
+  const uint32_t dropped = dropped_;
+  if (dropped != reported_dropped_) {
+    binary_metrics::Record record;
+    record.type = binary_metrics::kDropped;
+    record.size = sizeof(record.payload.dropped);
+    record.payload.dropped.count = dropped - reported_dropped_;
+    Encode(record, batch);
+    reported_dropped_ = dropped;
+    ++drained;
+  }
+  binary_metrics::Record record;
+  while (batch->size() < max_size && records_.TryPop(record)) {
+    Encode(record, batch);
+    ++drained;
+  }
+  return drained;
+}
+
+void BinaryMetricQueue::Clear() {
+  binary_metrics::Record record;
+  while (records_.TryPop(record)) {
+  }
+  reported_dropped_ = dropped_;
+}
+
+void BinaryMetricQueue::Encode(const binary_metrics::Record& record,
+                               std::vector<uint8_t>* batch) {
+  const uint8_t* header = reinterpret_cast<const uint8_t*>(&record);
+  batch->insert(batch->end(), header,
+                header + binary_metrics::kRecordHeaderSize);
+  const uint8_t* payload =
+      reinterpret_cast<const uint8_t*>(&record.payload);
+  batch->insert(batch->end(), payload, payload + record.size);
+}
+
+}  // namespace time_tester
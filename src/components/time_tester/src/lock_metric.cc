@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "lock_metric.h"
+#include "json/json.h"
+#include "json_keys.h"
+
+namespace time_tester {
+
+Json::Value LockMetricWrapper::GetJsonMetric() {
+  Json::Value result = MetricWrapper::GetJsonMetric();
+  result[strings::logger] = "Locks";
+  Json::Value& locks = result[strings::locks];
+  locks = Json::Value(Json::arrayValue);
+  for (std::vector<sync_primitives::LockStatistics>::const_iterator it =
+       statistics.begin(); statistics.end() != it; ++it) {
+    Json::Value lock;
+    lock[strings::name] = it->name;
+    lock[strings::acquisitions] = Json::UInt64(it->acquisitions);
+    lock[strings::contentions] = Json::UInt64(it->contentions);
+    lock[strings::wait_time] = Json::UInt64(it->total_wait_time);
+    lock[strings::max_wait_time] = Json::UInt64(it->max_wait_time);
+    lock[strings::hold_time] = Json::UInt64(it->total_hold_time);
+    lock[strings::max_hold_time] = Json::UInt64(it->max_hold_time);
+    locks.append(lock);
+  }
+  return result;
+}
+
+}  // namespace time_tester
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "metrics_snapshot_metric.h"
+#include "json/json.h"
+#include "json_keys.h"
+
+namespace time_tester {
+
+Json::Value MetricsSnapshotWrapper::GetJsonMetric() {
+  Json::Value result = MetricWrapper::GetJsonMetric();
+  result[strings::logger] = "Metrics";
+  Json::Value& counters = result[strings::counters];
+  counters = Json::Value(Json::objectValue);
+  for (size_t i = 0; i < snapshot.counters.size(); ++i) {
+    counters[snapshot.counters[i].first] =
+        Json::UInt64(snapshot.counters[i].second);
+  }
+  Json::Value& gauges = result[strings::gauges];
+  gauges = Json::Value(Json::objectValue);
+  for (size_t i = 0; i < snapshot.gauges.size(); ++i) {
+    gauges[snapshot.gauges[i].first] = Json::Int64(snapshot.gauges[i].second);
+  }
+  Json::Value& histograms = result[strings::histograms];
+  histograms = Json::Value(Json::arrayValue);
+  for (size_t i = 0; i < snapshot.histograms.size(); ++i) {
+    const utils::metrics::HistogramSnapshot& it = snapshot.histograms[i];
+    Json::Value histogram;
+    histogram[strings::name] = it.name;
+    histogram[strings::count] = Json::UInt64(it.count);
+    histogram[strings::sum] = Json::UInt64(it.sum);
+    histogram[strings::max] = Json::UInt64(it.max);
+    histogram[strings::p50] = Json::UInt64(it.Percentile(50));
+    histogram[strings::p99] = Json::UInt64(it.Percentile(99));
+    histogram[strings::p999] = Json::UInt64(it.Percentile(99.9));
+    histograms.append(histogram);
+  }
+  return result;
+}
+
+}  // namespace time_tester
@@ -40,7 +40,9 @@ namespace time_tester {
 CREATE_LOGGERPTR_GLOBAL(logger_, "Utils")
 
 ProtocolHandlerObserver::ProtocolHandlerObserver(TimeManager *time_manager):
-  time_manager_(time_manager) {
+  time_manager_(time_manager),
+  processing_time_metric_(utils::metrics::MetricsRegistry::instance()
+      ->GetHistogram("protocol_handler.message_time_us")) {
 }
 
 void ProtocolHandlerObserver::StartMessageProcess(uint32_t message_id,
@@ -63,7 +65,22 @@ void ProtocolHandlerObserver::EndMessageProcess(utils::SharedPtr<MessageMetric>
     return;
   }
   m->begin= time_starts[message_id];
-  m->end = date_time::DateTime::getCurrentTime();
+  m->end = date_time::DateTime::getPreciseMonotonicTime();
+  processing_time_metric_->Record(date_time::DateTime::getuSecs(
+      date_time::DateTime::Sub(m->end, m->begin)));
+  if (time_manager_->binary_format()) {
+    binary_metrics::Record record;
+    binary_metrics::MessagePayload& payload = record.payload.message;
+    payload.begin = date_time::DateTime::getuSecs(m->begin);
+    payload.end = date_time::DateTime::getuSecs(m->end);
+    payload.connection_key = m->connection_key;
+    payload.id = m->message_id;
+    payload.function_id = 0;
+    payload.data_size = m->raw_msg ? m->raw_msg->data_size() : 0;
+    time_manager_->SendRecord(&record, binary_metrics::kProtocolHandler,
+                              sizeof(payload));
+    return;
+  }
   ProtocolHandlerMecticWrapper* metric = new ProtocolHandlerMecticWrapper();
   metric->message_metric = m;
   metric->grabResources();
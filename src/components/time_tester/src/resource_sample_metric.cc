@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "resource_sample_metric.h"
+#include "json/json.h"
+#include "json_keys.h"
+
+namespace time_tester {
+
+Json::Value ResourceSampleMetricWrapper::GetJsonMetric() {
+  Json::Value result = MetricWrapper::GetJsonMetric();
+  result[strings::logger] = "ResourceSample";
+  result[strings::time] =
+      Json::Int64(date_time::DateTime::getuSecs(sample.time));
+  result[strings::open_files] = sample.open_files;
+
+  Json::Value& allocator = result[strings::allocator];
+  allocator[strings::arena] = Json::UInt64(sample.allocator.arena);
+  allocator[strings::mmapped] = Json::UInt64(sample.allocator.mmapped);
+  allocator[strings::in_use] = Json::UInt64(sample.allocator.in_use);
+  allocator[strings::free] = Json::UInt64(sample.allocator.free);
+
+  Json::Value& threads = result[strings::threads];
+  threads = Json::Value(Json::arrayValue);
+  for (std::vector<utils::Resources::ThreadUsage>::const_iterator it =
+       sample.threads.begin(); sample.threads.end() != it; ++it) {
+    Json::Value thread;
+    thread[strings::tid] = it->tid;
+    thread[strings::name] = it->name;
+    thread[strings::utime] = Json::UInt64(it->utime);
+    thread[strings::stime] = Json::UInt64(it->stime);
+    threads.append(thread);
+  }
+
+  Json::Value& queues = result[strings::queues];
+  queues = Json::Value(Json::arrayValue);
+  for (threads::MessageLoopRegistry::Depths::const_iterator it =
+       sample.queues.begin(); sample.queues.end() != it; ++it) {
+    Json::Value queue;
+    queue[strings::name] = it->first;
+    queue[strings::depth] = Json::UInt64(it->second);
+    queues.append(queue);
+  }
+
+  Json::Value& apps_memory = result[strings::apps_memory];
+  apps_memory = Json::Value(Json::arrayValue);
+  for (utils::MemoryAccounting::Snapshot::const_iterator it =
+       sample.apps_memory.begin(); sample.apps_memory.end() != it; ++it) {
+    Json::Value app;
+    app[strings::connection_key] = it->first;
+    for (uint32_t i = 0; i < utils::MemoryAccounting::kCategoriesCount; ++i) {
+      app[utils::MemoryAccounting::CategoryName(
+          static_cast<utils::MemoryAccounting::Category>(i))] =
+              Json::UInt64(it->second.bytes[i]);
+    }
+    apps_memory.append(app);
+  }
+  return result;
+}
+
+}  // namespace time_tester
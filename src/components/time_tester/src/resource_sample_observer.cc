@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "resource_sample_observer.h"
+#include "time_manager.h"
+#include "resource_sample_metric.h"
+
+namespace time_tester {
+
+ResourceSampleObserver::ResourceSampleObserver(TimeManager* time_manager)
+  : time_manager_(time_manager) {
+}
+
+void ResourceSampleObserver::OnResourceSample(
+    const utils::ResourceSample& sample) {
+  if (!time_manager_->is_client_connected()) {
+    return;
+  }
+  if (time_manager_->binary_format()) {
+    SendRecords(sample);
+    return;
+  }
+  ResourceSampleMetricWrapper* metric = new ResourceSampleMetricWrapper();
+  metric->sample = sample;
+  metric->grabResources();
+  time_manager_->SendMetric(metric);
+}
+
+void ResourceSampleObserver::SendRecords(
+    const utils::ResourceSample& sample) {
+  const int64_t time = date_time::DateTime::getuSecs(sample.time);
+  {
+    binary_metrics::Record record;
+    binary_metrics::ProcessUsagePayload& payload =
+        record.payload.process_usage;
+    payload.time = time;
+    payload.arena = sample.allocator.arena;
+    payload.mmapped = sample.allocator.mmapped;
+    payload.in_use = sample.allocator.in_use;
+    payload.free = sample.allocator.free;
+    payload.open_files = sample.open_files;
+    payload.threads_count = static_cast<uint32_t>(sample.threads.size());
+    time_manager_->SendRecord(&record, binary_metrics::kProcessUsage,
+                              sizeof(payload));
+  }
+  for (std::vector<utils::Resources::ThreadUsage>::const_iterator it =
+       sample.threads.begin(); sample.threads.end() != it; ++it) {
+    binary_metrics::Record record;
+    binary_metrics::ThreadUsagePayload& payload = record.payload.thread_usage;
+    BinaryMetricQueue::SetName(payload.name, it->name.c_str());
+    payload.time = time;
+    payload.utime = it->utime;
+    payload.stime = it->stime;
+    payload.tid = it->tid;
+    payload.reserved = 0;
+    time_manager_->SendRecord(&record, binary_metrics::kThreadUsage,
+                              sizeof(payload));
+  }
+  for (threads::MessageLoopRegistry::Depths::const_iterator it =
+       sample.queues.begin(); sample.queues.end() != it; ++it) {
+    binary_metrics::Record record;
+    binary_metrics::QueueDepthPayload& payload = record.payload.queue_depth;
+    BinaryMetricQueue::SetName(payload.name, it->first.c_str());
+    payload.time = time;
+    payload.depth = it->second;
+    time_manager_->SendRecord(&record, binary_metrics::kQueueDepth,
+                              sizeof(payload));
+  }
+  for (utils::MemoryAccounting::Snapshot::const_iterator it =
+       sample.apps_memory.begin(); sample.apps_memory.end() != it; ++it) {
+    binary_metrics::Record record;
+    binary_metrics::AppMemoryPayload& payload = record.payload.app_memory;
+    payload.time = time;
+    payload.connection_key = it->first;
+    payload.reserved = 0;
+    payload.app_state =
+        it->second.bytes[utils::MemoryAccounting::kAppState];
+    payload.multi_frame =
+        it->second.bytes[utils::MemoryAccounting::kMultiFrame];
+    payload.queued_messages =
+        it->second.bytes[utils::MemoryAccounting::kQueuedMessages];
+    time_manager_->SendRecord(&record, binary_metrics::kAppMemory,
+                              sizeof(payload));
+  }
+}
+
+}  // namespace time_tester
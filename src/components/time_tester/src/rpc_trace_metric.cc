@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rpc_trace_metric.h"
+
+#include <vector>
+
+#include "json/json.h"
+#include "json_keys.h"
+
+namespace time_tester {
+
+namespace {
+bool IsSet(const TimevalStruct& time) {
+  return 0 != time.tv_sec || 0 != time.tv_usec;
+}
+
+// Duration is not reported if one of its points was never reached
+void SetDuration(Json::Value* value, const char* key,
+                 const TimevalStruct& from, const TimevalStruct& to) {
+  if (IsSet(from) && IsSet(to)) {
+    (*value)[key] = Json::Int64(date_time::DateTime::getuSecs(
+        date_time::DateTime::Sub(to, from)));
+  }
+}
+}  // namespace
+
+Json::Value RpcTraceMetricWrapper::GetJsonMetric() {
+  Json::Value result = MetricWrapper::GetJsonMetric();
+  result[strings::logger] = "RpcTrace";
+  if (!trace) {
+    return result;
+  }
+  result[strings::connection_key] = trace->connection_key();
+  result[strings::correlation_id] = trace->correlation_id();
+  result[strings::function_id] = trace->function_id();
+
+  Json::Value& spans = result[strings::spans];
+  spans = Json::Value(Json::arrayValue);
+  const std::vector<utils::RpcTraceSpan> trace_spans = trace->spans();
+  for (std::vector<utils::RpcTraceSpan>::const_iterator it =
+       trace_spans.begin(); trace_spans.end() != it; ++it) {
+    Json::Value span;
+    span[strings::name] = it->name;
+    span[strings::parent] = it->parent;
+    span[strings::begin] = Json::Int64(date_time::DateTime::getuSecs(
+        it->begin));
+    span[strings::end] = Json::Int64(date_time::DateTime::getuSecs(it->end));
+    SetDuration(&span, strings::queue_wait, it->queued, it->begin);
+    SetDuration(&span, strings::processing, it->begin, it->end);
+    spans.append(span);
+  }
+  return result;
+}
+
+}  // namespace time_tester
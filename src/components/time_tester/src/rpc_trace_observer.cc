@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rpc_trace_observer.h"
+#include "time_manager.h"
+#include "rpc_trace_metric.h"
+#include "utils/atomic.h"
+
+namespace time_tester {
+
+RpcTraceObserver::RpcTraceObserver(TimeManager* time_manager)
+  : time_manager_(time_manager),
+    traces_count_(0) {
+}
+
+void RpcTraceObserver::OnRpcTraced(const utils::RpcTracePtr& trace) {
+  if (time_manager_->binary_format()) {
+    SendRecords(trace);
+    return;
+  }
+  RpcTraceMetricWrapper* metric = new RpcTraceMetricWrapper();
+  metric->trace = trace;
+  time_manager_->SendMetric(metric);
+}
+
+void RpcTraceObserver::SendRecords(const utils::RpcTracePtr& trace) {
+  const uint32_t trace_number = atomic_post_inc(&traces_count_);
+  const std::vector<utils::RpcTraceSpan> spans = trace->spans();
+  for (size_t index = 0; index < spans.size(); ++index) {
+    const utils::RpcTraceSpan& span = spans[index];
+    binary_metrics::Record record;
+    binary_metrics::RpcSpanPayload& payload = record.payload.span;
+    payload.queued = date_time::DateTime::getuSecs(span.queued);
+    payload.begin = date_time::DateTime::getuSecs(span.begin);
+    payload.end = date_time::DateTime::getuSecs(span.end);
+    BinaryMetricQueue::SetName(payload.name, span.name);
+    payload.trace = trace_number;
+    payload.connection_key = trace->connection_key();
+    payload.correlation_id = trace->correlation_id();
+    payload.function_id = trace->function_id();
+    payload.index = static_cast<int16_t>(index);
+    payload.parent = static_cast<int16_t>(span.parent);
+    payload.reserved = 0;
+    time_manager_->SendRecord(&record, binary_metrics::kRpcSpan,
+                              sizeof(payload));
+  }
+}
+
+}  // namespace time_tester
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "stream_queue_metric.h"
+#include "json/json.h"
+#include "json_keys.h"
+
+namespace time_tester {
+
+Json::Value StreamQueueMetricWrapper::GetJsonMetric() {
+  Json::Value result = MetricWrapper::GetJsonMetric();
+  result[strings::logger] = "MediaStreams";
+  Json::Value& streams = result[strings::streams];
+  streams = Json::Value(Json::arrayValue);
+  for (std::vector<media_manager::StreamQueueStatistics>::const_iterator it =
+       statistics.begin(); statistics.end() != it; ++it) {
+    Json::Value stream;
+    stream[strings::name] = it->name;
+    stream[strings::queued_frames] = Json::UInt64(it->queued_frames);
+    stream[strings::queued_bytes] = Json::UInt64(it->queued_bytes);
+    stream[strings::dropped_frames] = Json::UInt64(it->dropped_frames);
+    stream[strings::dropped_bytes] = Json::UInt64(it->dropped_bytes);
+    stream[strings::received_frames] = Json::UInt64(it->received_frames);
+    stream[strings::received_bytes] = Json::UInt64(it->received_bytes);
+    stream[strings::frame_rate] = it->frame_rate;
+    stream[strings::bitrate] = Json::UInt64(it->bitrate);
+    stream[strings::jitter] = Json::UInt64(it->jitter_us);
+    stream[strings::average_latency] = Json::UInt64(it->average_latency_us);
+    stream[strings::max_latency] = Json::UInt64(it->max_latency_us);
+    streams.append(stream);
+  }
+  return result;
+}
+
+}  // namespace time_tester
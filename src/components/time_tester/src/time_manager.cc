@@ -40,21 +40,55 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <string.h>
+#include <errno.h>
 
 #include "transport_manager/transport_manager_default.h"
 #include "config_profile/profile.h"
 #include "utils/resource_usage.h"
+#ifdef LOCK_PROFILING
+#include "lock_metric.h"
+#endif  // LOCK_PROFILING
+#include "stream_queue_metric.h"
+#include "metrics_snapshot_metric.h"
+#include "utils/date_time.h"
 
 namespace time_tester {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "TimeManager")
 
+namespace {
+#ifdef LOCK_PROFILING
+const uint32_t kLockMetricPeriodSeconds = 1;
+#endif  // LOCK_PROFILING
+const uint32_t kStreamQueueMetricPeriodSeconds = 1;
+const uint32_t kResourcesRecordPeriodSeconds = 1;
+const uint32_t kQueryPollPeriodSeconds = 1;
+const char kMetricsQuery[] = "metrics";
+// Longer client input without line end is dropped
+const size_t kMaxQuerySize = 256;
+// Records are gathered to batches of this size to send them with one write
+const size_t kBinaryBatchSize = 64 * 1024;
+// Streamer polls binary queue, so producers never block or signal
+const int32_t kBinaryIdleTimeoutMs = 10;
+}
+
 TimeManager::TimeManager():
+  resources_record_timer_("ResourcesRecord", this,
+                          &TimeManager::SendResourcesRecord, true),
+  query_timer_("MetricsQuery", this, &TimeManager::PollQuery, true),
+#ifdef LOCK_PROFILING
+  lock_metric_timer_("LockMetric", this, &TimeManager::SendLockMetric, true),
+#endif  // LOCK_PROFILING
+  stream_queue_metric_timer_("StreamQueueMetric", this,
+                             &TimeManager::SendStreamQueueMetric, true),
   thread_(NULL),
   streamer_(NULL),
+  binary_format_(profile::Profile::instance()->time_testing_binary_format()),
   app_observer(this),
   tm_observer(this),
-  ph_observer(this) {
+  ph_observer(this),
+  rpc_trace_observer(this),
+  resource_sample_observer(this) {
     ip_ = profile::Profile::instance()->server_address();
     port_ = profile::Profile::instance()->time_testing_port();
     streamer_ = new Streamer(this);
@@ -76,11 +110,29 @@ void TimeManager::Init(protocol_handler::ProtocolHandlerImpl* ph) {
   application_manager::ApplicationManagerImpl::instance()->SetTimeMetricObserver(&app_observer);
   transport_manager::TransportManagerDefault::instance()->SetTimeMetricObserver(&tm_observer);
   ph->SetTimeMetricObserver(&ph_observer);
+  utils::RpcTracer::instance()->set_observer(&rpc_trace_observer);
+  utils::ResourceSampler::instance()->set_observer(&resource_sample_observer);
   thread_->start(threads::ThreadOptions());
+#ifdef LOCK_PROFILING
+  lock_metric_timer_.start(kLockMetricPeriodSeconds);
+#endif  // LOCK_PROFILING
+  stream_queue_metric_timer_.start(kStreamQueueMetricPeriodSeconds);
+  if (binary_format_) {
+    resources_record_timer_.start(kResourcesRecordPeriodSeconds);
+  }
+  query_timer_.start(kQueryPollPeriodSeconds);
 }
 
 void TimeManager::Stop() {
   LOG4CXX_AUTO_TRACE(logger_);
+#ifdef LOCK_PROFILING
+  lock_metric_timer_.stop();
+#endif  // LOCK_PROFILING
+  stream_queue_metric_timer_.stop();
+  resources_record_timer_.stop();
+  query_timer_.stop();
+  utils::RpcTracer::instance()->set_observer(NULL);
+  utils::ResourceSampler::instance()->set_observer(NULL);
   threads::DeleteThread(thread_);
   thread_ = NULL;
 }
@@ -91,6 +143,151 @@ void TimeManager::SendMetric(utils::SharedPtr<MetricWrapper> metric) {
   }
 }
 
+bool TimeManager::is_client_connected() const {
+  return (NULL != streamer_) && streamer_->is_client_connected_;
+}
+
+void TimeManager::SendRecord(binary_metrics::Record* record,
+                             binary_metrics::RecordType type,
+                             uint16_t payload_size) {
+  if (is_client_connected()) {
+    records_.Push(record, type, payload_size);
+  }
+}
+
+void TimeManager::SendResourcesRecord() {
+  if (!is_client_connected()) {
+    return;
+  }
+  utils::ResourseUsage* usage = utils::Resources::getCurrentResourseUsage();
+  if (NULL == usage) {
+    return;
+  }
+  binary_metrics::Record record;
+  binary_metrics::ResourcesPayload& payload = record.payload.resources;
+  payload.time = date_time::DateTime::getuSecs(
+      date_time::DateTime::getPreciseMonotonicTime());
+  payload.utime = usage->utime;
+  payload.stime = usage->stime;
+  payload.memory = usage->memory;
+  delete usage;
+  SendRecord(&record, binary_metrics::kResources, sizeof(payload));
+}
+
+void TimeManager::PollQuery() {
+  if (is_client_connected() && streamer_->ReadQuery()) {
+    SendMetricsSnapshot();
+  }
+}
+
+void TimeManager::SendMetricsSnapshot() {
+  utils::metrics::Snapshot snapshot;
+  utils::metrics::MetricsRegistry::instance()->TakeSnapshot(&snapshot);
+  if (!binary_format_) {
+    MetricsSnapshotWrapper* metric = new MetricsSnapshotWrapper();
+    metric->snapshot = snapshot;
+    metric->grabResources();
+    SendMetric(metric);
+    return;
+  }
+  for (size_t i = 0; i < snapshot.counters.size(); ++i) {
+    binary_metrics::Record record;
+    binary_metrics::ValuePayload& payload = record.payload.value;
+    BinaryMetricQueue::SetName(payload.name,
+                               snapshot.counters[i].first.c_str());
+    payload.value = snapshot.counters[i].second;
+    SendRecord(&record, binary_metrics::kCounter, sizeof(payload));
+  }
+  for (size_t i = 0; i < snapshot.gauges.size(); ++i) {
+    binary_metrics::Record record;
+    binary_metrics::ValuePayload& payload = record.payload.value;
+    BinaryMetricQueue::SetName(payload.name,
+                               snapshot.gauges[i].first.c_str());
+    payload.value = snapshot.gauges[i].second;
+    SendRecord(&record, binary_metrics::kGauge, sizeof(payload));
+  }
+  for (size_t i = 0; i < snapshot.histograms.size(); ++i) {
+    const utils::metrics::HistogramSnapshot& histogram =
+        snapshot.histograms[i];
+    binary_metrics::Record record;
+    binary_metrics::HistogramPayload& payload = record.payload.histogram;
+    BinaryMetricQueue::SetName(payload.name, histogram.name.c_str());
+    payload.count = histogram.count;
+    payload.sum = histogram.sum;
+    payload.max = histogram.max;
+    payload.p50 = histogram.Percentile(50);
+    payload.p99 = histogram.Percentile(99);
+    payload.p999 = histogram.Percentile(99.9);
+    SendRecord(&record, binary_metrics::kHistogram, sizeof(payload));
+  }
+}
+
+#ifdef LOCK_PROFILING
+void TimeManager::SendLockMetric() {
+  if (!is_client_connected()) {
+    return;
+  }
+  if (binary_format_) {
+    std::vector<sync_primitives::LockStatistics> statistics;
+    sync_primitives::LockProfiler::instance()->Snapshot(&statistics);
+    for (std::vector<sync_primitives::LockStatistics>::const_iterator it =
+         statistics.begin(); statistics.end() != it; ++it) {
+      binary_metrics::Record record;
+      binary_metrics::LockPayload& payload = record.payload.lock;
+      BinaryMetricQueue::SetName(payload.name, it->name.c_str());
+      payload.acquisitions = it->acquisitions;
+      payload.contentions = it->contentions;
+      payload.wait_time = it->total_wait_time;
+      payload.max_wait_time = it->max_wait_time;
+      payload.hold_time = it->total_hold_time;
+      payload.max_hold_time = it->max_hold_time;
+      SendRecord(&record, binary_metrics::kLock, sizeof(payload));
+    }
+    return;
+  }
+  LockMetricWrapper* metric = new LockMetricWrapper();
+  sync_primitives::LockProfiler::instance()->Snapshot(&metric->statistics);
+  metric->grabResources();
+  SendMetric(metric);
+}
+#endif  // LOCK_PROFILING
+
+void TimeManager::SendStreamQueueMetric() {
+  if (!is_client_connected()) {
+    return;
+  }
+  std::vector<media_manager::StreamQueueStatistics> statistics;
+  media_manager::StreamQueue::Snapshot(&statistics);
+  if (statistics.empty()) {
+    return;
+  }
+  if (binary_format_) {
+    for (std::vector<media_manager::StreamQueueStatistics>::const_iterator it =
+         statistics.begin(); statistics.end() != it; ++it) {
+      binary_metrics::Record record;
+      binary_metrics::StreamQueuePayload& payload = record.payload.stream_queue;
+      BinaryMetricQueue::SetName(payload.name, it->name.c_str());
+      payload.queued_frames = it->queued_frames;
+      payload.queued_bytes = it->queued_bytes;
+      payload.dropped_frames = it->dropped_frames;
+      payload.dropped_bytes = it->dropped_bytes;
+      payload.received_frames = it->received_frames;
+      payload.received_bytes = it->received_bytes;
+      payload.bitrate = it->bitrate;
+      payload.jitter_us = it->jitter_us;
+      payload.average_latency_us = it->average_latency_us;
+      payload.max_latency_us = it->max_latency_us;
+      payload.frame_rate = it->frame_rate;
+      SendRecord(&record, binary_metrics::kStreamQueue, sizeof(payload));
+    }
+    return;
+  }
+  StreamQueueMetricWrapper* metric = new StreamQueueMetricWrapper();
+  metric->statistics.swap(statistics);
+  metric->grabResources();
+  SendMetric(metric);
+}
+
 TimeManager::Streamer::Streamer(
   TimeManager* const server)
   : is_client_connected_(false),
@@ -117,24 +314,53 @@ void TimeManager::Streamer::threadMain() {
       break;
     }
     LOG4CXX_INFO(logger_, "Client connected");
+    query_.clear();
 
-    is_client_connected_ = true;
-    while (is_client_connected_) {
-      while (!messages_.empty()) {
-        utils::SharedPtr<MetricWrapper> metric = messages_.pop();
-        is_client_connected_ = Send(metric->GetStyledString());
-      }
+    if (server_->binary_format_) {
+      StreamBinary();
+    } else {
+      StreamJson();
+    }
+  }
+}
 
-      if (!IsReady()) {
-        LOG4CXX_INFO(logger_, "Client disconnected.");
-        break;
-      }
+void TimeManager::Streamer::StreamJson() {
+  is_client_connected_ = true;
+  while (is_client_connected_) {
+    while (!messages_.empty()) {
+      utils::SharedPtr<MetricWrapper> metric = messages_.pop();
+      is_client_connected_ = Send(metric->GetStyledString());
+    }
 
-      messages_.wait();
+    if (!IsReady()) {
+      LOG4CXX_INFO(logger_, "Client disconnected.");
+      break;
     }
+
+    messages_.wait();
   }
 }
 
+void TimeManager::Streamer::StreamBinary() {
+  // Records left from previous client belong to its timeline
+  server_->records_.Clear();
+  batch_.clear();
+  batch_.reserve(kBinaryBatchSize + sizeof(binary_metrics::Record));
+  BinaryMetricQueue::EncodeHeader(&batch_);
+  is_client_connected_ = Send(&batch_[0], batch_.size());
+  while (is_client_connected_ && !stop_flag_) {
+    batch_.clear();
+    if (0 == server_->records_.Drain(&batch_, kBinaryBatchSize)) {
+      sync_primitives::AutoLock auto_lock(idle_lock_);
+      idle_.WaitFor(auto_lock, kBinaryIdleTimeoutMs);
+      continue;
+    }
+    is_client_connected_ = Send(&batch_[0], batch_.size());
+  }
+  is_client_connected_ = false;
+  LOG4CXX_INFO(logger_, "Client disconnected.");
+}
+
 void TimeManager::Streamer::exitThreadMain() {
   LOG4CXX_AUTO_TRACE(logger_);
   Stop();
@@ -200,6 +426,10 @@ void TimeManager::Streamer::Stop() {
   }
   stop_flag_ = true;
   messages_.Reset();
+  {
+    sync_primitives::AutoLock auto_lock(idle_lock_);
+    idle_.NotifyOne();
+  }
   LOG4CXX_WARN(logger_, "Stop server_socket_fd_");
   ShutDownAndCloseSocket(server_socket_fd_);
   server_socket_fd_ = -1;
@@ -234,19 +464,56 @@ bool TimeManager::Streamer::IsReady() const {
 
 bool TimeManager::Streamer::Send(const std::string& msg) {
   LOG4CXX_AUTO_TRACE(logger_);
-  if (!IsReady()) {
-    LOG4CXX_ERROR_EXT(logger_, " Socket is not ready");
-    return false;
-  }
+  return Send(reinterpret_cast<const uint8_t*>(msg.c_str()), msg.size());
+}
 
-  if (-1 == ::send(client_socket_fd_, msg.c_str(),
-                   msg.size(), MSG_NOSIGNAL)) {
-    LOG4CXX_ERROR_EXT(logger_, " Unable to send");
-    return false;
+bool TimeManager::Streamer::Send(const uint8_t* data, size_t size) {
+  while (0 < size) {
+    if (!IsReady()) {
+      LOG4CXX_ERROR_EXT(logger_, " Socket is not ready");
+      return false;
+    }
+    const ssize_t sent = ::send(client_socket_fd_, data, size, MSG_NOSIGNAL);
+    if (-1 == sent) {
+      if (EINTR == errno) {
+        continue;
+      }
+      LOG4CXX_ERROR_EXT(logger_, " Unable to send");
+      return false;
+    }
+    data += sent;
+    size -= sent;
   }
   return true;
 }
 
+bool TimeManager::Streamer::ReadQuery() {
+  char buffer[kMaxQuerySize];
+  bool queried = false;
+  ssize_t received = 0;
+  while (0 < (received = ::recv(client_socket_fd_, buffer, sizeof(buffer),
+                                MSG_DONTWAIT))) {
+    query_.append(buffer, received);
+    std::string::size_type line_end = std::string::npos;
+    while (std::string::npos != (line_end = query_.find('\n'))) {
+      std::string line = query_.substr(0, line_end);
+      query_.erase(0, line_end + 1);
+      if (!line.empty() && '\r' == line[line.size() - 1]) {
+        line.erase(line.size() - 1);
+      }
+      if (kMetricsQuery == line) {
+        queried = true;
+      } else {
+        LOG4CXX_WARN(logger_, "Unknown query: " << line);
+      }
+    }
+    if (kMaxQuerySize < query_.size()) {
+      query_.clear();
+    }
+  }
+  return queried;
+}
+
 void TimeManager::Streamer::PushMessage(utils::SharedPtr<MetricWrapper> metric) {
   messages_.push(metric);
 }
@@ -39,21 +39,39 @@
 namespace time_tester {
 
 TransportManagerObserver::TransportManagerObserver(TimeManager* time_manager):
-  time_manager_ (time_manager) {
+  time_manager_ (time_manager),
+  processing_time_metric_(utils::metrics::MetricsRegistry::instance()
+      ->GetHistogram("transport_manager.message_time_us")) {
 }
 
 void TransportManagerObserver::StartRawMsg(const protocol_handler::RawMessage* ptr) {
-  time_starts[ptr] = date_time::DateTime::getCurrentTime();
+  time_starts[ptr] = date_time::DateTime::getPreciseMonotonicTime();
 }
 
 void TransportManagerObserver::StopRawMsg(const protocol_handler::RawMessage* ptr) {
     std::map<const protocol_handler::RawMessage*, TimevalStruct>::const_iterator it;
     it = time_starts.find(ptr);
     if (it != time_starts.end()) {
+      const TimevalStruct end = date_time::DateTime::getPreciseMonotonicTime();
+      processing_time_metric_->Record(date_time::DateTime::getuSecs(
+          date_time::DateTime::Sub(end, it->second)));
+      if (time_manager_->binary_format()) {
+        binary_metrics::Record record;
+        binary_metrics::MessagePayload& payload = record.payload.message;
+        payload.begin = date_time::DateTime::getuSecs(it->second);
+        payload.end = date_time::DateTime::getuSecs(end);
+        payload.connection_key = 0;
+        payload.id = 0;
+        payload.function_id = 0;
+        payload.data_size = ptr->data_size();
+        time_manager_->SendRecord(&record, binary_metrics::kTransportManager,
+                                  sizeof(payload));
+        return;
+      }
       TransportManagerMecticWrapper* m = new TransportManagerMecticWrapper();
       m->message_metric = new transport_manager::TMMetricObserver::MessageMetric();
       m->message_metric->begin = it->second;
-      m->message_metric->end = date_time::DateTime::getCurrentTime();
+      m->message_metric->end = end;
       m->message_metric->data_size = ptr->data_size();
       m->grabResources();
       time_manager_->SendMetric(m);
@@ -43,9 +43,13 @@
 #include <bluetooth/sdp_lib.h>
 #include <bluetooth/rfcomm.h>
 
+#include <map>
+#include <string>
+
 #include "transport_manager/transport_adapter/device_scanner.h"
 #include "utils/conditional_variable.h"
 #include "utils/lock.h"
+#include "utils/date_time.h"
 #include "utils/threads/thread_delegate.h"
 
 class Thread;
@@ -64,9 +68,12 @@ class BluetoothDeviceScanner : public DeviceScanner {
    * @param controller Transport adapter controller
    * @param auto_repeat_search true - autorepeated or continous device search, false - search on demand
    * @param repeat_search_pause_sec - pause between device searches, 0 means continous search
+   * @param async_discovery true - devices are queried for SDL service concurrently,
+   * false - one by one
    */
   BluetoothDeviceScanner(TransportAdapterController* controller,
-                         bool auto_repeat_search, int repeat_search_pause_sec);
+                         bool auto_repeat_search, int repeat_search_pause_sec,
+                         bool async_discovery = false);
   /**
    * @brief Destructor.
    */
@@ -115,6 +122,17 @@ class BluetoothDeviceScanner : public DeviceScanner {
 
   typedef std::vector<uint8_t> RfcommChannelVector;
 
+  /**
+   * @brief SDL service found on paired device by previous search,
+   * device is reported by it without SDP query until it expires.
+   */
+  struct CachedDevice {
+    std::string name;
+    RfcommChannelVector rfcomm_channels;
+    TimevalStruct discovery_time;
+  };
+  typedef std::map<DeviceUID, CachedDevice> CachedDevices;
+
   /**
    * @brief Waits for external scan request or time out for repeated search or terminate request
    */
@@ -136,6 +154,15 @@ class BluetoothDeviceScanner : public DeviceScanner {
   bool DiscoverSmartDeviceLinkRFCOMMChannels(const bdaddr_t& device_address,
       RfcommChannelVector* discovered);
 
+  /**
+   * @brief Finds RFCOMM-channels of SDL enabled applications for set of devices,
+   * devices are queried concurrently by non-blocking SDP sessions
+   * @param device_addresses Bluetooth addresses to search on
+   * @return List of RFCOMM-channels lists
+   */
+  std::vector<RfcommChannelVector> DiscoverSmartDeviceLinkRFCOMMChannelsAsync(
+    const std::vector<bdaddr_t>& device_addresses);
+
   /**
    * @brief Summarizes the total list of devices (paired and scanned) and notifies controller
    */
@@ -151,10 +178,12 @@ class BluetoothDeviceScanner : public DeviceScanner {
    * @param bd_address List of bluetooth addresses to check
    * @param device_handle HCI handle
    * @param[out] discovered_devices List of created BluetoothDevice objects to fill
+   * @param paired true - devices are paired, so they are taken from and remembered in cache
    */
   void CheckSDLServiceOnDevices(const std::vector<bdaddr_t>& bd_address,
                                 int device_handle,
-                                DeviceVector* discovered_devices);
+                                DeviceVector* discovered_devices,
+                                bool paired);
 
   TransportAdapterController* controller_;
   threads::Thread* thread_;
@@ -176,6 +205,12 @@ class BluetoothDeviceScanner : public DeviceScanner {
 
   const bool auto_repeat_search_;
   const int auto_repeat_pause_sec_;
+  const bool async_discovery_;
+
+  /**
+   * @brief Paired devices with SDL service, accessed by scanner thread only.
+   **/
+  CachedDevices cached_devices_;
 };
 
 }  // namespace transport_adapter
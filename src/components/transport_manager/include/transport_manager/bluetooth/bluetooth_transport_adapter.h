@@ -62,6 +62,11 @@ class BluetoothTransportAdapter : public TransportAdapterImpl {
    */
   virtual DeviceType GetDeviceType() const;
 
+  /**
+   * @brief Return maximum frame size configured for transport.
+   */
+  virtual size_t GetMaximumFrameSize() const;
+
   /**
    * @brief Store adapter state in last state singleton
    */
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_REPLAY_REPLAY_CLIENT_LISTENER_H_
+#define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_REPLAY_REPLAY_CLIENT_LISTENER_H_
+
+#include <map>
+#include <string>
+
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "utils/threads/thread_delegate.h"
+#include "transport_manager/traffic_capture.h"
+#include "transport_manager/transport_adapter/client_connection_listener.h"
+#include "transport_manager/transport_adapter/device.h"
+
+namespace threads {
+class Thread;
+}  // namespace threads
+
+namespace transport_manager {
+namespace transport_adapter {
+
+class TransportAdapterController;
+class ReplayDevice;
+
+/**
+ * @brief Listener of replay transport adapter, when listening is started
+ * it reads capture file and delivers inbound frames of every captured
+ * connection over connection of its own.
+ * Outbound frames of capture are skipped, SDL answers replayed
+ * requests by itself.
+ */
+class ReplayClientListener : public ClientConnectionListener {
+ public:
+  /**
+   * @brief Constructor.
+   *
+   * @param controller Pointer to the device adapter controller.
+   * @param capture_file File written by traffic capture
+   * @param real_time If true frames are delivered with their original
+   * timing, otherwise as fast as possible
+   */
+  ReplayClientListener(TransportAdapterController* controller,
+                       const std::string& capture_file, bool real_time);
+
+  /**
+   * @brief Destructor.
+   */
+  virtual ~ReplayClientListener();
+
+  /**
+   * @brief Open capture file.
+   *
+   * @return Error information about possible reason of failure.
+   */
+  virtual TransportAdapter::Error Init();
+
+  /**
+   * @brief Stop replay.
+   */
+  virtual void Terminate();
+
+  /**
+   * @brief Check initialization.
+   *
+   * @return True if capture file is opened.
+   */
+  virtual bool IsInitialised() const;
+
+  /**
+   * @brief Start replay of capture, capture is replayed once.
+   *
+   * @return Error information about possible reason of failure.
+   */
+  virtual TransportAdapter::Error StartListening();
+
+  /**
+   * @brief Stop replay thread.
+   */
+  virtual TransportAdapter::Error StopListening();
+
+ private:
+  TransportAdapterController* controller_;
+  const std::string capture_file_;
+  const bool real_time_;
+  TrafficCaptureReader reader_;
+  bool initialised_;
+  threads::Thread* thread_;
+  // Protects stop_requested_, wait of real time replay is cut by stop
+  sync_primitives::Lock stop_lock_;
+  sync_primitives::ConditionalVariable stop_condition_;
+  bool stop_requested_;
+  DeviceSptr device_;
+  // Connection of every captured connection id
+  std::map<ConnectionUID, ApplicationHandle> applications_;
+
+  void Loop();
+  void StopLoop();
+  /**
+   * @brief Waits for time frame was captured at.
+   *
+   * @return false if replay is stopped meanwhile
+   */
+  bool WaitFrameTime(const TimevalStruct& start_time, uint64_t offset);
+  ApplicationHandle ApplicationFor(ConnectionUID captured_id);
+
+  class ReplayThreadDelegate : public threads::ThreadDelegate {
+   public:
+    explicit ReplayThreadDelegate(ReplayClientListener* parent);
+    virtual void threadMain();
+    void exitThreadMain();
+   private:
+    ReplayClientListener* parent_;
+  };
+
+  DISALLOW_COPY_AND_ASSIGN(ReplayClientListener);
+};
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
+
+#endif  // SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_REPLAY_REPLAY_CLIENT_LISTENER_H_
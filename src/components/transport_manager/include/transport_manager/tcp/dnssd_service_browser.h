@@ -41,10 +41,12 @@
 #include <avahi-common/error.h>
 #include <avahi-common/thread-watch.h>
 
+#include <map>
 #include <string>
 #include <vector>
 
 #include "utils/lock.h"
+#include "utils/date_time.h"
 #include "transport_manager/transport_adapter/device_scanner.h"
 #include "transport_manager/transport_adapter/transport_adapter.h"
 
@@ -93,9 +95,19 @@ class DnssdServiceBrowser : public DeviceScanner {
 
   void OnClientConnected();
   void OnClientFailure();
+  void OnAllForNow();
 
   DeviceVector PrepareDeviceVector() const;
 
+  // Following methods are called with mutex_ taken
+  bool ResolveFromCache(DnssdServiceRecord* service_record);
+  void PruneResolveCache();
+  /*
+   * Reports device list once browsing burst is over and
+   * no resolver is in flight, so every resolve does not rebuild it
+   */
+  void DeviceListChanged();
+
   void ServiceResolved(const DnssdServiceRecord& service_record);
   void ServiceResolveFailed(const DnssdServiceRecord& service_record);
 
@@ -124,6 +136,19 @@ class DnssdServiceBrowser : public DeviceScanner {
   typedef std::vector<DnssdServiceRecord> ServiceRecords;
   ServiceRecords service_records_;
 
+  struct CachedResolve {
+    DnssdServiceRecord service_record;
+    TimevalStruct resolve_time;
+  };
+  // Resolved services, including recently removed ones, by service key
+  typedef std::map<std::string, CachedResolve> ResolveCache;
+  ResolveCache resolve_cache_;
+  // Resolvers in flight by service key, they run in parallel
+  typedef std::map<std::string, AvahiServiceResolver*> Resolvers;
+  Resolvers resolvers_;
+  bool browsing_done_;
+  bool device_list_changed_;
+
   sync_primitives::Lock mutex_;
 
   bool initialised_;
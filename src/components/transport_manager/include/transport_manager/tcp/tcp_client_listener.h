@@ -36,6 +36,8 @@
 #ifndef SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TCP_TCP_CLIENT_LISTENER_H_
 #define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TCP_TCP_CLIENT_LISTENER_H_
 
+#include <string>
+
 #include "utils/threads/thread_delegate.h"
 #include "transport_manager/transport_adapter/client_connection_listener.h"
 
@@ -45,6 +47,7 @@ namespace transport_manager {
 namespace transport_adapter {
 
 class TransportAdapterController;
+class SocketReactor;
 
 /**
  * @brief Listener of device adapter that use TCP transport.
@@ -58,9 +61,11 @@ class TcpClientListener : public ClientConnectionListener {
    * @param port Port No.
    * @param enable_keepalive If true enables TCP keepalive on accepted
    *connections
+   * @param use_event_loop If true accepted connections are served by
+   * single reactor thread instead of thread per connection
    */
   TcpClientListener(TransportAdapterController* controller, uint16_t port,
-                    bool enable_keepalive);
+                    bool enable_keepalive, bool use_event_loop = false);
 
   /**
    * @brief Destructor.
@@ -102,11 +107,18 @@ class TcpClientListener : public ClientConnectionListener {
  private:
   const uint16_t port_;
   const bool enable_keepalive_;
+  const bool use_event_loop_;
   TransportAdapterController* controller_;
   threads::Thread* thread_;
   int socket_;
   bool thread_stop_requested_;
+  // Serves accepted connections, NULL if they have threads of their own.
+  // Deleted after connections, which are deleted by Terminate()
+  SocketReactor* reactor_;
 
+  bool Listen();
+  // Name of listening socket handed over on warm restart
+  std::string HandoffName() const;
   void Loop();
   void StopLoop();
 
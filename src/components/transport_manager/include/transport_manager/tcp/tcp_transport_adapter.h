@@ -64,6 +64,16 @@ class TcpTransportAdapter : public TransportAdapterImpl {
    */
   virtual DeviceType GetDeviceType() const;
 
+  /**
+   * @brief Return maximum frame size configured for transport.
+   */
+  virtual size_t GetMaximumFrameSize() const;
+
+  /**
+   * @brief Return time lost connection is kept for reconnect of the device.
+   */
+  virtual uint32_t GetReconnectGracePeriod() const;
+
   /**
    * @brief Store adapter state in last state singleton
    */
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRAFFIC_CAPTURE_H_
+#define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRAFFIC_CAPTURE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "transport_manager/common.h"
+#include "protocol/raw_message.h"
+#include "utils/date_time.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+/*
+ * Layout of traffic capture files.
+ * Values are stored in byte order of the writer, header carries
+ * kTrafficCaptureByteOrder so reader may detect foreign files.
+ *
+ * File:   header, then sequence of frames
+ * Header: magic[8], uint32 byte order, uint32 version
+ * Frame:  uint64 time stamp (microseconds since capture start),
+ *         uint32 connection id, uint8 direction, uint32 size, data
+ */
+namespace transport_manager {
+
+const char kTrafficCaptureMagic[8] = {'S', 'D', 'L', 'T', 'C', 'A', 'P', '1'};
+const uint32_t kTrafficCaptureByteOrder = 0x01020304;
+const uint32_t kTrafficCaptureVersion = 1;
+
+enum TrafficDirection {
+  // Received from device
+  kTrafficInbound = 0,
+  // Sent to device
+  kTrafficOutbound = 1
+};
+
+/*
+ * Frame restored from traffic capture
+ */
+struct CapturedFrame {
+  uint64_t time_stamp;
+  ConnectionUID connection_id;
+  TrafficDirection direction;
+  std::vector<uint8_t> data;
+};
+
+/*
+ * Appends raw frames passing transport manager to capture file.
+ * Frames are recorded by transport manager threads concurrently.
+ */
+class TrafficCaptureWriter {
+ public:
+  TrafficCaptureWriter();
+  ~TrafficCaptureWriter();
+
+  /*
+   * Creates capture file, time stamps of frames are counted from now
+   */
+  bool Open(const std::string& file_name);
+  void Close();
+
+  /*
+   * Cheap check transport manager does before every frame,
+   * capture is set up once at start so no lock is taken
+   */
+  bool is_open() const {
+    return file_;
+  }
+
+  /*
+   * Writes whole frame, fragmented message is written without merging
+   */
+  bool Record(TrafficDirection direction,
+              const protocol_handler::RawMessage& message);
+
+ private:
+  sync_primitives::Lock lock_;
+  FILE* volatile file_;
+  TimevalStruct start_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(TrafficCaptureWriter);
+};
+
+/*
+ * Reads traffic capture files, used by replay transport adapter
+ * and offline tools
+ */
+class TrafficCaptureReader {
+ public:
+  TrafficCaptureReader();
+  ~TrafficCaptureReader();
+
+  bool Open(const std::string& file_name);
+
+  /*
+   * Reads next frame, returns false at the end of file or on error
+   */
+  bool Next(CapturedFrame* frame);
+
+  // Not empty if reading stopped because of broken or foreign file
+  const std::string& error() const {
+    return error_;
+  }
+
+ private:
+  FILE* file_;
+  std::string error_;
+
+  DISALLOW_COPY_AND_ASSIGN(TrafficCaptureReader);
+};
+
+}  // namespace transport_manager
+
+#endif  // SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRAFFIC_CAPTURE_H_
@@ -36,6 +36,7 @@
 #define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_CONNECTION_H_
 
 #include "utils/shared_ptr.h"
+#include "utils/buffer_pool.h"
 #include "transport_manager/transport_adapter/transport_adapter.h"
 
 namespace transport_manager {
@@ -68,6 +69,12 @@ class Connection {
 
 typedef utils::SharedPtr<Connection> ConnectionSPtr;
 
+/**
+ * @brief Pool receive buffers of connections are taken from.
+ * Buffer is reused once all frames received into it are released.
+ */
+utils::BufferPool& ReceiveBufferPool();
+
 }  // namespace transport_adapter
 }  // namespace transport_manager
 #endif // SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_CONNECTION_H_
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_SOCKET_POLLER_H_
+#define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_SOCKET_POLLER_H_
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+#include "utils/macro.h"
+#include "utils/lock.h"
+
+#ifdef IO_URING_SUPPORT
+struct io_uring_sqe;
+struct io_uring_cqe;
+#endif  // IO_URING_SUPPORT
+
+namespace transport_manager {
+namespace transport_adapter {
+
+/**
+ * @brief Readiness notification backend of SocketReactor.
+ *
+ * Watch(), Unwatch() and WatchWrite() are never called concurrently
+ * with each other, while Wait() is called by reactor thread
+ * at the same time with any of them.
+ */
+class SocketPoller {
+ public:
+  virtual ~SocketPoller() {}
+
+  /**
+   * @brief Allocates poller resources.
+   *
+   * @return false if poller is not supported by the system.
+   */
+  virtual bool Init() = 0;
+
+  /**
+   * @brief Starts watching socket and notification descriptor,
+   * their readiness is reported with given id.
+   *
+   * @param notify_fd Notification descriptor, -1 if there is none.
+   * @param write_wanted If true socket is watched for writability as well.
+   */
+  virtual bool Watch(uint64_t id, int socket, int notify_fd,
+                     bool write_wanted) = 0;
+
+  /**
+   * @brief Stops watching descriptors of id. Readiness of them can still
+   * be reported by the next Wait() call.
+   */
+  virtual void Unwatch(uint64_t id) = 0;
+
+  /**
+   * @brief Updates whether socket of id is watched for writability.
+   * Called by reactor thread after every serving of id.
+   */
+  virtual void WatchWrite(uint64_t id, bool watch) = 0;
+
+  /**
+   * @brief Waits until any of watched descriptors is ready.
+   *
+   * @param ready_ids Filled with ids of ready descriptors.
+   * @return false on failure, reactor is stopped then.
+   */
+  virtual bool Wait(std::vector<uint64_t>* ready_ids) = 0;
+};
+
+#ifdef __linux__
+/**
+ * @brief Poller based on level-triggered epoll.
+ */
+class EpollSocketPoller : public SocketPoller {
+ public:
+  EpollSocketPoller();
+  ~EpollSocketPoller();
+  bool Init() OVERRIDE;
+  bool Watch(uint64_t id, int socket, int notify_fd,
+             bool write_wanted) OVERRIDE;
+  void Unwatch(uint64_t id) OVERRIDE;
+  void WatchWrite(uint64_t id, bool watch) OVERRIDE;
+  bool Wait(std::vector<uint64_t>* ready_ids) OVERRIDE;
+
+ private:
+  struct Watched {
+    int socket;
+    int notify_fd;
+    bool write_watched;
+  };
+  // Accessed by callers of Watch(), Unwatch() and WatchWrite() only
+  typedef std::map<uint64_t, Watched> WatchedMap;
+
+  int epoll_fd_;
+  WatchedMap watched_;
+
+  DISALLOW_COPY_AND_ASSIGN(EpollSocketPoller);
+};
+#endif  // __linux__
+
+#ifdef IO_URING_SUPPORT
+/**
+ * @brief Poller based on io_uring multishot poll requests.
+ *
+ * Every watched descriptor has poll request which keeps posting
+ * completions until it is removed, so nothing is rearmed after serving.
+ * Writability is polled by one-shot request armed only while socket
+ * has data to send. Requests queued by reactor thread are submitted
+ * together with waiting, i.e. by single system call.
+ */
+class IoUringSocketPoller : public SocketPoller {
+ public:
+  IoUringSocketPoller();
+  ~IoUringSocketPoller();
+  bool Init() OVERRIDE;
+  bool Watch(uint64_t id, int socket, int notify_fd,
+             bool write_wanted) OVERRIDE;
+  void Unwatch(uint64_t id) OVERRIDE;
+  void WatchWrite(uint64_t id, bool watch) OVERRIDE;
+  bool Wait(std::vector<uint64_t>* ready_ids) OVERRIDE;
+
+ private:
+  // Request kind, stored in lowest bits of its user data next to id
+  enum Request {
+    kReadRequest = 0,
+    kNotifyRequest = 1,
+    kWriteRequest = 2
+  };
+  struct Watched {
+    int socket;
+    int notify_fd;
+    bool write_wanted;
+    // One-shot write request is not completed yet
+    bool write_armed;
+  };
+  typedef std::map<uint64_t, Watched> WatchedMap;
+
+  // Following require lock_ to be taken
+  bool Poll(int fd, uint32_t events, uint64_t id, Request request,
+            bool multishot);
+  bool RemovePoll(uint64_t id, Request request);
+  // Removes all requests of watched entry and erases it
+  void RemoveRequests(WatchedMap::iterator it);
+  io_uring_sqe* NextSqe();
+  void CommitSqe();
+  bool Submit();
+  void OnCompletion(const io_uring_cqe& cqe,
+                    std::vector<uint64_t>* ready_ids);
+
+  int ring_fd_;
+  void* ring_;
+  size_t ring_size_;
+  io_uring_sqe* sqes_;
+  size_t sqes_size_;
+  // Ring fields shared with kernel
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned sq_mask_;
+  unsigned sq_entries_;
+  unsigned* sq_array_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  io_uring_cqe* cqes_;
+  // Queued requests not handed over to kernel yet
+  unsigned unsubmitted_;
+  WatchedMap watched_;
+  // Protects submission queue and watched_
+  sync_primitives::Lock lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(IoUringSocketPoller);
+};
+#endif  // IO_URING_SUPPORT
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
+
+#endif  // SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_SOCKET_POLLER_H_
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_SOCKET_REACTOR_H_
+#define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_SOCKET_REACTOR_H_
+
+#include <stdint.h>
+#include <map>
+
+#include "utils/macro.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace threads {
+class Thread;
+}  // namespace threads
+
+namespace transport_manager {
+namespace transport_adapter {
+
+class SocketPoller;
+
+/**
+ * @brief Event loop serving many socket connections by single thread.
+ *
+ * Every handler is watched by two descriptors: its socket and
+ * notification descriptor other threads make readable to wake handler up.
+ * Handler is always served by reactor thread only, so it needs no locking
+ * of data it shares with nobody but reactor.
+ * Readiness is got from io_uring if it is built with IO_URING_SUPPORT
+ * and provided by the kernel, from epoll otherwise. On other platforms
+ * Start() fails and connections are supposed to get threads of their own.
+ */
+class SocketReactor {
+ public:
+  class Handler {
+   public:
+    /**
+     * @brief Called on reactor thread when any of descriptors is ready.
+     *
+     * @return false if handler is finished and has to be removed.
+     */
+    virtual bool OnReady() = 0;
+
+    /**
+     * @brief Tells if handler waits for socket to become writable.
+     */
+    virtual bool IsWriteWanted() const = 0;
+
+    /**
+     * @brief Called on reactor thread after OnReady() returned false
+     * and handler descriptors are not watched anymore.
+     */
+    virtual void OnRemoved() = 0;
+
+   protected:
+    virtual ~Handler() {}
+  };
+
+  SocketReactor();
+
+  /**
+   * @brief Destructor. Stops reactor, handlers which are still added
+   * are not served anymore.
+   */
+  ~SocketReactor();
+
+  /**
+   * @brief Starts reactor thread.
+   *
+   * @return true on success, false if reactor is not supported or failed.
+   */
+  bool Start();
+
+  /**
+   * @brief Starts watching handler descriptors. Thread-safe.
+   *
+   * @return true on success.
+   */
+  bool Add(Handler* handler, int socket, int notify_fd);
+
+  /**
+   * @brief Stops watching handler descriptors. Thread-safe.
+   * Waits if handler is being served at the moment. Must not be called
+   * from handler callbacks.
+   *
+   * @return true if handler was removed, false if it was not added
+   * or has already finished by itself (OnRemoved() was called).
+   */
+  bool Remove(Handler* handler);
+
+ private:
+  struct Entry {
+    Handler* handler;
+    // Handler is being served by reactor thread
+    bool busy;
+  };
+  // Entries are addressed by id, so events got for removed handler
+  // within the same wait are just ignored
+  typedef std::map<uint64_t, Entry> Entries;
+
+  class ReactorDelegate : public threads::ThreadDelegate {
+   public:
+    explicit ReactorDelegate(SocketReactor* reactor);
+    void threadMain() OVERRIDE;
+    void exitThreadMain() OVERRIDE;
+   private:
+    SocketReactor* reactor_;
+  };
+
+  void Loop();
+  void Stop();
+  void Serve(uint64_t id);
+  Entries::iterator Find(Handler* handler);
+
+  // Called under entries_lock_ besides Wait() of reactor thread
+  SocketPoller* poller_;
+  // Pipe reactor thread is woken up by to stop
+  int stop_read_fd_;
+  int stop_write_fd_;
+  bool stop_requested_;
+  uint64_t last_id_;
+  Entries entries_;
+  sync_primitives::Lock entries_lock_;
+  // Signaled every time reactor finishes serving handler
+  sync_primitives::ConditionalVariable entry_released_;
+  threads::Thread* thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(SocketReactor);
+};
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
+
+#endif  // SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_SOCKET_REACTOR_H_
@@ -36,12 +36,16 @@
 #define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_THREADED_SOCKET_CONNECTION_H_
 
 #include <poll.h>
-#include <queue>
+
+#include <deque>
 
 #include "transport_manager/transport_adapter/connection.h"
+#include "transport_manager/transport_adapter/socket_reactor.h"
 #include "protocol/common.h"
 #include "utils/threads/thread_delegate.h"
 #include "utils/lock.h"
+#include "utils/buffer_slice.h"
+#include "utils/deficit_round_robin_queue.h"
 
 using ::transport_manager::transport_adapter::Connection;
 
@@ -87,6 +91,14 @@ class ThreadedSocketConnection : public Connection {
     socket_ = socket;
   }
 
+  /**
+   * @brief Makes connection served by reactor instead of own thread.
+   * Has to be set before Start(), reactor has to outlive connection.
+   */
+  void set_reactor(SocketReactor* reactor) {
+    reactor_ = reactor;
+  }
+
  protected:
   /**
    * @brief Constructor.
@@ -137,23 +149,81 @@ class ThreadedSocketConnection : public Connection {
     ThreadedSocketConnection* connection_;
   };
 
+  class ReactorHandler : public SocketReactor::Handler {
+   public:
+    explicit ReactorHandler(ThreadedSocketConnection* connection);
+    bool OnReady() OVERRIDE;
+    bool IsWriteWanted() const OVERRIDE;
+    void OnRemoved() OVERRIDE;
+   private:
+    ThreadedSocketConnection* connection_;
+  };
+
   int read_fd_;
   int write_fd_;
   void threadMain();
-  void Transmit();
+  /**
+   * @brief Notifies controller about connection and establishes it.
+   */
+  void Setup();
+  /**
+   * @brief Waits for socket events up to poll_timeout milliseconds
+   * (infinitely if negative) and handles them.
+   */
+  void Transmit(int poll_timeout);
+  /**
+   * @brief Finalizes connection and fails frames which were not sent.
+   */
+  void Finish();
+  bool IsSendPending() const;
   void Finalize();
   TransportAdapter::Error Notify() const;
   bool Receive();
+  /**
+   * @brief Passes first bytes of receive buffer on as a received frame
+   * and leaves the rest of buffer for next reads.
+   **/
+  void ReceiveDone(size_t bytes_received);
   bool Send();
   void Abort();
 
   TransportAdapterController* controller_;
+  /**
+   * @brief Frame scheduled for sending: control and RPC frames go first,
+   * streaming services share connection fairly.
+   **/
+  struct Frame : public protocol_handler::RawMessagePtr {
+    explicit Frame(const protocol_handler::RawMessagePtr& message)
+      : protocol_handler::RawMessagePtr(message) {}
+    // DeficitRoundRobinQueue requires following methods to schedule frames
+    bool IsUrgent() const;
+    uint64_t FlowId() const;
+    size_t Cost() const;
+  };
   /**
    * @brief Frames that must be sent to remote device.
    **/
-  typedef std::queue<protocol_handler::RawMessagePtr> FrameQueue;
+  typedef utils::DeficitRoundRobinQueue<Frame> FrameQueue;
   FrameQueue frames_to_send_;
   mutable sync_primitives::Lock frames_to_send_mutex_;
+  /**
+   * @brief Frames taken from scheduler and being sent,
+   * first one may be sent partially by sent_offset_ bytes.
+   * Accessed by transmitting thread only.
+   **/
+  std::deque< ::protocol_handler::RawMessagePtr> frames_in_flight_;
+  size_t sent_offset_;
+  /**
+   * @brief Unused part of storage the next recv() is made into, received
+   * frames reference it instead of copying, so it is consumed by frames
+   * and replaced when it is exhausted.
+   **/
+  utils::BufferSlice receive_buffer_;
+  /**
+   * @brief Size of next allocated receive buffer, adapts to amount of data
+   * read per wakeup.
+   **/
+  size_t receive_buffer_size_;
 
   int socket_;
   bool terminate_flag_;
@@ -161,6 +231,9 @@ class ThreadedSocketConnection : public Connection {
   const DeviceUID device_uid_;
   const ApplicationHandle app_handle_;
   threads::Thread* thread_;
+  SocketReactor* reactor_;
+  ReactorHandler reactor_handler_;
+  bool setup_done_;
 };
 }  // namespace transport_adapter
 }  // namespace transport_manager
@@ -397,6 +397,18 @@ class TransportAdapterImpl : public TransportAdapter,
    */
   virtual std::string GetConnectionType() const;
 
+  /**
+   * @brief Allows to obtain maximum size of protocol frame for transport.
+   * @return 0, i.e. protocol default is used.
+   */
+  virtual size_t GetMaximumFrameSize() const;
+
+  /**
+   * @brief Allows to obtain time lost connection is kept for reconnect.
+   * @return 0, i.e. connection is closed as soon as link is lost.
+   */
+  virtual uint32_t GetReconnectGracePeriod() const;
+
 #ifdef TIME_TESTER
   /**
    * @brief Setup observer for time metric.
@@ -41,21 +41,51 @@
 #include <algorithm>
 
 #include "utils/timer_thread.h"
+#include "utils/lock.h"
 #include "utils/rwlock.h"
+#include "utils/shared_ptr.h"
 
 #include "transport_manager/transport_manager.h"
 #include "transport_manager/transport_manager_listener.h"
 #include "transport_manager/transport_adapter/transport_adapter_listener_impl.h"
+#include "transport_manager/traffic_capture.h"
 #include "protocol/common.h"
 #ifdef TIME_TESTER
 #include "transport_manager/time_metric_observer.h"
 #endif  // TIME_TESTER
 #include "utils/threads/message_loop_thread.h"
+#include "utils/deficit_round_robin_queue.h"
 #include "transport_manager/transport_adapter/transport_adapter_event.h"
 
 namespace transport_manager {
 
-typedef threads::MessageLoopThread<std::queue<protocol_handler::RawMessagePtr> >
+/**
+ * @brief Frame posted for sending, connections share sending in proportion
+ * to their weights.
+ **/
+struct OutgoingFrame : public protocol_handler::RawMessagePtr {
+  OutgoingFrame(const protocol_handler::RawMessagePtr& message,
+                uint32_t send_weight)
+    : protocol_handler::RawMessagePtr(message),
+      weight(send_weight) {}
+  // DeficitRoundRobinQueue requires following methods to schedule frames
+  bool IsUrgent() const {
+    return false;
+  }
+  uint64_t FlowId() const {
+    return get()->connection_key();
+  }
+  size_t Cost() const {
+    return get()->data_size();
+  }
+  uint32_t Weight() const {
+    return weight;
+  }
+  uint32_t weight;
+};
+
+typedef threads::MessageLoopThread<
+  utils::DeficitRoundRobinQueue<OutgoingFrame, utils::MessageFlowWeights> >
   RawMessageLoopThread;
 typedef threads::MessageLoopThread<std::queue<TransportAdapterEvent> >
   TransportAdapterEventLoopThread;
@@ -86,6 +116,15 @@ class TransportManagerImpl : public TransportManager,
     bool shutDown;
     DeviceHandle device_handle_;
     int messages_count;
+    // Share of connection in sending of frames
+    uint32_t send_weight;
+    // Transport link is lost and connection waits for device to reconnect
+    bool standby;
+    volatile bool standby_expired;
+    TimerInternalSharedPointer standby_timer;
+    // Messages sent while link is lost, they are flushed to the new link
+    sync_primitives::Lock standby_messages_lock;
+    std::vector< ::protocol_handler::RawMessagePtr> standby_messages;
 
     ConnectionInternal(TransportManagerImpl* transport_manager,
                        TransportAdapter* transport_adapter,
@@ -93,6 +132,7 @@ class TransportManagerImpl : public TransportManager,
                        const ApplicationHandle& app_id,
                        const DeviceHandle& device_handle);
     void DisconnectFailedRoutine();
+    void StandbyExpiredRoutine();
   };
  public:
   /**
@@ -212,10 +252,12 @@ class TransportManagerImpl : public TransportManager,
   virtual int Visibility(const bool& on_off) const;
 
   /**
-   * @brief Updates total device list with info from specific transport adapter.
+   * @brief Updates total device list with info from specific transport adapter,
+   * raises events for every added, removed or changed device.
    * @param ta Transport adapter
+   * @return true if any device of adapter was added, removed or changed
    */
-  void UpdateDeviceList(TransportAdapter* ta);
+  bool UpdateDeviceList(TransportAdapter* ta);
 
 #ifdef TIME_TESTER
   /**
@@ -234,7 +276,7 @@ class TransportManagerImpl : public TransportManager,
 
  protected:
   template <class Proc, class... Args>
-  void RaiseEvent(Proc proc, Args... args) {
+  void RaiseEvent(Proc proc, const Args&... args) {
     for (TransportManagerListenerList::iterator it =
              transport_manager_listener_.begin();
          it != transport_manager_listener_.end(); ++it) {
@@ -246,11 +288,20 @@ class TransportManagerImpl : public TransportManager,
    * @brief Put massage in the container of massages.
    *
    * @param message Smart pointer to the raw massage.
+   * @param send_weight Share of message connection in sending.
    **/
-  void PostMessage(const ::protocol_handler::RawMessagePtr message);
+  void PostMessage(const ::protocol_handler::RawMessagePtr message,
+                   uint32_t send_weight);
 
-  void Handle(::protocol_handler::RawMessagePtr msg);
+  void Handle(const OutgoingFrame frame);
   void Handle(TransportAdapterEvent msg);
+  void HandleBatch(std::queue<TransportAdapterEvent>* events);
+
+  /**
+   * @brief Passes messages received since last call to listeners at once.
+   * Called from event loop thread only.
+   **/
+  void RaiseReceivedMessages();
 
   /**
    * @brief Post event to the container of events.
@@ -325,7 +376,17 @@ class TransportManagerImpl : public TransportManager,
   explicit TransportManagerImpl(const TransportManagerImpl&);
   int connection_id_counter_;
   sync_primitives::RWLock connections_lock_;
-  std::vector<ConnectionInternal> connections_;
+  /**
+   * Connections are allocated once and never moved, so their addresses
+   * (used by disconnect timers) stay valid until removal
+   */
+  typedef utils::SharedPtr<ConnectionInternal> ConnectionInternalSPtr;
+  typedef std::map<ConnectionUID, ConnectionInternalSPtr> ConnectionMap;
+  typedef std::pair<DeviceUID, ApplicationHandle> DeviceApplicationPair;
+  typedef std::map<DeviceApplicationPair, ConnectionInternal*>
+      DeviceApplicationIndex;
+  ConnectionMap connections_;
+  DeviceApplicationIndex connections_index_;
   sync_primitives::RWLock device_to_adapter_map_lock_;
   typedef std::map<DeviceUID, TransportAdapter*> DeviceToAdapterMap;
   DeviceToAdapterMap device_to_adapter_map_;
@@ -335,31 +396,41 @@ class TransportManagerImpl : public TransportManager,
       transport_adapter_listeners_;
   RawMessageLoopThread message_queue_;
   TransportAdapterEventLoopThread event_queue_;
+  // ON_RECEIVED_DONE events of currently handled batch
+  std::vector<TransportAdapterEvent> received_events_;
+  // Records frames passing transport manager if capture is configured
+  TrafficCaptureWriter traffic_capture_;
 
   typedef std::vector<std::pair<const TransportAdapter*, DeviceInfo> >
   DeviceInfoList;
   sync_primitives::RWLock device_list_lock_;
   DeviceInfoList device_list_;
 
-  void AddConnection(const ConnectionInternal& c);
+  /**
+   * @brief Takes ownership of connection and indexes it by both
+   * connection id and device/application pair
+   */
+  void AddConnection(ConnectionInternal* c);
   void RemoveConnection(uint32_t id);
   ConnectionInternal* GetConnection(const ConnectionUID& id);
   ConnectionInternal* GetConnection(const DeviceUID& device,
                                     const ApplicationHandle& application);
 
-  void AddDataToContainer(
-      ConnectionUID id,
-      std::map<ConnectionUID, std::pair<unsigned int, unsigned char*> >&
-          container,
-      unsigned char* data, unsigned int data_size);
-  bool GetFrameSize(unsigned char* data, unsigned int data_size,
-                    unsigned int& frame_size);
-  bool GetFrame(std::map<ConnectionUID,
-                std::pair<unsigned int, unsigned char*> >& container,
-                ConnectionUID id, unsigned int frame_size,
-                unsigned char** frame);
-
   void OnDeviceListUpdated(TransportAdapter* ta);
+
+  /**
+   * @brief Keeps connection of lost link for reconnect if its adapter
+   * allows it. Should be called under connections_lock_ taken for writing.
+   * @return true if connection is put to standby
+   */
+  bool StartStandby(ConnectionInternal* connection);
+
+  /**
+   * @brief Binds standby connection of the device to its new link.
+   * @return true if connection is restored, false if there was no
+   * standby connection for the device
+   */
+  bool RestoreConnection(const TransportAdapterEvent& event);
   void DisconnectAllDevices();
   void TerminateAllAdapters();
   int InitAllAdapters();
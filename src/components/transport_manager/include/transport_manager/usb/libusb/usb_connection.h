@@ -34,8 +34,11 @@
 #define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_USB_LIBUSB_USB_CONNECTION_H_
 
 #include <list>
+#include <vector>
 
 #include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/buffer_slice.h"
 
 #include "transport_manager/transport_adapter/transport_adapter_controller.h"
 #include "transport_manager/transport_adapter/connection.h"
@@ -58,9 +61,43 @@ class UsbConnection : public Connection {
   virtual TransportAdapter::Error Disconnect();
 
  private:
-  void PopOutMessage();
-  bool PostInTransfer();
-  bool PostOutTransfer();
+  /*
+   * Transfer reading into its own region of receive buffer,
+   * region is reused by next reads until received messages took it
+   */
+  struct InTransfer {
+    InTransfer()
+      : transfer(NULL),
+        submitted(false) {
+    }
+    libusb_transfer* transfer;
+    utils::BufferSlice buffer;
+    bool submitted;
+  };
+  /*
+   * Transfer writing message, message is kept until transfer is finished
+   */
+  struct OutTransfer {
+    OutTransfer(libusb_transfer* transfer,
+                ::protocol_handler::RawMessagePtr message)
+      : transfer(transfer),
+        message(message) {
+    }
+    libusb_transfer* transfer;
+    ::protocol_handler::RawMessagePtr message;
+  };
+  typedef std::vector<InTransfer> InTransfers;
+  typedef std::list<OutTransfer> OutTransfers;
+
+  // Following methods are called with transfers_lock_ taken
+  bool PostInTransfer(InTransfer* in_transfer);
+  bool PostOutTransfers();
+  void CancelTransfers();
+  void FailOutMessages();
+  void RequestAbort();
+  bool HasPendingTransfers() const;
+  bool TransfersFinished();
+
   void OnInTransfer(struct libusb_transfer*);
   void OnOutTransfer(struct libusb_transfer*);
   void Finalise();
@@ -77,17 +114,18 @@ class UsbConnection : public Connection {
   uint16_t in_endpoint_max_packet_size_;
   uint8_t out_endpoint_;
   uint16_t out_endpoint_max_packet_size_;
-  unsigned char* in_buffer_;
-  libusb_transfer* in_transfer_;
-  libusb_transfer* out_transfer_;
+  // Count of transfers submitted at once for each direction
+  const size_t transfers_count_;
+  size_t in_transfer_size_;
+  InTransfers in_transfers_;
+  std::vector<libusb_transfer*> free_out_transfers_;
+  OutTransfers submitted_out_transfers_;
 
   std::list<protocol_handler::RawMessagePtr> out_messages_;
-  protocol_handler::RawMessagePtr current_out_message_;
-  sync_primitives::Lock out_messages_mutex_;
-  size_t bytes_sent_;
+  sync_primitives::Lock transfers_lock_;
+  sync_primitives::ConditionalVariable transfers_finished_;
   bool disconnecting_;
-  bool waiting_in_transfer_cancel_;
-  bool waiting_out_transfer_cancel_;
+  bool aborting_;
   friend void InTransferCallback(struct libusb_transfer*);
   friend void OutTransferCallback(struct libusb_transfer*);
 };
@@ -36,7 +36,12 @@
 #ifndef SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_USB_QNX_USB_CONNECTION_H_
 #define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_USB_QNX_USB_CONNECTION_H_
 
+#include <deque>
+#include <list>
+#include <vector>
+
 #include "utils/lock.h"
+#include "utils/conditional_variable.h"
 
 #include "transport_manager/transport_adapter/transport_adapter_controller.h"
 #include "transport_manager/transport_adapter/connection.h"
@@ -46,7 +51,6 @@ namespace transport_manager {
 namespace transport_adapter {
 
 class UsbConnection : public Connection {
-  static const uint32_t kInBufferSize = 2048;
  public:
   UsbConnection(const DeviceUID& device_uid,
                 const ApplicationHandle& app_handle,
@@ -61,15 +65,65 @@ class UsbConnection : public Connection {
   virtual TransportAdapter::Error SendData(::protocol_handler::RawMessagePtr message);
   virtual TransportAdapter::Error Disconnect();
  private:
+  /*
+   * Urb reading into its own buffer, buffer is allocated once
+   * and reused by every read of the urb
+   */
+  struct InTransfer {
+    InTransfer()
+      : urb(NULL),
+        buffer(NULL),
+        submitted(false),
+        completed(false),
+        succeeded(false),
+        length(0) {
+    }
+    usbd_urb* urb;
+    unsigned char* buffer;
+    bool submitted;
+    // Set by callback, cleared when urb is delivered in submission order
+    bool completed;
+    bool succeeded;
+    uint32_t length;
+  };
+  /*
+   * Urb writing chunk of message copied into its own buffer,
+   * buffer is allocated once and reused by every write of the urb
+   */
+  struct OutTransfer {
+    OutTransfer()
+      : urb(NULL),
+        buffer(NULL),
+        size(0),
+        last(false) {
+    }
+    usbd_urb* urb;
+    void* buffer;
+    ::protocol_handler::RawMessagePtr message;
+    uint32_t size;
+    // Chunk completes message
+    bool last;
+  };
+  typedef std::vector<InTransfer> InTransfers;
+  typedef std::vector<OutTransfer> OutTransfers;
+
   friend void InTransferCallback(usbd_urb* urb, usbd_pipe*, void*);
   friend void OutTransferCallback(usbd_urb* urb, usbd_pipe*, void*);
   bool OpenEndpoints();
-  void PopOutMessage();
-  bool PostInTransfer();
-  bool PostOutTransfer();
+
+  // Following methods are called with transfers_lock_ taken
+  bool PostInTransfer(InTransfer* in_transfer);
+  bool PostOutTransfers();
+  void DropOutMessage(const ::protocol_handler::RawMessagePtr message);
+  void FailOutMessages();
+  void RequestAbort();
+  bool HasPendingTransfers() const;
+  bool TransfersFinished();
+
   void OnInTransfer(usbd_urb* urb);
   void OnOutTransfer(usbd_urb* urb);
   void Finalise();
+  void AbortConnection();
 
   const DeviceUID device_uid_;
   const ApplicationHandle app_handle_;
@@ -80,19 +134,24 @@ class UsbConnection : public Connection {
   usbd_pipe* in_pipe_;
   usbd_pipe* out_pipe_;
 
-  unsigned char* in_buffer_;
-  void* out_buffer_;
-
-  usbd_urb* in_urb_;
-  usbd_urb* out_urb_;
+  // Count of urbs submitted at once for each direction
+  const size_t transfers_count_;
+  InTransfers in_transfers_;
+  // Submitted incoming urbs in order of submission
+  std::deque<InTransfer*> submitted_in_transfers_;
+  // Completed reads are being passed on by some callback
+  bool delivering_in_;
+  OutTransfers out_transfers_;
+  std::vector<OutTransfer*> free_out_transfers_;
+  size_t submitted_out_transfers_count_;
 
   std::list<protocol_handler::RawMessagePtr> out_messages_;
-  ::protocol_handler::RawMessagePtr current_out_message_;
-  sync_primitives::Lock out_messages_mutex_;
-  size_t bytes_sent_;
+  // Bytes of front of out_messages_ already submitted
+  size_t bytes_submitted_;
+  sync_primitives::Lock transfers_lock_;
+  sync_primitives::ConditionalVariable transfers_finished_;
   bool disconnecting_;
-  bool pending_in_transfer_;
-  bool pending_out_transfer_;
+  bool aborting_;
 };
 
 }  // namespace transport_adapter
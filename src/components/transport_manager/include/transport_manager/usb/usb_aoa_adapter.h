@@ -49,6 +49,11 @@ class UsbAoaAdapter : public TransportAdapterImpl {
 
  protected:
   virtual DeviceType GetDeviceType() const;
+
+  /**
+   * @brief Return maximum frame size configured for transport.
+   */
+  virtual size_t GetMaximumFrameSize() const;
   virtual bool IsInitialised() const;
   virtual TransportAdapter::Error Init();
   virtual bool ToBeAutoConnected(DeviceSptr device) const;
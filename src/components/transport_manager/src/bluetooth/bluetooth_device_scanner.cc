@@ -42,12 +42,14 @@
 #include <bluetooth/sdp_lib.h>
 #include <bluetooth/rfcomm.h>
 #include <errno.h>
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <unistd.h>
 #include <vector>
 #include <sstream>
+#include <algorithm>
 #include "transport_manager/bluetooth/bluetooth_transport_adapter.h"
 #include "transport_manager/bluetooth/bluetooth_device.h"
 
@@ -99,11 +101,236 @@ int FindPairedDevs(std::vector<bdaddr_t>* result) {
   LOG4CXX_TRACE(logger_, "exit with 0");
   return 0;
 }
+
+// Paired device is reported by cached SDL service that long,
+// then it is queried again to find out if it is still there
+const int64_t kCachedDeviceLifetimeMs = 5 * 60 * 1000;
+// Asynchronous SDP query of a device is given up after that,
+// page timeout of device out of range is about 5 seconds
+const int64_t kSdpQueryTimeoutMs = 10 * 1000;
+// Scanner thread checks for shutdown request at least that often
+const int kSdpPollTimeoutMs = 500;
+
+// Device or local adapter is busy, query is worth another attempt
+bool IsSdpRetryError(int error) {
+  return EMLINK == error || EBUSY == error ||
+         EUCLEAN == error || EALREADY == error;
+}
+
+void FindRfcommChannels(sdp_record_t* sdp_record,
+                        RfcommChannelVector* channels) {
+  sdp_list_t* proto_list = 0;
+
+  if (0 == sdp_get_access_protos(sdp_record, &proto_list)) {
+    for (sdp_list_t* p = proto_list; 0 != p; p = p->next) {
+      sdp_list_t* pdsList = static_cast<sdp_list_t*>(p->data);
+
+      for (sdp_list_t* pds = pdsList; 0 != pds; pds = pds->next) {
+        sdp_data_t* sdpData = static_cast<sdp_data_t*>(pds->data);
+        int proto = 0;
+
+        for (sdp_data_t* d = sdpData; 0 != d; d = d->next) {
+          switch (d->dtd) {
+            case SDP_UUID16:
+            case SDP_UUID32:
+            case SDP_UUID128:
+              proto = sdp_uuid_to_proto(&d->val.uuid);
+              break;
+
+            case SDP_UINT8:
+              if (RFCOMM_UUID == proto) {
+                channels->push_back(d->val.uint8);
+              }
+              break;
+          }
+        }
+      }
+
+      sdp_list_free(pdsList, 0);
+    }
+
+    sdp_list_free(proto_list, 0);
+  }
+}
+
+void LogRfcommChannels(const bdaddr_t& device_address,
+                       const RfcommChannelVector& channels) {
+  if (!channels.empty()) {
+    LOG4CXX_INFO(logger_, "channels not empty");
+    std::stringstream rfcomm_channels_string;
+
+    for (RfcommChannelVector::const_iterator it = channels.begin();
+         it != channels.end(); ++it) {
+      if (it != channels.begin()) {
+        rfcomm_channels_string << ", ";
+      }
+      rfcomm_channels_string << static_cast<uint32_t>(*it);
+    }
+
+    LOG4CXX_INFO(logger_,
+                 "SmartDeviceLink service was discovered on device "
+                 << BluetoothDevice::GetUniqueDeviceId(device_address)
+                 << " at channel(s): " << rfcomm_channels_string.str().c_str());
+  } else {
+    LOG4CXX_INFO(logger_,
+                 "SmartDeviceLink service was not discovered on device "
+                 << BluetoothDevice::GetUniqueDeviceId(device_address));
+  }
+}
+
+/*
+ * SDP query of single device made by non-blocking session,
+ * so scanner thread waits for several devices at once.
+ * Session is connected first, then search request is sent
+ * and response is collected by sdp_process().
+ */
+class SdpQuery {
+ public:
+  enum State {
+    kConnecting,
+    kSearching,
+    kDone,
+    kRetry
+  };
+
+  SdpQuery(const bdaddr_t& address, uuid_t* service_uuid,
+           RfcommChannelVector* channels)
+    : address_(address),
+      service_uuid_(service_uuid),
+      channels_(channels),
+      session_(NULL),
+      state_(kDone),
+      start_time_(date_time::DateTime::getCurrentTime()) {
+  }
+
+  ~SdpQuery() {
+    if (session_) {
+      sdp_close(session_);
+    }
+  }
+
+  void Start() {
+    static bdaddr_t any_address = { { 0, 0, 0, 0, 0, 0 } };
+    session_ = sdp_connect(&any_address, &address_, SDP_NON_BLOCKING);
+    if (NULL == session_) {
+      state_ = IsSdpRetryError(errno) ? kRetry : kDone;
+      return;
+    }
+    state_ = kConnecting;
+  }
+
+  bool finished() const {
+    return kDone == state_ || kRetry == state_;
+  }
+
+  bool retry() const {
+    return kRetry == state_;
+  }
+
+  bool IsExpired() const {
+    return date_time::DateTime::calculateTimeSpan(start_time_) >=
+           kSdpQueryTimeoutMs;
+  }
+
+  void Expire() {
+    LOG4CXX_WARN(logger_, "SDP query timed out on device "
+                 << BluetoothDevice::GetUniqueDeviceId(address_));
+    state_ = kDone;
+  }
+
+  int socket() const {
+    return sdp_get_socket(session_);
+  }
+
+  short events() const {
+    return kConnecting == state_ ? POLLOUT : POLLIN;
+  }
+
+  void Process() {
+    if (kConnecting == state_) {
+      OnConnected();
+    } else if (kSearching == state_ && 0 != sdp_process(session_)) {
+      LOG4CXX_WARN(logger_, "SDP query failed on device "
+                   << BluetoothDevice::GetUniqueDeviceId(address_));
+      state_ = kDone;
+    }
+  }
+
+ private:
+  void OnConnected() {
+    int error = 0;
+    socklen_t error_size = sizeof(error);
+    if (0 != getsockopt(socket(), SOL_SOCKET, SO_ERROR, &error, &error_size)) {
+      error = errno;
+    }
+    if (0 != error) {
+      state_ = IsSdpRetryError(error) ? kRetry : kDone;
+      return;
+    }
+    sdp_list_t* search_list = sdp_list_append(0, service_uuid_);
+    uint32_t range = 0x0000ffff;
+    sdp_list_t* attr_list = sdp_list_append(0, &range);
+    state_ = kSearching;
+    if (0 != sdp_set_notify(session_, &SdpQuery::OnResponse, this) ||
+        0 != sdp_service_search_attr_async(session_, search_list,
+                                           SDP_ATTR_REQ_RANGE, attr_list)) {
+      LOG4CXX_WARN(logger_, "SDP search request failed on device "
+                   << BluetoothDevice::GetUniqueDeviceId(address_));
+      state_ = kDone;
+    }
+    sdp_list_free(search_list, 0);
+    sdp_list_free(attr_list, 0);
+  }
+
+  static void OnResponse(uint8_t type, uint16_t status, uint8_t* rsp,
+                         size_t size, void* udata) {
+    SdpQuery* query = static_cast<SdpQuery*>(udata);
+    query->state_ = kDone;
+    if (SDP_SVC_SEARCH_ATTR_RSP != type || 0 != status) {
+      LOG4CXX_WARN(logger_, "SDP search failed on device "
+                   << BluetoothDevice::GetUniqueDeviceId(query->address_)
+                   << ", status " << status);
+      return;
+    }
+    // Response is sequence of service records
+    uint8_t data_type = 0;
+    int sequence_size = 0;
+    const int scanned = sdp_extract_seqtype(rsp, size, &data_type,
+                                            &sequence_size);
+    if (scanned <= 0) {
+      return;
+    }
+    rsp += scanned;
+    int bytes_left = std::min(sequence_size, static_cast<int>(size) - scanned);
+    while (bytes_left > 0) {
+      int record_size = 0;
+      sdp_record_t* sdp_record = sdp_extract_pdu(rsp, bytes_left, &record_size);
+      if (NULL == sdp_record) {
+        break;
+      }
+      FindRfcommChannels(sdp_record, query->channels_);
+      sdp_record_free(sdp_record);
+      if (record_size <= 0) {
+        break;
+      }
+      rsp += record_size;
+      bytes_left -= record_size;
+    }
+  }
+
+  const bdaddr_t address_;
+  uuid_t* service_uuid_;
+  RfcommChannelVector* channels_;
+  sdp_session_t* session_;
+  State state_;
+  const TimevalStruct start_time_;
+  DISALLOW_COPY_AND_ASSIGN(SdpQuery);
+};
 }  //  namespace
 
 BluetoothDeviceScanner::BluetoothDeviceScanner(
   TransportAdapterController* controller, bool auto_repeat_search,
-  int auto_repeat_pause_sec)
+  int auto_repeat_pause_sec, bool async_discovery)
   : controller_(controller),
     thread_(NULL),
     shutdown_requested_(false),
@@ -112,7 +339,8 @@ BluetoothDeviceScanner::BluetoothDeviceScanner(
     device_scan_requested_lock_(),
     device_scan_requested_cv_(),
     auto_repeat_search_(auto_repeat_search),
-    auto_repeat_pause_sec_(auto_repeat_pause_sec) {
+    auto_repeat_pause_sec_(auto_repeat_pause_sec),
+    async_discovery_(async_discovery) {
   uint8_t smart_device_link_service_uuid_data[] = { 0x93, 0x6D, 0xA0, 0x1F,
                                                     0x9A, 0xBD, 0x4D, 0x9D, 0x80, 0xC7, 0x02, 0xAF, 0x85, 0xC8, 0x22, 0xA8
                                                   };
@@ -173,7 +401,7 @@ void BluetoothDeviceScanner::DoInquiry() {
 
   paired_devices_with_sdl_.clear();
   CheckSDLServiceOnDevices(paired_devices_, device_handle,
-                           &paired_devices_with_sdl_);
+                           &paired_devices_with_sdl_, true);
   UpdateTotalDeviceList();
 
   LOG4CXX_INFO(logger_, "Starting hci_inquiry on device " << device_id);
@@ -194,7 +422,7 @@ void BluetoothDeviceScanner::DoInquiry() {
     }
     found_devices_with_sdl_.clear();
     CheckSDLServiceOnDevices(found_devices, device_handle,
-                             &found_devices_with_sdl_);
+                             &found_devices_with_sdl_, false);
   }
   UpdateTotalDeviceList();
   controller_->FindNewApplicationsRequest();
@@ -210,18 +438,43 @@ void BluetoothDeviceScanner::DoInquiry() {
 
 void BluetoothDeviceScanner::CheckSDLServiceOnDevices(
   const std::vector<bdaddr_t>& bd_addresses, int device_handle,
-  DeviceVector* discovered_devices) {
+  DeviceVector* discovered_devices, bool paired) {
   LOG4CXX_TRACE(logger_, "enter. bd_addresses: " << &bd_addresses << ", device_handle: " <<
                 device_handle << ", discovered_devices: " << discovered_devices);
-  std::vector<RfcommChannelVector> sdl_rfcomm_channels =
-    DiscoverSmartDeviceLinkRFCOMMChannels(bd_addresses);
-
+  // Paired devices found recently are not queried again,
+  // so their applications are connected without waiting for SDP
+  std::vector<bdaddr_t> queried_addresses;
   for (size_t i = 0; i < bd_addresses.size(); ++i) {
+    const bdaddr_t& bd_address = bd_addresses[i];
+    CachedDevices::const_iterator cached = paired ?
+        cached_devices_.find(BluetoothDevice::GetUniqueDeviceId(bd_address)) :
+        cached_devices_.end();
+    if (cached == cached_devices_.end() ||
+        date_time::DateTime::calculateTimeSpan(cached->second.discovery_time) >=
+        kCachedDeviceLifetimeMs) {
+      queried_addresses.push_back(bd_address);
+      continue;
+    }
+    LOG4CXX_DEBUG(logger_, "SmartDeviceLink service of device "
+                  << cached->first << " is taken from cache");
+    discovered_devices->push_back(new BluetoothDevice(
+        bd_address, cached->second.name.c_str(),
+        cached->second.rfcomm_channels));
+  }
+
+  std::vector<RfcommChannelVector> sdl_rfcomm_channels = async_discovery_ ?
+    DiscoverSmartDeviceLinkRFCOMMChannelsAsync(queried_addresses) :
+    DiscoverSmartDeviceLinkRFCOMMChannels(queried_addresses);
+
+  for (size_t i = 0; i < queried_addresses.size(); ++i) {
+    const bdaddr_t& bd_address = queried_addresses[i];
+    if (paired) {
+      cached_devices_.erase(BluetoothDevice::GetUniqueDeviceId(bd_address));
+    }
     if (sdl_rfcomm_channels[i].empty()) {
       continue;
     }
 
-    const bdaddr_t& bd_address = bd_addresses[i];
     char deviceName[256];
     int hci_read_remote_name_ret = hci_read_remote_name(
                                      device_handle, &bd_address, sizeof(deviceName) / sizeof(deviceName[0]),
@@ -242,6 +495,13 @@ void BluetoothDeviceScanner::CheckSDLServiceOnDevices(
     } else {
       LOG4CXX_WARN(logger_, "Can't create bluetooth device " << deviceName);
     }
+    if (paired) {
+      CachedDevice& cached_device =
+        cached_devices_[BluetoothDevice::GetUniqueDeviceId(bd_address)];
+      cached_device.name = deviceName;
+      cached_device.rfcomm_channels = sdl_rfcomm_channels[i];
+      cached_device.discovery_time = date_time::DateTime::getCurrentTime();
+    }
   }
   LOG4CXX_TRACE(logger_, "exit");
 }
@@ -287,7 +547,7 @@ bool BluetoothDeviceScanner::DiscoverSmartDeviceLinkRFCOMMChannels(
   sdp_session_t* sdp_session = sdp_connect(
                                  &any_address, &device_address, SDP_RETRY_IF_BUSY | SDP_WAIT_ON_CLOSE);
   if (sdp_session == 0) {
-    bool result = !(errno == 31 || errno == 16 || errno == 117 || errno == 114);
+    bool result = !IsSdpRetryError(errno);
     if (result) {
       LOG4CXX_TRACE(logger_, "exit with TRUE. Condition: sdp_session == 0");
     } else {
@@ -306,39 +566,7 @@ bool BluetoothDeviceScanner::DiscoverSmartDeviceLinkRFCOMMChannels(
                                        SDP_ATTR_REQ_RANGE, attr_list,
                                        &response_list)) {
     for (sdp_list_t* r = response_list; 0 != r; r = r->next) {
-      sdp_record_t* sdp_record = static_cast<sdp_record_t*>(r->data);
-      sdp_list_t* proto_list = 0;
-
-      if (0 == sdp_get_access_protos(sdp_record, &proto_list)) {
-        for (sdp_list_t* p = proto_list; 0 != p; p = p->next) {
-          sdp_list_t* pdsList = static_cast<sdp_list_t*>(p->data);
-
-          for (sdp_list_t* pds = pdsList; 0 != pds; pds = pds->next) {
-            sdp_data_t* sdpData = static_cast<sdp_data_t*>(pds->data);
-            int proto = 0;
-
-            for (sdp_data_t* d = sdpData; 0 != d; d = d->next) {
-              switch (d->dtd) {
-                case SDP_UUID16:
-                case SDP_UUID32:
-                case SDP_UUID128:
-                  proto = sdp_uuid_to_proto(&d->val.uuid);
-                  break;
-
-                case SDP_UINT8:
-                  if (RFCOMM_UUID == proto) {
-                    channels->push_back(d->val.uint8);
-                  }
-                  break;
-              }
-            }
-          }
-
-          sdp_list_free(pdsList, 0);
-        }
-
-        sdp_list_free(proto_list, 0);
-      }
+      FindRfcommChannels(static_cast<sdp_record_t*>(r->data), channels);
     }
   }
   sdp_list_free(search_list, 0);
@@ -346,29 +574,87 @@ bool BluetoothDeviceScanner::DiscoverSmartDeviceLinkRFCOMMChannels(
   sdp_list_free(response_list, 0);
   sdp_close(sdp_session);
 
-  if (!channels->empty()) {
-    LOG4CXX_INFO(logger_, "channels not empty");
-    std::stringstream rfcomm_channels_string;
+  LogRfcommChannels(device_address, *channels);
+  LOG4CXX_TRACE(logger_, "exit with TRUE");
+  return true;
+}
 
-    for (RfcommChannelVector::const_iterator it = channels->begin();
-         it != channels->end(); ++it) {
-      if (it != channels->begin()) {
-        rfcomm_channels_string << ", ";
+std::vector<BluetoothDeviceScanner::RfcommChannelVector>
+BluetoothDeviceScanner::DiscoverSmartDeviceLinkRFCOMMChannelsAsync(
+  const std::vector<bdaddr_t>& device_addresses) {
+  LOG4CXX_TRACE(logger_, "enter device_addresses: " << &device_addresses);
+  std::vector<RfcommChannelVector> result(device_addresses.size());
+
+  static const int attempts = 4;
+  static const int attempt_timeout = 5;
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < device_addresses.size(); ++i) {
+    pending.push_back(i);
+  }
+  for (int nattempt = 0; nattempt < attempts && !pending.empty() &&
+       !shutdown_requested_; ++nattempt) {
+    if (nattempt > 0) {
+      sleep(attempt_timeout);
+    }
+    std::vector<SdpQuery*> queries;
+    for (size_t i = 0; i < pending.size(); ++i) {
+      SdpQuery* query = new SdpQuery(device_addresses[pending[i]],
+                                     &smart_device_link_service_uuid_,
+                                     &result[pending[i]]);
+      query->Start();
+      queries.push_back(query);
+    }
+
+    // Every device has its own deadline, unreachable ones
+    // do not hold up the others
+    while (!shutdown_requested_) {
+      std::vector<pollfd> poll_fds;
+      std::vector<SdpQuery*> polled_queries;
+      for (std::vector<SdpQuery*>::iterator it = queries.begin();
+           it != queries.end(); ++it) {
+        SdpQuery* query = *it;
+        if (query->finished()) {
+          continue;
+        }
+        if (query->IsExpired()) {
+          query->Expire();
+          continue;
+        }
+        pollfd poll_fd;
+        poll_fd.fd = query->socket();
+        poll_fd.events = query->events();
+        poll_fd.revents = 0;
+        poll_fds.push_back(poll_fd);
+        polled_queries.push_back(query);
+      }
+      if (poll_fds.empty()) {
+        break;
+      }
+      if (-1 == poll(&poll_fds.front(), poll_fds.size(), kSdpPollTimeoutMs) &&
+          EINTR != errno) {
+        LOG4CXX_ERROR_WITH_ERRNO(logger_, "poll failed for SDP queries");
+        break;
+      }
+      for (size_t i = 0; i < poll_fds.size(); ++i) {
+        if (0 != poll_fds[i].revents) {
+          polled_queries[i]->Process();
+        }
       }
-      rfcomm_channels_string << static_cast<uint32_t>(*it);
     }
 
-    LOG4CXX_INFO(logger_,
-                 "SmartDeviceLink service was discovered on device "
-                 << BluetoothDevice::GetUniqueDeviceId(device_address)
-                 << " at channel(s): " << rfcomm_channels_string.str().c_str());
-  } else {
-    LOG4CXX_INFO(logger_,
-                 "SmartDeviceLink service was not discovered on device "
-                 << BluetoothDevice::GetUniqueDeviceId(device_address));
+    std::vector<size_t> retried;
+    for (size_t i = 0; i < queries.size(); ++i) {
+      if (queries[i]->retry()) {
+        retried.push_back(pending[i]);
+      } else {
+        LogRfcommChannels(device_addresses[pending[i]], result[pending[i]]);
+      }
+      delete queries[i];
+    }
+    pending.swap(retried);
   }
-  LOG4CXX_TRACE(logger_, "exit with TRUE");
-  return true;
+  LOG4CXX_TRACE(logger_, "exit with vector<RfcommChannelVector>: size = " << result.size());
+  return result;
 }
 
 void BluetoothDeviceScanner::Thread() {
@@ -42,6 +42,7 @@
 #include <bluetooth/rfcomm.h>
 
 #include "transport_manager/bluetooth/bluetooth_device.h"
+#include "transport_manager/transport_adapter/socket_options.h"
 #include "transport_manager/transport_adapter/transport_adapter_controller.h"
 
 #include "utils/logger.h"
@@ -84,6 +85,7 @@ bool BluetoothSocketConnection::Establish(ConnectError** error) {
   remoteSocketAddress.rc_channel = rfcomm_channel;
 
   int rfcomm_socket;
+  const SocketOptions socket_options = SocketOptions::Bluetooth();
 
   int attempts = 4;
   int connect_status = 0;
@@ -97,6 +99,7 @@ bool BluetoothSocketConnection::Establish(ConnectError** error) {
       LOG4CXX_TRACE(logger_, "exit with FALSE");
       return false;
     }
+    socket_options.Apply(rfcomm_socket);
     connect_status = ::connect(rfcomm_socket,
                                (struct sockaddr*) &remoteSocketAddress,
                                sizeof(remoteSocketAddress));
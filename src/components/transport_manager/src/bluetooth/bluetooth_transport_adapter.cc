@@ -50,6 +50,7 @@
 #include "transport_manager/bluetooth/bluetooth_device.h"
 
 #include "utils/logger.h"
+#include "config_profile/profile.h"
 
 namespace transport_manager {
 namespace transport_adapter {
@@ -60,7 +61,9 @@ BluetoothTransportAdapter::~BluetoothTransportAdapter() {
 }
 
 BluetoothTransportAdapter::BluetoothTransportAdapter()
-  : TransportAdapterImpl(new BluetoothDeviceScanner(this, true, 0),
+  : TransportAdapterImpl(new BluetoothDeviceScanner(this, true, 0,
+                             profile::Profile::instance()->
+                             transport_manager_bluetooth_adapter_async_discovery()),
                          new BluetoothConnectionFactory(this), 0) {
 }
 
@@ -68,6 +71,11 @@ DeviceType BluetoothTransportAdapter::GetDeviceType() const {
   return "sdl-bluetooth";
 }
 
+size_t BluetoothTransportAdapter::GetMaximumFrameSize() const {
+  return profile::Profile::instance()->
+      transport_manager_bluetooth_adapter_maximum_frame_size();
+}
+
 void BluetoothTransportAdapter::Store() const {
   LOG4CXX_TRACE(logger_, "enter");
   Json::Value bluetooth_adapter_dictionary;
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transport_manager/replay/replay_client_listener.h"
+
+#include "utils/logger.h"
+#include "utils/threads/thread.h"
+#include "protocol/raw_message.h"
+#include "transport_manager/transport_adapter/transport_adapter_controller.h"
+#include "transport_manager/replay/replay_connection.h"
+#include "transport_manager/replay/replay_device.h"
+
+namespace transport_manager {
+namespace transport_adapter {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
+
+ReplayClientListener::ReplayClientListener(
+    TransportAdapterController* controller, const std::string& capture_file,
+    const bool real_time)
+    : controller_(controller),
+      capture_file_(capture_file),
+      real_time_(real_time),
+      initialised_(false),
+      thread_(NULL),
+      stop_requested_(false) {
+}
+
+ReplayClientListener::~ReplayClientListener() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (thread_) {
+    StopListening();
+    delete thread_->delegate();
+    threads::DeleteThread(thread_);
+  }
+}
+
+TransportAdapter::Error ReplayClientListener::Init() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (initialised_) {
+    return TransportAdapter::OK;
+  }
+  if (!reader_.Open(capture_file_)) {
+    LOG4CXX_ERROR(logger_, "Capture " << capture_file_ << " is not replayed: "
+                  << reader_.error());
+    return TransportAdapter::FAIL;
+  }
+  thread_ = threads::CreateThread("ReplayListener",
+                                  new ReplayThreadDelegate(this));
+  initialised_ = true;
+  return TransportAdapter::OK;
+}
+
+void ReplayClientListener::Terminate() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (thread_) {
+    StopListening();
+  }
+}
+
+bool ReplayClientListener::IsInitialised() const {
+  return initialised_;
+}
+
+TransportAdapter::Error ReplayClientListener::StartListening() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (thread_->is_running()) {
+    LOG4CXX_DEBUG(logger_, "Capture is being replayed already");
+    return TransportAdapter::BAD_STATE;
+  }
+  {
+    sync_primitives::AutoLock auto_lock(stop_lock_);
+    stop_requested_ = false;
+  }
+  if (!thread_->start()) {
+    LOG4CXX_ERROR(logger_, "Replay thread start failed");
+    return TransportAdapter::FAIL;
+  }
+  LOG4CXX_INFO(logger_, "Replay of " << capture_file_ << " is started");
+  return TransportAdapter::OK;
+}
+
+TransportAdapter::Error ReplayClientListener::StopListening() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (!thread_->is_running()) {
+    return TransportAdapter::BAD_STATE;
+  }
+  thread_->join();
+  return TransportAdapter::OK;
+}
+
+void ReplayClientListener::Loop() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (!device_) {
+    device_ = controller_->AddDevice(new ReplayDevice(capture_file_));
+  }
+  size_t frames_count = 0;
+  bool first_frame = true;
+  uint64_t first_time_stamp = 0;
+  const TimevalStruct start_time =
+      date_time::DateTime::getPreciseMonotonicTime();
+  CapturedFrame frame;
+  while (reader_.Next(&frame)) {
+    if (kTrafficInbound != frame.direction || frame.data.empty()) {
+      continue;
+    }
+    // Replay starts from the first received frame
+    if (first_frame) {
+      first_time_stamp = frame.time_stamp;
+      first_frame = false;
+    }
+    if (real_time_ && !WaitFrameTime(start_time,
+                                     frame.time_stamp - first_time_stamp)) {
+      break;
+    }
+    {
+      sync_primitives::AutoLock auto_lock(stop_lock_);
+      if (stop_requested_) {
+        break;
+      }
+    }
+    const ApplicationHandle app_handle = ApplicationFor(frame.connection_id);
+    ::protocol_handler::RawMessagePtr message(
+        new ::protocol_handler::RawMessage(0, 0, &frame.data[0],
+                                           frame.data.size()));
+    controller_->DataReceiveDone(device_->unique_device_id(), app_handle,
+                                 message);
+    ++frames_count;
+  }
+  if (!reader_.error().empty()) {
+    LOG4CXX_ERROR(logger_, "Replay of " << capture_file_ << " is stopped: "
+                  << reader_.error());
+  }
+  LOG4CXX_INFO(logger_, frames_count << " frames of " << capture_file_
+               << " are replayed");
+}
+
+bool ReplayClientListener::WaitFrameTime(const TimevalStruct& start_time,
+                                         const uint64_t offset) {
+  sync_primitives::AutoLock auto_lock(stop_lock_);
+  while (!stop_requested_) {
+    const int64_t elapsed = date_time::DateTime::getuSecs(
+        date_time::DateTime::Sub(
+            date_time::DateTime::getPreciseMonotonicTime(), start_time));
+    if (elapsed >= static_cast<int64_t>(offset)) {
+      return true;
+    }
+    const int64_t wait_time =
+        (static_cast<int64_t>(offset) - elapsed +
+         date_time::DateTime::MICROSECONDS_IN_MILLISECONDS - 1) /
+        date_time::DateTime::MICROSECONDS_IN_MILLISECONDS;
+    stop_condition_.WaitFor(auto_lock, static_cast<int32_t>(wait_time));
+  }
+  return false;
+}
+
+ApplicationHandle ReplayClientListener::ApplicationFor(
+    const ConnectionUID captured_id) {
+  std::map<ConnectionUID, ApplicationHandle>::const_iterator it =
+      applications_.find(captured_id);
+  if (applications_.end() != it) {
+    return it->second;
+  }
+  const ApplicationHandle app_handle =
+      static_cast<ApplicationHandle>(applications_.size() + 1);
+  applications_[captured_id] = app_handle;
+  static_cast<ReplayDevice*>(device_.get())->AddApplication(app_handle);
+  const DeviceUID& device_uid = device_->unique_device_id();
+  controller_->ConnectionCreated(
+      new ReplayConnection(device_uid, app_handle, controller_),
+      device_uid, app_handle);
+  controller_->ConnectDone(device_uid, app_handle);
+  LOG4CXX_DEBUG(logger_, "Captured connection " << captured_id
+                << " is replayed by application " << app_handle);
+  return app_handle;
+}
+
+void ReplayClientListener::StopLoop() {
+  sync_primitives::AutoLock auto_lock(stop_lock_);
+  stop_requested_ = true;
+  stop_condition_.Broadcast();
+}
+
+ReplayClientListener::ReplayThreadDelegate::ReplayThreadDelegate(
+    ReplayClientListener* parent)
+    : parent_(parent) {
+}
+
+void ReplayClientListener::ReplayThreadDelegate::threadMain() {
+  parent_->Loop();
+}
+
+void ReplayClientListener::ReplayThreadDelegate::exitThreadMain() {
+  parent_->StopLoop();
+}
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
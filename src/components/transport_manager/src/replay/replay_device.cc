@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transport_manager/replay/replay_device.h"
+
+#include <algorithm>
+
+namespace transport_manager {
+namespace transport_adapter {
+
+ReplayDevice::ReplayDevice(const std::string& capture_file)
+    : Device("Replay of " + capture_file, "replay:" + capture_file) {
+}
+
+bool ReplayDevice::IsSameAs(const Device* other_device) const {
+  return other_device->unique_device_id() == unique_device_id();
+}
+
+ApplicationList ReplayDevice::GetApplicationList() const {
+  sync_primitives::AutoLock auto_lock(applications_lock_);
+  return applications_;
+}
+
+void ReplayDevice::AddApplication(const ApplicationHandle app_handle) {
+  sync_primitives::AutoLock auto_lock(applications_lock_);
+  if (applications_.end() == std::find(applications_.begin(),
+                                       applications_.end(), app_handle)) {
+    applications_.push_back(app_handle);
+  }
+}
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <map>
+#include <sstream>
 #include "utils/logger.h"
 
 #include "transport_manager/transport_adapter/transport_adapter_impl.h"
@@ -45,6 +46,24 @@ namespace transport_adapter {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
 
+namespace {
+// Resolved address of service is reused that long, e.g. when service is
+// announced again after it was removed, mDNS host records live that long
+const int64_t kResolveCacheTtlMs =
+    120 * date_time::DateTime::MILLISECONDS_IN_SECOND;
+
+std::string ServiceKey(const DnssdServiceRecord& service_record) {
+  std::ostringstream key;
+  key << service_record.interface << ' ' << service_record.protocol << ' '
+      << service_record.name << '\n' << service_record.type << '\n'
+      << service_record.domain_name;
+  return key.str();
+}
+
+bool IsSameResolve(const DnssdServiceRecord& a, const DnssdServiceRecord& b) {
+  return a.host_name == b.host_name && a.addr == b.addr && a.port == b.port;
+}
+}  // namespace
 
 bool operator==(const DnssdServiceRecord& a, const DnssdServiceRecord& b) {
   return a.name == b.name && a.type == b.type && a.interface == b.interface
@@ -56,6 +75,9 @@ void DnssdServiceBrowser::Terminate() {
   if (0 != avahi_threaded_poll_) {
     avahi_threaded_poll_stop(avahi_threaded_poll_);
   }
+  mutex_.Acquire();
+  resolvers_.clear();
+  mutex_.Release();
   if (0 != avahi_service_browser_) {
     avahi_service_browser_free(avahi_service_browser_);
     avahi_service_browser_ = NULL;
@@ -80,6 +102,10 @@ DnssdServiceBrowser::DnssdServiceBrowser(TransportAdapterController* controller)
       avahi_threaded_poll_(0),
       avahi_client_(0),
       service_records_(),
+      resolve_cache_(),
+      resolvers_(),
+      browsing_done_(false),
+      device_list_changed_(false),
       mutex_(),
       initialised_(false) {
 }
@@ -164,6 +190,7 @@ void AvahiServiceBrowserCallback(AvahiServiceBrowser* avahi_service_browser,
       break;
 
     case AVAHI_BROWSER_ALL_FOR_NOW:
+      dnssd_service_browser->OnAllForNow();
       LOG4CXX_DEBUG(logger_, "event: AVAHI_BROWSER_ALL_FOR_NOW");
       break;
     case AVAHI_BROWSER_CACHE_EXHAUSTED:
@@ -177,13 +204,19 @@ void DnssdServiceBrowser::ServiceResolved(
     const DnssdServiceRecord& service_record) {
   LOG4CXX_AUTO_TRACE(logger_);
   sync_primitives::AutoLock locker(mutex_);
+  const std::string key = ServiceKey(service_record);
+  resolvers_.erase(key);
+  CachedResolve& cached = resolve_cache_[key];
+  cached.service_record = service_record;
+  cached.resolve_time = date_time::DateTime::getCurrentTime();
   ServiceRecords::iterator service_record_it = std::find(
       service_records_.begin(), service_records_.end(), service_record);
-  if (service_record_it != service_records_.end()) {
+  if (service_record_it != service_records_.end() &&
+      !IsSameResolve(*service_record_it, service_record)) {
     *service_record_it = service_record;
+    device_list_changed_ = true;
   }
-  DeviceVector device_vector = PrepareDeviceVector();
-  controller_->SearchDeviceDone(device_vector);
+  DeviceListChanged();
 }
 
 void DnssdServiceBrowser::ServiceResolveFailed(
@@ -192,11 +225,18 @@ void DnssdServiceBrowser::ServiceResolveFailed(
   LOG4CXX_DEBUG(logger_,
                 "AvahiServiceResolver failure for: " << service_record.name);
   sync_primitives::AutoLock locker(mutex_);
+  const std::string key = ServiceKey(service_record);
+  resolvers_.erase(key);
+  resolve_cache_.erase(key);
   ServiceRecords::iterator service_record_it = std::find(
       service_records_.begin(), service_records_.end(), service_record);
   if (service_record_it != service_records_.end()) {
+    if (!service_record_it->host_name.empty()) {
+      device_list_changed_ = true;
+    }
     service_records_.erase(service_record_it);
   }
+  DeviceListChanged();
 }
 
 void AvahiServiceResolverCallback(AvahiServiceResolver* avahi_service_resolver,
@@ -244,6 +284,10 @@ void AvahiServiceResolverCallback(AvahiServiceResolver* avahi_service_resolver,
 
 TransportAdapter::Error DnssdServiceBrowser::CreateAvahiClientAndBrowser() {
   LOG4CXX_AUTO_TRACE(logger_);
+  mutex_.Acquire();
+  // Resolvers are released together with client
+  resolvers_.clear();
+  mutex_.Release();
   if (0 != avahi_service_browser_) {
     avahi_service_browser_free(avahi_service_browser_);
     avahi_service_browser_ = NULL;
@@ -264,8 +308,11 @@ TransportAdapter::Error DnssdServiceBrowser::CreateAvahiClientAndBrowser() {
     return TransportAdapter::FAIL;
   }
 
+  // Resolve cache is kept, so services announced again are known at once
   mutex_.Acquire();
   service_records_.clear();
+  browsing_done_ = false;
+  device_list_changed_ = false;
   mutex_.Release();
 
   avahi_service_browser_ = avahi_service_browser_new(
@@ -317,13 +364,27 @@ void DnssdServiceBrowser::AddService(AvahiIfIndex interface,
 
   sync_primitives::AutoLock locker(mutex_);
   if (service_records_.end()
-      == std::find(service_records_.begin(), service_records_.end(), record)) {
+      != std::find(service_records_.begin(), service_records_.end(), record)) {
+    return;
+  }
+  PruneResolveCache();
+  if (ResolveFromCache(&record)) {
+    LOG4CXX_DEBUG(logger_, "Service " << name << " resolved from cache");
     service_records_.push_back(record);
-    avahi_service_resolver_new(avahi_client_, interface, protocol, name, type,
-                               domain, AVAHI_PROTO_INET,
-                               static_cast<AvahiLookupFlags>(0),
-                               AvahiServiceResolverCallback, this);
+    device_list_changed_ = true;
+    DeviceListChanged();
+    return;
   }
+  AvahiServiceResolver* avahi_service_resolver = avahi_service_resolver_new(
+      avahi_client_, interface, protocol, name, type, domain, AVAHI_PROTO_INET,
+      static_cast<AvahiLookupFlags>(0), AvahiServiceResolverCallback, this);
+  if (0 == avahi_service_resolver) {
+    LOG4CXX_ERROR(logger_, "Failed to create AvahiServiceResolver: "
+                  << avahi_strerror(avahi_client_errno(avahi_client_)));
+    return;
+  }
+  service_records_.push_back(record);
+  resolvers_[ServiceKey(record)] = avahi_service_resolver;
 }
 
 void DnssdServiceBrowser::RemoveService(AvahiIfIndex interface,
@@ -342,9 +403,62 @@ void DnssdServiceBrowser::RemoveService(AvahiIfIndex interface,
   record.domain_name = domain;
 
   sync_primitives::AutoLock locker(mutex_);
-  service_records_.erase(
-      std::remove(service_records_.begin(), service_records_.end(), record),
-      service_records_.end());
+  const Resolvers::iterator resolver = resolvers_.find(ServiceKey(record));
+  if (resolvers_.end() != resolver) {
+    // Resolver is cancelled, its callback is not called anymore
+    avahi_service_resolver_free(resolver->second);
+    resolvers_.erase(resolver);
+  }
+  ServiceRecords::iterator service_record_it = std::find(
+      service_records_.begin(), service_records_.end(), record);
+  if (service_record_it != service_records_.end()) {
+    if (!service_record_it->host_name.empty()) {
+      device_list_changed_ = true;
+    }
+    service_records_.erase(service_record_it);
+  }
+  DeviceListChanged();
+}
+
+void DnssdServiceBrowser::OnAllForNow() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock locker(mutex_);
+  browsing_done_ = true;
+  DeviceListChanged();
+}
+
+bool DnssdServiceBrowser::ResolveFromCache(
+    DnssdServiceRecord* service_record) {
+  const ResolveCache::const_iterator cached =
+      resolve_cache_.find(ServiceKey(*service_record));
+  if (resolve_cache_.end() == cached) {
+    return false;
+  }
+  service_record->host_name = cached->second.service_record.host_name;
+  service_record->addr = cached->second.service_record.addr;
+  service_record->port = cached->second.service_record.port;
+  return true;
+}
+
+void DnssdServiceBrowser::PruneResolveCache() {
+  for (ResolveCache::iterator it = resolve_cache_.begin();
+       it != resolve_cache_.end();) {
+    if (date_time::DateTime::calculateTimeSpan(it->second.resolve_time) >=
+        kResolveCacheTtlMs) {
+      resolve_cache_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void DnssdServiceBrowser::DeviceListChanged() {
+  if (!device_list_changed_ || !browsing_done_ || !resolvers_.empty()) {
+    return;
+  }
+  device_list_changed_ = false;
+  DeviceVector device_vector = PrepareDeviceVector();
+  controller_->SearchDeviceDone(device_vector);
 }
 
 DeviceVector DnssdServiceBrowser::PrepareDeviceVector() const {
@@ -52,11 +52,13 @@
 
 #include <sstream>
 
+#include "utils/fd_handoff.h"
 #include "utils/logger.h"
 #include "utils/threads/thread.h"
 #include "transport_manager/transport_adapter/transport_adapter_controller.h"
 #include "transport_manager/tcp/tcp_device.h"
 #include "transport_manager/tcp/tcp_socket_connection.h"
+#include "transport_manager/transport_adapter/socket_reactor.h"
 
 namespace transport_manager {
 namespace transport_adapter {
@@ -65,13 +67,16 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
 
 TcpClientListener::TcpClientListener(TransportAdapterController* controller,
                                      const uint16_t port,
-                                     const bool enable_keepalive)
+                                     const bool enable_keepalive,
+                                     const bool use_event_loop)
     : port_(port),
       enable_keepalive_(enable_keepalive),
+      use_event_loop_(use_event_loop),
       controller_(controller),
       thread_(0),
       socket_(-1),
-      thread_stop_requested_(false) {
+      thread_stop_requested_(false),
+      reactor_(NULL) {
   thread_ = threads::CreateThread("TcpClientListener",
                                   new ListeningThreadDelegate(this));
 }
@@ -80,10 +85,32 @@ TransportAdapter::Error TcpClientListener::Init() {
   LOG4CXX_AUTO_TRACE(logger_);
   thread_stop_requested_ = false;
 
+  // Listening socket of SDL running before keeps pending connections
+  socket_ = utils::FdHandoff::instance()->TakeInherited(HandoffName());
+  if (-1 != socket_) {
+    LOG4CXX_INFO(logger_, "Listening socket is taken over");
+  } else if (!Listen()) {
+    return TransportAdapter::FAIL;
+  }
+  utils::FdHandoff::instance()->Publish(HandoffName(), socket_);
+
+  if (use_event_loop_ && !reactor_) {
+    reactor_ = new SocketReactor();
+    if (!reactor_->Start()) {
+      LOG4CXX_WARN(logger_, "Event loop is not available, "
+                   "connections are served by their own threads");
+      delete reactor_;
+      reactor_ = NULL;
+    }
+  }
+  return TransportAdapter::OK;
+}
+
+bool TcpClientListener::Listen() {
   socket_ = socket(AF_INET, SOCK_STREAM, 0);
   if (-1 == socket_) {
     LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to create socket");
-    return TransportAdapter::FAIL;
+    return false;
   }
 
   sockaddr_in server_address = { 0 };
@@ -97,15 +124,21 @@ TransportAdapter::Error TcpClientListener::Init() {
   if (bind(socket_, reinterpret_cast<sockaddr*>(&server_address),
            sizeof(server_address)) != 0) {
     LOG4CXX_ERROR_WITH_ERRNO(logger_, "bind() failed");
-    return TransportAdapter::FAIL;
+    return false;
   }
 
   const int kBacklog = 128;
   if (0 != listen(socket_, kBacklog)) {
     LOG4CXX_ERROR_WITH_ERRNO(logger_, "listen() failed");
-    return TransportAdapter::FAIL;
+    return false;
   }
-  return TransportAdapter::OK;
+  return true;
+}
+
+std::string TcpClientListener::HandoffName() const {
+  std::stringstream name;
+  name << "tcp_listener:" << port_;
+  return name.str();
 }
 
 void TcpClientListener::Terminate() {
@@ -114,7 +147,10 @@ void TcpClientListener::Terminate() {
     LOG4CXX_WARN(logger_, "Socket has been closed");
     return;
   }
-  if (shutdown(socket_, SHUT_RDWR) != 0) {
+  utils::FdHandoff::instance()->Withdraw(HandoffName());
+  // Shutdown would stop listening of successor sharing the socket
+  if (!utils::FdHandoff::instance()->handed_over() &&
+      shutdown(socket_, SHUT_RDWR) != 0) {
     LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to shutdown socket");
   }
   if (close(socket_) != 0) {
@@ -133,6 +169,7 @@ TcpClientListener::~TcpClientListener() {
   delete thread_->delegate();
   threads::DeleteThread(thread_);
   Terminate();
+  delete reactor_;
 }
 
 void SetKeepaliveOptions(const int fd) {
@@ -225,6 +262,7 @@ void TcpClientListener::Loop() {
         new TcpSocketConnection(device->unique_device_id(), app_handle,
                                 controller_));
     connection->set_socket(connection_fd);
+    connection->set_reactor(reactor_);
     const TransportAdapter::Error error = connection->Start();
     if (error != TransportAdapter::OK) {
       delete connection;
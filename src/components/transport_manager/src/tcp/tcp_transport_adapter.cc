@@ -41,6 +41,7 @@
 #include <sstream>
 
 #include "utils/logger.h"
+#include "config_profile/profile.h"
 #include "utils/threads/thread_delegate.h"
 #include "resumption/last_state.h"
 #include "transport_manager/tcp/tcp_client_listener.h"
@@ -64,7 +65,9 @@ TcpTransportAdapter::TcpTransportAdapter(const uint16_t port)
                            NULL,
 #endif
                            new TcpConnectionFactory(this),
-                           new TcpClientListener(this, port, false)) {
+                           new TcpClientListener(this, port, false,
+                               profile::Profile::instance()->
+                               transport_manager_tcp_adapter_event_loop())) {
 }
 
 TcpTransportAdapter::~TcpTransportAdapter() {
@@ -74,6 +77,16 @@ DeviceType TcpTransportAdapter::GetDeviceType() const {
   return "sdl-tcp";
 }
 
+size_t TcpTransportAdapter::GetMaximumFrameSize() const {
+  return profile::Profile::instance()->
+      transport_manager_tcp_adapter_maximum_frame_size();
+}
+
+uint32_t TcpTransportAdapter::GetReconnectGracePeriod() const {
+  return profile::Profile::instance()->
+      transport_manager_tcp_adapter_reconnect_grace_period();
+}
+
 void TcpTransportAdapter::Store() const {
   LOG4CXX_AUTO_TRACE(logger_);
   Json::Value tcp_adapter_dictionary;
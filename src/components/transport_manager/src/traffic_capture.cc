@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transport_manager/traffic_capture.h"
+
+#include <string.h>
+
+#include "utils/logger.h"
+
+namespace transport_manager {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
+
+namespace {
+// time stamp, connection id, direction, size
+const size_t kFrameHeaderSize = 8 + 4 + 1 + 4;
+
+template <typename T>
+uint8_t* Put(uint8_t* buffer, const T& value) {
+  memcpy(buffer, &value, sizeof(value));
+  return buffer + sizeof(value);
+}
+
+template <typename T>
+const uint8_t* Get(const uint8_t* buffer, T* value) {
+  memcpy(value, buffer, sizeof(*value));
+  return buffer + sizeof(*value);
+}
+}  // namespace
+
+TrafficCaptureWriter::TrafficCaptureWriter()
+  : file_(NULL) {
+}
+
+TrafficCaptureWriter::~TrafficCaptureWriter() {
+  Close();
+}
+
+bool TrafficCaptureWriter::Open(const std::string& file_name) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  DCHECK_OR_RETURN(!file_, false);
+  FILE* file = fopen(file_name.c_str(), "wb");
+  if (!file) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Can not open " << file_name);
+    return false;
+  }
+  if (1 != fwrite(kTrafficCaptureMagic, sizeof(kTrafficCaptureMagic), 1,
+                  file) ||
+      1 != fwrite(&kTrafficCaptureByteOrder,
+                  sizeof(kTrafficCaptureByteOrder), 1, file) ||
+      1 != fwrite(&kTrafficCaptureVersion,
+                  sizeof(kTrafficCaptureVersion), 1, file)) {
+    LOG4CXX_ERROR(logger_, "Can not write header of " << file_name);
+    fclose(file);
+    return false;
+  }
+  start_time_ = date_time::DateTime::getPreciseMonotonicTime();
+  file_ = file;
+  LOG4CXX_INFO(logger_, "Traffic is captured to " << file_name);
+  return true;
+}
+
+void TrafficCaptureWriter::Close() {
+  sync_primitives::AutoLock auto_lock(lock_);
+  if (file_) {
+    fclose(file_);
+    file_ = NULL;
+  }
+}
+
+bool TrafficCaptureWriter::Record(
+    TrafficDirection direction, const protocol_handler::RawMessage& message) {
+  const uint64_t time_stamp = date_time::DateTime::getuSecs(
+      date_time::DateTime::Sub(date_time::DateTime::getPreciseMonotonicTime(),
+                               start_time_));
+  uint8_t header[kFrameHeaderSize];
+  uint8_t* end = Put(header, time_stamp);
+  end = Put(end, static_cast<uint32_t>(message.connection_key()));
+  end = Put(end, static_cast<uint8_t>(direction));
+  Put(end, static_cast<uint32_t>(message.data_size()));
+
+  sync_primitives::AutoLock auto_lock(lock_);
+  if (!file_) {
+    return false;
+  }
+  bool result = 1 == fwrite(header, sizeof(header), 1, file_);
+  for (size_t i = 0; result && i < message.fragments_count(); ++i) {
+    const utils::BufferSlice& fragment = message.fragment(i);
+    result = !fragment.size() ||
+             1 == fwrite(fragment.data(), fragment.size(), 1, file_);
+  }
+  if (!result) {
+    LOG4CXX_ERROR(logger_, "Traffic capture failed, it is stopped");
+    fclose(file_);
+    file_ = NULL;
+  }
+  return result;
+}
+
+TrafficCaptureReader::TrafficCaptureReader()
+  : file_(NULL) {
+}
+
+TrafficCaptureReader::~TrafficCaptureReader() {
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+bool TrafficCaptureReader::Open(const std::string& file_name) {
+  file_ = fopen(file_name.c_str(), "rb");
+  if (!file_) {
+    error_ = "Can not open " + file_name;
+    return false;
+  }
+  char magic[sizeof(kTrafficCaptureMagic)];
+  uint32_t byte_order = 0;
+  uint32_t version = 0;
+  if (1 != fread(magic, sizeof(magic), 1, file_) ||
+      1 != fread(&byte_order, sizeof(byte_order), 1, file_) ||
+      1 != fread(&version, sizeof(version), 1, file_) ||
+      0 != memcmp(magic, kTrafficCaptureMagic, sizeof(magic))) {
+    error_ = "Not a traffic capture";
+    return false;
+  }
+  if (kTrafficCaptureByteOrder != byte_order) {
+    error_ = "Capture was written on machine with other byte order";
+    return false;
+  }
+  if (kTrafficCaptureVersion != version) {
+    error_ = "Unsupported version of traffic capture";
+    return false;
+  }
+  return true;
+}
+
+bool TrafficCaptureReader::Next(CapturedFrame* frame) {
+  if (!frame || !file_ || !error_.empty()) {
+    return false;
+  }
+  uint8_t header[kFrameHeaderSize];
+  if (1 != fread(header, sizeof(header), 1, file_)) {
+    return false;
+  }
+  uint32_t connection_id = 0;
+  uint8_t direction = 0;
+  uint32_t size = 0;
+  const uint8_t* end = Get(header, &frame->time_stamp);
+  end = Get(end, &connection_id);
+  end = Get(end, &direction);
+  Get(end, &size);
+  frame->connection_id = connection_id;
+  frame->direction = static_cast<TrafficDirection>(direction);
+  frame->data.resize(size);
+  if (size && 1 != fread(&frame->data[0], size, 1, file_)) {
+    error_ = "Unexpected end of file";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace transport_manager
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transport_manager/transport_adapter/socket_poller.h"
+
+#include <errno.h>
+#include <unistd.h>
+#ifdef __linux__
+#  include <sys/epoll.h>
+#endif  // __linux__
+
+#include "utils/logger.h"
+
+namespace transport_manager {
+namespace transport_adapter {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
+
+#ifdef __linux__
+namespace {
+// Maximum count of events taken by single epoll_wait() call
+const int kMaxEvents = 64;
+
+bool Control(int epoll_fd, int operation, int fd, uint32_t events,
+             uint64_t id) {
+  epoll_event event = { 0 };
+  event.events = events;
+  event.data.u64 = id;
+  return 0 == epoll_ctl(epoll_fd, operation, fd, &event);
+}
+}  // namespace
+
+EpollSocketPoller::EpollSocketPoller()
+    : epoll_fd_(-1),
+      watched_() {
+}
+
+EpollSocketPoller::~EpollSocketPoller() {
+  if (-1 != epoll_fd_) {
+    close(epoll_fd_);
+  }
+}
+
+bool EpollSocketPoller::Init() {
+  epoll_fd_ = epoll_create(kMaxEvents);
+  if (-1 == epoll_fd_) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "epoll_create() failed");
+    return false;
+  }
+  return true;
+}
+
+bool EpollSocketPoller::Watch(uint64_t id, int socket, int notify_fd,
+                              bool write_wanted) {
+  const uint32_t events = EPOLLIN | EPOLLPRI | (write_wanted ? EPOLLOUT : 0);
+  if (!Control(epoll_fd_, EPOLL_CTL_ADD, socket, events, id)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to watch socket " << socket);
+    return false;
+  }
+  if (-1 != notify_fd &&
+      !Control(epoll_fd_, EPOLL_CTL_ADD, notify_fd, EPOLLIN, id)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to watch descriptor "
+                             << notify_fd);
+    Control(epoll_fd_, EPOLL_CTL_DEL, socket, 0, id);
+    return false;
+  }
+  const Watched watched = { socket, notify_fd, write_wanted };
+  watched_[id] = watched;
+  return true;
+}
+
+void EpollSocketPoller::Unwatch(uint64_t id) {
+  WatchedMap::iterator it = watched_.find(id);
+  if (it == watched_.end()) {
+    return;
+  }
+  // Descriptors are still open, so they can not be taken by somebody else
+  Control(epoll_fd_, EPOLL_CTL_DEL, it->second.socket, 0, id);
+  if (-1 != it->second.notify_fd) {
+    Control(epoll_fd_, EPOLL_CTL_DEL, it->second.notify_fd, 0, id);
+  }
+  watched_.erase(it);
+}
+
+void EpollSocketPoller::WatchWrite(uint64_t id, bool watch) {
+  WatchedMap::iterator it = watched_.find(id);
+  if (it == watched_.end() || watch == it->second.write_watched) {
+    return;
+  }
+  Watched& watched = it->second;
+  const uint32_t events = EPOLLIN | EPOLLPRI | (watch ? EPOLLOUT : 0);
+  if (!Control(epoll_fd_, EPOLL_CTL_MOD, watched.socket, events, id)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to update socket "
+                             << watched.socket);
+    return;
+  }
+  watched.write_watched = watch;
+}
+
+bool EpollSocketPoller::Wait(std::vector<uint64_t>* ready_ids) {
+  DCHECK(ready_ids);
+  epoll_event events[kMaxEvents];
+  const int count = epoll_wait(epoll_fd_, events, kMaxEvents, -1);
+  if (count < 0) {
+    if (EINTR == errno) {
+      return true;
+    }
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "epoll_wait() failed");
+    return false;
+  }
+  for (int i = 0; i < count; ++i) {
+    ready_ids->push_back(events[i].data.u64);
+  }
+  return true;
+}
+#endif  // __linux__
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
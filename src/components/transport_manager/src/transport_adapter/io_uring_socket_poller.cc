@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transport_manager/transport_adapter/socket_poller.h"
+
+#include <errno.h>
+#include <endian.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include <algorithm>
+
+#include "utils/logger.h"
+
+namespace transport_manager {
+namespace transport_adapter {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
+
+namespace {
+const unsigned kSubmissionQueueSize = 256;
+const unsigned kCompletionQueueSize = 1024;
+// Request kind takes lowest bits of user data, id takes the rest
+const unsigned kRequestBits = 2;
+const uint64_t kRequestMask = (1 << kRequestBits) - 1;
+// User data of removal requests, their completions are ignored
+const uint64_t kRemovalUserData = ~static_cast<uint64_t>(0);
+
+int Enter(int ring_fd, unsigned to_submit, unsigned min_complete,
+          unsigned flags) {
+  return syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete,
+                 flags, NULL, 0);
+}
+}  // namespace
+
+IoUringSocketPoller::IoUringSocketPoller()
+    : ring_fd_(-1),
+      ring_(MAP_FAILED),
+      ring_size_(0),
+      sqes_(NULL),
+      sqes_size_(0),
+      sq_head_(NULL),
+      sq_tail_(NULL),
+      sq_mask_(0),
+      sq_entries_(0),
+      sq_array_(NULL),
+      cq_head_(NULL),
+      cq_tail_(NULL),
+      cq_mask_(0),
+      cqes_(NULL),
+      unsubmitted_(0),
+      watched_(),
+      lock_() {
+}
+
+IoUringSocketPoller::~IoUringSocketPoller() {
+  if (sqes_) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (MAP_FAILED != ring_) {
+    munmap(ring_, ring_size_);
+  }
+  if (-1 != ring_fd_) {
+    close(ring_fd_);
+  }
+}
+
+bool IoUringSocketPoller::Init() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = kCompletionQueueSize;
+  ring_fd_ = syscall(__NR_io_uring_setup, kSubmissionQueueSize, &params);
+  if (ring_fd_ < 0) {
+    LOG4CXX_WARN_WITH_ERRNO(logger_, "io_uring_setup() failed");
+    ring_fd_ = -1;
+    return false;
+  }
+  // Multishot poll appeared together with resource tags feature
+  if (0 == (params.features & IORING_FEAT_SINGLE_MMAP) ||
+      0 == (params.features & IORING_FEAT_RSRC_TAGS)) {
+    LOG4CXX_WARN(logger_, "io_uring of the kernel lacks multishot poll");
+    return false;
+  }
+
+  ring_size_ = std::max(
+      params.sq_off.array + params.sq_entries * sizeof(unsigned),
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  ring_ = mmap(NULL, ring_size_, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (MAP_FAILED == ring_) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to map io_uring queues");
+    return false;
+  }
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (MAP_FAILED == sqes) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to map io_uring requests");
+    return false;
+  }
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  char* ring = static_cast<char*>(ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(ring + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(ring + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned*>(ring + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  sq_array_ = reinterpret_cast<unsigned*>(ring + params.sq_off.array);
+  cq_head_ = reinterpret_cast<unsigned*>(ring + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(ring + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned*>(ring + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe*>(ring + params.cq_off.cqes);
+  LOG4CXX_INFO(logger_, "io_uring is set up with " << sq_entries_
+               << " requests queue");
+  return true;
+}
+
+bool IoUringSocketPoller::Watch(uint64_t id, int socket, int notify_fd,
+                                bool write_wanted) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  const Watched watched = { socket, notify_fd, write_wanted, write_wanted };
+  WatchedMap::iterator it = watched_.insert(std::make_pair(id, watched)).first;
+  if (Poll(socket, POLLIN | POLLPRI, id, kReadRequest, true) &&
+      (-1 == notify_fd || Poll(notify_fd, POLLIN, id, kNotifyRequest, true)) &&
+      (!write_wanted || Poll(socket, POLLOUT, id, kWriteRequest, false)) &&
+      Submit()) {
+    return true;
+  }
+  LOG4CXX_ERROR(logger_, "Failed to watch socket " << socket);
+  // Removal of requests which were not queued just fails
+  RemoveRequests(it);
+  return false;
+}
+
+void IoUringSocketPoller::Unwatch(uint64_t id) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  WatchedMap::iterator it = watched_.find(id);
+  if (it != watched_.end()) {
+    RemoveRequests(it);
+  }
+}
+
+void IoUringSocketPoller::WatchWrite(uint64_t id, bool watch) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  WatchedMap::iterator it = watched_.find(id);
+  if (it == watched_.end()) {
+    return;
+  }
+  Watched& watched = it->second;
+  watched.write_wanted = watch;
+  // Request which is not wanted anymore is left to complete,
+  // it is submitted by the following Wait() otherwise
+  if (watch && !watched.write_armed) {
+    watched.write_armed = Poll(watched.socket, POLLOUT, id, kWriteRequest,
+                               false);
+  }
+}
+
+bool IoUringSocketPoller::Wait(std::vector<uint64_t>* ready_ids) {
+  DCHECK(ready_ids);
+  unsigned to_submit = 0;
+  {
+    sync_primitives::AutoLock auto_lock(lock_);
+    std::swap(to_submit, unsubmitted_);
+  }
+  const int submitted =
+      Enter(ring_fd_, to_submit, 1, IORING_ENTER_GETEVENTS);
+  const int enter_errno = errno;
+
+  sync_primitives::AutoLock auto_lock(lock_);
+  if (submitted < static_cast<int>(to_submit)) {
+    // Rest is submitted by next call
+    unsubmitted_ += to_submit - std::max(submitted, 0);
+  }
+  if (submitted < 0 && EINTR != enter_errno) {
+    errno = enter_errno;
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "io_uring_enter() failed");
+    return false;
+  }
+  unsigned head = *cq_head_;
+  const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    OnCompletion(cqes_[head & cq_mask_], ready_ids);
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  return true;
+}
+
+bool IoUringSocketPoller::Poll(int fd, uint32_t events, uint64_t id,
+                               Request request, bool multishot) {
+  io_uring_sqe* sqe = NextSqe();
+  if (!sqe) {
+    return false;
+  }
+#if __BYTE_ORDER == __BIG_ENDIAN
+  // Kernel takes mask word-reversed
+  events = (events << 16) | (events >> 16);
+#endif
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = events;
+  sqe->len = multishot ? IORING_POLL_ADD_MULTI : 0;
+  sqe->user_data = (id << kRequestBits) | request;
+  CommitSqe();
+  return true;
+}
+
+bool IoUringSocketPoller::RemovePoll(uint64_t id, Request request) {
+  io_uring_sqe* sqe = NextSqe();
+  if (!sqe) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = (id << kRequestBits) | request;
+  sqe->user_data = kRemovalUserData;
+  CommitSqe();
+  return true;
+}
+
+void IoUringSocketPoller::RemoveRequests(WatchedMap::iterator it) {
+  const uint64_t id = it->first;
+  const Watched& watched = it->second;
+  RemovePoll(id, kReadRequest);
+  if (-1 != watched.notify_fd) {
+    RemovePoll(id, kNotifyRequest);
+  }
+  if (watched.write_armed) {
+    RemovePoll(id, kWriteRequest);
+  }
+  watched_.erase(it);
+  // Poll request holds its descriptor open, so removal can not be deferred
+  Submit();
+}
+
+io_uring_sqe* IoUringSocketPoller::NextSqe() {
+  const unsigned tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+    // Queue is full, requests are handed over to kernel first
+    if (!Submit() ||
+        tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+      LOG4CXX_ERROR(logger_, "io_uring requests queue is full");
+      return NULL;
+    }
+  }
+  const unsigned index = tail & sq_mask_;
+  io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  return sqe;
+}
+
+void IoUringSocketPoller::CommitSqe() {
+  __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+  ++unsubmitted_;
+}
+
+bool IoUringSocketPoller::Submit() {
+  if (0 == unsubmitted_) {
+    return true;
+  }
+  const int submitted = Enter(ring_fd_, unsubmitted_, 0, 0);
+  if (submitted < 0) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "io_uring_enter() failed");
+    return false;
+  }
+  unsubmitted_ -= std::min(static_cast<unsigned>(submitted), unsubmitted_);
+  return true;
+}
+
+void IoUringSocketPoller::OnCompletion(const io_uring_cqe& cqe,
+                                       std::vector<uint64_t>* ready_ids) {
+  if (kRemovalUserData == cqe.user_data) {
+    return;
+  }
+  const uint64_t id = cqe.user_data >> kRequestBits;
+  const Request request = static_cast<Request>(cqe.user_data & kRequestMask);
+  WatchedMap::iterator it = watched_.find(id);
+  if (it == watched_.end()) {
+    // Completion of request which has already been removed
+    return;
+  }
+  Watched& watched = it->second;
+  if (kWriteRequest == request) {
+    watched.write_armed = false;
+    if (!watched.write_wanted) {
+      return;
+    }
+  } else if (0 == (cqe.flags & IORING_CQE_F_MORE) &&
+             -ECANCELED != cqe.res) {
+    // Multishot request can be finished by kernel, e.g. on queue overflow.
+    // On failure handler finds descriptor broken by itself.
+    if (kReadRequest == request) {
+      Poll(watched.socket, POLLIN | POLLPRI, id, kReadRequest, true);
+    } else {
+      Poll(watched.notify_fd, POLLIN, id, kNotifyRequest, true);
+    }
+  }
+  // Both descriptors of id are often ready at once
+  if (ready_ids->empty() || ready_ids->back() != id) {
+    ready_ids->push_back(id);
+  }
+}
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
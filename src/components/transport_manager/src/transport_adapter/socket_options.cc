@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transport_manager/transport_adapter/socket_options.h"
+
+#include <sys/socket.h>
+
+#include "config_profile/profile.h"
+#include "utils/logger.h"
+
+namespace transport_manager {
+namespace transport_adapter {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
+
+namespace {
+bool SetOption(int socket, int option, const char* name, uint32_t value) {
+  const int int_value = static_cast<int>(value);
+  if (0 != setsockopt(socket, SOL_SOCKET, option, &int_value,
+                      sizeof(int_value))) {
+    LOG4CXX_WARN_WITH_ERRNO(logger_, "Failed to set " << name << " "
+                            << value << " on socket " << socket);
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+SocketOptions SocketOptions::Bluetooth() {
+  const profile::Profile* profile = profile::Profile::instance();
+  SocketOptions options;
+  options.send_buffer_size =
+      profile->transport_manager_bluetooth_adapter_send_buffer_size();
+  options.receive_buffer_size =
+      profile->transport_manager_bluetooth_adapter_receive_buffer_size();
+  options.priority =
+      profile->transport_manager_bluetooth_adapter_socket_priority();
+  return options;
+}
+
+bool SocketOptions::Apply(int socket) const {
+  bool result = true;
+  if (send_buffer_size > 0) {
+    result &= SetOption(socket, SO_SNDBUF, "SO_SNDBUF", send_buffer_size);
+  }
+  if (receive_buffer_size > 0) {
+    result &= SetOption(socket, SO_RCVBUF, "SO_RCVBUF", receive_buffer_size);
+  }
+  if (priority > 0) {
+    result &= SetOption(socket, SO_PRIORITY, "SO_PRIORITY", priority);
+  }
+  return result;
+}
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transport_manager/transport_adapter/socket_reactor.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+#include "transport_manager/transport_adapter/socket_poller.h"
+#include "utils/logger.h"
+#include "utils/threads/thread.h"
+
+namespace transport_manager {
+namespace transport_adapter {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
+
+namespace {
+// Id of stop pipe events, handlers get ids starting from 1
+const uint64_t kStopId = 0;
+
+SocketPoller* CreatePoller() {
+#ifdef IO_URING_SUPPORT
+  SocketPoller* io_uring_poller = new IoUringSocketPoller();
+  if (io_uring_poller->Init()) {
+    LOG4CXX_INFO(logger_, "Socket reactor is driven by io_uring");
+    return io_uring_poller;
+  }
+  LOG4CXX_WARN(logger_, "io_uring is not available, epoll is used");
+  delete io_uring_poller;
+#endif  // IO_URING_SUPPORT
+#ifdef __linux__
+  SocketPoller* epoll_poller = new EpollSocketPoller();
+  if (epoll_poller->Init()) {
+    return epoll_poller;
+  }
+  delete epoll_poller;
+#endif  // __linux__
+  return NULL;
+}
+}  // namespace
+
+SocketReactor::SocketReactor()
+    : poller_(NULL),
+      stop_read_fd_(-1),
+      stop_write_fd_(-1),
+      stop_requested_(false),
+      last_id_(kStopId),
+      entries_(),
+      entries_lock_(),
+      entry_released_(),
+      thread_(NULL) {
+}
+
+SocketReactor::~SocketReactor() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (thread_) {
+    thread_->join();
+    delete thread_->delegate();
+    threads::DeleteThread(thread_);
+  }
+  if (!entries_.empty()) {
+    LOG4CXX_WARN(logger_, entries_.size() << " handlers left in reactor");
+  }
+  delete poller_;
+  if (-1 != stop_read_fd_) {
+    close(stop_read_fd_);
+  }
+  if (-1 != stop_write_fd_) {
+    close(stop_write_fd_);
+  }
+}
+
+bool SocketReactor::Start() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  DCHECK(NULL == thread_);
+  poller_ = CreatePoller();
+  if (!poller_) {
+    LOG4CXX_ERROR(logger_, "Socket reactor is not supported on this platform");
+    return false;
+  }
+  int fds[2];
+  if (0 != pipe(fds)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "pipe creation failed");
+    return false;
+  }
+  stop_read_fd_ = fds[0];
+  stop_write_fd_ = fds[1];
+  if (!poller_->Watch(kStopId, stop_read_fd_, -1, false)) {
+    LOG4CXX_ERROR(logger_, "Failed to watch stop pipe");
+    return false;
+  }
+  thread_ = threads::CreateThread("SocketReactor", new ReactorDelegate(this));
+  if (!thread_->start()) {
+    LOG4CXX_ERROR(logger_, "Reactor thread start failed");
+    delete thread_->delegate();
+    threads::DeleteThread(thread_);
+    thread_ = NULL;
+    return false;
+  }
+  return true;
+}
+
+bool SocketReactor::Add(Handler* handler, int socket, int notify_fd) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  DCHECK(handler);
+  sync_primitives::AutoLock auto_lock(entries_lock_);
+  if (NULL == thread_) {
+    LOG4CXX_ERROR(logger_, "Reactor is not started");
+    return false;
+  }
+  const uint64_t id = ++last_id_;
+  if (!poller_->Watch(id, socket, notify_fd, handler->IsWriteWanted())) {
+    return false;
+  }
+  const Entry entry = { handler, false };
+  entries_.insert(std::make_pair(id, entry));
+  LOG4CXX_DEBUG(logger_, "Handler " << handler << " added, socket " << socket);
+  return true;
+}
+
+bool SocketReactor::Remove(Handler* handler) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock auto_lock(entries_lock_);
+  Entries::iterator it = Find(handler);
+  while (it != entries_.end() && it->second.busy) {
+    entry_released_.Wait(auto_lock);
+    it = Find(handler);
+  }
+  if (it == entries_.end()) {
+    return false;
+  }
+  poller_->Unwatch(it->first);
+  entries_.erase(it);
+  LOG4CXX_DEBUG(logger_, "Handler " << handler << " removed");
+  return true;
+}
+
+void SocketReactor::Loop() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  std::vector<uint64_t> ready_ids;
+  while (!stop_requested_) {
+    ready_ids.clear();
+    if (!poller_->Wait(&ready_ids)) {
+      break;
+    }
+    for (size_t i = 0; i < ready_ids.size() && !stop_requested_; ++i) {
+      // Stop pipe is never cleared, loop checks the flag
+      if (kStopId != ready_ids[i]) {
+        Serve(ready_ids[i]);
+      }
+    }
+  }
+}
+
+void SocketReactor::Stop() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  stop_requested_ = true;
+  uint8_t c = 0;
+  if (1 != write(stop_write_fd_, &c, 1)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to wake up reactor thread");
+  }
+}
+
+void SocketReactor::Serve(uint64_t id) {
+  Handler* handler = NULL;
+  {
+    sync_primitives::AutoLock auto_lock(entries_lock_);
+    Entries::iterator it = entries_.find(id);
+    if (it == entries_.end()) {
+      // Event was got before handler removal
+      return;
+    }
+    it->second.busy = true;
+    handler = it->second.handler;
+  }
+
+  const bool keep = handler->OnReady();
+
+  sync_primitives::AutoLock auto_lock(entries_lock_);
+  // Remove() waits for busy entries, so entry is still here
+  Entries::iterator it = entries_.find(id);
+  DCHECK(it != entries_.end());
+  if (keep) {
+    poller_->WatchWrite(id, handler->IsWriteWanted());
+    it->second.busy = false;
+  } else {
+    poller_->Unwatch(id);
+    {
+      // Entry stays busy, so Remove() waits until handler is finished
+      sync_primitives::AutoUnlock auto_unlock(auto_lock);
+      handler->OnRemoved();
+    }
+    entries_.erase(id);
+  }
+  entry_released_.Broadcast();
+}
+
+SocketReactor::Entries::iterator SocketReactor::Find(Handler* handler) {
+  Entries::iterator it = entries_.begin();
+  for (; it != entries_.end(); ++it) {
+    if (handler == it->second.handler) {
+      break;
+    }
+  }
+  return it;
+}
+
+SocketReactor::ReactorDelegate::ReactorDelegate(SocketReactor* reactor)
+    : reactor_(reactor) {
+}
+
+void SocketReactor::ReactorDelegate::threadMain() {
+  reactor_->Loop();
+}
+
+void SocketReactor::ReactorDelegate::exitThreadMain() {
+  reactor_->Stop();
+}
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
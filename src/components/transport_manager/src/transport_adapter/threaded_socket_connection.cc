@@ -36,6 +36,10 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <deque>
 
 #include "utils/logger.h"
 #include "utils/threads/thread.h"
@@ -47,6 +51,17 @@ namespace transport_manager {
 namespace transport_adapter {
 CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
 
+namespace {
+// Maximum count of buffers gathered into single sendmsg() call
+const int kMaxSendBuffers = 128;
+// Bytes of frames taken from scheduler for single sendmsg() call,
+// small batches let urgent frames queued meanwhile overtake streaming
+const size_t kMaxSendBatchSize = 64 * 1024;
+// Receive buffer grows while reads fill it, shrinks while they are small
+const size_t kMinReceiveBufferSize = 4 * 1024;
+const size_t kMaxReceiveBufferSize = 256 * 1024;
+}  // namespace
+
 ThreadedSocketConnection::ThreadedSocketConnection(
     const DeviceUID& device_id, const ApplicationHandle& app_handle,
     TransportAdapterController* controller)
@@ -55,23 +70,32 @@ ThreadedSocketConnection::ThreadedSocketConnection(
       controller_(controller),
       frames_to_send_(),
       frames_to_send_mutex_(),
+      frames_in_flight_(),
+      sent_offset_(0),
+      receive_buffer_(),
+      receive_buffer_size_(kMinReceiveBufferSize),
       socket_(-1),
       terminate_flag_(false),
       unexpected_disconnect_(false),
       device_uid_(device_id),
       app_handle_(app_handle),
-      thread_(NULL) {
-  const std::string thread_name = std::string("Socket ") + device_handle();
-  thread_ = threads::CreateThread(thread_name.c_str(),
-                                  new SocketConnectionDelegate(this));
+      thread_(NULL),
+      reactor_(NULL),
+      reactor_handler_(this),
+      setup_done_(false) {
 }
 
 ThreadedSocketConnection::~ThreadedSocketConnection() {
   LOG4CXX_AUTO_TRACE(logger_);
   Disconnect();
-  thread_->join();
-  delete thread_->delegate();
-  threads::DeleteThread(thread_);
+  if (thread_) {
+    thread_->join();
+    delete thread_->delegate();
+    threads::DeleteThread(thread_);
+  } else if (reactor_ && reactor_->Remove(&reactor_handler_)) {
+    LOG4CXX_DEBUG(logger_, "Connection " << this << " removed from reactor");
+    Finish();
+  }
 
   if (-1 != read_fd_) {
     close(read_fd_);
@@ -106,6 +130,24 @@ TransportAdapter::Error ThreadedSocketConnection::Start() {
     return TransportAdapter::FAIL;
   }
 
+  if (reactor_) {
+    // Reactor thread never blocks on the socket
+    if (0 != fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL) | O_NONBLOCK)) {
+      LOG4CXX_ERROR_WITH_ERRNO(logger_, "fcntl failed for socket");
+      return TransportAdapter::FAIL;
+    }
+    if (!reactor_->Add(&reactor_handler_, socket_, read_fd_)) {
+      LOG4CXX_ERROR(logger_, "Failed to add connection to reactor");
+      return TransportAdapter::FAIL;
+    }
+    LOG4CXX_INFO(logger_, "Connection " << this << " is served by reactor");
+    // Connection is set up by reactor thread on first wakeup
+    return Notify();
+  }
+
+  const std::string thread_name = std::string("Socket ") + device_handle();
+  thread_ = threads::CreateThread(thread_name.c_str(),
+                                  new SocketConnectionDelegate(this));
   if (!thread_->start()) {
     LOG4CXX_ERROR(logger_, "thread creation failed");
     return TransportAdapter::FAIL;
@@ -148,7 +190,7 @@ TransportAdapter::Error ThreadedSocketConnection::SendData(
     ::protocol_handler::RawMessagePtr message) {
   LOG4CXX_AUTO_TRACE(logger_);
   sync_primitives::AutoLock auto_lock(frames_to_send_mutex_);
-  frames_to_send_.push(message);
+  frames_to_send_.push(Frame(message));
   return Notify();
 }
 
@@ -159,6 +201,15 @@ TransportAdapter::Error ThreadedSocketConnection::Disconnect() {
 }
 
 void ThreadedSocketConnection::threadMain() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  Setup();
+  while (!terminate_flag_) {
+    Transmit(-1);
+  }
+  Finish();
+}
+
+void ThreadedSocketConnection::Setup() {
   LOG4CXX_AUTO_TRACE(logger_);
   controller_->ConnectionCreated(this, device_uid_, app_handle_);
   ConnectError* connect_error = NULL;
@@ -168,11 +219,17 @@ void ThreadedSocketConnection::threadMain() {
   }
   LOG4CXX_DEBUG(logger_, "Connection established");
   controller_->ConnectDone(device_handle(), application_handle());
-  while (!terminate_flag_) {
-    Transmit();
-  }
+  setup_done_ = true;
+}
+
+void ThreadedSocketConnection::Finish() {
   LOG4CXX_DEBUG(logger_, "Connection is to finalize");
   Finalize();
+  while (!frames_in_flight_.empty()) {
+    controller_->DataSendFailed(device_handle(), application_handle(),
+                                frames_in_flight_.front(), DataSendError());
+    frames_in_flight_.pop_front();
+  }
   sync_primitives::AutoLock auto_lock(frames_to_send_mutex_);
   while (!frames_to_send_.empty()) {
     LOG4CXX_INFO(logger_, "removing message");
@@ -183,19 +240,24 @@ void ThreadedSocketConnection::threadMain() {
   }
 }
 
-void ThreadedSocketConnection::Transmit() {
+bool ThreadedSocketConnection::IsSendPending() const {
+  sync_primitives::AutoLock auto_lock(frames_to_send_mutex_);
+  return !frames_in_flight_.empty() || !frames_to_send_.empty();
+}
+
+void ThreadedSocketConnection::Transmit(int poll_timeout) {
   LOG4CXX_AUTO_TRACE(logger_);
 
   const nfds_t kPollFdsSize = 2;
   pollfd poll_fds[kPollFdsSize];
   poll_fds[0].fd = socket_;
   poll_fds[0].events = POLLIN | POLLPRI
-      | (frames_to_send_.empty() ? 0 : POLLOUT);
+      | (IsSendPending() ? POLLOUT : 0);
   poll_fds[1].fd = read_fd_;
   poll_fds[1].events = POLLIN | POLLPRI;
 
   LOG4CXX_DEBUG(logger_, "poll " << this);
-  if (-1 == poll(poll_fds, kPollFdsSize, -1)) {
+  if (-1 == poll(poll_fds, kPollFdsSize, poll_timeout)) {
     LOG4CXX_ERROR_WITH_ERRNO(logger_, "poll failed for connection " << this);
     Abort();
     return;
@@ -232,7 +294,7 @@ void ThreadedSocketConnection::Transmit() {
   }
 
   // send data if possible
-  if (!frames_to_send_.empty() && (poll_fds[0].revents | POLLOUT)) {
+  if (IsSendPending() && (poll_fds[0].revents | POLLOUT)) {
     LOG4CXX_DEBUG(logger_, "frames_to_send_ not empty() ");
 
     // send data
@@ -257,70 +319,211 @@ void ThreadedSocketConnection::Transmit() {
 
 bool ThreadedSocketConnection::Receive() {
   LOG4CXX_AUTO_TRACE(logger_);
-  uint8_t buffer[4096];
+  // Everything read within one wakeup is passed on as a single frame,
+  // unless buffer is exhausted earlier
+  size_t bytes_received = 0;
+  size_t total_bytes_read = 0;
   ssize_t bytes_read = -1;
+  bool result = true;
 
   do {
-    bytes_read = recv(socket_, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (receive_buffer_.empty()) {
+      receive_buffer_ = ReceiveBufferPool().Allocate(receive_buffer_size_);
+      if (receive_buffer_.empty()) {
+        LOG4CXX_ERROR(logger_, "Failed to allocate receive buffer for "
+                      "connection " << this);
+        return false;
+      }
+    }
+    bytes_read = recv(socket_, receive_buffer_.data() + bytes_received,
+                      receive_buffer_.size() - bytes_received, MSG_DONTWAIT);
 
     if (bytes_read > 0) {
       LOG4CXX_DEBUG(
           logger_,
           "Received " << bytes_read << " bytes for connection " << this);
-      ::protocol_handler::RawMessagePtr frame(
-          new protocol_handler::RawMessage(0, 0, buffer, bytes_read));
-      controller_->DataReceiveDone(device_handle(), application_handle(),
-                                   frame);
+      bytes_received += bytes_read;
+      total_bytes_read += bytes_read;
+      if (bytes_received == receive_buffer_.size()) {
+        ReceiveDone(bytes_received);
+        bytes_received = 0;
+      }
     } else if (bytes_read < 0) {
       if (EAGAIN != errno && EWOULDBLOCK != errno) {
         LOG4CXX_ERROR_WITH_ERRNO(logger_,
                                  "recv() failed for connection " << this);
-        return false;
+        result = false;
       }
     } else {
       LOG4CXX_WARN(logger_, "Connection " << this << " closed by remote peer");
-      return false;
+      result = false;
     }
   } while (bytes_read > 0);
 
-  return true;
+  // Data read before failure is still delivered
+  if (bytes_received > 0) {
+    ReceiveDone(bytes_received);
+  }
+  // Next buffers are sized by amount of data read per wakeup
+  if (total_bytes_read >= receive_buffer_size_) {
+    receive_buffer_size_ =
+        std::min(receive_buffer_size_ * 2, kMaxReceiveBufferSize);
+  } else if (total_bytes_read < receive_buffer_size_ / 4) {
+    receive_buffer_size_ =
+        std::max(receive_buffer_size_ / 2, kMinReceiveBufferSize);
+  }
+  return result;
+}
+
+void ThreadedSocketConnection::ReceiveDone(size_t bytes_received) {
+  DCHECK(bytes_received <= receive_buffer_.size());
+  ::protocol_handler::RawMessagePtr frame =
+      utils::MakeShared<protocol_handler::RawMessage>(
+          0, 0, receive_buffer_.Slice(0, bytes_received));
+  // Frame owns received bytes now, next reads go after them
+  receive_buffer_ = receive_buffer_.Slice(
+      bytes_received, receive_buffer_.size() - bytes_received);
+  controller_->DataReceiveDone(device_handle(), application_handle(), frame);
 }
 
 bool ThreadedSocketConnection::Send() {
   LOG4CXX_AUTO_TRACE(logger_);
-  FrameQueue frames_to_send;
+  // Frames queued during sending are left for the next call,
+  // so receiving is not blocked by endless stream
   frames_to_send_mutex_.Acquire();
-  std::swap(frames_to_send, frames_to_send_);
+  size_t frames_left = frames_to_send_.size();
   frames_to_send_mutex_.Release();
 
-  size_t offset = 0;
-  while (!frames_to_send.empty()) {
+  // Bytes of frames in flight not sent yet
+  size_t bytes_unsent = 0;
+  for (std::deque< ::protocol_handler::RawMessagePtr>::const_iterator it =
+       frames_in_flight_.begin(); it != frames_in_flight_.end(); ++it) {
+    bytes_unsent += (*it)->data_size();
+  }
+  bytes_unsent -= sent_offset_;
+
+  while (frames_left > 0 || !frames_in_flight_.empty()) {
+    // Frames in flight are topped up rather than drained first,
+    // so rest of partially sent batch goes out with following frames
+    if (frames_left > 0 && bytes_unsent < kMaxSendBatchSize) {
+      sync_primitives::AutoLock auto_lock(frames_to_send_mutex_);
+      while (frames_left > 0 && !frames_to_send_.empty() &&
+             bytes_unsent < kMaxSendBatchSize) {
+        frames_in_flight_.push_back(frames_to_send_.front());
+        frames_to_send_.pop();
+        bytes_unsent += frames_in_flight_.back()->data_size();
+        --frames_left;
+      }
+    }
+    if (frames_in_flight_.empty()) {
+      break;
+    }
     LOG4CXX_INFO(logger_, "frames_to_send is not empty");
-    ::protocol_handler::RawMessagePtr frame = frames_to_send.front();
-    const ssize_t bytes_sent = ::send(socket_, frame->data() + offset,
-                                      frame->data_size() - offset, 0);
-
-    if (bytes_sent >= 0) {
-      LOG4CXX_DEBUG(logger_, "bytes_sent >= 0");
-      offset += bytes_sent;
-      if (offset == frame->data_size()) {
-        frames_to_send.pop();
-        offset = 0;
-        controller_->DataSendDone(device_handle(), application_handle(), frame);
+    // Fragments of several frames are sent by single system call
+    // straight from their storage, without merging
+    iovec buffers[kMaxSendBuffers];
+    int buffers_count = 0;
+    size_t skip = sent_offset_;
+    for (std::deque< ::protocol_handler::RawMessagePtr>::const_iterator it =
+         frames_in_flight_.begin();
+         it != frames_in_flight_.end() && buffers_count < kMaxSendBuffers;
+         ++it) {
+      const ::protocol_handler::RawMessagePtr& frame = *it;
+      for (size_t i = 0; i < frame->fragments_count() &&
+           buffers_count < kMaxSendBuffers; ++i) {
+        const utils::BufferSlice& fragment = frame->fragment(i);
+        if (skip >= fragment.size()) {
+          skip -= fragment.size();
+          continue;
+        }
+        buffers[buffers_count].iov_base = fragment.data() + skip;
+        buffers[buffers_count].iov_len = fragment.size() - skip;
+        ++buffers_count;
+        skip = 0;
       }
-    } else {
+    }
+
+    // Unlike writev() it does not raise SIGPIPE when peer has gone
+    msghdr message_header;
+    memset(&message_header, 0, sizeof(message_header));
+    message_header.msg_iov = buffers;
+    message_header.msg_iovlen = buffers_count;
+    const ssize_t bytes_sent =
+        ::sendmsg(socket_, &message_header, MSG_NOSIGNAL);
+    if (bytes_sent < 0 && (EAGAIN == errno || EWOULDBLOCK == errno)) {
+      // Non-blocking socket is full, the rest is sent when it is writable
+      LOG4CXX_DEBUG(logger_, "Socket of connection " << this << " is full");
+      break;
+    }
+    if (bytes_sent < 0) {
       LOG4CXX_DEBUG(logger_, "bytes_sent < 0");
       LOG4CXX_ERROR_WITH_ERRNO(logger_, "Send failed for connection " << this);
-      frames_to_send.pop();
-      offset = 0;
+      ::protocol_handler::RawMessagePtr frame = frames_in_flight_.front();
+      frames_in_flight_.pop_front();
+      bytes_unsent -= frame->data_size() - sent_offset_;
+      sent_offset_ = 0;
       controller_->DataSendFailed(device_handle(), application_handle(), frame,
                                   DataSendError());
+      continue;
+    }
+
+    LOG4CXX_DEBUG(logger_, "bytes_sent >= 0");
+    sent_offset_ += bytes_sent;
+    bytes_unsent -= bytes_sent;
+    while (!frames_in_flight_.empty() &&
+           sent_offset_ >= frames_in_flight_.front()->data_size()) {
+      ::protocol_handler::RawMessagePtr frame = frames_in_flight_.front();
+      frames_in_flight_.pop_front();
+      sent_offset_ -= frame->data_size();
+      controller_->DataSendDone(device_handle(), application_handle(), frame);
     }
   }
 
   return true;
 }
 
+bool ThreadedSocketConnection::Frame::IsUrgent() const {
+  const ::protocol_handler::ServiceType service_type = get()->service_type();
+  return ::protocol_handler::kControl == service_type ||
+         ::protocol_handler::kRpc == service_type;
+}
+
+uint64_t ThreadedSocketConnection::Frame::FlowId() const {
+  // Connection is not aware of sessions, services are shared fairly
+  return get()->service_type();
+}
+
+size_t ThreadedSocketConnection::Frame::Cost() const {
+  return get()->data_size();
+}
+
+ThreadedSocketConnection::ReactorHandler::ReactorHandler(
+    ThreadedSocketConnection* connection)
+    : connection_(connection) {
+}
+
+bool ThreadedSocketConnection::ReactorHandler::OnReady() {
+  DCHECK(connection_);
+  if (!connection_->setup_done_) {
+    connection_->Setup();
+  }
+  if (!connection_->terminate_flag_) {
+    // Reactor has already waited, just take ready events
+    connection_->Transmit(0);
+  }
+  return !connection_->terminate_flag_;
+}
+
+bool ThreadedSocketConnection::ReactorHandler::IsWriteWanted() const {
+  DCHECK(connection_);
+  return connection_->IsSendPending();
+}
+
+void ThreadedSocketConnection::ReactorHandler::OnRemoved() {
+  DCHECK(connection_);
+  connection_->Finish();
+}
+
 ThreadedSocketConnection::SocketConnectionDelegate::SocketConnectionDelegate(
     ThreadedSocketConnection* connection)
     : connection_(connection) {
@@ -44,6 +44,36 @@ namespace transport_adapter {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
 
+namespace {
+// Receive buffers of sizes up to 256K are reused, up to 4M is kept free
+const size_t kMinReceiveBlockSize = 4 * 1024;
+const size_t kMaxReceiveBlockSize = 256 * 1024;
+const size_t kMaxCachedReceiveBytes = 4 * 1024 * 1024;
+
+// Device list is changed if devices are added, removed or renamed
+bool IsDeviceListChanged(const DeviceMap& old_devices,
+                         const DeviceMap& new_devices) {
+  if (old_devices.size() != new_devices.size()) {
+    return true;
+  }
+  for (DeviceMap::const_iterator it = new_devices.begin();
+       it != new_devices.end(); ++it) {
+    DeviceMap::const_iterator old_device = old_devices.find(it->first);
+    if (old_devices.end() == old_device ||
+        old_device->second->name() != it->second->name()) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+utils::BufferPool& ReceiveBufferPool() {
+  static utils::BufferPool pool(kMinReceiveBlockSize, kMaxReceiveBlockSize,
+                                kMaxCachedReceiveBytes);
+  return pool;
+}
+
 TransportAdapterImpl::TransportAdapterImpl(
   DeviceScanner* device_scanner,
   ServerConnectionFactory* server_connection_factory,
@@ -414,12 +444,16 @@ void TransportAdapterImpl::SearchDeviceDone(const DeviceVector& devices) {
       }
     }
   }
+  const bool device_list_changed = IsDeviceListChanged(devices_, all_devices);
   devices_ = all_devices;
   devices_mutex_.Release();
 
+  // Repeated search finding the same devices makes no work for listeners
   for (TransportAdapterListenerList::iterator it = listeners_.begin();
        it != listeners_.end(); ++it) {
-    (*it)->OnDeviceListUpdated(this);
+    if (device_list_changed) {
+      (*it)->OnDeviceListUpdated(this);
+    }
     (*it)->OnSearchDeviceDone(this);
   }
 
@@ -765,6 +799,14 @@ std::string TransportAdapterImpl::GetConnectionType() const {
   return result;
 }
 
+size_t TransportAdapterImpl::GetMaximumFrameSize() const {
+  return 0;
+}
+
+uint32_t TransportAdapterImpl::GetReconnectGracePeriod() const {
+  return 0;
+}
+
 #ifdef TIME_TESTER
 void TransportAdapterImpl::SetTimeMetricObserver(TMMetricObserver* observer) {
   metric_observer_ = observer;
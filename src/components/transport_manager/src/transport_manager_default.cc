@@ -37,6 +37,7 @@
 
 #include "transport_manager/transport_manager_default.h"
 #include "transport_manager/tcp/tcp_transport_adapter.h"
+#include "transport_manager/replay/replay_transport_adapter.h"
 #include "utils/logger.h"
 
 #ifdef BLUETOOTH_SUPPORT
@@ -93,7 +94,19 @@ int TransportManagerDefault::Init() {
   AddTransportAdapter(ta);
 #endif  // USB_SUPPORT
 
-
+  const std::string& replay_file =
+      profile::Profile::instance()->transport_manager_replay_capture_file();
+  if (!replay_file.empty()) {
+    ta = new transport_adapter::ReplayTransportAdapter(
+        replay_file,
+        profile::Profile::instance()->transport_manager_replay_real_time());
+#ifdef TIME_TESTER
+    if (metric_observer_) {
+      ta->SetTimeMetricObserver(metric_observer_);
+    }
+#endif  // TIME_TESTER
+    AddTransportAdapter(ta);
+  }
 
   LOG4CXX_TRACE(logger_, "exit with E_SUCCESS");
   return E_SUCCESS;
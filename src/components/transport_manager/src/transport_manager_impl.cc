@@ -167,6 +167,14 @@ int TransportManagerImpl::Disconnect(const ConnectionUID& cid) {
     return E_INVALID_HANDLE;
   }
 
+  if (connection->standby) {
+    // There is no link to disconnect, just stop waiting for reconnect
+    connection->standby_timer->stop();
+    connection->StandbyExpiredRoutine();
+    LOG4CXX_TRACE(logger_, "exit with E_SUCCESS. Condition: connection->standby");
+    return E_SUCCESS;
+  }
+
   connection->transport_adapter->Disconnect(connection->device,
       connection->application);
   // TODO(dchmerev@luxoft.com): Return disconnect timeout
@@ -207,7 +215,7 @@ int TransportManagerImpl::DisconnectForce(const ConnectionUID& cid) {
     return E_TM_IS_NOT_INITIALIZED;
   }
   sync_primitives::AutoReadLock lock(connections_lock_);
-  const ConnectionInternal* connection = GetConnection(cid);
+  ConnectionInternal* connection = GetConnection(cid);
   if (NULL == connection) {
     LOG4CXX_ERROR(
       logger_,
@@ -215,6 +223,12 @@ int TransportManagerImpl::DisconnectForce(const ConnectionUID& cid) {
     LOG4CXX_TRACE(logger_, "exit with E_INVALID_HANDLE. Condition: NULL == connection");
     return E_INVALID_HANDLE;
   }
+  if (connection->standby) {
+    connection->standby_timer->stop();
+    connection->StandbyExpiredRoutine();
+    LOG4CXX_TRACE(logger_, "exit with E_SUCCESS. Condition: connection->standby");
+    return E_SUCCESS;
+  }
   connection->transport_adapter->Disconnect(connection->device,
       connection->application);
   LOG4CXX_TRACE(logger_, "exit with E_SUCCESS");
@@ -285,6 +299,7 @@ int TransportManagerImpl::SendMessageToDevice(const ::protocol_handler::RawMessa
     return E_TM_IS_NOT_INITIALIZED;
   }
 
+  uint32_t send_weight = 1;
   {
   sync_primitives::AutoReadLock lock(connections_lock_);
   const ConnectionInternal* connection = GetConnection(message->connection_key());
@@ -301,13 +316,17 @@ int TransportManagerImpl::SendMessageToDevice(const ::protocol_handler::RawMessa
                   "exit with E_CONNECTION_IS_TO_SHUTDOWN. Condition: connection->shutDown");
     return E_CONNECTION_IS_TO_SHUTDOWN;
   }
+  send_weight = connection->send_weight;
   }
 #ifdef TIME_TESTER
   if (metric_observer_) {
     metric_observer_->StartRawMsg(message.get());
   }
 #endif  // TIME_TESTER
-  this->PostMessage(message);
+  if (traffic_capture_.is_open()) {
+    traffic_capture_.Record(kTrafficOutbound, *message);
+  }
+  this->PostMessage(message, send_weight);
   LOG4CXX_TRACE(logger_, "exit with E_SUCCESS");
   return E_SUCCESS;
 }
@@ -426,6 +445,11 @@ int TransportManagerImpl::SearchDevices() {
 
 int TransportManagerImpl::Init() {
   LOG4CXX_TRACE(logger_, "enter");
+  const std::string& capture_file =
+      profile::Profile::instance()->transport_manager_traffic_capture_file();
+  if (!capture_file.empty() && !traffic_capture_.is_open()) {
+    traffic_capture_.Open(capture_file);
+  }
   is_initialized_ = true;
   LOG4CXX_TRACE(logger_, "exit with E_SUCCESS");
   return E_SUCCESS;
@@ -468,7 +492,7 @@ int TransportManagerImpl::Visibility(const bool& on_off) const {
   return E_SUCCESS;
 }
 
-void TransportManagerImpl::UpdateDeviceList(TransportAdapter* ta) {
+bool TransportManagerImpl::UpdateDeviceList(TransportAdapter* ta) {
   LOG4CXX_TRACE(logger_, "enter. TransportAdapter: " << ta);
   std::set<DeviceInfo> old_devices;
   std::set<DeviceInfo> new_devices;
@@ -501,6 +525,7 @@ void TransportManagerImpl::UpdateDeviceList(TransportAdapter* ta) {
   for (std::set<DeviceInfo>::const_iterator it = added_devices.begin();
        it != added_devices.end();
        ++it) {
+    RaiseEvent(&TransportManagerListener::OnDeviceFound, *it);
     RaiseEvent(&TransportManagerListener::OnDeviceAdded, *it);
   }
 
@@ -514,12 +539,31 @@ void TransportManagerImpl::UpdateDeviceList(TransportAdapter* ta) {
        ++it) {
     RaiseEvent(&TransportManagerListener::OnDeviceRemoved, *it);
   }
-  LOG4CXX_TRACE(logger_, "exit");
+
+  // Devices are ordered by handle, so kept ones are matched in one pass
+  size_t changed_devices_count = 0;
+  std::set<DeviceInfo>::const_iterator old_device = old_devices.begin();
+  for (std::set<DeviceInfo>::const_iterator it = new_devices.begin();
+       it != new_devices.end(); ++it) {
+    while (old_device != old_devices.end() && *old_device < *it) {
+      ++old_device;
+    }
+    if (old_device != old_devices.end() && !(*it < *old_device) &&
+        !(*it == *old_device)) {
+      RaiseEvent(&TransportManagerListener::OnDeviceChanged, *it);
+      ++changed_devices_count;
+    }
+  }
+  const bool result = !added_devices.empty() || !removed_devices.empty() ||
+                      changed_devices_count > 0;
+  LOG4CXX_TRACE(logger_, "exit with " << (result ? "TRUE" : "FALSE"));
+  return result;
 }
 
-void TransportManagerImpl::PostMessage(const ::protocol_handler::RawMessagePtr message) {
+void TransportManagerImpl::PostMessage(const ::protocol_handler::RawMessagePtr message,
+                                       uint32_t send_weight) {
   LOG4CXX_TRACE(logger_, "enter. RawMessageSptr: " << message);
-  message_queue_.PostMessage(message);
+  message_queue_.PostMessage(OutgoingFrame(message, send_weight));
   LOG4CXX_TRACE(logger_, "exit");
 }
 
@@ -529,53 +573,142 @@ void TransportManagerImpl::PostEvent(const TransportAdapterEvent& event) {
   event_queue_.PostMessage(event);
 }
 
-void TransportManagerImpl::AddConnection(const ConnectionInternal& c) {
+void TransportManagerImpl::AddConnection(ConnectionInternal* c) {
   LOG4CXX_AUTO_TRACE(logger_);
-  LOG4CXX_DEBUG(logger_, "ConnectionInternal: " << &c);
+  DCHECK(c);
+  LOG4CXX_DEBUG(logger_, "ConnectionInternal: " << c);
   sync_primitives::AutoWriteLock lock(connections_lock_);
-  connections_.push_back(c);
+  connections_[c->id] = ConnectionInternalSPtr(c);
+  // Newer connection of the same application hides the outdated one
+  connections_index_[std::make_pair(c->device, c->application)] = c;
 }
 
 void TransportManagerImpl::RemoveConnection(uint32_t id) {
   LOG4CXX_AUTO_TRACE(logger_);
   LOG4CXX_DEBUG(logger_, "Id: " << id);
   sync_primitives::AutoWriteLock lock(connections_lock_);
-  for (std::vector<ConnectionInternal>::iterator it = connections_.begin();
-       it != connections_.end(); ++it) {
-    if (it->id == id) {
-      connections_.erase(it);
-      break;
-    }
+  ConnectionMap::iterator it = connections_.find(id);
+  if (connections_.end() == it) {
+    return;
+  }
+  DeviceApplicationIndex::iterator index_it = connections_index_.find(
+      std::make_pair(it->second->device, it->second->application));
+  if (connections_index_.end() != index_it &&
+      index_it->second == it->second.get()) {
+    connections_index_.erase(index_it);
   }
+  connections_.erase(it);
 }
 
 TransportManagerImpl::ConnectionInternal* TransportManagerImpl::GetConnection(
   const ConnectionUID& id) {
   LOG4CXX_AUTO_TRACE(logger_);
-  LOG4CXX_DEBUG(logger_, "ConnectionUID: " << &id);
-  for (std::vector<ConnectionInternal>::iterator it = connections_.begin();
-       it != connections_.end(); ++it) {
-    if (it->id == id) {
-      LOG4CXX_DEBUG(logger_, "ConnectionInternal. It's address: " << &*it);
-      return &*it;
-    }
+  LOG4CXX_DEBUG(logger_, "ConnectionUID: " << id);
+  ConnectionMap::const_iterator it = connections_.find(id);
+  if (connections_.end() == it) {
+    return NULL;
   }
-  return NULL;
+  LOG4CXX_DEBUG(logger_, "ConnectionInternal. It's address: " << it->second.get());
+  return it->second.get();
 }
 
 TransportManagerImpl::ConnectionInternal* TransportManagerImpl::GetConnection(
   const DeviceUID& device, const ApplicationHandle& application) {
   LOG4CXX_AUTO_TRACE(logger_);
-  LOG4CXX_DEBUG(logger_, "DeviceUID: " << &device << "ApplicationHandle: " <<
-                &application);
-  for (std::vector<ConnectionInternal>::iterator it = connections_.begin();
-       it != connections_.end(); ++it) {
-    if (it->device == device && it->application == application) {
-      LOG4CXX_DEBUG(logger_, "ConnectionInternal. It's address: " << &*it);
-      return &*it;
+  LOG4CXX_DEBUG(logger_, "DeviceUID: " << device << " ApplicationHandle: " <<
+                application);
+  DeviceApplicationIndex::const_iterator it =
+      connections_index_.find(std::make_pair(device, application));
+  if (connections_index_.end() == it) {
+    return NULL;
+  }
+  LOG4CXX_DEBUG(logger_, "ConnectionInternal. It's address: " << it->second);
+  return it->second;
+}
+
+bool TransportManagerImpl::StartStandby(ConnectionInternal* connection) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  DCHECK(connection);
+  const uint32_t grace_period =
+      connection->transport_adapter->GetReconnectGracePeriod();
+  if (0 == grace_period) {
+    return false;
+  }
+  LOG4CXX_INFO(logger_, "Connection " << connection->id << " waits "
+               << grace_period << "s for device " << connection->device
+               << " to reconnect");
+  connection->standby = true;
+  connection->standby_expired = false;
+  connection->standby_timer->start(grace_period);
+  return true;
+}
+
+bool TransportManagerImpl::RestoreConnection(
+    const TransportAdapterEvent& event) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  ConnectionUID connection_id = 0;
+  std::vector< ::protocol_handler::RawMessagePtr> failed_messages;
+  {
+    sync_primitives::AutoWriteLock lock(connections_lock_);
+    ConnectionInternal* connection = NULL;
+    for (ConnectionMap::iterator it = connections_.begin();
+         it != connections_.end(); ++it) {
+      ConnectionInternal* candidate = it->second.get();
+      if (candidate->standby && !candidate->standby_expired &&
+          candidate->transport_adapter == event.transport_adapter &&
+          candidate->device == event.device_uid) {
+        connection = candidate;
+        break;
+      }
+    }
+    if (NULL == connection) {
+      return false;
+    }
+    connection->standby_timer->stop();
+    if (connection->standby_expired) {
+      // Expiration is already posted, connection is to be closed
+      return false;
+    }
+    DeviceApplicationIndex::iterator index_it = connections_index_.find(
+        std::make_pair(connection->device, connection->application));
+    if (connections_index_.end() != index_it &&
+        index_it->second == connection) {
+      connections_index_.erase(index_it);
+    }
+    connection->application = event.application_id;
+    connections_index_[std::make_pair(connection->device,
+                                      connection->application)] = connection;
+    connection->standby = false;
+    connection_id = connection->id;
+
+    // Kept messages go first, new ones wait for the lock being released
+    std::vector< ::protocol_handler::RawMessagePtr> standby_messages;
+    {
+      sync_primitives::AutoLock standby_lock(connection->standby_messages_lock);
+      standby_messages.swap(connection->standby_messages);
+    }
+    for (std::vector< ::protocol_handler::RawMessagePtr>::const_iterator it =
+         standby_messages.begin(); it != standby_messages.end(); ++it) {
+      if (TransportAdapter::OK != connection->transport_adapter->SendData(
+              connection->device, connection->application, *it)) {
+        failed_messages.push_back(*it);
+      }
     }
   }
-  return NULL;
+  for (std::vector< ::protocol_handler::RawMessagePtr>::const_iterator it =
+       failed_messages.begin(); it != failed_messages.end(); ++it) {
+    RaiseEvent(&TransportManagerListener::OnTMMessageSendFailed,
+               DataSendError("Send failed"), *it);
+  }
+  LOG4CXX_INFO(logger_, "Connection " << connection_id << " is restored");
+  RaiseEvent(&TransportManagerListener::OnConnectionRestored,
+             DeviceInfo(converter_.UidToHandle(event.device_uid),
+                        event.device_uid,
+                        event.transport_adapter->DeviceName(event.device_uid),
+                        event.transport_adapter->GetConnectionType(),
+                        event.transport_adapter->GetMaximumFrameSize()),
+             connection_id);
+  return true;
 }
 
 void TransportManagerImpl::OnDeviceListUpdated(TransportAdapter* ta) {
@@ -587,11 +720,13 @@ void TransportManagerImpl::OnDeviceListUpdated(TransportAdapter* ta) {
     device_to_adapter_map_lock_.AcquireForWriting();
     device_to_adapter_map_.insert(std::make_pair(*it, ta));
     device_to_adapter_map_lock_.Release();
-    DeviceHandle device_handle = converter_.UidToHandle(*it);
-    DeviceInfo info(device_handle, *it, ta->DeviceName(*it), ta->GetConnectionType());
-    RaiseEvent(&TransportManagerListener::OnDeviceFound, info);
   }
-  UpdateDeviceList(ta);
+  // Whole list is raised only if it differs, listeners get the
+  // difference itself from per device events
+  if (!UpdateDeviceList(ta)) {
+    LOG4CXX_TRACE(logger_, "exit. Condition: device list is not changed");
+    return;
+  }
   std::vector<DeviceInfo> device_infos;
   device_list_lock_.AcquireForReading();
   for (DeviceInfoList::const_iterator it = device_list_.begin();
@@ -603,8 +738,62 @@ void TransportManagerImpl::OnDeviceListUpdated(TransportAdapter* ta) {
   LOG4CXX_TRACE(logger_, "exit");
 }
 
+void TransportManagerImpl::HandleBatch(
+    std::queue<TransportAdapterEvent>* events) {
+  while (!events->empty()) {
+    Handle(events->front());
+    events->pop();
+  }
+  RaiseReceivedMessages();
+}
+
+void TransportManagerImpl::RaiseReceivedMessages() {
+  if (received_events_.empty()) {
+    return;
+  }
+  ::protocol_handler::RawMessageList messages;
+  messages.reserve(received_events_.size());
+  {
+    sync_primitives::AutoReadLock lock(connections_lock_);
+    for (std::vector<TransportAdapterEvent>::const_iterator it =
+         received_events_.begin(); it != received_events_.end(); ++it) {
+      ConnectionInternal* connection =
+          GetConnection(it->device_uid, it->application_id);
+      if (connection == NULL) {
+        LOG4CXX_ERROR(logger_, "Connection ('" << it->device_uid << ", "
+                      << it->application_id
+                      << ") not found");
+        continue;
+      }
+      it->event_data->set_connection_key(connection->id);
+      if (traffic_capture_.is_open()) {
+        traffic_capture_.Record(kTrafficInbound, *it->event_data);
+      }
+      messages.push_back(it->event_data);
+    }
+  }
+  received_events_.clear();
+#ifdef TIME_TESTER
+  if (metric_observer_) {
+    for (::protocol_handler::RawMessageList::const_iterator it =
+         messages.begin(); it != messages.end(); ++it) {
+      metric_observer_->StopRawMsg(it->get());
+    }
+  }
+#endif  // TIME_TESTER
+  if (!messages.empty()) {
+    LOG4CXX_DEBUG(logger_, "Raise " << messages.size() << " received messages");
+    RaiseEvent(&TransportManagerListener::OnTMMessagesReceived, messages);
+  }
+}
+
 void TransportManagerImpl::Handle(TransportAdapterEvent event) {
   LOG4CXX_TRACE(logger_, "enter");
+  if (TransportAdapterListenerImpl::EventTypeEnum::ON_RECEIVED_DONE !=
+      event.event_type) {
+    // Keep order of received data and other events of the connection
+    RaiseReceivedMessages();
+  }
   switch (event.event_type) {
     case TransportAdapterListenerImpl::EventTypeEnum::ON_SEARCH_DONE: {
       RaiseEvent(&TransportManagerListener::OnScanDevicesFinished);
@@ -629,14 +818,21 @@ void TransportManagerImpl::Handle(TransportAdapterEvent event) {
       break;
     }
     case TransportAdapterListenerImpl::EventTypeEnum::ON_CONNECT_DONE: {
+      if (RestoreConnection(event)) {
+        LOG4CXX_DEBUG(logger_, "event_type = ON_CONNECT_DONE, connection restored");
+        break;
+      }
       const DeviceHandle device_handle = converter_.UidToHandle(event.device_uid);
-      AddConnection(ConnectionInternal(this, event.transport_adapter, ++connection_id_counter_,
-                                       event.device_uid, event.application_id,
-                                       device_handle));
+      AddConnection(new ConnectionInternal(this, event.transport_adapter,
+                                           ++connection_id_counter_,
+                                           event.device_uid,
+                                           event.application_id,
+                                           device_handle));
       RaiseEvent(&TransportManagerListener::OnConnectionEstablished,
                  DeviceInfo(device_handle, event.device_uid,
                                 event.transport_adapter->DeviceName(event.device_uid),
-                                event.transport_adapter->GetConnectionType()),
+                                event.transport_adapter->GetConnectionType(),
+                                event.transport_adapter->GetMaximumFrameSize()),
                  connection_id_counter_);
       LOG4CXX_DEBUG(logger_, "event_type = ON_CONNECT_DONE");
       break;
@@ -736,26 +932,8 @@ void TransportManagerImpl::Handle(TransportAdapterEvent event) {
       break;
     }
     case TransportAdapterListenerImpl::EventTypeEnum::ON_RECEIVED_DONE: {
-      {
-      sync_primitives::AutoReadLock lock(connections_lock_);
-      ConnectionInternal* connection =
-          GetConnection(event.device_uid, event.application_id);
-      if (connection == NULL) {
-        LOG4CXX_ERROR(logger_, "Connection ('" << event.device_uid << ", "
-                      << event.application_id
-                      << ") not found");
-        LOG4CXX_DEBUG(logger_,
-                      "event_type = ON_RECEIVED_DONE. Condition: NULL == connection");
-        break;
-      }
-      event.event_data->set_connection_key(connection->id);
-      }
-#ifdef TIME_TESTER
-      if (metric_observer_) {
-        metric_observer_->StopRawMsg(event.event_data.get());
-      }
-#endif  // TIME_TESTER
-      RaiseEvent(&TransportManagerListener::OnTMMessageReceived, event.event_data);
+      // Passed to listeners with the rest of the batch
+      received_events_.push_back(event);
       LOG4CXX_DEBUG(logger_, "event_type = ON_RECEIVED_DONE");
       break;
     }
@@ -784,12 +962,32 @@ void TransportManagerImpl::Handle(TransportAdapterEvent event) {
       break;
     }
     case TransportAdapterListenerImpl::EventTypeEnum::ON_UNEXPECTED_DISCONNECT: {
-      connections_lock_.AcquireForReading();
+      connections_lock_.AcquireForWriting();
       ConnectionInternal* connection =
           GetConnection(event.device_uid, event.application_id);
       if (connection) {
+        if (connection->standby && !connection->standby_expired) {
+          connections_lock_.Release();
+          LOG4CXX_DEBUG(logger_, "Connection is already waiting for reconnect");
+          break;
+        }
+        if (!connection->standby && StartStandby(connection)) {
+          connections_lock_.Release();
+          LOG4CXX_DEBUG(logger_, "eevent_type = ON_UNEXPECTED_DISCONNECT, standby");
+          break;
+        }
         const ConnectionUID id = connection->id;
+        std::vector< ::protocol_handler::RawMessagePtr> standby_messages;
+        {
+          sync_primitives::AutoLock lock(connection->standby_messages_lock);
+          standby_messages.swap(connection->standby_messages);
+        }
         connections_lock_.Release();
+        for (std::vector< ::protocol_handler::RawMessagePtr>::const_iterator it =
+             standby_messages.begin(); it != standby_messages.end(); ++it) {
+          RaiseEvent(&TransportManagerListener::OnTMMessageSendFailed,
+                     DataSendError("Connection is lost"), *it);
+        }
         RaiseEvent(&TransportManagerListener::OnUnexpectedDisconnect,
                    id,
                    *static_cast<CommunicationError*>(event.event_error.get()));
@@ -813,8 +1011,9 @@ void TransportManagerImpl::SetTimeMetricObserver(TMMetricObserver* observer) {
 }
 #endif  // TIME_TESTER
 
-void TransportManagerImpl::Handle(::protocol_handler::RawMessagePtr msg) {
+void TransportManagerImpl::Handle(const OutgoingFrame frame) {
   LOG4CXX_TRACE(logger_, "enter");
+  const ::protocol_handler::RawMessagePtr msg = frame;
   sync_primitives::AutoReadLock lock(connections_lock_);
   ConnectionInternal* connection = GetConnection(msg->connection_key());
   if (connection == NULL) {
@@ -824,6 +1023,14 @@ void TransportManagerImpl::Handle(::protocol_handler::RawMessagePtr msg) {
     return;
   }
 
+  if (connection->standby) {
+    LOG4CXX_DEBUG(logger_, "Connection " << msg->connection_key()
+                  << " waits for reconnect, message is kept");
+    sync_primitives::AutoLock standby_lock(connection->standby_messages_lock);
+    connection->standby_messages.push_back(msg);
+    return;
+  }
+
   TransportAdapter* transport_adapter = connection->transport_adapter;
   LOG4CXX_DEBUG(logger_, "Got adapter "
                 << transport_adapter << "["
@@ -862,7 +1069,13 @@ TransportManagerImpl::ConnectionInternal::ConnectionInternal(
                             &ConnectionInternal::DisconnectFailedRoutine)),
     shutDown(false),
     device_handle_(device_handle),
-    messages_count(0) {
+    messages_count(0),
+    send_weight(profile::Profile::instance()->transport_manager_send_weight(
+        transport_adapter->GetDeviceType(), dev_id)),
+    standby(false),
+    standby_expired(false),
+    standby_timer(new TimerInternal("TM StandbyRoutine", this,
+                                    &ConnectionInternal::StandbyExpiredRoutine)) {
   Connection::id = id;
   Connection::device = dev_id;
   Connection::application = app_id;
@@ -877,6 +1090,18 @@ void TransportManagerImpl::ConnectionInternal::DisconnectFailedRoutine() {
   LOG4CXX_TRACE(logger_, "exit");
 }
 
+void TransportManagerImpl::ConnectionInternal::StandbyExpiredRoutine() {
+  LOG4CXX_TRACE(logger_, "enter");
+  LOG4CXX_INFO(logger_, "Connection " << id << " was not restored");
+  standby_expired = true;
+  // Connection is closed from event thread like any lost link
+  transport_manager->PostEvent(TransportAdapterEvent(
+      TransportAdapterListenerImpl::EventTypeEnum::ON_UNEXPECTED_DISCONNECT,
+      transport_adapter, device, application,
+      ::protocol_handler::RawMessagePtr(), new CommunicationError()));
+  LOG4CXX_TRACE(logger_, "exit");
+}
+
 }  // namespace transport_manager
 
 
@@ -37,17 +37,25 @@
 #include <libusb/libusb.h>
 
 #include <sstream>
+#include <algorithm>
 
 #include "transport_manager/usb/libusb/usb_connection.h"
 #include "transport_manager/transport_adapter/transport_adapter_impl.h"
 
 #include "utils/logger.h"
+#include "config_profile/profile.h"
 
 namespace transport_manager {
 namespace transport_adapter {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
 
+namespace {
+// Incoming transfers read by several packets at once
+const size_t kInTransferSize = 16384;
+// Receive buffer of incoming transfer is reused by that many reads
+const size_t kInTransfersPerBuffer = 8;
+}  // namespace
 
 UsbConnection::UsbConnection(const DeviceUID& device_uid,
                              const ApplicationHandle& app_handle,
@@ -64,22 +72,28 @@ UsbConnection::UsbConnection(const DeviceUID& device_uid,
     in_endpoint_max_packet_size_(0),
     out_endpoint_(0),
     out_endpoint_max_packet_size_(0),
-    in_buffer_(NULL),
-    in_transfer_(NULL),
-    out_transfer_(0),
+    transfers_count_(profile::Profile::instance()->
+                     transport_manager_aoa_adapter_transfers_count()),
+    in_transfer_size_(0),
+    in_transfers_(),
+    free_out_transfers_(),
+    submitted_out_transfers_(),
     out_messages_(),
-    current_out_message_(),
-    bytes_sent_(0),
     disconnecting_(false),
-    waiting_in_transfer_cancel_(false),
-    waiting_out_transfer_cancel_(false) {
+    aborting_(false) {
 }
 
 UsbConnection::~UsbConnection() {
   LOG4CXX_TRACE(logger_, "enter with this" << this);
   Finalise();
-  libusb_free_transfer(in_transfer_);
-  delete[] in_buffer_;
+  for (InTransfers::iterator it = in_transfers_.begin();
+       it != in_transfers_.end(); ++it) {
+    libusb_free_transfer(it->transfer);
+  }
+  for (std::vector<libusb_transfer*>::iterator it = free_out_transfers_.begin();
+       it != free_out_transfers_.end(); ++it) {
+    libusb_free_transfer(*it);
+  }
   LOG4CXX_TRACE(logger_, "exit");
 }
 
@@ -92,12 +106,21 @@ void OutTransferCallback(libusb_transfer* transfer) {
   static_cast<UsbConnection*>(transfer->user_data)->OnOutTransfer(transfer);
 }
 
-bool UsbConnection::PostInTransfer() {
+bool UsbConnection::PostInTransfer(InTransfer* in_transfer) {
   LOG4CXX_TRACE(logger_, "enter");
-  libusb_fill_bulk_transfer(in_transfer_, device_handle_, in_endpoint_,
-                            in_buffer_, in_endpoint_max_packet_size_,
+  if (in_transfer->buffer.size() < in_transfer_size_) {
+    in_transfer->buffer =
+        ReceiveBufferPool().Allocate(in_transfer_size_ * kInTransfersPerBuffer);
+    if (in_transfer->buffer.empty()) {
+      LOG4CXX_ERROR(logger_, "Failed to allocate USB receive buffer");
+      LOG4CXX_TRACE(logger_, "exit with FALSE. Condition: buffer is empty");
+      return false;
+    }
+  }
+  libusb_fill_bulk_transfer(in_transfer->transfer, device_handle_, in_endpoint_,
+                            in_transfer->buffer.data(), in_transfer_size_,
                             InTransferCallback, this, 0);
-  const int libusb_ret = libusb_submit_transfer(in_transfer_);
+  const int libusb_ret = libusb_submit_transfer(in_transfer->transfer);
   if (LIBUSB_SUCCESS != libusb_ret) {
     LOG4CXX_ERROR(logger_, "libusb_submit_transfer failed: "
                   << libusb_error_name(libusb_ret));
@@ -105,6 +128,7 @@ bool UsbConnection::PostInTransfer() {
                   "exit with FALSE. Condition: LIBUSB_SUCCESS != libusb_submit_transfer");
     return false;
   }
+  in_transfer->submitted = true;
   LOG4CXX_TRACE(logger_, "exit with TRUE");
   return true;
 }
@@ -120,64 +144,74 @@ std::string hex_data(const unsigned char* const buffer, const int actual_length)
 
 void UsbConnection::OnInTransfer(libusb_transfer* transfer) {
   LOG4CXX_TRACE(logger_, "enter with Libusb_transfer*: " << transfer);
-  if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
-    LOG4CXX_DEBUG(logger_,
-                  "USB incoming transfer, size:" << transfer->actual_length
-                  << ", data:" << hex_data(transfer->buffer, transfer->actual_length));
-    ::protocol_handler::RawMessagePtr data(new protocol_handler::RawMessage(
-                         0, 0, in_buffer_, transfer->actual_length));
+  ::protocol_handler::RawMessagePtr data;
+  bool receive_failed = false;
+  bool abort = false;
+  {
+    sync_primitives::AutoLock locker(transfers_lock_);
+    InTransfers::iterator in_transfer = in_transfers_.begin();
+    while (in_transfer != in_transfers_.end() &&
+           in_transfer->transfer != transfer) {
+      ++in_transfer;
+    }
+    DCHECK(in_transfer != in_transfers_.end());
+    in_transfer->submitted = false;
+    if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
+      LOG4CXX_DEBUG(logger_,
+                    "USB incoming transfer, size:" << transfer->actual_length
+                    << ", data:" << hex_data(transfer->buffer, transfer->actual_length));
+      utils::BufferSlice& buffer = in_transfer->buffer;
+      data = utils::MakeShared<protocol_handler::RawMessage>(
+          0, 0, buffer.Slice(0, transfer->actual_length));
+      // Message owns received bytes now, next read goes after them
+      buffer = buffer.Slice(transfer->actual_length,
+                            buffer.size() - transfer->actual_length);
+    } else if (!disconnecting_) {
+      LOG4CXX_ERROR(logger_, "USB incoming transfer failed: "
+                    << libusb_error_name(transfer->status));
+      receive_failed = true;
+    }
+    if (!disconnecting_ && !PostInTransfer(&*in_transfer)) {
+      LOG4CXX_ERROR(logger_, "USB incoming transfer failed with "
+                    << "LIBUSB_TRANSFER_NO_DEVICE. Abort connection.");
+      RequestAbort();
+    }
+    abort = TransfersFinished();
+  }
+  // Transfers are completed one by one on USB handler thread,
+  // so data is passed on in order of receiving
+  if (data.valid()) {
     controller_->DataReceiveDone(device_uid_, app_handle_, data);
-  } else {
-    LOG4CXX_ERROR(logger_, "USB incoming transfer failed: "
-                  << libusb_error_name(transfer->status));
+  }
+  if (receive_failed) {
     controller_->DataReceiveFailed(device_uid_, app_handle_,
                                    DataReceiveError());
   }
-  if (disconnecting_) {
-    waiting_in_transfer_cancel_ = false;
-  } else {
-    if (!PostInTransfer()) {
-      LOG4CXX_ERROR(logger_, "USB incoming transfer failed with "
-                    << "LIBUSB_TRANSFER_NO_DEVICE. Abort connection.");
-      AbortConnection();
-    }
+  if (abort) {
+    AbortConnection();
   }
   LOG4CXX_TRACE(logger_, "exit");
 }
 
-void UsbConnection::PopOutMessage() {
+bool UsbConnection::PostOutTransfers() {
   LOG4CXX_TRACE(logger_, "enter");
-  bytes_sent_ = 0;
-  if (out_messages_.empty()) {
-    current_out_message_.reset();
-  } else {
-    current_out_message_ = out_messages_.front();
+  while (!out_messages_.empty() && !free_out_transfers_.empty()) {
+    const ::protocol_handler::RawMessagePtr message = out_messages_.front();
+    libusb_transfer* transfer = free_out_transfers_.back();
+    libusb_fill_bulk_transfer(transfer, device_handle_, out_endpoint_,
+                              message->data(), message->data_size(),
+                              OutTransferCallback, this, 0);
+    const int libusb_ret = libusb_submit_transfer(transfer);
+    if (LIBUSB_SUCCESS != libusb_ret) {
+      LOG4CXX_ERROR(logger_, "libusb_submit_transfer failed: "
+                    << libusb_error_name(libusb_ret) << ". Abort connection.");
+      LOG4CXX_TRACE(logger_, "exit with FALSE. Condition: "
+                    << "LIBUSB_SUCCESS != libusb_submit_transfer");
+      return false;
+    }
     out_messages_.pop_front();
-    PostOutTransfer();
-  }
-  LOG4CXX_TRACE(logger_, "exit");
-}
-
-bool UsbConnection::PostOutTransfer() {
-  LOG4CXX_TRACE(logger_, "enter");
-  out_transfer_ = libusb_alloc_transfer(0);
-  if (0 == out_transfer_) {
-    LOG4CXX_ERROR(logger_, "libusb_alloc_transfer failed");
-    LOG4CXX_TRACE(logger_, "exit with FALSE. Condition: 0 == out_transfer_");
-    return false;
-  }
-  libusb_fill_bulk_transfer(out_transfer_, device_handle_, out_endpoint_,
-                            current_out_message_->data() + bytes_sent_,
-                            current_out_message_->data_size() - bytes_sent_,
-                            OutTransferCallback, this, 0);
-  const int libusb_ret = libusb_submit_transfer(out_transfer_);
-  if (LIBUSB_SUCCESS != libusb_ret) {
-    LOG4CXX_ERROR(logger_, "libusb_submit_transfer failed: "
-                  << libusb_error_name(libusb_ret) << ". Abort connection.");
-    AbortConnection();
-    LOG4CXX_TRACE(logger_, "exit with FALSE. Condition: "
-                  << "LIBUSB_SUCCESS != libusb_fill_bulk_transfer");
-    return false;
+    free_out_transfers_.pop_back();
+    submitted_out_transfers_.push_back(OutTransfer(transfer, message));
   }
   LOG4CXX_TRACE(logger_, "exit with TRUE");
   return true;
@@ -185,78 +219,135 @@ bool UsbConnection::PostOutTransfer() {
 
 void UsbConnection::OnOutTransfer(libusb_transfer* transfer) {
   LOG4CXX_TRACE(logger_, "enter with  Libusb_transfer*: " << transfer);
-  sync_primitives::AutoLock locker(out_messages_mutex_);
-  if (transfer->status == LIBUSB_TRANSFER_COMPLETED) {
-    bytes_sent_ += transfer->actual_length;
-    if (bytes_sent_ == current_out_message_->data_size()) {
+  bool abort = false;
+  {
+    sync_primitives::AutoLock locker(transfers_lock_);
+    // Cancelled transfers are not guaranteed to finish in submission order
+    OutTransfers::iterator out_transfer = submitted_out_transfers_.begin();
+    while (out_transfer != submitted_out_transfers_.end() &&
+           out_transfer->transfer != transfer) {
+      ++out_transfer;
+    }
+    DCHECK(out_transfer != submitted_out_transfers_.end());
+    const ::protocol_handler::RawMessagePtr message = out_transfer->message;
+    submitted_out_transfers_.erase(out_transfer);
+    free_out_transfers_.push_back(transfer);
+    // Remainder of partially sent message can't be sent after messages
+    // already submitted behind it, so such message is failed
+    if (transfer->status == LIBUSB_TRANSFER_COMPLETED &&
+        static_cast<size_t>(transfer->actual_length) == message->data_size()) {
       LOG4CXX_DEBUG(logger_, "USB out transfer, data sent: "
-                    << current_out_message_.get());
-      controller_->DataSendDone(device_uid_, app_handle_, current_out_message_);
-      PopOutMessage();
+                    << message.get());
+      controller_->DataSendDone(device_uid_, app_handle_, message);
+    } else {
+      LOG4CXX_ERROR(logger_, "USB out transfer failed: "
+                    << libusb_error_name(transfer->status));
+      controller_->DataSendFailed(device_uid_, app_handle_, message,
+                                  DataSendError());
     }
-  } else {
-    LOG4CXX_ERROR(logger_, "USB out transfer failed: "
-                  << libusb_error_name(transfer->status));
-    controller_->DataSendFailed(device_uid_, app_handle_, current_out_message_,
-                                DataSendError());
-    PopOutMessage();
+    if (!disconnecting_ && !PostOutTransfers()) {
+      RequestAbort();
+    }
+    abort = TransfersFinished();
   }
-  if (!current_out_message_.valid()) {
-    libusb_free_transfer(transfer);
-    out_transfer_ = NULL;
-    waiting_out_transfer_cancel_ = false;
+  if (abort) {
+    AbortConnection();
   }
   LOG4CXX_TRACE(logger_, "exit");
 }
 
 TransportAdapter::Error UsbConnection::SendData(::protocol_handler::RawMessagePtr message) {
   LOG4CXX_TRACE(logger_, "enter with RawMessagePtr: " << message.get());
-  if (disconnecting_) {
-    LOG4CXX_TRACE(logger_, "exit with TransportAdapter::BAD_STATE. Condition: "
-                  << "disconnecting_");
-    return TransportAdapter::BAD_STATE;
-  }
-  sync_primitives::AutoLock locker(out_messages_mutex_);
-  if (current_out_message_.valid()) {
+  bool posted = true;
+  bool abort = false;
+  {
+    sync_primitives::AutoLock locker(transfers_lock_);
+    if (disconnecting_) {
+      LOG4CXX_TRACE(logger_, "exit with TransportAdapter::BAD_STATE. Condition: "
+                    << "disconnecting_");
+      return TransportAdapter::BAD_STATE;
+    }
     out_messages_.push_back(message);
-  } else {
-    current_out_message_ = message;
-    if (!PostOutTransfer()) {
-      controller_->DataSendFailed(device_uid_, app_handle_, message,
-                                  DataSendError());
-      LOG4CXX_TRACE(logger_, "exit with TransportAdapter::FAIL. Condition: !PostOutTransfer()");
-      return TransportAdapter::FAIL;
+    posted = PostOutTransfers();
+    if (!posted) {
+      RequestAbort();
+      abort = TransfersFinished();
     }
   }
+  if (abort) {
+    AbortConnection();
+  }
+  if (!posted) {
+    LOG4CXX_TRACE(logger_, "exit with TransportAdapter::FAIL. Condition: !PostOutTransfers()");
+    return TransportAdapter::FAIL;
+  }
   LOG4CXX_TRACE(logger_, "exit with TransportAdapter::OK.");
   return TransportAdapter::OK;
 }
 
-void UsbConnection::Finalise() {
-  LOG4CXX_TRACE(logger_, "enter");
-  LOG4CXX_DEBUG(logger_, "Finalise USB connection " << device_uid_);
-  {
-    sync_primitives::AutoLock locker(out_messages_mutex_);
-    disconnecting_ = true;
-    if (out_transfer_) {
-      waiting_out_transfer_cancel_ = true;
-      if ( LIBUSB_SUCCESS != libusb_cancel_transfer(out_transfer_)) {
-        waiting_out_transfer_cancel_ = false;
-      }
-    }
-    if (in_transfer_) {
-      waiting_in_transfer_cancel_ = true;
-      if ( LIBUSB_SUCCESS != libusb_cancel_transfer(in_transfer_)) {
-        waiting_in_transfer_cancel_ = false;
-      }
+void UsbConnection::CancelTransfers() {
+  for (InTransfers::iterator it = in_transfers_.begin();
+       it != in_transfers_.end(); ++it) {
+    if (it->submitted) {
+      libusb_cancel_transfer(it->transfer);
     }
-    for (std::list<protocol_handler::RawMessagePtr>::iterator it = out_messages_.begin();
-         it != out_messages_.end(); it = out_messages_.erase(it)) {
-      controller_->DataSendFailed(device_uid_, app_handle_, *it, DataSendError());
+  }
+  for (OutTransfers::iterator it = submitted_out_transfers_.begin();
+       it != submitted_out_transfers_.end(); ++it) {
+    libusb_cancel_transfer(it->transfer);
+  }
+}
+
+void UsbConnection::FailOutMessages() {
+  for (std::list<protocol_handler::RawMessagePtr>::iterator it = out_messages_.begin();
+       it != out_messages_.end(); it = out_messages_.erase(it)) {
+    controller_->DataSendFailed(device_uid_, app_handle_, *it, DataSendError());
+  }
+}
+
+void UsbConnection::RequestAbort() {
+  if (disconnecting_) {
+    return;
+  }
+  // Connection is aborted once all cancelled transfers are finished,
+  // otherwise USB handler thread would wait for itself in Finalise
+  disconnecting_ = true;
+  aborting_ = true;
+  CancelTransfers();
+  FailOutMessages();
+}
+
+bool UsbConnection::HasPendingTransfers() const {
+  for (InTransfers::const_iterator it = in_transfers_.begin();
+       it != in_transfers_.end(); ++it) {
+    if (it->submitted) {
+      return true;
     }
   }
-  while (waiting_in_transfer_cancel_ || waiting_out_transfer_cancel_) {
-    pthread_yield();
+  return !submitted_out_transfers_.empty();
+}
+
+bool UsbConnection::TransfersFinished() {
+  if (HasPendingTransfers()) {
+    return false;
+  }
+  transfers_finished_.Broadcast();
+  const bool abort = aborting_;
+  aborting_ = false;
+  return abort;
+}
+
+void UsbConnection::Finalise() {
+  LOG4CXX_TRACE(logger_, "enter");
+  LOG4CXX_DEBUG(logger_, "Finalise USB connection " << device_uid_);
+  sync_primitives::AutoLock locker(transfers_lock_);
+  // Pending abort is superseded by this disconnect
+  disconnecting_ = true;
+  aborting_ = false;
+  CancelTransfers();
+  FailOutMessages();
+  while (HasPendingTransfers()) {
+    transfers_finished_.Wait(locker);
   }
   LOG4CXX_TRACE(logger_, "exit");
 }
@@ -281,16 +372,41 @@ bool UsbConnection::Init() {
     LOG4CXX_TRACE(logger_, "exit with FALSE. Condition: !FindEndpoints()");
     return false;
   }
-  in_buffer_ = new unsigned char[in_endpoint_max_packet_size_];
-  in_transfer_ = libusb_alloc_transfer(0);
-  if (NULL == in_transfer_) {
-    LOG4CXX_ERROR(logger_, "libusb_alloc_transfer failed");
-    LOG4CXX_TRACE(logger_, "exit with FALSE. Condition: NULL == in_transfer_");
-    return false;
+  // Reads are made by whole packets, so device never overflows transfer
+  const size_t packet_size =
+      std::max<size_t>(in_endpoint_max_packet_size_, 1);
+  in_transfer_size_ =
+      (kInTransferSize + packet_size - 1) / packet_size * packet_size;
+
+  in_transfers_.resize(transfers_count_);
+  for (InTransfers::iterator it = in_transfers_.begin();
+       it != in_transfers_.end(); ++it) {
+    it->transfer = libusb_alloc_transfer(0);
+    libusb_transfer* out_transfer = libusb_alloc_transfer(0);
+    if (out_transfer) {
+      free_out_transfers_.push_back(out_transfer);
+    }
+    if (NULL == it->transfer || NULL == out_transfer) {
+      LOG4CXX_ERROR(logger_, "libusb_alloc_transfer failed");
+      LOG4CXX_TRACE(logger_, "exit with FALSE. Condition: NULL == transfer");
+      return false;
+    }
   }
 
   controller_->ConnectDone(device_uid_, app_handle_);
-  if (!PostInTransfer()) {
+  bool posted = true;
+  {
+    sync_primitives::AutoLock locker(transfers_lock_);
+    for (InTransfers::iterator it = in_transfers_.begin();
+         posted && it != in_transfers_.end(); ++it) {
+      posted = PostInTransfer(&*it);
+    }
+    if (!posted) {
+      disconnecting_ = true;
+      CancelTransfers();
+    }
+  }
+  if (!posted) {
     LOG4CXX_ERROR(logger_, "PostInTransfer failed. Call ConnectionAborted");
     controller_->ConnectionAborted(device_uid_, app_handle_,
                                    CommunicationError());
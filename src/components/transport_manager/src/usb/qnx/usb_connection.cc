@@ -34,19 +34,45 @@
  */
 
 #include <errno.h>
-#include <sched.h>
+#include <algorithm>
 #include <cstring>
 
 #include "transport_manager/usb/qnx/usb_connection.h"
 #include "transport_manager/transport_adapter/transport_adapter_impl.h"
 
 #include "utils/logger.h"
+#include "config_profile/profile.h"
 
 namespace transport_manager {
 namespace transport_adapter {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "TransportManager")
 
+namespace {
+// Every urb has buffer of that size allocated once by usbd_alloc
+const uint32_t kInBufferSize = 16384;
+const uint32_t kOutBufferSize = 16384;
+
+bool TransferSucceeded(usbd_urb* urb, uint32_t* len) {
+  uint32_t status = 0;
+  const int urb_status_rc = usbd_urb_status(urb, &status, len);
+  if (EOK != urb_status_rc && EIO != urb_status_rc) {  // EIO is OK
+    LOG4CXX_ERROR(logger_, "Get urb status failed: " << urb_status_rc);
+    return false;
+  }
+  LOG4CXX_DEBUG(logger_, "USB transfer, status " << std::hex << status
+                                                 << ", length " << std::dec
+                                                 << *len);
+  switch (status) {
+    case USBD_STATUS_CMP:
+    case USBD_STATUS_CMP_ERR | USBD_STATUS_DATA_UNDERRUN:
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
 UsbConnection::UsbConnection(const DeviceUID& device_uid,
                              const ApplicationHandle& app_handle,
                              TransportAdapterController* controller,
@@ -59,23 +85,32 @@ UsbConnection::UsbConnection(const DeviceUID& device_uid,
       usbd_device_(device->GetUsbdDevice()),
       in_pipe_(NULL),
       out_pipe_(NULL),
-      in_buffer_(NULL),
-      out_buffer_(NULL),
-      in_urb_(NULL),
-      out_urb_(NULL),
+      transfers_count_(std::max<uint32_t>(1, profile::Profile::instance()->
+                       transport_manager_aoa_adapter_transfers_count())),
+      in_transfers_(),
+      submitted_in_transfers_(),
+      delivering_in_(false),
+      out_transfers_(),
+      free_out_transfers_(),
+      submitted_out_transfers_count_(0),
       out_messages_(),
-      current_out_message_(),
-      out_messages_mutex_(),
-      bytes_sent_(0),
+      bytes_submitted_(0),
       disconnecting_(false),
-      pending_in_transfer_(false),
-      pending_out_transfer_(false) {
+      aborting_(false) {
 }
 
 UsbConnection::~UsbConnection() {
   Finalise();
-  if (in_urb_) usbd_free_urb(in_urb_);
-  if (out_urb_) usbd_free_urb(out_urb_);
+  for (InTransfers::iterator it = in_transfers_.begin();
+       it != in_transfers_.end(); ++it) {
+    if (it->urb) usbd_free_urb(it->urb);
+    if (it->buffer) usbd_free(it->buffer);
+  }
+  for (OutTransfers::iterator it = out_transfers_.begin();
+       it != out_transfers_.end(); ++it) {
+    if (it->urb) usbd_free_urb(it->urb);
+    if (it->buffer) usbd_free(it->buffer);
+  }
 
   if (in_pipe_) {
     const int close_pipe_rc = usbd_close_pipe(in_pipe_);
@@ -99,169 +134,241 @@ void OutTransferCallback(usbd_urb* urb, usbd_pipe*, void* data) {
   static_cast<UsbConnection*>(data)->OnOutTransfer(urb);
 }
 
-bool UsbConnection::PostInTransfer() {
-  usbd_setup_bulk(in_urb_, URB_DIR_IN, in_buffer_, kInBufferSize);
-  pending_in_transfer_ = true;
-  const int io_rc =
-      usbd_io(in_urb_, in_pipe_, InTransferCallback, this, USBD_TIME_INFINITY);
+bool UsbConnection::PostInTransfer(InTransfer* in_transfer) {
+  usbd_setup_bulk(in_transfer->urb, URB_DIR_IN, in_transfer->buffer,
+                  kInBufferSize);
+  const int io_rc = usbd_io(in_transfer->urb, in_pipe_, InTransferCallback,
+                            this, USBD_TIME_INFINITY);
   if (EOK != io_rc) {
-    pending_in_transfer_ = false;
     LOG4CXX_ERROR(logger_, "Failed to post in transfer: " << io_rc);
     return false;
   }
+  in_transfer->submitted = true;
+  submitted_in_transfers_.push_back(in_transfer);
   return true;
 }
 
 void UsbConnection::OnInTransfer(usbd_urb* urb) {
-  uint32_t status = 0;
   uint32_t len = 0;
-  bool error = false;
-  const int urb_status_rc = usbd_urb_status(urb, &status, &len);
-  if (EOK != urb_status_rc && EIO != urb_status_rc) {  // EIO is OK
-    LOG4CXX_ERROR(logger_, "Get in urb status failed: " << urb_status_rc);
-    error = true;
-  }
-  LOG4CXX_INFO(logger_, "USB in transfer, status " << std::hex << status
-                                                   << ", length " << std::dec
-                                                   << len);
-
-  if (!error) {
-    switch (status) {
-      case USBD_STATUS_CMP:
-      case USBD_STATUS_CMP_ERR | USBD_STATUS_DATA_UNDERRUN:
-        error = false;
-        break;
-      default:
-        error = true;
-        break;
+  const bool succeeded = TransferSucceeded(urb, &len);
+  bool abort = false;
+  {
+    sync_primitives::AutoLock locker(transfers_lock_);
+    InTransfers::iterator in_transfer = in_transfers_.begin();
+    while (in_transfer != in_transfers_.end() && in_transfer->urb != urb) {
+      ++in_transfer;
     }
+    DCHECK(in_transfer != in_transfers_.end());
+    in_transfer->completed = true;
+    in_transfer->succeeded = succeeded;
+    in_transfer->length = len;
+    // Urbs may complete on several usbd threads at once, the callback
+    // already passing data on delivers this urb too in submission order
+    if (delivering_in_) {
+      return;
+    }
+    delivering_in_ = true;
+    std::vector< ::protocol_handler::RawMessagePtr> received;
+    size_t receive_failures = 0;
+    while (!submitted_in_transfers_.empty() &&
+           submitted_in_transfers_.front()->completed) {
+      // All completed urbs are passed on by one batch
+      while (!submitted_in_transfers_.empty() &&
+             submitted_in_transfers_.front()->completed) {
+        InTransfer* completed = submitted_in_transfers_.front();
+        submitted_in_transfers_.pop_front();
+        completed->submitted = false;
+        completed->completed = false;
+        if (completed->succeeded) {
+          received.push_back(::protocol_handler::RawMessagePtr(
+              new protocol_handler::RawMessage(0, 0, completed->buffer,
+                                               completed->length)));
+        } else if (!disconnecting_) {
+          LOG4CXX_ERROR(logger_, "USB in transfer failed");
+          ++receive_failures;
+        }
+        // Data is copied out, so buffer is read into again at once
+        if (!disconnecting_ && !PostInTransfer(completed)) {
+          RequestAbort();
+        }
+      }
+      sync_primitives::AutoUnlock unlocker(locker);
+      for (std::vector< ::protocol_handler::RawMessagePtr>::const_iterator it =
+               received.begin(); it != received.end(); ++it) {
+        controller_->DataReceiveDone(device_uid_, app_handle_, *it);
+      }
+      for (; receive_failures > 0; --receive_failures) {
+        controller_->DataReceiveFailed(device_uid_, app_handle_,
+                                       DataReceiveError());
+      }
+      received.clear();
+    }
+    delivering_in_ = false;
+    abort = TransfersFinished();
   }
-
-  if (error) {
-    LOG4CXX_ERROR(logger_, "USB in transfer failed");
-    controller_->DataReceiveFailed(device_uid_, app_handle_,
-                                   DataReceiveError());
-  } else {
-    ::protocol_handler::RawMessagePtr msg(new protocol_handler::RawMessage(0, 0, in_buffer_, len));
-    controller_->DataReceiveDone(device_uid_, app_handle_, msg);
+  if (abort) {
+    AbortConnection();
   }
+}
 
-  pending_in_transfer_ = false;
-  if (!disconnecting_) {
-    if (!PostInTransfer()) {
-      controller_->ConnectionAborted(device_uid_, app_handle_,
-                                     CommunicationError());
-      Disconnect();
+bool UsbConnection::PostOutTransfers() {
+  while (!out_messages_.empty() && !free_out_transfers_.empty()) {
+    const ::protocol_handler::RawMessagePtr message = out_messages_.front();
+    OutTransfer* out_transfer = free_out_transfers_.back();
+    const size_t remaining = message->data_size() - bytes_submitted_;
+    const uint32_t size = std::min<size_t>(remaining, kOutBufferSize);
+    memcpy(out_transfer->buffer, message->data() + bytes_submitted_, size);
+    usbd_setup_bulk(out_transfer->urb, URB_DIR_OUT, out_transfer->buffer,
+                    size);
+    LOG4CXX_DEBUG(logger_, "out transfer :" << size);
+    const int io_rc = usbd_io(out_transfer->urb, out_pipe_,
+                              OutTransferCallback, this, USBD_TIME_INFINITY);
+    if (EOK != io_rc) {
+      LOG4CXX_ERROR(logger_, "Failed to post out transfer: " << io_rc);
+      return false;
+    }
+    free_out_transfers_.pop_back();
+    ++submitted_out_transfers_count_;
+    out_transfer->message = message;
+    out_transfer->size = size;
+    out_transfer->last = (size == remaining);
+    bytes_submitted_ += size;
+    if (out_transfer->last) {
+      out_messages_.pop_front();
+      bytes_submitted_ = 0;
     }
   }
+  return true;
 }
 
-void UsbConnection::PopOutMessage() {
-  bytes_sent_ = 0;
-  if (out_messages_.empty()) {
-    current_out_message_.reset();
-  } else {
-    current_out_message_ = out_messages_.front();
-    out_messages_.pop_front();
+void UsbConnection::DropOutMessage(
+    const ::protocol_handler::RawMessagePtr message) {
+  // Message is failed once, chunks of it still in flight are not reported
+  for (OutTransfers::iterator it = out_transfers_.begin();
+       it != out_transfers_.end(); ++it) {
+    if (it->message.get() == message.get()) {
+      it->message.reset();
+    }
   }
-}
-
-bool UsbConnection::PostOutTransfer() {
-  const int len = current_out_message_->data_size() - bytes_sent_;
-  out_buffer_ = usbd_alloc(len);
-  memmove(out_buffer_, current_out_message_->data() + bytes_sent_, len);
-  usbd_setup_bulk(out_urb_, URB_DIR_OUT, out_buffer_, len);
-  LOG4CXX_INFO(logger_, "out transfer :" << len);
-  pending_out_transfer_ = true;
-  const int io_rc = usbd_io(out_urb_, out_pipe_, OutTransferCallback, this,
-                            USBD_TIME_INFINITY);
-  if (EOK != io_rc) {
-    pending_out_transfer_ = false;
-    usbd_free(out_buffer_);
-    LOG4CXX_ERROR(logger_, "Failed to post out transfer: " << io_rc);
-    return false;
+  if (!out_messages_.empty() && out_messages_.front().get() == message.get()) {
+    out_messages_.pop_front();
+    bytes_submitted_ = 0;
   }
-  return true;
 }
 
 void UsbConnection::OnOutTransfer(usbd_urb* urb) {
-  usbd_free(out_buffer_);
-  uint32_t status = 0;
   uint32_t len = 0;
-  bool error = false;
-  const int urb_status_rc = usbd_urb_status(urb, &status, &len);
-  if (EOK != urb_status_rc && EIO != urb_status_rc) {  // EIO is OK
-    LOG4CXX_ERROR(logger_, "Get out urb status failed: " << urb_status_rc);
-    error = true;
-  }
-  LOG4CXX_INFO(logger_, "USB out transfer, status " << std::hex << status
-                                                    << ", length " << std::dec
-                                                    << len);
-
-  if (!error) {
-    switch (status) {
-      case USBD_STATUS_CMP:
-      case USBD_STATUS_CMP_ERR | USBD_STATUS_DATA_UNDERRUN:
-        error = false;
-        break;
-      default:
-        error = true;
-        break;
+  const bool succeeded = TransferSucceeded(urb, &len);
+  bool abort = false;
+  {
+    sync_primitives::AutoLock locker(transfers_lock_);
+    OutTransfers::iterator out_transfer = out_transfers_.begin();
+    while (out_transfer != out_transfers_.end() && out_transfer->urb != urb) {
+      ++out_transfer;
     }
+    DCHECK(out_transfer != out_transfers_.end());
+    const ::protocol_handler::RawMessagePtr message = out_transfer->message;
+    out_transfer->message.reset();
+    free_out_transfers_.push_back(&*out_transfer);
+    --submitted_out_transfers_count_;
+    if (message.valid()) {
+      if (succeeded && len == out_transfer->size) {
+        if (out_transfer->last) {
+          LOG4CXX_DEBUG(logger_, "USB out transfer, data sent: "
+                                     << message.get());
+          controller_->DataSendDone(device_uid_, app_handle_, message);
+        }
+      } else {
+        LOG4CXX_ERROR(logger_, "USB out transfer failed");
+        controller_->DataSendFailed(device_uid_, app_handle_, message,
+                                    DataSendError());
+        DropOutMessage(message);
+      }
+    }
+    if (!disconnecting_ && !PostOutTransfers()) {
+      RequestAbort();
+    }
+    abort = TransfersFinished();
+  }
+  if (abort) {
+    AbortConnection();
   }
+}
 
-  sync_primitives::AutoLock locker(out_messages_mutex_);
-
-  if (error) {
-    LOG4CXX_ERROR(logger_, "USB out transfer failed");
-    controller_->DataSendFailed(device_uid_, app_handle_, current_out_message_,
-                                DataSendError());
-    PopOutMessage();
-  } else {
-    bytes_sent_ += len;
-    if (bytes_sent_ == current_out_message_->data_size()) {
-      LOG4CXX_INFO(logger_, "USB out transfer, data sent: "
-                                << current_out_message_.get());
-      controller_->DataSendDone(device_uid_, app_handle_, current_out_message_);
-      PopOutMessage();
+TransportAdapter::Error UsbConnection::SendData(::protocol_handler::RawMessagePtr message) {
+  bool posted = true;
+  bool abort = false;
+  {
+    sync_primitives::AutoLock locker(transfers_lock_);
+    if (disconnecting_) {
+      return TransportAdapter::BAD_STATE;
     }
+    out_messages_.push_back(message);
+    posted = PostOutTransfers();
+    if (!posted) {
+      RequestAbort();
+      abort = TransfersFinished();
+    }
+  }
+  if (abort) {
+    AbortConnection();
   }
+  return posted ? TransportAdapter::OK : TransportAdapter::FAIL;
+}
 
-  if ((!disconnecting_) && current_out_message_.valid()) {
-    PostOutTransfer();
-  } else {
-    pending_out_transfer_ = false;
+void UsbConnection::FailOutMessages() {
+  for (std::list<protocol_handler::RawMessagePtr>::iterator it = out_messages_.begin();
+       it != out_messages_.end(); it = out_messages_.erase(it)) {
+    controller_->DataSendFailed(device_uid_, app_handle_, *it, DataSendError());
   }
+  bytes_submitted_ = 0;
 }
 
-TransportAdapter::Error UsbConnection::SendData(::protocol_handler::RawMessagePtr message) {
+void UsbConnection::RequestAbort() {
   if (disconnecting_) {
-    return TransportAdapter::BAD_STATE;
+    return;
   }
-  sync_primitives::AutoLock locker(out_messages_mutex_);
-  if (current_out_message_.valid()) {
-    out_messages_.push_back(message);
-  } else {
-    current_out_message_ = message;
-    if (!PostOutTransfer()) {
-      controller_->DataSendFailed(device_uid_, app_handle_, message,
-                                  DataSendError());
-    }
+  // Connection is aborted once all aborted urbs are finished,
+  // otherwise usbd callback thread would wait for itself in Finalise
+  disconnecting_ = true;
+  aborting_ = true;
+  if (in_pipe_) usbd_abort_pipe(in_pipe_);
+  if (out_pipe_) usbd_abort_pipe(out_pipe_);
+  FailOutMessages();
+}
+
+bool UsbConnection::HasPendingTransfers() const {
+  return delivering_in_ || !submitted_in_transfers_.empty() ||
+         submitted_out_transfers_count_ > 0;
+}
+
+bool UsbConnection::TransfersFinished() {
+  if (HasPendingTransfers()) {
+    return false;
   }
-  return TransportAdapter::OK;
+  transfers_finished_.Broadcast();
+  const bool abort = aborting_;
+  aborting_ = false;
+  return abort;
 }
 
 void UsbConnection::Finalise() {
   LOG4CXX_INFO(logger_, "Finalising");
-  sync_primitives::AutoLock locker(out_messages_mutex_);
+  sync_primitives::AutoLock locker(transfers_lock_);
+  // Pending abort is superseded by this disconnect
   disconnecting_ = true;
-  usbd_abort_pipe(in_pipe_);
-  usbd_abort_pipe(out_pipe_);
-  for (std::list<protocol_handler::RawMessagePtr>::iterator it = out_messages_.begin();
-       it != out_messages_.end(); it = out_messages_.erase(it)) {
-    controller_->DataSendFailed(device_uid_, app_handle_, *it, DataSendError());
+  aborting_ = false;
+  if (in_pipe_) usbd_abort_pipe(in_pipe_);
+  if (out_pipe_) usbd_abort_pipe(out_pipe_);
+  FailOutMessages();
+  while (HasPendingTransfers()) {
+    transfers_finished_.Wait(locker);
   }
-  while (pending_in_transfer_ || pending_out_transfer_) sched_yield();
+}
+
+void UsbConnection::AbortConnection() {
+  controller_->ConnectionAborted(device_uid_, app_handle_, CommunicationError());
+  Disconnect();
 }
 
 TransportAdapter::Error UsbConnection::Disconnect() {
@@ -274,22 +381,42 @@ TransportAdapter::Error UsbConnection::Disconnect() {
 bool UsbConnection::Init() {
   if (!OpenEndpoints()) return false;
 
-  in_urb_ = usbd_alloc_urb(NULL);
-  out_urb_ = usbd_alloc_urb(NULL);
-  if (NULL == in_urb_ || NULL == out_urb_) {
-    LOG4CXX_ERROR(logger_, "usbd_alloc_urb failed");
-    return false;
-  }
-
-  in_buffer_ = static_cast<unsigned char*>(usbd_alloc(kInBufferSize));
-  if (NULL == in_buffer_) {
-    LOG4CXX_ERROR(logger_, "usbd_alloc failed");
-    return false;
+  in_transfers_.resize(transfers_count_);
+  out_transfers_.resize(transfers_count_);
+  for (size_t i = 0; i < transfers_count_; ++i) {
+    InTransfer& in_transfer = in_transfers_[i];
+    OutTransfer& out_transfer = out_transfers_[i];
+    in_transfer.urb = usbd_alloc_urb(NULL);
+    out_transfer.urb = usbd_alloc_urb(NULL);
+    if (NULL == in_transfer.urb || NULL == out_transfer.urb) {
+      LOG4CXX_ERROR(logger_, "usbd_alloc_urb failed");
+      return false;
+    }
+    in_transfer.buffer =
+        static_cast<unsigned char*>(usbd_alloc(kInBufferSize));
+    out_transfer.buffer = usbd_alloc(kOutBufferSize);
+    if (NULL == in_transfer.buffer || NULL == out_transfer.buffer) {
+      LOG4CXX_ERROR(logger_, "usbd_alloc failed");
+      return false;
+    }
+    free_out_transfers_.push_back(&out_transfer);
   }
 
   controller_->ConnectDone(device_uid_, app_handle_);
 
-  if (!PostInTransfer()) {
+  bool posted = true;
+  {
+    sync_primitives::AutoLock locker(transfers_lock_);
+    for (InTransfers::iterator it = in_transfers_.begin();
+         posted && it != in_transfers_.end(); ++it) {
+      posted = PostInTransfer(&*it);
+    }
+    if (!posted) {
+      disconnecting_ = true;
+      usbd_abort_pipe(in_pipe_);
+    }
+  }
+  if (!posted) {
     controller_->ConnectionAborted(device_uid_, app_handle_,
                                    CommunicationError());
     return true;
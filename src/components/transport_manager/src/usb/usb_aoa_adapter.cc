@@ -38,6 +38,7 @@
 #include "transport_manager/usb/usb_connection_factory.h"
 #include "transport_manager/usb/common.h"
 #include "utils/logger.h"
+#include "config_profile/profile.h"
 
 namespace transport_manager {
 namespace transport_adapter {
@@ -59,6 +60,11 @@ DeviceType UsbAoaAdapter::GetDeviceType() const {
   return "sdl-usb-aoa";
 }
 
+size_t UsbAoaAdapter::GetMaximumFrameSize() const {
+  return profile::Profile::instance()->
+      transport_manager_aoa_adapter_maximum_frame_size();
+}
+
 bool UsbAoaAdapter::IsInitialised() const {
   return is_initialised_ && TransportAdapterImpl::IsInitialised();
 }
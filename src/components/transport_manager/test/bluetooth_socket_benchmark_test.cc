@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/date_time.h"
+#include "utils/macro.h"
+#include "transport_manager/transport_adapter/socket_options.h"
+
+namespace test {
+namespace components {
+namespace transport_manager {
+
+using ::transport_manager::transport_adapter::SocketOptions;
+
+namespace {
+// RFCOMM link is emulated by local stream socket, so figures show effect of
+// socket buffers on SDL side, not radio performance
+const size_t kFrameSize = 1000;
+const size_t kStreamFramesCount = 8192;
+// Practical throughput of Bluetooth 2.1 EDR RFCOMM link, about 2 Mbit/s
+const int64_t kRfcommBytesPerSecond = 250000;
+
+struct ReaderContext {
+  int socket;
+  size_t bytes_expected;
+  size_t bytes_read;
+};
+
+void* ReadAll(void* data) {
+  ReaderContext* context = static_cast<ReaderContext*>(data);
+  std::vector<char> buffer(64 * 1024);
+  while (context->bytes_read < context->bytes_expected) {
+    const ssize_t bytes_read = read(context->socket, &buffer[0],
+                                    buffer.size());
+    if (bytes_read <= 0) {
+      break;
+    }
+    context->bytes_read += bytes_read;
+  }
+  return NULL;
+}
+
+SocketOptions TunedOptions() {
+  SocketOptions options;
+  options.send_buffer_size = 16 * 1024;
+  options.receive_buffer_size = 256 * 1024;
+  options.priority = 5;
+  return options;
+}
+}  // namespace
+
+class BluetoothSocketBenchmarkTest : public ::testing::Test {
+ protected:
+  void SetUp() OVERRIDE {
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets_));
+  }
+  void TearDown() OVERRIDE {
+    close(sockets_[0]);
+    close(sockets_[1]);
+  }
+  int GetOption(int socket, int option) {
+    int value = 0;
+    socklen_t value_size = sizeof(value);
+    EXPECT_EQ(0, getsockopt(socket, SOL_SOCKET, option, &value, &value_size));
+    return value;
+  }
+  // Writes stream frames to non-read socket till it would block
+  size_t FillSocket(int socket) {
+    fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+    const std::vector<char> frame(kFrameSize, 'a');
+    size_t bytes_queued = 0;
+    ssize_t bytes_written = 0;
+    while ((bytes_written = write(socket, &frame[0], frame.size())) > 0) {
+      bytes_queued += bytes_written;
+    }
+    EXPECT_EQ(EAGAIN, errno);
+    return bytes_queued;
+  }
+  // Returns microseconds spent on sending stream frames to reader thread
+  int64_t SendStream(int socket, int peer_socket) {
+    ReaderContext context = { peer_socket, kFrameSize * kStreamFramesCount, 0 };
+    pthread_t reader;
+    EXPECT_EQ(0, pthread_create(&reader, NULL, &ReadAll, &context));
+    const std::vector<char> frame(kFrameSize, 'a');
+    const TimevalStruct start = date_time::DateTime::getCurrentTime();
+    for (size_t i = 0; i < kStreamFramesCount; ++i) {
+      EXPECT_EQ(static_cast<ssize_t>(frame.size()),
+                write(socket, &frame[0], frame.size()));
+    }
+    pthread_join(reader, NULL);
+    const int64_t usecs = date_time::DateTime::getuSecs(
+        date_time::DateTime::Sub(date_time::DateTime::getCurrentTime(),
+                                 start));
+    EXPECT_EQ(context.bytes_expected, context.bytes_read);
+    return usecs > 0 ? usecs : 1;
+  }
+  int sockets_[2];
+};
+
+TEST_F(BluetoothSocketBenchmarkTest, OptionsApplied_ExpectSocketTuned) {
+  const SocketOptions options = TunedOptions();
+  EXPECT_TRUE(options.Apply(sockets_[0]));
+  // Kernel reserves room for its bookkeeping on top of requested sizes
+  EXPECT_LE(static_cast<int>(options.send_buffer_size),
+            GetOption(sockets_[0], SO_SNDBUF));
+  EXPECT_LE(static_cast<int>(options.receive_buffer_size),
+            GetOption(sockets_[0], SO_RCVBUF));
+  EXPECT_EQ(static_cast<int>(options.priority),
+            GetOption(sockets_[0], SO_PRIORITY));
+}
+
+TEST_F(BluetoothSocketBenchmarkTest, DefaultOptions_ExpectSocketUntouched) {
+  const int send_buffer_size = GetOption(sockets_[0], SO_SNDBUF);
+  const int receive_buffer_size = GetOption(sockets_[0], SO_RCVBUF);
+  EXPECT_TRUE(SocketOptions().Apply(sockets_[0]));
+  EXPECT_EQ(send_buffer_size, GetOption(sockets_[0], SO_SNDBUF));
+  EXPECT_EQ(receive_buffer_size, GetOption(sockets_[0], SO_RCVBUF));
+  EXPECT_EQ(0, GetOption(sockets_[0], SO_PRIORITY));
+}
+
+TEST_F(BluetoothSocketBenchmarkTest, Throughput_CompareDefaultAndTuned) {
+  const int64_t default_usecs = SendStream(sockets_[0], sockets_[1]);
+
+  int tuned_sockets[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, tuned_sockets));
+  TunedOptions().Apply(tuned_sockets[0]);
+  TunedOptions().Apply(tuned_sockets[1]);
+  const int64_t tuned_usecs = SendStream(tuned_sockets[0], tuned_sockets[1]);
+  close(tuned_sockets[0]);
+  close(tuned_sockets[1]);
+
+  const int64_t bytes = kFrameSize * kStreamFramesCount;
+  // Timings depend on build and load, so they are reported only
+  std::cout << bytes << " bytes in " << kFrameSize << " byte frames: "
+            << "default " << bytes / default_usecs << " MB/s, "
+            << "tuned " << bytes / tuned_usecs << " MB/s" << std::endl;
+  RecordProperty("default_usecs", static_cast<int>(default_usecs));
+  RecordProperty("tuned_usecs", static_cast<int>(tuned_usecs));
+}
+
+TEST_F(BluetoothSocketBenchmarkTest,
+       UrgentFrameLatency_ExpectLessQueuedWithSmallSendBuffer) {
+  // Frames are prioritized before they are written to socket, so urgent
+  // frame waits only for streaming data already queued in kernel
+  const size_t default_queued = FillSocket(sockets_[0]);
+
+  int tuned_sockets[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, tuned_sockets));
+  ASSERT_TRUE(TunedOptions().Apply(tuned_sockets[0]));
+  const size_t tuned_queued = FillSocket(tuned_sockets[0]);
+  close(tuned_sockets[0]);
+  close(tuned_sockets[1]);
+
+  EXPECT_LT(tuned_queued, default_queued);
+  const int64_t default_latency_ms =
+      default_queued * 1000 / kRfcommBytesPerSecond;
+  const int64_t tuned_latency_ms = tuned_queued * 1000 / kRfcommBytesPerSecond;
+  std::cout << "Urgent frame waits behind stream data: "
+            << "default " << default_queued << " bytes ("
+            << default_latency_ms << " ms over RFCOMM), "
+            << "tuned " << tuned_queued << " bytes ("
+            << tuned_latency_ms << " ms over RFCOMM)" << std::endl;
+  RecordProperty("default_latency_ms", static_cast<int>(default_latency_ms));
+  RecordProperty("tuned_latency_ms", static_cast<int>(tuned_latency_ms));
+}
+
+}  // namespace transport_manager
+}  // namespace components
+}  // namespace test
@@ -69,12 +69,15 @@ class MockTransportManagerListener :
   MOCK_METHOD1(OnDeviceFound, void(const DeviceInfo &device_info));
   MOCK_METHOD1(OnDeviceAdded, void(const DeviceInfo &device_info));
   MOCK_METHOD1(OnDeviceRemoved, void(const DeviceInfo &device_info));
+  MOCK_METHOD1(OnDeviceChanged, void(const DeviceInfo &device_info));
   MOCK_METHOD0(OnNoDeviceFound, void());
   MOCK_METHOD0(OnScanDevicesFinished, void());
   MOCK_METHOD1(OnScanDevicesFailed, void(const SearchDeviceError& error));
 
   MOCK_METHOD2(OnConnectionEstablished, void(const DeviceInfo& device_info,
           const ConnectionUID &connection_id));
+  MOCK_METHOD2(OnConnectionRestored, void(const DeviceInfo& device_info,
+          const ConnectionUID &connection_id));
   MOCK_METHOD2(OnConnectionFailed, void(const DeviceInfo& device_info,
           const ConnectError& error));
 
@@ -89,6 +92,8 @@ class MockTransportManagerListener :
           const DisconnectDeviceError& error));
 
   MOCK_METHOD1(OnTMMessageReceived, void(const RawMessagePtr data_container));
+  MOCK_METHOD1(OnTMMessagesReceived,
+               void(const ::protocol_handler::RawMessageList& messages));
   MOCK_METHOD2(OnTMMessageReceiveFailed, void(ConnectionUID connection_id,
           const DataReceiveError& error));
   MOCK_METHOD1(OnTMMessageSend, void(const RawMessagePtr message));
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "transport_manager/transport_adapter/socket_poller.h"
+
+namespace test {
+namespace components {
+namespace transport_manager {
+
+using ::transport_manager::transport_adapter::SocketPoller;
+using ::transport_manager::transport_adapter::EpollSocketPoller;
+#ifdef IO_URING_SUPPORT
+using ::transport_manager::transport_adapter::IoUringSocketPoller;
+#endif  // IO_URING_SUPPORT
+
+namespace {
+const uint64_t kId = 1;
+const uint64_t kOtherId = 2;
+
+template <typename Poller>
+class SocketPollerTest : public ::testing::Test {
+ protected:
+  void SetUp() OVERRIDE {
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets_));
+    ASSERT_EQ(0, pipe(notify_fds_));
+    fcntl(notify_fds_[0], F_SETFL, fcntl(notify_fds_[0], F_GETFL) | O_NONBLOCK);
+    ASSERT_TRUE(poller_.Init());
+  }
+  void TearDown() OVERRIDE {
+    close(sockets_[0]);
+    close(sockets_[1]);
+    close(notify_fds_[0]);
+    close(notify_fds_[1]);
+  }
+  void Notify() {
+    const char c = 0;
+    ASSERT_EQ(1, write(notify_fds_[1], &c, 1));
+  }
+  void ClearNotifications() {
+    char buffer[16];
+    while (read(notify_fds_[0], buffer, sizeof(buffer)) > 0) {
+    }
+  }
+  // Waits until given id is reported
+  bool WaitReady(uint64_t id) {
+    for (int i = 0; i < 10; ++i) {
+      std::vector<uint64_t> ready_ids;
+      if (!poller_.Wait(&ready_ids)) {
+        return false;
+      }
+      if (ready_ids.end() !=
+          std::find(ready_ids.begin(), ready_ids.end(), id)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int sockets_[2];
+  int notify_fds_[2];
+  Poller poller_;
+};
+
+#ifdef IO_URING_SUPPORT
+typedef ::testing::Types<EpollSocketPoller, IoUringSocketPoller> Pollers;
+#else  // IO_URING_SUPPORT
+typedef ::testing::Types<EpollSocketPoller> Pollers;
+#endif  // IO_URING_SUPPORT
+TYPED_TEST_CASE(SocketPollerTest, Pollers);
+}  // namespace
+
+TYPED_TEST(SocketPollerTest, DataSent_ExpectReady) {
+  ASSERT_TRUE(this->poller_.Watch(kId, this->sockets_[0],
+                                  this->notify_fds_[0], false));
+  const char data[] = "data";
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(data)),
+            send(this->sockets_[1], data, sizeof(data), 0));
+  EXPECT_TRUE(this->WaitReady(kId));
+  this->poller_.Unwatch(kId);
+}
+
+TYPED_TEST(SocketPollerTest, NotifiedTwice_ExpectReadyTwice) {
+  ASSERT_TRUE(this->poller_.Watch(kId, this->sockets_[0],
+                                  this->notify_fds_[0], false));
+  this->Notify();
+  EXPECT_TRUE(this->WaitReady(kId));
+  this->ClearNotifications();
+  // Readiness is reported again without watching anew
+  this->Notify();
+  EXPECT_TRUE(this->WaitReady(kId));
+  this->poller_.Unwatch(kId);
+}
+
+TYPED_TEST(SocketPollerTest, WriteWatched_ExpectReady) {
+  ASSERT_TRUE(this->poller_.Watch(kId, this->sockets_[0], -1, false));
+  this->poller_.WatchWrite(kId, true);
+  // Empty socket is writable right away
+  EXPECT_TRUE(this->WaitReady(kId));
+  this->poller_.WatchWrite(kId, true);
+  EXPECT_TRUE(this->WaitReady(kId));
+  this->poller_.Unwatch(kId);
+}
+
+TYPED_TEST(SocketPollerTest, Unwatched_ExpectNotReady) {
+  int other_fds[2];
+  ASSERT_EQ(0, pipe(other_fds));
+  ASSERT_TRUE(this->poller_.Watch(kId, this->sockets_[0],
+                                  this->notify_fds_[0], false));
+  ASSERT_TRUE(this->poller_.Watch(kOtherId, other_fds[0], -1, false));
+  this->poller_.Unwatch(kId);
+  this->Notify();
+  const char c = 0;
+  ASSERT_EQ(1, write(other_fds[1], &c, 1));
+
+  std::vector<uint64_t> ready_ids;
+  ASSERT_TRUE(this->poller_.Wait(&ready_ids));
+  EXPECT_EQ(ready_ids.end(),
+            std::find(ready_ids.begin(), ready_ids.end(), kId));
+  this->poller_.Unwatch(kOtherId);
+  close(other_fds[0]);
+  close(other_fds[1]);
+}
+
+}  // namespace transport_manager
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "gtest/gtest.h"
+#include "utils/lock.h"
+#include "transport_manager/transport_adapter/socket_reactor.h"
+
+namespace test {
+namespace components {
+namespace transport_manager {
+
+using ::transport_manager::transport_adapter::SocketReactor;
+
+namespace {
+const int kWaitStepUsecs = 1000;
+const int kWaitStepsCount = 5000;
+
+class TestHandler : public SocketReactor::Handler {
+ public:
+  TestHandler(int socket, int notify_fd)
+      : socket_(socket),
+        notify_fd_(notify_fd),
+        ready_count_(0),
+        bytes_read_(0),
+        removed_(false),
+        finish_(false),
+        write_wanted_(false) {
+  }
+  virtual bool OnReady() {
+    char buffer[256];
+    ssize_t bytes_read = 0;
+    size_t total = 0;
+    while ((bytes_read = recv(socket_, buffer, sizeof(buffer),
+                              MSG_DONTWAIT)) > 0) {
+      total += bytes_read;
+    }
+    while (read(notify_fd_, buffer, sizeof(buffer)) > 0) {
+    }
+    sync_primitives::AutoLock auto_lock(lock_);
+    ++ready_count_;
+    bytes_read_ += total;
+    // Writability is reported once
+    write_wanted_ = false;
+    return !finish_;
+  }
+  virtual bool IsWriteWanted() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return write_wanted_;
+  }
+  virtual void OnRemoved() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    removed_ = true;
+  }
+  void set_finish(bool finish) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    finish_ = finish;
+  }
+  void set_write_wanted(bool write_wanted) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    write_wanted_ = write_wanted;
+  }
+  size_t ready_count() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return ready_count_;
+  }
+  size_t bytes_read() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return bytes_read_;
+  }
+  bool removed() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return removed_;
+  }
+
+ private:
+  const int socket_;
+  const int notify_fd_;
+  mutable sync_primitives::Lock lock_;
+  size_t ready_count_;
+  size_t bytes_read_;
+  bool removed_;
+  bool finish_;
+  bool write_wanted_;
+};
+
+class SocketReactorTest : public ::testing::Test {
+ protected:
+  void SetUp() OVERRIDE {
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets_));
+    ASSERT_EQ(0, pipe(notify_fds_));
+    fcntl(notify_fds_[0], F_SETFL, fcntl(notify_fds_[0], F_GETFL) | O_NONBLOCK);
+    ASSERT_TRUE(reactor_.Start());
+  }
+  void TearDown() OVERRIDE {
+    close(sockets_[0]);
+    close(sockets_[1]);
+    close(notify_fds_[0]);
+    close(notify_fds_[1]);
+  }
+  void Notify() {
+    const char c = 0;
+    ASSERT_EQ(1, write(notify_fds_[1], &c, 1));
+  }
+  // Waits up to 5 seconds for handler to read given bytes count
+  bool WaitBytesRead(const TestHandler& handler, size_t bytes) {
+    for (int i = 0; i < kWaitStepsCount; ++i) {
+      if (handler.bytes_read() >= bytes) {
+        return true;
+      }
+      usleep(kWaitStepUsecs);
+    }
+    return false;
+  }
+  bool WaitReadyCount(const TestHandler& handler, size_t count) {
+    for (int i = 0; i < kWaitStepsCount; ++i) {
+      if (handler.ready_count() >= count) {
+        return true;
+      }
+      usleep(kWaitStepUsecs);
+    }
+    return false;
+  }
+  bool WaitRemoved(const TestHandler& handler) {
+    for (int i = 0; i < kWaitStepsCount; ++i) {
+      if (handler.removed()) {
+        return true;
+      }
+      usleep(kWaitStepUsecs);
+    }
+    return false;
+  }
+
+  int sockets_[2];
+  int notify_fds_[2];
+  SocketReactor reactor_;
+};
+}  // namespace
+
+TEST_F(SocketReactorTest, DataSent_ExpectHandlerReadsIt) {
+  TestHandler handler(sockets_[0], notify_fds_[0]);
+  ASSERT_TRUE(reactor_.Add(&handler, sockets_[0], notify_fds_[0]));
+  const char data[] = "0123456789";
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(data)),
+            send(sockets_[1], data, sizeof(data), 0));
+  EXPECT_TRUE(WaitBytesRead(handler, sizeof(data)));
+  EXPECT_TRUE(reactor_.Remove(&handler));
+  EXPECT_FALSE(handler.removed());
+}
+
+TEST_F(SocketReactorTest, Notified_ExpectHandlerReady) {
+  TestHandler handler(sockets_[0], notify_fds_[0]);
+  ASSERT_TRUE(reactor_.Add(&handler, sockets_[0], notify_fds_[0]));
+  Notify();
+  EXPECT_TRUE(WaitReadyCount(handler, 1u));
+  EXPECT_EQ(0u, handler.bytes_read());
+  EXPECT_TRUE(reactor_.Remove(&handler));
+}
+
+TEST_F(SocketReactorTest, HandlerFinished_ExpectRemovedByReactor) {
+  TestHandler handler(sockets_[0], notify_fds_[0]);
+  handler.set_finish(true);
+  ASSERT_TRUE(reactor_.Add(&handler, sockets_[0], notify_fds_[0]));
+  Notify();
+  EXPECT_TRUE(WaitRemoved(handler));
+  EXPECT_EQ(1u, handler.ready_count());
+  EXPECT_FALSE(reactor_.Remove(&handler));
+
+  // Descriptors are not watched anymore
+  Notify();
+  usleep(10 * kWaitStepUsecs);
+  EXPECT_EQ(1u, handler.ready_count());
+}
+
+TEST_F(SocketReactorTest, Removed_ExpectNoMoreCallbacks) {
+  TestHandler handler(sockets_[0], notify_fds_[0]);
+  ASSERT_TRUE(reactor_.Add(&handler, sockets_[0], notify_fds_[0]));
+  EXPECT_TRUE(reactor_.Remove(&handler));
+  EXPECT_FALSE(reactor_.Remove(&handler));
+  Notify();
+  usleep(10 * kWaitStepUsecs);
+  EXPECT_EQ(0u, handler.ready_count());
+  EXPECT_FALSE(handler.removed());
+}
+
+TEST_F(SocketReactorTest, WriteWanted_ExpectHandlerReadyOnWritableSocket) {
+  TestHandler handler(sockets_[0], notify_fds_[0]);
+  handler.set_write_wanted(true);
+  ASSERT_TRUE(reactor_.Add(&handler, sockets_[0], notify_fds_[0]));
+  // Empty socket is writable right away
+  EXPECT_TRUE(WaitReadyCount(handler, 1u));
+  EXPECT_TRUE(reactor_.Remove(&handler));
+}
+
+TEST_F(SocketReactorTest, ManyHandlers_ExpectAllServed) {
+  const size_t kHandlersCount = 50;
+  int pairs[kHandlersCount][2];
+  TestHandler* handlers[kHandlersCount];
+  for (size_t i = 0; i < kHandlersCount; ++i) {
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, pairs[i]));
+    // Other socket end is never readable, so it serves as idle notifier
+    handlers[i] = new TestHandler(pairs[i][0], notify_fds_[0]);
+    ASSERT_TRUE(reactor_.Add(handlers[i], pairs[i][0], pairs[i][1]));
+  }
+  const char data[] = "data";
+  for (size_t i = 0; i < kHandlersCount; ++i) {
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(data)),
+              send(pairs[i][1], data, sizeof(data), 0));
+  }
+  for (size_t i = 0; i < kHandlersCount; ++i) {
+    EXPECT_TRUE(WaitBytesRead(*handlers[i], sizeof(data))) << i;
+    EXPECT_TRUE(reactor_.Remove(handlers[i]));
+    delete handlers[i];
+    close(pairs[i][0]);
+    close(pairs[i][1]);
+  }
+}
+
+}  // namespace transport_manager
+}  // namespace components
+}  // namespace test
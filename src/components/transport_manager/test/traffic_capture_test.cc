@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "transport_manager/traffic_capture.h"
+
+namespace test {
+namespace components {
+namespace transport_manager {
+
+using ::transport_manager::TrafficCaptureWriter;
+using ::transport_manager::TrafficCaptureReader;
+using ::transport_manager::CapturedFrame;
+using ::transport_manager::kTrafficInbound;
+using ::transport_manager::kTrafficOutbound;
+using ::protocol_handler::RawMessage;
+
+namespace {
+const char kCaptureFile[] = "traffic_capture_test.bin";
+const uint8_t kHeader[] = {0x21, 0x07, 0x00, 0x01};
+const uint8_t kPayload[] = {0xAB, 0xCD, 0xEF};
+}  // namespace
+
+class TrafficCaptureTest : public ::testing::Test {
+ protected:
+  void TearDown() OVERRIDE {
+    unlink(kCaptureFile);
+  }
+};
+
+TEST_F(TrafficCaptureTest, RecordedFrames_ReadBackInOrder) {
+  TrafficCaptureWriter writer;
+  EXPECT_FALSE(writer.is_open());
+  ASSERT_TRUE(writer.Open(kCaptureFile));
+  EXPECT_TRUE(writer.is_open());
+  const RawMessage received(1, 3, kHeader, sizeof(kHeader));
+  // Fragmented message is captured as a single frame
+  const RawMessage sent(2, 3,
+                        utils::BufferSlice(kHeader, sizeof(kHeader)),
+                        utils::BufferSlice(kPayload, sizeof(kPayload)));
+  EXPECT_TRUE(writer.Record(kTrafficInbound, received));
+  EXPECT_TRUE(writer.Record(kTrafficOutbound, sent));
+  writer.Close();
+  EXPECT_FALSE(writer.Record(kTrafficInbound, received));
+
+  TrafficCaptureReader reader;
+  ASSERT_TRUE(reader.Open(kCaptureFile));
+  CapturedFrame frame;
+  ASSERT_TRUE(reader.Next(&frame));
+  EXPECT_EQ(1u, frame.connection_id);
+  EXPECT_EQ(kTrafficInbound, frame.direction);
+  EXPECT_EQ(std::vector<uint8_t>(kHeader, kHeader + sizeof(kHeader)),
+            frame.data);
+  const uint64_t first_time_stamp = frame.time_stamp;
+
+  ASSERT_TRUE(reader.Next(&frame));
+  EXPECT_EQ(2u, frame.connection_id);
+  EXPECT_EQ(kTrafficOutbound, frame.direction);
+  std::vector<uint8_t> expected(kHeader, kHeader + sizeof(kHeader));
+  expected.insert(expected.end(), kPayload, kPayload + sizeof(kPayload));
+  EXPECT_EQ(expected, frame.data);
+  EXPECT_LE(first_time_stamp, frame.time_stamp);
+
+  EXPECT_FALSE(reader.Next(&frame));
+  EXPECT_TRUE(reader.error().empty());
+}
+
+TEST_F(TrafficCaptureTest, ForeignFile_NotOpened) {
+  FILE* file = fopen(kCaptureFile, "wb");
+  ASSERT_TRUE(file);
+  const std::string text = "not a capture at all";
+  fwrite(text.data(), text.size(), 1, file);
+  fclose(file);
+
+  TrafficCaptureReader reader;
+  EXPECT_FALSE(reader.Open(kCaptureFile));
+  EXPECT_FALSE(reader.error().empty());
+  CapturedFrame frame;
+  EXPECT_FALSE(reader.Next(&frame));
+}
+
+TEST_F(TrafficCaptureTest, TruncatedFrame_ReportedAsError) {
+  {
+    TrafficCaptureWriter writer;
+    ASSERT_TRUE(writer.Open(kCaptureFile));
+    const RawMessage message(1, 3, kPayload, sizeof(kPayload));
+    ASSERT_TRUE(writer.Record(kTrafficInbound, message));
+  }
+  // Cut the last byte of frame data
+  FILE* file = fopen(kCaptureFile, "rb+");
+  ASSERT_TRUE(file);
+  fseek(file, 0, SEEK_END);
+  ASSERT_EQ(0, ftruncate(fileno(file), ftell(file) - 1));
+  fclose(file);
+
+  TrafficCaptureReader reader;
+  ASSERT_TRUE(reader.Open(kCaptureFile));
+  CapturedFrame frame;
+  EXPECT_FALSE(reader.Next(&frame));
+  EXPECT_FALSE(reader.error().empty());
+}
+
+}  // namespace transport_manager
+}  // namespace components
+}  // namespace test
@@ -205,7 +205,7 @@ TEST_F(TransportManagerTest, ScanDeviceNoFound) {
   EXPECT_CALL(*tm_listener, OnDeviceFound(_)).Times(0);
   EXPECT_CALL(*tm_listener, OnScanDevicesFinished()).WillOnce(SignalTest(this));
 
-  EXPECT_CALL(*tm_listener, OnDeviceListUpdated(_));
+  EXPECT_CALL(*tm_listener, OnDeviceListUpdated(_)).Times(0);
 
   //act
   tm->SearchDevices();
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_ASYNC_FILE_IO_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_ASYNC_FILE_IO_H_
+
+#include <stdint.h>
+#include <deque>
+#include <ios>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/singleton.h"
+#include "utils/threads/thread_pool.h"
+
+namespace file_system {
+
+/**
+ * @brief How written data is made durable before completion is reported
+ */
+enum SyncPolicy {
+  // Data is left in page cache
+  kNoSync,
+  // Data is flushed to storage
+  kSyncData,
+  // File is written aside, flushed and renamed over the old one, so it is
+  // never seen written partially even after power loss.
+  // Appends are flushed as with kSyncData
+  kSyncReplace
+};
+
+/**
+ * @brief Completion of asynchronous write, called from I/O thread
+ */
+class WriteCallback {
+ public:
+  virtual ~WriteCallback() {}
+  virtual void OnWritten(const std::string& file_name, bool result) = 0;
+};
+
+/**
+ * @brief Completion of asynchronous read, called from I/O thread
+ */
+class ReadCallback {
+ public:
+  virtual ~ReadCallback() {}
+  virtual void OnRead(const std::string& file_name, bool result,
+                      const std::vector<uint8_t>& content) = 0;
+};
+
+/**
+ * @brief Performs file operations on dedicated I/O threads, so threads
+ * handling messages never wait for storage.
+ * Operations on the same file are done in order they are requested,
+ * different files are served concurrently. Writes to the file requested
+ * while previous ones wait are coalesced: rewrite of whole file drops
+ * not yet written data, appends are written at once.
+ * Callbacks are taken over and deleted after they are called.
+ */
+class AsyncFileIO : public utils::Singleton<AsyncFileIO> {
+ public:
+  /**
+   * @brief Writes data to file, file is created if it does not exist
+   * @param append If true data is appended, otherwise file is rewritten
+   * @param callback Completion callback or NULL
+   */
+  void Write(const std::string& file_name, const std::vector<uint8_t>& data,
+             bool append, SyncPolicy policy, WriteCallback* callback);
+
+  /**
+   * @brief Reads whole file after all writes requested before
+   * @param callback Completion callback
+   */
+  void Read(const std::string& file_name, ReadCallback* callback);
+
+  /**
+   * @brief Blocks until all requested operations are done
+   */
+  void Flush();
+
+  /**
+   * @brief Completes all requested operations
+   */
+  ~AsyncFileIO();
+
+ private:
+  struct Operation {
+    enum Type { kRewrite, kAppend, kRead };
+    Type type;
+    std::vector<uint8_t> data;
+    SyncPolicy policy;
+    WriteCallback* write_callback;
+    ReadCallback* read_callback;
+  };
+  typedef std::deque<Operation*> Operations;
+  // Operations of every file being served
+  typedef std::map<std::string, Operations> FileQueues;
+
+  class FileTask : public threads::ThreadDelegate {
+   public:
+    FileTask(AsyncFileIO* io, const std::string& file_name);
+    virtual void threadMain() OVERRIDE;
+   private:
+    AsyncFileIO& io_;
+    const std::string file_name_;
+  };
+
+  AsyncFileIO();
+
+  void Post(const std::string& file_name, Operation* operation);
+  void Serve(const std::string& file_name);
+  void Execute(const std::string& file_name, Operations* operations);
+  void Complete(const std::string& file_name, bool result,
+                std::vector<Operation*>* writes);
+  bool WriteFile(const std::string& file_name,
+                 const std::vector<uint8_t>& data, bool append,
+                 SyncPolicy policy);
+
+  threads::ThreadPool pool_;
+  sync_primitives::Lock queues_lock_;
+  sync_primitives::ConditionalVariable idle_;
+  FileQueues queues_;
+  size_t pending_count_;
+
+  FRIEND_BASE_SINGLETON_CLASS(AsyncFileIO);
+  DISALLOW_COPY_AND_ASSIGN(AsyncFileIO);
+};
+
+/**
+ * @brief Non-blocking variant of Write
+ * @param callback Completion callback or NULL, it is deleted after call
+ */
+void WriteAsync(const std::string& file_name,
+                const std::vector<uint8_t>& data,
+                std::ios_base::openmode mode = std::ios_base::out,
+                WriteCallback* callback = NULL);
+
+/**
+ * @brief Non-blocking variant of WriteBinaryFile
+ * @param callback Completion callback or NULL, it is deleted after call
+ */
+void WriteBinaryFileAsync(const std::string& name,
+                          const std::vector<uint8_t>& contents,
+                          SyncPolicy policy = kNoSync,
+                          WriteCallback* callback = NULL);
+
+/**
+ * @brief Non-blocking variant of ReadBinaryFile
+ * @param callback Completion callback, it is deleted after call
+ */
+void ReadBinaryFileAsync(const std::string& name, ReadCallback* callback);
+
+}  // namespace file_system
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_ASYNC_FILE_IO_H_
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_CASE_INSENSITIVE_STRING_SET_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_CASE_INSENSITIVE_STRING_SET_H_
+
+#include <set>
+#include <string>
+
+namespace utils {
+
+/**
+ * @brief Set of strings which are equal ignoring case, in the way strcasecmp
+ * compares them: ASCII letters are folded, bytes of other UTF-8 characters
+ * are compared as is. Lets commands find duplicated VR commands of many
+ * choices without comparing every pair of them
+ */
+class CaseInsensitiveStringSet {
+ public:
+  /**
+   * @brief Adds string to set
+   * @param str String to add
+   * @return false if equal string is already in set
+   */
+  bool Insert(const std::string& str);
+
+  /**
+   * @brief Checks if equal string is in set
+   */
+  bool Contains(const std::string& str) const;
+
+  size_t size() const {
+    return strings_.size();
+  }
+
+  bool empty() const {
+    return strings_.empty();
+  }
+
+  void clear() {
+    strings_.clear();
+  }
+
+ private:
+  static std::string FoldCase(const std::string& str);
+
+  std::set<std::string> strings_;
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_CASE_INSENSITIVE_STRING_SET_H_
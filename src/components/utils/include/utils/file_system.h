@@ -39,6 +39,8 @@
 #include <vector>
 #include <iostream>
 
+#include "utils/macro.h"
+
 namespace file_system {
 
 
@@ -218,6 +220,35 @@ bool ReadBinaryFile(const std::string& name,
 
 bool ReadFile(const std::string& name, std::string& result);
 
+/**
+ * @brief Read-only memory mapping of whole file, lets big files
+ * (e.g. preloaded policy table) be parsed in place without copying
+ * them into memory first
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Maps the file, mapping is released by destructor
+   * @param name path to file
+   */
+  explicit MappedFile(const std::string& name);
+  ~MappedFile();
+
+  /**
+   * @return true if file was mapped, empty file is never mapped
+   */
+  bool IsMapped() const;
+  const char* begin() const;
+  const char* end() const;
+  size_t size() const;
+
+ private:
+  void* data_;
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedFile);
+};
+
 /**
   * @brief Convert special symbols in system path to percent-encoded
   *
@@ -33,6 +33,7 @@
 #ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_GEN_HASH_H_
 #define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_GEN_HASH_H_
 
+#include <stdint.h>
 #include <string>
 
 namespace utils {
@@ -45,6 +46,14 @@ namespace utils {
 
 const std::string gen_hash(size_t size);
 
+/**
+ * @brief calculates non cryptographic 64 bit hash (FNV-1a) of data
+ * @param data data to hash
+ * @param size size of data
+ * @return hash of data
+ */
+uint64_t content_hash(const uint8_t* data, size_t size);
+
 }  // namespace utils
 
 #endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_GEN_HASH_H_
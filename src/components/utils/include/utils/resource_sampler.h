@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_RESOURCE_SAMPLER_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_RESOURCE_SAMPLER_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "utils/date_time.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/memory_accounting.h"
+#include "utils/resource_usage.h"
+#include "utils/timer_thread.h"
+#include "utils/threads/message_loop_registry.h"
+
+namespace utils {
+
+struct ResourceSample {
+  ResourceSample();
+
+  TimevalStruct time;
+  ResourseUsage process;
+  std::vector<Resources::ThreadUsage> threads;
+  Resources::AllocatorUsage allocator;
+  threads::MessageLoopRegistry::Depths queues;
+  // Memory held for applications by connection key
+  MemoryAccounting::Snapshot apps_memory;
+  // -1 if it is not known
+  int32_t open_files;
+};
+
+class ResourceSampleObserver {
+ public:
+  virtual void OnResourceSample(const ResourceSample& sample) = 0;
+ protected:
+  virtual ~ResourceSampleObserver() {}
+};
+
+/*
+ * Samples process, per-thread CPU, allocator, message loops queues,
+ * memory held for applications and open files periodically. Every sample is published to metrics
+ * registry as gauges, CPU time is summed by thread name, so component
+ * threads like "AM FromMobile" or "Backup thread" are compared directly.
+ */
+class ResourceSampler {
+ public:
+  static ResourceSampler* instance();
+
+  /*
+   * @brief Collects current sample, parts, which are not available
+   * on platform, are left empty
+   */
+  static void TakeSample(ResourceSample* sample);
+
+  /*
+   * @brief Starts sampling every period, 0 disables it
+   */
+  void Start(uint32_t period_seconds);
+  void Stop();
+
+  /*
+   * @brief Sets observer of samples, NULL removes it.
+   * Observer is called on timer thread.
+   */
+  void set_observer(ResourceSampleObserver* observer);
+
+ private:
+  ResourceSampler();
+  static void CreateInstance();
+  void OnTimer();
+  static void PublishMetrics(const ResourceSample& sample);
+
+  ResourceSampleObserver* observer_;
+  sync_primitives::Lock observer_lock_;
+  timer::TimerThread<ResourceSampler> timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(ResourceSampler);
+};
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_RESOURCE_SAMPLER_H_
@@ -39,7 +39,9 @@
 #endif
 
 #include "utils/macro.h"
+#include <stdint.h>
 #include <string>
+#include <vector>
 #include <iostream>
 
 #include "utils/logger.h"
@@ -113,12 +115,50 @@ class Resources {
 
 #endif
   public:
+  /*
+   * CPU time of one thread in milliseconds,
+   * name is the one set by threads::Thread, truncated by system
+   */
+  struct ThreadUsage {
+    int32_t tid;
+    std::string name;
+    uint64_t utime;
+    uint64_t stime;
+  };
+
+  /*
+   * Heap statistics of allocator in bytes
+   */
+  struct AllocatorUsage {
+    uint64_t arena;
+    uint64_t mmapped;
+    uint64_t in_use;
+    uint64_t free;
+  };
+
     /*
      * @brief Returns current resource usage of process
      * @return Raw pointer on  ResourseUsage if success, otherwise return NULL
      */
   static ResourseUsage* getCurrentResourseUsage();
 
+  /*
+   * @brief Reads CPU time of every thread of process from /proc/PID/task
+   * @return false if it is not supported or task directory can't be read
+   */
+  static bool GetThreadsUsage(std::vector<ThreadUsage>* threads);
+
+  /*
+   * @brief Returns statistics of malloc heap
+   * @return false if allocator does not provide them
+   */
+  static bool GetAllocatorUsage(AllocatorUsage* usage);
+
+  /*
+   * @brief Returns count of file descriptors open by process, -1 on failure
+   */
+  static int32_t GetOpenFilesCount();
+
 private:
 
 #ifdef BUILD_TESTS
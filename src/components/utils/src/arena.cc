@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/arena.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+namespace utils {
+
+namespace {
+size_t AlignUp(size_t size) {
+  return (size + Arena::kAlignment - 1) & ~(Arena::kAlignment - 1);
+}
+
+// Chunk header is padded, so chunk data starts aligned as malloc result is
+const size_t kChunkHeaderSize = 32;
+}  // namespace
+
+Arena::Arena(size_t chunk_size)
+  : chunk_size_(AlignUp(chunk_size ? chunk_size : kDefaultChunkSize)),
+    chunks_(NULL),
+    current_(NULL),
+    limit_(NULL),
+    allocated_bytes_(0),
+    reserved_bytes_(0) {
+}
+
+Arena::~Arena() {
+  while (chunks_) {
+    Chunk* next = chunks_->next;
+    free(chunks_);
+    chunks_ = next;
+  }
+}
+
+void* Arena::Allocate(size_t size) {
+  size = AlignUp(size ? size : 1);
+  if (static_cast<size_t>(limit_ - current_) >= size) {
+    void* memory = current_;
+    current_ += size;
+    allocated_bytes_ += size;
+    return memory;
+  }
+  if (size > chunk_size_ / 4) {
+    // Big block gets dedicated chunk, current one keeps serving small blocks
+    Chunk* chunk = NewChunk(size);
+    if (!chunk) {
+      return NULL;
+    }
+    if (chunks_) {
+      chunk->next = chunks_->next;
+      chunks_->next = chunk;
+    } else {
+      chunks_ = chunk;
+    }
+    allocated_bytes_ += size;
+    return ChunkData(chunk);
+  }
+  Chunk* chunk = NewChunk(chunk_size_);
+  if (!chunk) {
+    return NULL;
+  }
+  chunk->next = chunks_;
+  chunks_ = chunk;
+  current_ = ChunkData(chunk) + size;
+  limit_ = ChunkData(chunk) + chunk_size_;
+  allocated_bytes_ += size;
+  return ChunkData(chunk);
+}
+
+void Arena::Reset() {
+  Chunk* kept = NULL;
+  while (chunks_) {
+    Chunk* next = chunks_->next;
+    if (!kept && chunk_size_ == chunks_->size) {
+      kept = chunks_;
+      kept->next = NULL;
+    } else {
+      reserved_bytes_ -= kChunkHeaderSize + chunks_->size;
+      free(chunks_);
+    }
+    chunks_ = next;
+  }
+  chunks_ = kept;
+  current_ = kept ? ChunkData(kept) : NULL;
+  limit_ = kept ? ChunkData(kept) + chunk_size_ : NULL;
+  allocated_bytes_ = 0;
+}
+
+Arena::Chunk* Arena::NewChunk(size_t size) {
+  Chunk* chunk = static_cast<Chunk*>(malloc(kChunkHeaderSize + size));
+  if (!chunk) {
+    return NULL;
+  }
+  chunk->next = NULL;
+  chunk->size = size;
+  reserved_bytes_ += kChunkHeaderSize + size;
+  return chunk;
+}
+
+char* Arena::ChunkData(Chunk* chunk) {
+  return reinterpret_cast<char*>(chunk) + kChunkHeaderSize;
+}
+
+struct ScopedMessageArena::State {
+  State() : depth(0) {}
+  Arena arena;
+  size_t depth;
+};
+
+namespace {
+pthread_key_t arena_key;
+pthread_once_t arena_key_once = PTHREAD_ONCE_INIT;
+}  // namespace
+
+ScopedMessageArena::ScopedMessageArena()
+  : state_(ThisThreadState(true)) {
+  // Without arena allocations just go to heap
+  if (state_) {
+    ++state_->depth;
+  }
+}
+
+ScopedMessageArena::~ScopedMessageArena() {
+  if (state_ && 0 == --state_->depth) {
+    state_->arena.Reset();
+  }
+}
+
+Arena* ScopedMessageArena::Current() {
+  State* state = ThisThreadState(false);
+  return state && state->depth ? &state->arena : NULL;
+}
+
+ScopedMessageArena::State* ScopedMessageArena::ThisThreadState(bool create) {
+  pthread_once(&arena_key_once, &CreateStateKey);
+  State* state = static_cast<State*>(pthread_getspecific(arena_key));
+  if (!state && create) {
+    state = new (std::nothrow) State();
+    if (state && 0 != pthread_setspecific(arena_key, state)) {
+      delete state;
+      state = NULL;
+    }
+  }
+  return state;
+}
+
+void ScopedMessageArena::CreateStateKey() {
+  pthread_key_create(&arena_key, &DestroyState);
+}
+
+void ScopedMessageArena::DestroyState(void* data) {
+  delete static_cast<State*>(data);
+}
+
+}  // namespace utils
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/async_file_io.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+
+#include "utils/file_system.h"
+#include "utils/logger.h"
+
+namespace file_system {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "Utils")
+
+namespace {
+// Flash handles few requests at once, more threads only queue in kernel
+const size_t kWorkersCount = 2;
+const mode_t kFileMode =
+    S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH;
+}  // namespace
+
+AsyncFileIO::AsyncFileIO()
+  : pool_("FileIO", kWorkersCount),
+    pending_count_(0) {
+}
+
+AsyncFileIO::~AsyncFileIO() {
+  Flush();
+}
+
+void AsyncFileIO::Write(const std::string& file_name,
+                        const std::vector<uint8_t>& data, bool append,
+                        SyncPolicy policy, WriteCallback* callback) {
+  Operation* operation = new Operation;
+  operation->type = append ? Operation::kAppend : Operation::kRewrite;
+  operation->data = data;
+  operation->policy = policy;
+  operation->write_callback = callback;
+  operation->read_callback = NULL;
+  Post(file_name, operation);
+}
+
+void AsyncFileIO::Read(const std::string& file_name, ReadCallback* callback) {
+  DCHECK_OR_RETURN_VOID(callback);
+  Operation* operation = new Operation;
+  operation->type = Operation::kRead;
+  operation->policy = kNoSync;
+  operation->write_callback = NULL;
+  operation->read_callback = callback;
+  Post(file_name, operation);
+}
+
+void AsyncFileIO::Flush() {
+  sync_primitives::AutoLock auto_lock(queues_lock_);
+  while (pending_count_) {
+    idle_.Wait(auto_lock);
+  }
+}
+
+void AsyncFileIO::Post(const std::string& file_name, Operation* operation) {
+  bool is_served = true;
+  {
+    sync_primitives::AutoLock auto_lock(queues_lock_);
+    FileQueues::iterator it = queues_.find(file_name);
+    if (queues_.end() == it) {
+      it = queues_.insert(std::make_pair(file_name, Operations())).first;
+      is_served = false;
+    }
+    it->second.push_back(operation);
+    ++pending_count_;
+  }
+  // File is served by single task at a time, which keeps operations order
+  if (!is_served) {
+    pool_.Schedule(new FileTask(this, file_name));
+  }
+}
+
+void AsyncFileIO::Serve(const std::string& file_name) {
+  for (;;) {
+    Operations operations;
+    {
+      sync_primitives::AutoLock auto_lock(queues_lock_);
+      FileQueues::iterator it = queues_.find(file_name);
+      DCHECK_OR_RETURN_VOID(queues_.end() != it);
+      if (it->second.empty()) {
+        queues_.erase(it);
+        return;
+      }
+      operations.swap(it->second);
+    }
+    const size_t count = operations.size();
+    Execute(file_name, &operations);
+    sync_primitives::AutoLock auto_lock(queues_lock_);
+    pending_count_ -= count;
+    if (!pending_count_) {
+      idle_.Broadcast();
+    }
+  }
+}
+
+void AsyncFileIO::Execute(const std::string& file_name,
+                          Operations* operations) {
+  // Writes since last read are coalesced into single one
+  std::vector<Operation*> writes;
+  std::vector<uint8_t> data;
+  bool append = true;
+  SyncPolicy policy = kNoSync;
+  for (Operations::iterator it = operations->begin();
+       it != operations->end(); ++it) {
+    Operation* operation = *it;
+    if (Operation::kRead == operation->type) {
+      if (!writes.empty()) {
+        Complete(file_name, WriteFile(file_name, data, append, policy),
+                 &writes);
+        data.clear();
+        append = true;
+        policy = kNoSync;
+      }
+      std::vector<uint8_t> content;
+      const bool result = ReadBinaryFile(file_name, content);
+      operation->read_callback->OnRead(file_name, result, content);
+      delete operation->read_callback;
+      delete operation;
+      continue;
+    }
+    if (Operation::kRewrite == operation->type) {
+      // Data not written yet is overwritten anyway
+      data.swap(operation->data);
+      append = false;
+    } else {
+      data.insert(data.end(), operation->data.begin(), operation->data.end());
+    }
+    policy = std::max(policy, operation->policy);
+    writes.push_back(operation);
+  }
+  if (!writes.empty()) {
+    Complete(file_name, WriteFile(file_name, data, append, policy), &writes);
+  }
+}
+
+void AsyncFileIO::Complete(const std::string& file_name, bool result,
+                           std::vector<Operation*>* writes) {
+  if (!result) {
+    LOG4CXX_ERROR(logger_, writes->size() << " writes to " << file_name
+                  << " failed");
+  }
+  for (std::vector<Operation*>::iterator it = writes->begin();
+       it != writes->end(); ++it) {
+    if ((*it)->write_callback) {
+      (*it)->write_callback->OnWritten(file_name, result);
+      delete (*it)->write_callback;
+    }
+    delete *it;
+  }
+  writes->clear();
+}
+
+bool AsyncFileIO::WriteFile(const std::string& file_name,
+                            const std::vector<uint8_t>& data,
+                            const bool append, const SyncPolicy policy) {
+  const bool replace = !append && kSyncReplace == policy;
+  const std::string path = replace ? file_name + ".tmp" : file_name;
+  const int fd = open(path.c_str(), O_WRONLY | O_CREAT |
+                      (append ? O_APPEND : O_TRUNC), kFileMode);
+  if (-1 == fd) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Can't open " << path);
+    return false;
+  }
+  bool result = true;
+  size_t offset = 0;
+  while (result && offset < data.size()) {
+    const ssize_t written = write(fd, &data[offset], data.size() - offset);
+    if (written > 0) {
+      offset += written;
+    } else if (-1 == written && EINTR == errno) {
+      continue;
+    } else {
+      LOG4CXX_ERROR_WITH_ERRNO(logger_, "Can't write " << path);
+      result = false;
+    }
+  }
+  if (result && kNoSync != policy && 0 != fdatasync(fd)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Can't sync " << path);
+    result = false;
+  }
+  close(fd);
+  if (replace) {
+    if (result && 0 != rename(path.c_str(), file_name.c_str())) {
+      LOG4CXX_ERROR_WITH_ERRNO(logger_, "Can't replace " << file_name);
+      result = false;
+    }
+    if (!result) {
+      unlink(path.c_str());
+    }
+  }
+  return result;
+}
+
+AsyncFileIO::FileTask::FileTask(AsyncFileIO* io, const std::string& file_name)
+  : io_(*io),
+    file_name_(file_name) {
+}
+
+void AsyncFileIO::FileTask::threadMain() {
+  io_.Serve(file_name_);
+  // Pool does not own tasks, every file task is run once
+  delete this;
+}
+
+void WriteAsync(const std::string& file_name,
+                const std::vector<uint8_t>& data,
+                std::ios_base::openmode mode, WriteCallback* callback) {
+  AsyncFileIO::instance()->Write(file_name, data,
+                                 0 != (mode & std::ios_base::app), kNoSync,
+                                 callback);
+}
+
+void WriteBinaryFileAsync(const std::string& name,
+                          const std::vector<uint8_t>& contents,
+                          SyncPolicy policy, WriteCallback* callback) {
+  AsyncFileIO::instance()->Write(name, contents, false, policy, callback);
+}
+
+void ReadBinaryFileAsync(const std::string& name, ReadCallback* callback) {
+  AsyncFileIO::instance()->Read(name, callback);
+}
+
+}  // namespace file_system
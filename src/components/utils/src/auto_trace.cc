@@ -34,35 +34,26 @@
 #include <log4cxx/spi/loggingevent.h>
 
 #include "utils/auto_trace.h"
+#include "utils/binary_log.h"
 #include "utils/push_log.h"
 
 namespace logger {
 
-AutoTrace::AutoTrace(
-  log4cxx::LoggerPtr logger,
-  const log4cxx::spi::LocationInfo& location) :
-  logger_(logger), location_(location) {
-  if (logger_->isTraceEnabled()) {
-    push_log(logger_,
-             ::log4cxx::Level::getTrace(),
-             "Enter",
-             apr_time_now(),
-             location_,
-             ::log4cxx::spi::LoggingEvent::getCurrentThreadName()
-    );
-  }
-}
-
-AutoTrace::~AutoTrace() {
-  if (logger_->isTraceEnabled()) {
-    push_log(logger_,
-             ::log4cxx::Level::getTrace(),
-             "Exit",
-             apr_time_now(),
-             location_, // the location corresponds rather to creation of autotrace object than to deletion
-             ::log4cxx::spi::LoggingEvent::getCurrentThreadName()
-    );
+void AutoTrace::Log(const char* message) {
+  if (binary_log_started) {
+    BinaryRecord record(site_, *logger_, ::log4cxx::Level::getTrace());
+    record << message;
+    record.Commit();
+    return;
   }
+  push_log(*logger_,
+           ::log4cxx::Level::getTrace(),
+           message,
+           apr_time_now(),
+           ::log4cxx::spi::LocationInfo(site_->file, site_->function,
+                                        site_->line),
+           ::log4cxx::spi::LoggingEvent::getCurrentThreadName()
+  );
 }
 
 }  // namespace logger
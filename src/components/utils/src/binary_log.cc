@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/binary_log.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/spi/loggingevent.h>
+
+#include "utils/logger.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/memory_barrier.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace logger {
+
+volatile bool binary_log_started = false;
+
+namespace {
+
+// Must be power of two
+const uint32_t kRingSize = 128 * 1024;
+const uint32_t kRingMask = kRingSize - 1;
+// Writer sleep when rings are empty
+const int32_t kWriterIdleMs = 10;
+
+/*
+ * Header of record in thread ring, followed by record arguments
+ */
+struct RingEntry {
+  uint32_t size;
+  const LogSite* site;
+  log4cxx::Logger* logger;
+  int32_t level;
+  uint8_t flags;
+  uint64_t time_stamp;
+};
+
+/*
+ * Single producer single consumer ring of calling thread.
+ * Owner thread moves head, writer moves tail, both positions grow
+ * monotonically and wrap around with uint32.
+ */
+struct ThreadRing {
+  ThreadRing()
+    : head(0),
+      tail(0),
+      dropped(0),
+      finished(false),
+      id(0),
+      reported_dropped(0),
+      defined(false) {
+  }
+
+  uint8_t data[kRingSize];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  volatile uint32_t dropped;
+  volatile bool finished;
+
+  // Set on registration
+  uint32_t id;
+  std::string thread_name;
+
+  // Used by writer only
+  uint32_t reported_dropped;
+  bool defined;
+};
+
+void CopyToRing(ThreadRing* ring, uint32_t pos,
+                const void* src, uint32_t size) {
+  const uint32_t offset = pos & kRingMask;
+  const uint32_t first = std::min(size, kRingSize - offset);
+  memcpy(ring->data + offset, src, first);
+  memcpy(ring->data, static_cast<const uint8_t*>(src) + first, size - first);
+}
+
+void CopyFromRing(const ThreadRing* ring, uint32_t pos,
+                  void* dst, uint32_t size) {
+  const uint32_t offset = pos & kRingMask;
+  const uint32_t first = std::min(size, kRingSize - offset);
+  memcpy(dst, ring->data + offset, first);
+  memcpy(static_cast<uint8_t*>(dst) + first, ring->data, size - first);
+}
+
+class RingRegistry {
+ public:
+  RingRegistry()
+    : next_id_(1) {
+    pthread_key_create(&key_, &RingRegistry::OnThreadExit);
+  }
+
+  /*
+   * Returns ring of calling thread, creates it on first call
+   */
+  ThreadRing* CurrentRing() {
+    ThreadRing* ring = static_cast<ThreadRing*>(pthread_getspecific(key_));
+    if (!ring) {
+      ring = new ThreadRing();
+      LOG4CXX_ENCODE_CHAR(thread_name,
+          log4cxx::spi::LoggingEvent::getCurrentThreadName());
+      ring->thread_name = thread_name;
+      {
+        sync_primitives::AutoLock auto_lock(lock_);
+        ring->id = next_id_++;
+        rings_.push_back(ring);
+      }
+      pthread_setspecific(key_, ring);
+    }
+    return ring;
+  }
+
+  /*
+   * Returns copy of registered rings and forgets rings of exited threads,
+   * which has to be deleted by caller once drained
+   */
+  void TakeRings(std::vector<ThreadRing*>* rings,
+                 std::vector<ThreadRing*>* finished) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    *rings = rings_;
+    std::vector<ThreadRing*>::iterator it = rings_.begin();
+    while (it != rings_.end()) {
+      if ((*it)->finished) {
+        finished->push_back(*it);
+        it = rings_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+ private:
+  static void OnThreadExit(void* data) {
+    ThreadRing* ring = static_cast<ThreadRing*>(data);
+    utils::memory_barrier();
+    ring->finished = true;
+  }
+
+  pthread_key_t key_;
+  sync_primitives::Lock lock_;
+  std::vector<ThreadRing*> rings_;
+  uint32_t next_id_;
+};
+
+RingRegistry& registry() {
+  // Never destroyed, threads may log while static objects are destroyed
+  static RingRegistry* registry = new RingRegistry();
+  return *registry;
+}
+
+/*
+ * Serializes records for file, all values are in host byte order
+ */
+class RecordBuilder {
+ public:
+  void Start(uint8_t type) {
+    buffer_.clear();
+    const uint32_t size = 0;
+    Append(&size, sizeof(size));
+    Append(&type, sizeof(type));
+  }
+
+  template <typename T>
+  void Put(T value) {
+    Append(&value, sizeof(value));
+  }
+
+  void PutString(const std::string& value) {
+    const uint16_t size =
+        static_cast<uint16_t>(std::min<size_t>(value.size(), 0xFFFF));
+    Put(size);
+    Append(value.data(), size);
+  }
+
+  void Append(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+  }
+
+  bool Finish(FILE* file) {
+    const uint32_t size =
+        static_cast<uint32_t>(buffer_.size() - sizeof(uint32_t) - 1);
+    memcpy(&buffer_[0], &size, sizeof(size));
+    return 1 == fwrite(&buffer_[0], buffer_.size(), 1, file);
+  }
+
+ private:
+  std::vector<uint8_t> buffer_;
+};
+
+class BinaryLogWriter : public threads::ThreadDelegate {
+ public:
+  explicit BinaryLogWriter(FILE* file)
+    : file_(file),
+      stop_requested_(false),
+      next_site_id_(1),
+      next_logger_id_(1) {
+  }
+
+  ~BinaryLogWriter() {
+    fclose(file_);
+  }
+
+  bool WriteHeader() {
+    return 1 == fwrite(kBinaryLogMagic, sizeof(kBinaryLogMagic), 1, file_) &&
+           1 == fwrite(&kBinaryLogByteOrder,
+                       sizeof(kBinaryLogByteOrder), 1, file_) &&
+           1 == fwrite(&kBinaryLogVersion,
+                       sizeof(kBinaryLogVersion), 1, file_);
+  }
+
+  void threadMain() {
+    while (!stop_requested_) {
+      if (!Drain()) {
+        fflush(file_);
+        sync_primitives::AutoLock auto_lock(wait_lock_);
+        if (!stop_requested_) {
+          wait_cond_.WaitFor(auto_lock, kWriterIdleMs);
+        }
+      }
+    }
+    // Records left after stop request
+    while (Drain()) {
+    }
+    fflush(file_);
+  }
+
+  void exitThreadMain() {
+    sync_primitives::AutoLock auto_lock(wait_lock_);
+    stop_requested_ = true;
+    wait_cond_.NotifyOne();
+  }
+
+ private:
+  /*
+   * Moves records of all rings to file, returns true if any was moved
+   */
+  bool Drain() {
+    std::vector<ThreadRing*> rings;
+    std::vector<ThreadRing*> finished;
+    registry().TakeRings(&rings, &finished);
+    bool moved = false;
+    for (std::vector<ThreadRing*>::iterator it = rings.begin();
+         it != rings.end(); ++it) {
+      moved = DrainRing(*it) || moved;
+    }
+    // Thread of finished ring is gone, so ring was drained completely
+    for (std::vector<ThreadRing*>::iterator it = finished.begin();
+         it != finished.end(); ++it) {
+      delete *it;
+    }
+    return moved;
+  }
+
+  bool DrainRing(ThreadRing* ring) {
+    const uint32_t head = ring->head;
+    utils::memory_barrier();
+    uint32_t tail = ring->tail;
+    const bool moved = tail != head;
+    if (!ring->defined) {
+      builder_.Start(kRecordThread);
+      builder_.Put(ring->id);
+      builder_.PutString(ring->thread_name);
+      builder_.Finish(file_);
+      ring->defined = true;
+    }
+    while (tail != head) {
+      RingEntry entry;
+      CopyFromRing(ring, tail, &entry, sizeof(entry));
+      const uint32_t args_size = entry.size - sizeof(entry);
+      args_.resize(args_size);
+      if (args_size) {
+        CopyFromRing(ring, tail + sizeof(entry), &args_[0], args_size);
+      }
+      tail += entry.size;
+      WriteEvent(ring->id, entry);
+    }
+    utils::memory_barrier();
+    ring->tail = tail;
+
+    const uint32_t dropped = ring->dropped;
+    if (dropped != ring->reported_dropped) {
+      builder_.Start(kRecordDropped);
+      builder_.Put(ring->id);
+      builder_.Put(dropped - ring->reported_dropped);
+      builder_.Finish(file_);
+      ring->reported_dropped = dropped;
+    }
+    return moved;
+  }
+
+  void WriteEvent(uint32_t thread_id, const RingEntry& entry) {
+    const uint32_t site_id = SiteId(entry.site);
+    const uint32_t logger_id = LoggerId(entry.logger);
+    builder_.Start(kRecordEvent);
+    builder_.Put(site_id);
+    builder_.Put(logger_id);
+    builder_.Put(thread_id);
+    builder_.Put(entry.level);
+    builder_.Put(entry.time_stamp);
+    builder_.Put(entry.flags);
+    if (!args_.empty()) {
+      builder_.Append(&args_[0], args_.size());
+    }
+    builder_.Finish(file_);
+  }
+
+  uint32_t SiteId(const LogSite* site) {
+    std::map<const LogSite*, uint32_t>::const_iterator it = sites_.find(site);
+    if (sites_.end() != it) {
+      return it->second;
+    }
+    const uint32_t id = next_site_id_++;
+    sites_.insert(std::make_pair(site, id));
+    builder_.Start(kRecordSite);
+    builder_.Put(id);
+    builder_.Put(static_cast<uint32_t>(site->line));
+    builder_.PutString(site->file);
+    builder_.PutString(site->function);
+    builder_.Finish(file_);
+    return id;
+  }
+
+  uint32_t LoggerId(log4cxx::Logger* logger) {
+    std::map<log4cxx::Logger*, uint32_t>::const_iterator it =
+        loggers_.find(logger);
+    if (loggers_.end() != it) {
+      return it->second;
+    }
+    const uint32_t id = next_logger_id_++;
+    loggers_.insert(std::make_pair(logger, id));
+    std::string name;
+    logger->getName(name);
+    builder_.Start(kRecordLogger);
+    builder_.Put(id);
+    builder_.PutString(name);
+    builder_.Finish(file_);
+    return id;
+  }
+
+  FILE* file_;
+  volatile bool stop_requested_;
+  sync_primitives::Lock wait_lock_;
+  sync_primitives::ConditionalVariable wait_cond_;
+
+  RecordBuilder builder_;
+  std::vector<uint8_t> args_;
+  std::map<const LogSite*, uint32_t> sites_;
+  std::map<log4cxx::Logger*, uint32_t> loggers_;
+  uint32_t next_site_id_;
+  uint32_t next_logger_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryLogWriter);
+};
+
+sync_primitives::Lock writer_lock;
+threads::Thread* writer_thread = NULL;
+
+}  // namespace
+
+bool StartBinaryLog(const std::string& file_name) {
+  sync_primitives::AutoLock auto_lock(writer_lock);
+  if (writer_thread) {
+    return true;
+  }
+  FILE* file = fopen(file_name.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+  BinaryLogWriter* writer = new BinaryLogWriter(file);
+  if (!writer->WriteHeader()) {
+    delete writer;
+    return false;
+  }
+  registry();
+  writer_thread = threads::CreateThread("BinaryLog", writer);
+  writer_thread->start();
+  utils::memory_barrier();
+  binary_log_started = true;
+  return true;
+}
+
+void StopBinaryLog() {
+  sync_primitives::AutoLock auto_lock(writer_lock);
+  if (!writer_thread) {
+    return;
+  }
+  binary_log_started = false;
+  utils::memory_barrier();
+  writer_thread->join();
+  delete writer_thread->delegate();
+  threads::DeleteThread(writer_thread);
+  writer_thread = NULL;
+}
+
+namespace impl {
+
+BinaryRecordBuffer::BinaryRecordBuffer()
+  : size_(0),
+    text_length_pos_(0),
+    truncated_(false) {
+}
+
+void BinaryRecordBuffer::AppendText(const char* text, size_t length) {
+  if (0 == length) {
+    return;
+  }
+  uint16_t text_length = 0;
+  if (text_length_pos_) {
+    memcpy(&text_length, data_ + text_length_pos_, sizeof(text_length));
+  } else {
+    if (size_ + sizeof(uint8_t) + sizeof(text_length) >= kMaxSize) {
+      truncated_ = true;
+      return;
+    }
+    data_[size_] = kArgString;
+    text_length_pos_ = size_ + sizeof(uint8_t);
+    size_ = text_length_pos_ + sizeof(text_length);
+  }
+  if (size_ + length > kMaxSize) {
+    length = kMaxSize - size_;
+    truncated_ = true;
+  }
+  memcpy(data_ + size_, text, length);
+  size_ += length;
+  text_length += static_cast<uint16_t>(length);
+  memcpy(data_ + text_length_pos_, &text_length, sizeof(text_length));
+}
+
+BinaryRecordBuffer::int_type BinaryRecordBuffer::overflow(int_type c) {
+  if (traits_type::eq_int_type(c, traits_type::eof())) {
+    return traits_type::not_eof(c);
+  }
+  const char symbol = traits_type::to_char_type(c);
+  AppendText(&symbol, 1);
+  return c;
+}
+
+std::streamsize BinaryRecordBuffer::xsputn(const char* s,
+                                           std::streamsize count) {
+  AppendText(s, static_cast<size_t>(count));
+  return count;
+}
+
+}  // namespace impl
+
+BinaryRecord::BinaryRecord(const LogSite* site,
+                           const log4cxx::LoggerPtr& logger,
+                           const log4cxx::LevelPtr& level)
+  : std::ostream(static_cast<impl::BinaryRecordBuffer*>(this)),
+    site_(site),
+    logger_(logger),
+    level_(level->toInt()),
+    time_stamp_(time_now()) {
+}
+
+void BinaryRecord::Commit() {
+  if (!binary_log_started) {
+    return;
+  }
+  ThreadRing* ring = registry().CurrentRing();
+  RingEntry entry;
+  entry.size = static_cast<uint32_t>(sizeof(entry) + size());
+  entry.site = site_;
+  entry.logger = logger_;
+  entry.level = level_;
+  entry.flags = truncated() ? kEventTruncated : 0;
+  entry.time_stamp = time_stamp_;
+
+  const uint32_t head = ring->head;
+  const uint32_t tail = ring->tail;
+  utils::memory_barrier();
+  if (kRingSize - (head - tail) < entry.size) {
+    ++ring->dropped;
+    return;
+  }
+  CopyToRing(ring, head, &entry, sizeof(entry));
+  if (size()) {
+    CopyToRing(ring, head + sizeof(entry), data(), size());
+  }
+  utils::memory_barrier();
+  ring->head = head + entry.size;
+}
+
+}  // namespace logger
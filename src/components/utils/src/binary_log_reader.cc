@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/binary_log_reader.h"
+
+#include <sstream>
+
+#include "utils/binary_log_format.h"
+#include "utils/number_conversion.h"
+
+namespace logger {
+
+BinaryLogReader::BinaryLogReader()
+  : file_(NULL) {
+}
+
+BinaryLogReader::~BinaryLogReader() {
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+bool BinaryLogReader::Open(const std::string& file_name) {
+  file_ = fopen(file_name.c_str(), "rb");
+  if (!file_) {
+    error_ = "Can not open " + file_name;
+    return false;
+  }
+  char magic[sizeof(kBinaryLogMagic)];
+  uint32_t byte_order = 0;
+  uint32_t version = 0;
+  if (1 != fread(magic, sizeof(magic), 1, file_) ||
+      1 != fread(&byte_order, sizeof(byte_order), 1, file_) ||
+      1 != fread(&version, sizeof(version), 1, file_) ||
+      0 != memcmp(magic, kBinaryLogMagic, sizeof(magic))) {
+    error_ = "Not a binary log";
+    return false;
+  }
+  if (kBinaryLogByteOrder != byte_order) {
+    error_ = "Log was written on machine with other byte order";
+    return false;
+  }
+  if (kBinaryLogVersion != version) {
+    error_ = "Unsupported version of binary log";
+    return false;
+  }
+  return true;
+}
+
+bool BinaryLogReader::Next(BinaryLogEvent* event) {
+  if (!event || !file_ || !error_.empty()) {
+    return false;
+  }
+  uint8_t type = 0;
+  while (ReadRecord(&type)) {
+    size_t offset = 0;
+    uint32_t id = 0;
+    if (!Get(&offset, &id)) {
+      break;
+    }
+    switch (type) {
+      case kRecordSite: {
+        Site site;
+        if (!Get(&offset, &site.line) ||
+            !GetString(&offset, &site.file) ||
+            !GetString(&offset, &site.function)) {
+          error_ = "Broken site record";
+          return false;
+        }
+        sites_[id] = site;
+        break;
+      }
+      case kRecordLogger:
+        if (!GetString(&offset, &loggers_[id])) {
+          error_ = "Broken logger record";
+          return false;
+        }
+        break;
+      case kRecordThread:
+        if (!GetString(&offset, &threads_[id])) {
+          error_ = "Broken thread record";
+          return false;
+        }
+        break;
+      case kRecordEvent:
+        return ReadEvent(event);
+      case kRecordDropped:
+        *event = BinaryLogEvent();
+        event->thread = threads_[id];
+        if (!Get(&offset, &event->dropped)) {
+          error_ = "Broken dropped record";
+          return false;
+        }
+        return true;
+      default:
+        // Records of newer writers are skipped
+        break;
+    }
+  }
+  return false;
+}
+
+bool BinaryLogReader::ReadRecord(uint8_t* type) {
+  uint32_t size = 0;
+  if (1 != fread(&size, sizeof(size), 1, file_)) {
+    return false;
+  }
+  payload_.resize(size);
+  if (1 != fread(type, sizeof(*type), 1, file_) ||
+      (size && 1 != fread(&payload_[0], size, 1, file_))) {
+    error_ = "Unexpected end of file";
+    return false;
+  }
+  return true;
+}
+
+bool BinaryLogReader::ReadEvent(BinaryLogEvent* event) {
+  size_t offset = 0;
+  uint32_t site_id = 0;
+  uint32_t logger_id = 0;
+  uint32_t thread_id = 0;
+  uint8_t flags = 0;
+  *event = BinaryLogEvent();
+  if (!Get(&offset, &site_id) ||
+      !Get(&offset, &logger_id) ||
+      !Get(&offset, &thread_id) ||
+      !Get(&offset, &event->level) ||
+      !Get(&offset, &event->time_stamp) ||
+      !Get(&offset, &flags) ||
+      !FormatArguments(offset, &event->message)) {
+    error_ = "Broken event record";
+    return false;
+  }
+  const Site& site = sites_[site_id];
+  event->file = site.file;
+  event->function = site.function;
+  event->line = site.line;
+  event->logger = loggers_[logger_id];
+  event->thread = threads_[thread_id];
+  event->truncated = 0 != (flags & kEventTruncated);
+  return true;
+}
+
+bool BinaryLogReader::FormatArguments(size_t offset, std::string* message) {
+  // Integers are the most of arguments, they are formatted without stream
+  std::string text;
+  char buffer[utils::kInt64StringSize];
+  while (offset < payload_.size()) {
+    uint8_t tag = 0;
+    Get(&offset, &tag);
+    bool result = false;
+    switch (tag) {
+      case kArgInt64: {
+        int64_t value = 0;
+        result = Get(&offset, &value);
+        text.append(buffer, utils::FormatInt64(value, buffer));
+        break;
+      }
+      case kArgUInt64: {
+        uint64_t value = 0;
+        result = Get(&offset, &value);
+        text.append(buffer, utils::FormatUInt64(value, buffer));
+        break;
+      }
+      case kArgDouble: {
+        double value = 0;
+        result = Get(&offset, &value);
+        // Stream format of doubles is kept
+        std::ostringstream stream;
+        stream << value;
+        text += stream.str();
+        break;
+      }
+      case kArgChar: {
+        char value = 0;
+        result = Get(&offset, &value);
+        text += value;
+        break;
+      }
+      case kArgBool: {
+        uint8_t value = 0;
+        result = Get(&offset, &value);
+        text += value ? '1' : '0';
+        break;
+      }
+      case kArgString: {
+        std::string value;
+        result = GetString(&offset, &value);
+        text += value;
+        break;
+      }
+      default:
+        break;
+    }
+    if (!result) {
+      return false;
+    }
+  }
+  message->swap(text);
+  return true;
+}
+
+bool BinaryLogReader::GetString(size_t* offset, std::string* value) {
+  uint16_t size = 0;
+  if (!Get(offset, &size) || *offset + size > payload_.size()) {
+    return false;
+  }
+  value->assign(reinterpret_cast<const char*>(&payload_[0]) + *offset, size);
+  *offset += size;
+  return true;
+}
+
+}  // namespace logger
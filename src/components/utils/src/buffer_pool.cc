@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/buffer_pool.h"
+
+#include <stdint.h>
+#include <map>
+#include <new>
+#include <vector>
+
+#include "utils/lock.h"
+
+namespace utils {
+
+class BufferPool::Blocks : public BufferSlice::Allocator {
+ public:
+  explicit Blocks(size_t max_cached_bytes)
+    : max_cached_bytes_(max_cached_bytes),
+      cached_bytes_(0) {
+  }
+
+  ~Blocks() {
+    for (FreeBlocks::iterator it = free_blocks_.begin();
+         it != free_blocks_.end(); ++it) {
+      for (size_t i = 0; i < it->second.size(); ++i) {
+        delete[] it->second[i];
+      }
+    }
+  }
+
+  uint8_t* Allocate(size_t block_size) {
+    {
+      sync_primitives::AutoLock auto_lock(lock_);
+      FreeBlocks::iterator it = free_blocks_.find(block_size);
+      if (it != free_blocks_.end() && !it->second.empty()) {
+        uint8_t* block = it->second.back();
+        it->second.pop_back();
+        cached_bytes_ -= block_size;
+        return block;
+      }
+    }
+    return new (std::nothrow) uint8_t[block_size];
+  }
+
+  void Free(uint8_t* data, size_t size) OVERRIDE {
+    {
+      sync_primitives::AutoLock auto_lock(lock_);
+      if (cached_bytes_ + size <= max_cached_bytes_) {
+        free_blocks_[size].push_back(data);
+        cached_bytes_ += size;
+        return;
+      }
+    }
+    delete[] data;
+  }
+
+  size_t cached_bytes() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return cached_bytes_;
+  }
+
+ private:
+  // Free blocks by their size
+  typedef std::map<size_t, std::vector<uint8_t*> > FreeBlocks;
+
+  const size_t max_cached_bytes_;
+  size_t cached_bytes_;
+  FreeBlocks free_blocks_;
+  mutable sync_primitives::Lock lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(Blocks);
+};
+
+BufferPool::BufferPool(size_t min_block_size, size_t max_block_size,
+                       size_t max_cached_bytes)
+  : min_block_size_(min_block_size),
+    max_block_size_(max_block_size),
+    blocks_(new Blocks(max_cached_bytes)) {
+  DCHECK(min_block_size_ > 0);
+  DCHECK(min_block_size_ <= max_block_size_);
+}
+
+BufferPool::~BufferPool() {
+}
+
+BufferSlice BufferPool::Allocate(size_t size) {
+  if (0 == size) {
+    return BufferSlice();
+  }
+  if (size > max_block_size_) {
+    return BufferSlice(size);
+  }
+  const size_t block_size = BlockSize(size);
+  uint8_t* block = blocks_->Allocate(block_size);
+  if (!block) {
+    return BufferSlice();
+  }
+  // Blocks are kept alive by every storage taken from them
+  const BufferSlice::AllocatorPtr allocator = blocks_;
+  return BufferSlice(block, block_size, allocator).Slice(0, size);
+}
+
+size_t BufferPool::cached_bytes() const {
+  return blocks_->cached_bytes();
+}
+
+size_t BufferPool::BlockSize(size_t size) const {
+  size_t block_size = min_block_size_;
+  while (block_size < size) {
+    block_size *= 2;
+  }
+  return block_size;
+}
+
+}  // namespace utils
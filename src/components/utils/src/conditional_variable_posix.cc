@@ -85,9 +85,11 @@ void ConditionalVariable::Broadcast() {
 
 bool ConditionalVariable::Wait(Lock& lock) {
   lock.AssertTakenAndMarkFree();
+  lock.MarkReleased();
   int32_t wait_status = pthread_cond_wait(&cond_var_,
                                       &lock.mutex_);
   lock.AssertFreeAndMarkTaken();
+  lock.MarkHeld(false, 0);
   if (wait_status != 0) {
     LOG4CXX_ERROR(logger_, "Failed to wait for conditional variable");
     return false;
@@ -98,9 +100,11 @@ bool ConditionalVariable::Wait(Lock& lock) {
 bool ConditionalVariable::Wait(AutoLock& auto_lock) {
   Lock& lock = auto_lock.GetLock();
   lock.AssertTakenAndMarkFree();
+  lock.MarkReleased();
   int32_t wait_status = pthread_cond_wait(&cond_var_,
                                       &lock.mutex_);
   lock.AssertFreeAndMarkTaken();
+  lock.MarkHeld(false, 0);
   if (wait_status != 0) {
     LOG4CXX_ERROR(logger_, "Failed to wait for conditional variable");
     return false;
@@ -121,10 +125,12 @@ ConditionalVariable::WaitStatus ConditionalVariable::WaitFor(
   wait_interval.tv_nsec %= kNanosecondsPerSecond;
   Lock& lock = auto_lock.GetLock();
   lock.AssertTakenAndMarkFree();
+  lock.MarkReleased();
   int32_t timedwait_status = pthread_cond_timedwait(&cond_var_,
                                                 &lock.mutex_,
                                                 &wait_interval);
   lock.AssertFreeAndMarkTaken();
+  lock.MarkHeld(false, 0);
   WaitStatus wait_status = kNoTimeout;
   switch(timedwait_status) {
     case 0: {
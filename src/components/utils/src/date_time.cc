@@ -31,21 +31,46 @@
 */
 
 #include <sys/time.h>
+#include <time.h>
 #include <stdint.h>
 #include "utils/date_time.h"
 
 
 namespace date_time {
 
+namespace {
+TimevalStruct ReadClock(clockid_t clock_id) {
+  timespec now = {0, 0};
+  clock_gettime(clock_id, &now);
+  TimevalStruct result;
+  result.tv_sec = now.tv_sec;
+  result.tv_usec = now.tv_nsec / 1000;
+  return result;
+}
+}  // namespace
+
   TimevalStruct DateTime::getCurrentTime() {
     TimevalStruct currentTime;
-    timezone timeZone;
+    struct timezone timeZone;
 
     gettimeofday(&currentTime, &timeZone);
 
     return currentTime;
   }
 
+TimevalStruct DateTime::getMonotonicTime() {
+#ifdef CLOCK_MONOTONIC_COARSE
+  // Taken from last tick without reading hardware counter
+  return ReadClock(CLOCK_MONOTONIC_COARSE);
+#else
+  return ReadClock(CLOCK_MONOTONIC);
+#endif
+}
+
+TimevalStruct DateTime::getPreciseMonotonicTime() {
+  return ReadClock(CLOCK_MONOTONIC);
+}
+
 int64_t date_time::DateTime::getSecs(const TimevalStruct &time) {
    return static_cast<int64_t>(time.tv_sec);
 }
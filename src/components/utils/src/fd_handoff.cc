@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/fd_handoff.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+#include "utils/logger.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace utils {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "Utils")
+
+namespace {
+FdHandoff* handoff_instance = NULL;
+pthread_once_t handoff_once = PTHREAD_ONCE_INIT;
+
+// First byte of each message tells its kind
+const char kDescriptorMessage = 'F';
+const char kEndOfDescriptorsMessage = 'E';
+const char kStateSavedMessage = 'S';
+const size_t kMaxNameLength = 128;
+
+#ifdef MSG_NOSIGNAL
+const int kSendFlags = MSG_NOSIGNAL;
+#else
+const int kSendFlags = 0;
+#endif
+#ifdef MSG_CMSG_CLOEXEC
+const int kReceiveFlags = MSG_CMSG_CLOEXEC;
+#else
+const int kReceiveFlags = 0;
+#endif
+
+bool SendMessage(int channel, const std::string& payload, int fd) {
+  iovec data = { const_cast<char*>(payload.data()), payload.size() };
+  msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_iov = &data;
+  message.msg_iovlen = 1;
+  char control[CMSG_SPACE(sizeof(int))];
+  if (fd >= 0) {
+    memset(control, 0, sizeof(control));
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(header), &fd, sizeof(int));
+  }
+  ssize_t sent = -1;
+  do {
+    sent = sendmsg(channel, &message, kSendFlags);
+  } while (sent < 0 && EINTR == errno);
+  return static_cast<ssize_t>(payload.size()) == sent;
+}
+
+bool FillAddress(const std::string& path, sockaddr_un* address) {
+  memset(address, 0, sizeof(*address));
+  address->sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address->sun_path)) {
+    return false;
+  }
+  memcpy(address->sun_path, path.c_str(), path.size() + 1);
+  return true;
+}
+
+void CloseAll(FdHandoff::Descriptors* descriptors) {
+  for (FdHandoff::Descriptors::const_iterator it = descriptors->begin();
+       it != descriptors->end(); ++it) {
+    close(it->second);
+  }
+  descriptors->clear();
+}
+}  // namespace
+
+class FdHandoff::ServingDelegate : public threads::ThreadDelegate {
+ public:
+  explicit ServingDelegate(FdHandoff* handoff)
+    : handoff_(handoff) {
+  }
+
+  virtual void threadMain() {
+    handoff_->Serve();
+  }
+
+  virtual void exitThreadMain() {
+    // Wakes accept() up
+    shutdown(handoff_->listener_, SHUT_RDWR);
+  }
+
+ private:
+  FdHandoff* handoff_;
+};
+
+FdHandoff* FdHandoff::instance() {
+  pthread_once(&handoff_once, &FdHandoff::CreateInstance);
+  return handoff_instance;
+}
+
+void FdHandoff::CreateInstance() {
+  // Never deleted, descriptors are withdrawn by components destroyed late
+  handoff_instance = new FdHandoff();
+}
+
+FdHandoff::FdHandoff()
+  : handed_over_(false),
+    listener_(-1),
+    successor_(-1),
+    thread_(NULL) {
+}
+
+FdHandoff::~FdHandoff() {
+  StopServing();
+  CloseInherited();
+  if (-1 != successor_) {
+    close(successor_);
+  }
+}
+
+bool FdHandoff::SendDescriptors(int channel, const Descriptors& descriptors) {
+  for (Descriptors::const_iterator it = descriptors.begin();
+       it != descriptors.end(); ++it) {
+    if (it->first.size() > kMaxNameLength || it->second < 0) {
+      LOG4CXX_WARN(logger_, "Descriptor " << it->first << " is skipped");
+      continue;
+    }
+    if (!SendMessage(channel, kDescriptorMessage + it->first, it->second)) {
+      LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to send " << it->first);
+      return false;
+    }
+  }
+  return SendMessage(channel, std::string(1, kEndOfDescriptorsMessage), -1);
+}
+
+bool FdHandoff::ReceiveDescriptors(int channel, Descriptors* descriptors) {
+  DCHECK(descriptors);
+  while (true) {
+    char payload[kMaxNameLength + 1];
+    iovec data = { payload, sizeof(payload) };
+    char control[CMSG_SPACE(sizeof(int))];
+    msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    const ssize_t received = recvmsg(channel, &message, kReceiveFlags);
+    if (received < 0 && EINTR == errno) {
+      continue;
+    }
+    if (received <= 0) {
+      return false;
+    }
+    int fd = -1;
+    for (cmsghdr* header = CMSG_FIRSTHDR(&message); header;
+         header = CMSG_NXTHDR(&message, header)) {
+      if (SOL_SOCKET == header->cmsg_level &&
+          SCM_RIGHTS == header->cmsg_type) {
+        memcpy(&fd, CMSG_DATA(header), sizeof(int));
+      }
+    }
+    if (kEndOfDescriptorsMessage == payload[0] && -1 == fd) {
+      return true;
+    }
+    if (kDescriptorMessage != payload[0] || -1 == fd ||
+        (message.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+      if (-1 != fd) {
+        close(fd);
+      }
+      return false;
+    }
+    const std::string name(payload + 1, received - 1);
+    Descriptors::iterator it = descriptors->find(name);
+    if (descriptors->end() != it) {
+      close(it->second);
+    }
+    (*descriptors)[name] = fd;
+  }
+}
+
+bool FdHandoff::TakeOver(const std::string& path, int32_t timeout_ms) {
+  sockaddr_un address;
+  if (path.empty() || !FillAddress(path, &address)) {
+    return false;
+  }
+  const int channel = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  if (-1 == channel) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to create handoff socket");
+    return false;
+  }
+  if (0 != connect(channel, reinterpret_cast<sockaddr*>(&address),
+                   sizeof(address))) {
+    LOG4CXX_INFO(logger_, "No SDL to take over from " << path);
+    close(channel);
+    return false;
+  }
+  timeval timeout = { timeout_ms / 1000, (timeout_ms % 1000) * 1000 };
+  setsockopt(channel, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  Descriptors received;
+  if (!ReceiveDescriptors(channel, &received)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to receive descriptors");
+    CloseAll(&received);
+    close(channel);
+    return false;
+  }
+  // Predecessor state is loaded only when it is saved
+  char state = 0;
+  ssize_t result = -1;
+  do {
+    result = recv(channel, &state, sizeof(state), 0);
+  } while (result < 0 && EINTR == errno);
+  if (1 != result || kStateSavedMessage != state) {
+    LOG4CXX_WARN(logger_, "Predecessor has not reported its state saved");
+  }
+  close(channel);
+
+  sync_primitives::AutoLock auto_lock(lock_);
+  CloseAll(&inherited_);
+  inherited_.swap(received);
+  LOG4CXX_INFO(logger_, "Took over " << inherited_.size() << " descriptors");
+  return true;
+}
+
+int FdHandoff::TakeInherited(const std::string& name) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  Descriptors::iterator it = inherited_.find(name);
+  if (inherited_.end() == it) {
+    return -1;
+  }
+  const int fd = it->second;
+  inherited_.erase(it);
+  return fd;
+}
+
+void FdHandoff::CloseInherited() {
+  sync_primitives::AutoLock auto_lock(lock_);
+  CloseAll(&inherited_);
+}
+
+void FdHandoff::Publish(const std::string& name, int fd) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  published_[name] = fd;
+}
+
+void FdHandoff::Withdraw(const std::string& name) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  published_.erase(name);
+}
+
+bool FdHandoff::StartServing(const std::string& path) {
+  sockaddr_un address;
+  if (path.empty() || !FillAddress(path, &address)) {
+    return false;
+  }
+  sync_primitives::AutoLock auto_lock(lock_);
+  if (thread_) {
+    return false;
+  }
+  listener_ = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  if (-1 == listener_) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to create handoff socket");
+    return false;
+  }
+  // Left by predecessor, which does not serve it anymore
+  unlink(path.c_str());
+  if (0 != bind(listener_, reinterpret_cast<sockaddr*>(&address),
+                sizeof(address)) || 0 != listen(listener_, 1)) {
+    LOG4CXX_ERROR_WITH_ERRNO(logger_, "Failed to listen on " << path);
+    close(listener_);
+    listener_ = -1;
+    return false;
+  }
+  path_ = path;
+  thread_ = threads::CreateThread("FdHandoff", new ServingDelegate(this));
+  if (!thread_->start()) {
+    LOG4CXX_ERROR(logger_, "Failed to start handoff thread");
+    delete thread_->delegate();
+    threads::DeleteThread(thread_);
+    thread_ = NULL;
+    close(listener_);
+    listener_ = -1;
+    unlink(path.c_str());
+    return false;
+  }
+  return true;
+}
+
+void FdHandoff::Complete() {
+  StopServing();
+  sync_primitives::AutoLock auto_lock(lock_);
+  if (-1 != successor_) {
+    SendMessage(successor_, std::string(1, kStateSavedMessage), -1);
+    close(successor_);
+    successor_ = -1;
+  }
+}
+
+bool FdHandoff::handed_over() const {
+  sync_primitives::AutoLock auto_lock(lock_);
+  return handed_over_;
+}
+
+void FdHandoff::Serve() {
+  while (true) {
+    const int channel = accept(listener_, NULL, NULL);
+    if (-1 == channel) {
+      if (EINTR == errno) {
+        continue;
+      }
+      break;
+    }
+    sync_primitives::AutoLock auto_lock(lock_);
+    if (handed_over_) {
+      close(channel);
+      continue;
+    }
+    if (!SendDescriptors(channel, published_)) {
+      close(channel);
+      continue;
+    }
+    LOG4CXX_INFO(logger_, "Descriptors are handed over, stopping");
+    handed_over_ = true;
+    successor_ = channel;
+    // Stops as on signal, successor is released by Complete()
+    kill(getpid(), SIGTERM);
+  }
+}
+
+void FdHandoff::StopServing() {
+  threads::Thread* thread = NULL;
+  {
+    sync_primitives::AutoLock auto_lock(lock_);
+    thread = thread_;
+    thread_ = NULL;
+  }
+  if (!thread) {
+    return;
+  }
+  thread->join();
+  delete thread->delegate();
+  threads::DeleteThread(thread);
+
+  sync_primitives::AutoLock auto_lock(lock_);
+  close(listener_);
+  listener_ = -1;
+  unlink(path_.c_str());
+  path_.clear();
+}
+
+}  // namespace utils
@@ -36,6 +36,8 @@
 #include <sys/statvfs.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <sstream>
 
 #include <dirent.h>
@@ -373,6 +375,49 @@ bool file_system::ReadFile(const std::string& name, std::string& result) {
   return true;
 }
 
+file_system::MappedFile::MappedFile(const std::string& name)
+    : data_(NULL),
+      size_(0) {
+  const int fd = open(name.c_str(), O_RDONLY);
+  if (-1 == fd) {
+    LOG4CXX_WARN(logger_, "Unable to open file " << name);
+    return;
+  }
+  struct stat file_info = { 0 };
+  if (0 == fstat(fd, &file_info) && file_info.st_size > 0) {
+    void* data = mmap(NULL, file_info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED != data) {
+      data_ = data;
+      size_ = file_info.st_size;
+    } else {
+      LOG4CXX_WARN(logger_, "Unable to map file " << name);
+    }
+  }
+  close(fd);
+}
+
+file_system::MappedFile::~MappedFile() {
+  if (data_) {
+    munmap(data_, size_);
+  }
+}
+
+bool file_system::MappedFile::IsMapped() const {
+  return NULL != data_;
+}
+
+const char* file_system::MappedFile::begin() const {
+  return static_cast<const char*>(data_);
+}
+
+const char* file_system::MappedFile::end() const {
+  return begin() + size_;
+}
+
+size_t file_system::MappedFile::size() const {
+  return size_;
+}
+
 const std::string file_system::ConvertPathForURL(const std::string& path) {
   std::string::const_iterator it_path = path.begin();
   std::string::const_iterator it_path_end = path.end();
@@ -50,4 +50,13 @@ const std::string gen_hash(size_t size) {
   return hash;
 }
 
+uint64_t content_hash(const uint8_t* data, size_t size) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 }  // namespace utils
@@ -38,6 +38,7 @@
 #include <string.h>
 
 #include "utils/logger.h"
+#include "utils/lock_profiler.h"
 
 namespace sync_primitives {
 
@@ -49,6 +50,11 @@ Lock::Lock()
       is_mutex_recursive_(false)
 #endif // NDEBUG
 {
+#ifdef LOCK_PROFILING
+  statistics_ = NULL;
+  acquired_at_ = 0;
+  hold_depth_ = 0;
+#endif // LOCK_PROFILING
   const int32_t status = pthread_mutex_init(&mutex_, NULL);
   if (status != 0) {
     LOG4CXX_ERROR(logger_, "Failed to initialize mutex");
@@ -61,6 +67,11 @@ Lock::Lock(bool is_mutex_recursive)
       is_mutex_recursive_(is_mutex_recursive)
 #endif // NDEBUG
 {
+#ifdef LOCK_PROFILING
+  statistics_ = NULL;
+  acquired_at_ = 0;
+  hold_depth_ = 0;
+#endif // LOCK_PROFILING
   int32_t status;
 
   if (is_mutex_recursive) {
@@ -92,16 +103,33 @@ Lock::~Lock() {
 }
 
 void Lock::Acquire() {
+  bool contended = false;
+  uint64_t wait_time = 0;
+#ifdef LOCK_PROFILING
+  int32_t status = statistics_ ? pthread_mutex_trylock(&mutex_) : EBUSY;
+  if (EBUSY == status) {
+    contended = (NULL != statistics_);
+    const uint64_t wait_start =
+        contended ? LockProfiler::CurrentTimeUsec() : 0;
+    status = pthread_mutex_lock(&mutex_);
+    if (contended) {
+      wait_time = LockProfiler::CurrentTimeUsec() - wait_start;
+    }
+  }
+#else
   const int32_t status = pthread_mutex_lock(&mutex_);
+#endif // LOCK_PROFILING
   if (status != 0) {
     LOG4CXX_ERROR(logger_, "Failed to acquire mutex " << &mutex_ << ": " << strerror(status));
   } else {
     AssertFreeAndMarkTaken();
+    MarkHeld(contended, wait_time);
   }
 }
 
 void Lock::Release() {
   AssertTakenAndMarkFree();
+  MarkReleased();
   const int32_t status = pthread_mutex_unlock(&mutex_);
   if (status != 0) {
     LOG4CXX_ERROR(logger_, "Failed to unlock mutex" << &mutex_ << ": " << strerror(status));
@@ -114,11 +142,42 @@ bool Lock::Try() {
 #ifndef NDEBUG
     lock_taken_++;
 #endif
+    MarkHeld(false, 0);
     return true;
   }
   return false;
 }
 
+#ifdef LOCK_PROFILING
+void Lock::set_name(const char* name) {
+  DCHECK(name);
+  statistics_ = LockProfiler::instance()->Register(name);
+}
+
+void Lock::MarkHeld(bool contended, uint64_t wait_time) {
+  if (!statistics_) {
+    return;
+  }
+  statistics_->OnAcquired(contended, wait_time);
+  // Recursive lock is accounted as held by its outermost owner only
+  if (0 == hold_depth_++) {
+    acquired_at_ = LockProfiler::CurrentTimeUsec();
+  }
+}
+
+void Lock::MarkReleased() {
+  if (!statistics_ || 0 == hold_depth_) {
+    return;
+  }
+  if (0 == --hold_depth_) {
+    statistics_->OnReleased(LockProfiler::CurrentTimeUsec() - acquired_at_);
+  }
+}
+#else
+void Lock::set_name(const char* name) {
+}
+#endif // LOCK_PROFILING
+
 #ifndef NDEBUG
 void Lock::AssertFreeAndMarkTaken() {
   if ((lock_taken_ > 0) && !is_mutex_recursive_) {
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/lock_profiler.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <algorithm>
+
+namespace sync_primitives {
+
+namespace {
+LockProfiler* profiler_instance = NULL;
+pthread_once_t profiler_once = PTHREAD_ONCE_INIT;
+}  // namespace
+
+LockStatistics::LockStatistics()
+  : acquisitions(0),
+    contentions(0),
+    total_wait_time(0),
+    max_wait_time(0),
+    total_hold_time(0),
+    max_hold_time(0) {
+}
+
+LockStatistics::LockStatistics(const std::string& lock_name)
+  : name(lock_name),
+    acquisitions(0),
+    contentions(0),
+    total_wait_time(0),
+    max_wait_time(0),
+    total_hold_time(0),
+    max_hold_time(0) {
+}
+
+LockStatistics::LockStatistics(const LockStatistics& other)
+  : acquisitions(0),
+    contentions(0),
+    total_wait_time(0),
+    max_wait_time(0),
+    total_hold_time(0),
+    max_hold_time(0) {
+  *this = other;
+}
+
+LockStatistics& LockStatistics::operator=(const LockStatistics& other) {
+  if (this == &other) {
+    return *this;
+  }
+  other.spin_.Lock();
+  name = other.name;
+  acquisitions = other.acquisitions;
+  contentions = other.contentions;
+  total_wait_time = other.total_wait_time;
+  max_wait_time = other.max_wait_time;
+  total_hold_time = other.total_hold_time;
+  max_hold_time = other.max_hold_time;
+  other.spin_.Unlock();
+  return *this;
+}
+
+void LockStatistics::OnAcquired(bool contended, uint64_t wait_time) {
+  spin_.Lock();
+  ++acquisitions;
+  if (contended) {
+    ++contentions;
+    total_wait_time += wait_time;
+    max_wait_time = std::max(max_wait_time, wait_time);
+  }
+  spin_.Unlock();
+}
+
+void LockStatistics::OnReleased(uint64_t hold_time) {
+  spin_.Lock();
+  total_hold_time += hold_time;
+  max_hold_time = std::max(max_hold_time, hold_time);
+  spin_.Unlock();
+}
+
+LockProfiler::LockProfiler() {
+}
+
+LockProfiler* LockProfiler::instance() {
+  pthread_once(&profiler_once, &LockProfiler::CreateInstance);
+  return profiler_instance;
+}
+
+void LockProfiler::CreateInstance() {
+  // Intentionally never deleted, see class description
+  profiler_instance = new LockProfiler();
+}
+
+LockStatistics* LockProfiler::Register(const std::string& name) {
+  AutoLock auto_lock(statistics_lock_);
+  StatisticsMap::iterator it = statistics_.find(name);
+  if (statistics_.end() == it) {
+    it = statistics_.insert(
+        std::make_pair(name, new LockStatistics(name))).first;
+  }
+  return it->second;
+}
+
+void LockProfiler::Snapshot(std::vector<LockStatistics>* statistics) const {
+  DCHECK(statistics);
+  AutoLock auto_lock(statistics_lock_);
+  statistics->clear();
+  statistics->reserve(statistics_.size());
+  for (StatisticsMap::const_iterator it = statistics_.begin();
+       statistics_.end() != it; ++it) {
+    statistics->push_back(*it->second);
+  }
+}
+
+uint64_t LockProfiler::CurrentTimeUsec() {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+}  // namespace sync_primitives
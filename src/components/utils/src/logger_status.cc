@@ -31,9 +31,17 @@
  */
 
 #include "utils/logger_status.h"
+#include "utils/logger_level_cache.h"
+#include "utils/atomic.h"
 
 namespace logger {
 
 volatile LoggerStatus logger_status = LoggerThreadNotCreated;
 
+volatile uint32_t levels_generation = 1;
+
+void LevelsChanged() {
+  atomic_post_inc(&levels_generation);
+}
+
 }  // namespace logger
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/memory_accounting.h"
+
+#include <pthread.h>
+
+namespace utils {
+
+namespace {
+MemoryAccounting* accounting_instance = NULL;
+pthread_once_t accounting_once = PTHREAD_ONCE_INIT;
+
+const char* const kCategoryNames[MemoryAccounting::kCategoriesCount] = {
+  "app_state",
+  "multi_frame",
+  "queued_messages"
+};
+}  // namespace
+
+MemoryAccounting::Usage::Usage() {
+  for (uint32_t i = 0; i < kCategoriesCount; ++i) {
+    bytes[i] = 0;
+  }
+}
+
+uint64_t MemoryAccounting::Usage::Total() const {
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < kCategoriesCount; ++i) {
+    total += bytes[i];
+  }
+  return total;
+}
+
+MemoryAccounting* MemoryAccounting::instance() {
+  pthread_once(&accounting_once, &MemoryAccounting::CreateInstance);
+  return accounting_instance;
+}
+
+void MemoryAccounting::CreateInstance() {
+  // Never deleted, memory may be released by components destroyed late
+  accounting_instance = new MemoryAccounting();
+}
+
+const char* MemoryAccounting::CategoryName(Category category) {
+  DCHECK(category < kCategoriesCount);
+  return kCategoryNames[category];
+}
+
+MemoryAccounting::MemoryAccounting()
+  : app_quota_(0) {
+}
+
+void MemoryAccounting::set_app_quota(uint64_t bytes) {
+  sync_primitives::AutoLock auto_lock(accounts_lock_);
+  app_quota_ = bytes;
+}
+
+uint64_t MemoryAccounting::app_quota() const {
+  sync_primitives::AutoLock auto_lock(accounts_lock_);
+  return app_quota_;
+}
+
+bool MemoryAccounting::TryCharge(uint32_t key, Category category,
+                                 uint64_t bytes) {
+  DCHECK(category < kCategoriesCount);
+  sync_primitives::AutoLock auto_lock(accounts_lock_);
+  Usage& usage = accounts_[key];
+  if (!FitsQuota(usage, bytes)) {
+    if (0 == usage.Total()) {
+      accounts_.erase(key);
+    }
+    return false;
+  }
+  usage.bytes[category] += bytes;
+  total_.bytes[category] += bytes;
+  return true;
+}
+
+void MemoryAccounting::Charge(uint32_t key, Category category,
+                              uint64_t bytes) {
+  DCHECK(category < kCategoriesCount);
+  sync_primitives::AutoLock auto_lock(accounts_lock_);
+  accounts_[key].bytes[category] += bytes;
+  total_.bytes[category] += bytes;
+}
+
+void MemoryAccounting::Release(uint32_t key, Category category,
+                               uint64_t bytes) {
+  DCHECK(category < kCategoriesCount);
+  sync_primitives::AutoLock auto_lock(accounts_lock_);
+  Accounts::iterator it = accounts_.find(key);
+  if (accounts_.end() == it) {
+    return;
+  }
+  // Estimated sizes may drift from charged ones, account never goes negative
+  uint64_t& held = it->second.bytes[category];
+  const uint64_t released = held < bytes ? held : bytes;
+  held -= released;
+  total_.bytes[category] -= released;
+  if (0 == it->second.Total()) {
+    accounts_.erase(it);
+  }
+}
+
+bool MemoryAccounting::HasRoom(uint32_t key, uint64_t bytes) const {
+  sync_primitives::AutoLock auto_lock(accounts_lock_);
+  Accounts::const_iterator it = accounts_.find(key);
+  return FitsQuota(accounts_.end() == it ? Usage() : it->second, bytes);
+}
+
+MemoryAccounting::Usage MemoryAccounting::AppUsage(uint32_t key) const {
+  sync_primitives::AutoLock auto_lock(accounts_lock_);
+  Accounts::const_iterator it = accounts_.find(key);
+  return accounts_.end() == it ? Usage() : it->second;
+}
+
+MemoryAccounting::Usage MemoryAccounting::TotalUsage() const {
+  sync_primitives::AutoLock auto_lock(accounts_lock_);
+  return total_;
+}
+
+void MemoryAccounting::TakeSnapshot(Snapshot* snapshot) const {
+  DCHECK(snapshot);
+  sync_primitives::AutoLock auto_lock(accounts_lock_);
+  snapshot->assign(accounts_.begin(), accounts_.end());
+}
+
+bool MemoryAccounting::FitsQuota(const Usage& usage, uint64_t bytes) const {
+  return 0 == app_quota_ || usage.Total() + bytes <= app_quota_;
+}
+
+}  // namespace utils
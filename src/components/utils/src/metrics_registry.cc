@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/metrics_registry.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <algorithm>
+#include <sstream>
+
+#include "utils/atomic.h"
+#include "utils/logger.h"
+
+namespace utils {
+namespace metrics {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "Metrics")
+
+namespace {
+MetricsRegistry* registry_instance = NULL;
+pthread_once_t registry_once = PTHREAD_ONCE_INIT;
+
+pthread_key_t shard_key;
+pthread_once_t shard_key_once = PTHREAD_ONCE_INIT;
+volatile uint32_t next_shard = 0;
+
+void CreateShardKey() {
+  pthread_key_create(&shard_key, NULL);
+}
+
+void UpdateMax(volatile uint64_t* max, uint64_t value) {
+  uint64_t current = *max;
+  while (current < value) {
+    const uint64_t previous =
+        __sync_val_compare_and_swap(max, current, value);
+    if (previous == current) {
+      break;
+    }
+    current = previous;
+  }
+}
+
+const uint64_t kMaxValue = (static_cast<uint64_t>(1) << kMaxValueBits) - 1;
+const uint32_t kSubBucketsCount = 1 << kSubBucketBits;
+const uint32_t kSubBucketsHalf = kSubBucketsCount >> 1;
+}  // namespace
+
+uint32_t CurrentShard() {
+  pthread_once(&shard_key_once, &CreateShardKey);
+  // Shard is stored incremented, so zero means not assigned yet
+  uintptr_t shard = reinterpret_cast<uintptr_t>(
+      pthread_getspecific(shard_key));
+  if (0 == shard) {
+    shard = atomic_post_inc(&next_shard) % kShardsCount + 1;
+    pthread_setspecific(shard_key, reinterpret_cast<void*>(shard));
+  }
+  return static_cast<uint32_t>(shard - 1);
+}
+
+Counter::Counter(const std::string& name)
+  : name_(name) {
+  memset(shards_, 0, sizeof(shards_));
+}
+
+void Counter::Add(uint64_t value) {
+  __sync_fetch_and_add(&shards_[CurrentShard()].value, value);
+}
+
+uint64_t Counter::Value() const {
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < kShardsCount; ++i) {
+    value += shards_[i].value;
+  }
+  return value;
+}
+
+Gauge::Gauge(const std::string& name)
+  : name_(name),
+    value_(0) {
+}
+
+void Gauge::Set(int64_t value) {
+  value_ = value;
+}
+
+void Gauge::Add(int64_t value) {
+  __sync_fetch_and_add(&value_, value);
+}
+
+int64_t Gauge::Value() const {
+  return value_;
+}
+
+HistogramSnapshot::HistogramSnapshot()
+  : count(0),
+    sum(0),
+    max(0) {
+}
+
+uint64_t HistogramSnapshot::Percentile(double percent) const {
+  if (0 == count) {
+    return 0;
+  }
+  uint64_t rank = static_cast<uint64_t>(count * percent / 100.0 + 0.5);
+  if (0 == rank) {
+    rank = 1;
+  }
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return std::min(Histogram::BucketUpperBound(i), max);
+    }
+  }
+  return max;
+}
+
+Histogram::Histogram(const std::string& name)
+  : name_(name) {
+  memset(shards_, 0, sizeof(shards_));
+}
+
+uint32_t Histogram::BucketIndex(uint64_t value) {
+  if (value < kSubBucketsCount) {
+    return static_cast<uint32_t>(value);
+  }
+  if (value > kMaxValue) {
+    value = kMaxValue;
+  }
+  const uint32_t highest_bit = 63 - __builtin_clzll(value);
+  const uint32_t shift = highest_bit - kSubBucketBits + 1;
+  return shift * kSubBucketsHalf + static_cast<uint32_t>(value >> shift);
+}
+
+uint64_t Histogram::BucketUpperBound(uint32_t index) {
+  if (index < kSubBucketsCount) {
+    return index;
+  }
+  const uint32_t shift = (index >> (kSubBucketBits - 1)) - 1;
+  const uint64_t mantissa = index - shift * kSubBucketsHalf;
+  return ((mantissa + 1) << shift) - 1;
+}
+
+void Histogram::Record(uint64_t value) {
+  Shard& shard = shards_[CurrentShard()];
+  __sync_fetch_and_add(&shard.buckets[BucketIndex(value)], 1);
+  __sync_fetch_and_add(&shard.count, 1);
+  __sync_fetch_and_add(&shard.sum, value);
+  UpdateMax(&shard.max, value);
+}
+
+void Histogram::Snapshot(HistogramSnapshot* snapshot) const {
+  DCHECK(snapshot);
+  snapshot->name = name_;
+  snapshot->count = 0;
+  snapshot->sum = 0;
+  snapshot->max = 0;
+  snapshot->buckets.assign(kBucketsCount, 0);
+  for (uint32_t i = 0; i < kShardsCount; ++i) {
+    const Shard& shard = shards_[i];
+    snapshot->sum += shard.sum;
+    const uint64_t max = shard.max;
+    snapshot->max = std::max(snapshot->max, max);
+    for (uint32_t bucket = 0; bucket < kBucketsCount; ++bucket) {
+      snapshot->buckets[bucket] += shard.buckets[bucket];
+    }
+  }
+  // Count is summed from buckets to stay consistent with percentiles
+  // while shards are being updated
+  for (uint32_t bucket = 0; bucket < kBucketsCount; ++bucket) {
+    snapshot->count += snapshot->buckets[bucket];
+  }
+}
+
+std::string ToString(const Snapshot& snapshot) {
+  std::stringstream stream;
+  for (size_t i = 0; i < snapshot.counters.size(); ++i) {
+    stream << snapshot.counters[i].first << "="
+           << snapshot.counters[i].second << "\n";
+  }
+  for (size_t i = 0; i < snapshot.gauges.size(); ++i) {
+    stream << snapshot.gauges[i].first << "="
+           << snapshot.gauges[i].second << "\n";
+  }
+  for (size_t i = 0; i < snapshot.histograms.size(); ++i) {
+    const HistogramSnapshot& histogram = snapshot.histograms[i];
+    stream << histogram.name
+           << " count=" << histogram.count
+           << " p50=" << histogram.Percentile(50)
+           << " p99=" << histogram.Percentile(99)
+           << " p999=" << histogram.Percentile(99.9)
+           << " max=" << histogram.max << "\n";
+  }
+  return stream.str();
+}
+
+MetricsRegistry::MetricsRegistry()
+  : dump_timer_("MetricsDump", this, &MetricsRegistry::LogSnapshot, true) {
+}
+
+MetricsRegistry* MetricsRegistry::instance() {
+  pthread_once(&registry_once, &MetricsRegistry::CreateInstance);
+  return registry_instance;
+}
+
+void MetricsRegistry::CreateInstance() {
+  // Intentionally never deleted, see class description
+  registry_instance = new MetricsRegistry();
+}
+
+Counter* MetricsRegistry::GetCounter(const std::string& name) {
+  sync_primitives::AutoLock auto_lock(metrics_lock_);
+  Counters::iterator it = counters_.find(name);
+  if (counters_.end() == it) {
+    it = counters_.insert(std::make_pair(name, new Counter(name))).first;
+  }
+  return it->second;
+}
+
+Gauge* MetricsRegistry::GetGauge(const std::string& name) {
+  sync_primitives::AutoLock auto_lock(metrics_lock_);
+  Gauges::iterator it = gauges_.find(name);
+  if (gauges_.end() == it) {
+    it = gauges_.insert(std::make_pair(name, new Gauge(name))).first;
+  }
+  return it->second;
+}
+
+Histogram* MetricsRegistry::GetHistogram(const std::string& name) {
+  sync_primitives::AutoLock auto_lock(metrics_lock_);
+  Histograms::iterator it = histograms_.find(name);
+  if (histograms_.end() == it) {
+    it = histograms_.insert(
+        std::make_pair(name, new Histogram(name))).first;
+  }
+  return it->second;
+}
+
+void MetricsRegistry::TakeSnapshot(Snapshot* snapshot) const {
+  DCHECK(snapshot);
+  snapshot->counters.clear();
+  snapshot->gauges.clear();
+  std::vector<const Histogram*> histograms;
+  {
+    sync_primitives::AutoLock auto_lock(metrics_lock_);
+    for (Counters::const_iterator it = counters_.begin();
+         counters_.end() != it; ++it) {
+      snapshot->counters.push_back(
+          std::make_pair(it->first, it->second->Value()));
+    }
+    for (Gauges::const_iterator it = gauges_.begin();
+         gauges_.end() != it; ++it) {
+      snapshot->gauges.push_back(
+          std::make_pair(it->first, it->second->Value()));
+    }
+    for (Histograms::const_iterator it = histograms_.begin();
+         histograms_.end() != it; ++it) {
+      histograms.push_back(it->second);
+    }
+  }
+  // Histograms are never deleted, so they are merged out of the lock
+  snapshot->histograms.resize(histograms.size());
+  for (size_t i = 0; i < histograms.size(); ++i) {
+    histograms[i]->Snapshot(&snapshot->histograms[i]);
+  }
+}
+
+void MetricsRegistry::StartPeriodicDump(uint32_t period_seconds) {
+  dump_timer_.stop();
+  if (0 != period_seconds) {
+    dump_timer_.start(period_seconds);
+  }
+}
+
+void MetricsRegistry::StopPeriodicDump() {
+  dump_timer_.stop();
+}
+
+void MetricsRegistry::LogSnapshot() {
+  Snapshot snapshot;
+  TakeSnapshot(&snapshot);
+  LOG4CXX_INFO(logger_, "Metrics:\n" << ToString(snapshot));
+}
+
+}  // namespace metrics
+}  // namespace utils
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/number_conversion.h"
+
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits>
+#include <string>
+
+namespace utils {
+
+namespace {
+// Doubles up to 1e22 are exact, so one multiplication or division by them
+// rounds correctly, see W. Clinger "How to read floating point numbers
+// accurately"
+const double kExactPowersOfTen[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+const int kMaxExactPowerOfTen = 22;
+// Every integer up to 2^53 is exact double
+const uint64_t kMaxExactMantissa = static_cast<uint64_t>(1) << 53;
+const double kMinInexactInteger = 9007199254740992.0;
+
+const uint64_t kPowersOfTen[] = {
+  1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+  10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+  100000000000ull, 1000000000000ull, 10000000000000ull,
+  100000000000000ull, 1000000000000000ull
+};
+
+const char kDigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536"
+    "37383940414243444546474849505152535455565758596061626364656667686970717273"
+    "747576777879808182838485868788899091929394959697989900";
+
+inline bool IsDigit(char c) {
+  return '0' <= c && c <= '9';
+}
+
+size_t CopyLiteral(const char* literal, char* buffer) {
+  const size_t size = strlen(literal);
+  memcpy(buffer, literal, size);
+  return size;
+}
+
+/*
+ * Parses number by strtod, replacing '.' by decimal point of current locale
+ */
+bool ParseDoubleByLocale(const char* begin, const char* end, double* value) {
+  std::string number(begin, end);
+  const char* const decimal_point = localeconv()->decimal_point;
+  const std::string::size_type point = number.find('.');
+  if (std::string::npos != point && decimal_point &&
+      0 != strcmp(".", decimal_point)) {
+    number.replace(point, 1, decimal_point);
+  }
+  char* number_end = NULL;
+  errno = 0;
+  const double result = strtod(number.c_str(), &number_end);
+  if (ERANGE == errno || number_end != number.c_str() + number.size()) {
+    return false;
+  }
+  *value = result;
+  return true;
+}
+}  // namespace
+
+size_t FormatUInt64(uint64_t value, char* buffer) {
+  char digits[kInt64StringSize];
+  char* current = digits + sizeof(digits);
+  while (value >= 100) {
+    const size_t pair = static_cast<size_t>(value % 100) * 2;
+    value /= 100;
+    *--current = kDigitPairs[pair + 1];
+    *--current = kDigitPairs[pair];
+  }
+  if (value >= 10) {
+    const size_t pair = static_cast<size_t>(value) * 2;
+    *--current = kDigitPairs[pair + 1];
+    *--current = kDigitPairs[pair];
+  } else {
+    *--current = static_cast<char>('0' + value);
+  }
+  const size_t size = digits + sizeof(digits) - current;
+  memcpy(buffer, current, size);
+  return size;
+}
+
+size_t FormatInt64(int64_t value, char* buffer) {
+  if (value >= 0) {
+    return FormatUInt64(static_cast<uint64_t>(value), buffer);
+  }
+  buffer[0] = '-';
+  // Negation in unsigned type is defined for minimal value too
+  return 1 + FormatUInt64(0 - static_cast<uint64_t>(value), buffer + 1);
+}
+
+size_t FormatFixed(double value, int precision, char* buffer) {
+  if (isnan(value)) {
+    return CopyLiteral("nan", buffer);
+  }
+  if (isinf(value)) {
+    return CopyLiteral(value < 0 ? "-inf" : "inf", buffer);
+  }
+  if (precision < 0) {
+    precision = 0;
+  } else if (precision > kMaxFixedPrecision) {
+    precision = kMaxFixedPrecision;
+  }
+
+  size_t size = 0;
+  if (signbit(value)) {
+    buffer[size++] = '-';
+  }
+  const double magnitude = fabs(value);
+  if (magnitude >= kMinInexactInteger) {
+    // Value is an integer, its digits are written without decimal point
+    const int written = snprintf(buffer + size, kDoubleStringSize - size,
+                                 "%.0f", magnitude);
+    return written > 0 ? size + written : 0;
+  }
+
+  uint64_t integer = static_cast<uint64_t>(magnitude);
+  // Subtraction is exact, fraction keeps all bits of value
+  const double fraction = magnitude - static_cast<double>(integer);
+  const uint64_t scale = kPowersOfTen[precision];
+  const double scaled = fraction * static_cast<double>(scale);
+  uint64_t fraction_digits = static_cast<uint64_t>(scaled);
+  // Ties are rounded to even as printf does
+  const double remainder = scaled - static_cast<double>(fraction_digits);
+  if (remainder > 0.5 || (0.5 == remainder && (fraction_digits & 1))) {
+    ++fraction_digits;
+  }
+  if (fraction_digits == scale) {
+    ++integer;
+    fraction_digits = 0;
+  }
+
+  size += FormatUInt64(integer, buffer + size);
+  if (0 == fraction_digits) {
+    return size;
+  }
+  int digits_count = precision;
+  while (0 == fraction_digits % 10) {
+    fraction_digits /= 10;
+    --digits_count;
+  }
+  buffer[size++] = '.';
+  for (int i = digits_count - 1; i >= 0; --i) {
+    buffer[size + i] = static_cast<char>('0' + fraction_digits % 10);
+    fraction_digits /= 10;
+  }
+  return size + digits_count;
+}
+
+const char* ParseInt64(const char* begin, const char* end, int64_t* value) {
+  const char* current = begin;
+  const bool is_negative = current != end && '-' == *current;
+  if (is_negative) {
+    ++current;
+  }
+  const uint64_t limit = is_negative ?
+      static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1 :
+      static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+  const char* const digits_begin = current;
+  uint64_t result = 0;
+  for (; current != end && IsDigit(*current); ++current) {
+    const uint64_t digit = *current - '0';
+    if (result > (limit - digit) / 10) {
+      return begin;
+    }
+    result = result * 10 + digit;
+  }
+  if (current == digits_begin) {
+    return begin;
+  }
+  *value = is_negative ? static_cast<int64_t>(0 - result) :
+                         static_cast<int64_t>(result);
+  return current;
+}
+
+const char* ParseDouble(const char* begin, const char* end, double* value) {
+  const char* current = begin;
+  bool is_negative = false;
+  if (current != end && ('-' == *current || '+' == *current)) {
+    is_negative = '-' == *current;
+    ++current;
+  }
+
+  // Digits that do not fit mantissa are accounted in exponent,
+  // value is exact while all of them are zeros
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  bool is_exact = true;
+  size_t digits_count = 0;
+  for (; current != end && IsDigit(*current); ++current, ++digits_count) {
+    const uint64_t digit = *current - '0';
+    if (mantissa < kMaxExactMantissa) {
+      mantissa = mantissa * 10 + digit;
+    } else {
+      ++exponent;
+      is_exact &= 0 == digit;
+    }
+  }
+  if (current != end && '.' == *current) {
+    ++current;
+    for (; current != end && IsDigit(*current); ++current, ++digits_count) {
+      const uint64_t digit = *current - '0';
+      if (mantissa < kMaxExactMantissa) {
+        mantissa = mantissa * 10 + digit;
+        --exponent;
+      } else {
+        is_exact &= 0 == digit;
+      }
+    }
+  }
+  if (0 == digits_count) {
+    return begin;
+  }
+
+  // Exponent belongs to number only if it has digits
+  if (current != end && ('e' == *current || 'E' == *current)) {
+    const char* exponent_current = current + 1;
+    bool is_exponent_negative = false;
+    if (exponent_current != end &&
+        ('-' == *exponent_current || '+' == *exponent_current)) {
+      is_exponent_negative = '-' == *exponent_current;
+      ++exponent_current;
+    }
+    if (exponent_current != end && IsDigit(*exponent_current)) {
+      int exponent_value = 0;
+      for (; exponent_current != end && IsDigit(*exponent_current);
+           ++exponent_current) {
+        // Bigger exponents are out of range anyway
+        if (exponent_value < 100000) {
+          exponent_value = exponent_value * 10 + (*exponent_current - '0');
+        }
+      }
+      exponent += is_exponent_negative ? -exponent_value : exponent_value;
+      current = exponent_current;
+    }
+  }
+
+  if (0 == mantissa) {
+    *value = is_negative ? -0.0 : 0.0;
+    return current;
+  }
+  if (is_exact && mantissa <= kMaxExactMantissa &&
+      -kMaxExactPowerOfTen <= exponent && exponent <= kMaxExactPowerOfTen) {
+    double result = static_cast<double>(mantissa);
+    if (exponent < 0) {
+      result /= kExactPowersOfTen[-exponent];
+    } else {
+      result *= kExactPowersOfTen[exponent];
+    }
+    *value = is_negative ? -result : result;
+    return current;
+  }
+  // Rare long or huge numbers need big number arithmetic of strtod
+  double result = 0;
+  if (!ParseDoubleByLocale(begin, current, &result)) {
+    return begin;
+  }
+  *value = result;
+  return current;
+}
+
+}  // namespace utils
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/resource_sampler.h"
+
+#include <pthread.h>
+#include <map>
+#include <string>
+
+#include "utils/metrics_registry.h"
+
+namespace utils {
+
+namespace {
+ResourceSampler* sampler_instance = NULL;
+pthread_once_t sampler_once = PTHREAD_ONCE_INIT;
+}  // namespace
+
+ResourceSample::ResourceSample()
+  : open_files(-1) {
+  time.tv_sec = 0;
+  time.tv_usec = 0;
+  process.utime = 0;
+  process.stime = 0;
+  process.memory = 0;
+  allocator.arena = 0;
+  allocator.mmapped = 0;
+  allocator.in_use = 0;
+  allocator.free = 0;
+}
+
+ResourceSampler::ResourceSampler()
+  : observer_(NULL),
+    timer_("ResourceSampler", this, &ResourceSampler::OnTimer, true) {
+}
+
+ResourceSampler* ResourceSampler::instance() {
+  pthread_once(&sampler_once, &ResourceSampler::CreateInstance);
+  return sampler_instance;
+}
+
+void ResourceSampler::CreateInstance() {
+  // Never deleted like metrics registry it publishes to
+  sampler_instance = new ResourceSampler();
+}
+
+void ResourceSampler::TakeSample(ResourceSample* sample) {
+  DCHECK(sample);
+  sample->time = date_time::DateTime::getPreciseMonotonicTime();
+  ResourseUsage* usage = Resources::getCurrentResourseUsage();
+  if (usage) {
+    sample->process = *usage;
+    delete usage;
+  }
+  Resources::GetThreadsUsage(&sample->threads);
+  Resources::GetAllocatorUsage(&sample->allocator);
+  threads::MessageLoopRegistry::instance()->Snapshot(&sample->queues);
+  MemoryAccounting::instance()->TakeSnapshot(&sample->apps_memory);
+  sample->open_files = Resources::GetOpenFilesCount();
+}
+
+void ResourceSampler::Start(uint32_t period_seconds) {
+  timer_.stop();
+  if (0 != period_seconds) {
+    timer_.start(period_seconds);
+  }
+}
+
+void ResourceSampler::Stop() {
+  timer_.stop();
+}
+
+void ResourceSampler::set_observer(ResourceSampleObserver* observer) {
+  sync_primitives::AutoLock auto_lock(observer_lock_);
+  observer_ = observer;
+}
+
+void ResourceSampler::OnTimer() {
+  ResourceSample sample;
+  TakeSample(&sample);
+  PublishMetrics(sample);
+  sync_primitives::AutoLock auto_lock(observer_lock_);
+  if (observer_) {
+    observer_->OnResourceSample(sample);
+  }
+}
+
+void ResourceSampler::PublishMetrics(const ResourceSample& sample) {
+  metrics::MetricsRegistry* registry = metrics::MetricsRegistry::instance();
+  registry->GetGauge("process.utime")->Set(sample.process.utime);
+  registry->GetGauge("process.stime")->Set(sample.process.stime);
+  registry->GetGauge("process.memory")->Set(sample.process.memory);
+  registry->GetGauge("process.open_files")->Set(sample.open_files);
+  registry->GetGauge("allocator.in_use_bytes")->Set(sample.allocator.in_use);
+  registry->GetGauge("allocator.free_bytes")->Set(sample.allocator.free);
+  registry->GetGauge("allocator.mmapped_bytes")->Set(
+      sample.allocator.mmapped);
+
+  // Pools and loops run several threads of one name
+  std::map<std::string, uint64_t> cpu_by_name;
+  for (std::vector<Resources::ThreadUsage>::const_iterator it =
+       sample.threads.begin(); sample.threads.end() != it; ++it) {
+    cpu_by_name[it->name] += it->utime + it->stime;
+  }
+  for (std::map<std::string, uint64_t>::const_iterator it =
+       cpu_by_name.begin(); cpu_by_name.end() != it; ++it) {
+    registry->GetGauge("thread." + it->first + ".cpu_time_ms")->Set(
+        it->second);
+  }
+  std::map<std::string, uint64_t> depth_by_name;
+  for (threads::MessageLoopRegistry::Depths::const_iterator it =
+       sample.queues.begin(); sample.queues.end() != it; ++it) {
+    depth_by_name[it->first] += it->second;
+  }
+  for (std::map<std::string, uint64_t>::const_iterator it =
+       depth_by_name.begin(); depth_by_name.end() != it; ++it) {
+    registry->GetGauge("queue." + it->first + ".depth")->Set(it->second);
+  }
+  // Per application usage goes to time tester only, gauges live till exit
+  // and a gauge per connection key would grow with every connection
+  MemoryAccounting::Usage apps_total;
+  for (MemoryAccounting::Snapshot::const_iterator it =
+       sample.apps_memory.begin(); sample.apps_memory.end() != it; ++it) {
+    for (uint32_t i = 0; i < MemoryAccounting::kCategoriesCount; ++i) {
+      apps_total.bytes[i] += it->second.bytes[i];
+    }
+  }
+  for (uint32_t i = 0; i < MemoryAccounting::kCategoriesCount; ++i) {
+    registry->GetGauge(std::string("apps_memory.") +
+                       MemoryAccounting::CategoryName(
+                           static_cast<MemoryAccounting::Category>(i)) +
+                       "_bytes")->Set(apps_total.bytes[i]);
+  }
+  registry->GetGauge("apps_memory.apps")->Set(sample.apps_memory.size());
+}
+
+}  // namespace utils
@@ -15,6 +15,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <stdlib.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 #include <sstream>
 #include "utils/file_system.h"
 
@@ -173,6 +177,84 @@ bool Resources::GetMemInfo(Resources::MemInfo &output) {
   return result;
 }
 
+bool Resources::GetThreadsUsage(std::vector<ThreadUsage>* threads) {
+  DCHECK(threads);
+  threads->clear();
+#if defined(OS_LINUX)
+  const std::string task_path = GetProcPath() + "task/";
+  const std::vector<std::string> tasks = file_system::ListFiles(task_path);
+  if (tasks.empty()) {
+    LOG4CXX_ERROR(logger_, "Unable to list " << task_path);
+    return false;
+  }
+  const long ticks_per_second = sysconf(_SC_CLK_TCK);
+  threads->reserve(tasks.size());
+  for (std::vector<std::string>::const_iterator it = tasks.begin();
+       tasks.end() != it; ++it) {
+    std::string stat;
+    // Thread could exit after directory was listed
+    if (!file_system::ReadFile(task_path + *it + "/stat", stat)) {
+      continue;
+    }
+    // Name is in parentheses and may contain spaces and parentheses
+    const std::string::size_type name_begin = stat.find('(');
+    const std::string::size_type name_end = stat.rfind(')');
+    if (std::string::npos == name_begin || std::string::npos == name_end ||
+        name_end < name_begin) {
+      continue;
+    }
+    unsigned long utime = 0;
+    unsigned long stime = 0;
+    if (2 != sscanf(stat.c_str() + name_end + 1,
+                    " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu",
+                    &utime, &stime)) {
+      continue;
+    }
+    ThreadUsage usage;
+    usage.tid = atoi(it->c_str());
+    usage.name = stat.substr(name_begin + 1, name_end - name_begin - 1);
+    usage.utime = static_cast<uint64_t>(utime) * 1000 / ticks_per_second;
+    usage.stime = static_cast<uint64_t>(stime) * 1000 / ticks_per_second;
+    threads->push_back(usage);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool Resources::GetAllocatorUsage(AllocatorUsage* usage) {
+  DCHECK(usage);
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+  const struct mallinfo2 info = mallinfo2();
+#else
+  const struct mallinfo info = mallinfo();
+#endif
+  usage->arena = info.arena;
+  usage->mmapped = info.hblkhd;
+  usage->in_use = info.uordblks;
+  usage->free = info.fordblks;
+  return true;
+#else
+  return false;
+#endif
+}
+
+int32_t Resources::GetOpenFilesCount() {
+#if defined(OS_LINUX)
+  const std::string fd_path = GetProcPath() + "fd/";
+  const std::vector<std::string> files = file_system::ListFiles(fd_path);
+  if (files.empty()) {
+    return -1;
+  }
+  // Directory being listed is open too
+  return static_cast<int32_t>(files.size()) - 1;
+#else
+  return -1;
+#endif
+}
+
 std::string Resources::GetStatPath() {
   std::string filename;
 #if defined(OS_LINUX)
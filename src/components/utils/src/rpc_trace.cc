@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/rpc_trace.h"
+
+#include <cstring>
+
+namespace utils {
+
+namespace rpc_trace {
+const char kRpc[] = "rpc";
+const char kTransportManager[] = "transport_manager";
+const char kProtocolHandler[] = "protocol_handler";
+const char kApplicationManager[] = "application_manager";
+const char kFormatter[] = "formatter";
+const char kCommand[] = "command";
+const char kHmi[] = "hmi";
+const char kHmiResponse[] = "hmi_response";
+const char kMobileResponse[] = "mobile_response";
+}  // namespace rpc_trace
+
+namespace {
+const size_t kMaxPendingTraces = 512;
+const int64_t kPendingTimeoutSeconds = 60;
+
+bool IsSet(const TimevalStruct& time) {
+  return 0 != time.tv_sec || 0 != time.tv_usec;
+}
+}  // namespace
+
+RpcTraceSpan::RpcTraceSpan()
+  : name(NULL),
+    parent(-1) {
+  queued.tv_sec = queued.tv_usec = 0;
+  begin = end = queued;
+}
+
+RpcTraceSpan::RpcTraceSpan(const char* span_name, int32_t parent_span)
+  : name(span_name),
+    parent(parent_span) {
+  queued.tv_sec = queued.tv_usec = 0;
+  begin = end = queued;
+}
+
+RpcTrace::RpcTrace(const TimevalStruct& received)
+  : connection_key_(0),
+    correlation_id_(0),
+    function_id_(0) {
+  RpcTraceSpan root(rpc_trace::kRpc, -1);
+  root.queued = root.begin = received;
+  spans_.push_back(root);
+}
+
+void RpcTrace::set_rpc(uint32_t connection_key, int32_t correlation_id,
+                       int32_t function_id) {
+  sync_primitives::AutoLock lock(spans_lock_);
+  connection_key_ = connection_key;
+  correlation_id_ = correlation_id;
+  function_id_ = function_id;
+}
+
+uint32_t RpcTrace::connection_key() const {
+  sync_primitives::AutoLock lock(spans_lock_);
+  return connection_key_;
+}
+
+int32_t RpcTrace::correlation_id() const {
+  sync_primitives::AutoLock lock(spans_lock_);
+  return correlation_id_;
+}
+
+int32_t RpcTrace::function_id() const {
+  sync_primitives::AutoLock lock(spans_lock_);
+  return function_id_;
+}
+
+void RpcTrace::AddSpan(const char* name, const TimevalStruct& queued,
+                       const TimevalStruct& begin, const TimevalStruct& end) {
+  RpcTraceSpan span(name, 0);
+  span.queued = queued;
+  span.begin = begin;
+  span.end = end;
+  sync_primitives::AutoLock lock(spans_lock_);
+  spans_.push_back(span);
+}
+
+void RpcTrace::Enqueue(const char* name, const char* parent) {
+  const TimevalStruct now = date_time::DateTime::getPreciseMonotonicTime();
+  sync_primitives::AutoLock lock(spans_lock_);
+  RpcTraceSpan span(name, ParentOf(parent));
+  span.queued = now;
+  spans_.push_back(span);
+}
+
+void RpcTrace::Begin(const char* name, const char* parent) {
+  const TimevalStruct now = date_time::DateTime::getPreciseMonotonicTime();
+  sync_primitives::AutoLock lock(spans_lock_);
+  const int32_t index = Find(name, false, false);
+  if (index < 0) {
+    RpcTraceSpan span(name, ParentOf(parent));
+    span.queued = span.begin = now;
+    spans_.push_back(span);
+    return;
+  }
+  spans_[index].begin = now;
+}
+
+void RpcTrace::End(const char* name) {
+  const TimevalStruct now = date_time::DateTime::getPreciseMonotonicTime();
+  sync_primitives::AutoLock lock(spans_lock_);
+  const int32_t index = Find(name, true, false);
+  if (index >= 0) {
+    spans_[index].end = now;
+  }
+}
+
+void RpcTrace::Finish() {
+  const TimevalStruct now = date_time::DateTime::getPreciseMonotonicTime();
+  sync_primitives::AutoLock lock(spans_lock_);
+  spans_.front().end = now;
+}
+
+std::vector<RpcTraceSpan> RpcTrace::spans() const {
+  sync_primitives::AutoLock lock(spans_lock_);
+  return spans_;
+}
+
+int32_t RpcTrace::Find(const char* name, bool begun, bool ended) const {
+  for (int32_t i = static_cast<int32_t>(spans_.size()) - 1; i >= 0; --i) {
+    const RpcTraceSpan& span = spans_[i];
+    if (begun == IsSet(span.begin) && ended == IsSet(span.end) &&
+        0 == strcmp(name, span.name)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int32_t RpcTrace::ParentOf(const char* parent) const {
+  if (NULL == parent) {
+    return 0;
+  }
+  for (int32_t i = static_cast<int32_t>(spans_.size()) - 1; i > 0; --i) {
+    if (0 == strcmp(parent, spans_[i].name)) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+RpcTracer::RpcTracer()
+  : observer_(NULL) {
+}
+
+void RpcTracer::set_observer(RpcTraceObserver* observer) {
+  sync_primitives::AutoLock lock(traces_lock_);
+  observer_ = observer;
+  if (NULL == observer) {
+    traces_.clear();
+    hmi_traces_.clear();
+  }
+}
+
+void RpcTracer::Bind(uint32_t connection_key, int32_t correlation_id,
+                     const RpcTracePtr& trace) {
+  if (!trace) {
+    return;
+  }
+  const int64_t now = date_time::DateTime::getSecs(
+      date_time::DateTime::getMonotonicTime());
+  sync_primitives::AutoLock lock(traces_lock_);
+  if (!observer_) {
+    return;
+  }
+  if (traces_.size() >= kMaxPendingTraces) {
+    RemoveStale(&traces_, now);
+    if (traces_.size() >= kMaxPendingTraces) {
+      return;
+    }
+  }
+  traces_[RpcKey(connection_key, correlation_id)] = PendingTrace(trace, now);
+}
+
+RpcTracePtr RpcTracer::Find(uint32_t connection_key,
+                            int32_t correlation_id) const {
+  if (!enabled()) {
+    return RpcTracePtr();
+  }
+  sync_primitives::AutoLock lock(traces_lock_);
+  const Traces::const_iterator it =
+      traces_.find(RpcKey(connection_key, correlation_id));
+  return traces_.end() == it ? RpcTracePtr() : it->second.trace;
+}
+
+void RpcTracer::Complete(uint32_t connection_key, int32_t correlation_id) {
+  RpcTracePtr trace;
+  RpcTraceObserver* observer = NULL;
+  {
+    sync_primitives::AutoLock lock(traces_lock_);
+    const Traces::iterator it =
+        traces_.find(RpcKey(connection_key, correlation_id));
+    if (traces_.end() == it) {
+      return;
+    }
+    trace = it->second.trace;
+    traces_.erase(it);
+    observer = observer_;
+  }
+  trace->Finish();
+  if (observer) {
+    observer->OnRpcTraced(trace);
+  }
+}
+
+void RpcTracer::BindHmi(int32_t hmi_correlation_id, uint32_t connection_key,
+                        int32_t correlation_id) {
+  if (!enabled()) {
+    return;
+  }
+  const int64_t now = date_time::DateTime::getSecs(
+      date_time::DateTime::getMonotonicTime());
+  RpcTracePtr trace;
+  {
+    sync_primitives::AutoLock lock(traces_lock_);
+    const Traces::const_iterator it =
+        traces_.find(RpcKey(connection_key, correlation_id));
+    if (traces_.end() == it) {
+      return;
+    }
+    if (hmi_traces_.size() >= kMaxPendingTraces) {
+      RemoveStale(&hmi_traces_, now);
+      if (hmi_traces_.size() >= kMaxPendingTraces) {
+        return;
+      }
+    }
+    trace = it->second.trace;
+    hmi_traces_[hmi_correlation_id] = PendingTrace(trace, now);
+  }
+  trace->Enqueue(rpc_trace::kHmi, rpc_trace::kCommand);
+}
+
+RpcTracePtr RpcTracer::FindHmi(int32_t hmi_correlation_id) const {
+  if (!enabled()) {
+    return RpcTracePtr();
+  }
+  sync_primitives::AutoLock lock(traces_lock_);
+  const HmiTraces::const_iterator it = hmi_traces_.find(hmi_correlation_id);
+  return hmi_traces_.end() == it ? RpcTracePtr() : it->second.trace;
+}
+
+void RpcTracer::UnbindHmi(int32_t hmi_correlation_id) {
+  sync_primitives::AutoLock lock(traces_lock_);
+  hmi_traces_.erase(hmi_correlation_id);
+}
+
+size_t RpcTracer::pending_count() const {
+  sync_primitives::AutoLock lock(traces_lock_);
+  return traces_.size();
+}
+
+template <typename Map>
+void RpcTracer::RemoveStale(Map* pending, int64_t now) {
+  for (typename Map::iterator it = pending->begin(); it != pending->end();) {
+    if (now - it->second.bound >= kPendingTimeoutSeconds) {
+      pending->erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace utils
@@ -32,15 +32,27 @@
 
 #include "utils/rwlock.h"
 #include "utils/logger.h"
+#include "utils/lock_profiler.h"
 
 namespace sync_primitives {
 
 CREATE_LOGGERPTR_GLOBAL(logger_, "Utils")
 
-RWLock::RWLock() {
-  if (pthread_rwlock_init(&rwlock_, 0) != 0) {
+RWLock::RWLock()
+#ifdef LOCK_PROFILING
+  : statistics_(NULL),
+    write_acquired_at_(0)
+#endif // LOCK_PROFILING
+{
+  pthread_rwlockattr_t attr;
+  pthread_rwlockattr_init(&attr);
+#if defined(OS_LINUX) && defined(__GLIBC__)
+  pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_READER_NP);
+#endif
+  if (pthread_rwlock_init(&rwlock_, &attr) != 0) {
     LOG4CXX_ERROR(logger_, "Failed to initialize rwlock");
   }
+  pthread_rwlockattr_destroy(&attr);
 }
 
 RWLock::~RWLock() {
@@ -50,6 +62,22 @@ RWLock::~RWLock() {
 }
 
 bool RWLock::AcquireForReading() {
+#ifdef LOCK_PROFILING
+  if (statistics_) {
+    if (0 == pthread_rwlock_tryrdlock(&rwlock_)) {
+      statistics_->OnAcquired(false, 0);
+      return true;
+    }
+    const uint64_t wait_start = LockProfiler::CurrentTimeUsec();
+    if (pthread_rwlock_rdlock(&rwlock_) != 0) {
+      LOG4CXX_ERROR(logger_, "Failed to acquire rwlock for reading");
+      return false;
+    }
+    statistics_->OnAcquired(true,
+                            LockProfiler::CurrentTimeUsec() - wait_start);
+    return true;
+  }
+#endif // LOCK_PROFILING
   if (pthread_rwlock_rdlock(&rwlock_) != 0) {
     LOG4CXX_ERROR(logger_, "Failed to acquire rwlock for reading");
     return false;
@@ -62,10 +90,33 @@ bool RWLock::TryAcquireForReading() {
     LOG4CXX_ERROR(logger_, "Failed to acquire rwlock for reading");
     return false;
   }
+#ifdef LOCK_PROFILING
+  if (statistics_) {
+    statistics_->OnAcquired(false, 0);
+  }
+#endif // LOCK_PROFILING
   return true;
 }
 
 bool RWLock::AcquireForWriting() {
+#ifdef LOCK_PROFILING
+  if (statistics_) {
+    bool contended = false;
+    uint64_t wait_time = 0;
+    if (0 != pthread_rwlock_trywrlock(&rwlock_)) {
+      contended = true;
+      const uint64_t wait_start = LockProfiler::CurrentTimeUsec();
+      if (pthread_rwlock_wrlock(&rwlock_) != 0) {
+        LOG4CXX_ERROR(logger_, "Failed to acquire rwlock for writing");
+        return false;
+      }
+      wait_time = LockProfiler::CurrentTimeUsec() - wait_start;
+    }
+    statistics_->OnAcquired(contended, wait_time);
+    write_acquired_at_ = LockProfiler::CurrentTimeUsec();
+    return true;
+  }
+#endif // LOCK_PROFILING
   if (pthread_rwlock_wrlock(&rwlock_) != 0) {
     LOG4CXX_ERROR(logger_, "Failed to acquire rwlock for writing");
     return false;
@@ -78,10 +129,24 @@ bool RWLock::TryAcquireForWriting() {
     LOG4CXX_ERROR(logger_, "Failed to acquire rwlock for writing");
     return false;
   }
+#ifdef LOCK_PROFILING
+  if (statistics_) {
+    statistics_->OnAcquired(false, 0);
+    write_acquired_at_ = LockProfiler::CurrentTimeUsec();
+  }
+#endif // LOCK_PROFILING
   return true;
 }
 
 bool RWLock::Release() {
+#ifdef LOCK_PROFILING
+  // Only writer sets acquisition time, readers can not hold lock meanwhile
+  if (statistics_ && write_acquired_at_) {
+    statistics_->OnReleased(LockProfiler::CurrentTimeUsec() -
+                            write_acquired_at_);
+    write_acquired_at_ = 0;
+  }
+#endif // LOCK_PROFILING
   if (pthread_rwlock_unlock(&rwlock_) != 0) {
     LOG4CXX_ERROR(logger_, "Failed to release rwlock");
     return false;
@@ -89,4 +154,14 @@ bool RWLock::Release() {
   return true;
 }
 
+#ifdef LOCK_PROFILING
+void RWLock::set_name(const char* name) {
+  DCHECK(name);
+  statistics_ = LockProfiler::instance()->Register(name);
+}
+#else
+void RWLock::set_name(const char* name) {
+}
+#endif // LOCK_PROFILING
+
 }  // namespace sync_primitives
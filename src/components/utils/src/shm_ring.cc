@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/shm_ring.h"
+
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <algorithm>
+
+namespace utils {
+
+namespace {
+const uint32_t kRecordHeaderSize = sizeof(uint32_t);
+// Set in record length when message continues in next record
+const uint32_t kMoreRecords = 0x80000000u;
+const uint32_t kCacheLineSize = 64;
+
+uint32_t Align(uint32_t size) {
+  return (size + kRecordHeaderSize - 1) & ~(kRecordHeaderSize - 1);
+}
+}  // namespace
+
+/*
+ * Producer and consumer fields are kept in separate cache lines
+ */
+struct ShmRing::Header {
+  volatile uint32_t head;
+  volatile uint32_t data_sequence;
+  volatile uint32_t reader_waiting;
+  char producer_padding[kCacheLineSize - 3 * sizeof(uint32_t)];
+  volatile uint32_t tail;
+  volatile uint32_t space_sequence;
+  volatile uint32_t writer_waiting;
+  char consumer_padding[kCacheLineSize - 3 * sizeof(uint32_t)];
+};
+
+ShmRing::ShmRing()
+    : header_(NULL),
+      data_(NULL),
+      capacity_(0),
+      stopped_(0) {
+}
+
+size_t ShmRing::RequiredSize(uint32_t capacity) {
+  return sizeof(Header) + capacity;
+}
+
+void ShmRing::Attach(void* memory, uint32_t capacity, bool init) {
+  DCHECK(memory);
+  DCHECK(capacity && 0 == (capacity & (capacity - 1)));
+  header_ = static_cast<Header*>(memory);
+  data_ = static_cast<char*>(memory) + sizeof(Header);
+  capacity_ = capacity;
+  if (init) {
+    memset(header_, 0, sizeof(Header));
+  }
+}
+
+bool ShmRing::Write(const char* data, size_t size) {
+  DCHECK(header_);
+  size_t offset = 0;
+  for (;;) {
+    const uint32_t head = header_->head;
+    const uint32_t tail = header_->tail;
+    const uint32_t free_space = capacity_ - (head - tail);
+    const size_t remaining = size - offset;
+    const uint32_t required = kRecordHeaderSize +
+        static_cast<uint32_t>(std::min<size_t>(remaining, kRecordHeaderSize));
+    if (free_space < required) {
+      if (!WaitWhile(&header_->space_sequence, &header_->writer_waiting,
+                     &header_->tail, tail)) {
+        return false;
+      }
+      continue;
+    }
+    // Freed data must not be overwritten before tail is read
+    __sync_synchronize();
+    const uint32_t chunk = static_cast<uint32_t>(std::min<size_t>(
+        remaining, (free_space - kRecordHeaderSize) & ~(kRecordHeaderSize - 1)));
+    const uint32_t length = chunk | (chunk < remaining ? kMoreRecords : 0);
+    CopyIn(head, &length, kRecordHeaderSize);
+    CopyIn(head + kRecordHeaderSize, data + offset, chunk);
+    // Record has to be complete when reader sees new head
+    __sync_synchronize();
+    header_->head = head + kRecordHeaderSize + Align(chunk);
+    Notify(&header_->data_sequence, &header_->reader_waiting);
+    offset += chunk;
+    if (offset == size) {
+      return true;
+    }
+  }
+}
+
+bool ShmRing::Read(std::string* message) {
+  DCHECK(header_);
+  DCHECK(message);
+  message->clear();
+  for (;;) {
+    const uint32_t tail = header_->tail;
+    if (tail == header_->head) {
+      if (!WaitWhile(&header_->data_sequence, &header_->reader_waiting,
+                     &header_->head, tail)) {
+        return false;
+      }
+      continue;
+    }
+    // Record must not be read before head is
+    __sync_synchronize();
+    uint32_t length = 0;
+    CopyOut(tail, &length, kRecordHeaderSize);
+    const uint32_t chunk = length & ~kMoreRecords;
+    if (chunk) {
+      const size_t offset = message->size();
+      message->resize(offset + chunk);
+      CopyOut(tail + kRecordHeaderSize, &(*message)[offset], chunk);
+    }
+    // Record has to be read out before writer is allowed to reuse it
+    __sync_synchronize();
+    header_->tail = tail + kRecordHeaderSize + Align(chunk);
+    Notify(&header_->space_sequence, &header_->writer_waiting);
+    if (0 == (length & kMoreRecords)) {
+      return true;
+    }
+  }
+}
+
+void ShmRing::Stop() {
+  if (!header_) {
+    return;
+  }
+  stopped_ = 1;
+  __sync_synchronize();
+  syscall(SYS_futex, &header_->data_sequence, FUTEX_WAKE, INT_MAX,
+          NULL, NULL, 0);
+  syscall(SYS_futex, &header_->space_sequence, FUTEX_WAKE, INT_MAX,
+          NULL, NULL, 0);
+}
+
+bool ShmRing::WaitWhile(volatile uint32_t* sequence,
+                        volatile uint32_t* waiting,
+                        volatile uint32_t* position, uint32_t value) {
+  const uint32_t expected = *sequence;
+  *waiting = 1;
+  // Peer either sees the flag or has already moved position
+  __sync_synchronize();
+  if (*position == value && !stopped_) {
+    // Returns right away if sequence has changed since it was read
+    syscall(SYS_futex, sequence, FUTEX_WAIT, expected, NULL, NULL, 0);
+  }
+  *waiting = 0;
+  return !stopped_;
+}
+
+void ShmRing::Notify(volatile uint32_t* sequence, volatile uint32_t* waiting) {
+  // Full barrier, position is stored before the flag is checked
+  __sync_fetch_and_add(sequence, 1);
+  if (*waiting) {
+    syscall(SYS_futex, sequence, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+  }
+}
+
+void ShmRing::CopyIn(uint32_t position, const void* data, uint32_t size) {
+  const uint32_t index = position & (capacity_ - 1);
+  const uint32_t first = std::min(size, capacity_ - index);
+  memcpy(data_ + index, data, first);
+  memcpy(data_, static_cast<const char*>(data) + first, size - first);
+}
+
+void ShmRing::CopyOut(uint32_t position, void* data, uint32_t size) const {
+  const uint32_t index = position & (capacity_ - 1);
+  const uint32_t first = std::min(size, capacity_ - index);
+  memcpy(data, data_ + index, first);
+  memcpy(static_cast<char*>(data) + first, data_, size - first);
+}
+
+}  // namespace utils
@@ -32,6 +32,7 @@
 
 #include "utils/threads/async_runner.h"
 
+#include <algorithm>
 #include <string>
 
 #include "utils/logger.h"
@@ -41,45 +42,165 @@ namespace threads {
 CREATE_LOGGERPTR_GLOBAL(logger_, "AsyncRunner");
 
 AsyncRunner::AsyncRunner(const std::string &thread_name)
-  : executor_(new AsyncRunnerDelegate) {
+  : executor_(new AsyncRunnerDelegate),
+    pool_(NULL),
+    pool_stopped_(false) {
   LOG4CXX_AUTO_TRACE(logger_);
   thread_ = threads::CreateThread(thread_name.c_str(),
                                   executor_);
   thread_->start();
 }
 
+AsyncRunner::AsyncRunner(const std::string &thread_name, ThreadPool* pool,
+                         size_t max_running)
+  : thread_(NULL),
+    executor_(NULL),
+    pool_(pool),
+    pool_stopped_(false) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  DCHECK(pool);
+  if (0 == max_running) {
+    max_running = 1;
+  }
+  for (size_t i = 0; i < max_running; ++i) {
+    pool_tasks_.push_back(new PoolTask(this));
+  }
+  idle_tasks_ = pool_tasks_;
+  LOG4CXX_DEBUG(logger_, "Runner " << thread_name << " works on thread pool"
+                " running up to " << max_running << " delegates");
+}
+
 void AsyncRunner::AsyncRun(ThreadDelegate* delegate) {
   LOG4CXX_AUTO_TRACE(logger_);
-  executor_->runDelegate(delegate);
+  if (!pool_) {
+    executor_->runDelegate(delegate);
+    return;
+  }
+  DCHECK_OR_RETURN_VOID(delegate);
+  PoolTask* task = NULL;
+  {
+    sync_primitives::AutoLock lock(pool_lock_);
+    if (pool_stopped_) {
+      LOG4CXX_WARN(logger_, "Delegate is passed to stopped runner");
+      delete delegate;
+      return;
+    }
+    pool_queue_.push_back(delegate);
+    if (!idle_tasks_.empty()) {
+      task = idle_tasks_.back();
+      idle_tasks_.pop_back();
+    }
+  }
+  // Busy tasks take delegate from queue otherwise
+  if (task) {
+    pool_->Schedule(task);
+  }
+}
+
+bool AsyncRunner::Cancel(ThreadDelegate* delegate) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  if (!pool_) {
+    return executor_->cancelDelegate(delegate);
+  }
+  {
+    sync_primitives::AutoLock lock(pool_lock_);
+    std::deque<ThreadDelegate*>::iterator it =
+        std::find(pool_queue_.begin(), pool_queue_.end(), delegate);
+    if (pool_queue_.end() == it) {
+      return false;
+    }
+    pool_queue_.erase(it);
+  }
+  delete delegate;
+  return true;
 }
 
 void AsyncRunner::Stop() {
   LOG4CXX_AUTO_TRACE(logger_);
-  thread_->join();
+  if (!pool_) {
+    thread_->join();
+    return;
+  }
+  std::deque<ThreadDelegate*> dropped;
+  {
+    sync_primitives::AutoLock lock(pool_lock_);
+    pool_stopped_ = true;
+    dropped.swap(pool_queue_);
+    // Running delegate is reset by its task under lock before deletion
+    for (size_t i = 0; i < pool_tasks_.size(); ++i) {
+      if (pool_tasks_[i]->current) {
+        pool_tasks_[i]->current->exitThreadMain();
+      }
+    }
+    while (idle_tasks_.size() != pool_tasks_.size()) {
+      pool_idle_.Wait(lock);
+    }
+  }
+  for (size_t i = 0; i < dropped.size(); ++i) {
+    delete dropped[i];
+  }
 }
 
 AsyncRunner::~AsyncRunner() {
   LOG4CXX_AUTO_TRACE(logger_);
+  if (pool_) {
+    Stop();
+    for (size_t i = 0; i < pool_tasks_.size(); ++i) {
+      delete pool_tasks_[i];
+    }
+    return;
+  }
   thread_->join();
   delete executor_;
   threads::DeleteThread(thread_);
 }
 
+void AsyncRunner::RunPooledDelegates(PoolTask* task) {
+  sync_primitives::AutoLock lock(pool_lock_);
+  while (!pool_queue_.empty()) {
+    ThreadDelegate* run = pool_queue_.front();
+    pool_queue_.pop_front();
+    task->current = run;
+    {
+      sync_primitives::AutoUnlock unlock(lock);
+      run->threadMain();
+    }
+    task->current = NULL;
+    {
+      sync_primitives::AutoUnlock unlock(lock);
+      delete run;
+    }
+  }
+  idle_tasks_.push_back(task);
+  pool_idle_.Broadcast();
+}
+
+AsyncRunner::PoolTask::PoolTask(AsyncRunner* runner)
+  : current(NULL),
+    runner_(*runner) {
+}
+
+void AsyncRunner::PoolTask::threadMain() {
+  runner_.RunPooledDelegates(this);
+}
+
 AsyncRunner::AsyncRunnerDelegate::AsyncRunnerDelegate()
   : stop_flag_(false) {
 }
 
 void AsyncRunner::AsyncRunnerDelegate::processDelegate() {
-  if (!delegates_queue_.empty()) {
-    delegates_queue_lock_.Acquire();
-    ThreadDelegate* run = delegates_queue_.front();
-    delegates_queue_.pop();
-    delegates_queue_lock_.Release();
-
-    if (NULL != run) {
-      run->threadMain();
-      delete run;
+  ThreadDelegate* run = NULL;
+  {
+    sync_primitives::AutoLock lock(delegates_queue_lock_);
+    if (delegates_queue_.empty()) {
+      return;
     }
+    run = delegates_queue_.front();
+    delegates_queue_.pop_front();
+  }
+  if (NULL != run) {
+    run->threadMain();
+    delete run;
   }
 }
 
@@ -109,8 +230,24 @@ void AsyncRunner::AsyncRunnerDelegate::exitThreadMain() {
 void AsyncRunner::AsyncRunnerDelegate::runDelegate(ThreadDelegate* delegate) {
   LOG4CXX_AUTO_TRACE(logger_);
   sync_primitives::AutoLock lock(delegates_queue_lock_);
-  delegates_queue_.push(delegate);
+  delegates_queue_.push_back(delegate);
   delegate_notifier_.NotifyOne();
 }
 
+bool AsyncRunner::AsyncRunnerDelegate::cancelDelegate(
+    ThreadDelegate* delegate) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  {
+    sync_primitives::AutoLock lock(delegates_queue_lock_);
+    std::deque<ThreadDelegate*>::iterator it =
+        std::find(delegates_queue_.begin(), delegates_queue_.end(), delegate);
+    if (delegates_queue_.end() == it) {
+      return false;
+    }
+    delegates_queue_.erase(it);
+  }
+  delete delegate;
+  return true;
+}
+
 } // namespace policy.
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/threads/message_loop_registry.h"
+
+#include <pthread.h>
+
+namespace threads {
+
+namespace {
+MessageLoopRegistry* registry_instance = NULL;
+pthread_once_t registry_once = PTHREAD_ONCE_INIT;
+}  // namespace
+
+MessageLoopRegistry::MessageLoopRegistry() {
+}
+
+MessageLoopRegistry* MessageLoopRegistry::instance() {
+  pthread_once(&registry_once, &MessageLoopRegistry::CreateInstance);
+  return registry_instance;
+}
+
+void MessageLoopRegistry::CreateInstance() {
+  // Never deleted, loops may be destroyed during static destruction
+  registry_instance = new MessageLoopRegistry();
+}
+
+void MessageLoopRegistry::Register(const std::string& name,
+                                   const Entry* entry) {
+  DCHECK(entry);
+  sync_primitives::AutoLock auto_lock(entries_lock_);
+  entries_.push_back(std::make_pair(name, entry));
+}
+
+void MessageLoopRegistry::Unregister(const Entry* entry) {
+  sync_primitives::AutoLock auto_lock(entries_lock_);
+  for (Entries::iterator it = entries_.begin(); entries_.end() != it; ++it) {
+    if (entry == it->second) {
+      entries_.erase(it);
+      return;
+    }
+  }
+}
+
+void MessageLoopRegistry::Snapshot(Depths* depths) const {
+  DCHECK(depths);
+  depths->clear();
+  // Depth is taken under the lock, so entry can't be unregistered meanwhile
+  sync_primitives::AutoLock auto_lock(entries_lock_);
+  depths->reserve(entries_.size());
+  for (Entries::const_iterator it = entries_.begin();
+       entries_.end() != it; ++it) {
+    depths->push_back(std::make_pair(it->first, it->second->QueueDepth()));
+  }
+}
+
+}  // namespace threads
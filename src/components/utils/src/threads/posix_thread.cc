@@ -34,6 +34,7 @@
 #include <limits.h>
 #include <stddef.h>
 #include <signal.h>
+#include <sched.h>
 
 #ifdef BUILD_TESTS
 // Temporary fix for UnitTest until APPLINK-9987 is resolved
@@ -44,6 +45,7 @@
 #include "pthread.h"
 #include "utils/atomic.h"
 #include "utils/threads/thread_delegate.h"
+#include "utils/threads/thread_profiles.h"
 #include "utils/logger.h"
 
 #ifndef __QNXNTO__
@@ -60,6 +62,67 @@ CREATE_LOGGERPTR_GLOBAL(logger_, "Utils")
 
 size_t Thread::kMinStackSize = PTHREAD_STACK_MIN; /* Ubuntu : 16384 ; QNX : 256; */
 
+namespace {
+// Returns true if thread is to be created with explicit scheduling
+bool SetScheduling(pthread_attr_t* attributes, const ThreadProfile& profile) {
+  int policy = SCHED_OTHER;
+  switch (profile.policy) {
+    case ThreadProfile::kInheritPolicy:
+      return false;
+    case ThreadProfile::kOtherPolicy:
+      policy = SCHED_OTHER;
+      break;
+    case ThreadProfile::kFifoPolicy:
+      policy = SCHED_FIFO;
+      break;
+    case ThreadProfile::kRoundRobinPolicy:
+      policy = SCHED_RR;
+      break;
+  }
+  sched_param param;
+  param.sched_priority = profile.priority;
+  int pthread_result =
+      pthread_attr_setinheritsched(attributes, PTHREAD_EXPLICIT_SCHED);
+  if (pthread_result == EOK) {
+    pthread_result = pthread_attr_setschedpolicy(attributes, policy);
+  }
+  if (pthread_result == EOK) {
+    pthread_result = pthread_attr_setschedparam(attributes, &param);
+  }
+  if (pthread_result != EOK) {
+    LOG4CXX_WARN(
+        logger_,
+        "Couldn't set scheduling policy " << policy << ", priority " << profile.priority << ". Error code = " << pthread_result << " (\"" << strerror(pthread_result) << "\")");
+    pthread_attr_setinheritsched(attributes, PTHREAD_INHERIT_SCHED);
+    return false;
+  }
+  return true;
+}
+
+void SetAffinity(const PlatformThreadHandle& thread_id,
+                 const std::vector<int>& cpus) {
+#if defined(OS_LINUX)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (std::vector<int>::const_iterator it = cpus.begin();
+       it != cpus.end(); ++it) {
+    if (*it < CPU_SETSIZE) {
+      CPU_SET(*it, &cpu_set);
+    }
+  }
+  const int pthread_result =
+      pthread_setaffinity_np(thread_id, sizeof(cpu_set), &cpu_set);
+  if (pthread_result != EOK) {
+    LOG4CXX_WARN(
+        logger_,
+        "Couldn't set CPU affinity. Error code = " << pthread_result << " (\"" << strerror(pthread_result) << "\")");
+  }
+#else
+  LOG4CXX_WARN(logger_, "CPU affinity of threads is not supported");
+#endif
+}
+}  // namespace
+
 void Thread::cleanup(void* arg) {
   LOG4CXX_AUTO_TRACE(logger_);
   Thread* thread = reinterpret_cast<Thread*>(arg);
@@ -179,6 +242,14 @@ bool Thread::start(const ThreadOptions& options) {
 
   thread_options_ = options;
 
+  // Configured profile of thread role overrides stack size given by code
+  ThreadProfile profile;
+  const bool has_profile = ThreadProfiles::instance()->Find(name_, &profile);
+  if (has_profile && 0 != profile.stack_size) {
+    thread_options_ =
+        ThreadOptions(profile.stack_size, thread_options_.is_joinable());
+  }
+
   pthread_attr_t attributes;
   int pthread_result = pthread_attr_init(&attributes);
   if (pthread_result != EOK) {
@@ -211,12 +282,25 @@ bool Thread::start(const ThreadOptions& options) {
     thread_options_ = thread_options_temp;
   }
 
+  const bool explicit_scheduling =
+      has_profile && SetScheduling(&attributes, profile);
+
   if (!thread_created_) {
     // state_lock 1
     pthread_result = pthread_create(&handle_, &attributes, threadFunc, this);
+    if (pthread_result == EPERM && explicit_scheduling) {
+      // Real time policies need privileges, thread still runs without them
+      LOG4CXX_WARN(logger_, "Not permitted to set scheduling of thread "
+                   << name_ << ", default scheduling is used");
+      pthread_attr_setinheritsched(&attributes, PTHREAD_INHERIT_SCHED);
+      pthread_result = pthread_create(&handle_, &attributes, threadFunc, this);
+    }
     if (pthread_result == EOK) {
       LOG4CXX_DEBUG(logger_, "Created thread: " << name_);
       SetNameForId(handle_, name_);
+      if (has_profile && !profile.cpus.empty()) {
+        SetAffinity(handle_, profile.cpus);
+      }
       // state_lock 0
       // possible concurrencies: stop and threadFunc
       state_cond_.Wait(auto_lock);
@@ -0,0 +1,282 @@
+﻿/*
+ Copyright (c) 2015, Ford Motor Company
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following
+ disclaimer in the documentation and/or other materials provided with the
+ distribution.
+
+ Neither the name of the Ford Motor Company nor the names of its contributors
+ may be used to endorse or promote products derived from this software
+ without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/threads/thread_pool.h"
+
+#include <unistd.h>
+
+#include <sstream>
+#include <string>
+
+#include "utils/atomic.h"
+#include "utils/logger.h"
+
+namespace threads {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "Utils")
+
+ThreadPool::ThreadPool(const std::string& name, size_t workers_count)
+  : pending_tasks_(0),
+    sleeping_workers_(0),
+    next_queue_(0),
+    stopped_(false) {
+  LOG4CXX_AUTO_TRACE(logger_);
+  pthread_key_create(&current_worker_key_, NULL);
+  if (0 == workers_count) {
+    const long processors_count = sysconf(_SC_NPROCESSORS_ONLN);
+    workers_count = processors_count > 0 ? processors_count : 1;
+  }
+  for (size_t i = 0; i < workers_count; ++i) {
+    queues_.push_back(new WorkQueue);
+  }
+  for (size_t i = 0; i < workers_count; ++i) {
+    WorkerDelegate* delegate = new WorkerDelegate(this, i);
+    std::stringstream worker_name;
+    worker_name << name << i;
+    delegates_.push_back(delegate);
+    workers_.push_back(CreateThread(worker_name.str().c_str(), delegate));
+  }
+  for (size_t i = 0; i < workers_count; ++i) {
+    if (!workers_[i]->start()) {
+      LOG4CXX_ERROR(logger_, "Failed to start worker " << workers_[i]->name());
+    }
+  }
+  LOG4CXX_DEBUG(logger_, "Thread pool " << name << " started with "
+                << workers_count << " workers");
+}
+
+ThreadPool::~ThreadPool() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  Stop();
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    workers_[i]->join();
+    delete delegates_[i];
+    DeleteThread(workers_[i]);
+  }
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    if (!queues_[i]->tasks.empty()) {
+      LOG4CXX_WARN(logger_, queues_[i]->tasks.size()
+                   << " tasks are dropped by stopped worker " << i);
+    }
+    delete queues_[i];
+  }
+  pthread_key_delete(current_worker_key_);
+}
+
+void ThreadPool::Schedule(ThreadDelegate* task) {
+  DCHECK_OR_RETURN_VOID(task);
+  if (stopped_) {
+    LOG4CXX_WARN(logger_, "Task is scheduled to stopped thread pool");
+    return;
+  }
+  const WorkerDelegate* current_worker =
+      static_cast<WorkerDelegate*>(pthread_getspecific(current_worker_key_));
+  // Tasks spawned by worker most probably share data with its current task
+  const size_t index = current_worker ? current_worker->index()
+                       : atomic_post_inc(&next_queue_) % queues_.size();
+  {
+    sync_primitives::AutoLock auto_lock(queues_[index]->lock);
+    queues_[index]->tasks.push_back(task);
+  }
+  // Full barrier, pairs with sleeping_workers_ increment in WaitForTask
+  atomic_post_inc(&pending_tasks_);
+  if (sleeping_workers_ > 0) {
+    sync_primitives::AutoLock auto_lock(idle_lock_);
+    task_available_.NotifyOne();
+  }
+}
+
+void ThreadPool::Stop() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock auto_lock(idle_lock_);
+  stopped_ = true;
+  task_available_.Broadcast();
+}
+
+ThreadDelegate* ThreadPool::TakeTask(size_t index) {
+  const size_t queues_count = queues_.size();
+  // Own queue goes first, then others are tried in order
+  for (size_t i = 0; i < queues_count; ++i) {
+    WorkQueue& queue = *queues_[(index + i) % queues_count];
+    sync_primitives::AutoLock auto_lock(queue.lock);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    ThreadDelegate* task = queue.tasks.front();
+    queue.tasks.pop_front();
+    atomic_post_dec(&pending_tasks_);
+    return task;
+  }
+  return NULL;
+}
+
+bool ThreadPool::WaitForTask() {
+  sync_primitives::AutoLock auto_lock(idle_lock_);
+  atomic_post_inc(&sleeping_workers_);
+  while (!stopped_ && 0 == pending_tasks_) {
+    task_available_.Wait(auto_lock);
+  }
+  atomic_post_dec(&sleeping_workers_);
+  return !stopped_;
+}
+
+ThreadPool::WorkerDelegate::WorkerDelegate(ThreadPool* pool, size_t index)
+  : pool_(*pool),
+    index_(index) {
+}
+
+void ThreadPool::WorkerDelegate::threadMain() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  pthread_setspecific(pool_.current_worker_key_, this);
+  for (;;) {
+    ThreadDelegate* task = pool_.TakeTask(index_);
+    if (task) {
+      task->threadMain();
+    } else if (!pool_.WaitForTask()) {
+      break;
+    }
+  }
+  pthread_setspecific(pool_.current_worker_key_, NULL);
+}
+
+void ThreadPool::WorkerDelegate::exitThreadMain() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  pool_.Stop();
+}
+
+SerialTask::SerialTask(ThreadPool* pool, ThreadDelegate* delegate)
+  : pool_(*pool),
+    delegate_(*delegate),
+    runner_(this),
+    notifications_count_(0) {
+  DCHECK(pool);
+  DCHECK(delegate);
+}
+
+SerialTask::~SerialTask() {
+  WaitIdle();
+}
+
+void SerialTask::Notify() {
+  // Only first notification schedules the run, others are accumulated
+  if (0 == atomic_post_inc(&notifications_count_)) {
+    pool_.Schedule(&runner_);
+  }
+}
+
+void SerialTask::WaitIdle() {
+  sync_primitives::AutoLock auto_lock(idle_lock_);
+  while (0 != notifications_count_) {
+    idle_.Wait(auto_lock);
+  }
+}
+
+void SerialTask::Run() {
+  uint32_t handled_count = 0;
+  do {
+    handled_count = notifications_count_;
+    delegate_.threadMain();
+  } while (atomic_post_sub(&notifications_count_, handled_count) !=
+           handled_count);
+  sync_primitives::AutoLock auto_lock(idle_lock_);
+  idle_.Broadcast();
+}
+
+SerialTask::RunnerDelegate::RunnerDelegate(SerialTask* task)
+  : task_(*task) {
+}
+
+void SerialTask::RunnerDelegate::threadMain() {
+  task_.Run();
+}
+
+Strand::Strand(ThreadPool* pool)
+  : stopped_(false),
+    drain_delegate_(this),
+    serial_task_(pool, &drain_delegate_) {
+}
+
+Strand::~Strand() {
+  Stop();
+}
+
+void Strand::Post(ThreadDelegate* delegate) {
+  DCHECK_OR_RETURN_VOID(delegate);
+  {
+    sync_primitives::AutoLock auto_lock(delegates_queue_lock_);
+    if (stopped_) {
+      LOG4CXX_WARN(logger_, "Delegate is posted to stopped strand");
+      delete delegate;
+      return;
+    }
+    delegates_queue_.push(delegate);
+  }
+  serial_task_.Notify();
+}
+
+void Strand::Stop() {
+  {
+    sync_primitives::AutoLock auto_lock(delegates_queue_lock_);
+    stopped_ = true;
+    while (!delegates_queue_.empty()) {
+      delete delegates_queue_.front();
+      delegates_queue_.pop();
+    }
+  }
+  serial_task_.WaitIdle();
+}
+
+void Strand::Drain() {
+  std::queue<ThreadDelegate*> delegates;
+  {
+    sync_primitives::AutoLock auto_lock(delegates_queue_lock_);
+    delegates_queue_.swap(delegates);
+  }
+  while (!delegates.empty()) {
+    ThreadDelegate* delegate = delegates.front();
+    delegates.pop();
+    if (!stopped_) {
+      delegate->threadMain();
+    }
+    delete delegate;
+  }
+}
+
+Strand::DrainDelegate::DrainDelegate(Strand* strand)
+  : strand_(*strand) {
+}
+
+void Strand::DrainDelegate::threadMain() {
+  strand_.Drain();
+}
+
+}  // namespace threads
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/threads/thread_profiles.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <sstream>
+
+namespace threads {
+
+namespace {
+ThreadProfiles* profiles_instance = NULL;
+pthread_once_t profiles_once = PTHREAD_ONCE_INIT;
+
+std::string Trim(const std::string& value) {
+  const char* kSpaces = " \t";
+  const size_t begin = value.find_first_not_of(kSpaces);
+  if (std::string::npos == begin) {
+    return std::string();
+  }
+  return value.substr(begin, value.find_last_not_of(kSpaces) - begin + 1);
+}
+
+bool ParseNumber(const std::string& value, long* number) {
+  char* end = NULL;
+  *number = strtol(value.c_str(), &end, 10);
+  return !value.empty() && '\0' == *end && *number >= 0;
+}
+
+bool ParsePolicy(const std::string& value,
+                 ThreadProfile::SchedulingPolicy* policy) {
+  if (0 == strcasecmp("OTHER", value.c_str())) {
+    *policy = ThreadProfile::kOtherPolicy;
+  } else if (0 == strcasecmp("FIFO", value.c_str())) {
+    *policy = ThreadProfile::kFifoPolicy;
+  } else if (0 == strcasecmp("RR", value.c_str())) {
+    *policy = ThreadProfile::kRoundRobinPolicy;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ParseCpus(const std::string& value, std::vector<int>* cpus) {
+  std::istringstream stream(value);
+  std::string range;
+  while (stream >> range) {
+    const size_t dash = range.find('-');
+    long first = 0;
+    long last = 0;
+    if (!ParseNumber(range.substr(0, dash), &first)) {
+      return false;
+    }
+    last = first;
+    if (std::string::npos != dash &&
+        (!ParseNumber(range.substr(dash + 1), &last) || last < first)) {
+      return false;
+    }
+    for (long cpu = first; cpu <= last; ++cpu) {
+      cpus->push_back(static_cast<int>(cpu));
+    }
+  }
+  return true;
+}
+}  // namespace
+
+ThreadProfile::ThreadProfile()
+  : stack_size(0),
+    policy(kInheritPolicy),
+    priority(0),
+    cpus() {
+}
+
+bool ThreadProfile::Parse(const std::string& value) {
+  std::vector<std::string> fields;
+  std::istringstream stream(value);
+  std::string field;
+  while (std::getline(stream, field, ',')) {
+    fields.push_back(Trim(field));
+  }
+  if (fields.size() > 4) {
+    return false;
+  }
+  fields.resize(4);
+
+  ThreadProfile parsed;
+  long number = 0;
+  if (!fields[0].empty()) {
+    if (!ParseNumber(fields[0], &number)) {
+      return false;
+    }
+    parsed.stack_size = static_cast<size_t>(number) * 1024;
+  }
+  if (!fields[1].empty() && !ParsePolicy(fields[1], &parsed.policy)) {
+    return false;
+  }
+  if (!fields[2].empty()) {
+    if (!ParseNumber(fields[2], &number)) {
+      return false;
+    }
+    parsed.priority = static_cast<int>(number);
+  }
+  if (!ParseCpus(fields[3], &parsed.cpus)) {
+    return false;
+  }
+  *this = parsed;
+  return true;
+}
+
+ThreadProfiles::ThreadProfiles() {
+}
+
+ThreadProfiles* ThreadProfiles::instance() {
+  pthread_once(&profiles_once, &ThreadProfiles::CreateInstance);
+  return profiles_instance;
+}
+
+void ThreadProfiles::CreateInstance() {
+  // Never deleted, threads may be started during static destruction
+  profiles_instance = new ThreadProfiles();
+}
+
+void ThreadProfiles::Set(const Profiles& profiles) {
+  sync_primitives::AutoLock auto_lock(profiles_lock_);
+  profiles_ = profiles;
+}
+
+bool ThreadProfiles::Find(const std::string& thread_name,
+                          ThreadProfile* profile) const {
+  DCHECK(profile);
+  sync_primitives::AutoLock auto_lock(profiles_lock_);
+  const Profiles::value_type* found = NULL;
+  for (Profiles::const_iterator it = profiles_.begin();
+       profiles_.end() != it; ++it) {
+    const std::string& prefix = it->first;
+    if (0 == thread_name.compare(0, prefix.size(), prefix) &&
+        (NULL == found || prefix.size() > found->first.size())) {
+      found = &*it;
+    }
+  }
+  if (NULL == found) {
+    return false;
+  }
+  *profile = found->second;
+  return true;
+}
+
+}  // namespace threads
@@ -0,0 +1,295 @@
+﻿/*
+ Copyright (c) 2015, Ford Motor Company
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+
+ Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following
+ disclaimer in the documentation and/or other materials provided with the
+ distribution.
+
+ Neither the name of the Ford Motor Company nor the names of its contributors
+ may be used to endorse or promote products derived from this software
+ without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/timer_wheel.h"
+
+#include <pthread.h>
+#include <time.h>
+
+#include <limits>
+
+#include "utils/logger.h"
+
+namespace timer {
+
+CREATE_LOGGERPTR_GLOBAL(logger_, "Utils")
+
+namespace {
+uint64_t NowMilliseconds() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1000u + now.tv_nsec / 1000000;
+}
+}  // namespace
+
+TimerWheel::Timer::Timer()
+    : prev_(NULL),
+      next_(NULL),
+      expiration_tick_(0),
+      armed_(false) {
+}
+
+TimerWheel::Timer::~Timer() {
+  DCHECK(!armed_);
+}
+
+TimerWheel::Slot::Slot() {
+  prev_ = this;
+  next_ = this;
+}
+
+void TimerWheel::Slot::OnTimeout() {
+  NOTREACHED();
+}
+
+TimerWheel::DispatchDelegate::DispatchDelegate(TimerWheel* wheel)
+    : wheel_(*wheel) {
+}
+
+void TimerWheel::DispatchDelegate::threadMain() {
+  wheel_.Dispatch();
+}
+
+void TimerWheel::DispatchDelegate::exitThreadMain() {
+  wheel_.Stop();
+}
+
+TimerWheel::TimerWheel()
+    : current_tick_(NowTicks()),
+      wakeup_tick_(std::numeric_limits<uint64_t>::max()),
+      armed_count_(0),
+      running_timer_(NULL),
+      stop_flag_(false),
+      dispatch_delegate_(new DispatchDelegate(this)),
+      dispatch_thread_(threads::CreateThread("TimerWheel",
+                                             dispatch_delegate_)) {
+  if (!dispatch_thread_->start()) {
+    LOG4CXX_ERROR(logger_, "Failed to start timer wheel dispatch thread");
+  }
+}
+
+TimerWheel::~TimerWheel() {
+  dispatch_thread_->join();
+  delete dispatch_delegate_;
+  threads::DeleteThread(dispatch_thread_);
+}
+
+void TimerWheel::Arm(Timer* timer, uint64_t timeout_milliseconds) {
+  DCHECK_OR_RETURN_VOID(timer);
+  sync_primitives::AutoLock auto_lock(wheel_lock_);
+  if (timer->armed_) {
+    Unlink(timer);
+    --armed_count_;
+  }
+  // Timer must not fire earlier, so expiration is rounded up to the tick
+  uint64_t expiration_tick =
+      (NowMilliseconds() + timeout_milliseconds + kTickMilliseconds - 1) /
+      kTickMilliseconds;
+  if (expiration_tick < current_tick_) {
+    expiration_tick = current_tick_;
+  }
+  timer->expiration_tick_ = expiration_tick;
+  Insert(timer);
+  timer->armed_ = true;
+  ++armed_count_;
+  if (expiration_tick < wakeup_tick_) {
+    wakeup_condition_.NotifyOne();
+  }
+}
+
+void TimerWheel::Cancel(Timer* timer) {
+  DCHECK_OR_RETURN_VOID(timer);
+  sync_primitives::AutoLock auto_lock(wheel_lock_);
+  if (timer->armed_) {
+    Unlink(timer);
+    timer->armed_ = false;
+    --armed_count_;
+  }
+  if (pthread_equal(pthread_self(), dispatch_thread_->thread_handle())) {
+    return;
+  }
+  while (running_timer_ == timer) {
+    callback_finished_.Wait(auto_lock);
+  }
+}
+
+bool TimerWheel::IsArmed(const Timer* timer) const {
+  DCHECK_OR_RETURN(timer, false);
+  sync_primitives::AutoLock auto_lock(wheel_lock_);
+  return timer->armed_;
+}
+
+uint64_t TimerWheel::NowTicks() {
+  return NowMilliseconds() / kTickMilliseconds;
+}
+
+void TimerWheel::Link(Slot* slot, Timer* timer) {
+  timer->prev_ = slot->prev_;
+  timer->next_ = slot;
+  slot->prev_->next_ = timer;
+  slot->prev_ = timer;
+}
+
+void TimerWheel::Unlink(Timer* timer) {
+  timer->prev_->next_ = timer->next_;
+  timer->next_->prev_ = timer->prev_;
+  timer->prev_ = NULL;
+  timer->next_ = NULL;
+}
+
+void TimerWheel::MoveAll(Slot* from, Slot* to) {
+  if (from->empty()) {
+    return;
+  }
+  Timer* first = from->next_;
+  Timer* last = from->prev_;
+  first->prev_ = to->prev_;
+  to->prev_->next_ = first;
+  last->next_ = to;
+  to->prev_ = last;
+  from->prev_ = from;
+  from->next_ = from;
+}
+
+void TimerWheel::Insert(Timer* timer) {
+  uint64_t delta = timer->expiration_tick_ - current_tick_;
+  if (delta < kRootSlotsCount) {
+    Link(&root_slots_[timer->expiration_tick_ & (kRootSlotsCount - 1)],
+         timer);
+    return;
+  }
+  const size_t wheel_bits = kRootSlotsBits + kLevelsCount * kLevelSlotsBits;
+  const uint64_t max_delta = (static_cast<uint64_t>(1) << wheel_bits) - 1;
+  if (delta > max_delta) {
+    // Farther timeouts are 13 years away, it is equal to never
+    delta = max_delta;
+    timer->expiration_tick_ = current_tick_ + max_delta;
+  }
+  for (size_t level = 0; level < kLevelsCount; ++level) {
+    const size_t shift = kRootSlotsBits + level * kLevelSlotsBits;
+    if (delta < (static_cast<uint64_t>(1) << (shift + kLevelSlotsBits))) {
+      const size_t index =
+          (timer->expiration_tick_ >> shift) & (kLevelSlotsCount - 1);
+      Link(&level_slots_[level][index], timer);
+      return;
+    }
+  }
+  NOTREACHED();
+}
+
+void TimerWheel::Cascade(size_t level) {
+  const size_t shift = kRootSlotsBits + level * kLevelSlotsBits;
+  const size_t index = (current_tick_ >> shift) & (kLevelSlotsCount - 1);
+  Slot pending;
+  MoveAll(&level_slots_[level][index], &pending);
+  while (!pending.empty()) {
+    Timer* timer = pending.next_;
+    Unlink(timer);
+    Insert(timer);
+  }
+  if (0 == index && level + 1 < kLevelsCount) {
+    Cascade(level + 1);
+  }
+}
+
+void TimerWheel::ProcessTick() {
+  const size_t index = current_tick_ & (kRootSlotsCount - 1);
+  if (0 == index) {
+    Cascade(0);
+  }
+  MoveAll(&root_slots_[index], &expired_);
+  ++current_tick_;
+}
+
+void TimerWheel::RunExpired(sync_primitives::AutoLock& auto_lock) {
+  while (!expired_.empty()) {
+    Timer* timer = expired_.next_;
+    Unlink(timer);
+    timer->armed_ = false;
+    --armed_count_;
+    running_timer_ = timer;
+    {
+      sync_primitives::AutoUnlock auto_unlock(auto_lock);
+      timer->OnTimeout();
+    }
+    running_timer_ = NULL;
+    callback_finished_.Broadcast();
+  }
+}
+
+uint64_t TimerWheel::NextExpirationTick() const {
+  // Nearest cascade has to be done in time even if root slots are empty
+  const uint64_t cascade_tick =
+      (current_tick_ + kRootSlotsCount - 1) & ~static_cast<uint64_t>(
+          kRootSlotsCount - 1);
+  for (uint64_t tick = current_tick_; tick < cascade_tick; ++tick) {
+    if (!root_slots_[tick & (kRootSlotsCount - 1)].empty()) {
+      return tick;
+    }
+  }
+  return cascade_tick;
+}
+
+void TimerWheel::Dispatch() {
+  LOG4CXX_AUTO_TRACE(logger_);
+  sync_primitives::AutoLock auto_lock(wheel_lock_);
+  while (!stop_flag_) {
+    const uint64_t now_tick = NowTicks();
+    while (current_tick_ <= now_tick) {
+      ProcessTick();
+    }
+    RunExpired(auto_lock);
+    if (stop_flag_) {
+      break;
+    }
+    if (0 == armed_count_) {
+      wakeup_tick_ = std::numeric_limits<uint64_t>::max();
+      wakeup_condition_.Wait(auto_lock);
+      continue;
+    }
+    wakeup_tick_ = NextExpirationTick();
+    const uint64_t wakeup_milliseconds = wakeup_tick_ * kTickMilliseconds;
+    const uint64_t now_milliseconds = NowMilliseconds();
+    if (wakeup_milliseconds > now_milliseconds) {
+      wakeup_condition_.WaitFor(auto_lock, static_cast<int32_t>(
+          wakeup_milliseconds - now_milliseconds));
+    }
+  }
+}
+
+void TimerWheel::Stop() {
+  sync_primitives::AutoLock auto_lock(wheel_lock_);
+  stop_flag_ = true;
+  wakeup_condition_.NotifyOne();
+}
+
+}  // namespace timer
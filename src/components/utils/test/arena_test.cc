@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <pthread.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "utils/arena.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::Arena;
+using ::utils::ArenaString;
+using ::utils::ScopedMessageArena;
+
+namespace {
+void* CurrentArena(void*) {
+  ScopedMessageArena scope;
+  return ScopedMessageArena::Current();
+}
+}  // namespace
+
+TEST(ArenaTest, AllocationsAlignedAndDistinct) {
+  Arena arena(256);
+  char* first = static_cast<char*>(arena.Allocate(3));
+  char* second = static_cast<char*>(arena.Allocate(1));
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(first) % Arena::kAlignment);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(second) % Arena::kAlignment);
+  EXPECT_GE(second - first, static_cast<ptrdiff_t>(Arena::kAlignment));
+  EXPECT_EQ(2 * Arena::kAlignment, arena.allocated_bytes());
+}
+
+TEST(ArenaTest, ResetKeepsOneChunk) {
+  Arena arena(256);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(arena.Allocate(48));
+  }
+  // Dedicated chunk for big block
+  ASSERT_TRUE(arena.Allocate(4096));
+  const size_t reserved = arena.reserved_bytes();
+  arena.Reset();
+  EXPECT_EQ(0u, arena.allocated_bytes());
+  EXPECT_LT(arena.reserved_bytes(), reserved);
+  EXPECT_LT(0u, arena.reserved_bytes());
+
+  const size_t kept = arena.reserved_bytes();
+  ASSERT_TRUE(arena.Allocate(48));
+  EXPECT_EQ(kept, arena.reserved_bytes());
+}
+
+TEST(ArenaTest, BigBlockDoesNotWasteCurrentChunk) {
+  Arena arena(256);
+  char* small = static_cast<char*>(arena.Allocate(16));
+  ASSERT_TRUE(arena.Allocate(1024));
+  char* next_small = static_cast<char*>(arena.Allocate(16));
+  EXPECT_EQ(small + 16, next_small);
+}
+
+TEST(ScopedMessageArenaTest, CurrentOnlyWithinScope) {
+  EXPECT_EQ(NULL, ScopedMessageArena::Current());
+  {
+    ScopedMessageArena outer;
+    Arena* arena = ScopedMessageArena::Current();
+    ASSERT_TRUE(arena);
+    {
+      ScopedMessageArena inner;
+      EXPECT_EQ(arena, ScopedMessageArena::Current());
+      arena->Allocate(100);
+    }
+    // Inner scope leaves data of outer one alive
+    EXPECT_LT(0u, arena->allocated_bytes());
+  }
+  EXPECT_EQ(NULL, ScopedMessageArena::Current());
+}
+
+TEST(ScopedMessageArenaTest, OutermostScopeFreesEverything) {
+  Arena* arena = NULL;
+  {
+    ScopedMessageArena scope;
+    arena = ScopedMessageArena::Current();
+    ArenaString value(1000, 'a');
+    EXPECT_EQ(arena, value.get_allocator().arena());
+    EXPECT_LE(1000u, arena->allocated_bytes());
+  }
+  ScopedMessageArena scope;
+  EXPECT_EQ(arena, ScopedMessageArena::Current());
+  EXPECT_EQ(0u, arena->allocated_bytes());
+}
+
+TEST(ScopedMessageArenaTest, PromotedStringOutlivesScope) {
+  std::string promoted;
+  {
+    ScopedMessageArena scope;
+    ArenaString value("short lived ");
+    value += "value";
+    promoted.assign(value.data(), value.size());
+  }
+  EXPECT_EQ("short lived value", promoted);
+}
+
+TEST(ScopedMessageArenaTest, HeapUsedOutsideOfScope) {
+  ArenaString value(100, 'a');
+  EXPECT_EQ(NULL, value.get_allocator().arena());
+  value += "b";
+  EXPECT_EQ(101u, value.size());
+}
+
+TEST(ScopedMessageArenaTest, ThreadsGetDifferentArenas) {
+  ScopedMessageArena scope;
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &CurrentArena, NULL));
+  void* thread_arena = NULL;
+  ASSERT_EQ(0, pthread_join(thread, &thread_arena));
+  EXPECT_TRUE(thread_arena);
+  EXPECT_NE(ScopedMessageArena::Current(), thread_arena);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
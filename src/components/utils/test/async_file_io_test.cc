@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "utils/async_file_io.h"
+#include "utils/file_system.h"
+#include "utils/lock.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using namespace file_system;
+
+namespace {
+const std::string kFileName = "async_file_io_test.dat";
+
+std::vector<uint8_t> Bytes(const std::string& text) {
+  return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+std::string Content(const std::string& file_name) {
+  std::vector<uint8_t> content;
+  ReadBinaryFile(file_name, content);
+  return std::string(content.begin(), content.end());
+}
+
+sync_primitives::Lock results_lock;
+
+class RecordingWriteCallback : public WriteCallback {
+ public:
+  RecordingWriteCallback(std::vector<bool>* results)
+      : results_(results) {
+  }
+  virtual void OnWritten(const std::string& file_name, bool result) {
+    sync_primitives::AutoLock auto_lock(results_lock);
+    results_->push_back(result);
+  }
+ private:
+  std::vector<bool>* results_;
+};
+
+class RecordingReadCallback : public ReadCallback {
+ public:
+  RecordingReadCallback(std::vector<std::string>* contents)
+      : contents_(contents) {
+  }
+  virtual void OnRead(const std::string& file_name, bool result,
+                      const std::vector<uint8_t>& content) {
+    sync_primitives::AutoLock auto_lock(results_lock);
+    contents_->push_back(result ? std::string(content.begin(), content.end())
+                                : "<failed>");
+  }
+ private:
+  std::vector<std::string>* contents_;
+};
+}  // namespace
+
+class AsyncFileIOTest : public ::testing::Test {
+ protected:
+  void TearDown() OVERRIDE {
+    AsyncFileIO::instance()->Flush();
+    DeleteFile(kFileName);
+  }
+};
+
+TEST_F(AsyncFileIOTest, WritesAndAppends_AppliedInOrder) {
+  std::vector<bool> results;
+  WriteBinaryFileAsync(kFileName, Bytes("first"), kNoSync,
+                       new RecordingWriteCallback(&results));
+  WriteAsync(kFileName, Bytes(" second"), std::ios_base::app,
+             new RecordingWriteCallback(&results));
+  WriteAsync(kFileName, Bytes(" third"), std::ios_base::app);
+  AsyncFileIO::instance()->Flush();
+
+  EXPECT_EQ("first second third", Content(kFileName));
+  ASSERT_EQ(2u, results.size());
+  EXPECT_TRUE(results[0]);
+  EXPECT_TRUE(results[1]);
+}
+
+TEST_F(AsyncFileIOTest, Rewrite_DropsPreviousData) {
+  for (int i = 0; i < 100; ++i) {
+    WriteAsync(kFileName, Bytes("old data"), std::ios_base::app);
+  }
+  WriteBinaryFileAsync(kFileName, Bytes("new"), kSyncData);
+  AsyncFileIO::instance()->Flush();
+
+  EXPECT_EQ("new", Content(kFileName));
+}
+
+TEST_F(AsyncFileIOTest, Read_SeesPreviousWrites) {
+  std::vector<std::string> contents;
+  WriteBinaryFileAsync(kFileName, Bytes("one"));
+  ReadBinaryFileAsync(kFileName, new RecordingReadCallback(&contents));
+  WriteAsync(kFileName, Bytes(" two"), std::ios_base::app);
+  ReadBinaryFileAsync(kFileName, new RecordingReadCallback(&contents));
+  AsyncFileIO::instance()->Flush();
+
+  ASSERT_EQ(2u, contents.size());
+  EXPECT_EQ("one", contents[0]);
+  EXPECT_EQ("one two", contents[1]);
+}
+
+TEST_F(AsyncFileIOTest, Replace_LeavesNoTemporaryFile) {
+  WriteBinaryFileAsync(kFileName, Bytes("old"));
+  WriteBinaryFileAsync(kFileName, Bytes("replaced"), kSyncReplace);
+  AsyncFileIO::instance()->Flush();
+
+  EXPECT_EQ("replaced", Content(kFileName));
+  EXPECT_FALSE(FileExists(kFileName + ".tmp"));
+}
+
+TEST_F(AsyncFileIOTest, WriteToMissingDirectory_Failed) {
+  std::vector<bool> results;
+  std::vector<std::string> contents;
+  const std::string file_name = "not_existing_directory/" + kFileName;
+  WriteBinaryFileAsync(file_name, Bytes("data"), kSyncReplace,
+                       new RecordingWriteCallback(&results));
+  ReadBinaryFileAsync(file_name, new RecordingReadCallback(&contents));
+  AsyncFileIO::instance()->Flush();
+
+  ASSERT_EQ(1u, results.size());
+  EXPECT_FALSE(results[0]);
+  ASSERT_EQ(1u, contents.size());
+  EXPECT_EQ("<failed>", contents[0]);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
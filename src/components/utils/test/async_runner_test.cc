@@ -34,6 +34,7 @@
 #include <ctime>
 #include "lock.h"
 #include "threads/async_runner.h"
+#include "threads/thread_pool.h"
 #include "utils/conditional_variable.h"
 
 #include "gtest/gtest.h"
@@ -134,6 +135,115 @@ TEST_F(AsyncRunnerTest, RunManyDelegatesAndStop_ExpectSuccessfulDelegatesStop) {
   EXPECT_EQ(kDelegatesNum_ / 2, check_value);
 }
 
+namespace {
+// State shared by blocking delegates of one test
+struct BlockingState {
+  BlockingState() : started(0), finished(0), exited(0), released(false) {}
+  Lock lock;
+  ConditionalVariable changed;
+  uint32_t started;
+  uint32_t finished;
+  uint32_t exited;
+  bool released;
+
+  // Waits until |count| delegates are started, false on timeout
+  bool WaitStarted(uint32_t count) {
+    AutoLock auto_lock(lock);
+    while (started < count) {
+      if (ConditionalVariable::kTimeout == changed.WaitFor(auto_lock, 2000)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Release() {
+    AutoLock auto_lock(lock);
+    released = true;
+    changed.Broadcast();
+  }
+};
+
+// Blocks until released by test or stopped by runner
+class BlockingDelegate : public ThreadDelegate {
+ public:
+  explicit BlockingDelegate(BlockingState* state)
+      : state_(*state) {}
+
+  void threadMain() {
+    AutoLock auto_lock(state_.lock);
+    ++state_.started;
+    state_.changed.Broadcast();
+    while (!state_.released) {
+      state_.changed.Wait(auto_lock);
+    }
+    ++state_.finished;
+  }
+
+  void exitThreadMain() {
+    AutoLock auto_lock(state_.lock);
+    ++state_.exited;
+    state_.released = true;
+    state_.changed.Broadcast();
+  }
+
+ private:
+  BlockingState& state_;
+};
+}  // namespace
+
+TEST(AsyncRunnerPoolTest, BlockingDelegates_ExpectRunConcurrently) {
+  const uint32_t kMaxRunning = 3;
+  ThreadPool pool("AsyncRunnerTest", kMaxRunning + 1);
+  AsyncRunner runner("test", &pool, kMaxRunning);
+  BlockingState state;
+  for (uint32_t i = 0; i < kMaxRunning; ++i) {
+    runner.AsyncRun(new BlockingDelegate(&state));
+  }
+  // Every delegate waits for release, so all of them started concurrently
+  EXPECT_TRUE(state.WaitStarted(kMaxRunning));
+  state.Release();
+  runner.Stop();
+  EXPECT_EQ(kMaxRunning, state.finished);
+}
+
+TEST(AsyncRunnerPoolTest, CancelQueuedDelegate_ExpectDelegateNotRun) {
+  ThreadPool pool("AsyncRunnerTest", 2);
+  AsyncRunner runner("test", &pool, 1);
+  BlockingState state;
+  ThreadDelegate* running = new BlockingDelegate(&state);
+  ThreadDelegate* queued = new BlockingDelegate(&state);
+  runner.AsyncRun(running);
+  ASSERT_TRUE(state.WaitStarted(1));
+  runner.AsyncRun(queued);
+
+  EXPECT_FALSE(runner.Cancel(running));
+  EXPECT_TRUE(runner.Cancel(queued));
+  state.Release();
+  runner.Stop();
+  EXPECT_EQ(1u, state.started);
+  EXPECT_EQ(1u, state.finished);
+}
+
+TEST(AsyncRunnerPoolTest, StopWithRunningDelegate_ExpectDelegateExited) {
+  ThreadPool pool("AsyncRunnerTest", 2);
+  AsyncRunner runner("test", &pool, 1);
+  BlockingState state;
+  runner.AsyncRun(new BlockingDelegate(&state));
+  runner.AsyncRun(new BlockingDelegate(&state));
+  ASSERT_TRUE(state.WaitStarted(1));
+
+  // Running delegate is released by exitThreadMain, queued one is dropped
+  runner.Stop();
+  EXPECT_EQ(1u, state.exited);
+  EXPECT_EQ(1u, state.started);
+  EXPECT_EQ(1u, state.finished);
+
+  // Delegates passed after stop are deleted without run
+  runner.AsyncRun(new BlockingDelegate(&state));
+  EXPECT_EQ(1u, state.started);
+}
+
 }  // namespace utils
 }  // namespace components
 }  // namespace test
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/logger.h"
+#include "utils/binary_log.h"
+#include "utils/binary_log_reader.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using namespace ::logger;
+
+namespace {
+
+const char* kBinaryLogFile = "binary_log_test.blog";
+
+CREATE_LOGGERPTR_LOCAL(binary_logger_, "BinaryLogTest")
+
+const LogSite kSite = {"binary_log_test.cc", "void TestFunction(int)", 42};
+
+// Other threads of test binary may log meanwhile,
+// only events of given logger and dropped notifications are returned
+std::vector<BinaryLogEvent> ReadEvents(
+    const std::string& logger_name = "BinaryLogTest") {
+  std::vector<BinaryLogEvent> events;
+  BinaryLogReader reader;
+  EXPECT_TRUE(reader.Open(kBinaryLogFile));
+  BinaryLogEvent event;
+  while (reader.Next(&event)) {
+    if (event.dropped || logger_name == event.logger) {
+      events.push_back(event);
+    }
+  }
+  EXPECT_TRUE(reader.error().empty()) << reader.error();
+  return events;
+}
+
+void* LogFromThread(void*) {
+  BinaryRecord record(&kSite, binary_logger_, log4cxx::Level::getWarn());
+  record << "from thread";
+  record.Commit();
+  return NULL;
+}
+
+}  // namespace
+
+class BinaryLogTest : public ::testing::Test {
+ protected:
+  void SetUp() {
+    remove(kBinaryLogFile);
+    ASSERT_TRUE(StartBinaryLog(kBinaryLogFile));
+  }
+
+  void TearDown() {
+    StopBinaryLog();
+    remove(kBinaryLogFile);
+  }
+};
+
+TEST_F(BinaryLogTest, Record_ArgumentsRestored) {
+  BinaryRecord record(&kSite, binary_logger_, log4cxx::Level::getInfo());
+  record << "value " << 42 << ' ' << -7L << ' ' << 1.5 << ' '
+         << std::string("str") << ' ' << true << ' '
+         << static_cast<uint8_t>('u');
+  record.Commit();
+  StopBinaryLog();
+
+  const std::vector<BinaryLogEvent> events = ReadEvents();
+  ASSERT_EQ(1u, events.size());
+  const BinaryLogEvent& event = events.front();
+  EXPECT_EQ("value 42 -7 1.5 str 1 u", event.message);
+  EXPECT_EQ(kSite.file, event.file);
+  EXPECT_EQ(kSite.function, event.function);
+  EXPECT_EQ(42u, event.line);
+  EXPECT_EQ("BinaryLogTest", event.logger);
+  EXPECT_EQ(log4cxx::Level::getInfo()->toInt(), event.level);
+  EXPECT_FALSE(event.thread.empty());
+  EXPECT_FALSE(event.truncated);
+}
+
+TEST_F(BinaryLogTest, Record_ManipulatorsAppliedToRestOfStatement) {
+  BinaryRecord record(&kSite, binary_logger_, log4cxx::Level::getDebug());
+  record << 10 << ' ' << std::hex << 255 << ' ' << std::setw(3) << 1;
+  record.Commit();
+  StopBinaryLog();
+
+  const std::vector<BinaryLogEvent> events = ReadEvents();
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ("10 ff   1", events.front().message);
+}
+
+TEST_F(BinaryLogTest, Record_LongTextTruncated) {
+  const std::string text(BinaryRecord::kMaxSize * 2, 'x');
+  BinaryRecord record(&kSite, binary_logger_, log4cxx::Level::getInfo());
+  record << text;
+  record.Commit();
+  StopBinaryLog();
+
+  const std::vector<BinaryLogEvent> events = ReadEvents();
+  ASSERT_EQ(1u, events.size());
+  EXPECT_TRUE(events.front().truncated);
+  EXPECT_LT(events.front().message.size(), text.size());
+  EXPECT_EQ(std::string(events.front().message.size(), 'x'),
+            events.front().message);
+}
+
+TEST_F(BinaryLogTest, Records_OfExitedThreadWritten) {
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &LogFromThread, NULL));
+  ASSERT_EQ(0, pthread_join(thread, NULL));
+  LogFromThread(NULL);
+  StopBinaryLog();
+
+  const std::vector<BinaryLogEvent> events = ReadEvents();
+  ASSERT_EQ(2u, events.size());
+  EXPECT_EQ("from thread", events[0].message);
+  EXPECT_EQ("from thread", events[1].message);
+  EXPECT_NE(events[0].thread, events[1].thread);
+}
+
+TEST_F(BinaryLogTest, Records_DroppedWhenRingOverflows) {
+  const std::string text(1024, 'x');
+  const size_t kCount = 1000;
+  for (size_t i = 0; i < kCount; ++i) {
+    BinaryRecord record(&kSite, binary_logger_, log4cxx::Level::getInfo());
+    record << text;
+    record.Commit();
+  }
+  StopBinaryLog();
+
+  size_t written = 0;
+  size_t dropped = 0;
+  const std::vector<BinaryLogEvent> events = ReadEvents();
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (events[i].dropped) {
+      dropped += events[i].dropped;
+    } else {
+      ++written;
+    }
+  }
+  EXPECT_EQ(kCount, written + dropped);
+}
+
+TEST_F(BinaryLogTest, LogMacro_WritesToBinaryLog) {
+  CREATE_LOGGERPTR_LOCAL(macro_logger, "BinaryLogMacroTest");
+  macro_logger->setLevel(log4cxx::Level::getTrace());
+  LOG4CXX_ERROR(macro_logger, "macro " << 1);
+  StopBinaryLog();
+
+  const std::vector<BinaryLogEvent> events = ReadEvents("BinaryLogMacroTest");
+  ASSERT_EQ(1u, events.size());
+  const BinaryLogEvent& event = events.front();
+  EXPECT_EQ("macro 1", event.message);
+  EXPECT_EQ("BinaryLogMacroTest", event.logger);
+  EXPECT_EQ(__FILE__, event.file);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
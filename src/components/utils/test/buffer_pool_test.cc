@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include "gtest/gtest.h"
+#include "utils/buffer_pool.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::BufferPool;
+using ::utils::BufferSlice;
+
+namespace {
+const size_t kMinBlockSize = 1024;
+const size_t kMaxBlockSize = 8 * 1024;
+const size_t kMaxCachedBytes = 16 * 1024;
+}  // namespace
+
+TEST(BufferPoolTest, Allocate_ExpectRequestedSize) {
+  BufferPool pool(kMinBlockSize, kMaxBlockSize, kMaxCachedBytes);
+  BufferSlice slice = pool.Allocate(100);
+  EXPECT_EQ(100u, slice.size());
+  ASSERT_TRUE(slice.data() != NULL);
+  memset(slice.data(), 0xAB, slice.size());
+  EXPECT_TRUE(pool.Allocate(0).empty());
+}
+
+TEST(BufferPoolTest, Released_ExpectBlockReused) {
+  BufferPool pool(kMinBlockSize, kMaxBlockSize, kMaxCachedBytes);
+  BufferSlice slice = pool.Allocate(kMinBlockSize);
+  const uint8_t* data = slice.data();
+  BufferSlice part = slice.Slice(10, 10);
+  slice = BufferSlice();
+  // Block is still referenced by part
+  EXPECT_EQ(0u, pool.cached_bytes());
+  part = BufferSlice();
+  EXPECT_EQ(kMinBlockSize, pool.cached_bytes());
+
+  // Any size of the same class gets the same block
+  slice = pool.Allocate(kMinBlockSize / 2);
+  EXPECT_EQ(data, slice.data());
+  EXPECT_EQ(0u, pool.cached_bytes());
+}
+
+TEST(BufferPoolTest, SizeRoundedUp_ExpectClassesNotMixed) {
+  BufferPool pool(kMinBlockSize, kMaxBlockSize, kMaxCachedBytes);
+  pool.Allocate(kMinBlockSize + 1);
+  EXPECT_EQ(2 * kMinBlockSize, pool.cached_bytes());
+  // Bigger free block is not taken for smaller size
+  pool.Allocate(kMinBlockSize);
+  EXPECT_EQ(3 * kMinBlockSize, pool.cached_bytes());
+}
+
+TEST(BufferPoolTest, BigSize_ExpectNotCached) {
+  BufferPool pool(kMinBlockSize, kMaxBlockSize, kMaxCachedBytes);
+  EXPECT_EQ(kMaxBlockSize + 1, pool.Allocate(kMaxBlockSize + 1).size());
+  EXPECT_EQ(0u, pool.cached_bytes());
+}
+
+TEST(BufferPoolTest, CacheLimitReached_ExpectBlocksFreed) {
+  BufferPool pool(kMinBlockSize, kMaxBlockSize, kMaxCachedBytes);
+  BufferSlice slices[3];
+  for (size_t i = 0; i < 3; ++i) {
+    slices[i] = pool.Allocate(kMaxBlockSize);
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    slices[i] = BufferSlice();
+  }
+  EXPECT_EQ(kMaxCachedBytes, pool.cached_bytes());
+}
+
+TEST(BufferPoolTest, PoolDestroyed_ExpectSliceValid) {
+  BufferSlice slice;
+  {
+    BufferPool pool(kMinBlockSize, kMaxBlockSize, kMaxCachedBytes);
+    slice = pool.Allocate(kMinBlockSize);
+  }
+  memset(slice.data(), 0, slice.size());
+  EXPECT_EQ(kMinBlockSize, slice.size());
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
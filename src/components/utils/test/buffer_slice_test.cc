@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include "gtest/gtest.h"
+#include "utils/buffer_slice.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::BufferSlice;
+
+TEST(BufferSliceTest, Empty) {
+  const BufferSlice slice;
+  EXPECT_TRUE(slice.empty());
+  EXPECT_EQ(0u, slice.size());
+  EXPECT_EQ(NULL, slice.data());
+  EXPECT_TRUE(slice.Slice(0, 10).empty());
+}
+
+TEST(BufferSliceTest, Allocate) {
+  BufferSlice slice(100);
+  EXPECT_FALSE(slice.empty());
+  EXPECT_EQ(100u, slice.size());
+  ASSERT_TRUE(slice.data() != NULL);
+  memset(slice.data(), 0xAB, slice.size());
+}
+
+TEST(BufferSliceTest, CopyData) {
+  const uint8_t data[] = {1, 2, 3, 4, 5};
+  const BufferSlice slice(data, sizeof(data));
+  EXPECT_EQ(sizeof(data), slice.size());
+  EXPECT_NE(data, slice.data());
+  EXPECT_EQ(0, memcmp(data, slice.data(), sizeof(data)));
+
+  EXPECT_TRUE(BufferSlice(NULL, 10).empty());
+  EXPECT_TRUE(BufferSlice(data, 0).empty());
+}
+
+TEST(BufferSliceTest, Slice_SharesStorage) {
+  const uint8_t data[] = {1, 2, 3, 4, 5};
+  const BufferSlice slice(data, sizeof(data));
+  const BufferSlice middle = slice.Slice(1, 3);
+  EXPECT_EQ(3u, middle.size());
+  EXPECT_EQ(slice.data() + 1, middle.data());
+  const BufferSlice inner = middle.Slice(1, 1);
+  EXPECT_EQ(1u, inner.size());
+  EXPECT_EQ(3, inner.data()[0]);
+}
+
+TEST(BufferSliceTest, Slice_Clamped) {
+  const BufferSlice slice(10);
+  EXPECT_EQ(4u, slice.Slice(6, 100).size());
+  EXPECT_TRUE(slice.Slice(10, 1).empty());
+  EXPECT_TRUE(slice.Slice(0, 0).empty());
+}
+
+TEST(BufferSliceTest, Slice_KeepsStorageAlive) {
+  BufferSlice tail;
+  {
+    const uint8_t data[] = {1, 2, 3, 4, 5};
+    const BufferSlice slice(data, sizeof(data));
+    tail = slice.Slice(3, 2);
+  }
+  ASSERT_EQ(2u, tail.size());
+  EXPECT_EQ(4, tail.data()[0]);
+  EXPECT_EQ(5, tail.data()[1]);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include "utils/case_insensitive_string_set.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::CaseInsensitiveStringSet;
+
+TEST(CaseInsensitiveStringSetTest, InsertIgnoresCase) {
+  CaseInsensitiveStringSet strings;
+  EXPECT_TRUE(strings.Insert("Play Music"));
+  EXPECT_FALSE(strings.Insert("play music"));
+  EXPECT_FALSE(strings.Insert("PLAY MUSIC"));
+  EXPECT_TRUE(strings.Insert("Play Musi"));
+  EXPECT_EQ(2u, strings.size());
+}
+
+TEST(CaseInsensitiveStringSetTest, ContainsIgnoresCase) {
+  CaseInsensitiveStringSet strings;
+  EXPECT_FALSE(strings.Contains("Radio"));
+  strings.Insert("RaDiO");
+  EXPECT_TRUE(strings.Contains("radio"));
+  EXPECT_FALSE(strings.Contains("radio 1"));
+  strings.clear();
+  EXPECT_TRUE(strings.empty());
+  EXPECT_FALSE(strings.Contains("radio"));
+}
+
+TEST(CaseInsensitiveStringSetTest, NonAsciiComparedAsStrcasecmp) {
+  CaseInsensitiveStringSet strings;
+  // Only ASCII letters are folded, like strcasecmp in C locale does
+  EXPECT_TRUE(strings.Insert("\xC3\x84pfel"));
+  EXPECT_FALSE(strings.Insert("\xC3\x84PFEL"));
+  EXPECT_TRUE(strings.Insert("\xC3\xA4pfel"));
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
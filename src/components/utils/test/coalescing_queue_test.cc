@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <queue>
+#include <string>
+#include "gtest/gtest.h"
+#include "utils/coalescing_queue.h"
+#include "utils/shared_ptr.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::CoalescingQueue;
+
+namespace {
+struct TestMessage : public ::utils::SharedPtr<int> {
+  TestMessage(int value, const std::string& group, const std::string& key)
+      : ::utils::SharedPtr<int>(new int(value)),
+        group(group),
+        key(key) {
+  }
+  const std::string& CoalescingGroup() const {
+    return group;
+  }
+  const std::string& CoalescingKey() const {
+    return key;
+  }
+  std::string group;
+  std::string key;
+};
+
+typedef CoalescingQueue<std::queue<TestMessage> > TestQueue;
+
+int PopValue(TestQueue* queue) {
+  const int value = *queue->front();
+  queue->pop();
+  return value;
+}
+}  // namespace
+
+TEST(CoalescingQueueTest, Push_MessagesWithoutGroupAreKept) {
+  TestQueue queue;
+  queue.push(TestMessage(1, "", ""));
+  queue.push(TestMessage(2, "", ""));
+  ASSERT_EQ(2u, queue.size());
+  EXPECT_EQ(1, PopValue(&queue));
+  EXPECT_EQ(2, PopValue(&queue));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(CoalescingQueueTest, Push_LatestPendingMessageIsSuperseded) {
+  TestQueue queue;
+  queue.push(TestMessage(1, "app", "speed"));
+  queue.push(TestMessage(2, "", ""));
+  queue.push(TestMessage(3, "app", "speed"));
+  ASSERT_EQ(2u, queue.size());
+  EXPECT_EQ(3, PopValue(&queue));
+  EXPECT_EQ(2, PopValue(&queue));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(CoalescingQueueTest, Push_OrderWithinGroupIsKept) {
+  TestQueue queue;
+  queue.push(TestMessage(1, "app", "speed"));
+  queue.push(TestMessage(2, "app", "rpm"));
+  queue.push(TestMessage(3, "app", "speed"));
+  queue.push(TestMessage(4, "other app", "speed"));
+  ASSERT_EQ(4u, queue.size());
+  EXPECT_EQ(1, PopValue(&queue));
+  EXPECT_EQ(2, PopValue(&queue));
+  EXPECT_EQ(3, PopValue(&queue));
+  EXPECT_EQ(4, PopValue(&queue));
+}
+
+TEST(CoalescingQueueTest, Pop_HandedOutMessageIsNotSuperseded) {
+  TestQueue queue;
+  queue.push(TestMessage(1, "app", "speed"));
+  const TestMessage handed_out = queue.front();
+  queue.pop();
+  queue.push(TestMessage(2, "app", "speed"));
+  EXPECT_EQ(1, *handed_out);
+  ASSERT_EQ(1u, queue.size());
+  EXPECT_EQ(2, PopValue(&queue));
+}
+
+TEST(CoalescingQueueTest, Swap) {
+  TestQueue queue;
+  queue.push(TestMessage(1, "app", "speed"));
+  TestQueue other;
+  queue.swap(other);
+  EXPECT_TRUE(queue.empty());
+  other.push(TestMessage(2, "app", "speed"));
+  ASSERT_EQ(1u, other.size());
+  EXPECT_EQ(2, PopValue(&other));
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
@@ -30,6 +30,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <unistd.h>
+
 #include "gtest/gtest.h"
 #include "utils/date_time.h"
 
@@ -56,6 +58,32 @@ TEST(DateTimeTest, GetCurrentTime) {
   ASSERT_GE(time2.tv_sec, time1.tv_sec);
 }
 
+TEST(DateTimeTest, GetMonotonicTime_NeverGoesBack) {
+  TimevalStruct previous = DateTime::getMonotonicTime();
+  for (int i = 0; i < 1000; ++i) {
+    const TimevalStruct current = DateTime::getMonotonicTime();
+    ASSERT_FALSE(DateTime::Less(current, previous));
+    ASSERT_GE(current.tv_usec, 0);
+    ASSERT_LT(current.tv_usec, 1000000);
+    previous = current;
+  }
+}
+
+TEST(DateTimeTest, GetPreciseMonotonicTime_MeasuresSleep) {
+  const TimevalStruct start = DateTime::getPreciseMonotonicTime();
+  usleep(20000);
+  const TimevalStruct end = DateTime::getPreciseMonotonicTime();
+  ASSERT_TRUE(DateTime::Greater(end, start));
+  EXPECT_GE(DateTime::getuSecs(DateTime::Sub(end, start)), 20000);
+}
+
+TEST(DateTimeTest, MonotonicTimes_ShareTimeLine) {
+  const TimevalStruct precise = DateTime::getPreciseMonotonicTime();
+  const TimevalStruct coarse = DateTime::getMonotonicTime();
+  // Coarse time lags behind by less than a scheduler tick
+  EXPECT_LT(DateTime::calculateTimeDiff(precise, coarse), 1000);
+}
+
 TEST(DateTimeTest, GetSecs) {
   //arrange
   TimevalStruct time;
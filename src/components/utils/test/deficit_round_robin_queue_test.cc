@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "utils/deficit_round_robin_queue.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::DeficitRoundRobinQueue;
+using ::utils::MessageFlowWeights;
+
+namespace {
+struct TestMessage {
+  TestMessage()
+      : urgent(false),
+        flow(0),
+        cost(0),
+        id(0) {
+  }
+  TestMessage(bool is_urgent, uint64_t flow_id, size_t message_cost,
+              int message_id)
+      : urgent(is_urgent),
+        flow(flow_id),
+        cost(message_cost),
+        id(message_id) {
+  }
+  bool IsUrgent() const {
+    return urgent;
+  }
+  uint64_t FlowId() const {
+    return flow;
+  }
+  size_t Cost() const {
+    return cost;
+  }
+  bool urgent;
+  uint64_t flow;
+  size_t cost;
+  int id;
+};
+
+struct WeightedMessage : public TestMessage {
+  WeightedMessage()
+      : weight(0) {
+  }
+  WeightedMessage(uint64_t flow_id, uint32_t flow_weight, size_t message_cost,
+                  int message_id)
+      : TestMessage(false, flow_id, message_cost, message_id),
+        weight(flow_weight) {
+  }
+  uint32_t Weight() const {
+    return weight;
+  }
+  uint32_t weight;
+};
+
+template <class Queue>
+std::vector<int> PopAllIds(Queue& queue) {
+  std::vector<int> ids;
+  while (!queue.empty()) {
+    ids.push_back(queue.front().id);
+    queue.pop();
+  }
+  return ids;
+}
+}  // namespace
+
+TEST(DeficitRoundRobinQueueTest, DefaultCtor_ExpectEmptyQueue) {
+  DeficitRoundRobinQueue<TestMessage> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0u, queue.size());
+}
+
+TEST(DeficitRoundRobinQueueTest, Push_ExpectUrgentFirstFifoInsideFlow) {
+  DeficitRoundRobinQueue<TestMessage> queue(100);
+  queue.push(TestMessage(false, 1, 10, 1));
+  queue.push(TestMessage(false, 1, 10, 2));
+  queue.push(TestMessage(true, 2, 1000, 3));
+  queue.push(TestMessage(true, 1, 1000, 4));
+  EXPECT_EQ(4u, queue.size());
+
+  std::vector<int> ids = PopAllIds(queue);
+  ASSERT_EQ(4u, ids.size());
+  EXPECT_EQ(3, ids[0]);
+  EXPECT_EQ(4, ids[1]);
+  EXPECT_EQ(1, ids[2]);
+  EXPECT_EQ(2, ids[3]);
+}
+
+TEST(DeficitRoundRobinQueueTest, BigMessages_ExpectSmallFlowNotDelayed) {
+  DeficitRoundRobinQueue<TestMessage> queue(100);
+  // Burst of big messages queued ahead of small ones
+  for (int i = 0; i < 3; ++i) {
+    queue.push(TestMessage(false, 1, 300, 10 + i));
+  }
+  for (int i = 0; i < 3; ++i) {
+    queue.push(TestMessage(false, 2, 100, 20 + i));
+  }
+
+  // Flow 2 gets its quantum while flow 1 accumulates credit for 3 rounds
+  std::vector<int> ids = PopAllIds(queue);
+  ASSERT_EQ(6u, ids.size());
+  EXPECT_EQ(20, ids[0]);
+  EXPECT_EQ(21, ids[1]);
+  EXPECT_EQ(10, ids[2]);
+  EXPECT_EQ(22, ids[3]);
+  EXPECT_EQ(11, ids[4]);
+  EXPECT_EQ(12, ids[5]);
+}
+
+TEST(DeficitRoundRobinQueueTest, EqualMessages_ExpectFlowsInterleaved) {
+  DeficitRoundRobinQueue<TestMessage> queue(100);
+  for (int i = 0; i < 2; ++i) {
+    queue.push(TestMessage(false, 1, 100, 10 + i));
+  }
+  for (int i = 0; i < 2; ++i) {
+    queue.push(TestMessage(false, 2, 100, 20 + i));
+  }
+  std::vector<int> ids = PopAllIds(queue);
+  ASSERT_EQ(4u, ids.size());
+  EXPECT_EQ(10, ids[0]);
+  EXPECT_EQ(20, ids[1]);
+  EXPECT_EQ(11, ids[2]);
+  EXPECT_EQ(21, ids[3]);
+}
+
+TEST(DeficitRoundRobinQueueTest, WeightedFlows_ExpectShareByWeight) {
+  DeficitRoundRobinQueue<WeightedMessage, MessageFlowWeights> queue(100);
+  for (int i = 0; i < 4; ++i) {
+    queue.push(WeightedMessage(1, 3, 100, 10 + i));
+  }
+  for (int i = 0; i < 4; ++i) {
+    queue.push(WeightedMessage(2, 0, 100, 20 + i));
+  }
+
+  // Flow 1 gives out three messages per turn, zero weight counts as one
+  std::vector<int> ids = PopAllIds(queue);
+  ASSERT_EQ(8u, ids.size());
+  EXPECT_EQ(10, ids[0]);
+  EXPECT_EQ(11, ids[1]);
+  EXPECT_EQ(12, ids[2]);
+  EXPECT_EQ(20, ids[3]);
+  EXPECT_EQ(13, ids[4]);
+  EXPECT_EQ(21, ids[5]);
+  EXPECT_EQ(22, ids[6]);
+  EXPECT_EQ(23, ids[7]);
+}
+
+TEST(DeficitRoundRobinQueueTest, Front_ExpectSameMessageUntilPop) {
+  DeficitRoundRobinQueue<TestMessage> queue(10);
+  queue.push(TestMessage(false, 1, 35, 1));
+  queue.push(TestMessage(false, 2, 5, 2));
+  EXPECT_EQ(2, queue.front().id);
+  EXPECT_EQ(2, queue.front().id);
+  queue.pop();
+  EXPECT_EQ(1, queue.front().id);
+  EXPECT_EQ(1, queue.front().id);
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(DeficitRoundRobinQueueTest, Swap_ExpectContentExchanged) {
+  DeficitRoundRobinQueue<TestMessage> queue;
+  DeficitRoundRobinQueue<TestMessage> other;
+  queue.push(TestMessage(false, 1, 10, 1));
+  queue.push(TestMessage(true, 1, 10, 2));
+  other.push(TestMessage(false, 3, 10, 3));
+
+  queue.swap(other);
+  EXPECT_EQ(1u, queue.size());
+  EXPECT_EQ(3, queue.front().id);
+  EXPECT_EQ(2u, other.size());
+  EXPECT_EQ(2, other.front().id);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
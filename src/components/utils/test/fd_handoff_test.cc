@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "utils/fd_handoff.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::FdHandoff;
+
+namespace {
+std::string HandoffPath() {
+  char path[64];
+  snprintf(path, sizeof(path), "/tmp/sdl_fd_handoff_test_%d",
+           static_cast<int>(getpid()));
+  return path;
+}
+
+bool IsPipe(int write_fd, int read_fd) {
+  const char sent = 'x';
+  char received = 0;
+  return 1 == write(write_fd, &sent, 1) && 1 == read(read_fd, &received, 1) &&
+         sent == received;
+}
+
+struct Successor {
+  FdHandoff handoff;
+  bool taken_over;
+};
+
+void* TakeOver(void* data) {
+  Successor* successor = static_cast<Successor*>(data);
+  successor->taken_over = successor->handoff.TakeOver(HandoffPath(), 5000);
+  return NULL;
+}
+}  // namespace
+
+TEST(FdHandoffTest, SendDescriptors_ReceivedDescriptorsShareFile) {
+  int channel[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, channel));
+  int pipe_fds[2];
+  ASSERT_EQ(0, pipe(pipe_fds));
+
+  FdHandoff::Descriptors sent;
+  sent["pipe"] = pipe_fds[1];
+  ASSERT_TRUE(FdHandoff::SendDescriptors(channel[0], sent));
+  FdHandoff::Descriptors received;
+  ASSERT_TRUE(FdHandoff::ReceiveDescriptors(channel[1], &received));
+  ASSERT_EQ(1u, received.size());
+  ASSERT_EQ(1u, received.count("pipe"));
+  EXPECT_NE(pipe_fds[1], received["pipe"]);
+  EXPECT_TRUE(IsPipe(received["pipe"], pipe_fds[0]));
+
+  close(received["pipe"]);
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+  close(channel[0]);
+  close(channel[1]);
+}
+
+TEST(FdHandoffTest, ReceiveDescriptors_ClosedChannel_Fail) {
+  int channel[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, channel));
+  close(channel[0]);
+  FdHandoff::Descriptors received;
+  EXPECT_FALSE(FdHandoff::ReceiveDescriptors(channel[1], &received));
+  EXPECT_TRUE(received.empty());
+  close(channel[1]);
+}
+
+TEST(FdHandoffTest, TakeOver_NoPredecessor_ColdStart) {
+  FdHandoff handoff;
+  EXPECT_FALSE(handoff.TakeOver(HandoffPath(), 100));
+  EXPECT_FALSE(handoff.TakeOver("", 100));
+  EXPECT_EQ(-1, handoff.TakeInherited("pipe"));
+}
+
+TEST(FdHandoffTest, TakeOver_PredecessorServing_DescriptorsInherited) {
+  // Predecessor stops itself by SIGTERM when descriptors are handed over
+  void (*previous_handler)(int) = signal(SIGTERM, SIG_IGN);
+  int pipe_fds[2];
+  ASSERT_EQ(0, pipe(pipe_fds));
+
+  FdHandoff predecessor;
+  predecessor.Publish("pipe", pipe_fds[1]);
+  predecessor.Publish("withdrawn", pipe_fds[0]);
+  predecessor.Withdraw("withdrawn");
+  ASSERT_TRUE(predecessor.StartServing(HandoffPath()));
+
+  Successor successor;
+  successor.taken_over = false;
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &TakeOver, &successor));
+  for (int i = 0; i < 500 && !predecessor.handed_over(); ++i) {
+    usleep(10000);
+  }
+  EXPECT_TRUE(predecessor.handed_over());
+  predecessor.Complete();
+  ASSERT_EQ(0, pthread_join(thread, NULL));
+  signal(SIGTERM, previous_handler);
+
+  ASSERT_TRUE(successor.taken_over);
+  EXPECT_EQ(-1, successor.handoff.TakeInherited("withdrawn"));
+  const int inherited = successor.handoff.TakeInherited("pipe");
+  ASSERT_NE(-1, inherited);
+  EXPECT_EQ(-1, successor.handoff.TakeInherited("pipe"));
+  EXPECT_TRUE(IsPipe(inherited, pipe_fds[0]));
+  EXPECT_NE(0, access(HandoffPath().c_str(), F_OK));
+
+  close(inherited);
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
@@ -1170,6 +1170,33 @@ TEST(FileSystemTest, DeleteAllContentInDirectory) {
   EXPECT_FALSE(DirectoryExists("./Test directory"));
 }
 
+TEST(FileSystemTest, MappedFile) {
+  ASSERT_FALSE(FileExists("./test file"));
+  {
+    MappedFile absent("./test file");
+    EXPECT_FALSE(absent.IsMapped());
+  }
+
+  EXPECT_TRUE(CreateFile("./test file"));
+  {
+    MappedFile empty("./test file");
+    EXPECT_FALSE(empty.IsMapped());
+    EXPECT_EQ(0u, empty.size());
+  }
+
+  const std::string text = "{ \"policy_table\": {} }";
+  std::vector<uint8_t> data(text.begin(), text.end());
+  EXPECT_TRUE(WriteBinaryFile("./test file", data));
+  {
+    MappedFile file("./test file");
+    ASSERT_TRUE(file.IsMapped());
+    EXPECT_EQ(text.size(), file.size());
+    EXPECT_EQ(text, std::string(file.begin(), file.end()));
+  }
+
+  EXPECT_TRUE(DeleteFile("./test file"));
+}
+
 }  // namespace utils
 }  // namespace components
 }  // namespace test
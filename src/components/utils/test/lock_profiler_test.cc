@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <unistd.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "utils/lock.h"
+#include "utils/rwlock.h"
+#include "utils/lock_profiler.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::sync_primitives::Lock;
+using ::sync_primitives::AutoLock;
+using ::sync_primitives::RWLock;
+using ::sync_primitives::LockStatistics;
+using ::sync_primitives::LockProfiler;
+
+namespace {
+LockStatistics FindStatistics(const std::string& name) {
+  std::vector<LockStatistics> statistics;
+  LockProfiler::instance()->Snapshot(&statistics);
+  for (size_t i = 0; i < statistics.size(); ++i) {
+    if (name == statistics[i].name) {
+      return statistics[i];
+    }
+  }
+  return LockStatistics();
+}
+
+#ifdef LOCK_PROFILING
+void* AcquireLock(void* context) {
+  Lock* lock = static_cast<Lock*>(context);
+  AutoLock auto_lock(*lock);
+  return NULL;
+}
+#endif  // LOCK_PROFILING
+}  // namespace
+
+TEST(LockProfilerTest, RegisterSameName_ExpectSameStatistics) {
+  LockStatistics* first = LockProfiler::instance()->Register("shared_name");
+  LockStatistics* second = LockProfiler::instance()->Register("shared_name");
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, LockProfiler::instance()->Register("other_name"));
+}
+
+TEST(LockProfilerTest, OnAcquiredOnReleased_ExpectTotalsAndMaximums) {
+  LockStatistics statistics("statistics");
+  statistics.OnAcquired(false, 0);
+  statistics.OnAcquired(true, 10);
+  statistics.OnAcquired(true, 30);
+  statistics.OnReleased(5);
+  statistics.OnReleased(7);
+  EXPECT_EQ(3u, statistics.acquisitions);
+  EXPECT_EQ(2u, statistics.contentions);
+  EXPECT_EQ(40u, statistics.total_wait_time);
+  EXPECT_EQ(30u, statistics.max_wait_time);
+  EXPECT_EQ(12u, statistics.total_hold_time);
+  EXPECT_EQ(7u, statistics.max_hold_time);
+}
+
+#ifdef LOCK_PROFILING
+TEST(LockProfilerTest, NamedLockContended_ExpectContentionAccounted) {
+  Lock lock;
+  lock.set_name("contended_lock");
+  pthread_t thread;
+  {
+    AutoLock auto_lock(lock);
+    ASSERT_EQ(0, pthread_create(&thread, NULL, &AcquireLock, &lock));
+    usleep(50000);
+  }
+  ASSERT_EQ(0, pthread_join(thread, NULL));
+  const LockStatistics statistics = FindStatistics("contended_lock");
+  EXPECT_EQ(2u, statistics.acquisitions);
+  EXPECT_EQ(1u, statistics.contentions);
+  EXPECT_LT(0u, statistics.total_wait_time);
+  EXPECT_LE(statistics.max_hold_time, statistics.total_hold_time);
+}
+
+TEST(LockProfilerTest, NamedRWLock_ExpectReadersAndWritersAccounted) {
+  RWLock rwlock;
+  rwlock.set_name("named_rwlock");
+  ASSERT_TRUE(rwlock.AcquireForReading());
+  ASSERT_TRUE(rwlock.AcquireForReading());
+  rwlock.Release();
+  rwlock.Release();
+  ASSERT_TRUE(rwlock.AcquireForWriting());
+  rwlock.Release();
+  const LockStatistics statistics = FindStatistics("named_rwlock");
+  EXPECT_EQ(3u, statistics.acquisitions);
+  EXPECT_EQ(0u, statistics.contentions);
+}
+#else
+TEST(LockProfilerTest, NamedLockWithoutProfiling_ExpectNotRegistered) {
+  Lock lock;
+  lock.set_name("not_profiled_lock");
+  {
+    AutoLock auto_lock(lock);
+  }
+  EXPECT_TRUE(FindStatistics("not_profiled_lock").name.empty());
+}
+#endif  // LOCK_PROFILING
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
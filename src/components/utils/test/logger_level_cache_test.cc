@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include "utils/logger.h"
+#include "utils/logger_level_cache.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using namespace ::logger;
+
+namespace {
+CREATE_LOGGERPTR_LOCAL(first_logger_, "LevelCacheFirst")
+CREATE_LOGGERPTR_LOCAL(second_logger_, "LevelCacheSecond")
+}  // namespace
+
+TEST(LevelCacheTest, ZeroInitialized_NotValid) {
+  static LevelCache cache;
+  EXPECT_FALSE(cache.IsValidFor(&*first_logger_));
+}
+
+TEST(LevelCacheTest, Update_RemembersResultForLogger) {
+  static LevelCache cache;
+  const bool enabled =
+      cache.Update(first_logger_, log4cxx::Level::getFatal());
+
+  EXPECT_EQ(first_logger_->isEnabledFor(log4cxx::Level::getFatal()), enabled);
+  EXPECT_TRUE(cache.IsValidFor(&*first_logger_));
+  EXPECT_EQ(enabled, cache.enabled());
+  EXPECT_FALSE(cache.IsValidFor(&*second_logger_));
+}
+
+TEST(LevelCacheTest, LevelsChanged_CacheInvalidated) {
+  static LevelCache cache;
+  cache.Update(first_logger_, log4cxx::Level::getFatal());
+  ASSERT_TRUE(cache.IsValidFor(&*first_logger_));
+
+  LevelsChanged();
+
+  EXPECT_FALSE(cache.IsValidFor(&*first_logger_));
+}
+
+TEST(LevelCacheTest, CachedIsEnabled_LevelEvaluatedOnlyOnRefresh) {
+  static LevelCache cache;
+  int evaluated = 0;
+  for (int i = 0; i < 3; ++i) {
+    LOG4CXX_CACHED_IS_ENABLED(
+        cache, first_logger_, (++evaluated, log4cxx::Level::getFatal()));
+  }
+  EXPECT_EQ(1, evaluated);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
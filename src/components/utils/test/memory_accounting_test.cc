@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include "utils/memory_accounting.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::MemoryAccounting;
+
+TEST(MemoryAccountingTest, ChargeRelease_ExpectAppAndTotalUsage) {
+  MemoryAccounting accounting;
+  accounting.Charge(1, MemoryAccounting::kAppState, 100);
+  accounting.Charge(1, MemoryAccounting::kMultiFrame, 50);
+  accounting.Charge(2, MemoryAccounting::kMultiFrame, 10);
+
+  EXPECT_EQ(150u, accounting.AppUsage(1).Total());
+  EXPECT_EQ(100u, accounting.AppUsage(1).bytes[MemoryAccounting::kAppState]);
+  EXPECT_EQ(10u, accounting.AppUsage(2).Total());
+  EXPECT_EQ(60u,
+            accounting.TotalUsage().bytes[MemoryAccounting::kMultiFrame]);
+  EXPECT_EQ(160u, accounting.TotalUsage().Total());
+
+  accounting.Release(1, MemoryAccounting::kMultiFrame, 50);
+  EXPECT_EQ(100u, accounting.AppUsage(1).Total());
+  EXPECT_EQ(110u, accounting.TotalUsage().Total());
+}
+
+TEST(MemoryAccountingTest, TryCharge_OverQuota_ExpectRefused) {
+  MemoryAccounting accounting;
+  accounting.set_app_quota(100);
+  EXPECT_TRUE(accounting.TryCharge(1, MemoryAccounting::kAppState, 60));
+  EXPECT_TRUE(accounting.HasRoom(1, 40));
+  EXPECT_FALSE(accounting.HasRoom(1, 41));
+  EXPECT_FALSE(accounting.TryCharge(1, MemoryAccounting::kMultiFrame, 41));
+  EXPECT_EQ(60u, accounting.AppUsage(1).Total());
+
+  // Quota is per application
+  EXPECT_TRUE(accounting.TryCharge(2, MemoryAccounting::kMultiFrame, 100));
+  EXPECT_FALSE(accounting.TryCharge(3, MemoryAccounting::kMultiFrame, 101));
+
+  // Forced charge is seen in usage even above quota
+  accounting.Charge(1, MemoryAccounting::kQueuedMessages, 100);
+  EXPECT_EQ(160u, accounting.AppUsage(1).Total());
+  EXPECT_FALSE(accounting.HasRoom(1, 0));
+
+  accounting.set_app_quota(0);
+  EXPECT_TRUE(accounting.TryCharge(1, MemoryAccounting::kAppState, 1000));
+}
+
+TEST(MemoryAccountingTest, Release_MoreThanCharged_ExpectNoUnderflow) {
+  MemoryAccounting accounting;
+  accounting.Charge(1, MemoryAccounting::kAppState, 10);
+  accounting.Charge(2, MemoryAccounting::kAppState, 10);
+  accounting.Release(1, MemoryAccounting::kAppState, 30);
+  accounting.Release(3, MemoryAccounting::kAppState, 30);
+
+  EXPECT_EQ(0u, accounting.AppUsage(1).Total());
+  EXPECT_EQ(10u, accounting.TotalUsage().Total());
+}
+
+TEST(MemoryAccountingTest, TakeSnapshot_ExpectOnlyAppsHoldingMemory) {
+  MemoryAccounting accounting;
+  accounting.set_app_quota(10);
+  accounting.Charge(1, MemoryAccounting::kAppState, 5);
+  accounting.Charge(2, MemoryAccounting::kMultiFrame, 5);
+  accounting.Release(2, MemoryAccounting::kMultiFrame, 5);
+  EXPECT_FALSE(accounting.TryCharge(3, MemoryAccounting::kMultiFrame, 20));
+
+  MemoryAccounting::Snapshot snapshot;
+  accounting.TakeSnapshot(&snapshot);
+  ASSERT_EQ(1u, snapshot.size());
+  EXPECT_EQ(1u, snapshot[0].first);
+  EXPECT_EQ(5u, snapshot[0].second.Total());
+}
+
+TEST(MemoryAccountingTest, CategoryName_ExpectNames) {
+  EXPECT_STREQ("app_state",
+               MemoryAccounting::CategoryName(MemoryAccounting::kAppState));
+  EXPECT_STREQ("multi_frame",
+               MemoryAccounting::CategoryName(MemoryAccounting::kMultiFrame));
+  EXPECT_STREQ("queued_messages", MemoryAccounting::CategoryName(
+      MemoryAccounting::kQueuedMessages));
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
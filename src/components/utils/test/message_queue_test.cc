@@ -31,6 +31,7 @@
  */
 
 #include <unistd.h>
+#include <vector>
 #include "gtest/gtest.h"
 #include "utils/message_queue.h"
 
@@ -154,6 +155,40 @@ TEST_F(MessageQueueTest, MessageQueuePopOneElementTest_ExpectOneElementRemovedFr
   ASSERT_EQ(0u, test_queue.size());
 }
 
+TEST_F(MessageQueueTest, MessageQueuePopAllTest_ExpectAllElementsMovedInOrder) {
+  test_queue.push(test_val_1);
+  test_queue.push(test_val_2);
+  test_queue.push(test_val_3);
+  MessageQueue<std::string>::Queue batch;
+  batch.push(test_line);
+  // Previous content of output queue has to be discarded
+  ASSERT_EQ(3u, test_queue.PopAll(batch));
+  ASSERT_TRUE(test_queue.empty());
+  ASSERT_EQ(3u, batch.size());
+  ASSERT_EQ(test_val_1, batch.front());
+  batch.pop();
+  ASSERT_EQ(test_val_2, batch.front());
+  batch.pop();
+  ASSERT_EQ(test_val_3, batch.front());
+  // Nothing left to take
+  ASSERT_EQ(0u, test_queue.PopAll(batch));
+}
+
+TEST_F(MessageQueueTest, MessageQueuePushRangeTest_ExpectElementsAddedInOrder) {
+  std::vector<std::string> elements;
+  // Empty range adds nothing
+  test_queue.push(elements.begin(), elements.end());
+  ASSERT_TRUE(test_queue.empty());
+  elements.push_back(test_val_1);
+  elements.push_back(test_val_2);
+  elements.push_back(test_val_3);
+  test_queue.push(elements.begin(), elements.end());
+  ASSERT_EQ(3u, test_queue.size());
+  ASSERT_EQ(test_val_1, test_queue.pop());
+  ASSERT_EQ(test_val_2, test_queue.pop());
+  ASSERT_EQ(test_val_3, test_queue.pop());
+}
+
 TEST_F(MessageQueueTest, MessageQueueShutdownTest_ExpectMessageQueueWillBeShutDown) {
   pthread_t thread1;
   // Creating thread with thread function mentioned above
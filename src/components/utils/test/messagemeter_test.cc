@@ -278,6 +278,104 @@ INSTANTIATE_TEST_CASE_P(MessageMeterTestCase,
                         MessageMeterTest,
                         ::testing::ValuesIn(testing_time_pairs));
 
+class BucketedMessageMeterTest: public ::testing::TestWithParam<TimePair> {
+ protected:
+  void SetUp() OVERRIDE {
+    usecs = date_time::DateTime::MICROSECONDS_IN_MILLISECONDS;
+    id1 = 0x0;
+    id2 = 0xABCDEF;
+
+    const TimePair time_pair = GetParam();
+    time_range.tv_sec = time_pair.first;
+    time_range.tv_usec = time_pair.second * usecs;
+    meter.set_time_range(time_range);
+    time_range_msecs = date_time::DateTime::getmSecs(time_range);
+  }
+  static const size_t kBucketsCount = 16;
+  ::utils::BucketedMessageMeter<int, kBucketsCount> meter;
+  TimevalStruct time_range = {0, 0};
+  int64_t time_range_msecs;
+  int usecs;
+  int id1, id2;
+};
+
+TEST(BucketedMessageMeterTest, DefaultTimeRange) {
+  const ::utils::BucketedMessageMeter<int> default_meter;
+  const TimevalStruct time_second {1, 0};
+  EXPECT_EQ(time_second, default_meter.time_range());
+}
+
+TEST(BucketedMessageMeterTest, TimeRangeSetter) {
+  ::utils::BucketedMessageMeter<int> meter;
+  const TimevalStruct time_range {2, 300000};
+  meter.set_time_range(time_range);
+  EXPECT_EQ(time_range, meter.time_range());
+  meter.set_time_range(1500);
+  const TimevalStruct time_range_msecs {1, 500000};
+  EXPECT_EQ(time_range_msecs, meter.time_range());
+}
+
+TEST(BucketedMessageMeterTest, AddingWithNullTimeRange) {
+  ::utils::BucketedMessageMeter<int> meter;
+  const TimevalStruct null_time_range {0, 0};
+  meter.set_time_range(null_time_range);
+  for (int i = 0; i < 10000; ++i) {
+    EXPECT_EQ(0u, meter.TrackMessage(1));
+    EXPECT_EQ(0u, meter.Frequency(1));
+  }
+}
+
+TEST(BucketedMessageMeterTest, TimeRangeChange_ClearsFrequency) {
+  ::utils::BucketedMessageMeter<int> meter;
+  EXPECT_EQ(10u, meter.TrackMessages(1, 10));
+  meter.set_time_range(500);
+  EXPECT_EQ(0u, meter.Frequency(1));
+  EXPECT_EQ(1u, meter.TrackMessage(1));
+}
+
+TEST_P(BucketedMessageMeterTest, AddingOverPeriod) {
+  size_t messages = 0;
+  const TimevalStruct start_time = date_time::DateTime::getCurrentTime();
+  // No message is forgotten earlier than time range
+  while (date_time::DateTime::calculateTimeSpan(start_time)
+         < time_range_msecs) {
+    messages += 2;
+    EXPECT_EQ(messages - 1, meter.TrackMessage(id1));
+    EXPECT_EQ(messages, meter.TrackMessages(id1, 1));
+    EXPECT_EQ(messages, meter.Frequency(id1));
+  }
+  EXPECT_EQ(0u, meter.Frequency(id2));
+}
+
+TEST_P(BucketedMessageMeterTest, CountingOutOfPeriod) {
+  EXPECT_EQ(1u, meter.TrackMessage(id1));
+  EXPECT_EQ(3u, meter.TrackMessages(id2, 3));
+
+  // Message is forgotten not later than time range plus one bucket
+  const int64_t bucket_msecs = time_range_msecs / kBucketsCount + 1;
+  usleep((time_range_msecs + 2 * bucket_msecs) * usecs);
+  EXPECT_EQ(0u, meter.Frequency(id1));
+  EXPECT_EQ(0u, meter.Frequency(id2));
+  EXPECT_EQ(1u, meter.TrackMessage(id1));
+}
+
+TEST_P(BucketedMessageMeterTest, ClearIdAndIds) {
+  EXPECT_EQ(1u, meter.TrackMessage(id1));
+  EXPECT_EQ(1u, meter.TrackMessage(id2));
+
+  meter.RemoveIdentifier(id1);
+  EXPECT_EQ(0u, meter.Frequency(id1));
+  EXPECT_EQ(1u, meter.Frequency(id2));
+
+  meter.ClearIdentifiers();
+  EXPECT_EQ(0u, meter.Frequency(id1));
+  EXPECT_EQ(0u, meter.Frequency(id2));
+}
+
+INSTANTIATE_TEST_CASE_P(BucketedMessageMeterTestCase,
+                        BucketedMessageMeterTest,
+                        ::testing::ValuesIn(testing_time_pairs));
+
 }  // namespace utils
 }  // namespace components
 }  // namespace test
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "utils/metrics_registry.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::metrics::Counter;
+using ::utils::metrics::Histogram;
+using ::utils::metrics::HistogramSnapshot;
+using ::utils::metrics::MetricsRegistry;
+using ::utils::metrics::Snapshot;
+
+namespace {
+const int kThreadsCount = 4;
+const int kIncrementsPerThread = 10000;
+
+void* IncrementCounter(void* context) {
+  Counter* counter = static_cast<Counter*>(context);
+  for (int i = 0; i < kIncrementsPerThread; ++i) {
+    counter->Increment();
+  }
+  return NULL;
+}
+}  // namespace
+
+TEST(MetricsRegistryTest, GetSameName_ExpectSameMetric) {
+  MetricsRegistry* registry = MetricsRegistry::instance();
+  EXPECT_EQ(registry->GetCounter("test.same"),
+            registry->GetCounter("test.same"));
+  EXPECT_EQ(registry->GetHistogram("test.same"),
+            registry->GetHistogram("test.same"));
+  EXPECT_NE(registry->GetCounter("test.same"),
+            registry->GetCounter("test.other"));
+}
+
+TEST(MetricsRegistryTest, BucketBounds_ExpectValueWithinPrecision) {
+  const uint64_t values[] = {0, 1, 63, 64, 65, 1000, 123456, 987654321};
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+    const uint64_t value = values[i];
+    const uint64_t upper =
+        Histogram::BucketUpperBound(Histogram::BucketIndex(value));
+    EXPECT_LE(value, upper);
+    EXPECT_LE(upper - value, value / 32) << value;
+  }
+}
+
+TEST(MetricsRegistryTest, RecordUniformValues_ExpectPercentiles) {
+  Histogram histogram("test.uniform");
+  for (uint64_t value = 1; value <= 1000; ++value) {
+    histogram.Record(value);
+  }
+  HistogramSnapshot snapshot;
+  histogram.Snapshot(&snapshot);
+  EXPECT_EQ(1000u, snapshot.count);
+  EXPECT_EQ(500500u, snapshot.sum);
+  EXPECT_EQ(1000u, snapshot.max);
+  EXPECT_NEAR(500.0, snapshot.Percentile(50), 500 / 32.0);
+  EXPECT_NEAR(990.0, snapshot.Percentile(99), 990 / 32.0);
+  EXPECT_EQ(1000u, snapshot.Percentile(99.9));
+  EXPECT_EQ(1000u, snapshot.Percentile(100));
+}
+
+TEST(MetricsRegistryTest, EmptyHistogram_ExpectZeroPercentiles) {
+  Histogram histogram("test.empty");
+  HistogramSnapshot snapshot;
+  histogram.Snapshot(&snapshot);
+  EXPECT_EQ(0u, snapshot.count);
+  EXPECT_EQ(0u, snapshot.Percentile(99));
+}
+
+TEST(MetricsRegistryTest, IncrementFromThreads_ExpectNoLostUpdates) {
+  Counter counter("test.threads");
+  pthread_t threads[kThreadsCount];
+  for (int i = 0; i < kThreadsCount; ++i) {
+    ASSERT_EQ(0, pthread_create(&threads[i], NULL,
+                                &IncrementCounter, &counter));
+  }
+  for (int i = 0; i < kThreadsCount; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+  EXPECT_EQ(static_cast<uint64_t>(kThreadsCount * kIncrementsPerThread),
+            counter.Value());
+}
+
+TEST(MetricsRegistryTest, TakeSnapshot_ExpectAllMetricsInText) {
+  MetricsRegistry* registry = MetricsRegistry::instance();
+  registry->GetCounter("test.snapshot.counter")->Add(3);
+  registry->GetGauge("test.snapshot.gauge")->Set(-2);
+  registry->GetHistogram("test.snapshot.histogram")->Record(42);
+  Snapshot snapshot;
+  registry->TakeSnapshot(&snapshot);
+  const std::string text = ::utils::metrics::ToString(snapshot);
+  EXPECT_NE(std::string::npos, text.find("test.snapshot.counter=3\n"));
+  EXPECT_NE(std::string::npos, text.find("test.snapshot.gauge=-2\n"));
+  EXPECT_NE(std::string::npos, text.find(
+      "test.snapshot.histogram count=1 p50=42 p99=42 p999=42 max=42\n"));
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
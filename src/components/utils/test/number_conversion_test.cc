@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "utils/number_conversion.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::FormatInt64;
+using ::utils::FormatFixed;
+using ::utils::ParseInt64;
+using ::utils::ParseDouble;
+
+namespace {
+std::string Int64ToString(int64_t value) {
+  char buffer[::utils::kInt64StringSize];
+  return std::string(buffer, FormatInt64(value, buffer));
+}
+
+std::string FixedToString(double value, int precision) {
+  char buffer[::utils::kDoubleStringSize];
+  return std::string(buffer, FormatFixed(value, precision, buffer));
+}
+
+// Format SmartObject produced by stream before
+std::string ReferenceFixed(double value, int precision) {
+  std::stringstream stream;
+  stream << std::fixed << std::setprecision(precision) << value;
+  std::string result = stream.str();
+  result.erase(result.find_last_not_of('0') + 1, std::string::npos);
+  if ('.' == result[result.size() - 1]) {
+    result.erase(result.end() - 1);
+  }
+  return result;
+}
+
+double RandomDouble() {
+  const double mantissa = static_cast<double>(rand()) / RAND_MAX;
+  const int exponent = rand() % 40 - 20;
+  const double value = mantissa * pow(10.0, exponent);
+  return rand() % 2 ? value : -value;
+}
+
+bool ParseWhole(const std::string& text, double* value) {
+  return text.data() + text.size() ==
+         ParseDouble(text.data(), text.data() + text.size(), value);
+}
+}  // namespace
+
+TEST(NumberConversionTest, FormatInt64_Limits) {
+  EXPECT_EQ("0", Int64ToString(0));
+  EXPECT_EQ("7", Int64ToString(7));
+  EXPECT_EQ("-42", Int64ToString(-42));
+  EXPECT_EQ("1000000", Int64ToString(1000000));
+  EXPECT_EQ("9223372036854775807",
+            Int64ToString(std::numeric_limits<int64_t>::max()));
+  EXPECT_EQ("-9223372036854775808",
+            Int64ToString(std::numeric_limits<int64_t>::min()));
+}
+
+TEST(NumberConversionTest, FormatFixed_TrailingZerosDropped) {
+  EXPECT_EQ("123.12", FixedToString(123.12, 10));
+  EXPECT_EQ("5", FixedToString(5.0, 10));
+  EXPECT_EQ("0", FixedToString(0.0, 10));
+  EXPECT_EQ("-0.5", FixedToString(-0.5, 10));
+  EXPECT_EQ("1", FixedToString(0.99999999999, 10));
+  EXPECT_EQ("inf", FixedToString(std::numeric_limits<double>::infinity(), 10));
+  EXPECT_EQ("nan", FixedToString(std::numeric_limits<double>::quiet_NaN(), 10));
+}
+
+TEST(NumberConversionTest, FormatFixed_MatchesStream) {
+  srand(12345);
+  for (int i = 0; i < 100000; ++i) {
+    const double value = RandomDouble();
+    ASSERT_EQ(ReferenceFixed(value, 10), FixedToString(value, 10)) << value;
+  }
+  const double huge = 1e300;
+  EXPECT_EQ(ReferenceFixed(huge, 10), FixedToString(huge, 10));
+  // Exact tie is rounded to even
+  EXPECT_EQ(ReferenceFixed(1.0 / 2048, 10), FixedToString(1.0 / 2048, 10));
+}
+
+TEST(NumberConversionTest, ParseInt64_Limits) {
+  const char kText[] = "-9223372036854775808 9223372036854775808 12ab";
+  int64_t value = 0;
+  const char* end = ParseInt64(kText, kText + 20, &value);
+  EXPECT_EQ(kText + 20, end);
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), value);
+  // Overflow is not parsed
+  EXPECT_EQ(kText + 21, ParseInt64(kText + 21, kText + 40, &value));
+  EXPECT_EQ(kText + 43, ParseInt64(kText + 41, kText + 45, &value));
+  EXPECT_EQ(12, value);
+  EXPECT_EQ(kText, ParseInt64(kText, kText + 1, &value));
+}
+
+TEST(NumberConversionTest, ParseDouble_Grammar) {
+  double value = 0;
+  EXPECT_TRUE(ParseWhole("1.5", &value));
+  EXPECT_EQ(1.5, value);
+  EXPECT_TRUE(ParseWhole("-.25", &value));
+  EXPECT_EQ(-0.25, value);
+  EXPECT_TRUE(ParseWhole("3.", &value));
+  EXPECT_EQ(3.0, value);
+  EXPECT_TRUE(ParseWhole("1e3", &value));
+  EXPECT_EQ(1000.0, value);
+  EXPECT_TRUE(ParseWhole("+2.5E-2", &value));
+  EXPECT_EQ(0.025, value);
+  // Exponent without digits is not part of number
+  const std::string text("7e+x");
+  EXPECT_EQ(text.data() + 1,
+            ParseDouble(text.data(), text.data() + text.size(), &value));
+  EXPECT_EQ(7.0, value);
+  EXPECT_FALSE(ParseWhole(".", &value));
+  EXPECT_FALSE(ParseWhole("-", &value));
+  EXPECT_FALSE(ParseWhole("nan", &value));
+  EXPECT_FALSE(ParseWhole("1e999", &value));
+}
+
+TEST(NumberConversionTest, ParseDouble_MatchesStrtod) {
+  srand(54321);
+  char buffer[64];
+  for (int i = 0; i < 100000; ++i) {
+    const double number = RandomDouble();
+    // Short numbers take exact fast path, long ones are parsed by strtod
+    snprintf(buffer, sizeof(buffer), i % 2 ? "%.17g" : "%.6g", number);
+    double value = 0;
+    ASSERT_TRUE(ParseWhole(buffer, &value)) << buffer;
+    ASSERT_EQ(strtod(buffer, NULL), value) << buffer;
+  }
+}
+
+TEST(NumberConversionTest, FormatFixed_ParsedBack) {
+  srand(777);
+  for (int i = 0; i < 10000; ++i) {
+    const double number = RandomDouble();
+    const std::string text = FixedToString(number, 10);
+    double value = 0;
+    ASSERT_TRUE(ParseWhole(text, &value)) << text;
+    ASSERT_EQ(strtod(text.c_str(), NULL), value) << text;
+  }
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "gtest/gtest.h"
+#include "utils/prioritized_queue.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::FixedPrioritizedQueue;
+
+namespace {
+struct TestMessage {
+  TestMessage()
+      : priority(0),
+        id(0) {
+  }
+  TestMessage(size_t message_priority, int message_id)
+      : priority(message_priority),
+        id(message_id) {
+  }
+  size_t PriorityOrder() const {
+    return priority;
+  }
+  size_t priority;
+  int id;
+};
+}  // namespace
+
+TEST(FixedPrioritizedQueueTest, DefaultCtor_ExpectEmptyQueue) {
+  FixedPrioritizedQueue<TestMessage> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0u, queue.size());
+}
+
+TEST(FixedPrioritizedQueueTest, Push_ExpectHigherPriorityFirstFifoInside) {
+  FixedPrioritizedQueue<TestMessage> queue;
+  queue.push(TestMessage(0, 1));
+  queue.push(TestMessage(0xFF, 2));
+  queue.push(TestMessage(0x40, 3));
+  queue.push(TestMessage(0xFF, 4));
+  ASSERT_EQ(4u, queue.size());
+  EXPECT_EQ(2, queue.front().id);
+  queue.pop();
+  EXPECT_EQ(4, queue.front().id);
+  queue.pop();
+  EXPECT_EQ(3, queue.front().id);
+  queue.pop();
+  EXPECT_EQ(1, queue.front().id);
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(FixedPrioritizedQueueTest, PushOverLevelCapacity_ExpectOrderKept) {
+  FixedPrioritizedQueue<TestMessage, 8> queue;
+  const int kMessagesCount = 100;
+  for (int i = 0; i < kMessagesCount; ++i) {
+    queue.push(TestMessage(3, i));
+    if (i % 3 == 0) {
+      // Priority out of range shares highest level
+      queue.push(TestMessage(100, -i));
+    }
+  }
+  for (int i = 0; i < kMessagesCount; i += 3) {
+    ASSERT_EQ(-i, queue.front().id);
+    queue.pop();
+  }
+  for (int i = 0; i < kMessagesCount; ++i) {
+    ASSERT_EQ(i, queue.front().id);
+    queue.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(FixedPrioritizedQueueTest, Swap_ExpectContentExchanged) {
+  FixedPrioritizedQueue<TestMessage> queue;
+  FixedPrioritizedQueue<TestMessage> other;
+  queue.push(TestMessage(1, 1));
+  queue.push(TestMessage(200, 2));
+  other.push(TestMessage(5, 3));
+  queue.swap(other);
+  ASSERT_EQ(1u, queue.size());
+  EXPECT_EQ(3, queue.front().id);
+  ASSERT_EQ(2u, other.size());
+  EXPECT_EQ(2, other.front().id);
+  other.pop();
+  EXPECT_EQ(1, other.front().id);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
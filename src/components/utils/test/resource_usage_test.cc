@@ -30,11 +30,13 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <pthread.h>
 #include <unistd.h>
 #include "gtest/gtest.h"
 #include "utils/macro.h"
 
 #include "utils/resource_usage.h"
+#include "utils/resource_sampler.h"
 #include "utils/file_system.h"
 
 namespace utils {
@@ -95,6 +97,64 @@ TEST(ResourceUsageTest, SuccesfulGrabResources) {
 
 }
 
+namespace {
+class FixedDepthEntry : public threads::MessageLoopRegistry::Entry {
+ public:
+  virtual size_t QueueDepth() const {
+    return 7;
+  }
+};
+}  // namespace
+
+TEST(ResourceUsageTest, GetThreadsUsage_ExpectNamedThread) {
+  pthread_setname_np(pthread_self(), "UsageTest");
+  std::vector<Resources::ThreadUsage> threads;
+  ASSERT_TRUE(Resources::GetThreadsUsage(&threads));
+  bool found = false;
+  for (size_t i = 0; i < threads.size(); ++i) {
+    found = found || ("UsageTest" == threads[i].name);
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST(ResourceUsageTest, GetOpenFilesCount_ExpectStandardStreams) {
+  EXPECT_LE(3, Resources::GetOpenFilesCount());
+}
+
+TEST(ResourceUsageTest, TakeSample_ExpectRegisteredQueueDepth) {
+  FixedDepthEntry entry;
+  threads::MessageLoopRegistry::instance()->Register("TestLoop", &entry);
+  ResourceSample sample;
+  ResourceSampler::TakeSample(&sample);
+  threads::MessageLoopRegistry::instance()->Unregister(&entry);
+
+  EXPECT_FALSE(sample.threads.empty());
+  bool found = false;
+  for (size_t i = 0; i < sample.queues.size(); ++i) {
+    found = found || ("TestLoop" == sample.queues[i].first &&
+                      7u == sample.queues[i].second);
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST(ResourceUsageTest, TakeSample_ExpectAppsMemory) {
+  using ::utils::MemoryAccounting;
+  const uint32_t connection_key = 65537;
+  MemoryAccounting::instance()->Charge(connection_key,
+                                       MemoryAccounting::kMultiFrame, 100);
+  ResourceSample sample;
+  ResourceSampler::TakeSample(&sample);
+  MemoryAccounting::instance()->Release(connection_key,
+                                        MemoryAccounting::kMultiFrame, 100);
+
+  bool found = false;
+  for (size_t i = 0; i < sample.apps_memory.size(); ++i) {
+    found = found || (connection_key == sample.apps_memory[i].first &&
+                      100u == sample.apps_memory[i].second.Total());
+  }
+  EXPECT_TRUE(found);
+}
+
 }  // namespace utils
 }  // namespace components
 }  // namespace test
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "utils/ring_buffer_queue.h"
+#include "utils/message_queue.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::RingBufferQueue;
+using ::utils::MessageQueue;
+
+namespace {
+const size_t kProducersCount = 4;
+const size_t kMessagesPerProducer = 10000;
+
+typedef MessageQueue<size_t, RingBufferQueue<size_t, 64> > LockFreeQueue;
+
+void* ProduceMessages(void* context) {
+  LockFreeQueue* queue = static_cast<LockFreeQueue*>(context);
+  for (size_t i = 1; i <= kMessagesPerProducer; ++i) {
+    queue->push(i);
+  }
+  return NULL;
+}
+}  // namespace
+
+TEST(RingBufferQueueTest, DefaultCtor_ExpectEmptyQueue) {
+  RingBufferQueue<std::string, 4> queue;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0u, queue.size());
+  EXPECT_EQ(4u, queue.capacity());
+}
+
+TEST(RingBufferQueueTest, PushPop_ExpectFifoOrder) {
+  RingBufferQueue<std::string, 4> queue;
+  queue.push("Hello,");
+  queue.push("World!");
+  ASSERT_EQ(2u, queue.size());
+  EXPECT_EQ("Hello,", queue.front());
+  queue.pop();
+  EXPECT_EQ("World!", queue.front());
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(RingBufferQueueTest, TryPushToFullQueue_ExpectFalse) {
+  RingBufferQueue<int, 2> queue;
+  EXPECT_TRUE(queue.TryPush(1));
+  EXPECT_TRUE(queue.TryPush(2));
+  EXPECT_FALSE(queue.TryPush(3));
+  int value = 0;
+  EXPECT_TRUE(queue.TryPop(value));
+  EXPECT_EQ(1, value);
+  // Freed cell can be reused after wrap around
+  EXPECT_TRUE(queue.TryPush(3));
+  EXPECT_TRUE(queue.TryPop(value));
+  EXPECT_EQ(2, value);
+  EXPECT_TRUE(queue.TryPop(value));
+  EXPECT_EQ(3, value);
+  EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(RingBufferQueueTest, MultipleProducers_ExpectAllMessagesReceived) {
+  LockFreeQueue queue;
+  pthread_t producers[kProducersCount];
+  for (size_t i = 0; i < kProducersCount; ++i) {
+    ASSERT_EQ(0, pthread_create(&producers[i], NULL, &ProduceMessages, &queue));
+  }
+  size_t received = 0;
+  size_t sum = 0;
+  LockFreeQueue::Queue batch;
+  while (received < kProducersCount * kMessagesPerProducer) {
+    queue.wait();
+    received += queue.PopAll(batch);
+    while (!batch.empty()) {
+      sum += batch.front();
+      batch.pop();
+    }
+  }
+  for (size_t i = 0; i < kProducersCount; ++i) {
+    pthread_join(producers[i], NULL);
+  }
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(kProducersCount * kMessagesPerProducer * (kMessagesPerProducer + 1) / 2,
+            sum);
+}
+
+TEST(RingBufferQueueTest, ShutdownParkedConsumer_ExpectWaitFinished) {
+  LockFreeQueue queue;
+  queue.Shutdown();
+  queue.wait();
+  EXPECT_TRUE(queue.IsShuttingDown());
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "utils/rpc_trace.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::RpcTrace;
+using ::utils::RpcTracePtr;
+using ::utils::RpcTraceSpan;
+using ::utils::RpcTracer;
+using ::utils::RpcTraceObserver;
+namespace rpc_trace = ::utils::rpc_trace;
+
+namespace {
+const uint32_t kConnectionKey = 65537;
+const int32_t kCorrelationId = 12;
+const int32_t kHmiCorrelationId = 101;
+
+class TraceCollector : public RpcTraceObserver {
+ public:
+  void OnRpcTraced(const RpcTracePtr& trace) OVERRIDE {
+    traces.push_back(trace);
+  }
+  std::vector<RpcTracePtr> traces;
+};
+
+bool IsSet(const TimevalStruct& time) {
+  return 0 != time.tv_sec || 0 != time.tv_usec;
+}
+
+RpcTracePtr MakeTrace() {
+  return RpcTracePtr(
+      new RpcTrace(date_time::DateTime::getPreciseMonotonicTime()));
+}
+}  // namespace
+
+TEST(RpcTraceTest, EnqueueBeginEnd_ExpectOrderedSpanTimes) {
+  RpcTracePtr trace = MakeTrace();
+  trace->Enqueue(rpc_trace::kProtocolHandler);
+  trace->Begin(rpc_trace::kProtocolHandler);
+  trace->End(rpc_trace::kProtocolHandler);
+  trace->Finish();
+
+  const std::vector<RpcTraceSpan> spans = trace->spans();
+  ASSERT_EQ(2u, spans.size());
+  EXPECT_STREQ(rpc_trace::kRpc, spans[0].name);
+  EXPECT_EQ(-1, spans[0].parent);
+  EXPECT_TRUE(IsSet(spans[0].end));
+
+  const RpcTraceSpan& span = spans[1];
+  EXPECT_STREQ(rpc_trace::kProtocolHandler, span.name);
+  EXPECT_EQ(0, span.parent);
+  EXPECT_FALSE(date_time::DateTime::Greater(span.queued, span.begin));
+  EXPECT_FALSE(date_time::DateTime::Greater(span.begin, span.end));
+}
+
+TEST(RpcTraceTest, BeginWithoutQueue_ExpectSpanOpened) {
+  RpcTracePtr trace = MakeTrace();
+  trace->Begin(rpc_trace::kCommand);
+  trace->Begin(rpc_trace::kFormatter, rpc_trace::kCommand);
+  trace->End(rpc_trace::kFormatter);
+
+  const std::vector<RpcTraceSpan> spans = trace->spans();
+  ASSERT_EQ(3u, spans.size());
+  EXPECT_TRUE(IsSet(spans[1].queued));
+  EXPECT_FALSE(IsSet(spans[1].end));
+  EXPECT_EQ(1, spans[2].parent);
+  EXPECT_TRUE(IsSet(spans[2].end));
+}
+
+TEST(RpcTraceTest, EndOfNotStartedStage_ExpectIgnored) {
+  RpcTracePtr trace = MakeTrace();
+  trace->Enqueue(rpc_trace::kHmi);
+  trace->End(rpc_trace::kHmi);
+
+  const std::vector<RpcTraceSpan> spans = trace->spans();
+  ASSERT_EQ(2u, spans.size());
+  EXPECT_FALSE(IsSet(spans[1].begin));
+  EXPECT_FALSE(IsSet(spans[1].end));
+}
+
+TEST(RpcTracerTest, NoObserver_ExpectNothingBound) {
+  RpcTracer* tracer = RpcTracer::instance();
+  tracer->set_observer(NULL);
+  EXPECT_FALSE(tracer->enabled());
+  tracer->Bind(kConnectionKey, kCorrelationId, MakeTrace());
+  EXPECT_FALSE(tracer->Find(kConnectionKey, kCorrelationId));
+}
+
+TEST(RpcTracerTest, Complete_ExpectTraceFinishedAndPassedToObserver) {
+  TraceCollector collector;
+  RpcTracer* tracer = RpcTracer::instance();
+  tracer->set_observer(&collector);
+  RpcTracePtr trace = MakeTrace();
+  tracer->Bind(kConnectionKey, kCorrelationId, trace);
+  EXPECT_EQ(trace, tracer->Find(kConnectionKey, kCorrelationId));
+
+  tracer->Complete(kConnectionKey, kCorrelationId);
+  tracer->Complete(kConnectionKey, kCorrelationId);
+  tracer->set_observer(NULL);
+
+  ASSERT_EQ(1u, collector.traces.size());
+  EXPECT_EQ(trace, collector.traces.front());
+  EXPECT_TRUE(IsSet(trace->spans().front().end));
+  EXPECT_FALSE(tracer->Find(kConnectionKey, kCorrelationId));
+}
+
+TEST(RpcTracerTest, BindHmi_ExpectHmiSpanUnderCommand) {
+  TraceCollector collector;
+  RpcTracer* tracer = RpcTracer::instance();
+  tracer->set_observer(&collector);
+  RpcTracePtr trace = MakeTrace();
+  tracer->Bind(kConnectionKey, kCorrelationId, trace);
+  trace->Begin(rpc_trace::kCommand);
+
+  tracer->BindHmi(kHmiCorrelationId, kConnectionKey, kCorrelationId);
+  EXPECT_EQ(trace, tracer->FindHmi(kHmiCorrelationId));
+  tracer->UnbindHmi(kHmiCorrelationId);
+  EXPECT_FALSE(tracer->FindHmi(kHmiCorrelationId));
+  tracer->set_observer(NULL);
+
+  const std::vector<RpcTraceSpan> spans = trace->spans();
+  ASSERT_EQ(3u, spans.size());
+  EXPECT_STREQ(rpc_trace::kHmi, spans[2].name);
+  EXPECT_EQ(1, spans[2].parent);
+}
+
+TEST(RpcTracerTest, BindHmiOfUnknownRpc_ExpectNotBound) {
+  TraceCollector collector;
+  RpcTracer* tracer = RpcTracer::instance();
+  tracer->set_observer(&collector);
+  tracer->BindHmi(kHmiCorrelationId, kConnectionKey, kCorrelationId);
+  EXPECT_FALSE(tracer->FindHmi(kHmiCorrelationId));
+  tracer->set_observer(NULL);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
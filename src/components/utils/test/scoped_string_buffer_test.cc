@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "utils/scoped_string_buffer.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::ScopedStringBuffer;
+
+namespace {
+void* BufferAddress(void*) {
+  ScopedStringBuffer buffer;
+  return &buffer.get();
+}
+}  // namespace
+
+TEST(ScopedStringBufferTest, ReusedAndCleared) {
+  const std::string* first_address = NULL;
+  size_t capacity = 0;
+  {
+    ScopedStringBuffer buffer;
+    buffer.get().assign(1000, 'a');
+    first_address = &buffer.get();
+    capacity = buffer.get().capacity();
+  }
+  ScopedStringBuffer buffer;
+  EXPECT_EQ(first_address, &buffer.get());
+  EXPECT_TRUE(buffer.get().empty());
+  EXPECT_EQ(capacity, buffer.get().capacity());
+}
+
+TEST(ScopedStringBufferTest, NestedScopeGetsOwnString) {
+  ScopedStringBuffer outer;
+  outer.get() = "outer";
+  {
+    ScopedStringBuffer inner;
+    EXPECT_NE(&outer.get(), &inner.get());
+    EXPECT_TRUE(inner.get().empty());
+    inner.get() = "inner";
+  }
+  EXPECT_EQ("outer", outer.get());
+}
+
+TEST(ScopedStringBufferTest, HugeCapacityReleased) {
+  const size_t max_capacity = ScopedStringBuffer::kMaxRetainedCapacity;
+  {
+    ScopedStringBuffer buffer;
+    buffer.get().reserve(max_capacity * 2);
+  }
+  ScopedStringBuffer buffer;
+  EXPECT_GE(max_capacity, buffer.get().capacity());
+}
+
+TEST(ScopedStringBufferTest, ThreadsGetDifferentBuffers) {
+  const void* main_address = BufferAddress(NULL);
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &BufferAddress, NULL));
+  void* thread_address = NULL;
+  ASSERT_EQ(0, pthread_join(thread, &thread_address));
+  EXPECT_NE(main_address, thread_address);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "utils/shared_ptr.h"
+#include "utils/small_object_pool.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::SharedPtr;
+using ::utils::MakeShared;
+using ::utils::SmallObjectPool;
+
+namespace {
+class Base {
+ public:
+  explicit Base(int* destroyed_count)
+      : destroyed_count_(destroyed_count) {
+  }
+  virtual ~Base() {
+    ++*destroyed_count_;
+  }
+ private:
+  int* destroyed_count_;
+};
+
+class Derived : public Base {
+ public:
+  Derived(int* destroyed_count, const std::string& name, int* derived_count)
+      : Base(destroyed_count),
+        name(name),
+        derived_count_(derived_count) {
+  }
+  ~Derived() {
+    ++*derived_count_;
+  }
+  std::string name;
+ private:
+  int* derived_count_;
+};
+
+const size_t kPointersCount = 1000;
+
+void* ReleasePointers(void* context) {
+  std::vector<SharedPtr<std::string> >* pointers =
+      static_cast<std::vector<SharedPtr<std::string> >*>(context);
+  pointers->clear();
+  return NULL;
+}
+}  // namespace
+
+TEST(SmallObjectPoolTest, FreeThenAllocate_ExpectBlockReused) {
+  void* block = SmallObjectPool::Allocate(24);
+  SmallObjectPool::Free(block, 24);
+  // Same size class is served from cache of this thread
+  EXPECT_EQ(block, SmallObjectPool::Allocate(30));
+  SmallObjectPool::Free(block, 30);
+}
+
+TEST(SmallObjectPoolTest, AllocateBigBlock_ExpectNotCached) {
+  const size_t size = SmallObjectPool::kMaxBlockSize + 1;
+  void* block = SmallObjectPool::Allocate(size);
+  ASSERT_TRUE(block != NULL);
+  SmallObjectPool::Free(block, size);
+}
+
+TEST(SharedPtrTest, MakeShared_ExpectObjectConstructed) {
+  SharedPtr<std::string> pointer = MakeShared<std::string>("message");
+  ASSERT_TRUE(pointer.valid());
+  EXPECT_EQ("message", *pointer);
+  SharedPtr<std::string> copy = pointer;
+  EXPECT_EQ(pointer.get(), copy.get());
+}
+
+TEST(SharedPtrTest, MakeSharedCastToBase_ExpectDerivedDestroyedOnce) {
+  int base_destroyed = 0;
+  int derived_destroyed = 0;
+  {
+    SharedPtr<Base> base = MakeShared<Derived>(&base_destroyed,
+                                               std::string("derived"),
+                                               &derived_destroyed);
+    SharedPtr<Derived> derived = SharedPtr<Base>::static_pointer_cast<Derived>(
+        base);
+    EXPECT_EQ("derived", derived->name);
+    base.reset();
+    EXPECT_EQ(0, base_destroyed);
+  }
+  EXPECT_EQ(1, base_destroyed);
+  EXPECT_EQ(1, derived_destroyed);
+}
+
+TEST(SharedPtrTest, ReleaseInOtherThread_ExpectObjectsDestroyed) {
+  std::vector<SharedPtr<std::string> > pointers;
+  for (size_t i = 0; i < kPointersCount; ++i) {
+    if (i % 2) {
+      pointers.push_back(MakeShared<std::string>("pooled"));
+    } else {
+      pointers.push_back(SharedPtr<std::string>(new std::string("separate")));
+    }
+  }
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &ReleasePointers, &pointers));
+  ASSERT_EQ(0, pthread_join(thread, NULL));
+  EXPECT_TRUE(pointers.empty());
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
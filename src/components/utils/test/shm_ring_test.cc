@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+#include "utils/shm_ring.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::utils::ShmRing;
+
+namespace {
+const uint32_t kCapacity = 64;
+const size_t kMessagesCount = 200;
+
+std::string CreateMessage(size_t number) {
+  return std::string(number % 150, 'a' + number % 26);
+}
+
+void* ReadMessages(void* data) {
+  ShmRing* ring = static_cast<ShmRing*>(data);
+  std::vector<std::string>* messages = new std::vector<std::string>;
+  std::string message;
+  while (messages->size() < kMessagesCount && ring->Read(&message)) {
+    messages->push_back(message);
+  }
+  return messages;
+}
+}  // namespace
+
+TEST(ShmRingTest, WriteRead_MessagesOrderIsKept) {
+  std::vector<char> memory(ShmRing::RequiredSize(kCapacity));
+  ShmRing writer;
+  ShmRing reader;
+  writer.Attach(&memory[0], kCapacity, true);
+  reader.Attach(&memory[0], kCapacity, false);
+
+  ASSERT_TRUE(writer.Write("{}", 2));
+  ASSERT_TRUE(writer.Write("", 0));
+  std::string message;
+  ASSERT_TRUE(reader.Read(&message));
+  EXPECT_EQ("{}", message);
+  ASSERT_TRUE(reader.Read(&message));
+  EXPECT_EQ("", message);
+}
+
+TEST(ShmRingTest, WriteRead_MessagesBiggerThanRing) {
+  std::vector<char> memory(ShmRing::RequiredSize(kCapacity));
+  ShmRing writer;
+  ShmRing reader;
+  writer.Attach(&memory[0], kCapacity, true);
+  reader.Attach(&memory[0], kCapacity, false);
+
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &ReadMessages, &reader));
+  for (size_t i = 0; i < kMessagesCount; ++i) {
+    const std::string message = CreateMessage(i);
+    ASSERT_TRUE(writer.Write(message.data(), message.size()));
+  }
+  void* result = NULL;
+  ASSERT_EQ(0, pthread_join(thread, &result));
+  std::vector<std::string>* messages =
+      static_cast<std::vector<std::string>*>(result);
+  ASSERT_EQ(kMessagesCount, messages->size());
+  for (size_t i = 0; i < kMessagesCount; ++i) {
+    EXPECT_EQ(CreateMessage(i), (*messages)[i]);
+  }
+  delete messages;
+}
+
+TEST(ShmRingTest, Stop_WakesUpReader) {
+  std::vector<char> memory(ShmRing::RequiredSize(kCapacity));
+  ShmRing reader;
+  reader.Attach(&memory[0], kCapacity, true);
+
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &ReadMessages, &reader));
+  reader.Stop();
+  void* result = NULL;
+  ASSERT_EQ(0, pthread_join(thread, &result));
+  std::vector<std::string>* messages =
+      static_cast<std::vector<std::string>*>(result);
+  EXPECT_TRUE(messages->empty());
+  delete messages;
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
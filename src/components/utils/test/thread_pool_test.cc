@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <queue>
+#include <vector>
+#include "gtest/gtest.h"
+#include "utils/atomic.h"
+#include "utils/lock.h"
+#include "utils/threads/thread_pool.h"
+#include "utils/threads/message_loop_thread.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using namespace threads;
+
+namespace {
+const size_t kWorkersCount = 4;
+const uint32_t kTasksCount = 1000;
+
+class CountingDelegate : public ThreadDelegate {
+ public:
+  explicit CountingDelegate(volatile uint32_t* counter)
+      : counter_(counter) {
+  }
+  virtual void threadMain() {
+    atomic_post_inc(counter_);
+  }
+ private:
+  volatile uint32_t* counter_;
+};
+
+sync_primitives::Lock order_lock;
+
+class OrderedDelegate : public ThreadDelegate {
+ public:
+  OrderedDelegate(std::vector<uint32_t>* order, uint32_t index)
+      : order_(order),
+        index_(index) {
+  }
+  virtual void threadMain() {
+    sync_primitives::AutoLock auto_lock(order_lock);
+    // Strand guarantees the order delegates are run in
+    order_->push_back(index_);
+  }
+ private:
+  std::vector<uint32_t>* order_;
+  uint32_t index_;
+};
+
+struct TestMessage {
+  uint32_t value;
+};
+
+typedef MessageLoopThread<std::queue<TestMessage> > TestLoop;
+
+class TestHandler : public TestLoop::Handler {
+ public:
+  virtual void Handle(const TestMessage message) {
+    handled_.push_back(message.value);
+  }
+  std::vector<uint32_t> handled_;
+};
+
+class BatchTestHandler : public TestHandler {
+ public:
+  virtual void HandleBatch(TestLoop::Batch* batch) {
+    batch_sizes_.push_back(batch->size());
+    TestHandler::HandleBatch(batch);
+  }
+  std::vector<size_t> batch_sizes_;
+};
+}  // namespace
+
+TEST(ThreadPoolTest, ScheduleManyTasks_ExpectAllTasksRun) {
+  volatile uint32_t counter = 0;
+  CountingDelegate task(&counter);
+  {
+    ThreadPool pool("test", kWorkersCount);
+    ASSERT_EQ(kWorkersCount, pool.workers_count());
+    SerialTask serial_task(&pool, &task);
+    for (uint32_t i = 0; i < kTasksCount; ++i) {
+      serial_task.Notify();
+    }
+    serial_task.WaitIdle();
+  }
+  // Notifications are coalesced, but at least one run has to happen
+  EXPECT_LT(0u, counter);
+  EXPECT_GE(kTasksCount, counter);
+}
+
+TEST(ThreadPoolTest, StrandPost_ExpectDelegatesRunInOrder) {
+  std::vector<uint32_t> order;
+  ThreadPool pool("test", kWorkersCount);
+  {
+    Strand strand(&pool);
+    for (uint32_t i = 0; i < kTasksCount; ++i) {
+      strand.Post(new OrderedDelegate(&order, i));
+    }
+    // Strand destruction drops not started delegates, wait for all of them
+    for (;;) {
+      {
+        sync_primitives::AutoLock auto_lock(order_lock);
+        if (order.size() == kTasksCount) {
+          break;
+        }
+      }
+      usleep(1000);
+    }
+  }
+  ASSERT_EQ(kTasksCount, order.size());
+  for (uint32_t i = 0; i < kTasksCount; ++i) {
+    EXPECT_EQ(i, order[i]);
+  }
+}
+
+TEST(ThreadPoolTest, MessageLoopOnPool_ExpectMessagesHandledInOrder) {
+  ThreadPool pool("test", kWorkersCount);
+  TestHandler handler;
+  {
+    TestLoop loop("test_loop", &handler, &pool);
+    for (uint32_t i = 0; i < kTasksCount; ++i) {
+      TestMessage message = { i };
+      loop.PostMessage(message);
+    }
+    // Shutdown processes already posted messages
+    loop.Shutdown();
+  }
+  ASSERT_EQ(kTasksCount, handler.handled_.size());
+  for (uint32_t i = 0; i < kTasksCount; ++i) {
+    EXPECT_EQ(i, handler.handled_[i]);
+  }
+}
+
+TEST(ThreadPoolTest, MessageLoopBatches_ExpectAllMessagesHandledInOrder) {
+  ThreadPool pool("test", kWorkersCount);
+  BatchTestHandler handler;
+  {
+    TestLoop loop("test_loop", &handler, &pool);
+    for (uint32_t i = 0; i < kTasksCount; ++i) {
+      TestMessage message = { i };
+      loop.PostMessage(message);
+    }
+    loop.Shutdown();
+  }
+  ASSERT_EQ(kTasksCount, handler.handled_.size());
+  for (uint32_t i = 0; i < kTasksCount; ++i) {
+    EXPECT_EQ(i, handler.handled_[i]);
+  }
+  size_t batched = 0;
+  for (size_t i = 0; i < handler.batch_sizes_.size(); ++i) {
+    EXPECT_LT(0u, handler.batch_sizes_[i]);
+    batched += handler.batch_sizes_[i];
+  }
+  EXPECT_EQ(kTasksCount, batched);
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
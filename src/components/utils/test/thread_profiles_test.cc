@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include "gtest/gtest.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_profiles.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using namespace threads;
+
+namespace {
+const size_t kStackSize = 512 * 1024;
+
+ThreadProfile MakeProfile(size_t stack_size, int cpu) {
+  ThreadProfile profile;
+  profile.stack_size = stack_size;
+  if (cpu >= 0) {
+    profile.cpus.push_back(cpu);
+  }
+  return profile;
+}
+
+class AffinityDelegate : public ThreadDelegate {
+ public:
+  AffinityDelegate()
+      : cpus_count_(-1),
+        done_(false) {
+  }
+  virtual void threadMain() {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    sync_primitives::AutoLock auto_lock(lock_);
+    cpus_count_ = CPU_COUNT(&cpu_set);
+    first_cpu_ = CPU_ISSET(0, &cpu_set);
+    done_ = true;
+    done_cond_.Broadcast();
+  }
+  int WaitCpusCount(bool* first_cpu) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (!done_) {
+      done_cond_.Wait(auto_lock);
+    }
+    *first_cpu = first_cpu_;
+    return cpus_count_;
+  }
+ private:
+  int cpus_count_;
+  bool first_cpu_;
+  bool done_;
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable done_cond_;
+};
+}  // namespace
+
+TEST(ThreadProfileTest, Parse_AllFields) {
+  ThreadProfile profile;
+  ASSERT_TRUE(profile.Parse("256, FIFO, 10, 0 2-3"));
+  EXPECT_EQ(256u * 1024, profile.stack_size);
+  EXPECT_EQ(ThreadProfile::kFifoPolicy, profile.policy);
+  EXPECT_EQ(10, profile.priority);
+  ASSERT_EQ(3u, profile.cpus.size());
+  EXPECT_EQ(0, profile.cpus[0]);
+  EXPECT_EQ(2, profile.cpus[1]);
+  EXPECT_EQ(3, profile.cpus[2]);
+}
+
+TEST(ThreadProfileTest, Parse_EmptyFieldsKeepDefaults) {
+  ThreadProfile profile;
+  ASSERT_TRUE(profile.Parse(", rr"));
+  EXPECT_EQ(0u, profile.stack_size);
+  EXPECT_EQ(ThreadProfile::kRoundRobinPolicy, profile.policy);
+  EXPECT_EQ(0, profile.priority);
+  EXPECT_TRUE(profile.cpus.empty());
+
+  ASSERT_TRUE(profile.Parse(""));
+  EXPECT_EQ(ThreadProfile::kInheritPolicy, profile.policy);
+}
+
+TEST(ThreadProfileTest, Parse_MalformedValue_ProfileUnchanged) {
+  ThreadProfile profile;
+  ASSERT_TRUE(profile.Parse("128"));
+  EXPECT_FALSE(profile.Parse("big"));
+  EXPECT_FALSE(profile.Parse(", IDLE"));
+  EXPECT_FALSE(profile.Parse(", , -1"));
+  EXPECT_FALSE(profile.Parse(", , , 3-1"));
+  EXPECT_FALSE(profile.Parse("1, OTHER, 0, 0, 1"));
+  EXPECT_EQ(128u * 1024, profile.stack_size);
+}
+
+TEST(ThreadProfilesTest, Find_LongestPrefixWins) {
+  ThreadProfiles::Profiles profiles;
+  profiles.push_back(std::make_pair("Socket", MakeProfile(1024, -1)));
+  profiles.push_back(std::make_pair("SocketStreamer", MakeProfile(2048, -1)));
+  ThreadProfiles::instance()->Set(profiles);
+
+  ThreadProfile profile;
+  ASSERT_TRUE(ThreadProfiles::instance()->Find("Socket 1:2", &profile));
+  EXPECT_EQ(1024u, profile.stack_size);
+  ASSERT_TRUE(ThreadProfiles::instance()->Find("SocketStreamer", &profile));
+  EXPECT_EQ(2048u, profile.stack_size);
+  EXPECT_FALSE(ThreadProfiles::instance()->Find("Sock", &profile));
+
+  ThreadProfiles::instance()->Set(ThreadProfiles::Profiles());
+  EXPECT_FALSE(ThreadProfiles::instance()->Find("Socket 1:2", &profile));
+}
+
+TEST(ThreadProfilesTest, Start_ProfileApplied) {
+  ThreadProfiles::Profiles profiles;
+  profiles.push_back(std::make_pair("Profiled", MakeProfile(kStackSize, 0)));
+  ThreadProfiles::instance()->Set(profiles);
+
+  AffinityDelegate* delegate = new AffinityDelegate();
+  Thread* thread = CreateThread("Profiled thread", delegate);
+  ASSERT_TRUE(thread->start());
+  EXPECT_EQ(kStackSize, thread->stack_size());
+  bool first_cpu = false;
+  EXPECT_EQ(1, delegate->WaitCpusCount(&first_cpu));
+  EXPECT_TRUE(first_cpu);
+  thread->join();
+  ThreadProfiles::instance()->Set(ThreadProfiles::Profiles());
+  DeleteThread(thread);
+  delete delegate;
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "utils/atomic.h"
+#include "utils/lock.h"
+#include "utils/conditional_variable.h"
+#include "utils/timer_wheel.h"
+
+namespace test {
+namespace components {
+namespace utils {
+
+using ::timer::TimerWheel;
+using namespace sync_primitives;
+
+namespace {
+const size_t kTimersCount = 1000;
+const uint64_t kTimeoutMs = 200;
+const int32_t kWaitMs = 3000;
+
+class CountingTimer : public TimerWheel::Timer {
+ public:
+  CountingTimer(volatile uint32_t* counter, Lock* lock,
+                ConditionalVariable* fired)
+      : counter_(counter),
+        lock_(lock),
+        fired_(fired) {
+  }
+  virtual void OnTimeout() {
+    AutoLock auto_lock(*lock_);
+    ++(*counter_);
+    fired_->NotifyOne();
+  }
+ private:
+  volatile uint32_t* counter_;
+  Lock* lock_;
+  ConditionalVariable* fired_;
+};
+}  // namespace
+
+class TimerWheelTest : public ::testing::Test {
+ protected:
+  TimerWheelTest()
+      : counter_(0) {
+  }
+  void WaitForCounter(uint32_t expected) {
+    AutoLock auto_lock(lock_);
+    while (counter_ < expected) {
+      if (ConditionalVariable::kTimeout == fired_.WaitFor(auto_lock, kWaitMs)) {
+        break;
+      }
+    }
+  }
+  volatile uint32_t counter_;
+  Lock lock_;
+  ConditionalVariable fired_;
+};
+
+TEST_F(TimerWheelTest, ArmManyTimers_ExpectAllTimersFired) {
+  std::vector<CountingTimer*> timers;
+  for (size_t i = 0; i < kTimersCount; ++i) {
+    timers.push_back(new CountingTimer(&counter_, &lock_, &fired_));
+    TimerWheel::instance()->Arm(timers.back(), kTimeoutMs);
+    EXPECT_TRUE(TimerWheel::instance()->IsArmed(timers.back()));
+  }
+  WaitForCounter(kTimersCount);
+  EXPECT_EQ(kTimersCount, counter_);
+  for (size_t i = 0; i < kTimersCount; ++i) {
+    EXPECT_FALSE(TimerWheel::instance()->IsArmed(timers[i]));
+    delete timers[i];
+  }
+}
+
+TEST_F(TimerWheelTest, CancelHalfOfTimers_ExpectOnlyArmedTimersFired) {
+  std::vector<CountingTimer*> timers;
+  for (size_t i = 0; i < kTimersCount; ++i) {
+    timers.push_back(new CountingTimer(&counter_, &lock_, &fired_));
+    TimerWheel::instance()->Arm(timers.back(), kTimeoutMs);
+  }
+  for (size_t i = 0; i < kTimersCount; i += 2) {
+    TimerWheel::instance()->Cancel(timers[i]);
+    EXPECT_FALSE(TimerWheel::instance()->IsArmed(timers[i]));
+  }
+  WaitForCounter(kTimersCount / 2);
+  // Give cancelled timers a chance to fire erroneously
+  usleep(2 * kTimeoutMs * 1000);
+  EXPECT_EQ(kTimersCount / 2, counter_);
+  for (size_t i = 0; i < kTimersCount; ++i) {
+    delete timers[i];
+  }
+}
+
+TEST_F(TimerWheelTest, RearmFarTimerToNearTimeout_ExpectTimerFiredOnce) {
+  CountingTimer timer(&counter_, &lock_, &fired_);
+  // Far timeout is placed to upper levels of the wheel
+  TimerWheel::instance()->Arm(&timer, 24 * 3600 * 1000);
+  TimerWheel::instance()->Arm(&timer, kTimeoutMs);
+  WaitForCounter(1);
+  EXPECT_EQ(1u, counter_);
+  EXPECT_FALSE(TimerWheel::instance()->IsArmed(&timer));
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace test
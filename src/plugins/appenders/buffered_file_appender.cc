@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "buffered_file_appender.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <cstdio>
+#include <sstream>
+
+#include <log4cxx/helpers/loglog.h>
+#include <log4cxx/helpers/optionconverter.h>
+#include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/helpers/synchronized.h>
+#include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/rolling/gzcompressaction.h>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+IMPLEMENT_LOG4CXX_OBJECT(BufferedFileAppender)
+
+namespace {
+const size_t kDefaultBufferSize = 1024 * 1024;
+const int kDefaultFlushIntervalMs = 1000;
+const long kDefaultMaxFileSize = 10 * 1024 * 1024;
+const log4cxx_time_t kRateWindowUs = 1000000;
+
+int64_t MonotonicMs() {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+}
+
+void ReportError(const char* what, const std::string& file_name) {
+  std::string message(what);
+  message.append(" ").append(file_name).append(": ").append(strerror(errno));
+  LOG4CXX_DECODE_CHAR(error, message);
+  LogLog::error(error);
+}
+}  // namespace
+
+BufferedFileAppender::BufferedFileAppender()
+  : append_(true),
+    buffer_size_(kDefaultBufferSize),
+    flush_interval_ms_(kDefaultFlushIntervalMs),
+    sync_interval_ms_(0),
+    max_file_size_(kDefaultMaxFileSize),
+    max_backup_index_(1),
+    compress_(false),
+    rate_limit_(0),
+    dropped_(0),
+    stop_(false),
+    fd_(-1),
+    file_size_(0),
+    last_sync_ms_(0),
+    writer_(),
+    writer_started_(false) {
+  pthread_mutex_init(&buffer_lock_, NULL);
+  pthread_cond_init(&buffer_cond_, NULL);
+}
+
+BufferedFileAppender::~BufferedFileAppender() {
+  finalize();
+  pthread_cond_destroy(&buffer_cond_);
+  pthread_mutex_destroy(&buffer_lock_);
+}
+
+void BufferedFileAppender::setOption(const LogString& option,
+                                     const LogString& value) {
+  if (StringHelper::equalsIgnoreCase(option,
+                                     LOG4CXX_STR("FILE"), LOG4CXX_STR("file"))) {
+    Transcoder::encode(value, file_name_);
+  } else if (StringHelper::equalsIgnoreCase(option,
+             LOG4CXX_STR("APPEND"), LOG4CXX_STR("append"))) {
+    append_ = OptionConverter::toBoolean(value, true);
+  } else if (StringHelper::equalsIgnoreCase(option,
+             LOG4CXX_STR("BUFFERSIZE"), LOG4CXX_STR("buffersize"))) {
+    buffer_size_ = OptionConverter::toFileSize(value, kDefaultBufferSize);
+  } else if (StringHelper::equalsIgnoreCase(option,
+             LOG4CXX_STR("FLUSHINTERVAL"), LOG4CXX_STR("flushinterval"))) {
+    flush_interval_ms_ = OptionConverter::toInt(value, kDefaultFlushIntervalMs);
+  } else if (StringHelper::equalsIgnoreCase(option,
+             LOG4CXX_STR("SYNCINTERVAL"), LOG4CXX_STR("syncinterval"))) {
+    sync_interval_ms_ = OptionConverter::toInt(value, 0);
+  } else if (StringHelper::equalsIgnoreCase(option,
+             LOG4CXX_STR("MAXFILESIZE"), LOG4CXX_STR("maxfilesize"))) {
+    max_file_size_ = OptionConverter::toFileSize(value, kDefaultMaxFileSize);
+  } else if (StringHelper::equalsIgnoreCase(option,
+             LOG4CXX_STR("MAXBACKUPINDEX"), LOG4CXX_STR("maxbackupindex"))) {
+    max_backup_index_ = OptionConverter::toInt(value, 1);
+  } else if (StringHelper::equalsIgnoreCase(option,
+             LOG4CXX_STR("COMPRESS"), LOG4CXX_STR("compress"))) {
+    compress_ = OptionConverter::toBoolean(value, false);
+  } else if (StringHelper::equalsIgnoreCase(option,
+             LOG4CXX_STR("RATELIMIT"), LOG4CXX_STR("ratelimit"))) {
+    rate_limit_ = OptionConverter::toInt(value, 0);
+  } else {
+    AppenderSkeleton::setOption(option, value);
+  }
+}
+
+void BufferedFileAppender::activateOptions(Pool& p) {
+  synchronized sync(mutex);
+  if (writer_started_) {
+    LogLog::warn(LOG4CXX_STR("Appender [") + name +
+                 LOG4CXX_STR("] is already active"));
+    return;
+  }
+  if (file_name_.empty()) {
+    LogLog::error(LOG4CXX_STR("File option not set for appender [") + name +
+                  LOG4CXX_STR("]"));
+    return;
+  }
+  if (flush_interval_ms_ <= 0) {
+    flush_interval_ms_ = kDefaultFlushIntervalMs;
+  }
+  if (!OpenFile(append_)) {
+    return;
+  }
+  // Both buffers are allocated once, swapping keeps their capacity
+  front_buffer_.reserve(buffer_size_);
+  back_buffer_.reserve(buffer_size_);
+  stop_ = false;
+  if (pthread_create(&writer_, NULL, &BufferedFileAppender::WriterThread,
+                     this) != 0) {
+    ReportError("Failed to start writer thread for", file_name_);
+    CloseFile();
+    return;
+  }
+  writer_started_ = true;
+  AppenderSkeleton::activateOptions(p);
+}
+
+void BufferedFileAppender::close() {
+  synchronized sync(mutex);
+  if (closed) {
+    return;
+  }
+  closed = true;
+  if (!writer_started_) {
+    return;
+  }
+
+  Pool p;
+  for (RateStates::iterator it = rate_states_.begin();
+       it != rate_states_.end(); ++it) {
+    if (it->second.suppressed) {
+      AppendSummary(it->first, it->second.suppressed,
+                    LOG4CXX_STR(" messages suppressed"), p);
+    }
+  }
+  rate_states_.clear();
+  if (dropped_) {
+    AppendSummary(name, dropped_, LOG4CXX_STR(" messages dropped"), p);
+    dropped_ = 0;
+  }
+
+  pthread_mutex_lock(&buffer_lock_);
+  stop_ = true;
+  pthread_cond_signal(&buffer_cond_);
+  pthread_mutex_unlock(&buffer_lock_);
+  pthread_join(writer_, NULL);
+  writer_started_ = false;
+  CloseFile();
+}
+
+void BufferedFileAppender::append(const spi::LoggingEventPtr& event,
+                                  Pool& p) {
+  if (!writer_started_) {
+    return;
+  }
+  if (rate_limit_ > 0 &&
+      !Admit(event->getLoggerName(), event->getTimeStamp(), p)) {
+    return;
+  }
+  if (dropped_) {
+    const size_t dropped = dropped_;
+    dropped_ = 0;
+    AppendSummary(name, dropped, LOG4CXX_STR(" messages dropped"), p);
+    if (dropped_) {
+      // Buffer is still full, summary itself is not counted
+      dropped_ = dropped;
+    }
+  }
+  AppendFormatted(event, p);
+}
+
+bool BufferedFileAppender::Admit(const LogString& logger_name,
+                                 log4cxx_time_t time_stamp, Pool& p) {
+  RateState& state = rate_states_[logger_name];
+  if (time_stamp - state.window_start >= kRateWindowUs) {
+    if (state.suppressed) {
+      AppendSummary(logger_name, state.suppressed,
+                    LOG4CXX_STR(" messages suppressed"), p);
+    }
+    state.window_start = time_stamp;
+    state.count = 0;
+    state.suppressed = 0;
+  }
+  if (state.count >= rate_limit_) {
+    ++state.suppressed;
+    return false;
+  }
+  ++state.count;
+  return true;
+}
+
+void BufferedFileAppender::AppendSummary(const LogString& logger_name,
+                                         size_t count, const LogString& what,
+                                         Pool& p) {
+  LogString message;
+  StringHelper::toString(count, p, message);
+  message.append(what);
+  const spi::LoggingEventPtr event(
+      new spi::LoggingEvent(logger_name, Level::getWarn(), message,
+                            spi::LocationInfo::getLocationUnavailable()));
+  AppendFormatted(event, p);
+}
+
+void BufferedFileAppender::AppendFormatted(const spi::LoggingEventPtr& event,
+                                           Pool& p) {
+  LogString formatted;
+  layout->format(formatted, event, p);
+  std::string encoded;
+  Transcoder::encode(formatted, encoded);
+
+  pthread_mutex_lock(&buffer_lock_);
+  if (front_buffer_.size() + encoded.size() > buffer_size_) {
+    ++dropped_;
+  } else {
+    front_buffer_.append(encoded);
+    // Writer is woken up early when half of buffer is used
+    if (front_buffer_.size() >= buffer_size_ / 2) {
+      pthread_cond_signal(&buffer_cond_);
+    }
+  }
+  pthread_mutex_unlock(&buffer_lock_);
+}
+
+void* BufferedFileAppender::WriterThread(void* self) {
+  static_cast<BufferedFileAppender*>(self)->WriteLoop();
+  return NULL;
+}
+
+void BufferedFileAppender::WriteLoop() {
+  bool stop = false;
+  while (!stop) {
+    pthread_mutex_lock(&buffer_lock_);
+    if (!stop_ && front_buffer_.size() < buffer_size_ / 2) {
+      timespec wake_up;
+      clock_gettime(CLOCK_REALTIME, &wake_up);
+      wake_up.tv_sec += flush_interval_ms_ / 1000;
+      wake_up.tv_nsec += (flush_interval_ms_ % 1000) * 1000000;
+      if (wake_up.tv_nsec >= 1000000000) {
+        ++wake_up.tv_sec;
+        wake_up.tv_nsec -= 1000000000;
+      }
+      pthread_cond_timedwait(&buffer_cond_, &buffer_lock_, &wake_up);
+    }
+    front_buffer_.swap(back_buffer_);
+    stop = stop_;
+    pthread_mutex_unlock(&buffer_lock_);
+
+    if (!back_buffer_.empty()) {
+      WriteOut(back_buffer_);
+      back_buffer_.clear();
+    }
+  }
+  if (fd_ >= 0 && sync_interval_ms_ > 0) {
+    fdatasync(fd_);
+  }
+}
+
+void BufferedFileAppender::WriteOut(const std::string& data) {
+  if (max_file_size_ > 0 && file_size_ > 0 &&
+      file_size_ + static_cast<long>(data.size()) > max_file_size_) {
+    RollOver();
+  }
+  if (fd_ < 0) {
+    return;
+  }
+  const char* position = data.data();
+  size_t left = data.size();
+  while (left) {
+    const ssize_t written = ::write(fd_, position, left);
+    if (written < 0) {
+      if (EINTR == errno) {
+        continue;
+      }
+      ReportError("Failed to write", file_name_);
+      return;
+    }
+    position += written;
+    left -= written;
+    file_size_ += written;
+  }
+  if (sync_interval_ms_ > 0) {
+    const int64_t now = MonotonicMs();
+    if (now - last_sync_ms_ >= sync_interval_ms_) {
+      fdatasync(fd_);
+      last_sync_ms_ = now;
+    }
+  }
+}
+
+void BufferedFileAppender::RollOver() {
+  CloseFile();
+  if (max_backup_index_ > 0) {
+    ::remove(BackupName(max_backup_index_).c_str());
+    for (int i = max_backup_index_ - 1; i >= 1; --i) {
+      ::rename(BackupName(i).c_str(), BackupName(i + 1).c_str());
+    }
+    if (compress_) {
+      // gzip runs on writer thread, logging threads only fill the buffer
+      const std::string rolled = file_name_ + ".1";
+      if (0 == ::rename(file_name_.c_str(), rolled.c_str())) {
+        Pool p;
+        const rolling::ActionPtr compress(new rolling::GZCompressAction(
+            File(rolled), File(BackupName(1)), true));
+        compress->execute(p);
+      }
+    } else {
+      ::rename(file_name_.c_str(), BackupName(1).c_str());
+    }
+  }
+  OpenFile(false);
+}
+
+bool BufferedFileAppender::OpenFile(bool append) {
+  fd_ = ::open(file_name_.c_str(),
+               O_WRONLY | O_CREAT | O_APPEND | (append ? 0 : O_TRUNC), 0644);
+  if (fd_ < 0) {
+    ReportError("Failed to open", file_name_);
+    return false;
+  }
+  struct stat file_stat;
+  file_size_ = 0 == fstat(fd_, &file_stat) ? file_stat.st_size : 0;
+  return true;
+}
+
+void BufferedFileAppender::CloseFile() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+std::string BufferedFileAppender::BackupName(int index) const {
+  std::stringstream backup;
+  backup << file_name_ << '.' << index;
+  if (compress_) {
+    backup << ".gz";
+  }
+  return backup.str();
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_PLUGINS_APPENDERS_BUFFERED_FILE_APPENDER_H_
+#define SRC_PLUGINS_APPENDERS_BUFFERED_FILE_APPENDER_H_
+
+#include <pthread.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+
+#include <log4cxx/appenderskeleton.h>
+
+namespace log4cxx {
+
+/*
+ * File appender which never does file I/O on the logging thread.
+ * Formatted messages are appended to preallocated in-memory buffer,
+ * separate writer thread swaps it and writes out whole batches.
+ * If writer can't keep up, messages are dropped instead of
+ * growing the buffer and the count of dropped is logged afterwards.
+ *
+ * Options:
+ *   File           - log file name
+ *   Append         - append to existing file, true by default
+ *   BufferSize     - size of each of two buffers, 1MB by default
+ *   FlushInterval  - max delay in ms before buffered data is written
+ *   SyncInterval   - min delay in ms between fdatasync calls, 0 disables
+ *   MaxFileSize    - file is rolled over on exceeding it, 0 disables
+ *   MaxBackupIndex - number of kept backups
+ *   Compress       - gzip backups on roll-over
+ *   RateLimit      - max messages of one logger per second, 0 disables,
+ *                    surplus is replaced with "N messages suppressed"
+ */
+class BufferedFileAppender : public AppenderSkeleton {
+ public:
+  DECLARE_LOG4CXX_OBJECT(BufferedFileAppender)
+  BEGIN_LOG4CXX_CAST_MAP()
+    LOG4CXX_CAST_ENTRY(BufferedFileAppender)
+    LOG4CXX_CAST_ENTRY_CHAIN(AppenderSkeleton)
+  END_LOG4CXX_CAST_MAP()
+
+  BufferedFileAppender();
+  virtual ~BufferedFileAppender();
+
+  virtual void setOption(const LogString& option, const LogString& value);
+  virtual void activateOptions(helpers::Pool& p);
+  virtual void close();
+  virtual bool requiresLayout() const {
+    return true;
+  }
+
+ protected:
+  virtual void append(const spi::LoggingEventPtr& event, helpers::Pool& p);
+
+ private:
+  struct RateState {
+    RateState() : window_start(0), count(0), suppressed(0) {}
+    log4cxx_time_t window_start;
+    int count;
+    size_t suppressed;
+  };
+  typedef std::map<LogString, RateState> RateStates;
+
+  /*
+   * Counts message of logger against rate limit,
+   * returns false if message has to be suppressed
+   */
+  bool Admit(const LogString& logger_name, log4cxx_time_t time_stamp,
+             helpers::Pool& p);
+  void AppendSummary(const LogString& logger_name, size_t count,
+                     const LogString& what, helpers::Pool& p);
+  void AppendFormatted(const spi::LoggingEventPtr& event, helpers::Pool& p);
+
+  static void* WriterThread(void* self);
+  void WriteLoop();
+  void WriteOut(const std::string& data);
+  void RollOver();
+  bool OpenFile(bool append);
+  void CloseFile();
+  std::string BackupName(int index) const;
+
+  // Options
+  std::string file_name_;
+  bool append_;
+  size_t buffer_size_;
+  int flush_interval_ms_;
+  int sync_interval_ms_;
+  long max_file_size_;
+  int max_backup_index_;
+  bool compress_;
+  int rate_limit_;
+
+  // Accessed by logging thread only
+  RateStates rate_states_;
+
+  // Guarded by buffer_lock_
+  pthread_mutex_t buffer_lock_;
+  pthread_cond_t buffer_cond_;
+  std::string front_buffer_;
+  size_t dropped_;
+  bool stop_;
+
+  // Accessed by writer thread only
+  std::string back_buffer_;
+  int fd_;
+  long file_size_;
+  int64_t last_sync_ms_;
+
+  pthread_t writer_;
+  bool writer_started_;
+
+  BufferedFileAppender(const BufferedFileAppender&);
+  BufferedFileAppender& operator=(const BufferedFileAppender&);
+};
+
+LOG4CXX_PTR_DEF(BufferedFileAppender);
+
+}  // namespace log4cxx
+
+#endif  // SRC_PLUGINS_APPENDERS_BUFFERED_FILE_APPENDER_H_
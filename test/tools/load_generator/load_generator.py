@@ -0,0 +1,920 @@
+"""
+Synthetic load generator of SDL
+
+usage: load_generator.py [-h] [--sdl HOST:PORT] [--hmi HOST:PORT] [--no-hmi]
+                         [--hmi-script FILE] [--no-activation] [--apps N]
+                         [--protocol {2,3}] [--duration SECONDS] [--mix MIX]
+                         [--rate RATE] [--window WINDOW]
+                         [--put-file-size BYTES] [--video-apps N]
+                         [--video-rate KBPS] [--json FILE]
+
+Emulates mobile applications connected to SDL over TCP transport and
+scripted HMI connected over MessageBroker WebSocket. Every application
+registers, then sends RPCs of the given mix during the given time and
+optionally streams video. Throughput and latency percentiles of every RPC
+are printed at the end.
+
+optional arguments:
+  -h, --help            show this help message and exit
+  --sdl HOST:PORT       TCP transport of SDL, default 127.0.0.1:12345
+  --hmi HOST:PORT       MessageBroker of SDL, default 127.0.0.1:8087
+  --no-hmi              do not start mock HMI, real one is connected
+  --hmi-script FILE     JSON with responses of mock HMI, see hmi_script.json
+  --no-activation       mock HMI leaves registered applications in NONE
+  --apps N              count of emulated applications, default 1
+  --protocol {2,3}      SDL protocol version of applications, default 3
+  --duration SECONDS    time of sending RPCs, default 10
+  --mix MIX             weights of RPCs, default AddCommand:1
+  --rate RATE           requests per second of every application,
+                        0 sends as fast as window allows, default 0
+  --window WINDOW       requests of one application waiting for response,
+                        default 10
+  --put-file-size BYTES size of PutFile data, default 4096
+  --video-apps N        count of first applications streaming video
+  --video-rate KBPS     video bit rate of every streaming application
+  --json FILE           also write report to the file as JSON
+
+Mix is comma separated list of Name:weight, names are AddCommand, Show,
+SubscribeVehicleData (alternates with UnsubscribeVehicleData) and PutFile,
+e.g. --mix AddCommand:70,SubscribeVehicleData:10,PutFile:20
+
+Script of mock HMI maps method to its response: "delay" in milliseconds,
+"code" of result (0 is SUCCESS) and "params" of result, "*.Name" matches
+method Name of any interface. Requests missing in script are answered
+in no time with SUCCESS.
+
+Note that SDL limits request rate of applications by AppTimeScaleMaxRequests,
+AppHMILevelNoneTimeScaleMaxRequests and FrequencyCount of smartDeviceLink.ini
+and vehicle data is allowed by policies only for granted applications,
+result codes of every RPC are reported to see such rejections.
+"""
+
+import argparse
+import base64
+import json
+import os
+import random
+import socket
+import struct
+import sys
+import threading
+import time
+
+PROTOCOL_VERSION_1 = 1
+HEADER_V1_SIZE = 8
+HEADER_V2_SIZE = 12
+MAX_PAYLOAD_SIZE = 1488
+
+FRAME_TYPE_CONTROL = 0
+FRAME_TYPE_SINGLE = 1
+FRAME_TYPE_FIRST = 2
+FRAME_TYPE_CONSECUTIVE = 3
+
+SERVICE_TYPE_CONTROL = 0x00
+SERVICE_TYPE_RPC = 0x07
+SERVICE_TYPE_VIDEO = 0x0B
+
+FRAME_DATA_HEART_BEAT = 0x00
+FRAME_DATA_START_SERVICE = 0x01
+FRAME_DATA_START_SERVICE_ACK = 0x02
+FRAME_DATA_START_SERVICE_NACK = 0x03
+FRAME_DATA_END_SERVICE = 0x04
+FRAME_DATA_HEART_BEAT_ACK = 0xFF
+
+RPC_TYPE_REQUEST = 0
+RPC_TYPE_RESPONSE = 1
+RPC_TYPE_NOTIFICATION = 2
+RPC_HEADER_SIZE = 12
+
+REGISTER_APP_INTERFACE = 1
+UNREGISTER_APP_INTERFACE = 2
+ADD_COMMAND = 5
+SHOW = 13
+SUBSCRIBE_VEHICLE_DATA = 20
+UNSUBSCRIBE_VEHICLE_DATA = 21
+PUT_FILE = 32
+ON_HMI_STATUS = 32768
+
+RESPONSE_TIMEOUT = 10.0
+VIDEO_CHUNK_SIZE = 1024
+
+HMI_COMPONENTS = ("BasicCommunication", "UI", "VR", "TTS", "Navigation",
+                  "VehicleInfo", "Buttons")
+HMI_NOTIFICATIONS = ("BasicCommunication.OnAppRegistered",
+                     "BasicCommunication.OnAppUnregistered")
+
+# Responses of mock HMI, "*" matches any interface
+DEFAULT_HMI_SCRIPT = {
+    "*.IsReady": {"params": {"available": True}},
+    "*.GetLanguage": {"params": {"language": "EN-US"}},
+    "*.GetSupportedLanguages": {"params": {"languages": ["EN-US"]}},
+    "BasicCommunication.MixingAudioSupported": {
+        "params": {"attenuatedSupported": True}},
+    "VehicleInfo.GetVehicleType": {
+        "params": {"vehicleType": {"make": "Ford", "model": "Fiesta",
+                                   "modelYear": "2015", "trim": "SE"}}},
+}
+
+PERCENTILES = (50, 90, 99, 100)
+
+
+def now():
+    return time.time()
+
+
+def pack_frame(version, frame_type, service_type, frame_data, session_id,
+               message_id, data):
+    """Returns frame of SDL protocol with header of the given version"""
+    first_byte = (version << 4) | frame_type
+    if PROTOCOL_VERSION_1 == version:
+        header = struct.pack(">BBBBI", first_byte, service_type, frame_data,
+                             session_id, len(data))
+    else:
+        header = struct.pack(">BBBBII", first_byte, service_type, frame_data,
+                             session_id, len(data), message_id)
+    return header + data
+
+
+def pack_rpc(rpc_type, function_id, correlation_id, params, binary=b""):
+    """Returns RPC payload of protocol version 2 and higher"""
+    text = json.dumps(params).encode("utf-8")
+    header = struct.pack(">III", (rpc_type << 28) | function_id,
+                         correlation_id, len(text))
+    return header + text + binary
+
+
+def unpack_rpc(data):
+    """Returns (rpc type, function id, correlation id, params)"""
+    if len(data) < RPC_HEADER_SIZE:
+        return None
+    word, correlation_id, json_size = struct.unpack(
+        ">III", data[:RPC_HEADER_SIZE])
+    text = data[RPC_HEADER_SIZE:RPC_HEADER_SIZE + json_size]
+    try:
+        params = json.loads(text.decode("utf-8")) if text else {}
+    except ValueError:
+        params = {}
+    return word >> 28, word & 0x0FFFFFFF, correlation_id, params
+
+
+def recv_exact(connection, size):
+    """Returns size bytes from socket or None if it is closed"""
+    data = b""
+    while len(data) < size:
+        chunk = connection.recv(size - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+
+class Frame(object):
+    """Frame of SDL protocol"""
+
+    def __init__(self, header, data):
+        self.version = header[0] >> 4
+        self.frame_type = header[0] & 0x07
+        self.service_type = header[1]
+        self.frame_data = header[2]
+        self.session_id = header[3]
+        self.message_id = header[5] if len(header) > 5 else 0
+        self.data = data
+
+
+def read_frame(connection):
+    """Reads frame of any protocol version, returns None on disconnect"""
+    header_v1 = recv_exact(connection, HEADER_V1_SIZE)
+    if header_v1 is None:
+        return None
+    header = list(struct.unpack(">BBBBI", header_v1))
+    if header[0] >> 4 != PROTOCOL_VERSION_1:
+        message_id = recv_exact(connection, HEADER_V2_SIZE - HEADER_V1_SIZE)
+        if message_id is None:
+            return None
+        header.append(struct.unpack(">I", message_id)[0])
+    data = recv_exact(connection, header[4]) if header[4] else b""
+    if data is None:
+        return None
+    return Frame(header, data)
+
+
+class Histogram(object):
+    """Collects latencies in microseconds"""
+
+    def __init__(self):
+        self.values = []
+
+    def add(self, value):
+        self.values.append(value)
+
+    def percentile(self, percent):
+        ordered = sorted(self.values)
+        index = (len(ordered) * percent + 99) // 100 - 1
+        return ordered[max(0, min(index, len(ordered) - 1))]
+
+
+class RpcStatistics(object):
+    """Responses, result codes and latency of one RPC"""
+
+    def __init__(self):
+        self.sent = 0
+        self.latency = Histogram()
+        self.result_codes = {}
+
+    def summary(self, duration):
+        parts = ["sent %d, responses %d, %.1f/s" % (
+            self.sent, len(self.latency.values),
+            len(self.latency.values) / duration)]
+        if self.latency.values:
+            for percent in PERCENTILES:
+                parts.append("p%d %d us" % (
+                    percent, self.latency.percentile(percent)))
+        return ", ".join(parts)
+
+    def to_dict(self, duration):
+        result = {"sent": self.sent,
+                  "responses": len(self.latency.values),
+                  "throughput": len(self.latency.values) / duration,
+                  "result_codes": self.result_codes}
+        if self.latency.values:
+            for percent in PERCENTILES:
+                result["p%d_us" % percent] = self.latency.percentile(percent)
+        return result
+
+
+class Statistics(object):
+    """Statistics shared by all applications and mock HMI"""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.rpcs = {}
+        self.notifications = 0
+        self.registered_apps = 0
+        self.disconnected_apps = 0
+        self.video_bytes = 0
+        self.hmi_requests = {}
+
+    def rpc(self, name):
+        if name not in self.rpcs:
+            self.rpcs[name] = RpcStatistics()
+        return self.rpcs[name]
+
+    def sent(self, name):
+        with self.lock:
+            self.rpc(name).sent += 1
+
+    def response(self, name, latency, result_code):
+        with self.lock:
+            rpc = self.rpc(name)
+            rpc.latency.add(int(latency * 1000000))
+            rpc.result_codes[result_code] = (
+                rpc.result_codes.get(result_code, 0) + 1)
+
+    def add(self, field, value=1):
+        with self.lock:
+            setattr(self, field, getattr(self, field) + value)
+
+    def hmi_request(self, method):
+        with self.lock:
+            self.hmi_requests[method] = self.hmi_requests.get(method, 0) + 1
+
+    def write(self, out, duration):
+        total = sum(len(rpc.latency.values) for rpc in self.rpcs.values())
+        out.write("Load of %.1f s: %d responses, %.1f/s\n" % (
+            duration, total, total / duration))
+        for name in sorted(self.rpcs):
+            rpc = self.rpcs[name]
+            out.write("%s: %s\n" % (name, rpc.summary(duration)))
+            for code in sorted(rpc.result_codes):
+                out.write("  %s %d\n" % (code, rpc.result_codes[code]))
+        out.write("Registered applications %d, disconnected %d, "
+                  "notifications %d\n" % (self.registered_apps,
+                                          self.disconnected_apps,
+                                          self.notifications))
+        if self.video_bytes:
+            out.write("Video: %d bytes, %.1f kbit/s\n" % (
+                self.video_bytes, self.video_bytes * 8 / duration / 1000))
+        for method in sorted(self.hmi_requests):
+            out.write("HMI %s: %d\n" % (method, self.hmi_requests[method]))
+
+    def to_dict(self, duration):
+        return {"duration": duration,
+                "rpcs": dict((name, rpc.to_dict(duration))
+                             for name, rpc in self.rpcs.items()),
+                "registered_apps": self.registered_apps,
+                "disconnected_apps": self.disconnected_apps,
+                "notifications": self.notifications,
+                "video_bytes": self.video_bytes,
+                "hmi_requests": self.hmi_requests}
+
+
+class RpcMix(object):
+    """Weighted random choice of RPCs"""
+
+    NAMES = ("AddCommand", "Show", "SubscribeVehicleData", "PutFile")
+
+    def __init__(self, text):
+        self.choices = []
+        self.total = 0
+        for item in text.split(","):
+            name, _, weight = item.partition(":")
+            name = name.strip()
+            if name not in self.NAMES:
+                raise ValueError("Unknown RPC %s" % name)
+            weight = int(weight) if weight else 1
+            if weight > 0:
+                self.total += weight
+                self.choices.append((self.total, name))
+        if not self.total:
+            raise ValueError("Empty mix of RPCs")
+
+    def choose(self):
+        point = random.randint(1, self.total)
+        for bound, name in self.choices:
+            if point <= bound:
+                return name
+
+
+class MobileApp(threading.Thread):
+    """Application connected to SDL over TCP transport"""
+
+    def __init__(self, index, options, mix, statistics, started, stop):
+        threading.Thread.__init__(self)
+        self.daemon = True
+        self.index = index
+        self.options = options
+        self.mix = mix
+        self.statistics = statistics
+        self.started = started
+        self.stop = stop
+        self.streaming = index < options.video_apps
+        self.connection = None
+        self.send_lock = threading.Lock()
+        self.session_id = 0
+        self.message_id = 0
+        self.correlation_id = 0
+        self.commands_count = 0
+        self.subscribed = False
+        self.pending = {}
+        self.pending_lock = threading.Lock()
+        self.window = threading.Semaphore(options.window)
+        self.control_event = threading.Event()
+        self.control_frame = None
+        self.hmi_level = "NONE"
+        self.hmi_level_event = threading.Event()
+        self.connected = False
+        # Parts of multi frame messages by message id
+        self.assembling = {}
+
+    def run(self):
+        try:
+            self.connection = socket.create_connection(self.options.sdl)
+            self.connection.setsockopt(socket.IPPROTO_TCP,
+                                       socket.TCP_NODELAY, 1)
+        except socket.error as error:
+            sys.stderr.write("Application %d: %s\n" % (self.index, error))
+            self.started.release()
+            return
+        self.connected = True
+        reader = threading.Thread(target=self.read_loop)
+        reader.daemon = True
+        reader.start()
+        registered = self.register()
+        self.started.release()
+        if not registered:
+            return
+        if self.streaming:
+            self.start_video()
+        self.load_loop()
+        self.unregister()
+
+    def register(self):
+        if not self.start_service(SERVICE_TYPE_RPC):
+            sys.stderr.write("Application %d: RPC service is not started\n" %
+                             self.index)
+            return False
+        params = {
+            "syncMsgVersion": {"majorVersion": 4, "minorVersion": 0},
+            "appName": "Load App %d" % self.index,
+            "isMediaApplication": False,
+            "languageDesired": "EN-US",
+            "hmiDisplayLanguageDesired": "EN-US",
+            "appHMIType": ["NAVIGATION" if self.streaming else "DEFAULT"],
+            "appID": "%d" % (700000 + self.index),
+        }
+        result = self.call("RegisterAppInterface", REGISTER_APP_INTERFACE,
+                           params)
+        if result not in ("SUCCESS", "WARNINGS"):
+            sys.stderr.write("Application %d: RegisterAppInterface %s\n" %
+                             (self.index, result))
+            return False
+        self.statistics.add("registered_apps")
+        if self.options.activation:
+            self.hmi_level_event.wait(RESPONSE_TIMEOUT)
+        return True
+
+    def unregister(self):
+        self.wait_pending()
+        if self.connected:
+            self.call("UnregisterAppInterface", UNREGISTER_APP_INTERFACE, {})
+            self.send_frame(FRAME_TYPE_CONTROL, SERVICE_TYPE_RPC,
+                            FRAME_DATA_END_SERVICE, b"")
+        self.connection.close()
+
+    def start_service(self, service_type):
+        """Sends StartService, returns True on ACK"""
+        self.control_event.clear()
+        self.control_frame = None
+        self.send_frame(FRAME_TYPE_CONTROL, service_type,
+                        FRAME_DATA_START_SERVICE, b"")
+        self.control_event.wait(RESPONSE_TIMEOUT)
+        frame = self.control_frame
+        if frame is None or FRAME_DATA_START_SERVICE_ACK != frame.frame_data:
+            return False
+        self.session_id = frame.session_id
+        return True
+
+    def start_video(self):
+        if not self.start_service(SERVICE_TYPE_VIDEO):
+            sys.stderr.write("Application %d: video service is not started\n"
+                             % self.index)
+            return
+        streamer = threading.Thread(target=self.video_loop)
+        streamer.daemon = True
+        streamer.start()
+
+    def video_loop(self):
+        """Sends chunks of random data with the given bit rate"""
+        interval = VIDEO_CHUNK_SIZE * 8 / (self.options.video_rate * 1000.0)
+        chunk = os.urandom(VIDEO_CHUNK_SIZE)
+        next_time = now()
+        while not self.stop.is_set() and self.connected:
+            self.send_frame(FRAME_TYPE_SINGLE, SERVICE_TYPE_VIDEO, 0, chunk)
+            self.statistics.add("video_bytes", len(chunk))
+            next_time += interval
+            delay = next_time - now()
+            if delay > 0:
+                self.stop.wait(delay)
+
+    def load_loop(self):
+        rate = self.options.rate
+        begin = now()
+        sent = 0
+        while not self.stop.is_set() and self.connected:
+            if rate:
+                delay = begin + sent / rate - now()
+                if delay > 0 and self.stop.wait(delay):
+                    break
+            if not self.window.acquire(False):
+                # Window may be full, so waiting is split to see stop
+                self.stop.wait(0.001)
+                continue
+            self.send_request(self.mix.choose())
+            sent += 1
+
+    def send_request(self, name):
+        binary = b""
+        if "AddCommand" == name:
+            self.commands_count += 1
+            function_id = ADD_COMMAND
+            params = {"cmdID": self.commands_count,
+                      "menuParams": {"menuName": "Command %d" %
+                                     self.commands_count},
+                      "vrCommands": ["Command %d" % self.commands_count]}
+        elif "Show" == name:
+            function_id = SHOW
+            params = {"mainField1": "Application %d" % self.index,
+                      "mainField2": "Request %d" % self.correlation_id}
+        elif "SubscribeVehicleData" == name:
+            self.subscribed = not self.subscribed
+            if not self.subscribed:
+                name = "UnsubscribeVehicleData"
+            function_id = (SUBSCRIBE_VEHICLE_DATA if self.subscribed
+                           else UNSUBSCRIBE_VEHICLE_DATA)
+            params = {"gps": True, "speed": True}
+        else:
+            function_id = PUT_FILE
+            params = {"syncFileName": "load_%d.bin" % self.index,
+                      "fileType": "BINARY", "persistentFile": False}
+            binary = os.urandom(self.options.put_file_size)
+        correlation_id = self.next_correlation_id()
+        with self.pending_lock:
+            self.pending[correlation_id] = (name, now(), None)
+        self.statistics.sent(name)
+        self.send_message(pack_rpc(RPC_TYPE_REQUEST, function_id,
+                                   correlation_id, params, binary))
+
+    def call(self, name, function_id, params):
+        """Sends request out of window, returns its result code"""
+        event = threading.Event()
+        correlation_id = self.next_correlation_id()
+        with self.pending_lock:
+            self.pending[correlation_id] = (name, now(), event)
+        self.statistics.sent(name)
+        self.send_message(pack_rpc(RPC_TYPE_REQUEST, function_id,
+                                   correlation_id, params))
+        if not event.wait(RESPONSE_TIMEOUT):
+            return "TIMEOUT"
+        return event.result_code
+
+    def wait_pending(self):
+        deadline = now() + RESPONSE_TIMEOUT
+        while self.pending and self.connected and now() < deadline:
+            time.sleep(0.01)
+        with self.pending_lock:
+            for name, _, _ in self.pending.values():
+                self.statistics.response(name, 0, "NO_RESPONSE")
+            self.pending.clear()
+
+    def next_correlation_id(self):
+        self.correlation_id += 1
+        return self.correlation_id
+
+    def send_frame(self, frame_type, service_type, frame_data, data,
+                   message_id=None):
+        if message_id is None:
+            self.message_id += 1
+            message_id = self.message_id
+        frame = pack_frame(self.options.protocol, frame_type, service_type,
+                           frame_data, self.session_id, message_id, data)
+        try:
+            with self.send_lock:
+                self.connection.sendall(frame)
+        except socket.error:
+            self.connected = False
+
+    def send_message(self, data):
+        """Sends RPC payload in single frame or in multiple frames"""
+        if len(data) <= MAX_PAYLOAD_SIZE:
+            self.send_frame(FRAME_TYPE_SINGLE, SERVICE_TYPE_RPC, 0, data)
+            return
+        chunks = [data[offset:offset + MAX_PAYLOAD_SIZE]
+                  for offset in range(0, len(data), MAX_PAYLOAD_SIZE)]
+        with self.send_lock:
+            self.message_id += 1
+            message_id = self.message_id
+            frames = [pack_frame(self.options.protocol, FRAME_TYPE_FIRST,
+                                 SERVICE_TYPE_RPC, 0, self.session_id,
+                                 message_id,
+                                 struct.pack(">II", len(data), len(chunks)))]
+            for number, chunk in enumerate(chunks, 1):
+                # Last frame is marked by 0, others are numbered 1..255
+                frame_data = (0 if number == len(chunks)
+                              else (number - 1) % 0xFF + 1)
+                frames.append(pack_frame(
+                    self.options.protocol, FRAME_TYPE_CONSECUTIVE,
+                    SERVICE_TYPE_RPC, frame_data, self.session_id,
+                    message_id, chunk))
+            try:
+                self.connection.sendall(b"".join(frames))
+            except socket.error:
+                self.connected = False
+
+    def read_loop(self):
+        while True:
+            try:
+                frame = read_frame(self.connection)
+            except socket.error:
+                frame = None
+            if frame is None:
+                break
+            self.on_frame(frame)
+        if self.connected and not self.stop.is_set():
+            self.statistics.add("disconnected_apps")
+        self.connected = False
+        self.control_event.set()
+
+    def on_frame(self, frame):
+        if FRAME_TYPE_CONTROL == frame.frame_type:
+            if FRAME_DATA_HEART_BEAT == frame.frame_data:
+                self.send_frame(FRAME_TYPE_CONTROL, SERVICE_TYPE_CONTROL,
+                                FRAME_DATA_HEART_BEAT_ACK, b"")
+            elif frame.frame_data in (FRAME_DATA_START_SERVICE_ACK,
+                                      FRAME_DATA_START_SERVICE_NACK):
+                self.control_frame = frame
+                self.control_event.set()
+            return
+        if SERVICE_TYPE_RPC != frame.service_type:
+            return
+        if FRAME_TYPE_FIRST == frame.frame_type:
+            self.assembling[frame.message_id] = []
+            return
+        if FRAME_TYPE_CONSECUTIVE == frame.frame_type:
+            parts = self.assembling.get(frame.message_id)
+            if parts is None:
+                return
+            parts.append(frame.data)
+            if frame.frame_data:
+                return
+            data = b"".join(self.assembling.pop(frame.message_id))
+        else:
+            data = frame.data
+        if PROTOCOL_VERSION_1 == frame.version:
+            return
+        rpc = unpack_rpc(data)
+        if rpc is not None:
+            self.on_rpc(*rpc)
+
+    def on_rpc(self, rpc_type, function_id, correlation_id, params):
+        if RPC_TYPE_RESPONSE == rpc_type:
+            with self.pending_lock:
+                request = self.pending.pop(correlation_id, None)
+            if request is None:
+                return
+            name, sent_time, event = request
+            result_code = params.get("resultCode", "UNKNOWN")
+            self.statistics.response(name, now() - sent_time, result_code)
+            if event is None:
+                self.window.release()
+            else:
+                event.result_code = result_code
+                event.set()
+        elif RPC_TYPE_NOTIFICATION == rpc_type:
+            self.statistics.add("notifications")
+            if ON_HMI_STATUS == function_id:
+                self.hmi_level = params.get("hmiLevel", self.hmi_level)
+                if "NONE" != self.hmi_level:
+                    self.hmi_level_event.set()
+
+
+class WebSocket(object):
+    """Minimal WebSocket client of text messages"""
+
+    def __init__(self, address):
+        self.connection = socket.create_connection(address)
+        self.send_lock = threading.Lock()
+        self.buffer = b""
+        key = base64.b64encode(os.urandom(16)).decode("ascii")
+        request = ("GET / HTTP/1.1\r\nHost: %s:%d\r\n"
+                   "Upgrade: websocket\r\nConnection: Upgrade\r\n"
+                   "Sec-WebSocket-Key: %s\r\n"
+                   "Sec-WebSocket-Version: 13\r\n\r\n" % (
+                       address[0], address[1], key))
+        self.connection.sendall(request.encode("ascii"))
+        while b"\r\n\r\n" not in self.buffer:
+            chunk = self.connection.recv(4096)
+            if not chunk:
+                raise socket.error("Handshake is not completed")
+            self.buffer += chunk
+        self.buffer = self.buffer.split(b"\r\n\r\n", 1)[1]
+
+    def send(self, message):
+        data = json.dumps(message).encode("utf-8")
+        mask = os.urandom(4)
+        header = bytearray([0x81])
+        if len(data) < 126:
+            header.append(0x80 | len(data))
+        elif len(data) < 0x10000:
+            header.append(0x80 | 126)
+            header += struct.pack(">H", len(data))
+        else:
+            header.append(0x80 | 127)
+            header += struct.pack(">Q", len(data))
+        masked = bytearray(data)
+        mask_bytes = bytearray(mask)
+        for index in range(len(masked)):
+            masked[index] ^= mask_bytes[index % 4]
+        with self.send_lock:
+            self.connection.sendall(bytes(header) + mask + bytes(masked))
+
+    def read(self, size):
+        while len(self.buffer) < size:
+            chunk = self.connection.recv(65536)
+            if not chunk:
+                return None
+            self.buffer += chunk
+        data, self.buffer = self.buffer[:size], self.buffer[size:]
+        return data
+
+    def receive(self):
+        """Returns payload of next text frame or None on disconnect"""
+        while True:
+            header = self.read(2)
+            if header is None:
+                return None
+            opcode = bytearray(header)[0] & 0x0F
+            size = bytearray(header)[1] & 0x7F
+            if 126 == size:
+                size = struct.unpack(">H", self.read(2))[0]
+            elif 127 == size:
+                size = struct.unpack(">Q", self.read(8))[0]
+            payload = self.read(size)
+            if payload is None or 0x8 == opcode:
+                return None
+            if 0x1 == opcode:
+                return payload.decode("utf-8", "replace")
+
+    def close(self):
+        self.connection.close()
+
+
+def decode_messages(text):
+    """Yields JSON messages of text, several may come in one frame"""
+    decoder = json.JSONDecoder()
+    position = 0
+    while position < len(text):
+        while position < len(text) and text[position].isspace():
+            position += 1
+        if position == len(text):
+            return
+        try:
+            message, position = decoder.raw_decode(text, position)
+        except ValueError:
+            return
+        yield message
+
+
+class MockHmi(threading.Thread):
+    """HMI answering SDL requests by script and activating applications"""
+
+    def __init__(self, options, statistics):
+        threading.Thread.__init__(self)
+        self.daemon = True
+        self.options = options
+        self.statistics = statistics
+        self.script = dict(DEFAULT_HMI_SCRIPT)
+        if options.hmi_script:
+            with open(options.hmi_script) as script:
+                self.script.update(json.load(script))
+        self.socket = WebSocket(options.hmi)
+        self.ready = threading.Event()
+        self.request_id = 0
+        self.id_lock = threading.Lock()
+
+    def next_id(self):
+        with self.id_lock:
+            self.request_id += 1
+            return self.request_id
+
+    def start(self):
+        for component in HMI_COMPONENTS:
+            self.socket.send({"jsonrpc": "2.0", "id": self.next_id(),
+                              "method": "MB.registerComponent",
+                              "params": {"componentName": component}})
+        for notification in HMI_NOTIFICATIONS:
+            self.socket.send({"jsonrpc": "2.0", "id": self.next_id(),
+                              "method": "MB.subscribeTo",
+                              "params": {"propertyName": notification}})
+        threading.Thread.start(self)
+        self.ready.wait(RESPONSE_TIMEOUT)
+        self.socket.send({"jsonrpc": "2.0",
+                          "method": "BasicCommunication.OnReady"})
+
+    def run(self):
+        # MessageBroker answers registration with base of request ids
+        # of the component, subscription is answered with "OK"
+        registered = 0
+        while True:
+            try:
+                text = self.socket.receive()
+            except socket.error:
+                text = None
+            if text is None:
+                break
+            for message in decode_messages(text):
+                if "method" in message and "id" in message:
+                    self.on_request(message)
+                elif "method" in message:
+                    self.on_notification(message)
+                elif isinstance(message.get("result"), int):
+                    if not registered:
+                        with self.id_lock:
+                            self.request_id = message["result"]
+                    registered += 1
+                    if registered == len(HMI_COMPONENTS):
+                        self.ready.set()
+        self.ready.set()
+
+    def find_script(self, method):
+        if method in self.script:
+            return self.script[method]
+        wildcard = "*." + method.split(".", 1)[-1]
+        return self.script.get(wildcard, {})
+
+    def on_request(self, message):
+        method = message["method"]
+        self.statistics.hmi_request(method)
+        script = self.find_script(method)
+        result = dict(script.get("params", {}))
+        result["code"] = script.get("code", 0)
+        result["method"] = method
+        response = {"jsonrpc": "2.0", "id": message["id"], "result": result}
+        delay = script.get("delay", 0) / 1000.0
+        if delay > 0:
+            timer = threading.Timer(delay, self.socket.send, (response,))
+            timer.daemon = True
+            timer.start()
+        else:
+            self.socket.send(response)
+
+    def on_notification(self, message):
+        if ("BasicCommunication.OnAppRegistered" != message["method"] or
+                not self.options.activation):
+            return
+        application = message.get("params", {}).get("application", {})
+        if "appID" not in application:
+            return
+        self.socket.send({"jsonrpc": "2.0",
+                          "method": "SDL.OnAllowSDLFunctionality",
+                          "params": {"allowed": True, "source": "GUI"}})
+        self.socket.send({"jsonrpc": "2.0", "id": self.next_id(),
+                          "method": "SDL.ActivateApp",
+                          "params": {"appID": application["appID"]}})
+
+    def close(self):
+        self.socket.close()
+
+
+def parse_address(text):
+    host, port = text.rsplit(":", 1)
+    return host, int(port)
+
+
+def main():
+    """Main function of the load generator"""
+    parser = argparse.ArgumentParser(description="SDL load generator")
+    parser.add_argument("--sdl", type=parse_address, metavar="HOST:PORT",
+                        default=("127.0.0.1", 12345),
+                        help="TCP transport of SDL")
+    parser.add_argument("--hmi", type=parse_address, metavar="HOST:PORT",
+                        default=("127.0.0.1", 8087),
+                        help="MessageBroker of SDL")
+    parser.add_argument("--no-hmi", dest="mock_hmi", action="store_false",
+                        help="do not start mock HMI")
+    parser.add_argument("--hmi-script", metavar="FILE",
+                        help="JSON with responses of mock HMI")
+    parser.add_argument("--no-activation", dest="activation",
+                        action="store_false",
+                        help="leave registered applications in NONE")
+    parser.add_argument("--apps", type=int, metavar="N", default=1,
+                        help="count of emulated applications")
+    parser.add_argument("--protocol", type=int, choices=(2, 3), default=3,
+                        help="SDL protocol version of applications")
+    parser.add_argument("--duration", type=float, metavar="SECONDS",
+                        default=10,
+                        help="time of sending RPCs in seconds")
+    parser.add_argument("--mix", default="AddCommand:1",
+                        help="weights of RPCs, e.g. AddCommand:70,PutFile:30")
+    parser.add_argument("--rate", type=float, default=0,
+                        help="requests per second of every application")
+    parser.add_argument("--window", type=int, default=10,
+                        help="requests of application waiting for response")
+    parser.add_argument("--put-file-size", type=int, metavar="BYTES",
+                        default=4096,
+                        help="size of PutFile data")
+    parser.add_argument("--video-apps", type=int, metavar="N", default=0,
+                        help="count of first applications streaming video")
+    parser.add_argument("--video-rate", type=float, metavar="KBPS",
+                        default=1000,
+                        help="video bit rate in kbit/s")
+    parser.add_argument("--json", metavar="FILE",
+                        help="also write report to the file")
+    options = parser.parse_args()
+    if not options.mock_hmi:
+        options.activation = False
+
+    try:
+        mix = RpcMix(options.mix)
+    except ValueError as error:
+        parser.error(str(error))
+
+    statistics = Statistics()
+    hmi = None
+    if options.mock_hmi:
+        try:
+            hmi = MockHmi(options, statistics)
+        except socket.error as error:
+            sys.stderr.write("HMI: %s\n" % error)
+            return 1
+        hmi.start()
+
+    stop = threading.Event()
+    started = threading.Semaphore(0)
+    apps = [MobileApp(index, options, mix, statistics, started, stop)
+            for index in range(options.apps)]
+    for app in apps:
+        app.start()
+        # Applications register one by one, so HMI activates them in order
+        started.acquire()
+    begin = now()
+    try:
+        stop.wait(options.duration)
+    except KeyboardInterrupt:
+        pass
+    stop.set()
+    duration = max(now() - begin, 0.001)
+    for app in apps:
+        app.join(RESPONSE_TIMEOUT * 2)
+    if hmi:
+        hmi.close()
+
+    statistics.write(sys.stdout, duration)
+    if options.json:
+        with open(options.json, "w") as report:
+            json.dump(statistics.to_dict(duration), report, indent=2,
+                      sort_keys=True)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
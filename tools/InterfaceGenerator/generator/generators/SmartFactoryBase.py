@@ -90,6 +90,16 @@ class CodeGenerator(object):
             unicode(uuid.uuid1().hex.capitalize()))
         header_file_name = u"".join("{0}.h".format(class_name))
 
+        function_infos_decl = u""
+        function_infos_impl = u""
+        if "FunctionID" in interface.enums and \
+                "messageType" in interface.enums:
+            function_infos_decl = self._function_infos_decl_template
+            function_infos_impl = self._gen_function_infos(
+                interface.enums["FunctionID"],
+                interface.functions.values(),
+                namespace)
+
         with codecs.open(os.path.join(destination_dir, header_file_name),
                          encoding="utf-8",
                          mode="w") as f_h:
@@ -100,6 +110,7 @@ class CodeGenerator(object):
                 enums_content=self._gen_enums(
                     interface.enums.values(),
                     interface.structs.values()),
+                function_infos_decl=function_infos_decl,
                 namespace_close=namespace_close))
 
         self._gen_struct_schema_items(interface.structs.values())
@@ -165,6 +176,7 @@ class CodeGenerator(object):
                     interface.structs.values(),
                     namespace,
                     class_name),
+                function_infos=function_infos_impl,
                 enum_string_coversions=self._gen_enum_to_str_converters(
                     interface.enums.values(),
                     namespace)))
@@ -227,6 +239,67 @@ class CodeGenerator(object):
         """
         return u",\n".join([namespace + "::" + enum.name + "::" + x.primary_name for x in enum.elements.values()])
 
+    def _gen_function_infos(self, function_id, functions, namespace):
+        """Generate metadata table of function ids.
+
+        Generates constant table with name, interface and message types of
+        every function id and lookup function indexing it. Table is indexed
+        by function id if function ids have no explicit values, otherwise
+        switch over function ids maps them to table indices.
+
+        Keyword arguments:
+        function_id -- FunctionID enum.
+        functions -- list of functions.
+        namespace -- namespace to address enums.
+
+        Returns:
+        String with source code of table and lookup function.
+
+        """
+
+        message_types = {}
+        names = {}
+        for function in functions:
+            element = function.function_id
+            message_types.setdefault(element.name, []).append(
+                function.message_type.primary_name)
+            # Enum element of interface function is named as function,
+            # other enum elements have suffix
+            names.setdefault(
+                element.name,
+                element.name if element.internal_name is not None
+                else function.name)
+
+        elements = function_id.elements.values()
+        infos = []
+        for element in elements:
+            name = names.get(element.name, element.name)
+            dot = name.find(u".")
+            interface_name = name[:dot] if dot >= 0 else u""
+            types = u" | ".join(
+                [u"(1u << {0}::messageType::{1})".format(namespace, x)
+                 for x in message_types.get(element.name, [])])
+            infos.append(self._function_info_template.substitute(
+                name=name,
+                interface_name=interface_name,
+                message_types=types if types else u"0u"))
+
+        if all(x.value is None for x in elements):
+            lookup = self._function_info_index_template
+        else:
+            lookup = self._function_info_switch_template.substitute(
+                cases=self._indent_code(u"".join(
+                    [self._function_info_case_template.substitute(
+                        namespace=namespace,
+                        element=x.primary_name,
+                        index=i)
+                     for i, x in enumerate(elements)]).rstrip(u"\n"), 2))
+
+        return self._function_infos_impl_template.substitute(
+            namespace=namespace,
+            infos=self._indent_code(u",\n".join(infos), 1),
+            lookup=lookup)
+
     def _gen_h_class(self, class_name, params, functions, structs):
         """Generate source code of class for header file.
 
@@ -1217,6 +1290,7 @@ class CodeGenerator(object):
         u'''\n'''
         u'''$namespace_open'''
         u'''$enums_content'''
+        u'''$function_infos_decl'''
         u'''$namespace_close'''
         u'''#endif //$guard\n'''
         u'''\n\n''')
@@ -1421,6 +1495,10 @@ class CodeGenerator(object):
         u'''\n'''
         u'''$init_structs_impls'''
         u'''\n'''
+        u'''//------------------ Function ids metadata -------------------\n'''
+        u'''\n'''
+        u'''$function_infos'''
+        u'''\n'''
         u'''//-------------- String to value enum mapping ----------------\n'''
         u'''\n'''
         u'''namespace NsSmartDeviceLink {\n'''
@@ -1432,6 +1510,73 @@ class CodeGenerator(object):
         u'''} // NsSmartDeviceLink\n'''
         u'''\n''')
 
+    _function_infos_decl_template = (
+        u'''\n'''
+        u'''/**\n'''
+        u''' * @brief Metadata of function id known from interface '''
+        u'''description.\n'''
+        u''' */\n'''
+        u'''struct FunctionInfo {\n'''
+        u'''  /**\n'''
+        u'''   * @brief Function name, e.g. "Show" or "UI.Show".\n'''
+        u'''   */\n'''
+        u'''  const char* name;\n'''
+        u'''\n'''
+        u'''  /**\n'''
+        u'''   * @brief Interface of function, e.g. "UI", '''
+        u'''empty if there is none.\n'''
+        u'''   */\n'''
+        u'''  const char* interface_name;\n'''
+        u'''\n'''
+        u'''  /**\n'''
+        u'''   * @brief Bit mask of message types function is described '''
+        u'''for,\n'''
+        u'''   * bit number is messageType value.\n'''
+        u'''   */\n'''
+        u'''  unsigned message_types;\n'''
+        u'''};\n'''
+        u'''\n'''
+        u'''/**\n'''
+        u''' * @brief Gets metadata of function id from constant table.\n'''
+        u''' *\n'''
+        u''' * @return Metadata or NULL if function id is unknown.\n'''
+        u''' */\n'''
+        u'''const FunctionInfo* GetFunctionInfo(FunctionID::eType '''
+        u'''function_id);\n''')
+
+    _function_infos_impl_template = string.Template(
+        u'''namespace {\n'''
+        u'''const ${namespace}::FunctionInfo function_infos[] = {\n'''
+        u'''${infos}'''
+        u'''};\n'''
+        u'''}  // namespace\n'''
+        u'''\n'''
+        u'''const ${namespace}::FunctionInfo* ${namespace}::GetFunctionInfo(\n'''
+        u'''    FunctionID::eType function_id) {\n'''
+        u'''${lookup}'''
+        u'''}\n''')
+
+    _function_info_template = string.Template(
+        u'''{"${name}", "${interface_name}", ${message_types}}''')
+
+    _function_info_index_template = (
+        u'''  if (function_id < 0 || static_cast<size_t>(function_id) >=\n'''
+        u'''      sizeof(function_infos) / sizeof(function_infos[0])) {\n'''
+        u'''    return NULL;\n'''
+        u'''  }\n'''
+        u'''  return &function_infos[function_id];\n''')
+
+    _function_info_switch_template = string.Template(
+        u'''  switch (function_id) {\n'''
+        u'''${cases}'''
+        u'''    default:\n'''
+        u'''      return NULL;\n'''
+        u'''  }\n''')
+
+    _function_info_case_template = string.Template(
+        u'''case ${namespace}::FunctionID::${element}:\n'''
+        u'''  return &function_infos[${index}];\n''')
+
     _enum_to_str_converter_template = string.Template(
         u'''template<>\n'''
         u'''const EnumConversionHelper<${namespace}::${enum}::eType>::'''
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2015, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string>
+
+#include "utils/binary_log_format.h"
+#include "utils/binary_log_reader.h"
+
+namespace {
+
+// Mimics %M of log4cxx: method name without return type and arguments
+std::string MethodName(const std::string& function) {
+  std::string name = function.substr(0, function.find('('));
+  const size_t space = name.rfind(' ');
+  if (std::string::npos != space) {
+    name.erase(0, space + 1);
+  }
+  return name;
+}
+
+// Mimics %d{dd MMM yyyy HH:mm:ss,SSS} of log4cxx
+std::string FormatTime(uint64_t time_stamp) {
+  const time_t seconds = static_cast<time_t>(time_stamp / 1000000);
+  struct tm local_time;
+  localtime_r(&seconds, &local_time);
+  char buffer[64];
+  const size_t length =
+      strftime(buffer, sizeof(buffer), "%d %b %Y %H:%M:%S", &local_time);
+  snprintf(buffer + length, sizeof(buffer) - length, ",%03u",
+           static_cast<unsigned>(time_stamp / 1000 % 1000));
+  return buffer;
+}
+
+}  // namespace
+
+/*
+ * Prints binary log as text in layout of SmartDeviceLinkCore log file
+ */
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <binary log file>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  logger::BinaryLogReader reader;
+  if (!reader.Open(argv[1])) {
+    fprintf(stderr, "%s\n", reader.error().c_str());
+    return EXIT_FAILURE;
+  }
+
+  logger::BinaryLogEvent event;
+  while (reader.Next(&event)) {
+    if (event.dropped) {
+      printf("WARN  [%s] %u log records dropped, log ring was full\n",
+             event.thread.c_str(), event.dropped);
+      continue;
+    }
+    printf("%-5s [%s][%s][%s] %s:%u %s: %s%s\n",
+           logger::BinaryLogLevelName(event.level),
+           FormatTime(event.time_stamp).c_str(),
+           event.thread.c_str(),
+           event.logger.c_str(),
+           event.file.c_str(),
+           event.line,
+           MethodName(event.function).c_str(),
+           event.message.c_str(),
+           event.truncated ? "..." : "");
+  }
+
+  if (!reader.error().empty()) {
+    fprintf(stderr, "%s\n", reader.error().c_str());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -13,11 +13,14 @@ set(GENERATED_LIB_HEADER_DEPENDENCIES
 #   flag telling intergen to generate function ids automatically
 # if |DBUS_SUPPORT| is added to argument list, intergen is called with "-d"
 #   flag that enables DBus serialization code generation
+# if |FUNCTIONS| followed by function names is added to argument list,
+#   only these function messages are generated (intergen "-m" flags)
 # from xml_file (intergen creates separate directory for every interface).
 # Their names are written lowercase_underscored_style.
 function (GenerateInterfaceLibrary xml_file_name generated_interface_names)
   set(options AUTO_FUNC_IDS DBUS_SUPPORT)
-  cmake_parse_arguments(GenerateInterfaceLibrary "${options}" "" "" ${ARGN})
+  set(multi_value_args FUNCTIONS)
+  cmake_parse_arguments(GenerateInterfaceLibrary "${options}" "" "${multi_value_args}" ${ARGN})
   if (GenerateInterfaceLibrary_AUTO_FUNC_IDS)
     set(AUTOID "-a")
   endif()
@@ -25,6 +28,9 @@ function (GenerateInterfaceLibrary xml_file_name generated_interface_names)
     set(NEED_DBUS "-d")
     list(APPEND GENERATED_LIB_HEADER_DEPENDENCIES ${DBUS_INCLUDE_DIRS})
   endif()
+  foreach(function_name ${GenerateInterfaceLibrary_FUNCTIONS})
+    list(APPEND FUNCTION_FILTER "-m" ${function_name})
+  endforeach(function_name)
 
   foreach(interface_name ${generated_interface_names})
     set(HEADERS
@@ -41,7 +47,7 @@ function (GenerateInterfaceLibrary xml_file_name generated_interface_names)
         ${interface_name}/interface.cc
     )
     add_custom_command( OUTPUT ${HEADERS} ${SOURCES}
-                        COMMAND ${INTERGEN_CMD} -f ${CMAKE_CURRENT_SOURCE_DIR}/${xml_file_name} -j ${AUTOID} ${NEED_DBUS} -i ${interface_name}
+                        COMMAND ${INTERGEN_CMD} -f ${CMAKE_CURRENT_SOURCE_DIR}/${xml_file_name} -j ${AUTOID} ${NEED_DBUS} ${FUNCTION_FILTER} -i ${interface_name}
                         DEPENDS ${INTERGEN_CMD} ${xml_file_name}
                         COMMENT "Generating interface ${interface_name} from ${xml_file_name}"
                         VERBATIM
@@ -32,7 +32,9 @@
 
 #include "cppgen/enum_from_json_value_function.h"
 
+#include <map>
 #include <ostream>
+#include <vector>
 
 #include "cppgen/generator_preferences.h"
 #include "cppgen/literal_generator.h"
@@ -56,28 +58,39 @@ EnumFromJsonStringFunction::~EnumFromJsonStringFunction() {
 }
 
 void EnumFromJsonStringFunction::DefineBody(std::ostream* os) const {
+  // Constants are grouped by name length so only literal of matching
+  // length is compared
+  typedef std::map<size_t, std::vector<const Enum::Constant*> > LengthGroups;
+  LengthGroups groups;
   const Enum::ConstantsList& consts = enm_->constants();
-  if (!consts.empty()) {
-    const char* if_statement = "if (\"{0}\" == {1}) {";
-    for (Enum::ConstantsList::const_iterator i = consts.begin();
-        i != consts.end(); ++i) {
-      const Enum::Constant& c = *i;
-      strmfmt(*os, if_statement, c.name(), parameters_[0].name) << endl;
-      {
-        Indent indent(*os);
-        strmfmt(*os, "{0} = {1};", parameters_[1].name,
-                LiteralGenerator(c).result()) << '\n';
-        *os << "return true;" << '\n';
+  for (Enum::ConstantsList::const_iterator i = consts.begin();
+      i != consts.end(); ++i) {
+    groups[i->name().size()].push_back(&*i);
+  }
+  if (!groups.empty()) {
+    strmfmt(*os, "switch ({0}.size()) {", parameters_[0].name) << endl;
+    for (LengthGroups::const_iterator g = groups.begin();
+        g != groups.end(); ++g) {
+      strmfmt(*os, "  case {0}:", g->first) << endl;
+      Indent indent(*os, 4);
+      for (std::vector<const Enum::Constant*>::const_iterator i =
+          g->second.begin(); i != g->second.end(); ++i) {
+        const Enum::Constant& c = **i;
+        strmfmt(*os, "if (\"{0}\" == {1}) {", c.name(),
+                parameters_[0].name) << endl;
+        {
+          Indent indent(*os);
+          strmfmt(*os, "{0} = {1};", parameters_[1].name,
+                  LiteralGenerator(c).result()) << '\n';
+          *os << "return true;" << '\n';
+        }
+        *os << "}" << endl;
       }
-      if_statement = "} else if (\"{0}\" == {1}) {";
+      *os << "break;" << endl;
     }
+    *os << "}" << endl;
   }
-  *os << "} else {" << endl;
-  {
-    Indent indent(*os);
-    *os << "return false;" << '\n';
-  }
-  *os << "}" << endl;
+  *os << "return false;" << endl;
 }
 
 }  // namespace codegen
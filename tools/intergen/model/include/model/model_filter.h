@@ -45,11 +45,17 @@ namespace codegen {
 class ModelFilter {
 public:
   // Creates filter that skips all entities marked with scope
-  ModelFilter(const std::set<std::string>& filtered_scope_names);
+  // and all function messages except |requested_function_names|
+  // if it is not empty
+  ModelFilter(const std::set<std::string>& filtered_scope_names,
+              const std::set<std::string>& requested_function_names);
   // Tells whether entity with this scope should be skipped
   bool ShouldFilterScope(const Scope& scope) const;
+  // Tells whether function message with this name should be skipped
+  bool ShouldFilterFunction(const std::string& function_name) const;
 private:
   const std::set<Scope> filtered_scopes_;
+  const std::set<std::string> requested_functions_;
 };
 
 }  // namespace codegen
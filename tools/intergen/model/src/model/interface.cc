@@ -227,6 +227,9 @@ bool Interface::AddFunctionMessage(MessagesMap* list,
     std::cerr << "Message with empty function name found\n";
     return false;
   }
+  if (model_filter_->ShouldFilterFunction(name)) {
+    return true;
+  }
 
   std::string func_id_str;
   if (auto_generate_function_ids_) {
@@ -33,14 +33,21 @@
 
 namespace codegen {
 
-ModelFilter::ModelFilter(const std::set<std::string>& filtered_scope_names)
-  : filtered_scopes_(filtered_scope_names) {
+ModelFilter::ModelFilter(const std::set<std::string>& filtered_scope_names,
+                         const std::set<std::string>& requested_function_names)
+  : filtered_scopes_(filtered_scope_names),
+    requested_functions_(requested_function_names) {
 }
 
 bool ModelFilter::ShouldFilterScope(const Scope& scope) const {
   return filtered_scopes_.count(scope) != 0;
 }
 
+bool ModelFilter::ShouldFilterFunction(const std::string& function_name) const {
+  return !requested_functions_.empty() &&
+         requested_functions_.count(function_name) == 0;
+}
+
 
 
 }  // namespace codegen
@@ -57,6 +57,7 @@ struct Options {
   bool  generate_dbus_code;
   std::set<std::string> requested_interfaces;
   std::set<std::string> excluded_scopes;
+  std::set<std::string> requested_functions;
   bool  avoid_unsigned;
   int   minimum_word_size;
   Options()
@@ -80,6 +81,8 @@ void Usage() {
        << "                      multiple interfaces.\n"
        << "  -s <scope_name>     Excludes entities marked with given scope from\n"
        << "                      generated code. Can occur multiple times.\n"
+       << "  -m <function_name>  Generates only given function messages.\n"
+       << "                      Can occur multiple times.\n"
        << "  -a                  Automatically generates function ID enum.\n"
        << "  -U                  Avoid unsigned integers in generated types\n"
        << "  -w <word_bits>      Minimal word size (integer size in bits) in generated types\n"
@@ -93,7 +96,7 @@ int main(int argc, char* argv[]) {
     return EXIT_FAILURE;
   }
   Options options;
-  const char* opts = "ajdUf:i:s:w:";
+  const char* opts = "ajdUf:i:s:m:w:";
   for (int opt = getopt(argc, argv, opts); opt != -1;
       opt = getopt(argc, argv, opts)) {
     switch (opt) {
@@ -113,6 +116,10 @@ int main(int argc, char* argv[]) {
         options.excluded_scopes.insert(optarg);
         break;
       }
+      case 'm': {
+        options.requested_functions.insert(optarg);
+        break;
+      }
       case 'a': {
         options.auto_generate_function_ids = true;
         break;
@@ -156,7 +163,8 @@ int main(int argc, char* argv[]) {
   pugi::xml_document doc;
   pugi::xml_parse_result result = doc.load_file(options.interface_xml);
   if (result) {
-    codegen::ModelFilter model_filter(options.excluded_scopes);
+    codegen::ModelFilter model_filter(options.excluded_scopes,
+                                      options.requested_functions);
     codegen::API api(&model_filter, options.auto_generate_function_ids);
     if (api.init(doc)) {
       codegen::CppApiCodeGenerator cpp_code_generator(&api);
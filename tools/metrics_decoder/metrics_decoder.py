@@ -0,0 +1,358 @@
+"""
+Decoder of binary metrics stream of SDL time tester
+
+usage: metrics_decoder.py [-h] [--dump] [--query] source
+
+Reads stream enabled by TimeTestingBinaryFormat in smartDeviceLink.ini
+either from file or from running SDL and prints latency summaries
+
+positional arguments:
+  source      file with saved stream or host:port of SDL time tester
+
+optional arguments:
+  -h, --help  show this help message and exit
+  --dump      print every record instead of summaries
+  --query     ask SDL for aggregates of its metrics registry once connected
+"""
+
+import argparse
+import socket
+import struct
+import sys
+
+MAGIC = b"SDLMTRC1"
+BYTE_ORDER_MARK = 0x01020304
+VERSION = 1
+NAME_SIZE = 24
+METRIC_NAME_SIZE = 48
+QUERY = b"metrics\n"
+
+TRANSPORT_MANAGER = 1
+PROTOCOL_HANDLER = 2
+APPLICATION_MANAGER = 3
+RESOURCES = 4
+LOCK = 5
+STREAM_QUEUE = 6
+RPC_SPAN = 7
+DROPPED = 8
+COUNTER = 9
+GAUGE = 10
+HISTOGRAM = 11
+PROCESS_USAGE = 12
+THREAD_USAGE = 13
+QUEUE_DEPTH = 14
+APP_MEMORY = 15
+
+PAYLOADS = {
+    TRANSPORT_MANAGER: ("qqIiiI", ("begin", "end", "connection_key", "id",
+                                   "function_id", "data_size")),
+    PROTOCOL_HANDLER: ("qqIiiI", ("begin", "end", "connection_key", "id",
+                                  "function_id", "data_size")),
+    APPLICATION_MANAGER: ("qqIiiI", ("begin", "end", "connection_key", "id",
+                                     "function_id", "data_size")),
+    RESOURCES: ("qqqq", ("time", "utime", "stime", "memory")),
+    LOCK: ("%dsQQQQQQ" % NAME_SIZE,
+           ("name", "acquisitions", "contentions", "wait_time",
+            "max_wait_time", "hold_time", "max_hold_time")),
+    STREAM_QUEUE: ("%dsQQQQQQQQQQI" % NAME_SIZE,
+                   ("name", "queued_frames", "queued_bytes",
+                    "dropped_frames", "dropped_bytes", "received_frames",
+                    "received_bytes", "bitrate", "jitter_us",
+                    "average_latency_us", "max_latency_us", "frame_rate")),
+    RPC_SPAN: ("qqq%dsIIiihhI" % NAME_SIZE,
+               ("queued", "begin", "end", "name", "trace", "connection_key",
+                "correlation_id", "function_id", "index", "parent",
+                "reserved")),
+    DROPPED: ("Q", ("count",)),
+    COUNTER: ("%dsq" % METRIC_NAME_SIZE, ("name", "value")),
+    GAUGE: ("%dsq" % METRIC_NAME_SIZE, ("name", "value")),
+    HISTOGRAM: ("%dsQQQQQQ" % METRIC_NAME_SIZE,
+                ("name", "count", "sum", "max", "p50", "p99", "p999")),
+    PROCESS_USAGE: ("qQQQQiI", ("time", "arena", "mmapped", "in_use", "free",
+                                "open_files", "threads_count")),
+    THREAD_USAGE: ("%dsqQQiI" % NAME_SIZE,
+                   ("name", "time", "utime", "stime", "tid", "reserved")),
+    QUEUE_DEPTH: ("%dsqQ" % NAME_SIZE, ("name", "time", "depth")),
+    APP_MEMORY: ("qIIQQQ", ("time", "connection_key", "reserved",
+                            "app_state", "multi_frame", "queued_messages")),
+}
+
+APP_MEMORY_CATEGORIES = ("app_state", "multi_frame", "queued_messages")
+
+CATEGORIES = {
+    TRANSPORT_MANAGER: "TransportManager",
+    PROTOCOL_HANDLER: "ProtocolHandler",
+    APPLICATION_MANAGER: "ApplicationManager",
+}
+
+PERCENTILES = (50, 90, 99, 100)
+
+
+class DecodeError(Exception):
+    """Stream does not follow binary metrics format"""
+    pass
+
+
+class Reader(object):
+    """Reads exact amounts of bytes from file or socket"""
+
+    def __init__(self, read):
+        self.read_function = read
+
+    def read(self, size):
+        """Returns size bytes, less on end of stream"""
+        data = b""
+        while len(data) < size:
+            chunk = self.read_function(size - len(data))
+            if not chunk:
+                break
+            data += chunk
+        return data
+
+
+def open_source(source, query):
+    """Returns reader of file or of host:port connection"""
+    if ":" in source:
+        host, port = source.rsplit(":", 1)
+        connection = socket.create_connection((host, int(port)))
+        if query:
+            connection.sendall(QUERY)
+        return Reader(connection.recv)
+    stream = open(source, "rb")
+    return Reader(stream.read)
+
+
+def read_header(reader):
+    """Checks magic and version, returns struct byte order prefix"""
+    header = reader.read(len(MAGIC) + 6)
+    if len(header) < len(MAGIC) + 6 or header[:len(MAGIC)] != MAGIC:
+        raise DecodeError("Not a binary metrics stream")
+    for prefix in ("<", ">"):
+        mark, version = struct.unpack(prefix + "IH", header[len(MAGIC):])
+        if BYTE_ORDER_MARK == mark:
+            if VERSION != version:
+                raise DecodeError("Unsupported version %d" % version)
+            return prefix
+    raise DecodeError("Unknown byte order")
+
+
+def read_records(reader, prefix):
+    """Yields (type, fields) of every record, skips unknown types"""
+    while True:
+        header = reader.read(4)
+        if len(header) < 4:
+            return
+        record_type, size = struct.unpack(prefix + "HH", header)
+        payload = reader.read(size)
+        if len(payload) < size:
+            return
+        if record_type not in PAYLOADS:
+            continue
+        layout, names = PAYLOADS[record_type]
+        layout = prefix + layout
+        if struct.calcsize(layout) > size:
+            raise DecodeError("Record %d is too short" % record_type)
+        values = struct.unpack(layout, payload[:struct.calcsize(layout)])
+        fields = dict(zip(names, values))
+        if "name" in fields:
+            fields["name"] = fields["name"].split(b"\0", 1)[0].decode(
+                "ascii", "replace")
+        yield record_type, fields
+
+
+class Histogram(object):
+    """Collects durations in microseconds"""
+
+    def __init__(self):
+        self.values = []
+
+    def add(self, value):
+        if value >= 0:
+            self.values.append(value)
+
+    def percentile(self, percent):
+        ordered = sorted(self.values)
+        index = (len(ordered) * percent + 99) // 100 - 1
+        return ordered[max(0, min(index, len(ordered) - 1))]
+
+    def summary(self):
+        if not self.values:
+            return "no samples"
+        parts = ["count %d" % len(self.values)]
+        for percent in PERCENTILES:
+            parts.append("p%d %d us" % (percent, self.percentile(percent)))
+        return ", ".join(parts)
+
+    def buckets(self):
+        """Returns (upper bound, count) for power of two buckets"""
+        counts = {}
+        for value in self.values:
+            bound = 1
+            while bound < value:
+                bound *= 2
+            counts[bound] = counts.get(bound, 0) + 1
+        return sorted(counts.items())
+
+
+class Summary(object):
+    """Latency histograms per category, stage and function"""
+
+    def __init__(self):
+        self.histograms = {}
+        self.dropped = 0
+        self.last_resources = None
+        self.last_locks = {}
+        self.last_stream_queues = {}
+        self.last_values = {}
+        self.last_histograms = {}
+        self.last_process_usage = None
+        # CPU time per thread id, first and last samples
+        self.first_threads = {}
+        self.last_threads = {}
+        self.max_queue_depths = {}
+        # Peak bytes held per connection key, total and by category
+        self.max_apps_memory = {}
+
+    def histogram(self, key):
+        if key not in self.histograms:
+            self.histograms[key] = Histogram()
+        return self.histograms[key]
+
+    def add(self, record_type, fields):
+        if record_type in CATEGORIES:
+            category = CATEGORIES[record_type]
+            duration = fields["end"] - fields["begin"]
+            self.histogram((category, "processing")).add(duration)
+            if APPLICATION_MANAGER == record_type:
+                self.histogram(("%s function %d" % (
+                    category, fields["function_id"]), "processing")).add(
+                        duration)
+        elif RPC_SPAN == record_type:
+            stage = "RpcTrace %s" % fields["name"]
+            if fields["queued"] and fields["begin"]:
+                self.histogram((stage, "queue_wait")).add(
+                    fields["begin"] - fields["queued"])
+            if fields["begin"] and fields["end"]:
+                self.histogram((stage, "processing")).add(
+                    fields["end"] - fields["begin"])
+        elif RESOURCES == record_type:
+            self.last_resources = fields
+        elif LOCK == record_type:
+            self.last_locks[fields["name"]] = fields
+        elif STREAM_QUEUE == record_type:
+            self.last_stream_queues[fields["name"]] = fields
+        elif DROPPED == record_type:
+            self.dropped += fields["count"]
+        elif record_type in (COUNTER, GAUGE):
+            self.last_values[fields["name"]] = fields["value"]
+        elif HISTOGRAM == record_type:
+            self.last_histograms[fields["name"]] = fields
+        elif PROCESS_USAGE == record_type:
+            self.last_process_usage = fields
+        elif THREAD_USAGE == record_type:
+            self.first_threads.setdefault(fields["tid"], fields)
+            self.last_threads[fields["tid"]] = fields
+        elif QUEUE_DEPTH == record_type:
+            name = fields["name"]
+            self.max_queue_depths[name] = max(
+                self.max_queue_depths.get(name, 0), fields["depth"])
+        elif APP_MEMORY == record_type:
+            key = fields["connection_key"]
+            peaks = self.max_apps_memory.setdefault(key, {"total": 0})
+            total = 0
+            for category in APP_MEMORY_CATEGORIES:
+                peaks[category] = max(peaks.get(category, 0),
+                                      fields[category])
+                total += fields[category]
+            peaks["total"] = max(peaks["total"], total)
+
+    def cpu_by_thread_name(self):
+        """Returns CPU milliseconds spent by threads of each name"""
+        cpu = {}
+        for tid, last in self.last_threads.items():
+            first = self.first_threads[tid]
+            spent = (last["utime"] + last["stime"] -
+                     first["utime"] - first["stime"])
+            cpu[last["name"]] = cpu.get(last["name"], 0) + spent
+        return cpu
+
+    def write(self, out):
+        for key in sorted(self.histograms):
+            histogram = self.histograms[key]
+            out.write("%s %s: %s\n" % (key[0], key[1], histogram.summary()))
+            for bound, count in histogram.buckets():
+                out.write("  <= %10d us %d\n" % (bound, count))
+        if self.last_resources:
+            out.write("Resources: utime %(utime)d stime %(stime)d "
+                      "memory %(memory)d\n" % self.last_resources)
+        for name in sorted(self.last_locks):
+            out.write("Lock %(name)s: acquisitions %(acquisitions)d "
+                      "contentions %(contentions)d wait %(wait_time)d us "
+                      "hold %(hold_time)d us\n" % self.last_locks[name])
+        for name in sorted(self.last_stream_queues):
+            out.write("Stream queue %(name)s: queued %(queued_frames)d "
+                      "dropped %(dropped_frames)d, %(frame_rate)d fps "
+                      "%(bitrate)d bps, jitter %(jitter_us)d us, "
+                      "latency %(average_latency_us)d us "
+                      "max %(max_latency_us)d us\n" %
+                      self.last_stream_queues[name])
+        if self.last_process_usage:
+            out.write("Allocator: in use %(in_use)d free %(free)d "
+                      "mmapped %(mmapped)d, open files %(open_files)d, "
+                      "threads %(threads_count)d\n" %
+                      self.last_process_usage)
+        cpu = self.cpu_by_thread_name()
+        for name in sorted(cpu, key=lambda thread: -cpu[thread]):
+            out.write("Thread %s: cpu %d ms\n" % (name, cpu[name]))
+        for name in sorted(self.max_queue_depths):
+            out.write("Queue %s: max depth %d\n" %
+                      (name, self.max_queue_depths[name]))
+        for key in sorted(self.max_apps_memory):
+            peaks = self.max_apps_memory[key]
+            out.write("App %d memory: max total %d" % (key, peaks["total"]))
+            for category in APP_MEMORY_CATEGORIES:
+                out.write(", %s %d" % (category, peaks[category]))
+            out.write("\n")
+        for name in sorted(self.last_values):
+            out.write("Metric %s: %d\n" % (name, self.last_values[name]))
+        for name in sorted(self.last_histograms):
+            out.write("Metric %(name)s: count %(count)d p50 %(p50)d "
+                      "p99 %(p99)d p999 %(p999)d max %(max)d\n" %
+                      self.last_histograms[name])
+        out.write("Dropped records: %d\n" % self.dropped)
+
+
+def main():
+    """Main function of the decoder"""
+    parser = argparse.ArgumentParser(
+        description="SDL binary metrics stream decoder")
+    parser.add_argument("source",
+                        help="file with saved stream or host:port of SDL")
+    parser.add_argument("--dump", action="store_true",
+                        help="print every record instead of summaries")
+    parser.add_argument("--query", action="store_true",
+                        help="ask SDL for aggregates of metrics registry")
+    args = parser.parse_args()
+
+    reader = open_source(args.source, args.query)
+    summary = Summary()
+    try:
+        prefix = read_header(reader)
+        for record_type, fields in read_records(reader, prefix):
+            if args.dump:
+                sys.stdout.write("%d %s\n" % (record_type, sorted(
+                    fields.items())))
+            else:
+                summary.add(record_type, fields)
+    except DecodeError as error:
+        sys.stderr.write("%s\n" % error)
+        return 1
+    except KeyboardInterrupt:
+        pass
+    if not args.dump:
+        summary.write(sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())